@@ -20,6 +20,7 @@
 /// - Connection pooling;
 /// - Variadic template query parameter passing;
 /// - Query result extraction to C++ types;
+/// - Block by block processing of big query results;
 /// - Mapping C++ types to native ClickHouse types.
 ///
 /// @section info More information
@@ -0,0 +1,219 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/batch_inserter.hpp
+/// @brief @copybrief storages::clickhouse::BatchInserter
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/fwd.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// @brief Accumulates rows into columns of `T` and inserts them into a table
+/// in big batches in background.
+///
+/// `T` is a struct of vectors, just like for Cluster::Insert. Each appended
+/// row is moved field by field into the vectors, which are preallocated for
+/// Settings::max_rows rows and are reused between the batches, so the only
+/// copy of the data is done when a batch is serialized for ClickHouse.
+///
+/// A batch is sent out as soon as it has Settings::max_rows rows, and at
+/// least once in about Settings::max_delay.
+/// Insertion is done in a background task, while the new rows go into the
+/// next batch. If the previous batch is still being inserted, `Append` waits
+/// for it, which limits the memory usage.
+///
+/// Insertion errors are logged, the rows of the failed batch are lost.
+///
+/// The class is thread-safe.
+template <typename T>
+class BatchInserter final {
+ public:
+  struct Settings final {
+    /// Max number of rows in a single insert
+    std::size_t max_rows{100000};
+    /// Max time for a row to wait for the insert
+    std::chrono::milliseconds max_delay{std::chrono::seconds{1}};
+    /// Command control for the inserts
+    OptionalCommandControl command_control{};
+  };
+
+  BatchInserter(ClusterPtr cluster, std::string table_name,
+                std::vector<std::string> column_names, Settings settings);
+
+  /// Inserts all the remaining rows
+  ~BatchInserter();
+
+  BatchInserter(const BatchInserter&) = delete;
+  BatchInserter& operator=(const BatchInserter&) = delete;
+
+  /// @brief Appends a row to the current batch
+  ///
+  /// `Row` is an aggregate with the fields of the same types and in the same
+  /// order as `T::value_type` of each of the `T` vectors.
+  template <typename Row>
+  void Append(Row row);
+
+  /// Inserts the current batch and waits for all the inserts to complete
+  void Flush();
+
+ private:
+  void StartFlush(std::unique_lock<engine::Mutex>& lock);
+
+  void WaitForFlush(std::unique_lock<engine::Mutex>& lock);
+
+  void DoInsert(T& data) const noexcept;
+
+  static void Reserve(T& data, std::size_t rows);
+
+  static void Clear(T& data);
+
+  const ClusterPtr cluster_;
+  const std::string table_name_;
+  const std::vector<std::string> column_names_;
+  const std::vector<std::string_view> column_name_views_;
+  const Settings settings_;
+
+  engine::Mutex mutex_;
+  T batch_{};
+  std::size_t batch_rows_{0};
+  std::optional<T> spare_batch_{};
+  engine::TaskWithResult<T> flush_task_{};
+
+  // must be the last member, as its callback uses the others
+  USERVER_NAMESPACE::utils::PeriodicTask flush_timer_;
+};
+
+template <typename T>
+BatchInserter<T>::BatchInserter(ClusterPtr cluster, std::string table_name,
+                                std::vector<std::string> column_names,
+                                Settings settings)
+    : cluster_(std::move(cluster)),
+      table_name_(std::move(table_name)),
+      column_names_(std::move(column_names)),
+      column_name_views_(column_names_.begin(), column_names_.end()),
+      settings_(std::move(settings)) {
+  UINVARIANT(cluster_, "No cluster for BatchInserter");
+  UINVARIANT(settings_.max_rows > 0, "max_rows must be positive");
+  Reserve(batch_, settings_.max_rows);
+
+  flush_timer_.Start(
+      "clickhouse-batch-inserter",
+      USERVER_NAMESPACE::utils::PeriodicTask::Settings{settings_.max_delay},
+      [this] {
+        std::unique_lock lock(mutex_);
+        if (batch_rows_ > 0) StartFlush(lock);
+      });
+}
+
+template <typename T>
+BatchInserter<T>::~BatchInserter() {
+  flush_timer_.Stop();
+  Flush();
+}
+
+template <typename T>
+template <typename Row>
+void BatchInserter<T>::Append(Row row) {
+  static_assert(boost::pfr::tuple_size_v<Row> == boost::pfr::tuple_size_v<T>,
+                "Row must have a field for each column");
+
+  std::unique_lock lock(mutex_);
+  boost::pfr::for_each_field(batch_, [&row](auto& column, auto index) {
+    column.push_back(std::move(boost::pfr::get<decltype(index)::value>(row)));
+  });
+  if (++batch_rows_ >= settings_.max_rows) StartFlush(lock);
+}
+
+template <typename T>
+void BatchInserter<T>::Flush() {
+  std::unique_lock lock(mutex_);
+  if (batch_rows_ > 0) StartFlush(lock);
+  WaitForFlush(lock);
+}
+
+template <typename T>
+void BatchInserter<T>::StartFlush(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  WaitForFlush(lock);
+
+  T batch = std::move(batch_);
+  if (spare_batch_) {
+    batch_ = std::move(*spare_batch_);
+    spare_batch_.reset();
+  } else {
+    batch_ = T{};
+    Reserve(batch_, settings_.max_rows);
+  }
+  batch_rows_ = 0;
+
+  flush_task_ =
+      engine::CriticalAsyncNoSpan([this, batch = std::move(batch)]() mutable {
+        DoInsert(batch);
+        Clear(batch);
+        return std::move(batch);
+      });
+}
+
+template <typename T>
+void BatchInserter<T>::WaitForFlush(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  if (!flush_task_.IsValid()) return;
+
+  // The task is critical and doesn't throw, so waiting in a cancelled task is
+  // the only way for 'Get' to fail; the batch is lost in that case.
+  try {
+    spare_batch_.emplace(flush_task_.Get());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to wait for a ClickHouse insert into "
+                  << table_name_ << ": " << ex;
+  }
+}
+
+template <typename T>
+void BatchInserter<T>::DoInsert(T& data) const noexcept {
+  try {
+    cluster_->Insert(settings_.command_control, table_name_,
+                     column_name_views_, data);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to insert a batch into " << table_name_ << ": "
+                << ex;
+  }
+}
+
+template <typename T>
+void BatchInserter<T>::Reserve(T& data, std::size_t rows) {
+  boost::pfr::for_each_field(data,
+                             [rows](auto& column) { column.reserve(rows); });
+}
+
+template <typename T>
+void BatchInserter<T>::Clear(T& data) {
+  // keeps the capacity for the next batch
+  boost::pfr::for_each_field(data, [](auto& column) { column.clear(); });
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief storages::clickhouse::Cluster
 
 #include <atomic>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -24,6 +25,9 @@ namespace storages::clickhouse {
 
 class ExecutionResult;
 
+/// Callback for Cluster::ExecuteWithCallback, receives one block of the result
+using BlockCallback = std::function<void(ExecutionResult&&)>;
+
 namespace impl {
 struct ClickhouseSettings;
 }
@@ -60,6 +64,30 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, passing the result to `callback` block
+  /// by block, as soon as each block arrives.
+  ///
+  /// Unlike Execute, the whole result is never kept in memory, so this is the
+  /// way to read big results. Each block is passed as a separate
+  /// ExecutionResult, that could be converted to C++ types just as usual.
+  /// An exception thrown from `callback` aborts the query and is rethrown.
+  /// @note The execute timeout of the command control limits the whole
+  /// query, including the time spent in `callback`.
+  template <typename... Args>
+  void ExecuteWithCallback(const Query& query, const BlockCallback& callback,
+                           const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters, passing the
+  /// result to `callback` block by block, as soon as each block arrives.
+  ///
+  /// See the overload without command control for details.
+  template <typename... Args>
+  void ExecuteWithCallback(OptionalCommandControl, const Query& query,
+                           const BlockCallback& callback,
+                           const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -131,9 +159,17 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  void DoExecuteWithCallback(OptionalCommandControl, const Query& query,
+                             const BlockCallback& callback) const;
+
   const impl::Pool& GetPool() const;
 
+  const impl::Pool& GetLeastLoadedPool() const;
+
+  enum class HostSelection { kRoundRobin, kLeastLoaded };
+
   std::vector<impl::Pool> pools_;
+  HostSelection host_selection_{HostSelection::kRoundRobin};
   mutable std::atomic<std::size_t> current_pool_ind_{0};
 };
 
@@ -189,6 +225,22 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+void Cluster::ExecuteWithCallback(const Query& query,
+                                  const BlockCallback& callback,
+                                  const Args&... args) const {
+  ExecuteWithCallback(OptionalCommandControl{}, query, callback, args...);
+}
+
+template <typename... Args>
+void Cluster::ExecuteWithCallback(OptionalCommandControl optional_cc,
+                                  const Query& query,
+                                  const BlockCallback& callback,
+                                  const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  DoExecuteWithCallback(optional_cc, formatted_query, callback);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
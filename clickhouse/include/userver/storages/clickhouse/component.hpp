@@ -51,6 +51,7 @@ namespace components {
 /// queue_timeout         | client waiting for a free connection time limit  | 1s
 /// use_secure_connection | whether to use TLS for connections               | true
 /// compression           | compression method to use (none / lz4)           | none
+/// host_selection        | how to choose a host for a query (round-robin / least-loaded) | round-robin
 
 // clang-format on
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include <userver/storages/clickhouse/execution_result.hpp>
@@ -29,6 +30,10 @@ class Pool final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query& query) const;
 
+  void ExecuteWithCallback(OptionalCommandControl, const Query& query,
+                           const std::function<void(ExecutionResult&&)>&
+                               callback) const;
+
   void Insert(OptionalCommandControl, const InsertionRequest& request) const;
 
   void WriteStatistics(
@@ -36,6 +41,8 @@ class Pool final {
 
   bool IsAvailable() const;
 
+  std::size_t GetLoad() const;
+
  private:
   std::shared_ptr<PoolImpl> impl_;
 };
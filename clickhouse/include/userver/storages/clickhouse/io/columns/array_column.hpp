@@ -0,0 +1,131 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/io/columns/array_column.hpp
+/// @brief Array column support
+/// @ingroup userver_clickhouse_types
+
+#include <optional>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+#include <userver/storages/clickhouse/io/columns/column_includes.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+/// @returns `column`, throws if the column is not an Array
+ColumnRef GetArrayColumn(const ColumnRef& column);
+
+/// @returns the column of the elements of the array at `ind`
+ColumnRef GetArrayRow(const ColumnRef& column, size_t ind);
+
+/// @param nested empty column of the elements type
+/// @param rows columns of the elements of each array
+ColumnRef ConvertArrayRowsToColumn(ColumnRef&& nested,
+                                   std::vector<ColumnRef>&& rows);
+
+/// @brief Represents ClickHouse Array(T) column,
+/// where T is a ClickhouseColumn as well
+template <typename T>
+class ArrayColumn final : public ClickhouseColumn<ArrayColumn<T>> {
+ public:
+  using cpp_type = typename T::container_type;
+  using container_type = std::vector<cpp_type>;
+
+  class ArrayDataHolder final {
+   public:
+    ArrayDataHolder() = default;
+    ArrayDataHolder(
+        typename ColumnIterator<ArrayColumn<T>>::IteratorPosition iter_position,
+        ColumnRef&& column);
+
+    ArrayDataHolder operator++(int);
+    ArrayDataHolder& operator++();
+    cpp_type& UpdateValue();
+
+    bool operator==(const ArrayDataHolder& other) const;
+
+   private:
+    ColumnRef column_;
+    size_t ind_{0};
+    std::optional<cpp_type> current_value_ = std::nullopt;
+  };
+  using iterator_data = ArrayDataHolder;
+
+  ArrayColumn(ColumnRef column);
+
+  static ColumnRef Serialize(const container_type& from);
+};
+
+template <typename T>
+ArrayColumn<T>::ArrayColumn(ColumnRef column)
+    : ClickhouseColumn<ArrayColumn>{GetArrayColumn(column)} {}
+
+template <typename T>
+ArrayColumn<T>::ArrayDataHolder::ArrayDataHolder(
+    typename ColumnIterator<ArrayColumn<T>>::IteratorPosition iter_position,
+    ColumnRef&& column)
+    : column_{std::move(column)},
+      ind_{iter_position == decltype(iter_position)::kEnd
+               ? GetColumnSize(column_)
+               : 0} {}
+
+template <typename T>
+typename ArrayColumn<T>::ArrayDataHolder
+ArrayColumn<T>::ArrayDataHolder::operator++(int) {
+  ArrayDataHolder old{};
+  old.column_ = column_;
+  old.ind_ = ind_++;
+  old.current_value_ = std::move_if_noexcept(current_value_);
+  current_value_.reset();
+
+  return old;
+}
+
+template <typename T>
+typename ArrayColumn<T>::ArrayDataHolder&
+ArrayColumn<T>::ArrayDataHolder::operator++() {
+  ++ind_;
+  current_value_.reset();
+
+  return *this;
+}
+
+template <typename T>
+typename ArrayColumn<T>::cpp_type&
+ArrayColumn<T>::ArrayDataHolder::UpdateValue() {
+  UASSERT(ind_ < GetColumnSize(column_));
+  if (!current_value_.has_value()) {
+    const T row{GetArrayRow(column_, ind_)};
+    auto& value = current_value_.emplace();
+    value.reserve(row.Size());
+    for (auto it = row.begin(); it != row.end(); ++it) {
+      value.push_back(std::move_if_noexcept(*it));
+    }
+  }
+
+  return *current_value_;
+}
+
+template <typename T>
+bool ArrayColumn<T>::ArrayDataHolder::operator==(
+    const ArrayDataHolder& other) const {
+  return ind_ == other.ind_ && column_.get() == other.column_.get();
+}
+
+template <typename T>
+ColumnRef ArrayColumn<T>::Serialize(const container_type& from) {
+  std::vector<ColumnRef> rows;
+  rows.reserve(from.size());
+  for (const auto& row : from) {
+    rows.push_back(T::Serialize(row));
+  }
+
+  return ConvertArrayRowsToColumn(T::Serialize({}), std::move(rows));
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,139 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/io/columns/decimal_column.hpp
+/// @brief Decimal column support
+/// @ingroup userver_clickhouse_types
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <userver/decimal64/decimal64.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <userver/storages/clickhouse/io/columns/column_includes.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+/// @returns the scale of the Decimal column, throws if the column is of
+/// another type
+int GetDecimalScale(const ColumnRef& column);
+
+/// @returns the mantissa of the value at `ind`, throws if it does not fit
+/// into int64_t
+int64_t GetDecimalUnbiasedAt(const ColumnRef& column, size_t ind);
+
+/// @returns Decimal(18, scale) column of the mantissas
+ColumnRef SerializeDecimal(const std::vector<int64_t>& unbiased, int scale);
+
+/// @brief Represents ClickHouse Decimal(P, S) column as
+/// decimal64::Decimal<Prec, RoundPolicy>.
+///
+/// The values are inserted as Decimal64(Prec). On select the values of any
+/// scale fitting into 64 bits are accepted and are rounded to `Prec` digits
+/// after the point with `RoundPolicy` if needed.
+template <int Prec, typename RoundPolicy = decimal64::DefRoundPolicy>
+class DecimalColumn final
+    : public ClickhouseColumn<DecimalColumn<Prec, RoundPolicy>> {
+ public:
+  using cpp_type = decimal64::Decimal<Prec, RoundPolicy>;
+  using container_type = std::vector<cpp_type>;
+
+  class DecimalDataHolder final {
+   public:
+    DecimalDataHolder() = default;
+    DecimalDataHolder(
+        typename ColumnIterator<DecimalColumn>::IteratorPosition iter_position,
+        ColumnRef&& column);
+
+    DecimalDataHolder operator++(int);
+    DecimalDataHolder& operator++();
+    cpp_type& UpdateValue();
+
+    bool operator==(const DecimalDataHolder& other) const;
+
+   private:
+    ColumnRef column_;
+    size_t ind_{0};
+    int scale_{0};
+    std::optional<cpp_type> current_value_ = std::nullopt;
+  };
+  using iterator_data = DecimalDataHolder;
+
+  DecimalColumn(ColumnRef column);
+
+  static ColumnRef Serialize(const container_type& from);
+};
+
+template <int Prec, typename RoundPolicy>
+DecimalColumn<Prec, RoundPolicy>::DecimalColumn(ColumnRef column)
+    : ClickhouseColumn<DecimalColumn>{column} {
+  GetDecimalScale(column);
+}
+
+template <int Prec, typename RoundPolicy>
+DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder::DecimalDataHolder(
+    typename ColumnIterator<DecimalColumn>::IteratorPosition iter_position,
+    ColumnRef&& column)
+    : column_{std::move(column)},
+      ind_{iter_position == decltype(iter_position)::kEnd
+               ? GetColumnSize(column_)
+               : 0},
+      scale_{GetDecimalScale(column_)} {}
+
+template <int Prec, typename RoundPolicy>
+typename DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder
+DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder::operator++(int) {
+  DecimalDataHolder old{};
+  old.column_ = column_;
+  old.ind_ = ind_++;
+  old.scale_ = scale_;
+  old.current_value_ = std::exchange(current_value_, std::nullopt);
+
+  return old;
+}
+
+template <int Prec, typename RoundPolicy>
+typename DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder&
+DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder::operator++() {
+  ++ind_;
+  current_value_.reset();
+
+  return *this;
+}
+
+template <int Prec, typename RoundPolicy>
+typename DecimalColumn<Prec, RoundPolicy>::cpp_type&
+DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder::UpdateValue() {
+  UASSERT(ind_ < GetColumnSize(column_));
+  if (!current_value_.has_value()) {
+    current_value_.emplace(
+        cpp_type::FromBiased(GetDecimalUnbiasedAt(column_, ind_), scale_));
+  }
+
+  return *current_value_;
+}
+
+template <int Prec, typename RoundPolicy>
+bool DecimalColumn<Prec, RoundPolicy>::DecimalDataHolder::operator==(
+    const DecimalDataHolder& other) const {
+  return ind_ == other.ind_ && column_.get() == other.column_.get();
+}
+
+template <int Prec, typename RoundPolicy>
+ColumnRef DecimalColumn<Prec, RoundPolicy>::Serialize(
+    const container_type& from) {
+  std::vector<int64_t> unbiased;
+  unbiased.reserve(from.size());
+  for (const auto& value : from) {
+    unbiased.push_back(value.AsUnbiased());
+  }
+
+  return SerializeDecimal(unbiased, Prec);
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
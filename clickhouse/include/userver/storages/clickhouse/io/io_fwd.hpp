@@ -31,6 +31,9 @@ namespace storages::clickhouse::io {
 /// - String @ref storages::clickhouse::io::columns::StringColumn
 /// - UUID @ref storages::clickhouse::io::columns::UuidColumn
 /// - Nullable @ref storages::clickhouse::io::columns::NullableColumn
+/// - Array @ref storages::clickhouse::io::columns::ArrayColumn
+/// - LowCardinality(String) @ref storages::clickhouse::io::columns::LowCardinalityStringColumn
+/// - Decimal @ref storages::clickhouse::io::columns::DecimalColumn
 /// - Float32 @ref storages::clickhouse::io::columns::Float32Column
 /// - Float64 @ref storages::clickhouse::io::columns::Float64Column
 ///
@@ -4,6 +4,7 @@
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/common/merge.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 
@@ -28,6 +29,15 @@ size_t WrappingIncrement(std::atomic<size_t>& value, size_t mod,
 Cluster::Cluster(clients::dns::Resolver& resolver,
                  const impl::ClickhouseSettings& settings,
                  const components::ComponentConfig& config) {
+  const auto host_selection =
+      config["host_selection"].As<std::string>("round-robin");
+  if (host_selection == "least-loaded") {
+    host_selection_ = HostSelection::kLeastLoaded;
+  } else {
+    UINVARIANT(host_selection == "round-robin",
+               fmt::format("Unknown host_selection '{}'", host_selection));
+  }
+
   const auto& endpoints = settings.endpoints;
   const auto& auth_settings = settings.auth_settings;
 
@@ -55,12 +65,22 @@ ExecutionResult Cluster::DoExecute(OptionalCommandControl optional_cc,
   return GetPool().Execute(optional_cc, query);
 }
 
+void Cluster::DoExecuteWithCallback(OptionalCommandControl optional_cc,
+                                    const Query& query,
+                                    const BlockCallback& callback) const {
+  GetPool().ExecuteWithCallback(optional_cc, query, callback);
+}
+
 void Cluster::DoInsert(OptionalCommandControl optional_cc,
                        const impl::InsertionRequest& request) const {
   GetPool().Insert(optional_cc, request);
 }
 
 const impl::Pool& Cluster::GetPool() const {
+  if (host_selection_ == HostSelection::kLeastLoaded) {
+    return GetLeastLoadedPool();
+  }
+
   const auto pools_count = pools_.size();
   const auto current_pool_ind =
       WrappingIncrement(current_pool_ind_, pools_count);
@@ -76,6 +96,31 @@ const impl::Pool& Cluster::GetPool() const {
   throw NoAvailablePoolError{"No available pools in cluster."};
 }
 
+const impl::Pool& Cluster::GetLeastLoadedPool() const {
+  const auto pools_count = pools_.size();
+  // start from the next pool, so that the ties are broken in round-robin
+  const auto current_pool_ind =
+      WrappingIncrement(current_pool_ind_, pools_count);
+
+  const impl::Pool* best_pool = nullptr;
+  std::size_t best_load = 0;
+  for (size_t i = 0; i < pools_count; ++i) {
+    const auto& pool = pools_[(current_pool_ind + i) % pools_count];
+    if (!pool.IsAvailable()) continue;
+
+    const auto load = pool.GetLoad();
+    if (!best_pool || load < best_load) {
+      best_pool = &pool;
+      best_load = load;
+    }
+  }
+
+  if (!best_pool) {
+    throw NoAvailablePoolError{"No available pools in cluster."};
+  }
+  return *best_pool;
+}
+
 void Cluster::WriteStatistics(
     USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
   for (const auto& pool : pools_) {
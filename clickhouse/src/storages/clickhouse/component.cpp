@@ -76,6 +76,13 @@ properties:
         type: string
         description: compression method to use (none / lz4)
         defaultDescription: none
+    host_selection:
+        type: string
+        description: how to choose a host for a query (round-robin / least-loaded)
+        defaultDescription: round-robin
+        enum:
+          - round-robin
+          - least-loaded
 )");
 }
 
@@ -104,6 +104,30 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteWithCallback(
+    OptionalCommandControl optional_cc, const Query& query,
+    const std::function<void(ExecutionResult&&)>& callback) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  native_query.OnDataCancelable([&callback, &scope](const NativeBlock& data) {
+    scope.Reset(scopes::kExec);
+    // the first block only describes the columns
+    if (data.GetRowCount() != 0) {
+      // copying a block only copies the pointers to its columns
+      auto block_ptr = std::make_unique<BlockWrapper>(NativeBlock{data});
+      callback(ExecutionResult{BlockWrapperPtr{block_ptr.release()}});
+    }
+
+    // we must return 'true' if we don't want to cancel query
+    return !engine::current_task::ShouldCancel();
+  });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
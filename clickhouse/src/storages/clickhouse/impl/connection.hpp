@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -28,6 +30,9 @@ class Connection final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  void ExecuteWithCallback(OptionalCommandControl, const Query&,
+                           const std::function<void(ExecutionResult&&)>&);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
@@ -45,6 +45,18 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+void Pool::ExecuteWithCallback(
+    OptionalCommandControl optional_cc, const Query& query,
+    const std::function<void(ExecutionResult&&)>& callback) const {
+  auto conn_ptr = impl_->Acquire();
+
+  auto span = PrepareExecutionSpan(impl::scopes::kQuery, impl_->GetHostName());
+  query.FillSpanTags(span);
+
+  const auto timer = impl_->GetExecuteTimer();
+  conn_ptr->ExecuteWithCallback(optional_cc, query, callback);
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -63,6 +75,8 @@ void Pool::WriteStatistics(
 
 bool Pool::IsAvailable() const { return impl_->IsAvailable(); }
 
+std::size_t Pool::GetLoad() const { return impl_->GetLoad(); }
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -1,11 +1,13 @@
 #include "pool_impl.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/get_all.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
@@ -112,6 +114,11 @@ const std::string& PoolImpl::GetHostName() const {
   return pool_settings_.endpoint_settings.host;
 }
 
+std::size_t PoolImpl::GetLoad() const noexcept {
+  const auto& stats = statistics_.connections;
+  return stats.busy.Load() + stats.waiting.Load();
+}
+
 stats::StatementTimer PoolImpl::GetExecuteTimer() {
   return stats::StatementTimer{statistics_.queries};
 }
@@ -160,9 +167,25 @@ void PoolImpl::Drop(Connection* conn) noexcept {
 }
 
 Connection* PoolImpl::Pop() {
+  const auto start = std::chrono::steady_clock::now();
   const auto deadline =
       engine::Deadline::FromDuration(pool_settings_.queue_timeout);
 
+  auto& stats = GetStatistics().connections;
+  ++stats.waiting;
+  USERVER_NAMESPACE::utils::ScopeGuard waiting_guard{
+      [&stats] { --stats.waiting; }};
+
+  auto* conn = DoPop(deadline);
+
+  stats.wait_timings.GetCurrentCounter().Account(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  return conn;
+}
+
+Connection* PoolImpl::DoPop(engine::Deadline deadline) {
   engine::SemaphoreLock given_away_lock{given_away_semaphore_, deadline};
   if (!given_away_lock) {
     ++GetStatistics().connections.overload;
@@ -53,6 +53,9 @@ class PoolImpl final : public std::enable_shared_from_this<PoolImpl> {
 
   const std::string& GetHostName() const;
 
+  /// Number of connections in use and of clients waiting for a connection
+  std::size_t GetLoad() const noexcept;
+
   void StartMaintenance();
 
   stats::StatementTimer GetInsertTimer();
@@ -60,6 +63,7 @@ class PoolImpl final : public std::enable_shared_from_this<PoolImpl> {
 
  private:
   Connection* Pop();
+  Connection* DoPop(engine::Deadline deadline);
   Connection* TryPop();
 
   void DoRelease(Connection*) noexcept;
@@ -0,0 +1,44 @@
+#include <userver/storages/clickhouse/io/columns/array_column.hpp>
+
+#include <storages/clickhouse/io/columns/impl/column_includes.hpp>
+
+#include <clickhouse/columns/array.h>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+namespace {
+using NativeType = clickhouse::impl::clickhouse_cpp::ColumnArray;
+}
+
+ColumnRef GetArrayColumn(const ColumnRef& column) {
+  if (!column->As<NativeType>()) {
+    throw std::runtime_error{
+        fmt::format("failed to cast column of type '{}' to Array",
+                    column->Type()->GetName())};
+  }
+
+  return column;
+}
+
+ColumnRef GetArrayRow(const ColumnRef& column, size_t ind) {
+  UASSERT(column->As<NativeType>() != nullptr);
+  return static_cast<NativeType*>(column.get())->GetAsColumn(ind);
+}
+
+ColumnRef ConvertArrayRowsToColumn(ColumnRef&& nested,
+                                   std::vector<ColumnRef>&& rows) {
+  auto array = std::make_shared<NativeType>(std::move(nested));
+  for (auto& row : rows) {
+    array->AppendAsColumn(std::move(row));
+  }
+
+  return array;
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#include <userver/storages/clickhouse/io/columns/decimal_column.hpp>
+
+#include <limits>
+
+#include <storages/clickhouse/io/columns/impl/column_includes.hpp>
+
+#include <clickhouse/columns/decimal.h>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+namespace {
+using NativeType = clickhouse::impl::clickhouse_cpp::ColumnDecimal;
+
+// Decimal64 holds up to 18 digits
+constexpr size_t kDecimal64Precision = 18;
+}  // namespace
+
+int GetDecimalScale(const ColumnRef& column) {
+  const auto decimal = column->As<NativeType>();
+  if (!decimal) {
+    throw std::runtime_error{
+        fmt::format("failed to cast column of type '{}' to Decimal",
+                    column->Type()->GetName())};
+  }
+
+  return static_cast<int>(decimal->GetScale());
+}
+
+int64_t GetDecimalUnbiasedAt(const ColumnRef& column, size_t ind) {
+  const auto value = impl::NativeGetAt<NativeType>(column, ind);
+  if (value > std::numeric_limits<int64_t>::max() ||
+      value < std::numeric_limits<int64_t>::min()) {
+    throw std::runtime_error{
+        fmt::format("value of column of type '{}' does not fit into Decimal64",
+                    column->Type()->GetName())};
+  }
+
+  return static_cast<int64_t>(value);
+}
+
+ColumnRef SerializeDecimal(const std::vector<int64_t>& unbiased, int scale) {
+  auto column = std::make_shared<NativeType>(kDecimal64Precision,
+                                             static_cast<size_t>(scale));
+  for (const auto value : unbiased) {
+    column->Append(clickhouse::impl::clickhouse_cpp::Int128{value});
+  }
+
+  return column;
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
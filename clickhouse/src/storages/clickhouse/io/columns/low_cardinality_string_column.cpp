@@ -0,0 +1,46 @@
+#include <userver/storages/clickhouse/io/columns/low_cardinality_string_column.hpp>
+
+#include <storages/clickhouse/io/columns/impl/column_includes.hpp>
+
+#include <clickhouse/columns/lowcardinality.h>
+#include <clickhouse/columns/string.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+namespace {
+using StringType = clickhouse::impl::clickhouse_cpp::ColumnString;
+using NativeType =
+    clickhouse::impl::clickhouse_cpp::ColumnLowCardinalityT<StringType>;
+
+ColumnRef GetLowCardinalityColumn(const ColumnRef& column) {
+  if (column->As<NativeType>()) return column;
+  return impl::GetTypedColumn<LowCardinalityStringColumn, StringType>(column);
+}
+}  // namespace
+
+LowCardinalityStringColumn::LowCardinalityStringColumn(ColumnRef column)
+    : ClickhouseColumn{GetLowCardinalityColumn(column)} {}
+
+template <>
+LowCardinalityStringColumn::cpp_type
+ColumnIterator<LowCardinalityStringColumn>::DataHolder::Get() const {
+  if (const auto* native = dynamic_cast<const NativeType*>(column_.get())) {
+    return std::string{native->At(ind_)};
+  }
+  return std::string{impl::NativeGetAt<StringType>(column_, ind_)};
+}
+
+ColumnRef LowCardinalityStringColumn::Serialize(const container_type& from) {
+  auto column = std::make_shared<NativeType>();
+  for (const auto& value : from) {
+    column->Append(value);
+  }
+
+  return column;
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
@@ -29,6 +29,8 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["overload"] = stats.overload.Load();
   writer["active"] = stats.active.Load();
   writer["busy"] = stats.busy.Load();
+  writer["waiting"] = stats.waiting.Load();
+  writer["wait-timings"] = stats.wait_timings.GetStatsForPeriod();
 }
 
 }  // namespace storages::clickhouse::stats
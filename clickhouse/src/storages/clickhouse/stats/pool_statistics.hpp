@@ -22,6 +22,8 @@ struct PoolConnectionStatistics final {
   Counter created{};
   Counter active{};
   Counter busy{};
+  Counter waiting{};
+  RecentPeriod wait_timings{};
 };
 
 struct PoolQueryStatistics final {
@@ -0,0 +1,77 @@
+#include <userver/utest/utest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/io/columns/array_column.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct DataWithArrays final {
+  std::vector<std::vector<uint64_t>> ints;
+  std::vector<std::vector<std::optional<std::string>>> strings;
+};
+
+struct RowWithArray final {
+  std::vector<uint64_t> ints;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<DataWithArrays> {
+  using mapped_type = std::tuple<
+      columns::ArrayColumn<columns::UInt64Column>,
+      columns::ArrayColumn<columns::NullableColumn<columns::StringColumn>>>;
+};
+
+template <>
+struct CppToClickhouse<RowWithArray> {
+  using mapped_type = std::tuple<columns::ArrayColumn<columns::UInt64Column>>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(Array, InsertSelect) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(ints Array(UInt64), strings Array(Nullable(String)))");
+
+  const DataWithArrays insert_data{
+      {{}, {1, 2, 3}, {4}},
+      {{"a", std::nullopt}, {}, {std::nullopt, "b", "c"}}};
+  cluster->Insert("tmp_table", {"ints", "strings"}, insert_data);
+
+  const auto select_data =
+      cluster->Execute("SELECT ints, strings FROM tmp_table")
+          .As<DataWithArrays>();
+  EXPECT_EQ(select_data.ints, insert_data.ints);
+  EXPECT_EQ(select_data.strings, insert_data.strings);
+}
+
+UTEST(Array, IterationWorks) {
+  ClusterWrapper cluster{};
+  auto res = cluster
+                 ->Execute(
+                     "SELECT range(c.number) FROM system.numbers c "
+                     "LIMIT 10")
+                 .AsRows<RowWithArray>();
+  uint64_t ind = 0;
+  for (auto it = res.begin(); it != res.end(); ++it, ++ind) {
+    ASSERT_EQ(it->ints.size(), ind);
+    for (uint64_t i = 0; i < ind; ++i) ASSERT_EQ(it->ints[i], i);
+  }
+  EXPECT_EQ(ind, 10);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,111 @@
+#include <userver/storages/clickhouse/batch_inserter.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Data final {
+  std::vector<std::uint64_t> ids;
+  std::vector<std::string> names;
+};
+
+struct Row final {
+  std::uint64_t id;
+  std::string name;
+};
+
+using BatchInserter = storages::clickhouse::BatchInserter<Data>;
+
+storages::clickhouse::ClusterPtr MakeNonOwning(ClusterWrapper& cluster) {
+  return {std::shared_ptr<void>{}, &*cluster};
+}
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Data> {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(BatchInserter, InsertsBySize) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(id UInt64, name String)");
+
+  constexpr std::size_t kRows = 25;
+  BatchInserter inserter{MakeNonOwning(cluster),
+                         "tmp_table",
+                         {"id", "name"},
+                         {10, std::chrono::hours{1}, {}}};
+  for (std::size_t i = 0; i < kRows; ++i) {
+    inserter.Append(Row{i, std::to_string(i)});
+  }
+  inserter.Flush();
+
+  const auto data =
+      cluster->Execute("SELECT id, name FROM tmp_table ORDER BY id")
+          .As<Data>();
+  ASSERT_EQ(data.ids.size(), kRows);
+  for (std::size_t i = 0; i < kRows; ++i) {
+    EXPECT_EQ(data.ids[i], i);
+    EXPECT_EQ(data.names[i], std::to_string(i));
+  }
+}
+
+UTEST(BatchInserter, InsertsByTime) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(id UInt64, name String)");
+
+  BatchInserter inserter{MakeNonOwning(cluster),
+                         "tmp_table",
+                         {"id", "name"},
+                         {1000, std::chrono::milliseconds{10}, {}}};
+  inserter.Append(Row{1, "one"});
+
+  while (cluster->Execute("SELECT id, name FROM tmp_table")
+             .As<Data>()
+             .ids.empty()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+}
+
+UTEST(BatchInserter, InsertsOnDestruction) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(id UInt64, name String)");
+
+  {
+    BatchInserter inserter{MakeNonOwning(cluster),
+                           "tmp_table",
+                           {"id", "name"},
+                           {1000, std::chrono::hours{1}, {}}};
+    inserter.Append(Row{1, "one"});
+    inserter.Append(Row{2, "two"});
+  }
+
+  const auto data =
+      cluster->Execute("SELECT id, name FROM tmp_table").As<Data>();
+  EXPECT_EQ(data.ids.size(), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/decimal64/decimal64.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/io/columns/decimal_column.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Decimal = decimal64::Decimal<4>;
+
+struct DataWithDecimals final {
+  std::vector<Decimal> decimals;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<DataWithDecimals> {
+  using mapped_type = std::tuple<columns::DecimalColumn<4>>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(Decimal, InsertSelect) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(value Decimal64(4))");
+
+  const DataWithDecimals insert_data{
+      {Decimal{"3.1415"}, Decimal{"-0.0001"}, Decimal{"100000"}}};
+  cluster->Insert("tmp_table", {"value"}, insert_data);
+
+  const auto select_data =
+      cluster->Execute("SELECT value FROM tmp_table").As<DataWithDecimals>();
+  EXPECT_EQ(select_data.decimals, insert_data.decimals);
+}
+
+UTEST(Decimal, OtherScale) {
+  ClusterWrapper cluster{};
+  auto select_data =
+      cluster->Execute("SELECT toDecimal32('1.5', 1)").As<DataWithDecimals>();
+  ASSERT_EQ(select_data.decimals.size(), 1);
+  EXPECT_EQ(select_data.decimals.front(), Decimal{"1.5"});
+
+  select_data = cluster->Execute("SELECT toDecimal64('2.123456', 6)")
+                    .As<DataWithDecimals>();
+  ASSERT_EQ(select_data.decimals.size(), 1);
+  EXPECT_EQ(select_data.decimals.front(), Decimal{"2.1235"});
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <userver/utest/utest.hpp>
 
+#include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/query.hpp>
 
 #include "utils_test.hpp"
@@ -75,6 +76,49 @@ UTEST(Execute, MappingWorks) {
   EXPECT_EQ(sum, 10000 * (10000 - 1) / 2);
 }
 
+UTEST(Execute, WithCallback) {
+  ClusterWrapper cluster{};
+
+  // a small block size makes the server send the result in many blocks
+  const storages::clickhouse::Query q{
+      "SELECT c.number, randomString(10), c.number as t, NOW64(9) "
+      "FROM numbers(0, 10000) c "
+      "SETTINGS max_block_size = 1000"};
+
+  std::size_t blocks = 0;
+  std::size_t rows = 0;
+  uint64_t sum = 0;
+  cluster->ExecuteWithCallback(
+      q, [&](storages::clickhouse::ExecutionResult&& block) {
+        ++blocks;
+        rows += block.GetRowsCount();
+        for (auto&& data : std::move(block).AsRows<RowData>()) {
+          sum += data.number;
+        }
+      });
+
+  EXPECT_GT(blocks, 1);
+  EXPECT_EQ(rows, 10000);
+  EXPECT_EQ(sum, 10000 * (10000 - 1) / 2);
+}
+
+UTEST(Execute, WithCallbackThrows) {
+  ClusterWrapper cluster{};
+
+  std::size_t blocks = 0;
+  EXPECT_THROW(cluster->ExecuteWithCallback(
+                   "SELECT c.number FROM system.numbers c",
+                   [&blocks](storages::clickhouse::ExecutionResult&&) {
+                     ++blocks;
+                     throw std::runtime_error{"enough"};
+                   }),
+               std::runtime_error);
+  EXPECT_EQ(blocks, 1);
+
+  // the pool is still usable
+  EXPECT_EQ(cluster->Execute(common_query).GetRowsCount(), 10000);
+}
+
 namespace {
 namespace io = storages::clickhouse::io;
 
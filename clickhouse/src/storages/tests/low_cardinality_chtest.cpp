@@ -0,0 +1,44 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct DataWithLowCardinality final {
+  std::vector<std::string> strings;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<DataWithLowCardinality> {
+  using mapped_type = std::tuple<columns::LowCardinalityStringColumn>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(LowCardinality, InsertSelect) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table "
+      "(value LowCardinality(String))");
+
+  const DataWithLowCardinality insert_data{{"first", "second", "first", ""}};
+  cluster->Insert("tmp_table", {"value"}, insert_data);
+
+  const auto select_data = cluster->Execute("SELECT value FROM tmp_table")
+                               .As<DataWithLowCardinality>();
+  EXPECT_EQ(select_data.strings, insert_data.strings);
+}
+
+USERVER_NAMESPACE_END
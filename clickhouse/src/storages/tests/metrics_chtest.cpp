@@ -74,4 +74,17 @@ UTEST(Metrics, ActiveConnections) {
   EXPECT_EQ(pool->GetStatistics().connections.active, 3);
 }
 
+UTEST(Metrics, Load) {
+  PoolWrapper pool{};
+
+  EXPECT_EQ(pool->GetLoad(), 0);
+  {
+    const auto first = pool->Acquire();
+    const auto second = pool->Acquire();
+    EXPECT_EQ(pool->GetLoad(), 2);
+    EXPECT_EQ(pool->GetStatistics().connections.waiting, 0);
+  }
+  EXPECT_EQ(pool->GetLoad(), 0);
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,54 @@
+set(USERVER_OPENTELEMETRY_PROTOS "" CACHE PATH "Path to the folder with opentelemetry proto files")
+
+if (USERVER_OPENTELEMETRY_PROTOS)
+  set(opentelemetry-proto_SOURCE_DIR ${USERVER_OPENTELEMETRY_PROTOS})
+endif()
+
+if (NOT opentelemetry-proto_SOURCE_DIR)
+  include(FetchContent)
+
+  FetchContent_Declare(
+    opentelemetry-proto_external_project
+    GIT_REPOSITORY https://github.com/open-telemetry/opentelemetry-proto.git
+    TIMEOUT 10
+    GIT_TAG v0.19.0
+    SOURCE_DIR ${CMAKE_CURRENT_BINARY_DIR}/third_party/opentelemetry-proto
+    )
+
+  FetchContent_GetProperties(opentelemetry-proto_external_project)
+  if (NOT opentelemetry-proto_external_project_POPULATED)
+    message(STATUS "Downloading opentelemetry-proto from remote")
+    FetchContent_Populate(opentelemetry-proto_external_project)
+  endif()
+  set(opentelemetry-proto_SOURCE_DIR ${CMAKE_CURRENT_BINARY_DIR}/third_party/opentelemetry-proto)
+endif()
+
+if (NOT opentelemetry-proto_SOURCE_DIR)
+  message(FATAL_ERROR "Unable to get opentelemetry proto files. It is required for userver-grpc build.")
+endif()
+
+include(GrpcTargets)
+
+# Only the traces part of OTLP is used
+generate_grpc_files(
+  PROTOS
+    ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto/common/v1/common.proto
+    ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto/resource/v1/resource.proto
+    ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto/trace/v1/trace.proto
+    ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto/collector/trace/v1/trace_service.proto
+  INCLUDE_DIRECTORIES
+    ${opentelemetry-proto_SOURCE_DIR}
+  SOURCE_PATH
+    ${opentelemetry-proto_SOURCE_DIR}
+  GENERATED_INCLUDES include_paths
+  CPP_FILES generated_sources
+  CPP_USRV_FILES generated_usrv_sources
+)
+
+add_library(userver-opentelemetry-protos STATIC ${generated_sources})
+target_compile_options(userver-opentelemetry-protos PUBLIC -Wno-unused-parameter)
+target_include_directories(userver-opentelemetry-protos SYSTEM PUBLIC ${include_paths})
+target_link_libraries(userver-opentelemetry-protos PUBLIC userver-core userver-grpc-deps)
+
+set(opentelemetry-proto_LIBRARY userver-opentelemetry-protos)
+set(opentelemetry-proto_USRV_SOURCES ${generated_usrv_sources})
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/cache/admission_policy.hpp
+/// @brief @copybrief cache::AdmissionPolicy
+
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// Decides whether a new item may evict an old one from a full LRU cache
+enum class AdmissionPolicy {
+  /// Plain LRU: every new item is admitted and evicts the least recently used
+  kNone,
+
+  /// W-TinyLFU: new items go through a small window LRU and then compete
+  /// with the main LRU victim by their estimated access frequency. Protects
+  /// the hot set from one-time scans of cold keys.
+  kTinyLfu,
+};
+
+std::string_view ToString(AdmissionPolicy policy);
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
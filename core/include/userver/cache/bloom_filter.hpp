@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file userver/cache/bloom_filter.hpp
+/// @brief @copybrief cache::BloomFilter
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+struct BloomFilterStatistics final {
+  std::uint64_t items{0};
+  std::uint64_t checks{0};
+  std::uint64_t negatives{0};
+  std::uint64_t false_positives{0};
+
+  /// Share of the checks of missing keys that were not short-circuited
+  double GetFalsePositiveRate() const noexcept;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const BloomFilterStatistics& stats);
+
+/// @ingroup userver_containers
+///
+/// @brief Concurrent blocked Bloom filter of hashes, short-circuits the
+/// lookups of the keys that are surely missing.
+///
+/// All the bits of a hash live in a single 512-bit block, so Add() and
+/// MayContain() touch one cache line. The filter is sized for the expected
+/// number of items and the desired false positive rate, adding more items
+/// raises the rate.
+///
+/// Add() and MayContain() are lock-free and may be called concurrently, so a
+/// filter of the keys of a components::CachingComponentBase snapshot is built
+/// anew on a full update, and is shared (e.g. via std::shared_ptr) by the
+/// snapshot copies and extended in place with the new keys on an incremental
+/// update. Erased keys cannot be removed, they only raise the false positive
+/// rate until the next full update.
+///
+/// Call AccountFalsePositive() when the lookup of a key that MayContain()
+/// misses, to collect the false positive rate statistics.
+///
+/// @snippet cache/bloom_filter_test.cpp  Sample BloomFilter
+class BloomFilter final {
+ public:
+  explicit BloomFilter(std::size_t expected_items,
+                       double false_positive_rate = 0.01);
+
+  BloomFilter(const BloomFilter&) = delete;
+  BloomFilter& operator=(const BloomFilter&) = delete;
+
+  /// Adds the hash of a key, e.g. std::hash<Key>{}(key)
+  void Add(std::size_t hash) noexcept;
+
+  /// @returns false if the hash was surely never added
+  bool MayContain(std::size_t hash) const noexcept;
+
+  /// Accounts a MayContain() check of a key that turned out to be missing
+  void AccountFalsePositive() noexcept;
+
+  BloomFilterStatistics GetStatistics() const noexcept;
+
+ private:
+  using Word = std::atomic<std::uint64_t>;
+
+  std::size_t blocks_mask_{0};
+  unsigned hashes_{0};
+  std::unique_ptr<Word[]> words_;
+
+  std::atomic<std::uint64_t> items_{0};
+  mutable std::atomic<std::uint64_t> checks_{0};
+  mutable std::atomic<std::uint64_t> negatives_{0};
+  std::atomic<std::uint64_t> false_positives_{0};
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
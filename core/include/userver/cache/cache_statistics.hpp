@@ -3,6 +3,7 @@
 /// @file userver/cache/cache_statistics.hpp
 /// @brief Statistics collection for components::CachingComponentBase
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -33,9 +34,23 @@ struct UpdateStatistics final {
 formats::json::Value Serialize(const UpdateStatistics& stats,
                                formats::serialize::To<formats::json::Value>);
 
+// Statistics are only collected for the first kMaxPartitionStatistics
+// partitions
+inline constexpr std::size_t kMaxPartitionStatistics = 64;
+
+struct PartitionStatistics final {
+  std::atomic<std::size_t> last_partition_count{0};
+  std::array<std::atomic<std::chrono::milliseconds>, kMaxPartitionStatistics>
+      last_update_durations{};
+};
+
+formats::json::Value Serialize(const PartitionStatistics& stats,
+                               formats::serialize::To<formats::json::Value>);
+
 struct Statistics final {
   UpdateStatistics full_update;
   UpdateStatistics incremental_update;
+  PartitionStatistics full_update_partitions;
   std::atomic<std::size_t> documents_current_count{0};
 };
 
@@ -76,6 +91,17 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Marks the start of a partitioned full update with the specified
+  /// number of partitions
+  /// @see cache::CacheUpdateTrait::RunPartitionedUpdate
+  void StartPartitions(std::size_t partition_count);
+
+  /// @brief Accounts the duration of a partition of a partitioned update
+  /// @note This method can be called concurrently for different partitions,
+  /// as well as the methods that increase the documents counters
+  void FinishPartition(std::size_t partition,
+                       std::chrono::milliseconds duration);
+
  private:
   impl::Statistics& stats_;
   impl::UpdateStatistics& update_stats_;
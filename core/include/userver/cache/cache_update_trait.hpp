@@ -3,13 +3,22 @@
 /// @file userver/cache/cache_update_trait.hpp
 /// @brief @copybrief cache::CacheUpdateTrait
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <userver/cache/cache_statistics.hpp>
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/fwd.hpp>
+#include <userver/engine/get_all.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/flags.hpp>
 
@@ -20,6 +29,10 @@ template <typename T>
 class ReadablePtr;
 }  // namespace rcu
 
+namespace dist_lock {
+class DistLockStrategyBase;
+}  // namespace dist_lock
+
 namespace cache {
 
 struct CacheDependencies;
@@ -37,6 +50,15 @@ class CacheUpdateTrait {
   /// @throws If `Update` throws
   void Update(UpdateType update_type);
 
+  /// @brief Non-blocking forced cache update of specified type, e.g. on a
+  /// notification about the changes of the data source
+  ///
+  /// The update runs in the periodic update task without waiting for the rest
+  /// of the update interval. The requests made during an update result in a
+  /// single update right after it. Has no effect if the periodic updates are
+  /// disabled.
+  void InvalidateAsync(UpdateType update_type);
+
   const std::string& Name() const;
 
  protected:
@@ -60,6 +82,22 @@ class CacheUpdateTrait {
     kNoFirstUpdate = 1 << 0,  ///< Disable initial update on start
   };
 
+  /// @brief Shares the updates between the instances of the service: only
+  /// the instance holding the distributed lock updates the cache from the
+  /// data source and writes the dumps, the others load those dumps instead
+  ///
+  /// The dumps must be enabled, and `dump-root` of components::DumpConfigurator
+  /// must point to a storage shared by the instances. An instance that finds no
+  /// dump at startup updates the cache by itself for the first time. The
+  /// followers lag behind the leader by its dump `min-interval`.
+  ///
+  /// For the processes of a single host use dist_lock::FileLockStrategy,
+  /// together with `mmap: true` dumps on tmpfs it lets them share the pages
+  /// of the cache snapshot.
+  /// @note Must be called before StartPeriodicUpdates()
+  void SetUpdateLeaderElection(
+      std::shared_ptr<dist_lock::DistLockStrategyBase> strategy);
+
   /// Starts periodic updates
   void StartPeriodicUpdates(utils::Flags<Flag> flags = {});
 
@@ -73,6 +111,33 @@ class CacheUpdateTrait {
   /// that the cached data has been modified
   void OnCacheModified();
 
+  /// @brief Reports the changes made by the current incremental update, so
+  /// that the delta is dumped instead of the whole cache, see
+  /// `max-delta-count` of dump::Dumper
+  ///
+  /// Call after `CachingComponentBase::Set`. Without the call the update is
+  /// dumped in full.
+  void SetDumpDelta(dump::DeltaWriter write_delta);
+
+  /// @brief Runs the parts of a full update concurrently and combines them,
+  /// e.g. to fetch and parse the key ranges of a big table in parallel
+  ///
+  /// Calls `update_partition(partition, stats_scope)` for each partition in
+  /// `[0, partition_count)` in a separate task of the cache task processor,
+  /// then returns `merge(parts)`, where `parts` is a `std::vector` of the
+  /// results of `update_partition` in the order of partitions. The durations
+  /// of the partitions are accounted in cache statistics.
+  ///
+  /// The caller is responsible for `Set`ting the data and finishing
+  /// `stats_scope`, as for a usual update.
+  /// @throws Any exception of `update_partition`, the other partitions are
+  /// cancelled
+  template <typename UpdatePartition, typename Merge>
+  auto RunPartitionedUpdate(std::size_t partition_count,
+                            UpdateStatisticsScope& stats_scope,
+                            const UpdatePartition& update_partition,
+                            const Merge& merge);
+
   /// @cond
   // For internal use only
   rcu::ReadablePtr<Config> GetConfig() const;
@@ -98,10 +163,42 @@ class CacheUpdateTrait {
 
   virtual void ReadAndSet(dump::Reader& reader);
 
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
+
   class Impl;
-  utils::FastPimpl<Impl, 2672, 16> impl_;
+  utils::FastPimpl<Impl, 3296, 16> impl_;
 };
 
+template <typename UpdatePartition, typename Merge>
+auto CacheUpdateTrait::RunPartitionedUpdate(
+    std::size_t partition_count, UpdateStatisticsScope& stats_scope,
+    const UpdatePartition& update_partition, const Merge& merge) {
+  UINVARIANT(partition_count > 0, "partition_count must be positive");
+  using Part = std::invoke_result_t<const UpdatePartition&, std::size_t,
+                                    UpdateStatisticsScope&>;
+  static_assert(!std::is_void_v<Part>,
+                "update_partition must return the part of the data");
+
+  stats_scope.StartPartitions(partition_count);
+
+  std::vector<engine::TaskWithResult<Part>> tasks;
+  tasks.reserve(partition_count);
+  for (std::size_t partition = 0; partition < partition_count; ++partition) {
+    tasks.push_back(utils::Async(
+        GetCacheTaskProcessor(), "cache-partition-update",
+        [&update_partition, &stats_scope, partition] {
+          const auto start = std::chrono::steady_clock::now();
+          auto part = update_partition(partition, stats_scope);
+          stats_scope.FinishPartition(
+              partition, std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - start));
+          return part;
+        }));
+  }
+
+  return merge(engine::GetAll(tasks));
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -76,6 +76,21 @@ namespace components {
 /// If both `update-interval` and `full-update-interval` are present,
 /// `full-and-incremental` types is assumed. Otherwise `only-full` is used.
 ///
+/// ### Incremental updates of big caches
+/// An incremental Update usually copies the current cache contents, applies
+/// the delta and Set()s the copy, which costs O(size of the cache) memory and
+/// CPU. Use cache::PersistentMap as `T` to make such updates O(delta): its
+/// copies share unchanged items, and readers that hold the previous snapshot
+/// are not affected by the update.
+///
+/// If the cache needs several lookup maps over the same items, use
+/// cache::IndexedMap: it maintains the declared secondary indexes along with
+/// the items in the same snapshot, so they are neither rebuilt on each update
+/// nor duplicate the items.
+///
+/// If most of the lookups are for missing keys, keep a cache::BloomFilter of
+/// the keys alongside the data to short-circuit those lookups.
+///
 /// @see `dump::Dumper` for more info on persistent cache dumps and
 /// corresponding config options.
 
@@ -133,6 +148,11 @@ class CachingComponentBase : public LoggableComponentBase,
   virtual std::unique_ptr<const T> ReadContents(dump::Reader& reader) const;
   /// @}
 
+  /// Override to read the deltas reported via `SetDumpDelta` and apply them
+  /// to the `contents`, see `max-delta-count` of dump::Dumper
+  virtual std::unique_ptr<const T> ReadContentsDelta(dump::Reader& reader,
+                                                     const T& contents) const;
+
  private:
   void OnAllComponentsLoaded() final;
 
@@ -140,6 +160,7 @@ class CachingComponentBase : public LoggableComponentBase,
 
   void GetAndWrite(dump::Writer& writer) const final;
   void ReadAndSet(dump::Reader& reader) final;
+  void ReadAndApplyDelta(dump::Reader& reader) final;
 
   rcu::Variable<std::shared_ptr<const T>> cache_;
   concurrent::AsyncEventChannel<const std::shared_ptr<const T>&> event_channel_;
@@ -251,6 +272,13 @@ void CachingComponentBase<T>::ReadAndSet(dump::Reader& reader) {
   Set(ReadContents(reader));
 }
 
+template <typename T>
+void CachingComponentBase<T>::ReadAndApplyDelta(dump::Reader& reader) {
+  const auto contents = GetUnsafe();
+  if (!contents) throw cache::EmptyCacheError(Name());
+  Set(ReadContentsDelta(reader, *contents));
+}
+
 template <typename T>
 void CachingComponentBase<T>::WriteContents(dump::Writer& writer,
                                             const T& contents) const {
@@ -272,6 +300,12 @@ std::unique_ptr<const T> CachingComponentBase<T>::ReadContents(
   }
 }
 
+template <typename T>
+std::unique_ptr<const T> CachingComponentBase<T>::ReadContentsDelta(
+    dump::Reader&, const T&) const {
+  dump::ThrowDumpUnimplemented(Name());
+}
+
 template <typename T>
 void CachingComponentBase<T>::OnAllComponentsLoaded() {
   AssertPeriodicUpdateStarted();
@@ -5,7 +5,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
@@ -14,7 +16,10 @@
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/shared_task_with_result.hpp>
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 
@@ -64,6 +69,7 @@ template <typename Key, typename Value, typename Hash = std::hash<Key>,
 class ExpirableLruCache final {
  public:
   using UpdateValueFunc = std::function<Value(const Key&)>;
+  using Weigher = std::function<std::size_t(const Key&, const Value&)>;
 
   /// Cache read mode
   enum class ReadMode {
@@ -89,10 +95,30 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /// Sets the policy for admitting new items into a full cache
+  void SetAdmissionPolicy(AdmissionPolicy policy);
+
+  /// Sets the function that weighs the items for SetWayMaxWeight(), e.g. by
+  /// the count of bytes they take. This method is not thread-safe.
+  void SetWeigher(Weigher weigher);
+
+  /// Bounds the total weight of the items of each way in addition to their
+  /// count, 0 disables the bound. Has no effect without SetWeigher().
+  void SetWayMaxWeight(size_t way_max_weight);
+
+  /// @returns the total weight of the items, 0 if the weight is not bounded
+  size_t GetWeightApproximate() const;
+
+  bool IsWeightBounded() const noexcept;
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent misses of the same key share a single call of update_func,
+   * that runs in a separate task. Its result or exception is returned to all
+   * of them.
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -158,13 +184,27 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  void PutToLru(const Key& key, impl::ExpirableValue<Value>&& value);
+
+  struct Load final {
+    engine::SharedTaskWithResult<Value> task;
+    ReadMode read_mode;
+  };
+
+  Load StartLoad(const Key& key, const UpdateValueFunc& update_func,
+                 ReadMode read_mode);
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<bool> is_weight_bounded_{false};
+  bool has_weigher_{false};
   impl::ExpirableLruCacheStatistics stats_;
   concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  engine::Mutex loads_mutex_;
+  std::unordered_map<Key, Load, Hash, Equal> loads_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
@@ -172,7 +212,8 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
     : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+      mutex_set_{ways, way_size, hash, equal},
+      loads_(0, hash, equal) {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -202,6 +243,45 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetAdmissionPolicy(
+    AdmissionPolicy policy) {
+  lru_.SetAdmissionPolicy(policy);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWeigher(Weigher weigher) {
+  has_weigher_ = static_cast<bool>(weigher);
+  if (!weigher) {
+    lru_.SetWeigher({});
+    return;
+  }
+  lru_.SetWeigher(
+      [weigher = std::move(weigher)](
+          const Key& key, const impl::ExpirableValue<Value>& value) {
+        return weigher(key, value.value);
+      });
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWayMaxWeight(
+    size_t way_max_weight) {
+  lru_.UpdateWayMaxWeight(way_max_weight);
+  is_weight_bounded_ = has_weigher_ && way_max_weight != 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetWeightApproximate()
+    const {
+  return lru_.GetWeight();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsWeightBounded()
+    const noexcept {
+  return is_weight_bounded_.load();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -211,20 +291,30 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
-  // Test one more time - concurrent ExpirableLruCache::Get()
-  // might have put the value
-  auto old_value = lru_.Get(key);
-  if (old_value && !IsExpired(old_value->update_time, now)) {
-    return std::move(old_value->value);
-  }
+  std::unique_lock loads_lock(loads_mutex_);
+  if (const auto it = loads_.find(key); it != loads_.end()) {
+    const auto load = it->second;
+    loads_lock.unlock();
+    impl::CacheCoalescedLoad(stats_);
 
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
+    const auto& value = load.task.Get();
+    if (read_mode == ReadMode::kUseCache &&
+        load.read_mode == ReadMode::kSkipCache) {
+      PutToLru(key, {value, now});
+    }
+    return value;
   }
-  return value;
+
+  const auto load = StartLoad(key, update_func, read_mode);
+  loads_.emplace(key, load);
+  loads_lock.unlock();
+
+  // the concurrent misses that come later start a new load
+  utils::FastScopeGuard erase_guard([this, &key]() noexcept {
+    const std::lock_guard lock(loads_mutex_);
+    loads_.erase(key);
+  });
+  return load.task.Get();
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -311,13 +401,13 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      const Value& value) {
-  lru_.Put(key, {value, utils::datetime::SteadyNow()});
+  PutToLru(key, {value, utils::datetime::SteadyNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      Value&& value) {
-  lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
+  PutToLru(key, {std::move(value), utils::datetime::SteadyNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -360,10 +450,35 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
 
     auto now = utils::datetime::SteadyNow();
     auto value = update_func(key);
-    lru_.Put(key, {value, now});
+    PutToLru(key, {value, now});
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename ExpirableLruCache<Key, Value, Hash, Equal>::Load
+ExpirableLruCache<Key, Value, Hash, Equal>::StartLoad(
+    const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
+  // the task outlives a cancelled caller if other callers wait for it
+  auto task = engine::SharedAsyncNoSpan([this, key, update_func, read_mode] {
+    auto now = utils::datetime::SteadyNow();
+    auto mutex = mutex_set_.GetMutexForKey(key);
+    std::lock_guard lock(mutex);
+    // Test one more time - a background update or a load that has just
+    // finished might have put the value
+    auto old_value = lru_.Get(key);
+    if (old_value && !IsExpired(old_value->update_time, now)) {
+      return std::move(old_value->value);
+    }
+
+    auto value = update_func(key);
+    if (read_mode == ReadMode::kUseCache) {
+      PutToLru(key, {value, now});
+    }
+    return value;
+  });
+  return {std::move(task), read_mode};
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -381,6 +496,14 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::PutToLru(
+    const Key& key, impl::ExpirableValue<Value>&& value) {
+  if (!lru_.Put(key, std::move(value))) {
+    impl::CacheAdmissionRejection(stats_);
+  }
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
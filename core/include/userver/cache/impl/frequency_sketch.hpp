@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of 4-bit counters that estimates how often a hash was
+/// recorded. All the counters are halved once the number of recorded events
+/// reaches 10 * capacity, so the estimates follow recent popularity.
+///
+/// Not thread-safe.
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity);
+
+  /// Changes the expected number of distinct items and resets the counters
+  void Resize(std::size_t capacity);
+
+  void Record(std::size_t hash) noexcept;
+
+  /// @returns frequency estimate in range [0, 15]
+  std::uint32_t Estimate(std::size_t hash) const noexcept;
+
+  void Clear() noexcept;
+
+ private:
+  void Age() noexcept;
+
+  std::vector<std::uint64_t> table_;
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,270 @@
+#pragma once
+
+/// @file userver/cache/indexed_map.hpp
+/// @brief @copybrief cache::IndexedMap
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <userver/cache/persistent_map.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// Declares a non-unique hash index of cache::IndexedMap over the key that
+/// `Extractor{}(value)` returns
+template <typename Extractor>
+struct HashIndex final {
+  using ExtractorType = Extractor;
+};
+
+/// Declares a non-unique ordered index of cache::IndexedMap over the key that
+/// `Extractor{}(value)` returns
+template <typename Extractor>
+struct OrderedIndex final {
+  using ExtractorType = Extractor;
+};
+
+namespace impl {
+
+template <typename Index, typename Key, typename Value>
+class IndexStorage;
+
+template <typename Extractor, typename Key, typename Value>
+class IndexStorage<HashIndex<Extractor>, Key, Value> final {
+ public:
+  using IndexKey =
+      std::decay_t<std::invoke_result_t<const Extractor&, const Value&>>;
+  using Group = PersistentMap<Key, std::shared_ptr<const Value>>;
+
+  const Group* Find(const IndexKey& index_key) const {
+    return groups_.Get(index_key);
+  }
+
+  const PersistentMap<IndexKey, Group>& GetGroups() const { return groups_; }
+
+  void Add(const Key& key, const std::shared_ptr<const Value>& value) {
+    const auto index_key = Extractor{}(*value);
+    const auto* group = groups_.Get(index_key);
+    auto updated = group ? *group : Group{};
+    updated.Set(key, value);
+    groups_.Set(index_key, std::move(updated));
+  }
+
+  void Remove(const Key& key, const Value& value) {
+    const auto index_key = Extractor{}(value);
+    const auto* group = groups_.Get(index_key);
+    if (!group) return;
+    if (group->size() == 1) {
+      groups_.Erase(index_key);
+      return;
+    }
+    auto updated = *group;
+    updated.Erase(key);
+    groups_.Set(index_key, std::move(updated));
+  }
+
+  void Clear() noexcept { groups_.Clear(); }
+
+ private:
+  PersistentMap<IndexKey, Group> groups_;
+};
+
+template <typename Extractor, typename Key, typename Value>
+class IndexStorage<OrderedIndex<Extractor>, Key, Value> final {
+ public:
+  using IndexKey =
+      std::decay_t<std::invoke_result_t<const Extractor&, const Value&>>;
+  using Group = PersistentMap<Key, std::shared_ptr<const Value>>;
+
+  const Group* Find(const IndexKey& index_key) const {
+    const auto it = groups_.find(index_key);
+    return it == groups_.end() ? nullptr : &it->second;
+  }
+
+  const std::map<IndexKey, Group>& GetGroups() const { return groups_; }
+
+  void Add(const Key& key, const std::shared_ptr<const Value>& value) {
+    groups_[Extractor{}(*value)].Set(key, value);
+  }
+
+  void Remove(const Key& key, const Value& value) {
+    const auto it = groups_.find(Extractor{}(value));
+    if (it == groups_.end()) return;
+    it->second.Erase(key);
+    if (it->second.empty()) groups_.erase(it);
+  }
+
+  void Clear() noexcept { groups_.clear(); }
+
+ private:
+  std::map<IndexKey, Group> groups_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_containers
+///
+/// @brief cache::PersistentMap with secondary indexes maintained along with
+/// the items.
+///
+/// Each of the `Indexes` is a cache::HashIndex or a cache::OrderedIndex, and
+/// is looked up by its extractor type. An index maps each of its keys to the
+/// group of the items with that key, so the indexes may be non-unique.
+///
+/// Set() and Erase() update the indexes in O(log N) each, so an incremental
+/// update of components::CachingComponentBase copies the current snapshot,
+/// applies the delta and Set()s the result instead of rebuilding the lookup
+/// maps from scratch. The items are stored once and shared by the copies and
+/// by all the indexes. Copying is O(1) for the primary map and for the hash
+/// indexes, and O(distinct keys) for an ordered index.
+///
+/// The extractors must be default constructible and must return the same
+/// index key for the same value.
+///
+/// @snippet cache/indexed_map_test.cpp  Sample IndexedMap declaration
+/// @snippet cache/indexed_map_test.cpp  Sample IndexedMap
+template <typename Key, typename Value, typename... Indexes>
+class IndexedMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using ValuePtr = std::shared_ptr<const Value>;
+  /// Items that have the same index key
+  using Group = PersistentMap<Key, ValuePtr>;
+
+  using const_iterator = typename Group::const_iterator;
+  using iterator = const_iterator;
+
+  std::size_t size() const noexcept { return items_.size(); }
+  bool empty() const noexcept { return items_.empty(); }
+
+  /// @returns pointer to the value or nullptr if there's no such key
+  const Value* Get(const Key& key) const {
+    const auto* value = items_.Get(key);
+    return value ? value->get() : nullptr;
+  }
+
+  /// @returns the shared value or nullptr if there's no such key
+  ValuePtr GetShared(const Key& key) const {
+    const auto* value = items_.Get(key);
+    return value ? *value : nullptr;
+  }
+
+  bool Contains(const Key& key) const { return items_.Contains(key); }
+
+  /// Adds or replaces the value, updating the indexes
+  void Set(const Key& key, Value value);
+
+  /// @returns true if the key was present
+  bool Erase(const Key& key);
+
+  void Clear() noexcept {
+    items_.Clear();
+    std::apply([](auto&... indexes) { (indexes.Clear(), ...); }, indexes_);
+  }
+
+  /// @returns the items with the index key of the `Extractor` index or
+  /// nullptr if there are none
+  template <typename Extractor, typename IndexKey>
+  const Group* Find(const IndexKey& index_key) const {
+    return GetIndex<Extractor>().Find(index_key);
+  }
+
+  /// @returns the map from the index keys to the groups of items: a
+  /// cache::PersistentMap for a hash index, an std::map for an ordered one
+  /// (e.g. for range lookups)
+  template <typename Extractor>
+  const auto& GetGroups() const {
+    return GetIndex<Extractor>().GetGroups();
+  }
+
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+
+ private:
+  template <typename Extractor>
+  static constexpr std::size_t IndexOf() {
+    constexpr std::array<bool, sizeof...(Indexes)> matches{
+        std::is_same_v<typename Indexes::ExtractorType, Extractor>...};
+    std::size_t result = matches.size();
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+      if (matches[i]) {
+        if (result != matches.size()) return matches.size();
+        result = i;
+      }
+    }
+    return result;
+  }
+
+  template <typename Extractor>
+  const auto& GetIndex() const {
+    constexpr auto kIndex = IndexOf<Extractor>();
+    static_assert(kIndex < sizeof...(Indexes),
+                  "IndexedMap must declare exactly one index with the "
+                  "Extractor");
+    return std::get<kIndex>(indexes_);
+  }
+
+  Group items_;
+  std::tuple<impl::IndexStorage<Indexes, Key, Value>...> indexes_;
+};
+
+template <typename Key, typename Value, typename... Indexes>
+void IndexedMap<Key, Value, Indexes...>::Set(const Key& key, Value value) {
+  if (const auto* old = items_.Get(key)) {
+    const auto& old_value = **old;
+    std::apply(
+        [&](auto&... indexes) { (indexes.Remove(key, old_value), ...); },
+        indexes_);
+  }
+
+  auto shared = std::make_shared<const Value>(std::move(value));
+  std::apply([&](auto&... indexes) { (indexes.Add(key, shared), ...); },
+             indexes_);
+  items_.Set(key, std::move(shared));
+}
+
+template <typename Key, typename Value, typename... Indexes>
+bool IndexedMap<Key, Value, Indexes...>::Erase(const Key& key) {
+  const auto old = GetShared(key);
+  if (!old) return false;
+
+  std::apply([&](auto&... indexes) { (indexes.Remove(key, *old), ...); },
+             indexes_);
+  return items_.Erase(key);
+}
+
+template <typename Key, typename Value, typename... Indexes>
+void Write(dump::Writer& writer,
+           const IndexedMap<Key, Value, Indexes...>& map) {
+  writer.Write(map.size());
+  for (const auto& [key, value] : map) {
+    writer.Write(key);
+    writer.Write(*value);
+  }
+}
+
+template <typename Key, typename Value, typename... Indexes>
+IndexedMap<Key, Value, Indexes...> Read(
+    dump::Reader& reader, dump::To<IndexedMap<Key, Value, Indexes...>>) {
+  IndexedMap<Key, Value, Indexes...> map;
+  const auto size = reader.Read<std::size_t>();
+  for (std::size_t i = 0; i < size; ++i) {
+    auto key = reader.Read<Key>();
+    auto value = reader.Read<Value>();
+    map.Set(key, std::move(value));
+  }
+  return map;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
+#include <userver/dump/dumped_size.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/meta.hpp>
 #include <userver/dump/operations.hpp>
@@ -22,13 +23,16 @@ namespace cache {
 namespace impl {
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size);
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::optional<std::size_t> bytes_used = std::nullopt);
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 formats::json::Value GetCacheStatisticsAsJson(
     const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
+  std::optional<std::size_t> bytes_used;
+  if (cache.IsWeightBounded()) bytes_used = cache.GetWeightApproximate();
   return GetCacheStatisticsAsJson(cache.GetStatistics(),
-                                  cache.GetSizeApproximate());
+                                  cache.GetSizeApproximate(), bytes_used);
 }
 
 testsuite::ComponentControl& FindComponentControl(
@@ -65,9 +69,16 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
+/// size-bytes | max total size of the items to store in cache, 0 for no limit | 0
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// admission-policy | `none` for plain LRU or `tinylfu` to protect frequently used items from scans, see cache::AdmissionPolicy | none
+///
+/// The size of an item for `size-bytes` is the size of its dump for the
+/// dumpable keys and values, see dump::GetDumpedSize, and
+/// `sizeof(Key) + sizeof(Value)` otherwise. To weigh the items differently
+/// call `GetCacheRaw()->SetWeigher()` in the constructor of the component.
 ///
 /// ## Example usage:
 ///
@@ -110,6 +121,8 @@ class LruCacheComponent : public components::LoggableComponentBase,
 
   void UpdateConfig(const LruCacheConfig& config);
 
+  static std::size_t GetDefaultWeight(const Key& key, const Value& value);
+
   static constexpr bool kCacheIsDumpable =
       dump::kIsDumpable<Key> && dump::kIsDumpable<Value>;
 
@@ -138,6 +151,10 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
                                      static_config_.GetWaySize())) {
+  cache_->SetWeigher(&GetDefaultWeight);
+  cache_->SetWayMaxWeight(
+      static_config_.config.GetWayMaxWeight(static_config_.ways));
+
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -147,6 +164,7 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetAdmissionPolicy(static_config_.config.admission_policy);
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -215,8 +233,20 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
     const LruCacheConfig& config) {
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
+  cache_->SetWayMaxWeight(config.GetWayMaxWeight(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetAdmissionPolicy(config.admission_policy);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t LruCacheComponent<Key, Value, Hash, Equal>::GetDefaultWeight(
+    const Key& key, const Value& value) {
+  if constexpr (kCacheIsDumpable) {
+    return dump::GetDumpedSize(key) + dump::GetDumpedSize(value);
+  } else {
+    return sizeof(Key) + sizeof(Value);
+  }
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/admission_policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -27,9 +28,15 @@ struct LruCacheConfig final {
 
   std::size_t GetWaySize(std::size_t ways) const;
 
+  /// @returns the max weight of a way, 0 if the weight is not bounded
+  std::size_t GetWayMaxWeight(std::size_t ways) const;
+
   std::size_t size;
+  /// The max total weight of the items, 0 for no bound
+  std::size_t size_bytes;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  AdmissionPolicy admission_policy;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
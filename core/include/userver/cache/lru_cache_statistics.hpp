@@ -15,6 +15,8 @@ struct ExpirableLruCacheStatisticsBase final {
   std::atomic<std::size_t> misses{0};
   std::atomic<std::size_t> stale{0};
   std::atomic<std::size_t> background_updates{0};
+  std::atomic<std::size_t> admission_rejections{0};
+  std::atomic<std::size_t> coalesced_loads{0};
 
   ExpirableLruCacheStatisticsBase();
 
@@ -39,6 +41,10 @@ void CacheMiss(ExpirableLruCacheStatistics& stats);
 
 void CacheStale(ExpirableLruCacheStatistics& stats);
 
+void CacheAdmissionRejection(ExpirableLruCacheStatistics& stats);
+
+void CacheCoalescedLoad(ExpirableLruCacheStatistics& stats);
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,342 @@
+#pragma once
+
+/// @file userver/cache/nway_clock_lru_cache.hpp
+/// @brief @copybrief cache::NWayClockLRU
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/dumper.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief N-way cache with the same interface as cache::NWayLRU, but with
+/// readers that never lock.
+///
+/// Each way keeps its items in an rcu::Variable, so Get() and GetOr() only
+/// take a hazard pointer and set an atomic "referenced" bit of the found item.
+/// Eviction uses the CLOCK approximation of LRU: the clock hand skips (and
+/// clears) referenced items and evicts the first unreferenced one.
+///
+/// Writes (Put, InvalidateByKey, failed validation in Get) copy the whole way,
+/// so their cost is O(way_size). Prefer this cache over cache::NWayLRU for
+/// read-mostly workloads and use more, smaller ways than you would with
+/// cache::NWayLRU.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class NWayClockLRU final {
+ public:
+  NWayClockLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
+               const Equal& equal = Equal());
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  std::optional<U> Get(const T& key) {
+    return Get(key, [](const U&) { return true; });
+  }
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Invalidate();
+
+  void InvalidateByKey(const T& key);
+
+  /// Iterates over all items. May be slow for big caches.
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  size_t GetSize() const;
+
+  void UpdateWaySize(size_t way_size);
+
+  void Write(dump::Writer& writer) const;
+  void Read(dump::Reader& reader);
+
+  /// The dump::Dumper will be notified of any cache updates. This method is not
+  /// thread-safe.
+  void SetDumper(std::shared_ptr<dump::Dumper> dumper);
+
+ private:
+  struct Entry {
+    explicit Entry(U value) : value(std::move(value)) {}
+
+    const U value;
+    mutable std::atomic<bool> referenced{false};
+  };
+
+  using Map = std::unordered_map<T, std::shared_ptr<const Entry>, Hash, Equal>;
+
+  struct Way {
+    Way(const Hash& hash, const Equal& equal)
+        : map(rcu::DestructionType::kSync, 0, hash, equal) {}
+
+    rcu::Variable<Map> map;
+
+    // Protects the fields below and serializes writers of `map`
+    mutable engine::Mutex mutex;
+    std::vector<T> clock;
+    size_t hand{0};
+    size_t max_size{0};
+  };
+
+  Way& GetWay(const T& key);
+
+  // Both must be called with way.mutex held
+  static void EvictOne(Way& way, Map& map);
+  void EraseFromClock(Way& way, const T& key) const;
+
+  void EraseIfSame(Way& way, const T& key, const Entry* entry);
+
+  void NotifyDumper();
+
+  utils::FixedArray<Way> caches_;
+  Hash hash_fn_;
+  Equal equal_fn_;
+  std::shared_ptr<dump::Dumper> dumper_{nullptr};
+};
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayClockLRU<T, U, Hash, Eq>::NWayClockLRU(size_t ways, size_t way_size,
+                                           const Hash& hash, const Eq& equal)
+    : caches_(ways, hash, equal), hash_fn_(hash), equal_fn_(equal) {
+  if (ways == 0) throw std::logic_error("Ways must be positive");
+
+  for (auto& way : caches_) {
+    way.max_size = way_size;
+    way.clock.reserve(way_size);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+  auto& way = GetWay(key);
+  {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    if (way.max_size == 0) return;
+
+    auto map = way.map.StartWrite();
+    auto entry = std::make_shared<const Entry>(std::move(value));
+    auto it = map->find(key);
+    if (it != map->end()) {
+      it->second = std::move(entry);
+    } else {
+      if (map->size() >= way.max_size) EvictOne(way, *map);
+      map->emplace(key, std::move(entry));
+      way.clock.push_back(key);
+    }
+    map.Commit();
+  }
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> NWayClockLRU<T, U, Hash, Eq>::Get(const T& key,
+                                                   Validator validator) {
+  auto& way = GetWay(key);
+  std::shared_ptr<const Entry> entry;
+  {
+    const auto map = way.map.Read();
+    const auto it = map->find(key);
+    if (it == map->end()) return std::nullopt;
+
+    // Writing only when the bit is unset keeps hot items' cache lines shared
+    if (!it->second->referenced.load(std::memory_order_relaxed)) {
+      it->second->referenced.store(true, std::memory_order_relaxed);
+    }
+    if (validator(it->second->value)) return it->second->value;
+
+    entry = it->second;
+  }
+
+  EraseIfSame(way, key, entry.get());
+  return std::nullopt;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  EraseIfSame(GetWay(key), key, nullptr);
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U NWayClockLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+  auto result = Get(key);
+  if (result) return std::move(*result);
+  return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::Invalidate() {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    auto map = way.map.StartWrite();
+    map->clear();
+    map.Commit();
+    way.clock.clear();
+    way.hand = 0;
+  }
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void NWayClockLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
+  for (const auto& way : caches_) {
+    const auto map = way.map.Read();
+    for (const auto& [key, entry] : *map) func(key, entry->value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayClockLRU<T, U, Hash, Eq>::GetSize() const {
+  size_t size{0};
+  for (const auto& way : caches_) {
+    const auto map = way.map.Read();
+    size += map->size();
+  }
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.max_size = way_size;
+    if (way.clock.size() <= way_size) continue;
+
+    auto map = way.map.StartWrite();
+    while (map->size() > way_size) EvictOne(way, *map);
+    map.Commit();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayClockLRU<T, U, Hash, Eq>::Way&
+NWayClockLRU<T, U, Hash, Eq>::GetWay(const T& key) {
+  auto n = hash_fn_(key) % caches_.size();
+  return caches_[n];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::EvictOne(Way& way, Map& map) {
+  UASSERT(!way.clock.empty());
+  UASSERT(way.clock.size() == map.size());
+
+  // Terminates in at most two rounds: the first one clears all the bits
+  while (true) {
+    if (way.hand >= way.clock.size()) way.hand = 0;
+
+    auto it = map.find(way.clock[way.hand]);
+    UASSERT(it != map.end());
+    if (it->second->referenced.exchange(false, std::memory_order_relaxed)) {
+      ++way.hand;
+      continue;
+    }
+
+    map.erase(it);
+    way.clock[way.hand] = std::move(way.clock.back());
+    way.clock.pop_back();
+    return;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::EraseFromClock(Way& way,
+                                                  const T& key) const {
+  // Keys are unique in the clock, a linear scan is fine as the map copy on
+  // write is O(way_size) anyway
+  for (size_t i = 0; i < way.clock.size(); ++i) {
+    if (equal_fn_(way.clock[i], key)) {
+      way.clock[i] = std::move(way.clock.back());
+      way.clock.pop_back();
+      return;
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockLRU<T, U, Hash, Eq>::EraseIfSame(Way& way, const T& key,
+                                               const Entry* entry) {
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+
+  {
+    // Avoid copying the way if the item is already gone or was replaced
+    const auto map = way.map.Read();
+    const auto it = map->find(key);
+    if (it == map->end()) return;
+    if (entry && it->second.get() != entry) return;
+  }
+
+  auto map = way.map.StartWrite();
+  map->erase(key);
+  map.Commit();
+  EraseFromClock(way, key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayClockLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+  writer.Write(caches_.size());
+
+  for (const Way& way : caches_) {
+    const auto map = way.map.Read();
+
+    writer.Write(map->size());
+
+    for (const auto& [key, entry] : *map) {
+      writer.Write(key);
+      writer.Write(entry->value);
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayClockLRU<T, U, Hash, Equal>::Read(dump::Reader& reader) {
+  Invalidate();
+
+  const auto ways = reader.Read<std::size_t>();
+  for (std::size_t i = 0; i < ways; ++i) {
+    const auto elements_in_way = reader.Read<std::size_t>();
+    for (std::size_t j = 0; j < elements_in_way; ++j) {
+      auto key = reader.Read<T>();
+      auto value = reader.Read<U>();
+      Put(std::move(key), std::move(value));
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayClockLRU<T, U, Hash, Equal>::NotifyDumper() {
+  if (dumper_ != nullptr) {
+    dumper_->OnUpdateCompleted();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayClockLRU<T, U, Hash, Equal>::SetDumper(
+    std::shared_ptr<dump::Dumper> dumper) {
+  dumper_ = std::move(dumper);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
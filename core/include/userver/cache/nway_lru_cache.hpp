@@ -1,13 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <optional>
 #include <vector>
 
+#include <userver/cache/admission_policy.hpp>
+#include <userver/cache/impl/frequency_sketch.hpp>
 #include <userver/cache/lru_map.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/utils/hash.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,10 +22,16 @@ template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class NWayLRU final {
  public:
+  /// Returns the weight of an item, e.g. the count of bytes it takes
+  using Weigher = std::function<std::size_t(const T& key, const U& value)>;
+
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
           const Equal& equal = Equal());
 
-  void Put(const T& key, U value);
+  /// @returns false if the admission policy rejected an item to make room
+  /// for the new one, or if the item alone outweighs the way. The rejected
+  /// item is not necessarily `key`.
+  bool Put(const T& key, U value);
 
   template <typename Validator>
   std::optional<U> Get(const T& key, Validator validator);
@@ -44,6 +54,20 @@ class NWayLRU final {
 
   void UpdateWaySize(size_t way_size);
 
+  /// Sets the function that weighs the items for UpdateWayMaxWeight(). This
+  /// method is not thread-safe.
+  void SetWeigher(Weigher weigher);
+
+  /// Bounds the total weight of the items of each way in addition to their
+  /// count, evicting the least used items once the weight is exceeded. 0
+  /// disables the bound and stops weighing the items.
+  void UpdateWayMaxWeight(size_t way_max_weight);
+
+  /// @returns the total weight of the items, 0 if the weight is not bounded
+  size_t GetWeight() const;
+
+  void SetAdmissionPolicy(AdmissionPolicy policy);
+
   void Write(dump::Writer& writer) const;
   void Read(dump::Reader& reader);
 
@@ -53,21 +77,56 @@ class NWayLRU final {
 
  private:
   struct Way {
-    Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
+    Way(Way&& other) noexcept
+        : cache(std::move(other.cache)),
+          window(std::move(other.window)),
+          sketch(std::move(other.sketch)),
+          policy(other.policy),
+          way_size(other.way_size),
+          weight(other.weight),
+          max_weight(other.max_weight) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(const Hash& hash, const Equal& equal)
+        : cache(1, hash, equal), window(1, hash, equal), sketch(1) {}
 
     mutable engine::Mutex mutex;
     LruMap<T, U, Hash, Equal> cache;
+
+    // Used only with AdmissionPolicy::kTinyLfu
+    LruMap<T, U, Hash, Equal> window;
+    impl::FrequencySketch sketch;
+
+    AdmissionPolicy policy{AdmissionPolicy::kNone};
+    size_t way_size{1};
+
+    // Used only if max_weight is non-zero
+    size_t weight{0};
+    size_t max_weight{0};
   };
 
   Way& GetWay(const T& key);
 
+  // The functions below must be called with way.mutex held
+  static void ApplyLimits(Way& way);
+  static size_t GetWindowSize(size_t way_size);
+  static size_t GetMainSize(size_t way_size);
+  bool PutTinyLfu(Way& way, const T& key, U value);
+
+  bool IsWeighted(const Way& way) const;
+  size_t Weigh(const T& key, const U& value) const;
+  void AddWeight(Way& way, const T& key, const U& value) const;
+  void SubtractWeight(Way& way, const T& key, const U& value) const;
+  void Replace(Way& way, const T& key, U& existing, U value) const;
+  void EvictLeastUsed(Way& way, LruMap<T, U, Hash, Equal>& map) const;
+  void ApplyMaxWeight(Way& way) const;
+  void RecalculateWeight(Way& way) const;
+
   void NotifyDumper();
 
   std::vector<Way> caches_;
   Hash hash_fn_;
+  Weigher weigher_;
   std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
@@ -79,17 +138,46 @@ NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
   for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches_) {
+    way.way_size = way_size;
+    ApplyLimits(way);
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
-void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+bool NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
+  bool admitted = true;
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+    if (IsWeighted(way) && Weigh(key, value) > way.max_weight) {
+      if (auto* existing = way.cache.Get(key)) {
+        SubtractWeight(way, key, *existing);
+        way.cache.Erase(key);
+      } else if (auto* existing = way.window.Get(key)) {
+        SubtractWeight(way, key, *existing);
+        way.window.Erase(key);
+      }
+      admitted = false;
+    } else if (way.policy == AdmissionPolicy::kTinyLfu) {
+      admitted = PutTinyLfu(way, key, std::move(value));
+    } else if (IsWeighted(way)) {
+      if (auto* existing = way.cache.Get(key)) {
+        Replace(way, key, *existing, std::move(value));
+      } else {
+        if (way.cache.GetSize() >= way.way_size) {
+          EvictLeastUsed(way, way.cache);
+        }
+        AddWeight(way, key, value);
+        way.cache.Put(key, std::move(value));
+      }
+    } else {
+      way.cache.Put(key, std::move(value));
+    }
+    ApplyMaxWeight(way);
   }
   NotifyDumper();
+  return admitted;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -100,9 +188,16 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
   std::unique_lock<engine::Mutex> lock(way.mutex);
   auto* value = way.cache.Get(key);
 
+  if (way.policy == AdmissionPolicy::kTinyLfu) {
+    way.sketch.Record(hash_fn_(key));
+    if (!value) value = way.window.Get(key);
+  }
+
   if (value) {
     if (validator(*value)) return *value;
+    SubtractWeight(way, key, *value);
     way.cache.Erase(key);
+    way.window.Erase(key);
   }
 
   return std::nullopt;
@@ -113,16 +208,22 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
+    if (IsWeighted(way)) {
+      auto* value = way.cache.Get(key);
+      if (!value) value = way.window.Get(key);
+      if (value) SubtractWeight(way, key, *value);
+    }
     way.cache.Erase(key);
+    way.window.Erase(key);
   }
   NotifyDumper();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
-  auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  auto value = Get(key);
+  if (value) return std::move(*value);
+  return default_value;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -130,6 +231,9 @@ void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.Clear();
+    way.window.Clear();
+    way.sketch.Clear();
+    way.weight = 0;
   }
   NotifyDumper();
 }
@@ -140,6 +244,7 @@ void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.VisitAll(func);
+    way.window.VisitAll(func);
   }
 }
 
@@ -148,7 +253,7 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    size += way.cache.GetSize() + way.window.GetSize();
   }
   return size;
 }
@@ -157,14 +262,191 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    if (way.way_size == way_size) continue;
+    way.way_size = way_size;
+    ApplyLimits(way);
+    if (way.policy == AdmissionPolicy::kTinyLfu) way.sketch.Resize(way_size);
+    RecalculateWeight(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SetWeigher(Weigher weigher) {
+  weigher_ = std::move(weigher);
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    RecalculateWeight(way);
+    ApplyMaxWeight(way);
   }
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdateWayMaxWeight(size_t way_max_weight) {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    if (way.max_weight == way_max_weight) continue;
+    way.max_weight = way_max_weight;
+    RecalculateWeight(way);
+    ApplyMaxWeight(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetWeight() const {
+  size_t weight{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    weight += way.weight;
+  }
+  return weight;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SetAdmissionPolicy(AdmissionPolicy policy) {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    if (way.policy == policy) continue;
+    way.policy = policy;
+
+    if (policy == AdmissionPolicy::kTinyLfu) {
+      way.sketch.Resize(way.way_size);
+      ApplyLimits(way);
+    } else {
+      ApplyLimits(way);
+      way.window.VisitAll(
+          [&way](const T& key, const U& value) { way.cache.Put(key, value); });
+      way.window.Clear();
+      way.sketch.Resize(1);
+    }
+    RecalculateWeight(way);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::ApplyLimits(Way& way) {
+  if (way.policy != AdmissionPolicy::kTinyLfu) {
+    way.cache.SetMaxSize(way.way_size);
+    return;
+  }
+
+  way.window.SetMaxSize(GetWindowSize(way.way_size));
+  way.cache.SetMaxSize(GetMainSize(way.way_size));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetWindowSize(size_t way_size) {
+  // 1% of the capacity, as recommended by the W-TinyLFU paper
+  return std::max<size_t>(way_size / 100, 1);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetMainSize(size_t way_size) {
+  const auto window_size = GetWindowSize(way_size);
+  return way_size > window_size ? way_size - window_size : 1;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+bool NWayLRU<T, U, Hash, Eq>::PutTinyLfu(Way& way, const T& key, U value) {
+  if (auto* existing = way.cache.Get(key)) {
+    Replace(way, key, *existing, std::move(value));
+    return true;
+  }
+  if (auto* existing = way.window.Get(key)) {
+    Replace(way, key, *existing, std::move(value));
+    return true;
+  }
+
+  bool admitted = true;
+  if (way.window.GetSize() >= GetWindowSize(way.way_size)) {
+    // The window is full, its LRU item competes with the main LRU victim
+    T candidate = *way.window.GetLeastUsedKey();
+    const bool is_main_full = way.cache.GetSize() >= GetMainSize(way.way_size);
+    if (is_main_full) {
+      const auto* victim = way.cache.GetLeastUsedKey();
+      admitted = way.sketch.Estimate(hash_fn_(candidate)) >
+                 way.sketch.Estimate(hash_fn_(*victim));
+    }
+    if (admitted) {
+      if (is_main_full) EvictLeastUsed(way, way.cache);
+      way.cache.Put(candidate, std::move(*way.window.GetLeastUsed()));
+    } else {
+      SubtractWeight(way, candidate, *way.window.GetLeastUsed());
+    }
+    way.window.Erase(candidate);
+  }
+
+  AddWeight(way, key, value);
+  way.window.Put(key, std::move(value));
+  return admitted;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+bool NWayLRU<T, U, Hash, Eq>::IsWeighted(const Way& way) const {
+  return way.max_weight != 0 && weigher_;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::Weigh(const T& key, const U& value) const {
+  return weigher_(key, value);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::AddWeight(Way& way, const T& key,
+                                        const U& value) const {
+  if (IsWeighted(way)) way.weight += Weigh(key, value);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SubtractWeight(Way& way, const T& key,
+                                             const U& value) const {
+  if (IsWeighted(way)) way.weight -= std::min(way.weight, Weigh(key, value));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::Replace(Way& way, const T& key, U& existing,
+                                      U value) const {
+  SubtractWeight(way, key, existing);
+  existing = std::move(value);
+  AddWeight(way, key, existing);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::EvictLeastUsed(
+    Way& way, LruMap<T, U, Hash, Eq>& map) const {
+  const auto* key = map.GetLeastUsedKey();
+  if (!key) return;
+  T victim = *key;
+  SubtractWeight(way, victim, *map.GetLeastUsed());
+  map.Erase(victim);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::ApplyMaxWeight(Way& way) const {
+  if (!IsWeighted(way)) return;
+  // the most recently put item is the last to go
+  while (way.weight > way.max_weight &&
+         way.cache.GetSize() + way.window.GetSize() > 1) {
+    EvictLeastUsed(way, way.cache.GetSize() != 0 ? way.cache : way.window);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::RecalculateWeight(Way& way) const {
+  way.weight = 0;
+  if (!IsWeighted(way)) return;
+  const auto add = [this, &way](const T& key, const U& value) {
+    way.weight += Weigh(key, value);
+  };
+  way.cache.VisitAll(add);
+  way.window.VisitAll(add);
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
-  auto n = hash_fn_(key) % caches_.size();
+  // The same hash is used by the maps of the way, so it is mixed to keep
+  // them from getting only the keys with equal hash remainders.
+  auto n = utils::HashMix(hash_fn_(key)) % caches_.size();
   return caches_[n];
 }
 
@@ -175,12 +457,14 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   for (const Way& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+    writer.Write(way.cache.GetSize() + way.window.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
+    const auto write_item = [&writer](const T& key, const U& value) {
       writer.Write(key);
       writer.Write(value);
-    });
+    };
+    way.cache.VisitAll(write_item);
+    way.window.VisitAll(write_item);
   }
 }
 
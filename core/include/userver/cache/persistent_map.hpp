@@ -0,0 +1,385 @@
+#pragma once
+
+/// @file userver/cache/persistent_map.hpp
+/// @brief @copybrief cache::PersistentMap
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Immutable-friendly hash map with structural sharing (a hash array
+/// mapped trie).
+///
+/// Copying a PersistentMap is O(1): the copies share all the nodes. Set() and
+/// Erase() copy only the O(log32 N) nodes on the path to the modified item,
+/// so a modified copy costs O(delta) memory instead of O(N).
+///
+/// Designed for components::CachingComponentBase: an incremental update
+/// copies the current snapshot, applies the delta and Set()s the result,
+/// while readers keep using the previous snapshot.
+///
+/// Iteration order is unspecified. Thread safety matches Standard Library
+/// thread safety; distinct copies may be used concurrently.
+///
+/// @snippet cache/persistent_map_test.cpp  Sample PersistentMap
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  explicit PersistentMap(const Hash& hash = Hash(),
+                         const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// @returns pointer to the value or nullptr if there's no such key
+  const Value* Get(const Key& key) const;
+
+  bool Contains(const Key& key) const { return Get(key) != nullptr; }
+
+  /// Adds or replaces the value
+  void Set(const Key& key, Value value);
+
+  /// @returns true if the key was present
+  bool Erase(const Key& key);
+
+  void Clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  const_iterator begin() const { return const_iterator(root_.get()); }
+  const_iterator end() const { return const_iterator(); }
+
+ private:
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  static constexpr unsigned kBitsPerLevel = 5;
+  static constexpr std::size_t kMaxDepth =
+      std::numeric_limits<std::size_t>::digits / kBitsPerLevel + 2;
+
+  // A leaf if items are not empty, a branch otherwise
+  struct Node final {
+    // branch
+    std::uint32_t bitmap{0};
+    std::vector<NodePtr> children;
+
+    // leaf, all the items have the same full hash
+    std::size_t hash{0};
+    std::vector<value_type> items;
+
+    bool IsLeaf() const noexcept { return !items.empty(); }
+
+    std::size_t Size() const noexcept {
+      return IsLeaf() ? items.size() : children.size();
+    }
+  };
+
+  static std::uint32_t GetBit(std::size_t hash, unsigned shift) noexcept {
+    UASSERT(shift < std::numeric_limits<std::size_t>::digits);
+    return std::uint32_t{1} << ((hash >> shift) & ((1u << kBitsPerLevel) - 1));
+  }
+
+  static std::size_t GetPosition(std::uint32_t bitmap,
+                                 std::uint32_t bit) noexcept {
+    return __builtin_popcount(bitmap & (bit - 1));
+  }
+
+  static NodePtr MakeLeaf(std::size_t hash, const Key& key, Value&& value);
+
+  NodePtr Insert(const NodePtr& node, std::size_t hash, unsigned shift,
+                 const Key& key, Value&& value, bool& added) const;
+
+  NodePtr Remove(const NodePtr& node, std::size_t hash, unsigned shift,
+                 const Key& key, bool& erased) const;
+
+  NodePtr root_;
+  std::size_t size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename PersistentMap::value_type;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    UASSERT(depth_ > 0);
+    const auto& frame = stack_[depth_ - 1];
+    return frame.node->items[frame.index];
+  }
+
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    Advance();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto copy = *this;
+    Advance();
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    if (depth_ != other.depth_) return false;
+    if (depth_ == 0) return true;
+    const auto& lhs = stack_[depth_ - 1];
+    const auto& rhs = other.stack_[depth_ - 1];
+    return lhs.node == rhs.node && lhs.index == rhs.index;
+  }
+
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentMap;
+
+  struct Frame {
+    const Node* node{nullptr};
+    std::size_t index{0};
+  };
+
+  explicit const_iterator(const Node* root) {
+    if (!root) return;
+    stack_[depth_++] = {root, 0};
+    Descend();
+  }
+
+  void Descend() {
+    while (!stack_[depth_ - 1].node->IsLeaf()) {
+      const auto& frame = stack_[depth_ - 1];
+      UASSERT(depth_ < kMaxDepth);
+      stack_[depth_++] = {frame.node->children[frame.index].get(), 0};
+    }
+  }
+
+  void Advance() {
+    UASSERT(depth_ > 0);
+    ++stack_[depth_ - 1].index;
+    while (stack_[depth_ - 1].index >= stack_[depth_ - 1].node->Size()) {
+      if (--depth_ == 0) return;
+      ++stack_[depth_ - 1].index;
+    }
+    Descend();
+  }
+
+  std::array<Frame, kMaxDepth> stack_{};
+  std::size_t depth_{0};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value* PersistentMap<Key, Value, Hash, Equal>::Get(
+    const Key& key) const {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+  unsigned shift = 0;
+
+  while (node) {
+    if (node->IsLeaf()) {
+      if (node->hash != hash) return nullptr;
+      for (const auto& item : node->items) {
+        if (equal_(item.first, key)) return &item.second;
+      }
+      return nullptr;
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (!(node->bitmap & bit)) return nullptr;
+    node = node->children[GetPosition(node->bitmap, bit)].get();
+    shift += kBitsPerLevel;
+  }
+
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentMap<Key, Value, Hash, Equal>::Set(const Key& key, Value value) {
+  bool added = false;
+  root_ = Insert(root_, hash_(key), 0, key, std::move(value), added);
+  if (added) ++size_;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::Erase(const Key& key) {
+  bool erased = false;
+  root_ = Remove(root_, hash_(key), 0, key, erased);
+  if (erased) --size_;
+  return erased;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::MakeLeaf(std::size_t hash,
+                                                      const Key& key,
+                                                      Value&& value)
+    -> NodePtr {
+  auto leaf = std::make_shared<Node>();
+  leaf->hash = hash;
+  leaf->items.emplace_back(key, std::move(value));
+  return leaf;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::Insert(
+    const NodePtr& node, std::size_t hash, unsigned shift, const Key& key,
+    Value&& value, bool& added) const -> NodePtr {
+  if (!node) {
+    added = true;
+    return MakeLeaf(hash, key, std::move(value));
+  }
+
+  if (node->IsLeaf()) {
+    if (node->hash == hash) {
+      auto leaf = std::make_shared<Node>(*node);
+      for (auto& item : leaf->items) {
+        if (equal_(item.first, key)) {
+          item.second = std::move(value);
+          return leaf;
+        }
+      }
+      leaf->items.emplace_back(key, std::move(value));
+      added = true;
+      return leaf;
+    }
+
+    // Different hashes, push the leaf one level down and retry
+    auto branch = std::make_shared<Node>();
+    branch->bitmap = GetBit(node->hash, shift);
+    branch->children.push_back(node);
+    return Insert(branch, hash, shift, key, std::move(value), added);
+  }
+
+  const auto bit = GetBit(hash, shift);
+  const auto pos = GetPosition(node->bitmap, bit);
+
+  auto branch = std::make_shared<Node>();
+  branch->bitmap = node->bitmap | bit;
+  branch->children = node->children;
+  if (node->bitmap & bit) {
+    branch->children[pos] =
+        Insert(node->children[pos], hash, shift + kBitsPerLevel, key,
+               std::move(value), added);
+  } else {
+    branch->children.insert(branch->children.begin() + pos,
+                            MakeLeaf(hash, key, std::move(value)));
+    added = true;
+  }
+  return branch;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::Remove(const NodePtr& node,
+                                                    std::size_t hash,
+                                                    unsigned shift,
+                                                    const Key& key,
+                                                    bool& erased) const
+    -> NodePtr {
+  if (!node) return node;
+
+  if (node->IsLeaf()) {
+    if (node->hash != hash) return node;
+
+    for (std::size_t i = 0; i < node->items.size(); ++i) {
+      if (!equal_(node->items[i].first, key)) continue;
+
+      erased = true;
+      if (node->items.size() == 1) return nullptr;
+
+      auto leaf = std::make_shared<Node>(*node);
+      leaf->items.erase(leaf->items.begin() + i);
+      return leaf;
+    }
+    return node;
+  }
+
+  const auto bit = GetBit(hash, shift);
+  if (!(node->bitmap & bit)) return node;
+
+  const auto pos = GetPosition(node->bitmap, bit);
+  auto child =
+      Remove(node->children[pos], hash, shift + kBitsPerLevel, key, erased);
+  if (!erased) return node;
+
+  if (!child) {
+    if (node->children.size() == 1) return nullptr;
+
+    // Leaves may live at any depth, so a lone leaf replaces its branch
+    if (node->children.size() == 2 && node->children[1 - pos]->IsLeaf()) {
+      return node->children[1 - pos];
+    }
+
+    auto branch = std::make_shared<Node>();
+    branch->bitmap = node->bitmap & ~bit;
+    branch->children = node->children;
+    branch->children.erase(branch->children.begin() + pos);
+    return branch;
+  }
+
+  if (node->children.size() == 1 && child->IsLeaf()) return child;
+
+  auto branch = std::make_shared<Node>();
+  branch->bitmap = node->bitmap;
+  branch->children = node->children;
+  branch->children[pos] = std::move(child);
+  return branch;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void Write(dump::Writer& writer,
+           const PersistentMap<Key, Value, Hash, Equal>& map) {
+  writer.Write(map.size());
+  for (const auto& [key, value] : map) {
+    writer.Write(key);
+    writer.Write(value);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+PersistentMap<Key, Value, Hash, Equal> Read(
+    dump::Reader& reader, dump::To<PersistentMap<Key, Value, Hash, Equal>>) {
+  PersistentMap<Key, Value, Hash, Equal> map;
+  const auto size = reader.Read<std::size_t>();
+  for (std::size_t i = 0; i < size; ++i) {
+    auto key = reader.Read<Key>();
+    auto value = reader.Read<Value>();
+    map.Set(key, std::move(value));
+  }
+  return map;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
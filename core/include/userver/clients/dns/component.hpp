@@ -33,6 +33,8 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-prefetch-interval | interval of background updates of hot names before their expiration, 0 disables the prefetch | 0
+/// cache-prefetch-min-hits | min number of lookups during the prefetch interval for a name to be considered hot | 1
 ///
 /// ## Static configuration example:
 ///
@@ -39,6 +39,12 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Hot names prefetch interval, prefetch is disabled if zero
+  std::chrono::milliseconds cache_prefetch_interval{0};
+
+  /// Min number of lookups between prefetches for a name to be considered hot
+  size_t cache_prefetch_min_hits{1};
 };
 
 }  // namespace clients::dns
@@ -19,6 +19,11 @@ namespace clients::dns {
 /// Caching DNS resolver implementation.
 ///
 /// Combines file-based (/etc/hosts) name resolution with network-based one.
+///
+/// If ResolverConfig::cache_prefetch_interval is set, the names looked up at
+/// least ResolverConfig::cache_prefetch_min_hits times during an interval are
+/// updated in background before they expire and are served from a lock-free
+/// snapshot, so the hot names never wait for the network.
 class Resolver {
  public:
   struct LookupSourceCounters {
@@ -30,6 +35,15 @@ class Resolver {
     utils::statistics::RelaxedCounter<size_t> network_failure{0};
   };
 
+  struct PrefetchCounters {
+    /// Background updates started for hot names before their expiration
+    utils::statistics::RelaxedCounter<size_t> started{0};
+    /// Cached replies served from entries refreshed by prefetch
+    utils::statistics::RelaxedCounter<size_t> hits{0};
+    /// Cached replies that required a reactive update
+    utils::statistics::RelaxedCounter<size_t> misses{0};
+  };
+
   Resolver(engine::TaskProcessor& fs_task_processor,
            const ResolverConfig& config);
   Resolver(const Resolver&) = delete;
@@ -40,6 +54,7 @@ class Resolver {
   ///
   /// Sources are tried in the following order:
   ///  - Cached file lookup table
+  ///  - Lock-free snapshot of hot names, if prefetch is enabled
   ///  - Cached network resolution results
   ///  - Network name servers
   ///
@@ -50,6 +65,9 @@ class Resolver {
   /// Returns lookup source counters.
   const LookupSourceCounters& GetLookupSourceCounters() const;
 
+  /// Returns hot names prefetch counters.
+  const PrefetchCounters& GetPrefetchCounters() const;
+
   /// Forces the reload of lookup table file. Waits until the reload is done.
   void ReloadHosts();
 
@@ -61,7 +79,7 @@ class Resolver {
 
  private:
   class Impl;
-  constexpr static size_t kSize = 1584;
+  constexpr static size_t kSize = 2544;
   constexpr static size_t kAlignment = 16;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -7,12 +7,20 @@
 #error Use clients::Http from clients/http.hpp instead
 #endif
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/moodycamel/concurrentqueue_fwd.h>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/clients/http/request.hpp>
+#include <userver/clients/http/request_template.hpp>
+#include <userver/congestion_control/client_throttler.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -44,11 +52,39 @@ class Statistics;
 struct PoolStatistics;
 struct InstanceStatistics;
 class DestinationStatistics;
+class RetryBudget;
+
+/// @brief Limits the retries and the hedged requests to each destination
+/// (scheme, host and port), so that they do not multiply the load on a
+/// failing destination
+struct RetryBudgetSettings final {
+  /// Max number of extra requests in a burst, zero disables the limit
+  size_t max_tokens = 0;
+  /// Number of extra requests added to the budget each second
+  size_t refill_per_second = 10;
+};
 
 struct ClientSettings final {
   std::string thread_name_prefix;
   size_t io_threads = 8;
   bool defer_events = false;
+  bool destination_affinity = false;
+  RetryBudgetSettings retry_budget{};
+  /// Client-side throttling of each destination (scheme, host and port) that
+  /// rejects too many requests, the throttled requests fail with
+  /// clients::http::ThrottledException
+  congestion_control::ClientThrottlerSettings throttling{};
+};
+
+/// @brief Settings for Client::PerformHedged
+struct HedgingSettings final {
+  /// Max number of requests sent, including the first one
+  size_t max_attempts = 2;
+  /// Time to wait for a response before sending the next request
+  std::chrono::milliseconds hedging_delay{50};
+  /// If set, the percentile of the recent timings of the destination metric
+  /// of the URL is used as the delay instead of hedging_delay
+  std::optional<double> delay_percentile{};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -73,6 +109,12 @@ class Client final {
   /// User-Agent, Proxy and some of the Testsuite suff (if any).
   std::shared_ptr<Request> CreateRequest();
 
+  /// @brief Returns a HTTP request builder with the settings of the template
+  /// applied over the ones of CreateRequest().
+  /// @see clients::http::RequestTemplate
+  std::shared_ptr<Request> CreateRequest(
+      const RequestTemplate& request_template);
+
   /// Providing CreateNonSignedRequest() function for the clients::Http alias.
   std::shared_ptr<Request> CreateNotSignedRequest() { return CreateRequest(); }
 
@@ -93,6 +135,9 @@ class Client final {
   // For internal use only.
   const http::DestinationStatistics& GetDestinationStatistics() const;
 
+  // For internal use only.
+  const congestion_control::ClientThrottlers& GetThrottlers() const;
+
   // For internal use only.
   void SetTestsuiteConfig(const TestsuiteConfig& config);
 
@@ -123,6 +168,31 @@ class Client final {
   /// (most likely getaddrinfo).
   void SetDnsResolver(clients::dns::Resolver* resolver);
 
+  /// @brief Opens connections to the URLs in advance, so that the first
+  /// requests reuse them instead of waiting for the handshakes.
+  ///
+  /// Sends `connections` concurrent HEAD requests to each of the URLs and
+  /// waits for them, errors are logged. The connections are kept in the
+  /// connection pools, so this is most useful with
+  /// ClientSettings::destination_affinity enabled.
+  void Prewarm(const std::vector<std::string>& urls, size_t connections,
+               std::chrono::milliseconds timeout);
+
+  /// @brief Performs a request returned by `make_request` and sends the same
+  /// request again if there is no response after a delay, returning the
+  /// response that comes first and cancelling the others.
+  ///
+  /// A response with a status code below 500 is returned as soon as it
+  /// arrives. If a request fails, the next one is sent without waiting for the
+  /// delay. If all the requests fail, the last received response is returned
+  /// or the last error is rethrown.
+  ///
+  /// Each of the extra requests takes a token from the retry budget of the
+  /// destination, no extra requests are sent if the budget is exhausted.
+  std::shared_ptr<Response> PerformHedged(
+      const std::function<std::shared_ptr<Request>()>& make_request,
+      const HedgingSettings& settings);
+
  private:
   void ReinitEasy();
 
@@ -130,12 +200,16 @@ class Client final {
 
   size_t FindMultiIndex(const curl::multi*) const;
 
+  std::chrono::milliseconds GetHedgingDelay(
+      const std::string& url, const HedgingSettings& settings) const;
+
   // Functions for EasyWrapper that must be noexcept, as they are called from
   // the EasyWrapper destructor.
   friend class impl::EasyWrapper;
   void IncPending() noexcept { ++pending_tasks_; }
   void DecPending() noexcept { --pending_tasks_; }
   void PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept;
+  void BindToDestination(curl::easy& easy, std::string_view url) const;
 
   std::shared_ptr<curl::easy> TryDequeueIdle() noexcept;
 
@@ -143,9 +217,12 @@ class Client final {
   rcu::Variable<EnforceTaskDeadlineConfig> enforce_task_deadline_;
 
   std::shared_ptr<DestinationStatistics> destination_statistics_;
+  std::shared_ptr<RetryBudget> retry_budget_;
+  std::shared_ptr<congestion_control::ClientThrottlers> throttlers_;
   std::unique_ptr<engine::ev::ThreadPool> thread_pool_;
   std::vector<Statistics> statistics_;
   std::vector<std::unique_ptr<curl::multi>> multis_;
+  const bool destination_affinity_;
 
   static constexpr size_t kIdleQueueSize = 616;
   static constexpr size_t kIdleQueueAlignment = 8;
@@ -39,6 +39,12 @@ namespace components {
 /// thread-name-prefix | set OS thread name to this value | ''
 /// threads | number of threads to process low level HTTP related IO system calls | 8
 /// defer-events | whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care | false
+/// destination-affinity | whether to perform all the requests to a destination (scheme, host and port) in the same IO thread, so that they share its keep-alive connections | false
+/// prewarm-urls | URLs to open connections to at start by sending HEAD requests | []
+/// prewarm-connections | number of connections to open to each of prewarm-urls | 1
+/// retry-budget-max-tokens | max number of retries and hedged requests to a destination (scheme, host and port) in a burst, 0 disables the limit | 0
+/// retry-budget-refill-per-second | number of retries and hedged requests to a destination added to its budget each second | 10
+/// throttling-accepts-multiplier | start rejecting the requests to a destination (scheme, host and port) locally once they outnumber the requests accepted by it during the last 2 minutes by this factor, see congestion_control::ClientThrottler; 0 disables the throttling | 0
 /// fs-task-processor | task processor to run blocking HTTP related calls, like DNS resolving or hosts reading | -
 /// destination-metrics-auto-max-size | set max number of automatically created destination metrics | 100
 /// user-agent | User-Agent HTTP header to show on all requests, result of utils::GetUserverIdentifier() if empty | empty
@@ -95,6 +95,15 @@ class AuthFailedException : public BaseCodeException {
   ~AuthFailedException() override = default;
 };
 
+/// Request was rejected locally, as the destination rejects too many requests
+/// recently. It is safe to retry the request later.
+/// @see clients::http::ClientSettings::throttling
+class ThrottledException : public BaseException {
+ public:
+  using BaseException::BaseException;
+  ~ThrottledException() override = default;
+};
+
 /// Base class for HttpClientException and HttpServerException
 class HttpException : public BaseException {
  public:
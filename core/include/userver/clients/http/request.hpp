@@ -17,6 +17,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace congestion_control {
+class ClientThrottlers;
+}  // namespace congestion_control
+
 /// HTTP client helpers
 namespace clients::http {
 
@@ -40,6 +44,10 @@ enum class HttpVersion {
   k2,        ///< HTTP/2 with fallback to HTTP/1.1
   k2Tls,     ///< HTTP/2 over TLS only, otherwise (no TLS or h2) HTTP/1.1
   k2PriorKnowledge,  ///< HTTP/2 only (without Upgrade)
+  /// HTTP/3 over QUIC with fallback to HTTP/2 over TLS or HTTP/1.1 if the
+  /// destination does not answer over QUIC. Behaves as k2Tls if libcurl is
+  /// built without HTTP/3 or is older than 7.88.0.
+  k3,
 };
 
 enum class ProxyAuthType {
@@ -57,8 +65,10 @@ enum class ProxyAuthType {
 ProxyAuthType ProxyAuthTypeFromString(const std::string& auth_name);
 
 class Form;
+class RequestTemplate;
 class RequestStats;
 class DestinationStatistics;
+class RetryBudget;
 struct TestsuiteConfig;
 struct EnforceTaskDeadlineConfig;
 
@@ -73,6 +83,9 @@ class Request final : public std::enable_shared_from_this<Request> {
   explicit Request(std::shared_ptr<impl::EasyWrapper>&&,
                    std::shared_ptr<RequestStats>&& req_stats,
                    const std::shared_ptr<DestinationStatistics>& dest_stats,
+                   const std::shared_ptr<RetryBudget>& retry_budget,
+                   const std::shared_ptr<congestion_control::ClientThrottlers>&
+                       throttlers,
                    clients::dns::Resolver* resolver);
   /// @endcond
 
@@ -114,6 +127,17 @@ class Request final : public std::enable_shared_from_this<Request> {
   std::shared_ptr<Request> url(const std::string& url);
   /// data for POST request
   std::shared_ptr<Request> data(std::string data);
+  /// @brief Body for POST-like requests that is read from the queue while the
+  /// request is performed, so that it does not have to be kept in memory
+  /// at once.
+  ///
+  /// Must be set after the method and the URL. The body ends when all the
+  /// producers of the queue are released; the max length of the queue limits
+  /// the memory usage, as pushing waits for the previous chunks to be sent.
+  /// After the request is completed pushes start to fail. The body is sent with
+  /// chunked transfer encoding in HTTP/1.1, and the request is not retried.
+  std::shared_ptr<Request> stream_data(
+      const std::shared_ptr<concurrent::SpscQueue<std::string>>& queue);
   /// form for POST request
   std::shared_ptr<Request> form(const Form& form);
   /// Headers for request as map
@@ -166,8 +190,17 @@ class Request final : public std::enable_shared_from_this<Request> {
   ///
   /// Retries use exponential backoff - an exponentially increasing delay
   /// is added before each retry of this request.
+  ///
+  /// Each retry takes a token from the retry budget of the destination, the
+  /// request is not retried if the budget is exhausted.
+  /// @see clients::http::RetryBudgetSettings
   std::shared_ptr<Request> retry(short retries = 3, bool on_fails = true);
 
+  /// Applies the settings of the template, the headers are added in bulk.
+  /// @see clients::http::RequestTemplate
+  std::shared_ptr<Request> ApplyTemplate(
+      const RequestTemplate& request_template);
+
   /// Set unix domain socket as connection endpoint and provide path to it
   /// When enabled, request will connect to the Unix domain socket instead
   /// of establishing a TCP connection to a host.
@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file userver/clients/http/request_template.hpp
+/// @brief @copybrief clients::http::RequestTemplate
+
+#include <chrono>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/clients/http/request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace impl {
+struct RequestTemplateSettings;
+}  // namespace impl
+
+/// @brief Request settings that are prepared once, usually per destination,
+/// and applied to each request with Client::CreateRequest(const
+/// RequestTemplate&).
+///
+/// The headers are formatted when added to the template and passed to the
+/// request in bulk, so the per-call code sets only the URL, the body and the
+/// dynamic headers. Copies share the settings, a setter called on a shared
+/// template copies them first, so a template can be safely used from many
+/// tasks as long as it is not modified.
+///
+/// ## Example usage:
+///
+/// @snippet clients/http/client_test.cpp  Sample HTTP Client request template
+class RequestTemplate final {
+ public:
+  RequestTemplate();
+  RequestTemplate(const RequestTemplate&) noexcept;
+  RequestTemplate(RequestTemplate&&) noexcept;
+  RequestTemplate& operator=(const RequestTemplate&) noexcept;
+  RequestTemplate& operator=(RequestTemplate&&) noexcept;
+  ~RequestTemplate();
+
+  /// Specifies method
+  RequestTemplate& method(HttpMethod method);
+  /// Headers for request as map, the User-Agent header sets the user agent
+  RequestTemplate& headers(const Headers& headers);
+  /// Headers for request as list, the User-Agent header sets the user agent
+  RequestTemplate& headers(
+      std::initializer_list<std::pair<std::string_view, std::string_view>>
+          headers);
+  /// Sets the User-Agent header
+  RequestTemplate& user_agent(std::string value);
+  /// Sets proxy to use. Example: [::1]:1080
+  RequestTemplate& proxy(std::string value);
+  /// Follow redirects or not. Default: follow
+  RequestTemplate& follow_redirects(bool follow = true);
+  /// Set timeout for request
+  RequestTemplate& timeout(std::chrono::milliseconds timeout);
+  /// Verify host and peer or not. Default: verify
+  RequestTemplate& verify(bool verify = true);
+  /// Set file holding one or more certificates to verify the peer with
+  RequestTemplate& ca_info(std::string file_path);
+  /// Set HTTP version
+  RequestTemplate& http_version(HttpVersion version);
+  /// Number of retries, see Request::retry()
+  RequestTemplate& retry(short retries = 3, bool on_fails = true);
+  /// Set destination name in metric "httpclient.destinations.<name>"
+  RequestTemplate& SetDestinationMetricName(std::string destination);
+  /// Disable auto-decoding of received replies
+  RequestTemplate& DisableReplyDecoding();
+
+  /// @cond
+  // For internal use only.
+  const impl::RequestTemplateSettings& GetSettings() const noexcept;
+  /// @endcond
+
+ private:
+  impl::RequestTemplateSettings& GetMutableSettings();
+
+  std::shared_ptr<impl::RequestTemplateSettings> settings_;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -25,6 +25,7 @@ enum Status : uint16_t {
   BadRequest = 400,
   NotFound = 404,
   Conflict = 409,
+  TooManyRequests = 429,
   InternalServerError = 500,
   BadGateway = 502,
   ServiceUnavailable = 503,
@@ -59,6 +60,10 @@ class Response final {
   std::string body() const& { return response_; }
   std::string&& body() && { return std::move(response_); }
 
+  /// moves the body out, avoiding a copy of a big body when the response is
+  /// held by a shared pointer
+  std::string ExtractBody() { return std::move(response_); }
+
   /// body as string_view
   std::string_view body_view() const { return response_; }
 
@@ -19,11 +19,16 @@ namespace components {
 /// @brief Component for storing files in memory
 /// ## Static options:
 ///
-/// Name              | Description                                          | Default value
-/// ----------------- | ---------------------------------------------------- | -------------
-/// dir               | directory to cache files from                        | /var/www
-/// update-period     | Update period (0 - fill the cache only at startup)   | 0
-/// fs-task-processor | task processor to do filesystem operations           | fs-task-processor
+/// Name                   | Description                                          | Default value
+/// ---------------------- | ---------------------------------------------------- | -------------
+/// dir                    | directory to cache files from                        | /var/www
+/// update-period          | Update period (0 - fill the cache only at startup)   | 0
+/// fs-task-processor      | task processor to do filesystem operations           | fs-task-processor
+/// precompress-gzip       | keep the gzip-compressed variants of the files, see fs::FsCacheCompressionSettings | false
+/// precompress-gzip-level | gzip compression level from 1 (fastest) to 9 (smallest) | 9
+/// precompress-min-size   | files smaller than this are not compressed           | 1024
+/// mmap-min-size          | files of this size or larger are memory-mapped instead of being copied into memory, 0 disables the mapping | 0
+/// watch-changes          | pick up the changes of the files through inotify instead of the periodic rescans, Linux only | false
 
 // clang-format on
 
@@ -33,9 +33,14 @@ class Manager;
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | -
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | -
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
+/// coro_pool.stack_usage_sampling_period | measure the stack usage of each Nth coroutine returned to the pool and report the distribution in statistics, 0 disables | 0
+/// coro_pool.stack_release_watermark | release the pages of the stacks returned to the pool that were touched deeper than this many bytes, 0 disables | 0
+/// coro_pool.idle_shrink_period | destroy the idle coroutines above initial_size once the pool has not run out of coroutines for this long, 0 disables | 0
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | -
+/// event_thread_pool.io_uring | perform socket I/O via per-thread io_uring instances instead of epoll readiness notifications (Linux 5.7+, falls back to epoll if not supported) | false
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
+/// startup_parallelism | max number of components that are constructed concurrently; a component waiting in FindComponent for its dependency does not occupy a slot; the startup timeline and the critical path are logged after the start | 0 (unlimited)
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
 ///
 /// ## Static task_processor options:
@@ -45,6 +50,16 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-processor-queue | Task queue implementation: 'global-task-queue' with a single queue shared by all the workers or 'work-stealing-task-queue' with a local queue for each worker and stealing between them. The latter scales better past 16 worker threads. 'priority-task-queue' has a lane for each engine::Task::Priority, see engine::current_task::SetPriority(). | global-task-queue
+/// direct-handoff | run a task woken up by another task (e.g. by engine::SingleConsumerEvent::Send() or a Mutex unlock) right after the current step of the waker on the same worker, skipping the global task queue; ignored for 'work-stealing-task-queue' and 'priority-task-queue' | false
+/// cooperative-yield-slice | yield in the library CPU-bound loops (formats::json serialization, utils::CpuRelax in cache updates and dumps) once a task has run that long without a context switch, see engine::YieldIfTimeSliceExceeded() | 0 (disabled)
+/// cpu-affinity | CPU list to pin the worker threads to, e.g. '0-7,16-23' | -
+/// numa-node | NUMA node of the worker threads; coroutine stacks are reused within the node; if `cpu-affinity` is not set the workers are pinned to all the CPUs of the node | -
+/// coro-stack-size | stack size of the task processor coroutines; coroutines of a non-default size are taken from a separate pool | coro_pool.stack_size
+/// jemalloc-arena | optional dictionary of the jemalloc arena options, gives the worker threads a jemalloc arena of their own | empty (the arenas are shared)
+/// jemalloc-arena.tcache | cache the small allocations per thread | true
+/// jemalloc-arena.dirty-decay | how long the unused dirty pages of the arena are kept | opt.dirty_decay_ms
+/// jemalloc-arena.muzzy-decay | how long the unused muzzy pages of the arena are kept | opt.muzzy_decay_ms
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -23,7 +23,9 @@ void TryValidateStaticConfig(const components::ComponentConfig& static_config,
                              ValidationMode validation_condition) {
   if (components::kHasValidate<Component> ||
       validation_condition == ValidationMode::kAll) {
-    yaml_config::Schema schema = Component::GetStaticConfigSchema();
+    // the schema of a component type does not change, build it only once
+    static const yaml_config::Schema schema =
+        Component::GetStaticConfigSchema();
 
     yaml_config::impl::Validate(static_config, schema);
   }
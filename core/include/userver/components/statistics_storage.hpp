@@ -28,7 +28,7 @@ namespace components {
 /// @snippet components/common_component_list_test.cpp  Sample statistics storage component config
 
 // clang-format on
-class StatisticsStorage final : public LoggableComponentBase {
+class StatisticsStorage final : public impl::ComponentBase {
  public:
   static constexpr auto kName = "statistics-storage";
 
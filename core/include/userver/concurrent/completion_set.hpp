@@ -0,0 +1,216 @@
+#pragma once
+
+/// @file userver/concurrent/completion_set.hpp
+/// @brief @copybrief concurrent::CompletionSet
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+// clang-format off
+
+/// @ingroup userver_concurrency
+///
+/// @brief A set of tasks that are retrieved in the order of their completion
+///
+/// engine::WaitAny registers in each of the N awaited tasks on every call, so
+/// draining N results with it costs O(N²). The tasks of a CompletionSet
+/// instead report into a shared lock-free ready list as they finish, and
+/// WaitNext() takes the next one from there in O(1).
+///
+/// The tasks are started with utils::Async. Only the owner of the set may
+/// call its member functions, the tasks that are not retrieved are cancelled
+/// and waited for in the destructor.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/completion_set_test.cpp  Sample concurrent::CompletionSet usage
+///
+/// @see @ref md_en_userver_synchronization
+
+// clang-format on
+
+template <typename T>
+class CompletionSet final {
+ public:
+  CompletionSet() = default;
+
+  CompletionSet(CompletionSet&&) = delete;
+  CompletionSet& operator=(CompletionSet&&) = delete;
+  ~CompletionSet() = default;
+
+  /// @brief Starts a task with utils::Async and adds it to the set.
+  /// @returns the index of the task in the set.
+  template <typename Function, typename... Args>
+  std::size_t Async(std::string name, Function&& f, Args&&... args);
+
+  /// @brief Starts a task with utils::Async on the specified task processor
+  /// and adds it to the set.
+  /// @returns the index of the task in the set.
+  template <typename Function, typename... Args>
+  std::size_t Async(engine::TaskProcessor& task_processor, std::string name,
+                    Function&& f, Args&&... args);
+
+  /// @brief Waits for the next completed task or the deadline.
+  /// @returns the index of the completed task, or `std::nullopt` if all the
+  /// tasks have already been returned, the deadline is reached or the current
+  /// task is cancelled.
+  std::optional<std::size_t> WaitNext(engine::Deadline deadline = {});
+
+  /// @brief Returns the result of a task returned by WaitNext() or rethrows
+  /// its exception.
+  /// @note Can be called at most once for each task.
+  T Get(std::size_t index);
+
+  /// Number of the tasks added to the set.
+  std::size_t Size() const noexcept { return slots_.size(); }
+
+  /// Number of the tasks that were not returned by WaitNext() yet.
+  std::size_t GetPendingCount() const noexcept {
+    return slots_.size() - returned_count_;
+  }
+
+ private:
+  struct Slot final {
+    explicit Slot(std::size_t index) noexcept : index(index) {}
+
+    const std::size_t index;
+    Slot* next_completed{nullptr};
+    engine::TaskWithResult<T> task;
+  };
+
+  /// Reports the completion when the payload of the task is destroyed, which
+  /// happens after its result is stored or when it is cancelled before start
+  class CompletionGuard final {
+   public:
+    CompletionGuard(CompletionSet& set, Slot& slot) noexcept
+        : set_(&set), slot_(&slot) {}
+
+    CompletionGuard(CompletionGuard&& other) noexcept
+        : set_(std::exchange(other.set_, nullptr)), slot_(other.slot_) {}
+    CompletionGuard& operator=(CompletionGuard&&) = delete;
+
+    ~CompletionGuard() {
+      if (set_) set_->PushCompleted(*slot_);
+    }
+
+   private:
+    CompletionSet* set_;
+    Slot* slot_;
+  };
+
+  template <typename Spawner>
+  std::size_t AddTask(Spawner&& spawner);
+
+  void PushCompleted(Slot& slot) noexcept;
+
+  // destroyed after the tasks, which report into them
+  std::atomic<Slot*> completed_head_{nullptr};
+  engine::SingleConsumerEvent completed_event_;
+
+  Slot* ready_head_{nullptr};
+  std::size_t returned_count_{0};
+  std::deque<Slot> slots_;
+};
+
+template <typename T>
+template <typename Function, typename... Args>
+std::size_t CompletionSet<T>::Async(std::string name, Function&& f,
+                                    Args&&... args) {
+  return AddTask([&](CompletionGuard&& guard) {
+    return utils::Async(
+        std::move(name),
+        [guard = std::move(guard), func = std::forward<Function>(f),
+         args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+          return std::apply(std::move(func), std::move(args));
+        });
+  });
+}
+
+template <typename T>
+template <typename Function, typename... Args>
+std::size_t CompletionSet<T>::Async(engine::TaskProcessor& task_processor,
+                                    std::string name, Function&& f,
+                                    Args&&... args) {
+  return AddTask([&](CompletionGuard&& guard) {
+    return utils::Async(
+        task_processor, std::move(name),
+        [guard = std::move(guard), func = std::forward<Function>(f),
+         args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+          return std::apply(std::move(func), std::move(args));
+        });
+  });
+}
+
+template <typename T>
+template <typename Spawner>
+std::size_t CompletionSet<T>::AddTask(Spawner&& spawner) {
+  static_assert(std::is_same_v<std::invoke_result_t<Spawner&, CompletionGuard>,
+                               engine::TaskWithResult<T>>,
+                "The function must return T");
+
+  // std::deque keeps the references to the elements valid on growth
+  auto& slot = slots_.emplace_back(slots_.size());
+  slot.task = spawner(CompletionGuard{*this, slot});
+  return slot.index;
+}
+
+template <typename T>
+std::optional<std::size_t> CompletionSet<T>::WaitNext(
+    engine::Deadline deadline) {
+  while (!ready_head_) {
+    if (returned_count_ == slots_.size()) return std::nullopt;
+
+    // the completed list is LIFO, reversing it gives the completion order
+    auto* completed =
+        completed_head_.exchange(nullptr, std::memory_order_acquire);
+    while (completed) {
+      auto* next = completed->next_completed;
+      completed->next_completed = ready_head_;
+      ready_head_ = completed;
+      completed = next;
+    }
+    if (ready_head_) break;
+
+    if (!completed_event_.WaitForEventUntil(deadline)) return std::nullopt;
+  }
+
+  auto& slot = *std::exchange(ready_head_, ready_head_->next_completed);
+  ++returned_count_;
+  return slot.index;
+}
+
+template <typename T>
+T CompletionSet<T>::Get(std::size_t index) {
+  UASSERT(index < slots_.size());
+  return slots_[index].task.Get();
+}
+
+template <typename T>
+void CompletionSet<T>::PushCompleted(Slot& slot) noexcept {
+  auto* head = completed_head_.load(std::memory_order_relaxed);
+  do {
+    slot.next_completed = head;
+  } while (!completed_head_.compare_exchange_weak(
+      head, &slot, std::memory_order_release, std::memory_order_relaxed));
+  completed_event_.Send();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -160,10 +160,22 @@ class MpscQueue final : public std::enable_shared_from_this<MpscQueue<T>> {
   bool PushNoblock(ProducerToken&, T&&);
   bool DoPush(ProducerToken&, T&&);
 
+  template <typename Iterator>
+  bool PushBulk(ProducerToken&, Iterator first, std::size_t count,
+                engine::Deadline);
+  template <typename Iterator>
+  bool DoPushBulk(ProducerToken&, Iterator first, std::size_t count);
+
   bool Pop(ConsumerToken&, T&, engine::Deadline);
   bool PopNoblock(ConsumerToken&, T&);
   bool DoPop(ConsumerToken&, T&);
 
+  template <typename Iterator>
+  std::size_t PopBulk(ConsumerToken&, Iterator first, std::size_t max_count,
+                      engine::Deadline);
+  template <typename Iterator>
+  std::size_t DoPopBulk(ConsumerToken&, Iterator first, std::size_t max_count);
+
   void MarkConsumerIsDead();
   void MarkProducerIsDead();
 
@@ -272,6 +284,36 @@ bool MpscQueue<T>::DoPush(ProducerToken& /*unused*/, T&& value) {
   return true;
 }
 
+template <typename T>
+template <typename Iterator>
+bool MpscQueue<T>::PushBulk(ProducerToken& token, Iterator first,
+                            std::size_t count, engine::Deadline deadline) {
+  if (count == 0) return true;
+  return !engine::current_task::ShouldCancel() &&
+         remaining_capacity_.try_lock_shared_until_count(deadline, count) &&
+         DoPushBulk(token, first, count);
+}
+
+template <typename T>
+template <typename Iterator>
+bool MpscQueue<T>::DoPushBulk(ProducerToken& /*unused*/, Iterator first,
+                              std::size_t count) {
+  if (consumer_is_created_and_dead_) {
+    remaining_capacity_.unlock_shared_count(count);
+    return false;
+  }
+
+  // boost::lockfree::queue has no bulk operations, but the capacity and the
+  // consumer wakeup are still handled once per bulk
+  for (std::size_t i = 0; i < count; ++i, ++first) {
+    QueueHelper::Push(queue_, std::move(*first));
+  }
+  size_ += count;
+  nonempty_event_.Send();
+
+  return true;
+}
+
 template <typename T>
 bool MpscQueue<T>::Pop(ConsumerToken& token, T& value,
                        engine::Deadline deadline) {
@@ -303,6 +345,44 @@ bool MpscQueue<T>::DoPop(ConsumerToken& /*unused*/, T& value) {
   return false;
 }
 
+template <typename T>
+template <typename Iterator>
+std::size_t MpscQueue<T>::PopBulk(ConsumerToken& token, Iterator first,
+                                  std::size_t max_count,
+                                  engine::Deadline deadline) {
+  if (max_count == 0) return 0;
+
+  std::size_t popped = 0;
+  while ((popped = DoPopBulk(token, first, max_count)) == 0) {
+    if (producer_is_created_and_dead_ ||
+        !nonempty_event_.WaitForEventUntil(deadline)) {
+      // See Pop
+      return DoPopBulk(token, first, max_count);
+    }
+  }
+  return popped;
+}
+
+template <typename T>
+template <typename Iterator>
+std::size_t MpscQueue<T>::DoPopBulk(ConsumerToken& /*unused*/, Iterator first,
+                                    std::size_t max_count) {
+  std::size_t popped = 0;
+  T value{};
+  while (popped < max_count && QueueHelper::Pop(queue_, value)) {
+    *first = std::move(value);
+    ++first;
+    ++popped;
+  }
+
+  if (popped != 0) {
+    size_ -= popped;
+    remaining_capacity_.unlock_shared_count(popped);
+    nonempty_event_.Reset();
+  }
+  return popped;
+}
+
 template <typename T>
 void MpscQueue<T>::MarkConsumerIsDead() {
   consumer_is_created_and_dead_ = true;
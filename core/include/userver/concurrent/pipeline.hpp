@@ -0,0 +1,141 @@
+#pragma once
+
+/// @file userver/concurrent/pipeline.hpp
+/// @brief Stages of streaming pipelines, connected with concurrent queues
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Stages of streaming pipelines
+///
+/// Each stage is a task that reads from the `Consumer` of one queue and/or
+/// writes to the `Producer` of another one, e.g. of concurrent::SpscQueue or
+/// concurrent::NonFifoMpmcQueue. Bounded queues between the stages provide
+/// backpressure, so the stages run concurrently without an unlimited buffering.
+///
+/// Fan-in and fan-out do not need special stages: start multiple stages with
+/// producers or consumers of the same multi-producer or multi-consumer queue.
+///
+/// A stage owns its `Producer` and `Consumer`, so the end and the failure of
+/// a stage propagates along the pipeline:
+/// - a stage finishes after its input producers are gone and the queue is
+///   empty, then its output producer is released;
+/// - a stage stops after its output consumers are gone, then its input
+///   consumer is released;
+/// - an exception or a cancellation of the stage task ends the stage in the
+///   same way, the exception is rethrown from `Get()` of the stage task.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/pipeline_test.cpp  Sample concurrent::pipeline usage
+namespace concurrent::pipeline {
+
+/// @brief Starts a stage that pushes the values returned by `generator`
+/// until it returns `std::nullopt`
+template <typename Producer, typename Generator>
+[[nodiscard]] engine::TaskWithResult<void> StartSource(std::string name,
+                                                       Producer producer,
+                                                       Generator generator) {
+  return utils::Async(std::move(name), [producer = std::move(producer),
+                                        generator =
+                                            std::move(generator)]() mutable {
+    while (!engine::current_task::ShouldCancel()) {
+      auto value = generator();
+      if (!value || !producer.Push(std::move(*value))) return;
+    }
+  });
+}
+
+/// @brief Starts a stage that pushes `func(value)` for each popped value
+template <typename Consumer, typename Producer, typename Func>
+[[nodiscard]] engine::TaskWithResult<void> StartMap(std::string name,
+                                                    Consumer consumer,
+                                                    Producer producer,
+                                                    Func func) {
+  return utils::Async(std::move(name), [consumer = std::move(consumer),
+                                        producer = std::move(producer),
+                                        func = std::move(func)]() mutable {
+    typename Consumer::ValueType value{};
+    while (!engine::current_task::ShouldCancel() && consumer.Pop(value)) {
+      if (!producer.Push(func(std::move(value)))) return;
+    }
+  });
+}
+
+/// @brief Starts a stage that pushes `func(value)` for each popped value,
+/// running up to `parallelism` calls of `func` concurrently in separate tasks.
+/// `func` is called as a const object from multiple tasks concurrently.
+///
+/// The results are pushed in the order of the popped values, so a slow call
+/// delays the pushing of the subsequent results. While some calls are in
+/// flight and there are no new values, the stage waits for the oldest call.
+template <typename Consumer, typename Producer, typename Func>
+[[nodiscard]] engine::TaskWithResult<void> StartParallelMap(
+    std::string name, Consumer consumer, Producer producer,
+    std::size_t parallelism, Func func) {
+  UINVARIANT(parallelism > 0, "parallelism must be positive");
+  auto stage = [name, consumer = std::move(consumer),
+                producer = std::move(producer), parallelism,
+                func = std::move(func)]() {
+    using InputType = typename Consumer::ValueType;
+    using OutputType = std::invoke_result_t<const Func&, InputType&&>;
+
+    // Destroyed before `func`, the unfinished calls are cancelled
+    std::deque<engine::TaskWithResult<OutputType>> calls;
+    InputType value{};
+    bool is_input_finished = false;
+
+    while ((!is_input_finished || !calls.empty()) &&
+           !engine::current_task::ShouldCancel()) {
+      if (!is_input_finished && calls.size() < parallelism) {
+        const bool is_popped =
+            calls.empty() ? consumer.Pop(value) : consumer.PopNoblock(value);
+        if (is_popped) {
+          calls.push_back(utils::Async(
+              name, [&func, value = std::move(value)]() mutable {
+                return func(std::move(value));
+              }));
+          continue;
+        }
+        if (calls.empty()) {
+          is_input_finished = true;
+          continue;
+        }
+      }
+
+      auto result = calls.front().Get();
+      calls.pop_front();
+      if (!producer.Push(std::move(result))) return;
+    }
+  };
+  return utils::Async(std::move(name), std::move(stage));
+}
+
+/// @brief Starts a stage that calls `func(value)` for each popped value
+template <typename Consumer, typename Func>
+[[nodiscard]] engine::TaskWithResult<void> StartSink(std::string name,
+                                                     Consumer consumer,
+                                                     Func func) {
+  return utils::Async(std::move(name), [consumer = std::move(consumer),
+                                        func = std::move(func)]() mutable {
+    typename Consumer::ValueType value{};
+    while (!engine::current_task::ShouldCancel() && consumer.Pop(value)) {
+      func(std::move(value));
+    }
+  });
+}
+
+}  // namespace concurrent::pipeline
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
 
@@ -190,6 +192,13 @@ class GenericQueue final
     return producer_side_.PushNoblock(token, std::move(value));
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool PushBulk(Token& token, Iterator first, std::size_t count,
+                              engine::Deadline deadline) {
+    if (count == 0) return true;
+    return producer_side_.PushBulk(token, first, count, deadline);
+  }
+
   [[nodiscard]] bool Pop(ConsumerToken& token, T& value,
                          engine::Deadline deadline) {
     return consumer_side_.Pop(token, value, deadline);
@@ -199,6 +208,14 @@ class GenericQueue final
     return consumer_side_.PopNoblock(token, value);
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t PopBulk(ConsumerToken& token, Iterator first,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    if (max_count == 0) return 0;
+    return consumer_side_.PopBulk(token, first, max_count, deadline);
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -255,6 +272,24 @@ class GenericQueue final
     consumer_side_.OnElementPushed();
   }
 
+  template <typename Token, typename Iterator>
+  void DoPushBulk(Token& token, Iterator first, std::size_t count) {
+    const auto values = std::make_move_iterator(first);
+    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(token, values, count);
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(values, count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!MultipleProducer);
+      queue_.enqueue_bulk(single_producer_token_, values, count);
+    }
+
+    consumer_side_.OnElementsPushed(count);
+  }
+
   [[nodiscard]] bool DoPop(ConsumerToken& token, T& value) {
     bool success = false;
     if constexpr (MultipleProducer) {
@@ -272,6 +307,21 @@ class GenericQueue final
     return false;
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t DoPopBulk(ConsumerToken& token, Iterator first,
+                                      std::size_t max_count) {
+    std::size_t popped = 0;
+    if constexpr (MultipleProducer) {
+      popped = queue_.try_dequeue_bulk(token, first, max_count);
+    } else {
+      popped = queue_.try_dequeue_bulk_from_producer(single_producer_token_,
+                                                     first, max_count);
+    }
+
+    if (popped != 0) producer_side_.OnElementsPopped(popped);
+    return popped;
+  }
+
   moodycamel::ConcurrentQueue<T> queue_{1};
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
@@ -312,11 +362,28 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool PushBulk(Token& token, Iterator first, std::size_t count,
+                              engine::Deadline deadline) {
+    while (!DoPushBulk(token, first, count)) {
+      if (queue_.NoMoreConsumers() || count > total_capacity_.load() ||
+          !non_full_event_.WaitForEventUntil(deadline)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void OnElementPopped() {
     --used_capacity_;
     non_full_event_.Send();
   }
 
+  void OnElementsPopped(std::size_t count) {
+    used_capacity_ -= count;
+    non_full_event_.Send();
+  }
+
   void StopBlockingOnPush() {
     total_capacity_ += kSemaphoreUnlockValue;
     non_full_event_.Send();
@@ -345,6 +412,20 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     return true;
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool DoPushBulk(Token& token, Iterator first,
+                                std::size_t count) {
+    if (queue_.NoMoreConsumers() ||
+        used_capacity_.load() + count > total_capacity_.load()) {
+      return false;
+    }
+
+    used_capacity_ += count;
+    queue_.DoPushBulk(token, first, count);
+    non_full_event_.Reset();
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -375,8 +456,20 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool PushBulk(Token& token, Iterator first, std::size_t count,
+                              engine::Deadline deadline) {
+    return !engine::current_task::ShouldCancel() &&
+           remaining_capacity_.try_lock_shared_until_count(deadline, count) &&
+           DoPushBulk(token, first, count);
+  }
+
   void OnElementPopped() { remaining_capacity_.unlock_shared(); }
 
+  void OnElementsPopped(std::size_t count) {
+    remaining_capacity_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPush() {
     remaining_capacity_control_.SetCapacityOverride(0);
   }
@@ -405,6 +498,18 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
     return true;
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool DoPushBulk(Token& token, Iterator first,
+                                std::size_t count) {
+    if (queue_.NoMoreConsumers()) {
+      remaining_capacity_.unlock_shared_count(count);
+      return false;
+    }
+
+    queue_.DoPushBulk(token, first, count);
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::Semaphore remaining_capacity_;
   concurrent::impl::SemaphoreCapacityControl remaining_capacity_control_;
@@ -435,11 +540,31 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t PopBulk(ConsumerToken& token, Iterator first,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    std::size_t popped = 0;
+    while ((popped = DoPopBulk(token, first, max_count)) == 0) {
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        // See Pop
+        return DoPopBulk(token, first, max_count);
+      }
+    }
+    return popped;
+  }
+
   void OnElementPushed() {
     ++size_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    size_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
@@ -456,6 +581,17 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return false;
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t DoPopBulk(ConsumerToken& token, Iterator first,
+                                      std::size_t max_count) {
+    const auto popped = queue_.DoPopBulk(token, first, max_count);
+    if (popped != 0) {
+      size_ -= popped;
+      nonempty_event_.Reset();
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> size_;
@@ -483,8 +619,25 @@ class GenericQueue<T, MP, MC>::MultiConsumerSide final {
     return size_.try_lock_shared() && DoPop(token, value);
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t PopBulk(ConsumerToken& token, Iterator first,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    if (!size_.try_lock_shared_until(deadline)) return 0;
+
+    // Take the elements that are already in the queue without waiting. The
+    // remaining count is approximate, so back off until the lock succeeds.
+    auto extra_count = std::min(max_count - 1, size_.RemainingApprox());
+    while (extra_count != 0 && !size_.try_lock_shared_count(extra_count)) {
+      extra_count /= 2;
+    }
+    return DoPopBulk(token, first, 1 + extra_count);
+  }
+
   void OnElementPushed() { size_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) { size_.unlock_shared_count(count); }
+
   void StopBlockingOnPop() {
     size_control_.SetCapacityOverride(kUnbounded + kSemaphoreUnlockValue);
   }
@@ -514,6 +667,20 @@ class GenericQueue<T, MP, MC>::MultiConsumerSide final {
     }
   }
 
+  template <typename Iterator>
+  [[nodiscard]] std::size_t DoPopBulk(ConsumerToken& token, Iterator first,
+                                      std::size_t locked_count) {
+    std::size_t popped = 0;
+    while (true) {
+      popped = queue_.DoPopBulk(token, first, locked_count);
+      if (popped != 0 || queue_.NoMoreProducers()) break;
+      // See DoPop
+    }
+    // The elements that we have not found are left for other consumers
+    if (popped < locked_count) size_.unlock_shared_count(locked_count - popped);
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::Semaphore size_;
   concurrent::impl::SemaphoreCapacityControl size_control_;
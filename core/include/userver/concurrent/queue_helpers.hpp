@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <userver/engine/deadline.hpp>
@@ -27,9 +28,9 @@ class Producer final {
       "Do not instantiate Producer on your own. Use Producer type alias "
       "from queue");
 
+ public:
   using ValueType = typename QueueType::ValueType;
 
- public:
   Producer(const Producer&) = delete;
   Producer(Producer&&) noexcept = default;
   Producer& operator=(const Producer&) = delete;
@@ -54,6 +55,20 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push `count` elements, moved from the range starting at `first`, into
+  /// queue at once. May wait asynchronously until there is free space for all
+  /// of them. Takes the space and wakes up the consumers only once, which is
+  /// cheaper than pushing the elements one by one.
+  /// @returns whether push succeeded before the deadline. The elements are not
+  /// moved from on failure.
+  /// @note `false` is returned if `count` exceeds the max size of the queue.
+  template <typename Iterator>
+  bool PushBulk(Iterator first, std::size_t count,
+                engine::Deadline deadline = {}) const {
+    UASSERT(queue_);
+    return queue_->PushBulk(token_, first, count, deadline);
+  }
+
   void Release() && {
     if (queue_) queue_->MarkProducerIsDead();
     queue_.reset();
@@ -82,10 +97,11 @@ class Consumer final {
       "Do not instantiate Consumer on your own. Use Consumer type alias "
       "from queue");
 
-  using ValueType = typename QueueType::ValueType;
   using ConsumerToken = typename QueueType::ConsumerToken;
 
  public:
+  using ValueType = typename QueueType::ValueType;
+
   Consumer(const Consumer&) = delete;
   Consumer(Consumer&&) noexcept = default;
   Consumer& operator=(const Consumer&) = delete;
@@ -111,6 +127,19 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `max_count` elements from queue into the range starting at
+  /// `first`. May wait asynchronously if the queue is empty, but the producer
+  /// is alive. Does not wait for more elements once there is at least one.
+  /// @returns the number of popped elements, 0 if nothing was popped before
+  /// the deadline.
+  /// @note 0 can be returned before the deadline
+  /// when the producer is no longer alive.
+  template <typename Iterator>
+  std::size_t PopBulk(Iterator first, std::size_t max_count,
+                      engine::Deadline deadline = {}) const {
+    return queue_->PopBulk(token_, first, max_count, deadline);
+  }
+
   /// Const access to source queue.
   std::shared_ptr<const QueueType> Queue() const { return {queue_}; }
 
@@ -0,0 +1,379 @@
+#pragma once
+
+/// @file userver/concurrent/spsc_ring_queue.hpp
+/// @brief @copybrief concurrent::SpscRingQueue
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <userver/concurrent/queue_helpers.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Bounded single producer single consumer queue.
+///
+/// A fixed-capacity ring buffer, which is allocated once on creation. Unlike
+/// concurrent::SpscQueue, pushing and popping do not allocate, and the
+/// producer and the consumer do not touch each other's cache lines unless the
+/// queue becomes empty or full. The other side is only woken up if it waits.
+///
+/// The capacity is rounded up to a power of two. `Producer` and `Consumer`
+/// can be obtained only once each.
+///
+/// @see @ref md_en_userver_synchronization
+template <typename T>
+class SpscRingQueue final
+    : public std::enable_shared_from_this<SpscRingQueue<T>> {
+  struct EmplaceEnabler final {
+    // Disable {}-initialization in Queue's constructor
+    explicit EmplaceEnabler() = default;
+  };
+
+  using ProducerToken = impl::NoToken;
+  using ConsumerToken = impl::NoToken;
+
+  friend class Producer<SpscRingQueue, ProducerToken, EmplaceEnabler>;
+  friend class Consumer<SpscRingQueue, EmplaceEnabler>;
+
+ public:
+  using ValueType = T;
+
+  using Producer =
+      concurrent::Producer<SpscRingQueue, ProducerToken, EmplaceEnabler>;
+  using Consumer = concurrent::Consumer<SpscRingQueue, EmplaceEnabler>;
+
+  static constexpr std::size_t kDefaultCapacity = 1024;
+
+  /// @cond
+  // For internal use only
+  SpscRingQueue(std::size_t capacity, EmplaceEnabler /*unused*/);
+
+  SpscRingQueue(SpscRingQueue&&) = delete;
+  SpscRingQueue(const SpscRingQueue&) = delete;
+  SpscRingQueue& operator=(SpscRingQueue&&) = delete;
+  SpscRingQueue& operator=(const SpscRingQueue&) = delete;
+  ~SpscRingQueue();
+  /// @endcond
+
+  /// Create a new queue that holds at least `capacity` elements
+  static std::shared_ptr<SpscRingQueue> Create(
+      std::size_t capacity = kDefaultCapacity) {
+    return std::make_shared<SpscRingQueue>(capacity, EmplaceEnabler{});
+  }
+
+  /// Get a `Producer` which makes it possible to push items into the queue.
+  /// Can be called only once.
+  ///
+  /// @note `Producer` may outlive the queue and the `Consumer`.
+  Producer GetProducer();
+
+  /// Get a `Consumer` which makes it possible to read items from the queue.
+  /// Can be called only once.
+  ///
+  /// @note `Consumer` may outlive the queue and the `Producer`.
+  Consumer GetConsumer();
+
+  /// @brief Gets the max number of elements in the queue
+  [[nodiscard]] std::size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+  /// @brief Gets the approximate size of queue
+  [[nodiscard]] std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  // Uninitialized storage of a single element
+  struct Slot final {
+    alignas(T) std::byte data[sizeof(T)];
+  };
+
+  bool Push(ProducerToken&, T&&, engine::Deadline);
+  bool PushNoblock(ProducerToken&, T&&);
+
+  template <typename Iterator>
+  bool PushBulk(ProducerToken&, Iterator first, std::size_t count,
+                engine::Deadline);
+
+  bool Pop(ConsumerToken&, T&, engine::Deadline);
+  bool PopNoblock(ConsumerToken&, T&);
+
+  template <typename Iterator>
+  std::size_t PopBulk(ConsumerToken&, Iterator first, std::size_t max_count,
+                      engine::Deadline);
+
+  void MarkConsumerIsDead();
+  void MarkProducerIsDead();
+
+  T& GetElement(std::size_t index) noexcept {
+    return *std::launder(reinterpret_cast<T*>(slots_[index & mask_].data));
+  }
+
+  // Producer side
+  std::size_t GetFreeSpace() noexcept;
+  template <typename Iterator>
+  bool DoPush(Iterator first, std::size_t count);
+  bool WaitForFreeSpace(std::size_t count, engine::Deadline deadline);
+  void NotifyConsumer();
+
+  // Consumer side
+  std::size_t GetAvailable() noexcept;
+  template <typename Iterator>
+  std::size_t DoPop(Iterator first, std::size_t max_count);
+  bool WaitForElements(engine::Deadline deadline);
+  void NotifyProducer();
+
+  // Mimics the token of other queues, which Producer and Consumer construct
+  // from the queue_ member
+  SpscRingQueue& queue_{*this};
+
+  const std::size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+
+  // Written by the consumer only
+  alignas(64) std::atomic<std::size_t> head_{0};
+  std::size_t cached_tail_{0};
+
+  // Written by the producer only
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  std::size_t cached_head_{0};
+
+  // Rarely written, so they are read on each operation without contention
+  alignas(64) std::atomic<bool> consumer_is_waiting_{false};
+  std::atomic<bool> producer_is_waiting_{false};
+  std::atomic<bool> consumer_is_created_{false};
+  std::atomic<bool> consumer_is_dead_{false};
+  std::atomic<bool> producer_is_created_{false};
+  std::atomic<bool> producer_is_dead_{false};
+
+  alignas(64) engine::SingleConsumerEvent nonempty_event_;
+  engine::SingleConsumerEvent nonfull_event_;
+};
+
+namespace impl {
+
+constexpr std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) result *= 2;
+  return result;
+}
+
+}  // namespace impl
+
+template <typename T>
+SpscRingQueue<T>::SpscRingQueue(std::size_t capacity,
+                                EmplaceEnabler /*unused*/)
+    : mask_(impl::RoundUpToPowerOfTwo(capacity) - 1),
+      slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+  UINVARIANT(capacity > 0, "SpscRingQueue capacity must be positive");
+}
+
+template <typename T>
+SpscRingQueue<T>::~SpscRingQueue() {
+  UASSERT(consumer_is_dead_ || !consumer_is_created_);
+  UASSERT(producer_is_dead_ || !producer_is_created_);
+
+  const auto tail = tail_.load(std::memory_order_acquire);
+  for (auto head = head_.load(); head != tail; ++head) {
+    GetElement(head).~T();
+  }
+}
+
+template <typename T>
+typename SpscRingQueue<T>::Producer SpscRingQueue<T>::GetProducer() {
+  UINVARIANT(!producer_is_created_.exchange(true),
+             "SpscRingQueue::Producer must only be obtained a single time");
+  return Producer(this->shared_from_this(), EmplaceEnabler{});
+}
+
+template <typename T>
+typename SpscRingQueue<T>::Consumer SpscRingQueue<T>::GetConsumer() {
+  UINVARIANT(!consumer_is_created_.exchange(true),
+             "SpscRingQueue::Consumer must only be obtained a single time");
+  return Consumer(this->shared_from_this(), EmplaceEnabler{});
+}
+
+template <typename T>
+std::size_t SpscRingQueue<T>::GetSizeApproximate() const noexcept {
+  const auto head = head_.load(std::memory_order_relaxed);
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  return tail >= head ? tail - head : 0;
+}
+
+template <typename T>
+bool SpscRingQueue<T>::Push(ProducerToken& token, T&& value,
+                            engine::Deadline deadline) {
+  return PushBulk(token, &value, 1, deadline);
+}
+
+template <typename T>
+bool SpscRingQueue<T>::PushNoblock(ProducerToken& /*unused*/, T&& value) {
+  return DoPush(&value, 1);
+}
+
+template <typename T>
+template <typename Iterator>
+bool SpscRingQueue<T>::PushBulk(ProducerToken& /*unused*/, Iterator first,
+                                std::size_t count, engine::Deadline deadline) {
+  if (count > GetCapacity()) return false;
+  while (!DoPush(first, count)) {
+    if (consumer_is_dead_ || !WaitForFreeSpace(count, deadline)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool SpscRingQueue<T>::Pop(ConsumerToken& token, T& value,
+                           engine::Deadline deadline) {
+  return PopBulk(token, &value, 1, deadline) != 0;
+}
+
+template <typename T>
+bool SpscRingQueue<T>::PopNoblock(ConsumerToken& /*unused*/, T& value) {
+  return DoPop(&value, 1) != 0;
+}
+
+template <typename T>
+template <typename Iterator>
+std::size_t SpscRingQueue<T>::PopBulk(ConsumerToken& /*unused*/,
+                                      Iterator first, std::size_t max_count,
+                                      engine::Deadline deadline) {
+  if (max_count == 0) return 0;
+
+  std::size_t popped = 0;
+  while ((popped = DoPop(first, max_count)) == 0) {
+    if (producer_is_dead_ || !WaitForElements(deadline)) {
+      // Producer might have pushed something in queue between DoPop
+      // and producer_is_dead_ check. Check twice to avoid TOCTOU.
+      return DoPop(first, max_count);
+    }
+  }
+  return popped;
+}
+
+template <typename T>
+void SpscRingQueue<T>::MarkConsumerIsDead() {
+  consumer_is_dead_ = true;
+  nonfull_event_.Send();
+}
+
+template <typename T>
+void SpscRingQueue<T>::MarkProducerIsDead() {
+  producer_is_dead_ = true;
+  nonempty_event_.Send();
+}
+
+template <typename T>
+std::size_t SpscRingQueue<T>::GetFreeSpace() noexcept {
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  return GetCapacity() - (tail - cached_head_);
+}
+
+template <typename T>
+template <typename Iterator>
+bool SpscRingQueue<T>::DoPush(Iterator first, std::size_t count) {
+  if (consumer_is_dead_) return false;
+
+  if (GetFreeSpace() < count) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    if (GetFreeSpace() < count) return false;
+  }
+
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i, ++first) {
+    new (slots_[(tail + i) & mask_].data) T(std::move(*first));
+  }
+  tail_.store(tail + count, std::memory_order_release);
+
+  NotifyConsumer();
+  return true;
+}
+
+template <typename T>
+bool SpscRingQueue<T>::WaitForFreeSpace(std::size_t count,
+                                        engine::Deadline deadline) {
+  producer_is_waiting_.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in NotifyProducer: either the consumer sees the flag
+  // or we see the released space.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  cached_head_ = head_.load(std::memory_order_acquire);
+  const bool is_ready = GetFreeSpace() >= count || consumer_is_dead_ ||
+                        nonfull_event_.WaitForEventUntil(deadline);
+
+  producer_is_waiting_.store(false, std::memory_order_relaxed);
+  return is_ready;
+}
+
+template <typename T>
+void SpscRingQueue<T>::NotifyConsumer() {
+  // Pairs with the fence in WaitForElements
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (consumer_is_waiting_.load(std::memory_order_relaxed)) {
+    nonempty_event_.Send();
+  }
+}
+
+template <typename T>
+std::size_t SpscRingQueue<T>::GetAvailable() noexcept {
+  return cached_tail_ - head_.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+template <typename Iterator>
+std::size_t SpscRingQueue<T>::DoPop(Iterator first, std::size_t max_count) {
+  if (GetAvailable() < max_count) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+  }
+
+  const auto count = std::min(GetAvailable(), max_count);
+  if (count == 0) return 0;
+
+  const auto head = head_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i, ++first) {
+    auto& element = GetElement(head + i);
+    *first = std::move(element);
+    element.~T();
+  }
+  head_.store(head + count, std::memory_order_release);
+
+  NotifyProducer();
+  return count;
+}
+
+template <typename T>
+bool SpscRingQueue<T>::WaitForElements(engine::Deadline deadline) {
+  consumer_is_waiting_.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in NotifyConsumer: either the producer sees the flag
+  // or we see the pushed elements.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  cached_tail_ = tail_.load(std::memory_order_acquire);
+  const bool is_ready = GetAvailable() != 0 || producer_is_dead_ ||
+                        nonempty_event_.WaitForEventUntil(deadline);
+
+  consumer_is_waiting_.store(false, std::memory_order_relaxed);
+  return is_ready;
+}
+
+template <typename T>
+void SpscRingQueue<T>::NotifyProducer() {
+  // Pairs with the fence in WaitForFreeSpace
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (producer_is_waiting_.load(std::memory_order_relaxed)) {
+    nonfull_event_.Send();
+  }
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
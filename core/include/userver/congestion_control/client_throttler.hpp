@@ -0,0 +1,123 @@
+#pragma once
+
+/// @file userver/congestion_control/client_throttler.hpp
+/// @brief @copybrief congestion_control::ClientThrottler
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+struct ClientThrottlerSettings final {
+  /// The throttling starts once the requests outnumber the accepts by this
+  /// factor, zero disables the throttling. The lower the value the more
+  /// aggressive the throttling is, 2 is a good starting point.
+  double accepts_multiplier{0};
+
+  bool operator==(const ClientThrottlerSettings& other) const {
+    return accepts_multiplier == other.accepts_multiplier;
+  }
+};
+
+struct ClientThrottlerStatistics final {
+  std::uint64_t requests{0};
+  std::uint64_t accepts{0};
+  std::uint64_t rejected{0};
+  double reject_probability{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ClientThrottlerStatistics& stats);
+
+/// @ingroup userver_concurrency
+///
+/// @brief Client-side adaptive throttling of the requests to a single backend.
+///
+/// Tracks the requests made and the requests the backend accepted for the last
+/// 2 minutes and rejects each new request locally with the probability of
+/// `max(0, (requests - K * accepts) / (requests + 1))`, where K is
+/// ClientThrottlerSettings::accepts_multiplier. While the backend is healthy
+/// no requests are rejected, once it starts to reject or time out the
+/// requests the client sheds the load that would have been rejected anyway,
+/// including the retries.
+///
+/// The locally rejected requests are counted as requests, so the throttling
+/// stops only after the backend accepts enough of the requests that made it
+/// through.
+///
+/// Thread safe and lock-free.
+class ClientThrottler final {
+ public:
+  explicit ClientThrottler(const ClientThrottlerSettings& settings = {});
+
+  void SetSettings(const ClientThrottlerSettings& settings);
+
+  /// Accounts a request that is about to be made, returns false if the
+  /// request should be rejected locally
+  bool Allow();
+
+  /// Accounts a request that was accepted (i.e. processed) by the backend
+  void AccountAccepted() noexcept;
+
+  double GetRejectProbability() const;
+
+  ClientThrottlerStatistics GetStatistics() const;
+
+ private:
+  struct Counter final {
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> accepts{0};
+
+    void Reset() noexcept;
+  };
+
+  struct Result final {
+    std::uint64_t requests{0};
+    std::uint64_t accepts{0};
+
+    Result& operator+=(const Counter& counter) noexcept;
+  };
+
+  double GetRejectProbability(const Result& recent) const;
+
+  std::atomic<double> accepts_multiplier_;
+  std::atomic<std::uint64_t> rejected_{0};
+  mutable utils::statistics::RecentPeriod<Counter, Result,
+                                          utils::datetime::SteadyClock>
+      recent_;
+};
+
+/// @brief ClientThrottler for each of the destinations of a client
+class ClientThrottlers final {
+ public:
+  explicit ClientThrottlers(const ClientThrottlerSettings& settings = {});
+
+  void SetSettings(const ClientThrottlerSettings& settings);
+
+  /// Returns the throttler of the destination, or nullptr if the throttling is
+  /// disabled
+  std::shared_ptr<ClientThrottler> Get(const std::string& destination);
+
+  /// Writes the statistics of each destination labelled with `label`
+  void DumpStatistics(utils::statistics::Writer& writer,
+                      std::string_view label) const;
+
+ private:
+  std::atomic<double> accepts_multiplier_;
+  rcu::RcuMap<std::string, ClientThrottler> throttlers_;
+};
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
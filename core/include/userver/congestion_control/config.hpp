@@ -3,9 +3,11 @@
 /// @file userver/congestion_control/config.hpp
 /// @brief Congestion Control config structures
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/dynamic_config/value.hpp>
 #include <userver/formats/json_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -32,6 +34,34 @@ struct Policy {
 
 Policy Parse(const formats::json::Value& policy, formats::parse::To<Policy>);
 
+/// Policy of the gradient-based adaptive concurrency limit of a handler
+struct GradientPolicy {
+  /// if not set, the limit is calculated but not enforced
+  bool enabled{false};
+
+  std::size_t initial_limit{100};
+  std::size_t min_limit{10};
+  std::size_t max_limit{1000};
+
+  /// the limit is recalculated once per window of RTT samples
+  std::chrono::milliseconds window{500};
+  std::size_t min_window_samples{10};
+
+  /// the limit shrinks once the window RTT exceeds the minimal one more than
+  /// this number of times
+  double rtt_tolerance{1.5};
+
+  /// weight of the new limit in the exponential smoothing
+  double smoothing{0.2};
+
+  /// the minimal RTT is re-measured every this number of windows to follow
+  /// the changes of the handler latency
+  std::size_t min_rtt_reset_windows{600};
+};
+
+GradientPolicy Parse(const formats::json::Value& policy,
+                     formats::parse::To<GradientPolicy>);
+
 namespace impl {
 
 struct RpsCcConfig {
@@ -44,6 +74,17 @@ struct RpsCcConfig {
 
 inline constexpr dynamic_config::Key<RpsCcConfig::Parse> kRpsCcConfig;
 
+struct AdaptiveConcurrencyConfig {
+  /// handler name -> policy, with a `__default__` one
+  dynamic_config::ValueDict<GradientPolicy> policies;
+
+  static AdaptiveConcurrencyConfig Parse(
+      const dynamic_config::DocsMap& docs_map);
+};
+
+inline constexpr dynamic_config::Key<AdaptiveConcurrencyConfig::Parse>
+    kAdaptiveConcurrencyConfig;
+
 }  // namespace impl
 
 }  // namespace congestion_control
@@ -0,0 +1,140 @@
+#pragma once
+
+/// @file userver/dist_lock/dist_lock_group.hpp
+/// @brief @copybrief dist_lock::DistLockGroup
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+/// @ingroup userver_base_classes userver_concurrency
+///
+/// @brief Interface for distributed lock strategies that acquire and prolong
+/// many locks at once
+///
+/// @see dist_lock::DistLockGroup
+class DistLockGroupStrategyBase {
+ public:
+  struct LockRequest {
+    /// Name of the lock, it is unique within a batch
+    std::string lock_name;
+    /// Globally unique ID of the locking entity
+    std::string locker_id;
+    /// The duration for which the lock must be held
+    std::chrono::milliseconds lock_ttl;
+  };
+
+  virtual ~DistLockGroupStrategyBase() = default;
+
+  /// Acquires or prolongs all the locks of the batch, preferably with a single
+  /// query to the backend.
+  ///
+  /// @returns for each request whether the lock is held by its locker
+  /// @throws anything when the batch fails, all the acquisitions of the batch
+  /// fail then.
+  virtual std::vector<bool> AcquireBatch(
+      const std::vector<LockRequest>& requests) = 0;
+
+  /// Releases the lock.
+  ///
+  /// @note Exceptions are ignored.
+  virtual void Release(const std::string& lock_name,
+                       const std::string& locker_id) = 0;
+};
+
+/// Distributed lock group settings
+struct DistLockGroupSettings {
+  /// How long to collect the acquisitions before sending a batch. The lockers
+  /// that got their results from the same batch stay in step, so after the
+  /// first batches all the held locks are prolonged together.
+  std::chrono::milliseconds max_batch_delay{10};
+};
+
+// clang-format off
+
+/// @ingroup userver_concurrency
+///
+/// @brief Coalesces acquisitions and prolongations of many distributed locks
+/// into batches of a single dist_lock::DistLockGroupStrategyBase
+///
+/// A service holding hundreds of locks, e.g. one per shard, creates a
+/// dist_lock::DistLockedWorker or a dist_lock::DistLockedTask for each lock
+/// with a strategy from GetLockStrategy(). Instead of a query per lock and per
+/// prolong interval, the backend receives a single query per interval.
+///
+/// An acquisition waits for up to DistLockGroupSettings::max_batch_delay plus
+/// the batch query, the watchdog of a lock counts its TTL from the start of
+/// the acquisition, so the delay is taken into account.
+///
+/// The group must outlive all the workers that use its strategies.
+///
+/// ## Example usage:
+///
+/// @snippet core/src/dist_lock/dist_lock_group_test.cpp  Sample distlock group
+
+// clang-format on
+
+class DistLockGroup final {
+ public:
+  /// @param strategy batched strategy of the group
+  /// @param settings group settings
+  /// @param task_processor TaskProcessor to send the batches from, using
+  /// current TaskProcessor if `nullptr`
+  explicit DistLockGroup(std::shared_ptr<DistLockGroupStrategyBase> strategy,
+                         const DistLockGroupSettings& settings = {},
+                         engine::TaskProcessor* task_processor = nullptr);
+
+  DistLockGroup(DistLockGroup&&) = delete;
+  DistLockGroup& operator=(DistLockGroup&&) = delete;
+  ~DistLockGroup();
+
+  /// Returns a strategy for a single lock of the group to be passed to
+  /// a dist_lock::DistLockedWorker or a dist_lock::DistLockedTask.
+  std::shared_ptr<DistLockStrategyBase> GetLockStrategy(std::string lock_name);
+
+  /// Number of the batches sent to the backend.
+  std::size_t GetBatchesCount() const noexcept;
+
+ private:
+  class LockStrategy;
+
+  struct PendingRequest {
+    DistLockGroupStrategyBase::LockRequest request;
+    engine::Promise<void> promise;
+  };
+
+  void Acquire(std::string lock_name, std::string locker_id,
+               std::chrono::milliseconds lock_ttl);
+
+  void Run();
+
+  void SendBatch(std::vector<PendingRequest>& batch);
+
+  const std::shared_ptr<DistLockGroupStrategyBase> strategy_;
+  const DistLockGroupSettings settings_;
+
+  engine::Mutex pending_mutex_;
+  std::vector<PendingRequest> pending_;
+  engine::SingleConsumerEvent pending_event_;
+  std::atomic<std::size_t> batches_count_{0};
+
+  engine::TaskWithResult<void> batcher_task_;
+};
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+/// @file userver/dist_lock/file_lock_strategy.hpp
+/// @brief @copybrief dist_lock::FileLockStrategy
+
+#include <optional>
+#include <string>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Host-local lock strategy over an exclusive `flock` of a file
+///
+/// Elects a single leader among the processes of the same host without any
+/// external backend: the lock is held for as long as the process keeps the
+/// file open, and it is freed by the kernel if the process dies, so the TTL
+/// is never exceeded by a dead holder.
+///
+/// Combined with cache::CacheUpdateTrait::SetUpdateLeaderElection() and
+/// `mmap: true` dumps in a `dump-root` on tmpfs, the processes of a host build
+/// a cache snapshot once: the leader updates the cache and writes the dumps,
+/// and the followers map those dumps read-only, sharing the pages of the
+/// snapshot instead of keeping a copy each.
+///
+/// ## Example
+///
+/// @code
+/// SetUpdateLeaderElection(std::make_shared<dist_lock::FileLockStrategy>(
+///     "/dev/shm/my-service/my-cache.lock",
+///     context.GetTaskProcessor("fs-task-processor")));
+/// @endcode
+class FileLockStrategy final : public DistLockStrategyBase {
+ public:
+  /// @param path lock file, created if missing; its directory must exist
+  /// @param fs_task_processor task processor for the blocking file operations
+  FileLockStrategy(std::string path, engine::TaskProcessor& fs_task_processor);
+
+  /// @throws LockIsAcquiredByAnotherHostException if another process (or
+  /// another FileLockStrategy of this process) holds the lock
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override;
+
+  void Release(const std::string& locker_id) override;
+
+  bool IsLocked();
+
+ private:
+  const std::string path_;
+  engine::TaskProcessor& fs_task_processor_;
+  engine::Mutex mutex_;
+  std::optional<fs::blocking::FileDescriptor> file_;
+};
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
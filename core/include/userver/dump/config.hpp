@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json/value.hpp>
@@ -45,6 +46,11 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool use_mmap;
+  bool dump_is_compressed;
+  std::vector<std::string> peers;
+  std::chrono::milliseconds peers_timeout;
+  uint64_t max_delta_count;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
@@ -0,0 +1,39 @@
+#pragma once
+
+/// @file userver/dump/dumped_size.hpp
+/// @brief @copybrief dump::GetDumpedSize
+
+#include <cstddef>
+#include <string_view>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// A Writer that only counts the bytes written
+class SizeCountingWriter final : public Writer {
+ public:
+  void Finish() override {}
+
+  std::size_t GetSize() const noexcept { return size_; }
+
+ private:
+  void WriteRaw(std::string_view data) override { size_ += data.size(); }
+
+  std::size_t size_{0};
+};
+
+/// @brief Returns the size of the dump of the value, an estimation of the
+/// memory its contents take
+template <typename T>
+std::size_t GetDumpedSize(const T& value) {
+  SizeCountingWriter writer;
+  writer.Write(value);
+  return writer.GetSize();
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/helpers.hpp>
 #include <userver/dump/operations.hpp>
+#include <userver/dump/fwd.hpp>
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -21,6 +22,10 @@ namespace utils::statistics {
 class Storage;
 }  // namespace utils::statistics
 
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
 namespace testsuite {
 class DumpControl;
 }  // namespace testsuite
@@ -42,6 +47,10 @@ class DumpableEntity {
   virtual void GetAndWrite(dump::Writer& writer) const = 0;
 
   virtual void ReadAndSet(dump::Reader& reader) = 0;
+
+  /// Reads a delta written by a `DeltaWriter` and applies it to the current
+  /// data, required only if the deltas are reported to `Dumper`
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
 };
 
 enum class UpdateType {
@@ -84,6 +93,11 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to map the dump into memory instead of reading it, ignored for encrypted and compressed dumps, see dump::MmapFileReader | `false`
+/// `compressed` | `boolean` | Whether to write the dump as chunks compressed in parallel, ignored for encrypted dumps, see dump::CompressedWriter | `false`
+/// `peers` | `string[]` | URLs of server::handlers::CacheDumps of the other instances to download the dump from at start if there is no local one, requires components::HttpClient | `[]`
+/// `peers-timeout` | `string` (duration) | Timeout of a dump download from a peer | `1m`
+/// `max-delta-count` | `integer` | Max count of delta dumps written on top of a full dump before the next full dump, 0 disables delta dumps | `0`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
@@ -105,7 +119,8 @@ class Dumper final {
          engine::TaskProcessor& fs_task_processor,
          dynamic_config::Source config_source,
          utils::statistics::Storage& statistics_storage,
-         testsuite::DumpControl& dump_control, DumpableEntity& dumpable);
+         testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
+         clients::http::Client* peers_http_client = nullptr);
 
   Dumper(Dumper&&) = delete;
   Dumper& operator=(Dumper&&) = delete;
@@ -114,10 +129,19 @@ class Dumper final {
   const std::string& Name() const;
 
   /// @brief Read data from a dump, if any
+  ///
+  /// If there is no local dump and `peers` are configured, the dump is
+  /// downloaded from the first peer that has one.
   /// @note Catches and logs any exceptions related to read operation failure
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
   std::optional<TimePoint> ReadDump();
 
+  /// @brief Read data from the latest dump if it is newer than `update_time`,
+  /// e.g. to pick up the dumps written by another instance to a shared storage
+  /// @note Catches and logs any exceptions related to read operation failure
+  /// @returns `update_time` of the loaded dump on success, `null` otherwise
+  std::optional<TimePoint> ReadNewerDump(TimePoint update_time);
+
   /// @brief Forces the `Dumper` to write a dump synchronously
   /// @throws std::exception if the `Dumper` failed to write a dump
   void WriteDumpSyncDebug();
@@ -148,6 +172,18 @@ class Dumper final {
   /// On the other hand, it allows to exactly control the dump expiration.
   void OnUpdateCompleted(TimePoint update_time, UpdateType update_type);
 
+  /// @overload void OnUpdateCompleted()
+  /// @param update_time The time at which the data has been guaranteed to be
+  /// up-to-date
+  /// @param write_delta Writes the changes made by the update
+  ///
+  /// If `max-delta-count` is positive, the next dump only records the deltas
+  /// reported since the previous dump, until `max-delta-count` of them are
+  /// written on top of a full dump. Reading a dump then reads the full dump
+  /// and applies its deltas in order.
+  /// @note `max-age` applies to the full dump
+  void OnUpdateCompleted(TimePoint update_time, DeltaWriter write_delta);
+
   /// @brief Cancel and wait for the task running background writes. Also
   /// disables operations via testsuite dump control.
   ///
@@ -163,7 +199,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1040, 16> impl_;
+  utils::FastPimpl<Impl, 1184, 16> impl_;
 };
 
 }  // namespace dump
@@ -3,6 +3,8 @@
 /// @file userver/dump/fwd.hpp
 /// @brief Forward declarations of dump::Reader, dump::Writer and dump::To
 
+#include <functional>
+
 #include <userver/dump/to.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +14,11 @@ namespace dump {
 class Writer;
 class Reader;
 
+/// Writes the changes made by an update, e.g. the upserted and the removed
+/// items, for `DumpableEntity::ReadAndApplyDelta`. Applying a delta to the
+/// data that already contains its changes must be harmless.
+using DeltaWriter = std::function<void(Writer& writer)>;
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
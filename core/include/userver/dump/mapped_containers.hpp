@@ -0,0 +1,221 @@
+#pragma once
+
+/// @file userver/dump/mapped_containers.hpp
+/// @brief Dump support for read-only containers of trivially copyable types,
+/// which are used in place from a memory-mapped dump
+///
+/// @see dump::MmapFileReader
+/// @ingroup userver_dump_read_write
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A read-only contiguous array of trivially copyable `T`
+///
+/// When read from a memory-mapped dump, points straight into the mapping and
+/// keeps it alive, otherwise owns a copy of the elements. Copying is cheap,
+/// the copies share the elements.
+template <typename T>
+class MappedVector final {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector only supports trivially copyable types");
+
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+  using iterator = const_iterator;
+
+  MappedVector() = default;
+
+  /// Takes ownership of the elements
+  explicit MappedVector(std::vector<T> elements) : size_(elements.size()) {
+    auto storage = std::make_shared<const std::vector<T>>(std::move(elements));
+    data_ = storage->data();
+    owner_ = std::move(storage);
+  }
+
+  /// Points to `size` elements at `data`, which are kept alive by `owner`
+  MappedVector(const T* data, std::size_t size,
+               std::shared_ptr<const void> owner)
+      : data_(data), size_(size), owner_(std::move(owner)) {}
+
+  const T* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  const T& operator[](std::size_t index) const noexcept {
+    UASSERT(index < size_);
+    return data_[index];
+  }
+
+ private:
+  const T* data_{nullptr};
+  std::size_t size_{0};
+  std::shared_ptr<const void> owner_;
+};
+
+template <typename T>
+bool operator==(const MappedVector<T>& lhs, const MappedVector<T>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T>
+bool operator!=(const MappedVector<T>& lhs, const MappedVector<T>& rhs) {
+  return !(lhs == rhs);
+}
+
+/// @brief A read-only map of trivially copyable types, stored as sorted
+/// arrays of keys and values
+///
+/// Lookups are binary searches over the keys. Just like MappedVector, the
+/// arrays are used in place when read from a memory-mapped dump.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class MappedFlatMap final {
+ public:
+  MappedFlatMap() = default;
+
+  /// @brief Sorts the items by key
+  /// @warning The keys must be unique
+  explicit MappedFlatMap(std::vector<std::pair<Key, Value>> items) {
+    std::sort(items.begin(), items.end(),
+              [](const auto& lhs, const auto& rhs) {
+                return Compare{}(lhs.first, rhs.first);
+              });
+
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    keys.reserve(items.size());
+    values.reserve(items.size());
+    for (auto& [key, value] : items) {
+      UINVARIANT(keys.empty() || Compare{}(keys.back(), key),
+                 "Duplicate keys in MappedFlatMap");
+      keys.push_back(key);
+      values.push_back(value);
+    }
+
+    keys_ = MappedVector<Key>{std::move(keys)};
+    values_ = MappedVector<Value>{std::move(values)};
+  }
+
+  /// Takes the keys sorted by `Compare` and their values
+  MappedFlatMap(MappedVector<Key> keys, MappedVector<Value> values)
+      : keys_(std::move(keys)), values_(std::move(values)) {
+    UINVARIANT(keys_.size() == values_.size(),
+               "MappedFlatMap keys and values sizes differ");
+  }
+
+  std::size_t size() const noexcept { return keys_.size(); }
+  bool empty() const noexcept { return keys_.empty(); }
+
+  const MappedVector<Key>& GetKeys() const noexcept { return keys_; }
+  const MappedVector<Value>& GetValues() const noexcept { return values_; }
+
+  /// Returns the value for `key` or `nullptr` if there is no such key
+  const Value* FindOrNullptr(const Key& key) const {
+    const auto it =
+        std::lower_bound(keys_.begin(), keys_.end(), key, Compare{});
+    if (it == keys_.end() || Compare{}(key, *it)) return nullptr;
+    return &values_[it - keys_.begin()];
+  }
+
+  bool Contains(const Key& key) const { return FindOrNullptr(key) != nullptr; }
+
+ private:
+  MappedVector<Key> keys_;
+  MappedVector<Value> values_;
+};
+
+template <typename Key, typename Value, typename Compare>
+bool operator==(const MappedFlatMap<Key, Value, Compare>& lhs,
+                const MappedFlatMap<Key, Value, Compare>& rhs) {
+  return lhs.GetKeys() == rhs.GetKeys() && lhs.GetValues() == rhs.GetValues();
+}
+
+template <typename Key, typename Value, typename Compare>
+bool operator!=(const MappedFlatMap<Key, Value, Compare>& lhs,
+                const MappedFlatMap<Key, Value, Compare>& rhs) {
+  return !(lhs == rhs);
+}
+
+/// @brief dump::MappedVector serialization support
+///
+/// The elements are written as is, aligned relative to the beginning of the
+/// dump, so that they can be used in place from a memory mapping.
+template <typename T>
+void Write(Writer& writer, const MappedVector<T>& value) {
+  writer.Write(value.size());
+  WriteAlignmentPaddingUnsafe(writer, alignof(T));
+  WriteStringViewUnsafe(
+      writer, std::string_view{reinterpret_cast<const char*>(value.data()),
+                               value.size() * sizeof(T)});
+}
+
+/// @brief dump::MappedVector deserialization support
+template <typename T>
+MappedVector<T> Read(Reader& reader, To<MappedVector<T>>) {
+  const auto size = reader.Read<std::size_t>();
+  if (size > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+    throw Error(fmt::format("Invalid MappedVector size in the dump: {}", size));
+  }
+  ReadAlignmentPaddingUnsafe(reader);
+
+  auto mapped = ReadMappedStringViewUnsafe(reader, size * sizeof(T));
+  const auto* data = mapped.data.data();
+  if (mapped.owner &&
+      reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0) {
+    return MappedVector<T>{reinterpret_cast<const T*>(data), size,
+                           std::move(mapped.owner)};
+  }
+
+  std::vector<T> elements(size);
+  mapped.data.copy(reinterpret_cast<char*>(elements.data()),
+                   mapped.data.size());
+  return MappedVector<T>{std::move(elements)};
+}
+
+/// @brief dump::MappedFlatMap serialization support
+template <typename Key, typename Value, typename Compare>
+void Write(Writer& writer, const MappedFlatMap<Key, Value, Compare>& value) {
+  writer.Write(value.GetKeys());
+  writer.Write(value.GetValues());
+}
+
+/// @brief dump::MappedFlatMap deserialization support
+template <typename Key, typename Value, typename Compare>
+MappedFlatMap<Key, Value, Compare> Read(
+    Reader& reader, To<MappedFlatMap<Key, Value, Compare>>) {
+  auto keys = reader.Read<MappedVector<Key>>();
+  auto values = reader.Read<MappedVector<Value>>();
+  if (keys.size() != values.size()) {
+    throw Error(fmt::format(
+        "MappedFlatMap keys and values sizes differ in the dump: {} != {}",
+        keys.size(), values.size()));
+  }
+  return {std::move(keys), std::move(values)};
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
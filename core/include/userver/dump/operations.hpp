@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -12,6 +14,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+struct MappedStringView;
+
 /// Indicates a failure reading or writing a dump. No further operations
 /// should be performed with a failed dump.
 class Error final : public std::runtime_error {
@@ -42,6 +46,11 @@ class Writer {
   virtual void WriteRaw(std::string_view data) = 0;
 
   friend void WriteStringViewUnsafe(Writer& writer, std::string_view value);
+  friend void WriteAlignmentPaddingUnsafe(Writer& writer,
+                                          std::size_t alignment);
+
+ private:
+  std::size_t written_size_{0};
 };
 
 /// A general interface for binary data input
@@ -68,7 +77,16 @@ class Reader {
   /// @throws `Error` on read operation failure
   virtual std::string_view ReadRaw(std::size_t max_size) = 0;
 
+  /// @brief Returns the owner of the memory mapping that the data returned by
+  /// `ReadRaw` points into, `nullptr` if the data is invalidated by the next
+  /// `ReadRaw` call
+  virtual std::shared_ptr<const void> GetMappingOwner() const {
+    return nullptr;
+  }
+
   friend std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t size);
+  friend MappedStringView ReadMappedStringViewUnsafe(Reader& reader,
+                                                    std::size_t size);
 };
 
 namespace impl {
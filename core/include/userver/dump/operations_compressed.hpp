@@ -0,0 +1,129 @@
+#pragma once
+
+/// @file userver/dump/operations_compressed.hpp
+/// @brief Chunked and compressed dump files
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+struct CompressionSettings final {
+  /// Size of the uncompressed data of a single chunk
+  std::size_t chunk_size{1024 * 1024};
+  /// zlib compression level from 1 (fastest) to 9 (smallest)
+  int level{1};
+  /// Max number of chunks compressed or decompressed at once
+  std::size_t max_parallel_chunks{4};
+};
+
+namespace impl {
+
+struct CompressedChunk final {
+  std::uint64_t offset;
+  std::uint64_t compressed_size;
+  std::uint64_t uncompressed_size;
+};
+
+}  // namespace impl
+
+/// @brief A handle to a dump file, which is split into independently
+/// compressed chunks. File operations block the thread.
+///
+/// The chunks are compressed with gzip in parallel in background tasks of the
+/// current task processor, while the next chunk is being serialized. The file
+/// ends with an index of the chunks, which allows CompressedReader to read
+/// and decompress them in parallel.
+class CompressedWriter final : public Writer {
+ public:
+  /// @brief Creates a new dump file and opens it
+  /// @throws `Error` on a filesystem error
+  CompressedWriter(std::string path, boost::filesystem::perms perms,
+                   tracing::ScopeTime& scope, CompressionSettings settings);
+
+  void Finish() override;
+
+ private:
+  struct InFlightChunk {
+    std::size_t uncompressed_size;
+    engine::TaskWithResult<std::string> task;
+  };
+
+  void WriteRaw(std::string_view data) override;
+
+  void StartChunk();
+  void WriteOldestChunk();
+
+  FileWriter file_;
+  const CompressionSettings settings_;
+  std::string chunk_;
+  std::uint64_t offset_{0};
+  std::vector<impl::CompressedChunk> index_;
+  std::deque<InFlightChunk> in_flight_;
+};
+
+/// @brief A handle to a dump file written by CompressedWriter. File
+/// operations block the thread.
+///
+/// Up to CompressionSettings::max_parallel_chunks chunks ahead are read and
+/// decompressed in parallel in background tasks of the current task
+/// processor.
+class CompressedReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file and reads its index
+  /// @throws `Error` on a filesystem error or a malformed file
+  CompressedReader(std::string path, CompressionSettings settings);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  void StartDecompression();
+  bool NextChunk();
+
+  std::string path_;
+  fs::blocking::FileDescriptor file_;
+  const CompressionSettings settings_;
+  std::vector<impl::CompressedChunk> index_;
+  std::size_t next_chunk_{0};
+  std::string curr_chunk_;
+  std::size_t position_{0};
+  std::string buffer_;
+
+  // must be the last member, as the tasks use the file
+  std::deque<engine::TaskWithResult<std::string>> in_flight_;
+};
+
+class CompressedOperationsFactory final : public OperationsFactory {
+ public:
+  CompressedOperationsFactory(boost::filesystem::perms perms,
+                              CompressionSettings settings);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const boost::filesystem::perms perms_;
+  const CompressionSettings settings_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
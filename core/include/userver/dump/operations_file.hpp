@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -52,9 +53,37 @@ class FileReader final : public Reader {
   std::string curr_chunk_;
 };
 
+/// @brief A handle to a dump file, which is mapped into memory instead of
+/// being read. The file data is loaded lazily on first access.
+///
+/// Unlike FileReader, the data returned by `ReadRaw` stays valid after the
+/// reader is destroyed, as long as the owner from `GetMappingOwner` is alive.
+/// This allows the types from <userver/dump/mapped_containers.hpp> to use the
+/// data in place without copying.
+class MmapFileReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file and maps it into memory
+  /// @throws `Error` on a filesystem error
+  explicit MmapFileReader(std::string path);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::shared_ptr<const void> GetMappingOwner() const override;
+
+  std::string path_;
+  std::shared_ptr<const char> mapping_;
+  std::size_t size_{0};
+  std::size_t position_{0};
+};
+
 class FileOperationsFactory final : public OperationsFactory {
  public:
-  explicit FileOperationsFactory(boost::filesystem::perms perms);
+  /// @param use_mmap whether to create MmapFileReader instead of FileReader
+  explicit FileOperationsFactory(boost::filesystem::perms perms,
+                                 bool use_mmap = false);
 
   std::unique_ptr<Reader> CreateReader(std::string full_path) override;
 
@@ -63,6 +92,7 @@ class FileOperationsFactory final : public OperationsFactory {
 
  private:
   const boost::filesystem::perms perms_;
+  const bool use_mmap_;
 };
 
 }  // namespace dump
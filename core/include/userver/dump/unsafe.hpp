@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <string_view>
 
 #include <userver/dump/operations.hpp>
@@ -27,6 +29,29 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size);
 /// @warning The `string_view` will be invalidated on the next `Read` operation
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size);
 
+/// @brief Writes padding, so that the next written byte is aligned to
+/// `alignment` relative to the beginning of the dump
+/// @note Must be read using `ReadAlignmentPaddingUnsafe`
+void WriteAlignmentPaddingUnsafe(Writer& writer, std::size_t alignment);
+
+/// @brief Skips the padding written by `WriteAlignmentPaddingUnsafe`
+void ReadAlignmentPaddingUnsafe(Reader& reader);
+
+/// A view into the data read from a dump, see `ReadMappedStringViewUnsafe`
+struct MappedStringView final {
+  std::string_view data;
+
+  /// Keeps `data` valid, `nullptr` if `data` is only valid until the next
+  /// `Read` operation
+  std::shared_ptr<const void> owner;
+};
+
+/// @brief Reads a non-size-prefixed `std::string_view`, which stays valid for
+/// as long as the returned owner is alive if `reader` is backed by a memory
+/// mapping of the dump
+/// @note The caller must somehow know the string size in advance
+MappedStringView ReadMappedStringViewUnsafe(Reader& reader, std::size_t size);
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
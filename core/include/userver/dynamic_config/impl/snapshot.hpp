@@ -2,10 +2,14 @@
 
 #include <any>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <typeindex>
 #include <typeinfo>
+#include <unordered_set>
 #include <vector>
 
 #include <userver/dynamic_config/fwd.hpp>
@@ -46,6 +50,11 @@ class SnapshotData final {
   SnapshotData(const SnapshotData& defaults,
                const std::vector<KeyValue>& overrides);
 
+  /// Reuses the configs of `previous`, only re-parsing the ones that have
+  /// requested any of the `changed_names` docs while being parsed
+  SnapshotData(const DocsMap& docs_map, const SnapshotData& previous,
+               const std::unordered_set<std::string>& changed_names);
+
   SnapshotData(SnapshotData&&) noexcept = default;
   SnapshotData& operator=(SnapshotData&&) noexcept = default;
 
@@ -59,10 +68,29 @@ class SnapshotData final {
     }
   }
 
+  /// Returns the config, which may outlive the snapshot
+  const std::shared_ptr<const std::any>& GetShared(impl::ConfigId id) const;
+
+  /// Returns an id of the update that has last changed the config, or 0 if
+  /// there is no such config
+  std::uint64_t GetVersion(impl::ConfigId id) const;
+
  private:
+  using Dependencies = std::shared_ptr<const std::vector<std::string>>;
+
   const std::any& Get(impl::ConfigId id) const;
 
-  std::vector<std::any> user_configs_;
+  void ParseConfig(const DocsMap& docs_map, impl::ConfigId id,
+                   Factory factory);
+
+  bool IsAffected(impl::ConfigId id,
+                  const std::unordered_set<std::string>& changed_names) const;
+
+  // shared between snapshots to make the partial updates cheap
+  std::vector<std::shared_ptr<const std::any>> user_configs_;
+  // names of the docs requested by the factories, nullptr if unknown
+  std::vector<Dependencies> dependencies_;
+  std::vector<std::uint64_t> versions_;
 };
 
 struct StorageData;
@@ -3,8 +3,12 @@
 /// @file userver/dynamic_config/source.hpp
 /// @brief @copybrief dynamic_config::Source
 
+#include <any>
+#include <exception>
 #include <string_view>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
@@ -80,10 +84,18 @@ class Source final {
     return VariableSnapshotPtr{GetSnapshot(), key};
   }
 
+  /// Returns a copy of the current value of the config variable. Cheaper than
+  /// GetSnapshot, as the values are cached per thread until the next update
+  /// of the config.
   template <typename Key>
-  VariableOfKey<Key> GetCopy(Key key) const {
-    const auto snapshot = GetSnapshot();
-    return snapshot[key];
+  VariableOfKey<Key> GetCopy(Key) const {
+    using VariableType = VariableOfKey<Key>;
+    try {
+      return std::any_cast<const VariableType&>(
+          GetCachedConfig(impl::kConfigId<Key>));
+    } catch (const std::exception& ex) {
+      impl::WrapGetError(ex, typeid(VariableType));
+    }
   }
 
   /// Subscribes to dynamic-config updates using a member function, named
@@ -100,6 +112,23 @@ class Source final {
         });
   }
 
+  /// Subscribes to updates of the specified config keys only. The function is
+  /// not invoked on the updates that leave all of the `keys` untouched.
+  /// Also immediately invokes the function with the current config snapshot.
+  template <typename Class, typename... Keys>
+  concurrent::AsyncEventSubscriberScope UpdateAndListen(
+      Class* obj, std::string_view name,
+      void (Class::*func)(const dynamic_config::Snapshot& config),
+      const Keys&... /*keys*/) {
+    static_assert(sizeof...(Keys) != 0, "Specify at least one key");
+    return DoUpdateAndListen(
+        concurrent::FunctionId(obj), name,
+        {impl::kConfigId<Keys>...},
+        [obj, func](const dynamic_config::Snapshot& config) {
+          (obj->*func)(config);
+        });
+  }
+
   EventSource& GetEventChannel();
 
  private:
@@ -107,6 +136,13 @@ class Source final {
       concurrent::FunctionId id, std::string_view name,
       EventSource::Function&& func);
 
+  concurrent::AsyncEventSubscriberScope DoUpdateAndListen(
+      concurrent::FunctionId id, std::string_view name,
+      std::vector<impl::ConfigId> ids, EventSource::Function&& func);
+
+  // The reference is valid until the current task yields
+  const std::any& GetCachedConfig(impl::ConfigId id) const;
+
   impl::StorageData* storage_;
 };
 
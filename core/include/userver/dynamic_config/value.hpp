@@ -12,6 +12,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config {
 
+namespace impl {
+class SnapshotData;
+}  // namespace impl
+
 class DocsMap final {
  public:
   /* Returns config item or throws an exception if key is missing */
@@ -30,7 +34,15 @@ class DocsMap final {
 
   bool AreContentsEqual(const DocsMap& other) const;
 
+  /// Returns the names of the docs that were added, removed or changed
+  /// compared to `previous`
+  std::unordered_set<std::string> GetChangedNames(
+      const DocsMap& previous) const;
+
  private:
+  // for tracking the docs requested by each config
+  friend class impl::SnapshotData;
+
   std::unordered_map<std::string, formats::json::Value> docs_;
   mutable std::unordered_set<std::string> requested_names_;
 };
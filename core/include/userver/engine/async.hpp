@@ -156,6 +156,37 @@ template <typename Function, typename... Args>
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
+/// @brief Runs a short non-blocking function call using specified task
+/// processor without a coroutine
+///
+/// The function runs to completion right on a worker thread, so the spawn
+/// does not take a coroutine from the pool and costs no context switches.
+/// Suits tiny callbacks, e.g. notifying a waiter or updating a metric.
+///
+/// @warning The function must not wait, sleep or yield: any waiting on the
+/// engine primitives is an invariant violation. Use AsyncNoSpan for anything
+/// that may block.
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncMicrotaskNoSpan(TaskProcessor& task_processor,
+                                        Function&& f, Args&&... args) {
+  auto wrapped_call_ptr = utils::impl::WrapCall(std::forward<Function>(f),
+                                                std::forward<Args>(args)...);
+  using ResultType = decltype(wrapped_call_ptr->Retrieve());
+  return TaskWithResult<ResultType>(task_processor, Task::Importance::kNormal,
+                                    {}, std::move(wrapped_call_ptr),
+                                    impl::TaskKind::kMicrotask);
+}
+
+/// @brief Runs a short non-blocking function call using task processor of the
+/// caller without a coroutine
+/// @see AsyncMicrotaskNoSpan
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncMicrotaskNoSpan(Function&& f, Args&&... args) {
+  return AsyncMicrotaskNoSpan(current_task::GetTaskProcessor(),
+                              std::forward<Function>(f),
+                              std::forward<Args>(args)...);
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
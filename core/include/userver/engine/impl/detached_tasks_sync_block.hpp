@@ -35,8 +35,9 @@ class DetachedTasksSyncBlock final {
   static void Dispose(Token& token) noexcept;
 
  private:
+  struct Shard;
   struct Impl;
-  utils::FastPimpl<Impl, 48, 8> impl_;
+  utils::FastPimpl<Impl, 16, 8> impl_;
 };
 
 }  // namespace engine::impl
@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <typeinfo>
 
+#include <userver/utils/assert.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -83,6 +84,8 @@ class DataImpl final : public ConditionalDataBase<Kind> {
 
 [[noreturn]] void ReportVariableNotSet(const std::type_info& type);
 
+Key GetVariableCount() noexcept;
+
 class Storage final {
  public:
   Storage();
@@ -142,7 +145,13 @@ class Storage final {
   }
 
  private:
-  DataBase* GetGeneric(Key key) noexcept;
+  // Variables are registered at static initialization, so each one has a
+  // fixed slot and the lookup is an array index without any calls
+  DataBase* GetGeneric(Key key) noexcept {
+    UASSERT(key < GetVariableCount());
+    if (!slots_) return nullptr;
+    return slots_[key];
+  }
 
   void SetGeneric(Key key, NormalDataBase& node, bool has_existing_variable);
 
@@ -150,6 +159,10 @@ class Storage final {
 
   void EraseInherited(Key key) noexcept;
 
+  void AllocateSlots();
+
+  void DoSetGeneric(Key key, DataBase& node);
+
   // Provides strong exception guarantee. Does not delete the old data, if any.
   template <typename T, VariableKind Kind, typename... Args>
   T& DoEmplace(Key key, bool has_existing_variable, Args&&... args) {
@@ -159,6 +172,8 @@ class Storage final {
     return new_data.release()->Get();
   }
 
+  std::unique_ptr<DataBase*[]> slots_;
+
   struct Impl;
   utils::FastPimpl<Impl, 40, 8> impl_;
 };
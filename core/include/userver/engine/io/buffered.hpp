@@ -3,8 +3,12 @@
 /// @file userver/engine/io/buffered.hpp
 /// @brief Buffered I/O wrappers
 
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include <userver/compiler/select.hpp>
 #include <userver/engine/deadline.hpp>
@@ -83,6 +87,84 @@ class BufferedReader final {
   utils::FastPimpl<impl::Buffer, kBufferSize, kBufferAlignment, true> buffer_;
 };
 
+/// Size of the big-endian length prefix of a frame
+enum class FramePrefix : std::uint8_t {
+  kUint8 = 1,
+  kUint16 = 2,
+  kUint32 = 4,
+};
+
+/// @brief Buffered input that parses the data in place
+///
+/// Unlike BufferedReader hands out views into its fixed-size buffer instead of
+/// copying the data into strings, so binary protocols may parse the frames
+/// without allocations. The unconsumed data is always contiguous: when the
+/// buffer runs out of space the unconsumed tail is moved to its beginning,
+/// which is cheap as the tail is usually a part of a single frame.
+///
+/// The views returned by Peek(), ReadFrame() and ReadUntil() stay valid until
+/// the next call that reads from the source, i.e. any call but Peek() and
+/// Consume().
+///
+/// Does not own the source, it must outlive the reader.
+///
+/// @snippet engine/io/buffered_test.cpp RingBufferedReader frames
+class RingBufferedReader final {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 16 * 1024;
+
+  /// Creates a reader with the buffer of `capacity` bytes, no frame or token
+  /// may exceed it.
+  explicit RingBufferedReader(ReadableBase& source,
+                              std::size_t capacity = kDefaultCapacity);
+
+  RingBufferedReader(RingBufferedReader&&) noexcept;
+  RingBufferedReader& operator=(RingBufferedReader&&) noexcept;
+  ~RingBufferedReader();
+
+  /// Size of the buffer
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+  /// Returns the buffered data that was not consumed yet
+  std::string_view Peek() const noexcept {
+    return {data_.get() + begin_, end_ - begin_};
+  }
+
+  /// Marks the first `num_bytes` of Peek() as processed
+  void Consume(std::size_t num_bytes) noexcept;
+
+  /// @brief Reads from the source until at least `num_bytes` are buffered.
+  /// @returns the buffered data, less than `num_bytes` only on EOF.
+  /// @throws IoException if `num_bytes` exceed the capacity.
+  /// @throws IoTimeout/IoCancelled, the data read so far stays buffered.
+  std::string_view Fill(std::size_t num_bytes, Deadline deadline = {});
+
+  /// @brief Reads a frame prefixed with its big-endian payload length and
+  /// consumes it.
+  /// @returns the payload of the frame or std::nullopt on EOF between frames.
+  /// @throws IoException on EOF inside of a frame or if the frame does not
+  /// fit into the buffer.
+  std::optional<std::string_view> ReadFrame(FramePrefix prefix,
+                                            Deadline deadline = {});
+
+  /// @brief Reads the data up to and including the terminator and consumes
+  /// it.
+  /// @returns the data or std::nullopt on EOF before the terminator. No data
+  /// is consumed in the latter case.
+  /// @throws IoException if the terminator is not found within the capacity.
+  std::optional<std::string_view> ReadUntil(char terminator,
+                                            Deadline deadline = {});
+
+ private:
+  std::size_t FillOnce(Deadline deadline);
+
+  ReadableBase* source_;
+  std::size_t capacity_;
+  std::unique_ptr<char[]> data_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
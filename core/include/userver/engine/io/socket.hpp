@@ -46,6 +46,21 @@ class USERVER_NODISCARD Socket final : public RwBase {
     Sockaddr src_addr;
   };
 
+  /// Datagram buffer for RecvSomeBatchFrom
+  struct RecvDatagram {
+    void* buf{nullptr};
+    size_t len{0};
+    size_t bytes_received{0};
+    Sockaddr src_addr;
+  };
+
+  /// Datagram for SendAllBatchTo
+  struct SendDatagram {
+    const Sockaddr* dest_addr{nullptr};
+    const void* data{nullptr};
+    size_t len{0};
+  };
+
   /// Constructs an invalid socket.
   Socket() = default;
 
@@ -122,6 +137,24 @@ class USERVER_NODISCARD Socket final : public RwBase {
   [[nodiscard]] size_t SendAllTo(const Sockaddr& dest_addr, const void* buf,
                                  size_t len, Deadline deadline);
 
+  /// @brief Receives at least one datagram into the buffers, taking as many of
+  /// the already queued datagrams as fit with a single syscall (recvmmsg).
+  /// Suspends current task only if there are no datagrams queued.
+  /// @returns the number of the filled datagrams at the front of `datagrams`
+  /// @note Not for SocketType::kStream connections.
+  [[nodiscard]] size_t RecvSomeBatchFrom(RecvDatagram* datagrams, size_t count,
+                                         Deadline deadline);
+
+  /// @brief Sends all the datagrams, as many per syscall (sendmmsg) as the
+  /// socket buffer takes. Suspends current task while the buffer is full.
+  /// @returns `count`
+  /// @throws IoTimeout or IoCancelled with the number of the sent datagrams
+  /// as IoInterrupted::BytesTransferred()
+  /// @note Sockaddr domains must match the socket's domain.
+  /// @note Not for SocketType::kStream connections.
+  [[nodiscard]] size_t SendAllBatchTo(const SendDatagram* datagrams,
+                                      size_t count, Deadline deadline);
+
   /// File descriptor corresponding to this socket.
   int Fd() const;
 
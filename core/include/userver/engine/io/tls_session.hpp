@@ -0,0 +1,88 @@
+#pragma once
+
+/// @file userver/engine/io/tls_session.hpp
+/// @brief TLS session resumption for engine::io::TlsWrapper
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+class TlsWrapper;
+
+/// Handshake counters of the TLS connections sharing a session store
+struct TlsHandshakeStatistics {
+  /// Handshakes that negotiated a new session
+  std::uint64_t full{0};
+
+  /// Handshakes that resumed a previously negotiated session
+  std::uint64_t resumed{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const TlsHandshakeStatistics& stats);
+
+/// @brief Session ticket keys of TLS servers for the stateless session
+/// resumption.
+///
+/// Tickets are encrypted with the current key, which is replaced with a new
+/// random one every `rotation_period`. Tickets of the previous key are still
+/// accepted and reissued, so a ticket is valid for at most two periods.
+///
+/// Thread safe, must outlive all the TlsWrapper instances using it.
+class TlsSessionTicketKeys final {
+ public:
+  explicit TlsSessionTicketKeys(
+      std::chrono::seconds rotation_period = std::chrono::hours{1});
+  ~TlsSessionTicketKeys();
+
+  TlsSessionTicketKeys(const TlsSessionTicketKeys&) = delete;
+  TlsSessionTicketKeys& operator=(const TlsSessionTicketKeys&) = delete;
+
+  /// Replaces the current key with a new random one
+  void Rotate();
+
+  /// Handshakes of the servers using the keys
+  TlsHandshakeStatistics GetStatistics() const;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// @brief Cache of TLS client sessions for the resumption, keyed by the
+/// server name and the peer address.
+///
+/// Thread safe, must outlive all the TlsWrapper instances using it.
+class TlsClientSessionCache final {
+ public:
+  explicit TlsClientSessionCache(std::size_t max_size = 1024);
+  ~TlsClientSessionCache();
+
+  TlsClientSessionCache(const TlsClientSessionCache&) = delete;
+  TlsClientSessionCache& operator=(const TlsClientSessionCache&) = delete;
+
+  /// Drops all the cached sessions
+  void Clear();
+
+  /// Handshakes of the clients using the cache
+  TlsHandshakeStatistics GetStatistics() const;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_session.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -18,6 +19,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// Whether the symmetric encryption of a TlsWrapper is offloaded to the kernel
+enum class KernelTls {
+  /// All the data is encrypted in userspace by OpenSSL
+  kDisabled,
+
+  /// After the handshake the session keys are passed to the kernel (kTLS),
+  /// and plain socket I/O is used for the directions the kernel accepted.
+  /// Falls back to userspace encryption if the kernel, the OpenSSL build or
+  /// the negotiated cipher does not support it.
+  kIfSupported,
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe.
@@ -26,16 +39,25 @@ namespace engine::io {
 /// @snippet src/engine/io/tls_wrapper_test.cpp TLS wrapper usage
 class USERVER_NODISCARD TlsWrapper final : public RwBase {
  public:
-  /// Starts a TLS client on an opened socket
-  static TlsWrapper StartTlsClient(Socket&& socket,
-                                   const std::string& server_name,
-                                   Deadline deadline);
-
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS client on an opened socket
+  /// @param session_cache if set, a session of the previous connections to
+  ///   the same server name and peer address is resumed if possible, and the
+  ///   new sessions of the connection are stored into the cache
+  static TlsWrapper StartTlsClient(
+      Socket&& socket, const std::string& server_name, Deadline deadline,
+      KernelTls kernel_tls = KernelTls::kDisabled,
+      TlsClientSessionCache* session_cache = nullptr);
+
+  /// @brief Starts a TLS server on an opened socket
+  /// @param session_ticket_keys if set, the clients get session tickets
+  ///   encrypted with the keys and may resume the sessions on the following
+  ///   connections; otherwise no tickets are issued
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      KernelTls kernel_tls = KernelTls::kDisabled,
+      TlsSessionTicketKeys* session_ticket_keys = nullptr);
 
   ~TlsWrapper() override;
 
@@ -67,9 +89,26 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends `len` bytes of the file `fd` starting from `offset` without
+  /// copying them to userspace.
+  /// @note Can return less than len if socket is closed by peer or the file
+  ///   ends earlier.
+  /// @throws TlsException if the kernel TLS send offload is not active, see
+  ///   IsKernelTlsSendActive().
+  [[nodiscard]] size_t SendFile(int fd, size_t offset, size_t len,
+                                Deadline deadline);
+
+  /// Whether the outgoing data is encrypted by the kernel
+  bool IsKernelTlsSendActive() const;
+
+  /// Whether the incoming data is decrypted by the kernel
+  bool IsKernelTlsRecvActive() const;
+
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @note The socket can not be used without TLS after the kernel TLS
+  ///   offload, in that case it is closed and an invalid socket is returned.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
@@ -0,0 +1,129 @@
+#pragma once
+
+/// @file userver/engine/reader_biased_shared_mutex.hpp
+/// @brief @copybrief engine::ReaderBiasedSharedMutex
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>  // for std locks
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @ingroup userver_concurrency
+///
+/// @brief A reader-biased std::shared_mutex replacement for asynchronous tasks
+///
+/// Readers only modify a reader counter of the current thread, so read
+/// locking from all the worker threads scales, unlike engine::SharedMutex,
+/// where all the readers contend for a single counter. A writer revokes the
+/// bias: it makes the new readers wait, then waits for all the counters to
+/// drain. Writers are therefore much slower than for engine::SharedMutex,
+/// and each mutex occupies a cache line per reader slot.
+///
+/// Use it for read-mostly locks that are taken by all the worker threads
+/// and are rarely locked exclusively. Writers are preferred over the readers
+/// that arrive after them.
+///
+/// A read lock may be released on a different thread than it was taken on.
+///
+/// @see @ref md_en_userver_synchronization
+class ReaderBiasedSharedMutex final {
+ public:
+  ReaderBiasedSharedMutex();
+  ~ReaderBiasedSharedMutex();
+
+  ReaderBiasedSharedMutex(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex(ReaderBiasedSharedMutex&&) = delete;
+  ReaderBiasedSharedMutex& operator=(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex& operator=(ReaderBiasedSharedMutex&&) = delete;
+
+  void lock();
+  void unlock();
+
+  bool try_lock();
+
+  template <typename Rep, typename Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period>&);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_until(const std::chrono::time_point<Clock, Duration>&);
+
+  bool try_lock_until(Deadline deadline);
+
+  void lock_shared();
+  void unlock_shared();
+  bool try_lock_shared();
+
+  template <typename Rep, typename Period>
+  bool try_lock_shared_for(const std::chrono::duration<Rep, Period>&);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration>&);
+
+  bool try_lock_shared_until(Deadline deadline);
+
+ private:
+  static constexpr std::size_t kReaderSlotCount = 32;
+
+  // readers may unlock on another thread, so the slots are summed up and a
+  // single slot may become negative
+  struct alignas(64) ReaderSlot final {
+    std::atomic<std::int64_t> count{0};
+  };
+
+  std::atomic<std::int64_t>& GetReaderSlot() noexcept;
+  std::int64_t CountReaders() const noexcept;
+
+  bool TryLockSharedFastPath();
+  void NotifyWriter();
+  bool WaitForNoWriter(Deadline deadline);
+  void RevokeWriter();
+
+  std::array<ReaderSlot, kReaderSlotCount> reader_slots_{};
+  std::atomic<bool> has_writer_{false};
+
+  // serializes the writers, locked for the whole exclusive section
+  Mutex writer_mutex_;
+
+  // protects the waits for has_writer_ and for the readers to drain
+  Mutex state_mutex_;
+  ConditionVariable readers_cv_;
+  ConditionVariable writer_cv_;
+};
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_until(Deadline::FromDuration(duration));
+}
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_shared_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_shared_until(Deadline::FromDuration(duration));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_until(Deadline::FromTimePoint(until));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_shared_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_shared_until(Deadline::FromTimePoint(until));
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
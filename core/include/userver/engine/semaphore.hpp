@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <shared_mutex>  // for std locks
 #include <stdexcept>
 
@@ -104,11 +105,13 @@ class Semaphore final {
 
   TryLockStatus DoTryLock(Counter count);
   TryLockStatus LockFastPath(Counter count);
+  TryLockStatus LockSpinPath(Counter count);
   bool LockSlowPath(Deadline, Counter count);
 
   impl::FastPimplWaitList lock_waiters_;
   std::atomic<Counter> acquired_locks_;
   std::atomic<Counter> capacity_;
+  std::atomic<std::uint32_t> spin_estimate_{0};
 };
 
 /// A replacement for std::shared_lock that accepts Deadline arguments
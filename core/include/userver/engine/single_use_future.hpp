@@ -0,0 +1,189 @@
+#pragma once
+
+/// @file userver/engine/single_use_future.hpp
+/// @brief @copybrief engine::SingleUseFuture
+
+#include <exception>
+#include <future>
+#include <utility>
+
+#include <userver/engine/single_use_event.hpp>
+#include <userver/utils/result_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+template <typename T>
+class SingleUsePromise;
+
+// clang-format off
+
+/// @ingroup userver_concurrency
+///
+/// @brief A single-producer, single-consumer future that does not allocate
+///
+/// Unlike engine::Future, the state is stored in the SingleUseFuture itself,
+/// so the pair costs no heap allocation. In exchange:
+/// - the SingleUseFuture can neither be copied nor moved, the
+///   engine::SingleUsePromise refers to it;
+/// - get() does not support task cancellation, the same as
+///   engine::SingleUseEvent;
+/// - the destructor of a SingleUseFuture waits for its promise to be
+///   satisfied or destroyed, so the promise must not be kept indefinitely.
+///
+/// Use it for short request/response exchanges between tasks, where the
+/// producer always responds.
+///
+/// ## Example usage:
+///
+/// @snippet engine/single_use_future_test.cpp  Sample engine::SingleUseFuture usage
+///
+/// @see @ref md_en_userver_synchronization
+
+// clang-format on
+
+template <typename T>
+class SingleUseFuture final {
+ public:
+  SingleUseFuture() = default;
+
+  SingleUseFuture(const SingleUseFuture&) = delete;
+  SingleUseFuture(SingleUseFuture&&) = delete;
+  SingleUseFuture& operator=(const SingleUseFuture&) = delete;
+  SingleUseFuture& operator=(SingleUseFuture&&) = delete;
+
+  /// Waits for the promise, if it was retrieved
+  ~SingleUseFuture();
+
+  /// @brief Retrieves the promise associated with this future.
+  /// @throw std::future_error if the promise has already been retrieved.
+  [[nodiscard]] SingleUsePromise<T> get_promise();
+
+  /// @brief Waits for the value availability without cancellations and
+  /// retrieves it.
+  /// @throw std::future_error if the promise has not been retrieved, if the
+  /// promise has been destroyed without setting a value or if the value has
+  /// already been retrieved.
+  T get();
+
+ private:
+  friend class SingleUsePromise<T>;
+
+  SingleUseEvent event_;
+  utils::ResultStore<T> result_store_;
+  bool is_promise_retrieved_{false};
+  bool is_value_retrieved_{false};
+};
+
+/// @brief The producer side of an engine::SingleUseFuture
+///
+/// The promise is movable and refers to its future, which must not be
+/// destroyed earlier, see engine::SingleUseFuture.
+template <typename T>
+class SingleUsePromise final {
+ public:
+  SingleUsePromise(const SingleUsePromise&) = delete;
+  SingleUsePromise(SingleUsePromise&&) noexcept;
+  SingleUsePromise& operator=(const SingleUsePromise&) = delete;
+  SingleUsePromise& operator=(SingleUsePromise&&) noexcept;
+
+  /// Sets std::future_errc::broken_promise if no value or exception was set
+  ~SingleUsePromise();
+
+  /// @brief Stores a value for retrieval, takes no arguments for `T = void`.
+  /// @throw std::future_error if a value or an exception has already been set.
+  template <typename... Args>
+  void set_value(Args&&... args);
+
+  /// @brief Stores an exception to be thrown on retrieval.
+  /// @throw std::future_error if a value or an exception has already been set.
+  void set_exception(std::exception_ptr ex);
+
+ private:
+  friend class SingleUseFuture<T>;
+
+  explicit SingleUsePromise(SingleUseFuture<T>& future) noexcept
+      : future_(&future) {}
+
+  SingleUseFuture<T>& ReleaseFuture();
+
+  SingleUseFuture<T>* future_;
+};
+
+template <typename T>
+SingleUseFuture<T>::~SingleUseFuture() {
+  if (is_promise_retrieved_) event_.WaitNonCancellable();
+}
+
+template <typename T>
+SingleUsePromise<T> SingleUseFuture<T>::get_promise() {
+  if (std::exchange(is_promise_retrieved_, true)) {
+    throw std::future_error(std::future_errc::future_already_retrieved);
+  }
+  return SingleUsePromise<T>{*this};
+}
+
+template <typename T>
+T SingleUseFuture<T>::get() {
+  if (!is_promise_retrieved_ || std::exchange(is_value_retrieved_, true)) {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  event_.WaitNonCancellable();
+  return result_store_.Retrieve();
+}
+
+template <typename T>
+SingleUsePromise<T>::SingleUsePromise(SingleUsePromise&& other) noexcept
+    : future_(std::exchange(other.future_, nullptr)) {}
+
+template <typename T>
+SingleUsePromise<T>& SingleUsePromise<T>::operator=(
+    SingleUsePromise&& other) noexcept {
+  if (this != &other) {
+    // breaks the previous promise, if any
+    const SingleUsePromise previous{std::move(*this)};
+    future_ = std::exchange(other.future_, nullptr);
+  }
+  return *this;
+}
+
+template <typename T>
+SingleUsePromise<T>::~SingleUsePromise() {
+  if (future_) {
+    set_exception(std::make_exception_ptr(
+        std::future_error(std::future_errc::broken_promise)));
+  }
+}
+
+template <typename T>
+template <typename... Args>
+void SingleUsePromise<T>::set_value(Args&&... args) {
+  auto& future = ReleaseFuture();
+  try {
+    future.result_store_.SetValue(std::forward<Args>(args)...);
+  } catch (...) {
+    future.result_store_.SetException(std::current_exception());
+  }
+  // the future may be destroyed as soon as the event is sent
+  future.event_.Send();
+}
+
+template <typename T>
+void SingleUsePromise<T>::set_exception(std::exception_ptr ex) {
+  auto& future = ReleaseFuture();
+  future.result_store_.SetException(std::move(ex));
+  future.event_.Send();
+}
+
+template <typename T>
+SingleUseFuture<T>& SingleUsePromise<T>::ReleaseFuture() {
+  if (!future_) {
+    throw std::future_error(std::future_errc::promise_already_satisfied);
+  }
+  return *std::exchange(future_, nullptr);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
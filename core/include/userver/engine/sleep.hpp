@@ -15,6 +15,20 @@ namespace engine {
 /// other tasks to execute
 void Yield();
 
+/// @brief Yields if the current task has been running without a context switch
+/// for longer than the `cooperative-yield-slice` of its task processor.
+///
+/// An opt-in preemption point for long CPU-bound loops. The clock is read
+/// once in 64 calls, so the function is cheap enough to be called for each
+/// element. Does nothing if the option is not set or outside of a coroutine.
+///
+/// utils::CpuRelax, utils::StreamingCpuRelax and the formats::json
+/// serialization into a string call it.
+///
+/// @warning The same as with engine::Yield(), do not call it while holding
+/// a lock that is not coroutine-aware, e.g. std::mutex.
+void YieldIfTimeSliceExceeded();
+
 /// @cond
 /// Recursion stoppers/specializations
 void InterruptibleSleepUntil(Deadline);
@@ -13,6 +13,11 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io {
+class PipeReader;
+class PipeWriter;
+}  // namespace engine::io
+
 namespace engine::subprocess {
 
 class ChildProcessImpl;
@@ -63,9 +68,22 @@ class ChildProcess final {
   /// Send a signal to the child process.
   void SendSignal(int signum);
 
+  /// The writing end of the pipe connected to the stdin of the child process,
+  /// closing it sends EOF to the child.
+  /// @note Available only if the stdin is piped, see ExecOptions::pipes
+  io::PipeWriter& GetStdin();
+
+  /// The reading end of the pipe connected to the stdout of the child process.
+  /// @note Available only if the stdout is piped, see ExecOptions::pipes
+  io::PipeReader& GetStdout();
+
+  /// The reading end of the pipe connected to the stderr of the child process.
+  /// @note Available only if the stderr is piped, see ExecOptions::pipes
+  io::PipeReader& GetStderr();
+
  private:
   static constexpr std::size_t kImplSize =
-      compiler::SelectSize().For64Bit(24).For32Bit(12);
+      compiler::SelectSize().For64Bit(144).For32Bit(72);
   static constexpr std::size_t kImplAlignment = alignof(void*);
   utils::FastPimpl<ChildProcessImpl, kImplSize, kImplAlignment> impl_;
 };
@@ -11,6 +11,7 @@
 #include <userver/engine/subprocess/child_process.hpp>
 #include <userver/engine/subprocess/environment_variables.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/flags.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,18 +23,52 @@ class ThreadControl;
 
 namespace subprocess {
 
+/// Standard streams of a child process
+enum class StdStream {
+  kNone = 0,
+  kStdin = 1 << 0,
+  kStdout = 1 << 1,
+  kStderr = 1 << 2,
+};
+
+/// Options of ProcessStarter::Exec
+struct ExecOptions final {
+  /// Redefines all the environment variables, the current environment is used
+  /// if not set
+  std::optional<EnvironmentVariables> env;
+  /// Variables to add to the environment, existing values are replaced
+  std::optional<EnvironmentVariablesUpdate> env_update;
+  /// A file to append the stdout of the child process to
+  std::optional<std::string> stdout_file;
+  /// A file to append the stderr of the child process to
+  std::optional<std::string> stderr_file;
+  /// The streams of the child process to connect to the pipes, which are
+  /// available through ChildProcess::GetStdin, ChildProcess::GetStdout and
+  /// ChildProcess::GetStderr. A piped stream must not be redirected to a file.
+  utils::Flags<StdStream> pipes;
+};
+
 /// @ingroup userver_clients
 ///
 /// @brief Creates a new OS subprocess and executes a command in it.
+///
+/// The subprocess is created with `posix_spawn`, which does not copy the page
+/// tables of the parent process, so the start does not slow down with the
+/// memory usage of the service.
 class ProcessStarter {
  public:
   explicit ProcessStarter(TaskProcessor& task_processor);
 
+  /// Exec subprocess with the `options`.
+  /// @throws std::system_error if the command could not be started
+  ChildProcess Exec(const std::string& command,
+                    const std::vector<std::string>& args,
+                    ExecOptions&& options);
+
   /// `env` redefines all environment variables.
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
       const EnvironmentVariables& env,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
@@ -42,14 +77,12 @@ class ProcessStarter {
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
       EnvironmentVariablesUpdate env_update,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
   /// Exec subprocess using current environment.
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
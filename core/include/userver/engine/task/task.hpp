@@ -30,6 +30,13 @@ class TaskContext;
 class DetachedTasksSyncBlock;
 class ContextAccessor;
 using TaskPayload = std::unique_ptr<utils::impl::WrappedCallBase>;
+
+enum class TaskKind {
+  // runs in a coroutine with a stack of its own, may wait and yield
+  kCoroutine,
+  // runs to completion right on the worker thread, must not wait or yield
+  kMicrotask,
+};
 }  // namespace impl
 
 /// Asynchronous task
@@ -47,6 +54,22 @@ class USERVER_NODISCARD Task {
     kCritical,
   };
 
+  /// @brief Task priority within its TaskProcessor
+  ///
+  /// Only `priority-task-queue` task processors serve the priorities
+  /// separately, see engine::current_task::SetPriority().
+  enum class Priority {
+    /// Latency-critical task, served before the others
+    kHigh,
+
+    /// Default priority
+    kNormal,
+
+    /// Batch work, served when there are no tasks of higher priorities and
+    /// with a small share of the worker time otherwise
+    kLow,
+  };
+
   /// Task state
   enum class State {
     kInvalid,    ///< Unusable
@@ -161,7 +184,7 @@ class USERVER_NODISCARD Task {
 
   /// Constructor for internal use
   Task(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-       impl::TaskPayload&&);
+       impl::TaskPayload&&, impl::TaskKind = impl::TaskKind::kCoroutine);
 
   /// Marks task as invalid
   void Invalidate() noexcept;
@@ -203,6 +226,15 @@ void AccountSpuriousWakeup();
 /// Returns task coroutine stack size
 size_t GetStackSize();
 
+/// @brief Sets the priority of the current task.
+///
+/// The tasks created by the current task inherit its priority. The current
+/// task is scheduled with the new priority starting from its next wakeup.
+void SetPriority(Task::Priority priority);
+
+/// Returns the priority of the current task
+Task::Priority GetPriority();
+
 }  // namespace current_task
 
 template <typename Rep, typename Period>
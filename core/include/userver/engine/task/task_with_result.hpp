@@ -39,13 +39,15 @@ class USERVER_NODISCARD TaskWithResult : public Task {
   /// @param importance specifies whether this task can be auto-cancelled
   ///   in case of task processor overload
   /// @param wrapped_call_ptr task body
+  /// @param kind whether the task body runs in a coroutine
   /// @see Async()
   TaskWithResult(
       TaskProcessor& task_processor, Task::Importance importance,
       Deadline deadline,
-      std::unique_ptr<utils::impl::WrappedCall<T>>&& wrapped_call_ptr)
+      std::unique_ptr<utils::impl::WrappedCall<T>>&& wrapped_call_ptr,
+      impl::TaskKind kind = impl::TaskKind::kCoroutine)
       : Task(task_processor, importance, Task::WaitMode::kSingleWaiter,
-             deadline, std::move(wrapped_call_ptr)) {}
+             deadline, std::move(wrapped_call_ptr), kind) {}
 
   TaskWithResult(const TaskWithResult&) = delete;
   TaskWithResult& operator=(const TaskWithResult&) = delete;
@@ -3,6 +3,10 @@
 /// @file userver/fs/fs_cache_client.hpp
 /// @brief @copybref fs::FsCacheClient
 
+#include <memory>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/fs/read.hpp>
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/periodic_task.hpp>
@@ -11,6 +15,36 @@ USERVER_NAMESPACE_BEGIN
 
 namespace fs {
 
+/// @brief Settings of the compressed variants of the files, prepared by
+/// fs::FsCacheClient on cache update to serve them without compressing at
+/// request time
+struct FsCacheCompressionSettings {
+  /// Keep the gzip-compressed variants in FileInfoWithData::gzip_data. The
+  /// `<file>.gz` file is used as the variant if it exists, otherwise the file
+  /// is compressed. The variant is dropped if it is not smaller than the file.
+  bool gzip{false};
+  /// gzip compression level from 1 (fastest) to 9 (smallest)
+  int gzip_level{9};
+  /// Files smaller than this are not compressed
+  size_t min_size{1024};
+};
+
+/// @brief Settings of how fs::FsCacheClient keeps the files in memory and
+/// picks up their changes
+struct FsCacheStorageSettings {
+  /// Files of this size or larger are memory-mapped instead of being copied
+  /// into memory, 0 disables the mapping. The mapped files should be replaced
+  /// by a rename rather than rewritten in place.
+  size_t mmap_min_size{0};
+  /// Pick up the changes of the files through inotify instead of the periodic
+  /// rescans of the whole directory, Linux only
+  bool watch_changes{false};
+};
+
+namespace impl {
+class InotifyWatcher;
+}  // namespace impl
+
 /// @ingroup userver_clients
 ///
 /// @brief Class client for storing files in memory
@@ -20,9 +54,16 @@ class FsCacheClient final {
   /// @brief Fills the cache and starts periodic update
   /// @param dir directory to cache files from
   /// @param update_period time (0 - fill the cache only at startup)
-  /// @param tp task processor to do filesystem operations
+  /// @param tp task processor to do filesystem operations and compression
+  /// @param compression settings of the compressed variants of the files
+  /// @param storage settings of the mapping and refreshing of the files,
+  /// `update_period` is ignored if the changes are watched
   FsCacheClient(std::string_view dir, std::chrono::milliseconds update_period,
-                engine::TaskProcessor& tp);
+                engine::TaskProcessor& tp,
+                const FsCacheCompressionSettings& compression = {},
+                const FsCacheStorageSettings& storage = {});
+
+  ~FsCacheClient();
 
   /// @brief get file from memory
   /// @param path to file
@@ -34,11 +75,18 @@ class FsCacheClient final {
   void UpdateCache();
 
  private:
+  void WatchChanges();
+  void UpdateFiles(const std::vector<std::string>& paths);
+
   const std::string dir_;
   const std::chrono::milliseconds update_period_;
   engine::TaskProcessor& tp_;
+  const FsCacheCompressionSettings compression_;
+  const FsCacheStorageSettings storage_;
+  std::unique_ptr<impl::InotifyWatcher> watcher_;
   utils::PeriodicTask cache_updater_;
   rcu::RcuMap<std::string, const fs::FileInfoWithData> data_;
+  engine::TaskWithResult<void> watcher_task_;
 };
 
 }  // namespace fs
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -20,6 +21,17 @@ struct FileInfoWithData {
   std::string data;
   std::string extension;
   size_t size;
+  /// gzip-compressed `data`, empty if there is no compressed variant
+  std::string gzip_data{};
+  /// Quoted entity tag of the contents, empty if it was not calculated
+  std::string etag{};
+  /// Memory-mapped contents of `size` bytes, `data` is empty if it is set
+  std::shared_ptr<const char> mapping{};
+
+  /// @returns the file contents, either `data` or the mapped ones
+  std::string_view GetContents() const noexcept {
+    return mapping ? std::string_view{mapping.get(), size} : data;
+  }
 };
 
 using FileInfoWithDataConstPtr = std::shared_ptr<const FileInfoWithData>;
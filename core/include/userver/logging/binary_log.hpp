@@ -0,0 +1,37 @@
+#pragma once
+
+/// @file userver/logging/binary_log.hpp
+/// @brief Decoder of the logs written in logging::Format::kBinary
+
+#include <iosfwd>
+#include <stdexcept>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+/// @brief Malformed binary log
+class BinaryLogError : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Converts the logs written in logging::Format::kBinary into TSKV
+/// lines, as they would have been written in logging::Format::kTskv.
+///
+/// The binary log is a sequence of records. A record is its size followed by
+/// the fields; the first two fields are the timestamp (microseconds since the
+/// epoch) and the level. A field is a key tag, the key itself for the tag 0,
+/// a value type byte and a value. Value types are 0 for a size-prefixed
+/// string, 1 for an unsigned and 2 for a zigzag-encoded signed integer. All
+/// sizes, tags and integers are LEB128 varints. Keys known to userver have
+/// fixed tags, the rest are written inline.
+///
+/// The input is processed record by record, the timestamps are converted to
+/// the local time.
+///
+/// @throws BinaryLogError if the input is malformed or truncated
+void ConvertBinaryLogToTskv(std::istream& binary, std::ostream& tskv);
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
@@ -12,6 +12,7 @@
 #include <userver/os_signals/component.hpp>
 
 #include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/storage.hpp>
 
 #include "logger.hpp"
 
@@ -35,12 +36,20 @@ namespace components {
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
+/// fs-task-processor | task processor for disk I/O operations | -
+/// async-stacktrace-symbolization | symbolize the stacktraces of the logs on the `fs-task-processor`, see below | false
+/// loggers | per logger options | -
+///
+/// ### Logger options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv`, `binary` (see logging::ConvertBinaryLogToTskv()) or `tskv-deferred` (TSKV that is escaped and formatted on the logger's task, see logging::Format::kTskvDeferred) | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
-/// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
-/// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// message_queue_size | the size of the per-thread message buffer, must be a power of 2 | 4096
+/// overflow_behavior | message handling policy while the buffer of the thread is full: `discard` drops messages, `block` waits until message gets into the buffer | discard
+/// file_buffer_size | the size of the write buffer of the log file in bytes, `0` leaves the buffering to stdio | 0
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
 ///
@@ -63,6 +72,28 @@ namespace components {
 /// @snippet components/common_component_list_test.cpp Sample logging component config
 ///
 /// `default` section configures the default logger for LOG_*.
+///
+/// ### Asynchronous logging
+/// Each thread puts the messages into its own buffer of `message_queue_size`
+/// messages, a task on the `fs-task-processor` drains the buffers in batches
+/// and writes the messages. The `logger` statistics have the numbers of the
+/// `dropped` and `written` messages and the number of `thread-buffers` for
+/// each logger.
+///
+/// With a non-zero `file_buffer_size` the messages are gathered in a buffer of
+/// that size and written to the file with a single writev() call when the
+/// buffer gets full, on messages of `flush_level` and every 2 seconds. This
+/// reduces the number of write syscalls for the high volume logs.
+///
+/// ### Stacktraces
+/// With `async-stacktrace-symbolization: true` the stacktraces of the logs
+/// are not symbolized by the logging thread. A stacktrace that was seen before
+/// is taken from the cache, a new stacktrace is logged as raw frame addresses
+/// with a `stacktrace_id` and is symbolized by a task on the
+/// `fs-task-processor`, which logs the symbolized stacktrace with the same
+/// `stacktrace_id`. The `logger-stacktrace` statistics have the numbers of
+/// cache `hits` and `misses`, `dropped` and `symbolized` stacktraces and the
+/// `symbolization-time-us`.
 
 // clang-format on
 
@@ -102,12 +133,17 @@ class Logging final : public impl::ComponentBase {
     return [this] { FlushLogs(); };
   }
   void FlushLogs();
+  formats::json::Value ExtendStatistics();
+  formats::json::Value ExtendStacktraceStatistics();
 
   engine::TaskProcessor* fs_task_processor_;
   std::unordered_map<std::string, logging::LoggerPtr> loggers_;
   utils::PeriodicTask flush_task_;
+  utils::PeriodicTask symbolize_task_;
   std::shared_ptr<TestsuiteCaptureSink> socket_sink_;
   os_signals::Subscriber signal_subscriber_;
+  utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry stacktrace_statistics_holder_;
 };
 
 template <>
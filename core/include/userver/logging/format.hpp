@@ -10,7 +10,18 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+  kTskv,
+  kLtsv,
+  kRaw,
+  /// Length-prefixed records with varint values, see
+  /// logging::ConvertBinaryLogToTskv()
+  kBinary,
+  /// TSKV, but the fields are captured in the binary form of kBinary by the
+  /// logging call and escaped and formatted by the sink, i.e. on the logger's
+  /// own task for the asynchronous loggers
+  kTskvDeferred,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
@@ -4,8 +4,11 @@
 /// @brief Implementation of hazard pointer
 
 #include <atomic>
+#include <cstddef>
 #include <cstdlib>
+#include <deque>
 #include <list>
+#include <memory>
 #include <unordered_set>
 
 #include <userver/engine/async.hpp>
@@ -69,6 +72,52 @@ thread_local CachedData<T> cache;
 
 uint64_t GetNextEpoch() noexcept;
 
+// Epoch-based reclamation domain shared by all the Variables that use
+// ReclamationType::kEpochs. Readers announce themselves in per-thread counters
+// of the current index. A grace period ends when the other index is drained
+// and the current index is flipped twice (see TryAdvanceEpoch()). Lock and
+// unlock are counted separately, so a coroutine may release its read lock on
+// a different thread.
+struct alignas(64) EpochReaderRecord final {
+  std::atomic<uint64_t> locks[2]{};
+  std::atomic<uint64_t> unlocks[2]{};
+  EpochReaderRecord* next{nullptr};
+};
+
+extern std::atomic<std::size_t> epoch_index;
+
+EpochReaderRecord& RegisterEpochReader();
+
+inline thread_local EpochReaderRecord* epoch_reader_record = nullptr;
+
+inline EpochReaderRecord& GetEpochReader() {
+  auto* record = epoch_reader_record;
+  if (!record) record = epoch_reader_record = &RegisterEpochReader();
+  return *record;
+}
+
+inline std::size_t EpochReadLock() {
+  auto& record = GetEpochReader();
+  const auto index = epoch_index.load(std::memory_order_relaxed);
+  record.locks[index].fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in TryAdvanceEpoch(): either the writer sees our
+  // lock, or we see its new value
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return index;
+}
+
+inline void EpochReadUnlock(std::size_t index) {
+  GetEpochReader().unlocks[index].fetch_add(1, std::memory_order_release);
+}
+
+// @returns the sequence number of the current grace period. Any flip of the
+// epoch index that increments it starts after the call.
+uint64_t GetEpochSequence() noexcept;
+
+// Tries to complete up to two flips of the epoch index without waiting.
+// @returns the sequence number of the current grace period
+uint64_t TryAdvanceEpoch() noexcept;
+
 }  // namespace impl
 
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
@@ -79,8 +128,15 @@ uint64_t GetNextEpoch() noexcept;
 template <typename T>
 class USERVER_NODISCARD ReadablePtr final {
  public:
-  explicit ReadablePtr(const Variable<T>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
+  explicit ReadablePtr(const Variable<T>& ptr) {
+    if (ptr.UsesEpochs()) {
+      hp_record_ = nullptr;
+      epoch_index_ = impl::EpochReadLock();
+      t_ptr_ = ptr.GetCurrent();
+      return;
+    }
+
+    hp_record_ = &ptr.MakeHazardPointer();
     // This cycle guarantees that at the end of it both t_ptr_ and
     // hp_record_->ptr will both be set to
     // 1. something meaningful
@@ -94,7 +150,9 @@ class USERVER_NODISCARD ReadablePtr final {
   }
 
   ReadablePtr(ReadablePtr<T>&& other) noexcept
-      : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
+      : t_ptr_(other.t_ptr_),
+        hp_record_(other.hp_record_),
+        epoch_index_(other.epoch_index_) {
     other.t_ptr_ = nullptr;
   }
 
@@ -122,13 +180,14 @@ class USERVER_NODISCARD ReadablePtr final {
 
     // Get rid of our current hp_record_
     if (t_ptr_) {
-      hp_record_->Release();
+      Release();
     }
     // After that moment, the content of our hp_record_ can't be used -
     // no more hp_record_->xyz calls, because it is probably already reused in
     // some other ReadablePtr. Also, don't call t_ptr_, it is probably already
     // freed. Just take values from 'other'.
     hp_record_ = other.hp_record_;
+    epoch_index_ = other.epoch_index_;
     t_ptr_ = other.t_ptr_;
 
     // Now, it won't do us any good if there were two glorified things having
@@ -141,8 +200,20 @@ class USERVER_NODISCARD ReadablePtr final {
     return *this;
   }
 
+  /// @note With ReclamationType::kEpochs the copy references the same value
+  /// as `other`, otherwise it references the current value of the Variable
   ReadablePtr(const ReadablePtr<T>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+      : t_ptr_(other.t_ptr_),
+        hp_record_(other.hp_record_),
+        epoch_index_(other.epoch_index_) {
+    if (!t_ptr_) return;
+    if (hp_record_) {
+      *this = ReadablePtr<T>{other.hp_record_->owner};
+    } else {
+      // We are inside of the read section of `other`, the value can't be freed
+      epoch_index_ = impl::EpochReadLock();
+    }
+  }
 
   ReadablePtr& operator=(const ReadablePtr<T>& other) {
     if (this != &other) *this = ReadablePtr<T>{other};
@@ -151,8 +222,7 @@ class USERVER_NODISCARD ReadablePtr final {
 
   ~ReadablePtr() {
     if (!t_ptr_) return;
-    UASSERT(hp_record_ != nullptr);
-    hp_record_->Release();
+    Release();
   }
 
   const T* Get() const& {
@@ -175,6 +245,14 @@ class USERVER_NODISCARD ReadablePtr final {
     std::abort();
   }
 
+  void Release() {
+    if (hp_record_) {
+      hp_record_->Release();
+    } else {
+      impl::EpochReadUnlock(epoch_index_);
+    }
+  }
+
   // This is a pointer to actual data. If it is null, then we treat it as
   // an indicator that this ReadablePtr is cleared and won't call
   // any logic associated with hp_record_
@@ -183,7 +261,10 @@ class USERVER_NODISCARD ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
+  // hp_record_ is nullptr for Variables with ReclamationType::kEpochs.
   impl::HazardPointerRecord<T>* hp_record_;
+  // Index of the epoch counters to decrement on release, if !hp_record_.
+  std::size_t epoch_index_{0};
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -271,6 +352,21 @@ class USERVER_NODISCARD WritablePtr final {
 /// whether old values should be destroyed asynchronously.
 enum class DestructionType { kSync, kAsync };
 
+/// @brief Can be passed to `rcu::Variable` after rcu::DestructionType to
+/// choose how the readers are tracked.
+enum class ReclamationType {
+  /// Each reader occupies a hazard pointer of the Variable, writers scan
+  /// them to find out which of the old values may be destroyed
+  kHazardPointers,
+
+  /// Each reader increments a thread-local counter of the current epoch.
+  /// Old values are destroyed in batches once all the readers of their epoch
+  /// are gone, on the following writes or Cleanup() calls. Makes Read()
+  /// cheaper, but a long-living ReadablePtr of any such Variable delays the
+  /// destruction of old values of all of them.
+  kEpochs,
+};
+
 /// @ingroup userver_concurrency userver_containers
 ///
 /// @brief Read-Copy-Update variable
@@ -322,6 +418,20 @@ class Variable final {
         epoch_(impl::GetNextEpoch()),
         current_(new T(std::forward<Args>(initial_value_args)...)) {}
 
+  /// Create a new `Variable` with an in-place constructed initial value.
+  /// @param destruction_type controls whether destruction of old values should
+  /// be performed asynchronously
+  /// @param reclamation_type controls how the readers are tracked
+  /// @param initial_value_args arguments passed to the constructor of the
+  /// initial value
+  template <typename... Args>
+  Variable(DestructionType destruction_type, ReclamationType reclamation_type,
+           Args&&... initial_value_args)
+      : destruction_type_(destruction_type),
+        reclamation_type_(reclamation_type),
+        epoch_(impl::GetNextEpoch()),
+        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+
   Variable(const Variable&) = delete;
   Variable(Variable&&) = delete;
   Variable& operator=(const Variable&) = delete;
@@ -329,6 +439,7 @@ class Variable final {
 
   ~Variable() {
     delete current_.load();
+    epoch_retire_list_.clear();
 
     auto* hp = hp_record_head_.load();
     while (hp) {
@@ -385,12 +496,21 @@ class Variable final {
       return;
     }
 
+    if (UsesEpochs()) {
+      ScanEpochRetiredList();
+      return;
+    }
+
     ScanRetiredList(CollectHazardPtrs(lock));
   }
 
  private:
   T* GetCurrent() const { return current_.load(); }
 
+  bool UsesEpochs() const noexcept {
+    return reclamation_type_ == ReclamationType::kEpochs;
+  }
+
   impl::HazardPointerRecord<T>* MakeHazardPointerCached() const {
     auto& cache = impl::cache<T>;
     auto* hp = cache.hp;
@@ -453,6 +573,15 @@ class Variable final {
   void Retire(std::unique_ptr<T> old_ptr,
               std::unique_lock<engine::Mutex>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
+    if (UsesEpochs()) {
+      // current_ was exchanged before, so two more flips of the epoch index
+      // guarantee that all the readers of old_ptr are gone
+      epoch_retire_list_.push_back(
+          {impl::GetEpochSequence(), std::move(old_ptr)});
+      ScanEpochRetiredList();
+      return;
+    }
+
     auto hazard_ptrs = CollectHazardPtrs(lock);
 
     if (hazard_ptrs.count(old_ptr.get()) > 0) {
@@ -481,6 +610,16 @@ class Variable final {
     }
   }
 
+  // Destroy (asynchronously) the retired objects whose grace period has ended
+  void ScanEpochRetiredList() {
+    const auto sequence = impl::TryAdvanceEpoch();
+    while (!epoch_retire_list_.empty() &&
+           epoch_retire_list_.front().sequence + 2 <= sequence) {
+      DeleteAsync(std::move(epoch_retire_list_.front().ptr));
+      epoch_retire_list_.pop_front();
+    }
+  }
+
   // Returns all T*, that have hazard ptr pointing at them. Occasionally nullptr
   // might be in result as well.
   std::unordered_set<T*> CollectHazardPtrs(std::unique_lock<engine::Mutex>&) {
@@ -509,7 +648,13 @@ class Variable final {
     }
   }
 
+  struct EpochRetired {
+    uint64_t sequence;
+    std::unique_ptr<T> ptr;
+  };
+
   const DestructionType destruction_type_;
+  const ReclamationType reclamation_type_{ReclamationType::kHazardPointers};
   const uint64_t epoch_;
 
   mutable std::atomic<impl::HazardPointerRecord<T>*> hp_record_head_{{nullptr}};
@@ -518,6 +663,8 @@ class Variable final {
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
   std::list<std::unique_ptr<T>> retire_list_head_;
+  // sorted by sequence, used instead of retire_list_head_ with kEpochs
+  std::deque<EpochRetired> epoch_retire_list_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
   friend class ReadablePtr<T>;
@@ -0,0 +1,257 @@
+#pragma once
+
+/// @file userver/rcu/sharded_rcu_map.hpp
+/// @brief @copybrief rcu::ShardedRcuMap
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Forward iterator for the rcu::ShardedRcuMap
+///
+/// Use member functions of rcu::ShardedRcuMap to retrieve the iterator.
+template <typename Key, typename Value, typename IterValue>
+class ShardedRcuMapIterator final {
+  using Shard = RcuMap<Key, Value>;
+  using ShardIterator = RcuMapIterator<Key, Value, IterValue>;
+
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = typename ShardIterator::value_type;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  ShardedRcuMapIterator() = default;
+
+  ShardedRcuMapIterator operator++(int) {
+    ShardedRcuMapIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  ShardedRcuMapIterator& operator++() {
+    ++it_;
+    SkipEmptyShards();
+    return *this;
+  }
+
+  reference operator*() const { return *it_; }
+  pointer operator->() const { return &*it_; }
+
+  bool operator==(const ShardedRcuMapIterator& other) const {
+    if (index_ >= shards_count_ || other.index_ >= other.shards_count_) {
+      return index_ >= shards_count_ && other.index_ >= other.shards_count_;
+    }
+    return index_ == other.index_ && it_ == other.it_;
+  }
+
+  bool operator!=(const ShardedRcuMapIterator& other) const {
+    return !(*this == other);
+  }
+
+  /// @cond
+  /// For internal use only
+  ShardedRcuMapIterator(Shard* shards, std::size_t shards_count)
+      : shards_(shards), shards_count_(shards_count) {
+    if (shards_count_ == 0) return;
+    it_ = Begin(shards_[0]);
+    SkipEmptyShards();
+  }
+  /// @endcond
+
+ private:
+  static ShardIterator Begin(Shard& shard) {
+    if constexpr (std::is_const_v<IterValue>) {
+      return std::as_const(shard).begin();
+    } else {
+      return shard.begin();
+    }
+  }
+
+  void SkipEmptyShards() {
+    while (it_ == ShardIterator{}) {
+      if (++index_ >= shards_count_) return;
+      it_ = Begin(shards_[index_]);
+    }
+  }
+
+  Shard* shards_{nullptr};
+  std::size_t shards_count_{0};
+  std::size_t index_{0};
+  ShardIterator it_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief rcu::RcuMap split into independent shards picked by the key hash.
+///
+/// Each shard is a separate rcu::RcuMap, so a keyset change copies only the
+/// shard of the key, and keyset changes of different shards do not wait for
+/// each other.
+///
+/// Iteration and GetSnapshot() are consistent only within a single shard:
+/// changes to other shards made during the iteration may or may not be
+/// observed.
+///
+/// @see @ref md_en_userver_synchronization
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedRcuMap final {
+  using Shard = RcuMap<Key, Value>;
+
+ public:
+  using ValuePtr = typename Shard::ValuePtr;
+  using ConstValuePtr = typename Shard::ConstValuePtr;
+  using Iterator = ShardedRcuMapIterator<Key, Value, Value>;
+  using ConstIterator = ShardedRcuMapIterator<Key, Value, const Value>;
+  using RawMap = typename Shard::RawMap;
+  using Snapshot = typename Shard::Snapshot;
+  using InsertReturnType = typename Shard::InsertReturnType;
+
+  static constexpr std::size_t kDefaultShardsCount = 16;
+
+  explicit ShardedRcuMap(std::size_t shards_count = kDefaultShardsCount,
+                         const Hash& hash = Hash())
+      : shards_(shards_count), hash_(hash) {
+    if (shards_count == 0) {
+      throw std::logic_error("Shards count must be positive");
+    }
+  }
+
+  ShardedRcuMap(const ShardedRcuMap&) = delete;
+  ShardedRcuMap(ShardedRcuMap&&) = delete;
+  ShardedRcuMap& operator=(const ShardedRcuMap&) = delete;
+  ShardedRcuMap& operator=(ShardedRcuMap&&) = delete;
+
+  std::size_t GetShardsCount() const noexcept { return shards_.size(); }
+
+  /// Returns an estimated size of the map at some point in time
+  std::size_t SizeApprox() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards_) size += shard.SizeApprox();
+    return size;
+  }
+
+  /// @name Iteration support
+  /// @details Keyset of a shard is fixed when the iteration reaches it.
+  /// @{
+  ConstIterator begin() const {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return {const_cast<Shard*>(shards_.data()), shards_.size()};
+  }
+  ConstIterator end() const { return {}; }
+  Iterator begin() { return {shards_.data(), shards_.size()}; }
+  Iterator end() { return {}; }
+  /// @}
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key& key) const {
+    return std::as_const(GetShard(key))[key];
+  }
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  /// @note Copies the key's shard if the key doesn't exist.
+  const ValuePtr operator[](const Key& key) { return GetShard(key)[key]; }
+
+  /// @see rcu::RcuMap::Insert
+  /// @note Copies the key's shard if the key doesn't exist.
+  InsertReturnType Insert(const Key& key, ValuePtr value) {
+    return GetShard(key).Insert(key, std::move(value));
+  }
+
+  /// @see rcu::RcuMap::Emplace
+  /// @note Copies the key's shard if the key doesn't exist.
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args) {
+    return GetShard(key).Emplace(key, std::forward<Args>(args)...);
+  }
+
+  /// @see rcu::RcuMap::TryEmplace
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args) {
+    return GetShard(key).TryEmplace(key, std::forward<Args>(args)...);
+  }
+
+  /// @see rcu::RcuMap::InsertOrAssign
+  template <typename RawKey>
+  void InsertOrAssign(RawKey&& key, ValuePtr value) {
+    auto& shard = GetShard(key);
+    shard.InsertOrAssign(std::forward<RawKey>(key), std::move(value));
+  }
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  const ConstValuePtr Get(const Key& key) const {
+    return std::as_const(GetShard(key)).Get(key);
+  }
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  const ValuePtr Get(const Key& key) { return GetShard(key).Get(key); }
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  /// @note Copies the key's shard.
+  bool Erase(const Key& key) { return GetShard(key).Erase(key); }
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  /// @note Copies the key's shard.
+  ValuePtr Pop(const Key& key) { return GetShard(key).Pop(key); }
+
+  /// Resets the map to an empty state, shard by shard
+  void Clear() {
+    for (auto& shard : shards_) shard.Clear();
+  }
+
+  /// Replace current data by data from `new_map`, shard by shard
+  void Assign(RawMap new_map) {
+    utils::FixedArray<RawMap> new_shards(shards_.size());
+    for (auto& [key, value] : new_map) {
+      new_shards[GetShardIndex(key)].emplace(key, std::move(value));
+    }
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      shards_[i].Assign(std::move(new_shards[i]));
+    }
+  }
+
+  /// @brief Starts a transaction over the shard of `key`
+  /// @details The shard is copied. Only the keys of the same shard (see
+  /// GetShardIndex()) may be changed in the transaction. Don't forget to
+  /// `Commit` to apply the changes.
+  rcu::WritablePtr<RawMap> StartWriteShard(const Key& key) {
+    return GetShard(key).StartWrite();
+  }
+
+  std::size_t GetShardIndex(const Key& key) const {
+    return hash_(key) % shards_.size();
+  }
+
+  /// @brief Returns a readonly copy of the map, each shard is copied
+  /// atomically
+  Snapshot GetSnapshot() const { return {begin(), end()}; }
+
+ private:
+  Shard& GetShard(const Key& key) { return shards_[GetShardIndex(key)]; }
+
+  const Shard& GetShard(const Key& key) const {
+    return shards_[GetShardIndex(key)];
+  }
+
+  utils::FixedArray<Shard> shards_;
+  Hash hash_;
+};
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -32,6 +32,7 @@ namespace components {
 /// * @ref USERVER_LOG_REQUEST_HEADERS
 /// * @ref USERVER_CHECK_AUTH_IN_HANDLERS
 /// * @ref USERVER_CANCEL_HANDLE_REQUEST_BY_DEADLINE
+/// * @ref USERVER_HANDLER_ADAPTIVE_CONCURRENCY
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -69,7 +70,18 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.idle_release_timeout | release the tasks and buffers of a connection that has no requests in progress and received nothing for this time, the connection is woken up once the peer sends data again; 0 to disable | 0
+/// connection.cancel_on_disconnect | keep watching the socket while the final request of a connection (e.g. with `Connection: close`) is in progress and cancel it once the peer closes or resets the connection; requests on keep-alive connections are always cancelled on disconnect | false
+/// connection.http2.enabled | accept HTTP/2 with prior knowledge (h2c) along with HTTP/1.1 on the listener | false
+/// connection.http2.max_concurrent_streams | max concurrent streams of an HTTP/2 connection | 100
+/// connection.http2.initial_window_size | HTTP/2 per-stream flow-control window for the request bodies, in bytes | 65535
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// ev_thread_per_shard | serve each of the `shards` SO_REUSEPORT sockets and all its accepted connections by its own ev thread, so that a connection stays on one ev thread from accept to response | false
+/// reuseport_cpu_bpf | attach a BPF program to the SO_REUSEPORT group that passes the connections received on CPU `i` to the `i % shards` socket; the kernel hash balancing is used if it fails | false
+/// request_queue.codel_enabled | drop the requests of the handlers with throttling that waited in the task processor queue more than twice the target of their `priority_class`, once no request of the class waited less than the target during the last interval | false
+/// request_queue.codel_interval | interval of the CoDel overload detection | 100ms
+/// request_queue.normal_target | target queue time of the handlers with `priority_class: normal` | 10ms
+/// request_queue.batch_target | target queue time of the handlers with `priority_class: batch` | 5ms
 
 // clang-format on
 
@@ -0,0 +1,70 @@
+#pragma once
+
+/// @file userver/server/handlers/cache_dumps.hpp
+/// @brief @copybrief server::handlers::CacheDumps
+
+#include <string>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that serves the latest local cache dumps to the other
+/// instances of the service.
+///
+/// A fresh instance with the `dump.peers` option of a cache set to the URLs of
+/// this handler of the other instances downloads the dump at start instead of
+/// waiting for the first update of the cache, see dump::Dumper.
+///
+/// The dumps are served as is, so the encrypted dumps stay encrypted. The
+/// handler is registered on the monitor listener, as the dumps contain the
+/// data of the caches.
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the
+/// following ones:
+///
+/// Name              | Description                                 | Default value
+/// ----------------- | ------------------------------------------- | -------------
+/// fs-task-processor | `TaskProcessor` for blocking disk IO        | fs-task-processor
+///
+/// ## Scheme
+/// GET request with the arguments:
+/// * name - the name of the cache component
+/// * format-version - the `dump.format-version` of the cache
+///
+/// Returns the contents of the latest dump of the format version with its
+/// file name in the `X-Dump-Filename` header, or HTTP 404 if there is none.
+
+// clang-format on
+class CacheDumps final : public HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-cache-dumps";
+
+  CacheDumps(const components::ComponentConfig& config,
+             const components::ComponentContext& context);
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const std::string dump_root_;
+  engine::TaskProcessor& fs_task_processor_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CacheDumps> =
+    true;
+
+USERVER_NAMESPACE_END
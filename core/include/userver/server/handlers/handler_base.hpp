@@ -37,8 +37,13 @@ namespace server::handlers {
 /// response_data_size_log_limit | trim responses to this size before logging | 512
 /// max_requests_per_second | integer to limit RPS to this handler | <no limit>
 /// decompress_request | allow decompression of the requests | false
+/// compress_response | gzip the responses if the client accepts gzip in `Accept-Encoding`, streamed responses are compressed chunk by chunk | false
+/// compress_response_level | gzip compression level from 1 (fastest) to 9 (smallest) | 6
+/// compress_response_min_size | responses smaller than this are sent uncompressed, does not apply to streamed responses | 1024
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
+/// priority_class | `critical` requests are never dropped by the `request_queue` management of components::Server and ignore the task processor overload, `batch` ones are dropped first | normal
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
+/// request-body-stream | run the handler once the headers are received and stream the body to it via server::http::HttpRequest::GetBodyStream(), the body is not limited by `max_request_size` and is neither decompressed nor parsed | false
 /// monitor-handler | Overrides the in-code `is_monitor` flag that makes the handler run either on `server.listener` or on `server.listener-monitor` | --
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 
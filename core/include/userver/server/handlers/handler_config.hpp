@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
@@ -24,6 +26,19 @@ enum class UrlTrailingSlashOption {
   kDefault = kBoth,
 };
 
+/// Priority class of the handler requests in the request queue of the server
+enum class PriorityClass {
+  kCritical,  ///< never dropped by the queue management
+  kNormal,
+  kBatch,  ///< dropped first, with a tighter queue time target
+
+  kDefault = kNormal,
+};
+
+inline constexpr std::size_t kPriorityClassCount = 3;
+
+std::string_view ToString(PriorityClass priority_class);
+
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
@@ -36,8 +51,13 @@ struct HandlerConfig {
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
   bool decompress_request{false};
+  bool compress_response{false};
+  int compress_response_level{6};
+  size_t compress_response_min_size{1024};
   bool throttling_enabled{true};
+  PriorityClass priority_class{PriorityClass::kDefault};
   bool response_body_stream{false};
+  bool request_body_stream{false};
   std::optional<bool> set_response_server_hostname;
   bool set_tracing_headers{true};
 };
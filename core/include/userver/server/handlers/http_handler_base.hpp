@@ -3,6 +3,7 @@
 /// @file userver/server/handlers/http_handler_base.hpp
 /// @brief @copybrief server::handlers::HttpHandlerBase
 
+#include <chrono>
 #include <optional>
 #include <string>
 #include <vector>
@@ -23,6 +24,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace congestion_control {
+class GradientLimiter;
+}  // namespace congestion_control
+
 /// @brief Most common \ref userver_http_handlers "userver HTTP handlers"
 namespace server::handlers {
 
@@ -30,6 +35,7 @@ class HttpHandlerStatistics;
 class HttpRequestStatistics;
 class HttpHandlerMethodStatistics;
 class HttpHandlerStatisticsScope;
+class HttpResponseCache;
 
 // clang-format off
 
@@ -45,6 +51,22 @@ class HttpHandlerStatisticsScope;
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// log-level | overrides log level for this handle | <no override>
+/// tail-sampling-log-level | buffers the log messages of this and higher levels that are below the logger level and writes them only for the requests that failed with 5xx or took longer than `tail-sampling-latency-threshold` | <disabled>
+/// tail-sampling-latency-threshold | requests that took longer get their tail sampled log messages written | 1s
+/// tracing-sampling-ratio | share of the requests in [0, 1] that are traced, decided by the trace id; the spans of the other requests keep the tracing ids for the propagation but are neither measured nor logged, see tracing::Span::SetSampled() | 1.0
+/// response-cache | caches the successful responses to GET and HEAD requests and answers 304 to the requests with a matching `If-None-Match`, the responses are shared between all the clients that send the same key | <disabled>
+/// response-cache.size | max count of the cached responses | -
+/// response-cache.ways | count of the independently locked parts of the cache | 16
+/// response-cache.lifetime | how long a response is served from the cache, e.g. `1s` | -
+/// response-cache.key-args | the request args that the response depends on, besides the path | []
+/// response-cache.key-headers | the request headers that the response depends on | []
+///
+/// A cached response keeps its body and headers except for the tracing ones.
+/// It gets the `ETag` header that the handler has set or a digest of its body.
+/// The responses with cookies or with `Cache-Control: no-store` or `private`
+/// are not cached.
+/// The concurrent requests that miss the same key wait for the first of them
+/// to be handled instead of calling the handler each.
 ///
 /// ## Example usage:
 ///
@@ -159,6 +181,11 @@ class HttpHandlerBase : public HandlerBase {
                            http::HttpResponse& response,
                            request::RequestContext& context) const;
 
+  void HandleRequestCached(const http::HttpRequest& http_request,
+                           const std::string& cache_key,
+                           http::HttpResponse& response,
+                           request::RequestContext& context) const;
+
   std::string GetRequestBodyForLoggingChecked(
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& request_body) const;
@@ -168,8 +195,18 @@ class HttpHandlerBase : public HandlerBase {
 
   void CheckRatelimit(const http::HttpRequest& http_request) const;
 
+  void AccountAdaptiveConcurrency(
+      std::chrono::steady_clock::time_point start_time) const;
+
+  void OnAdaptiveConcurrencyConfigUpdate(const dynamic_config::Snapshot& cfg);
+
   void DecompressRequestBody(http::HttpRequest& http_request) const;
 
+  bool IsResponseCompressionAccepted(
+      const http::HttpRequest& http_request) const;
+  void CompressResponse(const http::HttpRequest& http_request,
+                        http::HttpResponse& response) const;
+
   template <typename HttpStatistics>
   void FormatStatistics(utils::statistics::Writer result,
                         const HttpStatistics& stats);
@@ -187,9 +224,15 @@ class HttpHandlerBase : public HandlerBase {
   std::vector<auth::AuthCheckerBasePtr> auth_checkers_;
 
   std::optional<logging::Level> log_level_;
+  std::optional<logging::Level> tail_sampling_log_level_;
+  std::chrono::milliseconds tail_sampling_latency_threshold_;
+  double tracing_sampling_ratio_;
   bool set_response_server_hostname_;
   mutable utils::TokenBucket rate_limit_;
   bool is_body_streamed_;
+  std::unique_ptr<congestion_control::GradientLimiter> adaptive_concurrency_;
+  std::unique_ptr<HttpResponseCache> response_cache_;
+  concurrent::AsyncEventSubscriberScope adaptive_concurrency_subscription_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,73 @@
+#pragma once
+
+/// @file userver/server/handlers/http_handler_json_cbor_base.hpp
+/// @brief @copybrief server::handlers::HttpHandlerJsonCborBase
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers userver_base_classes
+///
+/// @brief Convenient base for handlers that accept and respond with
+/// formats::json::Value encoded either as JSON or as CBOR (RFC 8949).
+///
+/// Has the same interface as server::handlers::HttpHandlerJsonBase. The request
+/// body is parsed from CBOR if the request has `Content-Type: application/cbor`
+/// and from JSON otherwise. The response is encoded in the format of the
+/// request; for requests without a body it is encoded in CBOR if the
+/// `Accept` header lists `application/cbor`. Error bodies are always JSON.
+///
+/// See formats::json::ToCborString() for the details of the encoding.
+
+// clang-format on
+
+class HttpHandlerJsonCborBase : public HttpHandlerBase {
+ public:
+  HttpHandlerJsonCborBase(const components::ComponentConfig& config,
+                          const components::ComponentContext& component_context,
+                          bool is_monitor = false);
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext& context) const final;
+
+  virtual formats::json::Value HandleRequestJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context) const = 0;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// @returns A pointer to the request value if it was parsed successfully or
+  /// nullptr otherwise.
+  static const formats::json::Value* GetRequestJson(
+      const request::RequestContext& context);
+
+  /// @returns a pointer to the response value if it was returned successfully
+  /// by `HandleRequestJsonThrow()` or nullptr otherwise.
+  static const formats::json::Value* GetResponseJson(
+      const request::RequestContext& context);
+
+  /// @returns true if the response is encoded in CBOR
+  static bool IsCborResponse(const request::RequestContext& context);
+
+  void ParseRequestData(const http::HttpRequest& request,
+                        request::RequestContext& context) const override;
+
+ private:
+  FormattedErrorData GetFormattedExternalErrorBody(
+      const CustomHandlerException& exc) const final;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::handlers::HttpHandlerJsonCborBase> = true;
+
+USERVER_NAMESPACE_END
@@ -19,6 +19,13 @@ namespace server::handlers {
 /// @brief Handler that returns HTTP 200 if file exist
 /// and returns file data with mapped content/type
 ///
+/// If the components::FsCache keeps the gzip-compressed variant of the file
+/// (see its `precompress-gzip` option) and the client accepts gzip, the
+/// variant is returned with `Content-Encoding: gzip`.
+///
+/// The responses carry the `ETag` of the file contents, the requests with a
+/// matching `If-None-Match` get HTTP 304 without a body.
+///
 /// ## Dynamic config
 /// * @ref USERVER_FILES_CONTENT_TYPE_MAP
 ///
@@ -0,0 +1,61 @@
+#pragma once
+
+/// @file userver/server/handlers/inspect_cpu.hpp
+/// @brief @copybrief server::handlers::InspectCpu
+
+#include <userver/server/handlers/http_handler_json_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that returns the top CPU consumers of the service.
+///
+/// While the component is alive each task accounts the time it runs between
+/// the context switches. The time is rolled up by the name of the root span of
+/// the task, e.g. `http/handler-name` for the requests or the span name passed
+/// to utils::Async for the subtasks, and is kept for the last 5 minutes.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_server_component_list_test.cpp  Sample handler inspect cpu component config
+///
+/// ## Scheme
+/// GET request with the optional arguments:
+/// * period - the number of the last seconds to report, 60 by default, at most 300
+/// * limit - the max number of the reported spans, 20 by default
+///
+/// Returns an array of objects with the `span` name, its `cpu-time-ms` and
+/// `cpu-usage`, i.e. the CPU time divided by the period, the hottest first.
+
+// clang-format on
+class InspectCpu final : public HttpHandlerJsonBase {
+ public:
+  InspectCpu(const components::ComponentConfig& config,
+             const components::ComponentContext& component_context);
+
+  ~InspectCpu() override;
+
+  static constexpr std::string_view kName = "handler-inspect-cpu";
+
+  formats::json::Value HandleRequestJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::InspectCpu> =
+    true;
+
+USERVER_NAMESPACE_END
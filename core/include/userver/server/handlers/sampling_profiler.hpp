@@ -0,0 +1,79 @@
+#pragma once
+
+/// @file userver/server/handlers/sampling_profiler.hpp
+/// @brief @copybrief server::handlers::SamplingProfiler
+
+#include <chrono>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that samples the CPU usage of the service threads.
+///
+/// While the profiler runs, each thread that consumes CPU gets a SIGPROF every
+/// `sampling-interval` of its CPU time. The signal handler records the name of
+/// the current span of the running task along with the native stack trace into
+/// a lock-free ring buffer, that keeps the samples of the last minutes
+/// depending on the load.
+///
+/// The profiler is process wide, so it makes sense to have only one such
+/// handler per service.
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// sampling-interval | the CPU time between the samples of a thread | 10ms
+/// always-on | sample continuously instead of only while a request is handled | false
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_server_component_list_test.cpp  Sample handler sampling profiler component config
+///
+/// ## Scheme
+/// GET request with the optional argument `seconds` - the duration of the
+/// profile, 10 by default, at most 60. Unless the handler is `always-on`, the
+/// request samples for the given duration and then responds, otherwise the
+/// samples of the last `seconds` are returned right away.
+///
+/// The response is in the folded stacks format, i.e. the
+/// `span;root_frame;...;leaf_frame samples_count` lines, that are accepted by
+/// the flamegraph.pl and speedscope tools. Threads that do not run a
+/// task are reported with the `<no span>` name.
+
+// clang-format on
+class SamplingProfiler final : public HttpHandlerBase {
+ public:
+  SamplingProfiler(const components::ComponentConfig& config,
+                   const components::ComponentContext& component_context);
+
+  ~SamplingProfiler() override;
+
+  static constexpr std::string_view kName = "handler-sampling-profiler";
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const std::chrono::microseconds sampling_interval_;
+  const bool always_on_;
+  mutable engine::Mutex mutex_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::handlers::SamplingProfiler> = true;
+
+USERVER_NAMESPACE_END
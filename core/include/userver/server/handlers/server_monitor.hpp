@@ -3,11 +3,19 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace utils::statistics::impl {
+class PrometheusFormatCache;
+}  // namespace utils::statistics::impl
+
 namespace server::handlers {
 
 // clang-format off
@@ -21,6 +29,11 @@ namespace server::handlers {
 /// 'common-labels' option that should be a map of label name to label value.
 /// Items of the map are added to each metric.
 ///
+/// With 'prometheus-fragments-cache' option enabled the Prometheus output is
+/// cached per metrics source and only the sources with changed metrics are
+/// formatted again on request. Combined with the 'response-body-stream' option
+/// the output is sent in chunks as soon as it is ready.
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
@@ -46,11 +59,17 @@ class ServerMonitor final : public HttpHandlerBase {
   ServerMonitor(const components::ComponentConfig& config,
                 const components::ComponentContext& component_context);
 
+  ~ServerMonitor() override;
+
   static constexpr std::string_view kName = "handler-server-monitor";
 
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext&) const override;
 
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext&,
+                           http::ResponseBodyStream& stream) const override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
@@ -58,10 +77,18 @@ class ServerMonitor final : public HttpHandlerBase {
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& response_data) const override;
 
+  std::vector<std::string> GetResponseChunks(
+      const http::HttpRequest& request) const;
+
   utils::statistics::Storage& statistics_storage_;
 
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
+
+  std::unique_ptr<utils::statistics::impl::PrometheusFormatCache>
+      prometheus_cache_;
+  std::unique_ptr<utils::statistics::impl::PrometheusFormatCache>
+      prometheus_untyped_cache_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,66 @@
+#pragma once
+
+/// @file userver/server/http/form_data_stream.hpp
+/// @brief @copybrief server::http::FormDataStream
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Incremental parser of a multipart/form-data request body.
+///
+/// Reads the parts from a RequestBodyStream while the body is being received,
+/// the values of the parts are returned piece by piece and are never buffered
+/// whole, so files of any size may be proxied with a constant memory
+/// footprint. Unlike the parser of the buffered bodies requires CRLF line
+/// breaks.
+///
+/// All the methods throw handlers::ClientError on a malformed or incomplete
+/// body.
+///
+/// @snippet server/http/multipart_form_data_parser_test.cpp FormDataStream
+class FormDataStream final {
+ public:
+  struct Part {
+    std::string name;
+    std::optional<std::string> filename;
+    std::optional<std::string> content_type;
+  };
+
+  /// @throws handlers::ClientError if `content_type` is not a
+  /// multipart/form-data with a boundary
+  FormDataStream(RequestBodyStream& body, std::string_view content_type);
+
+  /// @brief Skips the rest of the current part and reads the headers of the
+  /// next one.
+  /// @returns false after the last part.
+  [[nodiscard]] bool NextPart(Part& part, engine::Deadline deadline = {});
+
+  /// @brief Reads the next piece of the value of the current part.
+  /// @returns false at the end of the value.
+  [[nodiscard]] bool ReadPartData(std::string& data,
+                                  engine::Deadline deadline = {});
+
+ private:
+  enum class State { kDelimiter, kHeaders, kData, kEnd };
+
+  void Fill(engine::Deadline deadline);
+  bool ParseDelimiterEnd(engine::Deadline deadline);
+  void ParseHeaders(Part& part, engine::Deadline deadline);
+
+  RequestBodyStream& body_;
+  std::string delimiter_;
+  std::string buffer_;
+  State state_{State::kDelimiter};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -21,6 +22,7 @@ USERVER_NAMESPACE_BEGIN
 namespace server::http {
 
 class HttpRequestImpl;
+class RequestBodyStream;
 
 /// @brief HTTP Request data
 class HttpRequest final {
@@ -136,6 +138,11 @@ class HttpRequest final {
   /// empty string if no such header.
   const std::string& GetHeader(const std::string& header_name) const;
 
+  /// @return Value of the header with case insensitive name header_name, or an
+  /// empty string_view if no such header. Unlike GetHeader() does not build
+  /// the headers map for requests that were parsed in bulk.
+  std::string_view GetHeaderView(std::string_view header_name) const;
+
   /// @return true if header with case insensitive name header_name exists,
   /// false otherwise.
   bool HasHeader(const std::string& header_name) const;
@@ -176,6 +183,15 @@ class HttpRequest final {
   /// @return true if the body of the request was compressed
   bool IsBodyCompressed() const;
 
+  /// @brief Returns the body of the request as a stream.
+  ///
+  /// For the handlers with the `request-body-stream` static option the
+  /// handler starts once the request headers are received and reads the body
+  /// from the stream while it is still being received, RequestBody() is empty
+  /// for such requests. For the other requests the stream returns the whole
+  /// RequestBody().
+  RequestBodyStream& GetBodyStream() const;
+
  private:
   HttpRequestImpl& impl_;
 };
@@ -0,0 +1,59 @@
+#pragma once
+
+/// @file userver/server/http/http_request_body_stream.hpp
+/// @brief @copybrief server::http::RequestBodyStream
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Body of an HTTP request that is read while it is still being
+/// received.
+///
+/// Handlers with the `request-body-stream: true` static option are started as
+/// soon as the request headers are received, the body is pushed into the
+/// stream by the connection as it arrives. The connection stops reading from
+/// the socket while the handler lags behind, so the memory used by a request
+/// does not depend on the size of its body and `max_request_size` does not
+/// limit it.
+///
+/// @see HttpRequest::GetBodyStream(), FormDataStream
+class RequestBodyStream final {
+ public:
+  using Queue = concurrent::SpscQueue<std::string>;
+
+  /// @cond
+  // For internal use only
+  RequestBodyStream(Queue::Consumer&& consumer,
+                    std::shared_ptr<const std::atomic<bool>> is_complete);
+  /// @endcond
+
+  RequestBodyStream(RequestBodyStream&&) noexcept;
+  RequestBodyStream& operator=(RequestBodyStream&&) noexcept;
+  ~RequestBodyStream();
+
+  /// @brief Waits for the next chunk of the body.
+  /// @returns false once the body has ended, the client has gone, the deadline
+  /// has expired or the task was cancelled; IsComplete() tells the first case
+  /// from the others.
+  [[nodiscard]] bool ReadChunk(std::string& chunk,
+                               engine::Deadline deadline = {});
+
+  /// Whether the whole body was received from the client
+  bool IsComplete() const noexcept;
+
+ private:
+  Queue::Consumer consumer_;
+  std::shared_ptr<const std::atomic<bool>> is_complete_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
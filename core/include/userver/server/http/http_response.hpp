@@ -4,6 +4,7 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -29,6 +30,7 @@ void OutputHeader(std::string& header, std::string_view key,
 }
 
 class HttpRequestImpl;
+class Http2Session;
 
 /// @brief HTTP Response data
 class HttpResponse final : public request::ResponseBase {
@@ -103,6 +105,7 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::Socket& socket) override;
+  void SendResponse(Http2Session& session, std::int32_t stream_id);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
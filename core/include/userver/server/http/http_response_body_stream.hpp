@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/server/http/http_response.hpp>
@@ -11,11 +12,16 @@ namespace server::handlers {
 class HttpHandlerBase;
 }
 
+namespace compression::gzip {
+class Compressor;
+}
+
 namespace server::http {
 
 class ResponseBodyStream final {
  public:
-  ResponseBodyStream(ResponseBodyStream&&) = default;
+  ResponseBodyStream(ResponseBodyStream&&) noexcept;
+  ~ResponseBodyStream();
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
@@ -36,9 +42,15 @@ class ResponseBodyStream final {
       server::http::HttpResponse::Queue::Producer&& queue_producer,
       server::http::HttpResponse& http_response);
 
+  // Compresses the body chunks with gzip if the response status has a body
+  // and the Content-Encoding is not set by the handler
+  void EnableCompression(int level);
+
   bool headers_ended_{false};
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
+  int compression_level_{0};
+  std::unique_ptr<compression::gzip::Compressor> compressor_;
 };
 
 }  // namespace server::http
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -20,6 +21,10 @@ class RequestBase {
 
   virtual bool IsFinal() const = 0;
 
+  /// Whether the client asks to switch the connection to another protocol,
+  /// such a request is always final
+  virtual bool IsUpgrade() const { return false; }
+
   virtual ResponseBase& GetResponse() const = 0;
 
   virtual void WriteAccessLogs(const logging::LoggerPtr& logger_access,
@@ -41,8 +46,22 @@ class RequestBase {
     return start_time_;
   }
 
+  std::chrono::steady_clock::time_point TaskCreateTime() const {
+    return task_create_time_;
+  }
+
+  std::chrono::steady_clock::time_point TaskStartTime() const {
+    return task_start_time_;
+  }
+
   virtual void MarkAsInternalServerError() const = 0;
 
+  /// Marks the request as cancelled as the client has disconnected, must be
+  /// called before its task is cancelled
+  void MarkAsCancelledByPeer() noexcept;
+
+  bool IsCancelledByPeer() const noexcept;
+
   virtual void AccountResponseTime() = 0;
 
  protected:
@@ -58,6 +77,9 @@ class RequestBase {
   std::chrono::steady_clock::time_point start_send_response_time_;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   std::chrono::steady_clock::time_point finish_send_response_time_;
+
+ private:
+  std::atomic<bool> is_cancelled_by_peer_{false};
 };
 
 }  // namespace server::request
@@ -8,6 +8,7 @@
 #include <userver/compiler/select.hpp>
 #include <userver/utils/any_movable.hpp>
 #include <userver/utils/fast_pimpl.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -98,6 +99,13 @@ class RequestContext final {
   /// @brief Erase data with specified name.
   void EraseData(const std::string& name);
 
+  /// @brief Request-scoped memory arena, all its memory is freed at once
+  /// after the request is handled.
+  ///
+  /// Use it with utils::ArenaAllocator for the short-lived containers that do
+  /// not outlive the request handling.
+  utils::MonotonicArena& GetArena() noexcept { return arena_; }
+
  private:
   class Impl;
 
@@ -118,6 +126,7 @@ class RequestContext final {
   void EraseAnyData(const std::string& name);
 
   utils::FastPimpl<Impl, kPimplSize, alignof(void*), utils::kStrictMatch> impl_;
+  utils::MonotonicArena arena_;
 };
 
 template <typename Data>
@@ -4,8 +4,10 @@
 #include <chrono>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 USERVER_NAMESPACE_BEGIN
@@ -48,8 +50,20 @@ class ResponseBase {
   virtual ~ResponseBase() noexcept;
 
   void SetData(std::string data);
+  /// @returns the data set by SetData(), empty if SetSharedData() was called
   const std::string& GetData() const { return data_; }
 
+  /// @brief Sets the data that is kept alive by `owner`, e.g. a memory-mapped
+  /// file, to send it without copying into the response. SetData() discards
+  /// it.
+  void SetSharedData(std::string_view data, std::shared_ptr<const void> owner);
+  bool HasSharedData() const { return shared_data_owner_ != nullptr; }
+
+  /// @returns the data set either by SetData() or by SetSharedData()
+  std::string_view GetDataView() const {
+    return HasSharedData() ? shared_data_ : std::string_view{data_};
+  }
+
   virtual bool IsBodyStreamed() const = 0;
   virtual bool WaitForHeadersEnd() = 0;
   virtual void SetHeadersEnd() = 0;
@@ -65,6 +79,9 @@ class ResponseBase {
   bool IsReady() const { return is_ready_; }
   bool IsSent() const { return is_sent_; }
   size_t BytesSent() const { return bytes_sent_; }
+  /// Bytes of BytesSent() that were serialized into intermediate buffers
+  /// rather than sent straight from the response data
+  size_t BytesCopied() const { return bytes_copied_; }
   std::chrono::steady_clock::time_point ReadyTime() const {
     return ready_time_;
   }
@@ -75,10 +92,20 @@ class ResponseBase {
   virtual void SetStatusServiceUnavailable() = 0;
   virtual void SetStatusOk() = 0;
   virtual void SetStatusNotFound() = 0;
+
+  using UpgradeCallback = std::function<void(engine::io::Socket& socket)>;
+
+  /// Makes the connection call `callback` with its socket once the response
+  /// is sent, the connection is closed when the callback returns
+  void SetUpgradeCallback(UpgradeCallback callback);
+  bool IsUpgradeRequested() const noexcept {
+    return upgrade_callback_ != nullptr;
+  }
+  void SwitchProtocols(engine::io::Socket& socket);
   /// @endcond
 
  protected:
-  void SetSent(size_t bytes_sent);
+  void SetSent(size_t bytes_sent, size_t bytes_copied = 0);
   void SetSentTime(std::chrono::steady_clock::time_point sent_time);
 
   class Guard final {
@@ -101,10 +128,14 @@ class ResponseBase {
   ResponseDataAccounter& accounter_;
   std::optional<Guard> guard_;
   std::string data_;
+  std::string_view shared_data_;
+  std::shared_ptr<const void> shared_data_owner_;
+  UpgradeCallback upgrade_callback_;
   std::chrono::steady_clock::time_point create_time_;
   std::chrono::steady_clock::time_point ready_time_;
   std::chrono::steady_clock::time_point sent_time_;
   size_t bytes_sent_ = 0;
+  size_t bytes_copied_ = 0;
   bool is_ready_ = false;
   bool is_sent_ = false;
 };
@@ -30,10 +30,17 @@ struct TaskInheritedData final {
 
 /// @see TaskInheritedData for details on the contents.
 ///
+/// ## Deadline propagation
+///
+/// By default, the remaining time of the handled request limits the outbound
+/// calls made directly from the handler task, as well as from its child tasks:
+/// the deadline header is set for HTTP client requests, and the timeouts of
+/// PostgreSQL, Redis and gRPC client calls are shrunk to the remaining time.
+/// Once the deadline is reached, the calls fail without reaching the network.
+///
 /// ## Stopping deadline propagation
 ///
-/// By default, deadline header is set for client requests created directly
-/// from the handler task, as well as from its child tasks. However, this
+/// However, this
 /// behavior is highly undesirable for requests from background tasks, which
 /// should continue past the deadline of the originally handled request.
 ///
@@ -46,6 +53,13 @@ struct TaskInheritedData final {
 /// @see concurrent::BackgroundTaskStorage::AsyncDetach does it by default.
 inline engine::TaskInheritedVariable<TaskInheritedData> kTaskInheritedData;
 
+/// @brief Returns the deadline of the request handled by the current task or
+/// by its parent, an unreachable Deadline if there is none or if called
+/// outside of a coroutine.
+///
+/// Outbound clients limit their timeouts with it, see kTaskInheritedData.
+engine::Deadline GetTaskInheritedDeadline() noexcept;
+
 }  // namespace server::request
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file userver/server/websocket/broadcaster.hpp
+/// @brief @copybrief server::websocket::Broadcaster
+
+#include <cstddef>
+#include <unordered_set>
+
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/server/websocket/websocket_connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+// clang-format off
+
+/// @brief Sends a message to all the subscribed connections.
+///
+/// The message is framed and compressed once, each connection queues a
+/// reference to the shared frame. The connections with a full send queue skip
+/// the message instead of delaying the others.
+///
+/// @snippet server/websocket/websocket_connection_test.cpp  Sample websocket handler
+
+// clang-format on
+
+class Broadcaster final {
+ public:
+  /// Keeps the connection subscribed, must be destroyed before the
+  /// connection
+  class Subscription final {
+   public:
+    Subscription() = default;
+    Subscription(Subscription&&) noexcept;
+    Subscription& operator=(Subscription&&) noexcept;
+    ~Subscription();
+
+    void Unsubscribe() noexcept;
+
+   private:
+    friend class Broadcaster;
+    Subscription(Broadcaster& broadcaster, WebSocketConnection& connection);
+
+    Broadcaster* broadcaster_{nullptr};
+    WebSocketConnection* connection_{nullptr};
+  };
+
+  struct BroadcastResult {
+    std::size_t sent{0};
+    /// The connections that were closed or had a full send queue
+    std::size_t dropped{0};
+  };
+
+  Broadcaster() = default;
+  Broadcaster(const Broadcaster&) = delete;
+  Broadcaster& operator=(const Broadcaster&) = delete;
+  ~Broadcaster();
+
+  [[nodiscard]] Subscription Subscribe(WebSocketConnection& connection);
+
+  BroadcastResult Broadcast(const PreparedMessage& message);
+
+  std::size_t GetSubscribersCount() const;
+
+ private:
+  void Unsubscribe(WebSocketConnection& connection) noexcept;
+
+  mutable engine::SharedMutex mutex_;
+  std::unordered_set<WebSocketConnection*> connections_;
+};
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,146 @@
+#pragma once
+
+/// @file userver/server/websocket/websocket_connection.hpp
+/// @brief @copybrief server::websocket::WebSocketConnection
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/engine/io/sockaddr.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+class Socket;
+}  // namespace engine::io
+
+/// @brief WebSocket server, see server::websocket::WebsocketHandlerBase
+namespace server::websocket {
+
+namespace impl {
+class PreparedFrames;
+
+struct ConnectionConfig {
+  std::size_t max_message_size{0};
+  std::size_t max_send_queue_size{0};
+  bool is_deflate_enabled{false};
+};
+}  // namespace impl
+
+/// Close status codes of RFC 6455 section 7.4.1
+enum class CloseStatus : std::uint16_t {
+  kNormal = 1000,
+  kGoingAway = 1001,
+  kProtocolError = 1002,
+  kUnsupportedData = 1003,
+  /// The peer closed the connection without a status, never sent
+  kNoStatusReceived = 1005,
+  /// The connection was lost without a close frame, never sent
+  kAbnormalClosure = 1006,
+  kInvalidPayload = 1007,
+  kPolicyViolation = 1008,
+  kMessageTooBig = 1009,
+  kMandatoryExtension = 1010,
+  kInternalError = 1011,
+};
+
+/// A message received from a client
+struct Message {
+  std::string data;
+  bool is_text{false};
+  /// Set if the connection is closed, `data` holds the close reason then
+  std::optional<CloseStatus> close_status;
+};
+
+/// @brief A message framed once to be sent to any number of connections.
+///
+/// Sending a prepared message to a connection queues a reference to the
+/// shared frame, the payload is neither copied nor compressed per connection.
+/// The permessage-deflate variant of the frame is compressed on the first
+/// send to a connection that negotiated the extension.
+///
+/// Copies of a PreparedMessage share the frames.
+class PreparedMessage final {
+ public:
+  static PreparedMessage Text(std::string_view data);
+  static PreparedMessage Binary(std::string_view data);
+
+  std::size_t GetPayloadSize() const noexcept;
+
+  /// @cond
+  const impl::PreparedFrames& GetFrames() const noexcept { return *frames_; }
+  /// @endcond
+
+ private:
+  explicit PreparedMessage(std::shared_ptr<const impl::PreparedFrames> frames);
+
+  std::shared_ptr<const impl::PreparedFrames> frames_;
+};
+
+/// @brief A server side WebSocket connection, see
+/// server::websocket::WebsocketHandlerBase::Handle.
+///
+/// A single task may receive messages while any number of tasks send them.
+/// The messages are sent by a separate task of the connection in batches;
+/// each connection has a bounded send queue, so a slow client delays only its
+/// own messages: Send() waits for a free slot, TrySend() drops the message.
+/// The control frames do not count against the limit.
+///
+/// The pings of the client are answered while Recv() waits for a message.
+class WebSocketConnection final {
+ public:
+  /// @cond
+  WebSocketConnection(engine::io::Socket& socket,
+                      const impl::ConnectionConfig& config);
+  /// @endcond
+
+  WebSocketConnection(WebSocketConnection&&) = delete;
+  WebSocketConnection& operator=(WebSocketConnection&&) = delete;
+
+  /// Sends the close frame unless it was sent, waits a bit for the queued
+  /// frames to go out
+  ~WebSocketConnection();
+
+  /// @brief Waits for the next message, assembles the fragmented messages.
+  ///
+  /// Once the client sends a close frame or violates the protocol, the
+  /// connection is closed and the message has the `close_status` set; the
+  /// subsequent calls return the same status without waiting.
+  ///
+  /// @throws engine::io::IoException on socket errors and cancellation
+  void Recv(Message& message);
+
+  /// Queues the message, waits while the queue is full. The message is
+  /// dropped if the connection is closed or the current task is cancelled.
+  void Send(const PreparedMessage& message);
+
+  /// Queues the message without waiting. Returns false and drops the message
+  /// if the queue is full or the connection is closed.
+  [[nodiscard]] bool TrySend(const PreparedMessage& message);
+
+  void SendText(std::string_view data);
+  void SendBinary(std::string_view data);
+
+  /// Sends the close frame after the queued messages, the messages sent
+  /// afterwards are dropped. Recv() still returns the messages until the
+  /// client confirms the close.
+  void Close(CloseStatus status);
+
+  /// Whether the close frame was queued by either side or by an error
+  bool IsClosing() const;
+
+  std::size_t GetSendQueueSize() const;
+
+  const engine::io::Sockaddr& RemoteAddr() const noexcept;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,91 @@
+#pragma once
+
+/// @file userver/server/websocket/websocket_handler.hpp
+/// @brief @copybrief server::websocket::WebsocketHandlerBase
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/websocket/websocket_connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers userver_base_classes
+///
+/// @brief Base class for the handlers that upgrade HTTP/1.1 connections to
+/// the WebSocket protocol of RFC 6455.
+///
+/// The handler validates the handshake, optionally negotiates the
+/// permessage-deflate extension of RFC 7692 and answers with
+/// `101 Switching Protocols`. Once the response is sent, Handle() runs in the
+/// task of the connection; the connection is closed when Handle() returns.
+/// The server stop cancels the task, Recv() throws then and the clients get
+/// the 1001 close status.
+///
+/// The messages sent to many connections should be prepared once with
+/// server::websocket::PreparedMessage and sent with
+/// server::websocket::Broadcaster, that writes the same frame to each of the
+/// connections.
+///
+/// With permessage-deflate the server compresses each message on its own to
+/// share the compressed frames between the connections, so the offers that
+/// limit the window of the server are declined.
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the
+/// following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// max-message-size | max size of a received message after the decompression, the bigger messages close the connection with the 1009 status | 1048576
+/// max-send-queue-size | max count of the messages queued to a connection, the control frames do not count | 1024
+/// permessage-deflate | whether to accept the permessage-deflate offers of the clients | false
+///
+/// ## Example usage:
+///
+/// @snippet server/websocket/websocket_connection_test.cpp  Sample websocket handler
+
+// clang-format on
+
+class WebsocketHandlerBase : public handlers::HttpHandlerBase {
+ public:
+  WebsocketHandlerBase(const components::ComponentConfig& config,
+                       const components::ComponentContext& context);
+
+  ~WebsocketHandlerBase() override;
+
+  /// @brief Runs the protocol over the upgraded connection.
+  ///
+  /// `request` is the handshake request, its response is already sent.
+  virtual void Handle(const http::HttpRequest& request,
+                      WebSocketConnection& websocket) const = 0;
+
+  /// @brief Called for a valid handshake before the response is formed.
+  ///
+  /// Returning false rejects the upgrade with the response that the override
+  /// has set. The override may choose a subprotocol by setting the
+  /// `Sec-WebSocket-Protocol` response header.
+  virtual bool HandleHandshake(const http::HttpRequest& request,
+                               http::HttpResponse& response,
+                               request::RequestContext& context) const;
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext& context) const final;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void RunConnection(const http::HttpRequest& request,
+                     engine::io::Socket& socket,
+                     const impl::ConnectionConfig& config) const;
+
+  const std::size_t max_message_size_;
+  const std::size_t max_send_queue_size_;
+  const bool is_deflate_enabled_;
+};
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
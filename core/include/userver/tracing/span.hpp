@@ -3,6 +3,7 @@
 /// @file userver/tracing/span.hpp
 /// @brief @copybrief tracing::Span
 
+#include <chrono>
 #include <optional>
 #include <string_view>
 
@@ -14,6 +15,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace logging::impl {
+class TailSampling;
+}  // namespace logging::impl
+
 namespace tracing {
 
 /// @brief Measures the execution time of the current code block, links it with
@@ -149,6 +154,33 @@ class Span final {
   /// it is set and greater than the main log level of the Span.
   std::optional<logging::Level> GetLocalLogLevel() const;
 
+  /// @brief Enables the tail sampling of the logs for this Span and its future
+  /// children.
+  ///
+  /// The log messages of `level` and higher that are below the level of their
+  /// logger are buffered instead of being dropped. When this Span ends, the
+  /// buffered messages are written with their original timestamps if the Span
+  /// has the tracing::kErrorFlag tag or took at least `latency_threshold`,
+  /// and are dropped otherwise.
+  void EnableTailSampling(logging::Level level,
+                          std::chrono::milliseconds latency_threshold);
+
+  /// @brief Sets the head sampling decision for this Span and its future
+  /// children, all the spans are sampled by default.
+  ///
+  /// Unsampled spans still have the trace id and the span ids and propagate
+  /// them to the logs and the outgoing requests. But they cost next to
+  /// nothing: there are no time measurements, the non-inheritable tags are
+  /// dropped, and the spans are neither logged nor exported on destruction.
+  ///
+  /// Usually set at the request entry, see `tracing-sampling-ratio` of
+  /// server::handlers::HttpHandlerBase.
+  void SetSampled(bool is_sampled);
+
+  /// @returns false if the Span or one of its parents was marked as not
+  /// sampled with SetSampled()
+  bool IsSampled() const noexcept;
+
   /// Set link. Can be called only once.
   void SetLink(std::string link);
 
@@ -181,6 +213,9 @@ class Span final {
   void AddTags(const logging::LogExtra&, utils::InternalTag);
 
   impl::TimeStorage& GetTimeStorage();
+
+  logging::impl::TailSampling* GetTailSampling(
+      utils::InternalTag) const noexcept;
   /// @endcond
 
  private:
@@ -0,0 +1,53 @@
+#pragma once
+
+/// @file userver/tracing/span_exporter.hpp
+/// @brief @copybrief tracing::SpanExporter
+
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+#include <userver/tracing/tracer_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// @brief Data of a finished span, valid only during the
+/// SpanExporter::Export call
+struct FinishedSpan final {
+  using Tag = std::pair<std::string_view,
+                        std::reference_wrapper<const logging::LogExtra::Value>>;
+
+  std::string_view name;
+  std::string_view trace_id;
+  std::string_view span_id;
+  std::string_view parent_id;
+  ReferenceType reference_type{ReferenceType::kChild};
+
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::nanoseconds duration{};
+  bool has_error{false};
+
+  /// Inheritable tags followed by the local tags of the span
+  std::vector<Tag> tags;
+};
+
+/// @brief Receives the spans of the sampled traces when they finish.
+///
+/// @see tracing::Tracer::SetSpanExporter
+class SpanExporter {
+ public:
+  virtual ~SpanExporter();
+
+  /// Called by the task that finishes the span, so the implementation should
+  /// only copy the data into its own buffer and return.
+  virtual void Export(const FinishedSpan& span) noexcept = 0;
+};
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
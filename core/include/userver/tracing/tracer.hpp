@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <unordered_set>
 
 #include <userver/tracing/span.hpp>
@@ -12,6 +13,7 @@ USERVER_NAMESPACE_BEGIN
 namespace tracing {
 
 struct NoLogSpans;
+class SpanExporter;
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
@@ -22,6 +24,29 @@ class Tracer : public std::enable_shared_from_this<Tracer> {
 
   static TracerPtr GetTracer();
 
+  /// Sets the exporter that receives the finished spans of the sampled
+  /// traces, `nullptr` disables the export
+  static void SetSpanExporter(std::shared_ptr<SpanExporter> exporter);
+
+  static std::shared_ptr<SpanExporter> GetSpanExporter();
+
+  /// Sets the share of the traces in [0, 1] that are passed to the span
+  /// exporter, 1 by default
+  static void SetSamplingRatio(double ratio);
+
+  /// @brief Head sampling decision for the trace.
+  ///
+  /// The decision depends only on the trace id, so all the spans of a trace
+  /// are either exported or not, in all the services that use the same ratio.
+  static bool IsSampled(std::string_view trace_id) noexcept;
+
+  /// @brief Head sampling decision for the trace with the specified share of
+  /// the sampled traces in [0, 1].
+  ///
+  /// Consistent with IsSampled(): a trace sampled with some ratio is also
+  /// sampled with any greater ratio.
+  static bool IsSampled(std::string_view trace_id, double ratio) noexcept;
+
   const std::string& GetServiceName() const;
 
   Span CreateSpanWithoutParent(std::string name);
@@ -29,7 +29,8 @@ class ScopeTimePause {
 };
 
 /// Utility to yield every N iterations in a CPU-bound task to give other tasks
-/// an opportunity to get CPU time
+/// an opportunity to get CPU time. Also yields once the task exceeds the
+/// time slice of engine::YieldIfTimeSliceExceeded().
 class CpuRelax {
  public:
   /// @param every number of iterations to call yield. 0 = noop
@@ -50,7 +51,8 @@ class CpuRelax {
 };
 
 /// Utility to yield in a CPU-bound data processing task
-/// to give other tasks an opportunity to get CPU time
+/// to give other tasks an opportunity to get CPU time. Also yields once the
+/// task exceeds the time slice of engine::YieldIfTimeSliceExceeded().
 class StreamingCpuRelax {
  public:
   /// @param check_time_after_bytes number of bytes to call yield
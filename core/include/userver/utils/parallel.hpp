@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file userver/utils/parallel.hpp
+/// @brief Parallel algorithms over the task processor of the current task
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Parallel algorithms, that split a range into chunks and process the
+/// chunks in separate tasks of the current task processor.
+///
+/// The current task processes the chunks too and waits for the other tasks.
+/// The tasks are started with utils::Async, so they inherit the tracing span
+/// and the task-inherited data of the caller.
+///
+/// The functions are called concurrently from multiple tasks, so they must be
+/// thread-safe. Iterators must be random access.
+///
+/// If the caller is cancelled or the deadline is reached, no new chunks are
+/// started, the already running ones are waited for, and
+/// engine::WaitInterruptedException is thrown. An exception from a function
+/// is rethrown in the caller, the other tasks are cancelled.
+///
+/// ## Example usage:
+///
+/// @snippet utils/parallel_test.cpp  Sample utils::parallel usage
+namespace utils::parallel {
+
+/// Parallel algorithm settings
+struct Settings final {
+  /// The number of elements in a chunk, 0 to pick it for ~4 chunks per task
+  std::size_t grain_size{0};
+
+  /// The max number of tasks including the current one, 0 to use the worker
+  /// count of the current task processor
+  std::size_t max_tasks{0};
+
+  /// Deadline for the whole algorithm, is also set for the started tasks
+  engine::Deadline deadline{};
+};
+
+namespace impl {
+
+std::size_t GetChunkSize(std::size_t size, const Settings& settings);
+
+// Calls `job(i)` for each i in [0, job_count) from up to settings.max_tasks
+// tasks and waits for all of them
+void RunJobs(std::size_t job_count, const Settings& settings,
+             const std::function<void(std::size_t job)>& job);
+
+template <typename Func>
+void RunChunks(std::size_t size, std::size_t chunk_size,
+               const Settings& settings, const Func& func) {
+  const auto chunk_count = (size + chunk_size - 1) / chunk_size;
+  RunJobs(chunk_count, settings, [&](std::size_t chunk) {
+    const auto begin = chunk * chunk_size;
+    func(chunk, begin, std::min(begin + chunk_size, size));
+  });
+}
+
+}  // namespace impl
+
+/// @brief Calls `func(element)` for each element of the range
+template <typename Iterator, typename Func>
+void ForEach(Iterator first, Iterator last, const Func& func,
+             const Settings& settings = {}) {
+  const std::size_t size = std::distance(first, last);
+  impl::RunChunks(size, impl::GetChunkSize(size, settings), settings,
+                  [&](std::size_t /*chunk*/, std::size_t begin,
+                      std::size_t end) {
+                    for (auto it = first + begin; it != first + end; ++it) {
+                      func(*it);
+                    }
+                  });
+}
+
+/// @brief Assigns `func(element)` to the corresponding element of the output
+/// range. The output range must have enough elements.
+/// @returns the iterator past the last written element
+template <typename InputIterator, typename OutputIterator, typename Func>
+OutputIterator Transform(InputIterator first, InputIterator last,
+                         OutputIterator out, const Func& func,
+                         const Settings& settings = {}) {
+  const std::size_t size = std::distance(first, last);
+  impl::RunChunks(size, impl::GetChunkSize(size, settings), settings,
+                  [&](std::size_t /*chunk*/, std::size_t begin,
+                      std::size_t end) {
+                    for (auto i = begin; i != end; ++i) {
+                      out[i] = func(first[i]);
+                    }
+                  });
+  return out + size;
+}
+
+/// @brief Combines `init` and the elements with `op`, which must be
+/// associative. The elements of each chunk are combined in order, then the
+/// results of the chunks are combined in order.
+template <typename Iterator, typename T, typename BinaryOp>
+T Reduce(Iterator first, Iterator last, T init, const BinaryOp& op,
+         const Settings& settings = {}) {
+  const std::size_t size = std::distance(first, last);
+  const auto chunk_size = impl::GetChunkSize(size, settings);
+
+  std::vector<std::optional<T>> partial_results((size + chunk_size - 1) /
+                                                chunk_size);
+  impl::RunChunks(size, chunk_size, settings,
+                  [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                    T result(first[begin]);
+                    for (auto i = begin + 1; i != end; ++i) {
+                      result = op(std::move(result), first[i]);
+                    }
+                    partial_results[chunk].emplace(std::move(result));
+                  });
+
+  for (auto& result : partial_results) {
+    init = op(std::move(init), std::move(*result));
+  }
+  return init;
+}
+
+/// @brief Sorts the range: sorts the chunks, then merges them pairwise in
+/// parallel. Not stable.
+template <typename Iterator, typename Compare>
+void Sort(Iterator first, Iterator last, const Compare& comp,
+          const Settings& settings = {}) {
+  const std::size_t size = std::distance(first, last);
+  const auto chunk_size = impl::GetChunkSize(size, settings);
+  impl::RunChunks(size, chunk_size, settings,
+                  [&](std::size_t /*chunk*/, std::size_t begin,
+                      std::size_t end) {
+                    std::sort(first + begin, first + end, comp);
+                  });
+
+  for (auto width = chunk_size; width < size; width *= 2) {
+    impl::RunChunks(size, 2 * width, settings,
+                    [&](std::size_t /*chunk*/, std::size_t begin,
+                        std::size_t end) {
+                      const auto middle = std::min(begin + width, end);
+                      std::inplace_merge(first + begin, first + middle,
+                                         first + end, comp);
+                    });
+  }
+}
+
+/// @overload
+template <typename Iterator>
+void Sort(Iterator first, Iterator last, const Settings& settings = {}) {
+  parallel::Sort(first, last, std::less<>{}, settings);
+}
+
+}  // namespace utils::parallel
+
+USERVER_NAMESPACE_END
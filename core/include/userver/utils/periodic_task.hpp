@@ -3,6 +3,7 @@
 /// @file userver/utils/periodic_task.hpp
 /// @brief @copybrief utils::PeriodicTask
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <optional>
@@ -22,6 +23,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils {
 
+class PeriodicTaskScheduler;
+
 /// @ingroup userver_concurrency
 /// @brief Task that periodically runs a user callback
 class PeriodicTask final {
@@ -83,6 +86,10 @@ class PeriodicTask final {
     utils::Flags<Flags> flags{};
     logging::Level span_level{};
     engine::TaskProcessor* task_processor{nullptr};
+    /// If set, the task sleeps in the shared scheduler instead of its own
+    /// coroutine and runs the steps in the task processor of the scheduler.
+    /// Must be set at the start, as the flags.
+    PeriodicTaskScheduler* scheduler{nullptr};
   };
 
   using Callback = std::function<void()>;
@@ -119,6 +126,14 @@ class PeriodicTask final {
   /// serially, one time after another.
   bool SynchronizeDebug(bool preserve_span = false);
 
+  /// @brief Makes the task run the next Step() without waiting for the rest
+  /// of the period, returns without waiting for it.
+  ///
+  /// The requests made while a Step() is running result in a single Step()
+  /// right after the current one. The period is counted from the forced
+  /// Step().
+  void ForceStepAsync();
+
   /// Skip Step() calls from loop until ResumeDebug() is called. If DoStep()
   /// is executing, wait its completion, for a potentially long time.
   /// The purpose is to control task execution from tests.
@@ -141,10 +156,22 @@ class PeriodicTask final {
   Settings GetCurrentSettings() const;
 
  private:
+  friend class PeriodicTaskScheduler;
+
   enum class SuspendState { kRunning, kSuspended };
 
+  struct NextStep {
+    std::chrono::steady_clock::time_point time;
+    std::chrono::milliseconds period;
+  };
+
   void DoStart();
 
+  // Runs a step in the coroutine borrowed from the scheduler
+  NextStep ScheduledStep();
+
+  bool IsCritical() const;
+
   void Run();
 
   bool Step();
@@ -158,12 +185,16 @@ class PeriodicTask final {
   std::string name_;
   Callback callback_;
   engine::TaskWithResult<void> task_;
+  // Set while the task is registered in the scheduler
+  PeriodicTaskScheduler* scheduler_{nullptr};
+  std::atomic<std::chrono::steady_clock::time_point> period_start_{};
   rcu::Variable<Settings> settings_;
   engine::SingleConsumerEvent changed_event_;
 
   // For kNow only
   engine::Mutex step_mutex_;
   std::atomic<SuspendState> suspend_state_;
+  std::atomic<bool> should_force_step_{false};
 
   std::optional<testsuite::PeriodicTaskRegistrationHolder> registration_holder_;
 };
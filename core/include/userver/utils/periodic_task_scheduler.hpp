@@ -0,0 +1,124 @@
+#pragma once
+
+/// @file userver/utils/periodic_task_scheduler.hpp
+/// @brief @copybrief utils::PeriodicTaskScheduler
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+class PeriodicTask;
+
+// clang-format off
+
+/// @ingroup userver_concurrency
+/// @brief Runs many utils::PeriodicTask with a single sleeping coroutine.
+///
+/// A utils::PeriodicTask with utils::PeriodicTask::Settings::scheduler set
+/// does not keep a coroutine of its own between the steps. The scheduler keeps
+/// the next step times of its tasks ordered, wakes up for the earliest one and
+/// starts all the steps that are due within the slack, so the tasks with close
+/// step times wake up in one batch. A coroutine is taken for a task only while
+/// its Step() runs.
+///
+/// A step never starts earlier than its time minus the slack, and the slack
+/// of a task is limited by a quarter of its period, so the short periods are
+/// not shortened noticeably.
+///
+/// The scheduler must outlive all the tasks registered in it.
+///
+/// ## Example usage:
+///
+/// @snippet utils/periodic_task_scheduler_test.cpp  Sample periodic task scheduler
+
+// clang-format on
+
+class PeriodicTaskScheduler final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Settings {
+    /// The steps that are due within the slack of the earliest one start
+    /// together with it
+    std::chrono::milliseconds slack{std::chrono::milliseconds{100}};
+    /// The task processor of the scheduler coroutine and of the steps, the
+    /// current one if not set
+    engine::TaskProcessor* task_processor{nullptr};
+  };
+
+  PeriodicTaskScheduler();
+  explicit PeriodicTaskScheduler(Settings settings);
+
+  PeriodicTaskScheduler(PeriodicTaskScheduler&&) = delete;
+  PeriodicTaskScheduler& operator=(PeriodicTaskScheduler&&) = delete;
+  ~PeriodicTaskScheduler();
+
+  /// Number of the registered tasks
+  std::size_t GetTasksCount() const;
+
+  /// Number of the steps that are running now
+  std::size_t GetRunningStepsCount() const;
+
+ private:
+  friend class PeriodicTask;
+
+  using Queue = std::multimap<Clock::time_point, PeriodicTask*>;
+
+  struct Entry {
+    std::optional<Queue::iterator> queued;
+    /// The step may start that much earlier than it is due
+    Clock::duration slack{};
+    /// Valid while the step runs
+    engine::TaskCancellationToken running;
+    bool is_removed{false};
+  };
+
+  void Register(PeriodicTask& task, Clock::time_point first_step,
+                std::chrono::milliseconds period);
+
+  /// Moves the next step of a waiting task, a running task is rescheduled in
+  /// the end of its step
+  void Reschedule(PeriodicTask& task, Clock::time_point next_step,
+                  std::chrono::milliseconds period);
+
+  /// Cancels the running step and waits for it
+  void Unregister(PeriodicTask& task) noexcept;
+
+  void Enqueue(PeriodicTask& task, Entry& entry, Clock::time_point next_step,
+               std::chrono::milliseconds period);
+
+  void Run();
+
+  void RunStep(PeriodicTask& task);
+
+  const Settings settings_;
+  engine::TaskProcessor& task_processor_;
+
+  mutable engine::Mutex mutex_;
+  engine::ConditionVariable step_finished_cv_;
+  Queue queue_;
+  std::unordered_map<PeriodicTask*, Entry> entries_;
+  std::size_t running_steps_{0};
+
+  engine::SingleConsumerEvent queue_changed_event_;
+  concurrent::BackgroundTaskStorageCore steps_;
+  engine::TaskWithResult<void> loop_task_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
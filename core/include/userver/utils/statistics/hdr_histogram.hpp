@@ -0,0 +1,196 @@
+#pragma once
+
+/// @file userver/utils/statistics/hdr_histogram.hpp
+/// @brief @copybrief utils::statistics::HdrHistogram
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl::hdr {
+
+/// Values in [0, 2^precision_bits) get a bucket each, every next power-of-two
+/// range [2^k, 2^(k+1)) is split into 2^precision_bits equal buckets.
+constexpr std::size_t GetBucketCount(std::size_t precision_bits,
+                                     std::size_t max_value_bits) noexcept {
+  return (max_value_bits - precision_bits + 1) << precision_bits;
+}
+
+constexpr std::size_t GetBucketIndex(std::uint64_t value,
+                                     std::size_t precision_bits,
+                                     std::size_t max_value_bits) noexcept {
+  const std::uint64_t sub_bucket_count = std::uint64_t{1} << precision_bits;
+  if (value < sub_bucket_count) return value;
+
+  const auto bucket_count = GetBucketCount(precision_bits, max_value_bits);
+  if (value >> max_value_bits) return bucket_count - 1;
+
+  const std::size_t msb = 63 - __builtin_clzll(value);
+  const std::size_t shift = msb - precision_bits;
+  return ((shift + 1) << precision_bits) +
+         static_cast<std::size_t>((value >> shift) - sub_bucket_count);
+}
+
+/// The greatest value that gets into the bucket
+constexpr std::uint64_t GetBucketUpperBound(
+    std::size_t index, std::size_t precision_bits) noexcept {
+  const std::size_t sub_bucket_count = std::size_t{1} << precision_bits;
+  if (index < sub_bucket_count) return index;
+
+  const std::size_t shift = (index >> precision_bits) - 1;
+  const std::uint64_t sub_bucket = (index & (sub_bucket_count - 1)) |
+                                   sub_bucket_count;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+}  // namespace impl::hdr
+
+/// @brief Read-only view of the HdrHistogram buckets, used to write the
+/// histogram to utils::statistics::Writer without knowing its parameters.
+class HdrHistogramView final {
+ public:
+  std::size_t GetBucketCount() const noexcept { return bucket_count_; }
+
+  /// The greatest value accounted in the bucket
+  std::uint64_t GetUpperBoundAt(std::size_t index) const noexcept;
+
+  std::uint64_t GetValueAt(std::size_t index) const noexcept;
+
+  /// Number of the accounted values
+  std::uint64_t GetTotalCount() const noexcept;
+
+  /// Sum of the accounted values
+  std::uint64_t GetSum() const noexcept;
+
+  /// Upper bound of the bucket where the percentile falls, the relative error
+  /// is below 2^-PrecisionBits of the histogram
+  std::uint64_t GetPercentile(double percent) const noexcept;
+
+  /// @cond
+  HdrHistogramView(const std::atomic<std::uint64_t>* buckets,
+                   std::size_t bucket_count, std::size_t precision_bits,
+                   const std::atomic<std::uint64_t>& sum) noexcept
+      : buckets_(buckets),
+        bucket_count_(bucket_count),
+        precision_bits_(precision_bits),
+        sum_(&sum) {}
+  /// @endcond
+
+ private:
+  const std::atomic<std::uint64_t>* buckets_;
+  std::size_t bucket_count_;
+  std::size_t precision_bits_;
+  const std::atomic<std::uint64_t>* sum_;
+};
+
+/// @brief Log-linear (HDR-style) histogram with bounded relative error.
+///
+/// Unlike utils::statistics::Percentile, the resolution does not depend on the
+/// magnitude of the values: each power-of-two range is split into
+/// 2^PrecisionBits buckets, so the relative error of the percentiles is below
+/// 2^-PrecisionBits for all the values below 2^MaxValueBits. Bigger values are
+/// accounted in the last bucket.
+///
+/// The default parameters cover microseconds up to ~19 hours with ~3% error
+/// using 1024 buckets.
+///
+/// Account() is lock-free and wait-free, so the histogram may be written from
+/// any number of threads at once. Histograms are mergeable with Add(), which
+/// makes them suitable for utils::statistics::RecentPeriod.
+///
+/// Prometheus and Solomon formats write the histogram natively with its
+/// buckets, other formats write the percentiles as utils::statistics::Percentile
+/// does.
+///
+/// @code
+/// using Histogram = utils::statistics::HdrHistogram<>;
+///
+/// void Account(Histogram& histogram, std::chrono::microseconds us) {
+///   histogram.Account(us.count());
+/// }
+///
+/// void DumpMetric(utils::statistics::Writer& writer, const Histogram& h) {
+///   writer["timings-us"] = h;
+/// }
+/// @endcode
+template <std::size_t PrecisionBits = 5, std::size_t MaxValueBits = 36>
+class HdrHistogram final {
+  static_assert(PrecisionBits > 0 && PrecisionBits < MaxValueBits &&
+                MaxValueBits < 64);
+
+ public:
+  static constexpr std::size_t kBucketCount =
+      impl::hdr::GetBucketCount(PrecisionBits, MaxValueBits);
+
+  HdrHistogram() noexcept { Reset(); }
+
+  HdrHistogram(const HdrHistogram& other) noexcept { *this = other; }
+
+  HdrHistogram& operator=(const HdrHistogram& rhs) noexcept {
+    if (this == &rhs) return *this;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      buckets_[i].store(rhs.buckets_[i].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    }
+    sum_.store(rhs.sum_.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+    return *this;
+  }
+
+  void Account(std::uint64_t value) noexcept {
+    buckets_[impl::hdr::GetBucketIndex(value, PrecisionBits, MaxValueBits)]
+        .fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  /// Merges the other histogram into this one
+  template <class Duration = std::chrono::seconds>
+  void Add(const HdrHistogram& other,
+           [[maybe_unused]] Duration this_epoch_duration = Duration(),
+           [[maybe_unused]] Duration before_this_epoch_duration = Duration()) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      const auto value = other.buckets_[i].load(std::memory_order_relaxed);
+      if (value) buckets_[i].fetch_add(value, std::memory_order_relaxed);
+    }
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  }
+
+  void Reset() noexcept {
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+  }
+
+  /// @see HdrHistogramView::GetPercentile
+  std::uint64_t GetPercentile(double percent) const noexcept {
+    return GetView().GetPercentile(percent);
+  }
+
+  std::uint64_t Count() const noexcept { return GetView().GetTotalCount(); }
+
+  HdrHistogramView GetView() const noexcept {
+    return {buckets_.data(), kBucketCount, PrecisionBits, sum_};
+  }
+
+ private:
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_;
+  std::atomic<std::uint64_t> sum_;
+};
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+void DumpMetric(Writer& writer,
+                const HdrHistogram<PrecisionBits, MaxValueBits>& histogram) {
+  writer = histogram.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
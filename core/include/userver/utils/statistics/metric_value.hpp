@@ -34,6 +34,17 @@ class MetricValue final {
     return std::visit(visitor, value_);
   }
 
+  /// Metrics of different types are never equal
+  friend bool operator==(const MetricValue& lhs,
+                         const MetricValue& rhs) noexcept {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend bool operator!=(const MetricValue& lhs,
+                         const MetricValue& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
   /// @cond
   MetricValue() noexcept : value_(std::int64_t{0}) {}
 
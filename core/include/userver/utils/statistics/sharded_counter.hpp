@@ -0,0 +1,105 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_counter.hpp
+/// @brief @copybrief utils::statistics::ShardedCounter
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+inline constexpr std::size_t kCounterShardCount = 32;
+
+/// Index of the shard for the current thread, stable for the thread lifetime
+std::size_t GetCounterShardIndex() noexcept;
+
+}  // namespace impl
+
+/// @brief Counter of type T that is split into per-thread cache lines.
+///
+/// Unlike utils::statistics::RelaxedCounter, concurrent modifications from
+/// different threads do not contend for a single cache line, which makes it
+/// suitable for the hot paths that are hit by every request or every task. The
+/// price is the memory footprint (a cache line per shard) and a linear Load()
+/// that sums all the shards, so use it for the counters that are modified
+/// much more often than read.
+///
+/// Increments and decrements may be done from different threads: the result
+/// of Load() is still exact once the modifications are complete.
+template <class T>
+class ShardedCounter final {
+  static_assert(std::is_integral_v<T>);
+
+ public:
+  using ValueType = T;
+
+  constexpr ShardedCounter() noexcept = default;
+
+  ShardedCounter(const ShardedCounter&) = delete;
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  /// Sums up all the shards, not a linearizable snapshot
+  T Load() const noexcept {
+    UnsignedType sum = 0;
+    for (const auto& shard : shards_) {
+      sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return static_cast<T>(sum);
+  }
+
+  operator T() const noexcept { return Load(); }
+
+  ShardedCounter& operator++() noexcept { return *this += 1; }
+
+  ShardedCounter& operator--() noexcept { return *this -= 1; }
+
+  void operator++(int) noexcept { *this += 1; }
+
+  void operator--(int) noexcept { *this -= 1; }
+
+  ShardedCounter& operator+=(T arg) noexcept {
+    GetShard().fetch_add(static_cast<UnsignedType>(arg),
+                         std::memory_order_relaxed);
+    return *this;
+  }
+
+  ShardedCounter& operator-=(T arg) noexcept {
+    GetShard().fetch_sub(static_cast<UnsignedType>(arg),
+                         std::memory_order_relaxed);
+    return *this;
+  }
+
+ private:
+  // shards are summed with wraparound, so a decrement in one shard may
+  // compensate an increment in another one
+  using UnsignedType = std::make_unsigned_t<T>;
+
+  static_assert(std::atomic<UnsignedType>::is_always_lock_free);
+
+  struct alignas(64) Shard final {
+    std::atomic<UnsignedType> value{0};
+  };
+
+  std::atomic<UnsignedType>& GetShard() noexcept {
+    return shards_[impl::GetCounterShardIndex()].value;
+  }
+
+  std::array<Shard, impl::kCounterShardCount> shards_{};
+};
+
+template <typename T>
+void DumpMetric(Writer& writer, const ShardedCounter<T>& value) {
+  writer = value.Load();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,101 @@
+#pragma once
+
+/// @file userver/utils/statistics/statsd_exporter.hpp
+/// @brief @copybrief components::StatsdExporter
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+class StatsdDeltaEncoder;
+}  // namespace utils::statistics::impl
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that periodically pushes the metrics to a statsd agent
+/// over UDP.
+///
+/// Unlike server::handlers::ServerMonitor, which renders all the metrics on
+/// each scrape, the exporter remembers the pushed values and sends only the
+/// metrics that changed since the previous push. All the metrics are sent
+/// once in a `full-push-interval` to refresh the agents that forget the
+/// gauges between flushes.
+///
+/// The metrics are sent as statsd gauges with the labels as DogStatsD tags:
+/// `path.to.metric:42|g|#label:value`, supported by Datadog, Telegraf, Vector
+/// and other agents. The lines are packed into datagrams of up to
+/// `max-packet-size` bytes and all the datagrams of a push are sent with as
+/// few syscalls as possible.
+///
+/// The host is resolved with the clients::dns::Component on each push.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// host | statsd agent host name or IP address | -
+/// port | statsd agent UDP port | 8125
+/// push-interval | how often to push the changed metrics | 10s
+/// full-push-interval | how often to push all the metrics, 0 to push only the changed ones | 5m
+/// max-packet-size | max datagram size in bytes | 1432
+/// send-timeout | timeout for resolving and sending a single push | 1s
+/// prefix | push only the metrics whose path starts with the prefix | ''
+/// task-processor | task processor to run the pushes on | the main task processor
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_component_list_test.cpp  Sample statsd exporter component config
+
+// clang-format on
+
+class StatsdExporter final : public LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "statsd-exporter";
+
+  StatsdExporter(const ComponentConfig&, const ComponentContext&);
+  ~StatsdExporter() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void OnAllComponentsLoaded() override;
+  void OnAllComponentsAreStopping() override;
+
+  void Push();
+
+  const utils::statistics::Storage& storage_;
+  clients::dns::Resolver& resolver_;
+  const std::string host_;
+  const int port_;
+  const std::chrono::milliseconds full_push_interval_;
+  const std::chrono::milliseconds send_timeout_;
+  const utils::statistics::Request request_;
+  const utils::PeriodicTask::Settings push_settings_;
+
+  // accessed from the push task only
+  std::unique_ptr<utils::statistics::impl::StatsdDeltaEncoder> encoder_;
+  engine::io::Socket socket_;
+  std::chrono::steady_clock::time_point last_full_push_{};
+
+  utils::PeriodicTask push_task_;
+};
+
+template <>
+inline constexpr bool kHasValidate<StatsdExporter> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
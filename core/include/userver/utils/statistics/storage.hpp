@@ -86,6 +86,8 @@ using ExtenderFunc =
 
 using WriterFunc = std::function<void(Writer&)>;
 
+class BaseFormatBuilder;
+
 namespace impl {
 
 struct MetricsSource final {
@@ -100,6 +102,14 @@ struct MetricsSource final {
 using StorageData = std::list<MetricsSource>;
 using StorageIterator = StorageData::iterator;
 
+/// Writes the metrics of a single metrics source to the builder
+using SourceWriteFunc = std::function<void(BaseFormatBuilder&)>;
+
+/// Called for each metrics source with the source identifier and a function
+/// that writes its metrics, the function may be called multiple times.
+using SourceVisitor =
+    std::function<void(const void* source_id, const SourceWriteFunc& write)>;
+
 }  // namespace impl
 
 class BaseFormatBuilder {
@@ -108,6 +118,11 @@ class BaseFormatBuilder {
 
   virtual void HandleMetric(std::string_view path, LabelsSpan labels,
                             const MetricValue& value) = 0;
+
+  /// Formats without native histograms get the percentiles of the histogram
+  /// as separate metrics with the `percentile` label
+  virtual void HandleHistogram(std::string_view path, LabelsSpan labels,
+                               const HdrHistogramView& histogram);
 };
 
 /// @ingroup userver_clients
@@ -129,6 +144,12 @@ class Storage final {
   void VisitMetrics(BaseFormatBuilder& out, const Request& request = {}) const;
 
   /// @cond
+  /// Visits the metrics source by source, used to cache the formatted
+  /// metrics of every source separately. The identifiers are stable while
+  /// the source is registered.
+  void VisitMetricsBySource(const Request& request,
+                            const impl::SourceVisitor& visitor) const;
+
   /// Must be called from StatisticsStorage only. Don't call it from user
   /// components.
   void StopRegisteringExtenders();
@@ -146,6 +167,9 @@ class Storage final {
  private:
   Entry DoRegisterExtender(impl::MetricsSource&& source);
 
+  void WriteSource(const impl::MetricsSource& source, BaseFormatBuilder& out,
+                   const Request& request) const;
+
   std::atomic<bool> may_register_extenders_;
   impl::StorageData metrics_sources_;
   mutable engine::SharedMutex mutex_;
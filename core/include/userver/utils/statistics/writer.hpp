@@ -12,6 +12,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
 
+class HdrHistogramView;
+
 namespace impl {
 
 struct WriterState;
@@ -52,7 +54,8 @@ class Writer final {
   /// function.
   template <class T>
   void operator=(const T& value) {
-    if constexpr (std::is_arithmetic_v<T>) {
+    if constexpr (std::is_arithmetic_v<T> ||
+                  std::is_same_v<T, HdrHistogramView>) {
       Write(value);
     } else {
       if (state_) {
@@ -101,6 +104,7 @@ class Writer final {
   void Write(unsigned long long value);
   void Write(long long value);
   void Write(double value);
+  void Write(const HdrHistogramView& value);
 
   void Write(float value) { Write(static_cast<double>(value)); }
 
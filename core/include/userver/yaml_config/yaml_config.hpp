@@ -116,6 +116,12 @@ class YamlConfig {
   const_iterator end() const;
 
  private:
+  friend class Iterator<IterTraits>;
+
+  // Resolves the substitution of a child that was already looked up
+  YamlConfig MakeChild(formats::yaml::Value value, std::string_view key) const;
+  YamlConfig MakeChild(formats::yaml::Value value, size_t index) const;
+
   formats::yaml::Value yaml_;
   formats::yaml::Value config_vars_;
 };
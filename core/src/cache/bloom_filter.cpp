@@ -0,0 +1,130 @@
+#include <userver/cache/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace {
+
+constexpr std::size_t kWordBits = 64;
+constexpr std::size_t kBlockWords = 8;
+constexpr std::size_t kBlockBits = kWordBits * kBlockWords;
+constexpr unsigned kMaxHashes = 16;
+
+// splitmix64 finalizer, spreads poor std::hash values (e.g. identity for ints)
+std::uint64_t Mix(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+std::size_t RoundUpToPowerOf2(std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+// Visits the bits of a hash: the block is picked by the low bits of the
+// mixed hash, the bits inside it by double hashing of its high bits
+template <typename Func>
+void ForEachBit(std::size_t hash, std::size_t blocks_mask, unsigned hashes,
+                Func&& func) {
+  const auto mixed = Mix(hash);
+  const auto block = static_cast<std::size_t>(mixed) & blocks_mask;
+  auto bit = static_cast<std::uint32_t>(mixed >> 32);
+  const auto step = static_cast<std::uint32_t>(Mix(mixed) >> 32) | 1;
+
+  for (unsigned i = 0; i < hashes; ++i, bit += step) {
+    const auto in_block = bit % kBlockBits;
+    func(block * kBlockWords + in_block / kWordBits,
+         std::uint64_t{1} << (in_block % kWordBits));
+  }
+}
+
+}  // namespace
+
+double BloomFilterStatistics::GetFalsePositiveRate() const noexcept {
+  // a check of a missing key is either short-circuited or a false positive
+  const auto missing = negatives + false_positives;
+  if (missing == 0) return 0;
+  return static_cast<double>(false_positives) / static_cast<double>(missing);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const BloomFilterStatistics& stats) {
+  writer["items"] = stats.items;
+  writer["checks"] = stats.checks;
+  writer["negatives"] = stats.negatives;
+  writer["false-positives"] = stats.false_positives;
+  writer["false-positive-rate"] = stats.GetFalsePositiveRate();
+}
+
+BloomFilter::BloomFilter(std::size_t expected_items,
+                         double false_positive_rate) {
+  UINVARIANT(false_positive_rate > 0 && false_positive_rate < 1,
+             "Bloom filter false positive rate must be in (0, 1)");
+
+  const auto ln2 = std::log(2.0);
+  const auto bits_per_item = -std::log(false_positive_rate) / (ln2 * ln2);
+  hashes_ = std::clamp(static_cast<unsigned>(std::lround(bits_per_item * ln2)),
+                       1u, kMaxHashes);
+
+  const auto bits = static_cast<std::size_t>(std::ceil(
+      bits_per_item * static_cast<double>(std::max<std::size_t>(
+                          expected_items, 1))));
+  const auto blocks = RoundUpToPowerOf2((bits + kBlockBits - 1) / kBlockBits);
+  blocks_mask_ = blocks - 1;
+
+  words_ = std::make_unique<Word[]>(blocks * kBlockWords);
+  for (std::size_t i = 0; i < blocks * kBlockWords; ++i) {
+    words_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void BloomFilter::Add(std::size_t hash) noexcept {
+  ForEachBit(hash, blocks_mask_, hashes_,
+             [this](std::size_t word, std::uint64_t mask) {
+               words_[word].fetch_or(mask, std::memory_order_relaxed);
+             });
+  items_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool BloomFilter::MayContain(std::size_t hash) const noexcept {
+  bool result = true;
+  ForEachBit(hash, blocks_mask_, hashes_,
+             [this, &result](std::size_t word, std::uint64_t mask) {
+               if (!(words_[word].load(std::memory_order_relaxed) & mask)) {
+                 result = false;
+               }
+             });
+
+  checks_.fetch_add(1, std::memory_order_relaxed);
+  if (!result) negatives_.fetch_add(1, std::memory_order_relaxed);
+  return result;
+}
+
+void BloomFilter::AccountFalsePositive() noexcept {
+  false_positives_.fetch_add(1, std::memory_order_relaxed);
+}
+
+BloomFilterStatistics BloomFilter::GetStatistics() const noexcept {
+  return {
+      items_.load(std::memory_order_relaxed),
+      checks_.load(std::memory_order_relaxed),
+      negatives_.load(std::memory_order_relaxed),
+      false_positives_.load(std::memory_order_relaxed),
+  };
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#include <userver/cache/bloom_filter.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kItems = 10000;
+
+std::size_t Hash(std::size_t key) { return std::hash<std::size_t>{}(key); }
+
+}  // namespace
+
+TEST(BloomFilter, Sample) {
+  const std::unordered_map<std::string, int> storage{{"a", 1}, {"b", 2}};
+
+  /// [Sample BloomFilter]
+  cache::BloomFilter filter{storage.size()};
+  for (const auto& [key, value] : storage) {
+    filter.Add(std::hash<std::string>{}(key));
+  }
+
+  const auto lookup = [&](const std::string& key) -> std::optional<int> {
+    if (!filter.MayContain(std::hash<std::string>{}(key))) return {};
+
+    const auto it = storage.find(key);
+    if (it == storage.end()) {
+      filter.AccountFalsePositive();
+      return {};
+    }
+    return it->second;
+  };
+  /// [Sample BloomFilter]
+
+  EXPECT_EQ(lookup("a"), 1);
+  EXPECT_EQ(lookup("b"), 2);
+  EXPECT_EQ(lookup("c"), std::nullopt);
+}
+
+TEST(BloomFilter, NoFalseNegatives) {
+  cache::BloomFilter filter{kItems};
+  for (std::size_t i = 0; i < kItems; ++i) filter.Add(Hash(i));
+
+  for (std::size_t i = 0; i < kItems; ++i) {
+    EXPECT_TRUE(filter.MayContain(Hash(i))) << i;
+  }
+
+  const auto stats = filter.GetStatistics();
+  EXPECT_EQ(stats.items, kItems);
+  EXPECT_EQ(stats.checks, kItems);
+  EXPECT_EQ(stats.negatives, 0);
+}
+
+TEST(BloomFilter, FalsePositiveRate) {
+  for (const double rate : {0.01, 0.001}) {
+    cache::BloomFilter filter{kItems, rate};
+    for (std::size_t i = 0; i < kItems; ++i) filter.Add(Hash(i));
+
+    constexpr std::size_t kChecks = 100000;
+    for (std::size_t i = kItems; i < kItems + kChecks; ++i) {
+      if (filter.MayContain(Hash(i))) filter.AccountFalsePositive();
+    }
+
+    const auto stats = filter.GetStatistics();
+    EXPECT_EQ(stats.checks, kChecks);
+    EXPECT_EQ(stats.negatives + stats.false_positives, kChecks);
+    EXPECT_LT(stats.GetFalsePositiveRate(), rate * 2) << rate;
+  }
+}
+
+TEST(BloomFilter, Empty) {
+  const cache::BloomFilter filter{0};
+  EXPECT_FALSE(filter.MayContain(Hash(1)));
+  EXPECT_DOUBLE_EQ(filter.GetStatistics().GetFalsePositiveRate(), 0);
+}
+
+USERVER_NAMESPACE_END
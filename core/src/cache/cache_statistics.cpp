@@ -1,5 +1,8 @@
 #include <userver/cache/cache_statistics.hpp>
 
+#include <algorithm>
+#include <string>
+
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/statistics/metadata.hpp>
@@ -15,6 +18,8 @@ constexpr const char* kStatisticsNameIncremental = "incremental";
 constexpr const char* kStatisticsNameAny = "any";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameFullUpdatePartitions =
+    "full-update-partitions";
 
 template <typename Clock, typename Duration>
 std::int64_t TimeStampToMillisecondsFromNow(
@@ -77,6 +82,23 @@ formats::json::Value Serialize(const UpdateStatistics& stats,
   return result.ExtractValue();
 }
 
+formats::json::Value Serialize(const PartitionStatistics& stats,
+                               formats::serialize::To<formats::json::Value>) {
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+
+  const auto count =
+      std::min(stats.last_partition_count.load(), kMaxPartitionStatistics);
+  for (std::size_t i = 0; i < count; ++i) {
+    formats::json::ValueBuilder partition(formats::json::Type::kObject);
+    partition["last-update-duration-ms"] =
+        stats.last_update_durations[i].load().count();
+    result[std::to_string(i)] = partition.ExtractValue();
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(result, "cache_partition");
+
+  return result.ExtractValue();
+}
+
 formats::json::Value Serialize(const Statistics& stats,
                                formats::serialize::To<formats::json::Value>) {
   const auto& full = stats.full_update;
@@ -93,6 +115,11 @@ formats::json::Value Serialize(const Statistics& stats,
   builder[cache::kStatisticsNameCurrentDocumentsCount] =
       stats.documents_current_count.load();
 
+  if (stats.full_update_partitions.last_partition_count.load() != 0) {
+    builder[cache::kStatisticsNameFullUpdatePartitions] =
+        stats.full_update_partitions;
+  }
+
   return builder.ExtractValue();
 }
 
@@ -137,6 +164,20 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(size_t add) {
   update_stats_.documents_parse_failures += add;
 }
 
+void UpdateStatisticsScope::StartPartitions(std::size_t partition_count) {
+  auto& partitions = stats_.full_update_partitions;
+  partitions.last_partition_count = partition_count;
+  for (auto& duration : partitions.last_update_durations) {
+    duration = std::chrono::milliseconds{0};
+  }
+}
+
+void UpdateStatisticsScope::FinishPartition(
+    std::size_t partition, std::chrono::milliseconds duration) {
+  if (partition >= impl::kMaxPartitionStatistics) return;
+  stats_.full_update_partitions.last_update_durations[partition] = duration;
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -23,12 +23,21 @@ void CacheUpdateTrait::Update(UpdateType update_type) {
   impl_->Update(update_type);
 }
 
+void CacheUpdateTrait::InvalidateAsync(UpdateType update_type) {
+  impl_->InvalidateAsync(update_type);
+}
+
 const std::string& CacheUpdateTrait::Name() const { return impl_->Name(); }
 
 AllowedUpdateTypes CacheUpdateTrait::GetAllowedUpdateTypes() const {
   return impl_->GetAllowedUpdateTypes();
 }
 
+void CacheUpdateTrait::SetUpdateLeaderElection(
+    std::shared_ptr<dist_lock::DistLockStrategyBase> strategy) {
+  impl_->SetUpdateLeaderElection(std::move(strategy));
+}
+
 void CacheUpdateTrait::StartPeriodicUpdates(utils::Flags<Flag> flags) {
   impl_->StartPeriodicUpdates(flags);
 }
@@ -41,6 +50,10 @@ void CacheUpdateTrait::AssertPeriodicUpdateStarted() {
 
 void CacheUpdateTrait::OnCacheModified() { impl_->OnCacheModified(); }
 
+void CacheUpdateTrait::SetDumpDelta(dump::DeltaWriter write_delta) {
+  impl_->SetDumpDelta(std::move(write_delta));
+}
+
 rcu::ReadablePtr<Config> CacheUpdateTrait::GetConfig() const {
   return impl_->GetConfig();
 }
@@ -57,6 +70,10 @@ void CacheUpdateTrait::ReadAndSet(dump::Reader&) {
   dump::ThrowDumpUnimplemented(Name());
 }
 
+void CacheUpdateTrait::ReadAndApplyDelta(dump::Reader&) {
+  dump::ThrowDumpUnimplemented(Name());
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
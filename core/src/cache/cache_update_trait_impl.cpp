@@ -3,6 +3,7 @@
 #include <userver/components/component.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/testsuite/cache_control.hpp>
@@ -49,6 +50,11 @@ void CacheUpdateTrait::Impl::Update(UpdateType update_type) {
   }).Get();
 }
 
+void CacheUpdateTrait::Impl::InvalidateAsync(UpdateType update_type) {
+  if (update_type == UpdateType::kFull) full_update_requested_ = true;
+  update_task_.ForceStepAsync();
+}
+
 const std::string& CacheUpdateTrait::Impl::Name() const { return name_; }
 
 CacheUpdateTrait::Impl::Impl(CacheDependencies&& dependencies,
@@ -101,6 +107,19 @@ AllowedUpdateTypes CacheUpdateTrait::Impl::GetAllowedUpdateTypes() const {
   return config->allowed_update_types;
 }
 
+void CacheUpdateTrait::Impl::SetUpdateLeaderElection(
+    std::shared_ptr<dist_lock::DistLockStrategyBase> strategy) {
+  UINVARIANT(!is_running_.load(),
+             "SetUpdateLeaderElection() must be called before "
+             "StartPeriodicUpdates(), cache '" +
+                 name_ + "'");
+  UINVARIANT(dumper_, "Cache '" + name_ +
+                          "' must have dumps enabled to share its updates");
+  leader_worker_ = std::make_unique<dist_lock::DistLockedWorker>(
+      "update-leader/" + name_, [this] { HoldUpdateLeadership(); },
+      std::move(strategy), dist_lock::DistLockSettings{}, &task_processor_);
+}
+
 void CacheUpdateTrait::Impl::StartPeriodicUpdates(
     utils::Flags<CacheUpdateTrait::Flag> flags) {
   if (is_running_.exchange(true)) {
@@ -119,12 +138,18 @@ void CacheUpdateTrait::Impl::StartPeriodicUpdates(
     const auto dump_time = dumper_ ? dumper_->ReadDump() : std::nullopt;
     if (dump_time) {
       last_update_ = *dump_time;
+      // the contents match the dump, the next update may be dumped as a delta
+      cache_modified_ = false;
       forced_update_type_ = config->first_update_type == FirstUpdateType::kFull
                                 ? UpdateType::kFull
                                 : UpdateType::kIncremental;
     }
 
+    // the leader keeps the shared dumps up to date
+    const bool is_loaded_from_leader = dump_time && leader_worker_;
+
     if ((!dump_time || config->first_update_mode != FirstUpdateMode::kSkip) &&
+        !is_loaded_from_leader &&
         (!(flags & CacheUpdateTrait::Flag::kNoFirstUpdate) ||
          !periodic_update_enabled_)) {
       // ignore kNoFirstUpdate if !periodic_update_enabled_
@@ -162,6 +187,8 @@ void CacheUpdateTrait::Impl::StartPeriodicUpdates(
     }
 
     if (periodic_update_enabled_) {
+      if (leader_worker_) leader_worker_->Start();
+
       update_task_.Start("update-task/" + name_,
                          GetPeriodicTaskSettings(*config),
                          [this] { DoPeriodicUpdate(); });
@@ -198,6 +225,15 @@ void CacheUpdateTrait::Impl::StopPeriodicUpdates() {
                 << ". Reason: " << ex;
   }
 
+  if (leader_worker_) {
+    try {
+      leader_worker_->Stop();
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Exception in update leader election of cache " << name_
+                  << ". Reason: " << ex;
+    }
+  }
+
   try {
     cleanup_task_.Stop();
   } catch (const std::exception& ex) {
@@ -260,6 +296,19 @@ void CacheUpdateTrait::Impl::DoPeriodicUpdate() {
     return;
   }
 
+  if (IsUpdateFollower() &&
+      (!is_first_update || last_update_ != dump::TimePoint{})) {
+    if (const auto dump_time = dumper_->ReadNewerDump(last_update_)) {
+      LOG_INFO() << "Loaded the update of cache " << name_
+                 << " shared by the update leader";
+      last_update_ = *dump_time;
+    }
+    return;
+  }
+
+  if (full_update_requested_.exchange(false)) {
+    forced_update_type_ = UpdateType::kFull;
+  }
   const auto update_type = NextUpdateType(*config);
   try {
     DoUpdate(update_type);
@@ -271,6 +320,19 @@ void CacheUpdateTrait::Impl::DoPeriodicUpdate() {
   }
 }
 
+bool CacheUpdateTrait::Impl::IsUpdateFollower() const {
+  return leader_worker_ && !is_update_leader_.load();
+}
+
+void CacheUpdateTrait::Impl::HoldUpdateLeadership() {
+  LOG_INFO() << "Became the update leader of cache " << name_;
+  is_update_leader_ = true;
+  // the leadership is held until the lock is lost or the updates are stopped
+  engine::InterruptibleSleepUntil(engine::Deadline{});
+  is_update_leader_ = false;
+  LOG_INFO() << "Lost the update leadership of cache " << name_;
+}
+
 void CacheUpdateTrait::Impl::AssertPeriodicUpdateStarted() {
   UASSERT_MSG(is_running_.load(), "Cache " + name_ +
                                       " has been constructed without calling "
@@ -279,6 +341,10 @@ void CacheUpdateTrait::Impl::AssertPeriodicUpdateStarted() {
 
 void CacheUpdateTrait::Impl::OnCacheModified() { cache_modified_ = true; }
 
+void CacheUpdateTrait::Impl::SetDumpDelta(dump::DeltaWriter write_delta) {
+  dump_delta_ = std::move(write_delta);
+}
+
 engine::TaskProcessor& CacheUpdateTrait::Impl::GetCacheTaskProcessor() const {
   return task_processor_;
 }
@@ -292,6 +358,10 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type) {
       update_type == UpdateType::kFull ? "full" : "incremental";
   tracing::Span::CurrentSpan().AddTag("update_type", update_type_str);
 
+  // A modification left by a failed update must be dumped in full
+  const bool modified_before = cache_modified_.load();
+  dump_delta_ = {};
+
   UpdateStatisticsScope stats(statistics_, update_type);
   LOG_INFO() << "Updating cache update_type=" << update_type_str
              << " name=" << name_;
@@ -304,10 +374,17 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type) {
   if (update_type == UpdateType::kFull) {
     last_full_update_ = steady_now;
   }
+  const bool modified = cache_modified_.exchange(false);
+  auto dump_delta = std::exchange(dump_delta_, {});
   if (dumper_) {
-    dumper_->OnUpdateCompleted(now, cache_modified_.exchange(false)
-                                        ? dump::UpdateType::kModified
-                                        : dump::UpdateType::kAlreadyUpToDate);
+    if (modified && dump_delta && !modified_before &&
+        update_type == UpdateType::kIncremental) {
+      dumper_->OnUpdateCompleted(now, std::move(dump_delta));
+    } else {
+      dumper_->OnUpdateCompleted(now, modified
+                                          ? dump::UpdateType::kModified
+                                          : dump::UpdateType::kAlreadyUpToDate);
+    }
   }
 }
 
@@ -334,6 +411,11 @@ void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSet(
   cache_.ReadAndSet(reader);
 }
 
+void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndApplyDelta(
+    dump::Reader& reader) {
+  cache_.ReadAndApplyDelta(reader);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -9,6 +9,7 @@
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/dist_lock/dist_locked_worker.hpp>
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -38,10 +39,15 @@ class CacheUpdateTrait::Impl final {
 
   void Update(UpdateType update_type);
 
+  void InvalidateAsync(UpdateType update_type);
+
   const std::string& Name() const;
 
   AllowedUpdateTypes GetAllowedUpdateTypes() const;
 
+  void SetUpdateLeaderElection(
+      std::shared_ptr<dist_lock::DistLockStrategyBase> strategy);
+
   void StartPeriodicUpdates(utils::Flags<CacheUpdateTrait::Flag> flags = {});
 
   void StopPeriodicUpdates();
@@ -50,6 +56,8 @@ class CacheUpdateTrait::Impl final {
 
   void OnCacheModified();
 
+  void SetDumpDelta(dump::DeltaWriter write_delta);
+
   rcu::ReadablePtr<Config> GetConfig() const;
 
   engine::TaskProcessor& GetCacheTaskProcessor() const;
@@ -59,6 +67,10 @@ class CacheUpdateTrait::Impl final {
 
   void DoPeriodicUpdate();
 
+  bool IsUpdateFollower() const;
+
+  void HoldUpdateLeadership();
+
   // Throws if `Update` throws
   void DoUpdate(UpdateType type);
 
@@ -76,6 +88,8 @@ class CacheUpdateTrait::Impl final {
 
     void ReadAndSet(dump::Reader& reader) override;
 
+    void ReadAndApplyDelta(dump::Reader& reader) override;
+
    private:
     CacheUpdateTrait& cache_;
   };
@@ -91,6 +105,8 @@ class CacheUpdateTrait::Impl final {
   std::atomic<bool> is_running_{false};
   bool first_update_attempted_{false};
   std::atomic<bool> cache_modified_{false};
+  std::atomic<bool> full_update_requested_{false};
+  dump::DeltaWriter dump_delta_;
   utils::PeriodicTask update_task_;
   utils::PeriodicTask cleanup_task_;
   std::optional<UpdateType> forced_update_type_;
@@ -100,6 +116,8 @@ class CacheUpdateTrait::Impl final {
   engine::Mutex update_mutex_;
   DumpableEntityProxy dumpable_;
   std::optional<dump::Dumper> dumper_;
+  std::unique_ptr<dist_lock::DistLockedWorker> leader_worker_;
+  std::atomic<bool> is_update_leader_{false};
 
   utils::statistics::Entry statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <boost/filesystem.hpp>
@@ -12,10 +13,13 @@
 #include <userver/cache/cache_config.hpp>
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/dist_lock/dist_lock_strategy.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/formats/yaml/value_builder.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -43,15 +47,19 @@ class FakeCache final : public cache::CacheMockBase {
 
   cache::UpdateType LastUpdateType() const { return last_update_type_; }
 
+  std::size_t UpdatesCount() const { return updates_count_; }
+
  private:
   void Update(cache::UpdateType type,
               const std::chrono::system_clock::time_point&,
               const std::chrono::system_clock::time_point&,
               cache::UpdateStatisticsScope&) override {
     last_update_type_ = type;
+    ++updates_count_;
   }
 
   cache::UpdateType last_update_type_{cache::UpdateType::kIncremental};
+  std::size_t updates_count_{0};
 };
 
 const std::string kFakeCacheConfig = R"(
@@ -73,6 +81,79 @@ UTEST(CacheUpdateTrait, FirstIsFull) {
   EXPECT_EQ(cache::UpdateType::kFull, test_cache.LastUpdateType());
 }
 
+namespace {
+
+class PartitionedCache final : public cache::CacheMockBase {
+ public:
+  static constexpr auto kName = "partitioned-cache";
+  static constexpr std::size_t kPartitionCount = 4;
+
+  PartitionedCache(const yaml_config::YamlConfig& config,
+                   cache::MockEnvironment& environment)
+      : CacheMockBase(kName, config, environment) {
+    StartPeriodicUpdates();
+  }
+
+  ~PartitionedCache() final { StopPeriodicUpdates(); }
+
+  const std::vector<int>& GetData() const { return data_; }
+
+ private:
+  void Update(cache::UpdateType, const std::chrono::system_clock::time_point&,
+              const std::chrono::system_clock::time_point&,
+              cache::UpdateStatisticsScope& stats_scope) override {
+    data_ = RunPartitionedUpdate(
+        kPartitionCount, stats_scope,
+        [](std::size_t partition, cache::UpdateStatisticsScope& stats_scope) {
+          engine::Yield();
+          stats_scope.IncreaseDocumentsReadCount(2);
+          const auto first = static_cast<int>(partition) * 2;
+          return std::vector<int>{first, first + 1};
+        },
+        [](std::vector<std::vector<int>>&& parts) {
+          std::vector<int> result;
+          for (const auto& part : parts) {
+            result.insert(result.end(), part.begin(), part.end());
+          }
+          return result;
+        });
+    stats_scope.Finish(data_.size());
+  }
+
+  std::vector<int> data_;
+};
+
+}  // namespace
+
+UTEST_MT(CacheUpdateTrait, PartitionedUpdate, 4) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString(kFakeCacheConfig), {}};
+  cache::MockEnvironment environment;
+
+  PartitionedCache test_cache(config, environment);
+
+  EXPECT_EQ(test_cache.GetData(), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+UTEST(CacheUpdateTrait, PartitionStatistics) {
+  cache::impl::Statistics stats;
+  {
+    cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kFull);
+    scope.StartPartitions(2);
+    scope.FinishPartition(0, std::chrono::milliseconds{10});
+    scope.FinishPartition(1, std::chrono::milliseconds{20});
+    scope.FinishPartition(cache::impl::kMaxPartitionStatistics,
+                          std::chrono::milliseconds{30});
+    scope.Finish(0);
+  }
+
+  const auto json = formats::json::ValueBuilder{stats}.ExtractValue();
+  const auto& partitions = json["full-update-partitions"];
+  EXPECT_EQ(partitions["0"]["last-update-duration-ms"].As<int>(), 10);
+  EXPECT_EQ(partitions["1"]["last-update-duration-ms"].As<int>(), 20);
+  EXPECT_FALSE(partitions.HasMember("2"));
+}
+
 using cache::AllowedUpdateTypes;
 using cache::FirstUpdateMode;
 using cache::FirstUpdateType;
@@ -563,6 +644,154 @@ UTEST(CacheUpdateTrait, WriteDumps) {
 
 namespace {
 
+class SharedUpdatesCache final : public cache::CacheMockBase {
+ public:
+  static constexpr auto kName = "shared-updates-cache";
+
+  SharedUpdatesCache(const yaml_config::YamlConfig& config,
+                     cache::MockEnvironment& environment,
+                     cache::DataSourceMock<std::uint64_t>& data_source,
+                     std::shared_ptr<dist_lock::DistLockStrategyBase> strategy)
+      : cache::CacheMockBase(kName, config, environment),
+        data_source_(data_source) {
+    SetUpdateLeaderElection(std::move(strategy));
+    StartPeriodicUpdates();
+  }
+
+  ~SharedUpdatesCache() final { StopPeriodicUpdates(); }
+
+  std::uint64_t Get() const { return value_; }
+
+ private:
+  void Update(cache::UpdateType, const std::chrono::system_clock::time_point&,
+              const std::chrono::system_clock::time_point&,
+              cache::UpdateStatisticsScope&) override {
+    const auto new_value = data_source_.Fetch();
+    if (value_ == new_value) return;
+    value_ = new_value;
+    OnCacheModified();
+  }
+
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(value_.load());
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    value_ = reader.Read<std::uint64_t>();
+  }
+
+  std::atomic<std::uint64_t> value_{0};
+  cache::DataSourceMock<std::uint64_t>& data_source_;
+};
+
+class SingleLeaderStrategy final : public dist_lock::DistLockStrategyBase {
+ public:
+  void Acquire(std::chrono::milliseconds,
+               const std::string& locker_id) override {
+    auto locked_by = locked_by_.Lock();
+    if (!locked_by->empty() && *locked_by != locker_id) {
+      throw dist_lock::LockIsAcquiredByAnotherHostException();
+    }
+    *locked_by = locker_id;
+  }
+
+  void Release(const std::string& locker_id) override {
+    auto locked_by = locked_by_.Lock();
+    if (*locked_by == locker_id) locked_by->clear();
+  }
+
+  bool IsLocked() {
+    auto locked_by = locked_by_.Lock();
+    return !locked_by->empty();
+  }
+
+ private:
+  concurrent::Variable<std::string> locked_by_;
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!predicate()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  return true;
+}
+
+constexpr std::string_view kSharedUpdatesConfig = R"(
+update-types: only-full
+update-interval: 10ms
+dump:
+    enable: true
+    world-readable: true
+    format-version: 0
+    first-update-mode: skip
+    max-age:  # unlimited
+    max-count: 2
+)";
+
+}  // namespace
+
+UTEST(CacheUpdateTrait, SharedUpdates) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString(std::string{kSharedUpdatesConfig}), {}};
+  cache::MockEnvironment leader_env{
+      testsuite::CacheControl::PeriodicUpdatesMode::kEnabled};
+  cache::MockEnvironment follower_env{
+      testsuite::CacheControl::PeriodicUpdatesMode::kEnabled};
+
+  // the instances share the directory of the dumps
+  const auto shared_dir =
+      boost::filesystem::path{leader_env.dump_root.GetPath()} /
+      SharedUpdatesCache::kName;
+  boost::filesystem::create_directories(shared_dir);
+  boost::filesystem::create_directory_symlink(
+      shared_dir, boost::filesystem::path{follower_env.dump_root.GetPath()} /
+                      SharedUpdatesCache::kName);
+
+  const auto strategy = std::make_shared<SingleLeaderStrategy>();
+  cache::DataSourceMock<std::uint64_t> leader_source(5);
+  cache::DataSourceMock<std::uint64_t> follower_source(1);
+
+  SharedUpdatesCache leader(config, leader_env, leader_source, strategy);
+  ASSERT_TRUE(WaitFor([&] { return strategy->IsLocked(); }));
+  leader_env.dump_control.WriteCacheDumps({leader.Name()});
+
+  SharedUpdatesCache follower(config, follower_env, follower_source, strategy);
+  EXPECT_EQ(follower.Get(), 5);
+
+  leader_source.Set(10);
+  leader_env.cache_control.InvalidateCaches(cache::UpdateType::kFull,
+                                            {leader.Name()});
+  leader_env.dump_control.WriteCacheDumps({leader.Name()});
+  ASSERT_TRUE(WaitFor([&] { return follower.Get() == 10; }));
+
+  // the follower has never hit the data source
+  EXPECT_EQ(follower_source.GetFetchCallsCount(), 0);
+}
+
+UTEST(CacheUpdateTrait, InvalidateAsync) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString(kFakeCacheConfig), {}};
+  cache::MockEnvironment environment{
+      testsuite::CacheControl::PeriodicUpdatesMode::kEnabled};
+
+  FakeCache test_cache(config, environment);
+  ASSERT_EQ(test_cache.UpdatesCount(), 1);
+
+  test_cache.InvalidateAsync(cache::UpdateType::kIncremental);
+  ASSERT_TRUE(WaitFor([&] { return test_cache.UpdatesCount() == 2; }));
+  EXPECT_EQ(test_cache.LastUpdateType(), cache::UpdateType::kIncremental);
+
+  test_cache.InvalidateAsync(cache::UpdateType::kFull);
+  ASSERT_TRUE(WaitFor([&] { return test_cache.UpdatesCount() == 3; }));
+  EXPECT_EQ(test_cache.LastUpdateType(), cache::UpdateType::kFull);
+}
+
+namespace {
+
 class FaultyDumpedCache final : public cache::CacheMockBase {
  public:
   static constexpr auto kName = "faulty-dumped-cache";
@@ -89,6 +89,29 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: Whether to map the dump into memory instead of reading it, ignored for encrypted and compressed dumps
+                defaultDescription: false
+            compressed:
+                type: boolean
+                description: Whether to write the dump as chunks compressed in parallel, ignored for encrypted dumps
+                defaultDescription: false
+            peers:
+                type: array
+                description: URLs of handler-cache-dumps of the other instances to download the dump from at start if there is no local one
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: URL of handler-cache-dumps
+            peers-timeout:
+                type: string
+                description: Timeout of a dump download from a peer
+                defaultDescription: 1m
+            max-delta-count:
+                type: integer
+                description: Max count of delta dumps written on top of a full dump before the next full dump, 0 disables delta dumps
+                defaultDescription: 0
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
@@ -1,9 +1,13 @@
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -295,6 +299,97 @@ UTEST(ExpirableLruCache, InvalidateByKey) {
   EXPECT_EQ(Counter::One(), *counter);
 }
 
+UTEST(ExpirableLruCache, AdmissionRejection) {
+  SimpleCache cache(1, 10);
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kTinyLfu);
+
+  for (int i = 0; i < 10; ++i) {
+    const auto key = std::to_string(i);
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(i, cache.Get(key, [i](const SimpleCacheKey&) { return i; }));
+    }
+  }
+  EXPECT_EQ(0, cache.GetStatistics().total.admission_rejections.load());
+
+  for (int i = 100; i < 110; ++i) {
+    cache.Put(std::to_string(i), i);
+  }
+  EXPECT_LT(0, cache.GetStatistics().total.admission_rejections.load());
+  EXPECT_EQ(10, cache.GetSizeApproximate());
+}
+
+UTEST(ExpirableLruCache, Weighted) {
+  SimpleCache cache(1, 100);
+  EXPECT_FALSE(cache.IsWeightBounded());
+
+  cache.SetWeigher([](const SimpleCacheKey& key, SimpleCacheValue) {
+    return key.size();
+  });
+  cache.SetWayMaxWeight(10);
+  EXPECT_TRUE(cache.IsWeightBounded());
+
+  cache.Put("12345", 1);
+  cache.Put("abcde", 2);
+  EXPECT_EQ(10, cache.GetWeightApproximate());
+
+  cache.Put("z", 3);
+  EXPECT_EQ(6, cache.GetWeightApproximate());
+  EXPECT_EQ(2, cache.GetSizeApproximate());
+  EXPECT_FALSE(cache.GetOptionalNoUpdate("12345").has_value());
+
+  cache.SetWayMaxWeight(0);
+  EXPECT_FALSE(cache.IsWeightBounded());
+  EXPECT_EQ(0, cache.GetWeightApproximate());
+}
+
+UTEST(ExpirableLruCache, CoalescedMisses) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  std::atomic<int> updates{0};
+  engine::SingleConsumerEvent release;
+  auto update = [&](const SimpleCacheKey&) {
+    ++updates;
+    EXPECT_TRUE(release.WaitForEvent());
+    return 1;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get(key, update); }));
+  }
+  EngineYield();
+  release.Send();
+
+  for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+  EXPECT_EQ(1, updates.load());
+  EXPECT_EQ(9, cache.GetStatistics().total.coalesced_loads.load());
+}
+
+UTEST(ExpirableLruCache, CoalescedFailure) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  std::atomic<int> updates{0};
+  engine::SingleConsumerEvent release;
+  auto update = [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    ++updates;
+    EXPECT_TRUE(release.WaitForEvent());
+    throw std::runtime_error("backend is down");
+  };
+
+  auto first = engine::AsyncNoSpan([&] { return cache.Get(key, update); });
+  auto second = engine::AsyncNoSpan([&] { return cache.Get(key, update); });
+  EngineYield();
+  release.Send();
+
+  // the waiters do not retry the failed update one after another
+  UEXPECT_THROW(first.Get(), std::runtime_error);
+  UEXPECT_THROW(second.Get(), std::runtime_error);
+  EXPECT_EQ(1, updates.load());
+}
+
 UTEST(ExpirableLruCache, BackgroundUpdate) {
   auto counter = std::make_shared<Counter>();
 
@@ -0,0 +1,97 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <algorithm>
+#include <array>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kDepth = 4;
+constexpr std::uint64_t kMaxCounter = 15;
+constexpr std::uint64_t kResetMask = 0x7777777777777777ULL;
+constexpr std::size_t kSampleSizeFactor = 10;
+
+constexpr std::array<std::uint64_t, kDepth> kSeeds{
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+
+// splitmix64 finalizer, spreads poor std::hash values (e.g. identity for ints)
+std::uint64_t Mix(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+struct CounterPosition {
+  std::size_t word;
+  unsigned shift;
+};
+
+CounterPosition GetPosition(std::uint64_t hash, std::size_t row,
+                            std::size_t mask) noexcept {
+  const auto h = Mix(hash + kSeeds[row]);
+  // 16 counters per word, 4 bits each
+  return {static_cast<std::size_t>(h) & mask,
+          static_cast<unsigned>((h >> 60) << 2)};
+}
+
+std::size_t RoundUpToPowerOf2(std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(std::size_t capacity) { Resize(capacity); }
+
+void FrequencySketch::Resize(std::size_t capacity) {
+  capacity = std::max<std::size_t>(capacity, 1);
+  table_.assign(RoundUpToPowerOf2(capacity), 0);
+  sample_size_ = capacity * kSampleSizeFactor;
+  additions_ = 0;
+}
+
+void FrequencySketch::Record(std::size_t hash) noexcept {
+  const auto mask = table_.size() - 1;
+  bool added = false;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    const auto [word, shift] = GetPosition(hash, row, mask);
+    if (((table_[word] >> shift) & kMaxCounter) != kMaxCounter) {
+      table_[word] += std::uint64_t{1} << shift;
+      added = true;
+    }
+  }
+
+  if (added && ++additions_ >= sample_size_) Age();
+}
+
+std::uint32_t FrequencySketch::Estimate(std::size_t hash) const noexcept {
+  const auto mask = table_.size() - 1;
+  auto result = kMaxCounter;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    const auto [word, shift] = GetPosition(hash, row, mask);
+    result = std::min(result, (table_[word] >> shift) & kMaxCounter);
+  }
+  return static_cast<std::uint32_t>(result);
+}
+
+void FrequencySketch::Clear() noexcept {
+  std::fill(table_.begin(), table_.end(), 0);
+  additions_ = 0;
+}
+
+void FrequencySketch::Age() noexcept {
+  for (auto& word : table_) word = (word >> 1) & kResetMask;
+  additions_ /= 2;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
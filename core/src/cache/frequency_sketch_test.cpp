@@ -0,0 +1,44 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch sketch(1000);
+  EXPECT_EQ(sketch.Estimate(42), 0);
+
+  for (int i = 0; i < 5; ++i) sketch.Record(42);
+  EXPECT_GE(sketch.Estimate(42), 5);
+  EXPECT_EQ(sketch.Estimate(43), 0);
+}
+
+TEST(FrequencySketch, Saturates) {
+  cache::impl::FrequencySketch sketch(1000);
+  for (int i = 0; i < 100; ++i) sketch.Record(1);
+  EXPECT_EQ(sketch.Estimate(1), 15);
+}
+
+TEST(FrequencySketch, Ages) {
+  constexpr std::size_t kCapacity = 16;
+  cache::impl::FrequencySketch sketch(kCapacity);
+  for (int i = 0; i < 15; ++i) sketch.Record(1);
+  EXPECT_EQ(sketch.Estimate(1), 15);
+
+  // Distinct hashes fill the sample and trigger halving of all counters
+  for (std::size_t i = 100; i < 100 + kCapacity * 10; ++i) sketch.Record(i);
+  EXPECT_LE(sketch.Estimate(1), 8);
+}
+
+TEST(FrequencySketch, Clear) {
+  cache::impl::FrequencySketch sketch(10);
+  sketch.Record(7);
+  sketch.Clear();
+  EXPECT_EQ(sketch.Estimate(7), 0);
+
+  sketch.Record(7);
+  sketch.Resize(100);
+  EXPECT_EQ(sketch.Estimate(7), 0);
+}
+
+USERVER_NAMESPACE_END
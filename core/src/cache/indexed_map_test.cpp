@@ -0,0 +1,129 @@
+#include <userver/cache/indexed_map.hpp>
+
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+/// [Sample IndexedMap declaration]
+struct User {
+  std::string city;
+  int age{0};
+};
+
+struct ByCity {
+  const std::string& operator()(const User& user) const { return user.city; }
+};
+
+struct ByAge {
+  int operator()(const User& user) const { return user.age; }
+};
+
+using Users =
+    cache::IndexedMap<int, User, cache::HashIndex<ByCity>,
+                      cache::OrderedIndex<ByAge>>;
+/// [Sample IndexedMap declaration]
+
+template <typename Group>
+std::set<int> Keys(const Group* group) {
+  std::set<int> result;
+  if (!group) return result;
+  for (const auto& [key, value] : *group) result.insert(key);
+  return result;
+}
+
+User Read(dump::Reader& reader, dump::To<User>) {
+  auto city = reader.Read<std::string>();
+  return {std::move(city), reader.Read<int>()};
+}
+
+void Write(dump::Writer& writer, const User& user) {
+  writer.Write(user.city);
+  writer.Write(user.age);
+}
+
+}  // namespace
+
+TEST(IndexedMap, Sample) {
+  /// [Sample IndexedMap]
+  Users snapshot;
+  snapshot.Set(1, {"Moscow", 30});
+  snapshot.Set(2, {"Moscow", 40});
+
+  // incremental update of a copy, the indexes follow the items
+  auto updated = snapshot;
+  updated.Set(2, {"Paris", 40});
+  updated.Set(3, {"Paris", 20});
+
+  EXPECT_EQ(snapshot.Find<ByCity>("Moscow")->size(), 2);
+  EXPECT_EQ(snapshot.Find<ByCity>("Paris"), nullptr);
+  EXPECT_EQ(updated.Find<ByCity>("Moscow")->size(), 1);
+  EXPECT_EQ(updated.Find<ByCity>("Paris")->size(), 2);
+
+  const auto& by_age = updated.GetGroups<ByAge>();
+  EXPECT_EQ(by_age.begin()->first, 20);
+  EXPECT_EQ(by_age.lower_bound(35)->first, 40);
+  /// [Sample IndexedMap]
+}
+
+TEST(IndexedMap, SetErase) {
+  Users users;
+  EXPECT_TRUE(users.empty());
+  EXPECT_FALSE(users.Erase(1));
+
+  users.Set(1, {"Moscow", 30});
+  users.Set(2, {"Moscow", 30});
+  users.Set(3, {"Paris", 30});
+  EXPECT_EQ(users.size(), 3);
+  EXPECT_EQ(users.Get(1)->city, "Moscow");
+  EXPECT_EQ(users.Get(4), nullptr);
+  EXPECT_EQ(Keys(users.Find<ByCity>("Moscow")), (std::set<int>{1, 2}));
+  EXPECT_EQ(Keys(users.Find<ByAge>(30)), (std::set<int>{1, 2, 3}));
+
+  users.Set(1, {"Paris", 25});
+  EXPECT_EQ(Keys(users.Find<ByCity>("Moscow")), (std::set<int>{2}));
+  EXPECT_EQ(Keys(users.Find<ByCity>("Paris")), (std::set<int>{1, 3}));
+  EXPECT_EQ(Keys(users.Find<ByAge>(25)), (std::set<int>{1}));
+
+  EXPECT_TRUE(users.Erase(2));
+  EXPECT_EQ(users.Find<ByCity>("Moscow"), nullptr);
+  EXPECT_EQ(users.GetGroups<ByCity>().size(), 1);
+  EXPECT_EQ(users.GetGroups<ByAge>().size(), 2);
+
+  users.Clear();
+  EXPECT_TRUE(users.empty());
+  EXPECT_TRUE(users.GetGroups<ByCity>().empty());
+  EXPECT_TRUE(users.GetGroups<ByAge>().empty());
+}
+
+TEST(IndexedMap, SharesValues) {
+  Users users;
+  users.Set(1, {"Moscow", 30});
+  const auto copy = users;
+
+  const auto value = users.GetShared(1);
+  EXPECT_EQ(value, copy.GetShared(1));
+  EXPECT_EQ(value, *users.Find<ByCity>("Moscow")->Get(1));
+  EXPECT_EQ(value, *users.Find<ByAge>(30)->Get(1));
+}
+
+TEST(IndexedMap, Dump) {
+  Users users;
+  users.Set(1, {"Moscow", 30});
+  users.Set(2, {"Paris", 40});
+
+  const auto restored = dump::FromBinary<Users>(dump::ToBinary(users));
+  EXPECT_EQ(restored.size(), 2);
+  EXPECT_EQ(restored.Get(2)->city, "Paris");
+  EXPECT_EQ(Keys(restored.Find<ByCity>("Moscow")), (std::set<int>{1}));
+  EXPECT_EQ(Keys(restored.Find<ByAge>(40)), (std::set<int>{2}));
+}
+
+USERVER_NAMESPACE_END
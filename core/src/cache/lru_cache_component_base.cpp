@@ -20,21 +20,30 @@ constexpr const char* kStatisticsNameMisses = "misses";
 constexpr const char* kStatisticsNameStale = "stale";
 constexpr const char* kStatisticsNameBackground = "background-updates";
 constexpr const char* kStatisticsNameHitRatio = "hit_ratio";
+constexpr const char* kStatisticsNameAdmissionRejections =
+    "admission-rejections";
+constexpr const char* kStatisticsNameCoalescedLoads = "coalesced-loads";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameBytesUsed = "bytes-used";
 
 }  // namespace
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size) {
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::optional<std::size_t> bytes_used) {
   formats::json::ValueBuilder builder;
   utils::statistics::SolomonLabelValue(builder, "cache_name");
 
   builder[kStatisticsNameCurrentDocumentsCount] = size;
+  if (bytes_used) builder[kStatisticsNameBytesUsed] = *bytes_used;
   builder[kStatisticsNameHits] = stats.total.hits.load();
   builder[kStatisticsNameMisses] = stats.total.misses.load();
   builder[kStatisticsNameStale] = stats.total.stale.load();
   builder[kStatisticsNameBackground] = stats.total.background_updates.load();
+  builder[kStatisticsNameAdmissionRejections] =
+      stats.total.admission_rejections.load();
+  builder[kStatisticsNameCoalescedLoads] = stats.total.coalesced_loads.load();
 
   auto s1min = stats.recent.GetStatsForPeriod();
   double s1min_hits = s1min.hits.load();
@@ -84,6 +93,10 @@ properties:
     size:
         type: integer
         description: max amount of items to store in cache
+    size-bytes:
+        type: integer
+        description: max total size of the items to store in cache, 0 for no limit
+        defaultDescription: 0
     ways:
         type: integer
         description: number of ways for associative cache
@@ -95,6 +108,13 @@ properties:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    admission-policy:
+        type: string
+        description: policy for admitting new items into a full cache
+        defaultDescription: none
+        enum:
+          - none
+          - tinylfu
 )");
 }
 
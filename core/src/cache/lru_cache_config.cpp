@@ -2,10 +2,13 @@
 
 #include <stdexcept>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -15,20 +18,50 @@ namespace {
 
 constexpr std::string_view kWays = "ways";
 constexpr std::string_view kSize = "size";
+constexpr std::string_view kSizeBytes = "size-bytes";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kAdmissionPolicy = "admission-policy";
+
+constexpr std::string_view kAdmissionPolicyNone = "none";
+constexpr std::string_view kAdmissionPolicyTinyLfu = "tinylfu";
+
+AdmissionPolicy ParseAdmissionPolicy(const std::string& value,
+                                     const std::string& path) {
+  if (value == kAdmissionPolicyNone) return AdmissionPolicy::kNone;
+  if (value == kAdmissionPolicyTinyLfu) return AdmissionPolicy::kTinyLfu;
+  throw std::runtime_error(fmt::format(
+      "Invalid value of '{}': '{}', expected one of: '{}', '{}'", path, value,
+      kAdmissionPolicyNone, kAdmissionPolicyTinyLfu));
+}
 
 }  // namespace
 
+std::string_view ToString(AdmissionPolicy policy) {
+  switch (policy) {
+    case AdmissionPolicy::kNone:
+      return kAdmissionPolicyNone;
+    case AdmissionPolicy::kTinyLfu:
+      return kAdmissionPolicyTinyLfu;
+  }
+
+  UINVARIANT(false, "Unexpected admission policy");
+}
+
 using dump::impl::ParseMs;
 
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
     : size(config[kSize].As<std::size_t>()),
+      size_bytes(config[kSizeBytes].As<std::size_t>(0)),
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      admission_policy(ParseAdmissionPolicy(
+          config[kAdmissionPolicy].As<std::string>(
+              std::string{kAdmissionPolicyNone}),
+          config[kAdmissionPolicy].GetPath())) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -37,10 +70,15 @@ LruCacheConfig::LruCacheConfig(const components::ComponentConfig& config)
 
 LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
     : size(value[kSize].As<std::size_t>()),
+      size_bytes(value[kSizeBytes].As<std::size_t>(0)),
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      admission_policy(ParseAdmissionPolicy(
+          value[kAdmissionPolicy].As<std::string>(
+              std::string{kAdmissionPolicyNone}),
+          value[kAdmissionPolicy].GetPath())) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -49,6 +87,12 @@ std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
   return way_size == 0 ? 1 : way_size;
 }
 
+std::size_t LruCacheConfig::GetWayMaxWeight(std::size_t ways) const {
+  if (size_bytes == 0) return 0;
+  const auto way_max_weight = size_bytes / ways;
+  return way_max_weight == 0 ? 1 : way_max_weight;
+}
+
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>) {
   return LruCacheConfig{value};
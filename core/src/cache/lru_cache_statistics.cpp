@@ -13,13 +13,17 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      admission_rejections(other.admission_rejections.load()),
+      coalesced_loads(other.coalesced_loads.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
   background_updates = 0;
+  admission_rejections = 0;
+  coalesced_loads = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +32,8 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   misses += other.misses.load();
   stale += other.stale.load();
   background_updates += other.background_updates.load();
+  admission_rejections += other.admission_rejections.load();
+  coalesced_loads += other.coalesced_loads.load();
   return *this;
 }
 
@@ -49,6 +55,18 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheAdmissionRejection(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.admission_rejections;
+  ++stats.recent.GetCurrentCounter().admission_rejections;
+  LOG_TRACE() << "cache admission rejection";
+}
+
+void CacheCoalescedLoad(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.coalesced_loads;
+  ++stats.recent.GetCurrentCounter().coalesced_loads;
+  LOG_TRACE() << "cache load coalesced";
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
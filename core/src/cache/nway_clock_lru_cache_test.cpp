@@ -0,0 +1,154 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/cache/nway_clock_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::NWayClockLRU<int, int>;
+
+UTEST(NWayClockLRU, Ctr) {
+  UEXPECT_NO_THROW(Cache(1, 10));
+  UEXPECT_NO_THROW(Cache(10, 10));
+  UEXPECT_THROW(Cache(0, 10), std::logic_error);
+}
+
+UTEST(NWayClockLRU, Set) {
+  Cache cache(1, 1);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.Put(2, 2);
+
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(NWayClockLRU, Overwrite) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(1, 10);
+
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(10, cache.Get(1));
+  EXPECT_EQ(10, cache.GetOr(1, -1));
+  EXPECT_EQ(-1, cache.GetOr(2, -1));
+}
+
+UTEST(NWayClockLRU, GetExpired) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(2, [](int) { return false; }).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayClockLRU, SetMultipleWays) {
+  Cache cache(2, 1);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.Get(1));
+}
+
+UTEST(NWayClockLRU, ReferencedSurvivesEviction) {
+  Cache cache(1, 3);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+
+  cache.Put(4, 4);
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_EQ(4, cache.Get(4));
+}
+
+UTEST(NWayClockLRU, Invalidate) {
+  Cache cache(2, 4);
+  for (int i = 0; i < 8; ++i) cache.Put(i, i);
+
+  cache.InvalidateByKey(3);
+  EXPECT_FALSE(cache.Get(3).has_value());
+  EXPECT_EQ(7, cache.GetSize());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(3, 3);
+  EXPECT_EQ(3, cache.Get(3));
+}
+
+UTEST(NWayClockLRU, UpdateWaySize) {
+  Cache cache(1, 4);
+  for (int i = 0; i < 4; ++i) cache.Put(i, i);
+
+  cache.UpdateWaySize(2);
+  EXPECT_EQ(2, cache.GetSize());
+
+  cache.UpdateWaySize(3);
+  cache.Put(10, 10);
+  cache.Put(11, 11);
+  EXPECT_EQ(3, cache.GetSize());
+}
+
+UTEST(NWayClockLRU, VisitAll) {
+  Cache cache(3, 10);
+  for (int i = 0; i < 10; ++i) cache.Put(i, i * 2);
+
+  int count = 0;
+  cache.VisitAll([&count](int key, int value) {
+    EXPECT_EQ(key * 2, value);
+    ++count;
+  });
+  EXPECT_EQ(10, count);
+}
+
+UTEST_MT(NWayClockLRU, ConcurrentReadWrite, 4) {
+  constexpr int kKeys = 64;
+  Cache cache(4, kKeys / 8);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int t = 0; t < 4; ++t) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, t] {
+      for (int i = 0; i < 10000; ++i) {
+        const int key = (i * 7 + t) % kKeys;
+        if (i % 4 == 0) {
+          cache.Put(key, key);
+        } else {
+          const auto value = cache.Get(key);
+          if (value) {
+            EXPECT_EQ(key, *value);
+          }
+        }
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), kKeys / 2);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <userver/cache/nway_clock_lru_cache.hpp>
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 64;
+constexpr std::size_t kKeys = kWays * kWaySize;
+
+template <typename Cache>
+void FillCache(Cache& cache) {
+  for (std::size_t i = 0; i < kKeys; ++i) cache.Put(i, i);
+}
+
+}  // namespace
+
+template <typename Cache>
+void nway_lru_get(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    Cache cache(kWays, kWaySize);
+    FillCache(cache);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(i++ % kKeys));
+    }
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_get, cache::NWayLRU<std::size_t, std::size_t>);
+BENCHMARK_TEMPLATE(nway_lru_get,
+                   cache::NWayClockLRU<std::size_t, std::size_t>);
+
+template <typename Cache>
+void nway_lru_put(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    Cache cache(kWays, kWaySize);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+      cache.Put(i % (kKeys * 2), i);
+      ++i;
+    }
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_put, cache::NWayLRU<std::size_t, std::size_t>);
+BENCHMARK_TEMPLATE(nway_lru_put,
+                   cache::NWayClockLRU<std::size_t, std::size_t>);
+
+// Readers hammer a few hot keys, state.range(1) per mille of operations in
+// background tasks are writes
+template <typename Cache>
+void nway_lru_contention(benchmark::State& state) {
+  const auto threads = static_cast<std::size_t>(state.range(0));
+  const auto writes_per_mille = static_cast<std::size_t>(state.range(1));
+
+  engine::RunStandalone(threads, [&] {
+    Cache cache(kWays, kWaySize);
+    FillCache(cache);
+
+    std::atomic<bool> run{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads - 1);
+    for (std::size_t t = 0; t < threads - 1; ++t) {
+      tasks.push_back(engine::AsyncNoSpan([&, t] {
+        std::size_t i = t;
+        while (run) {
+          const auto key = i % kWays;
+          if (i % 1000 < writes_per_mille) {
+            cache.Put(key, i);
+          } else {
+            benchmark::DoNotOptimize(cache.Get(key));
+          }
+          ++i;
+        }
+      }));
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(i++ % kWays));
+    }
+
+    run = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+BENCHMARK_TEMPLATE(nway_lru_contention,
+                   cache::NWayLRU<std::size_t, std::size_t>)
+    ->Ranges({{1, 4}, {0, 10}});
+BENCHMARK_TEMPLATE(nway_lru_contention,
+                   cache::NWayClockLRU<std::size_t, std::size_t>)
+    ->Ranges({{1, 4}, {0, 10}});
+
+USERVER_NAMESPACE_END
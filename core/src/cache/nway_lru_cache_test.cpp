@@ -54,4 +54,112 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, TinyLfuScanResistance) {
+  Cache cache(1, 100);
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kTinyLfu);
+
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(i, cache.Get(i));
+  }
+
+  bool rejected = false;
+  for (int i = 1000; i < 2000; ++i) {
+    EXPECT_FALSE(cache.Get(i).has_value());
+    rejected |= !cache.Put(i, i);
+  }
+  EXPECT_TRUE(rejected);
+  EXPECT_EQ(100, cache.GetSize());
+
+  // Plain LRU would keep none of them. A few cold items may get in due to
+  // collisions in the frequency sketch.
+  int hot_items = 0;
+  for (int i = 0; i < 100; ++i) hot_items += cache.Get(i).has_value();
+  EXPECT_GE(hot_items, 90);
+}
+
+UTEST(NWayLRU, TinyLfuAdmitsFrequent) {
+  Cache cache(1, 100);
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kTinyLfu);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 1000; i < 1010; ++i) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+
+  for (int i = 1000; i < 1010; ++i) EXPECT_EQ(i, cache.Get(i));
+  EXPECT_EQ(100, cache.GetSize());
+}
+
+UTEST(NWayLRU, SwitchAdmissionPolicy) {
+  Cache cache(2, 50);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kTinyLfu);
+  EXPECT_LE(cache.GetSize(), 100);
+  cache.Put(1000, 1000);
+  EXPECT_EQ(1000, cache.Get(1000));
+
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kNone);
+  EXPECT_EQ(1000, cache.Get(1000));
+  EXPECT_LE(cache.GetSize(), 100);
+
+  cache.InvalidateByKey(1000);
+  EXPECT_FALSE(cache.Get(1000).has_value());
+}
+
+UTEST(NWayLRU, Weighted) {
+  // the values are their own weights
+  Cache cache(1, 100);
+  cache.SetWeigher([](int, int value) { return static_cast<size_t>(value); });
+  cache.UpdateWayMaxWeight(10);
+
+  cache.Put(1, 4);
+  cache.Put(2, 4);
+  EXPECT_EQ(8, cache.GetWeight());
+
+  // the least used item goes to make room for the new one
+  cache.Put(3, 4);
+  EXPECT_EQ(8, cache.GetWeight());
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(4, cache.Get(2));
+
+  cache.Put(2, 1);
+  EXPECT_EQ(5, cache.GetWeight());
+
+  // an item heavier than the way is not stored
+  EXPECT_FALSE(cache.Put(4, 11));
+  EXPECT_FALSE(cache.Get(4).has_value());
+  EXPECT_EQ(5, cache.GetWeight());
+
+  cache.InvalidateByKey(3);
+  EXPECT_EQ(1, cache.GetWeight());
+
+  cache.UpdateWayMaxWeight(0);
+  EXPECT_EQ(0, cache.GetWeight());
+  cache.Put(5, 20);
+  EXPECT_EQ(20, cache.Get(5));
+}
+
+UTEST(NWayLRU, WeightedTinyLfu) {
+  Cache cache(1, 100);
+  cache.SetAdmissionPolicy(cache::AdmissionPolicy::kTinyLfu);
+  cache.SetWeigher([](int, int value) { return static_cast<size_t>(value); });
+  cache.UpdateWayMaxWeight(100);
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, 1 + i % 10);
+    EXPECT_LE(cache.GetWeight(), 100);
+  }
+
+  size_t weight = 0;
+  cache.VisitAll([&weight](int, int value) { weight += value; });
+  EXPECT_EQ(weight, cache.GetWeight());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetWeight());
+}
+
 USERVER_NAMESPACE_END
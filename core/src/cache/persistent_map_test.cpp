@@ -0,0 +1,143 @@
+#include <userver/cache/persistent_map.hpp>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentMap<int, std::string>;
+
+struct BadHash {
+  std::size_t operator()(int key) const noexcept { return key % 3; }
+};
+
+template <typename PersistentMap>
+std::unordered_map<int, std::string> ToStd(const PersistentMap& map) {
+  std::unordered_map<int, std::string> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second);
+  }
+  EXPECT_EQ(result.size(), map.size());
+  return result;
+}
+
+}  // namespace
+
+TEST(PersistentMap, Sample) {
+  /// [Sample PersistentMap]
+  cache::PersistentMap<std::string, int> snapshot;
+  snapshot.Set("a", 1);
+  snapshot.Set("b", 2);
+
+  // O(1) copy, e.g. of the current contents of a cache
+  auto updated = snapshot;
+  updated.Set("a", 10);
+  updated.Erase("b");
+
+  EXPECT_EQ(*snapshot.Get("a"), 1);
+  EXPECT_EQ(*snapshot.Get("b"), 2);
+  EXPECT_EQ(*updated.Get("a"), 10);
+  EXPECT_EQ(updated.Get("b"), nullptr);
+  /// [Sample PersistentMap]
+}
+
+TEST(PersistentMap, Empty) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.Get(1), nullptr);
+  EXPECT_FALSE(map.Erase(1));
+}
+
+TEST(PersistentMap, SetGetErase) {
+  Map map;
+  map.Set(1, "1");
+  map.Set(2, "2");
+  map.Set(1, "one");
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.Get(1), "one");
+  EXPECT_EQ(*map.Get(2), "2");
+  EXPECT_FALSE(map.Contains(3));
+
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(map.Get(1), nullptr);
+
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentMap, Collisions) {
+  cache::PersistentMap<int, std::string, BadHash> map;
+  for (int i = 0; i < 30; ++i) map.Set(i, std::to_string(i));
+  EXPECT_EQ(map.size(), 30);
+  EXPECT_EQ(ToStd(map).size(), 30);
+
+  for (int i = 0; i < 30; i += 2) EXPECT_TRUE(map.Erase(i));
+  EXPECT_EQ(map.size(), 15);
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_EQ(map.Contains(i), i % 2 == 1) << i;
+  }
+}
+
+TEST(PersistentMap, SnapshotsAreIndependent) {
+  Map original;
+  for (int i = 0; i < 1000; ++i) original.Set(i, std::to_string(i));
+  const auto expected = ToStd(original);
+
+  auto copy = original;
+  for (int i = 0; i < 1000; i += 3) copy.Erase(i);
+  for (int i = 1000; i < 1100; ++i) copy.Set(i, "new");
+  copy.Set(1, "changed");
+
+  EXPECT_EQ(ToStd(original), expected);
+  EXPECT_EQ(copy.size(), 1000 - 334 + 100);
+  EXPECT_EQ(*copy.Get(1), "changed");
+  EXPECT_EQ(*original.Get(1), "1");
+}
+
+TEST(PersistentMap, MatchesUnorderedMap) {
+  Map map;
+  std::unordered_map<int, std::string> reference;
+  std::minstd_rand rng(42);
+
+  for (int i = 0; i < 20000; ++i) {
+    const int key = rng() % 5000;
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(map.Erase(key), reference.erase(key) == 1);
+    } else {
+      map.Set(key, std::to_string(i));
+      reference[key] = std::to_string(i);
+    }
+  }
+
+  EXPECT_EQ(ToStd(map), reference);
+  for (const auto& [key, value] : reference) {
+    ASSERT_NE(map.Get(key), nullptr);
+    EXPECT_EQ(*map.Get(key), value);
+  }
+
+  for (const auto& [key, value] : reference) EXPECT_TRUE(map.Erase(key));
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMap, Dump) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map.Set(i, std::to_string(i));
+
+  const auto restored = dump::FromBinary<Map>(dump::ToBinary(map));
+  EXPECT_EQ(ToStd(restored), ToStd(map));
+}
+
+USERVER_NAMESPACE_END
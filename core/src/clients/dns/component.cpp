@@ -40,6 +40,12 @@ ResolverConfig ParseResolverConfig(
   config.cache_failure_ttl =
       component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.cache_prefetch_interval =
+      component_config["cache-prefetch-interval"]
+          .As<std::chrono::milliseconds>(config.cache_prefetch_interval);
+  config.cache_prefetch_min_hits =
+      component_config["cache-prefetch-min-hits"].As<size_t>(
+          config.cache_prefetch_min_hits);
   return config;
 }
 
@@ -71,7 +77,15 @@ formats::json::Value Component::ExtendStatistics() {
   json_counters["network-failure"] = counters.network_failure.Load();
   utils::statistics::SolomonChildrenAreLabelValues(json_counters,
                                                    "dns_reply_source");
-  return formats::json::MakeObject("replies", json_counters.ExtractValue());
+
+  const auto& prefetch_counters = GetResolver().GetPrefetchCounters();
+  formats::json::ValueBuilder json_prefetch;
+  json_prefetch["started"] = prefetch_counters.started.Load();
+  json_prefetch["hits"] = prefetch_counters.hits.Load();
+  json_prefetch["misses"] = prefetch_counters.misses.Load();
+
+  return formats::json::MakeObject("replies", json_counters.ExtractValue(),
+                                   "prefetch", json_prefetch.ExtractValue());
 }
 
 yaml_config::Schema Component::GetStaticConfigSchema() {
@@ -122,6 +136,18 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-prefetch-interval:
+        type: string
+        description: |
+            interval of background updates of hot names before their
+            expiration, 0 disables the prefetch
+        defaultDescription: 0
+    cache-prefetch-min-hits:
+        type: integer
+        description: |
+            min number of lookups during the prefetch interval for a name to
+            be considered hot
+        defaultDescription: 1
 )");
 }
 
@@ -2,9 +2,14 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <atomic>
 #include <cctype>
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <clients/dns/file_resolver.hpp>
 #include <clients/dns/helpers.hpp>
@@ -14,10 +19,12 @@
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -146,6 +153,7 @@ class Resolver::Impl {
   ~Impl();
 
   const LookupSourceCounters& GetLookupSourceCounters() const;
+  const PrefetchCounters& GetPrefetchCounters() const;
 
   void ReloadHosts();
   void FlushNetworkCache();
@@ -164,35 +172,55 @@ class Resolver::Impl {
 
   template <typename Mutex>
   void StartBackgroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex,
-                            const std::string& name);
+                            const std::string& name, bool is_prefetch = false);
 
  private:
   struct NetCacheEntry {
     AddrVector addrs;
     std::chrono::steady_clock::time_point expiration;
     bool is_failure{false};
+    bool is_prefetched{false};
+    // shared between the copies of the entry, reset on each prefetch
+    std::shared_ptr<std::atomic<size_t>> hits{
+        std::make_shared<std::atomic<size_t>>(0)};
   };
 
+  using HotCache = std::unordered_map<std::string, NetCacheEntry>;
+
+  bool IsPrefetchEnabled() const;
+  std::optional<AddrVector> QueryHotCache(const std::string& name);
+  void AccountPrefetch(const NetCacheEntry& entry,
+                       NetCacheResult::Status status);
+  void Prefetch();
+
   template <typename Mutex>
   void MoveQueryToBackground(std::unique_lock<Mutex>& lock, Mutex&& mutex,
                              engine::Future<NetResolver::Response>&& future,
-                             const std::string& name, FailureMode failure_mode);
+                             const std::string& name, FailureMode failure_mode,
+                             bool is_prefetch);
 
   template <typename Mutex>
   void FinishNetUpdate(std::unique_lock<Mutex>& lock,
                        engine::Future<NetResolver::Response>&& future,
                        const std::string& name, AddrVector* addrs,
-                       FailureMode failure_mode);
+                       FailureMode failure_mode, bool is_prefetch = false);
 
   LookupSourceCounters source_counters_;
+  PrefetchCounters prefetch_counters_;
   FileResolver file_resolver_;
   NetResolver net_resolver_;
   const std::chrono::milliseconds net_cache_update_margin_;
   const std::chrono::milliseconds net_cache_max_reply_ttl_;
   const std::chrono::milliseconds net_cache_failure_ttl_;
+  const std::chrono::milliseconds net_cache_prefetch_interval_;
+  const size_t net_cache_prefetch_min_hits_;
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
+  rcu::Variable<HotCache> hot_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+
+  // must be the last member, as its callback uses the others
+  utils::PeriodicTask prefetch_task_;
 };
 
 Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
@@ -204,22 +232,43 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_prefetch_interval_{config.cache_prefetch_interval},
+      net_cache_prefetch_min_hits_{config.cache_prefetch_min_hits},
       net_cache_{config.cache_ways, config.cache_size_per_way},
-      net_cache_update_mutexes_(config.cache_ways) {}
+      net_cache_update_mutexes_(config.cache_ways) {
+  if (IsPrefetchEnabled()) {
+    prefetch_task_.Start(
+        "dns-resolver-prefetch",
+        utils::PeriodicTask::Settings{net_cache_prefetch_interval_},
+        [this] { Prefetch(); });
+  }
+}
 
-Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
+Resolver::Impl::~Impl() {
+  prefetch_task_.Stop();
+  wait_token_storage_.WaitForAllTokens();
+}
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters()
     const {
   return source_counters_;
 }
 
+const Resolver::PrefetchCounters& Resolver::Impl::GetPrefetchCounters() const {
+  return prefetch_counters_;
+}
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
-void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
+void Resolver::Impl::FlushNetworkCache() {
+  net_cache_.Invalidate();
+  hot_cache_.Assign({});
+}
 
 void Resolver::Impl::FlushNetworkCache(const std::string& name) {
   net_cache_.InvalidateByKey(name);
+  auto hot_cache = hot_cache_.StartWrite();
+  if (hot_cache->erase(name)) hot_cache.Commit();
 }
 
 AddrVector Resolver::Impl::QueryFileCache(const std::string& name) {
@@ -234,6 +283,15 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
     const std::string& name) {
   NetCacheResult result;
 
+  if (IsPrefetchEnabled()) {
+    auto hot_addrs = QueryHotCache(name);
+    if (hot_addrs) {
+      result.status = NetCacheResult::Status::kHitReply;
+      result.addrs = std::move(*hot_addrs);
+      return result;
+    }
+  }
+
   const auto now = utils::datetime::MockSteadyNow();
   const auto cached = net_cache_.Get(name);
   if (!cached) return result;
@@ -258,10 +316,41 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
   } else {
     result.status = NetCacheResult::Status::kHitReplyWithUpdate;
   }
+  if (IsPrefetchEnabled()) AccountPrefetch(*cached, result.status);
 
   return result;
 }
 
+bool Resolver::Impl::IsPrefetchEnabled() const {
+  return net_cache_prefetch_interval_.count() > 0;
+}
+
+std::optional<AddrVector> Resolver::Impl::QueryHotCache(
+    const std::string& name) {
+  const auto hot_cache = hot_cache_.Read();
+  const auto it = hot_cache->find(name);
+  if (it == hot_cache->end()) return std::nullopt;
+
+  const auto& entry = it->second;
+  const auto now = utils::datetime::MockSteadyNow();
+  // the entry is updated in the main cache by this time
+  if (entry.expiration - now < net_cache_update_margin_) return std::nullopt;
+
+  ++source_counters_.cached;
+  AccountPrefetch(entry, NetCacheResult::Status::kHitReply);
+  return entry.addrs;
+}
+
+void Resolver::Impl::AccountPrefetch(const NetCacheEntry& entry,
+                                     NetCacheResult::Status status) {
+  ++*entry.hits;
+  if (status == NetCacheResult::Status::kHitReplyWithUpdate) {
+    ++prefetch_counters_.misses;
+  } else if (entry.is_prefetched) {
+    ++prefetch_counters_.hits;
+  }
+}
+
 auto Resolver::Impl::GetUpdateMutex(const std::string& name) {
   return net_cache_update_mutexes_.GetMutexForKey(name);
 }
@@ -284,7 +373,7 @@ AddrVector Resolver::Impl::DoForegroundQuery(std::unique_lock<Mutex>& lock,
   if (future_status != engine::FutureStatus::kReady) {
     LOG_TRACE() << "Sending query for '" << name << "' to background";
     MoveQueryToBackground(lock, std::forward<Mutex>(mutex), std::move(future),
-                          name, FailureMode::kCache);
+                          name, FailureMode::kCache, false);
     // not updating counters here as the request lives on in the background
     if (future_status == engine::FutureStatus::kTimeout) {
       throw NotResolvedException{"Resolving '" + name + "' timed out"};
@@ -299,31 +388,33 @@ AddrVector Resolver::Impl::DoForegroundQuery(std::unique_lock<Mutex>& lock,
 template <typename Mutex>
 void Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock,
                                           Mutex&& mutex,
-                                          const std::string& name) {
+                                          const std::string& name,
+                                          bool is_prefetch) {
   UASSERT(lock.mutex() == &mutex);
   if (!lock && !lock.try_lock()) {
     LOG_TRACE() << "Record for '" << name << "' is already updating, skipping";
     return;
   }
   LOG_TRACE() << "Updating record for '" << name << "' in background";
+  if (is_prefetch) ++prefetch_counters_.started;
   auto future = net_resolver_.Resolve(name);
   MoveQueryToBackground(lock, std::forward<Mutex>(mutex), std::move(future),
-                        name, FailureMode::kIgnore);
+                        name, FailureMode::kIgnore, is_prefetch);
 }
 
 template <typename Mutex>
 void Resolver::Impl::MoveQueryToBackground(
     std::unique_lock<Mutex>& lock, Mutex&& mutex,
     engine::Future<NetResolver::Response>&& future, const std::string& name,
-    FailureMode failure_mode) {
+    FailureMode failure_mode, bool is_prefetch) {
   UASSERT(lock);
   UASSERT(lock.mutex() == &mutex);
   engine::CriticalAsyncNoSpan(
-      [token = wait_token_storage_.GetToken(), this, name, failure_mode](
-          auto&& mutex, auto&& future) {
+      [token = wait_token_storage_.GetToken(), this, name, failure_mode,
+       is_prefetch](auto&& mutex, auto&& future) {
         std::unique_lock lock{mutex, std::adopt_lock};
         this->FinishNetUpdate(lock, std::forward<decltype(future)>(future),
-                              name, nullptr, failure_mode);
+                              name, nullptr, failure_mode, is_prefetch);
       },
       std::forward<Mutex>(mutex), std::move(future))
       .Detach();
@@ -339,7 +430,7 @@ template <typename Mutex>
 void Resolver::Impl::FinishNetUpdate(
     std::unique_lock<Mutex>& lock,
     engine::Future<NetResolver::Response>&& future, const std::string& name,
-    AddrVector* addrs, FailureMode failure_mode) {
+    AddrVector* addrs, FailureMode failure_mode, bool is_prefetch) {
   UASSERT(lock);
   NetResolver::Response response;
   try {
@@ -364,15 +455,43 @@ void Resolver::Impl::FinishNetUpdate(
   if (addrs) *addrs = response.addrs;
   if (effective_ttl.count() > 0) {
     LOG_TRACE() << "Updating cache for '" << name << '\'';
-    net_cache_.Put(
-        name, NetCacheEntry{std::move(response.addrs),
-                            utils::datetime::MockSteadyNow() + effective_ttl});
+    NetCacheEntry entry;
+    entry.addrs = std::move(response.addrs);
+    entry.expiration = utils::datetime::MockSteadyNow() + effective_ttl;
+    entry.is_prefetched = is_prefetch;
+    net_cache_.Put(name, std::move(entry));
   } else {
     LOG_TRACE() << "Skipping cache update for '" << name << '\'';
   }
   ++source_counters_.network;
 }
 
+// Hot entries expiring before the next run are updated in background, the ones
+// that don't need an update yet go into the lock-free snapshot.
+void Resolver::Impl::Prefetch() {
+  const auto now = utils::datetime::MockSteadyNow();
+  const auto prefetch_margin =
+      net_cache_update_margin_ + 2 * net_cache_prefetch_interval_;
+
+  std::vector<std::string> names_to_update;
+  HotCache hot_cache;
+  net_cache_.VisitAll([&](const std::string& name, const NetCacheEntry& entry) {
+    if (entry.is_failure) return;
+    if (entry.hits->exchange(0) < net_cache_prefetch_min_hits_) return;
+
+    const auto time_left = entry.expiration - now;
+    if (time_left < prefetch_margin) names_to_update.push_back(name);
+    if (time_left >= net_cache_update_margin_) hot_cache.emplace(name, entry);
+  });
+  hot_cache_.Assign(std::move(hot_cache));
+
+  for (const auto& name : names_to_update) {
+    auto mutex = GetUpdateMutex(name);
+    std::unique_lock lock{mutex, std::defer_lock};
+    StartBackgroundQuery(lock, std::move(mutex), name, true);
+  }
+}
+
 Resolver::Resolver(engine::TaskProcessor& fs_task_processor,
                    const ResolverConfig& config)
     : impl_(fs_task_processor, config) {}
@@ -447,6 +566,10 @@ const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters()
   return impl_->GetLookupSourceCounters();
 }
 
+const Resolver::PrefetchCounters& Resolver::GetPrefetchCounters() const {
+  return impl_->GetPrefetchCounters();
+}
+
 void Resolver::ReloadHosts() { impl_->ReloadHosts(); }
 
 void Resolver::FlushNetworkCache() { impl_->FlushNetworkCache(); }
@@ -58,7 +58,8 @@ constexpr auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
   using ServerMock = utest::DnsServerMock;
 
-  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way,
+                 std::chrono::milliseconds cache_prefetch_interval = {})
       : hosts_file{[] {
           auto file = fs::blocking::TempFile::Create();
           fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -88,6 +89,7 @@ struct MockedResolver {
               config.cache_ways = 1;
               config.cache_size_per_way = cache_size_per_way;
               config.network_custom_servers = {server_mock.GetServerAddress()};
+              config.cache_prefetch_interval = cache_prefetch_interval;
               return config;
             }()} {}
 
@@ -517,4 +519,36 @@ UTEST(Resolver, FirstUpdateCombines) {
   EXPECT_EQ(counters.network_failure, 1);
 }
 
+UTEST(Resolver, PrefetchHotNames) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  constexpr std::chrono::milliseconds kPrefetchInterval{10};
+  MockedResolver resolver{1000, 1, kPrefetchInterval};
+
+  utils::datetime::MockNowSet({});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("hot", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  // right before the update margin (network timeout) of the cached reply
+  utils::datetime::MockSleep(std::chrono::seconds{1000} -
+                             utest::kMaxTestWaitTime - kPrefetchInterval);
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  const auto& prefetch_counters = resolver->GetPrefetchCounters();
+  while (prefetch_counters.hits == 0 && !test_deadline.IsReached()) {
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("hot", test_deadline),
+                        (Expected{kNetV6String, kNetV4String}));
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+
+  EXPECT_GE(prefetch_counters.started, 1);
+  EXPECT_GE(prefetch_counters.hits, 1);
+  EXPECT_EQ(prefetch_counters.misses, 0);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_GE(counters.network, 2);
+  EXPECT_EQ(counters.network_failure, 0);
+}
+
 USERVER_NAMESPACE_END
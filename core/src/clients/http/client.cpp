@@ -2,11 +2,18 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/userver_info.hpp>
@@ -15,6 +22,7 @@
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
 #include <clients/http/enforce_task_deadline_config.hpp>
+#include <clients/http/retry_budget.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/openssl.hpp>
@@ -36,6 +44,9 @@ long ClampToLong(size_t value) {
   return std::min<size_t>(value, std::numeric_limits<long>::max());
 }
 
+// too few timings give an unstable percentile
+constexpr std::size_t kMinTimingsForHedgingDelay = 100;
+
 }  // namespace
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -45,6 +56,17 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(settings.thread_name_prefix);
   settings.io_threads = value["threads"].As<size_t>(settings.io_threads);
   settings.defer_events = value["defer-events"].As<bool>(settings.defer_events);
+  settings.destination_affinity = value["destination-affinity"].As<bool>(
+      settings.destination_affinity);
+  settings.retry_budget.max_tokens =
+      value["retry-budget-max-tokens"].As<size_t>(
+          settings.retry_budget.max_tokens);
+  settings.retry_budget.refill_per_second =
+      value["retry-budget-refill-per-second"].As<size_t>(
+          settings.retry_budget.refill_per_second);
+  settings.throttling.accepts_multiplier =
+      value["throttling-accepts-multiplier"].As<double>(
+          settings.throttling.accepts_multiplier);
 
   return settings;
 }
@@ -52,7 +74,11 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
 Client::Client(ClientSettings settings,
                engine::TaskProcessor& fs_task_processor)
     : destination_statistics_(std::make_shared<DestinationStatistics>()),
+      retry_budget_(std::make_shared<RetryBudget>(settings.retry_budget)),
+      throttlers_(std::make_shared<congestion_control::ClientThrottlers>(
+          settings.throttling)),
       statistics_(settings.io_threads),
+      destination_affinity_(settings.destination_affinity),
       fs_task_processor_(fs_task_processor),
       user_agent_(utils::GetUserverIdentifier()),
       connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()) {
@@ -123,7 +149,8 @@ std::shared_ptr<Request> Client::CreateRequest() {
     auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
     request = std::make_shared<Request>(std::move(wrapper),
                                         statistics_[idx].CreateRequestStats(),
-                                        destination_statistics_, resolver_);
+                                        destination_statistics_, retry_budget_,
+                                        throttlers_, resolver_);
   } else {
     auto i = utils::RandRange(multis_.size());
     auto& multi = multis_[i];
@@ -135,7 +162,8 @@ std::shared_ptr<Request> Client::CreateRequest() {
                       easy_.Get()->GetBoundBlocking(*multi), *this);
                   return std::make_shared<Request>(
                       std::move(wrapper), statistics_[i].CreateRequestStats(),
-                      destination_statistics_, resolver_);
+                      destination_statistics_, retry_budget_, throttlers_,
+                      resolver_);
                 }).Get();
     } catch (engine::WaitInterruptedException&) {
       throw clients::http::CancelException();
@@ -163,6 +191,123 @@ std::shared_ptr<Request> Client::CreateRequest() {
   return request;
 }
 
+std::shared_ptr<Request> Client::CreateRequest(
+    const RequestTemplate& request_template) {
+  return CreateRequest()->ApplyTemplate(request_template);
+}
+
+void Client::Prewarm(const std::vector<std::string>& urls,
+                     size_t connections, std::chrono::milliseconds timeout) {
+  std::vector<std::pair<const std::string*, ResponseFuture>> requests;
+  requests.reserve(urls.size() * connections);
+  for (const auto& url : urls) {
+    for (size_t i = 0; i < connections; ++i) {
+      requests.emplace_back(&url, CreateRequest()
+                                      ->head(url)
+                                      ->timeout(timeout)
+                                      ->retry(1)
+                                      ->async_perform());
+    }
+  }
+
+  for (auto& [url, future] : requests) {
+    try {
+      future.Get();
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to prewarm a connection to " << *url << ": "
+                    << ex;
+    }
+  }
+}
+
+std::shared_ptr<Response> Client::PerformHedged(
+    const std::function<std::shared_ptr<Request>()>& make_request,
+    const HedgingSettings& settings) {
+  UINVARIANT(settings.max_attempts > 0, "max_attempts must be positive");
+
+  auto request = make_request();
+  const auto url = request->GetUrl();
+  const auto delay = GetHedgingDelay(url, settings);
+
+  std::vector<ResponseFuture> futures;
+  futures.reserve(settings.max_attempts);
+  futures.push_back(request->async_perform());
+  request.reset();
+
+  std::size_t in_flight = 1;
+  bool can_hedge = settings.max_attempts > 1;
+  bool hedge_now = false;
+  std::shared_ptr<Response> last_response;
+  std::exception_ptr last_error;
+
+  while (in_flight > 0 || can_hedge) {
+    std::optional<std::size_t> ready;
+    if (in_flight > 0 && !(can_hedge && hedge_now)) {
+      try {
+        ready = engine::WaitAnyUntil(can_hedge
+                                         ? engine::Deadline::FromDuration(delay)
+                                         : engine::Deadline{},
+                                     futures);
+      } catch (const engine::WaitInterruptedException&) {
+        throw CancelException("Hedged HTTP request was cancelled", {});
+      }
+    }
+
+    if (!ready) {
+      hedge_now = false;
+      if (!retry_budget_->Obtain(url)) {
+        LOG_LIMITED_WARNING()
+            << "Retry budget is exhausted, not sending a hedged request to "
+            << url;
+        can_hedge = false;
+        continue;
+      }
+      futures.push_back(make_request()->async_perform());
+      ++in_flight;
+      can_hedge = futures.size() < settings.max_attempts;
+      continue;
+    }
+
+    --in_flight;
+    auto& future = futures[*ready];
+    try {
+      auto response = future.Get();
+      if (response->status_code() < Status::InternalServerError) {
+        return response;
+      }
+      last_response = std::move(response);
+    } catch (const std::exception&) {
+      last_error = std::current_exception();
+    }
+    future.Detach();
+    hedge_now = true;
+  }
+
+  if (last_response) return last_response;
+  UASSERT(last_error);
+  std::rethrow_exception(last_error);
+}
+
+std::chrono::milliseconds Client::GetHedgingDelay(
+    const std::string& url, const HedgingSettings& settings) const {
+  if (!settings.delay_percentile) return settings.hedging_delay;
+
+  const auto timing = destination_statistics_->GetTimingPercentile(
+      USERVER_NAMESPACE::http::ExtractMetaTypeFromUrl(url),
+      *settings.delay_percentile, kMinTimingsForHedgingDelay);
+  return timing.value_or(settings.hedging_delay);
+}
+
+void Client::BindToDestination(curl::easy& easy, std::string_view url) const {
+  if (!destination_affinity_ || multis_.size() < 2) return;
+
+  // keeps the connections to a destination in the cache of a single multi
+  const auto index =
+      std::hash<std::string_view>{}(ExtractDestination(url)) % multis_.size();
+  auto& multi = *multis_[index];
+  if (easy.GetMulti() != &multi) easy.SetMulti(multi);
+}
+
 void Client::SetMultiplexingEnabled(bool enabled) {
   for (auto& multi : multis_) {
     multi->SetMultiplexingEnabled(enabled);
@@ -228,6 +373,10 @@ const DestinationStatistics& Client::GetDestinationStatistics() const {
   return *destination_statistics_;
 }
 
+const congestion_control::ClientThrottlers& Client::GetThrottlers() const {
+  return *throttlers_;
+}
+
 void Client::PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept {
   try {
     easy->reset();
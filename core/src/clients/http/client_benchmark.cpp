@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/internal/net/net_listener.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+
+constexpr std::string_view kRequestEnd = "\r\n\r\n";
+
+std::string MakeResponse(std::size_t body_size) {
+  std::string response;
+  for (int i = 0; i < 10; ++i) {
+    response += fmt::format("X-Header-{}: value-{}\r\n", i, i);
+  }
+  return fmt::format(
+      "HTTP/1.1 200 OK\r\nContent-Length: {}\r\n{}\r\n{}", body_size, response,
+      std::string(body_size, 'a'));
+}
+
+// Answers each request of a keep-alive connection with the same response
+void ServeConnection(engine::io::Socket socket, const std::string& response,
+                     const std::atomic<bool>& serving) {
+  const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+  std::array<char, 4096> buf{};
+  std::string request;
+  while (serving) {
+    const auto size = socket.RecvSome(buf.data(), buf.size(), deadline);
+    if (size == 0) return;
+    request.append(buf.data(), size);
+    // the client sends the next request only after the response
+    if (request.find(kRequestEnd) == std::string::npos) continue;
+    request.clear();
+    if (socket.SendAll(response.data(), response.size(), deadline) !=
+        response.size()) {
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+void http_client_get(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener{internal::net::IpVersion::kV4};
+    const auto response = MakeResponse(state.range(0));
+    std::atomic<bool> serving{true};
+    auto server_task = engine::AsyncNoSpan([&] {
+      ServeConnection(listener.socket.Accept(deadline), response, serving);
+    });
+
+    clients::http::Client client{clients::http::ClientSettings{"", 1, false},
+                                 engine::current_task::GetTaskProcessor()};
+    const auto url = fmt::format("http://127.0.0.1:{}/", listener.port);
+
+    for (auto _ : state) {
+      auto body = client.CreateRequest()
+                      ->get(url)
+                      ->retry(1)
+                      ->timeout(std::chrono::seconds{10})
+                      ->perform()
+                      ->ExtractBody();
+      benchmark::DoNotOptimize(body);
+    }
+
+    serving = false;
+    server_task.RequestCancel();
+  });
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(http_client_get)->RangeMultiplier(16)->Range(16, 16 << 20);
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,13 @@
 #include <userver/clients/http/client.hpp>
 
+#include <atomic>
 #include <set>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
+#include <clients/http/request_template_settings.hpp>
 #include <clients/http/testsuite.hpp>
 #include <engine/task/task_processor.hpp>
 #include <userver/clients/dns/resolver.hpp>
@@ -177,6 +179,31 @@ struct EchoCallback {
   }
 };
 
+// Replies with the decoded body of a chunked request
+HttpResponse chunked_echo_callback(const HttpRequest& request) {
+  const auto body_pos = request.find("\r\n\r\n");
+  if (body_pos == std::string::npos ||
+      request.find("\r\n0\r\n\r\n", body_pos) == std::string::npos) {
+    return {{}, HttpResponse::kTryReadMore};
+  }
+  EXPECT_NE(request.find("Transfer-Encoding: chunked"), std::string::npos);
+
+  std::string payload;
+  std::size_t pos = body_pos + 4;
+  while (true) {
+    const auto size_end = request.find("\r\n", pos);
+    const auto size = std::stoul(request.substr(pos, size_end - pos), nullptr,
+                                 /*base=*/16);
+    if (size == 0) break;
+    payload += request.substr(size_end + 2, size);
+    pos = size_end + 2 + size + 2;
+  }
+
+  return {"HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: " +
+              std::to_string(payload.size()) + "\r\n\r\n" + payload,
+          HttpResponse::kWriteAndClose};
+}
+
 struct ValidatingSharedCallback {
   const std::shared_ptr<std::string> method_name =
       std::make_shared<std::string>();
@@ -349,6 +376,16 @@ struct Response503WithConnDrop {
   }
 };
 
+struct SlowFirstResponse {
+  std::shared_ptr<std::atomic<std::size_t>> requests =
+      std::make_shared<std::atomic<std::size_t>>(0);
+
+  HttpResponse operator()(const HttpRequest& request) const {
+    if ((*requests)++ == 0) return sleep_callback(request);
+    return EchoCallback{}(request);
+  }
+};
+
 struct CheckCookie {
   const std::set<std::string> expected_cookies;
 
@@ -578,6 +615,33 @@ UTEST(HttpClient, PostEcho) {
   }
 }
 
+UTEST(HttpClient, PostStreamData) {
+  const utest::SimpleServer http_server{&chunked_echo_callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  const auto queue =
+      concurrent::SpscQueue<std::string>::Create(/*max_size=*/2);
+  auto response_future = http_client_ptr->CreateRequest()
+                             ->post(http_server.GetBaseUrl())
+                             ->stream_data(queue)
+                             ->timeout(utest::kMaxTestWaitTime)
+                             ->async_perform();
+
+  std::string expected_body;
+  {
+    auto producer = queue->GetProducer();
+    for (unsigned i = 0; i < kFewRepetitions; ++i) {
+      auto chunk = fmt::format("chunk {};", i);
+      expected_body += chunk;
+      ASSERT_TRUE(producer.Push(std::move(chunk)));
+    }
+  }
+
+  const auto response = response_future.Get();
+  EXPECT_EQ(200, response->status_code());
+  EXPECT_EQ(expected_body, response->body());
+}
+
 UTEST(HttpClient, StatsOnTimeout) {
   const int kRetries = 5;
   const utest::SimpleServer http_server{&sleep_callback};
@@ -1026,6 +1090,57 @@ UTEST(HttpClient, HeadersUserAgent) {
   EXPECT_TRUE(response->IsOk());
 }
 
+UTEST(HttpClient, RequestTemplate) {
+  const utest::SimpleServer http_server{[](const HttpRequest& request) {
+    LOG_INFO() << "HTTP Server receive: " << request;
+    EXPECT_EQ(request.find("POST"), 0) << request;
+    EXPECT_EQ(AssertHeader(request, kTestHeader), "test");
+    EXPECT_EQ(AssertHeader(request, http::headers::kUserAgent), kTestUserAgent);
+    EXPECT_EQ(AssertHeader(request, "X-Dynamic"), "dynamic");
+    return HttpResponse{
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: "
+        "0\r\n\r\n",
+        HttpResponse::kWriteAndClose};
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto& http_client = *http_client_ptr;
+
+  /// [Sample HTTP Client request template]
+  // prepared once per destination, e.g. in the constructor of a component
+  const auto request_template =
+      clients::http::RequestTemplate{}
+          .method(clients::http::HttpMethod::kPost)
+          .headers({{kTestHeader, "test"},
+                    {http::headers::kUserAgent, kTestUserAgent}})
+          .http_version(clients::http::HttpVersion::k11)
+          .timeout(kTimeout)
+          .retry(1);
+
+  // each call sets only the dynamic parts
+  const auto response = http_client.CreateRequest(request_template)
+                            ->url(http_server.GetBaseUrl())
+                            ->data(kTestData)
+                            ->headers({{"X-Dynamic", "dynamic"}})
+                            ->perform();
+  /// [Sample HTTP Client request template]
+  EXPECT_TRUE(response->IsOk());
+
+  // the copies share the settings until modified
+  auto modified = request_template;
+  modified.headers({{kTestHeader, "other"}});
+  EXPECT_EQ(request_template.GetSettings().header_lines.size(), 1);
+  EXPECT_EQ(modified.GetSettings().header_lines.size(), 2);
+
+  for (unsigned i = 0; i < kRepetitions; ++i) {
+    EXPECT_TRUE(http_client.CreateRequest(request_template)
+                    ->url(http_server.GetBaseUrl())
+                    ->data(kTestData)
+                    ->headers({{"X-Dynamic", "dynamic"}})
+                    ->perform()
+                    ->IsOk());
+  }
+}
+
 UTEST(HttpClient, Cookies) {
   const auto test = [](const clients::http::Request::Cookies& cookies,
                        std::set<std::string> expected) {
@@ -1222,6 +1337,70 @@ UTEST(HttpClient, Retry) {
   EXPECT_EQ(2, response->GetStats().retries_count);
 }
 
+UTEST(HttpClient, RetryBudget) {
+  clients::http::ClientSettings settings{"", 1, false};
+  settings.retry_budget.max_tokens = 1;
+  settings.retry_budget.refill_per_second = 0;
+  clients::http::Client http_client{settings,
+                                    engine::current_task::GetTaskProcessor()};
+  const utest::SimpleServer unavail_server{Response503WithConnDrop{}};
+
+  for (const auto expected_retries : {1, 0}) {
+    auto response = http_client.CreateRequest()
+                        ->get(unavail_server.GetBaseUrl())
+                        ->timeout(kTimeout)
+                        ->retry(3)
+                        ->perform();
+
+    EXPECT_EQ(503, response->status_code());
+    EXPECT_EQ(expected_retries, response->GetStats().retries_count);
+  }
+}
+
+UTEST(HttpClient, Throttling) {
+  clients::http::ClientSettings settings{"", 1, false};
+  settings.throttling.accepts_multiplier = 2;
+  clients::http::Client http_client{settings,
+                                    engine::current_task::GetTaskProcessor()};
+  const utest::SimpleServer unavail_server{Response503WithConnDrop{}};
+
+  std::size_t throttled = 0;
+  for (int i = 0; i < 100; ++i) {
+    try {
+      auto response = http_client.CreateRequest()
+                          ->get(unavail_server.GetBaseUrl())
+                          ->timeout(kTimeout)
+                          ->perform();
+      EXPECT_EQ(503, response->status_code());
+    } catch (const clients::http::ThrottledException&) {
+      ++throttled;
+    }
+  }
+  EXPECT_GT(throttled, 0);
+}
+
+UTEST(HttpClient, Hedging) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  const SlowFirstResponse callback;
+  const utest::SimpleServer http_server{callback};
+
+  clients::http::HedgingSettings settings;
+  settings.max_attempts = 2;
+  settings.hedging_delay = std::chrono::milliseconds{10};
+
+  const auto response = http_client_ptr->PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            ->post(http_server.GetBaseUrl(), kTestData)
+            ->timeout(utest::kMaxTestWaitTime);
+      },
+      settings);
+
+  EXPECT_EQ(200, response->status_code());
+  EXPECT_EQ(kTestData, response->body());
+  EXPECT_EQ(2, callback.requests->load());
+}
+
 UTEST(HttpClient, TinyTimeout) {
   auto http_client_ptr = utest::CreateHttpClient();
   const utest::SimpleServer http_server{sleep_callback_1s};
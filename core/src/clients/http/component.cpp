@@ -1,5 +1,9 @@
 #include <userver/clients/http/component.hpp>
 
+#include <chrono>
+#include <string>
+#include <vector>
+
 #include <userver/clients/dns/resolver_utils.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
@@ -21,6 +25,8 @@ namespace components {
 namespace {
 
 constexpr size_t kDestinationMetricsAutoMaxSizeDefault = 100;
+constexpr size_t kPrewarmConnectionsDefault = 1;
+constexpr std::chrono::seconds kPrewarmTimeout{1};
 
 }  // namespace
 
@@ -76,6 +82,15 @@ HttpClient::HttpClient(const ComponentConfig& component_config,
           .GetEventSource()
           .AddListener(this, kName, &HttpClient::OnConfigUpdate);
 
+  const auto prewarm_urls =
+      component_config["prewarm-urls"].As<std::vector<std::string>>({});
+  if (!prewarm_urls.empty()) {
+    http_client_.Prewarm(prewarm_urls,
+                         component_config["prewarm-connections"].As<size_t>(
+                             kPrewarmConnectionsDefault),
+                         kPrewarmTimeout);
+  }
+
   const auto thread_name_prefix =
       component_config["thread-name-prefix"].As<std::string>("");
   auto stats_name =
@@ -105,6 +120,10 @@ void HttpClient::ExtendStatistics(utils::statistics::Writer& writer) {
     DumpMetric(writer, http_client_.GetPoolStatistics());
   }
   DumpMetric(writer, http_client_.GetDestinationStatistics());
+
+  auto throttling_writer = writer["throttling"];
+  http_client_.GetThrottlers().DumpStatistics(throttling_writer,
+                                              "http_destination");
 }
 
 yaml_config::Schema HttpClient::GetStaticConfigSchema() {
@@ -129,6 +148,32 @@ properties:
         type: boolean
         description: whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care
         defaultDescription: false
+    destination-affinity:
+        type: boolean
+        description: whether to perform all the requests to a destination (scheme, host and port) in the same IO thread, so that they share its keep-alive connections
+        defaultDescription: false
+    prewarm-urls:
+        type: array
+        description: URLs to open connections to at start by sending HEAD requests
+        items:
+            type: string
+            description: URL
+    prewarm-connections:
+        type: integer
+        description: number of connections to open to each of prewarm-urls
+        defaultDescription: 1
+    retry-budget-max-tokens:
+        type: integer
+        description: max number of retries and hedged requests to a destination (scheme, host and port) in a burst, 0 disables the limit
+        defaultDescription: 0
+    retry-budget-refill-per-second:
+        type: integer
+        description: number of retries and hedged requests to a destination added to its budget each second
+        defaultDescription: 10
+    throttling-accepts-multiplier:
+        type: number
+        description: start rejecting the requests to a destination (scheme, host and port) locally once they outnumber the requests accepted by it during the last 2 minutes by this factor, 0 disables the throttling
+        defaultDescription: 0
     fs-task-processor:
         type: string
         description: task processor to run blocking HTTP related calls, like DNS resolving or hosts reading
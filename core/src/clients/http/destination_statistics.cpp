@@ -79,6 +79,15 @@ void DestinationStatistics::SetAutoMaxSize(size_t max_auto_destinations) {
   max_auto_destinations_ = max_auto_destinations;
 }
 
+std::optional<std::chrono::milliseconds>
+DestinationStatistics::GetTimingPercentile(const std::string& destination,
+                                           double percent,
+                                           size_t min_count) const {
+  const auto stats = rcu_map_.Get(destination);
+  if (!stats) return std::nullopt;
+  return stats->GetTimingPercentile(percent, min_count);
+}
+
 DestinationStatistics::DestinationsMap::ConstIterator
 DestinationStatistics::begin() const {
   return rcu_map_.begin();
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include <userver/rcu/rcu_map.hpp>
@@ -25,6 +27,12 @@ class DestinationStatistics final {
 
   void SetAutoMaxSize(size_t max_auto_destinations);
 
+  // Return the percentile of the recent timings of the destination, nullopt if
+  // the destination is unknown or has less than min_count timings
+  std::optional<std::chrono::milliseconds> GetTimingPercentile(
+      const std::string& destination, double percent,
+      size_t min_count) const;
+
   using DestinationsMap = rcu::RcuMap<std::string, Statistics>;
 
   DestinationsMap::ConstIterator begin() const;
@@ -7,6 +7,8 @@
 #include <userver/utest/simple_server.hpp>
 #include <userver/utest/utest.hpp>
 
+#include <curl-ev/easy.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 using HttpResponse = utest::SimpleServer::Response;
@@ -105,4 +107,59 @@ UTEST(DestinationStatistics, Multiple) {
   }
 }
 
+UTEST(DestinationStatistics, Prewarm) {
+  const utest::SimpleServer http_server{
+      [](const HttpRequest& request) { return Callback(200, request); }};
+  auto client = utest::CreateHttpClient();
+
+  const auto url = http_server.GetBaseUrl();
+  client->Prewarm({url}, 2, std::chrono::milliseconds(100));
+
+  const auto& dest_stats = client->GetDestinationStatistics();
+  size_t size = 0;
+  for (const auto& [stat_url, stat_ptr] : dest_stats) {
+    ASSERT_EQ(1, ++size);
+
+    EXPECT_EQ(url, stat_url);
+    ASSERT_NE(nullptr, stat_ptr);
+
+    auto stats = clients::http::InstanceStatistics(*stat_ptr);
+    auto ok = static_cast<size_t>(clients::http::Statistics::ErrorGroup::kOk);
+    EXPECT_EQ(2, stats.error_count[ok]);
+  }
+}
+
+UTEST(DestinationStatistics, HttpVersions) {
+  const utest::SimpleServer http_server{
+      [](const HttpRequest& request) { return Callback(200, request); }};
+  auto client = utest::CreateHttpClient();
+
+  const auto url = http_server.GetBaseUrl();
+  for (const auto version :
+       {clients::http::HttpVersion::k11, clients::http::HttpVersion::k3}) {
+    // a plain HTTP destination answers HTTP/3 requests over HTTP/1.1
+    const auto response = client->CreateRequest()
+                              ->post(url)
+                              ->http_version(version)
+                              ->retry(1)
+                              ->timeout(std::chrono::milliseconds(100))
+                              ->perform();
+    EXPECT_TRUE(response->IsOk());
+  }
+
+  const auto& dest_stats = client->GetDestinationStatistics();
+  size_t size = 0;
+  for (const auto& [stat_url, stat_ptr] : dest_stats) {
+    ASSERT_EQ(1, ++size);
+    ASSERT_NE(nullptr, stat_ptr);
+
+    const auto stats = clients::http::InstanceStatistics(*stat_ptr);
+    const auto http11 =
+        static_cast<size_t>(clients::http::ResponseHttpVersion::k11);
+    EXPECT_EQ(2, stats.http_versions[http11]);
+    EXPECT_EQ(curl::easy::is_http3_supported() ? 1 : 0,
+              stats.http3_fallbacks);
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -17,6 +17,10 @@ EasyWrapper::~EasyWrapper() { client_.PushIdleEasy(std::move(easy_)); }
 
 curl::easy& EasyWrapper::Easy() { return *easy_; }
 
+void EasyWrapper::BindToDestination(std::string_view url) {
+  client_.BindToDestination(*easy_, url);
+}
+
 }  // namespace clients::http::impl
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 
 #include <curl-ev/easy.hpp>
 
@@ -25,6 +26,9 @@ class EasyWrapper final {
 
   curl::easy& Easy();
 
+  /// Moves the handle to the multi that serves the URL destination
+  void BindToDestination(std::string_view url);
+
  private:
   std::shared_ptr<curl::easy> easy_;
   Client& client_;
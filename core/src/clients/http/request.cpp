@@ -23,6 +23,7 @@
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
 #include <clients/http/request_state.hpp>
+#include <clients/http/request_template_settings.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
@@ -59,6 +60,13 @@ curl::easy::http_version_t ToNative(HttpVersion version) {
       return curl::easy::http_version_t::http_vertion_2tls;
     case HttpVersion::k2PriorKnowledge:
       return curl::easy::http_version_t::http_version_2_prior_knowledge;
+    case HttpVersion::k3:
+#if LIBCURL_VERSION_NUM >= 0x074200
+      if (curl::easy::is_http3_supported()) {
+        return curl::easy::http_version_t::http_version_3;
+      }
+#endif
+      return curl::easy::http_version_t::http_vertion_2tls;
   }
 
   UINVARIANT(false, "Unexpected HTTP version");
@@ -197,9 +205,13 @@ ProxyAuthType ProxyAuthTypeFromString(const std::string& auth_name) {
 Request::Request(std::shared_ptr<impl::EasyWrapper>&& wrapper,
                  std::shared_ptr<RequestStats>&& req_stats,
                  const std::shared_ptr<DestinationStatistics>& dest_stats,
+                 const std::shared_ptr<RetryBudget>& retry_budget,
+                 const std::shared_ptr<congestion_control::ClientThrottlers>&
+                     throttlers,
                  clients::dns::Resolver* resolver)
     : pimpl_(std::make_shared<RequestState>(
-          std::move(wrapper), std::move(req_stats), dest_stats, resolver)) {
+          std::move(wrapper), std::move(req_stats), dest_stats, retry_budget,
+          throttlers, resolver)) {
   LOG_TRACE() << "Request::Request()";
   // default behavior follow redirects and verify ssl
   pimpl_->follow_redirects(true);
@@ -292,6 +304,32 @@ std::shared_ptr<Request> Request::retry(short retries, bool on_fails) {
   return shared_from_this();
 }
 
+std::shared_ptr<Request> Request::ApplyTemplate(
+    const RequestTemplate& request_template) {
+  const auto& settings = request_template.GetSettings();
+  auto& easy = pimpl_->easy();
+
+  if (settings.method) method(*settings.method);
+  easy.add_headers(settings.header_lines);
+  if (settings.user_agent) SetUserAgent(easy, *settings.user_agent);
+  if (settings.proxy) pimpl_->proxy(*settings.proxy);
+  if (settings.follow_redirects) {
+    pimpl_->follow_redirects(*settings.follow_redirects);
+  }
+  if (settings.timeout) pimpl_->set_timeout(settings.timeout->count());
+  if (settings.verify) pimpl_->verify(*settings.verify);
+  if (settings.ca_info) pimpl_->ca_info(*settings.ca_info);
+  if (settings.http_version) {
+    pimpl_->http_version(ToNative(*settings.http_version));
+  }
+  if (settings.retries) retry(*settings.retries, settings.retry_on_fails);
+  if (settings.destination_metric_name) {
+    pimpl_->SetDestinationMetricName(*settings.destination_metric_name);
+  }
+  if (settings.disable_reply_decoding) pimpl_->DisableReplyDecoding();
+  return shared_from_this();
+}
+
 std::shared_ptr<Request> Request::unix_socket_path(const std::string& path) {
   pimpl_->unix_socket_path(path);
   return shared_from_this();
@@ -305,6 +343,14 @@ std::shared_ptr<Request> Request::data(std::string data) {
   return shared_from_this();
 }
 
+std::shared_ptr<Request> Request::stream_data(
+    const std::shared_ptr<concurrent::SpscQueue<std::string>>& queue) {
+  pimpl_->easy().add_header(kHeaderExpect, "",
+                            curl::easy::EmptyHeaderAction::kDoNotSend);
+  pimpl_->stream_data(queue);
+  return shared_from_this();
+}
+
 std::shared_ptr<Request> Request::form(const Form& form) {
   pimpl_->easy().set_http_post(form.GetNative());
   pimpl_->easy().add_header(kHeaderExpect, "",
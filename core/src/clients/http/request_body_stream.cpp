@@ -0,0 +1,88 @@
+#include <clients/http/request_body_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <userver/engine/task/cancel.hpp>
+
+#include <curl-ev/easy.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+void RequestBodyStream::Pump(Queue::Consumer consumer, curl::easy& easy) {
+  std::string chunk;
+  while (consumer.Pop(chunk)) {
+    // an empty read means the end of the body for cURL
+    if (chunk.empty()) continue;
+    if (!WaitForChunkConsumed()) return;
+
+    bool resume = false;
+    {
+      std::lock_guard lock(mutex_);
+      if (aborted_) return;
+      chunk_ = std::move(chunk);
+      offset_ = 0;
+      resume = std::exchange(paused_, false);
+    }
+    if (resume) easy.unpause_read();
+  }
+
+  // a cancelled pump must not end the body, the request is aborted instead
+  const bool cancelled = engine::current_task::ShouldCancel();
+  if (!cancelled && !WaitForChunkConsumed()) return;
+  bool resume = false;
+  {
+    std::lock_guard lock(mutex_);
+    finished_ = !cancelled;
+    aborted_ = cancelled;
+    resume = std::exchange(paused_, false);
+  }
+  if (resume) easy.unpause_read();
+}
+
+size_t RequestBodyStream::Read(char* buffer, size_t size) {
+  bool consumed = false;
+  size_t bytes = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (aborted_) return CURL_READFUNC_ABORT;
+    if (offset_ == chunk_.size()) {
+      if (finished_) return 0;
+      paused_ = true;
+      return CURL_READFUNC_PAUSE;
+    }
+
+    bytes = std::min(size, chunk_.size() - offset_);
+    std::memcpy(buffer, chunk_.data() + offset_, bytes);
+    offset_ += bytes;
+    consumed = offset_ == chunk_.size();
+  }
+  if (consumed) chunk_consumed_.Send();
+  return bytes;
+}
+
+void RequestBodyStream::Abort() {
+  {
+    std::lock_guard lock(mutex_);
+    aborted_ = true;
+  }
+  chunk_consumed_.Send();
+}
+
+bool RequestBodyStream::WaitForChunkConsumed() {
+  while (true) {
+    {
+      std::lock_guard lock(mutex_);
+      if (aborted_) return false;
+      if (offset_ == chunk_.size()) return true;
+    }
+    if (!chunk_consumed_.WaitForEvent()) return false;
+  }
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
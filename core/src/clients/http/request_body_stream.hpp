@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace curl {
+class easy;
+}  // namespace curl
+
+namespace clients::http {
+
+// Feeds a request body from a queue to cURL. The chunks are popped by a
+// coroutine, which waits for cURL to send the previous chunk, and are read by
+// the cURL read callback in the libev thread, which pauses the transfer while
+// there is no chunk.
+class RequestBodyStream final {
+ public:
+  using Queue = concurrent::SpscQueue<std::string>;
+
+  // Pops the chunks until the end of the body or Abort(), runs in a
+  // coroutine. The consumer is released on return, so that pushing into the
+  // queue fails after the request is completed.
+  void Pump(Queue::Consumer consumer, curl::easy& easy);
+
+  // Returns the next part of the body, runs in the libev thread
+  size_t Read(char* buffer, size_t size);
+
+  // Stops the pumping once the request is completed
+  void Abort();
+
+ private:
+  bool WaitForChunkConsumed();
+
+  engine::SingleConsumerEvent chunk_consumed_;
+
+  std::mutex mutex_;
+  std::string chunk_;
+  size_t offset_{0};
+  bool finished_{false};
+  bool aborted_{false};
+  bool paused_{false};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
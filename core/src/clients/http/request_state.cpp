@@ -43,6 +43,9 @@ constexpr long kLeastBadHttpCodeForEB = 500;
 
 constexpr Status kFakeHttpErrorCode{599};
 
+/// Headers count of a typical response, reserved to avoid rehashing
+constexpr std::size_t kTypicalHeadersCount = 16;
+
 const std::string kTracingClientName = "external";
 
 const std::vector<std::string> ya_tracing_headers = {
@@ -87,6 +90,24 @@ bool IsSetCookie(std::string_view key) {
   return equal(key, USERVER_NAMESPACE::http::headers::kSetCookie);
 }
 
+std::optional<ResponseHttpVersion> ToResponseHttpVersion(long version) {
+  switch (version) {
+    case curl::native::CURL_HTTP_VERSION_1_0:
+      return ResponseHttpVersion::k10;
+    case curl::native::CURL_HTTP_VERSION_1_1:
+      return ResponseHttpVersion::k11;
+    case curl::native::CURL_HTTP_VERSION_2_0:
+      return ResponseHttpVersion::k2;
+#if LIBCURL_VERSION_NUM >= 0x074200
+    case curl::native::CURL_HTTP_VERSION_3:
+      return ResponseHttpVersion::k3;
+#endif
+    default:
+      // no response
+      return std::nullopt;
+  }
+}
+
 // Not a strict check, but OK for non-header line check
 bool IsHttpStatusLineStart(const char* ptr, size_t size) {
   return (size > 5 && memcmp(ptr, "HTTP/", 5) == 0);
@@ -101,11 +122,6 @@ char* rfind_not_space(char* ptr, size_t size) {
   return ptr;
 }
 
-engine::Deadline GetTaskDeadline() {
-  const auto* const data = server::request::kTaskInheritedData.GetOptional();
-  return data ? data->deadline : engine::Deadline{};
-}
-
 void SetTracingHeader(curl::easy& e, std::string_view name,
                       std::string_view value) {
   e.add_header(name, value, curl::easy::EmptyHeaderAction::kDoNotSend,
@@ -133,13 +149,17 @@ RequestState::RequestState(
     std::shared_ptr<impl::EasyWrapper>&& wrapper,
     std::shared_ptr<RequestStats>&& req_stats,
     const std::shared_ptr<DestinationStatistics>& dest_stats,
+    const std::shared_ptr<RetryBudget>& retry_budget,
+    const std::shared_ptr<congestion_control::ClientThrottlers>& throttlers,
     clients::dns::Resolver* resolver)
     : easy_(std::move(wrapper)),
       stats_(std::move(req_stats)),
       dest_stats_(dest_stats),
+      retry_budget_(retry_budget),
+      throttlers_(throttlers),
       original_timeout_(kDefaultTimeout),
       effective_timeout_(original_timeout_),
-      deadline_(GetTaskDeadline()),
+      deadline_(server::request::GetTaskInheritedDeadline()),
       is_cancelled_(false),
       errorbuffer_(),
       resolver_{resolver} {
@@ -229,6 +249,9 @@ void RequestState::client_key_cert(crypto::PrivateKey pkey,
 
 void RequestState::http_version(curl::easy::http_version_t version) {
   easy().set_http_version(version);
+#if LIBCURL_VERSION_NUM >= 0x074200
+  is_http3_requested_ = (version == curl::easy::http_version_3);
+#endif
 }
 
 void RequestState::set_timeout(long timeout_ms) {
@@ -255,6 +278,14 @@ void RequestState::proxy_auth_type(curl::easy::proxyauth_t value) {
   easy().set_proxy_auth(value);
 }
 
+void RequestState::stream_data(const std::shared_ptr<Queue>& queue) {
+  body_consumer_.emplace(queue->GetConsumer());
+  body_stream_ = std::make_shared<RequestBodyStream>();
+  easy().set_body_reader([body = body_stream_](char* buffer, size_t size) {
+    return body->Read(buffer, size);
+  });
+}
+
 void RequestState::Cancel() {
   // We can not call `retry_.timer.reset();` here because of data race
   is_cancelled_ = true;
@@ -347,6 +378,8 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   auto& span = holder->span_storage_->Get();
   auto& easy = holder->easy();
 
+  holder->AbortBodyStream();
+
   auto* stream_data = std::get_if<StreamData>(&holder->data_);
   if (stream_data && !stream_data->headers_promise_set.exchange(true)) {
     stream_data->headers_promise.set_value();
@@ -372,6 +405,11 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   const auto sockets = easy.get_num_connects();
   holder->WithRequestStats(
       [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  if (const auto version = ToResponseHttpVersion(easy.get_http_version())) {
+    holder->WithRequestStats([version, &holder](RequestStats& stats) {
+      stats.AccountHttpVersion(*version, holder->is_http3_requested_);
+    });
+  }
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   span.AddTag(tracing::kMaxAttempts, holder->retry_.retries);
@@ -441,10 +479,12 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
   //  - if we got result and http code is good
   //  - if we use all tries
   //  - if error and we should not retry on error
+  //  - if the retry budget of the destination is exhausted
   bool not_need_retry =
       (!err && holder->easy().get_response_code() < kLeastBadHttpCodeForEB) ||
       (holder->retry_.current >= holder->retry_.retries) ||
-      (err && !holder->retry_.on_fails) || holder->is_cancelled_.load();
+      (err && !holder->retry_.on_fails) || holder->is_cancelled_.load() ||
+      !holder->ObtainRetryToken();
   if (not_need_retry) {
     // finish if don't need retry
     RequestState::on_completed(std::move(holder), err);
@@ -470,6 +510,28 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
   }
 }
 
+bool RequestState::ObtainRetryToken() {
+  const auto& url = easy().get_original_url();
+  if (retry_budget_ && !retry_budget_->Obtain(url)) {
+    LOG_LIMITED_WARNING() << "Retry budget is exhausted, not retrying " << url;
+    return false;
+  }
+  if (throttler_ && !throttler_->Allow()) {
+    LOG_LIMITED_WARNING() << "Destination is throttled, not retrying " << url;
+    return false;
+  }
+  return true;
+}
+
+bool RequestState::ObtainThrottlerPermit() {
+  throttler_.reset();
+  if (throttlers_) {
+    throttler_ = throttlers_->Get(
+        std::string{ExtractDestination(easy().get_original_url())});
+  }
+  return !throttler_ || throttler_->Allow();
+}
+
 void RequestState::on_retry_timer(std::error_code err) {
   // if there is no error with timer call perform, otherwise finish
   if (!err)
@@ -511,11 +573,12 @@ void RequestState::parse_header(char* ptr, size_t size) try {
         LOG_INFO() << "drop header " << k << "=" << v;
       // In case of redirect drop 1st response headers
       response_->headers().clear();
+      response_->headers().reserve(kTypicalHeadersCount);
     }
     return;
   }
 
-  std::string key(ptr, col_pos - ptr);
+  const std::string_view key(ptr, col_pos - ptr);
 
   ++col_pos;
 
@@ -531,8 +594,8 @@ void RequestState::parse_header(char* ptr, size_t size) try {
     ++col_pos;
   }
 
-  std::string value(col_pos, end - col_pos);
-  response_->headers().emplace(std::move(key), std::move(value));
+  // the value is constructed in place and only for the first occurrence
+  response_->headers().try_emplace(std::string{key}, col_pos, end - col_pos);
 } catch (const std::exception& e) {
   LOG_ERROR() << "Failed to parse header: " << e.what();
 }
@@ -549,7 +612,9 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform() {
 
   auto future = StartNewPromise();
   ApplyTestsuiteConfig();
+  easy_->BindToDestination(easy().get_original_url());
   StartStats();
+  StartBodyStream();
 
   // if we need retries call with special callback
   if (retry_.retries <= 1) {
@@ -586,7 +651,9 @@ void RequestState::async_perform_stream(const std::shared_ptr<Queue>& queue) {
   retry_.retries = 1;  // Force no retries
 
   ApplyTestsuiteConfig();
+  easy_->BindToDestination(easy().get_original_url());
   StartStats();
+  StartBodyStream();
 
   perform_request([holder = shared_from_this()](std::error_code err) mutable {
     RequestState::on_completed(std::move(holder), err);
@@ -599,12 +666,18 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
 
   UASSERT(response_);
   response_->sink_string().clear();
-  response_->body().clear();
 
   UpdateTimeoutFromDeadline();
   SetEasyTimeout(effective_timeout_);
+  std::exception_ptr exc;
   if (effective_timeout_ <= std::chrono::milliseconds{0}) {
-    auto exc = PrepareDeadlineAlreadyPassedException();
+    exc = PrepareDeadlineAlreadyPassedException();
+  } else if (retry_.current == 1 && !ObtainThrottlerPermit()) {
+    // retries are throttled in on_retry
+    exc = PrepareThrottledException();
+  }
+  if (exc) {
+    AbortBodyStream();
 
     std::visit(
         utils::Overloaded{[&exc](FullBufferedData& buffered_data) {
@@ -625,12 +698,14 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
         ResolveTargetAddress(*resolver_);
         easy().async_perform(std::move(handler));
       } catch (const clients::dns::ResolverException& ex) {
+        AbortBodyStream();
         // TODO: should retry - TAXICOMMON-4932
         auto* buffered_data = std::get_if<FullBufferedData>(&data_);
         if (buffered_data) {
           buffered_data->promise_.set_exception(std::current_exception());
         }
       } catch (const BaseException& ex) {
+        AbortBodyStream();
         auto* buffered_data = std::get_if<FullBufferedData>(&data_);
         if (buffered_data) {
           buffered_data->promise_.set_exception(std::current_exception());
@@ -707,9 +782,25 @@ std::exception_ptr RequestState::PrepareDeadlineAlreadyPassedException() {
   }
 }
 
+std::exception_ptr RequestState::PrepareThrottledException() {
+  const auto& url = easy().get_original_url();
+  LOG_LIMITED_WARNING() << "Destination is throttled, not sending a request to "
+                        << url;
+  return std::make_exception_ptr(ThrottledException(
+      fmt::format("Request was throttled, url: {}", url),
+      easy().get_local_stats()));
+}
+
 void RequestState::AccountResponse(std::error_code err) {
   const auto attempts = retry_.current;
 
+  // overloaded backends are expected to time out, shed or fail the requests
+  const auto status_code = static_cast<Status>(easy().get_response_code());
+  if (throttler_ && !err && status_code < Status::InternalServerError &&
+      status_code != Status::TooManyRequests) {
+    throttler_->AccountAccepted();
+  }
+
   const auto time_to_start =
       std::chrono::duration_cast<std::chrono::microseconds>(
           easy().time_to_start());
@@ -856,6 +947,24 @@ void RequestState::WithRequestStats(const Func& func) {
   if (dest_req_stats_) func(*dest_req_stats_);
 }
 
+void RequestState::StartBodyStream() {
+  if (!body_consumer_) return;
+
+  // the body can not be sent twice
+  retry_.retries = 1;
+
+  engine::AsyncNoSpan([body = body_stream_,
+                       consumer = std::move(*body_consumer_),
+                       easy = easy().shared_from_this()]() mutable {
+    body->Pump(std::move(consumer), *easy);
+  }).Detach();
+  body_consumer_.reset();
+}
+
+void RequestState::AbortBodyStream() {
+  if (body_stream_) body_stream_->Abort();
+}
+
 void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
   const auto deadline = engine::Deadline::FromDuration(effective_timeout_);
   auto target = curl::url{};
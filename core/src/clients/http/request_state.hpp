@@ -12,6 +12,7 @@
 #include <userver/clients/http/form.hpp>
 #include <userver/clients/http/response_future.hpp>
 #include <userver/concurrent/queue.hpp>
+#include <userver/congestion_control/client_throttler.hpp>
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
 #include <userver/engine/deadline.hpp>
@@ -25,6 +26,8 @@
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
 #include <clients/http/enforce_task_deadline_config.hpp>
+#include <clients/http/request_body_stream.hpp>
+#include <clients/http/retry_budget.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
 #include <engine/ev/watcher/timer_watcher.hpp>
@@ -40,6 +43,9 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   RequestState(std::shared_ptr<impl::EasyWrapper>&&,
                std::shared_ptr<RequestStats>&& req_stats,
                const std::shared_ptr<DestinationStatistics>& dest_stats,
+               const std::shared_ptr<RetryBudget>& retry_budget,
+               const std::shared_ptr<congestion_control::ClientThrottlers>&
+                   throttlers,
                clients::dns::Resolver* resolver);
   ~RequestState();
 
@@ -78,6 +84,8 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   void proxy(const std::string& value);
   /// sets proxy auth type to use
   void proxy_auth_type(curl::easy::proxyauth_t value);
+  /// set body to be read from the queue while the request is performed
+  void stream_data(const std::shared_ptr<Queue>& queue);
 
   /// get timeout value in milliseconds
   long timeout() const { return original_timeout_.count(); }
@@ -127,6 +135,13 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   /// parse one header
   void parse_header(char* ptr, size_t size);
   void ParseSingleCookie(const char* ptr, size_t size);
+  /// takes a token from the retry budget, false if it is exhausted or the
+  /// destination is throttled
+  bool ObtainRetryToken();
+  /// accounts the first attempt in the throttler of the destination, false if
+  /// the request should be rejected locally
+  bool ObtainThrottlerPermit();
+  std::exception_ptr PrepareThrottledException();
   /// simply run perform_request if there is now errors from timer
   void on_retry_timer(std::error_code err);
   /// run curl async_request
@@ -155,6 +170,9 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   template <typename Func>
   void WithRequestStats(const Func& func);
 
+  void StartBodyStream();
+  void AbortBodyStream();
+
   void ResolveTargetAddress(clients::dns::Resolver& resolver);
   void ScheduleWrite();
   bool IsStreamBody() const;
@@ -167,6 +185,12 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   std::shared_ptr<DestinationStatistics> dest_stats_;
   std::string destination_metric_name_;
 
+  std::shared_ptr<RetryBudget> retry_budget_;
+
+  std::shared_ptr<congestion_control::ClientThrottlers> throttlers_;
+  /// throttler of the destination of the current request, if enabled
+  std::shared_ptr<congestion_control::ClientThrottler> throttler_;
+
   std::shared_ptr<const TestsuiteConfig> testsuite_config_;
   std::vector<std::string> allowed_urls_extra_;
 
@@ -182,6 +206,8 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   /// the timeout, possibly updated by deadline propagation
   std::chrono::milliseconds effective_timeout_;
 
+  /// HTTP/3 with fallback is set, the other responses are the fallbacks
+  bool is_http3_requested_{false};
   bool add_client_timeout_header_{true};
   bool report_timeout_as_cancellation_{false};
   EnforceTaskDeadlineConfig enforce_task_deadline_{};
@@ -199,6 +225,10 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
     std::optional<engine::ev::TimerWatcher> timer;
   } retry_;
 
+  /// streamed request body, if any
+  std::shared_ptr<RequestBodyStream> body_stream_;
+  std::optional<Queue::Consumer> body_consumer_;
+
   std::optional<tracing::InPlaceSpan> span_storage_;
   std::optional<std::string> log_url_;
 
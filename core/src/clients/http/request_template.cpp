@@ -0,0 +1,148 @@
+#include <userver/clients/http/request_template.hpp>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+#include <clients/http/request_template_settings.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+std::string FormatHeaderLine(std::string_view name, std::string_view value) {
+  std::string line;
+  // an empty header is sent as "Name;", the same as Request::headers() does
+  line.reserve(name.size() + value.size() + 2);
+  line.append(name);
+  if (value.empty()) {
+    line += ';';
+  } else {
+    line += ": ";
+    line.append(value);
+  }
+  return line;
+}
+
+template <class Range>
+void AddHeaders(impl::RequestTemplateSettings& settings,
+                const Range& headers_range) {
+  for (const auto& [name, value] : headers_range) {
+    if (utils::StrIcaseEqual{}(name,
+                               USERVER_NAMESPACE::http::headers::kUserAgent)) {
+      settings.user_agent.emplace(value);
+    } else {
+      settings.header_lines.push_back(FormatHeaderLine(name, value));
+    }
+  }
+}
+
+}  // namespace
+
+RequestTemplate::RequestTemplate()
+    : settings_(std::make_shared<impl::RequestTemplateSettings>()) {}
+
+RequestTemplate::RequestTemplate(const RequestTemplate&) noexcept = default;
+
+RequestTemplate::RequestTemplate(RequestTemplate&&) noexcept = default;
+
+RequestTemplate& RequestTemplate::operator=(const RequestTemplate&) noexcept =
+    default;
+
+RequestTemplate& RequestTemplate::operator=(RequestTemplate&&) noexcept =
+    default;
+
+RequestTemplate::~RequestTemplate() = default;
+
+RequestTemplate& RequestTemplate::method(HttpMethod method) {
+  GetMutableSettings().method = method;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::headers(const Headers& headers) {
+  AddHeaders(GetMutableSettings(), headers);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::headers(
+    std::initializer_list<std::pair<std::string_view, std::string_view>>
+        headers) {
+  AddHeaders(GetMutableSettings(), headers);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::user_agent(std::string value) {
+  GetMutableSettings().user_agent = std::move(value);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::proxy(std::string value) {
+  GetMutableSettings().proxy = std::move(value);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::follow_redirects(bool follow) {
+  GetMutableSettings().follow_redirects = follow;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::timeout(std::chrono::milliseconds timeout) {
+  GetMutableSettings().timeout = timeout;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::verify(bool verify) {
+  GetMutableSettings().verify = verify;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::ca_info(std::string file_path) {
+  GetMutableSettings().ca_info = std::move(file_path);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::http_version(HttpVersion version) {
+  GetMutableSettings().http_version = version;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::retry(short retries, bool on_fails) {
+  UASSERT_MSG(retries >= 0, "retires < 0 (" + std::to_string(retries) +
+                                "), uninitialized variable?");
+  auto& settings = GetMutableSettings();
+  settings.retries = retries;
+  settings.retry_on_fails = on_fails;
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::SetDestinationMetricName(
+    std::string destination) {
+  GetMutableSettings().destination_metric_name = std::move(destination);
+  return *this;
+}
+
+RequestTemplate& RequestTemplate::DisableReplyDecoding() {
+  GetMutableSettings().disable_reply_decoding = true;
+  return *this;
+}
+
+const impl::RequestTemplateSettings& RequestTemplate::GetSettings()
+    const noexcept {
+  UASSERT(settings_);
+  return *settings_;
+}
+
+impl::RequestTemplateSettings& RequestTemplate::GetMutableSettings() {
+  UASSERT_MSG(settings_, "RequestTemplate used after move");
+  if (settings_.use_count() != 1) {
+    // copy on write, the other copies may be in use by other tasks
+    settings_ = std::make_shared<impl::RequestTemplateSettings>(*settings_);
+  }
+  return *settings_;
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/clients/http/request_template.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+
+struct RequestTemplateSettings final {
+  std::optional<HttpMethod> method;
+  // formatted "Name: value" lines, the User-Agent is kept in user_agent
+  std::vector<std::string> header_lines;
+  std::optional<std::string> user_agent;
+  std::optional<std::string> proxy;
+  std::optional<bool> follow_redirects;
+  std::optional<std::chrono::milliseconds> timeout;
+  std::optional<bool> verify;
+  std::optional<std::string> ca_info;
+  std::optional<HttpVersion> http_version;
+  std::optional<short> retries;
+  bool retry_on_fails{true};
+  std::optional<std::string> destination_metric_name;
+  bool disable_reply_decoding{false};
+};
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
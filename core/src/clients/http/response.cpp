@@ -24,6 +24,8 @@ std::ostream& operator<<(std::ostream& os, Status s) {
       return os << "404 Not Found";
     case Conflict:
       return os << "409 Conflict";
+    case TooManyRequests:
+      return os << "429 Too Many Requests";
     case InternalServerError:
       return os << "500 Internal Server Error";
     case BadGateway:
@@ -0,0 +1,36 @@
+#include <clients/http/retry_budget.hpp>
+
+#include <chrono>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+std::string_view ExtractDestination(std::string_view url) {
+  const auto scheme_end = url.find("://");
+  const auto authority_start =
+      scheme_end == std::string_view::npos ? 0 : scheme_end + 3;
+  return url.substr(0, url.find_first_of("/?#", authority_start));
+}
+
+RetryBudget::RetryBudget(RetryBudgetSettings settings) : settings_(settings) {}
+
+bool RetryBudget::Obtain(std::string_view url) {
+  if (settings_.max_tokens == 0) return true;
+
+  const std::string destination{ExtractDestination(url)};
+  auto bucket = buckets_.Get(destination);
+  if (!bucket) {
+    bucket = buckets_
+                 .TryEmplace(destination, settings_.max_tokens,
+                             utils::TokenBucket::RefillPolicy{
+                                 settings_.refill_per_second,
+                                 std::chrono::seconds{1}})
+                 .value;
+  }
+  return bucket->Obtain();
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
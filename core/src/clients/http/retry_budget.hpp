@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/token_bucket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+// Returns the scheme and the authority of the URL, i.e. everything that
+// identifies a connection
+std::string_view ExtractDestination(std::string_view url);
+
+class RetryBudget final {
+ public:
+  explicit RetryBudget(RetryBudgetSettings settings);
+
+  // Takes a token for an extra request to the destination of the URL, returns
+  // false if the budget of the destination is exhausted
+  bool Obtain(std::string_view url);
+
+ private:
+  const RetryBudgetSettings settings_;
+  rcu::RcuMap<std::string, utils::TokenBucket> buckets_;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
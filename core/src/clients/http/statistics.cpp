@@ -21,6 +21,22 @@ T SumToMean(T sum, U count) {
 
 }  // namespace
 
+const char* ToString(ResponseHttpVersion version) {
+  switch (version) {
+    case ResponseHttpVersion::k10:
+      return "1.0";
+    case ResponseHttpVersion::k11:
+      return "1.1";
+    case ResponseHttpVersion::k2:
+      return "2";
+    case ResponseHttpVersion::k3:
+      return "3";
+    case ResponseHttpVersion::kCount:
+      break;
+  }
+  return "unknown";
+}
+
 RequestStats::RequestStats(Statistics& stats) : stats_(stats) {
   stats_.easy_handles_++;
 }
@@ -59,6 +75,15 @@ void RequestStats::StoreTimeToStart(
 
 void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_.socket_open_ += sockets;
+  if (sockets == 0) ++stats_.socket_reused_;
+}
+
+void RequestStats::AccountHttpVersion(ResponseHttpVersion version,
+                                      bool is_http3_requested) noexcept {
+  ++stats_.http_versions_[static_cast<std::size_t>(version)];
+  if (is_http3_requested && version != ResponseHttpVersion::k3) {
+    ++stats_.http3_fallbacks_;
+  }
 }
 
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
@@ -131,6 +156,13 @@ void Statistics::AccountError(ErrorGroup error) {
 
 void Statistics::AccountStatus(int code) { reply_status_.Account(code); }
 
+std::optional<std::chrono::milliseconds> Statistics::GetTimingPercentile(
+    double percent, size_t min_count) const {
+  const auto timings = timings_percentile_.GetStatsForPeriod();
+  if (timings.Count() < min_count) return std::nullopt;
+  return std::chrono::milliseconds{timings.GetPercentile(percent)};
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const InstanceStatistics& stats, FormatMode format_mode) {
   writer["timings"] = stats.timings_percentile;
@@ -166,6 +198,16 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 
   writer["sockets"]["open"] = stats.multi.socket_open;
+  // requests that got a kept-alive connection instead of opening a new one
+  writer["sockets"]["reused"] = stats.socket_reused;
+
+  for (std::size_t i = 0; i < Statistics::kHttpVersionCount; ++i) {
+    writer["http-versions"].ValueWithLabels(
+        stats.http_versions[i],
+        {"http_version", ToString(static_cast<ResponseHttpVersion>(i))});
+  }
+  // responses to HTTP/3 requests that came over HTTP/2 or HTTP/1.x
+  writer["http3-fallbacks"] = stats.http3_fallbacks;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -184,11 +226,15 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
       last_time_to_start_us(other.last_time_to_start_us_.load()),
       timings_percentile(other.timings_percentile_.GetStatsForPeriod()),
       retries(other.retries_.load()),
+      socket_reused(other.socket_reused_.load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.load()),
       reply_status(other.reply_status_) {
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].load();
+  for (size_t i = 0; i < http_versions.size(); i++)
+    http_versions[i] = other.http_versions_[i].load();
+  http3_fallbacks = other.http3_fallbacks_.load();
   multi.socket_open = other.socket_open_;
 }
 
@@ -217,6 +263,11 @@ InstanceStatistics& InstanceStatistics::operator+=(
     error_count[i] += stat.error_count[i];
   }
   retries += stat.retries;
+  socket_reused += stat.socket_reused;
+  for (size_t i = 0; i < http_versions.size(); i++) {
+    http_versions[i] += stat.http_versions[i];
+  }
+  http3_fallbacks += stat.http3_fallbacks;
 
   timeout_updated_by_deadline += stat.timeout_updated_by_deadline;
   cancelled_by_deadline += stat.cancelled_by_deadline;
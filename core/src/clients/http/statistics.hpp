@@ -1,7 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -17,6 +19,11 @@ namespace clients::http {
 
 class Statistics;
 
+/// HTTP version of a response
+enum class ResponseHttpVersion { k10, k11, k2, k3, kCount };
+
+const char* ToString(ResponseHttpVersion version);
+
 class RequestStats final {
  public:
   explicit RequestStats(Statistics& stats);
@@ -28,8 +35,14 @@ class RequestStats final {
 
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
+  // Zero sockets means the request has reused a kept-alive connection
   void AccountOpenSockets(size_t sockets) noexcept;
 
+  // The HTTP version of the response, the responses to HTTP/3 requests over
+  // the other versions are the fallbacks
+  void AccountHttpVersion(ResponseHttpVersion version,
+                          bool is_http3_requested) noexcept;
+
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
 
@@ -85,10 +98,18 @@ class Statistics {
 
   static const char* ToString(ErrorGroup error);
 
+  static constexpr auto kHttpVersionCount =
+      static_cast<std::size_t>(ResponseHttpVersion::kCount);
+
   void AccountError(ErrorGroup error);
 
   void AccountStatus(int);
 
+  // Percentile of the recent request timings, nullopt if there are less than
+  // min_count of them
+  std::optional<std::chrono::milliseconds> GetTimingPercentile(
+      double percent, size_t min_count) const;
+
  private:
   std::atomic<uint64_t> easy_handles_{0};
   std::atomic<uint64_t> last_time_to_start_us_{0};
@@ -99,6 +120,9 @@ class Statistics {
       {0, 0, 0, 0, 0, 0, 0}};
   std::atomic_llong retries_{0};
   std::atomic_llong socket_open_{0};
+  std::atomic<std::uint64_t> socket_reused_{0};
+  std::array<std::atomic<std::uint64_t>, kHttpVersionCount> http_versions_{};
+  std::atomic<std::uint64_t> http3_fallbacks_{0};
 
   std::atomic<std::uint64_t> timeout_updated_by_deadline_{0};
   std::atomic<std::uint64_t> cancelled_by_deadline_{0};
@@ -127,6 +151,9 @@ struct InstanceStatistics {
   std::array<uint64_t, Statistics::kErrorGroupCount> error_count{
       {0, 0, 0, 0, 0, 0, 0}};
   uint64_t retries{0};
+  std::uint64_t socket_reused{0};
+  std::array<std::uint64_t, Statistics::kHttpVersionCount> http_versions{};
+  std::uint64_t http3_fallbacks{0};
 
   std::uint64_t timeout_updated_by_deadline{0};
   std::uint64_t cancelled_by_deadline{0};
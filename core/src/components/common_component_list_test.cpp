@@ -5,6 +5,7 @@
 #include <userver/components/run.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>  // for fs::blocking::TempDirectory
 #include <userver/fs/blocking/write.hpp>  // for fs::blocking::RewriteFileContents
+#include <userver/utils/statistics/statsd_exporter.hpp>
 
 #include <components/component_list_test.hpp>
 #include <userver/utest/utest.hpp>
@@ -189,6 +190,14 @@ components_manager:
       fs-task-processor: fs-task-processor
       with-nginx: false
 # /// [Sample system statistics component config]
+# /// [Sample statsd exporter component config]
+# yaml
+    statsd-exporter:
+      host: localhost
+      port: 8125
+      push-interval: 10s
+      full-push-interval: 5m
+# /// [Sample statsd exporter component config]
 config_vars: )" + kConfigVariablesPath + R"(
 )";
 // clang-format on
@@ -203,7 +212,8 @@ TEST_F(ComponentList, Common) {
                   ToString(logging::GetDefaultLoggerLevel())));
 
   components::RunOnce(components::InMemoryConfig{kStaticConfig},
-                      components::CommonComponentList());
+                      components::CommonComponentList()
+                          .Append<components::StatsdExporter>());
 }
 
 USERVER_NAMESPACE_END
@@ -6,10 +6,12 @@
 #include <userver/server/handlers/auth/auth_checker_settings_component.hpp>
 #include <userver/server/handlers/dns_client_control.hpp>
 #include <userver/server/handlers/dynamic_debug_log.hpp>
+#include <userver/server/handlers/inspect_cpu.hpp>
 #include <userver/server/handlers/inspect_requests.hpp>
 #include <userver/server/handlers/jemalloc.hpp>
 #include <userver/server/handlers/log_level.hpp>
 #include <userver/server/handlers/on_log_rotate.hpp>
+#include <userver/server/handlers/sampling_profiler.hpp>
 #include <userver/server/handlers/server_monitor.hpp>
 #include <userver/server/handlers/tests_control.hpp>
 
@@ -23,10 +25,12 @@ ComponentList CommonServerComponentList() {
       .Append<server::handlers::DnsClientControl>()
       .Append<server::handlers::DynamicDebugLog>()
       .Append<server::handlers::ImplicitOptionsHttpHandler>()
+      .Append<server::handlers::InspectCpu>()
       .Append<server::handlers::InspectRequests>()
       .Append<server::handlers::Jemalloc>()
       .Append<server::handlers::LogLevel>()
       .Append<server::handlers::OnLogRotate>()
+      .Append<server::handlers::SamplingProfiler>()
       .Append<server::handlers::ServerMonitor>()
       .Append<server::handlers::TestsControl>()
       .Append<congestion_control::Component>()
@@ -190,6 +190,21 @@ components_manager:
         method: GET
         task_processor: monitor-task-processor
 # /// [Sample handler inspect requests component config]
+# /// [Sample handler inspect cpu component config]
+# yaml
+    handler-inspect-cpu:
+        path: /service/inspect-cpu
+        method: GET
+        task_processor: monitor-task-processor
+# /// [Sample handler inspect cpu component config]
+# /// [Sample handler sampling profiler component config]
+# yaml
+    handler-sampling-profiler:
+        path: /service/sampling-profiler
+        method: GET
+        task_processor: monitor-task-processor
+        sampling-interval: 10ms
+# /// [Sample handler sampling profiler component config]
 # /// [Sample handler implicit http options component config]
 # yaml
     handler-implicit-http-options:
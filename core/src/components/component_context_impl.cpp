@@ -1,6 +1,8 @@
 #include <components/component_context_impl.hpp>
 
 #include <algorithm>
+#include <iterator>
+#include <optional>
 #include <queue>
 
 #include <fmt/format.h>
@@ -12,9 +14,11 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 #include <components/component_context_component_info.hpp>
 #include <components/impl/component_name_from_info.hpp>
+#include <components/manager_config.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -27,6 +31,12 @@ const std::string kClearComponentsRootName = "clear_components";
 
 const std::chrono::seconds kPrintAddingComponentsPeriod{10};
 
+template <typename Duration>
+auto ToMilliseconds(Duration duration) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+      .count();
+}
+
 template <class Container>
 std::string JoinNamesFromInfo(const Container& container,
                               std::string_view separator) {
@@ -77,9 +87,31 @@ ComponentContext::Impl::SearchingComponentScope::~SearchingComponentScope() {
   data->searching_components.erase(component_name_);
 }
 
+ComponentContext::Impl::StartupSlotScope::StartupSlotScope(
+    Impl& context, impl::ComponentNameFromInfo component_name)
+    : context_(context), component_name_(component_name) {
+  const auto start = std::chrono::steady_clock::now();
+  context_.LockStartupSlot();
+  const auto slot_wait_time = std::chrono::steady_clock::now() - start;
+
+  auto data = context_.shared_data_.Lock();
+  auto& timeline = data->startup_timeline[component_name_];
+  timeline.start = start;
+  timeline.slot_wait_time += slot_wait_time;
+}
+
+ComponentContext::Impl::StartupSlotScope::~StartupSlotScope() {
+  context_.UnlockStartupSlot();
+  const auto finish = std::chrono::steady_clock::now();
+
+  auto data = context_.shared_data_.Lock();
+  data->startup_timeline[component_name_].finish = finish;
+}
+
 ComponentContext::Impl::Impl(const Manager& manager,
                              std::vector<std::string>&& loading_component_names)
-    : manager_(manager) {
+    : manager_(manager),
+      startup_start_time_(std::chrono::steady_clock::now()) {
   UASSERT(std::is_sorted(loading_component_names.begin(),
                          loading_component_names.end()));
   UASSERT(std::unique(loading_component_names.begin(),
@@ -102,6 +134,10 @@ ComponentContext::Impl::Impl(const Manager& manager,
     components_.insert(std::move(node));
   }
 
+  if (const auto parallelism = manager_.GetConfig().startup_parallelism) {
+    startup_semaphore_.emplace(parallelism);
+  }
+
   StartPrintAddingComponentsTask();
 }
 
@@ -116,6 +152,7 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
     throw std::runtime_error("trying to add component " + std::string{name} +
                              " multiple times");
 
+  StartupSlotScope startup_slot_scope(*this, component_info.Name());
   component_info.SetComponent(factory(context));
 
   return component_info.GetComponent();
@@ -123,6 +160,7 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
 
 void ComponentContext::Impl::OnAllComponentsLoaded() {
   StopPrintAddingComponentsTask();
+  PrintStartupTimeline();
   tracing::Span span(kOnAllComponentsLoadedRootName);
   return ProcessAllComponentLifetimeStageSwitchings(
       {impl::ComponentLifetimeStage::kRunning,
@@ -332,6 +370,20 @@ impl::ComponentBase* ComponentContext::Impl::DoFindComponent(
   }
   SearchingComponentScope finder(*this, this_component_name);
 
+  // Let the other components start while this one is waiting
+  const auto wait_start = std::chrono::steady_clock::now();
+  UnlockStartupSlot();
+  utils::ScopeGuard relock_startup_slot([&] {
+    const auto dependency_ready = std::chrono::steady_clock::now();
+    LockStartupSlot();
+    const auto slot_ready = std::chrono::steady_clock::now();
+
+    auto data = shared_data_.Lock();
+    auto& timeline = data->startup_timeline[this_component_name];
+    timeline.dependencies_wait_time += dependency_ready - wait_start;
+    timeline.slot_wait_time += slot_ready - dependency_ready;
+  });
+
   return component_info.WaitAndGetComponent();
 }
 
@@ -451,6 +503,71 @@ void ComponentContext::Impl::PrintAddingComponents() const {
              << JoinNamesFromInfo(adding_components, ", ") << ']';
 }
 
+void ComponentContext::Impl::LockStartupSlot() {
+  if (startup_semaphore_) startup_semaphore_->lock_shared();
+}
+
+void ComponentContext::Impl::UnlockStartupSlot() {
+  if (startup_semaphore_) startup_semaphore_->unlock_shared();
+}
+
+void ComponentContext::Impl::PrintStartupTimeline() const {
+  std::vector<std::pair<impl::ComponentNameFromInfo, StartupTimeline>>
+      timeline;
+  {
+    auto data = shared_data_.Lock();
+    timeline.assign(data->startup_timeline.begin(),
+                    data->startup_timeline.end());
+  }
+  if (timeline.empty()) return;
+
+  std::sort(timeline.begin(), timeline.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.second.finish < rhs.second.finish;
+            });
+
+  std::string report;
+  std::unordered_map<impl::ComponentNameFromInfo, const StartupTimeline*>
+      timeline_by_name;
+  for (const auto& [name, times] : timeline) {
+    const auto wait_time = times.slot_wait_time + times.dependencies_wait_time;
+    fmt::format_to(std::back_inserter(report),
+                   "\n  {}: started at {}ms, ready at {}ms, construction {}ms, "
+                   "waiting for dependencies {}ms, waiting for a startup "
+                   "slot {}ms",
+                   name.StringViewName(),
+                   ToMilliseconds(times.start - startup_start_time_),
+                   ToMilliseconds(times.finish - startup_start_time_),
+                   ToMilliseconds(times.finish - times.start - wait_time),
+                   ToMilliseconds(times.dependencies_wait_time),
+                   ToMilliseconds(times.slot_wait_time));
+    timeline_by_name.emplace(name, &times);
+  }
+
+  // The last ready component, its last ready dependency and so on
+  std::vector<impl::ComponentNameFromInfo> critical_path;
+  std::optional<impl::ComponentNameFromInfo> current = timeline.back().first;
+  while (current) {
+    critical_path.push_back(*current);
+    std::optional<impl::ComponentNameFromInfo> slowest_dependency;
+    components_.at(*current).ForEachItDependsOn(
+        [&](impl::ComponentNameFromInfo dependency) {
+          const auto it = timeline_by_name.find(dependency);
+          if (it == timeline_by_name.end()) return;
+          if (!slowest_dependency ||
+              timeline_by_name.at(*slowest_dependency)->finish <
+                  it->second->finish) {
+            slowest_dependency = dependency;
+          }
+        });
+    current = slowest_dependency;
+  }
+
+  LOG_INFO() << "Components startup timeline:" << report
+             << "\nStartup critical path: "
+             << JoinNamesFromInfo(critical_path, " -> ");
+}
+
 }  // namespace components
 
 USERVER_NAMESPACE_END
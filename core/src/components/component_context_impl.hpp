@@ -3,6 +3,8 @@
 #include <userver/components/component_context.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <optional>
 #include <set>
 #include <stdexcept>
 #include <unordered_map>
@@ -12,6 +14,7 @@
 #include <userver/concurrent/variable.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
@@ -77,17 +80,37 @@ struct ComponentContext::Impl {
     impl::ComponentNameFromInfo component_name_;
   };
 
+  // Holds a slot of `startup_parallelism` while the component is constructed
+  class StartupSlotScope final {
+   public:
+    StartupSlotScope(Impl& context, impl::ComponentNameFromInfo component_name);
+    ~StartupSlotScope();
+
+   private:
+    Impl& context_;
+    impl::ComponentNameFromInfo component_name_;
+  };
+
   using ComponentMap =
       std::unordered_map<impl::ComponentNameFromInfo, impl::ComponentInfo>;
 
   enum class DependencyType { kNormal, kInverted };
 
+  struct StartupTimeline {
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point finish;
+    std::chrono::steady_clock::duration slot_wait_time{};
+    std::chrono::steady_clock::duration dependencies_wait_time{};
+  };
+
   struct ProtectedData {
     std::unordered_map<engine::impl::TaskContext*, impl::ComponentNameFromInfo>
         task_to_component_map;
     mutable std::unordered_set<impl::ComponentNameFromInfo>
         searching_components;
     bool print_adding_components_stopped{false};
+    std::unordered_map<impl::ComponentNameFromInfo, StartupTimeline>
+        startup_timeline;
   };
 
   struct ComponentLifetimeStageSwitchingParams {
@@ -139,9 +162,15 @@ struct ComponentContext::Impl {
   void StopPrintAddingComponentsTask();
   void PrintAddingComponents() const;
 
+  void LockStartupSlot();
+  void UnlockStartupSlot();
+  void PrintStartupTimeline() const;
+
   const Manager& manager_;
+  const std::chrono::steady_clock::time_point startup_start_time_;
 
   ComponentMap components_;
+  std::optional<engine::Semaphore> startup_semaphore_;
   std::atomic_flag components_load_cancelled_ ATOMIC_FLAG_INIT;
 
   engine::ConditionVariable print_adding_components_cv_;
@@ -7,6 +7,36 @@ USERVER_NAMESPACE_BEGIN
 
 namespace components {
 
+namespace {
+
+fs::FsCacheCompressionSettings ParseCompressionSettings(
+    const components::ComponentConfig& config) {
+  fs::FsCacheCompressionSettings settings;
+  settings.gzip = config["precompress-gzip"].As<bool>(settings.gzip);
+  settings.gzip_level =
+      config["precompress-gzip-level"].As<int>(settings.gzip_level);
+  settings.min_size =
+      config["precompress-min-size"].As<size_t>(settings.min_size);
+  if (settings.gzip_level < 1 || settings.gzip_level > 9) {
+    throw std::runtime_error(
+        "precompress-gzip-level should be in [1, 9], current value is " +
+        std::to_string(settings.gzip_level));
+  }
+  return settings;
+}
+
+fs::FsCacheStorageSettings ParseStorageSettings(
+    const components::ComponentConfig& config) {
+  fs::FsCacheStorageSettings settings;
+  settings.mmap_min_size =
+      config["mmap-min-size"].As<size_t>(settings.mmap_min_size);
+  settings.watch_changes =
+      config["watch-changes"].As<bool>(settings.watch_changes);
+  return settings;
+}
+
+}  // namespace
+
 const FsCache::Client& FsCache::GetClient() const { return client_; }
 
 FsCache::FsCache(const components::ComponentConfig& config,
@@ -16,7 +46,8 @@ FsCache::FsCache(const components::ComponentConfig& config,
           config["dir"].As<std::string>("/var/www"),
           config["update-period"].As<std::chrono::milliseconds>(0),
           context.GetTaskProcessor(config["fs-task-processor"].As<std::string>(
-              "fs-task-processor"))) {}
+              "fs-task-processor")),
+          ParseCompressionSettings(config), ParseStorageSettings(config)) {}
 
 yaml_config::Schema FsCache::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
@@ -37,6 +68,32 @@ properties:
         type: string
         description: task processor to do filesystem operations
         defaultDescription: fs-task-processor
+    precompress-gzip:
+        type: boolean
+        description: |
+            keep the gzip-compressed variants of the files, taken from the
+            sibling .gz files or compressed on cache update
+        defaultDescription: false
+    precompress-gzip-level:
+        type: integer
+        description: gzip compression level from 1 (fastest) to 9 (smallest)
+        defaultDescription: 9
+    precompress-min-size:
+        type: integer
+        description: files smaller than this are not compressed
+        defaultDescription: 1024
+    mmap-min-size:
+        type: integer
+        description: |
+            files of this size or larger are memory-mapped instead of being
+            copied into memory, 0 disables the mapping
+        defaultDescription: 0
+    watch-changes:
+        type: boolean
+        description: |
+            pick up the changes of the files through inotify instead of the
+            periodic rescans, Linux only
+        defaultDescription: false
 )");
 }
 
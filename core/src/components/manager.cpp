@@ -120,7 +120,7 @@ void Manager::TaskProcessorsStorage::Reset() noexcept {
     task_processor->InitiateShutdown();
   }
   LOG_TRACE() << "Waiting for all coroutines to become idle";
-  while (task_processor_pools_->GetCoroPool().GetStats().active_coroutines) {
+  while (task_processor_pools_->GetCoroPoolStats().active_coroutines) {
     std::this_thread::sleep_for(std::chrono::milliseconds{10});
   }
   LOG_TRACE() << "Stopping task processors";
@@ -293,8 +293,14 @@ void Manager::AddComponents(const ComponentList& component_list) {
   std::vector<engine::TaskWithResult<void>> tasks;
   bool is_load_cancelled = false;
   try {
+    const auto validation_start_time = std::chrono::steady_clock::now();
     ValidateConfigs(component_list, component_config_map,
                     config_->validate_components_configs);
+    LOG_INFO() << "Static configs validated in "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - validation_start_time)
+                      .count()
+               << "ms";
 
     for (const auto& adder : component_list) {
       auto task_name = "boot/" + adder->GetComponentName();
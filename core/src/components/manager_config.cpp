@@ -92,6 +92,24 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            stack_usage_sampling_period:
+                type: integer
+                description: |
+                    measure the stack usage of each Nth coroutine returned
+                    to the pool and report the distribution in statistics
+                defaultDescription: 0 (disabled)
+            stack_release_watermark:
+                type: integer
+                description: |
+                    release the pages of the stacks returned to the pool
+                    that were touched deeper than this many bytes
+                defaultDescription: 0 (disabled)
+            idle_shrink_period:
+                type: string
+                description: |
+                    destroy the idle coroutines above initial_size once the
+                    pool has not run out of coroutines for this long
+                defaultDescription: 0 (disabled)
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -106,7 +124,16 @@ properties:
                 type: boolean
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
-                    or notify ev-loop right away
+                    or notify ev-loop right away. Deferred mode also keeps the
+                    task deadlines of 10ms and more in a per-thread timer wheel
+                    instead of libev timers
+            io_uring:
+                type: boolean
+                description: >
+                    Whether to perform socket I/O via per-thread io_uring
+                    instances instead of epoll readiness notifications
+                    (Linux 5.7+, falls back to epoll if not supported)
+                defaultDescription: false
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +169,72 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-processor-queue:
+                    type: string
+                    description: |
+                        Task queue implementation. `work-stealing-task-queue` gives
+                        each worker a local queue and lets idle workers steal from the
+                        others, which scales better for large worker_threads counts.
+                        `priority-task-queue` serves the tasks by
+                        engine::Task::Priority with starvation protection.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                      - priority-task-queue
+                direct-handoff:
+                    type: boolean
+                    description: |
+                        run a task woken up by another task right after the
+                        current step of the waker on the same worker, skipping
+                        the global task queue
+                    defaultDescription: false
+                cooperative-yield-slice:
+                    type: string
+                    description: |
+                        yield in the library CPU-bound loops, e.g. the JSON
+                        serialization and the cache updates, once a task has
+                        run that long without a context switch
+                    defaultDescription: 0 (disabled)
+                cpu-affinity:
+                    type: string
+                    description: |
+                        CPU list to pin the worker threads to, e.g. `0-7,16-23`
+                    defaultDescription: no pinning
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node of the worker threads. Coroutine stacks are reused
+                        within the node. If `cpu-affinity` is not set, the workers are
+                        pinned to all the CPUs of the node.
+                    defaultDescription: no NUMA binding
+                coro-stack-size:
+                    type: integer
+                    description: |
+                        stack size of the task processor coroutines in bytes, the
+                        coroutines are taken from a separate pool of that size class
+                    defaultDescription: coro_pool.stack_size
+                jemalloc-arena:
+                    type: object
+                    description: |
+                        gives the worker threads a jemalloc arena of their own
+                    defaultDescription: the arenas are shared by all the threads
+                    additionalProperties: false
+                    properties:
+                        tcache:
+                            type: boolean
+                            description: cache the small allocations per thread
+                            defaultDescription: true
+                        dirty-decay:
+                            type: string
+                            description: |
+                                how long the unused dirty pages are kept
+                            defaultDescription: opt.dirty_decay_ms
+                        muzzy-decay:
+                            type: string
+                            description: |
+                                how long the unused muzzy pages are kept
+                            defaultDescription: opt.muzzy_decay_ms
                 task-trace:
                     type: object
                     description: .
@@ -170,6 +263,12 @@ properties:
             validate_all_components:
                 type: boolean
                 description: if true, all components configs are validated
+    startup_parallelism:
+        type: integer
+        description: |
+            max number of components that are constructed concurrently, the
+            components waiting for their dependencies are not counted
+        defaultDescription: 0 (unlimited)
     # TODO: remove
     static_config_validator:
         type: object
@@ -210,6 +309,8 @@ ManagerConfig Parse(const yaml_config::YamlConfig& value,
   config.validate_components_configs =
       value["static_config_validation"].As<ValidationMode>(
           ValidationMode::kOnlyTurnedOn);
+  config.startup_parallelism =
+      value["startup_parallelism"].As<std::size_t>(0);
   return config;
 }
 
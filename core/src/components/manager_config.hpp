@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -23,6 +24,7 @@ struct ManagerConfig {
   std::vector<engine::TaskProcessorConfig> task_processors;
   std::string default_task_processor;
   ValidationMode validate_components_configs{};
+  std::size_t startup_parallelism{0};
 
   yaml_config::YamlConfig source;
 
@@ -18,7 +18,11 @@ components_manager:
     initial_size#fallback: 5000
     max_size: $coro_pool_max_size
     max_size#fallback: 50000
+    stack_usage_sampling_period: 100
+    stack_release_watermark: 32768
+    idle_shrink_period: 60s
   default_task_processor: main-task-processor
+  startup_parallelism: 4
   event_thread_pool:
     threads: $event_threads
     threads#fallback: 2
@@ -29,12 +33,19 @@ components_manager:
       worker_threads: $bg_worker_threads
       worker_threads#fallback: 2
       os-scheduling: low-priority
+      cpu-affinity: 0-1,4
+      numa-node: 0
+      jemalloc-arena:
+        tcache: false
+        dirty-decay: 1s
     fs-task-processor:
       thread_name: fs-worker
       worker_threads: $fs_worker_threads
+      coro-stack-size: 65536
     main-task-processor:
       thread_name: main-worker
       worker_threads: $main_worker_threads
+      task-processor-queue: work-stealing-task-queue
     monitor-task-processor:
       thread_name: mon-worker
       worker_threads: $monitor_worker_threads
@@ -201,7 +212,11 @@ TEST(ManagerConfig, Basic) {
   EXPECT_EQ(mc.default_task_processor, "main-task-processor");
   EXPECT_EQ(mc.coro_pool.max_size, 10000) << "config vars do not work";
   EXPECT_EQ(mc.coro_pool.initial_size, 5000) << "#fallback does not work";
+  EXPECT_EQ(mc.coro_pool.stack_usage_sampling_period, 100);
+  EXPECT_EQ(mc.coro_pool.stack_release_watermark, 32768);
+  EXPECT_EQ(mc.coro_pool.idle_shrink_period, std::chrono::seconds{60});
   EXPECT_EQ(mc.task_processors.size(), 5);
+  EXPECT_EQ(mc.startup_parallelism, 4);
 
   ASSERT_EQ(mc.components.size(), 28);
 
@@ -213,6 +228,58 @@ TEST(ManagerConfig, Basic) {
       [](const auto& conf) { return conf.Name() == "logging-configurator"; }));
 }
 
+TEST(ManagerConfig, TaskProcessorQueue) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& tp : mc.task_processors) {
+    const auto expected = (tp.name == "main-task-processor")
+                              ? engine::TaskQueueType::kWorkStealingTaskQueue
+                              : engine::TaskQueueType::kGlobalTaskQueue;
+    EXPECT_EQ(tp.task_processor_queue, expected) << tp.name;
+  }
+}
+
+TEST(ManagerConfig, TaskProcessorAffinity) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& tp : mc.task_processors) {
+    if (tp.name == "bg-task-processor") {
+      EXPECT_EQ(tp.cpu_affinity, (std::vector<std::size_t>{0, 1, 4}));
+      EXPECT_EQ(tp.numa_node, 0);
+    } else {
+      EXPECT_TRUE(tp.cpu_affinity.empty()) << tp.name;
+      EXPECT_FALSE(tp.numa_node) << tp.name;
+    }
+  }
+}
+
+TEST(ManagerConfig, TaskProcessorCoroStackSize) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& tp : mc.task_processors) {
+    if (tp.name == "fs-task-processor") {
+      EXPECT_EQ(tp.coro_stack_size, 65536);
+    } else {
+      EXPECT_FALSE(tp.coro_stack_size) << tp.name;
+    }
+  }
+}
+
+TEST(ManagerConfig, TaskProcessorJemallocArena) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& tp : mc.task_processors) {
+    if (tp.name == "bg-task-processor") {
+      ASSERT_TRUE(tp.jemalloc_arena);
+      EXPECT_FALSE(tp.jemalloc_arena->tcache);
+      EXPECT_EQ(tp.jemalloc_arena->dirty_decay, std::chrono::seconds{1});
+      EXPECT_FALSE(tp.jemalloc_arena->muzzy_decay);
+    } else {
+      EXPECT_FALSE(tp.jemalloc_arena) << tp.name;
+    }
+  }
+}
+
 TEST(ManagerConfig, HandlerConfig) {
   const auto mc = MakeManagerConfig();
 
@@ -12,6 +12,7 @@
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/utils/statistics/metadata.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,6 +37,7 @@ formats::json::ValueBuilder GetTaskProcessorStats(
   json_tasks["queued"] = queued;
   json_tasks["finished"] = created - current;
   json_tasks["cancelled"] = cancelled;
+  json_tasks["microtasks"] = counter.GetCreatedMicrotasks();
   json_task_processor["tasks"] = std::move(json_tasks);
 
   formats::json::ValueBuilder json_errors(formats::json::Type::kObject);
@@ -56,6 +58,17 @@ formats::json::ValueBuilder GetTaskProcessorStats(
 
   json_task_processor["worker-threads"] = task_processor.GetWorkerCount();
 
+  const auto arena = task_processor.GetJemallocArena();
+  utils::jemalloc::ArenaStats arena_stats;
+  if (arena && !utils::jemalloc::GetArenaStats(*arena, arena_stats)) {
+    formats::json::ValueBuilder json_arena(formats::json::Type::kObject);
+    json_arena["allocated-bytes"] = arena_stats.allocated_bytes;
+    json_arena["active-bytes"] = arena_stats.active_bytes;
+    json_arena["dirty-bytes"] = arena_stats.dirty_bytes;
+    json_arena["muzzy-bytes"] = arena_stats.muzzy_bytes;
+    json_task_processor["jemalloc-arena"] = std::move(json_arena);
+  }
+
   return json_task_processor;
 }
 
@@ -115,21 +128,34 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
   // ev-threads
   {
     formats::json::ValueBuilder json_ev_threads{formats::json::Type::kObject};
+    formats::json::ValueBuilder json_loop_iterations{
+        formats::json::Type::kObject};
+    formats::json::ValueBuilder json_wakeups{formats::json::Type::kObject};
 
     const auto& pools_ptr = components_manager_.GetTaskProcessorPools();
     auto& ev_thread_pool = pools_ptr->EventThreadPool();
     for (auto* thread : ev_thread_pool.NextThreads(ev_thread_pool.GetSize())) {
       json_ev_threads[thread->GetName()] = thread->GetCurrentLoadPercent();
+      const auto thread_stats = thread->GetStats();
+      json_loop_iterations[thread->GetName()] = thread_stats.loop_iterations;
+      json_wakeups[thread->GetName()] = thread_stats.wakeups;
     }
     utils::statistics::SolomonChildrenAreLabelValues(json_ev_threads,
                                                      "ev_thread_name");
+    utils::statistics::SolomonChildrenAreLabelValues(json_loop_iterations,
+                                                     "ev_thread_name");
+    utils::statistics::SolomonChildrenAreLabelValues(json_wakeups,
+                                                     "ev_thread_name");
     engine_data["ev-threads"]["cpu-load-percent"] = std::move(json_ev_threads);
+    engine_data["ev-threads"]["loop-iterations"] =
+        std::move(json_loop_iterations);
+    engine_data["ev-threads"]["wakeups"] = std::move(json_wakeups);
   }
 
   // coroutines
   {
     auto coro_stats =
-        components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+        components_manager_.GetTaskProcessorPools()->GetCoroPoolStats();
     formats::json::ValueBuilder json_coro_pool(formats::json::Type::kObject);
 
     formats::json::ValueBuilder json_coro_stats(formats::json::Type::kObject);
@@ -137,6 +163,27 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
     json_coro_stats["total"] = coro_stats.total_coroutines;
     json_coro_pool["coroutines"] = std::move(json_coro_stats);
 
+    if (coro_stats.max_stack_usage) {
+      using PoolStats = engine::coro::PoolStats;
+      formats::json::ValueBuilder json_stack_usage(
+          formats::json::Type::kObject);
+      for (std::size_t i = 0; i < PoolStats::kStackUsageBuckets; ++i) {
+        const auto bucket_name =
+            (i + 1 == PoolStats::kStackUsageBuckets)
+                ? std::string{"inf"}
+                : std::to_string(PoolStats::GetStackUsageBucketBound(i));
+        json_stack_usage[bucket_name] = coro_stats.stack_usage_samples[i];
+      }
+      utils::statistics::SolomonChildrenAreLabelValues(json_stack_usage,
+                                                       "stack_usage_le");
+      json_coro_pool["stack-usage"]["samples"] = std::move(json_stack_usage);
+      json_coro_pool["stack-usage"]["max-bytes"] = coro_stats.max_stack_usage;
+    }
+    if (coro_stats.idle_stack_resident_bytes) {
+      json_coro_pool["idle-stacks-resident-bytes"] =
+          coro_stats.idle_stack_resident_bytes;
+    }
+
     engine_data["coro-pool"] = std::move(json_coro_pool);
   }
 
@@ -1,10 +1,13 @@
 #include <userver/components/minimal_component_list.hpp>
 
+#include <string_view>
+
 #include <fmt/format.h>
 
 #include <userver/components/run.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <components/component_list_test.hpp>
 #include <userver/utest/utest.hpp>
@@ -25,6 +28,15 @@ const std::string kConfigVariables = fmt::format(
 const std::string kStaticConfig =
     std::string{tests::kMinimalStaticConfig} + kConfigVariablesPath + '\n';
 
+std::string MakeSequentialStartupConfig() {
+  constexpr std::string_view kManager = "components_manager:\n";
+  auto config = kStaticConfig;
+  const auto pos = config.find(kManager);
+  UINVARIANT(pos != std::string::npos, "Unexpected static config");
+  config.insert(pos + kManager.size(), "  startup_parallelism: 1\n");
+  return config;
+}
+
 }  // namespace
 
 TEST_F(ComponentList, Minimal) {
@@ -35,4 +47,13 @@ TEST_F(ComponentList, Minimal) {
                       components::MinimalComponentList());
 }
 
+TEST_F(ComponentList, MinimalSequentialStartup) {
+  fs::blocking::RewriteFileContents(kRuntimeConfingPath, tests::kRuntimeConfig);
+  fs::blocking::RewriteFileContents(kConfigVariablesPath, kConfigVariables);
+
+  // Components waiting for their dependencies release the startup slot
+  components::RunOnce(components::InMemoryConfig{MakeSequentialStartupConfig()},
+                      components::MinimalComponentList());
+}
+
 USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <unistd.h>
 
+#include <chrono>
 #include <csignal>
 #include <cstring>
 #include <variant>
@@ -140,6 +141,7 @@ void DoRun(const PathOrConfig& config,
   LogScope log_scope{init_log_path, format};
 
   LOG_INFO() << "Parsing configs";
+  const auto parse_start_time = std::chrono::steady_clock::now();
   if (config_vars_path) {
     LOG_INFO() << "Using config_vars from cmdline: " << *config_vars_path
                << ". The config_vars filepath in config.yaml is ignored.";
@@ -153,7 +155,11 @@ void DoRun(const PathOrConfig& config,
   auto parsed_config = std::make_unique<ManagerConfig>(std::visit(
       ConfigToManagerVisitor{config_vars_path, config_vars_override_path},
       config));
-  LOG_INFO() << "Parsed configs";
+  LOG_INFO() << "Parsed configs in "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - parse_start_time)
+                    .count()
+             << "ms";
 
   HandleJemallocSettings();
   PreheatStacktraceCollector();
@@ -42,6 +42,72 @@ properties:
           - normal
           - low-priority
           - idle
+    task-processor-queue:
+        type: string
+        description: |
+            Task queue implementation. `work-stealing-task-queue` gives
+            each worker a local queue and lets idle workers steal from the
+            others, which scales better for large worker_threads counts.
+            `priority-task-queue` serves the tasks by
+            engine::Task::Priority with starvation protection.
+        defaultDescription: global-task-queue
+        enum:
+          - global-task-queue
+          - work-stealing-task-queue
+          - priority-task-queue
+    direct-handoff:
+        type: boolean
+        description: |
+            run a task woken up by another task right after the
+            current step of the waker on the same worker, skipping
+            the global task queue
+        defaultDescription: false
+    cooperative-yield-slice:
+        type: string
+        description: |
+            yield in the library CPU-bound loops, e.g. the JSON
+            serialization and the cache updates, once a task has
+            run that long without a context switch
+        defaultDescription: 0 (disabled)
+    cpu-affinity:
+        type: string
+        description: |
+            CPU list to pin the worker threads to, e.g. `0-7,16-23`
+        defaultDescription: no pinning
+    numa-node:
+        type: integer
+        description: |
+            NUMA node of the worker threads. Coroutine stacks are reused
+            within the node. If `cpu-affinity` is not set, the workers are
+            pinned to all the CPUs of the node.
+        defaultDescription: no NUMA binding
+    coro-stack-size:
+        type: integer
+        description: |
+            stack size of the task processor coroutines in bytes, the
+            coroutines are taken from a separate pool of that size class
+        defaultDescription: coro_pool.stack_size
+    jemalloc-arena:
+        type: object
+        description: |
+            gives the worker threads a jemalloc arena of their own
+        defaultDescription: the arenas are shared by all the threads
+        additionalProperties: false
+        properties:
+            tcache:
+                type: boolean
+                description: cache the small allocations per thread
+                defaultDescription: true
+            dirty-decay:
+                type: string
+                description: |
+                    how long the unused dirty pages are kept
+                defaultDescription: opt.dirty_decay_ms
+            muzzy-decay:
+                type: string
+                description: |
+                    how long the unused muzzy pages are kept
+                defaultDescription: opt.muzzy_decay_ms
     task-trace:
         type: object
         description: .
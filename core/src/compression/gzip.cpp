@@ -1,15 +1,24 @@
 #include <compression/gzip.hpp>
 
+#include <stdexcept>
+
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
 constexpr auto kDecompressBufferSize = 1024;
-}
+constexpr auto kCompressBufferSize = 16 * 1024;
+
+// 15 bits of window and +16 for the gzip header and trailer instead of zlib
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
@@ -38,6 +47,55 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::string Compress(std::string_view data, int level) {
+  Compressor compressor{level};
+  auto result = compressor.Compress(data);
+  result += compressor.Finish();
+  return result;
+}
+
+Compressor::Compressor(int level) {
+  UASSERT(level >= Z_BEST_SPEED && level <= Z_BEST_COMPRESSION);
+  if (deflateInit2(&stream_, level, Z_DEFLATED, kGzipWindowBits, kMemLevel,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("failed to initialize gzip compressor");
+  }
+}
+
+Compressor::~Compressor() { deflateEnd(&stream_); }
+
+std::string Compressor::Compress(std::string_view data) {
+  UASSERT(!is_finished_);
+  if (data.empty()) return {};
+  return Deflate(data, Z_SYNC_FLUSH);
+}
+
+std::string Compressor::Finish() {
+  UASSERT(!is_finished_);
+  is_finished_ = true;
+  return Deflate({}, Z_FINISH);
+}
+
+std::string Compressor::Deflate(std::string_view data, int flush) {
+  std::string result;
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_.avail_in = data.size();
+
+  do {
+    const auto offset = result.size();
+    result.resize(offset + kCompressBufferSize);
+    stream_.next_out = reinterpret_cast<Bytef*>(result.data() + offset);
+    stream_.avail_out = kCompressBufferSize;
+    if (deflate(&stream_, flush) == Z_STREAM_ERROR) {
+      throw std::runtime_error("failed to compress data with gzip");
+    }
+    result.resize(offset + kCompressBufferSize - stream_.avail_out);
+  } while (stream_.avail_out == 0);
+
+  UASSERT(stream_.avail_in == 0);
+  return result;
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
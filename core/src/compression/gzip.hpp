@@ -1,7 +1,10 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 
+#include <zlib.h>
+
 #include <compression/error.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +15,33 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string with a zlib compression level from 1 to 9
+std::string Compress(std::string_view data, int level);
+
+/// Streaming gzip compressor, the concatenation of the Compress() outputs
+/// followed by the Finish() output is a single gzip stream.
+class Compressor final {
+ public:
+  explicit Compressor(int level);
+  ~Compressor();
+
+  Compressor(Compressor&&) = delete;
+  Compressor& operator=(Compressor&&) = delete;
+
+  /// Compresses the data and flushes the output, so that everything passed
+  /// so far can be decompressed by the peer
+  std::string Compress(std::string_view data);
+
+  /// Ends the stream, returns the remaining compressed data and the trailer
+  std::string Finish();
+
+ private:
+  std::string Deflate(std::string_view data, int flush);
+
+  z_stream stream_{};
+  bool is_finished_{false};
+};
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
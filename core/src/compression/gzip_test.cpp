@@ -0,0 +1,53 @@
+#include <compression/gzip.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr size_t kMaxSize = 1024 * 1024;
+
+std::string MakeData(size_t size) {
+  std::string data;
+  for (size_t i = 0; data.size() < size; ++i) {
+    data += "line " + std::to_string(i % 100) + "\n";
+  }
+  data.resize(size);
+  return data;
+}
+
+}  // namespace
+
+TEST(Gzip, CompressDecompress) {
+  const auto data = MakeData(100 * 1024);
+  const auto compressed = compression::gzip::Compress(data, 6);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+}
+
+TEST(Gzip, CompressEmpty) {
+  const auto compressed = compression::gzip::Compress({}, 1);
+  EXPECT_FALSE(compressed.empty());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), "");
+}
+
+TEST(Gzip, StreamingCompressor) {
+  const auto data = MakeData(50 * 1024);
+
+  compression::gzip::Compressor compressor{9};
+  std::string compressed;
+  for (size_t pos = 0; pos < data.size(); pos += 1000) {
+    const auto chunk = compressor.Compress(data.substr(pos, 1000));
+    // every chunk is flushed
+    EXPECT_FALSE(chunk.empty());
+    compressed += chunk;
+  }
+  compressed += compressor.Finish();
+
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+}
+
+USERVER_NAMESPACE_END
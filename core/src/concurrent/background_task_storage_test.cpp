@@ -1,10 +1,12 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <vector>
 
 #include <userver/concurrent/background_task_storage.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/inherited_variable.hpp>
@@ -152,6 +154,31 @@ UTEST(BackgroundTaskStorage, CancelAndWait) {
   EXPECT_TRUE(finished);
 }
 
+UTEST_MT(BackgroundTaskStorage, CancelAndWaitFromManyThreads, 4) {
+  constexpr int kTasksPerThread = 50;
+  std::atomic<int> finished{0};
+  concurrent::BackgroundTaskStorage bts;
+
+  std::vector<engine::TaskWithResult<void>> spawners;
+  for (std::size_t i = 0; i < GetThreadCount(); ++i) {
+    spawners.push_back(engine::AsyncNoSpan([&] {
+      for (int j = 0; j < kTasksPerThread; ++j) {
+        bts.AsyncDetach("", [&] {
+          engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+          ++finished;
+        });
+      }
+    }));
+  }
+  for (auto& spawner : spawners) spawner.Get();
+
+  const auto total = static_cast<int>(GetThreadCount()) * kTasksPerThread;
+  EXPECT_EQ(bts.ActiveTasksApprox(), total);
+
+  bts.CancelAndWait();
+  EXPECT_EQ(finished, total);
+}
+
 UTEST(BackgroundTaskStorage, SleepWhileCancelled) {
   concurrent::BackgroundTaskStorageCore bts;
   engine::SingleConsumerEvent event;
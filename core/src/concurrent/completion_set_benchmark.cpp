@@ -0,0 +1,49 @@
+#include <userver/concurrent/completion_set.hpp>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+void completion_set_drain_wait_any(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<int>> tasks;
+      tasks.reserve(state.range(0));
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        tasks.push_back(utils::Async("task", [] { return 1; }));
+      }
+
+      int sum = 0;
+      while (const auto index = engine::WaitAny(tasks)) {
+        sum += tasks[*index].Get();
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  });
+}
+BENCHMARK(completion_set_drain_wait_any)->Range(10, 1000);
+
+void completion_set_drain(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    for (auto _ : state) {
+      concurrent::CompletionSet<int> set;
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        set.Async("task", [] { return 1; });
+      }
+
+      int sum = 0;
+      while (const auto index = set.WaitNext()) sum += set.Get(*index);
+      benchmark::DoNotOptimize(sum);
+    }
+  });
+}
+BENCHMARK(completion_set_drain)->Range(10, 1000);
+
+USERVER_NAMESPACE_END
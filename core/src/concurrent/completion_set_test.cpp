@@ -0,0 +1,96 @@
+#include <userver/concurrent/completion_set.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST_MT(CompletionSet, Sample, 4) {
+  constexpr int kShardsCount = 1000;
+
+  /// [Sample concurrent::CompletionSet usage]
+  concurrent::CompletionSet<int> requests;
+  for (int shard = 0; shard < kShardsCount; ++shard) {
+    requests.Async("shard-request", [shard] { return shard * 2; });
+  }
+
+  int sum = 0;
+  while (const auto index = requests.WaitNext()) {
+    sum += requests.Get(*index);
+  }
+  /// [Sample concurrent::CompletionSet usage]
+
+  EXPECT_EQ(sum, kShardsCount * (kShardsCount - 1));
+  EXPECT_EQ(requests.Size(), kShardsCount);
+  EXPECT_EQ(requests.GetPendingCount(), 0);
+}
+
+UTEST(CompletionSet, CompletionOrder) {
+  concurrent::CompletionSet<int> set;
+  std::vector<engine::SingleConsumerEvent> events(3);
+  for (int i = 0; i < 3; ++i) {
+    set.Async("task", [&events, i] {
+      const bool sent = events[i].WaitForEvent();
+      EXPECT_TRUE(sent);
+      return i;
+    });
+  }
+
+  for (const int i : {2, 0, 1}) {
+    events[i].Send();
+    const auto index = set.WaitNext();
+    ASSERT_TRUE(index);
+    EXPECT_EQ(*index, i);
+    EXPECT_EQ(set.Get(*index), i);
+  }
+  EXPECT_EQ(set.WaitNext(), std::nullopt);
+}
+
+UTEST(CompletionSet, Exception) {
+  concurrent::CompletionSet<void> set;
+  set.Async("failing", [] { throw std::runtime_error("test"); });
+
+  const auto index = set.WaitNext();
+  ASSERT_TRUE(index);
+  UEXPECT_THROW(set.Get(*index), std::runtime_error);
+}
+
+UTEST(CompletionSet, Arguments) {
+  concurrent::CompletionSet<int> set;
+  set.Async("sum", [](int a, int b) { return a + b; }, 1, 2);
+  set.Async(engine::current_task::GetTaskProcessor(), "tp",
+            [](int a) { return a; }, 3);
+
+  int sum = 0;
+  while (const auto index = set.WaitNext()) sum += set.Get(*index);
+  EXPECT_EQ(sum, 6);
+}
+
+UTEST(CompletionSet, Deadline) {
+  concurrent::CompletionSet<void> set;
+  engine::SingleConsumerEvent event;
+  set.Async("waiting", [&event] {
+    const bool sent = event.WaitForEvent();
+    EXPECT_TRUE(sent);
+  });
+
+  EXPECT_EQ(set.WaitNext(engine::Deadline::FromDuration(
+                std::chrono::milliseconds{10})),
+            std::nullopt);
+  EXPECT_EQ(set.GetPendingCount(), 1);
+
+  event.Send();
+  EXPECT_EQ(set.WaitNext(), 0);
+}
+
+UTEST(CompletionSet, DestructorCancels) {
+  concurrent::CompletionSet<void> set;
+  set.Async("infinite",
+            [] { engine::InterruptibleSleepFor(utest::kMaxTestWaitTime); });
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <userver/concurrent/mpsc_queue.hpp>
 #include <userver/concurrent/queue.hpp>
+#include <userver/concurrent/spsc_ring_queue.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/utils/async.hpp>
 
@@ -31,6 +34,32 @@ auto GetConsumerTask(std::shared_ptr<QueueType> queue,
     }
   });
 }
+
+template <typename QueueType>
+auto GetBulkProducerTask(std::shared_ptr<QueueType> queue,
+                         std::atomic<bool>& run, std::size_t batch_size) {
+  return utils::Async(
+      "producer", [producer = queue->GetProducer(), &run, batch_size] {
+        std::vector<std::size_t> batch(batch_size);
+        while (run) {
+          bool res = producer.PushBulk(batch.begin(), batch.size());
+          benchmark::DoNotOptimize(res);
+        }
+      });
+}
+
+template <typename QueueType>
+auto GetBulkConsumerTask(std::shared_ptr<QueueType> queue,
+                         const std::atomic<bool>& run, std::size_t batch_size) {
+  return utils::Async(
+      "consumer", [consumer = queue->GetConsumer(), &run, batch_size] {
+        std::vector<std::size_t> batch(batch_size);
+        while (run) {
+          auto count = consumer.PopBulk(batch.begin(), batch.size());
+          benchmark::DoNotOptimize(count);
+        }
+      });
+}
 }  // namespace
 
 template <typename QueueType>
@@ -87,6 +116,10 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::SpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 1}, {1, 1}, {1'000'000'000, 1'000'000'000}});
 
+BENCHMARK_TEMPLATE(producer_consumer, concurrent::SpscRingQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 1}, {1, 1}, {128, 1024}});
+
 BENCHMARK_TEMPLATE(producer_consumer, concurrent::MpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 1}, {128, 512}});
@@ -95,4 +128,71 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::MpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 1}, {1'000'000'000, 1'000'000'000}});
 
+// Batch processing pipeline: elements are pushed and popped in batches of
+// state.range(2) elements, either one by one (state.range(3) == 0) or with
+// PushBulk and PopBulk
+template <typename QueueType>
+void producer_consumer_batch(benchmark::State& state) {
+  engine::RunStandalone(state.range(0) + state.range(1), [&] {
+    const std::size_t producers_count = state.range(0);
+    const std::size_t consumers_count = state.range(1);
+    const std::size_t batch_size = state.range(2);
+    const bool is_bulk = state.range(3) != 0;
+
+    std::atomic<bool> run{true};
+    auto queue = QueueType::Create(64 * batch_size);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(producers_count + consumers_count - 1);
+    for (std::size_t i = 0; i < producers_count - 1; ++i) {
+      tasks.push_back(is_bulk ? GetBulkProducerTask(queue, run, batch_size)
+                              : GetProducerTask(queue, run));
+    }
+
+    for (std::size_t i = 0; i < consumers_count; ++i) {
+      tasks.push_back(is_bulk ? GetBulkConsumerTask(queue, run, batch_size)
+                              : GetConsumerTask(queue, run));
+    }
+
+    // Current thread work
+    {
+      std::vector<std::size_t> batch(batch_size);
+      auto producer = queue->GetProducer();
+      for (auto _ : state) {
+        if (is_bulk) {
+          bool res = producer.PushBulk(batch.begin(), batch.size());
+          benchmark::DoNotOptimize(res);
+        } else {
+          for (auto& value : batch) {
+            bool res = producer.Push(std::size_t{value});
+            benchmark::DoNotOptimize(res);
+          }
+        }
+      }
+    }
+
+    state.counters["elements"] = benchmark::Counter(
+        state.iterations() * batch_size, benchmark::Counter::kIsRate);
+    run = false;
+  });
+}
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpmcQueue<std::size_t>)
+    ->ArgsProduct({{1, 4}, {1, 4}, {16, 128}, {0, 1}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpscQueue<std::size_t>)
+    ->ArgsProduct({{1, 4}, {1}, {16, 128}, {0, 1}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch, concurrent::SpscQueue<std::size_t>)
+    ->ArgsProduct({{1}, {1}, {16, 128}, {0, 1}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::SpscRingQueue<std::size_t>)
+    ->ArgsProduct({{1}, {1}, {16, 128}, {0, 1}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch, concurrent::MpscQueue<std::size_t>)
+    ->ArgsProduct({{1, 4}, {1}, {16, 128}, {0, 1}});
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/utest/utest.hpp>
 
+#include <vector>
+
 #include <userver/concurrent/mpsc_queue.hpp>
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -251,9 +253,72 @@ TYPED_UTEST_P(TypedQueueFixture, Noblock) {
   consumer_task.Get();
 }
 
+TYPED_UTEST_P(TypedQueueFixture, ConsumeBulk) {
+  auto queue = TypeParam::Create();
+  auto consumer = queue->GetConsumer();
+  auto producer = queue->GetProducer();
+
+  auto constexpr N = 10;
+
+  std::vector<typename TypeParam::ValueType> values;
+  for (int i = 0; i < N; i++) values.push_back(this->Wrap(i));
+  EXPECT_TRUE(producer.PushBulk(values.begin(), N));
+  EXPECT_EQ(N, queue->GetSizeApproximate());
+
+  std::vector<typename TypeParam::ValueType> popped(N);
+  EXPECT_EQ(3, consumer.PopBulk(popped.begin(), 3));
+  EXPECT_EQ(N - 3, queue->GetSizeApproximate());
+  EXPECT_EQ(N - 3, consumer.PopBulk(popped.begin() + 3, N));
+  EXPECT_EQ(0, queue->GetSizeApproximate());
+
+  for (int i = 0; i < N; i++) {
+    EXPECT_EQ(i, this->Unwrap(popped[i]));
+  }
+}
+
+TYPED_UTEST_P(TypedQueueFixture, BlockBulk) {
+  auto queue = TypeParam::Create();
+  queue->SetSoftMaxSize(4);
+
+  auto consumer_task =
+      utils::Async("consumer", [consumer = queue->GetConsumer(), this]() {
+        std::vector<typename TypeParam::ValueType> values(8);
+        std::size_t popped = 0;
+        while (popped < values.size()) {
+          const auto count =
+              consumer.PopBulk(values.begin() + popped, values.size() - popped);
+          ASSERT_NE(count, 0);
+          popped += count;
+        }
+        for (int i = 0; i < 8; i++) {
+          EXPECT_EQ(i, this->Unwrap(values[i]));
+        }
+
+        EXPECT_EQ(0, consumer.PopBulk(values.begin(), values.size()));
+      });
+
+  {
+    auto producer = queue->GetProducer();
+    for (int i = 0; i < 8; i += 2) {
+      std::vector<typename TypeParam::ValueType> values;
+      values.push_back(this->Wrap(i));
+      values.push_back(this->Wrap(i + 1));
+      EXPECT_TRUE(producer.PushBulk(values.begin(), values.size()));
+    }
+
+    // more elements than the queue can hold
+    std::vector<typename TypeParam::ValueType> values(5);
+    EXPECT_FALSE(producer.PushBulk(values.begin(), values.size(),
+                                   engine::Deadline::FromDuration(
+                                       std::chrono::milliseconds{10})));
+  }
+
+  consumer_task.Get();
+}
+
 REGISTER_TYPED_UTEST_SUITE_P(TypedQueueFixture, Ctr, Consume, ConsumeMany,
                              ProducerIsDead, QueueDestroyed, QueueCleanUp,
-                             Block, Noblock);
+                             Block, Noblock, ConsumeBulk, BlockBulk);
 
 TYPED_UTEST_P(QueueFixture, BlockMulti) {
   auto queue = TypeParam::Create();
@@ -0,0 +1,155 @@
+#include <userver/concurrent/pipeline.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kMessageCount = 100;
+
+auto MakeCounter(int count) {
+  return [i = 0, count]() mutable -> std::optional<int> {
+    if (i == count) return std::nullopt;
+    return i++;
+  };
+}
+
+}  // namespace
+
+UTEST_MT(Pipeline, Sample, 4) {
+  /// [Sample concurrent::pipeline usage]
+  auto numbers = concurrent::SpscQueue<int>::Create(16);
+  auto strings = concurrent::SpscQueue<std::string>::Create(16);
+
+  auto source = concurrent::pipeline::StartSource(
+      "source", numbers->GetProducer(), MakeCounter(kMessageCount));
+
+  auto map = concurrent::pipeline::StartParallelMap(
+      "map", numbers->GetConsumer(), strings->GetProducer(), 4,
+      [](int value) { return std::to_string(value); });
+
+  std::vector<std::string> results;
+  auto sink = concurrent::pipeline::StartSink(
+      "sink", strings->GetConsumer(),
+      [&results](std::string value) { results.push_back(std::move(value)); });
+
+  source.Get();
+  map.Get();
+  sink.Get();
+  /// [Sample concurrent::pipeline usage]
+
+  ASSERT_EQ(results.size(), kMessageCount);
+  for (int i = 0; i < kMessageCount; ++i) {
+    EXPECT_EQ(results[i], std::to_string(i));
+  }
+}
+
+UTEST_MT(Pipeline, ParallelMapKeepsOrder, 4) {
+  auto input = concurrent::SpscQueue<int>::Create(8);
+  auto output = concurrent::SpscQueue<int>::Create(8);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+
+  auto source = concurrent::pipeline::StartSource(
+      "source", input->GetProducer(), MakeCounter(kMessageCount));
+  auto map = concurrent::pipeline::StartParallelMap(
+      "map", input->GetConsumer(), output->GetProducer(), 3, [&](int value) {
+        const auto now_running = ++running;
+        if (now_running > max_running) max_running = now_running;
+        // later values finish earlier
+        engine::SleepFor(
+            std::chrono::microseconds{(kMessageCount - value) % 7});
+        --running;
+        return value * 2;
+      });
+
+  auto consumer = output->GetConsumer();
+  int value{};
+  for (int i = 0; i < kMessageCount; ++i) {
+    ASSERT_TRUE(consumer.Pop(value));
+    EXPECT_EQ(value, i * 2);
+  }
+  EXPECT_FALSE(consumer.Pop(value));
+  EXPECT_LE(max_running, 3);
+
+  source.Get();
+  map.Get();
+}
+
+UTEST(Pipeline, MapAndFanIn) {
+  auto input = concurrent::NonFifoMpscQueue<int>::Create(4);
+  auto output = concurrent::SpscQueue<int>::Create(4);
+
+  auto source1 = concurrent::pipeline::StartSource(
+      "source1", input->GetProducer(), MakeCounter(10));
+  auto source2 = concurrent::pipeline::StartSource(
+      "source2", input->GetProducer(), MakeCounter(10));
+  auto map = concurrent::pipeline::StartMap(
+      "map", input->GetConsumer(), output->GetProducer(),
+      [](int value) { return value + 1; });
+
+  int sum = 0;
+  auto sink = concurrent::pipeline::StartSink(
+      "sink", output->GetConsumer(), [&sum](int value) { sum += value; });
+
+  source1.Get();
+  source2.Get();
+  map.Get();
+  sink.Get();
+  EXPECT_EQ(sum, 2 * (1 + 10) * 10 / 2);
+}
+
+UTEST(Pipeline, FailurePropagates) {
+  auto input = concurrent::SpscQueue<int>::Create(4);
+  auto output = concurrent::SpscQueue<int>::Create(4);
+
+  // infinite source
+  auto source = concurrent::pipeline::StartSource(
+      "source", input->GetProducer(),
+      []() -> std::optional<int> { return 42; });
+  auto map = concurrent::pipeline::StartMap(
+      "map", input->GetConsumer(), output->GetProducer(),
+      [i = 0](int value) mutable {
+        if (++i == 10) throw std::runtime_error("map failed");
+        return value;
+      });
+  auto sink = concurrent::pipeline::StartSink("sink", output->GetConsumer(),
+                                              [](int) {});
+
+  // the source stops after the consumer of the failed stage is released,
+  // the sink stops after its producer is released
+  UEXPECT_THROW(map.Get(), std::runtime_error);
+  UEXPECT_NO_THROW(source.Get());
+  UEXPECT_NO_THROW(sink.Get());
+}
+
+UTEST(Pipeline, Cancellation) {
+  auto input = concurrent::SpscQueue<int>::Create(4);
+  auto source = concurrent::pipeline::StartSource(
+      "source", input->GetProducer(),
+      []() -> std::optional<int> { return 42; });
+  auto sink = concurrent::pipeline::StartSink("sink", input->GetConsumer(),
+                                              [](int) { engine::Yield(); });
+
+  engine::SleepFor(10ms);
+  sink.RequestCancel();
+  sink.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(sink.IsFinished());
+
+  source.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(source.IsFinished());
+}
+
+USERVER_NAMESPACE_END
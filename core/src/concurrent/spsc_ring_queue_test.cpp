@@ -0,0 +1,160 @@
+#include <userver/concurrent/spsc_ring_queue.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+constexpr std::size_t kMessageCount = 10000;
+}  // namespace
+
+UTEST(SpscRingQueue, Capacity) {
+  EXPECT_EQ(concurrent::SpscRingQueue<int>::Create(1)->GetCapacity(), 1);
+  EXPECT_EQ(concurrent::SpscRingQueue<int>::Create(5)->GetCapacity(), 8);
+  EXPECT_EQ(concurrent::SpscRingQueue<int>::Create(64)->GetCapacity(), 64);
+}
+
+UTEST(SpscRingQueue, Consume) {
+  auto queue = concurrent::SpscRingQueue<std::unique_ptr<int>>::Create(4);
+  auto consumer = queue->GetConsumer();
+  auto producer = queue->GetProducer();
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(producer.PushNoblock(std::make_unique<int>(i)));
+  }
+  EXPECT_FALSE(producer.PushNoblock(std::make_unique<int>(4)));
+  EXPECT_EQ(queue->GetSizeApproximate(), 4);
+
+  std::unique_ptr<int> value;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(consumer.PopNoblock(value));
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(consumer.PopNoblock(value));
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+}
+
+UTEST(SpscRingQueue, Bulk) {
+  auto queue = concurrent::SpscRingQueue<int>::Create(8);
+  auto consumer = queue->GetConsumer();
+  auto producer = queue->GetProducer();
+
+  // wraps around the end of the buffer
+  for (int round = 0; round < 3; ++round) {
+    std::vector<int> values{1, 2, 3, 4, 5};
+    EXPECT_TRUE(producer.PushBulk(values.begin(), values.size()));
+
+    std::vector<int> popped(8);
+    EXPECT_EQ(consumer.PopBulk(popped.begin(), 2), 2);
+    EXPECT_EQ(consumer.PopBulk(popped.begin() + 2, 8), 3);
+    popped.resize(5);
+    EXPECT_EQ(popped, (std::vector<int>{1, 2, 3, 4, 5}));
+  }
+
+  std::vector<int> too_many(9);
+  EXPECT_FALSE(producer.PushBulk(too_many.begin(), too_many.size()));
+}
+
+UTEST(SpscRingQueue, QueueCleanUp) {
+  auto value = std::make_shared<int>(42);
+  auto queue = concurrent::SpscRingQueue<std::shared_ptr<int>>::Create(4);
+  {
+    auto producer = queue->GetProducer();
+    EXPECT_TRUE(producer.Push(std::shared_ptr{value}));
+    EXPECT_TRUE(producer.Push(std::shared_ptr{value}));
+  }
+  EXPECT_EQ(value.use_count(), 3);
+
+  queue = nullptr;
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+UTEST(SpscRingQueue, ProducerIsDead) {
+  auto queue = concurrent::SpscRingQueue<int>::Create();
+  auto consumer = queue->GetConsumer();
+
+  auto consumer_task = utils::Async("consumer", [&] {
+    int value{};
+    EXPECT_TRUE(consumer.Pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(consumer.Pop(value));
+  });
+
+  {
+    auto producer = queue->GetProducer();
+    engine::Yield();
+    EXPECT_TRUE(producer.Push(1));
+  }
+  consumer_task.Get();
+}
+
+UTEST(SpscRingQueue, ConsumerIsDead) {
+  auto queue = concurrent::SpscRingQueue<int>::Create(1);
+  auto producer = queue->GetProducer();
+  std::optional consumer(queue->GetConsumer());
+
+  EXPECT_TRUE(producer.Push(0));
+  auto producer_task =
+      utils::Async("producer", [&] { EXPECT_FALSE(producer.Push(1)); });
+  engine::Yield();
+  EXPECT_FALSE(producer_task.IsFinished());
+
+  consumer.reset();
+  producer_task.Get();
+  EXPECT_FALSE(producer.PushNoblock(2));
+}
+
+UTEST(SpscRingQueue, Timeout) {
+  auto queue = concurrent::SpscRingQueue<int>::Create(1);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  int value{};
+  EXPECT_FALSE(consumer.Pop(
+      value, engine::Deadline::FromDuration(std::chrono::milliseconds{10})));
+
+  EXPECT_TRUE(producer.Push(1));
+  EXPECT_FALSE(producer.Push(
+      2, engine::Deadline::FromDuration(std::chrono::milliseconds{10})));
+}
+
+UTEST_MT(SpscRingQueue, Spsc, 1 + 1) {
+  auto queue = concurrent::SpscRingQueue<std::size_t>::Create(16);
+
+  auto consumer_task =
+      utils::Async("consumer", [consumer = queue->GetConsumer()] {
+        std::vector<std::size_t> values(5);
+        std::size_t expected = 0;
+        while (const auto count =
+                   consumer.PopBulk(values.begin(), values.size())) {
+          for (std::size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(values[i], expected++);
+          }
+        }
+        EXPECT_EQ(expected, kMessageCount);
+      });
+
+  {
+    auto producer = queue->GetProducer();
+    for (std::size_t message = 0; message < kMessageCount; message += 2) {
+      if (message % 8 == 0) {
+        std::vector<std::size_t> values{message, message + 1};
+        ASSERT_TRUE(producer.PushBulk(values.begin(), values.size()));
+      } else {
+        ASSERT_TRUE(producer.Push(std::size_t{message}));
+        ASSERT_TRUE(producer.Push(std::size_t{message + 1}));
+      }
+    }
+  }
+
+  consumer_task.Get();
+}
+
+USERVER_NAMESPACE_END
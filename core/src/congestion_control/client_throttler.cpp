@@ -0,0 +1,129 @@
+#include <userver/congestion_control/client_throttler.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+namespace {
+
+constexpr std::chrono::seconds kEpochDuration{5};
+constexpr std::chrono::seconds kWindow{120};
+
+// too few requests say nothing about the health of the backend
+constexpr std::uint64_t kMinRequests = 10;
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ClientThrottlerStatistics& stats) {
+  writer["requests"] = stats.requests;
+  writer["accepts"] = stats.accepts;
+  writer["rejected"] = stats.rejected;
+  writer["reject-probability"] = stats.reject_probability;
+}
+
+void ClientThrottler::Counter::Reset() noexcept {
+  requests.store(0, std::memory_order_relaxed);
+  accepts.store(0, std::memory_order_relaxed);
+}
+
+ClientThrottler::Result& ClientThrottler::Result::operator+=(
+    const Counter& counter) noexcept {
+  requests += counter.requests.load(std::memory_order_relaxed);
+  accepts += counter.accepts.load(std::memory_order_relaxed);
+  return *this;
+}
+
+ClientThrottler::ClientThrottler(const ClientThrottlerSettings& settings)
+    : accepts_multiplier_(settings.accepts_multiplier),
+      recent_(kEpochDuration, kWindow) {}
+
+void ClientThrottler::SetSettings(const ClientThrottlerSettings& settings) {
+  accepts_multiplier_.store(settings.accepts_multiplier,
+                            std::memory_order_relaxed);
+}
+
+bool ClientThrottler::Allow() {
+  const auto probability = GetRejectProbability();
+  recent_.GetCurrentCounter().requests.fetch_add(1, std::memory_order_relaxed);
+
+  if (probability <= 0 || utils::RandRange(1.0) >= probability) return true;
+  rejected_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void ClientThrottler::AccountAccepted() noexcept {
+  recent_.GetCurrentCounter().accepts.fetch_add(1, std::memory_order_relaxed);
+}
+
+double ClientThrottler::GetRejectProbability() const {
+  if (accepts_multiplier_.load(std::memory_order_relaxed) <= 0) return 0;
+  return GetRejectProbability(recent_.GetStatsForPeriod(
+      decltype(recent_)::Duration::min(), /*with_current_epoch=*/true));
+}
+
+ClientThrottlerStatistics ClientThrottler::GetStatistics() const {
+  const auto recent = recent_.GetStatsForPeriod(
+      decltype(recent_)::Duration::min(), /*with_current_epoch=*/true);
+  return {
+      recent.requests,
+      recent.accepts,
+      rejected_.load(std::memory_order_relaxed),
+      GetRejectProbability(recent),
+  };
+}
+
+double ClientThrottler::GetRejectProbability(const Result& recent) const {
+  const auto accepts_multiplier =
+      accepts_multiplier_.load(std::memory_order_relaxed);
+  if (accepts_multiplier <= 0 || recent.requests < kMinRequests) return 0;
+
+  const auto requests = static_cast<double>(recent.requests);
+  return std::max(
+      0.0, (requests - accepts_multiplier * static_cast<double>(
+                                                recent.accepts)) /
+               (requests + 1));
+}
+
+ClientThrottlers::ClientThrottlers(const ClientThrottlerSettings& settings)
+    : accepts_multiplier_(settings.accepts_multiplier) {}
+
+void ClientThrottlers::SetSettings(const ClientThrottlerSettings& settings) {
+  accepts_multiplier_.store(settings.accepts_multiplier,
+                            std::memory_order_relaxed);
+  for (const auto& [destination, throttler] : throttlers_) {
+    throttler->SetSettings(settings);
+  }
+}
+
+std::shared_ptr<ClientThrottler> ClientThrottlers::Get(
+    const std::string& destination) {
+  const auto accepts_multiplier =
+      accepts_multiplier_.load(std::memory_order_relaxed);
+  if (accepts_multiplier <= 0) return nullptr;
+
+  auto throttler = throttlers_.Get(destination);
+  if (!throttler) {
+    throttler = throttlers_
+                    .TryEmplace(destination,
+                                ClientThrottlerSettings{accepts_multiplier})
+                    .value;
+  }
+  return throttler;
+}
+
+void ClientThrottlers::DumpStatistics(utils::statistics::Writer& writer,
+                                      std::string_view label) const {
+  for (const auto& [destination, throttler] : throttlers_) {
+    writer.ValueWithLabels(throttler->GetStatistics(), {label, destination});
+  }
+}
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
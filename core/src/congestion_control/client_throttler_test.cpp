@@ -0,0 +1,87 @@
+#include <userver/congestion_control/client_throttler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/mock_now.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr congestion_control::ClientThrottlerSettings kSettings{2};
+
+std::size_t CountAllowed(congestion_control::ClientThrottler& throttler,
+                         std::size_t requests, bool accept) {
+  std::size_t allowed = 0;
+  for (std::size_t i = 0; i < requests; ++i) {
+    if (!throttler.Allow()) continue;
+    ++allowed;
+    if (accept) throttler.AccountAccepted();
+  }
+  return allowed;
+}
+
+}  // namespace
+
+TEST(ClientThrottler, HealthyBackend) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  congestion_control::ClientThrottler throttler{kSettings};
+
+  EXPECT_EQ(CountAllowed(throttler, 1000, true), 1000);
+  EXPECT_DOUBLE_EQ(throttler.GetRejectProbability(), 0);
+
+  const auto stats = throttler.GetStatistics();
+  EXPECT_EQ(stats.requests, 1000);
+  EXPECT_EQ(stats.accepts, 1000);
+  EXPECT_EQ(stats.rejected, 0);
+  utils::datetime::MockNowUnset();
+}
+
+TEST(ClientThrottler, RejectsWhenBackendRejects) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  congestion_control::ClientThrottler throttler{kSettings};
+
+  CountAllowed(throttler, 100, true);
+  // the backend keeps accepting only a part of the requests
+  CountAllowed(throttler, 1000, false);
+  EXPECT_GT(throttler.GetRejectProbability(), 0.5);
+
+  const auto stats = throttler.GetStatistics();
+  EXPECT_EQ(stats.requests, 1100);
+  EXPECT_GT(stats.rejected, 0);
+
+  // accepted requests lower the probability
+  const auto probability = throttler.GetRejectProbability();
+  CountAllowed(throttler, 1000, true);
+  EXPECT_LT(throttler.GetRejectProbability(), probability);
+
+  // the window is over, the backend gets a fresh start
+  utils::datetime::MockSleep(std::chrono::seconds{180});
+  EXPECT_DOUBLE_EQ(throttler.GetRejectProbability(), 0);
+  utils::datetime::MockNowUnset();
+}
+
+TEST(ClientThrottler, Disabled) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  congestion_control::ClientThrottler throttler;
+
+  EXPECT_EQ(CountAllowed(throttler, 100, false), 100);
+  EXPECT_DOUBLE_EQ(throttler.GetRejectProbability(), 0);
+
+  throttler.SetSettings(kSettings);
+  EXPECT_GT(throttler.GetRejectProbability(), 0.9);
+  utils::datetime::MockNowUnset();
+}
+
+TEST(ClientThrottlers, PerDestination) {
+  congestion_control::ClientThrottlers throttlers;
+  EXPECT_EQ(throttlers.Get("http://example.com"), nullptr);
+
+  throttlers.SetSettings(kSettings);
+  const auto first = throttlers.Get("http://example.com");
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(throttlers.Get("http://example.com"), first);
+  EXPECT_NE(throttlers.Get("http://example.org"), first);
+}
+
+USERVER_NAMESPACE_END
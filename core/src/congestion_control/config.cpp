@@ -30,6 +30,17 @@ T ParseNonNegative(const formats::json::Value& json) {
   return value;
 }
 
+template <typename T>
+T ParsePositive(const formats::json::Value& json, T default_value) {
+  if (json.IsMissing()) return default_value;
+  const auto value = json.As<T>();
+  if (value <= 0) {
+    throw std::runtime_error(fmt::format(
+        "Validation 0 < x failed for '{}' (got: {})", json.GetPath(), value));
+  }
+  return value;
+}
+
 }  // namespace
 
 Policy Parse(const formats::json::Value& policy, formats::parse::To<Policy>) {
@@ -48,6 +59,38 @@ Policy Parse(const formats::json::Value& policy, formats::parse::To<Policy>) {
   return p;
 }
 
+GradientPolicy Parse(const formats::json::Value& policy,
+                     formats::parse::To<GradientPolicy>) {
+  const GradientPolicy defaults;
+  GradientPolicy p;
+  p.enabled = policy["enabled"].As<bool>(defaults.enabled);
+  p.initial_limit =
+      ParsePositive<int>(policy["initial-limit"], defaults.initial_limit);
+  p.min_limit = ParsePositive<int>(policy["min-limit"], defaults.min_limit);
+  p.max_limit = ParsePositive<int>(policy["max-limit"], defaults.max_limit);
+  p.window = std::chrono::milliseconds{
+      ParsePositive<int>(policy["window-ms"], defaults.window.count())};
+  p.min_window_samples = ParsePositive<int>(policy["min-window-samples"],
+                                            defaults.min_window_samples);
+  p.rtt_tolerance =
+      ParsePositive<double>(policy["rtt-tolerance"], defaults.rtt_tolerance);
+  p.smoothing = ParsePositive<double>(policy["smoothing"], defaults.smoothing);
+  p.min_rtt_reset_windows = ParsePositive<int>(
+      policy["min-rtt-reset-windows"], defaults.min_rtt_reset_windows);
+
+  if (p.min_limit > p.max_limit) {
+    throw std::runtime_error(
+        fmt::format("Validation min-limit <= max-limit failed for '{}'",
+                    policy.GetPath()));
+  }
+  if (p.rtt_tolerance < 1 || p.smoothing > 1) {
+    throw std::runtime_error(fmt::format(
+        "Validation 1 <= rtt-tolerance and smoothing <= 1 failed for '{}'",
+        policy.GetPath()));
+  }
+  return p;
+}
+
 namespace impl {
 
 RpsCcConfig RpsCcConfig::Parse(const dynamic_config::DocsMap& docs_map) {
@@ -57,6 +100,12 @@ RpsCcConfig RpsCcConfig::Parse(const dynamic_config::DocsMap& docs_map) {
       docs_map.Get("USERVER_RPS_CCONTROL_ACTIVATED_FACTOR_METRIC").As<int>()};
 }
 
+AdaptiveConcurrencyConfig AdaptiveConcurrencyConfig::Parse(
+    const dynamic_config::DocsMap& docs_map) {
+  return {docs_map.Get("USERVER_HANDLER_ADAPTIVE_CONCURRENCY")
+              .As<dynamic_config::ValueDict<GradientPolicy>>()};
+}
+
 }  // namespace impl
 
 }  // namespace congestion_control
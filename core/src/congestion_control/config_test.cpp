@@ -38,4 +38,34 @@ TEST(CongestionControlConfig, Parsing) {
   EXPECT_DOUBLE_EQ(policy.start_limit_factor, 13.5);
 }
 
+TEST(CongestionControlConfig, GradientPolicyParsing) {
+  constexpr std::string_view kPolicyJson = R"(
+    {
+      "enabled": true,
+      "initial-limit": 50,
+      "min-limit": 5,
+      "max-limit": 500,
+      "window-ms": 200,
+      "rtt-tolerance": 2.5
+    }
+  )";
+  const auto policy = formats::json::FromString(kPolicyJson)
+                          .As<congestion_control::GradientPolicy>();
+  const congestion_control::GradientPolicy defaults;
+
+  EXPECT_TRUE(policy.enabled);
+  EXPECT_EQ(policy.initial_limit, 50);
+  EXPECT_EQ(policy.min_limit, 5);
+  EXPECT_EQ(policy.max_limit, 500);
+  EXPECT_EQ(policy.window, std::chrono::milliseconds{200});
+  EXPECT_EQ(policy.min_window_samples, defaults.min_window_samples);
+  EXPECT_DOUBLE_EQ(policy.rtt_tolerance, 2.5);
+  EXPECT_DOUBLE_EQ(policy.smoothing, defaults.smoothing);
+  EXPECT_EQ(policy.min_rtt_reset_windows, defaults.min_rtt_reset_windows);
+
+  EXPECT_ANY_THROW(
+      formats::json::FromString(R"({"min-limit": 10, "max-limit": 5})")
+          .As<congestion_control::GradientPolicy>());
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,162 @@
+#include <congestion_control/gradient_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+namespace {
+
+constexpr double kMinGradient = 0.5;
+
+double ClampLimit(double limit, const GradientPolicy& policy) {
+  return std::clamp(limit, static_cast<double>(policy.min_limit),
+                    static_cast<double>(policy.max_limit));
+}
+
+template <typename T>
+void StoreMax(std::atomic<T>& value, T candidate) noexcept {
+  auto current = value.load(std::memory_order_relaxed);
+  while (current < candidate &&
+         !value.compare_exchange_weak(current, candidate,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const GradientLimiterStatistics& stats) {
+  writer["is-enabled"] = stats.is_enabled ? 1 : 0;
+  writer["limit"] = stats.limit;
+  writer["gradient"] = stats.gradient;
+  writer["min-rtt-us"] = stats.min_rtt.count();
+  writer["window-rtt-us"] = stats.window_rtt.count();
+  writer["rejected"] = stats.rejected;
+}
+
+GradientLimiter::GradientLimiter(const GradientPolicy& policy)
+    : state_(State{policy,
+                   ClampLimit(static_cast<double>(policy.initial_limit),
+                              policy),
+                   std::chrono::microseconds{0}, 0}),
+      window_end_((Clock::now() + policy.window).time_since_epoch().count()) {
+  const auto state = state_.Read();
+  Publish(*state);
+}
+
+void GradientLimiter::SetPolicy(const GradientPolicy& policy) {
+  auto state = state_.StartWrite();
+  if (state->policy.initial_limit != policy.initial_limit) {
+    state->limit = static_cast<double>(policy.initial_limit);
+  }
+  state->limit = ClampLimit(state->limit, policy);
+  state->policy = policy;
+  Publish(*state);
+  state.Commit();
+}
+
+std::optional<std::size_t> GradientLimiter::GetLimit() const noexcept {
+  if (!is_enabled_.load(std::memory_order_relaxed)) return std::nullopt;
+  return limit_.load(std::memory_order_relaxed);
+}
+
+void GradientLimiter::Account(std::chrono::microseconds rtt,
+                              std::size_t in_flight, Clock::time_point now) {
+  window_rtt_sum_us_.fetch_add(rtt.count(), std::memory_order_relaxed);
+  window_samples_.fetch_add(1, std::memory_order_relaxed);
+  StoreMax(window_max_in_flight_, in_flight);
+
+  if (now.time_since_epoch().count() <
+      window_end_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (is_closing_window_.exchange(true, std::memory_order_acquire)) return;
+  const utils::FastScopeGuard closing_guard([this]() noexcept {
+    is_closing_window_.store(false, std::memory_order_release);
+  });
+
+  // might have been closed concurrently
+  if (now.time_since_epoch().count() <
+      window_end_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  CloseWindow(now);
+}
+
+void GradientLimiter::AccountRejected() noexcept {
+  rejected_.fetch_add(1, std::memory_order_relaxed);
+}
+
+GradientLimiterStatistics GradientLimiter::GetStatistics() const {
+  return {
+      is_enabled_.load(std::memory_order_relaxed),
+      limit_.load(std::memory_order_relaxed),
+      gradient_.load(std::memory_order_relaxed),
+      std::chrono::microseconds{min_rtt_us_.load(std::memory_order_relaxed)},
+      std::chrono::microseconds{
+          window_rtt_us_.load(std::memory_order_relaxed)},
+      rejected_.load(std::memory_order_relaxed),
+  };
+}
+
+void GradientLimiter::CloseWindow(Clock::time_point now) {
+  auto state = state_.StartWrite();
+  const auto& policy = state->policy;
+  // too few samples for a meaningful RTT, the window is extended
+  if (window_samples_.load(std::memory_order_relaxed) <
+      policy.min_window_samples) {
+    return;
+  }
+  window_end_.store((now + policy.window).time_since_epoch().count(),
+                    std::memory_order_relaxed);
+
+  // samples that race with the exchanges are accounted in the next window
+  const auto samples = window_samples_.exchange(0, std::memory_order_relaxed);
+  const auto rtt_sum_us =
+      window_rtt_sum_us_.exchange(0, std::memory_order_relaxed);
+  const auto max_in_flight =
+      window_max_in_flight_.exchange(0, std::memory_order_relaxed);
+  if (samples == 0) return;
+
+  const std::chrono::microseconds window_rtt{
+      std::max<std::int64_t>(rtt_sum_us / samples, 1)};
+  if (state->min_rtt.count() == 0 || window_rtt < state->min_rtt ||
+      ++state->windows_since_min_rtt_reset >= policy.min_rtt_reset_windows) {
+    state->min_rtt = window_rtt;
+    state->windows_since_min_rtt_reset = 0;
+  }
+
+  const double gradient = std::clamp(
+      policy.rtt_tolerance * static_cast<double>(state->min_rtt.count()) /
+          static_cast<double>(window_rtt.count()),
+      kMinGradient, 1.0);
+  auto new_limit = state->limit * gradient + std::sqrt(state->limit);
+  if (static_cast<double>(max_in_flight) * 2 < state->limit) {
+    // the load does not reach the limit, so the RTT says nothing about it
+    new_limit = std::min(new_limit, state->limit);
+  }
+  state->limit = ClampLimit(
+      state->limit * (1 - policy.smoothing) + new_limit * policy.smoothing,
+      policy);
+
+  gradient_.store(gradient, std::memory_order_relaxed);
+  window_rtt_us_.store(window_rtt.count(), std::memory_order_relaxed);
+  Publish(*state);
+  state.Commit();
+}
+
+void GradientLimiter::Publish(const State& state) noexcept {
+  is_enabled_.store(state.policy.enabled, std::memory_order_relaxed);
+  limit_.store(std::lround(state.limit), std::memory_order_relaxed);
+  min_rtt_us_.store(state.min_rtt.count(), std::memory_order_relaxed);
+}
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
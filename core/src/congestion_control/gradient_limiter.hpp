@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <userver/congestion_control/config.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+struct GradientLimiterStatistics {
+  bool is_enabled{false};
+  std::size_t limit{0};
+  double gradient{1};
+  std::chrono::microseconds min_rtt{0};
+  std::chrono::microseconds window_rtt{0};
+  std::uint64_t rejected{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const GradientLimiterStatistics& stats);
+
+/// @brief Adaptive concurrency limit that tracks the RTT of the requests.
+///
+/// Once per window the average RTT of the window is compared with the minimal
+/// observed RTT. While they stay close the limit grows by its square root, when
+/// the requests start queueing and the RTT grows the limit is multiplied by
+/// the `tolerance * min_rtt / window_rtt` gradient, so the load is shed before
+/// the queues build up.
+///
+/// Thread safe. GetLimit() is wait-free, Account() is wait-free except for
+/// the single request that closes the window.
+class GradientLimiter final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit GradientLimiter(const GradientPolicy& policy = {});
+
+  /// Applies the new policy, the limit is reset if the initial one changes
+  void SetPolicy(const GradientPolicy& policy);
+
+  /// The limit of the concurrent requests if enforced
+  std::optional<std::size_t> GetLimit() const noexcept;
+
+  /// Accounts the RTT of a finished request and the number of requests that
+  /// were in flight along with it
+  void Account(std::chrono::microseconds rtt, std::size_t in_flight,
+               Clock::time_point now = Clock::now());
+
+  void AccountRejected() noexcept;
+
+  GradientLimiterStatistics GetStatistics() const;
+
+ private:
+  struct State {
+    GradientPolicy policy;
+    double limit{0};
+    std::chrono::microseconds min_rtt{0};
+    std::size_t windows_since_min_rtt_reset{0};
+  };
+
+  void CloseWindow(Clock::time_point now);
+  void Publish(const State& state) noexcept;
+
+  rcu::Variable<State> state_;
+
+  std::atomic<bool> is_enabled_{false};
+  std::atomic<std::size_t> limit_{0};
+  std::atomic<double> gradient_{1};
+  std::atomic<std::int64_t> min_rtt_us_{0};
+  std::atomic<std::int64_t> window_rtt_us_{0};
+  std::atomic<std::uint64_t> rejected_{0};
+
+  // samples of the current window
+  std::atomic<Clock::rep> window_end_;
+  std::atomic<std::int64_t> window_rtt_sum_us_{0};
+  std::atomic<std::size_t> window_samples_{0};
+  std::atomic<std::size_t> window_max_in_flight_{0};
+  std::atomic<bool> is_closing_window_{false};
+};
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
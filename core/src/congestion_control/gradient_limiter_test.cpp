@@ -0,0 +1,101 @@
+#include <congestion_control/gradient_limiter.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Clock = congestion_control::GradientLimiter::Clock;
+
+congestion_control::GradientPolicy MakePolicy() {
+  congestion_control::GradientPolicy policy;
+  policy.enabled = true;
+  policy.initial_limit = 100;
+  policy.min_limit = 10;
+  policy.max_limit = 1000;
+  policy.window = std::chrono::milliseconds{100};
+  policy.min_window_samples = 10;
+  policy.smoothing = 1;
+  return policy;
+}
+
+// Fills the current window with the samples and closes it
+void FeedWindow(congestion_control::GradientLimiter& limiter,
+                Clock::time_point& now, std::chrono::microseconds rtt,
+                std::size_t in_flight) {
+  for (int i = 0; i < 20; ++i) limiter.Account(rtt, in_flight, now);
+  now += std::chrono::milliseconds{100};
+  limiter.Account(rtt, in_flight, now);
+}
+
+}  // namespace
+
+UTEST(GradientLimiter, Disabled) {
+  auto policy = MakePolicy();
+  policy.enabled = false;
+  congestion_control::GradientLimiter limiter{policy};
+
+  EXPECT_EQ(limiter.GetLimit(), std::nullopt);
+  EXPECT_EQ(limiter.GetStatistics().limit, 100);
+
+  policy.enabled = true;
+  limiter.SetPolicy(policy);
+  EXPECT_EQ(limiter.GetLimit(), 100);
+}
+
+UTEST(GradientLimiter, GrowsWhileRttIsStable) {
+  congestion_control::GradientLimiter limiter{MakePolicy()};
+  auto now = Clock::now();
+
+  FeedWindow(limiter, now, std::chrono::milliseconds{10}, 100);
+  const auto first_limit = limiter.GetLimit().value();
+  EXPECT_GT(first_limit, 100);
+
+  FeedWindow(limiter, now, std::chrono::milliseconds{10}, first_limit);
+  EXPECT_GT(limiter.GetLimit().value(), first_limit);
+  EXPECT_DOUBLE_EQ(limiter.GetStatistics().gradient, 1);
+  EXPECT_EQ(limiter.GetStatistics().min_rtt, std::chrono::milliseconds{10});
+}
+
+UTEST(GradientLimiter, ShrinksWhenRttGrows) {
+  congestion_control::GradientLimiter limiter{MakePolicy()};
+  auto now = Clock::now();
+
+  FeedWindow(limiter, now, std::chrono::milliseconds{10}, 100);
+  const auto stable_limit = limiter.GetLimit().value();
+
+  FeedWindow(limiter, now, std::chrono::milliseconds{30}, stable_limit);
+  const auto stats = limiter.GetStatistics();
+  EXPECT_DOUBLE_EQ(stats.gradient, 0.5);
+  EXPECT_EQ(stats.window_rtt, std::chrono::milliseconds{30});
+  EXPECT_LT(limiter.GetLimit().value(), stable_limit);
+
+  for (int i = 0; i < 20; ++i) {
+    FeedWindow(limiter, now, std::chrono::milliseconds{30}, 1000);
+  }
+  EXPECT_EQ(limiter.GetLimit(), 10);
+}
+
+UTEST(GradientLimiter, NoGrowthWithoutLoad) {
+  congestion_control::GradientLimiter limiter{MakePolicy()};
+  auto now = Clock::now();
+
+  FeedWindow(limiter, now, std::chrono::milliseconds{10}, 5);
+  EXPECT_EQ(limiter.GetLimit(), 100);
+}
+
+UTEST(GradientLimiter, WaitsForEnoughSamples) {
+  congestion_control::GradientLimiter limiter{MakePolicy()};
+  const auto now = Clock::now() + std::chrono::milliseconds{100};
+
+  limiter.Account(std::chrono::milliseconds{10}, 100, now);
+  EXPECT_EQ(limiter.GetLimit(), 100);
+
+  for (int i = 0; i < 10; ++i) {
+    limiter.Account(std::chrono::milliseconds{10}, 100, now);
+  }
+  EXPECT_GT(limiter.GetLimit().value(), 100);
+}
+
+USERVER_NAMESPACE_END
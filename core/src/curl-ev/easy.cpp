@@ -9,6 +9,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <utility>
 
 #include <curl-ev/easy.hpp>
@@ -34,6 +35,9 @@ USERVER_NAMESPACE_BEGIN
 namespace curl {
 namespace {
 
+// a bogus Content-Length can not make the client allocate more at once
+constexpr std::size_t kMaxReservedBodySize = 128 * 1024 * 1024;
+
 bool IsHeaderMatchingName(std::string_view header, std::string_view name) {
   return header.size() > name.size() &&
          utils::StrIcaseEqual()(header.substr(0, name.size()), name) &&
@@ -138,6 +142,26 @@ std::shared_ptr<easy> easy::GetBoundBlocking(multi& multi_handle) const {
   return std::make_shared<easy>(cloned, &multi_handle);
 }
 
+void easy::SetMulti(multi& multi_handle) {
+  UASSERT(!multi_registered_);
+  multi_ = &multi_handle;
+}
+
+bool easy::is_http3_supported() noexcept {
+#if LIBCURL_VERSION_NUM >= 0x074200
+  static const bool kIsSupported = [] {
+    const auto* info = native::curl_version_info(native::CURLVERSION_NOW);
+    // earlier versions fail instead of falling back to HTTP/2 or HTTP/1.1
+    constexpr unsigned kMinVersionWithFallback = 0x075800;
+    return info && (info->features & CURL_VERSION_HTTP3) &&
+           info->version_num >= kMinVersionWithFallback;
+  }();
+  return kIsSupported;
+#else
+  return false;
+#endif
+}
+
 easy* easy::from_native(native::CURL* native_easy) {
   easy* easy_handle = nullptr;
   native::curl_easy_getinfo(native_easy, native::CURLINFO_PRIVATE,
@@ -234,6 +258,7 @@ void easy::reset() {
   orig_url_str_.clear();
   std::string{}.swap(post_fields_);  // forced memory freeing
   form_.reset();
+  body_reader_ = {};
   if (headers_) headers_->clear();
   if (proxy_headers_) proxy_headers_->clear();
   if (http200_aliases_) http200_aliases_->clear();
@@ -285,6 +310,31 @@ void easy::set_source(std::shared_ptr<std::istream> source,
   if (!ec) set_seek_data(this, ec);
 }
 
+void easy::set_body_reader(body_reader_t body_reader) {
+  std::error_code ec;
+  set_body_reader(std::move(body_reader), ec);
+  throw_error(ec, "set_body_reader");
+}
+
+void easy::set_body_reader(body_reader_t body_reader, std::error_code& ec) {
+  body_reader_ = std::move(body_reader);
+  std::string{}.swap(post_fields_);
+  set_post_fields(nullptr, ec);
+  if (!ec) set_post(true, ec);
+  // unknown size, chunked transfer encoding for HTTP/1.1
+  if (!ec) set_post_field_size_large(-1, ec);
+  if (!ec) set_read_function(&easy::read_function, ec);
+  if (!ec) set_read_data(this, ec);
+}
+
+void easy::unpause_read() {
+  if (!multi_) return;
+  multi_->GetThreadControl().RunInEvLoopAsync([self = shared_from_this()] {
+    // a no-op if the transfer is not paused
+    native::curl_easy_pause(self->handle_, CURLPAUSE_CONT);
+  });
+}
+
 void easy::set_sink(std::string* sink) {
   std::error_code ec;
   set_sink(sink, ec);
@@ -439,6 +489,18 @@ void easy::add_header(const std::string& header, std::error_code& ec) {
   add_header(header.c_str(), ec);
 }
 
+void easy::add_headers(const std::vector<std::string>& headers) {
+  if (headers.empty()) return;
+  if (!headers_) {
+    headers_ = std::make_shared<string_list>();
+  }
+
+  for (const auto& header : headers) headers_->add(header);
+  std::error_code ec{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
+      handle_, native::CURLOPT_HTTPHEADER, headers_->native_handle()))};
+  throw_error(ec, "add_headers");
+}
+
 void easy::set_headers(std::shared_ptr<string_list> headers) {
   std::error_code ec;
   set_headers(std::move(headers), ec);
@@ -601,7 +663,9 @@ void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   }
 }
 
-bool easy::has_post_data() const { return !post_fields_.empty() || form_; }
+bool easy::has_post_data() const {
+  return !post_fields_.empty() || form_ || body_reader_;
+}
 
 const std::string& easy::get_post_data() const { return post_fields_; }
 
@@ -674,7 +738,20 @@ size_t easy::write_function(char* ptr, size_t size, size_t nmemb,
   }
 
   try {
-    self->sink_->append(ptr, actual_size);
+    auto& sink = *self->sink_;
+    if (sink.empty()) {
+      // the first chunk of a body, growing the string chunk by chunk copies
+      // a big body several times
+      native::curl_off_t content_length = -1;
+      if (native::curl_easy_getinfo(
+              self->handle_, native::CURLINFO_CONTENT_LENGTH_DOWNLOAD_T,
+              &content_length) == native::CURLE_OK &&
+          content_length > 0) {
+        sink.reserve(std::min(static_cast<std::size_t>(content_length),
+                              kMaxReservedBodySize));
+      }
+    }
+    sink.append(ptr, actual_size);
   } catch (const std::exception&) {
     // out of memory
     return 0;
@@ -690,6 +767,15 @@ size_t easy::read_function(void* ptr, size_t size, size_t nmemb,
   easy* self = static_cast<easy*>(userdata);
   size_t actual_size = size * nmemb;
 
+  if (self->body_reader_) {
+    try {
+      return self->body_reader_(static_cast<char*>(ptr), actual_size);
+    } catch (const std::exception& ex) {
+      LOG_LIMITED_WARNING() << "Body reader failed: " << ex;
+      return CURL_READFUNC_ABORT;
+    }
+  }
+
   if (!self->source_) return CURL_READFUNC_ABORT;
 
   if (self->source_->eof()) {
@@ -170,6 +170,10 @@ class easy final : public std::enable_shared_from_this<easy> {
 
   const multi* GetMulti() const { return multi_; }
 
+  // Moves the handle to another multi, must only be called while no
+  // operation is in progress.
+  void SetMulti(multi& multi_handle);
+
   inline native::CURL* native_handle() { return handle_; }
   engine::ev::ThreadControl& GetThreadControl();
 
@@ -183,6 +187,16 @@ class easy final : public std::enable_shared_from_this<easy> {
   void set_sink(std::string* sink);
   void set_sink(std::string* sink, std::error_code& ec);
 
+  // Reads the body of a POST-like request chunk by chunk in the libev thread.
+  // Returns the number of bytes written into the buffer, 0 at the end of the
+  // body or CURL_READFUNC_PAUSE if there is no data yet, see unpause_read().
+  using body_reader_t = std::function<size_t(char* buffer, size_t size)>;
+  void set_body_reader(body_reader_t body_reader);
+  void set_body_reader(body_reader_t body_reader, std::error_code& ec);
+  // Resumes the transfer paused by the body reader, may be called from any
+  // thread
+  void unpause_read();
+
   using progress_callback_t =
       std::function<bool(native::curl_off_t dltotal, native::curl_off_t dlnow,
                          native::curl_off_t ultotal, native::curl_off_t ulnow)>;
@@ -423,6 +437,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   void add_header(const char* header, std::error_code& ec);
   void add_header(const std::string& header);
   void add_header(const std::string& header, std::error_code& ec);
+  // Adds the formatted "Name: value" lines with a single curl_easy_setopt
+  void add_headers(const std::vector<std::string>& headers);
   void set_headers(std::shared_ptr<string_list> headers);
   void set_headers(std::shared_ptr<string_list> headers, std::error_code& ec);
   std::optional<std::string_view> FindHeaderByName(std::string_view name) const;
@@ -457,7 +473,13 @@ class easy final : public std::enable_shared_from_this<easy> {
     http_vertion_2tls = native::CURL_HTTP_VERSION_2TLS,
     http_version_2_prior_knowledge =
         native::CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE,
+#if LIBCURL_VERSION_NUM >= 0x074200
+    http_version_3 = native::CURL_HTTP_VERSION_3,
+#endif
   };
+  // Whether the runtime libcurl has HTTP/3 and falls back from it to the
+  // older versions on failures, that is libcurl 7.88.0 or newer
+  static bool is_http3_supported() noexcept;
   IMPLEMENT_CURL_OPTION_ENUM(set_http_version, native::CURLOPT_HTTP_VERSION,
                              http_version_t, long);
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_ignore_content_length,
@@ -778,6 +800,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   url url_;
   handler_type handler_;
   std::shared_ptr<std::istream> source_;
+  body_reader_t body_reader_;
   std::string* sink_{nullptr};
   std::string post_fields_;
   std::shared_ptr<form> form_;
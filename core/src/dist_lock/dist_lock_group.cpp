@@ -0,0 +1,145 @@
+#include <userver/dist_lock/dist_lock_group.hpp>
+
+#include <stdexcept>
+#include <unordered_set>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+class DistLockGroup::LockStrategy final : public DistLockStrategyBase {
+ public:
+  LockStrategy(DistLockGroup& group, std::string lock_name)
+      : group_(group), lock_name_(std::move(lock_name)) {}
+
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override {
+    group_.Acquire(lock_name_, locker_id, lock_ttl);
+  }
+
+  void Release(const std::string& locker_id) override {
+    group_.strategy_->Release(lock_name_, locker_id);
+  }
+
+ private:
+  DistLockGroup& group_;
+  const std::string lock_name_;
+};
+
+DistLockGroup::DistLockGroup(
+    std::shared_ptr<DistLockGroupStrategyBase> strategy,
+    const DistLockGroupSettings& settings,
+    engine::TaskProcessor* task_processor)
+    : strategy_(std::move(strategy)), settings_(settings) {
+  UASSERT(strategy_);
+  batcher_task_ = engine::CriticalAsyncNoSpan(
+      task_processor ? *task_processor
+                     : engine::current_task::GetTaskProcessor(),
+      &DistLockGroup::Run, this);
+}
+
+DistLockGroup::~DistLockGroup() { batcher_task_.SyncCancel(); }
+
+std::shared_ptr<DistLockStrategyBase> DistLockGroup::GetLockStrategy(
+    std::string lock_name) {
+  return std::make_shared<LockStrategy>(*this, std::move(lock_name));
+}
+
+std::size_t DistLockGroup::GetBatchesCount() const noexcept {
+  return batches_count_.load();
+}
+
+void DistLockGroup::Acquire(std::string lock_name, std::string locker_id,
+                            std::chrono::milliseconds lock_ttl) {
+  engine::Promise<void> promise;
+  auto future = promise.get_future();
+  {
+    std::lock_guard<engine::Mutex> lock(pending_mutex_);
+    pending_.push_back(
+        {{std::move(lock_name), std::move(locker_id), lock_ttl},
+         std::move(promise)});
+  }
+  pending_event_.Send();
+  future.get();
+}
+
+void DistLockGroup::Run() {
+  std::vector<PendingRequest> batch;
+  while (pending_event_.WaitForEvent()) {
+    engine::InterruptibleSleepFor(settings_.max_batch_delay);
+    if (engine::current_task::ShouldCancel()) break;
+
+    {
+      std::lock_guard<engine::Mutex> lock(pending_mutex_);
+      batch.swap(pending_);
+    }
+    SendBatch(batch);
+    batch.clear();
+  }
+}
+
+void DistLockGroup::SendBatch(std::vector<PendingRequest>& batch) {
+  if (batch.empty()) return;
+
+  // a backend cannot lock the same key twice in a single statement, so the
+  // contenders for a lock that is already in the batch wait for the next one
+  std::unordered_set<std::string> lock_names;
+  std::vector<PendingRequest> current;
+  std::vector<PendingRequest> postponed;
+  current.reserve(batch.size());
+  for (auto& pending : batch) {
+    auto& target =
+        lock_names.insert(pending.request.lock_name).second ? current
+                                                            : postponed;
+    target.push_back(std::move(pending));
+  }
+  if (!postponed.empty()) {
+    {
+      std::lock_guard<engine::Mutex> lock(pending_mutex_);
+      pending_.insert(pending_.begin(),
+                      std::make_move_iterator(postponed.begin()),
+                      std::make_move_iterator(postponed.end()));
+    }
+    pending_event_.Send();
+  }
+
+  std::vector<DistLockGroupStrategyBase::LockRequest> requests;
+  requests.reserve(current.size());
+  for (const auto& pending : current) requests.push_back(pending.request);
+
+  ++batches_count_;
+  std::vector<bool> results;
+  try {
+    results = strategy_->AcquireBatch(requests);
+    if (results.size() != requests.size()) {
+      throw std::logic_error(
+          "AcquireBatch returned " + std::to_string(results.size()) +
+          " results for " + std::to_string(requests.size()) + " requests");
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Batched lock acquisition of " << requests.size()
+                  << " locks failed: " << ex;
+    const auto exception = std::current_exception();
+    for (auto& pending : current) pending.promise.set_exception(exception);
+    return;
+  }
+
+  for (std::size_t i = 0; i < current.size(); ++i) {
+    if (results[i]) {
+      current[i].promise.set_value();
+    } else {
+      current[i].promise.set_exception(
+          std::make_exception_ptr(LockIsAcquiredByAnotherHostException{}));
+    }
+  }
+}
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
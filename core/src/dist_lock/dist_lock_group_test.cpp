@@ -0,0 +1,183 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/dist_lock/dist_lock_group.hpp>
+#include <userver/dist_lock/dist_locked_worker.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kAttemptInterval{10};
+constexpr std::chrono::milliseconds kLockTtl{200};
+
+dist_lock::DistLockSettings MakeSettings() {
+  return {kAttemptInterval, kAttemptInterval, kLockTtl, kAttemptInterval,
+          kAttemptInterval};
+}
+
+class MockGroupStrategy final : public dist_lock::DistLockGroupStrategyBase {
+ public:
+  std::vector<bool> AcquireBatch(
+      const std::vector<LockRequest>& requests) override {
+    if (!allowed_) throw std::runtime_error("not allowed");
+
+    auto locks = locks_.Lock();
+    std::vector<bool> results;
+    results.reserve(requests.size());
+    for (const auto& request : requests) {
+      EXPECT_EQ(request.lock_ttl, kLockTtl);
+      auto& owner = (*locks)[request.lock_name];
+      if (owner.empty()) owner = request.locker_id;
+      results.push_back(owner == request.locker_id);
+    }
+    max_batch_size_ = std::max(max_batch_size_.load(), requests.size());
+    return results;
+  }
+
+  void Release(const std::string& lock_name,
+               const std::string& locker_id) override {
+    auto locks = locks_.Lock();
+    auto& owner = (*locks)[lock_name];
+    if (owner == locker_id) owner.clear();
+  }
+
+  std::size_t GetLockedCount() {
+    auto locks = locks_.Lock();
+    return std::count_if(locks->begin(), locks->end(),
+                         [](const auto& lock) { return !lock.second.empty(); });
+  }
+
+  void Allow(bool allowed) { allowed_ = allowed; }
+
+  std::size_t GetMaxBatchSize() const { return max_batch_size_; }
+
+ private:
+  concurrent::Variable<std::unordered_map<std::string, std::string>> locks_;
+  std::atomic<bool> allowed_{true};
+  std::atomic<std::size_t> max_batch_size_{0};
+};
+
+template <typename Pred>
+bool PollUntil(Pred pred) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!pred()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(kAttemptInterval);
+  }
+  return true;
+}
+
+void WaitForCancellation() {
+  while (!engine::current_task::ShouldCancel()) {
+    engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+  }
+}
+
+}  // namespace
+
+UTEST_MT(DistLockGroup, ManyWorkers, 4) {
+  constexpr std::size_t kWorkersCount = 50;
+  auto strategy = std::make_shared<MockGroupStrategy>();
+
+  /// [Sample distlock group]
+  dist_lock::DistLockGroup group{strategy};
+
+  std::atomic<std::size_t> working{0};
+  std::vector<std::unique_ptr<dist_lock::DistLockedWorker>> workers;
+  for (std::size_t i = 0; i < kWorkersCount; ++i) {
+    const auto shard = "shard-" + std::to_string(i);
+    workers.push_back(std::make_unique<dist_lock::DistLockedWorker>(
+        shard,
+        [&working] {
+          ++working;
+          WaitForCancellation();
+          --working;
+        },
+        group.GetLockStrategy(shard), MakeSettings()));
+    workers.back()->Start();
+  }
+  /// [Sample distlock group]
+
+  EXPECT_TRUE(PollUntil([&] { return working == kWorkersCount; }));
+  EXPECT_EQ(strategy->GetLockedCount(), kWorkersCount);
+
+  // the prolongations of the held locks are sent together
+  EXPECT_TRUE(
+      PollUntil([&] { return strategy->GetMaxBatchSize() == kWorkersCount; }));
+  const auto batches_before = group.GetBatchesCount();
+  engine::SleepFor(kAttemptInterval * 10);
+  EXPECT_LT(group.GetBatchesCount() - batches_before, 20);
+
+  for (auto& worker : workers) worker->Stop();
+  EXPECT_EQ(working, 0);
+  EXPECT_EQ(strategy->GetLockedCount(), 0);
+}
+
+UTEST(DistLockGroup, SameLock) {
+  auto strategy = std::make_shared<MockGroupStrategy>();
+  dist_lock::DistLockGroup group{strategy};
+
+  std::atomic<int> working{0};
+  const auto work = [&working] {
+    ++working;
+    WaitForCancellation();
+    --working;
+  };
+  dist_lock::DistLockedWorker first{"first", work,
+                                    group.GetLockStrategy("lock"),
+                                    MakeSettings()};
+  dist_lock::DistLockedWorker second{"second", work,
+                                     group.GetLockStrategy("lock"),
+                                     MakeSettings()};
+  first.Start();
+  second.Start();
+
+  EXPECT_TRUE(PollUntil([&] { return working == 1; }));
+  engine::SleepFor(kAttemptInterval * 5);
+  EXPECT_EQ(working, 1);
+  EXPECT_EQ(strategy->GetLockedCount(), 1);
+
+  first.Stop();
+  second.Stop();
+  EXPECT_EQ(working, 0);
+  EXPECT_EQ(strategy->GetLockedCount(), 0);
+}
+
+UTEST(DistLockGroup, BatchFailure) {
+  auto strategy = std::make_shared<MockGroupStrategy>();
+  strategy->Allow(false);
+  dist_lock::DistLockGroup group{strategy};
+
+  std::atomic<bool> working{false};
+  dist_lock::DistLockedWorker worker{"worker",
+                                     [&working] {
+                                       working = true;
+                                       WaitForCancellation();
+                                       working = false;
+                                     },
+                                     group.GetLockStrategy("lock"),
+                                     MakeSettings()};
+  worker.Start();
+
+  EXPECT_TRUE(PollUntil(
+      [&] { return worker.GetStatistics().lock_failures.Load() > 0; }));
+  EXPECT_FALSE(working);
+
+  strategy->Allow(true);
+  EXPECT_TRUE(PollUntil([&] { return working.load(); }));
+
+  worker.Stop();
+  EXPECT_FALSE(working);
+}
+
+USERVER_NAMESPACE_END
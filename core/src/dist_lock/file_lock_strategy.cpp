@@ -0,0 +1,61 @@
+#include <userver/dist_lock/file_lock_strategy.hpp>
+
+#include <sys/file.h>
+
+#include <cerrno>
+#include <mutex>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/logging/log.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+FileLockStrategy::FileLockStrategy(std::string path,
+                                   engine::TaskProcessor& fs_task_processor)
+    : path_(std::move(path)), fs_task_processor_(fs_task_processor) {}
+
+void FileLockStrategy::Acquire(std::chrono::milliseconds,
+                               const std::string& locker_id) {
+  std::lock_guard lock(mutex_);
+  // the lock is held until released, there is nothing to prolong
+  if (file_) return;
+
+  file_ = engine::AsyncNoSpan(fs_task_processor_, [this] {
+            auto file = fs::blocking::FileDescriptor::Open(
+                path_, {fs::blocking::OpenFlag::kWrite,
+                        fs::blocking::OpenFlag::kCreateIfNotExists});
+            const auto result = ::flock(file.GetNative(), LOCK_EX | LOCK_NB);
+            if (result == -1 && errno == EWOULDBLOCK) {
+              throw LockIsAcquiredByAnotherHostException();
+            }
+            utils::CheckSyscall(result, "calling ::flock for '{}'", path_);
+            return file;
+          }).Get();
+  LOG_INFO() << "Acquired the file lock '" << path_ << "' by " << locker_id;
+}
+
+void FileLockStrategy::Release(const std::string& locker_id) {
+  std::lock_guard lock(mutex_);
+  if (!file_) return;
+
+  // closing the file releases the lock
+  auto file = std::move(*file_);
+  file_.reset();
+  engine::AsyncNoSpan(fs_task_processor_, [&file] {
+    std::move(file).Close();
+  }).Get();
+  LOG_INFO() << "Released the file lock '" << path_ << "' by " << locker_id;
+}
+
+bool FileLockStrategy::IsLocked() {
+  std::lock_guard lock(mutex_);
+  return file_.has_value();
+}
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
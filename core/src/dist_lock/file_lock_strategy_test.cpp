@@ -0,0 +1,42 @@
+#include <userver/dist_lock/file_lock_strategy.hpp>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kLockTtl{100};
+
+}  // namespace
+
+UTEST(FileLockStrategy, SingleHolder) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/cache.lock";
+  auto& fs_task_processor = engine::current_task::GetTaskProcessor();
+
+  dist_lock::FileLockStrategy leader{path, fs_task_processor};
+  dist_lock::FileLockStrategy follower{path, fs_task_processor};
+
+  leader.Acquire(kLockTtl, "leader");
+  EXPECT_TRUE(leader.IsLocked());
+  // prolonging the held lock succeeds
+  EXPECT_NO_THROW(leader.Acquire(kLockTtl, "leader"));
+
+  EXPECT_THROW(follower.Acquire(kLockTtl, "follower"),
+               dist_lock::LockIsAcquiredByAnotherHostException);
+  EXPECT_FALSE(follower.IsLocked());
+
+  leader.Release("leader");
+  EXPECT_FALSE(leader.IsLocked());
+
+  follower.Acquire(kLockTtl, "follower");
+  EXPECT_TRUE(follower.IsLocked());
+  EXPECT_THROW(leader.Acquire(kLockTtl, "leader"),
+               dist_lock::LockIsAcquiredByAnotherHostException);
+  follower.Release("follower");
+}
+
+USERVER_NAMESPACE_END
@@ -14,6 +14,7 @@
 #include <userver/utest/utest.hpp>
 #include <userver/utils/rand.hpp>
 
+#include <userver/dump/dumped_size.hpp>
 #include <userver/dump/operations_mock.hpp>
 #include <userver/dump/test_helpers.hpp>
 
@@ -83,6 +84,12 @@ TEST(DumpCommon, String) {
   TestWriteReadCycle(std::string{"A big brown hog jumps over the lazy dog"});
 }
 
+TEST(DumpCommon, DumpedSize) {
+  EXPECT_EQ(dump::GetDumpedSize(42), dump::ToBinary(42).size());
+  const std::string value(1000, 'a');
+  EXPECT_EQ(dump::GetDumpedSize(value), dump::ToBinary(value).size());
+}
+
 TEST(DumpCommon, Bool) {
   TestWriteReadCycle(false);
   TestWriteReadCycle(true);
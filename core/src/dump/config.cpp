@@ -5,6 +5,7 @@
 #include <fmt/format.h>
 
 #include <userver/dynamic_config/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,9 +19,15 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMmap = "mmap";
+constexpr std::string_view kCompressed = "compressed";
+constexpr std::string_view kPeers = "peers";
+constexpr std::string_view kPeersTimeout = "peers-timeout";
+constexpr std::string_view kMaxDeltaCount = "max-delta-count";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
+constexpr std::chrono::milliseconds kDefaultPeersTimeout{60000};
 
 }  // namespace
 
@@ -67,6 +74,12 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      use_mmap(config[kMmap].As<bool>(false)),
+      dump_is_compressed(config[kCompressed].As<bool>(false)),
+      peers(config[kPeers].As<std::vector<std::string>>({})),
+      peers_timeout(config[kPeersTimeout].As<std::chrono::milliseconds>(
+          kDefaultPeersTimeout)),
+      max_delta_count(config[kMaxDeltaCount].As<uint64_t>(0)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -21,12 +21,16 @@ namespace {
 
 const std::string kTimeZone = "UTC";
 
+const std::string kDateRegex =
+    R"(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)";
+
 }  // namespace
 
 DumpLocator::DumpLocator(Config static_config)
     : config_(static_config),
       filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
-      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
+      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)),
+      delta_filename_regex_(GenerateFilenameRegex(FileFormatType::kDelta)) {}
 
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   std::string dump_path = GenerateDumpPath(update_time);
@@ -48,6 +52,45 @@ DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   return {update_time, std::move(dump_path), config_.dump_format_version};
 }
 
+DeltaFileStats DumpLocator::RegisterNewDelta(TimePoint base_update_time,
+                                             TimePoint update_time) {
+  std::string delta_path = GenerateDeltaPath(base_update_time, update_time);
+
+  if (boost::filesystem::exists(delta_path)) {
+    throw std::runtime_error(fmt::format(
+        "{}: could not write a delta to \"{}\", because the file already "
+        "exists",
+        config_.name, delta_path));
+  }
+
+  return {base_update_time, update_time, std::move(delta_path),
+          config_.dump_format_version};
+}
+
+std::vector<DeltaFileStats> DumpLocator::GetDeltas(
+    const DumpFileStats& base) const {
+  std::vector<DeltaFileStats> deltas;
+  if (base.format_version != config_.dump_format_version) return deltas;
+
+  for (const auto& file :
+       boost::filesystem::directory_iterator{config_.dump_directory}) {
+    if (!boost::filesystem::is_regular_file(file.status())) continue;
+
+    auto delta = ParseDeltaName(file.path().string());
+    if (!delta || delta->format_version != base.format_version ||
+        delta->base_update_time != base.update_time) {
+      continue;
+    }
+    deltas.push_back(std::move(*delta));
+  }
+
+  std::sort(deltas.begin(), deltas.end(),
+            [](const DeltaFileStats& a, const DeltaFileStats& b) {
+              return a.update_time < b.update_time;
+            });
+  return deltas;
+}
+
 std::optional<DumpFileStats> DumpLocator::GetLatestDump() const {
   try {
     std::optional<DumpFileStats> stats = GetLatestDumpImpl();
@@ -79,9 +122,19 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
                                                  kFilenameDateFormat);
   }
 
-  const std::string old_name = GenerateDumpPath({old_update_time});
-  const std::string new_name = GenerateDumpPath({new_update_time});
+  return RenameDump(GenerateDumpPath(old_update_time),
+                    GenerateDumpPath(new_update_time));
+}
+
+bool DumpLocator::BumpDeltaTime(TimePoint base_update_time,
+                                TimePoint old_update_time,
+                                TimePoint new_update_time) {
+  return RenameDump(GenerateDeltaPath(base_update_time, old_update_time),
+                    GenerateDeltaPath(base_update_time, new_update_time));
+}
 
+bool DumpLocator::RenameDump(const std::string& old_name,
+                             const std::string& new_name) {
   try {
     if (!boost::filesystem::is_regular_file(old_name)) {
       LOG_WARNING()
@@ -100,9 +153,60 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
   }
 }
 
+DumpFileStats DumpLocator::SaveReceivedDump(std::string_view filename,
+                                           std::string_view contents) {
+  auto stats = ParseDumpName(
+      fmt::format("{}/{}", config_.dump_directory, filename), filename_regex_);
+  if (filename.find('/') != std::string_view::npos || !stats ||
+      stats->format_version != config_.dump_format_version) {
+    throw std::runtime_error(fmt::format(
+        "{}: \"{}\" is not a name of a dump of format version {}",
+        config_.name, filename, config_.dump_format_version));
+  }
+
+  auto dump_stats = RegisterNewDump(stats->update_time);
+  const auto tmp_path = dump_stats.full_path + ".tmp";
+  fs::blocking::RewriteFileContents(tmp_path, contents);
+  fs::blocking::Chmod(tmp_path,
+                      config_.world_readable
+                          ? boost::filesystem::perms::owner_read |
+                                boost::filesystem::perms::group_read |
+                                boost::filesystem::perms::others_read
+                          : boost::filesystem::perms::owner_read);
+  fs::blocking::Rename(tmp_path, dump_stats.full_path);
+
+  LOG_INFO() << config_.name << ": a received dump has been saved at \""
+             << dump_stats.full_path << '"';
+  return dump_stats;
+}
+
+std::optional<DumpFileStats> DumpLocator::FindLatestDump(
+    const std::string& dump_directory, uint64_t format_version) {
+  static const boost::regex filename_regex{
+      GenerateFilenameRegex(FileFormatType::kNormal)};
+  std::optional<DumpFileStats> best_dump;
+
+  if (!boost::filesystem::exists(dump_directory)) return {};
+
+  for (const auto& file :
+       boost::filesystem::directory_iterator{dump_directory}) {
+    if (!boost::filesystem::is_regular_file(file.status())) continue;
+
+    auto curr_dump = ParseDumpName(file.path().string(), filename_regex);
+    if (!curr_dump || curr_dump->format_version != format_version) continue;
+
+    if (!best_dump || curr_dump->update_time > best_dump->update_time) {
+      best_dump = std::move(curr_dump);
+    }
+  }
+
+  return best_dump;
+}
+
 void DumpLocator::Cleanup() {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::vector<DumpFileStats> dumps;
+  std::vector<DeltaFileStats> deltas;
 
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
@@ -126,7 +230,19 @@ void DumpLocator::Cleanup() {
         continue;
       }
 
-      auto dump = ParseDumpName(file.path().string());
+      if (boost::regex_match(filename, delta_filename_regex_)) {
+        auto delta = ParseDeltaName(file.path().string());
+        if (!delta || delta->format_version < config_.dump_format_version) {
+          LOG_DEBUG() << config_.name << ": removing an obsolete delta, path=\""
+                      << file.path().string() << "\"";
+          boost::filesystem::remove(file);
+        } else if (delta->format_version == config_.dump_format_version) {
+          deltas.push_back(std::move(*delta));
+        }
+        continue;
+      }
+
+      auto dump = ParseDumpName(file.path().string(), filename_regex_);
       if (!dump) {
         LOG_WARNING() << config_.name
                       << ": unrelated file in the dump directory, path=\""
@@ -157,6 +273,19 @@ void DumpLocator::Cleanup() {
                   << dumps[i].full_path << "\"";
       boost::filesystem::remove(dumps[i].full_path);
     }
+    dumps.resize(std::min<std::size_t>(dumps.size(), config_.max_dump_count));
+
+    for (const auto& delta : deltas) {
+      const bool has_base = std::any_of(
+          dumps.begin(), dumps.end(), [&](const DumpFileStats& dump) {
+            return dump.update_time == delta.base_update_time;
+          });
+      if (has_base) continue;
+
+      LOG_DEBUG() << config_.name << ": removing a delta of a removed dump \""
+                  << delta.full_path << "\"";
+      boost::filesystem::remove(delta.full_path);
+    }
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while cleaning up old dumps. Cause: " << ex;
@@ -164,11 +293,11 @@ void DumpLocator::Cleanup() {
 }
 
 std::optional<DumpFileStats> DumpLocator::ParseDumpName(
-    std::string full_path) const {
+    std::string full_path, const boost::regex& filename_regex) {
   const auto filename = boost::filesystem::path{full_path}.filename().string();
 
   boost::smatch regex;
-  if (boost::regex_match(filename, regex, filename_regex_)) {
+  if (boost::regex_match(filename, regex, filename_regex)) {
     UASSERT_MSG(regex.size() == 3,
                 fmt::format("Incorrect sub-match count: {} for filename {}",
                             regex.size(), filename));
@@ -191,6 +320,33 @@ std::optional<DumpFileStats> DumpLocator::ParseDumpName(
   return std::nullopt;
 }
 
+std::optional<DeltaFileStats> DumpLocator::ParseDeltaName(
+    std::string full_path) const {
+  const auto filename = boost::filesystem::path{full_path}.filename().string();
+
+  boost::smatch regex;
+  if (!boost::regex_match(filename, regex, delta_filename_regex_)) {
+    return std::nullopt;
+  }
+  UASSERT_MSG(regex.size() == 4,
+              fmt::format("Incorrect sub-match count: {} for filename {}",
+                          regex.size(), filename));
+
+  try {
+    const auto version = utils::FromString<uint64_t>(regex[2].str());
+    const auto base_date = utils::datetime::Stringtime(
+        regex[1].str(), kTimeZone, kFilenameDateFormat);
+    const auto date = utils::datetime::Stringtime(regex[3].str(), kTimeZone,
+                                                  kFilenameDateFormat);
+    return DeltaFileStats{Round(base_date), Round(date), std::move(full_path),
+                          version};
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "A filename looks like a delta, but it is not, path=\""
+                  << filename << "\". Reason: " << ex;
+    return std::nullopt;
+  }
+}
+
 std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::optional<DumpFileStats> best_dump;
@@ -208,12 +364,14 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
         continue;
       }
 
-      auto curr_dump = ParseDumpName(file.path().string());
+      auto curr_dump = ParseDumpName(file.path().string(), filename_regex_);
       if (!curr_dump) {
-        if (boost::regex_match(file.path().filename().string(),
-                               tmp_filename_regex_)) {
+        const auto filename = file.path().filename().string();
+        if (boost::regex_match(filename, tmp_filename_regex_)) {
           LOG_DEBUG() << "A leftover tmp file found: \"" << file.path().string()
                       << "\". It will be removed on next Cleanup";
+        } else if (boost::regex_match(filename, delta_filename_regex_)) {
+          // deltas are looked up by GetDeltas
         } else {
           LOG_WARNING() << "Unrelated file in the dump directory: \""
                         << file.path().string() << "\"";
@@ -257,6 +415,13 @@ std::string DumpLocator::GenerateDumpPath(TimePoint update_time) const {
       config_.dump_format_version);
 }
 
+std::string DumpLocator::GenerateDeltaPath(TimePoint base_update_time,
+                                           TimePoint update_time) const {
+  return fmt::format(
+      FMT_COMPILE("{}.delta-{}"), GenerateDumpPath(base_update_time),
+      utils::datetime::Timestring(update_time, kTimeZone, kFilenameDateFormat));
+}
+
 TimePoint DumpLocator::MinAcceptableUpdateTime() const {
   return config_.max_dump_age
              ? Round(utils::datetime::Now()) - *config_.max_dump_age
@@ -264,9 +429,17 @@ TimePoint DumpLocator::MinAcceptableUpdateTime() const {
 }
 
 std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
-  return std::string{
-             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
-         (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
+  const auto dump = fmt::format(R"(^({})-v(\d+))", kDateRegex);
+  const auto delta = fmt::format(R"(\.delta-({}))", kDateRegex);
+  switch (type) {
+    case FileFormatType::kNormal:
+      return dump + "$";
+    case FileFormatType::kTmp:
+      return fmt::format(R"({}(?:{})?\.tmp$)", dump, delta);
+    case FileFormatType::kDelta:
+      return dump + delta + "$";
+  }
+  UINVARIANT(false, "Unexpected dump file format type");
 }
 
 TimePoint DumpLocator::Round(std::chrono::system_clock::time_point time) {
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -23,6 +24,14 @@ struct DumpFileStats final {
   uint64_t format_version;
 };
 
+/// A delta dump: the changes on top of the dump of `base_update_time`
+struct DeltaFileStats final {
+  TimePoint base_update_time;
+  TimePoint update_time;
+  std::string full_path;
+  uint64_t format_version;
+};
+
 /// @brief Manages dump files on disk. Encapsulates file paths and naming scheme
 /// and performs necessary bookkeeping.
 /// @note The class is thread-safe, except for `Cleanup`
@@ -36,31 +45,74 @@ class DumpLocator final {
   /// @throws On a filesystem error
   DumpFileStats RegisterNewDump(TimePoint update_time);
 
+  /// @brief Prepare the place for a new delta on top of the dump of
+  /// `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @note The actual creation of the file is a caller's responsibility
+  /// @throws On a filesystem error
+  DeltaFileStats RegisterNewDelta(TimePoint base_update_time,
+                                  TimePoint update_time);
+
+  /// @brief Finds the deltas on top of the dump `base` in the order they
+  /// should be applied
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  std::vector<DeltaFileStats> GetDeltas(const DumpFileStats& base) const;
+
   /// @brief Finds the latest suitable dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @returns The full path of the dump if available and fresh enough,
   /// or `nullopt` otherwise
   std::optional<DumpFileStats> GetLatestDump() const;
 
+  /// @brief Stores a dump received from elsewhere, e.g. from another instance,
+  /// under its original name
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @throws If the name is not a dump name of the current format version, or
+  /// on a filesystem error
+  DumpFileStats SaveReceivedDump(std::string_view filename,
+                                 std::string_view contents);
+
+  /// @brief Finds the latest dump of `format_version` in `dump_directory`
+  /// regardless of its age, e.g. to hand it over to another instance
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  static std::optional<DumpFileStats> FindLatestDump(
+      const std::string& dump_directory, uint64_t format_version);
+
   /// @brief Modifies the update time for a dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @return `true` on success, `false` if the dump is not available
   bool BumpDumpTime(TimePoint old_update_time, TimePoint new_update_time);
 
-  /// @brief Removes old dumps and tmp files
+  /// @brief Modifies the update time for the latest delta of the dump of
+  /// `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @return `true` on success, `false` if the delta is not available
+  bool BumpDeltaTime(TimePoint base_update_time, TimePoint old_update_time,
+                     TimePoint new_update_time);
+
+  /// @brief Removes old dumps, their deltas and tmp files
+
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @warning Must not be called concurrently with `RegisterNewDump`
   void Cleanup();
 
  private:
-  enum class FileFormatType { kNormal, kTmp };
+  enum class FileFormatType { kNormal, kTmp, kDelta };
+
+  static std::optional<DumpFileStats> ParseDumpName(
+      std::string full_path, const boost::regex& filename_regex);
 
-  std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
+  std::optional<DeltaFileStats> ParseDeltaName(std::string full_path) const;
+
+  bool RenameDump(const std::string& old_name, const std::string& new_name);
 
   std::optional<DumpFileStats> GetLatestDumpImpl() const;
 
   std::string GenerateDumpPath(TimePoint update_time) const;
 
+  std::string GenerateDeltaPath(TimePoint base_update_time,
+                                TimePoint update_time) const;
+
   TimePoint MinAcceptableUpdateTime() const;
 
   static std::string GenerateFilenameRegex(FileFormatType type);
@@ -70,6 +122,7 @@ class DumpLocator final {
   const Config config_;
   const boost::regex filename_regex_;
   const boost::regex tmp_filename_regex_;
+  const boost::regex delta_filename_regex_;
 };
 
 }  // namespace dump
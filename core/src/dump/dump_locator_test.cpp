@@ -268,4 +268,112 @@ max-age: 30m
   }
 }
 
+UTEST(DumpLocator, FindLatestDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  dump::CreateDumps(InitialFileNames(), dir, kDumperName);
+  dump::CreateDumps(JunkFileNames(), dir, kDumperName);
+  dump::CreateDumps(UnrelatedFileNames(), dir, kDumperName);
+
+  const auto dump_directory = dir.GetPath() + '/' + std::string{kDumperName};
+
+  const auto dump_stats = dump::DumpLocator::FindLatestDump(dump_directory, 5);
+  ASSERT_TRUE(dump_stats);
+  EXPECT_EQ(Filename(dump_stats->full_path), "2015-03-22T090003.000000Z-v5");
+
+  EXPECT_FALSE(dump::DumpLocator::FindLatestDump(dump_directory, 1));
+  EXPECT_FALSE(dump::DumpLocator::FindLatestDump(dump_directory + "-none", 5));
+}
+
+UTEST(DumpLocator, SaveReceivedDump) {
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-age: null
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator{config};
+
+  EXPECT_ANY_THROW(
+      locator.SaveReceivedDump("2015-03-22T090000.000000Z-v4", "abc"));
+  EXPECT_ANY_THROW(locator.SaveReceivedDump("foo", "abc"));
+  EXPECT_ANY_THROW(
+      locator.SaveReceivedDump("../2015-03-22T090000.000000Z-v5", "abc"));
+
+  locator.SaveReceivedDump("2015-03-22T090000.000000Z-v5", "abc");
+
+  const auto dump_info = locator.GetLatestDump();
+  ASSERT_TRUE(dump_info);
+  EXPECT_EQ(dump_info->update_time, BaseTime());
+  EXPECT_EQ(fs::blocking::ReadFileContents(dump_info->full_path), "abc");
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{"2015-03-22T090000.000000Z-v5"}));
+}
+
+UTEST(DumpLocator, Deltas) {
+  using namespace std::chrono_literals;
+
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-count: 1
+max-age: null
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  const std::string old_dump = "2015-03-22T090000.000000Z-v5";
+  const std::string old_delta =
+      "2015-03-22T090000.000000Z-v5.delta-2015-03-22T090001.000000Z";
+  const std::string base = "2015-03-22T090002.000000Z-v5";
+  const std::string delta1 =
+      "2015-03-22T090002.000000Z-v5.delta-2015-03-22T090003.000000Z";
+  const std::string delta2 =
+      "2015-03-22T090002.000000Z-v5.delta-2015-03-22T090004.000000Z";
+  const std::string obsolete_delta =
+      "2015-03-22T090002.000000Z-v4.delta-2015-03-22T090003.000000Z";
+  const std::string tmp_delta =
+      "2015-03-22T090002.000000Z-v5.delta-2015-03-22T090005.000000Z.tmp";
+  dump::CreateDumps({old_dump, old_delta, base, delta2, obsolete_delta,
+                     tmp_delta},
+                    dir, kDumperName);
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator{config};
+
+  const auto delta_stats =
+      locator.RegisterNewDelta(BaseTime() + 2s, BaseTime() + 3s);
+  EXPECT_EQ(Filename(delta_stats.full_path), delta1);
+  fs::blocking::RewriteFileContents(delta_stats.full_path, delta1);
+
+  const auto dump_stats = locator.GetLatestDump();
+  ASSERT_TRUE(dump_stats);
+  EXPECT_EQ(Filename(dump_stats->full_path), base);
+
+  auto deltas = locator.GetDeltas(*dump_stats);
+  ASSERT_EQ(deltas.size(), 2);
+  EXPECT_EQ(Filename(deltas[0].full_path), delta1);
+  EXPECT_EQ(deltas[0].base_update_time, BaseTime() + 2s);
+  EXPECT_EQ(deltas[0].update_time, BaseTime() + 3s);
+  EXPECT_EQ(Filename(deltas[1].full_path), delta2);
+
+  // Emulate a new update that got identical data
+  EXPECT_TRUE(locator.BumpDeltaTime(BaseTime() + 2s, BaseTime() + 4s,
+                                    BaseTime() + 6s));
+  deltas = locator.GetDeltas(*dump_stats);
+  ASSERT_EQ(deltas.size(), 2);
+  EXPECT_EQ(deltas[1].update_time, BaseTime() + 6s);
+
+  // Deltas of the removed dumps are removed along with tmp files
+  locator.Cleanup();
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{
+                base, delta1,
+                "2015-03-22T090002.000000Z-v5.delta-2015-03-22T090006.000000Z",
+            }));
+}
+
 USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
+#include <userver/clients/http/component.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/concurrent/variable.hpp>
@@ -27,8 +28,10 @@
 #include <userver/utils/statistics/storage.hpp>
 
 #include <dump/dump_locator.hpp>
+#include <dump/peers.hpp>
 #include <dump/statistics.hpp>
 #include <userver/components/dump_configurator.hpp>
+#include <userver/dump/common.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
 #include <userver/testsuite/dump_control.hpp>
@@ -45,6 +48,10 @@ void ThrowDumpUnimplemented(const std::string& name) {
 
 DumpableEntity::~DumpableEntity() = default;
 
+void DumpableEntity::ReadAndApplyDelta(dump::Reader&) {
+  throw Error("Delta dumps are not supported by the dumpable entity");
+}
+
 namespace {
 
 struct UpdateTime final {
@@ -52,6 +59,17 @@ struct UpdateTime final {
   TimePoint last_modifying_update;
 };
 
+// Deltas written on top of a full dump
+struct DeltaChain final {
+  TimePoint base_update_time;
+  std::size_t delta_count{0};
+};
+
+struct LoadedDump final {
+  TimePoint update_time;
+  DeltaChain delta_chain;
+};
+
 struct DumpData {
   DumpData(const Config& static_config,
            std::unique_ptr<OperationsFactory> rw_factory,
@@ -66,6 +84,7 @@ struct DumpData {
   DumpableEntity& dumpable;
   DumpLocator locator;
   std::optional<UpdateTime> dumped_update_time;
+  std::optional<DeltaChain> delta_chain;
 };
 
 struct UpdateData {
@@ -73,9 +92,19 @@ struct UpdateData {
       : is_current_from_dump(statistics.is_current_from_dump) {}
 
   std::optional<UpdateTime> update_time;
+  // The deltas reported since the last dump, meaningless if a full dump is
+  // required anyway
+  std::vector<DeltaWriter> deltas;
+  bool full_dump_required{true};
   std::atomic<bool>& is_current_from_dump;
 };
 
+struct PendingUpdate final {
+  UpdateTime update_time;
+  std::vector<DeltaWriter> deltas;
+  bool full_dump_required;
+};
+
 Config ParseConfig(const components::ComponentConfig& config,
                    const components::ComponentContext& context) {
   return Config{
@@ -108,7 +137,7 @@ class Dumper::Impl {
        dynamic_config::Source config_source,
        utils::statistics::Storage& statistics_storage,
        testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
-       Dumper& self);
+       clients::http::Client* peers_http_client, Dumper& self);
 
   ~Impl();
 
@@ -116,6 +145,8 @@ class Dumper::Impl {
 
   std::optional<TimePoint> ReadDump();
 
+  std::optional<TimePoint> ReadNewerDump(TimePoint update_time);
+
   void WriteDumpSyncDebug();
 
   void ReadDumpDebug();
@@ -124,6 +155,8 @@ class Dumper::Impl {
 
   void OnUpdateCompleted(TimePoint update_time, UpdateType update_type);
 
+  void OnUpdateCompleted(TimePoint update_time, DeltaWriter write_delta);
+
   void CancelWriteTaskAndWait() noexcept;
 
  private:
@@ -134,15 +167,25 @@ class Dumper::Impl {
 
   UpdateTime RetrieveUpdateTime(UpdateData& update_data);
 
+  PendingUpdate RetrievePendingUpdate();
+
+  void FetchDumpIfMissing(DumpData& dump_data);
+
   /// @throws std::exception on failure
   void DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                    DumpData& dump_data);
 
+  /// @throws std::exception on failure
+  void DoWriteDelta(const DeltaChain& delta_chain, TimePoint update_time,
+                    const std::vector<DeltaWriter>& deltas,
+                    tracing::ScopeTime& scope, DumpData& dump_data);
+
   enum class DumpOperation { kNewDump, kBumpTime };
 
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
-  std::optional<TimePoint> LoadFromDump(DumpData& dump_data,
-                                        const DynamicConfig& config);
+  std::optional<TimePoint> LoadFromDump(
+      DumpData& dump_data, const DynamicConfig& config,
+      std::optional<TimePoint> newer_than = std::nullopt);
 
   rcu::ReadablePtr<DynamicConfig> ReadConfigForPeriodicTask();
 
@@ -155,6 +198,7 @@ class Dumper::Impl {
   const std::string read_span_name_;
   rcu::Variable<DynamicConfig> dynamic_config_;
   engine::TaskProcessor& fs_task_processor_;
+  clients::http::Client* const peers_http_client_;
   Statistics statistics_;
 
   engine::SingleConsumerEvent config_updated_signal_{NoAutoReset{}};
@@ -179,12 +223,14 @@ Dumper::Impl::Impl(const Config& initial_config,
                    dynamic_config::Source config_source,
                    utils::statistics::Storage& statistics_storage,
                    testsuite::DumpControl& dump_control,
-                   DumpableEntity& dumpable, Dumper& self)
+                   DumpableEntity& dumpable,
+                   clients::http::Client* peers_http_client, Dumper& self)
     : static_config_(initial_config),
       write_span_name_("write-dump/" + Name()),
       read_span_name_("read-dump/" + Name()),
       dynamic_config_(static_config_, ConfigPatch{}),
       fs_task_processor_(fs_task_processor),
+      peers_http_client_(peers_http_client),
       dump_data_(static_config_, std::move(rw_factory), dumpable),
       update_data_(statistics_),
       testsuite_registration_(std::in_place, dump_control, self) {
@@ -212,9 +258,19 @@ std::optional<TimePoint> Dumper::Impl::ReadDump() {
   auto dump_data = dump_data_.Lock();
   const auto config = dynamic_config_.Read();
 
+  if (peers_http_client_ && config->dumps_enabled) {
+    FetchDumpIfMissing(*dump_data);
+  }
   return LoadFromDump(*dump_data, *config);
 }
 
+std::optional<TimePoint> Dumper::Impl::ReadNewerDump(TimePoint update_time) {
+  auto dump_data = dump_data_.Lock();
+  const auto config = dynamic_config_.Read();
+
+  return LoadFromDump(*dump_data, *config, update_time);
+}
+
 void Dumper::Impl::WriteDumpSyncDebug() {
   const auto config = dynamic_config_.Read();
   if (!config->dumps_enabled) {
@@ -269,6 +325,8 @@ void Dumper::Impl::OnUpdateCompleted(TimePoint update_time,
   if (update_type == UpdateType::kModified) {
     update_data->update_time = {update_time, update_time};
     update_data->is_current_from_dump = false;
+    update_data->deltas.clear();
+    update_data->full_dump_required = true;
   } else if (update_data->update_time) {
     update_data->update_time->last_update = update_time;
   } else {
@@ -278,6 +336,23 @@ void Dumper::Impl::OnUpdateCompleted(TimePoint update_time,
   data_updated_signal_.Send();
 }
 
+void Dumper::Impl::OnUpdateCompleted(TimePoint update_time,
+                                     DeltaWriter write_delta) {
+  UASSERT(write_delta);
+  auto update_data = update_data_.Lock();
+
+  update_data->update_time = {update_time, update_time};
+  update_data->is_current_from_dump = false;
+  if (static_config_.max_delta_count == 0) {
+    update_data->full_dump_required = true;
+  }
+  if (!update_data->full_dump_required) {
+    update_data->deltas.push_back(std::move(write_delta));
+  }
+
+  data_updated_signal_.Send();
+}
+
 void Dumper::Impl::PeriodicWriteTask() {
   bool previous_write_succeeded = true;
   auto previous_write_attempt_time = engine::Deadline::TimePoint::min();
@@ -326,12 +401,13 @@ void Dumper::Impl::WriteDump(DumpData& dump_data) {
   auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime();
   LOG_DEBUG() << Name() << ": requested to write a dump";
 
-  const auto update_time = [&] {
-    auto update_data = update_data_.Lock();
-    return RetrieveUpdateTime(*update_data);
-  }();
+  const auto [update_time, deltas, full_dump_required] =
+      RetrievePendingUpdate();
 
   const auto& dumped_update_time = dump_data.dumped_update_time;
+  // Reset until the write succeeds, so that a failed write of a delta is
+  // followed by a full dump
+  auto delta_chain = std::exchange(dump_data.delta_chain, std::nullopt);
 
   auto operation_type = DumpOperation::kNewDump;
   if (dumped_update_time && dumped_update_time->last_modifying_update ==
@@ -342,21 +418,48 @@ void Dumper::Impl::WriteDump(DumpData& dump_data) {
 
   switch (operation_type) {
     case DumpOperation::kNewDump: {
+      if (delta_chain && !full_dump_required && !deltas.empty() &&
+          delta_chain->delta_count < static_config_.max_delta_count) {
+        DoWriteDelta(*delta_chain, update_time.last_update, deltas, scope_time,
+                     dump_data);
+        ++delta_chain->delta_count;
+        break;
+      }
+
       dump_data.locator.Cleanup();
       DoWriteDump(update_time.last_update, scope_time, dump_data);
+      delta_chain = DeltaChain{update_time.last_update};
       break;
     }
     case DumpOperation::kBumpTime: {
       UASSERT(dumped_update_time);
-      if (!dump_data.locator.BumpDumpTime(dumped_update_time->last_update,
-                                          update_time.last_update)) {
+      const bool bumped =
+          delta_chain && delta_chain->delta_count != 0
+              ? dump_data.locator.BumpDeltaTime(
+                    delta_chain->base_update_time,
+                    dumped_update_time->last_update, update_time.last_update)
+              : dump_data.locator.BumpDumpTime(dumped_update_time->last_update,
+                                               update_time.last_update);
+      if (!bumped) {
         DoWriteDump(update_time.last_update, scope_time, dump_data);
+        delta_chain = DeltaChain{update_time.last_update};
       }
       break;
     }
   }
 
   dump_data.dumped_update_time = update_time;
+  dump_data.delta_chain = delta_chain;
+}
+
+PendingUpdate Dumper::Impl::RetrievePendingUpdate() {
+  auto update_data = update_data_.Lock();
+  auto update_time = RetrieveUpdateTime(*update_data);
+  return {
+      update_time,
+      std::exchange(update_data->deltas, {}),
+      std::exchange(update_data->full_dump_required, false),
+  };
 }
 
 UpdateTime Dumper::Impl::RetrieveUpdateTime(UpdateData& update_data) {
@@ -369,6 +472,8 @@ UpdateTime Dumper::Impl::RetrieveUpdateTime(UpdateData& update_data) {
     const auto now = std::chrono::time_point_cast<TimePoint::duration>(
         utils::datetime::Now());
     update_data.update_time = {now, now};
+    update_data.deltas.clear();
+    update_data.full_dump_required = true;
   }
 
   if (update_data.update_time) {
@@ -381,6 +486,30 @@ UpdateTime Dumper::Impl::RetrieveUpdateTime(UpdateData& update_data) {
                   Name()));
 }
 
+void Dumper::Impl::FetchDumpIfMissing(DumpData& dump_data) {
+  const bool has_local_dump =
+      utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
+        return dump_data.locator.GetLatestDump().has_value();
+      }).Get();
+  if (has_local_dump) return;
+
+  tracing::Span span("fetch-dump/" + Name());
+  auto dump = FetchDumpFromPeers(*peers_http_client_, static_config_);
+  if (!dump) {
+    LOG_INFO() << Name() << ": none of the peers has a dump";
+    return;
+  }
+
+  utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
+    try {
+      dump_data.locator.SaveReceivedDump(dump->filename, dump->contents);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << Name()
+                  << ": error while saving a dump of a peer. Reason: " << ex;
+    }
+  }).Get();
+}
+
 rcu::ReadablePtr<DynamicConfig> Dumper::Impl::ReadConfigForPeriodicTask() {
   config_updated_signal_.Reset();
   return dynamic_config_.Read();
@@ -434,8 +563,37 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
   statistics_.last_nontrivial_write_start_time = dump_start;
 }
 
+void Dumper::Impl::DoWriteDelta(const DeltaChain& delta_chain,
+                                TimePoint update_time,
+                                const std::vector<DeltaWriter>& deltas,
+                                tracing::ScopeTime& scope,
+                                DumpData& dump_data) {
+  const auto dump_start = std::chrono::steady_clock::now();
+
+  const auto delta_stats = dump_data.locator.RegisterNewDelta(
+      delta_chain.base_update_time, update_time);
+  const auto& delta_path = delta_stats.full_path;
+  auto writer = dump_data.rw_factory->CreateWriter(delta_path, scope);
+  writer->Write(deltas.size());
+  for (const auto& write_delta : deltas) {
+    write_delta(*writer);
+  }
+  writer->Finish();
+  const auto delta_size = boost::filesystem::file_size(delta_path);
+
+  LOG_INFO() << Name() << ": a new delta dump has been written at \""
+             << delta_path << '"';
+
+  statistics_.last_written_size = delta_size;
+  statistics_.last_nontrivial_write_duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - dump_start);
+  statistics_.last_nontrivial_write_start_time = dump_start;
+}
+
 std::optional<TimePoint> Dumper::Impl::LoadFromDump(
-    DumpData& dump_data, const DynamicConfig& config) {
+    DumpData& dump_data, const DynamicConfig& config,
+    std::optional<TimePoint> newer_than) {
   if (!config.dumps_enabled) {
     LOG_DEBUG() << Name()
                 << ": could not load a dump, because dumps are disabled for "
@@ -445,38 +603,65 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
 
   const auto load_start = std::chrono::steady_clock::now();
 
-  const std::optional<TimePoint> update_time =
+  const std::optional<LoadedDump> loaded_dump =
       utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
         auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime();
 
         try {
           auto dump_stats = dump_data.locator.GetLatestDump();
-          if (!dump_stats) return std::optional<TimePoint>{};
+          if (!dump_stats) return std::optional<LoadedDump>{};
+
+          const auto deltas = dump_data.locator.GetDeltas(*dump_stats);
+          const auto update_time =
+              deltas.empty() ? dump_stats->update_time
+                             : deltas.back().update_time;
+          if (newer_than && update_time <= *newer_than) {
+            LOG_DEBUG() << Name() << ": no dump newer than the loaded data";
+            return std::optional<LoadedDump>{};
+          }
 
           auto reader =
               dump_data.rw_factory->CreateReader(dump_stats->full_path);
           dump_data.dumpable.ReadAndSet(*reader);
           reader->Finish();
 
-          LOG_INFO() << Name() << ": a dump has been loaded successfully";
-          return std::optional{dump_stats->update_time};
+          for (const auto& delta : deltas) {
+            auto delta_reader =
+                dump_data.rw_factory->CreateReader(delta.full_path);
+            const auto count = delta_reader->Read<std::size_t>();
+            for (std::size_t i = 0; i < count; ++i) {
+              dump_data.dumpable.ReadAndApplyDelta(*delta_reader);
+            }
+            delta_reader->Finish();
+          }
+
+          LOG_INFO() << Name() << ": a dump has been loaded successfully"
+                     << (deltas.empty() ? ""
+                                        : fmt::format(" with {} deltas",
+                                                      deltas.size()));
+          return std::optional{LoadedDump{
+              update_time, DeltaChain{dump_stats->update_time, deltas.size()}}};
         } catch (const std::exception& ex) {
           LOG_ERROR() << Name()
                       << ": error while reading a dump. Reason: " << ex;
-          return std::optional<TimePoint>{};
+          return std::optional<LoadedDump>{};
         }
       }).Get();
 
-  if (!update_time) return {};
-  const UpdateTime update_times{*update_time, *update_time};
+  if (!loaded_dump) return {};
+  const auto update_time = loaded_dump->update_time;
+  const UpdateTime update_times{update_time, update_time};
 
   {
     auto update_data = update_data_.Lock();
     update_data->update_time = update_times;
+    update_data->deltas.clear();
+    update_data->full_dump_required = false;
     update_data->is_current_from_dump = true;
   }
   // So that we don't attempt to write the dump we've just read
   dump_data.dumped_update_time = update_times;
+  dump_data.delta_chain = loaded_dump->delta_chain;
 
   statistics_.is_loaded = true;
   statistics_.load_duration =
@@ -490,9 +675,11 @@ Dumper::Dumper(const Config& initial_config,
                engine::TaskProcessor& fs_task_processor,
                dynamic_config::Source config_source,
                utils::statistics::Storage& statistics_storage,
-               testsuite::DumpControl& dump_control, DumpableEntity& dumpable)
+               testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
+               clients::http::Client* peers_http_client)
     : impl_(initial_config, std::move(rw_factory), fs_task_processor,
-            config_source, statistics_storage, dump_control, dumpable, *this) {}
+            config_source, statistics_storage, dump_control, dumpable,
+            peers_http_client, *this) {}
 
 Dumper::Dumper(const components::ComponentConfig& config,
                const components::ComponentContext& context,
@@ -508,7 +695,12 @@ Dumper::Dumper(const Config& initial_config,
             context.FindComponent<components::StatisticsStorage>().GetStorage(),
             context.FindComponent<components::TestsuiteSupport>()
                 .GetDumpControl(),
-            dumpable, *this) {}
+            dumpable,
+            initial_config.peers.empty()
+                ? nullptr
+                : &context.FindComponent<components::HttpClient>()
+                       .GetHttpClient(),
+            *this) {}
 
 Dumper::~Dumper() = default;
 
@@ -516,6 +708,10 @@ const std::string& Dumper::Name() const { return impl_->Name(); }
 
 std::optional<TimePoint> Dumper::ReadDump() { return impl_->ReadDump(); }
 
+std::optional<TimePoint> Dumper::ReadNewerDump(TimePoint update_time) {
+  return impl_->ReadNewerDump(update_time);
+}
+
 void Dumper::WriteDumpSyncDebug() { impl_->WriteDumpSyncDebug(); }
 
 void Dumper::ReadDumpDebug() { impl_->ReadDumpDebug(); }
@@ -526,6 +722,10 @@ void Dumper::OnUpdateCompleted(TimePoint update_time, UpdateType update_type) {
   impl_->OnUpdateCompleted(update_time, update_type);
 }
 
+void Dumper::OnUpdateCompleted(TimePoint update_time, DeltaWriter write_delta) {
+  impl_->OnUpdateCompleted(update_time, std::move(write_delta));
+}
+
 void Dumper::CancelWriteTaskAndWait() { impl_->CancelWriteTaskAndWait(); }
 
 }  // namespace dump
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <userver/clients/http/client.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/common_containers.hpp>
@@ -17,6 +18,8 @@
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/testsuite/dump_control.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/atomic.hpp>
@@ -24,6 +27,7 @@
 #include <userver/utils/statistics/storage.hpp>
 
 #include <dump/internal_helpers_test.hpp>
+#include <dump/peers.hpp>
 
 using namespace std::chrono_literals;
 
@@ -53,9 +57,18 @@ struct DummyEntity final : public dump::DumpableEntity {
     ++read_count;
   }
 
+  void ReadAndApplyDelta(dump::Reader& reader) override {
+    std::unique_lock lock(check_no_data_race_mutex, std::try_to_lock);
+    ASSERT_TRUE(lock.owns_lock());
+
+    value = reader.Read<int>();
+    ++delta_read_count;
+  }
+
   int value{0};
   mutable int write_count{0};
   mutable int read_count{0};
+  int delta_read_count{0};
 
   mutable engine::Mutex check_no_data_race_mutex;
   mutable engine::Mutex write_mutex;
@@ -95,6 +108,32 @@ class DumperFixture : public ::testing::Test {
     };
   }
 
+  dump::Dumper MakeDumper(const dump::Config& config) {
+    return dump::Dumper{
+        config,
+        dump::CreateDefaultOperationsFactory(config),
+        engine::current_task::GetTaskProcessor(),
+        config_storage_.GetSource(),
+        statistics_storage_,
+        control_,
+        dumpable_,
+    };
+  }
+
+  dump::Dumper MakeDumper(const dump::Config& config,
+                          clients::http::Client& peers_http_client) {
+    return dump::Dumper{
+        config,
+        dump::CreateDefaultOperationsFactory(config),
+        engine::current_task::GetTaskProcessor(),
+        config_storage_.GetSource(),
+        statistics_storage_,
+        control_,
+        dumpable_,
+        &peers_http_client,
+    };
+  }
+
   const fs::blocking::TempDirectory& GetRoot() const { return root_; }
   const dump::Config& GetConfig() const { return config_; }
   testsuite::DumpControl& GetDumpControl() { return control_; }
@@ -273,6 +312,35 @@ UTEST_F(DumperFixture, UpdateTimeDetailed) {
   EXPECT_EQ(dumper.ReadDump(), explicit_time);
 }
 
+UTEST_F(DumperFixture, FetchFromPeers) {
+  const std::string filename = "2015-03-22T090000.000000Z-v0";
+  const utest::HttpServerMock peer(
+      [&](const utest::HttpServerMock::HttpRequest& request) {
+        if (request.path == "/empty") {
+          return utest::HttpServerMock::HttpResponse{404, {}, {}};
+        }
+        EXPECT_EQ(request.query.at("name"), DummyEntity::kName);
+        EXPECT_EQ(request.query.at("format-version"), "0");
+        return utest::HttpServerMock::HttpResponse{
+            200,
+            {{std::string{dump::kDumpFilenameHeader}, filename}},
+            dump::ToBinary(42)};
+      });
+  const auto http_client = utest::CreateHttpClient();
+
+  const auto config = dump::ConfigFromYaml(
+      kConfig + fmt::format("peers: ['{0}/empty', '{0}/dumps']\n",
+                            peer.GetBaseUrl()),
+      GetRoot(), DummyEntity::kName);
+  auto dumper = MakeDumper(config, *http_client);
+
+  // There is no local dump, so the first peer that has one is used
+  EXPECT_TRUE(dumper.ReadDump());
+  EXPECT_EQ(GetDumpable().value, 42);
+  EXPECT_EQ(dump::FilenamesInDirectory(GetRoot(), DummyEntity::kName),
+            (std::set<std::string>{filename}));
+}
+
 namespace {
 
 class DumperFixtureNonPeriodic : public DumperFixture {
@@ -321,6 +389,68 @@ UTEST_F(DumperFixtureNonPeriodic, ForcedWritesEnabled) {
   EXPECT_EQ(GetDumpable().write_count, 1);
 }
 
+UTEST_F(DumperFixtureNonPeriodic, DeltaDumps) {
+  const auto config = dump::ConfigFromYaml(kConfig + "max-delta-count: 2\n",
+                                           GetRoot(), DummyEntity::kName);
+  auto dumper = MakeDumper(config);
+  auto& dumpable = GetDumpable();
+  const auto write_delta = [](int value) {
+    return [value](dump::Writer& writer) { writer.Write(value); };
+  };
+
+  auto update_time = Now();
+  dumpable.value = 1;
+  dumper.OnUpdateCompleted(update_time, dump::UpdateType::kModified);
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(dumpable.write_count, 1);
+
+  for (const int value : {2, 3}) {
+    update_time += 1s;
+    dumpable.value = value;
+    dumper.OnUpdateCompleted(update_time, write_delta(value));
+    dumper.WriteDumpSyncDebug();
+  }
+  // Only the deltas have been written
+  EXPECT_EQ(dumpable.write_count, 1);
+
+  // The latest delta gets the new update time
+  update_time += 1s;
+  dumper.OnUpdateCompleted(update_time, dump::UpdateType::kAlreadyUpToDate);
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(dump::FilenamesInDirectory(GetRoot(), DummyEntity::kName).size(),
+            3);
+
+  dumpable.value = 0;
+  EXPECT_EQ(dumper.ReadDump(), update_time);
+  EXPECT_EQ(dumpable.value, 3);
+  EXPECT_EQ(dumpable.read_count, 1);
+  EXPECT_EQ(dumpable.delta_read_count, 2);
+
+  // The deltas are compacted into a new full dump
+  update_time += 1s;
+  dumpable.value = 4;
+  dumper.OnUpdateCompleted(update_time, write_delta(4));
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(dumpable.write_count, 2);
+
+  dumpable.value = 0;
+  EXPECT_EQ(dumper.ReadDump(), update_time);
+  EXPECT_EQ(dumpable.value, 4);
+  EXPECT_EQ(dumpable.delta_read_count, 2);
+}
+
+UTEST_F(DumperFixtureNonPeriodic, DeltaDumpsDisabled) {
+  auto dumper = MakeDumper();
+  dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+  dumper.WriteDumpSyncDebug();
+
+  GetDumpable().value = 2;
+  dumper.OnUpdateCompleted(Now() + 1s,
+                           [](dump::Writer& writer) { writer.Write(2); });
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(GetDumpable().write_count, 2);
+}
+
 UTEST_F(DumperFixtureNonPeriodic, ForcedReadsEnabled) {
   dump::CreateDump(dump::ToBinary(42), GetConfig());
   auto dumper = MakeDumper();
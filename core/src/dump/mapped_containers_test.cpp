@@ -0,0 +1,98 @@
+#include <userver/dump/mapped_containers.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Point {
+  double x;
+  double y;
+};
+
+bool operator==(const Point& lhs, const Point& rhs) {
+  return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+using PointMap = dump::MappedFlatMap<std::int64_t, Point>;
+
+PointMap MakePointMap() {
+  return PointMap{{{3, {3.0, 0.5}}, {1, {1.0, 0.5}}, {2, {2.0, 0.5}}}};
+}
+
+template <typename T>
+std::vector<T> ToStdVector(const dump::MappedVector<T>& vector) {
+  return {vector.begin(), vector.end()};
+}
+
+}  // namespace
+
+TEST(DumpMappedContainers, Vector) {
+  dump::TestWriteReadCycle(dump::MappedVector<int>{});
+  dump::TestWriteReadCycle(dump::MappedVector<int>{{1, 2, 3}});
+  dump::TestWriteReadCycle(
+      dump::MappedVector<Point>{{{1.0, 2.0}, {3.0, 4.0}}});
+}
+
+TEST(DumpMappedContainers, FlatMap) {
+  const auto map = MakePointMap();
+  ASSERT_EQ(map.size(), 3);
+  EXPECT_EQ(map.GetKeys(), (dump::MappedVector<std::int64_t>{{1, 2, 3}}));
+  ASSERT_TRUE(map.FindOrNullptr(2));
+  EXPECT_EQ(*map.FindOrNullptr(2), (Point{2.0, 0.5}));
+  EXPECT_FALSE(map.Contains(4));
+
+  dump::TestWriteReadCycle(PointMap{});
+  dump::TestWriteReadCycle(map);
+}
+
+UTEST(DumpMappedContainers, InPlaceFromMmap) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/dump";
+  const std::vector<std::uint64_t> elements{1, 2, 3, 0xffff'ffff'ffff};
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  // misaligns the following data
+  writer.Write(std::string{"abc"});
+  writer.Write(dump::MappedVector<std::uint64_t>{elements});
+  writer.Write(MakePointMap());
+  writer.Finish();
+
+  dump::MappedVector<std::uint64_t> vector;
+  PointMap map;
+  {
+    dump::MmapFileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), "abc");
+    vector = reader.Read<dump::MappedVector<std::uint64_t>>();
+    map = reader.Read<PointMap>();
+    reader.Finish();
+  }
+
+  // the data outlives the reader
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) %
+                alignof(std::uint64_t),
+            0);
+  EXPECT_EQ(ToStdVector(vector), elements);
+  EXPECT_EQ(map, MakePointMap());
+
+  // the same format is read by the usual reader
+  dump::FileReader reader(path);
+  EXPECT_EQ(reader.Read<std::string>(), "abc");
+  EXPECT_EQ(ToStdVector(reader.Read<dump::MappedVector<std::uint64_t>>()),
+            elements);
+  EXPECT_EQ(reader.Read<PointMap>(), MakePointMap());
+  reader.Finish();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,295 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <compression/gzip.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// File format:
+// 1. gzip-compressed chunks
+// 2. index: chunk count, then (offset, compressed size, uncompressed size)
+//    of each chunk
+// 3. footer: index offset, magic
+//
+// All the integers are std::uint64_t of native endianness.
+constexpr std::uint64_t kMagic = 0x31'4b'4e'55'48'43'50'44;  // "DPCHUNK1"
+constexpr std::size_t kFooterSize = 2 * sizeof(std::uint64_t);
+constexpr std::size_t kIndexEntrySize = sizeof(impl::CompressedChunk);
+
+static_assert(kIndexEntrySize == 3 * sizeof(std::uint64_t));
+
+void AppendUint64(std::string& data, std::uint64_t value) {
+  data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::uint64_t ParseUint64(std::string_view data, std::size_t offset) {
+  UASSERT(offset + sizeof(std::uint64_t) <= data.size());
+  std::uint64_t value = 0;
+  data.copy(reinterpret_cast<char*>(&value), sizeof(value), offset);
+  return value;
+}
+
+std::string ReadAt(int fd, std::uint64_t offset, std::size_t size) {
+  std::string result(size, '\0');
+  std::size_t done = 0;
+  while (done < size) {
+    const auto bytes_read =
+        ::pread(fd, result.data() + done, size - done, offset + done);
+    if (bytes_read < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error(
+          fmt::format("pread failed: {}", std::strerror(errno)));
+    }
+    if (bytes_read == 0) throw std::runtime_error("unexpected end-of-file");
+    done += bytes_read;
+  }
+  return result;
+}
+
+fs::blocking::FileDescriptor OpenForReading(const std::string& path) {
+  try {
+    return fs::blocking::FileDescriptor::Open(path,
+                                              fs::blocking::OpenFlag::kRead);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to open the dump file for reading \"{}\". Reason: {}", path,
+        ex.what()));
+  }
+}
+
+std::vector<impl::CompressedChunk> ReadIndex(
+    const fs::blocking::FileDescriptor& file) {
+  const auto file_size = file.GetSize();
+  if (file_size < kFooterSize) throw Error("the footer is missing");
+
+  const auto footer =
+      ReadAt(file.GetNative(), file_size - kFooterSize, kFooterSize);
+  if (ParseUint64(footer, sizeof(std::uint64_t)) != kMagic) {
+    throw Error("not a compressed dump");
+  }
+  const auto index_offset = ParseUint64(footer, 0);
+  const auto index_end = file_size - kFooterSize;
+  if (index_offset + sizeof(std::uint64_t) > index_end) {
+    throw Error(fmt::format("invalid index offset {}", index_offset));
+  }
+
+  const auto index_data =
+      ReadAt(file.GetNative(), index_offset, index_end - index_offset);
+  const auto chunk_count = ParseUint64(index_data, 0);
+  if ((index_data.size() - sizeof(std::uint64_t)) / kIndexEntrySize !=
+          chunk_count ||
+      (index_data.size() - sizeof(std::uint64_t)) % kIndexEntrySize != 0) {
+    throw Error(fmt::format("invalid index size {} for {} chunks",
+                            index_data.size(), chunk_count));
+  }
+
+  std::vector<impl::CompressedChunk> index;
+  index.reserve(chunk_count);
+  for (std::size_t i = 0; i < chunk_count; ++i) {
+    const auto entry_offset = sizeof(std::uint64_t) + i * kIndexEntrySize;
+    impl::CompressedChunk chunk{
+        ParseUint64(index_data, entry_offset),
+        ParseUint64(index_data, entry_offset + sizeof(std::uint64_t)),
+        ParseUint64(index_data, entry_offset + 2 * sizeof(std::uint64_t)),
+    };
+    if (chunk.offset + chunk.compressed_size > index_offset) {
+      throw Error(fmt::format("chunk {} is out of the data bounds", i));
+    }
+    index.push_back(chunk);
+  }
+  return index;
+}
+
+}  // namespace
+
+CompressedWriter::CompressedWriter(std::string path,
+                                   boost::filesystem::perms perms,
+                                   tracing::ScopeTime& scope,
+                                   CompressionSettings settings)
+    : file_(std::move(path), perms, scope), settings_(settings) {
+  UINVARIANT(settings_.chunk_size > 0, "chunk_size must be positive");
+  UINVARIANT(settings_.max_parallel_chunks > 0,
+             "max_parallel_chunks must be positive");
+  chunk_.reserve(settings_.chunk_size);
+}
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    const auto size =
+        std::min(data.size(), settings_.chunk_size - chunk_.size());
+    chunk_.append(data.substr(0, size));
+    data.remove_prefix(size);
+    if (chunk_.size() == settings_.chunk_size) StartChunk();
+  }
+}
+
+void CompressedWriter::Finish() {
+  if (!chunk_.empty()) StartChunk();
+  while (!in_flight_.empty()) WriteOldestChunk();
+
+  std::string index;
+  index.reserve(sizeof(std::uint64_t) + index_.size() * kIndexEntrySize +
+                kFooterSize);
+  AppendUint64(index, index_.size());
+  for (const auto& chunk : index_) {
+    AppendUint64(index, chunk.offset);
+    AppendUint64(index, chunk.compressed_size);
+    AppendUint64(index, chunk.uncompressed_size);
+  }
+  AppendUint64(index, offset_);
+  AppendUint64(index, kMagic);
+  WriteStringViewUnsafe(file_, index);
+
+  file_.Finish();
+}
+
+void CompressedWriter::StartChunk() {
+  if (in_flight_.size() >= settings_.max_parallel_chunks) WriteOldestChunk();
+
+  const auto uncompressed_size = chunk_.size();
+  in_flight_.push_back(
+      {uncompressed_size,
+       engine::AsyncNoSpan(
+           [chunk = std::move(chunk_), level = settings_.level] {
+             return compression::gzip::Compress(chunk, level);
+           })});
+
+  chunk_ = std::string{};
+  chunk_.reserve(settings_.chunk_size);
+}
+
+void CompressedWriter::WriteOldestChunk() {
+  UASSERT(!in_flight_.empty());
+  auto& oldest = in_flight_.front();
+
+  std::string compressed;
+  try {
+    compressed = oldest.task.Get();
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to compress a dump chunk: {}", ex.what()));
+  }
+
+  index_.push_back({offset_, compressed.size(), oldest.uncompressed_size});
+  in_flight_.pop_front();
+
+  WriteStringViewUnsafe(file_, compressed);
+  offset_ += compressed.size();
+}
+
+CompressedReader::CompressedReader(std::string path,
+                                   CompressionSettings settings)
+    : path_(std::move(path)),
+      file_(OpenForReading(path_)),
+      settings_(settings) {
+  UINVARIANT(settings_.max_parallel_chunks > 0,
+             "max_parallel_chunks must be positive");
+  try {
+    index_ = ReadIndex(file_);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to read the index of the dump file "
+                            "\"{}\". Reason: {}",
+                            path_, ex.what()));
+  }
+  StartDecompression();
+}
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+  if (position_ == curr_chunk_.size() && !NextChunk()) return {};
+
+  // fast path, no copying
+  if (curr_chunk_.size() - position_ >= max_size) {
+    const std::string_view result{curr_chunk_.data() + position_, max_size};
+    position_ += max_size;
+    return result;
+  }
+
+  buffer_.clear();
+  while (buffer_.size() < max_size) {
+    if (position_ == curr_chunk_.size() && !NextChunk()) break;
+    const auto size =
+        std::min(max_size - buffer_.size(), curr_chunk_.size() - position_);
+    buffer_.append(curr_chunk_, position_, size);
+    position_ += size;
+  }
+  return buffer_;
+}
+
+void CompressedReader::Finish() {
+  if (position_ != curr_chunk_.size() || next_chunk_ != index_.size() ||
+      !in_flight_.empty()) {
+    throw Error(fmt::format(
+        "Unexpected extra data at the end of the dump file \"{}\"", path_));
+  }
+}
+
+void CompressedReader::StartDecompression() {
+  while (in_flight_.size() < settings_.max_parallel_chunks &&
+         next_chunk_ < index_.size()) {
+    in_flight_.push_back(engine::AsyncNoSpan(
+        [fd = file_.GetNative(), chunk = index_[next_chunk_]] {
+          const auto compressed =
+              ReadAt(fd, chunk.offset, chunk.compressed_size);
+          auto result = compression::gzip::Decompress(compressed,
+                                                      chunk.uncompressed_size);
+          if (result.size() != chunk.uncompressed_size) {
+            throw std::runtime_error(
+                fmt::format("expected {} bytes, got {}",
+                            chunk.uncompressed_size, result.size()));
+          }
+          return result;
+        }));
+    ++next_chunk_;
+  }
+}
+
+bool CompressedReader::NextChunk() {
+  if (in_flight_.empty()) return false;
+
+  try {
+    curr_chunk_ = in_flight_.front().Get();
+  } catch (const std::exception& ex) {
+    throw Error(
+        fmt::format("Failed to read a chunk of the dump file \"{}\": {}",
+                    path_, ex.what()));
+  }
+  in_flight_.pop_front();
+  position_ = 0;
+
+  StartDecompression();
+  return true;
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    boost::filesystem::perms perms, CompressionSettings settings)
+    : perms_(perms), settings_(settings) {}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<CompressedReader>(std::move(full_path), settings_);
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<CompressedWriter>(std::move(full_path), perms_,
+                                            scope, settings_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,106 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_compressed.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+dump::CompressionSettings MakeSettings() {
+  dump::CompressionSettings settings;
+  settings.chunk_size = 1000;
+  settings.max_parallel_chunks = 3;
+  return settings;
+}
+
+}  // namespace
+
+UTEST(DumpCompressedFile, Smoke) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time, MakeSettings());
+  w.Write(1);
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path, MakeSettings());
+  EXPECT_EQ(r.Read<int32_t>(), 1);
+  UEXPECT_THROW(r.Read<int32_t>(), dump::Error);
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+UTEST(DumpCompressedFile, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time, MakeSettings());
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path, MakeSettings());
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+UTEST_MT(DumpCompressedFile, ManyChunks, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  std::vector<std::string> data;
+  for (int i = 0; i < 1000; ++i) {
+    data.push_back(std::string(i % 50, 'a' + i % 26));
+  }
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time, MakeSettings());
+  w.Write(data);
+  // spans several chunks
+  w.Write(std::string(2500, 'x'));
+  UEXPECT_NO_THROW(w.Finish());
+
+  // compresses well
+  EXPECT_LT(boost::filesystem::file_size(path), 10000);
+
+  dump::CompressedReader r(path, MakeSettings());
+  EXPECT_EQ(r.Read<std::vector<std::string>>(), data);
+  EXPECT_EQ(r.Read<std::string>(), std::string(2500, 'x'));
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+UTEST(DumpCompressedFile, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time, MakeSettings());
+  w.Write(1);
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path, MakeSettings());
+  UEXPECT_THROW(r.Finish(), dump::Error);
+}
+
+UTEST(DumpCompressedFile, NotCompressed) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  fs::blocking::RewriteFileContents(path, std::string(100, 'a'));
+
+  UEXPECT_THROW_MSG(dump::CompressedReader(path, MakeSettings()), dump::Error,
+                    "not a compressed dump");
+}
+
+USERVER_NAMESPACE_END
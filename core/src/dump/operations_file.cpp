@@ -1,11 +1,16 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <stdexcept>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -115,11 +120,59 @@ void FileReader::Finish() {
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+MmapFileReader::MmapFileReader(std::string path) : path_(std::move(path)) {
+  try {
+    const auto file = fs::blocking::FileDescriptor::Open(
+        path_, fs::blocking::OpenFlag::kRead);
+    size_ = file.GetSize();
+    // mmap fails for empty files, there is nothing to read from them anyway
+    if (size_ == 0) return;
+
+    void* data =
+        ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file.GetNative(), 0);
+    if (data == MAP_FAILED) {
+      throw std::runtime_error(
+          fmt::format("mmap failed: {}", std::strerror(errno)));
+    }
+    // the mapping outlives the file descriptor
+    mapping_ = std::shared_ptr<const char>(
+        static_cast<const char*>(data), [size = size_](const char* mapped) {
+          ::munmap(const_cast<char*>(mapped), size);
+        });
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+}
+
+std::string_view MmapFileReader::ReadRaw(std::size_t max_size) {
+  const auto size = std::min(max_size, size_ - position_);
+  const std::string_view result{mapping_.get() + position_, size};
+  position_ += size;
+  return result;
+}
+
+std::shared_ptr<const void> MmapFileReader::GetMappingOwner() const {
+  return mapping_;
+}
+
+void MmapFileReader::Finish() {
+  if (position_ != size_) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, size_, position_, size_ - position_));
+  }
+}
+
+FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms,
+                                             bool use_mmap)
+    : perms_(perms), use_mmap_(use_mmap) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
+  if (use_mmap_) return std::make_unique<MmapFileReader>(std::move(full_path));
   return std::make_unique<FileReader>(std::move(full_path));
 }
 
@@ -113,4 +113,43 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, MmapReadRaw) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  constexpr std::size_t kMaxLength = 10;
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    WriteStringViewUnsafe(writer, std::string(i, 'a'));
+  }
+  writer.Finish();
+
+  dump::MmapFileReader reader(path);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    EXPECT_EQ(ReadStringViewUnsafe(reader, i), std::string(i, 'a'));
+  }
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MmapEmptyDump) {
+  const auto file = fs::blocking::TempFile::Create();
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadUnsafeAtMost(reader, 1), "");
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MmapUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+  UEXPECT_THROW_MSG(reader.Finish(), dump::Error,
+                    "file-size=10, position=9, unread-size=1");
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#include <dump/peers.hpp>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/http/url.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/algo.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+std::optional<PeerDump> FetchDumpFromPeers(clients::http::Client& http_client,
+                                           const Config& config) {
+  const auto format_version = std::to_string(config.dump_format_version);
+
+  for (const auto& peer : config.peers) {
+    const auto url = http::MakeUrl(
+        peer, {{"name", config.name}, {"format-version", format_version}});
+
+    try {
+      auto response = http_client.CreateRequest()
+                          ->get(url)
+                          ->timeout(config.peers_timeout)
+                          ->perform();
+      if (response->status_code() == clients::http::Status::NotFound) {
+        LOG_INFO() << config.name << ": no dump at the peer \"" << peer
+                   << '"';
+        continue;
+      }
+      response->raise_for_status();
+
+      auto filename = utils::FindOrDefault(
+          response->headers(), std::string{kDumpFilenameHeader});
+      if (filename.empty()) {
+        LOG_WARNING() << config.name << ": the peer \"" << peer
+                      << "\" has not sent the dump name";
+        continue;
+      }
+
+      LOG_INFO() << config.name << ": downloaded the dump \"" << filename
+                 << "\" from the peer \"" << peer << '"';
+      return PeerDump{std::move(filename), std::move(*response).body()};
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << config.name
+                    << ": failed to download a dump from the peer \"" << peer
+                    << "\". Reason: " << ex;
+    }
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/dump/config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
+namespace dump {
+
+/// The response header of server::handlers::CacheDumps with the name of the
+/// served dump file
+inline constexpr std::string_view kDumpFilenameHeader = "X-Dump-Filename";
+
+struct PeerDump final {
+  std::string filename;
+  std::string contents;
+};
+
+/// @brief Downloads the latest dump from the first of `Config::peers` that
+/// has one, the peers are expected to serve their dumps with
+/// server::handlers::CacheDumps
+/// @returns `null` if none of the peers has a dump of the current format
+/// version
+std::optional<PeerDump> FetchDumpFromPeers(clients::http::Client& http_client,
+                                           const Config& config);
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
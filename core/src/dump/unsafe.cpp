@@ -1,5 +1,7 @@
 #include <userver/dump/unsafe.hpp>
 
+#include <cstdint>
+
 #include <fmt/format.h>
 
 #include <userver/dump/common.hpp>
@@ -9,8 +11,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+namespace {
+
+constexpr std::size_t kMaxAlignment = 64;
+constexpr char kZeroPadding[kMaxAlignment]{};
+
+}  // namespace
+
 void WriteStringViewUnsafe(Writer& writer, std::string_view value) {
   writer.WriteRaw(value);
+  writer.written_size_ += value.size();
 }
 
 std::string_view ReadStringViewUnsafe(Reader& reader) {
@@ -37,6 +47,31 @@ std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size) {
   return result;
 }
 
+void WriteAlignmentPaddingUnsafe(Writer& writer, std::size_t alignment) {
+  UASSERT(alignment > 0 && alignment <= kMaxAlignment);
+  // the padding size byte itself goes before the padding
+  const auto position = writer.written_size_ + 1;
+  const auto padding = (alignment - position % alignment) % alignment;
+  writer.Write(static_cast<std::uint8_t>(padding));
+  WriteStringViewUnsafe(writer, std::string_view{kZeroPadding, padding});
+}
+
+void ReadAlignmentPaddingUnsafe(Reader& reader) {
+  const auto padding = reader.Read<std::uint8_t>();
+  if (padding >= kMaxAlignment) {
+    throw Error(fmt::format("Invalid alignment padding in the dump: {}",
+                            static_cast<int>(padding)));
+  }
+  ReadStringViewUnsafe(reader, padding);
+}
+
+MappedStringView ReadMappedStringViewUnsafe(Reader& reader, std::size_t size) {
+  MappedStringView result;
+  result.data = ReadStringViewUnsafe(reader, size);
+  result.owner = reader.GetMappingOwner();
+  return result;
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
@@ -80,6 +80,22 @@ UTEST_F(DynamicConfigTest, VariableSnapshotPtr) {
 
 UTEST_F(DynamicConfigTest, Copy) { EXPECT_EQ(source_.GetCopy(kIntConfig), 5); }
 
+UTEST(DynamicConfig, CopyAfterUpdate) {
+  dynamic_config::StorageMock storage{{kIntConfig, 5}};
+  const auto source = storage.GetSource();
+  EXPECT_EQ(source.GetCopy(kIntConfig), 5);
+  UEXPECT_THROW(source.GetCopy(kBoolConfig), std::logic_error);
+
+  storage.Extend({{kIntConfig, 6}, {kBoolConfig, true}});
+  EXPECT_EQ(source.GetCopy(kIntConfig), 6);
+  EXPECT_EQ(source.GetCopy(kBoolConfig), true);
+
+  // the cache is per storage
+  const dynamic_config::StorageMock other_storage{{kIntConfig, 7}};
+  EXPECT_EQ(other_storage.GetSource().GetCopy(kIntConfig), 7);
+  EXPECT_EQ(source.GetCopy(kIntConfig), 6);
+}
+
 struct ByConstructor final {
   int foo{42};
 
@@ -193,6 +209,39 @@ UTEST(DynamicConfig, Extend2) {
   EXPECT_EQ(config[kIntConfig], 5);
 }
 
+class KeyListener final {
+ public:
+  explicit KeyListener(dynamic_config::Source source)
+      : subscriber_(source.UpdateAndListen(this, "test",
+                                           &KeyListener::OnConfigUpdate,
+                                           kIntConfig, kBoolConfig)) {}
+
+  ~KeyListener() { subscriber_.Unsubscribe(); }
+
+  int GetUpdateCount() const { return update_count_; }
+
+ private:
+  void OnConfigUpdate(const dynamic_config::Snapshot&) { ++update_count_; }
+
+  int update_count_{0};
+  concurrent::AsyncEventSubscriberScope subscriber_;
+};
+
+UTEST(DynamicConfig, UpdateAndListenKeys) {
+  auto storage = MakeFooConfig();
+  KeyListener listener{storage.GetSource()};
+  EXPECT_EQ(listener.GetUpdateCount(), 1);
+
+  storage.Extend({{kDummyConfig, {1, "unrelated"}}});
+  EXPECT_EQ(listener.GetUpdateCount(), 1);
+
+  storage.Extend(MakeBarConfig());
+  EXPECT_EQ(listener.GetUpdateCount(), 2);
+
+  storage.Extend({{kIntConfig, 6}});
+  EXPECT_EQ(listener.GetUpdateCount(), 3);
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,14 @@
 #include <userver/dynamic_config/impl/snapshot.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <utils/impl/static_registration.hpp>
@@ -18,6 +23,11 @@ std::vector<impl::Factory>& Registry() {
   return registry;
 }
 
+std::uint64_t NextVersion() {
+  static std::atomic<std::uint64_t> last_version{0};
+  return ++last_version;
+}
+
 }  // namespace
 
 [[noreturn]] void WrapGetError(const std::exception& ex, std::type_index type) {
@@ -35,10 +45,19 @@ impl::ConfigId Register(impl::Factory factory) {
 
 SnapshotData::SnapshotData(const std::vector<KeyValue>& config_variables) {
   utils::impl::AssertStaticRegistrationFinished();
-  user_configs_.resize(Registry().size());
+  const auto size = Registry().size();
+  user_configs_.resize(size);
+  dependencies_.resize(size);
+  versions_.resize(size, 0);
 
+  const auto version = NextVersion();
   for (const auto& config_variable : config_variables) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] =
+        std::make_shared<const std::any>(config_variable.GetValue());
+    // an override does not depend on the docs
+    dependencies_[config_variable.GetId()] =
+        std::make_shared<const std::vector<std::string>>();
+    versions_[config_variable.GetId()] = version;
   }
 }
 
@@ -47,29 +66,103 @@ SnapshotData::SnapshotData(const DocsMap& defaults,
     : SnapshotData(overrides) {
   utils::StreamingCpuRelax relax(1, nullptr);
   for (const auto [id, factory] : utils::enumerate(Registry())) {
-    if (!user_configs_[id].has_value()) {
+    if (!user_configs_[id]) {
       relax.Relax(1);
-      user_configs_[id] = factory(defaults);
+      ParseConfig(defaults, id, factory);
     }
   }
 }
 
 SnapshotData::SnapshotData(const SnapshotData& defaults,
                            const std::vector<KeyValue>& overrides)
-    : user_configs_(defaults.user_configs_) {
+    : user_configs_(defaults.user_configs_),
+      dependencies_(defaults.dependencies_),
+      versions_(defaults.versions_) {
+  const auto version = NextVersion();
   for (const auto& config_variable : overrides) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] =
+        std::make_shared<const std::any>(config_variable.GetValue());
+    // an override does not depend on the docs
+    dependencies_[config_variable.GetId()] =
+        std::make_shared<const std::vector<std::string>>();
+    versions_[config_variable.GetId()] = version;
+  }
+}
+
+SnapshotData::SnapshotData(const DocsMap& docs_map,
+                           const SnapshotData& previous,
+                           const std::unordered_set<std::string>& changed_names)
+    : user_configs_(previous.user_configs_),
+      dependencies_(previous.dependencies_),
+      versions_(previous.versions_) {
+  utils::impl::AssertStaticRegistrationFinished();
+  UASSERT(user_configs_.size() == Registry().size());
+
+  utils::StreamingCpuRelax relax(1, nullptr);
+  for (const auto [id, factory] : utils::enumerate(Registry())) {
+    if (IsAffected(id, changed_names)) {
+      relax.Relax(1);
+      ParseConfig(docs_map, id, factory);
+    } else {
+      // keeps DocsMap::GetRequestedNames in sync with a full re-parse
+      const auto& dependencies = *dependencies_[id];
+      docs_map.requested_names_.insert(dependencies.begin(),
+                                       dependencies.end());
+    }
   }
 }
 
 const std::any& SnapshotData::Get(impl::ConfigId id) const {
+  return *GetShared(id);
+}
+
+const std::shared_ptr<const std::any>& SnapshotData::GetShared(
+    impl::ConfigId id) const {
   const auto& config = user_configs_[id];
-  if (!config.has_value()) {
+  if (!config) {
     throw std::logic_error("This type is not registered as config");
   }
   return config;
 }
 
+std::uint64_t SnapshotData::GetVersion(impl::ConfigId id) const {
+  UASSERT(id < versions_.size());
+  return versions_[id];
+}
+
+void SnapshotData::ParseConfig(const DocsMap& docs_map, impl::ConfigId id,
+                               Factory factory) {
+  // Collect the names requested by this factory only. Merging the smaller set
+  // into the larger one keeps the tracking linear in the number of configs.
+  auto requested_names = std::exchange(docs_map.requested_names_, {});
+  std::any config;
+  try {
+    config = factory(docs_map);
+  } catch (...) {
+    requested_names.merge(docs_map.requested_names_);
+    docs_map.requested_names_ = std::move(requested_names);
+    throw;
+  }
+
+  dependencies_[id] = std::make_shared<const std::vector<std::string>>(
+      docs_map.requested_names_.begin(), docs_map.requested_names_.end());
+  requested_names.merge(docs_map.requested_names_);
+  docs_map.requested_names_ = std::move(requested_names);
+
+  user_configs_[id] = std::make_shared<const std::any>(std::move(config));
+  versions_[id] = NextVersion();
+}
+
+bool SnapshotData::IsAffected(
+    impl::ConfigId id,
+    const std::unordered_set<std::string>& changed_names) const {
+  const auto& dependencies = dependencies_[id];
+  if (!user_configs_[id] || !dependencies) return true;
+  return std::any_of(
+      dependencies->begin(), dependencies->end(),
+      [&](const std::string& name) { return changed_names.count(name) != 0; });
+}
+
 }  // namespace dynamic_config::impl
 
 USERVER_NAMESPACE_END
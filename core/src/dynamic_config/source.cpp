@@ -1,10 +1,38 @@
 #include <dynamic_config/storage_data.hpp>
 #include <userver/dynamic_config/source.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config {
 
+namespace {
+
+// Caches the configs of a single storage to avoid taking rcu::ReadablePtr on
+// each access. Filled lazily, reset once the storage version changes.
+struct ThreadCache final {
+  const impl::StorageData* storage{nullptr};
+  std::uint64_t version{0};
+  std::vector<std::shared_ptr<const std::any>> configs;
+};
+
+thread_local ThreadCache thread_cache;
+
+}  // namespace
+
+namespace impl {
+
+std::uint64_t NextStorageVersion() {
+  static std::atomic<std::uint64_t> last_version{0};
+  return ++last_version;
+}
+
+}  // namespace impl
+
 Source::Source(impl::StorageData& storage) : storage_(&storage) {}
 
 Snapshot Source::GetSnapshot() const { return Snapshot{*storage_}; }
@@ -19,6 +47,57 @@ concurrent::AsyncEventSubscriberScope Source::DoUpdateAndListen(
                                              [&] { func_copy(GetSnapshot()); });
 }
 
+concurrent::AsyncEventSubscriberScope Source::DoUpdateAndListen(
+    concurrent::FunctionId id, std::string_view name,
+    std::vector<impl::ConfigId> ids, EventSource::Function&& func) {
+  // Shared between the copies of the function. The initial invocation and
+  // the events are serialized by the channel, so no locking is required.
+  struct Filter final {
+    std::vector<impl::ConfigId> ids;
+    std::vector<std::uint64_t> seen_versions;
+  };
+
+  auto filter = std::make_shared<Filter>();
+  // guarantees the initial invocation
+  filter->seen_versions.resize(ids.size(),
+                               std::numeric_limits<std::uint64_t>::max());
+  filter->ids = std::move(ids);
+
+  return DoUpdateAndListen(
+      id, name,
+      [filter, func = std::move(func)](const Snapshot& config) {
+        bool is_changed = false;
+        for (std::size_t i = 0; i < filter->ids.size(); ++i) {
+          const auto version = config.GetData().GetVersion(filter->ids[i]);
+          if (version != filter->seen_versions[i]) {
+            filter->seen_versions[i] = version;
+            is_changed = true;
+          }
+        }
+        if (is_changed) func(config);
+      });
+}
+
+const std::any& Source::GetCachedConfig(impl::ConfigId id) const {
+  auto& cache = thread_cache;
+  // The version is updated after the config, so the config read below is at
+  // least as new as the version.
+  const auto version = storage_->version.load(std::memory_order_acquire);
+  if (cache.storage != storage_ || cache.version != version) {
+    cache.storage = storage_;
+    cache.version = version;
+    cache.configs.clear();
+  }
+
+  if (id >= cache.configs.size()) cache.configs.resize(id + 1);
+  auto& config = cache.configs[id];
+  if (!config) {
+    const auto data = storage_->config.Read();
+    config = data->GetShared(id);
+  }
+  return *config;
+}
+
 }  // namespace dynamic_config
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/dynamic_config/benchmark_helpers.hpp>
+#include <userver/engine/run_standalone.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct DummyConfig final {
+  int foo{42};
+
+  static DummyConfig Parse(const dynamic_config::DocsMap&) { return {}; }
+};
+
+constexpr dynamic_config::Key<DummyConfig::Parse> kDummyConfig;
+
+}  // namespace
+
+void dynamic_config_get_snapshot(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const dynamic_config::StorageMock storage{{kDummyConfig, {}}};
+    const auto source = storage.GetSource();
+
+    for (auto _ : state) {
+      const auto snapshot = source.GetSnapshot();
+      benchmark::DoNotOptimize(snapshot[kDummyConfig].foo);
+    }
+  });
+}
+BENCHMARK(dynamic_config_get_snapshot);
+
+void dynamic_config_get_copy(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const dynamic_config::StorageMock storage{{kDummyConfig, {}}};
+    const auto source = storage.GetSource();
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(source.GetCopy(kDummyConfig).foo);
+    }
+  });
+}
+BENCHMARK(dynamic_config_get_copy);
+
+void dynamic_config_get_copy_updated(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    dynamic_config::StorageMock storage{{kDummyConfig, {}}};
+    const auto source = storage.GetSource();
+
+    int i = 0;
+    for (auto _ : state) {
+      // every 16th read misses the cache
+      if (++i % 16 == 0) storage.Extend({{kDummyConfig, {i}}});
+      benchmark::DoNotOptimize(source.GetCopy(kDummyConfig).foo);
+    }
+  });
+}
+BENCHMARK(dynamic_config_get_copy_updated);
+
+USERVER_NAMESPACE_END
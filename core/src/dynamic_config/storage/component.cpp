@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <string>
 #include <unordered_set>
 
@@ -69,6 +70,8 @@ class DynamicConfig::Impl final {
 
   dynamic_config::impl::StorageData cache_{
       dynamic_config::impl::SnapshotData{{}}};
+  // the docs of the current snapshot, only accessed by the updater
+  std::optional<dynamic_config::DocsMap> last_docs_;
 
   const std::string fs_cache_path_;
   engine::TaskProcessor* fs_task_processor_;
@@ -153,10 +156,18 @@ void DynamicConfig::Impl::NotifyLoadingFailed(std::string_view updater,
 }
 
 void DynamicConfig::Impl::DoSetConfig(const dynamic_config::DocsMap& value) {
-  auto config = dynamic_config::impl::SnapshotData(value, {});
+  // Only the configs that depend on the changed docs are re-parsed, the rest
+  // are shared with the previous snapshot.
+  auto config = [&] {
+    if (!last_docs_) return dynamic_config::impl::SnapshotData(value, {});
+    const auto previous = cache_.config.Read();
+    return dynamic_config::impl::SnapshotData(
+        value, *previous, value.GetChangedNames(*last_docs_));
+  }();
+  last_docs_ = value;
   {
     std::lock_guard lock(loaded_mutex_);
-    cache_.config.Assign(std::move(config));
+    cache_.Assign(std::move(config));
     is_loaded_ = true;
   }
   loaded_cv_.NotifyAll();
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
 #include <userver/concurrent/async_event_channel.hpp>
 #include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
@@ -9,9 +13,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config::impl {
 
+// Returns a new version, unique among all the storages
+std::uint64_t NextStorageVersion();
+
 struct StorageData final {
+  void Assign(SnapshotData&& new_config) {
+    config.Assign(std::move(new_config));
+    version.store(NextStorageVersion(), std::memory_order_release);
+  }
+
   rcu::Variable<SnapshotData> config;
   concurrent::AsyncEventChannel<const Snapshot&> channel{"dynamic-config"};
+  // changes after each update of the config, allows caching it
+  std::atomic<std::uint64_t> version{NextStorageVersion()};
 };
 
 }  // namespace dynamic_config::impl
@@ -37,7 +37,7 @@ Snapshot StorageMock::GetSnapshot() const& { return GetSource().GetSnapshot(); }
 void StorageMock::Extend(const std::vector<KeyValue>& overrides) {
   UASSERT(storage_);
   const auto old_config = storage_->config.Read();
-  storage_->config.Assign(impl::SnapshotData{*old_config, overrides});
+  storage_->Assign(impl::SnapshotData{*old_config, overrides});
   storage_->channel.SendEvent(GetSnapshot());
 }
 
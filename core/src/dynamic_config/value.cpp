@@ -78,6 +78,21 @@ bool DocsMap::AreContentsEqual(const DocsMap& other) const {
   return docs_ == other.docs_;
 }
 
+std::unordered_set<std::string> DocsMap::GetChangedNames(
+    const DocsMap& previous) const {
+  std::unordered_set<std::string> changed_names;
+  for (const auto& [name, value] : docs_) {
+    const auto it = previous.docs_.find(name);
+    if (it == previous.docs_.end() || it->second != value) {
+      changed_names.insert(name);
+    }
+  }
+  for (const auto& [name, value] : previous.docs_) {
+    if (docs_.count(name) == 0) changed_names.insert(name);
+  }
+  return changed_names;
+}
+
 const std::string kValueDictDefaultName = "__default__";
 
 }  // namespace dynamic_config
@@ -29,6 +29,18 @@ TEST(DocsMap, AreContentsEqualFalse) {
   EXPECT_FALSE(docs_map1.AreContentsEqual(docs_map2));
 }
 
+TEST(DocsMap, GetChangedNames) {
+  dynamic_config::DocsMap previous;
+  previous.Parse(R"({"a": "a", "b": "b", "c": "c"})", false);
+
+  dynamic_config::DocsMap current;
+  current.Parse(R"({"a": "a", "b": "x", "d": "d"})", false);
+
+  EXPECT_EQ(current.GetChangedNames(previous),
+            (std::unordered_set<std::string>{"b", "c", "d"}));
+  EXPECT_TRUE(previous.GetChangedNames(previous).empty());
+}
+
 TEST(ValueDict, UseAsRange) {
   using ValueDict = dynamic_config::ValueDict<int>;
 
@@ -1,16 +1,27 @@
 #pragma once
 
 #include <algorithm>  // for std::max
+#include <array>
 #include <atomic>
 #include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <utility>
+#include <vector>
+
+#include <sys/mman.h>
 
 #include <moodycamel/concurrentqueue.h>
+#include <uboost_coro/context/stack_context.hpp>
+#include <uboost_coro/context/stack_traits.hpp>
 #include <uboost_coro/coroutine2/coroutine.hpp>
 #include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <utils/threads.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
@@ -36,26 +47,86 @@ class Pool final {
   std::size_t GetStackSize() const;
 
  private:
-  Coroutine CreateCoroutine(bool quiet = false);
+  using StackContext = boost::context::stack_context;
+
+  // Remembers the stack of the coroutine being created
+  class StackAllocator final {
+   public:
+    StackAllocator(boost::coroutines2::protected_fixedsize_stack impl,
+                   StackContext& allocated)
+        : impl_(impl), allocated_(&allocated) {}
+
+    StackContext allocate() {
+      auto stack = impl_.allocate();
+      *allocated_ = stack;
+      return stack;
+    }
+
+    void deallocate(StackContext& stack) noexcept { impl_.deallocate(stack); }
+
+   private:
+    boost::coroutines2::protected_fixedsize_stack impl_;
+    StackContext* allocated_;
+  };
+
+  struct IdleCoroutine final {
+    Coroutine coroutine;
+    StackContext stack;
+    // filled only if the stacks are released
+    std::size_t resident_bytes{0};
+  };
+
+  IdleCoroutine CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
 
+  using CoroutinesQueue = moodycamel::ConcurrentQueue<IdleCoroutine>;
+
+  CoroutinesQueue& GetLocalQueue() noexcept;
+  std::optional<IdleCoroutine> TryGetCoroutine();
+  std::size_t GetIdleCoroutinesApprox() const;
+
+  bool ShouldSampleStackUsage() noexcept;
+  void SampleStackUsage(std::size_t usage) noexcept;
+  static std::optional<std::size_t> GetStackUsage(
+      const StackContext& stack) noexcept;
+  std::size_t ReleaseStack(const StackContext& stack,
+                           std::size_t usage) const noexcept;
+
+  bool ShouldShrink() const noexcept;
+  void DropIdleCoroutine();
+
   template <typename Token>
   Token& GetToken();
 
+  static inline std::atomic<std::uint64_t> next_id_{1};
+
+  const std::uint64_t id_{next_id_++};
   const PoolConfig config_;
   const Executor executor_;
 
   boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-  moodycamel::ConcurrentQueue<Coroutine> coroutines_;
+
+  // Coroutines are kept on the NUMA node where they were last used. Fresh
+  // stacks are first touched by the thread that runs them, so with pinned
+  // workers the stack memory stays local to their node.
+  utils::FixedArray<CoroutinesQueue> coroutines_;
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+
+  std::array<std::atomic<std::size_t>, PoolStats::kStackUsageBuckets>
+      stack_usage_samples_{};
+  std::atomic<std::size_t> max_stack_usage_{0};
+
+  std::atomic<std::size_t> idle_stack_resident_bytes_{0};
+  std::atomic<std::chrono::steady_clock::rep> last_shortage_time_{
+      std::chrono::steady_clock::now().time_since_epoch().count()};
 };
 
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(IdleCoroutine&& coro, Pool<Task>& pool) noexcept
+      : coro_(std::move(coro.coroutine)), stack_(coro.stack), pool_(&pool) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -75,8 +146,11 @@ class Pool<Task>::CoroutinePtr final {
     pool_->PutCoroutine(std::move(*this));
   }
 
+  const StackContext& GetStack() const noexcept { return stack_; }
+
  private:
   Coroutine coro_;
+  StackContext stack_;
   Pool<Task>* pool_;
 };
 
@@ -85,12 +159,14 @@ Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
       stack_allocator_(config.stack_size),
-      coroutines_(config_.max_size),
+      coroutines_(utils::GetNumaNodesCount(), config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
-  moodycamel::ProducerToken token(coroutines_);
+  // Threads that are not bound to a NUMA node use the first queue
+  auto& queue = coroutines_[0];
+  moodycamel::ProducerToken token(queue);
   for (std::size_t i = 0; i < config_.initial_size; ++i) {
-    bool ok = coroutines_.enqueue(token, CreateCoroutine(/*quiet =*/true));
+    bool ok = queue.enqueue(token, CreateCoroutine(/*quiet =*/true));
     UINVARIANT(ok, "Failed to allocate the initial coro pool");
   }
 }
@@ -100,21 +176,16 @@ Pool<Task>::~Pool() = default;
 
 template <typename Task>
 typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
-  struct CoroutineMover {
-    std::optional<Coroutine>& result;
-
-    CoroutineMover& operator=(Coroutine&& coro) {
-      result.emplace(std::move(coro));
-      return *this;
-    }
-  };
-
-  std::optional<Coroutine> coroutine;
-  CoroutineMover mover{coroutine};
-  auto& token = GetToken<moodycamel::ConsumerToken>();
-  if (coroutines_.try_dequeue(token, mover)) {
+  auto coroutine = TryGetCoroutine();
+  if (coroutine) {
     --idle_coroutines_num_;
+    idle_stack_resident_bytes_ -= coroutine->resident_bytes;
   } else {
+    if (config_.idle_shrink_period.count() != 0) {
+      last_shortage_time_.store(
+          std::chrono::steady_clock::now().time_since_epoch().count(),
+          std::memory_order_relaxed);
+    }
     coroutine.emplace(CreateCoroutine());
   }
   return CoroutinePtr(std::move(*coroutine), *this);
@@ -122,32 +193,67 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
+  const auto& stack = coroutine_ptr.GetStack();
+  const bool should_sample = ShouldSampleStackUsage();
+  const bool should_release = config_.stack_release_watermark != 0;
+  std::size_t resident_bytes = 0;
+  if (should_sample || should_release) {
+    const auto usage = GetStackUsage(stack);
+    if (usage && should_sample) SampleStackUsage(*usage);
+    if (usage && should_release) resident_bytes = ReleaseStack(stack, *usage);
+  }
+
   if (idle_coroutines_num_.load() >= config_.max_size) return;
+  if (ShouldShrink()) {
+    // also drop an idle coroutine, otherwise the coroutines that are not
+    // needed during the quiet period would never be destroyed
+    if (idle_coroutines_num_.load() > config_.initial_size) {
+      DropIdleCoroutine();
+    }
+    return;
+  }
+
+  // accounted before the coroutine may be taken by another thread
+  idle_stack_resident_bytes_ += resident_bytes;
   auto& token = GetToken<moodycamel::ProducerToken>();
-  const bool ok = coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
-  if (ok) ++idle_coroutines_num_;
+  const bool ok = GetLocalQueue().enqueue(
+      token, IdleCoroutine{std::move(coroutine_ptr.Get()), stack,
+                           resident_bytes});
+  if (ok) {
+    ++idle_coroutines_num_;
+  } else {
+    idle_stack_resident_bytes_ -= resident_bytes;
+  }
 }
 
 template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
   PoolStats stats;
   stats.active_coroutines =
-      total_coroutines_num_.load() - coroutines_.size_approx();
+      total_coroutines_num_.load() - GetIdleCoroutinesApprox();
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
+
+  for (std::size_t i = 0; i < PoolStats::kStackUsageBuckets; ++i) {
+    stats.stack_usage_samples[i] =
+        stack_usage_samples_[i].load(std::memory_order_relaxed);
+  }
+  stats.max_stack_usage = max_stack_usage_.load(std::memory_order_relaxed);
+  stats.idle_stack_resident_bytes = idle_stack_resident_bytes_.load();
   return stats;
 }
 
 template <typename Task>
-typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
+typename Pool<Task>::IdleCoroutine Pool<Task>::CreateCoroutine(bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
+    StackContext stack;
+    Coroutine coroutine(StackAllocator{stack_allocator_, stack}, executor_);
     const auto new_total = ++total_coroutines_num_;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
                   << config_.max_size;
     }
-    return coroutine;
+    return {std::move(coroutine), stack};
   } catch (const std::bad_alloc&) {
     if (errno == ENOMEM) {
       // It should be ok to allocate here (which LOG_ERROR might do),
@@ -175,11 +281,149 @@ std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
 }
 
+template <typename Task>
+typename Pool<Task>::CoroutinesQueue& Pool<Task>::GetLocalQueue() noexcept {
+  const auto node = utils::GetCurrentThreadNumaNode();
+  return coroutines_[node < coroutines_.size() ? node : 0];
+}
+
+template <typename Task>
+std::optional<typename Pool<Task>::IdleCoroutine>
+Pool<Task>::TryGetCoroutine() {
+  struct CoroutineMover {
+    std::optional<IdleCoroutine>& result;
+
+    CoroutineMover& operator=(IdleCoroutine&& coro) {
+      result.emplace(std::move(coro));
+      return *this;
+    }
+  };
+
+  std::optional<IdleCoroutine> coroutine;
+  CoroutineMover mover{coroutine};
+  auto& token = GetToken<moodycamel::ConsumerToken>();
+  if (GetLocalQueue().try_dequeue(token, mover)) return coroutine;
+
+  // Reusing a remote stack is still cheaper than mmap-ing a new one
+  for (auto& queue : coroutines_) {
+    if (&queue != &GetLocalQueue() && queue.try_dequeue(mover)) {
+      return coroutine;
+    }
+  }
+  return coroutine;
+}
+
+template <typename Task>
+std::size_t Pool<Task>::GetIdleCoroutinesApprox() const {
+  std::size_t result = 0;
+  for (const auto& queue : coroutines_) result += queue.size_approx();
+  return result;
+}
+
+template <typename Task>
+bool Pool<Task>::ShouldSampleStackUsage() noexcept {
+  if (config_.stack_usage_sampling_period == 0) return false;
+
+  thread_local std::size_t returned_count = 0;
+  if (++returned_count < config_.stack_usage_sampling_period) return false;
+  returned_count = 0;
+  return true;
+}
+
+template <typename Task>
+std::optional<std::size_t> Pool<Task>::GetStackUsage(
+    const StackContext& stack) noexcept {
+  // Unless released, the pages that were touched at least once stay resident.
+  // The lowest resident page above the guard page is the high-water mark of
+  // the stack.
+  const auto page_size = boost::context::stack_traits::page_size();
+  const auto pages = stack.size / page_size - 1;  // without the guard page
+  auto* const bottom = static_cast<char*>(stack.sp) - pages * page_size;
+
+  thread_local std::vector<unsigned char> residency;
+  residency.resize(pages);
+  if (::mincore(bottom, pages * page_size, residency.data()) != 0) {
+    return std::nullopt;
+  }
+
+  std::size_t used_pages = 0;
+  for (std::size_t i = 0; i < pages; ++i) {
+    if (residency[i] & 1) {
+      used_pages = pages - i;
+      break;
+    }
+  }
+  return used_pages * page_size;
+}
+
+template <typename Task>
+std::size_t Pool<Task>::ReleaseStack(const StackContext& stack,
+                                     std::size_t usage) const noexcept {
+  const auto page_size = boost::context::stack_traits::page_size();
+  const auto kept_bytes =
+      (config_.stack_release_watermark + page_size - 1) / page_size * page_size;
+  if (usage <= kept_bytes) return usage;
+
+  // The stack grows down from stack.sp, the pages below the watermark are
+  // zero-filled on the next touch
+  auto* const watermark = static_cast<char*>(stack.sp) - kept_bytes;
+  if (::madvise(watermark - (usage - kept_bytes), usage - kept_bytes,
+                MADV_DONTNEED) != 0) {
+    return usage;
+  }
+  return kept_bytes;
+}
+
+template <typename Task>
+bool Pool<Task>::ShouldShrink() const noexcept {
+  // the coroutine being returned is not counted as idle yet
+  if (config_.idle_shrink_period.count() == 0 ||
+      idle_coroutines_num_.load() < config_.initial_size) {
+    return false;
+  }
+
+  const std::chrono::steady_clock::time_point last_shortage{
+      std::chrono::steady_clock::duration{
+          last_shortage_time_.load(std::memory_order_relaxed)}};
+  return std::chrono::steady_clock::now() - last_shortage >=
+         config_.idle_shrink_period;
+}
+
+template <typename Task>
+void Pool<Task>::DropIdleCoroutine() {
+  auto coroutine = TryGetCoroutine();
+  if (!coroutine) return;
+
+  --idle_coroutines_num_;
+  idle_stack_resident_bytes_ -= coroutine->resident_bytes;
+  OnCoroutineDestruction();
+}
+
+template <typename Task>
+void Pool<Task>::SampleStackUsage(std::size_t usage) noexcept {
+  ++stack_usage_samples_[PoolStats::GetStackUsageBucket(usage)];
+
+  auto max_usage = max_stack_usage_.load(std::memory_order_relaxed);
+  while (usage > max_usage &&
+         !max_stack_usage_.compare_exchange_weak(max_usage, usage,
+                                                 std::memory_order_relaxed)) {
+  }
+}
+
 template <typename Task>
 template <typename Token>
 Token& Pool<Task>::GetToken() {
-  thread_local Token token(coroutines_);
-  return token;
+  // There may be multiple pools (one per stack size) and a worker thread uses
+  // only one of them, but the tokens must not outlive their pool.
+  // The NUMA node of a thread is set before the first coroutine is requested
+  // and never changes.
+  thread_local std::optional<Token> token;
+  thread_local std::uint64_t token_pool_id = 0;
+  if (token_pool_id != id_) {
+    token.emplace(GetLocalQueue());
+    token_pool_id = id_;
+  }
+  return *token;
 }
 
 }  // namespace engine::coro
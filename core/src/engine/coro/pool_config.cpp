@@ -10,6 +10,14 @@ PoolConfig Parse(const yaml_config::YamlConfig& value,
   config.initial_size = value["initial_size"].As<size_t>();
   config.max_size = value["max_size"].As<size_t>();
   config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
+  config.stack_usage_sampling_period =
+      value["stack_usage_sampling_period"].As<size_t>(
+          config.stack_usage_sampling_period);
+  config.stack_release_watermark = value["stack_release_watermark"].As<size_t>(
+      config.stack_release_watermark);
+  config.idle_shrink_period =
+      value["idle_shrink_period"].As<std::chrono::seconds>(
+          config.idle_shrink_period);
   return config;
 }
 
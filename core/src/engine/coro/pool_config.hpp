@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include <userver/formats/yaml.hpp>
@@ -13,6 +14,18 @@ struct PoolConfig {
   size_t initial_size = 1000;
   size_t max_size = 10000;
   size_t stack_size = 256 * 1024ULL;
+
+  /// Measure the stack usage of each Nth coroutine returned to the pool,
+  /// 0 disables the sampling
+  size_t stack_usage_sampling_period = 0;
+
+  /// Release the pages of the stacks returned to the pool that were touched
+  /// deeper than this many bytes, 0 disables the releasing
+  size_t stack_release_watermark = 0;
+
+  /// Destroy the idle coroutines above initial_size once the pool has not run
+  /// out of coroutines for this long, 0 disables the shrinking
+  std::chrono::seconds idle_shrink_period{0};
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
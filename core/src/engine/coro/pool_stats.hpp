@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <utility>
 
@@ -8,13 +10,43 @@ USERVER_NAMESPACE_BEGIN
 namespace engine::coro {
 
 struct PoolStats {
+  /// Stack usage histogram buckets: up to 4KiB, 8KiB, ..., 512KiB and more
+  static constexpr size_t kStackUsageBuckets = 9;
+  static constexpr size_t kFirstStackUsageBucketBound = 4 * 1024;
+
+  static constexpr size_t GetStackUsageBucketBound(size_t bucket) {
+    return kFirstStackUsageBucketBound << bucket;
+  }
+
+  static constexpr size_t GetStackUsageBucket(size_t usage) {
+    size_t bucket = 0;
+    while (bucket + 1 < kStackUsageBuckets &&
+           usage > GetStackUsageBucketBound(bucket)) {
+      ++bucket;
+    }
+    return bucket;
+  }
+
   size_t active_coroutines = 0;
   size_t total_coroutines = 0;
+
+  /// Filled only if PoolConfig::stack_usage_sampling_period is set
+  std::array<size_t, kStackUsageBuckets> stack_usage_samples{};
+  size_t max_stack_usage = 0;
+
+  /// Resident bytes of the stacks of the idle coroutines, filled only if
+  /// PoolConfig::stack_release_watermark is set
+  size_t idle_stack_resident_bytes = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
   lhs.active_coroutines += rhs.active_coroutines;
   lhs.total_coroutines += rhs.total_coroutines;
+  for (size_t i = 0; i < PoolStats::kStackUsageBuckets; ++i) {
+    lhs.stack_usage_samples[i] += rhs.stack_usage_samples[i];
+  }
+  lhs.max_stack_usage = std::max(lhs.max_stack_usage, rhs.max_stack_usage);
+  lhs.idle_stack_resident_bytes += rhs.idle_stack_resident_bytes;
   return lhs;
 }
 
@@ -0,0 +1,124 @@
+#include <engine/coro/pool.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct StackConsumer final {
+  std::size_t bytes;
+};
+
+using Pool = engine::coro::Pool<StackConsumer>;
+
+char ConsumeStack(std::size_t bytes) {
+  constexpr std::size_t kChunk = 1024;
+  volatile char buffer[kChunk];
+  std::memset(const_cast<char*>(buffer), 1, kChunk);
+  // not a tail call, each frame stays on the stack
+  if (bytes > kChunk) buffer[0] = ConsumeStack(bytes - kChunk);
+  return buffer[0];
+}
+
+void Executor(Pool::TaskPipe& pipe) {
+  for (StackConsumer* consumer : pipe) {
+    if (consumer) ConsumeStack(consumer->bytes);
+  }
+}
+
+engine::coro::PoolConfig MakeConfig(std::size_t sampling_period) {
+  engine::coro::PoolConfig config;
+  config.initial_size = 0;
+  config.max_size = 10;
+  config.stack_usage_sampling_period = sampling_period;
+  return config;
+}
+
+void RunOnce(Pool& pool, std::size_t stack_bytes) {
+  auto coroutine = pool.GetCoroutine();
+  StackConsumer consumer{stack_bytes};
+  coroutine.Get()(&consumer);
+  std::move(coroutine).ReturnToPool();
+}
+
+}  // namespace
+
+TEST(CoroPool, StackUsageBuckets) {
+  using engine::coro::PoolStats;
+
+  EXPECT_EQ(PoolStats::GetStackUsageBucket(0), 0);
+  EXPECT_EQ(PoolStats::GetStackUsageBucket(4 * 1024), 0);
+  EXPECT_EQ(PoolStats::GetStackUsageBucket(4 * 1024 + 1), 1);
+  EXPECT_EQ(PoolStats::GetStackUsageBucket(64 * 1024), 4);
+  EXPECT_EQ(PoolStats::GetStackUsageBucket(100 * 1024 * 1024),
+            PoolStats::kStackUsageBuckets - 1);
+}
+
+TEST(CoroPool, StackUsageSamplingDisabled) {
+  Pool pool(MakeConfig(0), &Executor);
+  RunOnce(pool, 32 * 1024);
+
+  const auto stats = pool.GetStats();
+  EXPECT_EQ(stats.max_stack_usage, 0);
+  for (auto samples : stats.stack_usage_samples) EXPECT_EQ(samples, 0);
+}
+
+TEST(CoroPool, StackUsageSampling) {
+  Pool pool(MakeConfig(1), &Executor);
+  RunOnce(pool, 64 * 1024);
+
+  const auto stats = pool.GetStats();
+  EXPECT_GE(stats.max_stack_usage, 64 * 1024);
+  EXPECT_LT(stats.max_stack_usage, pool.GetStackSize());
+
+  std::size_t total_samples = 0;
+  for (auto samples : stats.stack_usage_samples) total_samples += samples;
+  EXPECT_EQ(total_samples, 1);
+  EXPECT_EQ(stats.stack_usage_samples[engine::coro::PoolStats::
+                                          GetStackUsageBucket(
+                                              stats.max_stack_usage)],
+            1);
+}
+
+TEST(CoroPool, StackRelease) {
+  auto config = MakeConfig(1);
+  config.stack_release_watermark = 16 * 1024;
+  Pool pool(config, &Executor);
+
+  RunOnce(pool, 128 * 1024);
+  EXPECT_GE(pool.GetStats().max_stack_usage, 128 * 1024);
+  EXPECT_EQ(pool.GetStats().idle_stack_resident_bytes, 16 * 1024);
+
+  // the released pages are measured as not used
+  RunOnce(pool, 0);
+  const auto stats = pool.GetStats();
+  EXPECT_EQ(stats.idle_stack_resident_bytes, 16 * 1024);
+  EXPECT_EQ(stats.stack_usage_samples[engine::coro::PoolStats::
+                                          GetStackUsageBucket(16 * 1024)],
+            1);
+}
+
+TEST(CoroPool, IdleShrink) {
+  auto config = MakeConfig(0);
+  config.initial_size = 1;
+  config.idle_shrink_period = std::chrono::seconds{1};
+  Pool pool(config, &Executor);
+
+  {
+    std::vector<Pool::CoroutinePtr> coroutines;
+    for (int i = 0; i < 4; ++i) coroutines.push_back(pool.GetCoroutine());
+    for (auto& coroutine : coroutines) std::move(coroutine).ReturnToPool();
+  }
+  EXPECT_EQ(pool.GetStats().total_coroutines, 4);
+
+  std::this_thread::sleep_for(config.idle_shrink_period);
+  for (int i = 0; i < 4; ++i) RunOnce(pool, 0);
+  EXPECT_EQ(pool.GetStats().total_coroutines, 1);
+}
+
+USERVER_NAMESPACE_END
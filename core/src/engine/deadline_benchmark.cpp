@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <memory>
+#include <vector>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -47,6 +50,32 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+void OnWheelTimer(engine::ev::TimerWheel::Entry&) noexcept {}
+
+// The common case of a deadline timer: the operation finishes before the
+// deadline and the timer is cancelled. range(0) is the number of the other
+// timers in the wheel.
+void timer_wheel_schedule_cancel(benchmark::State& state) {
+  using Clock = engine::ev::TimerWheel::Clock;
+  const auto now = Clock::now();
+  engine::ev::TimerWheel wheel(now);
+
+  std::vector<std::unique_ptr<engine::ev::TimerWheel::Entry>> others;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    auto& entry = *others.emplace_back(
+        std::make_unique<engine::ev::TimerWheel::Entry>(&OnWheelTimer));
+    wheel.Schedule(entry, now + std::chrono::milliseconds{i % 100'000});
+  }
+
+  engine::ev::TimerWheel::Entry entry{&OnWheelTimer};
+  for (auto _ : state) {
+    wheel.Schedule(entry, now + std::chrono::milliseconds{20});
+    wheel.Cancel(entry);
+  }
+
+  for (auto& other : others) wheel.Cancel(*other);
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +85,6 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(timer_wheel_schedule_cancel)->Range(1, 1 << 16);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,474 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <build_config.hpp>
+#include <engine/ev/thread.hpp>
+#include <engine/impl/wait_list_light.hpp>
+#include <engine/task/task_context.hpp>
+#include <utils/impl/assert_extra.hpp>
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+namespace {
+
+// Low bit of a pending queue item marks a cancellation request
+constexpr std::uintptr_t kCancelFlag = 1;
+
+// user_data of the cancellation requests, their completions are ignored
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+constexpr std::size_t kInitPendingQueueCapacity = 128;
+
+}  // namespace
+
+class IoUringOperation::WaitStrategy final : public engine::impl::WaitStrategy {
+ public:
+  WaitStrategy(Deadline deadline, IoUringOperation& op,
+               engine::impl::TaskContext& current)
+      : engine::impl::WaitStrategy(deadline), op_(op), current_(current) {}
+
+  void SetupWakeups() override {
+    op_.waiters_->Append(&current_);
+    if (op_.is_completed_.load()) op_.waiters_->WakeupOne();
+  }
+
+  void DisableWakeups() override { op_.waiters_->Remove(current_); }
+
+ private:
+  IoUringOperation& op_;
+  engine::impl::TaskContext& current_;
+};
+
+IoUringOperation::IoUringOperation() = default;
+
+IoUringOperation::~IoUringOperation() = default;
+
+void IoUringOperation::Prepare(std::uint8_t opcode, int fd, std::uint64_t addr,
+                               std::uint32_t len, std::uint64_t off,
+                               std::uint32_t op_flags) noexcept {
+  UASSERT_MSG(!is_completed_, "IoUringOperation must not be reused");
+  request_ = {opcode, fd, addr, len, off, op_flags};
+}
+
+bool IoUringOperation::Wait(Deadline deadline) {
+  auto& current = current_task::GetCurrentTaskContext();
+  if (current.ShouldCancel()) return is_completed_;
+
+  WaitStrategy wait_strategy(deadline, *this, current);
+  current.Sleep(wait_strategy);
+  return is_completed_;
+}
+
+void IoUringOperation::Complete(int result) noexcept {
+  result_ = result;
+  is_completed_ = true;
+  waiters_->WakeupOne();
+  // The waiter may destroy the operation right after this call
+  finished_.Send();
+}
+
+IoUringOperation::Status IoUring::Execute(IoUringOperation& op,
+                                          Deadline deadline) {
+  if (current_task::ShouldCancel()) return IoUringOperation::Status::kCancelled;
+  if (deadline.IsReached()) return IoUringOperation::Status::kTimeout;
+
+  Enqueue(&op);
+  auto status = IoUringOperation::Status::kCompleted;
+  if (!op.Wait(deadline)) {
+    Cancel(op);
+    status = current_task::ShouldCancel()
+                 ? IoUringOperation::Status::kCancelled
+                 : IoUringOperation::Status::kTimeout;
+  }
+
+  // The kernel may use the buffers until the completion arrives
+  op.finished_.WaitNonCancellable();
+  if (op.result_ != -ECANCELED) status = IoUringOperation::Status::kCompleted;
+  return status;
+}
+
+void IoUring::Enqueue(IoUringOperation* op) {
+  const auto item = reinterpret_cast<std::uintptr_t>(op);
+  UASSERT((item & kCancelFlag) == 0);
+  if (!pending_.push(item)) {
+    throw std::runtime_error("can't push io_uring operation to queue");
+  }
+
+  if (thread_.IsInEvThread()) {
+    Flush();
+  } else if (!is_flush_scheduled_.exchange(true)) {
+    ev_async_send(thread_.GetEvLoop(), &flush_watcher_);
+  }
+}
+
+void IoUring::Cancel(const IoUringOperation& op) {
+  const auto item = reinterpret_cast<std::uintptr_t>(&op) | kCancelFlag;
+  if (!pending_.push(item)) {
+    // The operation can't be left in flight, its buffers are on the stack
+    utils::impl::AbortWithStacktrace("can't push io_uring cancellation");
+  }
+
+  if (thread_.IsInEvThread()) {
+    Flush();
+  } else if (!is_flush_scheduled_.exchange(true)) {
+    ev_async_send(thread_.GetEvLoop(), &flush_watcher_);
+  }
+}
+
+void IoUring::FlushCb(struct ev_loop*, ev_async* w, int) noexcept {
+  auto* self = static_cast<IoUring*>(w->data);
+  UASSERT(self);
+  self->Flush();
+}
+
+void IoUring::CompletionCb(struct ev_loop*, ev_io* w, int) noexcept {
+  auto* self = static_cast<IoUring*>(w->data);
+  UASSERT(self);
+  self->ReapCompletions();
+}
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+namespace {
+
+constexpr unsigned kSubmissionQueueEntries = 256;
+constexpr unsigned kCompletionQueueEntries = kSubmissionQueueEntries * 4;
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_enter, fd, to_submit, 0, 0, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, const void* arg,
+                    unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T* RingPtr(void* ring, std::uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+struct IoUring::Ring final {
+  Ring() = default;
+  Ring(const Ring&) = delete;
+  Ring& operator=(const Ring&) = delete;
+
+  ~Ring() {
+    if (sqes) ::munmap(sqes, sqes_size);
+    if (ring) ::munmap(ring, ring_size);
+    if (event_fd != -1) ::close(event_fd);
+    if (fd != -1) ::close(fd);
+  }
+
+  // Returns nullptr if the submission queue is full
+  io_uring_sqe* GetSqe() noexcept {
+    const auto head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (sq_tail_local - head >= sq_entries) return nullptr;
+    const auto index = sq_tail_local & *sq_mask;
+    sq_array[index] = index;
+    ++sq_tail_local;
+    auto* sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+  }
+
+  void Submit() noexcept {
+    __atomic_store_n(sq_tail, sq_tail_local, __ATOMIC_RELEASE);
+    while (true) {
+      const auto to_submit =
+          sq_tail_local - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+      if (to_submit == 0) return;
+
+      const auto submitted = IoUringEnter(fd, to_submit);
+      if (submitted == 0) return;
+      if (submitted < 0) {
+        const auto error_code = errno;
+        if (error_code == EINTR) continue;
+        // EAGAIN/EBUSY: resources are exhausted, the entries stay in the
+        // queue and are submitted on the next flush or completion
+        if (error_code != EAGAIN && error_code != EBUSY) {
+          LOG_ERROR() << "io_uring_enter failed: "
+                      << std::error_code(error_code, std::system_category())
+                             .message();
+        }
+        return;
+      }
+    }
+  }
+
+  int fd{-1};
+  int event_fd{-1};
+
+  void* ring{nullptr};
+  std::size_t ring_size{0};
+  io_uring_sqe* sqes{nullptr};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned* sq_mask{nullptr};
+  unsigned* sq_array{nullptr};
+  unsigned sq_entries{0};
+  unsigned sq_tail_local{0};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  unsigned* cq_mask{nullptr};
+  io_uring_cqe* cqes{nullptr};
+};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(Thread& thread) {
+  auto ring = std::make_unique<Ring>();
+
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionQueueEntries;
+  ring->fd = IoUringSetup(kSubmissionQueueEntries, &params);
+  if (ring->fd < 0) {
+    const auto error_code = errno;
+    LOG_WARNING() << "io_uring is not available, falling back to epoll: "
+                  << std::error_code(error_code, std::system_category())
+                         .message();
+    return nullptr;
+  }
+
+  // FAST_POLL (Linux 5.7) is required for socket requests not to occupy
+  // kernel worker threads while waiting for the data
+  constexpr auto kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    LOG_WARNING() << "io_uring of this kernel lacks required features, "
+                     "falling back to epoll";
+    return nullptr;
+  }
+
+  ring->ring_size =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring->ring = ::mmap(nullptr, ring->ring_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (ring->ring == MAP_FAILED) {
+    ring->ring = nullptr;
+    LOG_WARNING() << "Failed to map io_uring queues, falling back to epoll";
+    return nullptr;
+  }
+
+  ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    LOG_WARNING() << "Failed to map io_uring entries, falling back to epoll";
+    return nullptr;
+  }
+  ring->sqes = static_cast<io_uring_sqe*>(sqes);
+
+  ring->sq_head = RingPtr<unsigned>(ring->ring, params.sq_off.head);
+  ring->sq_tail = RingPtr<unsigned>(ring->ring, params.sq_off.tail);
+  ring->sq_mask = RingPtr<unsigned>(ring->ring, params.sq_off.ring_mask);
+  ring->sq_array = RingPtr<unsigned>(ring->ring, params.sq_off.array);
+  ring->sq_entries = params.sq_entries;
+  ring->sq_tail_local = *ring->sq_tail;
+
+  ring->cq_head = RingPtr<unsigned>(ring->ring, params.cq_off.head);
+  ring->cq_tail = RingPtr<unsigned>(ring->ring, params.cq_off.tail);
+  ring->cq_mask = RingPtr<unsigned>(ring->ring, params.cq_off.ring_mask);
+  ring->cqes = RingPtr<io_uring_cqe>(ring->ring, params.cq_off.cqes);
+
+  ring->event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (ring->event_fd < 0 ||
+      IoUringRegister(ring->fd, IORING_REGISTER_EVENTFD, &ring->event_fd, 1) <
+          0) {
+    LOG_WARNING() << "Failed to register io_uring eventfd, falling back to "
+                     "epoll";
+    return nullptr;
+  }
+
+  LOG_INFO() << "io_uring enabled for " << thread.GetName()
+             << ", sq_entries=" << params.sq_entries
+             << ", cq_entries=" << params.cq_entries;
+  return std::unique_ptr<IoUring>(new IoUring(thread, std::move(ring)));
+}
+
+IoUring::IoUring(Thread& thread, std::unique_ptr<Ring> ring)
+    : thread_(thread),
+      ring_(std::move(ring)),
+      pending_(kInitPendingQueueCapacity) {
+  flush_watcher_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_async_init(&flush_watcher_, FlushCb);
+  ev_async_start(thread_.GetEvLoop(), &flush_watcher_);
+
+  completion_watcher_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_io_init(&completion_watcher_, CompletionCb, ring_->event_fd, EV_READ);
+  ev_io_start(thread_.GetEvLoop(), &completion_watcher_);
+}
+
+void IoUring::Flush() noexcept {
+  UASSERT(thread_.IsInEvThread());
+  is_flush_scheduled_ = false;
+
+  // Requests must reach the kernel in the enqueue order, otherwise a stale
+  // cancellation may hit a newer request with the same address
+  std::uintptr_t item = 0;
+  while (!deferred_.empty() || pending_.pop(item)) {
+    if (!deferred_.empty()) {
+      item = deferred_.front();
+      deferred_.pop_front();
+    }
+
+    auto* sqe = ring_->GetSqe();
+    if (!sqe) {
+      // The queue is full, hand the batch to the kernel and retry
+      ring_->Submit();
+      sqe = ring_->GetSqe();
+    }
+    if (!sqe) {
+      // Still full: the kernel is out of resources, retry on completions
+      deferred_.push_front(item);
+      while (pending_.pop(item)) deferred_.push_back(item);
+      break;
+    }
+
+    auto* op = reinterpret_cast<IoUringOperation*>(item & ~kCancelFlag);
+    if (item & kCancelFlag) {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->addr = reinterpret_cast<std::uint64_t>(op);
+      sqe->user_data = kIgnoredUserData;
+      continue;
+    }
+
+    const auto& request = op->request_;
+    sqe->opcode = request.opcode;
+    sqe->fd = request.fd;
+    sqe->addr = request.addr;
+    sqe->len = request.len;
+    sqe->off = request.off;
+    // msg_flags, accept_flags and poll32_events share the same union
+    sqe->msg_flags = request.op_flags;
+    sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+  }
+
+  ring_->Submit();
+}
+
+void IoUring::ReapCompletions() noexcept {
+  UASSERT(thread_.IsInEvThread());
+
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto res =
+      ::read(ring_->event_fd, &counter, sizeof(counter));
+
+  auto head = *ring_->cq_head;
+  const auto tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const auto& cqe = ring_->cqes[head & *ring_->cq_mask];
+    if (cqe.user_data == kIgnoredUserData) continue;
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    reinterpret_cast<IoUringOperation*>(cqe.user_data)->Complete(cqe.res);
+  }
+  __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+
+  // Completion queue space is freed, submit the leftovers if any
+  if (!deferred_.empty() || !pending_.empty()) Flush();
+}
+
+void IoUringOperation::PrepareRecv(int fd, void* buf, std::size_t len,
+                                   int flags) noexcept {
+  Prepare(IORING_OP_RECV, fd, reinterpret_cast<std::uint64_t>(buf), len, 0,
+          flags);
+}
+
+void IoUringOperation::PrepareSend(int fd, const void* buf, std::size_t len,
+                                   int flags) noexcept {
+  Prepare(IORING_OP_SEND, fd, reinterpret_cast<std::uint64_t>(buf), len, 0,
+          flags);
+}
+
+void IoUringOperation::PrepareSendMsg(int fd, const struct msghdr* msg,
+                                      int flags) noexcept {
+  Prepare(IORING_OP_SENDMSG, fd, reinterpret_cast<std::uint64_t>(msg), 1, 0,
+          flags);
+}
+
+void IoUringOperation::PrepareAccept(int fd, struct sockaddr* addr,
+                                     socklen_t* addr_len, int flags) noexcept {
+  Prepare(IORING_OP_ACCEPT, fd, reinterpret_cast<std::uint64_t>(addr), 0,
+          reinterpret_cast<std::uint64_t>(addr_len), flags);
+}
+
+void IoUringOperation::PreparePoll(int fd, short events) noexcept {
+  Prepare(IORING_OP_POLL_ADD, fd, 0, 0, 0, static_cast<std::uint16_t>(events));
+}
+
+#else  // HAVE_LINUX_IO_URING_H
+
+struct IoUring::Ring final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(Thread&) {
+  LOG_WARNING() << "io_uring is not supported by this build, falling back to "
+                   "the default poller";
+  return nullptr;
+}
+
+IoUring::IoUring(Thread& thread, std::unique_ptr<Ring> ring)
+    : thread_(thread), ring_(std::move(ring)), pending_(0) {}
+
+void IoUring::Flush() noexcept { UINVARIANT(false, "io_uring is disabled"); }
+
+void IoUring::ReapCompletions() noexcept {
+  UINVARIANT(false, "io_uring is disabled");
+}
+
+void IoUringOperation::PrepareRecv(int, void*, std::size_t, int) noexcept {}
+void IoUringOperation::PrepareSend(int, const void*, std::size_t,
+                                   int) noexcept {}
+void IoUringOperation::PrepareSendMsg(int, const struct msghdr*,
+                                      int) noexcept {}
+void IoUringOperation::PrepareAccept(int, struct sockaddr*, socklen_t*,
+                                     int) noexcept {}
+void IoUringOperation::PreparePoll(int, short) noexcept {}
+
+#endif  // HAVE_LINUX_IO_URING_H
+
+IoUring::~IoUring() {
+  UASSERT_MSG(pending_.empty(), "io_uring is destroyed with pending requests");
+}
+
+void IoUring::StopWatchers() noexcept {
+  UASSERT(thread_.IsInEvThread());
+  ev_async_stop(thread_.GetEvLoop(), &flush_watcher_);
+  ev_io_stop(thread_.GetEvLoop(), &completion_watcher_);
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include <ev.h>
+#include <boost/lockfree/queue.hpp>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/impl/wait_list_fwd.hpp>
+#include <userver/engine/single_use_event.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+class Thread;
+
+/// A single io_uring request of a coroutine
+class IoUringOperation final {
+ public:
+  enum class Status {
+    kCompleted,  ///< the kernel completed the request, see Result()
+    kTimeout,    ///< the deadline expired, the request was cancelled
+    kCancelled,  ///< the task was cancelled, the request was cancelled
+  };
+
+  IoUringOperation();
+  ~IoUringOperation();
+  IoUringOperation(const IoUringOperation&) = delete;
+  IoUringOperation& operator=(const IoUringOperation&) = delete;
+
+  void PrepareRecv(int fd, void* buf, std::size_t len, int flags) noexcept;
+  void PrepareSend(int fd, const void* buf, std::size_t len,
+                   int flags) noexcept;
+  void PrepareSendMsg(int fd, const struct msghdr* msg, int flags) noexcept;
+  void PrepareAccept(int fd, struct sockaddr* addr, socklen_t* addr_len,
+                     int flags) noexcept;
+  /// Waits for `poll(2)` events, e.g. POLLOUT for a connecting socket
+  void PreparePoll(int fd, short events) noexcept;
+
+  /// Syscall-like result: non-negative on success, `-errno` on failure
+  int Result() const noexcept { return result_; }
+
+ private:
+  friend class IoUring;
+
+  void Prepare(std::uint8_t opcode, int fd, std::uint64_t addr,
+               std::uint32_t len, std::uint64_t off,
+               std::uint32_t op_flags) noexcept;
+
+  class WaitStrategy;
+
+  // Returns false on timeout or task cancellation
+  bool Wait(Deadline deadline);
+  void Complete(int result) noexcept;
+
+  struct Request {
+    std::uint8_t opcode{0};
+    int fd{-1};
+    std::uint64_t addr{0};
+    std::uint32_t len{0};
+    std::uint64_t off{0};
+    std::uint32_t op_flags{0};
+  };
+
+  Request request_;
+  int result_{0};
+  std::atomic<bool> is_completed_{false};
+  engine::impl::FastPimplWaitListLight waiters_;
+  engine::SingleUseEvent finished_;
+};
+
+/// @brief Per ev::Thread io_uring instance.
+///
+/// Coroutines enqueue requests from any thread, the ev-thread submits all the
+/// enqueued requests with a single io_uring_enter call and wakes up the
+/// waiting coroutines straight from the completion queue.
+class IoUring final {
+ public:
+  /// Returns nullptr if io_uring is not supported by the build or the kernel
+  static std::unique_ptr<IoUring> TryCreate(Thread& thread);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+  ~IoUring();
+
+  /// @brief Submits the operation and waits for its completion.
+  ///
+  /// On timeout or task cancellation the request is cancelled in the kernel,
+  /// and the call still waits until the kernel stops using the buffers.
+  /// The request may complete successfully in spite of the cancellation, such
+  /// requests are reported as kCompleted.
+  IoUringOperation::Status Execute(IoUringOperation& op, Deadline deadline);
+
+  /// @brief Asynchronously cancels the operation in the kernel.
+  ///
+  /// May be called concurrently with the operation completion, the operation
+  /// object is not accessed. The operation must not be destroyed until the
+  /// call returns, otherwise the cancellation may hit a newer operation at
+  /// the same address.
+  void Cancel(const IoUringOperation& op);
+
+  /// Must be called from the ev-thread before the loop is destroyed
+  void StopWatchers() noexcept;
+
+ private:
+  struct Ring;
+
+  explicit IoUring(Thread& thread, std::unique_ptr<Ring> ring);
+
+  void Enqueue(IoUringOperation* op);
+
+  static void FlushCb(struct ev_loop*, ev_async*, int) noexcept;
+  static void CompletionCb(struct ev_loop*, ev_io*, int) noexcept;
+  void Flush() noexcept;
+  void ReapCompletions() noexcept;
+
+  Thread& thread_;
+  std::unique_ptr<Ring> ring_;
+
+  // Holds both the requests and the cancellations (with the lowest bit set)
+  boost::lockfree::queue<std::uintptr_t> pending_;
+  std::atomic<bool> is_flush_scheduled_{false};
+  // Items that did not fit into the submission queue, ev-thread only
+  std::deque<std::uintptr_t> deferred_;
+
+  ev_async flush_watcher_{};
+  ev_io completion_watcher_{};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
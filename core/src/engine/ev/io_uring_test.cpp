@@ -0,0 +1,110 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <string_view>
+
+#include <engine/ev/thread.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kTimeout{100};
+
+class SocketPair final {
+ public:
+  SocketPair() {
+    EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0,
+                              fds_.data()));
+  }
+
+  ~SocketPair() {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  int First() const { return fds_[0]; }
+  int Second() const { return fds_[1]; }
+
+ private:
+  std::array<int, 2> fds_{-1, -1};
+};
+
+}  // namespace
+
+UTEST(IoUring, RecvSend) {
+  engine::ev::Thread thread("test_thread",
+                            engine::ev::Thread::RegisterEventMode::kImmediate,
+                            /*use_io_uring=*/true);
+  auto* ring = thread.GetIoUring();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported";
+
+  SocketPair sockets;
+  auto reader = engine::AsyncNoSpan([&] {
+    std::array<char, 16> buf{};
+    engine::ev::IoUringOperation op;
+    op.PrepareRecv(sockets.First(), buf.data(), buf.size(), 0);
+    const auto deadline =
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    EXPECT_EQ(ring->Execute(op, deadline),
+              engine::ev::IoUringOperation::Status::kCompleted);
+    EXPECT_EQ(op.Result(), 4);
+    EXPECT_EQ(std::string_view(buf.data(), 4), "ping");
+  });
+
+  engine::SleepFor(std::chrono::milliseconds(10));
+  engine::ev::IoUringOperation op;
+  op.PrepareSend(sockets.Second(), "ping", 4, MSG_NOSIGNAL);
+  EXPECT_EQ(ring->Execute(op, {}),
+            engine::ev::IoUringOperation::Status::kCompleted);
+  EXPECT_EQ(op.Result(), 4);
+
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(IoUring, Timeout) {
+  engine::ev::Thread thread("test_thread",
+                            engine::ev::Thread::RegisterEventMode::kImmediate,
+                            /*use_io_uring=*/true);
+  auto* ring = thread.GetIoUring();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported";
+
+  SocketPair sockets;
+  std::array<char, 16> buf{};
+  engine::ev::IoUringOperation op;
+  op.PrepareRecv(sockets.First(), buf.data(), buf.size(), 0);
+  EXPECT_EQ(ring->Execute(op, engine::Deadline::FromDuration(kTimeout)),
+            engine::ev::IoUringOperation::Status::kTimeout);
+  EXPECT_EQ(op.Result(), -ECANCELED);
+}
+
+UTEST(IoUring, Cancel) {
+  engine::ev::Thread thread("test_thread",
+                            engine::ev::Thread::RegisterEventMode::kImmediate,
+                            /*use_io_uring=*/true);
+  auto* ring = thread.GetIoUring();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported";
+
+  SocketPair sockets;
+  auto reader = engine::AsyncNoSpan([&] {
+    std::array<char, 16> buf{};
+    engine::ev::IoUringOperation op;
+    op.PrepareRecv(sockets.First(), buf.data(), buf.size(), 0);
+    return ring->Execute(op, {});
+  });
+
+  engine::SleepFor(std::chrono::milliseconds(10));
+  reader.RequestCancel();
+  EXPECT_EQ(reader.Get(), engine::ev::IoUringOperation::Status::kCancelled);
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,9 @@
 #include "thread.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
+#include <vector>
 
 #include <sys/param.h>
 #include <sys/types.h>
@@ -19,6 +21,8 @@
 #include <utils/statistics/thread_statistics.hpp>
 
 #include "child_process_map.hpp"
+#include "io_uring.hpp"
+#include "timer_wheel.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -62,20 +66,42 @@ void ReleaseEvDefaultLoop() {
 constexpr std::chrono::milliseconds kCpuStatsCollectInterval{1000};
 constexpr std::size_t kCpuStatsThrottle{16};
 
+struct WakeupBatch final {
+  bool is_active{false};
+  std::vector<Thread*> threads;
+};
+
+thread_local WakeupBatch wakeup_batch;
+
 }  // namespace
 
+WakeupBatchScope::WakeupBatchScope() noexcept
+    : is_owner_(!wakeup_batch.is_active) {
+  wakeup_batch.is_active = true;
+}
+
+WakeupBatchScope::~WakeupBatchScope() {
+  if (!is_owner_) return;
+
+  auto& batch = wakeup_batch;
+  batch.is_active = false;
+  for (auto* thread : batch.threads) thread->Wakeup();
+  batch.threads.clear();
+}
+
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode, bool use_io_uring)
+    : Thread(thread_name, false, register_event_mode, use_io_uring) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode, bool use_io_uring)
+    : Thread(thread_name, true, register_event_mode, use_io_uring) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, bool use_io_uring)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
+      use_io_uring_(use_io_uring),
       func_queue_(kInitFuncQueueCapacity),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
@@ -96,7 +122,7 @@ void Thread::RunInEvLoopAsync(OnAsyncPayload* func, AsyncPayloadPtr&& data) {
   RegisterInEvLoop(func, std::move(data));
 
   if (!IsInEvThread()) {
-    ev_async_send(loop_, &watch_update_);
+    Wakeup();
   }
 }
 
@@ -104,13 +130,15 @@ void Thread::RunInEvLoopDeferred(OnAsyncPayload* func, AsyncPayloadPtr&& data,
                                  Deadline deadline) {
   switch (register_event_mode_) {
     case RegisterEventMode::kImmediate: {
-      RunInEvLoopAsync(func, std::move(data));
+      RegisterInEvLoop(func, std::move(data));
+      WakeupBatched();
       return;
     }
     case RegisterEventMode::kDeferred: {
       if (deadline.IsReachable() &&
           deadline.TimeLeftApprox() < kEventImmediateSetupThreshold) {
-        RunInEvLoopAsync(func, std::move(data));
+        RegisterInEvLoop(func, std::move(data));
+        WakeupBatched();
       } else {
         RegisterInEvLoop(func, std::move(data));
       }
@@ -135,6 +163,25 @@ void Thread::RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data) {
   (void)data.release();
 }
 
+void Thread::Wakeup() noexcept {
+  wakeups_.fetch_add(1, std::memory_order_relaxed);
+  ev_async_send(loop_, &watch_update_);
+}
+
+void Thread::WakeupBatched() {
+  if (IsInEvThread()) return;
+
+  auto& batch = wakeup_batch;
+  if (!batch.is_active) {
+    Wakeup();
+    return;
+  }
+  if (std::find(batch.threads.begin(), batch.threads.end(), this) ==
+      batch.threads.end()) {
+    batch.threads.push_back(this);
+  }
+}
+
 bool Thread::IsInEvThread() const {
   return (std::this_thread::get_id() == thread_.get_id());
 }
@@ -145,6 +192,11 @@ std::uint8_t Thread::GetCurrentLoadPercent() const {
 
 const std::string& Thread::GetName() const { return name_; }
 
+ThreadStats Thread::GetStats() const noexcept {
+  return {loop_iterations_.load(std::memory_order_relaxed),
+          wakeups_.load(std::memory_order_relaxed)};
+}
+
 void Thread::Start() {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
@@ -166,6 +218,7 @@ void Thread::Start() {
 
   using LibEvDuration = std::chrono::duration<double>;
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
+    timer_wheel_ = std::make_unique<TimerWheel>();
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     ev_timer_init(
         &timers_driver_, UpdateTimersWatcher, 0.0,
@@ -190,6 +243,8 @@ void Thread::Start() {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (use_io_uring_) io_uring_ = IoUring::TryCreate(*this);
+
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
@@ -205,6 +260,7 @@ void Thread::StopEventLoop() {
     utils::impl::AbortWithStacktrace("Some work was enqueued on a dead Thread");
   }
 
+  io_uring_.reset();
   if (!use_ev_default_loop_) ev_loop_destroy(loop_);
   loop_ = nullptr;
 }
@@ -213,6 +269,9 @@ void Thread::RunEvLoop() {
   while (is_running_) {
     AcquireImpl();
     ev_run(loop_, EVRUN_ONCE);
+    loop_iterations_.store(
+        loop_iterations_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
     UpdateLoopWatcherImpl();
     cpu_stats_storage_.Collect();
     ReleaseImpl();
@@ -226,6 +285,7 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &stats_timer_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (io_uring_) io_uring_->StopWatchers();
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -239,6 +299,9 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
   ev_thread->UpdateLoopWatcherImpl();
+  if (ev_thread->timer_wheel_) {
+    ev_thread->timer_wheel_->Advance(std::chrono::steady_clock::now());
+  }
 }
 
 void Thread::UpdateLoopWatcherImpl() {
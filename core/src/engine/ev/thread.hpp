@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -13,12 +14,17 @@
 #include <userver/engine/deadline.hpp>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/thread_control.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+class IoUring;
+class TimerWheel;
+class WakeupBatchScope;
+
 class Thread final {
  public:
   struct UseDefaultEvLoop {};
@@ -35,8 +41,12 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  // With `use_io_uring` the thread tries to set up an ev::IoUring, see
+  // GetIoUring()
+  Thread(const std::string& thread_name, RegisterEventMode,
+         bool use_io_uring = false);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         bool use_io_uring = false);
   ~Thread();
 
   struct ev_loop* GetEvLoop() const {
@@ -49,21 +59,35 @@ class Thread final {
 
   // Callbacks passed to RunInEvLoopDeferred() are serialized.
   // Same as RunInEvLoopAsync but doesn't force the wakeup of ev-loop, adding
-  // delay up to ~1ms.
+  // delay up to ~1ms. If the wakeup is still required, it is postponed until
+  // the end of the current WakeupBatchScope.
   void RunInEvLoopDeferred(OnAsyncPayload* func, AsyncPayloadPtr&& data,
                            Deadline deadline);
 
   bool IsInEvThread() const;
 
+  // nullptr if io_uring was not requested or is not supported
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
+  // Driven by the periodic events timer, nullptr for kImmediate mode.
+  // Must be used only from the ev thread.
+  TimerWheel* GetTimerWheel() const noexcept { return timer_wheel_.get(); }
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
+  ThreadStats GetStats() const noexcept;
 
  private:
+  friend class WakeupBatchScope;
+
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode, bool use_io_uring);
 
   void RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
+  void Wakeup() noexcept;
+  void WakeupBatched();
+
   void Start();
 
   void StopEventLoop();
@@ -84,6 +108,7 @@ class Thread final {
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
+  bool use_io_uring_;
 
   struct QueueData {
     OnAsyncPayload* func;
@@ -102,13 +127,33 @@ class Thread final {
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
+  std::unique_ptr<IoUring> io_uring_;
+  std::unique_ptr<TimerWheel> timer_wheel_;
 
   const std::string name_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
+  std::atomic<std::uint64_t> loop_iterations_{0};
+  std::atomic<std::uint64_t> wakeups_{0};
 
   bool is_running_;
 };
 
+// Gathers the ev-loop wakeups required by Thread::RunInEvLoopDeferred() calls
+// from the current OS thread and sends them on destruction, once per Thread.
+// Task processor workers hold it for a step of a task, so a task that arms
+// multiple watchers wakes up each ev-loop once. Nested scopes are no-op.
+class WakeupBatchScope final {
+ public:
+  WakeupBatchScope() noexcept;
+  ~WakeupBatchScope();
+
+  WakeupBatchScope(const WakeupBatchScope&) = delete;
+  WakeupBatchScope& operator=(const WakeupBatchScope&) = delete;
+
+ private:
+  const bool is_owner_;
+};
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
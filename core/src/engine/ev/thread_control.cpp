@@ -75,12 +75,24 @@ bool ThreadControl::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControl::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
+TimerWheel* ThreadControl::GetTimerWheel() const noexcept {
+  return thread_.GetTimerWheel();
+}
+
 std::uint8_t ThreadControl::GetCurrentLoadPercent() const {
   return thread_.GetCurrentLoadPercent();
 }
 
 const std::string& ThreadControl::GetName() const { return thread_.GetName(); }
 
+ThreadStats ThreadControl::GetStats() const noexcept {
+  return thread_.GetStats();
+}
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -97,7 +98,16 @@ class CallerOwnedPayloadBlocking final : public AsyncPayloadBase {
 
 }  // namespace impl
 
+class IoUring;
 class Thread;
+class TimerWheel;
+
+struct ThreadStats final {
+  /// Iterations of the ev-loop
+  std::uint64_t loop_iterations{0};
+  /// ev_async_send calls that woke up the ev-loop from other threads
+  std::uint64_t wakeups{0};
+};
 
 class ThreadControl final {
  public:
@@ -147,8 +157,15 @@ class ThreadControl final {
 
   bool IsInEvThread() const noexcept;
 
+  /// nullptr if io_uring is disabled for this thread
+  IoUring* GetIoUring() const noexcept;
+
+  /// nullptr if the events of this thread are not deferred
+  TimerWheel* GetTimerWheel() const noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
+  ThreadStats GetStats() const noexcept;
 
  private:
   Thread& thread_;
@@ -1,5 +1,7 @@
 #include "thread_pool.hpp"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include <userver/utils/assert.hpp>
@@ -35,13 +37,18 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
     return (use_ev_default_loop && index == 0)
                ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                        register_timer_event_mode)
-               : Thread(thread_name, register_timer_event_mode);
+                        register_timer_event_mode, config.io_uring)
+               : Thread(thread_name, register_timer_event_mode,
+                        config.io_uring);
   });
 
   thread_controls_ = utils::GenerateFixedArray(
       threads_.size(),
       [&](std::size_t index) { return ThreadControl(threads_[index]); });
+
+  is_io_uring_enabled_ = std::any_of(
+      threads_.begin(), threads_.end(),
+      [](const Thread& thread) { return thread.GetIoUring() != nullptr; });
 }
 
 ThreadPool::~ThreadPool() = default;
@@ -54,6 +61,11 @@ ThreadControl& ThreadPool::NextThread() {
   return thread_controls_[next_thread_idx_++ % thread_controls_.size()];
 }
 
+ThreadControl& ThreadPool::GetThread(std::size_t index) {
+  UASSERT(index < thread_controls_.size());
+  return thread_controls_[index];
+}
+
 std::vector<ThreadControl*> ThreadPool::NextThreads(std::size_t count) {
   std::vector<ThreadControl*> res;
   if (!count) return res;
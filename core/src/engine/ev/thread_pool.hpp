@@ -27,10 +27,15 @@ class ThreadPool final {
 
   ThreadControl& NextThread();
 
+  ThreadControl& GetThread(std::size_t index);
+
   std::vector<ThreadControl*> NextThreads(std::size_t count);
 
   ThreadControl& GetEvDefaultLoopThread();
 
+  /// Whether at least one of the threads has an io_uring
+  bool IsIoUringEnabled() const noexcept { return is_io_uring_enabled_; }
+
  private:
   ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop);
 
@@ -38,6 +43,7 @@ class ThreadPool final {
   utils::FixedArray<Thread> threads_;
   utils::FixedArray<ThreadControl> thread_controls_;
   std::atomic<std::size_t> next_thread_idx_{0};
+  bool is_io_uring_enabled_{false};
 };
 
 }  // namespace engine::ev
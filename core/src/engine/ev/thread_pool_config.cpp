@@ -10,6 +10,7 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
   config.threads = value["threads"].As<size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.io_uring = value["io_uring"].As<bool>(config.io_uring);
   return config;
 }
 
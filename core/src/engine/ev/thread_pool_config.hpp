@@ -14,6 +14,7 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  bool io_uring = false;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -0,0 +1,51 @@
+#include <engine/ev/thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void WaitForCount(const std::atomic<int>& counter, int expected) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + utest::kMaxTestWaitTime;
+  while (counter.load() != expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(counter.load(), expected);
+}
+
+}  // namespace
+
+TEST(EvThread, WakeupBatch) {
+  engine::ev::Thread thread("test_thread",
+                            engine::ev::Thread::RegisterEventMode::kImmediate);
+  engine::ev::ThreadControl thread_control(thread);
+  std::atomic<int> executed{0};
+
+  {
+    engine::ev::WakeupBatchScope batch_scope;
+    {
+      engine::ev::WakeupBatchScope nested_scope;
+      for (int i = 0; i < 10; ++i) {
+        thread_control.RunInEvLoopDeferred([&executed] { ++executed; });
+      }
+    }
+    EXPECT_EQ(thread.GetStats().wakeups, 0);
+  }
+  EXPECT_EQ(thread.GetStats().wakeups, 1);
+  WaitForCount(executed, 10);
+
+  thread_control.RunInEvLoopDeferred([&executed] { ++executed; });
+  EXPECT_EQ(thread.GetStats().wakeups, 2);
+  WaitForCount(executed, 11);
+  EXPECT_GT(thread.GetStats().loop_iterations, 0);
+}
+
+USERVER_NAMESPACE_END
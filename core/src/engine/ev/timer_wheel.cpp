@@ -0,0 +1,122 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+constexpr std::uint64_t LevelSpan(std::size_t bits) noexcept {
+  return std::uint64_t{1} << bits;
+}
+
+}  // namespace
+
+TimerWheel::TimerWheel(Clock::time_point now) : start_(now) {}
+
+void TimerWheel::Schedule(Entry& entry, Clock::time_point expiration) noexcept {
+  Cancel(entry);
+  entry.expiration_tick_ =
+      std::max(ToTick(expiration, /*round_up=*/true), current_tick_ + 1);
+  Insert(entry);
+  ++size_;
+}
+
+void TimerWheel::Cancel(Entry& entry) noexcept {
+  if (!entry.IsScheduled()) return;
+  entry.unlink();
+  UASSERT(size_ > 0);
+  --size_;
+}
+
+void TimerWheel::Advance(Clock::time_point now) noexcept {
+  const auto now_tick = ToTick(now, /*round_up=*/false);
+
+  while (current_tick_ < now_tick) {
+    if (size_ == 0) {
+      // Nothing to cascade or fire in the skipped ticks
+      current_tick_ = now_tick;
+      return;
+    }
+
+    ++current_tick_;
+
+    // Higher levels first, as they cascade into the slots of the lower ones
+    std::size_t levels_to_cascade = 0;
+    while (levels_to_cascade + 1 < kLevelCount &&
+           current_tick_ % LevelSpan(kSlotBits * (levels_to_cascade + 1)) ==
+               0) {
+      ++levels_to_cascade;
+    }
+    for (auto level = levels_to_cascade; level > 0; --level) {
+      Cascade(level);
+    }
+
+    Expire();
+  }
+}
+
+std::uint64_t TimerWheel::ToTick(Clock::time_point time_point,
+                                 bool round_up) const noexcept {
+  if (time_point <= start_) return 0;
+
+  const auto since_start = time_point - start_;
+  std::uint64_t ticks = since_start / kTick;
+  if (round_up && since_start % kTick != Clock::duration::zero()) ++ticks;
+  return ticks;
+}
+
+void TimerWheel::Insert(Entry& entry) noexcept {
+  UASSERT(entry.expiration_tick_ >= current_tick_);
+  const auto delta = entry.expiration_tick_ - current_tick_;
+
+  std::size_t level = 0;
+  while (level + 1 < kLevelCount &&
+         delta >= LevelSpan(kSlotBits * (level + 1))) {
+    ++level;
+  }
+
+  // Timers beyond the range of the top level are cascaded to it each
+  // rotation until they are in range
+  const auto placement_tick =
+      std::min(entry.expiration_tick_,
+               current_tick_ + LevelSpan(kSlotBits * kLevelCount) - 1);
+  const auto slot = (placement_tick >> (kSlotBits * level)) % kSlotCount;
+  levels_[level][slot].push_back(entry);
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  auto& slot = levels_[level][(current_tick_ >> (kSlotBits * level)) %
+                              kSlotCount];
+  Slot pending;
+  pending.splice(pending.end(), slot);
+  while (!pending.empty()) {
+    auto& entry = pending.front();
+    pending.pop_front();
+    Insert(entry);
+  }
+}
+
+void TimerWheel::Expire() noexcept {
+  Slot expired;
+  expired.splice(expired.end(), levels_[0][current_tick_ % kSlotCount]);
+
+  // The callbacks may cancel or reschedule the entries of `expired`
+  while (!expired.empty()) {
+    auto& entry = expired.front();
+    expired.pop_front();
+    if (entry.expiration_tick_ > current_tick_) {
+      Insert(entry);
+      continue;
+    }
+
+    --size_;
+    entry.callback_(entry);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
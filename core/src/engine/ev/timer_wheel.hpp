@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/intrusive/list.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Hierarchical timing wheel with a 1ms tick for coarse-grained timers
+/// of an ev::Thread.
+///
+/// Scheduling and cancellation are O(1) without any ev-loop heap operations,
+/// expired timers are fired from Advance(). A timer never fires before its
+/// expiration, but may fire up to a tick plus the Advance() period later.
+///
+/// Not thread-safe, all the methods must be called from the same thread.
+class TimerWheel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds kTick{1};
+
+  class Entry;
+  using Callback = void (*)(Entry&) noexcept;
+
+  /// A timer of the wheel, must be cancelled before destruction
+  class Entry final
+      : public boost::intrusive::list_base_hook<
+            boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
+   public:
+    explicit Entry(Callback callback) noexcept : callback_(callback) {}
+    ~Entry() { UASSERT(!IsScheduled()); }
+
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+    bool IsScheduled() const noexcept { return is_linked(); }
+
+    /// User data for the callback
+    void* data{nullptr};
+
+   private:
+    friend class TimerWheel;
+
+    const Callback callback_;
+    std::uint64_t expiration_tick_{0};
+  };
+
+  explicit TimerWheel(Clock::time_point now = Clock::now());
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /// Schedules the entry, an already scheduled entry is rescheduled
+  void Schedule(Entry& entry, Clock::time_point expiration) noexcept;
+
+  /// Cancels the entry, does nothing if it is not scheduled
+  void Cancel(Entry& entry) noexcept;
+
+  /// Fires the callbacks of the entries that have expired by `now`. The
+  /// callbacks may schedule and cancel entries.
+  void Advance(Clock::time_point now) noexcept;
+
+  /// The number of scheduled entries
+  std::size_t GetSize() const noexcept { return size_; }
+
+ private:
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::uint64_t kSlotCount = std::uint64_t{1} << kSlotBits;
+  static constexpr std::size_t kLevelCount = 4;
+
+  using Slot =
+      boost::intrusive::list<Entry, boost::intrusive::constant_time_size<false>>;
+
+  std::uint64_t ToTick(Clock::time_point time_point,
+                       bool round_up) const noexcept;
+  void Insert(Entry& entry) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  void Expire() noexcept;
+
+  const Clock::time_point start_;
+  std::uint64_t current_tick_{0};
+  std::size_t size_{0};
+  std::array<std::array<Slot, kSlotCount>, kLevelCount> levels_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,160 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::TimerWheel;
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+
+const auto kStart = Clock::time_point{} + std::chrono::hours{1};
+
+class Timer final {
+ public:
+  explicit Timer(std::vector<int>* fired = nullptr, int id = 0)
+      : fired_(fired), id_(id) {
+    entry.data = this;
+  }
+
+  ~Timer() {
+    if (entry.IsScheduled()) wheel->Cancel(entry);
+  }
+
+  int GetFiredCount() const { return fired_count_; }
+
+  TimerWheel::Entry entry{&OnTimer};
+  TimerWheel* wheel{nullptr};
+
+ private:
+  static void OnTimer(TimerWheel::Entry& entry) noexcept {
+    auto& self = *static_cast<Timer*>(entry.data);
+    ++self.fired_count_;
+    if (self.fired_) self.fired_->push_back(self.id_);
+  }
+
+  std::vector<int>* fired_;
+  int id_;
+  int fired_count_{0};
+};
+
+void AdvanceBy(TimerWheel& wheel, Clock::time_point& now,
+               Clock::duration duration) {
+  const auto end = now + duration;
+  while (now < end) {
+    now += milliseconds{1};
+    wheel.Advance(now);
+  }
+}
+
+}  // namespace
+
+TEST(TimerWheel, FiresNotEarlier) {
+  TimerWheel wheel(kStart);
+  Timer timer;
+  timer.wheel = &wheel;
+  wheel.Schedule(timer.entry, kStart + milliseconds{10});
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  wheel.Advance(kStart + milliseconds{9});
+  EXPECT_EQ(timer.GetFiredCount(), 0);
+  EXPECT_TRUE(timer.entry.IsScheduled());
+
+  wheel.Advance(kStart + milliseconds{10});
+  EXPECT_EQ(timer.GetFiredCount(), 1);
+  EXPECT_FALSE(timer.entry.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(TimerWheel, Cancel) {
+  TimerWheel wheel(kStart);
+  Timer timer;
+  timer.wheel = &wheel;
+  wheel.Schedule(timer.entry, kStart + milliseconds{5});
+  wheel.Cancel(timer.entry);
+  wheel.Cancel(timer.entry);
+  EXPECT_EQ(wheel.GetSize(), 0);
+
+  wheel.Advance(kStart + milliseconds{100});
+  EXPECT_EQ(timer.GetFiredCount(), 0);
+}
+
+TEST(TimerWheel, Reschedule) {
+  TimerWheel wheel(kStart);
+  Timer timer;
+  timer.wheel = &wheel;
+  wheel.Schedule(timer.entry, kStart + milliseconds{5});
+  wheel.Schedule(timer.entry, kStart + milliseconds{500});
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  wheel.Advance(kStart + milliseconds{499});
+  EXPECT_EQ(timer.GetFiredCount(), 0);
+  wheel.Advance(kStart + milliseconds{500});
+  EXPECT_EQ(timer.GetFiredCount(), 1);
+}
+
+TEST(TimerWheel, PassedExpiration) {
+  TimerWheel wheel(kStart);
+  Timer timer;
+  timer.wheel = &wheel;
+  wheel.Advance(kStart + milliseconds{100});
+
+  wheel.Schedule(timer.entry, kStart);
+  EXPECT_EQ(timer.GetFiredCount(), 0);
+  wheel.Advance(kStart + milliseconds{101});
+  EXPECT_EQ(timer.GetFiredCount(), 1);
+}
+
+TEST(TimerWheel, Order) {
+  TimerWheel wheel(kStart);
+  auto now = kStart;
+  std::vector<int> fired;
+
+  // Levels of the wheel and the timers beyond its range
+  const std::vector<Clock::duration> timeouts{
+      milliseconds{1},        milliseconds{63},  milliseconds{64},
+      milliseconds{1000},     milliseconds{4096}, std::chrono::seconds{300},
+      std::chrono::hours{5},
+  };
+  std::vector<std::unique_ptr<Timer>> timers;
+  for (std::size_t i = timeouts.size(); i > 0; --i) {
+    auto& timer = *timers.emplace_back(
+        std::make_unique<Timer>(&fired, static_cast<int>(i - 1)));
+    timer.wheel = &wheel;
+    wheel.Schedule(timer.entry, kStart + timeouts[i - 1]);
+  }
+
+  AdvanceBy(wheel, now, std::chrono::seconds{1});
+  EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3}));
+
+  wheel.Advance(kStart + std::chrono::seconds{300} - milliseconds{1});
+  EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3, 4}));
+
+  wheel.Advance(kStart + std::chrono::hours{5} - milliseconds{1});
+  EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  wheel.Advance(kStart + std::chrono::hours{5});
+  EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(TimerWheel, SkipsIdleTicks) {
+  TimerWheel wheel(kStart);
+  Timer timer;
+  timer.wheel = &wheel;
+
+  wheel.Advance(kStart + std::chrono::hours{24});
+  wheel.Schedule(timer.entry,
+                 kStart + std::chrono::hours{24} + milliseconds{10});
+  wheel.Advance(kStart + std::chrono::hours{24} + milliseconds{10});
+  EXPECT_EQ(timer.GetFiredCount(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -9,6 +9,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/single_use_future.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -102,6 +103,30 @@ struct FutureCoroSetGet {
   engine::TaskWithResult<void> producer;
 };
 
+struct SingleUseFutureSetGet {
+  SingleUseFutureSetGet() {
+    producer =
+        engine::AsyncNoSpan([&, promise = future.get_promise()]() mutable {
+          producer_ready.Send();
+          const bool status = consumer_ready.WaitForEvent();
+          UASSERT(status);
+          promise.set_value(42);
+        });
+    const bool status = producer_ready.WaitForEvent();
+    UASSERT(status);
+  }
+
+  void Run() {
+    consumer_ready.Send();
+    benchmark::DoNotOptimize(future.get());
+  }
+
+  engine::SingleConsumerEvent producer_ready;
+  engine::SingleConsumerEvent consumer_ready;
+  engine::SingleUseFuture<int> future;
+  engine::TaskWithResult<void> producer;
+};
+
 }  // namespace
 
 void future_std_single_threaded(benchmark::State& state) {
@@ -126,6 +151,18 @@ void future_coro_single_threaded(benchmark::State& state) {
 }
 BENCHMARK(future_coro_single_threaded);
 
+void future_single_use_single_threaded(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    for (auto _ : state) {
+      engine::SingleUseFuture<int> future;
+      auto promise = future.get_promise();
+      promise.set_value(42);
+      benchmark::DoNotOptimize(future.get());
+    }
+  });
+}
+BENCHMARK(future_single_use_single_threaded);
+
 void future_std_set_and_get(benchmark::State& state) {
   engine::RunStandalone(2, [&] { RunPrepared<FutureStdSetGet>(state); });
 }
@@ -136,4 +173,9 @@ void future_coro_set_and_get(benchmark::State& state) {
 }
 BENCHMARK(future_coro_set_and_get);
 
+void future_single_use_set_and_get(benchmark::State& state) {
+  engine::RunStandalone(2, [&] { RunPrepared<SingleUseFutureSetGet>(state); });
+}
+BENCHMARK(future_single_use_set_and_get);
+
 USERVER_NAMESPACE_END
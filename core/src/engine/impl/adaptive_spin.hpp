@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+inline void CpuPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// Spin estimate of a synchronization primitive, i.e. an exponential moving
+/// average of how many CpuPause iterations it took the primitive to become
+/// available, multiplied by 8
+using SpinEstimate = std::atomic<std::uint32_t>;
+
+inline constexpr std::uint32_t kMinSpins = 4;
+inline constexpr std::uint32_t kMaxSpins = 256;
+
+/// @brief Calls `try_lock` in a bounded busy loop before the caller goes to
+/// sleep on a wait list, which requires a context switch.
+///
+/// The spin limit follows `estimate`: it grows while the primitive is
+/// released shortly after a failed fast path, and decays to kMinSpins while
+/// spinning does not help, e.g. for long critical sections. There is no
+/// spinning with a single worker thread, as the owner can't run concurrently.
+///
+/// @returns whether `try_lock` has succeeded
+template <typename TryLock>
+bool SpinBeforeSleep(SpinEstimate& estimate, TaskContext& current,
+                     TryLock&& try_lock) {
+  if (current.GetTaskProcessor().GetWorkerCount() < 2) return false;
+
+  const auto old_estimate = estimate.load(std::memory_order_relaxed);
+  const auto limit = std::clamp(old_estimate / 4, kMinSpins, kMaxSpins);
+
+  for (std::uint32_t spins = 1; spins <= limit; ++spins) {
+    CpuPause();
+    if (try_lock()) {
+      estimate.store(old_estimate - old_estimate / 8 + spins,
+                     std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  estimate.store(old_estimate - old_estimate / 4, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 #include <atomic>
+#include <cstddef>
+#include <memory>
 #include <optional>
 
 #include <userver/utils/assert.hpp>
@@ -13,10 +15,27 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
 
+namespace {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+// Spreads the registrations of the tasks started from different threads, so
+// that they do not contend on a single free list and counter
+constexpr std::size_t kShardCount = 8;
+
+std::size_t GetCurrentThreadShard() noexcept {
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local const std::size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+  return shard;
+}
+
+}  // namespace
+
 struct DetachedTasksSyncBlock::Token final {
-  explicit Token(DetachedTasksSyncBlock& owner) : owner(owner) {}
+  explicit Token(Shard& shard) : shard(shard) {}
 
-  DetachedTasksSyncBlock& owner;
+  Shard& shard;
 
   concurrent::impl::IntrusiveWalkablePoolHook<Token> pool_hook{};
 
@@ -27,32 +46,41 @@ struct DetachedTasksSyncBlock::Token final {
   utils::impl::WaitTokenStorage::Token wait_token{};
 };
 
-struct DetachedTasksSyncBlock::Impl final {
+struct alignas(kCacheLineSize) DetachedTasksSyncBlock::Shard final {
   std::optional<utils::impl::WaitTokenStorage> wait_tokens{};
   concurrent::impl::IntrusiveWalkablePool<
       Token, concurrent::impl::MemberHook<&Token::pool_hook>>
       cancel_tokens{};
+};
+
+struct DetachedTasksSyncBlock::Impl final {
+  std::unique_ptr<Shard[]> shards{std::make_unique<Shard[]>(kShardCount)};
+  bool is_waiting{false};
   std::atomic<TaskCancellationReason> cancel_new_tasks{
       TaskCancellationReason::kNone};
 };
 
 DetachedTasksSyncBlock::DetachedTasksSyncBlock(StopMode stop_mode) {
   if (stop_mode == StopMode::kCancelAndWait) {
-    impl_->wait_tokens.emplace();
+    impl_->is_waiting = true;
+    for (std::size_t i = 0; i < kShardCount; ++i) {
+      impl_->shards[i].wait_tokens.emplace();
+    }
   }
 }
 
 DetachedTasksSyncBlock::~DetachedTasksSyncBlock() = default;
 
 void DetachedTasksSyncBlock::Add(TaskContext& context) {
-  auto& token = impl_->cancel_tokens.Acquire([this] { return Token(*this); });
+  auto& shard = impl_->shards[GetCurrentThreadShard()];
+  auto& token = shard.cancel_tokens.Acquire([&shard] { return Token(shard); });
   UASSERT(token.task == nullptr);
 
   boost::intrusive_ptr<TaskContext> context_copy(&context);
 
   token.task.store(context_copy.detach());
-  if (impl_->wait_tokens) {
-    token.wait_token = impl_->wait_tokens->GetToken();
+  if (shard.wait_tokens) {
+    token.wait_token = shard.wait_tokens->GetToken();
   }
 
   context.SetDetached(token);
@@ -75,34 +103,42 @@ void DetachedTasksSyncBlock::Dispose(Token& token) noexcept {
                                                     /*add_ref=*/false);
   }
   [[maybe_unused]] const auto wait_token = std::move(token.wait_token);
-  token.owner.impl_->cancel_tokens.Release(token);
+  token.shard.cancel_tokens.Release(token);
 }
 
 void DetachedTasksSyncBlock::RequestCancellation(
     TaskCancellationReason reason) noexcept {
   impl_->cancel_new_tasks.store(reason);
 
-  impl_->cancel_tokens.Walk([&](Token& token) {
-    auto* const context_ptr = token.task.exchange(nullptr);
+  for (std::size_t i = 0; i < kShardCount; ++i) {
+    impl_->shards[i].cancel_tokens.Walk([&](Token& token) {
+      auto* const context_ptr = token.task.exchange(nullptr);
 
-    if (context_ptr != nullptr) {
-      boost::intrusive_ptr<TaskContext> context(context_ptr,
-                                                /*add_ref=*/false);
-      context->RequestCancel(reason);
-    }
-  });
+      if (context_ptr != nullptr) {
+        boost::intrusive_ptr<TaskContext> context(context_ptr,
+                                                  /*add_ref=*/false);
+        context->RequestCancel(reason);
+      }
+    });
+  }
 
-  if (impl_->wait_tokens) {
-    impl_->wait_tokens->WaitForAllTokens();
+  if (impl_->is_waiting) {
+    for (std::size_t i = 0; i < kShardCount; ++i) {
+      impl_->shards[i].wait_tokens->WaitForAllTokens();
+    }
   }
 }
 
 std::int64_t DetachedTasksSyncBlock::ActiveTasksApprox() const noexcept {
-  UASSERT_MSG(impl_->wait_tokens,
+  UASSERT_MSG(impl_->is_waiting,
               "Task count is only available for StopMode::kCancelAndWait");
-  if (!impl_->wait_tokens) return 0;
+  if (!impl_->is_waiting) return 0;
 
-  return impl_->wait_tokens->AliveTokensApprox();
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < kShardCount; ++i) {
+    result += impl_->shards[i].wait_tokens->AliveTokensApprox();
+  }
+  return static_cast<std::int64_t>(result);
 }
 
 }  // namespace engine::impl
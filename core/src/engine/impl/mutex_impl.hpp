@@ -6,6 +6,7 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
@@ -37,10 +38,12 @@ class MutexImpl {
   class MutexWaitStrategy;
 
   bool LockFastPath(TaskContext&);
+  bool LockSpinPath(TaskContext&);
   bool LockSlowPath(TaskContext&, Deadline);
 
   std::atomic<TaskContext*> owner_;
   Waiters lock_waiters_;
+  SpinEstimate spin_estimate_{0};
 };
 
 template <>
@@ -105,6 +108,15 @@ bool MutexImpl<Waiters>::LockFastPath(TaskContext& current) {
                                         std::memory_order_acquire);
 }
 
+template <class Waiters>
+bool MutexImpl<Waiters>::LockSpinPath(TaskContext& current) {
+  return SpinBeforeSleep(spin_estimate_, current, [&] {
+    // avoid bouncing the cache line with CAS while the mutex is locked
+    return owner_.load(std::memory_order_relaxed) == nullptr &&
+           LockFastPath(current);
+  });
+}
+
 template <class Waiters>
 bool MutexImpl<Waiters>::LockSlowPath(TaskContext& current, Deadline deadline) {
   TaskContext* expected = nullptr;
@@ -156,7 +168,8 @@ bool MutexImpl<Waiters>::try_lock() {
 template <class Waiters>
 bool MutexImpl<Waiters>::try_lock_until(Deadline deadline) {
   auto& current = current_task::GetCurrentTaskContext();
-  return LockFastPath(current) || LockSlowPath(current, deadline);
+  return LockFastPath(current) || LockSpinPath(current) ||
+         LockSlowPath(current, deadline);
 }
 
 }  // namespace engine::impl
@@ -25,6 +25,7 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   ev_config.thread_name = pools_config.ev_thread_name;
   ev_config.ev_default_loop_disabled = pools_config.ev_default_loop_disabled;
   ev_config.defer_events = pools_config.defer_events;
+  ev_config.io_uring = pools_config.io_uring;
 
   return std::make_shared<TaskProcessorPools>(std::move(coro_config),
                                               std::move(ev_config));
@@ -1,5 +1,7 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/list_hook.hpp>
@@ -37,7 +39,6 @@ struct DataPtr final {
   // ListHook lies that it's copyable. Disable copying to be safe.
   DataPtr(const DataPtr&) = delete;
 
-  DataBase* ptr{nullptr};
   ListHook list_hook;
 };
 
@@ -68,20 +69,26 @@ void ReportVariableNotSet(const std::type_info& type) {
       compiler::GetTypeName(type)));
 }
 
+Key GetVariableCount() noexcept { return variable_count; }
+
 struct Storage::Impl final {
+  // list nodes of the variables, indexed the same way as Storage::slots_
   std::unique_ptr<DataPtr[]> data;
   NormalDataList normal_data_storage;
   InheritedDataList inherited_data_storage;
 
-  void DoSetGeneric(Key key, DataBase& node);
+  Key GetKey(const DataPtr& node) const noexcept {
+    return static_cast<Key>(&node - data.get());
+  }
 };
 
 Storage::Storage() { utils::impl::AssertStaticRegistrationFinished(); }
 
 Storage::~Storage() {
-  const auto disposer = [](DataPtr* node_ptr) noexcept {
-    UASSERT(node_ptr->ptr);
-    node_ptr->ptr->DeleteSelf();
+  const auto disposer = [this](DataPtr* node_ptr) noexcept {
+    auto* const data = slots_[impl_->GetKey(*node_ptr)];
+    UASSERT(data);
+    data->DeleteSelf();
   };
 
   // By default, boost::intrusive containers don't own their elements (nodes),
@@ -100,21 +107,19 @@ void Storage::InheritFrom(Storage& other) {
   UASSERT(impl_->normal_data_storage.empty());
   UASSERT(impl_->inherited_data_storage.empty());
 
-  if (!other.impl_->inherited_data_storage.empty() && !impl_->data) {
-    impl_->data = std::make_unique<DataPtr[]>(variable_count);
-  }
+  if (!other.impl_->inherited_data_storage.empty()) AllocateSlots();
 
   for (DataPtr& their_ptr :
        other.impl_->inherited_data_storage | boost::adaptors::reversed) {
-    UASSERT(their_ptr.ptr);
+    const auto key = other.impl_->GetKey(their_ptr);
+    UASSERT(other.slots_[key]);
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-    auto& node = static_cast<InheritedDataBase&>(*their_ptr.ptr);
-    UASSERT(node.GetKey() < variable_count);
+    auto& node = static_cast<InheritedDataBase&>(*other.slots_[key]);
+    UASSERT(node.GetKey() == key);
 
-    auto& our_ptr = impl_->data[node.GetKey()];
-    UASSERT(!our_ptr.ptr);
-    our_ptr.ptr = &node;
-    impl_->inherited_data_storage.push_front(our_ptr);
+    UASSERT(!slots_[key]);
+    slots_[key] = &node;
+    impl_->inherited_data_storage.push_front(impl_->data[key]);
     node.AddRef();
   }
 }
@@ -122,24 +127,26 @@ void Storage::InheritFrom(Storage& other) {
 void Storage::InitializeFrom(Storage&& other) noexcept {
   UASSERT(impl_->normal_data_storage.empty());
   UASSERT(impl_->inherited_data_storage.empty());
+  slots_ = std::move(other.slots_);
   impl_ = std::move(other.impl_);
 }
 
-DataBase* Storage::GetGeneric(Key key) noexcept {
-  UASSERT(key < variable_count);
-  if (!impl_->data) return nullptr;
-  return impl_->data[key].ptr;
+void Storage::AllocateSlots() {
+  if (slots_) return;
+  auto data = std::make_unique<DataPtr[]>(variable_count);
+  slots_ = std::make_unique<DataBase*[]>(variable_count);
+  impl_->data = std::move(data);
 }
 
-void Storage::Impl::DoSetGeneric(Key key, DataBase& node) {
+void Storage::DoSetGeneric(Key key, DataBase& node) {
   UASSERT(key < variable_count);
-  if (!data) data = std::make_unique<DataPtr[]>(variable_count);
-  data[key].ptr = &node;
+  AllocateSlots();
+  slots_[key] = &node;
 }
 
 void Storage::SetGeneric(Key key, NormalDataBase& node,
                          bool has_existing_variable) {
-  impl_->DoSetGeneric(key, node);
+  DoSetGeneric(key, node);
   if (!has_existing_variable) {
     impl_->normal_data_storage.push_front(impl_->data[key]);
   }
@@ -147,7 +154,7 @@ void Storage::SetGeneric(Key key, NormalDataBase& node,
 
 void Storage::SetGeneric(Key key, InheritedDataBase& node,
                          bool has_existing_variable) {
-  impl_->DoSetGeneric(key, node);
+  DoSetGeneric(key, node);
   if (!has_existing_variable) {
     impl_->inherited_data_storage.push_front(impl_->data[key]);
   }
@@ -155,15 +162,13 @@ void Storage::SetGeneric(Key key, InheritedDataBase& node,
 
 void Storage::EraseInherited(Key key) noexcept {
   UASSERT(key < variable_count);
-  if (!impl_->data) return;
+  if (!slots_) return;
 
-  auto& data_ptr = impl_->data[key];
-  auto* const data = data_ptr.ptr;
+  auto* const data = std::exchange(slots_[key], nullptr);
   if (!data) return;
 
-  data_ptr.ptr = nullptr;
   impl_->inherited_data_storage.erase(
-      InheritedDataList::s_iterator_to(data_ptr));
+      InheritedDataList::s_iterator_to(impl_->data[key]));
   data->DeleteSelf();
 }
 
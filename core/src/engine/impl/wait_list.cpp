@@ -2,6 +2,7 @@
 
 #include <boost/intrusive/list.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
 #include <engine/task/task_context.hpp>
 
 #include <userver/utils/assert.hpp>
@@ -14,6 +15,9 @@ namespace {
 
 constexpr bool kAdopt = false;
 
+// A few hundred nanoseconds, about the cost of a futex syscall
+constexpr int kSpinsBeforeBlocking = 64;
+
 template <class Container, class Value>
 bool IsInIntrusiveContainer(const Container& container, const Value& val) {
   const auto val_it = Container::s_iterator_to(val);
@@ -33,6 +37,14 @@ using MemberHookConfig =
 
 }  // namespace
 
+void SpinningMutex::LockSlow() {
+  for (int i = 0; i < kSpinsBeforeBlocking; ++i) {
+    CpuPause();
+    if (mutex_.try_lock()) return;
+  }
+  mutex_.lock();
+}
+
 struct WaitList::List
     : public boost::intrusive::make_list<
           impl::TaskContext, boost::intrusive::constant_time_size<false>,
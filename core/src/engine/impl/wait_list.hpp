@@ -13,6 +13,25 @@ namespace engine::impl {
 
 class TaskContext;
 
+/// @brief std::mutex that spins for a while before blocking the OS thread.
+///
+/// The critical sections of a WaitList are a few list operations long, so a
+/// contender usually gets the mutex sooner than a futex sleep and wakeup
+/// complete, and the worker thread keeps running tasks.
+class SpinningMutex final {
+ public:
+  void lock() {
+    if (!mutex_.try_lock()) LockSlow();
+  }
+  bool try_lock() noexcept { return mutex_.try_lock(); }
+  void unlock() noexcept { mutex_.unlock(); }
+
+ private:
+  void LockSlow();
+
+  std::mutex mutex_;
+};
+
 /// Wait list for multiple entries with explicit control over critical section.
 class WaitList final {
  public:
@@ -26,7 +45,7 @@ class WaitList final {
     void unlock() { impl_.unlock(); }
 
    private:
-    std::unique_lock<std::mutex> impl_;
+    std::unique_lock<SpinningMutex> impl_;
   };
 
   // This guard is used to optimize the hot path of unlocking:
@@ -74,7 +93,7 @@ class WaitList final {
 
  private:
   std::atomic<std::size_t> sleepies_{0};
-  std::mutex mutex_;
+  SpinningMutex mutex_;
 
   struct List;
   static constexpr std::size_t kListSize = sizeof(void*) * 2;
@@ -143,7 +143,7 @@ void wait_list_add_remove_contention(benchmark::State& state) {
 }
 BENCHMARK(wait_list_add_remove_contention)
     ->RangeMultiplier(2)
-    ->Range(1, 2)
+    ->Range(1, 32)
     ->UseRealTime();
 
 void wait_list_add_remove_contention_unbalanced(benchmark::State& state) {
@@ -1,9 +1,13 @@
 #include <userver/engine/io/buffered.hpp>
 
+#include <cstring>
+#include <utility>
+
 #include <boost/algorithm/string/trim.hpp>
 
 #include <engine/io/impl/buffer.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -132,6 +136,118 @@ size_t BufferedReader::FillBuffer(Deadline deadline) {
   }
 }
 
+RingBufferedReader::RingBufferedReader(ReadableBase& source,
+                                       std::size_t capacity)
+    : source_(&source),
+      capacity_(capacity),
+      data_(std::make_unique<char[]>(capacity)) {
+  UINVARIANT(capacity_ > 0, "RingBufferedReader requires a non-empty buffer");
+}
+
+RingBufferedReader::RingBufferedReader(RingBufferedReader&& other) noexcept
+    : source_(other.source_),
+      capacity_(other.capacity_),
+      data_(std::move(other.data_)),
+      begin_(std::exchange(other.begin_, 0)),
+      end_(std::exchange(other.end_, 0)) {}
+
+RingBufferedReader& RingBufferedReader::operator=(
+    RingBufferedReader&& other) noexcept {
+  source_ = other.source_;
+  capacity_ = other.capacity_;
+  data_ = std::move(other.data_);
+  begin_ = std::exchange(other.begin_, 0);
+  end_ = std::exchange(other.end_, 0);
+  return *this;
+}
+
+RingBufferedReader::~RingBufferedReader() = default;
+
+void RingBufferedReader::Consume(std::size_t num_bytes) noexcept {
+  UASSERT_MSG(num_bytes <= end_ - begin_, "Consuming more than was buffered");
+  begin_ += num_bytes;
+  if (begin_ == end_) begin_ = end_ = 0;
+}
+
+std::string_view RingBufferedReader::Fill(std::size_t num_bytes,
+                                          Deadline deadline) {
+  if (num_bytes > capacity_) {
+    throw IoException() << "Requested " << num_bytes
+                        << " bytes exceed the buffer capacity of " << capacity_;
+  }
+  if (begin_ + num_bytes > capacity_) {
+    std::memmove(data_.get(), data_.get() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  while (end_ - begin_ < num_bytes) {
+    if (!FillOnce(deadline)) break;
+  }
+  return Peek();
+}
+
+std::optional<std::string_view> RingBufferedReader::ReadFrame(
+    FramePrefix prefix, Deadline deadline) {
+  const auto prefix_size = static_cast<std::size_t>(prefix);
+  auto data = Fill(prefix_size, deadline);
+  if (data.empty()) return std::nullopt;
+  if (data.size() < prefix_size) {
+    throw IoException() << "EOF inside of a frame prefix";
+  }
+
+  std::size_t payload_size = 0;
+  for (std::size_t i = 0; i < prefix_size; ++i) {
+    payload_size = (payload_size << 8) | static_cast<unsigned char>(data[i]);
+  }
+  if (prefix_size + payload_size > capacity_) {
+    throw IoException() << "Frame of " << payload_size
+                        << " bytes exceeds the buffer capacity of "
+                        << capacity_;
+  }
+
+  data = Fill(prefix_size + payload_size, deadline);
+  if (data.size() < prefix_size + payload_size) {
+    throw IoException() << "EOF inside of a frame";
+  }
+  Consume(prefix_size + payload_size);
+  return data.substr(prefix_size, payload_size);
+}
+
+std::optional<std::string_view> RingBufferedReader::ReadUntil(
+    char terminator, Deadline deadline) {
+  std::size_t search_pos = 0;
+  while (true) {
+    const auto data = Peek();
+    const auto pos = data.find(terminator, search_pos);
+    if (pos != std::string_view::npos) {
+      Consume(pos + 1);
+      return data.substr(0, pos + 1);
+    }
+    search_pos = data.size();
+
+    if (data.size() == capacity_) {
+      throw IoException() << "Terminator not found within the buffer capacity"
+                          << " of " << capacity_;
+    }
+    if (Fill(data.size() + 1, deadline).size() == data.size()) {
+      return std::nullopt;
+    }
+  }
+}
+
+std::size_t RingBufferedReader::FillOnce(Deadline deadline) {
+  UASSERT(end_ < capacity_);
+  try {
+    const auto read_bytes =
+        source_->ReadSome(data_.get() + end_, capacity_ - end_, deadline);
+    end_ += read_bytes;
+    return read_bytes;
+  } catch (const IoTimeout& ex) {
+    end_ += ex.BytesTransferred();
+    throw IoTimeout(end_ - begin_);
+  }
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
@@ -12,6 +12,7 @@
 USERVER_NAMESPACE_BEGIN
 
 using BufferedReader = engine::io::BufferedReader;
+using RingBufferedReader = engine::io::RingBufferedReader;
 using ReadableBase = engine::io::ReadableBase;
 
 class ReadableMock : public ReadableBase {
@@ -104,4 +105,77 @@ TEST(BufferedReader, GetPeek) {
   EXPECT_EQ(EOF, reader.Peek());
 }
 
+TEST(RingBufferedReader, FillConsume) {
+  ReadableMock mock;
+  RingBufferedReader reader(mock, 8);
+
+  mock.Feed("abcdefgh");
+  EXPECT_EQ("abc", reader.Fill(3).substr(0, 3));
+  reader.Consume(3);
+  EXPECT_EQ("defgh", reader.Fill(5));
+
+  // the unconsumed tail is moved to the beginning of the buffer
+  reader.Consume(4);
+  mock.Feed("ijklmnop");
+  EXPECT_EQ("hijklmno", reader.Fill(8));
+  reader.Consume(8);
+  EXPECT_EQ("p", reader.Fill(2));
+  UEXPECT_THROW(reader.Fill(9), engine::io::IoException);
+}
+
+TEST(RingBufferedReader, Frames) {
+  /// [RingBufferedReader frames]
+  ReadableMock mock;
+  RingBufferedReader reader(mock, 64);
+
+  mock.Feed(std::string("\x00\x05"
+                        "hello"
+                        "\x00\x00"
+                        "\x03"
+                        "abc",
+                        13));
+  auto frame = reader.ReadFrame(engine::io::FramePrefix::kUint16);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ("hello", *frame);
+
+  frame = reader.ReadFrame(engine::io::FramePrefix::kUint16);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ("", *frame);
+
+  // EOF between the frames
+  frame = reader.ReadFrame(engine::io::FramePrefix::kUint8);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ("abc", *frame);
+  EXPECT_FALSE(reader.ReadFrame(engine::io::FramePrefix::kUint8));
+  /// [RingBufferedReader frames]
+}
+
+TEST(RingBufferedReader, FrameErrors) {
+  ReadableMock mock;
+  RingBufferedReader reader(mock, 8);
+
+  mock.Feed(std::string("\x08", 1));
+  UEXPECT_THROW(reader.ReadFrame(engine::io::FramePrefix::kUint8),
+                engine::io::IoException);
+
+  RingBufferedReader other(mock, 8);
+  mock.Feed(std::string("\x05\x00\x00", 3));
+  UEXPECT_THROW(other.ReadFrame(engine::io::FramePrefix::kUint8),
+                engine::io::IoException);
+}
+
+TEST(RingBufferedReader, ReadUntil) {
+  ReadableMock mock;
+  RingBufferedReader reader(mock, 8);
+
+  mock.Feed("a;bc;d");
+  EXPECT_EQ("a;", reader.ReadUntil(';'));
+  EXPECT_EQ("bc;", reader.ReadUntil(';'));
+  EXPECT_FALSE(reader.ReadUntil(';'));
+  EXPECT_EQ("d", reader.Peek());
+
+  mock.Feed("efghijkl");
+  UEXPECT_THROW(reader.ReadUntil(';'), engine::io::IoException);
+}
+
 USERVER_NAMESPACE_END
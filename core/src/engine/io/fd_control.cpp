@@ -8,10 +8,14 @@
 #include <stdexcept>
 
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
+#include <engine/ev/thread_pool.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +23,15 @@ USERVER_NAMESPACE_BEGIN
 namespace engine::io::impl {
 namespace {
 
+// Does not take a round-robin step over the ev-threads unless io_uring is
+// enabled for the task processor
+ev::IoUring* GetCurrentIoUring() {
+  if (!current_task::GetTaskProcessor().EventThreadPool().IsIoUringEnabled()) {
+    return nullptr;
+  }
+  return current_task::GetEventThread().GetIoUring();
+}
+
 int SetNonblock(int fd) {
   int oldflags = utils::CheckSyscallCustomException<IoSystemError>(
       ::fcntl(fd, F_GETFL), "getting file status flags, fd={}", fd);
@@ -65,7 +78,8 @@ Direction::SingleUserGuard::~SingleUserGuard() {
 }
 #endif  // #ifndef NDEBUG
 
-Direction::Direction(Kind kind) : kind_(kind) {}
+Direction::Direction(Kind kind)
+    : kind_(kind), io_uring_(GetCurrentIoUring()) {}
 
 Direction::~Direction() = default;
 
@@ -75,6 +89,16 @@ void Direction::Reset(int fd) { poller_.Reset(fd, kind_); }
 
 void Direction::Invalidate() { poller_.Invalidate(); }
 
+void Direction::WakeupWaiters() {
+  poller_.WakeupWaiters();
+  if (!io_uring_) return;
+
+  // The lock keeps the operation alive until its cancellation is enqueued,
+  // otherwise the cancellation could hit a newer request at the same address
+  std::lock_guard lock{ring_operation_mutex_};
+  if (ring_operation_) io_uring_->Cancel(*ring_operation_);
+}
+
 FdControl::FdControl()
     : read_(Direction::Kind::kRead), write_(Direction::Kind::kWrite) {}
 
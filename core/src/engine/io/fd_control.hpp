@@ -1,8 +1,12 @@
 #pragma once
 
+#include <sys/socket.h>
 #include <sys/uio.h>
-#include <atomic>
+
 #include <cerrno>
+#include <mutex>
+#include <type_traits>
+#include <utility>
 
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/fd_control_holder.hpp>
@@ -12,6 +16,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -78,13 +83,44 @@ class Direction final {
   template <typename IoFunc, typename... Context>
   size_t PerformIo(SingleUserGuard& guard, IoFunc&& io_func, void* buf,
                    size_t len, TransferMode mode, Deadline deadline,
-                   const Context&... context);
+                   const Context&... context) {
+    return PerformIoWithRing(guard, std::forward<IoFunc>(io_func), nullptr,
+                             buf, len, mode, deadline, context...);
+  }
 
   template <typename IoFunc, typename... Context>
   size_t PerformIoV(SingleUserGuard& guard, IoFunc&& io_func,
                     struct iovec* list, std::size_t list_size,
                     TransferMode mode, Deadline deadline,
-                    const Context&... context);
+                    const Context&... context) {
+    return PerformIoVWithRing(guard, std::forward<IoFunc>(io_func), nullptr,
+                              list, list_size, mode, deadline, context...);
+  }
+
+  // Same as PerformIo, but instead of waiting for readiness after EAGAIN
+  // the transfer is submitted to the io_uring of the ev-thread, if enabled.
+  // (RingPrepare*)(ev::IoUringOperation&, int, void*, size_t)
+  template <typename IoFunc, typename RingPrepare, typename... Context>
+  size_t PerformIoWithRing(SingleUserGuard& guard, IoFunc&& io_func,
+                           RingPrepare&& ring_prepare, void* buf, size_t len,
+                           TransferMode mode, Deadline deadline,
+                           const Context&... context);
+
+  // (RingPrepare*)(ev::IoUringOperation&, int, const msghdr*)
+  template <typename IoFunc, typename RingPrepare, typename... Context>
+  size_t PerformIoVWithRing(SingleUserGuard& guard, IoFunc&& io_func,
+                            RingPrepare&& ring_prepare, struct iovec* list,
+                            std::size_t list_size, TransferMode mode,
+                            Deadline deadline, const Context&... context);
+
+  ev::IoUring* GetIoUring() const noexcept { return io_uring_; }
+
+  // Executes a request prepared by `prepare(op)` in the io_uring. Returns the
+  // syscall-like result (-1 and errno on failure), throws on timeout and
+  // cancellation. Must be called only if GetIoUring() is not null.
+  template <typename Prepare, typename... Context>
+  ssize_t ExecuteInRing(Prepare&& prepare, size_t processed_bytes,
+                        Deadline deadline, const Context&... context);
 
  private:
   friend class FdControl;
@@ -92,7 +128,7 @@ class Direction final {
 
   void Reset(int fd);
   void StopWatcher();
-  void WakeupWaiters() { poller_.WakeupWaiters(); }
+  void WakeupWaiters();
 
   // does not notify
   void Invalidate();
@@ -104,8 +140,16 @@ class Direction final {
 
   FdPoller poller_;
   Kind kind_;
+  ev::IoUring* io_uring_;
+  // The in-flight io_uring request, cancelled on close
+  ev::IoUringOperation* ring_operation_{nullptr};
+  std::mutex ring_operation_mutex_;
 };
 
+inline bool IsWouldBlock(int error_code) noexcept {
+  return error_code == EWOULDBLOCK || error_code == EAGAIN;
+}
+
 class FdControl final {
  public:
   // fd will be silently forced to nonblocking mode
@@ -144,7 +188,7 @@ ErrorMode Direction::TryHandleError(int error_code, size_t processed_bytes,
                                     Context&... context) {
   if (error_code == EINTR) {
     return ErrorMode::kProcessed;
-  } else if (error_code == EWOULDBLOCK || error_code == EAGAIN) {
+  } else if (IsWouldBlock(error_code)) {
     if (processed_bytes != 0 && mode != TransferMode::kWhole) {
       return ErrorMode::kFatal;
     }
@@ -182,17 +226,68 @@ ErrorMode Direction::TryHandleError(int error_code, size_t processed_bytes,
   return ErrorMode::kProcessed;
 }
 
-template <typename IoFunc, typename... Context>
-size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
-                             struct iovec* list, std::size_t list_size,
-                             TransferMode mode, Deadline deadline,
-                             const Context&... context) {
+template <typename Prepare, typename... Context>
+ssize_t Direction::ExecuteInRing(Prepare&& prepare, size_t processed_bytes,
+                                 Deadline deadline, const Context&... context) {
+  UASSERT(io_uring_);
+
+  ev::IoUringOperation op;
+  prepare(op);
+  {
+    std::lock_guard lock{ring_operation_mutex_};
+    ring_operation_ = &op;
+  }
+  const auto status = io_uring_->Execute(op, deadline);
+  {
+    std::lock_guard lock{ring_operation_mutex_};
+    ring_operation_ = nullptr;
+  }
+
+  switch (status) {
+    case ev::IoUringOperation::Status::kCompleted:
+      break;
+    case ev::IoUringOperation::Status::kTimeout:
+      throw(IoTimeout(/*bytes_transferred =*/processed_bytes) << ... << context);
+    case ev::IoUringOperation::Status::kCancelled:
+      throw(IoCancelled(/*bytes_transferred =*/processed_bytes)
+            << ... << context);
+  }
+
+  if (!IsValid()) {
+    throw((IoException() << "Fd closed during ") << ... << context);
+  }
+
+  if (op.Result() < 0) {
+    errno = -op.Result();
+    return -1;
+  }
+  return op.Result();
+}
+
+template <typename IoFunc, typename RingPrepare, typename... Context>
+size_t Direction::PerformIoVWithRing(SingleUserGuard&, IoFunc&& io_func,
+                                     RingPrepare&& ring_prepare,
+                                     struct iovec* list, std::size_t list_size,
+                                     TransferMode mode, Deadline deadline,
+                                     const Context&... context) {
   UASSERT(list_size > 0);
   UASSERT(list_size <= IOV_MAX);
   std::size_t processed_bytes = 0;
   do {
     auto chunk_size = io_func(Fd(), list, list_size);
 
+    if constexpr (!std::is_null_pointer_v<std::decay_t<RingPrepare>>) {
+      if (chunk_size < 0 && io_uring_ && IsWouldBlock(errno) &&
+          (processed_bytes == 0 || mode == TransferMode::kWhole)) {
+        struct msghdr msg {};
+        msg.msg_iov = list;
+        msg.msg_iovlen = list_size;
+        chunk_size = ExecuteInRing(
+            [&](ev::IoUringOperation& op) { ring_prepare(op, Fd(), &msg); },
+            processed_bytes, deadline, context...);
+      }
+    }
+
     if (chunk_size > 0) {
       processed_bytes += chunk_size;
       if (mode == TransferMode::kOnce) {
@@ -221,10 +316,12 @@ size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
   return processed_bytes;
 }
 
-template <typename IoFunc, typename... Context>
-size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
-                            size_t len, TransferMode mode, Deadline deadline,
-                            const Context&... context) {
+template <typename IoFunc, typename RingPrepare, typename... Context>
+size_t Direction::PerformIoWithRing(SingleUserGuard&, IoFunc&& io_func,
+                                    RingPrepare&& ring_prepare, void* buf,
+                                    size_t len, TransferMode mode,
+                                    Deadline deadline,
+                                    const Context&... context) {
   char* const begin = static_cast<char*>(buf);
   char* const end = begin + len;
 
@@ -233,6 +330,17 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   while (pos < end) {
     auto chunk_size = io_func(Fd(), pos, end - pos);
 
+    if constexpr (!std::is_null_pointer_v<std::decay_t<RingPrepare>>) {
+      if (chunk_size < 0 && io_uring_ && IsWouldBlock(errno) &&
+          (pos == begin || mode == TransferMode::kWhole)) {
+        chunk_size = ExecuteInRing(
+            [&](ev::IoUringOperation& op) {
+              ring_prepare(op, Fd(), pos, end - pos);
+            },
+            pos - begin, deadline, context...);
+      }
+    }
+
     if (chunk_size > 0) {
       pos += chunk_size;
       if (mode == TransferMode::kOnce) {
@@ -1,10 +1,13 @@
 #include <userver/engine/io/socket.hpp>
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -69,6 +72,31 @@ Sockaddr& MemoizeAddr(Sockaddr& addr, decltype(&::getpeername) getter,
                     0);
 }
 
+// RingPrepare wrappers for Direction::PerformIoWithRing
+
+void RecvRingPrepare(ev::IoUringOperation& op, int fd, void* buf, size_t len) {
+  op.PrepareRecv(fd, buf, len, 0);
+}
+
+void SendRingPrepare(ev::IoUringOperation& op, int fd, void* buf, size_t len) {
+  op.PrepareSend(fd, buf, len,
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+                 MSG_NOSIGNAL |
+#endif
+                     0);
+}
+
+void SendMsgRingPrepare(ev::IoUringOperation& op, int fd,
+                        const struct msghdr* msg) {
+  op.PrepareSendMsg(fd, msg,
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+                    MSG_NOSIGNAL |
+#endif
+                        0);
+}
+
 class RecvFromWrapper {
  public:
   [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) {
@@ -106,6 +134,82 @@ class SendToWrapper {
   const Sockaddr& dest_addr_;
 };
 
+// Returns the number of the received datagrams, -1 with errno on error
+ssize_t RecvBatch(int fd, Socket::RecvDatagram* datagrams, size_t count) {
+  UASSERT(count > 0 && count <= kMaxStackSizeVector);
+#ifdef HAVE_RECVMMSG
+  std::array<struct mmsghdr, kMaxStackSizeVector> messages{};
+  std::array<struct iovec, kMaxStackSizeVector> iovecs{};
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = datagrams[i].buf;
+    iovecs[i].iov_len = datagrams[i].len;
+    auto& header = messages[i].msg_hdr;
+    header.msg_name = datagrams[i].src_addr.Data();
+    header.msg_namelen = datagrams[i].src_addr.Capacity();
+    header.msg_iov = &iovecs[i];
+    header.msg_iovlen = 1;
+  }
+
+  const auto ret = ::recvmmsg(fd, messages.data(), count, 0, nullptr);
+  for (ssize_t i = 0; i < ret; ++i) {
+    if (messages[i].msg_hdr.msg_namelen > datagrams[i].src_addr.Capacity()) {
+      throw IoException()
+          << "Peer address does not fit into AddrStorage, family="
+          << datagrams[i].src_addr.Data()->sa_family
+          << ", addrlen=" << messages[i].msg_hdr.msg_namelen;
+    }
+    datagrams[i].bytes_received = messages[i].msg_len;
+  }
+  return ret;
+#else
+  // MAC_COMPAT: no recvmmsg, drain the queue datagram by datagram
+  for (size_t i = 0; i < count; ++i) {
+    socklen_t addrlen = datagrams[i].src_addr.Capacity();
+    const auto ret = ::recvfrom(fd, datagrams[i].buf, datagrams[i].len, 0,
+                                datagrams[i].src_addr.Data(), &addrlen);
+    if (ret == -1) return i == 0 ? -1 : static_cast<ssize_t>(i);
+    datagrams[i].bytes_received = ret;
+  }
+  return count;
+#endif
+}
+
+// Returns the number of the sent datagrams, -1 with errno on error
+ssize_t SendBatch(int fd, const Socket::SendDatagram* datagrams,
+                  size_t count) {
+  UASSERT(count > 0 && count <= kMaxStackSizeVector);
+  constexpr int kFlags =
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+      MSG_NOSIGNAL |
+#endif
+      0;
+#ifdef HAVE_SENDMMSG
+  std::array<struct mmsghdr, kMaxStackSizeVector> messages{};
+  std::array<struct iovec, kMaxStackSizeVector> iovecs{};
+  for (size_t i = 0; i < count; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    iovecs[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iovecs[i].iov_len = datagrams[i].len;
+    auto& header = messages[i].msg_hdr;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    header.msg_name = const_cast<sockaddr*>(datagrams[i].dest_addr->Data());
+    header.msg_namelen = datagrams[i].dest_addr->Size();
+    header.msg_iov = &iovecs[i];
+    header.msg_iovlen = 1;
+  }
+  return ::sendmmsg(fd, messages.data(), count, kFlags);
+#else
+  for (size_t i = 0; i < count; ++i) {
+    const auto& dest_addr = *datagrams[i].dest_addr;
+    const auto ret = ::sendto(fd, datagrams[i].data, datagrams[i].len, kFlags,
+                              dest_addr.Data(), dest_addr.Size());
+    if (ret == -1) return i == 0 ? -1 : static_cast<ssize_t>(i);
+  }
+  return count;
+#endif
+}
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
   UASSERT(data);
   UASSERT(count > 0);
@@ -154,7 +258,16 @@ void Socket::Connect(const Sockaddr& addr, Deadline deadline) {
   }
 
   int err_value = errno;
-  if (err_value == EINPROGRESS) {
+  if (err_value == EINPROGRESS && fd_control_->Write().GetIoUring()) {
+    auto& dir = fd_control_->Write();
+    if (dir.ExecuteInRing(
+            [&](ev::IoUringOperation& op) { op.PreparePoll(Fd(), POLLOUT); },
+            0, deadline, "Connect to ", addr) == -1) {
+      err_value = errno;
+    } else {
+      err_value = GetOption(SOL_SOCKET, SO_ERROR);
+    }
+  } else if (err_value == EINPROGRESS) {
     if (!WaitWriteable(deadline)) {
       if (current_task::ShouldCancel()) {
         throw IoCancelled() << "Connect to " << addr;
@@ -220,8 +333,9 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce,
-                       deadline, "RecvSome from ", peername_);
+  return dir.PerformIoWithRing(guard, &RecvWrapper, &RecvRingPrepare, buf, len,
+                               impl::TransferMode::kOnce, deadline,
+                               "RecvSome from ", peername_);
 }
 
 size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
@@ -230,9 +344,9 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len,
-                       impl::TransferMode::kWhole, deadline, "RecvAll from ",
-                       peername_);
+  return dir.PerformIoWithRing(guard, &RecvWrapper, &RecvRingPrepare, buf, len,
+                               impl::TransferMode::kWhole, deadline,
+                               "RecvAll from ", peername_);
 }
 
 size_t Socket::SendAll(std::initializer_list<IoData> list, Deadline deadline) {
@@ -253,16 +367,18 @@ size_t Socket::SendAll(const IoData* list, std::size_t list_size,
     /// stack
     std::array<struct iovec, kMaxStackSizeVector> data{};
     FillIoSendData(list, data.data(), list_size);
-    return dir.PerformIoV(guard, &writev, data.data(), list_size,
-                          impl::TransferMode::kWhole, deadline, "SendAll to ",
-                          peername_);
+    return dir.PerformIoVWithRing(guard, &writev, &SendMsgRingPrepare,
+                                  data.data(), list_size,
+                                  impl::TransferMode::kWhole, deadline,
+                                  "SendAll to ", peername_);
   } else {
     /// heap
     std::vector<struct iovec> data(list_size);
     FillIoSendData(list, data.data(), list_size);
-    return dir.PerformIoV(guard, &writev, data.data(), list_size,
-                          impl::TransferMode::kWhole, deadline, "SendAll to ",
-                          peername_);
+    return dir.PerformIoVWithRing(guard, &writev, &SendMsgRingPrepare,
+                                  data.data(), list_size,
+                                  impl::TransferMode::kWhole, deadline,
+                                  "SendAll to ", peername_);
   }
 }
 
@@ -273,9 +389,10 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Write();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(guard, &SendWrapper, const_cast<void*>(buf), len,
-                       impl::TransferMode::kWhole, deadline, "SendAll to ",
-                       peername_);
+  return dir.PerformIoWithRing(guard, &SendWrapper, &SendRingPrepare,
+                               const_cast<void*>(buf), len,
+                               impl::TransferMode::kWhole, deadline,
+                               "SendAll to ", peername_);
 }
 
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
@@ -315,6 +432,76 @@ size_t Socket::SendAllTo(const Sockaddr& dest_addr, const void* buf, size_t len,
                        "SendAllTo to ", dest_addr);
 }
 
+size_t Socket::RecvSomeBatchFrom(RecvDatagram* datagrams, size_t count,
+                                 Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to RecvSomeBatchFrom via closed socket");
+  }
+  if (count == 0) return 0;
+
+  auto& dir = fd_control_->Read();
+  impl::Direction::SingleUserGuard guard(dir);
+  for (;;) {
+    const auto ret = RecvBatch(dir.Fd(), datagrams,
+                               std::min(count, kMaxStackSizeVector));
+    if (ret > 0) return ret;
+    if (ret == 0 || errno == EINTR) continue;
+
+    if (!impl::IsWouldBlock(errno)) {
+      utils::CheckSyscallCustomException<IoSystemError>(
+          -1, "receiving datagrams, fd={}", dir.Fd());
+    }
+    if (!dir.Wait(deadline)) {
+      if (current_task::ShouldCancel()) {
+        throw IoCancelled() << "RecvSomeBatchFrom";
+      }
+      throw IoTimeout() << "RecvSomeBatchFrom";
+    }
+  }
+}
+
+size_t Socket::SendAllBatchTo(const SendDatagram* datagrams, size_t count,
+                              Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendAllBatchTo via closed socket");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    UASSERT(datagrams[i].dest_addr);
+    if (datagrams[i].dest_addr->Domain() != domain_) {
+      throw AddrException(fmt::format(
+          "Socket address domain ({}) does not match address domain ({})",
+          static_cast<int>(domain_),
+          static_cast<int>(datagrams[i].dest_addr->Domain())));
+    }
+  }
+
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+  size_t sent = 0;
+  while (sent < count) {
+    const auto ret =
+        SendBatch(dir.Fd(), datagrams + sent,
+                  std::min(count - sent, kMaxStackSizeVector));
+    if (ret > 0) {
+      sent += ret;
+      continue;
+    }
+    if (ret == 0 || errno == EINTR) continue;
+
+    if (!impl::IsWouldBlock(errno)) {
+      utils::CheckSyscallCustomException<IoSystemError>(
+          -1, "sending datagrams, fd={}", dir.Fd());
+    }
+    if (!dir.Wait(deadline)) {
+      if (current_task::ShouldCancel()) {
+        throw IoCancelled(sent) << "SendAllBatchTo";
+      }
+      throw IoTimeout(sent) << "SendAllBatchTo";
+    }
+  }
+  return sent;
+}
+
 Socket Socket::Accept(Deadline deadline) {
   if (!IsValid()) {
     throw IoException("Attempt to Accept from closed socket");
@@ -329,6 +516,15 @@ Socket Socket::Accept(Deadline deadline) {
 #ifdef HAVE_ACCEPT4
     int fd =
         ::accept4(dir.Fd(), buf.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd == -1 && impl::IsWouldBlock(errno) && dir.GetIoUring()) {
+      len = buf.Capacity();
+      fd = dir.ExecuteInRing(
+          [&](ev::IoUringOperation& op) {
+            op.PrepareAccept(dir.Fd(), buf.Data(), &len,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+          },
+          0, deadline, "Accept");
+    }
 #else
     int fd = ::accept(dir.Fd(), buf.Data(), &len);
 #endif
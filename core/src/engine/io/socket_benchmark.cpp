@@ -1,8 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
@@ -138,4 +140,55 @@ BENCHMARK(socket_send_all_v);
 // TODO(TAXICOMMON-5510) flaky, sometimes throws engine::io::IoTimeout
 // BENCHMARK(socket_send_all_range)->RangeMultiplier(10)->Range(10, 10000);
 
+// Sends and receives state.range(0) datagrams per iteration, one per syscall
+// for the batch size of 0
+void socket_dgram_throughput(benchmark::State& state) {
+  engine::RunStandalone([&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    constexpr std::size_t kDatagrams = 32;
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+
+    internal::net::UdpListener listener;
+    engine::io::Socket client{listener.addr.Domain(),
+                              internal::net::UdpListener::type};
+    // a single iteration fits into the socket buffers
+    std::array<char, 64> payload{};
+
+    std::vector<engine::io::Socket::SendDatagram> to_send(
+        kDatagrams, {&listener.addr, payload.data(), payload.size()});
+    std::vector<std::array<char, 64>> buffers(kDatagrams);
+    std::vector<engine::io::Socket::RecvDatagram> received(kDatagrams);
+    for (std::size_t i = 0; i < kDatagrams; ++i) {
+      received[i].buf = buffers[i].data();
+      received[i].len = buffers[i].size();
+    }
+
+    for (auto _ : state) {
+      if (batch_size == 0) {
+        for (std::size_t i = 0; i < kDatagrams; ++i) {
+          benchmark::DoNotOptimize(client.SendAllTo(
+              listener.addr, payload.data(), payload.size(), test_deadline));
+        }
+        for (std::size_t i = 0; i < kDatagrams; ++i) {
+          benchmark::DoNotOptimize(listener.socket.RecvSomeFrom(
+              buffers[i].data(), buffers[i].size(), test_deadline));
+        }
+      } else {
+        for (std::size_t sent = 0; sent < kDatagrams; sent += batch_size) {
+          benchmark::DoNotOptimize(client.SendAllBatchTo(
+              to_send.data() + sent, std::min(batch_size, kDatagrams - sent),
+              test_deadline));
+        }
+        for (std::size_t got = 0; got < kDatagrams;) {
+          got += listener.socket.RecvSomeBatchFrom(
+              received.data() + got, std::min(batch_size, kDatagrams - got),
+              test_deadline);
+        }
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kDatagrams);
+  });
+}
+BENCHMARK(socket_dgram_throughput)->Arg(0)->Arg(1)->Arg(8)->Arg(32);
+
 USERVER_NAMESPACE_END
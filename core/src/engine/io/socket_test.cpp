@@ -8,15 +8,22 @@
 #include <array>
 #include <cerrno>
 #include <cstdlib>
+#include <functional>
+#include <string>
 #include <string_view>
+#include <vector>
 
+#include <engine/ev/thread_pool.hpp>
+#include <engine/task/task_processor.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/internal/net/net_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -28,6 +35,23 @@ using Deadline = engine::Deadline;
 using TcpListener = internal::net::TcpListener;
 using UdpListener = internal::net::UdpListener;
 
+bool IsIoUringEnabled() {
+  return engine::current_task::GetTaskProcessor()
+      .EventThreadPool()
+      .IsIoUringEnabled();
+}
+
+void RunWithIoUring(std::function<void()> payload) {
+  engine::TaskProcessorPoolsConfig config;
+  config.io_uring = true;
+  engine::RunStandalone(2, config, [&payload] {
+    if (!IsIoUringEnabled()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    payload();
+  });
+}
+
 }  // namespace
 
 UTEST(Socket, ConnectFail) {
@@ -390,6 +414,53 @@ UTEST(Socket, DgramUnbound) {
   listen_task.Get();
 }
 
+UTEST(Socket, DgramBatch) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  UdpListener listener;
+  engine::io::Socket client{listener.addr.Domain(), UdpListener::type};
+
+  constexpr std::size_t kDatagrams = 40;
+  std::vector<std::string> payloads;
+  std::vector<engine::io::Socket::SendDatagram> to_send;
+  for (std::size_t i = 0; i < kDatagrams; ++i) {
+    payloads.push_back(std::to_string(i));
+  }
+  for (const auto& payload : payloads) {
+    to_send.push_back({&listener.addr, payload.data(), payload.size()});
+  }
+  EXPECT_EQ(kDatagrams, client.SendAllBatchTo(to_send.data(), to_send.size(),
+                                              test_deadline));
+
+  std::vector<std::array<char, 8>> buffers(kDatagrams);
+  std::vector<engine::io::Socket::RecvDatagram> received(kDatagrams);
+  for (std::size_t i = 0; i < kDatagrams; ++i) {
+    received[i].buf = buffers[i].data();
+    received[i].len = buffers[i].size();
+  }
+
+  std::size_t received_count = 0;
+  while (received_count < kDatagrams) {
+    const auto count = listener.socket.RecvSomeBatchFrom(
+        received.data() + received_count, kDatagrams - received_count,
+        test_deadline);
+    ASSERT_GT(count, 0);
+    received_count += count;
+  }
+
+  for (std::size_t i = 0; i < kDatagrams; ++i) {
+    EXPECT_EQ(payloads[i], std::string(buffers[i].data(),
+                                       received[i].bytes_received));
+    EXPECT_EQ(client.Getsockname().Port(), received[i].src_addr.Port());
+  }
+
+  // nothing is queued, the receive waits for the deadline
+  UEXPECT_THROW([[maybe_unused]] auto ret = listener.socket.RecvSomeBatchFrom(
+                    received.data(), received.size(),
+                    Deadline::FromDuration(std::chrono::milliseconds{10})),
+                io::IoTimeout);
+}
+
 UTEST_MT(Socket, ConcurrentReadWriteUdp, 2) {
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -440,4 +511,121 @@ UTEST(Socket, WriteALot) {
   }
 }
 
+TEST(Socket, IoUringAcceptConnect) {
+  RunWithIoUring([] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    // Accept and RecvSome are submitted before there is anything to complete
+    auto server_task = engine::AsyncNoSpan([&] {
+      auto server = listener.socket.Accept(deadline);
+      EXPECT_TRUE(server.IsValid());
+      EXPECT_EQ("::1", server.Getpeername().PrimaryAddressString());
+
+      char c = 0;
+      ASSERT_EQ(1, server.RecvSome(&c, 1, deadline));
+      EXPECT_EQ('1', c);
+      ASSERT_EQ(1, server.SendAll("2", 1, deadline));
+    });
+    engine::SleepFor(std::chrono::milliseconds{10});
+
+    io::Socket client{listener.addr.Domain(), TcpListener::type};
+    client.Connect(listener.addr, deadline);
+    EXPECT_EQ(listener.port, client.Getpeername().Port());
+    ASSERT_EQ(1, client.SendAll("1", 1, deadline));
+
+    char c = 0;
+    ASSERT_EQ(1, client.RecvAll(&c, 1, deadline));
+    EXPECT_EQ('2', c);
+    server_task.Get();
+  });
+}
+
+TEST(Socket, IoUringSendAllRecvAll) {
+  RunWithIoUring([] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto sockets = listener.MakeSocketPair(deadline);
+
+    // much more than the socket buffers, so the operations are split
+    std::string data(8 * 1024 * 1024, '\0');
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<char>(i % 251);
+    }
+
+    auto read_task = engine::AsyncNoSpan([&] {
+      std::string received(data.size(), '\0');
+      EXPECT_EQ(received.size(),
+                sockets.first.RecvAll(received.data(), received.size(),
+                                      deadline));
+      EXPECT_EQ(received, data);
+    });
+
+    EXPECT_EQ(data.size(),
+              sockets.second.SendAll(data.data(), data.size(), deadline));
+    read_task.Get();
+  });
+}
+
+TEST(Socket, IoUringTimeout) {
+  RunWithIoUring([] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto sockets = listener.MakeSocketPair(deadline);
+
+    char c = 0;
+    UEXPECT_THROW(
+        [[maybe_unused]] auto received = sockets.first.RecvSome(
+            &c, 1, Deadline::FromDuration(std::chrono::milliseconds{10})),
+        io::IoTimeout);
+
+    // the socket is usable after the timed out request
+    ASSERT_EQ(1, sockets.second.SendAll("1", 1, deadline));
+    ASSERT_EQ(1, sockets.first.RecvSome(&c, 1, deadline));
+    EXPECT_EQ('1', c);
+  });
+}
+
+TEST(Socket, IoUringCancel) {
+  RunWithIoUring([] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto sockets = listener.MakeSocketPair(deadline);
+
+    for (int i = 0; i < 10; ++i) {
+      engine::SingleConsumerEvent has_started_event;
+      auto recv_task = engine::AsyncNoSpan([&] {
+        has_started_event.Send();
+        char c = 0;
+        [[maybe_unused]] auto received =
+            sockets.first.RecvSome(&c, 1, deadline);
+      });
+      ASSERT_TRUE(has_started_event.WaitForEvent());
+      engine::Yield();
+      recv_task.RequestCancel();
+      UEXPECT_THROW(recv_task.Get(), io::IoCancelled);
+
+      // a cancellation of the previous request must not hit the new one
+      auto send_task = engine::AsyncNoSpan(
+          [&] { ASSERT_EQ(1, sockets.second.SendAll("x", 1, deadline)); });
+      char c = 0;
+      ASSERT_EQ(1, sockets.first.RecvSome(&c, 1, deadline));
+      EXPECT_EQ('x', c);
+      send_task.Get();
+    }
+
+    engine::SingleConsumerEvent has_started_event;
+    auto accept_task = engine::AsyncNoSpan([&] {
+      has_started_event.Send();
+      [[maybe_unused]] auto socket = listener.socket.Accept(deadline);
+    });
+    ASSERT_TRUE(has_started_event.WaitForEvent());
+    accept_task.RequestCancel();
+    UEXPECT_THROW(accept_task.Get(), io::IoCancelled);
+  });
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,306 @@
+#include <engine/io/tls_session_impl.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+#include <crypto/helpers.hpp>
+#include <crypto/openssl.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+namespace {
+
+template <std::size_t Size>
+void FillRandom(std::array<unsigned char, Size>& data) {
+  if (1 != RAND_bytes(data.data(), data.size())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to generate a session ticket key: RAND_bytes"));
+  }
+}
+
+TlsTicketKey MakeKey() {
+  TlsTicketKey key;
+  FillRandom(key.name);
+  FillRandom(key.aes_key);
+  FillRandom(key.hmac_key);
+  return key;
+}
+
+int GetTicketKeysIndex() {
+  static const int kIndex =
+      SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return kIndex;
+}
+
+bool InitMac(TlsTicketMacCtx* mac_ctx, const TlsTicketKey& key) {
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  auto* hmac_key = const_cast<unsigned char*>(key.hmac_key.data());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  auto* digest = const_cast<char*>("SHA256");
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, hmac_key,
+                                        key.hmac_key.size()),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+      OSSL_PARAM_construct_end(),
+  };
+  return 1 == EVP_MAC_CTX_set_params(mac_ctx, params);
+#else
+  return 1 == HMAC_Init_ex(mac_ctx, key.hmac_key.data(), key.hmac_key.size(),
+                           EVP_sha256(), nullptr);
+#endif
+}
+
+}  // namespace
+
+void TlsHandshakeCounters::Account(SSL* ssl) noexcept {
+  auto& counter = SSL_session_reused(ssl) ? resumed_ : full_;
+  counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+TlsHandshakeStatistics TlsHandshakeCounters::Get() const noexcept {
+  return {full_.load(std::memory_order_relaxed),
+          resumed_.load(std::memory_order_relaxed)};
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const TlsHandshakeStatistics& stats) {
+  writer["handshakes"].ValueWithLabels(stats.full, {"tls_handshake", "full"});
+  writer["handshakes"].ValueWithLabels(stats.resumed,
+                                       {"tls_handshake", "resumed"});
+}
+
+TlsSessionTicketKeys::Impl::Impl(std::chrono::seconds rotation_period)
+    : rotation_period_(rotation_period),
+      keys_(Keys{MakeKey(), std::nullopt, std::chrono::steady_clock::now()}) {
+  UINVARIANT(rotation_period_.count() > 0,
+             "Session ticket keys rotation period must be positive");
+}
+
+void TlsSessionTicketKeys::Impl::Rotate() {
+  auto keys = keys_.StartWrite();
+  keys->previous = keys->current;
+  keys->current = MakeKey();
+  keys->rotated_at = std::chrono::steady_clock::now();
+  keys.Commit();
+}
+
+void TlsSessionTicketKeys::Impl::SetUpContext(SSL_CTX* ssl_ctx) {
+  crypto::impl::Openssl::Init();
+
+  if (1 != SSL_CTX_set_ex_data(ssl_ctx, GetTicketKeysIndex(), this)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up session tickets: SSL_CTX_set_ex_data"));
+  }
+  // casts in the macro expansions
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-cstyle-cast)
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+  SSL_CTX_set_tlsext_ticket_key_evp_cb(ssl_ctx, &OnTicketKey);
+#else
+  SSL_CTX_set_tlsext_ticket_key_cb(ssl_ctx, &OnTicketKey);
+#endif
+  // NOLINTEND(cppcoreguidelines-pro-type-cstyle-cast)
+
+  // tickets of the previous key are accepted for one more period
+  SSL_CTX_set_timeout(ssl_ctx, 2 * rotation_period_.count());
+}
+
+// Returns 1 on success, 2 if the ticket should be renewed, 0 if the ticket
+// can not be decrypted and a negative value on errors
+int TlsSessionTicketKeys::Impl::OnTicketKey(SSL* ssl, unsigned char* key_name,
+                                            unsigned char* iv,
+                                            EVP_CIPHER_CTX* cipher_ctx,
+                                            TlsTicketMacCtx* mac_ctx,
+                                            int enc) noexcept {
+  auto* keys = static_cast<Impl*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), GetTicketKeysIndex()));
+  UASSERT(keys);
+
+  try {
+    if (enc) {
+      const auto key = keys->GetCurrentKey();
+      if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) {
+        return -1;
+      }
+      std::copy(key.name.begin(), key.name.end(), key_name);
+      if (1 != EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr,
+                                  key.aes_key.data(), iv) ||
+          !InitMac(mac_ctx, key)) {
+        return -1;
+      }
+      return 1;
+    }
+
+    const auto key = keys->FindKey(key_name);
+    if (!key) return 0;
+    if (1 != EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr,
+                                key->aes_key.data(), iv) ||
+        !InitMac(mac_ctx, *key)) {
+      return -1;
+    }
+    // Clients use TLS 1.3 tickets only once, and tickets of the previous key
+    // should be replaced, so a new ticket is always issued on resumption
+    return 2;
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_ERROR() << "Failed to process a session ticket key: " << ex;
+    return -1;
+  }
+}
+
+TlsTicketKey TlsSessionTicketKeys::Impl::GetCurrentKey() {
+  const auto now = std::chrono::steady_clock::now();
+  {
+    const auto keys = keys_.Read();
+    if (now < keys->rotated_at + rotation_period_) return keys->current;
+  }
+
+  auto keys = keys_.StartWrite();
+  // might have been rotated concurrently
+  if (now >= keys->rotated_at + rotation_period_) {
+    keys->previous = keys->current;
+    keys->current = MakeKey();
+    keys->rotated_at = now;
+  }
+  auto key = keys->current;
+  keys.Commit();
+  return key;
+}
+
+std::optional<TlsTicketKey> TlsSessionTicketKeys::Impl::FindKey(
+    const unsigned char* name) const {
+  const auto keys = keys_.Read();
+  const auto matches = [name](const TlsTicketKey& key) {
+    return std::memcmp(key.name.data(), name, key.name.size()) == 0;
+  };
+
+  // the rotation is lazy, so the age of the keys is checked here as well
+  const auto since_rotation =
+      std::chrono::steady_clock::now() - keys->rotated_at;
+  if (matches(keys->current) && since_rotation < 2 * rotation_period_) {
+    return keys->current;
+  }
+  if (keys->previous && matches(*keys->previous) &&
+      since_rotation < rotation_period_) {
+    return keys->previous;
+  }
+  return std::nullopt;
+}
+
+int TlsClientSessionCache::Impl::GetConnectionDataIndex() {
+  static const int kIndex = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                                 &FreeConnectionData);
+  return kIndex;
+}
+
+void TlsClientSessionCache::Impl::FreeConnectionData(void*, void* ptr,
+                                                     CRYPTO_EX_DATA*, int,
+                                                     long, void*) {
+  delete static_cast<ConnectionData*>(ptr);
+}
+
+int TlsClientSessionCache::Impl::OnNewSession(SSL* ssl,
+                                              SSL_SESSION* session) noexcept {
+  auto* data = static_cast<ConnectionData*>(
+      SSL_get_ex_data(ssl, GetConnectionDataIndex()));
+  if (!data) return 0;
+
+  try {
+    data->cache->Put(data->destination,
+                     SslSession{session, SslSessionDeleter{}});
+    return 1;  // the session is owned by the cache
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Failed to cache a TLS session: " << ex;
+    return 0;
+  }
+}
+
+TlsClientSessionCache::Impl::Impl(std::size_t max_size)
+    : sessions_(std::max<std::size_t>(max_size, 1)) {}
+
+void TlsClientSessionCache::Impl::Clear() {
+  auto sessions = sessions_.Lock();
+  sessions->Clear();
+}
+
+void TlsClientSessionCache::Impl::SetUpContext(SSL_CTX* ssl_ctx) {
+  crypto::impl::Openssl::Init();
+
+  // TLS 1.3 tickets arrive after the handshake, so the sessions are
+  // collected by the callback instead of the internal per-context store
+  SSL_CTX_set_session_cache_mode(
+      ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ssl_ctx, &OnNewSession);
+}
+
+void TlsClientSessionCache::Impl::SetUpConnection(SSL* ssl,
+                                                  std::string destination) {
+  const auto session = Get(destination);
+  if (session
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+      && SSL_SESSION_is_resumable(session.get())
+#endif
+  ) {
+    if (1 != SSL_set_session(ssl, session.get())) {
+      LOG_LIMITED_WARNING() << crypto::FormatSslError(
+          "Failed to resume a TLS session: SSL_set_session");
+    }
+  }
+
+  auto data = std::make_unique<ConnectionData>(
+      ConnectionData{this, std::move(destination)});
+  if (1 != SSL_set_ex_data(ssl, GetConnectionDataIndex(), data.get())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up TLS session cache: SSL_set_ex_data"));
+  }
+  [[maybe_unused]] const auto* disowned_data = data.release();
+}
+
+void TlsClientSessionCache::Impl::Put(const std::string& destination,
+                                      SslSession session) {
+  auto sessions = sessions_.Lock();
+  sessions->Put(destination, std::move(session));
+}
+
+SslSession TlsClientSessionCache::Impl::Get(const std::string& destination) {
+  auto sessions = sessions_.Lock();
+  return sessions->GetOr(destination, {});
+}
+
+TlsSessionTicketKeys::TlsSessionTicketKeys(
+    std::chrono::seconds rotation_period)
+    : impl_(std::make_unique<Impl>(rotation_period)) {}
+
+TlsSessionTicketKeys::~TlsSessionTicketKeys() = default;
+
+void TlsSessionTicketKeys::Rotate() { impl_->Rotate(); }
+
+TlsHandshakeStatistics TlsSessionTicketKeys::GetStatistics() const {
+  return impl_->GetStatistics();
+}
+
+TlsClientSessionCache::TlsClientSessionCache(std::size_t max_size)
+    : impl_(std::make_unique<Impl>(max_size)) {}
+
+TlsClientSessionCache::~TlsClientSessionCache() = default;
+
+void TlsClientSessionCache::Clear() { impl_->Clear(); }
+
+TlsHandshakeStatistics TlsClientSessionCache::GetStatistics() const {
+  return impl_->GetStatistics();
+}
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
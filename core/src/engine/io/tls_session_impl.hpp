@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER < 0x030000000L
+#include <openssl/hmac.h>
+#endif
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/io/tls_session.hpp>
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+class TlsHandshakeCounters final {
+ public:
+  void Account(SSL* ssl) noexcept;
+
+  TlsHandshakeStatistics Get() const noexcept;
+
+ private:
+  std::atomic<std::uint64_t> full_{0};
+  std::atomic<std::uint64_t> resumed_{0};
+};
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+using TlsTicketMacCtx = EVP_MAC_CTX;
+#else
+using TlsTicketMacCtx = HMAC_CTX;
+#endif
+
+struct TlsTicketKey {
+  std::array<unsigned char, 16> name{};
+  std::array<unsigned char, 32> aes_key{};
+  std::array<unsigned char, 32> hmac_key{};
+};
+
+class TlsSessionTicketKeys::Impl final {
+ public:
+  explicit Impl(std::chrono::seconds rotation_period);
+
+  void Rotate();
+
+  /// Makes the servers of the context issue and accept tickets of the keys
+  void SetUpContext(SSL_CTX* ssl_ctx);
+
+  void AccountHandshake(SSL* ssl) noexcept { counters_.Account(ssl); }
+
+  TlsHandshakeStatistics GetStatistics() const { return counters_.Get(); }
+
+ private:
+  struct Keys {
+    TlsTicketKey current;
+    std::optional<TlsTicketKey> previous;
+    std::chrono::steady_clock::time_point rotated_at;
+  };
+
+  static int OnTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                         EVP_CIPHER_CTX* cipher_ctx, TlsTicketMacCtx* mac_ctx,
+                         int enc) noexcept;
+
+  /// Takes the key to encrypt a new ticket, rotating the expired one
+  TlsTicketKey GetCurrentKey();
+
+  /// Finds the current or the previous key of a ticket
+  std::optional<TlsTicketKey> FindKey(const unsigned char* name) const;
+
+  const std::chrono::seconds rotation_period_;
+  rcu::Variable<Keys> keys_;
+  TlsHandshakeCounters counters_;
+};
+
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::shared_ptr<SSL_SESSION>;
+
+class TlsClientSessionCache::Impl final {
+ public:
+  explicit Impl(std::size_t max_size);
+
+  void Clear();
+
+  /// Makes the clients of the context report their new sessions
+  static void SetUpContext(SSL_CTX* ssl_ctx);
+
+  /// Resumes the cached session of the destination if any, and caches the
+  /// new sessions of the connection
+  void SetUpConnection(SSL* ssl, std::string destination);
+
+  void AccountHandshake(SSL* ssl) noexcept { counters_.Account(ssl); }
+
+  TlsHandshakeStatistics GetStatistics() const { return counters_.Get(); }
+
+ private:
+  struct ConnectionData {
+    Impl* cache;
+    std::string destination;
+  };
+
+  static int GetConnectionDataIndex();
+  static void FreeConnectionData(void* parent, void* ptr, CRYPTO_EX_DATA* ad,
+                                 int index, long argl, void* argp);
+  static int OnNewSession(SSL* ssl, SSL_SESSION* session) noexcept;
+
+  void Put(const std::string& destination, SslSession session);
+  SslSession Get(const std::string& destination);
+
+  concurrent::Variable<cache::LruMap<std::string, SslSession>> sessions_;
+  TlsHandshakeCounters counters_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -10,7 +10,9 @@
 #include <crypto/helpers.hpp>
 #include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <engine/io/tls_session_impl.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -48,6 +50,12 @@ void BIO_set_shutdown(BIO* bio, int shutdown) { bio->shutdown = shutdown; }
 
 constexpr const char* kBioMethodName = "userver-socket";
 
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+constexpr bool kHasKernelTls = true;
+#else
+constexpr bool kHasKernelTls = false;
+#endif
+
 struct SocketBioData {
   explicit SocketBioData(Socket&& socket) : socket(std::move(socket)) {
     if (!this->socket) {
@@ -239,20 +247,31 @@ class TlsWrapper::Impl {
   Impl(Impl&& other) noexcept
       : bio_data(std::move(other.bio_data)),
         ssl(std::move(other.ssl)),
-        is_in_shutdown(other.is_in_shutdown) {
+        is_in_shutdown(other.is_in_shutdown),
+        is_native_bio(other.is_native_bio) {
     UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-    SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    // native BIO only keeps the descriptor, which does not change on move
+    if (!is_native_bio) SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
+  void SetUp(SslCtx&& ssl_ctx, KernelTls kernel_tls) {
+    // kTLS is set up by OpenSSL during the handshake and is only supported
+    // by its own socket BIO, so the descriptor is handed to OpenSSL
+    // and we wait for it on WANT_READ/WANT_WRITE.
+    is_native_bio = kHasKernelTls && kernel_tls == KernelTls::kIfSupported;
+
+    Bio socket_bio{is_native_bio
+                       ? BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE)
+                       : BIO_new(GetSocketBioMethod())};
     if (!socket_bio) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
     }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    SyncBioData(socket_bio.get(), nullptr);
-    BIO_set_init(socket_bio.get(), 1);
+    if (!is_native_bio) {
+      BIO_set_shutdown(socket_bio.get(), 0);
+      SyncBioData(socket_bio.get(), nullptr);
+      BIO_set_init(socket_bio.get(), 1);
+    }
 
     ssl.reset(SSL_new(ssl_ctx.get()));
     if (!ssl) {
@@ -261,11 +280,76 @@ class TlsWrapper::Impl {
     }
 #if OPENSSL_VERSION_NUMBER < 0x010100000L
     ssl->s3->flags |= SSL3_FLAGS_NO_RENEGOTIATE_CIPHERS;
+#endif
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+    if (is_native_bio) SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
 #endif
     SSL_set_bio(ssl.get(), socket_bio.get(), socket_bio.get());
     [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
   }
 
+  void DoHandshake(int (*handshake_func)(SSL*), Deadline deadline,
+                   const char* side) {
+    UASSERT(ssl);
+    bio_data.current_deadline = deadline;
+
+    while (true) {
+      const int ret = handshake_func(ssl.get());
+      if (ret == 1) break;
+
+      const int ssl_error = SSL_get_error(ssl.get(), ret);
+      if (IsWantIo(ssl_error) && WaitForNativeBio(ssl_error, 0)) continue;
+      if (bio_data.last_exception) {
+        std::rethrow_exception(bio_data.last_exception);
+      }
+      throw TlsException(crypto::FormatSslError(fmt::format(
+          "Failed to set up {} TLS wrapper ({})", side, ssl_error)));
+    }
+
+    if (is_native_bio) {
+      LOG_DEBUG() << "Kernel TLS offload for " << side
+                  << " TLS wrapper: send=" << IsKernelTlsSendActive()
+                  << ", recv=" << IsKernelTlsRecvActive();
+    }
+  }
+
+  /// Waits for the socket if OpenSSL works with it directly. Stores the
+  /// interruption into `bio_data.last_exception` and returns false if the
+  /// operation should not be retried.
+  bool WaitForNativeBio(int ssl_error, size_t bytes_transferred) {
+    if (!is_native_bio) return false;
+
+    auto& socket = bio_data.socket;
+    const auto deadline = bio_data.current_deadline;
+    if (!current_task::ShouldCancel() &&
+        (ssl_error == SSL_ERROR_WANT_READ ? socket.WaitReadable(deadline)
+                                          : socket.WaitWriteable(deadline))) {
+      bio_data.last_exception = {};
+      return true;
+    }
+
+    try {
+      if (current_task::ShouldCancel()) throw IoCancelled(bytes_transferred);
+      throw IoTimeout(bytes_transferred);
+    } catch (const IoInterrupted&) {
+      bio_data.last_exception = std::current_exception();
+    }
+    return false;
+  }
+
+  bool IsKernelTlsSendActive() const {
+    return ssl && is_native_bio && BIO_get_ktls_send(SSL_get_wbio(ssl.get()));
+  }
+
+  bool IsKernelTlsRecvActive() const {
+    return ssl && is_native_bio && BIO_get_ktls_recv(SSL_get_rbio(ssl.get()));
+  }
+
+  static bool IsWantIo(int ssl_error) noexcept {
+    return ssl_error == SSL_ERROR_WANT_READ ||
+           ssl_error == SSL_ERROR_WANT_WRITE;
+  }
+
   template <typename SslIoFunc>
   size_t PerformSslIo(SslIoFunc&& io_func, void* buf, size_t len,
                       impl::TransferMode mode, InterruptAction interrupt_action,
@@ -294,6 +378,8 @@ class TlsWrapper::Impl {
           // timeout, cancel, EOF, or just a spurious wakeup
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            WaitForNativeBio(ssl_error, pos - begin);
+            break;
           case SSL_ERROR_ZERO_RETURN:
             break;
 
@@ -336,6 +422,7 @@ class TlsWrapper::Impl {
   SocketBioData bio_data;
   Ssl ssl;
   bool is_in_shutdown{false};
+  bool is_native_bio{false};
 
  private:
   void SyncBioData(BIO* bio,
@@ -349,7 +436,8 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
-                                      Deadline deadline) {
+                                      Deadline deadline, KernelTls kernel_tls,
+                                      TlsClientSessionCache* session_cache) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!server_name.empty()) {
@@ -366,8 +454,18 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
     SSL_CTX_set_verify(ssl_ctx.get(), SSL_VERIFY_PEER, nullptr);
   }
 
+  std::string destination;
+  if (session_cache) {
+    session_cache->impl_->SetUpContext(ssl_ctx.get());
+    destination = fmt::format("{}@{}", server_name, socket.Getpeername());
+  }
+
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), kernel_tls);
+  if (session_cache) {
+    session_cache->impl_->SetUpConnection(wrapper.impl_->ssl.get(),
+                                          std::move(destination));
+  }
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -378,17 +476,9 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
     }
   }
 
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up client TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  wrapper.impl_->DoHandshake(&SSL_connect, deadline, "client");
+  if (session_cache) {
+    session_cache->impl_->AccountHandshake(wrapper.impl_->ssl.get());
   }
   return wrapper;
 }
@@ -396,7 +486,8 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
+    const std::vector<crypto::Certificate>& cert_authorities,
+    KernelTls kernel_tls, TlsSessionTicketKeys* session_ticket_keys) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!cert_authorities.empty()) {
@@ -419,21 +510,22 @@ TlsWrapper TlsWrapper::StartTlsServer(
         "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
   }
 
-  TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up server TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  if (session_ticket_keys) {
+    session_ticket_keys->impl_->SetUpContext(ssl_ctx.get());
+  } else {
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+    // the context is not shared, so its tickets could never be resumed
+    SSL_CTX_set_num_tickets(ssl_ctx.get(), 0);
+#endif
+    SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_NO_TICKET);
   }
 
+  TlsWrapper wrapper{std::move(socket)};
+  wrapper.impl_->SetUp(std::move(ssl_ctx), kernel_tls);
+  wrapper.impl_->DoHandshake(&SSL_accept, deadline, "server");
+  if (session_ticket_keys) {
+    session_ticket_keys->impl_->AccountHandshake(wrapper.impl_->ssl.get());
+  }
   return wrapper;
 }
 
@@ -482,8 +574,58 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
                              deadline, "SendAll");
 }
 
+size_t TlsWrapper::SendFile(int fd, size_t offset, size_t len,
+                            Deadline deadline) {
+  impl_->CheckAlive();
+  if (!impl_->IsKernelTlsSendActive()) {
+    throw TlsException("SendFile requires the kernel TLS send offload");
+  }
+
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  impl_->bio_data.current_deadline = deadline;
+  size_t sent = 0;
+  while (sent < len && impl_->ssl) {
+    const auto ret = SSL_sendfile(impl_->ssl.get(), fd,
+                                  static_cast<off_t>(offset + sent),
+                                  len - sent, /*flags=*/0);
+    if (ret > 0) {
+      sent += ret;
+      continue;
+    }
+    if (ret == 0) break;  // EOF of the file
+
+    const int ssl_error = SSL_get_error(impl_->ssl.get(), ret);
+    if (Impl::IsWantIo(ssl_error) && impl_->WaitForNativeBio(ssl_error, sent)) {
+      continue;
+    }
+    if (impl_->bio_data.last_exception) {
+      std::rethrow_exception(impl_->bio_data.last_exception);
+    }
+    impl_->ssl.reset();
+    throw TlsException(crypto::FormatSslError("SendFile failed"));
+  }
+  return sent;
+#else
+  static_cast<void>(fd);
+  static_cast<void>(offset);
+  static_cast<void>(len);
+  static_cast<void>(deadline);
+  UINVARIANT(false, "Kernel TLS is not supported by the OpenSSL build");
+#endif
+}
+
+bool TlsWrapper::IsKernelTlsSendActive() const {
+  return impl_->IsKernelTlsSendActive();
+}
+
+bool TlsWrapper::IsKernelTlsRecvActive() const {
+  return impl_->IsKernelTlsRecvActive();
+}
+
 Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
+    const bool is_kernel_tls =
+        impl_->IsKernelTlsSendActive() || impl_->IsKernelTlsRecvActive();
     impl_->is_in_shutdown = true;
     impl_->bio_data.current_deadline = deadline;
     int shutdown_ret = 0;
@@ -495,6 +637,7 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
           // this is fine
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            impl_->WaitForNativeBio(ssl_error, 0);
             break;
 
           // connection breaking errors
@@ -515,6 +658,8 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
       }
     }
     impl_->ssl.reset();
+    // the kernel keeps encrypting the socket after the offload
+    if (is_kernel_tls) impl_->bio_data.socket.Close();
   }
   return std::move(impl_->bio_data.socket);
 }
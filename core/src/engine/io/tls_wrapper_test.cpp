@@ -12,6 +12,9 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/async.hpp>
@@ -572,4 +575,119 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, KernelTls, 2) {
+  static constexpr std::string_view kFileData = "static file contents";
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline](auto&& server) {
+        try {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+              io::KernelTls::kIfSupported);
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          EXPECT_EQ('2', c);
+
+          if (tls_server.IsKernelTlsSendActive()) {
+            const auto temp_file = fs::blocking::TempFile::Create();
+            fs::blocking::RewriteFileContents(temp_file.GetPath(), kFileData);
+            const auto file = fs::blocking::FileDescriptor::Open(
+                temp_file.GetPath(), fs::blocking::OpenFlag::kRead);
+            EXPECT_EQ(kFileData.size() - 1,
+                      tls_server.SendFile(file.GetNative(), 1,
+                                          kFileData.size(), test_deadline));
+          } else {
+            UEXPECT_THROW(static_cast<void>(tls_server.SendFile(
+                              0, 0, kFileData.size(), test_deadline)),
+                          io::TlsException);
+            EXPECT_EQ(kFileData.size() - 1,
+                      tls_server.SendAll(kFileData.data() + 1,
+                                         kFileData.size() - 1, test_deadline));
+          }
+        } catch (const std::exception& e) {
+          LOG_ERROR() << e;
+          FAIL() << e.what();
+        }
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(
+      std::move(client), {}, test_deadline, io::KernelTls::kIfSupported);
+  char c = 0;
+  EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+  EXPECT_EQ('1', c);
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+  std::string buffer(kFileData.size() - 1, '\0');
+  EXPECT_EQ(buffer.size(),
+            tls_client.RecvAll(buffer.data(), buffer.size(), test_deadline));
+  EXPECT_EQ(buffer, kFileData.substr(1));
+
+  server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  io::TlsSessionTicketKeys ticket_keys;
+  io::TlsClientSessionCache session_cache;
+
+  const auto connect = [&] {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [&](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+              io::KernelTls::kDisabled, &ticket_keys);
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvAll(&c, 1, test_deadline));
+        },
+        std::move(server));
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(
+        std::move(client), {}, test_deadline, io::KernelTls::kDisabled,
+        &session_cache);
+    // receives the session tickets sent after the handshake
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvAll(&c, 1, test_deadline));
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+    server_task.Get();
+  };
+
+  connect();
+  EXPECT_EQ(1, ticket_keys.GetStatistics().full);
+  EXPECT_EQ(1, session_cache.GetStatistics().full);
+
+  connect();
+  EXPECT_EQ(1, ticket_keys.GetStatistics().resumed);
+  EXPECT_EQ(1, session_cache.GetStatistics().resumed);
+
+  // the tickets of the previous key are accepted and reissued
+  ticket_keys.Rotate();
+  connect();
+  EXPECT_EQ(2, ticket_keys.GetStatistics().resumed);
+
+  ticket_keys.Rotate();
+  ticket_keys.Rotate();
+  connect();
+  EXPECT_EQ(2, ticket_keys.GetStatistics().full);
+  EXPECT_EQ(2, session_cache.GetStatistics().full);
+
+  session_cache.Clear();
+  connect();
+  EXPECT_EQ(3, ticket_keys.GetStatistics().full);
+  EXPECT_EQ(2, ticket_keys.GetStatistics().resumed);
+}
+
 USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -212,6 +213,53 @@ void generic_contention_with_payload(benchmark::State& state) {
       total_lock_unlock_count / state.range(0), benchmark::Counter::kIsRate);
 }
 
+// A critical section of a few hundred nanoseconds, which is shorter than a
+// context switch
+template <typename Mutex>
+void generic_contention_short_section(benchmark::State& state) {
+  std::atomic<bool> run{true};
+  std::atomic<std::uint64_t> lock_unlock_count{0};
+  concurrent::impl::InterferenceShield<Mutex> m;
+  const auto section_length = state.range(1);
+
+  const auto critical_section = [&] {
+    m->lock();
+    for (std::int64_t i = 0; i < section_length; ++i) {
+      benchmark::DoNotOptimize(i);
+    }
+    m->unlock();
+  };
+
+  PoolFor<Mutex> pool(state.range(0) - 1, [&]() {
+    std::uint64_t local_lock_unlock_count = 0;
+
+    while (run) {
+      critical_section();
+      ++local_lock_unlock_count;
+    }
+
+    lock_unlock_count += local_lock_unlock_count;
+  });
+
+  std::uint64_t local_lock_unlock_count = 0;
+
+  for (auto _ : state) {
+    critical_section();
+    ++local_lock_unlock_count;
+  }
+
+  lock_unlock_count += local_lock_unlock_count;
+
+  run = false;
+  pool.Wait();
+  const auto total_lock_unlock_count =
+      static_cast<double>(lock_unlock_count.load());
+  state.counters["locks"] =
+      benchmark::Counter(total_lock_unlock_count, benchmark::Counter::kIsRate);
+  state.counters["locks-per-thread"] = benchmark::Counter(
+      total_lock_unlock_count / state.range(0), benchmark::Counter::kIsRate);
+}
+
 //////// Benchmarks
 
 // Note: We intentionally do not run std::* benchmarks from RunStandalone to
@@ -276,6 +324,16 @@ void single_waiting_task_mutex_contention_with_payload(
   });
 }
 
+void mutex_coro_contention_short_section(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    generic_contention_short_section<engine::Mutex>(state);
+  });
+}
+
+void mutex_std_contention_short_section(benchmark::State& state) {
+  generic_contention_short_section<std::mutex>(state);
+}
+
 }  // namespace
 
 BENCHMARK(mutex_coro_lock);
@@ -294,4 +352,9 @@ BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention_with_payload)->Range(1, 2);
 
+BENCHMARK(mutex_coro_contention_short_section)
+    ->ArgsProduct({{2, 4, 8}, {50, 200, 1000}});
+BENCHMARK(mutex_std_contention_short_section)
+    ->ArgsProduct({{2, 4, 8}, {50, 200, 1000}});
+
 USERVER_NAMESPACE_END
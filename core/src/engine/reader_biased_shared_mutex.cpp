@@ -0,0 +1,154 @@
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+
+#include <mutex>
+
+#include <compiler/tls.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+std::size_t AcquireReaderSlotIndex() noexcept {
+  static std::atomic<std::size_t> next_index{0};
+  return next_index.fetch_add(1, std::memory_order_relaxed);
+}
+
+thread_local const std::size_t kThreadReaderSlotIndex =
+    AcquireReaderSlotIndex();
+
+// A coroutine may migrate to another thread between the calls, so the index
+// must not be cached across the context switches.
+USERVER_PREVENT_TLS_CACHING std::size_t GetThreadReaderSlotIndex() noexcept {
+  return kThreadReaderSlotIndex;
+}
+
+}  // namespace
+
+ReaderBiasedSharedMutex::ReaderBiasedSharedMutex() = default;
+
+ReaderBiasedSharedMutex::~ReaderBiasedSharedMutex() {
+  UASSERT_MSG(CountReaders() == 0 && !has_writer_,
+              "ReaderBiasedSharedMutex is destroyed while in use");
+}
+
+void ReaderBiasedSharedMutex::lock() { try_lock_until(Deadline{}); }
+
+void ReaderBiasedSharedMutex::unlock() {
+  RevokeWriter();
+  writer_mutex_.unlock();
+}
+
+bool ReaderBiasedSharedMutex::try_lock() {
+  if (!writer_mutex_.try_lock()) return false;
+
+  // Pairs with the seq_cst increment of the readers: either the reader sees
+  // the writer or the writer sees the reader.
+  has_writer_.store(true, std::memory_order_seq_cst);
+  if (CountReaders() == 0) return true;
+
+  RevokeWriter();
+  writer_mutex_.unlock();
+  return false;
+}
+
+bool ReaderBiasedSharedMutex::try_lock_until(Deadline deadline) {
+  if (!writer_mutex_.try_lock_until(deadline)) return false;
+
+  has_writer_.store(true, std::memory_order_seq_cst);
+
+  bool is_drained = false;
+  {
+    const TaskCancellationBlocker block_cancels;
+    std::unique_lock lock(state_mutex_);
+    is_drained = writer_cv_.WaitUntil(lock, deadline,
+                                      [this] { return CountReaders() == 0; });
+  }
+
+  if (!is_drained) {
+    RevokeWriter();
+    writer_mutex_.unlock();
+  }
+  return is_drained;
+}
+
+void ReaderBiasedSharedMutex::lock_shared() {
+  try_lock_shared_until(Deadline{});
+}
+
+void ReaderBiasedSharedMutex::unlock_shared() {
+  GetReaderSlot().fetch_sub(1, std::memory_order_seq_cst);
+  if (has_writer_.load(std::memory_order_seq_cst)) NotifyWriter();
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared() {
+  return TryLockSharedFastPath();
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared_until(Deadline deadline) {
+  while (!TryLockSharedFastPath()) {
+    if (!WaitForNoWriter(deadline)) return false;
+  }
+  return true;
+}
+
+std::atomic<std::int64_t>&
+ReaderBiasedSharedMutex::GetReaderSlot() noexcept {
+  return reader_slots_[GetThreadReaderSlotIndex() % kReaderSlotCount].count;
+}
+
+std::int64_t ReaderBiasedSharedMutex::CountReaders() const noexcept {
+  std::int64_t count = 0;
+  for (const auto& slot : reader_slots_) {
+    count += slot.count.load(std::memory_order_seq_cst);
+  }
+  return count;
+}
+
+bool ReaderBiasedSharedMutex::TryLockSharedFastPath() {
+  if (has_writer_.load(std::memory_order_relaxed)) return false;
+
+  // No context switches until the slot is released, so it is the same slot.
+  auto& slot = GetReaderSlot();
+  slot.fetch_add(1, std::memory_order_seq_cst);
+  if (!has_writer_.load(std::memory_order_seq_cst)) return true;
+
+  slot.fetch_sub(1, std::memory_order_seq_cst);
+  // the writer may have seen the increment and is waiting for the readers
+  NotifyWriter();
+  return false;
+}
+
+void ReaderBiasedSharedMutex::NotifyWriter() {
+  {
+    // prevents the writer from missing the notification between its check
+    // and going to sleep
+    const TaskCancellationBlocker block_cancels;
+    std::lock_guard lock(state_mutex_);
+  }
+  writer_cv_.NotifyAll();
+}
+
+bool ReaderBiasedSharedMutex::WaitForNoWriter(Deadline deadline) {
+  const TaskCancellationBlocker block_cancels;
+  std::unique_lock lock(state_mutex_);
+  return readers_cv_.WaitUntil(lock, deadline, [this] {
+    return !has_writer_.load(std::memory_order_seq_cst);
+  });
+}
+
+void ReaderBiasedSharedMutex::RevokeWriter() {
+  {
+    const TaskCancellationBlocker block_cancels;
+    std::lock_guard lock(state_mutex_);
+    has_writer_.store(false, std::memory_order_seq_cst);
+  }
+  readers_cv_.NotifyAll();
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,118 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+UTEST(ReaderBiasedSharedMutex, LockUnlock) {
+  engine::ReaderBiasedSharedMutex mutex;
+  mutex.lock_shared();
+  mutex.lock_shared();
+  EXPECT_FALSE(mutex.try_lock());
+  mutex.unlock_shared();
+  mutex.unlock_shared();
+
+  mutex.lock();
+  EXPECT_FALSE(mutex.try_lock_shared());
+  mutex.unlock();
+
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+  EXPECT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+}
+
+UTEST(ReaderBiasedSharedMutex, WriterWaitsForReaders) {
+  engine::ReaderBiasedSharedMutex mutex;
+  std::shared_lock reader_lock(mutex);
+
+  auto writer = engine::AsyncNoSpan([&] { std::unique_lock lock(mutex); });
+  writer.WaitFor(50ms);
+  EXPECT_FALSE(writer.IsFinished());
+
+  reader_lock.unlock();
+  writer.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(writer.IsFinished());
+  UEXPECT_NO_THROW(writer.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, ReadersWaitForWriter) {
+  engine::ReaderBiasedSharedMutex mutex;
+  std::unique_lock writer_lock(mutex);
+
+  auto reader = engine::AsyncNoSpan([&] { std::shared_lock lock(mutex); });
+  reader.WaitFor(50ms);
+  EXPECT_FALSE(reader.IsFinished());
+
+  writer_lock.unlock();
+  reader.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(reader.IsFinished());
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, Timeouts) {
+  engine::ReaderBiasedSharedMutex mutex;
+  {
+    std::shared_lock reader_lock(mutex);
+    auto writer =
+        engine::AsyncNoSpan([&] { return mutex.try_lock_for(10ms); });
+    EXPECT_FALSE(writer.Get());
+  }
+  {
+    std::unique_lock writer_lock(mutex);
+    auto reader =
+        engine::AsyncNoSpan([&] { return mutex.try_lock_shared_for(10ms); });
+    EXPECT_FALSE(reader.Get());
+  }
+
+  // a failed writer does not block the readers
+  EXPECT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+}
+
+UTEST_MT(ReaderBiasedSharedMutex, Stress, 4) {
+  engine::ReaderBiasedSharedMutex mutex;
+  std::atomic<bool> is_running{true};
+  std::atomic<int> readers{0};
+  std::atomic<int> writers{0};
+  std::atomic<bool> is_broken{false};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 8; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, is_writer = (i % 4 == 0)] {
+      while (is_running) {
+        if (is_writer) {
+          std::unique_lock lock(mutex);
+          if (writers++ != 0 || readers != 0) is_broken = true;
+          engine::Yield();
+          --writers;
+        } else {
+          std::shared_lock lock(mutex);
+          ++readers;
+          if (writers != 0) is_broken = true;
+          // may resume on another thread
+          engine::Yield();
+          --readers;
+        }
+      }
+    }));
+  }
+
+  engine::SleepFor(100ms);
+  is_running = false;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_FALSE(is_broken);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,287 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <utils/gbench_latency.hpp>
+
+// Macro benchmarks of the scheduler: each one models a load pattern of a real
+// service rather than a single primitive. All of them run for the worker
+// counts of 1 to 8 with each of the task queue types, and report the
+// throughput and the latency percentiles in microseconds.
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+using namespace utils::gbench;
+
+void SpinFor(std::chrono::microseconds duration) {
+  const auto until = Clock::now() + duration;
+  while (Clock::now() < until) {
+    // busy wait to model a CPU-bound step
+  }
+}
+
+// Runs the payload in a task processor of state.range(0) workers with the
+// state.range(1) task queue type
+void RunScheduler(benchmark::State& state, std::function<void()> payload,
+                  const engine::TaskProcessorPoolsConfig& pools_config = {}) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = state.range(0);
+  config.thread_name = "sched-bench";
+  config.task_processor_queue =
+      static_cast<engine::TaskQueueType>(state.range(1));
+  state.SetLabel(std::string{ToString(config.task_processor_queue)});
+
+  auto pools = engine::impl::MakeTaskProcessorPools(pools_config);
+  engine::impl::TaskProcessorHolder task_processor{
+      std::make_unique<engine::TaskProcessor>(std::move(config),
+                                              std::move(pools))};
+  engine::impl::RunOnTaskProcessorSync(*task_processor, std::move(payload));
+}
+
+const std::vector<std::int64_t> kWorkerCounts{1, 2, 4, 8};
+
+const std::vector<std::int64_t> kQueueTypes{
+    static_cast<std::int64_t>(engine::TaskQueueType::kGlobalTaskQueue),
+    static_cast<std::int64_t>(engine::TaskQueueType::kWorkStealingTaskQueue),
+    static_cast<std::int64_t>(engine::TaskQueueType::kPriorityTaskQueue),
+};
+
+template <typename Benchmark>
+void SchedulerArgs(Benchmark* benchmark) {
+  benchmark->ArgsProduct({kWorkerCounts, kQueueTypes})
+      ->ArgNames({"workers", "queue"})
+      ->UseRealTime();
+}
+
+}  // namespace
+
+// A request that calls 16 backends, each of them calling 16 more
+constexpr std::size_t kFanOut = 16;
+
+void engine_scheduler_fan_out_fan_in(benchmark::State& state) {
+  RunScheduler(state, [&] {
+    LatencyPercentile latency;
+    std::vector<engine::TaskWithResult<std::size_t>> children;
+    children.reserve(kFanOut);
+
+    for (auto _ : state) {
+      const auto start = Clock::now();
+      for (std::size_t i = 0; i < kFanOut; ++i) {
+        children.push_back(engine::AsyncNoSpan([] {
+          std::vector<engine::TaskWithResult<std::size_t>> leaves;
+          leaves.reserve(kFanOut);
+          for (std::size_t j = 0; j < kFanOut; ++j) {
+            leaves.push_back(engine::AsyncNoSpan([j] { return j; }));
+          }
+          std::size_t sum = 0;
+          for (auto& leaf : leaves) sum += leaf.Get();
+          return sum;
+        }));
+      }
+
+      std::size_t sum = 0;
+      for (auto& child : children) sum += child.Get();
+      benchmark::DoNotOptimize(sum);
+      children.clear();
+      Account(latency, Clock::now() - start);
+    }
+
+    const auto tasks_per_iteration = kFanOut * (kFanOut + 1);
+    ReportRate(state, "tasks",
+               static_cast<double>(state.iterations() * tasks_per_iteration));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(engine_scheduler_fan_out_fan_in)->Apply(SchedulerArgs);
+
+// A token passed through a chain of 64 tasks, each waking up the next one
+void engine_scheduler_ping_pong_chain(benchmark::State& state) {
+  constexpr std::size_t kChainLength = 64;
+
+  RunScheduler(state, [&] {
+    LatencyPercentile latency;
+    // the last event is waited for by the benchmark itself
+    std::vector<engine::SingleConsumerEvent> events(kChainLength + 1);
+    std::vector<engine::TaskWithResult<void>> chain;
+    chain.reserve(kChainLength);
+    for (std::size_t i = 0; i < kChainLength; ++i) {
+      chain.push_back(engine::AsyncNoSpan([&events, i] {
+        while (events[i].WaitForEvent()) events[i + 1].Send();
+      }));
+    }
+
+    for (auto _ : state) {
+      const auto start = Clock::now();
+      events.front().Send();
+      [[maybe_unused]] const bool passed = events.back().WaitForEvent();
+      Account(latency, Clock::now() - start);
+    }
+
+    for (auto& task : chain) task.SyncCancel();
+    ReportRate(state, "hops",
+               static_cast<double>(state.iterations() * kChainLength));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(engine_scheduler_ping_pong_chain)->Apply(SchedulerArgs);
+
+namespace {
+
+// Each sleeping coroutine takes two memory mappings, the stack and its guard
+// page, so that many tasks do not fit into the default vm.max_map_count
+bool HasEnoughMemoryMappings(std::size_t coroutines) {
+  std::ifstream max_map_count_file{"/proc/sys/vm/max_map_count"};
+  std::size_t max_map_count = 0;
+  if (!(max_map_count_file >> max_map_count)) return true;
+  return max_map_count > coroutines * 2 + 10'000;
+}
+
+}  // namespace
+
+// Lots of idle connections or periodic tasks. Each task sleeps for 10-20ms in
+// a loop, the latency is how late the timers wake the tasks up.
+void engine_scheduler_sleeping_tasks(benchmark::State& state) {
+  const auto tasks_count = static_cast<std::size_t>(state.range(2));
+  if (!HasEnoughMemoryMappings(tasks_count)) {
+    state.SkipWithError("Raise vm.max_map_count to run this benchmark");
+    return;
+  }
+
+  engine::TaskProcessorPoolsConfig pools_config;
+  pools_config.max_coro_pool_size = tasks_count + 100;
+  pools_config.coro_stack_size = 64 * 1024;
+
+  RunScheduler(
+      state,
+      [&] {
+        LatencyPercentile lateness;
+        std::atomic<std::uint64_t> wakeups{0};
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(tasks_count);
+        for (std::size_t i = 0; i < tasks_count; ++i) {
+          const std::chrono::microseconds period{10'000 + i * 7919 % 10'000};
+          tasks.push_back(engine::AsyncNoSpan([&lateness, &wakeups, period] {
+            while (!engine::current_task::ShouldCancel()) {
+              const auto deadline = Clock::now() + period;
+              engine::InterruptibleSleepUntil(
+                  engine::Deadline::FromTimePoint(deadline));
+              if (engine::current_task::ShouldCancel()) break;
+              Account(lateness, Clock::now() - deadline);
+              wakeups.fetch_add(1, std::memory_order_relaxed);
+            }
+          }));
+        }
+
+        for (auto _ : state) {
+          engine::SleepFor(std::chrono::milliseconds{10});
+        }
+
+        for (auto& task : tasks) task.RequestCancel();
+        tasks.clear();
+        ReportRate(state, "wakeups", static_cast<double>(wakeups.load()));
+        ReportLatency(state, lateness);
+      },
+      pools_config);
+}
+BENCHMARK(engine_scheduler_sleeping_tasks)
+    ->ArgsProduct({kWorkerCounts, kQueueTypes, {10'000, 100'000}})
+    ->ArgNames({"workers", "queue", "tasks"})
+    ->UseRealTime();
+
+// Short IO-bound requests, a 100us wait and 10us of CPU each, served while
+// the CPU-bound background tasks keep all the workers busy
+void engine_scheduler_mixed_cpu_io(benchmark::State& state) {
+  constexpr std::size_t kRequestsPerIteration = 64;
+
+  RunScheduler(state, [&] {
+    LatencyPercentile latency;
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> background;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      background.push_back(engine::AsyncNoSpan([&keep_running] {
+        while (keep_running) {
+          SpinFor(std::chrono::microseconds{200});
+          engine::Yield();
+        }
+      }));
+    }
+
+    std::vector<engine::TaskWithResult<void>> requests;
+    requests.reserve(kRequestsPerIteration);
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kRequestsPerIteration; ++i) {
+        const auto start = Clock::now();
+        requests.push_back(engine::AsyncNoSpan([&latency, start] {
+          engine::SleepFor(std::chrono::microseconds{100});
+          SpinFor(std::chrono::microseconds{10});
+          Account(latency, Clock::now() - start);
+        }));
+      }
+      for (auto& request : requests) request.Get();
+      requests.clear();
+    }
+
+    keep_running = false;
+    for (auto& task : background) task.Get();
+    ReportRate(state, "requests",
+               static_cast<double>(state.iterations() * kRequestsPerIteration));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(engine_scheduler_mixed_cpu_io)->Apply(SchedulerArgs);
+
+// Wakeups of a task from a foreign thread, e.g. from a driver callback
+void engine_scheduler_cross_thread_wakeup(benchmark::State& state) {
+  RunScheduler(state, [&] {
+    LatencyPercentile latency;
+    engine::SingleConsumerEvent event;
+    std::atomic<bool> keep_running{true};
+    std::atomic<bool> wakeup_requested{false};
+    std::atomic<Clock::time_point> sent_at{};
+
+    std::thread waker{[&] {
+      while (keep_running) {
+        if (!wakeup_requested.exchange(false)) {
+          std::this_thread::yield();
+          continue;
+        }
+        sent_at = Clock::now();
+        event.Send();
+      }
+    }};
+
+    for (auto _ : state) {
+      wakeup_requested = true;
+      [[maybe_unused]] const bool woken = event.WaitForEvent();
+      Account(latency, Clock::now() - sent_at.load());
+    }
+
+    keep_running = false;
+    waker.join();
+    ReportRate(state, "wakeups", static_cast<double>(state.iterations()));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(engine_scheduler_cross_thread_wakeup)->Apply(SchedulerArgs);
+
+USERVER_NAMESPACE_END
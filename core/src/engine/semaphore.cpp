@@ -5,6 +5,7 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/task/task_context.hpp>
 
@@ -122,7 +123,8 @@ bool Semaphore::try_lock_shared_until(Deadline deadline) {
 bool Semaphore::try_lock_shared_until_count(Deadline deadline,
                                             const Counter count) {
   LOG_TRACE() << "try_lock_shared_until_count()";
-  const auto status = LockFastPath(count);
+  auto status = LockFastPath(count);
+  if (status == TryLockStatus::kTransientFailure) status = LockSpinPath(count);
   if (status == TryLockStatus::kSuccess) return true;
   if (status == TryLockStatus::kPermanentFailure) return false;
   return LockSlowPath(deadline, count);
@@ -155,6 +157,16 @@ Semaphore::TryLockStatus Semaphore::LockFastPath(const Counter count) {
   return status;
 }
 
+Semaphore::TryLockStatus Semaphore::LockSpinPath(const Counter count) {
+  auto status = TryLockStatus::kTransientFailure;
+  impl::SpinBeforeSleep(
+      spin_estimate_, current_task::GetCurrentTaskContext(), [&] {
+        status = DoTryLock(count);
+        return status != TryLockStatus::kTransientFailure;
+      });
+  return status;
+}
+
 bool Semaphore::LockSlowPath(Deadline deadline, const Counter count) {
   UASSERT(count > 0);
   LOG_TRACE() << "trying slow path";
@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <atomic>
+#include <cstdint>
 #include <thread>
 
 #include <userver/engine/async.hpp>
@@ -117,6 +118,36 @@ BENCHMARK(semaphore_lock_unlock_payload_contention)
     ->RangeMultiplier(2)
     ->Range(1, 32);
 
+// A critical section of a few hundred nanoseconds, which is shorter than a
+// context switch
+void semaphore_short_section_contention(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&]() {
+    std::atomic<bool> run{true};
+    engine::Semaphore sem{1};
+    const auto section_length = state.range(1);
+
+    const auto critical_section = [&] {
+      sem.lock_shared();
+      for (std::int64_t i = 0; i < section_length; ++i) {
+        benchmark::DoNotOptimize(i);
+      }
+      sem.unlock_shared();
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 1; i++)
+      tasks.push_back(engine::AsyncNoSpan([&]() {
+        while (run) critical_section();
+      }));
+
+    for (auto _ : state) critical_section();
+
+    run = false;
+  });
+}
+BENCHMARK(semaphore_short_section_contention)
+    ->ArgsProduct({{2, 4, 8}, {50, 200, 1000}});
+
 void semaphore_lock_unlock_coro_contention(benchmark::State& state) {
   engine::RunStandalone(4, [&]() {
     std::atomic<bool> run{true};
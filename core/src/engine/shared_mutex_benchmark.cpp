@@ -1,18 +1,26 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/shared_mutex.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-void shared_mutex_benchmark(benchmark::State& state) {
+namespace {
+
+template <typename SharedMutex>
+void generic_shared_mutex_benchmark(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     int variable = 0;
-    engine::SharedMutex mutex;
+    SharedMutex mutex;
     std::atomic<bool> is_running(true);
 
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -43,6 +51,71 @@ void shared_mutex_benchmark(benchmark::State& state) {
     }
   });
 }
+// Only readers, one per worker thread. The throughput of
+// engine::ReaderBiasedSharedMutex should scale linearly with worker threads.
+template <typename SharedMutex>
+void generic_shared_mutex_readers(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    int variable = 0;
+    SharedMutex mutex;
+    std::atomic<bool> is_running(true);
+    std::atomic<std::uint64_t> lock_count{0};
+
+    const auto read = [&] {
+      std::shared_lock lock(mutex);
+      benchmark::DoNotOptimize(variable);
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        std::uint64_t local_lock_count = 0;
+        while (is_running) {
+          read();
+          ++local_lock_count;
+        }
+        lock_count += local_lock_count;
+      }));
+    }
+
+    std::uint64_t local_lock_count = 0;
+    for (auto _ : state) {
+      read();
+      ++local_lock_count;
+    }
+    lock_count += local_lock_count;
+
+    is_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+
+    state.counters["locks"] = benchmark::Counter(
+        static_cast<double>(lock_count.load()), benchmark::Counter::kIsRate);
+  });
+}
+
+}  // namespace
+
+void shared_mutex_benchmark(benchmark::State& state) {
+  generic_shared_mutex_benchmark<engine::SharedMutex>(state);
+}
 BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
 
+void reader_biased_shared_mutex_benchmark(benchmark::State& state) {
+  generic_shared_mutex_benchmark<engine::ReaderBiasedSharedMutex>(state);
+}
+BENCHMARK(reader_biased_shared_mutex_benchmark)->DenseRange(1, 6);
+
+void shared_mutex_readers(benchmark::State& state) {
+  generic_shared_mutex_readers<engine::SharedMutex>(state);
+}
+BENCHMARK(shared_mutex_readers)->RangeMultiplier(2)->Range(1, 16);
+
+void reader_biased_shared_mutex_readers(benchmark::State& state) {
+  generic_shared_mutex_readers<engine::ReaderBiasedSharedMutex>(state);
+}
+BENCHMARK(reader_biased_shared_mutex_readers)->RangeMultiplier(2)->Range(1, 16);
+
 USERVER_NAMESPACE_END
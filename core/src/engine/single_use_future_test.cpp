@@ -0,0 +1,107 @@
+#include <userver/engine/single_use_future.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(SingleUseFuture, Unused) { engine::SingleUseFuture<int> future; }
+
+UTEST(SingleUseFuture, Sample) {
+  /// [Sample engine::SingleUseFuture usage]
+  engine::SingleUseFuture<std::string> future;
+  auto responder = utils::Async(
+      "responder", [promise = future.get_promise()]() mutable {
+        promise.set_value("response");
+      });
+
+  // no allocation for the pair, the state lives in 'future'
+  EXPECT_EQ(future.get(), "response");
+  /// [Sample engine::SingleUseFuture usage]
+  responder.Get();
+}
+
+UTEST(SingleUseFuture, GetBeforeSet) {
+  engine::SingleUseFuture<int> future;
+  auto promise = future.get_promise();
+  auto task = utils::Async("getter", [&future] { return future.get(); });
+
+  engine::Yield();
+  EXPECT_FALSE(task.IsFinished());
+
+  promise.set_value(42);
+  EXPECT_EQ(task.Get(), 42);
+}
+
+UTEST(SingleUseFuture, Void) {
+  engine::SingleUseFuture<void> future;
+  auto promise = future.get_promise();
+  promise.set_value();
+  UEXPECT_NO_THROW(future.get());
+}
+
+UTEST(SingleUseFuture, MoveOnlyValue) {
+  engine::SingleUseFuture<std::unique_ptr<int>> future;
+  auto promise = future.get_promise();
+  promise.set_value(std::make_unique<int>(42));
+  EXPECT_EQ(*future.get(), 42);
+}
+
+UTEST(SingleUseFuture, Exception) {
+  engine::SingleUseFuture<int> future;
+  auto promise = future.get_promise();
+  promise.set_exception(std::make_exception_ptr(std::runtime_error("test")));
+  UEXPECT_THROW(future.get(), std::runtime_error);
+}
+
+UTEST(SingleUseFuture, BrokenPromise) {
+  engine::SingleUseFuture<int> future;
+  utils::Async("breaker", [promise = future.get_promise()] {}).Get();
+  UEXPECT_THROW(future.get(), std::future_error);
+}
+
+UTEST(SingleUseFuture, MisuseThrows) {
+  engine::SingleUseFuture<int> future;
+  UEXPECT_THROW(future.get(), std::future_error);
+
+  auto promise = future.get_promise();
+  UEXPECT_THROW(future.get_promise().set_value(0), std::future_error);
+
+  promise.set_value(1);
+  UEXPECT_THROW(promise.set_value(2), std::future_error);
+  EXPECT_EQ(future.get(), 1);
+  UEXPECT_THROW(future.get(), std::future_error);
+}
+
+UTEST(SingleUseFuture, DestructorWaitsForPromise) {
+  engine::TaskWithResult<void> setter;
+  {
+    engine::SingleUseFuture<int> future;
+    setter =
+        utils::Async("setter", [promise = future.get_promise()]() mutable {
+          engine::SleepFor(std::chrono::milliseconds{10});
+          promise.set_value(1);
+        });
+    // 'future' is destroyed without get(), after 'set_value' is done with it
+  }
+  setter.Get();
+}
+
+UTEST(SingleUseFuture, PromiseMoveAssignmentBreaksPrevious) {
+  engine::SingleUseFuture<int> first;
+  engine::SingleUseFuture<int> second;
+  auto promise = first.get_promise();
+  promise = second.get_promise();
+  UEXPECT_THROW(first.get(), std::future_error);
+
+  promise.set_value(2);
+  EXPECT_EQ(second.get(), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -35,6 +35,11 @@ void SleepUntil(Deadline deadline) {
 
 void Yield() { SleepUntil(Deadline::Passed()); }
 
+void YieldIfTimeSliceExceeded() {
+  auto* current = current_task::GetCurrentTaskContextUnchecked();
+  if (current && current->IsTimeSliceExceeded()) Yield();
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
@@ -33,17 +33,19 @@ void run_in_ev_loop_benchmark(benchmark::State& state) {
 }
 BENCHMARK(run_in_ev_loop_benchmark);
 
+// Timeouts of 10ms and more use the timer wheel of the ev thread
 [[maybe_unused]] void successful_wait_for_benchmark(benchmark::State& state) {
   engine::RunStandalone([&] {
+    const std::chrono::milliseconds timeout{state.range(0)};
     for (auto _ : state) {
       auto task = engine::AsyncNoSpan([] { engine::Yield(); });
-      task.WaitFor(20ms);
+      task.WaitFor(timeout);
 
       if (!task.IsFinished()) abort();
     }
   });
 }
-BENCHMARK(successful_wait_for_benchmark);
+BENCHMARK(successful_wait_for_benchmark)->Arg(1)->Arg(20)->Arg(20'000);
 
 void unreached_task_deadline_benchmark(benchmark::State& state,
                                        bool has_task_deadline) {
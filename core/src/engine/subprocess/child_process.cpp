@@ -27,6 +27,12 @@ ChildProcessStatus ChildProcess::Get() { return impl_->Get(); }
 
 void ChildProcess::SendSignal(int signum) { return impl_->SendSignal(signum); }
 
+io::PipeWriter& ChildProcess::GetStdin() { return impl_->GetStdin(); }
+
+io::PipeReader& ChildProcess::GetStdout() { return impl_->GetStdout(); }
+
+io::PipeReader& ChildProcess::GetStderr() { return impl_->GetStderr(); }
+
 }  // namespace engine::subprocess
 
 USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <csignal>
 
 #include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,6 +36,23 @@ void ChildProcessImpl::SendSignal(int signum) {
   utils::CheckSyscall(kill(pid_, signum), "kill, pid={}", pid_);
 }
 
+io::PipeWriter& ChildProcessImpl::GetStdin() {
+  UINVARIANT(pipes_.stdin_pipe, "The stdin of the child process is not piped");
+  return pipes_.stdin_pipe->writer;
+}
+
+io::PipeReader& ChildProcessImpl::GetStdout() {
+  UINVARIANT(pipes_.stdout_pipe,
+             "The stdout of the child process is not piped");
+  return pipes_.stdout_pipe->reader;
+}
+
+io::PipeReader& ChildProcessImpl::GetStderr() {
+  UINVARIANT(pipes_.stderr_pipe,
+             "The stderr of the child process is not piped");
+  return pipes_.stderr_pipe->reader;
+}
+
 }  // namespace engine::subprocess
 
 USERVER_NAMESPACE_END
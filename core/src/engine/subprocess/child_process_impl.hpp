@@ -1,15 +1,23 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/subprocess/child_process_status.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::subprocess {
 
+struct ChildProcessPipes final {
+  std::optional<io::Pipe> stdin_pipe;
+  std::optional<io::Pipe> stdout_pipe;
+  std::optional<io::Pipe> stderr_pipe;
+};
+
 class ChildProcessImpl {
  public:
   ChildProcessImpl(int pid, Future<ChildProcessStatus>&& status_future);
@@ -24,9 +32,18 @@ class ChildProcessImpl {
 
   void SendSignal(int signum);
 
+  void SetPipes(ChildProcessPipes&& pipes) { pipes_ = std::move(pipes); }
+
+  io::PipeWriter& GetStdin();
+
+  io::PipeReader& GetStdout();
+
+  io::PipeReader& GetStderr();
+
  private:
   int pid_;
   Future<ChildProcessStatus> status_future_;
+  ChildProcessPipes pipes_;
 };
 
 }  // namespace engine::subprocess
@@ -1,20 +1,21 @@
 #include <userver/engine/subprocess/process_starter.hpp>
 
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <csignal>
-#include <cstdio>
-#include <cstring>
-#include <iostream>
+#include <system_error>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <userver/engine/io/pipe.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
 #include <utils/check_syscall.hpp>
 
 #include <engine/ev/child_process_map.hpp>
@@ -31,20 +32,76 @@ USERVER_NAMESPACE_BEGIN
 namespace engine::subprocess {
 namespace {
 
-void DoExecve(const std::string& command, const std::vector<std::string>& args,
-              const EnvironmentVariables& env,
-              const std::optional<std::string>& stdout_file,
-              const std::optional<std::string>& stderr_file) {
-  if (stdout_file) {
-    if (!std::freopen(stdout_file->c_str(), "a", stdout)) {
-      utils::CheckSyscall(-1, "freopen stdout to {}", *stdout_file);
-    }
+void CheckSpawnCall(int error, std::string_view action) {
+  // posix_spawn* functions return the error instead of setting errno
+  if (error != 0) {
+    throw std::system_error(std::error_code(error, std::system_category()),
+                            fmt::format("Error while {}", action));
   }
-  if (stderr_file) {
-    if (!std::freopen(stderr_file->c_str(), "a", stderr)) {
-      utils::CheckSyscall(-1, "freopen stderr to {}", *stdout_file);
-    }
+}
+
+class SpawnFileActions final {
+ public:
+  SpawnFileActions() {
+    CheckSpawnCall(posix_spawn_file_actions_init(&actions_),
+                   "posix_spawn_file_actions_init");
+  }
+
+  SpawnFileActions(SpawnFileActions&&) = delete;
+  SpawnFileActions& operator=(SpawnFileActions&&) = delete;
+
+  ~SpawnFileActions() { posix_spawn_file_actions_destroy(&actions_); }
+
+  void AddDup(int fd, int target_fd) {
+    CheckSpawnCall(posix_spawn_file_actions_adddup2(&actions_, fd, target_fd),
+                   "posix_spawn_file_actions_adddup2");
+  }
+
+  void AddAppend(int target_fd, const std::string& path) {
+    CheckSpawnCall(
+        posix_spawn_file_actions_addopen(&actions_, target_fd, path.c_str(),
+                                         O_WRONLY | O_CREAT | O_APPEND, 0666),
+        "posix_spawn_file_actions_addopen");
   }
+
+  const posix_spawn_file_actions_t* Get() const { return &actions_; }
+
+ private:
+  posix_spawn_file_actions_t actions_{};
+};
+
+// The children do not expect their standard streams to be non-blocking
+void SetBlocking(int fd) {
+  const auto flags =
+      utils::CheckSyscall(::fcntl(fd, F_GETFL), "fcntl F_GETFL, fd={}", fd);
+  utils::CheckSyscall(::fcntl(fd, F_SETFL, flags & ~O_NONBLOCK),
+                      "fcntl F_SETFL, fd={}", fd);
+}
+
+void AddOutput(SpawnFileActions& actions, std::optional<io::Pipe>& pipe,
+               bool is_piped, const std::optional<std::string>& file,
+               int target_fd) {
+  UINVARIANT(!is_piped || !file,
+             "A standard stream of a child process must not be both piped "
+             "and redirected to a file");
+  if (is_piped) {
+    pipe.emplace();
+    SetBlocking(pipe->writer.Fd());
+    actions.AddDup(pipe->writer.Fd(), target_fd);
+  } else if (file) {
+    actions.AddAppend(target_fd, *file);
+  }
+}
+
+EnvironmentVariables MakeEnvironment(ExecOptions& options) {
+  auto env = options.env ? std::move(*options.env)
+                         : GetCurrentEnvironmentVariables();
+  if (options.env_update) env.UpdateWith(std::move(*options.env_update));
+  return env;
+}
+
+int DoSpawn(const std::string& command, const std::vector<std::string>& args,
+            const EnvironmentVariables& env, const SpawnFileActions& actions) {
   std::vector<char*> argv_ptrs;
   std::vector<std::string> envp_buf;
   std::vector<char*> envp_ptrs;
@@ -67,8 +124,13 @@ void DoExecve(const std::string& command, const std::vector<std::string>& args,
   }
   envp_ptrs.push_back(nullptr);
 
-  utils::CheckSyscall(
-      execve(command.c_str(), argv_ptrs.data(), envp_ptrs.data()), "execve");
+  // Unlike fork(), posix_spawn() does not copy the page tables of the parent
+  // process, so it does not slow down with the memory usage
+  pid_t pid = 0;
+  CheckSpawnCall(posix_spawn(&pid, command.c_str(), actions.Get(), nullptr,
+                             argv_ptrs.data(), envp_ptrs.data()),
+                 "posix_spawn " + command);
+  return pid;
 }
 
 }  // namespace
@@ -77,17 +139,32 @@ ProcessStarter::ProcessStarter(TaskProcessor& task_processor)
     : thread_control_(
           task_processor.EventThreadPool().GetEvDefaultLoopThread()) {}
 
-ChildProcess ProcessStarter::Exec(
-    const std::string& command, const std::vector<std::string>& args,
-    const EnvironmentVariables& env,
-    const std::optional<std::string>& stdout_file,
-    const std::optional<std::string>& stderr_file) {
+ChildProcess ProcessStarter::Exec(const std::string& command,
+                                  const std::vector<std::string>& args,
+                                  ExecOptions&& options) {
   tracing::Span span("ProcessStarter::Exec");
   span.AddTag("command", command);
-  Promise<ChildProcess> promise;
+
+  const auto env = MakeEnvironment(options);
+
+  ChildProcessPipes pipes;
+  SpawnFileActions actions;
+  if (options.pipes & StdStream::kStdin) {
+    pipes.stdin_pipe.emplace();
+    SetBlocking(pipes.stdin_pipe->reader.Fd());
+    actions.AddDup(pipes.stdin_pipe->reader.Fd(), STDIN_FILENO);
+  }
+  AddOutput(actions, pipes.stdout_pipe,
+            static_cast<bool>(options.pipes & StdStream::kStdout),
+            options.stdout_file, STDOUT_FILENO);
+  AddOutput(actions, pipes.stderr_pipe,
+            static_cast<bool>(options.pipes & StdStream::kStderr),
+            options.stderr_file, STDERR_FILENO);
+
+  Promise<ChildProcessImpl> promise;
   auto future = promise.get_future();
   thread_control_.RunInEvLoopAsync([&, promise = std::move(promise)]() mutable {
-    LOG_DEBUG() << "do fork() + execve(), command=" << command << ", args=["
+    LOG_DEBUG() << "do posix_spawn(), command=" << command << ", args=["
                 << (args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'')
                 << "], env=["
                 << (env.empty()
@@ -99,42 +176,53 @@ ChildProcess ProcessStarter::Exec(
                                                 }),
                                       ", "))
                 << ']';
-    auto pid = utils::CheckSyscall(fork(), "fork");
-    if (pid) {
-      // in parent thread
-      span.AddTag("child-process-pid", pid);
-      LOG_DEBUG() << "Started child process with pid=" << pid;
-      Promise<ChildProcessStatus> exec_result_promise;
-      auto res = ChildProcessMapSet(
-          pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
-      if (res.second) {
-        promise.set_value(ChildProcess{
-            ChildProcessImpl{pid, res.first->status_promise.get_future()}});
-      } else {
-        std::string msg = "process with pid=" + std::to_string(pid) +
-                          " already exists in child_process_map";
-        LOG_ERROR() << msg << ", send SIGKILL";
-        ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
-        promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
-      }
+    int pid = 0;
+    try {
+      pid = DoSpawn(command, args, env, actions);
+    } catch (const std::exception&) {
+      promise.set_exception(std::current_exception());
+      return;
+    }
+
+    span.AddTag("child-process-pid", pid);
+    LOG_DEBUG() << "Started child process with pid=" << pid;
+    Promise<ChildProcessStatus> exec_result_promise;
+    auto res = ChildProcessMapSet(
+        pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
+    if (res.second) {
+      promise.set_value(
+          ChildProcessImpl{pid, res.first->status_promise.get_future()});
     } else {
-      // in child thread
-      try {
-        try {
-          DoExecve(command, args, env, stdout_file, stderr_file);
-        } catch (const std::exception& ex) {
-          std::cerr << "Cannot execute child: " << ex.what();
-        }
-      } catch (...) {
-        // must not do anything in a child
-      }
-      // on success execve does not return
-      std::abort();
+      std::string msg = "process with pid=" + std::to_string(pid) +
+                        " already exists in child_process_map";
+      LOG_ERROR() << msg << ", send SIGKILL";
+      ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
+      promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
     }
   });
 
   engine::TaskCancellationBlocker cancel_blocker;
-  return future.get();
+  auto impl = future.get();
+
+  // The child has its own copies of these ends
+  if (pipes.stdin_pipe) pipes.stdin_pipe->reader.Close();
+  if (pipes.stdout_pipe) pipes.stdout_pipe->writer.Close();
+  if (pipes.stderr_pipe) pipes.stderr_pipe->writer.Close();
+  impl.SetPipes(std::move(pipes));
+
+  return ChildProcess{std::move(impl)};
+}
+
+ChildProcess ProcessStarter::Exec(
+    const std::string& command, const std::vector<std::string>& args,
+    const EnvironmentVariables& env,
+    const std::optional<std::string>& stdout_file,
+    const std::optional<std::string>& stderr_file) {
+  ExecOptions options;
+  options.env = env;
+  options.stdout_file = stdout_file;
+  options.stderr_file = stderr_file;
+  return Exec(command, args, std::move(options));
 }
 
 ChildProcess ProcessStarter::Exec(
@@ -142,18 +230,21 @@ ChildProcess ProcessStarter::Exec(
     EnvironmentVariablesUpdate env_update,
     const std::optional<std::string>& stdout_file,
     const std::optional<std::string>& stderr_file) {
-  return Exec(command, args,
-              EnvironmentVariables{GetCurrentEnvironmentVariables()}.UpdateWith(
-                  std::move(env_update)),
-              stdout_file, stderr_file);
+  ExecOptions options;
+  options.env_update = std::move(env_update);
+  options.stdout_file = stdout_file;
+  options.stderr_file = stderr_file;
+  return Exec(command, args, std::move(options));
 }
 
 ChildProcess ProcessStarter::Exec(
     const std::string& command, const std::vector<std::string>& args,
     const std::optional<std::string>& stdout_file,
     const std::optional<std::string>& stderr_file) {
-  return Exec(command, args, EnvironmentVariablesUpdate{{}}, stdout_file,
-              stderr_file);
+  ExecOptions options;
+  options.stdout_file = stdout_file;
+  options.stderr_file = stderr_file;
+  return Exec(command, args, std::move(options));
 }
 
 }  // namespace engine::subprocess
@@ -3,6 +3,7 @@
 #include <sys/param.h>
 #include <unistd.h>
 
+#include <array>
 #include <chrono>
 #include <string>
 #include <thread>
@@ -19,6 +20,7 @@
 
 #include <engine/ev/thread_control.hpp>
 #include <engine/ev/thread_pool.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/subprocess/child_process.hpp>
 #include <userver/engine/subprocess/process_starter.hpp>
 #include <userver/engine/task/task.hpp>
@@ -43,6 +45,15 @@ const std::string kTestProgram = "/usr/bin/test";
 
 constexpr std::string_view kSpdlogFilePart = "spdlog_closeexec_test_";
 
+std::string ReadToEnd(engine::io::PipeReader& reader) {
+  std::string result;
+  std::array<char, 64> buffer{};
+  while (const auto size = reader.ReadSome(buffer.data(), buffer.size(), {})) {
+    result.append(buffer.data(), size);
+  }
+  return result;
+}
+
 }  // namespace
 
 UTEST(Subprocess, True) {
@@ -63,6 +74,46 @@ UTEST(Subprocess, False) {
   EXPECT_NE(0, status.GetExitCode());
 }
 
+UTEST(Subprocess, Pipes) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  engine::subprocess::ExecOptions options;
+  options.pipes = {engine::subprocess::StdStream::kStdin,
+                   engine::subprocess::StdStream::kStdout};
+  auto process = starter.Exec("/bin/cat", {}, std::move(options));
+
+  const std::string data = "some data to convert";
+  ASSERT_EQ(process.GetStdin().WriteAll(data.data(), data.size(), {}),
+            data.size());
+  process.GetStdin().Close();
+
+  EXPECT_EQ(ReadToEnd(process.GetStdout()), data);
+  const auto status = process.Get();
+  ASSERT_TRUE(status.IsExited());
+  EXPECT_EQ(0, status.GetExitCode());
+}
+
+UTEST(Subprocess, PipedStderr) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  engine::subprocess::ExecOptions options;
+  options.pipes = engine::subprocess::StdStream::kStderr;
+  auto process =
+      starter.Exec("/bin/sh", {"-c", "echo error >&2"}, std::move(options));
+
+  EXPECT_EQ(ReadToEnd(process.GetStderr()), "error\n");
+  EXPECT_EQ(0, process.Get().GetExitCode());
+}
+
+UTEST(Subprocess, NonExistentCommand) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  EXPECT_THROW(starter.Exec("/non-existent-command", {}), std::system_error);
+}
+
 UTEST(Subprocess, CheckSpdlogClosesFds) {
   auto file = fs::blocking::TempFile::Create("/tmp", kSpdlogFilePart);
   auto logger = logging::MakeFileLogger("to_file", file.GetPath(),
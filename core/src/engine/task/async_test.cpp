@@ -271,6 +271,28 @@ UTEST(Async, Emplace) {
   EXPECT_EQ(task.Get(), "xy"s);
 }
 
+UTEST(Async, Microtask) {
+  auto& sync_task = engine::current_task::GetCurrentTaskContext();
+  auto task = engine::AsyncMicrotaskNoSpan(
+      [&sync_task](int x) {
+        EXPECT_FALSE(sync_task.IsCurrent());
+        return x + 1;
+      },
+      41);
+  EXPECT_EQ(task.Get(), 42);
+
+  auto throwing_task = engine::AsyncMicrotaskNoSpan(
+      [] { throw std::runtime_error("microtask"); });
+  UEXPECT_THROW_MSG(throwing_task.Get(), std::runtime_error, "microtask");
+}
+
+UTEST(Async, MicrotaskCancelledBeforeStart) {
+  auto task = engine::AsyncMicrotaskNoSpan([] { return true; });
+  task.RequestCancel();
+  task.Wait();
+  EXPECT_EQ(task.GetState(), engine::Task::State::kCancelled);
+}
+
 // Test from https://github.com/userver-framework/userver/issues/48 by
 // https://github.com/itrofimow
 UTEST(Async, FromNonWorkerThread) {
@@ -7,12 +7,20 @@
 #include <userver/utils/assert.hpp>
 
 #include <engine/ev/data_pipe_to_ev.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
 
+namespace {
+
+// Shorter timeouts use ev timers to keep their precision
+constexpr std::chrono::milliseconds kTimerWheelMinTimeLeft{10};
+
+}  // namespace
+
 class ContextTimer::Impl final : public ev::AsyncPayloadBase {
  public:
   Impl();
@@ -37,6 +45,7 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
   void StopTimerInEvThread() noexcept;
 
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnWheelTimer(ev::TimerWheel::Entry& entry) noexcept;
   void DoOnTimer();
 
   struct Params {
@@ -48,6 +57,7 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
   std::optional<ev::ThreadControl> thread_control_;
   Params params_;
   ev_timer timer_{};
+  ev::TimerWheel::Entry wheel_entry_{&OnWheelTimer};
 
   using ParamsPipe = ev::DataPipeToEv<Params>;
   ParamsPipe params_pipe_to_ev_;
@@ -57,11 +67,13 @@ ContextTimer::Impl::Impl() : ev::AsyncPayloadBase(&Release) {
   timer_.data = this;
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   ev_init(&timer_, OnTimer);
+  wheel_entry_.data = this;
 }
 
 ContextTimer::Impl::~Impl() {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   UASSERT(!ev_is_active(&timer_));
+  UASSERT(!wheel_entry_.IsScheduled());
 }
 
 bool ContextTimer::Impl::WasStarted() const noexcept {
@@ -151,12 +163,27 @@ void ContextTimer::Impl::ArmTimerInEvThread() {
     return;
   }
 
+  // Coarse-grained timeouts go to the timer wheel, which is cheaper to arm and
+  // to cancel than a libev timer
+  auto* timer_wheel = thread_control_->GetTimerWheel();
+  if (timer_wheel && params_.deadline.IsReachable() &&
+      params_.deadline.TimeLeft() >= kTimerWheelMinTimeLeft) {
+    thread_control_->Stop(timer_);
+    timer_wheel->Schedule(wheel_entry_, std::chrono::steady_clock::now() +
+                                            params_.deadline.TimeLeft());
+    return;
+  }
+
+  if (wheel_entry_.IsScheduled()) timer_wheel->Cancel(wheel_entry_);
   timer_.repeat = time_left;
   thread_control_->Again(timer_);
 }
 
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
   thread_control_->Stop(timer_);
+  if (wheel_entry_.IsScheduled()) {
+    thread_control_->GetTimerWheel()->Cancel(wheel_entry_);
+  }
 }
 
 void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
@@ -165,6 +192,12 @@ void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
   ev_timer->DoOnTimer();
 }
 
+void ContextTimer::Impl::OnWheelTimer(ev::TimerWheel::Entry& entry) noexcept {
+  auto* ev_timer = static_cast<Impl*>(entry.data);
+  UASSERT(ev_timer != nullptr);
+  ev_timer->DoOnTimer();
+}
+
 void ContextTimer::Impl::DoOnTimer() {
   try {
     // do not keep the function object around for much longer
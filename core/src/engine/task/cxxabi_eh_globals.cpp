@@ -51,7 +51,13 @@ extern "C" __cxxabiv1::__cxa_eh_globals* __cxa_get_globals();
 namespace engine::impl {
 
 void ExchangeEhGlobals(EhGlobals& replacement) noexcept {
-  auto* current = __cxa_get_globals();
+  auto* current = reinterpret_cast<EhGlobals*>(__cxa_get_globals());
+
+  // Most of the switches happen with no exception in flight on either side
+  if (!current->caught_exceptions && !current->uncaught_exceptions &&
+      !replacement.caught_exceptions && !replacement.uncaught_exceptions) {
+    return;
+  }
 
   EhGlobals buf;
   std::memcpy(&buf, current, sizeof(EhGlobals));
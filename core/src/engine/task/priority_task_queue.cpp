@@ -0,0 +1,86 @@
+#include <engine/task/priority_task_queue.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+std::size_t ToLane(Task::Priority priority) noexcept {
+  const auto lane = static_cast<std::size_t>(priority);
+  UASSERT(lane < kTaskPrioritiesCount);
+  return lane;
+}
+
+}  // namespace
+
+void PriorityTaskQueue::Push(impl::TaskContext* context) {
+  UASSERT(context);
+  Push(context, context->GetPriority());
+}
+
+void PriorityTaskQueue::Push(impl::TaskContext* context,
+                             Task::Priority priority) {
+  lanes_[ToLane(priority)].enqueue(context);
+  size_.signal();
+}
+
+impl::TaskContext* PriorityTaskQueue::PopBlocking() {
+  // Current thread handles only a single TaskProcessor
+  thread_local std::size_t pops_count = 0;
+  thread_local std::size_t starvation_guard_pops_count = 0;
+
+  while (!size_.wait()) {
+  }
+
+  std::size_t first_lane = 0;
+  if (++pops_count % kStarvationGuardInterval == 0) {
+    // rotates over the lower lanes, so that the normal lane is not starved
+    // by the high one while the low lane is served
+    first_lane =
+        1 + starvation_guard_pops_count++ % (kTaskPrioritiesCount - 1);
+  }
+
+  impl::TaskContext* context = nullptr;
+  // the semaphore guarantees an element, but a concurrent push may not be
+  // visible to try_dequeue yet
+  while (!TryPop(first_lane, context)) {
+  }
+
+  if (!context) {
+    // return "stop" token back
+    Push(nullptr, Task::Priority::kLow);
+  }
+  return context;
+}
+
+void PriorityTaskQueue::StopProcessing() {
+  Push(nullptr, Task::Priority::kLow);
+}
+
+std::size_t PriorityTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = 0;
+  for (const auto& lane : lanes_) size += lane.size_approx();
+  return size;
+}
+
+std::size_t PriorityTaskQueue::GetSizeApproximate(
+    Task::Priority priority) const noexcept {
+  return lanes_[ToLane(priority)].size_approx();
+}
+
+bool PriorityTaskQueue::TryPop(std::size_t first_lane,
+                               impl::TaskContext*& context) {
+  for (std::size_t i = 0; i < kTaskPrioritiesCount; ++i) {
+    auto& lane = lanes_[(first_lane + i) % kTaskPrioritiesCount];
+    if (lane.try_dequeue(context)) return true;
+  }
+  return false;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <userver/engine/task/task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+inline constexpr std::size_t kTaskPrioritiesCount = 3;
+
+/// A queue shared by all the workers of a TaskProcessor with a lane for each
+/// Task::Priority. The higher lanes are served first, every
+/// kStarvationGuardInterval-th pop of a worker starts from a lower lane, so
+/// the low priority tasks still progress under a constant high priority load.
+class PriorityTaskQueue final {
+ public:
+  static constexpr std::size_t kStarvationGuardInterval = 8;
+
+  PriorityTaskQueue() = default;
+
+  void Push(impl::TaskContext* context);
+
+  void Push(impl::TaskContext* context, Task::Priority priority);
+
+  /// Returns nullptr after StopProcessing() was called
+  impl::TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+  std::size_t GetSizeApproximate(Task::Priority priority) const noexcept;
+
+ private:
+  bool TryPop(std::size_t first_lane, impl::TaskContext*& context);
+
+  std::array<moodycamel::ConcurrentQueue<impl::TaskContext*>,
+             kTaskPrioritiesCount>
+      lanes_;
+  moodycamel::LightweightSemaphore size_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include <engine/task/priority_task_queue.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Priority = engine::Task::Priority;
+
+// The queue never dereferences the contexts pushed with a priority
+engine::impl::TaskContext* MakeFakeContext(std::uintptr_t value) {
+  return reinterpret_cast<engine::impl::TaskContext*>(value << 4);
+}
+
+std::uintptr_t FromFakeContext(engine::impl::TaskContext* context) {
+  return reinterpret_cast<std::uintptr_t>(context) >> 4;
+}
+
+}  // namespace
+
+TEST(PriorityTaskQueue, HigherLanesFirst) {
+  engine::PriorityTaskQueue queue;
+  queue.Push(MakeFakeContext(1), Priority::kLow);
+  queue.Push(MakeFakeContext(2), Priority::kNormal);
+  queue.Push(MakeFakeContext(3), Priority::kHigh);
+  queue.Push(MakeFakeContext(4), Priority::kHigh);
+  EXPECT_EQ(queue.GetSizeApproximate(), 4);
+  EXPECT_EQ(queue.GetSizeApproximate(Priority::kHigh), 2);
+
+  std::thread consumer([&queue] {
+    std::vector<std::uintptr_t> order;
+    for (int i = 0; i < 4; ++i) {
+      order.push_back(FromFakeContext(queue.PopBlocking()));
+    }
+    EXPECT_EQ(order, (std::vector<std::uintptr_t>{3, 4, 2, 1}));
+  });
+  consumer.join();
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+}
+
+TEST(PriorityTaskQueue, NoStarvation) {
+  constexpr std::size_t kPops =
+      engine::PriorityTaskQueue::kStarvationGuardInterval * 4;
+  engine::PriorityTaskQueue queue;
+  for (std::size_t i = 0; i < kPops; ++i) {
+    queue.Push(MakeFakeContext(1), Priority::kHigh);
+  }
+  queue.Push(MakeFakeContext(2), Priority::kNormal);
+  queue.Push(MakeFakeContext(3), Priority::kLow);
+
+  std::thread consumer([&queue] {
+    std::vector<std::uintptr_t> lower;
+    for (std::size_t i = 0; i < kPops; ++i) {
+      const auto value = FromFakeContext(queue.PopBlocking());
+      if (value != 1) lower.push_back(value);
+    }
+    // both lower lanes got their turn while the high lane was not empty
+    EXPECT_EQ(lower, (std::vector<std::uintptr_t>{2, 3}));
+  });
+  consumer.join();
+}
+
+TEST(PriorityTaskQueue, Stop) {
+  engine::PriorityTaskQueue queue;
+  queue.Push(MakeFakeContext(1), Priority::kLow);
+
+  std::thread consumer([&queue] {
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 1);
+    EXPECT_EQ(queue.PopBlocking(), nullptr);
+    EXPECT_EQ(queue.PopBlocking(), nullptr);
+  });
+
+  queue.StopProcessing();
+  consumer.join();
+}
+
+USERVER_NAMESPACE_END
@@ -20,10 +20,10 @@ Task::Task() = default;
 
 Task::Task(engine::TaskProcessor& task_processor, Task::Importance importance,
            Task::WaitMode wait_mode, engine::Deadline deadline,
-           impl::TaskPayload&& payload)
+           impl::TaskPayload&& payload, impl::TaskKind kind)
     : context_(utils::make_intrusive_ptr<impl::TaskContext>(
-          task_processor, importance, wait_mode, deadline,
-          std::move(payload))) {
+          task_processor, importance, wait_mode, deadline, std::move(payload),
+          kind)) {
   context_->Wakeup(impl::TaskContext::WakeupSource::kBootstrap,
                    impl::SleepState::Epoch{0});
 }
@@ -182,20 +182,23 @@ TaskProcessor* GetTaskProcessorOptional() noexcept {
 }
 
 ev::ThreadControl& GetEventThread() {
-  return GetTaskProcessor().EventThreadPool().NextThread();
+  auto& context = GetCurrentTaskContext();
+  if (auto* ev_thread = context.GetEventThreadAffinity()) return *ev_thread;
+  return context.GetTaskProcessor().EventThreadPool().NextThread();
 }
 
 void AccountSpuriousWakeup() {
   return GetTaskProcessor().GetTaskCounter().AccountSpuriousWakeup();
 }
 
-size_t GetStackSize() {
-  return GetTaskProcessor()
-      .GetTaskProcessorPools()
-      ->GetCoroPool()
-      .GetStackSize();
+size_t GetStackSize() { return GetTaskProcessor().GetCoroStackSize(); }
+
+void SetPriority(Task::Priority priority) {
+  GetCurrentTaskContext().SetPriority(priority);
 }
 
+Task::Priority GetPriority() { return GetCurrentTaskContext().GetPriority(); }
+
 }  // namespace current_task
 }  // namespace engine
 
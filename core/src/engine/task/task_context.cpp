@@ -68,10 +68,19 @@ namespace impl {
 
 namespace {
 
+std::atomic<bool> cpu_accounting_enabled{false};
+
+constexpr std::uint32_t kTimeSliceCheckInterval = 64;
+
 auto ReadableTaskId(const TaskContext* task) noexcept {
   return logging::HexShort(task ? task->GetTaskId() : 0);
 }
 
+Task::Priority GetCurrentPriority() noexcept {
+  const auto* current = current_task::GetCurrentTaskContextUnchecked();
+  return current ? current->GetPriority() : Task::Priority::kNormal;
+}
+
 class CurrentTaskScope final {
  public:
   explicit CurrentTaskScope(TaskContext& context, EhGlobals& eh_store)
@@ -101,11 +110,14 @@ auto* const kFinishedDetachedToken =
 
 TaskContext::TaskContext(TaskProcessor& task_processor,
                          Task::Importance importance, Task::WaitMode wait_type,
-                         Deadline deadline, TaskPayload&& payload)
+                         Deadline deadline, TaskPayload&& payload,
+                         TaskKind kind)
     : magic_(kMagic),
       task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      is_microtask_(kind == TaskKind::kMicrotask),
+      priority_(GetCurrentPriority()),
       payload_(std::move(payload)),
       state_(Task::State::kNew),
       detached_token_(nullptr),
@@ -116,6 +128,7 @@ TaskContext::TaskContext(TaskProcessor& task_processor,
       sleep_state_(SleepState{SleepFlags::kSleeping, SleepState::Epoch{0}}),
       local_storage_(std::nullopt) {
   UASSERT(payload_);
+  if (is_microtask_) task_processor_.GetTaskCounter().AccountMicrotask();
   LOG_TRACE() << "task with task_id="
               << ReadableTaskId(current_task::GetCurrentTaskContextUnchecked())
               << " created task with task_id=" << ReadableTaskId(this)
@@ -218,7 +231,10 @@ void TaskContext::DoStep() {
   if (IsFinished()) return;
 
   SleepState::Flags clear_flags{SleepFlags::kSleeping};
-  if (!coro_) {
+  if (is_microtask_) {
+    // runs to completion in a single step, no coroutine and no timers needed
+    clear_flags |= SleepFlags::kWakeupByBootstrap;
+  } else if (!coro_) {
     coro_ = task_processor_.GetCoroutine();
     clear_flags |= SleepFlags::kWakeupByBootstrap;
     ArmCancellationTimer();
@@ -231,7 +247,11 @@ void TaskContext::DoStep() {
     CurrentTaskScope current_task_scope(*this, eh_globals_);
     try {
       SetState(Task::State::kRunning);
-      (*coro_)(this);
+      if (is_microtask_) {
+        RunPayload();
+      } else {
+        (*coro_)(this);
+      }
     } catch (...) {
       uncaught = std::current_exception();
     }
@@ -306,6 +326,7 @@ bool TaskContext::SetCancellable(bool value) {
 TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy) {
   UASSERT(IsCurrent());
   UASSERT(state_ == Task::State::kRunning);
+  UINVARIANT(!is_microtask_, "Microtasks must not wait or yield");
 
   UASSERT_MSG(!std::exchange(within_sleep_, true),
               "Recursion in Sleep detected");
@@ -328,6 +349,7 @@ TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy) {
   ProfilerStopExecution();
   [[maybe_unused]] TaskContext* context = (*task_pipe_)().get();
   ProfilerStartExecution();
+  StartTimeSlice();
   TraceStateTransition(Task::State::kRunning);
   UASSERT(context == this);
   UASSERT(state_ == Task::State::kRunning);
@@ -483,48 +505,52 @@ class TaskContext::LocalStorageGuard {
 void TaskContext::CoroFunc(TaskPipe& task_pipe) {
   for (TaskContext* context : task_pipe) {
     UASSERT(context);
-    context->yield_reason_ = YieldReason::kNone;
     context->task_pipe_ = &task_pipe;
+    context->RunPayload();
+    context->task_pipe_ = nullptr;
+  }
+}
 
-    context->ProfilerStartExecution();
+void TaskContext::RunPayload() {
+  yield_reason_ = YieldReason::kNone;
 
-    // We only let tasks ran with CriticalAsync enter function body, others
-    // get terminated ASAP.
-    if (context->IsCancelRequested() && !context->WasStartedAsCritical()) {
-      context->SetCancellable(false);
-      // It is important to destroy payload here as someone may want
-      // to synchronize in its dtor (e.g. lambda closure).
+  ProfilerStartExecution();
+  StartTimeSlice();
+
+  // We only let tasks ran with CriticalAsync enter function body, others
+  // get terminated ASAP.
+  if (IsCancelRequested() && !WasStartedAsCritical()) {
+    SetCancellable(false);
+    // It is important to destroy payload here as someone may want
+    // to synchronize in its dtor (e.g. lambda closure).
+    {
+      LocalStorageGuard local_storage_guard(*this);
+      payload_.reset();
+    }
+    yield_reason_ = YieldReason::kTaskCancelled;
+  } else {
+    try {
       {
-        LocalStorageGuard local_storage_guard(*context);
-        context->payload_.reset();
-      }
-      context->yield_reason_ = YieldReason::kTaskCancelled;
-    } else {
-      try {
-        {
-          // Destroy contents of LocalStorage in the coroutine
-          // as dtors may want to schedule
-          LocalStorageGuard local_storage_guard(*context);
-
-          context->TraceStateTransition(Task::State::kRunning);
-          context->payload_->Perform();
-        }
-        context->yield_reason_ = YieldReason::kTaskComplete;
-      } catch (const CoroUnwinder&) {
-        context->yield_reason_ = YieldReason::kTaskCancelled;
-      } catch (...) {
-        utils::impl::AbortWithStacktrace(
-            "An exception that is not derived from std::exception has been "
-            "thrown: " +
-            boost::current_exception_diagnostic_information() +
-            " Such exceptions are not supported by userver.");
+        // Destroy contents of LocalStorage in the coroutine
+        // as dtors may want to schedule
+        LocalStorageGuard local_storage_guard(*this);
+
+        TraceStateTransition(Task::State::kRunning);
+        payload_->Perform();
       }
+      yield_reason_ = YieldReason::kTaskComplete;
+    } catch (const CoroUnwinder&) {
+      yield_reason_ = YieldReason::kTaskCancelled;
+    } catch (...) {
+      utils::impl::AbortWithStacktrace(
+          "An exception that is not derived from std::exception has been "
+          "thrown: " +
+          boost::current_exception_diagnostic_information() +
+          " Such exceptions are not supported by userver.");
     }
-
-    context->ProfilerStopExecution();
-
-    context->task_pipe_ = nullptr;
   }
+
+  ProfilerStopExecution();
 }
 
 void TaskContext::SetCancelDeadline(Deadline deadline) {
@@ -651,7 +677,7 @@ void TaskContext::Schedule() {
 
 void TaskContext::ProfilerStartExecution() {
   auto threshold_us = task_processor_.GetProfilerThreshold();
-  if (threshold_us.count() > 0) {
+  if (threshold_us.count() > 0 || IsCpuAccountingEnabled()) {
     execute_started_ = std::chrono::steady_clock::now();
   } else {
     execute_started_ = {};
@@ -659,16 +685,18 @@ void TaskContext::ProfilerStartExecution() {
 }
 
 void TaskContext::ProfilerStopExecution() {
-  auto threshold_us = task_processor_.GetProfilerThreshold();
-  if (threshold_us.count() <= 0) return;
-
   if (execute_started_ == std::chrono::steady_clock::time_point{}) {
     // the task was started w/o profiling, skip it
     return;
   }
 
   auto now = std::chrono::steady_clock::now();
-  auto duration = now - execute_started_;
+  auto duration = now - std::exchange(execute_started_, {});
+  execution_time_ += duration;
+
+  auto threshold_us = task_processor_.GetProfilerThreshold();
+  if (threshold_us.count() <= 0) return;
+
   auto duration_us =
       std::chrono::duration_cast<std::chrono::microseconds>(duration);
 
@@ -686,6 +714,35 @@ void TaskContext::ProfilerStopExecution() {
   }
 }
 
+void TaskContext::StartTimeSlice() {
+  const auto slice = task_processor_.GetCooperativeYieldSlice();
+  if (slice.count() > 0) {
+    time_slice_deadline_ = std::chrono::steady_clock::now() + slice;
+    time_slice_checks_left_ = kTimeSliceCheckInterval;
+  } else {
+    time_slice_deadline_ = {};
+  }
+}
+
+bool TaskContext::IsTimeSliceExceeded() noexcept {
+  UASSERT(IsCurrent());
+  if (time_slice_deadline_ == std::chrono::steady_clock::time_point{}) {
+    return false;
+  }
+  if (--time_slice_checks_left_ != 0) return false;
+
+  time_slice_checks_left_ = kTimeSliceCheckInterval;
+  return std::chrono::steady_clock::now() >= time_slice_deadline_;
+}
+
+std::chrono::nanoseconds TaskContext::GetExecutionTime() const {
+  if (execute_started_ == std::chrono::steady_clock::time_point{}) {
+    return execution_time_;
+  }
+  return execution_time_ +
+         (std::chrono::steady_clock::now() - execute_started_);
+}
+
 void TaskContext::TraceStateTransition(Task::State state) {
   if (trace_csw_left_ == 0) return;
   --trace_csw_left_;
@@ -705,6 +762,14 @@ void TaskContext::TraceStateTransition(Task::State state) {
                       << logging::LogExtra::Stacktrace(logger);
 }
 
+void SetCpuAccountingEnabled(bool enabled) noexcept {
+  cpu_accounting_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsCpuAccountingEnabled() noexcept {
+  return cpu_accounting_enabled.load(std::memory_order_relaxed);
+}
+
 }  // namespace impl
 }  // namespace engine
 
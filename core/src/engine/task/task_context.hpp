@@ -79,7 +79,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   };
 
   TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-              TaskPayload&&);
+              TaskPayload&&, TaskKind kind = TaskKind::kCoroutine);
 
   ~TaskContext() noexcept;
 
@@ -104,6 +104,14 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   // simultaneously
   bool IsSharedWaitAllowed() const;
 
+  // the task processor lane of the task, inherited from the creator task
+  Task::Priority GetPriority() const noexcept {
+    return priority_.load(std::memory_order_relaxed);
+  }
+  void SetPriority(Task::Priority priority) noexcept {
+    priority_.store(priority, std::memory_order_relaxed);
+  }
+
   // whether user code finished executing, coroutine may still be running
   bool IsFinished() const noexcept {
     return state_ == Task::State::kCompleted ||
@@ -121,6 +129,15 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   TaskProcessor& GetTaskProcessor() { return task_processor_; }
   void DoStep();
 
+  // ev thread for the new fd watchers of the task, nullptr to distribute
+  // them over the event thread pool
+  ev::ThreadControl* GetEventThreadAffinity() const noexcept {
+    return event_thread_affinity_;
+  }
+  void SetEventThreadAffinity(ev::ThreadControl* ev_thread) noexcept {
+    event_thread_affinity_ = ev_thread;
+  }
+
   // normally non-blocking, causes wakeup
   void RequestCancel(TaskCancellationReason);
 
@@ -172,6 +189,15 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   void SetCancelDeadline(Deadline deadline);
 
+  // Time spent running this task, accounted only while the profiler or the
+  // CPU accounting is enabled. Includes the current slice of a running task.
+  std::chrono::nanoseconds GetExecutionTime() const;
+
+  // Whether the current execution slice is longer than the
+  // cooperative-yield-slice of the task processor, the clock is read once in
+  // kTimeSliceCheckInterval calls
+  bool IsTimeSliceExceeded() noexcept;
+
   bool HasLocalStorage() const noexcept;
   task_local::Storage& GetLocalStorage() noexcept;
 
@@ -184,6 +210,8 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
  private:
   class LocalStorageGuard;
 
+  void RunPayload();
+
   static constexpr uint64_t kMagic = 0x6b73615453755459ULL;  // "YTuSTask"
 
   template <typename Func>
@@ -203,12 +231,16 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   void ProfilerStartExecution();
   void ProfilerStopExecution();
 
+  void StartTimeSlice();
+
   void TraceStateTransition(Task::State state);
 
   const uint64_t magic_;
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  const bool is_microtask_;
+  std::atomic<Task::Priority> priority_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
   EhGlobals eh_globals_;
@@ -225,6 +257,10 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   // {} if not defined
   std::chrono::steady_clock::time_point task_queue_wait_timepoint_;
   std::chrono::steady_clock::time_point execute_started_;
+  std::chrono::nanoseconds execution_time_{0};
+  // {} if cooperative-yield-slice is not set
+  std::chrono::steady_clock::time_point time_slice_deadline_;
+  std::uint32_t time_slice_checks_left_{0};
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
 
   size_t trace_csw_left_;
@@ -235,6 +271,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   CountedCoroutinePtr coro_;
   TaskPipe* task_pipe_{nullptr};
   YieldReason yield_reason_{YieldReason::kNone};
+  ev::ThreadControl* event_thread_affinity_{nullptr};
 
   std::optional<task_local::Storage> local_storage_;
 
@@ -246,6 +283,11 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   WaitListHook wait_list_hook;
 };
 
+// Makes every task account its execution time, see GetExecutionTime()
+void SetCpuAccountingEnabled(bool enabled) noexcept;
+
+bool IsCpuAccountingEnabled() noexcept;
+
 }  // namespace impl
 
 namespace current_task {
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <engine/ev/thread_pool.hpp>
 #include <engine/task/sleep_state.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 
@@ -93,4 +95,15 @@ UTEST(TaskContext, WaitListWakeupRace) {
             engine::impl::TaskContext::WakeupSource::kWaitList);
 }
 
+UTEST(TaskContext, EventThreadAffinity) {
+  auto& context = engine::current_task::GetCurrentTaskContext();
+  auto& ev_thread = context.GetTaskProcessor().EventThreadPool().GetThread(0);
+
+  context.SetEventThreadAffinity(&ev_thread);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(&engine::current_task::GetEventThread(), &ev_thread);
+  }
+  context.SetEventThreadAffinity(nullptr);
+}
+
 USERVER_NAMESPACE_END
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <thread>
 
 #include <userver/utils/assert.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -72,6 +72,8 @@ class TaskCounter final {
 
   size_t GetRunningTasks() const { return tasks_running_; }
 
+  size_t GetCreatedMicrotasks() const { return microtasks_created_; }
+
   size_t GetCancelledTasks() const { return tasks_cancelled_; }
 
   size_t GetCancelledTasksOverload() const { return tasks_cancelled_overload_; }
@@ -90,6 +92,8 @@ class TaskCounter final {
 
   void AccountTaskCancel() noexcept { tasks_cancelled_++; }
 
+  void AccountMicrotask() noexcept { microtasks_created_++; }
+
   void AccountTaskCancelOverload() noexcept { tasks_cancelled_overload_++; }
 
   void AccountTaskOverload() noexcept { tasks_overload_++; }
@@ -113,18 +117,21 @@ class TaskCounter final {
   }
 
  private:
-  std::atomic<size_t> tasks_alive_{0};
-  std::atomic<size_t> tasks_created_{0};
-  std::atomic<size_t> tasks_running_{0};
-  std::atomic<size_t> tasks_cancelled_{0};
-  std::atomic<size_t> tasks_switch_fast_{0};
-  std::atomic<size_t> tasks_switch_slow_{0};
-  std::atomic<size_t> spurious_wakeups_{0};
-  std::atomic<size_t> tasks_cancelled_overload_{0};
-  std::atomic<size_t> tasks_overload_{0};
-
-  std::atomic<size_t> tasks_overload_sensor_{0};
-  std::atomic<size_t> tasks_no_overload_sensor_{0};
+  using Counter = utils::statistics::ShardedCounter<size_t>;
+
+  Counter tasks_alive_;
+  Counter tasks_created_;
+  Counter tasks_running_;
+  Counter microtasks_created_;
+  Counter tasks_cancelled_;
+  Counter tasks_switch_fast_;
+  Counter tasks_switch_slow_;
+  Counter spurious_wakeups_;
+  Counter tasks_cancelled_overload_;
+  Counter tasks_overload_;
+
+  Counter tasks_overload_sensor_;
+  Counter tasks_no_overload_sensor_;
 
   utils::statistics::AggregatedValues<25> task_processor_profiler_timings_;
 };
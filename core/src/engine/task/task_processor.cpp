@@ -2,6 +2,7 @@
 
 #include <sys/types.h>
 #include <csignal>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -10,8 +11,11 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <utils/impl/static_registration.hpp>
+#include <utils/jemalloc.hpp>
 #include <utils/threads.hpp>
 
+#include <compiler/tls.hpp>
+#include <engine/ev/thread.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
 
@@ -35,6 +39,39 @@ void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   }
 }
 
+// Limits the tasks handed off in a row, so that a pair of tasks waking each
+// other does not starve the task queue
+constexpr std::size_t kMaxHandoffStreak = 16;
+
+struct WorkerHandoff final {
+  const TaskProcessor* task_processor{nullptr};
+  impl::TaskContext* next{nullptr};
+  std::size_t streak{0};
+};
+
+thread_local WorkerHandoff worker_handoff;
+
+// Schedule() is called from coroutines that may migrate between threads
+USERVER_PREVENT_TLS_CACHING WorkerHandoff& GetWorkerHandoff() noexcept {
+  return worker_handoff;
+}
+
+using TaskQueueVariant =
+    std::variant<TaskQueue, WorkStealingTaskQueue, PriorityTaskQueue>;
+
+TaskQueueVariant MakeTaskQueue(const TaskProcessorConfig& config) {
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return TaskQueueVariant{std::in_place_type<TaskQueue>};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return TaskQueueVariant{std::in_place_type<WorkStealingTaskQueue>,
+                              config.worker_threads};
+    case TaskQueueType::kPriorityTaskQueue:
+      return TaskQueueVariant{std::in_place_type<PriorityTaskQueue>};
+  }
+  UINVARIANT(false, "Unexpected task processor queue type");
+}
+
 // Hooks are modified only before task processors created and only in main
 // thread, so it doesnt' need any synchronization.
 std::vector<std::function<void()>>& ThreadStartedHooks() {
@@ -42,6 +79,11 @@ std::vector<std::function<void()>>& ThreadStartedHooks() {
   return thread_started_hooks;
 }
 
+std::vector<std::function<void()>>& ThreadStoppedHooks() {
+  static std::vector<std::function<void()>> thread_stopped_hooks;
+  return thread_stopped_hooks;
+}
+
 void EmitMagicNanosleep() {
   // If we're ptrace'd (e.g. by strace), the magic syscall tells a tracer
   // that all startup stuff of the current thread is done.
@@ -51,6 +93,12 @@ void EmitMagicNanosleep() {
   nanosleep(&ts, nullptr);
 }
 
+std::vector<std::size_t> GetWorkerCpus(const TaskProcessorConfig& config) {
+  if (!config.cpu_affinity.empty()) return config.cpu_affinity;
+  if (config.numa_node) return utils::GetNumaNodeCpus(*config.numa_node);
+  return {};
+}
+
 void TaskProcessorThreadStartedHook() {
   utils::impl::AssertStaticRegistrationFinished();
   (void)utils::DefaultRandom();
@@ -60,6 +108,12 @@ void TaskProcessorThreadStartedHook() {
   EmitMagicNanosleep();
 }
 
+void TaskProcessorThreadStoppedHook() noexcept {
+  for (const auto& func : ThreadStoppedHooks()) {
+    func();
+  }
+}
+
 }  // namespace
 
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
@@ -68,8 +122,12 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       task_profiler_threshold_{std::chrono::microseconds(0)},
       profiler_force_stacktrace_{false},
       pools_(std::move(pools)),
+      coro_pool_(config_.coro_stack_size
+                     ? pools_->GetCoroPool(*config_.coro_stack_size)
+                     : pools_->GetCoroPool()),
       is_shutting_down_(false),
       detached_contexts_(impl::DetachedTasksSyncBlock::StopMode::kCancel),
+      task_queue_(MakeTaskQueue(config_)),
       max_task_queue_wait_time_(std::chrono::microseconds(0)),
       max_task_queue_wait_length_(0),
       task_trace_logger_{nullptr} {
@@ -77,10 +135,54 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name << " task_queue="
+               << ToString(config_.task_processor_queue);
+    if (config_.jemalloc_arena) {
+      unsigned arena = 0;
+      if (auto ec = utils::jemalloc::CreateArena(*config_.jemalloc_arena,
+                                                 arena)) {
+        LOG_WARNING() << "Failed to create a jemalloc arena for task_processor "
+                      << Name() << ": " << ec.message();
+      } else {
+        LOG_INFO() << "task_processor " << Name() << " uses jemalloc arena "
+                   << arena;
+        jemalloc_arena_ = arena;
+      }
+    }
+
+    auto cpus = GetWorkerCpus(config_);
+    if (!cpus.empty()) {
+      LOG_INFO() << "task_processor " << Name() << " workers are pinned to "
+                 << cpus.size() << " CPUs"
+                 << (config_.numa_node
+                         ? fmt::format(" of NUMA node {}", *config_.numa_node)
+                         : std::string{});
+    }
+
     workers_.reserve(config_.worker_threads);
     for (size_t i = 0; i < config_.worker_threads; ++i) {
-      workers_.emplace_back([this, i] {
+      workers_.emplace_back([this, i, cpus] {
+        if (!cpus.empty()) {
+          try {
+            utils::SetCurrentThreadAffinity(cpus);
+          } catch (const std::exception& ex) {
+            LOG_ERROR() << "Failed to pin a worker of task_processor "
+                        << Name() << ": " << ex;
+          }
+        }
+        // Must be set before the first coroutine is taken from the pool
+        if (config_.numa_node) {
+          utils::SetCurrentThreadNumaNode(*config_.numa_node);
+        }
+        if (jemalloc_arena_) {
+          if (auto ec = utils::jemalloc::BindCurrentThread(
+                  *jemalloc_arena_, *config_.jemalloc_arena)) {
+            LOG_ERROR() << "Failed to bind a worker of task_processor "
+                        << Name() << " to its jemalloc arena: "
+                        << ec.message();
+          }
+        }
+
         switch (config_.os_scheduling) {
           case OsScheduling::kNormal:
             break;
@@ -111,7 +213,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -146,10 +248,29 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
   // but oh well
   intrusive_ptr_add_ref(context);
 
-  task_queue_.enqueue(context);
+  if (TryHandOff(context)) return;
+
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
   // NOTE: task may be executed at this point
 }
 
+bool TaskProcessor::TryHandOff(impl::TaskContext* context) {
+  if (!config_.direct_handoff ||
+      !std::holds_alternative<TaskQueue>(task_queue_)) {
+    return false;
+  }
+
+  auto& handoff = GetWorkerHandoff();
+  // Only a task running on a worker of this task processor may hand off the
+  // task it wakes up, the worker switches to it right after the current step
+  if (handoff.task_processor != this || handoff.next) return false;
+  auto* current = current_task::GetCurrentTaskContextUnchecked();
+  if (!current || current == context) return false;
+
+  handoff.next = context;
+  return true;
+}
+
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_.Add(context);
 }
@@ -159,7 +280,11 @@ ev::ThreadPool& TaskProcessor::EventThreadPool() {
 }
 
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
-  return {pools_->GetCoroPool().GetCoroutine(), *this};
+  return {coro_pool_.GetCoroutine(), *this};
+}
+
+std::size_t TaskProcessor::GetCoroStackSize() const {
+  return coro_pool_.GetStackSize();
 }
 
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
@@ -227,23 +352,27 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
   return task_trace_logger_;
 }
 
-impl::TaskContext* TaskProcessor::DequeueTask() {
-  impl::TaskContext* buf = nullptr;
-
-  /* Current thread handles only a single TaskProcessor, so it's safe to store
-   * a token for the task processor in a thread-local variable.
-   */
-  thread_local moodycamel::ConsumerToken token(task_queue_);
-
-  task_queue_.wait_dequeue(token, buf);
-  GetTaskCounter().AccountTaskSwitchSlow();
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit([](const auto& queue) { return queue.GetSizeApproximate(); },
+                    task_queue_);
+}
 
-  if (!buf) {
-    // return "stop" token back
-    task_queue_.enqueue(nullptr);
+impl::TaskContext* TaskProcessor::DequeueTask() {
+  auto& handoff = GetWorkerHandoff();
+  if (auto* next = std::exchange(handoff.next, nullptr)) {
+    if (handoff.streak++ < kMaxHandoffStreak) {
+      GetTaskCounter().AccountTaskSwitchFast();
+      return next;
+    }
+    // let the queued tasks run, the handed off task goes to the back
+    std::visit([next](auto& queue) { queue.Push(next); }, task_queue_);
   }
+  handoff.streak = 0;
 
-  return buf;
+  auto* context =
+      std::visit([](auto& queue) { return queue.PopBlocking(); }, task_queue_);
+  GetTaskCounter().AccountTaskSwitchSlow();
+  return context;
 }
 
 void RegisterThreadStartedHook(std::function<void()> func) {
@@ -252,8 +381,15 @@ void RegisterThreadStartedHook(std::function<void()> func) {
   ThreadStartedHooks().push_back(std::move(func));
 }
 
+void RegisterThreadStoppedHook(std::function<void()> func) {
+  utils::impl::AssertStaticRegistrationAllowed(
+      "Calling engine::RegisterThreadStoppedHook()");
+  ThreadStoppedHooks().push_back(std::move(func));
+}
+
 void TaskProcessor::ProcessTasks() noexcept {
   TaskProcessorThreadStartedHook();
+  GetWorkerHandoff().task_processor = this;
 
   while (true) {
     // wrapping instance referenced in EnqueueTask
@@ -264,25 +400,33 @@ void TaskProcessor::ProcessTasks() noexcept {
     CheckWaitTime(*context);
 
     bool has_failed = false;
-    try {
-      context->DoStep();
-    } catch (const std::exception& ex) {
-      LOG_ERROR() << "uncaught exception from DoStep: " << ex;
-      has_failed = true;
+    {
+      // Wakes up each ev-loop once for all the watchers armed in the step
+      ev::WakeupBatchScope wakeup_batch_scope;
+      try {
+        context->DoStep();
+      } catch (const std::exception& ex) {
+        LOG_ERROR() << "uncaught exception from DoStep: " << ex;
+        has_failed = true;
+      }
     }
 
     if (has_failed || context->IsFinished()) {
       context->FinishDetached();
     }
   }
+
+  TaskProcessorThreadStoppedHook();
 }
 
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
   const auto max_wait_time = max_task_queue_wait_time_.load();
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
+  auto& lane_overloaded = task_queue_wait_time_overloaded_[static_cast<
+      std::size_t>(context.GetPriority())];
 
   if (max_wait_time.count() == 0 && sensor_wait_time.count() == 0) {
-    task_queue_wait_time_overloaded_.store(false, std::memory_order_relaxed);
+    lane_overloaded.store(false, std::memory_order_relaxed);
     return;
   }
 
@@ -293,9 +437,8 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
         std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
     LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
 
-    task_queue_wait_time_overloaded_.store(
-        max_wait_time.count() && wait_time >= max_wait_time,
-        std::memory_order_relaxed);
+    lane_overloaded.store(max_wait_time.count() && wait_time >= max_wait_time,
+                          std::memory_order_relaxed);
 
     if (sensor_wait_time.count() && wait_time >= sensor_wait_time) {
       GetTaskCounter().AccountTaskOverloadSensor();
@@ -304,11 +447,11 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     }
   } else {
     // no info, let's pretend this task has the same queue wait time as the
-    // previous one
+    // previous one of its priority
   }
 
   // Don't cancel critical tasks, but use their timestamp to cancel other tasks
-  if (task_queue_wait_time_overloaded_.load()) {
+  if (lane_overloaded.load()) {
     HandleOverload(context);
   }
 }
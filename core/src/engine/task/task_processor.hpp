@@ -1,20 +1,25 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
-#include <moodycamel/blockingconcurrentqueue.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
+#include <engine/task/priority_task_queue.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_queue/task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -43,6 +48,8 @@ class TaskProcessor final {
 
   impl::CountedCoroutinePtr GetCoroutine();
 
+  std::size_t GetCoroStackSize() const;
+
   ev::ThreadPool& EventThreadPool();
 
   std::shared_ptr<impl::TaskProcessorPools> GetTaskProcessorPools() {
@@ -55,7 +62,7 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
@@ -65,6 +72,10 @@ class TaskProcessor final {
 
   bool ShouldProfilerForceStacktrace() const;
 
+  std::chrono::milliseconds GetCooperativeYieldSlice() const {
+    return config_.cooperative_yield_slice;
+  }
+
   size_t GetTaskTraceMaxCswForNewTask() const;
 
   const std::string& GetTaskTraceLoggerName() const;
@@ -73,9 +84,14 @@ class TaskProcessor final {
 
   logging::LoggerPtr GetTaskTraceLogger() const;
 
+  /// The jemalloc arena of the worker threads, if they have their own
+  std::optional<unsigned> GetJemallocArena() const { return jemalloc_arena_; }
+
  private:
   void Cleanup() noexcept;
 
+  bool TryHandOff(impl::TaskContext* context);
+
   impl::TaskContext* DequeueTask();
 
   void ProcessTasks() noexcept;
@@ -89,18 +105,23 @@ class TaskProcessor final {
   std::atomic<bool> profiler_force_stacktrace_{false};
 
   std::shared_ptr<impl::TaskProcessorPools> pools_;
+  coro::Pool<impl::TaskContext>& coro_pool_;
+  std::optional<unsigned> jemalloc_arena_;
 
   std::atomic<bool> is_shutting_down_;
   impl::DetachedTasksSyncBlock detached_contexts_;
 
-  moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue, PriorityTaskQueue> task_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
   std::atomic<size_t> max_task_queue_wait_length_{0};
   TaskProcessorSettings::OverloadAction overload_action_{
       TaskProcessorSettings::OverloadAction::kIgnore};
-  std::atomic<bool> task_queue_wait_time_overloaded_{false};
+  // by Task::Priority, a slow low priority lane must not cancel the tasks of
+  // the high priority one
+  std::array<std::atomic<bool>, kTaskPrioritiesCount>
+      task_queue_wait_time_overloaded_{};
 
   std::vector<std::thread> workers_;
   impl::TaskCounter task_counter_;
@@ -115,6 +136,14 @@ class TaskProcessor final {
 /// @note It is a low-level function. You might not want to use it.
 void RegisterThreadStartedHook(std::function<void()>);
 
+/// Register a function that runs on all threads of a task processor after
+/// they stop processing the tasks. Used for releasing the thread_local
+/// caches before the thread exit, when the subsystems they refer to may be
+/// already destroyed. The function must not throw.
+///
+/// @note It is a low-level function. You might not want to use it.
+void RegisterThreadStoppedHook(std::function<void()>);
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
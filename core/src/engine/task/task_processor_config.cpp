@@ -8,6 +8,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/threads.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -28,6 +29,33 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
       "Invalid OsScheduling value '{}' at path '{}'", str, value.GetPath()));
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  const auto str = value.As<std::string>();
+  if (str == "global-task-queue") {
+    return TaskQueueType::kGlobalTaskQueue;
+  } else if (str == "work-stealing-task-queue") {
+    return TaskQueueType::kWorkStealingTaskQueue;
+  } else if (str == "priority-task-queue") {
+    return TaskQueueType::kPriorityTaskQueue;
+  }
+
+  throw std::logic_error(fmt::format(
+      "Invalid TaskQueueType value '{}' at path '{}'", str, value.GetPath()));
+}
+
+std::string_view ToString(TaskQueueType type) {
+  switch (type) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return "global-task-queue";
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return "work-stealing-task-queue";
+    case TaskQueueType::kPriorityTaskQueue:
+      return "priority-task-queue";
+  }
+  UINVARIANT(false, "Unexpected TaskQueueType");
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -37,6 +65,37 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_name = value["thread_name"].As<std::string>();
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
+  config.task_processor_queue = value["task-processor-queue"].As<TaskQueueType>(
+      config.task_processor_queue);
+  config.direct_handoff =
+      value["direct-handoff"].As<bool>(config.direct_handoff);
+  config.cooperative_yield_slice =
+      value["cooperative-yield-slice"].As<std::chrono::milliseconds>(
+          config.cooperative_yield_slice);
+
+  const auto cpu_affinity = value["cpu-affinity"];
+  if (!cpu_affinity.IsMissing()) {
+    config.cpu_affinity = utils::ParseCpuList(cpu_affinity.As<std::string>());
+    if (config.cpu_affinity.empty()) {
+      throw std::logic_error(fmt::format("Empty CPU list at path '{}'",
+                                         cpu_affinity.GetPath()));
+    }
+  }
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
+  config.coro_stack_size =
+      value["coro-stack-size"].As<std::optional<std::size_t>>();
+
+  const auto jemalloc_arena = value["jemalloc-arena"];
+  if (!jemalloc_arena.IsMissing()) {
+    auto& settings = config.jemalloc_arena.emplace();
+    settings.tcache = jemalloc_arena["tcache"].As<bool>(settings.tcache);
+    settings.dirty_decay =
+        jemalloc_arena["dirty-decay"]
+            .As<std::optional<std::chrono::milliseconds>>();
+    settings.muzzy_decay =
+        jemalloc_arena["muzzy-decay"]
+            .As<std::optional<std::chrono::milliseconds>>();
+  }
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
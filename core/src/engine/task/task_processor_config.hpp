@@ -2,10 +2,14 @@
 
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,6 +24,17 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+  kPriorityTaskQueue,
+};
+
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
+std::string_view ToString(TaskQueueType type);
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -27,6 +42,31 @@ struct TaskProcessorConfig {
   std::size_t worker_threads{6};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
+  TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+
+  /// A task woken up by another task of the same worker is run right after
+  /// the current step of the waker instead of going through the global task
+  /// queue. Ignored for kWorkStealingTaskQueue, it has a LIFO slot of its own,
+  /// and for kPriorityTaskQueue, a handoff would bypass the lanes.
+  bool direct_handoff{false};
+
+  /// A running task yields in engine::YieldIfTimeSliceExceeded() once it has
+  /// run that long without a context switch, 0 disables the yields
+  std::chrono::milliseconds cooperative_yield_slice{0};
+
+  /// CPUs to pin the worker threads to, empty means no pinning
+  std::vector<std::size_t> cpu_affinity;
+  /// NUMA node of the worker threads. If cpu_affinity is empty, the workers
+  /// are pinned to all the CPUs of the node.
+  std::optional<std::size_t> numa_node;
+
+  /// Stack size of the coroutines of this task processor, the coro_pool
+  /// stack_size is used if not set
+  std::optional<std::size_t> coro_stack_size;
+
+  /// Gives the worker threads a jemalloc arena of their own, so that the
+  /// allocations of this task processor do not fragment the heap of the others
+  std::optional<utils::jemalloc::ArenaSettings> jemalloc_arena;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
@@ -8,10 +8,36 @@ namespace engine::impl {
 
 TaskProcessorPools::TaskProcessorPools(coro::PoolConfig coro_pool_config,
                                        ev::ThreadPoolConfig ev_pool_config)
-    : coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
+    : coro_pool_config_(std::move(coro_pool_config)),
+      coro_pool_(coro_pool_config_, &TaskContext::CoroFunc),
       event_thread_pool_(std::move(ev_pool_config),
                          ev::ThreadPool::kUseDefaultEvLoop) {}
 
+TaskProcessorPools::CoroPool& TaskProcessorPools::GetCoroPool(
+    std::size_t stack_size) {
+  if (stack_size == coro_pool_.GetStackSize()) return coro_pool_;
+
+  std::lock_guard lock(extra_coro_pools_mutex_);
+  auto& pool = extra_coro_pools_[stack_size];
+  if (!pool) {
+    auto config = coro_pool_config_;
+    config.initial_size = 0;
+    config.stack_size = stack_size;
+    pool = std::make_unique<CoroPool>(std::move(config), &TaskContext::CoroFunc);
+  }
+  return *pool;
+}
+
+coro::PoolStats TaskProcessorPools::GetCoroPoolStats() const {
+  auto stats = coro_pool_.GetStats();
+
+  std::lock_guard lock(extra_coro_pools_mutex_);
+  for (const auto& [stack_size, pool] : extra_coro_pools_) {
+    stats += pool->GetStats();
+  }
+  return stats;
+}
+
 }  // namespace engine::impl
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_pool.hpp>
 
@@ -17,10 +21,23 @@ class TaskProcessorPools final {
                      ev::ThreadPoolConfig ev_pool_config);
 
   CoroPool& GetCoroPool() { return coro_pool_; }
+
+  /// Returns the pool for coroutines with the specified stack size, creating
+  /// it on the first call. Pools of non-default sizes are not preallocated.
+  CoroPool& GetCoroPool(std::size_t stack_size);
+
+  /// Returns the total stats of all the coroutine pools
+  coro::PoolStats GetCoroPoolStats() const;
+
   ev::ThreadPool& EventThreadPool() { return event_thread_pool_; }
 
  private:
+  const coro::PoolConfig coro_pool_config_;
   CoroPool coro_pool_;
+
+  mutable std::mutex extra_coro_pools_mutex_;
+  std::map<std::size_t, std::unique_ptr<CoroPool>> extra_coro_pools_;
+
   ev::ThreadPool event_thread_pool_;
 };
 
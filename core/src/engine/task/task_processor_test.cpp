@@ -0,0 +1,133 @@
+#include <engine/task/task_processor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Returns the order in which a woken up task and an already queued task run
+std::vector<int> GetWakeupOrder(bool direct_handoff) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 1;
+  config.thread_name = "handoff";
+  config.direct_handoff = direct_handoff;
+  engine::impl::TaskProcessorHolder task_processor{
+      std::make_unique<engine::TaskProcessor>(
+          std::move(config), engine::impl::MakeTaskProcessorPools({}))};
+
+  std::vector<int> order;
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [&order] {
+    engine::SingleConsumerEvent event;
+    auto woken = engine::AsyncNoSpan([&] {
+      EXPECT_TRUE(event.WaitForEvent());
+      order.push_back(1);
+    });
+    // lets the task start waiting for the event
+    engine::Yield();
+
+    auto queued = engine::AsyncNoSpan([&] { order.push_back(2); });
+    event.Send();
+    engine::Yield();
+
+    woken.Get();
+    queued.Get();
+  });
+  return order;
+}
+
+// Spins in engine::YieldIfTimeSliceExceeded() for up to `spin_time`, returns
+// whether an already queued task has run meanwhile
+bool IsPreemptedBySlice(std::chrono::milliseconds cooperative_yield_slice,
+                        std::chrono::milliseconds spin_time) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 1;
+  config.thread_name = "slice";
+  config.cooperative_yield_slice = cooperative_yield_slice;
+  engine::impl::TaskProcessorHolder task_processor{
+      std::make_unique<engine::TaskProcessor>(
+          std::move(config), engine::impl::MakeTaskProcessorPools({}))};
+
+  bool preempted = false;
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [&] {
+    std::atomic<bool> queued_ran{false};
+    auto queued = engine::AsyncNoSpan([&queued_ran] { queued_ran = true; });
+
+    const auto deadline = engine::Deadline::FromDuration(spin_time);
+    while (!queued_ran && !deadline.IsReached()) {
+      engine::YieldIfTimeSliceExceeded();
+    }
+    preempted = queued_ran;
+    queued.Get();
+  });
+  return preempted;
+}
+
+}  // namespace
+
+TEST(TaskProcessor, WakeupGoesThroughQueue) {
+  EXPECT_EQ(GetWakeupOrder(false), (std::vector<int>{2, 1}));
+}
+
+TEST(TaskProcessor, DirectHandoff) {
+  EXPECT_EQ(GetWakeupOrder(true), (std::vector<int>{1, 2}));
+}
+
+TEST(TaskProcessor, CooperativeYieldSlice) {
+  EXPECT_TRUE(IsPreemptedBySlice(std::chrono::milliseconds{1},
+                                 std::chrono::seconds{10}));
+}
+
+TEST(TaskProcessor, NoCooperativeYieldByDefault) {
+  EXPECT_FALSE(IsPreemptedBySlice(std::chrono::milliseconds{0},
+                                  std::chrono::milliseconds{50}));
+}
+
+TEST(TaskProcessor, PriorityLanes) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 1;
+  config.thread_name = "priority";
+  config.task_processor_queue = engine::TaskQueueType::kPriorityTaskQueue;
+  engine::impl::TaskProcessorHolder task_processor{
+      std::make_unique<engine::TaskProcessor>(
+          std::move(config), engine::impl::MakeTaskProcessorPools({}))};
+
+  std::vector<int> order;
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [&order] {
+    EXPECT_EQ(engine::current_task::GetPriority(),
+              engine::Task::Priority::kNormal);
+
+    engine::current_task::SetPriority(engine::Task::Priority::kLow);
+    auto low = engine::AsyncNoSpan([&order] {
+      // inherited from the creator
+      EXPECT_EQ(engine::current_task::GetPriority(),
+                engine::Task::Priority::kLow);
+      order.push_back(1);
+    });
+
+    engine::current_task::SetPriority(engine::Task::Priority::kHigh);
+    auto high = engine::AsyncNoSpan([&order] { order.push_back(2); });
+
+    // the current task goes to the high lane, behind 'high' only
+    engine::Yield();
+    order.push_back(3);
+
+    low.Get();
+    high.Get();
+  });
+  EXPECT_EQ(order, (std::vector<int>{2, 3, 1}));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,35 @@
+#include <engine/task/task_queue.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+void TaskQueue::Push(impl::TaskContext* context) { queue_.enqueue(context); }
+
+impl::TaskContext* TaskQueue::PopBlocking() {
+  impl::TaskContext* buf = nullptr;
+
+  /* Current thread handles only a single TaskProcessor, so it's safe to store
+   * a token for the task processor in a thread-local variable.
+   */
+  thread_local moodycamel::ConsumerToken token(queue_);
+
+  queue_.wait_dequeue(token, buf);
+
+  if (!buf) {
+    // return "stop" token back
+    queue_.enqueue(nullptr);
+  }
+
+  return buf;
+}
+
+void TaskQueue::StopProcessing() { queue_.enqueue(nullptr); }
+
+std::size_t TaskQueue::GetSizeApproximate() const noexcept {
+  return queue_.size_approx();
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,223 @@
+#include <engine/task/work_stealing_queue/task_queue.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+namespace {
+
+// Consecutive tasks taken from the LIFO slot before the local queue gets a
+// chance. Protects from a pair of tasks waking up each other forever.
+constexpr std::size_t kMaxLifoStreak = 16;
+
+// The global queue is checked before the local one once in a while, otherwise
+// a busy worker could starve the tasks scheduled from outside.
+constexpr std::size_t kGlobalQueueCheckPeriod = 61;
+
+struct BoundConsumer final {
+  const void* queue{nullptr};
+  void* consumer{nullptr};
+};
+
+thread_local BoundConsumer bound_consumer;
+
+}  // namespace
+
+WorkStealingTaskQueue::Consumer::Consumer()
+    : producer_token(local_queue), consumer_token(local_queue) {}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(std::size_t consumers_count)
+    : consumers_(consumers_count) {
+  UINVARIANT(consumers_count > 0, "WorkStealingTaskQueue needs consumers");
+  for (std::size_t i = 0; i < consumers_.size(); ++i) {
+    consumers_[i]->index = i;
+  }
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::Push(impl::TaskContext* context) {
+  UASSERT(context);
+  auto* consumer = GetCurrentConsumer();
+
+  if (consumer) {
+    if (context == consumer->last_popped) {
+      // The running task rescheduled itself (e.g. engine::Yield), let the
+      // others run first.
+      consumer->local_queue.enqueue(consumer->producer_token, context);
+    } else {
+      auto* previous =
+          consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+      if (previous) {
+        consumer->local_queue.enqueue(consumer->producer_token, previous);
+      }
+    }
+    IncrementSingleWriter(consumer->pushed);
+  } else {
+    global_queue_.enqueue(context);
+    global_pushed_->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  WakeUpOneSleeper();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto& consumer = GetOrBindCurrentConsumer();
+
+  while (true) {
+    if (auto* context = TryPop(consumer)) return context;
+
+    sleepers_->fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Re-check after registering as a sleeper, otherwise a Push() that did
+    // not see us sleeping would be lost.
+    if (auto* context = TryPop(consumer)) {
+      CancelSleep();
+      return context;
+    }
+    if (is_stopped_.load()) {
+      CancelSleep();
+      return nullptr;
+    }
+
+    sleepers_semaphore_.wait();
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_ = true;
+  sleepers_semaphore_.signal(
+      static_cast<moodycamel::LightweightSemaphore::ssize_t>(
+          consumers_.size()));
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::int64_t size = global_pushed_->load(std::memory_order_relaxed);
+  for (const auto& consumer : consumers_) {
+    size += consumer->pushed.load(std::memory_order_relaxed);
+    size -= consumer->popped.load(std::memory_order_relaxed);
+  }
+  return static_cast<std::size_t>(std::max<std::int64_t>(size, 0));
+}
+
+WorkStealingTaskQueue::Consumer* WorkStealingTaskQueue::GetCurrentConsumer()
+    const noexcept {
+  if (bound_consumer.queue != this) return nullptr;
+  return static_cast<Consumer*>(bound_consumer.consumer);
+}
+
+WorkStealingTaskQueue::Consumer&
+WorkStealingTaskQueue::GetOrBindCurrentConsumer() {
+  if (auto* consumer = GetCurrentConsumer()) return *consumer;
+
+  const auto index = consumers_bound_.fetch_add(1);
+  UINVARIANT(index < consumers_.size(),
+             "Too many threads are consuming from WorkStealingTaskQueue");
+  UINVARIANT(!bound_consumer.queue,
+             "A thread may consume from a single WorkStealingTaskQueue only");
+
+  auto& consumer = *consumers_[index];
+  bound_consumer = {this, &consumer};
+  return consumer;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPop(Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+
+  if (++consumer.pops_since_global_check >= kGlobalQueueCheckPeriod) {
+    consumer.pops_since_global_check = 0;
+    context = TryPopGlobal();
+  }
+  if (!context) context = TryPopLocal(consumer);
+  if (!context) context = TryPopGlobal();
+  if (!context) context = TrySteal(consumer);
+
+  consumer.last_popped = context;
+  if (context) IncrementSingleWriter(consumer.popped);
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopLocal(Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+
+  if (consumer.lifo_streak < kMaxLifoStreak) {
+    context = consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++consumer.lifo_streak;
+      return context;
+    }
+  }
+
+  consumer.lifo_streak = 0;
+  if (consumer.local_queue.try_dequeue(consumer.consumer_token, context)) {
+    return context;
+  }
+  return consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal() {
+  impl::TaskContext* context = nullptr;
+  global_queue_.try_dequeue(context);
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& thief) {
+  const auto count = consumers_.size();
+  if (count == 1) return nullptr;
+
+  impl::TaskContext* context = nullptr;
+  const auto start = utils::RandRange(count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& victim = *consumers_[(start + i) % count];
+    if (&victim == &thief) continue;
+    if (victim.local_queue.try_dequeue(context)) return context;
+  }
+
+  // The victim is probably stuck in a long-running task, so its most recently
+  // woken task would wait for too long.
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& victim = *consumers_[(start + i) % count];
+    if (&victim == &thief) continue;
+    context = victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return context;
+  }
+
+  return nullptr;
+}
+
+void WorkStealingTaskQueue::WakeUpOneSleeper() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  auto sleepers = sleepers_->load(std::memory_order_seq_cst);
+  while (sleepers != 0) {
+    if (sleepers_->compare_exchange_weak(sleepers, sleepers - 1)) {
+      sleepers_semaphore_.signal();
+      return;
+    }
+  }
+}
+
+void WorkStealingTaskQueue::CancelSleep() noexcept {
+  // If some Push() has already decremented the counter on our behalf, the
+  // semaphore has an extra signal that would result in one spurious wakeup.
+  auto sleepers = sleepers_->load();
+  while (sleepers != 0) {
+    if (sleepers_->compare_exchange_weak(sleepers, sleepers - 1)) return;
+  }
+}
+
+void WorkStealingTaskQueue::IncrementSingleWriter(
+    std::atomic<std::int64_t>& counter) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// @brief A task queue with a local queue for each worker and work stealing.
+///
+/// Each worker thread owns a consumer with:
+/// * a LIFO slot for the task that was most recently woken up by the worker,
+///   so that the wakee runs next with hot caches;
+/// * a local FIFO queue that the other workers steal from when idle.
+///
+/// Tasks scheduled from threads that are not the workers of this queue
+/// (ev threads, other task processors) go to the shared global queue.
+///
+/// Workers park only after they failed to find anything to run, and are woken
+/// up by Push() only when there are parked workers.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(std::size_t consumers_count);
+
+  WorkStealingTaskQueue(const WorkStealingTaskQueue&) = delete;
+  WorkStealingTaskQueue& operator=(const WorkStealingTaskQueue&) = delete;
+  ~WorkStealingTaskQueue();
+
+  void Push(impl::TaskContext* context);
+
+  /// Must be called from at most consumers_count distinct threads. Each thread
+  /// is bound to its own consumer on the first call.
+  ///
+  /// Returns nullptr after StopProcessing() was called and there are no more
+  /// tasks in the queue.
+  impl::TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  // A consumer is only written to by its owning thread, except for the queue
+  // and the LIFO slot that are also accessed by the thieves.
+  struct Consumer final {
+    Consumer();
+
+    moodycamel::ConcurrentQueue<impl::TaskContext*> local_queue;
+    moodycamel::ProducerToken producer_token;
+    moodycamel::ConsumerToken consumer_token;
+    std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+
+    // Approximate size accounting, single writer each
+    std::atomic<std::int64_t> pushed{0};
+    std::atomic<std::int64_t> popped{0};
+
+    std::size_t index{0};
+    std::size_t lifo_streak{0};
+    std::size_t pops_since_global_check{0};
+    impl::TaskContext* last_popped{nullptr};
+  };
+
+  Consumer* GetCurrentConsumer() const noexcept;
+  Consumer& GetOrBindCurrentConsumer();
+
+  impl::TaskContext* TryPop(Consumer& consumer);
+  impl::TaskContext* TryPopLocal(Consumer& consumer);
+  impl::TaskContext* TryPopGlobal();
+  impl::TaskContext* TrySteal(Consumer& thief);
+
+  void WakeUpOneSleeper();
+  void CancelSleep() noexcept;
+
+  static void IncrementSingleWriter(std::atomic<std::int64_t>& counter) noexcept;
+
+  utils::FixedArray<concurrent::impl::InterferenceShield<Consumer>> consumers_;
+  std::atomic<std::size_t> consumers_bound_{0};
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  concurrent::impl::InterferenceShield<std::atomic<std::int64_t>>
+      global_pushed_{0};
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>> sleepers_{0};
+  moodycamel::LightweightSemaphore sleepers_semaphore_;
+  std::atomic<bool> is_stopped_{false};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
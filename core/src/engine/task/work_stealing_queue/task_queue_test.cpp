@@ -0,0 +1,111 @@
+#include <engine/task/work_stealing_queue/task_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The queue never dereferences the contexts, so fake pointers are enough
+engine::impl::TaskContext* MakeFakeContext(std::uintptr_t value) {
+  return reinterpret_cast<engine::impl::TaskContext*>(value << 4);
+}
+
+std::uintptr_t FromFakeContext(engine::impl::TaskContext* context) {
+  return reinterpret_cast<std::uintptr_t>(context) >> 4;
+}
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, ForeignPushAndStop) {
+  engine::WorkStealingTaskQueue queue{1};
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+
+  queue.Push(MakeFakeContext(1));
+  queue.Push(MakeFakeContext(2));
+  EXPECT_EQ(queue.GetSizeApproximate(), 2);
+
+  std::thread consumer([&queue] {
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 1);
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 2);
+    EXPECT_EQ(queue.PopBlocking(), nullptr);
+    EXPECT_EQ(queue.PopBlocking(), nullptr);
+  });
+
+  queue.StopProcessing();
+  consumer.join();
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+}
+
+TEST(WorkStealingTaskQueue, LifoSlot) {
+  engine::WorkStealingTaskQueue queue{1};
+
+  std::thread consumer([&queue] {
+    queue.Push(MakeFakeContext(1));
+    auto* current = queue.PopBlocking();
+    EXPECT_EQ(FromFakeContext(current), 1);
+
+    // The task woken last by the worker runs first
+    queue.Push(MakeFakeContext(2));
+    queue.Push(MakeFakeContext(3));
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 3);
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 2);
+
+    // A task that reschedules itself goes behind the others
+    queue.Push(MakeFakeContext(4));
+    current = queue.PopBlocking();
+    EXPECT_EQ(FromFakeContext(current), 4);
+    queue.Push(MakeFakeContext(5));
+    queue.Push(current);
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 5);
+    EXPECT_EQ(FromFakeContext(queue.PopBlocking()), 4);
+  });
+  consumer.join();
+
+  queue.StopProcessing();
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+}
+
+TEST(WorkStealingTaskQueue, Multithreaded) {
+  constexpr std::size_t kConsumersCount = 4;
+  constexpr std::size_t kTasksCount = 100000;
+  engine::WorkStealingTaskQueue queue{kConsumersCount};
+
+  std::vector<std::atomic<int>> seen(kTasksCount + 1);
+  std::atomic<std::size_t> popped{0};
+
+  std::vector<std::thread> consumers;
+  for (std::size_t i = 0; i < kConsumersCount; ++i) {
+    consumers.emplace_back([&, i] {
+      // Only the first consumer produces, so the others have to steal
+      if (i == 0) {
+        for (std::size_t value = 1; value <= kTasksCount / 2; ++value) {
+          queue.Push(MakeFakeContext(value));
+        }
+      }
+      while (auto* context = queue.PopBlocking()) {
+        ++seen[FromFakeContext(context)];
+        if (++popped == kTasksCount) queue.StopProcessing();
+      }
+    });
+  }
+
+  for (std::size_t value = kTasksCount / 2 + 1; value <= kTasksCount; ++value) {
+    queue.Push(MakeFakeContext(value));
+  }
+
+  for (auto& consumer : consumers) consumer.join();
+
+  EXPECT_EQ(popped.load(), kTasksCount);
+  for (std::size_t value = 1; value <= kTasksCount; ++value) {
+    ASSERT_EQ(seen[value].load(), 1) << value;
+  }
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -1,19 +1,159 @@
 #include <userver/fs/fs_cache_client.hpp>
 
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+
+#include <compression/gzip.hpp>
+#include <fs/inotify_watcher.hpp>
+
+#include <userver/crypto/hash.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace fs {
 
+namespace {
+
+constexpr std::string_view kGzipSuffix = ".gz";
+
+bool EndsWith(std::string_view str, std::string_view suffix) {
+  return str.size() >= suffix.size() &&
+         str.substr(str.size() - suffix.size()) == suffix;
+}
+
+bool IsHiddenFile(const boost::filesystem::path& path) {
+  auto name = path.filename().native();
+  return !name.empty() && name != ".." && name != "." && name[0] == '.';
+}
+
+std::string GetRelative(std::string_view path, std::string_view dir) {
+  UASSERT(dir.size() < path.size());
+  return std::string{path.substr(dir.size())};
+}
+
+std::shared_ptr<const char> MapFile(const fs::blocking::FileDescriptor& file,
+                                    std::size_t size) {
+  void* data =
+      ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.GetNative(), 0);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error(
+        fmt::format("mmap failed: {}", std::strerror(errno)));
+  }
+  // the mapping outlives the file descriptor
+  return std::shared_ptr<const char>(
+      static_cast<const char*>(data), [size](const char* mapped) {
+        ::munmap(const_cast<char*>(mapped), size);
+      });
+}
+
+FileInfoWithDataConstPtr ReadFile(const boost::filesystem::path& path,
+                                  const FsCacheStorageSettings& settings) {
+  FileInfoWithData info{};
+  info.extension = path.extension().string();
+
+  const auto file = fs::blocking::FileDescriptor::Open(
+      path.string(), fs::blocking::OpenFlag::kRead);
+  info.size = file.GetSize();
+  // mmap fails for empty files
+  if (settings.mmap_min_size != 0 && info.size != 0 &&
+      info.size >= settings.mmap_min_size) {
+    info.mapping = MapFile(file, info.size);
+  } else {
+    info.data = fs::blocking::ReadFileContents(path.string());
+    info.size = info.data.size();
+  }
+  info.etag = '"' +
+              crypto::hash::Sha1(info.GetContents(),
+                                 crypto::hash::OutputEncoding::kBase64) +
+              '"';
+  return std::make_shared<const FileInfoWithData>(std::move(info));
+}
+
+// Directories are added to the watcher before their files are read, so that
+// no change is lost between the read and the watch
+FileInfoWithDataMap ReadFiles(const std::string& dir,
+                              const FsCacheStorageSettings& settings,
+                              impl::InotifyWatcher* watcher) {
+  if (watcher) watcher->AddWatch(dir);
+
+  FileInfoWithDataMap files;
+  for (const auto& f : boost::filesystem::recursive_directory_iterator(dir)) {
+    const auto type = f.status().type();
+    if (type == boost::filesystem::directory_file && watcher) {
+      watcher->AddWatch(f.path().string());
+    }
+    if (type != boost::filesystem::regular_file || IsHiddenFile(f.path())) {
+      continue;
+    }
+    files[GetRelative(f.path().string(), dir)] = ReadFile(f.path(), settings);
+  }
+  return files;
+}
+
+void AddGzipVariants(FileInfoWithDataMap& files, engine::TaskProcessor& tp,
+                     const FsCacheCompressionSettings& settings) {
+  for (auto& [path, file] : files) {
+    if (EndsWith(path, kGzipSuffix)) continue;
+
+    const auto contents = file->GetContents();
+    std::string gzip_data;
+    if (const auto it = files.find(path + std::string{kGzipSuffix});
+        it != files.end()) {
+      gzip_data = std::string{it->second->GetContents()};
+    } else if (contents.size() >= settings.min_size) {
+      gzip_data = engine::AsyncNoSpan(tp, [contents, &settings] {
+                    return compression::gzip::Compress(contents,
+                                                       settings.gzip_level);
+                  }).Get();
+    }
+    if (gzip_data.empty() || gzip_data.size() >= contents.size()) continue;
+
+    auto info = std::make_shared<FileInfoWithData>(*file);
+    info->gzip_data = std::move(gzip_data);
+    file = std::move(info);
+  }
+}
+
+}  // namespace
+
 FsCacheClient::FsCacheClient(std::string_view dir,
                              std::chrono::milliseconds update_period,
-                             engine::TaskProcessor& tp)
-    : dir_(dir), update_period_(update_period), tp_(tp) {
+                             engine::TaskProcessor& tp,
+                             const FsCacheCompressionSettings& compression,
+                             const FsCacheStorageSettings& storage)
+    : dir_(dir),
+      update_period_(update_period),
+      tp_(tp),
+      compression_(compression),
+      storage_(storage) {
+  if (storage_.watch_changes) {
+    watcher_ = std::make_unique<impl::InotifyWatcher>();
+  }
   UpdateCache();
 
+  if (watcher_) {
+    watcher_task_ = engine::CriticalAsyncNoSpan(
+        engine::current_task::GetTaskProcessor(), [this] { WatchChanges(); });
+    return;
+  }
+
   if (update_period_ == std::chrono::milliseconds(0)) {
     return;
   }
@@ -23,9 +163,15 @@ FsCacheClient::FsCacheClient(std::string_view dir,
                        [this] { UpdateCache(); });
 }
 
+FsCacheClient::~FsCacheClient() {
+  if (watcher_task_.IsValid()) watcher_task_.SyncCancel();
+}
+
 void FsCacheClient::UpdateCache() {
-  auto map = fs::ReadRecursiveFilesInfoWithData(
-      tp_, dir_, {fs::SettingsReadFile::kSkipHidden});
+  auto map = engine::AsyncNoSpan(tp_, [this] {
+               return ReadFiles(dir_, storage_, watcher_.get());
+             }).Get();
+  if (compression_.gzip) AddGzipVariants(map, tp_, compression_);
   data_.Assign(std::move(map));
 }
 
@@ -38,6 +184,70 @@ FileInfoWithDataConstPtr FsCacheClient::TryGetFile(
   return nullptr;
 }
 
+void FsCacheClient::WatchChanges() {
+  while (!engine::current_task::ShouldCancel()) {
+    const auto events = watcher_->WaitEvents({});
+    if (events.empty()) continue;
+
+    try {
+      std::set<std::string> paths;
+      bool is_full_update_needed = false;
+      for (const auto& event : events) {
+        // new directories need watches, and the lost events are unknown
+        if (event.path.empty() || event.is_directory) {
+          is_full_update_needed = true;
+          break;
+        }
+        if (IsHiddenFile(event.path)) continue;
+
+        auto path = GetRelative(event.path, dir_);
+        // a file and its gzip variant are updated together
+        if (EndsWith(path, kGzipSuffix)) {
+          path.resize(path.size() - kGzipSuffix.size());
+        }
+        paths.insert(std::move(path));
+      }
+
+      if (is_full_update_needed) {
+        UpdateCache();
+      } else if (!paths.empty()) {
+        UpdateFiles({paths.begin(), paths.end()});
+      }
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to update the files of '" << dir_ << "': " << ex;
+    }
+  }
+}
+
+void FsCacheClient::UpdateFiles(const std::vector<std::string>& paths) {
+  std::vector<std::string> keys;
+  for (const auto& path : paths) {
+    keys.push_back(path);
+    keys.push_back(path + std::string{kGzipSuffix});
+  }
+
+  auto files = engine::AsyncNoSpan(tp_, [this, &keys] {
+                 FileInfoWithDataMap files;
+                 for (const auto& key : keys) {
+                   const boost::filesystem::path path{dir_ + key};
+                   if (!boost::filesystem::is_regular_file(path)) continue;
+                   files[key] = ReadFile(path, storage_);
+                 }
+                 return files;
+               }).Get();
+  if (compression_.gzip) AddGzipVariants(files, tp_, compression_);
+
+  auto map = data_.StartWrite();
+  for (const auto& key : keys) {
+    if (const auto it = files.find(key); it != files.end()) {
+      (*map)[key] = it->second;
+    } else {
+      map->erase(key);
+    }
+  }
+  map.Commit();
+}
+
 }  // namespace fs
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,145 @@
+#include <userver/utest/utest.hpp>
+
+#include <compression/gzip.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/fs/fs_cache_client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr size_t kMaxSize = 1024 * 1024;
+
+const std::string kCompressible(4096, 'a');
+
+// waits for the watcher to pick up the changes
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  const auto deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{10});
+  while (!predicate()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  return true;
+}
+
+}  // namespace
+
+UTEST(FsCacheClient, NoCompressionByDefault) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/file.txt",
+                                    kCompressible);
+
+  const fs::FsCacheClient client{dir.GetPath(), std::chrono::milliseconds{0},
+                                 engine::current_task::GetTaskProcessor()};
+  const auto file = client.TryGetFile("/file.txt");
+  ASSERT_TRUE(file);
+  EXPECT_EQ(file->data, kCompressible);
+  EXPECT_TRUE(file->gzip_data.empty());
+}
+
+UTEST(FsCacheClient, GzipVariants) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/big.txt", kCompressible);
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/small.txt", "aaaa");
+
+  const auto precompressed = compression::gzip::Compress(kCompressible, 1);
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/other.js",
+                                    kCompressible);
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/other.js.gz",
+                                    precompressed);
+
+  fs::FsCacheCompressionSettings settings;
+  settings.gzip = true;
+  settings.min_size = 100;
+  const fs::FsCacheClient client{dir.GetPath(), std::chrono::milliseconds{0},
+                                 engine::current_task::GetTaskProcessor(),
+                                 settings};
+
+  const auto big = client.TryGetFile("/big.txt");
+  ASSERT_TRUE(big);
+  EXPECT_EQ(big->data, kCompressible);
+  EXPECT_EQ(compression::gzip::Decompress(big->gzip_data, kMaxSize),
+            kCompressible);
+
+  const auto small = client.TryGetFile("/small.txt");
+  ASSERT_TRUE(small);
+  EXPECT_TRUE(small->gzip_data.empty());
+
+  // the existing .gz file is used as is
+  const auto other = client.TryGetFile("/other.js");
+  ASSERT_TRUE(other);
+  EXPECT_EQ(other->gzip_data, precompressed);
+}
+
+UTEST(FsCacheClient, MappedFiles) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/big.txt", kCompressible);
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/copy.txt",
+                                    kCompressible);
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/small.txt", "aaaa");
+
+  fs::FsCacheStorageSettings settings;
+  settings.mmap_min_size = 100;
+  const fs::FsCacheClient client{dir.GetPath(), std::chrono::milliseconds{0},
+                                 engine::current_task::GetTaskProcessor(),
+                                 {}, settings};
+
+  const auto big = client.TryGetFile("/big.txt");
+  ASSERT_TRUE(big);
+  EXPECT_TRUE(big->mapping);
+  EXPECT_TRUE(big->data.empty());
+  EXPECT_EQ(big->GetContents(), kCompressible);
+
+  const auto small = client.TryGetFile("/small.txt");
+  ASSERT_TRUE(small);
+  EXPECT_FALSE(small->mapping);
+  EXPECT_EQ(small->GetContents(), "aaaa");
+
+  const auto copy = client.TryGetFile("/copy.txt");
+  ASSERT_TRUE(copy);
+  EXPECT_FALSE(big->etag.empty());
+  EXPECT_EQ(big->etag, copy->etag);
+  EXPECT_NE(big->etag, small->etag);
+}
+
+#ifdef __linux__
+UTEST(FsCacheClient, WatchChanges) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/file.txt", "old");
+
+  fs::FsCacheCompressionSettings compression;
+  compression.gzip = true;
+  compression.min_size = 100;
+  fs::FsCacheStorageSettings storage;
+  storage.watch_changes = true;
+  const fs::FsCacheClient client{dir.GetPath(), std::chrono::milliseconds{0},
+                                 engine::current_task::GetTaskProcessor(),
+                                 compression, storage};
+
+  const auto contents_of = [&client](std::string_view path) {
+    const auto file = client.TryGetFile(path);
+    return file ? std::string{file->GetContents()} : std::string{};
+  };
+  ASSERT_EQ(contents_of("/file.txt"), "old");
+
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/file.txt",
+                                    kCompressible);
+  ASSERT_TRUE(
+      WaitFor([&] { return contents_of("/file.txt") == kCompressible; }));
+  EXPECT_FALSE(client.TryGetFile("/file.txt")->gzip_data.empty());
+
+  fs::blocking::CreateDirectories(dir.GetPath() + "/sub");
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/sub/new.txt", "new");
+  ASSERT_TRUE(WaitFor([&] { return contents_of("/sub/new.txt") == "new"; }));
+
+  fs::blocking::RemoveSingleFile(dir.GetPath() + "/file.txt");
+  ASSERT_TRUE(WaitFor([&] { return !client.TryGetFile("/file.txt"); }));
+}
+#endif
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#include <fs/inotify_watcher.hpp>
+
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+#include <boost/filesystem/path.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+namespace {
+
+#ifdef __linux__
+constexpr std::uint32_t kWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                                     IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+}  // namespace
+
+InotifyWatcher::InotifyWatcher() {
+#ifdef __linux__
+  fd_ = utils::CheckSyscall(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC),
+                            "initializing inotify");
+  poller_.Reset(fd_, engine::io::FdPoller::Kind::kRead);
+#else
+  throw std::runtime_error("inotify is not supported on this platform");
+#endif
+}
+
+InotifyWatcher::~InotifyWatcher() {
+  poller_.Invalidate();
+  ::close(fd_);
+}
+
+void InotifyWatcher::AddWatch(const std::string& dir) {
+#ifdef __linux__
+  const auto wd = utils::CheckSyscall(
+      ::inotify_add_watch(fd_, dir.c_str(), kWatchMask),
+      "adding an inotify watch for '{}'", dir);
+  std::lock_guard lock(dirs_mutex_);
+  dirs_[wd] = dir;
+#else
+  (void)dir;
+#endif
+}
+
+std::vector<InotifyWatcher::Event> InotifyWatcher::WaitEvents(
+    engine::Deadline deadline) {
+  std::vector<Event> events;
+#ifdef __linux__
+  alignas(struct inotify_event) char buffer[4096];
+  while (true) {
+    const auto size = ::read(fd_, buffer, sizeof(buffer));
+    if (size < 0) {
+      if (errno == EINTR) continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        throw std::system_error(errno, std::system_category(),
+                                "Error while reading inotify events");
+      }
+      // report all the events that have accumulated so far at once
+      if (!events.empty() || !poller_.Wait(deadline)) return events;
+      continue;
+    }
+
+    for (ssize_t offset = 0; offset < size;) {
+      const auto* event =
+          reinterpret_cast<const struct inotify_event*>(buffer + offset);
+      offset += sizeof(struct inotify_event) + event->len;
+      HandleEvent(event, events);
+    }
+  }
+#else
+  (void)deadline;
+  return events;
+#endif
+}
+
+void InotifyWatcher::HandleEvent([[maybe_unused]] const void* raw_event,
+                                 [[maybe_unused]] std::vector<Event>& events) {
+#ifdef __linux__
+  const auto& event = *static_cast<const struct inotify_event*>(raw_event);
+  if (event.mask & IN_Q_OVERFLOW) {
+    events.push_back({});
+    return;
+  }
+
+  std::lock_guard lock(dirs_mutex_);
+  const auto it = dirs_.find(event.wd);
+  if (it == dirs_.end()) return;
+  if (event.mask & IN_IGNORED) {
+    // the directory was removed, its parent reports the removal
+    dirs_.erase(it);
+    return;
+  }
+  if (event.len == 0) return;
+
+  Event result;
+  result.path = (boost::filesystem::path{it->second} / event.name).string();
+  result.is_directory = event.mask & IN_ISDIR;
+  events.push_back(std::move(result));
+#endif
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/io/fd_poller.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+/// Watches the entries of the directories through inotify, Linux only
+class InotifyWatcher final {
+ public:
+  struct Event {
+    /// Path of the changed entry, empty if the events were lost
+    std::string path;
+    bool is_directory{false};
+  };
+
+  /// @throws std::system_error or std::runtime_error if inotify is not
+  /// available
+  InotifyWatcher();
+  ~InotifyWatcher();
+
+  InotifyWatcher(const InotifyWatcher&) = delete;
+  InotifyWatcher& operator=(const InotifyWatcher&) = delete;
+
+  /// Starts watching the entries of `dir`, the subdirectories should be added
+  /// separately. Thread safe.
+  void AddWatch(const std::string& dir);
+
+  /// Waits for the changes, returns an empty vector on deadline or
+  /// cancellation. Must not be called concurrently.
+  std::vector<Event> WaitEvents(engine::Deadline deadline);
+
+ private:
+  void HandleEvent(const void* raw_event, std::vector<Event>& events);
+
+  int fd_{-1};
+  engine::io::FdPoller poller_;
+  engine::Mutex dirs_mutex_;
+  std::unordered_map<int, std::string> dirs_;
+};
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
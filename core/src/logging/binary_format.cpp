@@ -0,0 +1,200 @@
+#include <logging/binary_format.hpp>
+
+#include <chrono>
+#include <iterator>
+#include <string>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <logging/spdlog.hpp>
+#include <userver/logging/binary_log.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/trivial_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::binary {
+
+namespace {
+
+// Tags must never be changed or reused, new keys are appended
+constexpr utils::TrivialBiMap kTags = [](auto selector) {
+  return selector()
+      .Case("timestamp", kTimestampTag)
+      .Case("level", kLevelTag)
+      .Case("module", std::uint64_t{3})
+      .Case("task_id", std::uint64_t{4})
+      .Case("thread_id", std::uint64_t{5})
+      .Case("text", std::uint64_t{6})
+      .Case("trace_id", std::uint64_t{7})
+      .Case("span_id", std::uint64_t{8})
+      .Case("parent_id", std::uint64_t{9})
+      .Case("stopwatch_name", std::uint64_t{10})
+      .Case("total_time", std::uint64_t{11})
+      .Case("span_ref_type", std::uint64_t{12})
+      .Case("stopwatch_units", std::uint64_t{13})
+      .Case("start_timestamp", std::uint64_t{14})
+      .Case("link", std::uint64_t{15})
+      .Case("meta_type", std::uint64_t{16})
+      .Case("meta_code", std::uint64_t{17})
+      .Case("error", std::uint64_t{18});
+};
+
+template <typename Buffer>
+void AppendUnsignedField(Buffer& buffer, std::uint64_t tag,
+                         std::uint64_t value) {
+  AppendVarint(buffer, tag);
+  buffer.push_back(static_cast<char>(ValueType::kUnsigned));
+  AppendVarint(buffer, value);
+}
+
+struct PutCharToBuffer final {
+  template <typename Buffer>
+  void operator()(Buffer& buffer, char ch) const {
+    buffer.push_back(ch);
+  }
+};
+
+}  // namespace
+
+std::uint64_t FindTag(std::string_view key) noexcept {
+  return kTags.TryFindByFirst(key).value_or(kInlineKeyTag);
+}
+
+std::string_view FindKey(std::uint64_t tag) noexcept {
+  return kTags.TryFindBySecond(tag).value_or(std::string_view{});
+}
+
+std::uint64_t RecordReader::ReadVarint() {
+  std::uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const auto byte = static_cast<std::uint8_t>(ReadBytes(1)[0]);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return value;
+  }
+  Throw("varint is too long");
+}
+
+std::string_view RecordReader::ReadString() {
+  const auto size = ReadVarint();
+  if (size > record_.size() - pos_) Throw("string exceeds the record");
+  return ReadBytes(size);
+}
+
+ValueType RecordReader::ReadValueType() {
+  const auto type = static_cast<std::uint8_t>(ReadBytes(1)[0]);
+  if (type > static_cast<std::uint8_t>(ValueType::kSigned)) {
+    Throw(fmt::format("unknown value type {}", type));
+  }
+  return static_cast<ValueType>(type);
+}
+
+std::uint64_t RecordReader::ReadUnsignedField(std::uint64_t expected_tag) {
+  if (ReadVarint() != expected_tag ||
+      ReadValueType() != ValueType::kUnsigned) {
+    Throw("record must start with the timestamp and the level");
+  }
+  return ReadVarint();
+}
+
+void RecordReader::Throw(std::string_view what) const {
+  throw BinaryLogError(fmt::format(
+      "Malformed binary log record at offset {}: {}", record_offset_, what));
+}
+
+std::string_view RecordReader::ReadBytes(std::size_t size) {
+  if (record_.size() - pos_ < size) Throw("unexpected end of record");
+  const auto result = record_.substr(pos_, size);
+  pos_ += size;
+  return result;
+}
+
+template <typename Buffer>
+void AppendTskvFields(Buffer& buffer, RecordReader& reader) {
+  while (!reader.IsEnd()) {
+    buffer.push_back(utils::encoding::kTskvPairsSeparator);
+
+    const auto tag = reader.ReadVarint();
+    auto key = kInlineKeyTag == tag ? reader.ReadString() : FindKey(tag);
+    if (key.empty()) reader.Throw(fmt::format("unknown tag {}", tag));
+    utils::encoding::EncodeTskv(
+        buffer, key.begin(), key.end(),
+        utils::encoding::EncodeTskvMode::kKeyReplacePeriod, PutCharToBuffer{});
+    buffer.push_back(utils::encoding::kTskvKeyValueSeparator);
+
+    switch (reader.ReadValueType()) {
+      case ValueType::kString: {
+        const auto value = reader.ReadString();
+        utils::encoding::EncodeTskv(buffer, value.begin(), value.end(),
+                                    utils::encoding::EncodeTskvMode::kValue,
+                                    PutCharToBuffer{});
+        break;
+      }
+      case ValueType::kUnsigned:
+        fmt::format_to(std::back_inserter(buffer), "{}", reader.ReadVarint());
+        break;
+      case ValueType::kSigned:
+        fmt::format_to(std::back_inserter(buffer), "{}",
+                       ZigZagDecode(reader.ReadVarint()));
+        break;
+    }
+  }
+}
+
+template void AppendTskvFields(std::string&, RecordReader&);
+template void AppendTskvFields(spdlog::memory_buf_t&, RecordReader&);
+
+void Formatter::format(const spdlog::details::log_msg& msg,
+                       spdlog::memory_buf_t& dest) {
+  const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                             msg.time.time_since_epoch())
+                             .count();
+
+  fmt::basic_memory_buffer<char, 2 * (2 + kMaxVarintSize)> header;
+  AppendUnsignedField(header, kTimestampTag,
+                      static_cast<std::uint64_t>(timestamp));
+  AppendUnsignedField(header, kLevelTag, static_cast<std::uint64_t>(msg.level));
+
+  AppendVarint(dest, header.size() + msg.payload.size());
+  dest.append(header.data(), header.data() + header.size());
+  dest.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+}
+
+std::unique_ptr<spdlog::formatter> Formatter::clone() const {
+  return std::make_unique<Formatter>();
+}
+
+void TskvFormatter::format(const spdlog::details::log_msg& msg,
+                           spdlog::memory_buf_t& dest) {
+  const auto since_epoch = msg.time.time_since_epoch();
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  // localtime_r is slow, the date and time are reformatted once a second
+  if (seconds.count() != cached_seconds_) {
+    cached_seconds_ = seconds.count();
+    std::tm tm{};
+    ::localtime_r(&cached_seconds_, &tm);
+    cached_datetime_ = fmt::format("{:%Y-%m-%dT%H:%M:%S}", tm);
+  }
+  const auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(since_epoch -
+                                                            seconds);
+
+  fmt::format_to(std::back_inserter(dest), "tskv\ttimestamp={}.{:06}\tlevel=",
+                 cached_datetime_, microseconds.count());
+  const auto level_name = spdlog::level::to_string_view(msg.level);
+  dest.append(level_name.data(), level_name.data() + level_name.size());
+
+  RecordReader reader{{msg.payload.data(), msg.payload.size()}, 0};
+  AppendTskvFields(dest, reader);
+  dest.push_back('\n');
+}
+
+std::unique_ptr<spdlog::formatter> TskvFormatter::clone() const {
+  return std::make_unique<TskvFormatter>();
+}
+
+}  // namespace logging::binary
+
+USERVER_NAMESPACE_END
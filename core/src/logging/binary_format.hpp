@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <spdlog/formatter.h>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Binary log format, see userver/logging/binary_log.hpp for the layout
+namespace logging::binary {
+
+enum class ValueType : std::uint8_t {
+  kString = 0,
+  kUnsigned = 1,
+  kSigned = 2,
+};
+
+/// The key is not in the dictionary and is written inline after the tag
+inline constexpr std::uint64_t kInlineKeyTag = 0;
+inline constexpr std::uint64_t kTimestampTag = 1;
+inline constexpr std::uint64_t kLevelTag = 2;
+
+/// @returns the tag of the key or kInlineKeyTag
+std::uint64_t FindTag(std::string_view key) noexcept;
+
+/// @returns the key of the tag or an empty string_view for unknown tags
+std::string_view FindKey(std::uint64_t tag) noexcept;
+
+inline constexpr std::size_t kMaxVarintSize = 10;
+
+constexpr std::size_t GetVarintSize(std::uint64_t value) noexcept {
+  std::size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+/// Writes LEB128 into `out`, returns the number of bytes written
+inline std::size_t WriteVarint(char* out, std::uint64_t value) noexcept {
+  std::size_t size = 0;
+  while (value >= 0x80) {
+    out[size++] = static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out[size++] = static_cast<char>(value);
+  return size;
+}
+
+template <typename Buffer>
+void AppendVarint(Buffer& buffer, std::uint64_t value) {
+  char bytes[kMaxVarintSize];
+  const auto size = WriteVarint(bytes, value);
+  buffer.append(bytes, bytes + size);
+}
+
+constexpr std::uint64_t ZigZagEncode(std::int64_t value) noexcept {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+constexpr std::int64_t ZigZagDecode(std::uint64_t value) noexcept {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+/// Reads the fields of a record, throws logging::BinaryLogError on malformed
+/// input
+class RecordReader final {
+ public:
+  RecordReader(std::string_view record, std::size_t record_offset)
+      : record_(record), record_offset_(record_offset) {}
+
+  bool IsEnd() const noexcept { return pos_ == record_.size(); }
+
+  std::uint64_t ReadVarint();
+  std::string_view ReadString();
+  ValueType ReadValueType();
+  std::uint64_t ReadUnsignedField(std::uint64_t expected_tag);
+
+  [[noreturn]] void Throw(std::string_view what) const;
+
+ private:
+  std::string_view ReadBytes(std::size_t size);
+
+  const std::string_view record_;
+  const std::size_t record_offset_;
+  std::size_t pos_{0};
+};
+
+/// Appends the rest of the fields of the record as TSKV pairs, each one
+/// preceded by the pairs separator. Instantiated for std::string and
+/// spdlog::memory_buf_t.
+template <typename Buffer>
+void AppendTskvFields(Buffer& buffer, RecordReader& reader);
+
+/// Prepends the record size, the timestamp and the level to the fields
+/// written by the logging::LogHelper.
+class Formatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override;
+
+  std::unique_ptr<spdlog::formatter> clone() const override;
+};
+
+/// Formats the fields written by the logging::LogHelper in the binary form as
+/// a TSKV line, for logging::Format::kTskvDeferred. Runs in the sink, i.e. on
+/// the logger's own task for the asynchronous loggers.
+class TskvFormatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override;
+
+  std::unique_ptr<spdlog::formatter> clone() const override;
+
+ private:
+  std::time_t cached_seconds_{-1};
+  std::string cached_datetime_;
+};
+
+}  // namespace logging::binary
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#include <userver/logging/binary_log.hpp>
+
+#include <ctime>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <logging/binary_format.hpp>
+#include <logging/spdlog.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+namespace {
+
+// Guards against allocating the memory for a size read from a corrupted log
+constexpr std::uint64_t kMaxRecordSize = 64 * 1024 * 1024;
+
+// Returns false on the end of the input
+bool ReadRecordSize(std::istream& in, std::size_t offset, std::uint64_t& size) {
+  size = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const auto c = in.get();
+    if (c == std::istream::traits_type::eof()) {
+      if (shift == 0) return false;
+      break;
+    }
+    size |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+    if (!(c & 0x80)) return true;
+  }
+  throw BinaryLogError(
+      fmt::format("Malformed binary log record size at offset {}", offset));
+}
+
+void AppendTimestamp(std::string& line, std::uint64_t timestamp_us) {
+  const auto seconds = static_cast<std::time_t>(timestamp_us / 1'000'000);
+  std::tm tm{};
+  ::localtime_r(&seconds, &tm);
+  fmt::format_to(std::back_inserter(line), "{:%Y-%m-%dT%H:%M:%S}.{:06}", tm,
+                 timestamp_us % 1'000'000);
+}
+
+void AppendRecord(std::string& line, binary::RecordReader& reader) {
+  const auto timestamp = reader.ReadUnsignedField(binary::kTimestampTag);
+  const auto level = reader.ReadUnsignedField(binary::kLevelTag);
+  if (level > spdlog::level::off) reader.Throw("unknown level");
+
+  line += "tskv\ttimestamp=";
+  AppendTimestamp(line, timestamp);
+  line += "\tlevel=";
+  const auto level_name = spdlog::level::to_string_view(
+      static_cast<spdlog::level::level_enum>(level));
+  line.append(level_name.data(), level_name.size());
+
+  binary::AppendTskvFields(line, reader);
+  line += '\n';
+}
+
+}  // namespace
+
+void ConvertBinaryLogToTskv(std::istream& binary, std::ostream& tskv) {
+  std::string record;
+  std::string line;
+  std::size_t offset = 0;
+  std::uint64_t size = 0;
+
+  while (ReadRecordSize(binary, offset, size)) {
+    if (size > kMaxRecordSize) {
+      throw BinaryLogError(fmt::format(
+          "Binary log record at offset {} is too big: {}", offset, size));
+    }
+    offset += binary::GetVarintSize(size);
+    record.resize(size);
+    if (!binary.read(record.data(), record.size())) {
+      throw BinaryLogError(
+          fmt::format("Truncated binary log record at offset {}", offset));
+    }
+
+    binary::RecordReader reader{record, offset};
+    line.clear();
+    AppendRecord(line, reader);
+    tskv.write(line.data(), line.size());
+    offset += size;
+  }
+}
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
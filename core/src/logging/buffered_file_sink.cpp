@@ -0,0 +1,145 @@
+#include "buffered_file_sink.hpp"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+#include <utils/strerror.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+constexpr std::size_t kBufferAlignment = 4096;
+
+std::size_t RoundUpCapacity(std::size_t buffer_size) {
+  if (buffer_size == 0) return kBufferAlignment;
+  return (buffer_size + kBufferAlignment - 1) / kBufferAlignment *
+         kBufferAlignment;
+}
+
+char* AllocateBuffer(std::size_t capacity) {
+  void* buffer = nullptr;
+  if (::posix_memalign(&buffer, kBufferAlignment, capacity) != 0) {
+    throw std::bad_alloc();
+  }
+  return static_cast<char*>(buffer);
+}
+
+}  // namespace
+
+void BufferedFileWriter::FreeDeleter::operator()(char* p) const noexcept {
+  std::free(p);
+}
+
+BufferedFileWriter::BufferedFileWriter(std::string filename,
+                                       std::size_t buffer_size)
+    : filename_(std::move(filename)),
+      capacity_(RoundUpCapacity(buffer_size)),
+      buffer_(AllocateBuffer(capacity_)) {
+  Open(false);
+
+  const auto file_size = utils::CheckSyscall(
+      ::lseek(fd_, 0, SEEK_END), "getting the size of log file '{}'",
+      filename_);
+  if (file_size > 0) Write("\n");
+}
+
+BufferedFileWriter::~BufferedFileWriter() {
+  try {
+    Close();
+  } catch (const std::exception& e) {
+    std::cerr << "Error while closing log file '" << filename_
+              << "': " << e.what() << std::endl;
+  }
+}
+
+void BufferedFileWriter::Write(std::string_view data) {
+  if (data.size() <= capacity_ - size_) {
+    std::memcpy(buffer_.get() + size_, data.data(), data.size());
+    size_ += data.size();
+    return;
+  }
+
+  // the message goes to the file right after the buffered data in the same
+  // writev() call, without copying
+  WriteAll(data);
+}
+
+void BufferedFileWriter::Flush() {
+  if (size_ != 0) WriteAll({});
+}
+
+void BufferedFileWriter::Reopen(bool truncate) {
+  Close();
+  Open(truncate);
+}
+
+void BufferedFileWriter::Close() {
+  if (fd_ == -1) return;
+
+  try {
+    Flush();
+  } catch (...) {
+    ::close(fd_);
+    fd_ = -1;
+    throw;
+  }
+
+  if (::close(fd_) == -1) {
+    std::cerr << "Error while closing log file '" << filename_
+              << "': " << utils::strerror(errno) << std::endl;
+  }
+  fd_ = -1;
+}
+
+void BufferedFileWriter::Open(bool truncate) {
+  UASSERT(fd_ == -1);
+  const int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC |
+                    (truncate ? O_TRUNC : 0);
+  fd_ = utils::CheckSyscall(::open(filename_.c_str(), flags, 0644),
+                            "opening log file '{}'", filename_);
+}
+
+void BufferedFileWriter::WriteAll(std::string_view tail) {
+  struct iovec iov[2] = {
+      {buffer_.get(), size_},
+      {const_cast<char*>(tail.data()), tail.size()},
+  };
+  struct iovec* current = iov;
+  int count = tail.empty() ? 1 : 2;
+
+  // whatever happens, the buffered data must not be written twice
+  size_ = 0;
+
+  while (count > 0) {
+    const auto written = ::writev(fd_, current, count);
+    if (written == -1 && errno == EINTR) continue;
+    auto left = static_cast<std::size_t>(utils::CheckSyscall(
+        written, "writing to log file '{}'", filename_));
+
+    while (count > 0 && left >= current->iov_len) {
+      left -= current->iov_len;
+      ++current;
+      --count;
+    }
+    if (count > 0) {
+      current->iov_base = static_cast<char*>(current->iov_base) + left;
+      current->iov_len -= left;
+    }
+  }
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
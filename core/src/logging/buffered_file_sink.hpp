@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+namespace impl {
+
+/// Appends data to a file through a page aligned buffer. The buffer is
+/// written out with a single writev() call when it gets full or on Flush().
+class BufferedFileWriter final {
+ public:
+  BufferedFileWriter(std::string filename, std::size_t buffer_size);
+
+  BufferedFileWriter(const BufferedFileWriter&) = delete;
+  BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+  ~BufferedFileWriter();
+
+  void Write(std::string_view data);
+  void Flush();
+
+  /// Writes out the buffered data and reopens the file by its name
+  void Reopen(bool truncate);
+  void Close();
+
+ private:
+  struct FreeDeleter {
+    void operator()(char* p) const noexcept;
+  };
+
+  void Open(bool truncate);
+  void WriteAll(std::string_view tail);
+
+  const std::string filename_;
+  const std::size_t capacity_;
+  const std::unique_ptr<char, FreeDeleter> buffer_;
+  std::size_t size_{0};
+  int fd_{-1};
+};
+
+}  // namespace impl
+
+/// File sink that gathers messages in a big buffer to issue fewer write
+/// syscalls. The buffer is written out when full, on flush and on reopen.
+template <typename Mutex>
+class BufferedFileSink final : public spdlog::sinks::base_sink<Mutex> {
+ public:
+  using filename_t = spdlog::filename_t;
+  using sink = spdlog::sinks::base_sink<Mutex>;
+
+  BufferedFileSink(filename_t filename, std::size_t buffer_size)
+      : writer_(std::move(filename), buffer_size) {}
+
+  void Reopen(bool truncate) {
+    std::lock_guard<Mutex> lock(this->mutex_);
+    writer_.Reopen(truncate);
+  }
+
+  void Close() {
+    std::lock_guard<Mutex> lock(this->mutex_);
+    writer_.Close();
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override {
+    spdlog::memory_buf_t formatted;
+    sink::formatter_->format(msg, formatted);
+    writer_.Write({formatted.data(), formatted.size()});
+  }
+
+  void flush_() override { writer_.Flush(); }
+
+ private:
+  impl::BufferedFileWriter writer_;
+};
+
+using BufferedFileSinkST = BufferedFileSink<spdlog::details::null_mutex>;
+using BufferedFileSinkMT = BufferedFileSink<std::mutex>;
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
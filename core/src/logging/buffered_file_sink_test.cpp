@@ -0,0 +1,89 @@
+#include <logging/buffered_file_sink.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kBufferSize = 4096;
+
+void Log(logging::BufferedFileSinkST& sink, std::string_view text) {
+  sink.log(spdlog::details::log_msg{"", spdlog::level::info, text});
+}
+
+}  // namespace
+
+TEST(BufferedFileSink, WritesOnFlush) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log";
+
+  logging::BufferedFileSinkST sink{path, kBufferSize};
+  sink.set_pattern("%v");
+  Log(sink, "first");
+  Log(sink, "second");
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "");
+
+  sink.flush();
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "first\nsecond\n");
+}
+
+TEST(BufferedFileSink, WritesWhenFull) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log";
+
+  logging::BufferedFileSinkST sink{path, kBufferSize};
+  sink.set_pattern("%v");
+
+  const std::string line(99, 'a');
+  std::string expected;
+  while (expected.size() <= kBufferSize) {
+    Log(sink, line);
+    expected += line + '\n';
+  }
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), expected);
+
+  const std::string big(kBufferSize * 3, 'b');
+  Log(sink, "small");
+  Log(sink, big);
+  expected += "small\n" + big + '\n';
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), expected);
+}
+
+TEST(BufferedFileSink, Reopen) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log";
+  const auto rotated_path = dir.GetPath() + "/log.1";
+
+  logging::BufferedFileSinkST sink{path, kBufferSize};
+  sink.set_pattern("%v");
+  Log(sink, "before rotation");
+
+  fs::blocking::Rename(path, rotated_path);
+  sink.Reopen(false);
+  Log(sink, "after rotation");
+  sink.flush();
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(rotated_path), "before rotation\n");
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "after rotation\n");
+}
+
+TEST(BufferedFileSink, AppendsToExisting) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log";
+  fs::blocking::RewriteFileContents(path, "old");
+
+  {
+    logging::BufferedFileSinkST sink{path, kBufferSize};
+    sink.set_pattern("%v");
+    Log(sink, "new");
+  }
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "old\nnew\n");
+}
+
+USERVER_NAMESPACE_END
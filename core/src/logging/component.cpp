@@ -15,17 +15,22 @@
 #include <spdlog/sinks/stdout_sinks.h>
 
 #include <logging/logger_with_info.hpp>
+#include <logging/buffered_file_sink.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
+#include <logging/stacktrace_cache_impl.hpp>
 #include <logging/unix_socket_sink.hpp>
 #include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -43,6 +48,7 @@ namespace components {
 namespace {
 
 constexpr std::chrono::seconds kDefaultFlushInterval{2};
+constexpr std::chrono::milliseconds kSymbolizeInterval{100};
 constexpr std::string_view unix_socket_prefix = "unix:";
 
 struct TestsuiteCaptureConfig {
@@ -65,18 +71,26 @@ std::optional<TestsuiteCaptureConfig> GetTestsuiteCaptureConfig(
   return config.As<TestsuiteCaptureConfig>();
 }
 
+template <typename Sink>
+bool TryReopen(const spdlog::sink_ptr& s) {
+  auto reop = std::dynamic_pointer_cast<Sink>(s);
+  if (!reop) {
+    return false;
+  }
+
+  try {
+    bool should_truncate = false;
+    reop->Reopen(should_truncate);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception on log reopen: " << e;
+  }
+  return true;
+}
+
 void ReopenAll(std::vector<spdlog::sink_ptr>& sinks) {
   for (const auto& s : sinks) {
-    auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s);
-    if (!reop) {
-      continue;
-    }
-
-    try {
-      bool should_truncate = false;
-      reop->Reopen(should_truncate);
-    } catch (const std::exception& e) {
-      LOG_ERROR() << "Exception on log reopen: " << e;
+    if (!TryReopen<logging::ReopeningFileSinkMT>(s)) {
+      TryReopen<logging::BufferedFileSinkMT>(s);
     }
   }
 }
@@ -94,11 +108,16 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-spdlog::sink_ptr GetSinkFromFilename(const spdlog::filename_t& file_path) {
+spdlog::sink_ptr GetSinkFromFilename(const spdlog::filename_t& file_path,
+                                     std::size_t file_buffer_size) {
   if (boost::starts_with(file_path, unix_socket_prefix)) {
     // Use Unix-socket sink
     return std::make_shared<logging::SocketSinkMT>(
         file_path.substr(unix_socket_prefix.size()));
+  } else if (file_buffer_size != 0) {
+    // Use File sink with own buffer
+    return std::make_shared<logging::BufferedFileSinkMT>(file_path,
+                                                         file_buffer_size);
   } else {
     // Use File sink
     return std::make_shared<logging::ReopeningFileSinkMT>(file_path);
@@ -121,7 +140,7 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
     sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
   } else {
     CreateLogDirectory(logger_name, config.file_path);
-    sink = GetSinkFromFilename(config.file_path);
+    sink = GetSinkFromFilename(config.file_path, config.file_buffer_size);
   }
 
   if (sink) {
@@ -130,7 +149,7 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
 
   const auto level = static_cast<spdlog::level::level_enum>(config.level);
   logger->set_level(level);
-  logger->set_pattern(config.pattern);
+  logging::SetSpdlogFormatter(*logger, config.format, config.pattern);
   logger->flush_on(static_cast<spdlog::level::level_enum>(config.flush_level));
 
   return std::make_shared<logging::impl::LoggerWithInfo>(config.format,
@@ -236,13 +255,40 @@ Logging::Logging(const ComponentConfig& config, const ComponentContext& context)
                             kDefaultFlushInterval),
                         {}, logging::Level::kTrace),
                     GetTaskFunction());
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterExtender(
+      "logger", [this](const auto& /*request*/) { return ExtendStatistics(); });
+
+  if (config["async-stacktrace-symbolization"].As<bool>(false)) {
+    logging::stacktrace_cache::impl::EnableDeferredSymbolization(true);
+
+    utils::PeriodicTask::Settings settings(kSymbolizeInterval, {},
+                                           logging::Level::kTrace);
+    settings.task_processor = fs_task_processor_;
+    symbolize_task_.Start("stacktrace_symbolizer", settings, [] {
+      logging::stacktrace_cache::impl::SymbolizeDeferred();
+    });
+
+    stacktrace_statistics_holder_ = storage.RegisterExtender(
+        "logger-stacktrace", [this](const auto& /*request*/) {
+          return ExtendStacktraceStatistics();
+        });
+  }
 }
 
 Logging::~Logging() {
   /// [Signals sample - destr]
   signal_subscriber_.Unsubscribe();
   /// [Signals sample - destr]
+  statistics_holder_.Unregister();
+  stacktrace_statistics_holder_.Unregister();
   flush_task_.Stop();
+  if (symbolize_task_.IsRunning()) {
+    symbolize_task_.Stop();
+    logging::stacktrace_cache::impl::EnableDeferredSymbolization(false);
+  }
 
   // Loggers could be used from non coroutine environments and should be
   // available even after task processors are down.
@@ -333,6 +379,42 @@ void Logging::FlushLogs() {
   }
 }
 
+formats::json::Value Logging::ExtendStatistics() {
+  formats::json::ValueBuilder json_loggers(formats::json::Type::kObject);
+  for (const auto& [logger_name, logger] : loggers_) {
+    const auto tp_logger =
+        std::dynamic_pointer_cast<logging::TpLogger>(logger->ptr.GetBase());
+    if (!tp_logger) continue;
+
+    const auto stats = tp_logger->GetStatistics();
+    formats::json::ValueBuilder json_logger;
+    json_logger["dropped"] = stats.dropped;
+    json_logger["written"] = stats.written;
+    json_logger["thread-buffers"] = stats.thread_buffers;
+    json_loggers[logger_name] = std::move(json_logger);
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(json_loggers, "logger");
+  return json_loggers.ExtractValue();
+}
+
+formats::json::Value Logging::ExtendStacktraceStatistics() {
+  const auto stats =
+      logging::stacktrace_cache::impl::GetDeferredSymbolizationStatistics();
+
+  formats::json::ValueBuilder json_stats;
+  json_stats["hits"] = stats.hits;
+  json_stats["misses"] = stats.misses;
+  json_stats["dropped"] = stats.dropped;
+  json_stats["symbolized"] = stats.symbolized;
+  json_stats["symbolization-time-us"]["min"] =
+      stats.symbolization_time_us.minimum;
+  json_stats["symbolization-time-us"]["max"] =
+      stats.symbolization_time_us.maximum;
+  json_stats["symbolization-time-us"]["avg"] =
+      stats.symbolization_time_us.average;
+  return json_stats.ExtractValue();
+}
+
 yaml_config::Schema Logging::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<impl::ComponentBase>(R"(
 type: object
@@ -342,6 +424,10 @@ properties:
     fs-task-processor:
         type: string
         description: task processor for disk I/O operations
+    async-stacktrace-symbolization:
+        type: boolean
+        description: symbolize the stacktraces of the logs on the fs-task-processor, log the raw frame addresses until then
+        defaultDescription: false
     loggers:
         type: object
         description: logger options
@@ -366,21 +452,27 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
+                      - tskv-deferred
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
                     defaultDescription: warning
                 message_queue_size:
                     type: integer
-                    description: the size of internal message queue, must be a power of 2
-                    defaultDescription: 65536
+                    description: the size of the per-thread message buffer, must be a power of 2; the buffer is allocated on the first write of the thread and takes about 400 bytes per message
+                    defaultDescription: 256
                 overflow_behavior:
                     type: string
-                    description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue"
+                    description: "message handling policy while the buffer of the thread is full: `discard` drops messages, `block` waits until message gets into the buffer"
                     defaultDescription: discard
                     enum:
                       - discard
                       - block
+                file_buffer_size:
+                    type: integer
+                    description: the size of the write buffer of the log file in bytes, `0` leaves the buffering to stdio
+                    defaultDescription: 0
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
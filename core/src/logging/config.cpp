@@ -44,7 +44,8 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
 
   config.message_queue_size = value["message_queue_size"].As<size_t>(
       LoggerConfig::kDefaultMessageQueueSize);
-  if (config.message_queue_size & (config.message_queue_size - 1)) {
+  if (config.message_queue_size == 0 ||
+      config.message_queue_size & (config.message_queue_size - 1)) {
     throw std::runtime_error("log message queue size must be a power of 2");
   }
 
@@ -52,6 +53,8 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<LoggerConfig::QueueOveflowBehavior>(
           LoggerConfig::QueueOveflowBehavior::kDiscard);
 
+  config.file_buffer_size = value["file_buffer_size"].As<size_t>(0);
+
   config.fs_task_processor =
       value["fs-task-processor"].As<std::optional<std::string>>();
 
@@ -13,7 +13,9 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 struct LoggerConfig {
-  static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
+  // a message slot takes about 400 bytes, the buffers of a busy logger are
+  // multiplied by the number of the threads writing to it
+  static constexpr size_t kDefaultMessageQueueSize = 1 << 8;
 
   enum class QueueOveflowBehavior { kDiscard, kBlock };
 
@@ -23,10 +25,14 @@ struct LoggerConfig {
   std::string pattern;  // deprecated
   Level flush_level = Level::kWarning;
 
-  // must be a power of 2
+  // per-thread buffer size, must be a power of 2. The buffer of a thread is
+  // allocated on its first write to the logger
   size_t message_queue_size = kDefaultMessageQueueSize;
   QueueOveflowBehavior queue_overflow_behavior = QueueOveflowBehavior::kDiscard;
 
+  // 0 means the stdio buffering of the file
+  size_t file_buffer_size = 0;
+
   std::optional<std::string> fs_task_processor;
 };
 
@@ -8,6 +8,7 @@
 
 #include <logging/get_should_log_cache.hpp>
 #include <logging/spdlog.hpp>
+#include <logging/tail_sampling.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/trivial_map.hpp>
@@ -95,7 +96,9 @@ bool ShouldLogNospan(Level level) noexcept {
 }
 
 bool ShouldLog(Level level) noexcept {
-  if (!ShouldLogNospan(level)) return false;
+  if (!ShouldLogNospan(level)) {
+    return impl::GetCurrentTailSampling(level) != nullptr;
+  }
 
   auto* span = tracing::Span::CurrentSpanUnchecked();
   if (span) {
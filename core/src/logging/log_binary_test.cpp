@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/binary_log.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string ToTskv(const std::string& binary) {
+  std::istringstream in{binary};
+  std::ostringstream out;
+  logging::ConvertBinaryLogToTskv(in, out);
+  return out.str();
+}
+
+std::string WithoutTimestamp(const std::string& line) {
+  const auto begin = line.find("timestamp=");
+  const auto end = line.find("\tlevel=");
+  if (begin == std::string::npos || end == std::string::npos) return line;
+  return line.substr(0, begin) + line.substr(end);
+}
+
+void LogSample() {
+  LOG_WARNING() << "text with\ttab\nnewline, \"quotes\" and \\ = " << 42
+                << logging::LogExtra{
+                       {"key.with.Period", "value"},
+                       {"negative", -5},
+                       {"zero", 0},
+                       {"leading_zero", "007"},
+                       {"max", std::numeric_limits<std::uint64_t>::max()},
+                       {"min", std::numeric_limits<std::int64_t>::min()},
+                       {"double", 1.5},
+                       {"empty", ""},
+                   };
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, SameAsTskv) {
+  LogSample();
+  logging::LogFlush();
+  const auto binary_log_line = ToTskv(GetStreamString());
+
+  std::ostringstream tskv_stream;
+  auto tskv_logger =
+      MakeNamedStreamLogger("tskv", tskv_stream, logging::Format::kTskv);
+  tskv_logger->ptr->set_pattern(
+      logging::GetSpdlogPattern(logging::Format::kTskv));
+  const auto binary_logger = logging::SetDefaultLogger(tskv_logger);
+  LogSample();
+  logging::LogFlush();
+  logging::SetDefaultLogger(binary_logger);
+
+  EXPECT_EQ(binary_log_line.rfind("tskv\ttimestamp=", 0), 0) << binary_log_line;
+  EXPECT_EQ(WithoutTimestamp(binary_log_line),
+            WithoutTimestamp(tskv_stream.str()));
+}
+
+TEST_F(LoggingBinaryTest, Records) {
+  LOG_INFO() << 1;
+  LOG_ERROR() << "two";
+  logging::LogFlush();
+
+  const auto tskv = ToTskv(GetStreamString());
+  const auto first_end = tskv.find('\n');
+  ASSERT_NE(first_end, std::string::npos);
+  EXPECT_NE(tskv.find("\tlevel=INFO\t"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttext=1\n"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tlevel=ERROR\t", first_end), std::string::npos)
+      << tskv;
+  EXPECT_NE(tskv.find("\ttext=two\n", first_end), std::string::npos) << tskv;
+  EXPECT_EQ(tskv.back(), '\n');
+}
+
+TEST_F(LoggingTskvDeferredTest, SameAsTskv) {
+  LogSample();
+  logging::LogFlush();
+  const auto deferred_log_line = GetStreamString();
+
+  std::ostringstream tskv_stream;
+  auto tskv_logger =
+      MakeNamedStreamLogger("tskv", tskv_stream, logging::Format::kTskv);
+  tskv_logger->ptr->set_pattern(
+      logging::GetSpdlogPattern(logging::Format::kTskv));
+  const auto deferred_logger = logging::SetDefaultLogger(tskv_logger);
+  LogSample();
+  logging::LogFlush();
+  logging::SetDefaultLogger(deferred_logger);
+
+  EXPECT_EQ(WithoutTimestamp(deferred_log_line),
+            WithoutTimestamp(tskv_stream.str()));
+}
+
+TEST_F(LoggingTskvDeferredTest, Timestamp) {
+  LOG_INFO() << "text";
+  logging::LogFlush();
+  const auto line = GetStreamString();
+
+  // tskv\ttimestamp=YYYY-MM-DDTHH:MM:SS.uuuuuu\tlevel=INFO\t...
+  ASSERT_GT(line.size(), 53) << line;
+  EXPECT_EQ(line.rfind("tskv\ttimestamp=", 0), 0) << line;
+  EXPECT_EQ(line[25], 'T') << line;
+  EXPECT_EQ(line[34], '.') << line;
+  EXPECT_EQ(line.substr(41, 12), "\tlevel=INFO\t") << line;
+  EXPECT_EQ(line.back(), '\n');
+}
+
+TEST_F(LoggingBinaryTest, Malformed) {
+  LOG_INFO() << "text";
+  logging::LogFlush();
+  const auto binary = GetStreamString();
+
+  EXPECT_THROW(ToTskv(binary.substr(0, binary.size() - 1)),
+               logging::BinaryLogError);
+  EXPECT_THROW(ToTskv(binary + '\x01'), logging::BinaryLogError);
+  EXPECT_THROW(ToTskv(std::string{"\x02\x05\x00", 3}), logging::BinaryLogError);
+  EXPECT_THROW(ToTskv("\xff\xff\xff\xff\x7f"), logging::BinaryLogError);
+  EXPECT_EQ(ToTskv({}), "");
+}
+
+USERVER_NAMESPACE_END
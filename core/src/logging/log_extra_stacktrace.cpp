@@ -6,6 +6,7 @@
 
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
+#include <logging/stacktrace_cache_impl.hpp>
 #include <userver/logging/stacktrace_cache.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -16,16 +17,24 @@ namespace {
 
 const std::string kTraceKey = "stacktrace";
 
+std::string ToString(const boost::stacktrace::stacktrace& trace,
+                     utils::Flags<LogExtraStacktraceFlags> flags) {
+  if (flags & LogExtraStacktraceFlags::kNoCache) {
+    return boost::stacktrace::to_string(trace);
+  }
+  if (stacktrace_cache::impl::IsDeferredSymbolizationEnabled()) {
+    return stacktrace_cache::impl::ToStringDeferred(trace);
+  }
+  return stacktrace_cache::to_string(trace);
+}
+
 }  // namespace
 
 void ExtendLogExtraWithStacktrace(
     LogExtra& log_extra, const boost::stacktrace::stacktrace& trace,
     utils::Flags<LogExtraStacktraceFlags> flags) noexcept {
   try {
-    log_extra.Extend(kTraceKey,
-                     (flags & LogExtraStacktraceFlags::kNoCache)
-                         ? boost::stacktrace::to_string(trace)
-                         : stacktrace_cache::to_string(trace),
+    log_extra.Extend(kTraceKey, ToString(trace, flags),
                      (flags & LogExtraStacktraceFlags::kFrozen)
                          ? LogExtra::ExtendType::kFrozen
                          : LogExtra::ExtendType::kNormal);
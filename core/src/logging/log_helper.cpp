@@ -174,7 +174,7 @@ void LogHelper::AppendLogExtra() {
   if (items->empty()) return;
 
   for (const auto& item : *items) {
-    Put(utils::encoding::kTskvPairsSeparator);
+    pimpl_->PutPairsSeparator();
     {
       EncodingGuard guard{*this, Encode::kKeyReplacePeriod};
       Put(item.first);
@@ -186,7 +186,7 @@ void LogHelper::AppendLogExtra() {
 }
 
 void LogHelper::LogTextKey() {
-  Put(utils::encoding::kTskvPairsSeparator);
+  pimpl_->PutPairsSeparator();
   Put("text");
   pimpl_->PutKeyValueSeparator();
 }
@@ -208,12 +208,12 @@ void LogHelper::LogIds() {
   uint64_t task_id = task ? reinterpret_cast<uint64_t>(task) : 0;
   auto* thread_id = reinterpret_cast<void*>(pthread_self());
 
-  Put(utils::encoding::kTskvPairsSeparator);
+  pimpl_->PutPairsSeparator();
   Put("task_id");
   pimpl_->PutKeyValueSeparator();
   *this << HexShort{task_id};
 
-  Put(utils::encoding::kTskvPairsSeparator);
+  pimpl_->PutPairsSeparator();
   Put("thread_id");
   pimpl_->PutKeyValueSeparator();
   *this << Hex{thread_id};
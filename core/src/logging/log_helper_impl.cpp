@@ -2,7 +2,13 @@
 
 #include <logging/spdlog.hpp>
 
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include <logging/binary_format.hpp>
 #include <logging/logger_with_info.hpp>
+#include <logging/tail_sampling.hpp>
 
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/tskv.hpp>
@@ -21,6 +27,20 @@ class PutCharFmtBuffer final {
   }
 };
 
+template <typename Buffer>
+void AppendTskvEncoded(Buffer& to, std::string_view str,
+                       utils::encoding::EncodeTskvMode mode) {
+  for (;;) {
+    // copy the chars that need no escaping in bulk
+    const auto pos = utils::encoding::FindTskvEscapedChar(str, mode);
+    to.append(str.data(), str.data() + pos);
+    if (pos == str.size()) return;
+
+    utils::encoding::EncodeTskv(to, str[pos], mode, PutCharFmtBuffer{});
+    str.remove_prefix(pos + 1);
+  }
+}
+
 char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   if (!logger_ptr) {
     return '?';  // Won't be logged
@@ -31,6 +51,8 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   switch (logger.format) {
     case Format::kTskv:
     case Format::kRaw:
+    case Format::kBinary:
+    case Format::kTskvDeferred:
       return '=';
     case Format::kLtsv:
       return ':';
@@ -39,6 +61,42 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+bool IsBinary(const LoggerPtr& logger_ptr) {
+  return logger_ptr && (logger_ptr->format == Format::kBinary ||
+                        logger_ptr->format == Format::kTskvDeferred);
+}
+
+enum class IntegerType { kNone, kUnsigned, kSigned };
+
+// Integers that are printed back exactly the same are stored as varints
+IntegerType ParseCanonicalInteger(std::string_view value,
+                                  std::uint64_t& result) {
+  constexpr std::size_t kMaxIntegerSize = 20;
+  if (value.empty() || value.size() > kMaxIntegerSize) {
+    return IntegerType::kNone;
+  }
+
+  const bool is_negative = value[0] == '-';
+  const auto digits = value.substr(is_negative ? 1 : 0);
+  if (digits.empty() || digits[0] < '0' || digits[0] > '9' ||
+      (digits[0] == '0' && (digits.size() > 1 || is_negative))) {
+    return IntegerType::kNone;
+  }
+
+  const auto* const end = value.data() + value.size();
+  if (is_negative) {
+    std::int64_t signed_result = 0;
+    const auto [ptr, ec] = std::from_chars(value.data(), end, signed_result);
+    if (ec != std::errc{} || ptr != end) return IntegerType::kNone;
+    result = binary::ZigZagEncode(signed_result);
+    return IntegerType::kSigned;
+  }
+
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (ec != std::errc{} || ptr != end) return IntegerType::kNone;
+  return IntegerType::kUnsigned;
+}
+
 }  // namespace
 
 LogHelper::Impl::int_type LogHelper::Impl::BufferStd::overflow(int_type c) {
@@ -56,37 +114,30 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerPtr logger, Level level) noexcept
     : logger_(std::move(logger)),
       level_(level),
-      key_value_separator_(GetSeparatorFromLogger(logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(logger_)),
+      is_binary_(IsBinary(logger_)) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
 }
 
 std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
+  if (is_binary_) {
+    msg_.append(s, s + n);
+    return n;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.append(s, s + n);
       break;
     case Encode::kValue:
-      if (!utils::encoding::ShouldValueBeEscaped({s, static_cast<size_t>(n)})) {
-        msg_.append(s, s + n);
-      } else {
-        msg_.reserve(msg_.size() + n);
-
-        utils::encoding::EncodeTskv(msg_, s, s + n,
-                                    utils::encoding::EncodeTskvMode::kValue,
-                                    PutCharFmtBuffer{});
-      }
+      AppendTskvEncoded(msg_, {s, static_cast<std::size_t>(n)},
+                        utils::encoding::EncodeTskvMode::kValue);
       break;
     case Encode::kKeyReplacePeriod:
-      if (!utils::encoding::ShouldKeyBeEscaped({s, static_cast<size_t>(n)})) {
-        msg_.append(s, s + n);
-      } else {
-        msg_.reserve(msg_.size() + n);
-        utils::encoding::EncodeTskv(
-            msg_, s, s + n, utils::encoding::EncodeTskvMode::kKeyReplacePeriod,
-            PutCharFmtBuffer{});
-      }
+      AppendTskvEncoded(msg_, {s, static_cast<std::size_t>(n)},
+                        utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
       break;
   }
 
@@ -96,6 +147,11 @@ std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
 LogHelper::Impl::int_type LogHelper::Impl::overflow(int_type c) {
   if (c == std::streambuf::traits_type::eof()) return c;
 
+  if (is_binary_) {
+    msg_.push_back(c);
+    return c;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.push_back(c);
@@ -124,14 +180,95 @@ LogHelper::Impl::LazyInitedStream& LogHelper::Impl::GetLazyInitedStream() {
   return *lazy_stream_;
 }
 
-void LogHelper::Impl::LogTheMessage() const {
+void LogHelper::Impl::PutKeyValueSeparator() {
+  if (is_binary_) {
+    FinishBinaryKey();
+  } else {
+    xsputn(&key_value_separator_, 1);
+  }
+}
+
+void LogHelper::Impl::PutPairsSeparator() {
+  if (is_binary_) {
+    FinishBinaryValue();
+  } else {
+    xsputn(&utils::encoding::kTskvPairsSeparator, 1);
+  }
+}
+
+void LogHelper::Impl::FinishBinaryKey() {
+  UASSERT(is_binary_key_);
+  const std::string_view key{msg_.data() + binary_field_begin_,
+                             msg_.size() - binary_field_begin_};
+  const auto tag = binary::FindTag(key);
+  if (tag != binary::kInlineKeyTag) {
+    msg_.resize(binary_field_begin_);
+    binary::AppendVarint(msg_, tag);
+  } else {
+    char prefix[1 + binary::kMaxVarintSize];
+    prefix[0] = static_cast<char>(binary::kInlineKeyTag);
+    const auto size = 1 + binary::WriteVarint(prefix + 1, key.size());
+    InsertBinaryPrefix(binary_field_begin_, prefix, size);
+  }
+
+  msg_.push_back(static_cast<char>(binary::ValueType::kString));
+  binary_field_begin_ = msg_.size();
+  is_binary_key_ = false;
+}
+
+void LogHelper::Impl::FinishBinaryValue() {
+  if (is_binary_key_) {
+    if (msg_.size() == binary_field_begin_) return;
+    // a key without a value
+    FinishBinaryKey();
+  }
+
+  const std::string_view value{msg_.data() + binary_field_begin_,
+                               msg_.size() - binary_field_begin_};
+  std::uint64_t number = 0;
+  const auto integer_type = ParseCanonicalInteger(value, number);
+  if (integer_type != IntegerType::kNone) {
+    msg_[binary_field_begin_ - 1] = static_cast<char>(
+        integer_type == IntegerType::kSigned ? binary::ValueType::kSigned
+                                             : binary::ValueType::kUnsigned);
+    msg_.resize(binary_field_begin_);
+    binary::AppendVarint(msg_, number);
+  } else {
+    char prefix[binary::kMaxVarintSize];
+    const auto size = binary::WriteVarint(prefix, value.size());
+    InsertBinaryPrefix(binary_field_begin_, prefix, size);
+  }
+
+  binary_field_begin_ = msg_.size();
+  is_binary_key_ = true;
+}
+
+void LogHelper::Impl::InsertBinaryPrefix(std::size_t pos, const char* prefix,
+                                         std::size_t size) {
+  const auto old_size = msg_.size();
+  msg_.resize(old_size + size);
+  std::memmove(msg_.data() + pos + size, msg_.data() + pos, old_size - pos);
+  std::memcpy(msg_.data() + pos, prefix, size);
+}
+
+void LogHelper::Impl::LogTheMessage() {
   if (IsBroken()) {
     return;
   }
 
+  if (is_binary_) FinishBinaryValue();
+
   UASSERT(logger_);
   std::string_view message(msg_.data(), msg_.size());
-  logger_->ptr->log(static_cast<spdlog::level::level_enum>(level_), message);
+  const auto spdlog_level = static_cast<spdlog::level::level_enum>(level_);
+  if (!logger_->ptr->should_log(spdlog_level)) {
+    if (auto* tail_sampling = impl::GetCurrentTailSampling(level_)) {
+      tail_sampling->Push(logger_, level_, message);
+    }
+    return;
+  }
+
+  logger_->ptr->log(spdlog_level, message);
 }
 
 void LogHelper::Impl::MarkTextBegin() {
@@ -37,9 +37,10 @@ class LogHelper::Impl final {
   std::streamsize xsputn(const char_type* s, std::streamsize n);
   int_type overflow(int_type c);
 
-  void PutKeyValueSeparator() { xsputn(&key_value_separator_, 1); }
+  void PutKeyValueSeparator();
+  void PutPairsSeparator();
 
-  void LogTheMessage() const;
+  void LogTheMessage();
 
   void MarkTextBegin();
   size_t TextSize() const { return msg_.size() - initial_length_; }
@@ -69,11 +70,21 @@ class LogHelper::Impl final {
 
   LazyInitedStream& GetLazyInitedStream();
 
+  // logging::Format::kBinary keeps the fields as they are, the key and the
+  // value sizes are written after the field is complete
+  void FinishBinaryKey();
+  void FinishBinaryValue();
+  void InsertBinaryPrefix(std::size_t pos, const char* prefix,
+                          std::size_t size);
+
   static constexpr size_t kOptimalBufferSize = 1500;
 
   LoggerPtr logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
+  bool is_binary_key_{true};
+  std::size_t binary_field_begin_{0};
   Encode encode_mode_{Encode::kNone};
   fmt::basic_memory_buffer<char, kOptimalBufferSize> msg_;
   std::optional<LazyInitedStream> lazy_stream_;
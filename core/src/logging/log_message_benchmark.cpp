@@ -4,6 +4,7 @@
 #include <userver/logging/logger.hpp>
 
 #include <ostream>
+#include <string>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -48,6 +49,22 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogString)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+BENCHMARK_DEFINE_F(LogHelperBenchmark, LogStringEscaped)
+(benchmark::State& state) {
+  // a multiline text, e.g. a stacktrace or a pretty printed JSON
+  std::string text(state.range(0), '*');
+  for (std::size_t i = 63; i < text.size(); i += 64) text[i] = '\n';
+  const auto msg = Launder(std::move(text));
+  for (auto _ : state) {
+    LOG_INFO() << msg;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(LogHelperBenchmark, LogStringEscaped)
+    ->RangeMultiplier(2)
+    ->Range(8, 8 << 10)
+    ->Complexity();
+
 BENCHMARK_DEFINE_F(LogHelperBenchmark, LogChar)(benchmark::State& state) {
   const auto msg = Launder(std::string(state.range(0), '*'));
   for (auto _ : state) {
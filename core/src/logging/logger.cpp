@@ -29,7 +29,7 @@ LoggerPtr MakeSimpleLogger(const std::string& name, spdlog::sink_ptr sink,
   auto logger =
       std::make_shared<impl::LoggerWithInfo>(format, std::move(spdlog_logger));
 
-  logger->ptr->set_pattern(GetSpdlogPattern(format));
+  SetSpdlogFormatter(*logger->ptr, format, GetSpdlogPattern(format));
   logger->ptr->set_level(level);
   logger->ptr->flush_on(level);
   return logger;
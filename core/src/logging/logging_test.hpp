@@ -163,7 +163,8 @@ class LoggingTestBase : public ::testing::Test {
     std::ostringstream os;
     os << this;
     auto logger = MakeNamedStreamLogger(os.str(), stream, format_);
-    logger->ptr->set_pattern(logging::GetSpdlogPattern(format_));
+    logging::SetSpdlogFormatter(*logger->ptr, format_,
+                                logging::GetSpdlogPattern(format_));
     return logger;
   }
 
@@ -216,4 +217,15 @@ class LoggingLtsvTest : public LoggingTestBase {
   LoggingLtsvTest() : LoggingTestBase(logging::Format::kLtsv, "text:") {}
 };
 
+class LoggingBinaryTest : public LoggingTestBase {
+ protected:
+  LoggingBinaryTest() : LoggingTestBase(logging::Format::kBinary, "text=") {}
+};
+
+class LoggingTskvDeferredTest : public LoggingTestBase {
+ protected:
+  LoggingTskvDeferredTest()
+      : LoggingTestBase(logging::Format::kTskvDeferred, "text=") {}
+};
+
 USERVER_NAMESPACE_END
@@ -11,7 +11,7 @@ namespace logging {
 
 template <typename T>
 void PutData(LogHelper& lh, std::string_view key, const T& value) {
-  lh.Put(utils::encoding::kTskvPairsSeparator);
+  lh.pimpl_->PutPairsSeparator();
   {
     logging::LogHelper::EncodingGuard guard{
         lh, logging::LogHelper::Encode::kKeyReplacePeriod};
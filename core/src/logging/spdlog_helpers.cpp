@@ -1,5 +1,8 @@
 #include <logging/spdlog_helpers.hpp>
 
+#include <spdlog/logger.h>
+
+#include <logging/binary_format.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,12 +22,25 @@ const std::string& GetSpdlogPattern(Format format) {
     case Format::kLtsv:
       return kSpdlogLtsvPattern;
     case Format::kRaw:
+    case Format::kBinary:
+    case Format::kTskvDeferred:
       return kSpdlogRawPattern;
   }
 
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+void SetSpdlogFormatter(spdlog::logger& logger, Format format,
+                        const std::string& pattern) {
+  if (format == Format::kBinary) {
+    logger.set_formatter(std::make_unique<binary::Formatter>());
+  } else if (format == Format::kTskvDeferred) {
+    logger.set_formatter(std::make_unique<binary::TskvFormatter>());
+  } else {
+    logger.set_pattern(pattern);
+  }
+}
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
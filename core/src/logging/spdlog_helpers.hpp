@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include <spdlog/fwd.h>
+
 #include <userver/logging/format.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,6 +12,11 @@ namespace logging {
 
 const std::string& GetSpdlogPattern(Format format);
 
+/// Sets the `pattern` for the text formats and the binary::Formatter for
+/// Format::kBinary
+void SetSpdlogFormatter(spdlog::logger& logger, Format format,
+                        const std::string& pattern);
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
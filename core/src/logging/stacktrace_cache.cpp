@@ -1,13 +1,19 @@
 #include <userver/logging/stacktrace_cache.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <fmt/format.h>
 #include <boost/functional/hash.hpp>
 #include <boost/stacktrace.hpp>
 
+#include <logging/stacktrace_cache_impl.hpp>
 #include <userver/cache/lru_map.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/text.hpp>
 
@@ -47,18 +53,13 @@ const std::string& ToStringCachedFiltered(boost::stacktrace::frame frame) {
   return *ptr;
 }
 
-}  // namespace
-
-std::string to_string(const boost::stacktrace::stacktrace& st) {
-  if (!stacktrace_enabled.load()) {
-    return "<unknown>";
-  }
-
+template <typename Frames>
+std::string ToStringFiltered(const Frames& frames) {
   std::string res;
-  res.reserve(200 * st.size());
+  res.reserve(200 * frames.size());
 
   size_t i = 0;
-  for (const auto frame : st) {
+  for (const auto frame : frames) {
     if (i < 10) {
       res += ' ';
     }
@@ -83,6 +84,63 @@ std::string to_string(const boost::stacktrace::stacktrace& st) {
   return res;
 }
 
+using FrameAddresses =
+    std::vector<boost::stacktrace::frame::native_frame_ptr_t>;
+
+struct FrameAddressesHash {
+  std::size_t operator()(const FrameAddresses& addresses) const noexcept {
+    return boost::hash_range(addresses.begin(), addresses.end());
+  }
+};
+
+constexpr std::size_t kMaxSymbolizedStacktraces = 1000;
+constexpr std::size_t kMaxPendingStacktraces = 100;
+
+struct DeferredSymbolization {
+  std::atomic<bool> enabled{false};
+
+  std::mutex mutex;
+  cache::LruMap<FrameAddresses, std::string, FrameAddressesHash> symbolized{
+      kMaxSymbolizedStacktraces};
+  std::unordered_set<FrameAddresses, FrameAddressesHash> pending;
+
+  std::atomic<std::uint64_t> hits{0};
+  std::atomic<std::uint64_t> misses{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<std::uint64_t> symbolized_count{0};
+  utils::statistics::MinMaxAvg<std::uint64_t> symbolization_time_us;
+};
+
+DeferredSymbolization& GetDeferredSymbolization() {
+  static DeferredSymbolization instance;
+  return instance;
+}
+
+std::string FormatStacktraceId(const FrameAddresses& addresses) {
+  return fmt::format("{:016x}", FrameAddressesHash{}(addresses));
+}
+
+std::string ToStringRaw(const FrameAddresses& addresses) {
+  std::string res =
+      fmt::format("[symbolization pending, stacktrace_id={}]\n",
+                  FormatStacktraceId(addresses));
+  for (std::size_t i = 0; i < addresses.size(); ++i) {
+    fmt::format_to(std::back_inserter(res), "{:>2}# {}\n", i,
+                   fmt::ptr(addresses[i]));
+  }
+  return res;
+}
+
+}  // namespace
+
+std::string to_string(const boost::stacktrace::stacktrace& st) {
+  if (!stacktrace_enabled.load()) {
+    return "<unknown>";
+  }
+
+  return ToStringFiltered(st);
+}
+
 bool GlobalEnableStacktrace(bool enable) {
   return stacktrace_enabled.exchange(enable);
 }
@@ -94,6 +152,92 @@ StacktraceGuard::~StacktraceGuard() {
   logging::stacktrace_cache::GlobalEnableStacktrace(old_);
 }
 
+namespace impl {
+
+bool EnableDeferredSymbolization(bool enable) {
+  return GetDeferredSymbolization().enabled.exchange(enable);
+}
+
+bool IsDeferredSymbolizationEnabled() noexcept {
+  return GetDeferredSymbolization().enabled.load(std::memory_order_relaxed);
+}
+
+std::string ToStringDeferred(const boost::stacktrace::stacktrace& st) {
+  if (!stacktrace_enabled.load()) {
+    return "<unknown>";
+  }
+
+  FrameAddresses addresses;
+  addresses.reserve(st.size());
+  for (const auto frame : st) addresses.push_back(frame.address());
+
+  auto& state = GetDeferredSymbolization();
+  {
+    std::lock_guard lock(state.mutex);
+    if (const auto* symbolized = state.symbolized.Get(addresses)) {
+      ++state.hits;
+      return *symbolized;
+    }
+
+    ++state.misses;
+    if (state.pending.size() < kMaxPendingStacktraces) {
+      state.pending.insert(addresses);
+    } else if (!state.pending.count(addresses)) {
+      ++state.dropped;
+    }
+  }
+
+  return ToStringRaw(addresses);
+}
+
+std::size_t SymbolizeDeferred() {
+  auto& state = GetDeferredSymbolization();
+
+  std::unordered_set<FrameAddresses, FrameAddressesHash> pending;
+  {
+    std::lock_guard lock(state.mutex);
+    pending.swap(state.pending);
+  }
+
+  for (const auto& addresses : pending) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<boost::stacktrace::frame> frames;
+    frames.reserve(addresses.size());
+    for (const auto address : addresses) frames.emplace_back(address);
+    auto symbolized = ToStringFiltered(frames);
+
+    state.symbolization_time_us.Account(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    ++state.symbolized_count;
+
+    LOG_INFO() << "Stacktrace symbolized"
+               << LogExtra{{"stacktrace_id", FormatStacktraceId(addresses)},
+                           {"stacktrace", symbolized}};
+
+    std::lock_guard lock(state.mutex);
+    state.symbolized.Put(addresses, std::move(symbolized));
+  }
+
+  return pending.size();
+}
+
+DeferredSymbolizationStatistics GetDeferredSymbolizationStatistics() {
+  const auto& state = GetDeferredSymbolization();
+
+  DeferredSymbolizationStatistics stats;
+  stats.hits = state.hits.load();
+  stats.misses = state.misses.load();
+  stats.dropped = state.dropped.load();
+  stats.symbolized = state.symbolized_count.load();
+  stats.symbolization_time_us = state.symbolization_time_us.GetCurrent();
+  return stats;
+}
+
+}  // namespace impl
+
 }  // namespace logging::stacktrace_cache
 
 USERVER_NAMESPACE_END
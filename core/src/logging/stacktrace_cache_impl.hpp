@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/stacktrace/stacktrace_fwd.hpp>
+
+#include <userver/utils/statistics/min_max_avg.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::stacktrace_cache::impl {
+
+struct DeferredSymbolizationStatistics {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::uint64_t dropped{0};
+  std::uint64_t symbolized{0};
+  utils::statistics::MinMaxAvg<std::uint64_t>::Current symbolization_time_us{};
+};
+
+/// Enables/disables deferred symbolization, returns the previous value
+bool EnableDeferredSymbolization(bool enable);
+
+bool IsDeferredSymbolizationEnabled() noexcept;
+
+/// Returns the symbolized stacktrace if the same frames were symbolized
+/// before. Otherwise returns the raw frame addresses with the stacktrace_id
+/// and queues the frames for SymbolizeDeferred().
+std::string ToStringDeferred(const boost::stacktrace::stacktrace& st);
+
+/// Symbolizes the queued stacktraces, caches the results and logs them with
+/// their stacktrace_id. Returns the number of the symbolized stacktraces.
+std::size_t SymbolizeDeferred();
+
+DeferredSymbolizationStatistics GetDeferredSymbolizationStatistics();
+
+}  // namespace logging::stacktrace_cache::impl
+
+USERVER_NAMESPACE_END
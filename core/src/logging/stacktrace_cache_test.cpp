@@ -2,6 +2,7 @@
 
 #include <boost/stacktrace.hpp>
 
+#include <logging/stacktrace_cache_impl.hpp>
 #include <userver/logging/stacktrace_cache.hpp>
 #include <userver/utils/text.hpp>
 
@@ -21,4 +22,26 @@ UTEST(StacktraceCache, StartOfCoroutine) {
   EXPECT_TRUE(utils::text::EndsWith(text, "[start of coroutine]\n")) << text;
 }
 
+TEST(StacktraceCache, Deferred) {
+  namespace impl = logging::stacktrace_cache::impl;
+
+  logging::stacktrace_cache::StacktraceGuard guard(true);
+  auto st = boost::stacktrace::stacktrace();
+  const auto stats_before = impl::GetDeferredSymbolizationStatistics();
+
+  const auto raw = impl::ToStringDeferred(st);
+  EXPECT_TRUE(utils::text::StartsWith(raw, "[symbolization pending")) << raw;
+  EXPECT_EQ(impl::ToStringDeferred(st), raw);
+
+  EXPECT_EQ(impl::SymbolizeDeferred(), 1);
+  EXPECT_EQ(impl::SymbolizeDeferred(), 0);
+  EXPECT_EQ(impl::ToStringDeferred(st),
+            logging::stacktrace_cache::to_string(st));
+
+  const auto stats = impl::GetDeferredSymbolizationStatistics();
+  EXPECT_EQ(stats.misses - stats_before.misses, 2);
+  EXPECT_EQ(stats.hits - stats_before.hits, 1);
+  EXPECT_EQ(stats.symbolized - stats_before.symbolized, 1);
+}
+
 USERVER_NAMESPACE_END
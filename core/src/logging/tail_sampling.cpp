@@ -0,0 +1,100 @@
+#include <logging/tail_sampling.hpp>
+
+#include <atomic>
+#include <utility>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/logger.h>
+
+#include <logging/logger_with_info.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <utils/internal_tag.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+constexpr std::size_t kMaxBufferedBytes = 1 << 20;
+
+std::atomic<std::size_t> tail_samplings_count{0};
+
+// Gives access to spdlog::logger::sink_it_() that writes the message
+// regardless of the logger level
+class UnfilteredLogger final : public spdlog::logger {
+ public:
+  static void SinkIt(spdlog::logger& logger,
+                     const spdlog::details::log_msg& msg) {
+    (logger.*(&UnfilteredLogger::sink_it_))(msg);
+  }
+};
+
+}  // namespace
+
+TailSampling::TailSampling(Level level,
+                           std::chrono::milliseconds latency_threshold)
+    : level_(level), latency_threshold_(latency_threshold) {
+  ++tail_samplings_count;
+}
+
+TailSampling::~TailSampling() { --tail_samplings_count; }
+
+void TailSampling::Push(const LoggerPtr& logger, Level level,
+                        std::string_view message) {
+  std::lock_guard lock(mutex_);
+  if (buffered_bytes_ + message.size() > kMaxBufferedBytes) {
+    ++dropped_;
+    return;
+  }
+
+  buffered_bytes_ += message.size();
+  messages_.push_back(Message{logger, level, std::chrono::system_clock::now(),
+                              std::string{message}});
+}
+
+void TailSampling::Flush() {
+  std::vector<Message> messages;
+  std::size_t dropped = 0;
+  {
+    std::lock_guard lock(mutex_);
+    messages.swap(messages_);
+    buffered_bytes_ = 0;
+    dropped = std::exchange(dropped_, 0);
+  }
+
+  for (const auto& message : messages) {
+    auto& logger = *message.logger->ptr;
+    const spdlog::details::log_msg msg{
+        message.time, spdlog::source_loc{}, logger.name(),
+        static_cast<spdlog::level::level_enum>(message.level),
+        spdlog::string_view_t{message.text.data(), message.text.size()}};
+    UnfilteredLogger::SinkIt(logger, msg);
+  }
+
+  if (dropped != 0) {
+    LOG_WARNING() << "Dropped " << dropped
+                  << " tail sampled log messages of the request";
+  }
+}
+
+TailSampling* GetCurrentTailSampling(Level level) noexcept {
+  if (tail_samplings_count.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+
+  auto* span = tracing::Span::CurrentSpanUnchecked();
+  if (!span) return nullptr;
+
+  auto* tail_sampling = span->GetTailSampling(utils::InternalTag{});
+  if (!tail_sampling || level < tail_sampling->GetLevel()) return nullptr;
+  return tail_sampling;
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/logging/level.hpp>
+#include <userver/logging/logger.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Buffer of the log messages of a request that are below the logger level.
+/// The tracing::Span that enabled the tail sampling writes the messages out
+/// if the request failed or was slow, and drops them otherwise.
+class TailSampling final {
+ public:
+  TailSampling(Level level, std::chrono::milliseconds latency_threshold);
+  ~TailSampling();
+
+  TailSampling(const TailSampling&) = delete;
+  TailSampling& operator=(const TailSampling&) = delete;
+
+  Level GetLevel() const noexcept { return level_; }
+
+  std::chrono::milliseconds GetLatencyThreshold() const noexcept {
+    return latency_threshold_;
+  }
+
+  void Push(const LoggerPtr& logger, Level level, std::string_view message);
+
+  /// Writes the buffered messages to their loggers with their original
+  /// timestamps and levels
+  void Flush();
+
+ private:
+  struct Message {
+    LoggerPtr logger;
+    Level level;
+    std::chrono::system_clock::time_point time;
+    std::string text;
+  };
+
+  const Level level_;
+  const std::chrono::milliseconds latency_threshold_;
+
+  std::mutex mutex_;
+  std::vector<Message> messages_;
+  std::size_t buffered_bytes_{0};
+  std::size_t dropped_{0};
+};
+
+/// Returns the tail sampling of the current span if it buffers the messages of
+/// `level`, nullptr otherwise. Cheap if no span has the tail sampling enabled.
+TailSampling* GetCurrentTailSampling(Level level) noexcept;
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
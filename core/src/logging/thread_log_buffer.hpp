@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <spdlog/details/log_msg_buffer.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Single producer single consumer ring buffer of log messages. The producer
+/// is the thread that owns the buffer, the consumer is the writer task of the
+/// logger. The buffer is created on the first write of the thread.
+class ThreadLogBuffer final {
+ public:
+  /// @param capacity must be a power of 2
+  explicit ThreadLogBuffer(std::size_t capacity)
+      : mask_(capacity - 1),
+        slots_(std::make_unique<spdlog::details::log_msg_buffer[]>(capacity)) {
+    UASSERT(capacity != 0 && (capacity & mask_) == 0);
+  }
+
+  ThreadLogBuffer(const ThreadLogBuffer&) = delete;
+  ThreadLogBuffer& operator=(const ThreadLogBuffer&) = delete;
+
+  std::size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+  /// Producer side: copies the message into the buffer, returns false if the
+  /// buffer is full
+  bool TryPush(const spdlog::details::log_msg& msg) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ > mask_) return false;
+    }
+
+    slots_[tail & mask_] = spdlog::details::log_msg_buffer{msg};
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Producer side: accounts a message that did not fit into the buffer
+  void AccountDropped() noexcept {
+    dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  }
+
+  /// Consumer side: calls `func(const spdlog::details::log_msg&)` for at most
+  /// `max_count` oldest messages and removes them, returns the number of the
+  /// consumed messages
+  template <typename Func>
+  std::size_t ConsumeBatch(std::size_t max_count, Func&& func) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    const auto count = std::min<std::size_t>(tail - head, max_count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      func(static_cast<const spdlog::details::log_msg&>(
+          slots_[(head + i) & mask_]));
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /// Consumer side
+  bool IsEmpty() const noexcept {
+    return head_.load(std::memory_order_relaxed) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  std::uint64_t GetDroppedCount() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  const std::size_t mask_;
+  const std::unique_ptr<spdlog::details::log_msg_buffer[]> slots_;
+
+  // written by the consumer
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+
+  // written by the producer
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+  std::size_t cached_head_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
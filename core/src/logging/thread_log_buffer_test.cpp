@@ -0,0 +1,69 @@
+#include <logging/thread_log_buffer.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+spdlog::details::log_msg MakeMessage(const std::string& text) {
+  return spdlog::details::log_msg{"logger", spdlog::level::info, text};
+}
+
+}  // namespace
+
+TEST(ThreadLogBuffer, PushConsume) {
+  logging::impl::ThreadLogBuffer buffer(4);
+  EXPECT_EQ(buffer.GetCapacity(), 4);
+  EXPECT_TRUE(buffer.IsEmpty());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(buffer.TryPush(MakeMessage(std::to_string(i))));
+  }
+  EXPECT_FALSE(buffer.TryPush(MakeMessage("overflow")));
+  buffer.AccountDropped();
+  EXPECT_EQ(buffer.GetDroppedCount(), 1);
+
+  std::vector<std::string> consumed;
+  const auto consume = [&consumed](const spdlog::details::log_msg& msg) {
+    consumed.emplace_back(msg.payload.data(), msg.payload.size());
+  };
+  EXPECT_EQ(buffer.ConsumeBatch(3, consume), 3);
+  EXPECT_EQ(consumed, (std::vector<std::string>{"0", "1", "2"}));
+
+  // the long message does not fit into the inline storage
+  const std::string long_text(1000, 'x');
+  EXPECT_TRUE(buffer.TryPush(MakeMessage(long_text)));
+  EXPECT_EQ(buffer.ConsumeBatch(10, consume), 2);
+  EXPECT_EQ(consumed.back(), long_text);
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(ThreadLogBuffer, ProducerConsumer) {
+  constexpr int kMessages = 10000;
+  logging::impl::ThreadLogBuffer buffer(64);
+
+  std::thread producer([&buffer] {
+    for (int i = 0; i < kMessages; ++i) {
+      const auto message = MakeMessage(std::to_string(i));
+      while (!buffer.TryPush(message)) std::this_thread::yield();
+    }
+  });
+
+  int expected = 0;
+  while (expected < kMessages) {
+    buffer.ConsumeBatch(16, [&expected](const spdlog::details::log_msg& msg) {
+      ASSERT_EQ(std::string(msg.payload.data(), msg.payload.size()),
+                std::to_string(expected));
+      ++expected;
+    });
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+USERVER_NAMESPACE_END
@@ -3,10 +3,10 @@
 #include <memory>
 #include <string>
 
-#include <userver/concurrent/mpsc_queue.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/logging/log.hpp>
 
+#include <compiler/tls.hpp>
 #include <engine/task/task_context.hpp>
 #include <logging/logger_with_info.hpp>
 
@@ -14,16 +14,43 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging {
 
+namespace {
+
+// Upper bound on the messages taken from a thread buffer at once, so that a
+// single chatty thread does not delay the messages of the others
+constexpr std::size_t kMaxBatchSize = 256;
+
+std::atomic<std::uint64_t> next_logger_id{1};
+
+struct CachedThreadBuffer {
+  std::uint64_t logger_id;
+  impl::ThreadLogBuffer* buffer;
+};
+
+// Direct-mapped per-thread cache of the thread buffers of the loggers. Logger
+// ids are never reused, so entries of the destroyed loggers never match. The
+// cache is trivially destructible to be usable while other thread_local
+// objects are being destroyed.
+constexpr std::size_t kThreadBufferCacheSize = 8;
+thread_local CachedThreadBuffer thread_buffer_cache[kThreadBufferCacheSize]{};
+
+USERVER_PREVENT_TLS_CACHING
+CachedThreadBuffer& GetCachedThreadBuffer(std::uint64_t logger_id) noexcept {
+  return thread_buffer_cache[logger_id % kThreadBufferCacheSize];
+}
+
+}  // namespace
+
 TpLogger::TpLogger(std::string logger_name,
                    engine::TaskProcessor& task_processor,
-                   std::size_t max_queue_size,
+                   std::size_t thread_buffer_size,
                    LoggerConfig::QueueOveflowBehavior overflow_policy)
     : logger(std::move(logger_name)),
-      queue_(Queue::Create(max_queue_size)),
+      id_(next_logger_id++),
+      thread_buffer_size_(thread_buffer_size),
+      overflow_policy_(overflow_policy),
       consuming_task_(engine::CriticalAsyncNoSpan(
-          task_processor, &TpLogger::ProcessingLoop, this)),
-      producer_(queue_->GetMultiProducer()),
-      overflow_policy_(overflow_policy) {}
+          task_processor, &TpLogger::ProcessingLoop, this)) {}
 
 TpLogger::~TpLogger() {
   UASSERT_MSG(
@@ -38,14 +65,30 @@ void TpLogger::SwitchToSyncMode() {
   const auto was_fallback = in_fallback_mode_.exchange(true);
   UASSERT(!was_fallback);
 
-  // Some loggings could be in progress. To wait for those we send a kStop
-  // message by an explicit producer_.Push to avoid losing the message
-  // on overflow.
-  impl::AsyncAction action(impl::ActionType::kStop);
-  producer_.Push(std::move(action));
+  // Some loggings could be in progress. The writer task drains the buffers
+  // before stopping, the messages that were pushed after that are written
+  // here.
+  stop_requested_ = true;
+  writer_event_.Send();
 
   consuming_task_.Wait();
   consuming_task_ = {};
+
+  std::vector<impl::ThreadLogBuffer*> buffers;
+  RefreshBuffers(buffers);
+  DrainBuffers(buffers, thread_buffer_size_);
+}
+
+TpLoggerStatistics TpLogger::GetStatistics() const {
+  TpLoggerStatistics stats;
+  stats.written = written_.load(std::memory_order_relaxed);
+
+  std::lock_guard lock(buffers_mutex_);
+  stats.thread_buffers = buffers_.size();
+  for (const auto* buffer : buffers_) {
+    stats.dropped += buffer->GetDroppedCount();
+  }
+  return stats;
 }
 
 std::shared_ptr<spdlog::logger> TpLogger::clone(std::string /*new_name*/) {
@@ -62,8 +105,7 @@ void TpLogger::sink_it_(const spdlog::details::log_msg& msg) {
     return;
   }
 
-  impl::AsyncAction action(impl::ActionType::kLog, msg);
-  Push(std::move(action));
+  Push(msg);
 }
 
 void TpLogger::flush_() {
@@ -76,67 +118,135 @@ void TpLogger::flush_() {
     return;
   }
 
-  const auto flush_snapshot = flush_index_.load();
-  impl::AsyncAction action(impl::ActionType::kFlush);
-  Push(std::move(action));
+  const auto flush_request = ++flush_requested_;
+  writer_event_.Send();
 
   // logger flush is a very rare operation, it is fine to busy-loop here
   if (engine::current_task::GetCurrentTaskContextUnchecked()) {
-    while (flush_snapshot == flush_index_.load()) {
+    while (flush_index_.load() < flush_request) {
       engine::Yield();
     }
   } else {
-    while (flush_snapshot == flush_index_.load()) {
+    while (flush_index_.load() < flush_request) {
       std::this_thread::yield();
     }
   }
 }
 
 void TpLogger::ProcessingLoop() {
-  auto consumer = queue_->GetConsumer();
+  std::vector<impl::ThreadLogBuffer*> buffers;
 
   for (;;) {
-    impl::AsyncAction incoming_async_action;
-    if (!consumer.Pop(incoming_async_action)) {
-      // Producer is dead
-      return;
+    RefreshBuffers(buffers);
+    if (DrainBuffers(buffers, kMaxBatchSize) != 0) continue;
+
+    const auto flush_request = flush_requested_.load();
+    if (flush_request != flush_index_.load(std::memory_order_relaxed)) {
+      // Everything pushed before the flush request fits into the buffers
+      DrainBuffers(buffers, thread_buffer_size_);
+      BackendFlush();
+      flush_index_ = flush_request;
+      continue;
+    }
+
+    if (stop_requested_) return;
+
+    // Pairs with the fence in NotifyWriter(): either the producer sees the
+    // flag and wakes us up, or we see its message here.
+    is_writer_sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasPendingWork(buffers)) {
+      is_writer_sleeping_.store(false, std::memory_order_relaxed);
+      continue;
     }
 
-    if (!KeepProcessing(incoming_async_action)) {
+    if (!writer_event_.WaitForEvent() &&
+        engine::current_task::ShouldCancel()) {
       return;
     }
+    is_writer_sleeping_.store(false, std::memory_order_relaxed);
   }
 }
 
-bool TpLogger::KeepProcessing(const impl::AsyncAction& action) {
-  switch (action.GetType()) {
-    case impl::ActionType::kLog:
-      BackendSinkIt(action);
-      break;
+std::size_t TpLogger::DrainBuffers(std::vector<impl::ThreadLogBuffer*>& buffers,
+                                   std::size_t max_batch_size) {
+  std::size_t consumed = 0;
+  for (auto* buffer : buffers) {
+    consumed += buffer->ConsumeBatch(
+        max_batch_size,
+        [this](const spdlog::details::log_msg& msg) { BackendSinkIt(msg); });
+  }
+  written_.store(written_.load(std::memory_order_relaxed) + consumed,
+                 std::memory_order_relaxed);
+  return consumed;
+}
 
-    case impl::ActionType::kFlush:
-      BackendFlush();
-      ++flush_index_;
-      break;
+void TpLogger::RefreshBuffers(
+    std::vector<impl::ThreadLogBuffer*>& buffers) const {
+  if (buffers_count_.load(std::memory_order_acquire) == buffers.size()) return;
 
-    case impl::ActionType::kStop:
-      return false;
+  std::lock_guard lock(buffers_mutex_);
+  buffers = buffers_;
+}
+
+bool TpLogger::HasPendingWork(
+    const std::vector<impl::ThreadLogBuffer*>& buffers) const {
+  if (stop_requested_ || flush_requested_.load() != flush_index_.load() ||
+      buffers_count_.load() != buffers.size()) {
+    return true;
+  }
+  for (const auto* buffer : buffers) {
+    if (!buffer->IsEmpty()) return true;
+  }
+  return false;
+}
+
+impl::ThreadLogBuffer& TpLogger::GetThreadBuffer() {
+  auto& cached = GetCachedThreadBuffer(id_);
+  if (cached.logger_id != id_) {
+    cached = {id_, &RegisterThreadBuffer()};
+  }
+  return *cached.buffer;
+}
 
-    default:
-      UASSERT(false);
+impl::ThreadLogBuffer& TpLogger::RegisterThreadBuffer() {
+  std::lock_guard lock(buffers_mutex_);
+  auto& buffer = thread_buffers_[std::this_thread::get_id()];
+  if (!buffer) {
+    buffer = std::make_unique<impl::ThreadLogBuffer>(thread_buffer_size_);
+    buffers_.push_back(buffer.get());
+    buffers_count_.store(buffers_.size(), std::memory_order_release);
   }
-  return true;
+  return *buffer;
 }
 
-void TpLogger::Push(impl::AsyncAction&& action) {
+void TpLogger::Push(const spdlog::details::log_msg& msg) {
+  // A coroutine may migrate to another thread on a context switch, so the
+  // buffer is looked up anew after each Yield() and is never used across it.
+  if (GetThreadBuffer().TryPush(msg)) {
+    NotifyWriter();
+    return;
+  }
+
   // Do not do blocking push if we are not in a coroutine context
   if (overflow_policy_ == LoggerConfig::QueueOveflowBehavior::kBlock &&
       engine::current_task::GetCurrentTaskContextUnchecked()) {
-    producer_.Push(std::move(action));
-  } else {
-    UASSERT(overflow_policy_ == LoggerConfig::QueueOveflowBehavior::kDiscard ||
-            !engine::current_task::GetCurrentTaskContextUnchecked());
-    producer_.PushNoblock(std::move(action));
+    do {
+      NotifyWriter();
+      engine::Yield();
+    } while (!GetThreadBuffer().TryPush(msg));
+    NotifyWriter();
+    return;
+  }
+
+  GetThreadBuffer().AccountDropped();
+}
+
+void TpLogger::NotifyWriter() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (is_writer_sleeping_.load(std::memory_order_relaxed) &&
+      is_writer_sleeping_.exchange(false)) {
+    writer_event_.Send();
   }
 }
 
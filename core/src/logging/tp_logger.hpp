@@ -2,78 +2,90 @@
 
 /// @copybrief logging::TpLogger
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include <spdlog/logger.h>
 
-#include <userver/concurrent/queue.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 
 #include "config.hpp"
+#include "thread_log_buffer.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
 namespace logging {
 
-namespace impl {
-
-enum class ActionType {
-  kLog,
-  kFlush,
-  kStop,
-};
-
-class AsyncAction final : public spdlog::details::log_msg_buffer {
- public:
-  AsyncAction() = default;
-
-  AsyncAction(const AsyncAction&) = delete;
-  AsyncAction& operator=(const AsyncAction&) = delete;
-  AsyncAction(AsyncAction&&) = default;
-  AsyncAction& operator=(AsyncAction&&) = default;
-
-  ~AsyncAction() = default;
-
-  explicit AsyncAction(ActionType type) : action_type_{type} {}
-
-  AsyncAction(ActionType type, const spdlog::details::log_msg& m)
-      : log_msg_buffer{m}, action_type_{type} {}
-
-  ActionType GetType() const noexcept { return action_type_; }
-
- private:
-  ActionType action_type_{ActionType::kLog};
+struct TpLoggerStatistics {
+  /// messages dropped because of the full thread buffers
+  std::uint64_t dropped{0};
+  /// messages written by the writer task
+  std::uint64_t written{0};
+  /// number of the thread buffers
+  std::size_t thread_buffers{0};
 };
 
-}  // namespace impl
-
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
+///
+/// Each thread writes into its own single producer single consumer buffer of
+/// `thread_buffer_size` messages created on the first message from the
+/// thread. The writer task drains the buffers in batches, so the
+/// logging threads do not contend with each other and with the sinks.
 class TpLogger final : public spdlog::logger {
  public:
   TpLogger(std::string logger_name, engine::TaskProcessor& task_processor,
-           std::size_t max_queue_size,
+           std::size_t thread_buffer_size,
            LoggerConfig::QueueOveflowBehavior overflow_policy);
   ~TpLogger() override;
 
   void SwitchToSyncMode();
 
- private:
-  using Queue = concurrent::NonFifoMpmcQueue<impl::AsyncAction>;
+  TpLoggerStatistics GetStatistics() const;
 
+ private:
   std::shared_ptr<logger> clone(std::string new_name) override;
   void sink_it_(const spdlog::details::log_msg& msg) override;
   void flush_() override;
 
   void ProcessingLoop();
-  bool KeepProcessing(const impl::AsyncAction& action);
-  void Push(impl::AsyncAction&& action);
+  std::size_t DrainBuffers(std::vector<impl::ThreadLogBuffer*>& buffers,
+                           std::size_t max_batch_size);
+  void RefreshBuffers(std::vector<impl::ThreadLogBuffer*>& buffers) const;
+  bool HasPendingWork(const std::vector<impl::ThreadLogBuffer*>& buffers) const;
+
+  impl::ThreadLogBuffer& GetThreadBuffer();
+  impl::ThreadLogBuffer& RegisterThreadBuffer();
+  void Push(const spdlog::details::log_msg& msg);
+  void NotifyWriter();
+
   void BackendSinkIt(const spdlog::details::log_msg& incoming_log_msg);
   void BackendFlush();
 
-  const std::shared_ptr<Queue> queue_;
-  engine::Task consuming_task_;
-  std::atomic<bool> in_fallback_mode_{false};
-  Queue::MultiProducer producer_;
+  const std::uint64_t id_;
+  const std::size_t thread_buffer_size_;
   const LoggerConfig::QueueOveflowBehavior overflow_policy_;
-  std::atomic<std::int32_t> flush_index_{0};
+
+  mutable std::mutex buffers_mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<impl::ThreadLogBuffer>>
+      thread_buffers_;
+  std::vector<impl::ThreadLogBuffer*> buffers_;
+  std::atomic<std::size_t> buffers_count_{0};
+
+  engine::SingleConsumerEvent writer_event_;
+  std::atomic<bool> is_writer_sleeping_{false};
+  std::atomic<bool> stop_requested_{false};
+  std::atomic<std::uint64_t> flush_requested_{0};
+  std::atomic<std::uint64_t> flush_index_{0};
+  std::atomic<std::uint64_t> written_{0};
+
+  std::atomic<bool> in_fallback_mode_{false};
+  engine::Task consuming_task_;
 };
 
 }  // namespace logging
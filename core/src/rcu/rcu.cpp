@@ -1,16 +1,81 @@
 #include <userver/rcu/rcu.hpp>
 
 #include <atomic>
+#include <mutex>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace rcu::impl {
 
+namespace {
+
+std::atomic<EpochReaderRecord*> epoch_readers_head{nullptr};
+std::atomic<uint64_t> epoch_sequence{0};
+// Serializes flips of epoch_index and reads of epoch_sequence by writers
+std::mutex epoch_mutex;
+
+bool IsEpochIndexDrained(std::size_t index) noexcept {
+  auto* const head = epoch_readers_head.load(std::memory_order_acquire);
+
+  // Unlocks are summed first: a counted unlock implies that the matching lock
+  // is visible to the second pass
+  uint64_t unlocks = 0;
+  for (auto* record = head; record; record = record->next) {
+    unlocks += record->unlocks[index].load(std::memory_order_acquire);
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  uint64_t locks = 0;
+  for (auto* record = head; record; record = record->next) {
+    locks += record->locks[index].load(std::memory_order_relaxed);
+  }
+  return locks == unlocks;
+}
+
+}  // namespace
+
 uint64_t GetNextEpoch() noexcept {
   static std::atomic<uint64_t> counter{1};  // 0 is the default value in data
   return counter++;
 }
 
+std::atomic<std::size_t> epoch_index{0};
+
+EpochReaderRecord& RegisterEpochReader() {
+  // Records are never freed, there is one per thread that ever read a Variable
+  // with ReclamationType::kEpochs
+  auto* record = new EpochReaderRecord();
+  auto* head = epoch_readers_head.load();
+  do {
+    record->next = head;
+  } while (!epoch_readers_head.compare_exchange_weak(head, record));
+  return *record;
+}
+
+uint64_t GetEpochSequence() noexcept {
+  std::lock_guard lock(epoch_mutex);
+  return epoch_sequence.load();
+}
+
+uint64_t TryAdvanceEpoch() noexcept {
+  std::unique_lock lock(epoch_mutex, std::try_to_lock);
+  if (!lock.owns_lock()) return epoch_sequence.load();
+
+  // Pairs with the fence in EpochReadLock()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  for (int i = 0; i < 2; ++i) {
+    const auto current = epoch_index.load(std::memory_order_relaxed);
+    if (!IsEpochIndexDrained(current ^ 1)) break;
+
+    epoch_index.store(current ^ 1);
+    epoch_sequence.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  return epoch_sequence.load();
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
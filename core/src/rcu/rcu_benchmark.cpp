@@ -10,13 +10,22 @@
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-template <int VariableCount>
+namespace {
+
+constexpr auto kHazardPointers = rcu::ReclamationType::kHazardPointers;
+constexpr auto kEpochs = rcu::ReclamationType::kEpochs;
+
+}  // namespace
+
+template <int VariableCount, rcu::ReclamationType Reclamation>
 void rcu_read(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    utils::FixedArray<rcu::Variable<std::uint64_t>> vars(
+        VariableCount, rcu::DestructionType::kSync, Reclamation, 0);
     {
       std::uint64_t i = 0;
       for (auto& var : vars) {
@@ -33,14 +42,18 @@ void rcu_read(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_read, 1);
-BENCHMARK_TEMPLATE(rcu_read, 2);
-BENCHMARK_TEMPLATE(rcu_read, 4);
-
-template <int VariableCount>
+BENCHMARK_TEMPLATE(rcu_read, 1, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 2, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 4, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 1, kEpochs);
+BENCHMARK_TEMPLATE(rcu_read, 2, kEpochs);
+BENCHMARK_TEMPLATE(rcu_read, 4, kEpochs);
+
+template <int VariableCount, rcu::ReclamationType Reclamation>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    utils::FixedArray<rcu::Variable<std::uint64_t>> vars(
+        VariableCount, rcu::DestructionType::kSync, Reclamation, 0);
 
     std::uint64_t i = 0;
     for (auto _ : state) {
@@ -49,10 +62,14 @@ void rcu_write(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_write, 1);
-BENCHMARK_TEMPLATE(rcu_write, 2);
-BENCHMARK_TEMPLATE(rcu_write, 4);
-
+BENCHMARK_TEMPLATE(rcu_write, 1, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 2, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 4, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 1, kEpochs);
+BENCHMARK_TEMPLATE(rcu_write, 2, kEpochs);
+BENCHMARK_TEMPLATE(rcu_write, 4, kEpochs);
+
+template <rcu::ReclamationType Reclamation>
 void rcu_contention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
@@ -63,7 +80,8 @@ void rcu_contention(benchmark::State& state) {
 
   engine::RunStandalone(thread_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::uint64_t> var{0};
+    rcu::Variable<std::uint64_t> var{rcu::DestructionType::kSync, Reclamation,
+                                     0};
 
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(readers_count - 1 + writers_count);
@@ -112,7 +130,11 @@ void rcu_contention(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_contention)
+BENCHMARK_TEMPLATE(rcu_contention, kHazardPointers)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+BENCHMARK_TEMPLATE(rcu_contention, kEpochs)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
@@ -298,6 +298,57 @@ UTEST(Rcu, Cleanup) {
   EXPECT_EQ(count.load(), 1);
 }
 
+UTEST(Rcu, EpochCleanup) {
+  static std::atomic<size_t> count{0};
+  struct X {
+    X() { count++; }
+    X(X&&) noexcept { count++; }
+    X(const X&) { count++; }
+    ~X() { count--; }
+  };
+
+  rcu::Variable<X> ptr(rcu::DestructionType::kSync,
+                       rcu::ReclamationType::kEpochs);
+  EXPECT_EQ(count.load(), 1);
+
+  {
+    auto reader = ptr.Read();
+    ptr.Assign(X{});
+    // the old value is held by the reader
+    EXPECT_EQ(count.load(), 2);
+
+    auto reader_copy = reader;
+    EXPECT_EQ(reader_copy.Get(), reader.Get());
+  }
+
+  ptr.Cleanup();
+  EXPECT_EQ(count.load(), 1);
+
+  // nobody reads, the old value is destroyed right away
+  ptr.Assign(X{});
+  EXPECT_EQ(count.load(), 1);
+}
+
+UTEST(Rcu, EpochReadWrite) {
+  rcu::Variable<X> ptr(rcu::DestructionType::kSync,
+                       rcu::ReclamationType::kEpochs, 1, 2);
+
+  auto reader1 = ptr.Read();
+  {
+    auto writer = ptr.StartWrite();
+    writer->first = 3;
+    writer.Commit();
+  }
+  auto reader2 = ptr.Read();
+
+  EXPECT_EQ(std::make_pair(1, 2), *reader1);
+  EXPECT_EQ(std::make_pair(3, 2), *reader2);
+
+  reader1 = std::move(reader2);
+  EXPECT_EQ(std::make_pair(3, 2), *reader1);
+  EXPECT_EQ(std::make_pair(3, 2), ptr.ReadCopy());
+}
+
 UTEST(Rcu, ParallelCleanup) {
   rcu::Variable<int> ptr(1);
 
@@ -448,6 +499,52 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+UTEST_MT(Rcu, EpochTortureTest, kTotalTasks) {
+  rcu::Variable<CleaningUpInt> data{rcu::DestructionType::kAsync,
+                                    rcu::ReclamationType::kEpochs, 1};
+  std::atomic<bool> keep_running{true};
+
+  engine::Mutex ping_pong_mutex;
+  rcu::ReadablePtr<CleaningUpInt> ptr = data.Read();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kReadablePtrPingPongTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::lock_guard lock(ping_pong_mutex);
+        // copy a ptr created by another thread
+        ptr = rcu::ReadablePtr{ptr};
+        ASSERT_GT(ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kReadingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        ASSERT_GT(local_ptr->value, 0);
+        // migrate to another thread while holding the read lock
+        engine::Yield();
+        ASSERT_GT(local_ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.Read();
+        data.Assign(CleaningUpInt{old->value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
@@ -0,0 +1,143 @@
+#include <userver/utest/utest.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/rcu/sharded_rcu_map.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ShardedRcuMap, Empty) {
+  rcu::ShardedRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  using Map = rcu::ShardedRcuMap<std::string, int>;
+  EXPECT_EQ(map.GetShardsCount(), Map::kDefaultShardsCount);
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(cmap.begin(), cmap.end());
+  EXPECT_TRUE(map.GetSnapshot().empty());
+  map.Clear();
+  EXPECT_TRUE(map.GetSnapshot().empty());
+}
+
+UTEST(ShardedRcuMap, ZeroShards) {
+  using Map = rcu::ShardedRcuMap<int, int>;
+  UEXPECT_THROW(Map{0}, std::logic_error);
+}
+
+UTEST(ShardedRcuMap, Modify) {
+  rcu::ShardedRcuMap<std::string, int> map(4);
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(cmap.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *cmap.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.Pop("any"), 4);
+
+  EXPECT_TRUE(map.TryEmplace("any", 5).inserted);
+  EXPECT_EQ(*map.TryEmplace("any", 0).value, 5);
+
+  map.InsertOrAssign("any", std::make_shared<int>(6));
+  EXPECT_EQ(*cmap["any"], 6);
+  EXPECT_EQ(*map.Pop("any"), 6);
+}
+
+UTEST(ShardedRcuMap, IterationAndAssign) {
+  constexpr int kSize = 100;
+  rcu::ShardedRcuMap<int, int> map(8);
+
+  rcu::ShardedRcuMap<int, int>::RawMap raw;
+  for (int i = 0; i < kSize; ++i) raw.emplace(i, std::make_shared<int>(i));
+  map.Assign(std::move(raw));
+  EXPECT_EQ(map.SizeApprox(), kSize);
+
+  std::array<bool, kSize> seen{};
+  for (const auto& [key, value] : std::as_const(map)) {
+    ASSERT_TRUE(key >= 0 && key < kSize);
+    EXPECT_FALSE(std::exchange(seen[key], true));
+    EXPECT_EQ(key, *value);
+  }
+  for (const auto& [key, value] : map) ++*value;
+
+  const auto snapshot = map.GetSnapshot();
+  ASSERT_EQ(snapshot.size(), kSize);
+  for (int i = 0; i < kSize; ++i) EXPECT_EQ(*snapshot.at(i), i + 1);
+
+  map.Assign({{kSize, std::make_shared<int>(0)}});
+  EXPECT_EQ(map.SizeApprox(), 1);
+  EXPECT_FALSE(map.Get(0));
+  EXPECT_TRUE(map.Get(kSize));
+}
+
+UTEST(ShardedRcuMap, StartWriteShard) {
+  rcu::ShardedRcuMap<int, int> map(4);
+
+  {
+    auto shard = map.StartWriteShard(1);
+    shard->emplace(1, std::make_shared<int>(1));
+    shard.Commit();
+  }
+  EXPECT_EQ(*map[1], 1);
+  EXPECT_EQ(map.SizeApprox(), 1);
+}
+
+UTEST_MT(ShardedRcuMap, ConcurrentWriters, 4) {
+  constexpr int kKeysPerWriter = 100;
+  rcu::ShardedRcuMap<int, int> map;
+  std::array<engine::TaskWithResult<void>, 4> workers;
+  std::atomic<bool> stop_flag{false};
+
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i] = utils::Async("writer", [i, &map, &stop_flag] {
+      const int base = static_cast<int>(i) * kKeysPerWriter;
+      while (!stop_flag) {
+        for (int key = base; key < base + kKeysPerWriter; ++key) {
+          ASSERT_TRUE(map.Emplace(key, key).inserted);
+        }
+        for (int key = base; key < base + kKeysPerWriter; ++key) {
+          const auto value = map.Get(key);
+          ASSERT_TRUE(value);
+          ASSERT_EQ(*value, key);
+          ASSERT_TRUE(map.Erase(key));
+        }
+      }
+    });
+  }
+
+  std::size_t iterations = 0;
+  while (iterations++ < 100) {
+    for (const auto& [key, value] : std::as_const(map)) {
+      ASSERT_EQ(key, *value);
+    }
+    engine::Yield();
+  }
+  engine::SleepFor(std::chrono::milliseconds(50));
+  stop_flag = true;
+  for (auto& w : workers) w.Get();
+
+  EXPECT_EQ(map.SizeApprox(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+USERVER_NAMESPACE_END
@@ -137,9 +137,63 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    idle_release_timeout:
+                        type: string
+                        description: release the tasks and buffers of a connection that has no requests in progress and received nothing for this time, the connection is woken up once the peer sends data again; 0 to disable
+                        defaultDescription: 0
+                    cancel_on_disconnect:
+                        type: boolean
+                        description: keep watching the socket while the final request of a connection (e.g. with `Connection: close`) is in progress and cancel it once the peer closes or resets the connection; requests on keep-alive connections are always cancelled on disconnect
+                        defaultDescription: false
+                    http2:
+                        type: object
+                        description: HTTP/2 options
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: accept HTTP/2 with prior knowledge (h2c) along with HTTP/1.1 on the listener
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: max concurrent streams of an HTTP/2 connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: HTTP/2 per-stream flow-control window for the request bodies, in bytes
+                                defaultDescription: 65535
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+            ev_thread_per_shard:
+                type: boolean
+                description: serve each of the `shards` SO_REUSEPORT sockets and all its accepted connections by its own ev thread
+                defaultDescription: false
+            reuseport_cpu_bpf:
+                type: boolean
+                description: attach a BPF program to the SO_REUSEPORT group that passes the connections received on CPU `i` to the `i % shards` socket
+                defaultDescription: false
+            request_queue:
+                type: object
+                description: CoDel-style dropping of the requests of the handlers with throttling that wait too long in the task processor queue
+                additionalProperties: false
+                properties:
+                    codel_enabled:
+                        type: boolean
+                        description: drop the requests that waited more than twice the target of their priority class, once no request of the class waited less than the target during the interval
+                        defaultDescription: false
+                    codel_interval:
+                        type: string
+                        description: interval of CoDel overload detection
+                        defaultDescription: 100ms
+                    normal_target:
+                        type: string
+                        description: target queue time of the handlers with 'normal' priority_class
+                        defaultDescription: 10ms
+                    batch_target:
+                        type: string
+                        description: target queue time of the handlers with 'batch' priority_class
+                        defaultDescription: 5ms
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -181,6 +235,31 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    idle_release_timeout:
+                        type: string
+                        description: release the tasks and buffers of a connection that has no requests in progress and received nothing for this time, the connection is woken up once the peer sends data again; 0 to disable
+                        defaultDescription: 0
+                    cancel_on_disconnect:
+                        type: boolean
+                        description: keep watching the socket while the final request of a connection (e.g. with `Connection: close`) is in progress and cancel it once the peer closes or resets the connection; requests on keep-alive connections are always cancelled on disconnect
+                        defaultDescription: false
+                    http2:
+                        type: object
+                        description: HTTP/2 options
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: accept HTTP/2 with prior knowledge (h2c) along with HTTP/1.1 on the listener
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: max concurrent streams of an HTTP/2 connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: HTTP/2 per-stream flow-control window for the request bodies, in bytes
+                                defaultDescription: 65535
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -201,6 +280,35 @@ properties:
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+            ev_thread_per_shard:
+                type: boolean
+                description: serve each of the `shards` SO_REUSEPORT sockets and all its accepted connections by its own ev thread
+                defaultDescription: false
+            reuseport_cpu_bpf:
+                type: boolean
+                description: attach a BPF program to the SO_REUSEPORT group that passes the connections received on CPU `i` to the `i % shards` socket
+                defaultDescription: false
+            request_queue:
+                type: object
+                description: CoDel-style dropping of the requests of the handlers with throttling that wait too long in the task processor queue
+                additionalProperties: false
+                properties:
+                    codel_enabled:
+                        type: boolean
+                        description: drop the requests that waited more than twice the target of their priority class, once no request of the class waited less than the target during the interval
+                        defaultDescription: false
+                    codel_interval:
+                        type: string
+                        description: interval of CoDel overload detection
+                        defaultDescription: 100ms
+                    normal_target:
+                        type: string
+                        description: target queue time of the handlers with 'normal' priority_class
+                        defaultDescription: 10ms
+                    batch_target:
+                        type: string
+                        description: target queue time of the handlers with 'batch' priority_class
+                        defaultDescription: 5ms
     set-response-server-hostname:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
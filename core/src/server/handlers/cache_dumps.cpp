@@ -0,0 +1,90 @@
+#include <userver/server/handlers/cache_dumps.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <userver/components/component.hpp>
+#include <userver/components/dump_configurator.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <dump/dump_locator.hpp>
+#include <dump/peers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+bool IsValidDumperName(const std::string& name) {
+  return !name.empty() && name != "." && name != ".." &&
+         name.find('/') == std::string::npos;
+}
+
+}  // namespace
+
+CacheDumps::CacheDumps(const components::ComponentConfig& config,
+                       const components::ComponentContext& context)
+    : HttpHandlerBase(config, context, /*is_monitor = */ true),
+      dump_root_(context.FindComponent<components::DumpConfigurator>()
+                     .GetDumpRoot()),
+      fs_task_processor_(context.GetTaskProcessor(
+          config["fs-task-processor"].As<std::string>("fs-task-processor"))) {}
+
+std::string CacheDumps::HandleRequestThrow(const http::HttpRequest& request,
+                                           request::RequestContext&) const {
+  if (request.GetMethod() != http::HttpMethod::kGet) {
+    ThrowUnsupportedHttpMethod(request);
+  }
+
+  const auto& name = request.GetArg("name");
+  if (!IsValidDumperName(name)) {
+    throw ClientError(ExternalBody{"invalid 'name'"});
+  }
+
+  std::uint64_t format_version = 0;
+  try {
+    format_version =
+        utils::FromString<std::uint64_t>(request.GetArg("format-version"));
+  } catch (const std::exception&) {
+    throw ClientError(ExternalBody{"invalid 'format-version'"});
+  }
+
+  const auto dump = engine::AsyncNoSpan(fs_task_processor_, [&] {
+                      return dump::DumpLocator::FindLatestDump(
+                          dump_root_ + '/' + name, format_version);
+                    }).Get();
+  if (!dump) {
+    request.GetHttpResponse().SetStatusNotFound();
+    return {};
+  }
+
+  auto contents = fs::ReadFileContents(fs_task_processor_, dump->full_path);
+
+  auto& response = request.GetHttpResponse();
+  response.SetContentType("application/octet-stream");
+  response.SetHeader(
+      std::string{dump::kDumpFilenameHeader},
+      boost::filesystem::path{dump->full_path}.filename().string());
+  return contents;
+}
+
+yaml_config::Schema CacheDumps::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cache-dumps config
+additionalProperties: false
+properties:
+    fs-task-processor:
+        type: string
+        description: TaskProcessor for blocking disk IO
+        defaultDescription: fs-task-processor
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
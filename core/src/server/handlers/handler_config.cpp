@@ -5,6 +5,7 @@
 #include <server/server_config.hpp>
 
 #include <userver/formats/parse/common_containers.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,6 +24,27 @@ UrlTrailingSlashOption Parse(const yaml_config::YamlConfig& yaml,
                            '\'');
 }
 
+PriorityClass Parse(const yaml_config::YamlConfig& yaml,
+                    formats::parse::To<PriorityClass>) {
+  const auto& value = yaml.As<std::string>();
+  if (value == "critical") return PriorityClass::kCritical;
+  if (value == "normal") return PriorityClass::kNormal;
+  if (value == "batch") return PriorityClass::kBatch;
+  throw std::runtime_error("can't parse PriorityClass from '" + value + '\'');
+}
+
+std::string_view ToString(PriorityClass priority_class) {
+  switch (priority_class) {
+    case PriorityClass::kCritical:
+      return "critical";
+    case PriorityClass::kNormal:
+      return "normal";
+    case PriorityClass::kBatch:
+      return "batch";
+  }
+  UINVARIANT(false, "Unexpected PriorityClass");
+}
+
 FallbackHandler Parse(const yaml_config::YamlConfig& yaml,
                       formats::parse::To<FallbackHandler>) {
   const auto& value = yaml.As<std::string>();
@@ -81,11 +103,26 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
   config.decompress_request = value["decompress_request"].As<bool>(false);
+  config.compress_response = value["compress_response"].As<bool>(false);
+  config.compress_response_level =
+      value["compress_response_level"].As<int>(6);
+  config.compress_response_min_size =
+      value["compress_response_min_size"].As<size_t>(1024);
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
+  config.priority_class =
+      value["priority_class"].As<PriorityClass>(PriorityClass::kDefault);
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.request_body_stream = value["request-body-stream"].As<bool>(false);
+
+  if (config.compress_response_level < 1 ||
+      config.compress_response_level > 9) {
+    throw std::runtime_error(
+        "compress_response_level should be in [1, 9], current value is " +
+        std::to_string(config.compress_response_level));
+  }
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
@@ -5,12 +5,17 @@
 #include <boost/algorithm/string/split.hpp>
 
 #include <compression/gzip.hpp>
+#include <congestion_control/gradient_limiter.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
+#include <server/handlers/http_response_cache.hpp>
 #include <server/handlers/http_server_settings.hpp>
+#include <server/http/conditional_request.hpp>
+#include <server/http/content_encoding.hpp>
 #include <server/http/http_request_impl.hpp>
 #include <server/server_config.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/congestion_control/config.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/inherited_variable.hpp>
@@ -29,6 +34,7 @@
 #include <userver/tracing/set_throttle_reason.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/tracing/tracer.hpp>
 #include <userver/tracing/tracing.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/from_string.hpp>
@@ -53,6 +59,8 @@ const std::string kHostname = hostinfo::blocking::GetRealHostName();
 // set to 1 if you need server metrics
 constexpr bool kIncludeServerHttpMetrics = false;
 
+constexpr std::chrono::milliseconds kDefaultTailSamplingThreshold{1000};
+
 template <typename HeadersHolder>
 std::string GetHeadersLogString(const HeadersHolder& headers_holder) {
   formats::json::ValueBuilder json_headers(formats::json::Type::kObject);
@@ -128,14 +136,16 @@ class RequestProcessor final {
       }
 
       const auto status_code = response.GetStatus();
+      int response_code = static_cast<int>(status_code);
+      // the error flag is also checked by the tail sampling of the span
+      if (response_code >= 500) span.AddTag(tracing::kErrorFlag, true);
+
       span.SetLogLevel(handler_.GetLogLevelForResponseStatus(status_code));
       if (!span.ShouldLogDefault()) {
         return;
       }
 
-      int response_code = static_cast<int>(status_code);
       span.AddTag(tracing::kHttpStatusCode, response_code);
-      if (response_code >= 500) span.AddTag(tracing::kErrorFlag, true);
 
       if (log_request_) {
         if (log_request_headers_) {
@@ -225,9 +235,10 @@ class RequestProcessor final {
 
 std::optional<std::chrono::milliseconds> ParseTimeout(
     const http::HttpRequest& request) {
-  const auto& timeout_ms_str = request.GetHeader(
+  const std::string_view timeout_ms_header = request.GetHeaderView(
       USERVER_NAMESPACE::http::headers::kXYaTaxiClientTimeoutMs);
-  if (timeout_ms_str.empty()) return std::nullopt;
+  if (timeout_ms_header.empty()) return std::nullopt;
+  const std::string timeout_ms_str{timeout_ms_header};
 
   LOG_DEBUG() << "Got client timeout_ms=" << timeout_ms_str;
   std::chrono::milliseconds timeout;
@@ -307,26 +318,34 @@ logging::LogExtra LogRequestExtra(bool need_log_request_headers,
   log_extra.Extend(kTracingUri, http_request.GetUrl());
   log_extra.Extend(tracing::kHttpMethod, http_request.GetMethodStr());
 
-  const auto& request_application = http_request.GetHeader(
+  const auto request_application = http_request.GetHeaderView(
       USERVER_NAMESPACE::http::headers::kXRequestApplication);
   if (!request_application.empty()) {
-    log_extra.Extend("request_application", request_application);
+    log_extra.Extend("request_application", std::string{request_application});
   }
 
-  const auto& user_agent =
-      http_request.GetHeader(USERVER_NAMESPACE::http::headers::kUserAgent);
+  const auto user_agent =
+      http_request.GetHeaderView(USERVER_NAMESPACE::http::headers::kUserAgent);
   if (!user_agent.empty()) {
-    log_extra.Extend(kUserAgentTag, user_agent);
+    log_extra.Extend(kUserAgentTag, std::string{user_agent});
   }
-  const auto& accept_language =
-      http_request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptLanguage);
+  const auto accept_language = http_request.GetHeaderView(
+      USERVER_NAMESPACE::http::headers::kAcceptLanguage);
   if (!accept_language.empty()) {
-    log_extra.Extend(kAcceptLanguageTag, accept_language);
+    log_extra.Extend(kAcceptLanguageTag, std::string{accept_language});
   }
 
   return log_extra;
 }
 
+std::unique_ptr<HttpResponseCache> MakeResponseCache(
+    const components::ComponentConfig& config) {
+  const auto cache_config =
+      config["response-cache"].As<std::optional<HttpResponseCacheConfig>>();
+  if (!cache_config) return nullptr;
+  return std::make_unique<HttpResponseCache>(*cache_config);
+}
+
 }  // namespace
 
 HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
@@ -343,11 +362,26 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
           context, GetConfig(),
           context.FindComponent<components::AuthCheckerSettings>().Get())),
       log_level_(config["log-level"].As<std::optional<logging::Level>>()),
+      tail_sampling_log_level_(
+          config["tail-sampling-log-level"]
+              .As<std::optional<logging::Level>>()),
+      tail_sampling_latency_threshold_(
+          config["tail-sampling-latency-threshold"]
+              .As<std::chrono::milliseconds>(kDefaultTailSamplingThreshold)),
+      tracing_sampling_ratio_(config["tracing-sampling-ratio"].As<double>(1.0)),
       rate_limit_(utils::TokenBucket::MakeUnbounded()),
-      is_body_streamed_(config["response-body-stream"].As<bool>(false)) {
+      is_body_streamed_(config["response-body-stream"].As<bool>(false)),
+      adaptive_concurrency_(
+          std::make_unique<congestion_control::GradientLimiter>()),
+      response_cache_(MakeResponseCache(config)) {
   if (allowed_methods_.empty()) {
     LOG_WARNING() << "empty allowed methods list in " << config.Name();
   }
+  if (tracing_sampling_ratio_ < 0 || tracing_sampling_ratio_ > 1) {
+    throw std::runtime_error(
+        fmt::format("tracing-sampling-ratio of {} must be in [0, 1], got {}",
+                    config.Name(), tracing_sampling_ratio_));
+  }
 
   if (GetConfig().max_requests_per_second) {
     const auto max_rps = *GetConfig().max_requests_per_second;
@@ -394,6 +428,8 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
         if constexpr (kIncludeServerHttpMetrics) {
           FormatStatistics(result["request"], *request_statistics_);
         }
+        result["adaptive-concurrency"] = adaptive_concurrency_->GetStatistics();
+        if (response_cache_) result["response-cache"] = *response_cache_;
       },
       std::move(labels));
 
@@ -402,9 +438,18 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
           server_component.GetServer()
               .GetConfig()
               .set_response_server_hostname);
+
+  auto config_source = config_source_;
+  adaptive_concurrency_subscription_ = config_source.UpdateAndListen(
+      this, "http_handler_base." + handler_name_,
+      &HttpHandlerBase::OnAdaptiveConcurrencyConfigUpdate,
+      congestion_control::impl::kAdaptiveConcurrencyConfig);
 }
 
-HttpHandlerBase::~HttpHandlerBase() { statistics_holder_.Unregister(); }
+HttpHandlerBase::~HttpHandlerBase() {
+  adaptive_concurrency_subscription_.Unsubscribe();
+  statistics_holder_.Unregister();
+}
 
 void HttpHandlerBase::HandleRequestStream(
     const http::HttpRequest& http_request, http::HttpResponse& response,
@@ -414,6 +459,13 @@ void HttpHandlerBase::HandleRequestStream(
   auto& http_response = http_request.GetHttpResponse();
   server::http::ResponseBodyStream response_body_stream{
       response.GetBodyProducer(), http_response};
+  if (GetConfig().compress_response) {
+    http::AddVaryAcceptEncoding(response);
+    if (IsResponseCompressionAccepted(http_request)) {
+      response_body_stream.EnableCompression(
+          GetConfig().compress_response_level);
+    }
+  }
 
   // Just in case HandleStreamRequest() throws an exception.
   // Though it can be changed in HandleStreamRequest().
@@ -454,6 +506,39 @@ void HttpHandlerBase::HandleRequestStream(
   }
 }
 
+void HttpHandlerBase::HandleRequestCached(
+    const http::HttpRequest& http_request, const std::string& key,
+    http::HttpResponse& response, request::RequestContext& context) const {
+  std::optional<HttpResponseCache::LoadToken> load_token;
+  auto entry = response_cache_->Get(key, load_token);
+  const bool is_cache_hit = entry != nullptr;
+  if (is_cache_hit) {
+    for (const auto& [name, value] : entry->headers) {
+      response.SetHeader(name, value);
+    }
+  } else {
+    auto data = HandleRequestThrow(http_request, context);
+    if (!data.empty() || !response.HasSharedData()) {
+      response.SetData(std::move(data));
+    }
+    entry = response_cache_->Put(key, response);
+    if (!entry) return;
+  }
+
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kETag, entry->etag);
+  if (http::IsNoneMatchFailed(
+          http_request.GetHeaderView(
+              USERVER_NAMESPACE::http::headers::kIfNoneMatch),
+          entry->etag)) {
+    response.SetStatus(http::HttpStatus::kNotModified);
+    response.SetData({});
+    return;
+  }
+
+  // the cached body outlives the response, no need to copy it
+  if (is_cache_hit) response.SetSharedData(entry->body, entry);
+}
+
 void HttpHandlerBase::HandleRequest(request::RequestBase& request,
                                     request::RequestContext& context) const {
   UASSERT(dynamic_cast<http::HttpRequestImpl*>(&request));
@@ -463,8 +548,8 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   auto& response = http_request.GetHttpResponse();
 
   try {
-    HttpHandlerStatisticsScope stats_scope(*handler_statistics_,
-                                           http_request.GetMethod(), response);
+    HttpHandlerStatisticsScope stats_scope(
+        *handler_statistics_, http_request.GetMethod(), request, response);
 
     const auto server_settings = config_source_.GetCopy(kHttpServerSettings);
 
@@ -476,18 +561,18 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
                               server_settings, inherited_data);
     request::kTaskInheritedData.Set(inherited_data);
 
-    const auto& parent_link =
-        http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaRequestId);
-    const auto& trace_id =
-        http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaTraceId);
-    const auto& parent_span_id =
-        http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaSpanId);
+    const auto parent_link = http_request.GetHeaderView(
+        USERVER_NAMESPACE::http::headers::kXYaRequestId);
+    const auto trace_id = http_request.GetHeaderView(
+        USERVER_NAMESPACE::http::headers::kXYaTraceId);
+    const auto parent_span_id = http_request.GetHeaderView(
+        USERVER_NAMESPACE::http::headers::kXYaSpanId);
 
-    const auto& yandex_request_id =
-        http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXRequestId);
-    const auto& yandex_backend_server = http_request.GetHeader(
+    const auto yandex_request_id = http_request.GetHeaderView(
+        USERVER_NAMESPACE::http::headers::kXRequestId);
+    const auto yandex_backend_server = http_request.GetHeaderView(
         USERVER_NAMESPACE::http::headers::kXBackendServer);
-    const auto& envoy_proxy = http_request.GetHeader(
+    const auto envoy_proxy = http_request.GetHeaderView(
         USERVER_NAMESPACE::http::headers::kXTaxiEnvoyProxyDstVhost);
 
     if (!yandex_request_id.empty() || !yandex_backend_server.empty() ||
@@ -511,9 +596,19 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
                          span.GetSpanId());
     }
 
+    if (tracing_sampling_ratio_ < 1 &&
+        !tracing::Tracer::IsSampled(span.GetTraceId(),
+                                    tracing_sampling_ratio_)) {
+      span.SetSampled(false);
+    }
+
     span.SetLocalLogLevel(log_level_);
+    if (tail_sampling_log_level_) {
+      span.EnableTailSampling(*tail_sampling_log_level_,
+                              tail_sampling_latency_threshold_);
+    }
 
-    if (!parent_link.empty()) span.SetParentLink(parent_link);
+    if (!parent_link.empty()) span.SetParentLink(std::string{parent_link});
 
     const auto meta_type = CutTrailingSlash(GetMetaType(http_request),
                                             GetConfig().url_trailing_slash);
@@ -536,7 +631,7 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         server_settings.need_log_request,
         server_settings.need_log_request_headers);
 
-    request_processor.ProcessRequestStep(
+    const bool is_ratelimited = request_processor.ProcessRequestStep(
         kCheckRatelimitStep,
         [this, &http_request] { return CheckRatelimit(http_request); });
 
@@ -566,18 +661,33 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     }
 
     request_processor.ProcessRequestStep(
-        kHandleRequestStep, [this, &response, &http_request, &context] {
+        kHandleRequestStep,
+        [this, &response, &http_request, &http_request_impl, &context] {
           if (response.IsBodyStreamed()) {
             HandleRequestStream(http_request, response, context);
+          } else if (response_cache_ &&
+                     HttpResponseCache::IsCacheable(http_request_impl)) {
+            HandleRequestCached(http_request,
+                                response_cache_->MakeKey(http_request_impl),
+                                response, context);
           } else {
             // !IsBodyStreamed()
-            response.SetData(HandleRequestThrow(http_request, context));
+            auto data = HandleRequestThrow(http_request, context);
+            // the handler may have set the shared data and returned nothing
+            if (!data.empty() || !response.HasSharedData()) {
+              response.SetData(std::move(data));
+            }
           }
         });
+
+    if (!is_ratelimited) AccountAdaptiveConcurrency(request.StartTime());
   } catch (const std::exception& ex) {
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
+  if (GetConfig().compress_response && !response.IsBodyStreamed()) {
+    CompressResponse(http_request, response);
+  }
   SetResponseAcceptEncoding(response);
   SetResponseServerHostname(response);
   response.SetHeadersEnd();
@@ -708,13 +818,47 @@ void HttpHandlerBase::CheckRatelimit(
 
     throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
   }
+
+  const auto adaptive_limit = adaptive_concurrency_->GetLimit();
+  if (adaptive_limit && total_statistics.GetInFlight() > *adaptive_limit) {
+    auto& http_response = http_request.GetHttpResponse();
+    auto log_reason =
+        fmt::format("reached adaptive concurrency limit={}", *adaptive_limit);
+    SetThrottleReason(http_response, std::move(log_reason),
+                      USERVER_NAMESPACE::http::headers::ratelimit_reason::
+                          kAdaptiveConcurrency);
+
+    adaptive_concurrency_->AccountRejected();
+
+    throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
+  }
+}
+
+void HttpHandlerBase::AccountAdaptiveConcurrency(
+    std::chrono::steady_clock::time_point start_time) const {
+  // the time in the task processor queue is the first to grow on overload,
+  // so it is included
+  const auto now = std::chrono::steady_clock::now();
+  adaptive_concurrency_->Account(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - start_time),
+      handler_statistics_->GetTotal().GetInFlight(), now);
+}
+
+void HttpHandlerBase::OnAdaptiveConcurrencyConfigUpdate(
+    const dynamic_config::Snapshot& cfg) {
+  const auto& policies =
+      cfg[congestion_control::impl::kAdaptiveConcurrencyConfig].policies;
+  adaptive_concurrency_->SetPolicy(
+      policies.GetOptional(handler_name_).value_or(
+          congestion_control::GradientPolicy{}));
 }
 
 void HttpHandlerBase::DecompressRequestBody(
     http::HttpRequest& http_request) const {
   if (!http_request.IsBodyCompressed()) return;
 
-  const auto& content_encoding = http_request.GetHeader("Content-Encoding");
+  const auto content_encoding = http_request.GetHeaderView(
+      USERVER_NAMESPACE::http::headers::kContentEncoding);
 
   try {
     if (content_encoding == "gzip") {
@@ -739,6 +883,42 @@ void HttpHandlerBase::DecompressRequestBody(
   throw ClientError(HandlerErrorCode::kUnsupportedMediaType);
 }
 
+bool HttpHandlerBase::IsResponseCompressionAccepted(
+    const http::HttpRequest& http_request) const {
+  return http::IsContentCodingAccepted(
+      http_request.GetHeaderView(
+          USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+      "gzip");
+}
+
+void HttpHandlerBase::CompressResponse(const http::HttpRequest& http_request,
+                                       http::HttpResponse& response) const {
+  if (!http::IsCompressibleStatus(response.GetStatus()) ||
+      response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+
+  const auto data = response.GetDataView();
+  if (data.size() < GetConfig().compress_response_min_size) return;
+
+  // The representation depends on the Accept-Encoding from now on
+  http::AddVaryAcceptEncoding(response);
+  if (!IsResponseCompressionAccepted(http_request)) return;
+
+  try {
+    const tracing::ScopeTime scope_time{"http_compress_response"};
+    auto compressed = compression::gzip::Compress(
+        data, GetConfig().compress_response_level);
+    if (compressed.size() >= data.size()) return;
+
+    response.SetData(std::move(compressed));
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                       "gzip");
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "failed to compress the response, sending it as is: " << ex;
+  }
+}
+
 std::string HttpHandlerBase::GetRequestBodyForLogging(
     const http::HttpRequest&, request::RequestContext&,
     const std::string& request_body) const {
@@ -832,6 +1012,48 @@ properties:
         type: string
         description: overrides log level for this handle
         defaultDescription: <no override>
+    tail-sampling-log-level:
+        type: string
+        description: buffers the log messages of this and higher levels that are below the logger level and writes them only for the failed or slow requests
+        defaultDescription: <disabled>
+    tail-sampling-latency-threshold:
+        type: string
+        description: requests that took longer get their tail sampled log messages written
+        defaultDescription: 1s
+    tracing-sampling-ratio:
+        type: number
+        description: share of the requests in [0, 1] that are traced, the spans of the other requests are neither measured nor logged
+        defaultDescription: 1.0
+    response-cache:
+        type: object
+        description: caches the successful responses to GET and HEAD requests and answers 304 to the requests with a matching If-None-Match
+        defaultDescription: <disabled>
+        additionalProperties: false
+        properties:
+            size:
+                type: integer
+                description: max count of the cached responses
+            ways:
+                type: integer
+                description: count of the independently locked parts of the cache
+                defaultDescription: 16
+            lifetime:
+                type: string
+                description: how long a response is served from the cache
+            key-args:
+                type: array
+                description: the request args that the response depends on, besides the path
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: arg name
+            key-headers:
+                type: array
+                description: the request headers that the response depends on
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: header name
 )");
 }
 
@@ -17,6 +17,7 @@ void HttpHandlerMethodStatistics::Account(
   if (stats.cancellation == engine::TaskCancellationReason::kDeadline) {
     ++cancelled_by_deadline_;
   }
+  if (stats.cancelled_by_peer) ++cancelled_by_peer_;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -32,7 +33,8 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
       too_many_requests_in_flight(stats.GetTooManyRequestsInFlight()),
       rate_limit_reached(stats.GetRateLimitReached()),
       deadline_received(stats.GetDeadlineReceived()),
-      cancelled_by_deadline(stats.GetCancelledByDeadline()) {}
+      cancelled_by_deadline(stats.GetCancelledByDeadline()),
+      cancelled_by_peer(stats.GetCancelledByPeer()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(
     const HttpHandlerStatisticsSnapshot& other) {
@@ -43,6 +45,7 @@ void HttpHandlerStatisticsSnapshot::Add(
   rate_limit_reached += other.rate_limit_reached;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
+  cancelled_by_peer += other.cancelled_by_peer;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -53,6 +56,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["rate-limit-reached"] = stats.rate_limit_reached;
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
+  writer["cancelled-by-peer"] = stats.cancelled_by_peer;
   writer["timings"] = stats.timings;
 }
 
@@ -86,10 +90,11 @@ std::size_t HttpMethodToIndex(http::HttpMethod method) noexcept {
 
 HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
     HttpHandlerStatistics& stats, http::HttpMethod method,
-    server::http::HttpResponse& response)
+    const request::RequestBase& request, server::http::HttpResponse& response)
     : stats_(stats),
       method_(method),
       start_time_(std::chrono::steady_clock::now()),
+      request_(request),
       response_(response) {
   stats_.ForMethodAndTotal(method, [&](HttpHandlerMethodStatistics& stats) {
     stats.IncrementInFlight();
@@ -106,6 +111,9 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
       finish_time - start_time_);
   stats.deadline = data ? data->deadline : engine::Deadline{};
   stats.cancellation = engine::current_task::CancellationReason();
+  stats.cancelled_by_peer =
+      stats.cancellation != engine::TaskCancellationReason::kNone &&
+      request_.IsCancelledByPeer();
   stats_.Account(method_, stats);
 
   stats_.ForMethodAndTotal(method_, [&](HttpHandlerMethodStatistics& stats) {
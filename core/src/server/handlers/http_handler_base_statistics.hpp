@@ -13,6 +13,7 @@
 #include <userver/utils/statistics/aggregated_values.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 #include <utils/statistics/http_codes.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +27,7 @@ struct HttpHandlerStatisticsEntry final {
   engine::Deadline deadline{};
   engine::TaskCancellationReason cancellation{
       engine::TaskCancellationReason::kNone};
+  bool cancelled_by_peer{false};
 };
 
 class HttpHandlerMethodStatistics final {
@@ -59,11 +61,15 @@ class HttpHandlerMethodStatistics final {
   size_t GetRateLimitReached() const noexcept { return rate_limit_reached_; }
 
   std::uint64_t GetDeadlineReceived() const noexcept {
-    return deadline_received_.load();
+    return deadline_received_.Load();
   }
 
   std::uint64_t GetCancelledByDeadline() const noexcept {
-    return cancelled_by_deadline_.load();
+    return cancelled_by_deadline_.Load();
+  }
+
+  std::uint64_t GetCancelledByPeer() const noexcept {
+    return cancelled_by_peer_.Load();
   }
 
  private:
@@ -73,11 +79,14 @@ class HttpHandlerMethodStatistics final {
 
   RecentPeriod timings_;
   utils::statistics::HttpCodes reply_codes_;
+  // read on every request by the max_requests_in_flight check, so it is not
+  // sharded
   std::atomic<std::size_t> in_flight_{0};
-  std::atomic<std::uint64_t> too_many_requests_in_flight_{0};
-  std::atomic<std::uint64_t> rate_limit_reached_{0};
-  std::atomic<std::uint64_t> deadline_received_{0};
-  std::atomic<std::uint64_t> cancelled_by_deadline_{0};
+  utils::statistics::ShardedCounter<std::uint64_t> too_many_requests_in_flight_;
+  utils::statistics::ShardedCounter<std::uint64_t> rate_limit_reached_;
+  utils::statistics::ShardedCounter<std::uint64_t> deadline_received_;
+  utils::statistics::ShardedCounter<std::uint64_t> cancelled_by_deadline_;
+  utils::statistics::ShardedCounter<std::uint64_t> cancelled_by_peer_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -98,6 +107,7 @@ struct HttpHandlerStatisticsSnapshot final {
   std::uint64_t rate_limit_reached{0};
   std::uint64_t deadline_received{0};
   std::uint64_t cancelled_by_deadline{0};
+  std::uint64_t cancelled_by_peer{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -172,6 +182,7 @@ class HttpHandlerStatisticsScope final {
  public:
   HttpHandlerStatisticsScope(HttpHandlerStatistics& stats,
                              http::HttpMethod method,
+                             const request::RequestBase& request,
                              server::http::HttpResponse& response);
 
   ~HttpHandlerStatisticsScope();
@@ -180,6 +191,7 @@ class HttpHandlerStatisticsScope final {
   HttpHandlerStatistics& stats_;
   const http::HttpMethod method_;
   const std::chrono::steady_clock::time_point start_time_;
+  const request::RequestBase& request_;
   server::http::HttpResponse& response_;
 };
 
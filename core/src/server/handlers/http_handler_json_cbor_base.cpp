@@ -0,0 +1,162 @@
+#include <userver/server/handlers/http_handler_json_cbor_base.hpp>
+
+#include <optional>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/cbor.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/tracing/span.hpp>
+
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/handlers/json_error_builder.hpp>
+#include <userver/server/handlers/legacy_json_error_builder.hpp>
+#include <userver/server/http/http_error.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+const std::string kRequestDataName = "__request_json";
+const std::string kResponseDataName = "__response_json";
+const std::string kCborResponseDataName = "__response_cbor";
+const std::string kSerializeJson = "serialize_json";
+const std::string kSerializeCbor = "serialize_cbor";
+
+std::optional<USERVER_NAMESPACE::http::ContentType> ParseMediaRange(
+    std::string_view media_range) {
+  try {
+    return USERVER_NAMESPACE::http::ContentType{media_range};
+  } catch (const USERVER_NAMESPACE::http::MalformedContentType&) {
+    return std::nullopt;
+  }
+}
+
+bool IsCbor(const USERVER_NAMESPACE::http::ContentType& content_type) {
+  return content_type.MediaType() ==
+         USERVER_NAMESPACE::http::content_type::kApplicationCbor.MediaType();
+}
+
+bool IsCborContentType(std::string_view content_type) {
+  const auto parsed = ParseMediaRange(content_type);
+  return parsed && IsCbor(*parsed);
+}
+
+bool IsCborAccepted(std::string_view accept) {
+  while (!accept.empty()) {
+    const auto comma_pos = accept.find(',');
+    const auto media_range = accept.substr(0, comma_pos);
+    accept.remove_prefix(comma_pos == std::string_view::npos ? accept.size()
+                                                              : comma_pos + 1);
+
+    const auto parsed = ParseMediaRange(media_range);
+    if (parsed && IsCbor(*parsed) && parsed->Quality() > 0) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+HttpHandlerJsonCborBase::HttpHandlerJsonCborBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context, bool is_monitor)
+    : HttpHandlerBase(config, component_context, is_monitor) {}
+
+std::string HttpHandlerJsonCborBase::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  const auto& request_json =
+      context.GetData<const formats::json::Value&>(kRequestDataName);
+  const bool is_cbor = IsCborResponse(context);
+
+  auto& response = request.GetHttpResponse();
+  response.SetContentType(
+      is_cbor ? USERVER_NAMESPACE::http::content_type::kApplicationCbor
+              : USERVER_NAMESPACE::http::content_type::kApplicationJson);
+
+  const auto& response_json = context.SetData<const formats::json::Value>(
+      kResponseDataName,
+      HandleRequestJsonThrow(request, request_json, context));
+
+  if (is_cbor) {
+    const auto scope_time =
+        tracing::Span::CurrentSpan().CreateScopeTime(kSerializeCbor);
+    return formats::json::ToCborString(response_json);
+  }
+
+  const auto scope_time =
+      tracing::Span::CurrentSpan().CreateScopeTime(kSerializeJson);
+  return formats::json::ToString(response_json);
+}
+
+const formats::json::Value* HttpHandlerJsonCborBase::GetRequestJson(
+    const request::RequestContext& context) {
+  return context.GetDataOptional<const formats::json::Value>(kRequestDataName);
+}
+
+const formats::json::Value* HttpHandlerJsonCborBase::GetResponseJson(
+    const request::RequestContext& context) {
+  return context.GetDataOptional<const formats::json::Value>(kResponseDataName);
+}
+
+bool HttpHandlerJsonCborBase::IsCborResponse(
+    const request::RequestContext& context) {
+  const auto* is_cbor =
+      context.GetDataOptional<const bool>(kCborResponseDataName);
+  return is_cbor && *is_cbor;
+}
+
+FormattedErrorData HttpHandlerJsonCborBase::GetFormattedExternalErrorBody(
+    const CustomHandlerException& exc) const {
+  if (exc.GetServiceCode().empty()) {
+    // Legacy format has no "service codes", only HTTP codes.
+    return {LegacyJsonErrorBuilder(exc).GetExternalBody(),
+            LegacyJsonErrorBuilder::GetContentType()};
+  }
+  return {JsonErrorBuilder(exc).GetExternalBody(),
+          JsonErrorBuilder::GetContentType()};
+}
+
+void HttpHandlerJsonCborBase::ParseRequestData(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  const auto& body = request.RequestBody();
+  const bool is_cbor_request = IsCborContentType(request.GetHeaderView(
+      USERVER_NAMESPACE::http::headers::kContentType));
+
+  formats::json::Value request_json;
+  try {
+    if (!body.empty()) {
+      request_json = is_cbor_request ? formats::json::FromCborString(body)
+                                     : formats::json::FromString(body);
+    }
+  } catch (const formats::json::Exception& e) {
+    const std::string_view format = is_cbor_request ? "CBOR" : "JSON";
+    throw RequestParseError(
+        InternalMessage{fmt::format("Invalid {} body", format)},
+        ExternalBody{fmt::format("Invalid {} body: {}", format, e.what())});
+  }
+
+  const bool is_cbor_response =
+      body.empty() ? IsCborAccepted(request.GetHeaderView(
+                         USERVER_NAMESPACE::http::headers::kAccept))
+                   : is_cbor_request;
+
+  context.SetData<const formats::json::Value>(kRequestDataName, request_json);
+  context.SetData<const bool>(kCborResponseDataName, is_cbor_response);
+}
+
+yaml_config::Schema HttpHandlerJsonCborBase::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("HTTP handler JSON and CBOR base config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,13 @@
 #include <userver/server/handlers/http_handler_static.hpp>
 
+#include <server/http/conditional_request.hpp>
+#include <server/http/content_encoding.hpp>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/http/common_headers.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,9 +40,42 @@ std::string HttpHandlerStatic::HandleRequestThrow(
   const auto file = storage_.TryGetFile(request.GetRequestPath());
   if (file) {
     const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
-    return file->data;
+    auto& response = request.GetHttpResponse();
+    response.SetContentType(config[kContentTypeMap][file->extension]);
+
+    bool is_gzip = false;
+    if (!file->gzip_data.empty()) {
+      http::AddVaryAcceptEncoding(response);
+      is_gzip = http::IsContentCodingAccepted(
+          request.GetHeaderView(
+              USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+          "gzip");
+    }
+
+    if (!file->etag.empty()) {
+      // the compressed variant is only semantically equivalent to the file
+      response.SetHeader(
+          USERVER_NAMESPACE::http::headers::kETag,
+          is_gzip ? std::string{http::kWeakETagPrefix} + file->etag
+                  : file->etag);
+      if (http::IsNoneMatchFailed(
+              request.GetHeaderView(
+                  USERVER_NAMESPACE::http::headers::kIfNoneMatch),
+              file->etag)) {
+        response.SetStatus(http::HttpStatus::kNotModified);
+        return {};
+      }
+    }
+
+    // the cached file outlives the response, no need to copy it
+    if (is_gzip) {
+      response.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                         "gzip");
+      response.SetSharedData(file->gzip_data, file);
+    } else {
+      response.SetSharedData(file->GetContents(), file);
+    }
+    return {};
   }
   request.GetResponse().SetStatusNotFound();
   return "File not found";
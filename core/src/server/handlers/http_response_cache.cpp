@@ -0,0 +1,173 @@
+#include <server/handlers/http_response_cache.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/crypto/hash.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+// Headers that differ between the requests even for the same response
+bool IsPerRequestHeader(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, USERVER_NAMESPACE::http::headers::kXYaTraceId) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kXYaSpanId) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kETag);
+}
+
+// The responses that the handler does not want to be shared
+bool IsNoStore(std::string_view cache_control) {
+  return cache_control.find("no-store") != std::string_view::npos ||
+         cache_control.find("private") != std::string_view::npos;
+}
+
+void AppendKeyPart(std::string& key, std::string_view part) {
+  // the lengths keep the keys of the different parts apart
+  key += std::to_string(part.size());
+  key += ':';
+  key += part;
+}
+
+}  // namespace
+
+HttpResponseCacheConfig Parse(const yaml_config::YamlConfig& value,
+                              formats::parse::To<HttpResponseCacheConfig>) {
+  HttpResponseCacheConfig config;
+  config.size = value["size"].As<std::size_t>();
+  config.ways = value["ways"].As<std::size_t>(config.ways);
+  config.lifetime = value["lifetime"].As<std::chrono::milliseconds>();
+  config.key_args = value["key-args"].As<std::vector<std::string>>({});
+  config.key_headers = value["key-headers"].As<std::vector<std::string>>({});
+
+  if (config.size == 0 || config.ways == 0) {
+    throw std::runtime_error(fmt::format(
+        "'size' and 'ways' of {} should be positive", value.GetPath()));
+  }
+  if (config.lifetime <= std::chrono::milliseconds::zero()) {
+    throw std::runtime_error(fmt::format(
+        "'lifetime' of {} should be positive", value.GetPath()));
+  }
+  return config;
+}
+
+HttpResponseCache::HttpResponseCache(const HttpResponseCacheConfig& config)
+    : key_args_(config.key_args),
+      key_headers_(config.key_headers),
+      cache_(config.ways, (config.size + config.ways - 1) / config.ways) {
+  cache_.SetMaxLifetime(config.lifetime);
+}
+
+bool HttpResponseCache::IsCacheable(const http::HttpRequestImpl& request) {
+  const auto method = request.GetOrigMethod();
+  return method == http::HttpMethod::kGet || method == http::HttpMethod::kHead;
+}
+
+std::string HttpResponseCache::MakeKey(
+    const http::HttpRequestImpl& request) const {
+  std::string key;
+  AppendKeyPart(key, request.GetOrigMethodStr());
+  AppendKeyPart(key, request.GetRequestPath());
+  for (const auto& arg : key_args_) AppendKeyPart(key, request.GetArg(arg));
+  for (const auto& header : key_headers_) {
+    AppendKeyPart(key, request.GetHeaderView(header));
+  }
+  return key;
+}
+
+HttpResponseCache::LoadToken::LoadToken(HttpResponseCache& cache,
+                                        std::string key,
+                                        std::shared_ptr<Load> load)
+    : cache_(cache), key_(std::move(key)), load_(std::move(load)) {}
+
+HttpResponseCache::LoadToken::~LoadToken() {
+  {
+    const std::lock_guard lock(cache_.loads_mutex_);
+    cache_.loads_.erase(key_);
+  }
+  {
+    const std::lock_guard lock(load_->mutex);
+    load_->is_done = true;
+  }
+  load_->cv.NotifyAll();
+}
+
+HttpResponseCache::EntryPtr HttpResponseCache::Get(
+    const std::string& key, std::optional<LoadToken>& token) {
+  auto entry = cache_.GetOptionalNoUpdate(key);
+  if (entry) return *entry;
+
+  std::shared_ptr<Load> load;
+  {
+    const std::lock_guard lock(loads_mutex_);
+    auto& current = loads_[key];
+    if (!current) {
+      current = std::make_shared<Load>();
+      token.emplace(*this, key, current);
+      return nullptr;
+    }
+    load = current;
+  }
+
+  coalesced_.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock lock(load->mutex);
+  // a cancelled request is handled on its own
+  if (!load->cv.Wait(lock, [&load] { return load->is_done; })) return nullptr;
+  lock.unlock();
+
+  // the response may have turned out not cacheable
+  entry = cache_.GetOptionalNoUpdate(key);
+  return entry ? *entry : nullptr;
+}
+
+HttpResponseCache::EntryPtr HttpResponseCache::Put(
+    const std::string& key, const http::HttpResponse& response) {
+  if (response.GetStatus() != http::HttpStatus::kOk) return nullptr;
+  const auto cookies = response.GetCookieNames();
+  if (cookies.begin() != cookies.end()) return nullptr;
+  const auto& cache_control =
+      response.GetHeader(USERVER_NAMESPACE::http::headers::kCacheControl);
+  if (IsNoStore(cache_control)) return nullptr;
+
+  auto entry = std::make_shared<Entry>();
+  entry->body = std::string{response.GetDataView()};
+  const auto& etag =
+      response.GetHeader(USERVER_NAMESPACE::http::headers::kETag);
+  entry->etag = etag.empty() ? MakeETag(entry->body) : etag;
+  for (const auto& name : response.GetHeaderNames()) {
+    if (IsPerRequestHeader(name)) continue;
+    entry->headers.emplace_back(name, response.GetHeader(name));
+  }
+
+  EntryPtr result = std::move(entry);
+  cache_.Put(key, result);
+  return result;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpResponseCache& cache) {
+  const auto& stats = cache.cache_.GetStatistics();
+  writer["current-documents-count"] = cache.cache_.GetSizeApproximate();
+  writer["hits"] = stats.total.hits.load();
+  writer["misses"] = stats.total.misses.load();
+  writer["stale"] = stats.total.stale.load();
+  writer["coalesced"] = cache.coalesced_.load(std::memory_order_relaxed);
+}
+
+std::string MakeETag(std::string_view body) {
+  return '"' + crypto::hash::Sha1(body, crypto::hash::OutputEncoding::kBase64) +
+         '"';
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include <server/http/http_request_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+struct HttpResponseCacheConfig final {
+  std::size_t size{0};
+  std::size_t ways{16};
+  std::chrono::milliseconds lifetime{0};
+  std::vector<std::string> key_args;
+  std::vector<std::string> key_headers;
+};
+
+HttpResponseCacheConfig Parse(const yaml_config::YamlConfig& value,
+                              formats::parse::To<HttpResponseCacheConfig>);
+
+/// Cache of the successful responses to the GET and HEAD requests of a
+/// handler. The responses are keyed by the request method and path and the
+/// values of the configured args and headers, and are shared between all the
+/// clients that send the same key. The GET and HEAD responses are cached
+/// apart, as the handler sees both as GET and may set a different body.
+///
+/// The concurrent misses of a key wait for the first of them to be handled,
+/// so that the handler is not called once per request after an expiry.
+class HttpResponseCache final {
+  struct Load;
+
+ public:
+  struct Entry final {
+    std::string body;
+    std::string etag;
+    std::vector<std::pair<std::string, std::string>> headers;
+  };
+  using EntryPtr = std::shared_ptr<const Entry>;
+
+  /// Marks the key as being handled, wakes up the requests waiting for it
+  /// once destroyed
+  class LoadToken final {
+   public:
+    LoadToken(HttpResponseCache& cache, std::string key,
+              std::shared_ptr<Load> load);
+    LoadToken(LoadToken&&) = delete;
+    ~LoadToken();
+
+   private:
+    HttpResponseCache& cache_;
+    const std::string key_;
+    const std::shared_ptr<Load> load_;
+  };
+
+  explicit HttpResponseCache(const HttpResponseCacheConfig& config);
+
+  /// Returns false if the response to the request may not be cached
+  static bool IsCacheable(const http::HttpRequestImpl& request);
+
+  std::string MakeKey(const http::HttpRequestImpl& request) const;
+
+  /// Returns the fresh response for the key. Otherwise waits for the
+  /// concurrent request with the same key, if any, to be handled and checks
+  /// the cache again. Returns nullptr and sets `token` if the caller is the
+  /// first to miss the key, it should handle the request and Put() the
+  /// response while keeping the token.
+  EntryPtr Get(const std::string& key, std::optional<LoadToken>& token);
+
+  /// Stores the response and returns its entry, returns nullptr for the
+  /// responses that are not cacheable, e.g. unsuccessful or with cookies
+  EntryPtr Put(const std::string& key, const http::HttpResponse& response);
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const HttpResponseCache& cache);
+
+ private:
+  struct Load final {
+    engine::Mutex mutex;
+    engine::ConditionVariable cv;
+    bool is_done{false};
+  };
+
+  const std::vector<std::string> key_args_;
+  const std::vector<std::string> key_headers_;
+  cache::ExpirableLruCache<std::string, EntryPtr> cache_;
+  engine::Mutex loads_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Load>> loads_;
+  std::atomic<std::uint64_t> coalesced_{0};
+};
+
+/// Makes an entity tag of the response body
+std::string MakeETag(std::string_view body);
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
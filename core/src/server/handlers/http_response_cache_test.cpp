@@ -0,0 +1,195 @@
+#include <server/handlers/http_response_cache.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/http/create_parser_test.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using LoadToken = server::handlers::HttpResponseCache::LoadToken;
+
+server::handlers::HttpResponseCacheConfig MakeConfig() {
+  server::handlers::HttpResponseCacheConfig config;
+  config.size = 10;
+  config.ways = 1;
+  config.lifetime = std::chrono::seconds{10};
+  return config;
+}
+
+std::shared_ptr<server::http::HttpRequestImpl> ParseRequest(
+    const std::string& data) {
+  std::vector<std::shared_ptr<server::request::RequestBase>> requests;
+  auto parser = server::CreateTestParser(
+      [&requests](std::shared_ptr<server::request::RequestBase>&& request) {
+        requests.push_back(std::move(request));
+      });
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  EXPECT_EQ(requests.size(), 1);
+  return std::dynamic_pointer_cast<server::http::HttpRequestImpl>(
+      requests.at(0));
+}
+
+// Handles the request through the cache like HttpHandlerBase does
+server::handlers::HttpResponseCache::EntryPtr HandleCached(
+    server::handlers::HttpResponseCache& cache,
+    const server::http::HttpRequestImpl& request, const std::string& body) {
+  const auto key = cache.MakeKey(request);
+  std::optional<LoadToken> token;
+  if (auto entry = cache.Get(key, token)) return entry;
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpResponse response{request, accounter};
+  response.SetData(body);
+  response.SetStatus(server::http::HttpStatus::kOk);
+  return cache.Put(key, response);
+}
+
+}  // namespace
+
+UTEST(HttpResponseCache, Put) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetData("body");
+  response.SetHeader(std::string{http::headers::kContentType}, "text/plain");
+  response.SetHeader(std::string{http::headers::kXYaTraceId}, "trace");
+  response.SetStatus(server::http::HttpStatus::kOk);
+
+  std::optional<LoadToken> token;
+  EXPECT_EQ(cache.Get("key", token), nullptr);
+  EXPECT_TRUE(token.has_value());
+  const auto entry = cache.Put("key", response);
+  ASSERT_NE(entry, nullptr);
+  token.reset();
+
+  EXPECT_EQ(cache.Get("key", token), entry);
+  EXPECT_FALSE(token.has_value());
+
+  EXPECT_EQ(entry->body, "body");
+  EXPECT_EQ(entry->etag, server::handlers::MakeETag("body"));
+  ASSERT_EQ(entry->headers.size(), 1);
+  EXPECT_EQ(entry->headers.front().second, "text/plain");
+}
+
+UTEST(HttpResponseCache, NotCacheable) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetData("error");
+  response.SetStatus(server::http::HttpStatus::kInternalServerError);
+  EXPECT_EQ(cache.Put("key", response), nullptr);
+
+  response.SetStatus(server::http::HttpStatus::kOk);
+  response.SetHeader(std::string{http::headers::kCacheControl}, "no-store");
+  EXPECT_EQ(cache.Put("key", response), nullptr);
+
+  std::optional<LoadToken> token;
+  EXPECT_EQ(cache.Get("key", token), nullptr);
+}
+
+UTEST(HttpResponseCache, HandlerETag) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetData("body");
+  response.SetHeader(std::string{http::headers::kETag}, R"("v1")");
+  response.SetStatus(server::http::HttpStatus::kOk);
+
+  const auto entry = cache.Put("key", response);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->etag, R"("v1")");
+  EXPECT_TRUE(entry->headers.empty());
+}
+
+UTEST(HttpResponseCache, CoalescedMisses) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  std::optional<LoadToken> token;
+  EXPECT_EQ(cache.Get("key", token), nullptr);
+  ASSERT_TRUE(token.has_value());
+
+  auto follower = engine::AsyncNoSpan([&cache] {
+    std::optional<LoadToken> follower_token;
+    auto entry = cache.Get("key", follower_token);
+    EXPECT_FALSE(follower_token.has_value());
+    return entry;
+  });
+  engine::Yield();
+  EXPECT_FALSE(follower.IsFinished());
+
+  response.SetData("body");
+  response.SetStatus(server::http::HttpStatus::kOk);
+  const auto entry = cache.Put("key", response);
+  token.reset();
+  EXPECT_EQ(follower.Get(), entry);
+}
+
+UTEST(HttpResponseCache, MethodInKey) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  const auto get = ParseRequest("GET /path?a=1 HTTP/1.1\r\n\r\n");
+  const auto head = ParseRequest("HEAD /path?a=1 HTTP/1.1\r\n\r\n");
+  const auto post = ParseRequest("POST /path?a=1 HTTP/1.1\r\n\r\n");
+
+  EXPECT_TRUE(server::handlers::HttpResponseCache::IsCacheable(*get));
+  EXPECT_TRUE(server::handlers::HttpResponseCache::IsCacheable(*head));
+  EXPECT_FALSE(server::handlers::HttpResponseCache::IsCacheable(*post));
+  EXPECT_NE(cache.MakeKey(*get), cache.MakeKey(*head));
+  EXPECT_EQ(cache.MakeKey(*get),
+            cache.MakeKey(*ParseRequest("GET /path HTTP/1.1\r\n\r\n")));
+}
+
+UTEST(HttpResponseCache, HeadThenGet) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  const auto head = ParseRequest("HEAD /path HTTP/1.1\r\n\r\n");
+  const auto get = ParseRequest("GET /path HTTP/1.1\r\n\r\n");
+
+  const auto head_entry = HandleCached(cache, *head, "");
+  ASSERT_NE(head_entry, nullptr);
+  EXPECT_EQ(head_entry->body, "");
+
+  // the empty HEAD response is not served to GET
+  const auto get_entry = HandleCached(cache, *get, "body");
+  ASSERT_NE(get_entry, nullptr);
+  EXPECT_EQ(get_entry->body, "body");
+
+  EXPECT_EQ(HandleCached(cache, *head, "other"), head_entry);
+  EXPECT_EQ(HandleCached(cache, *get, "other"), get_entry);
+}
+
+UTEST(HttpResponseCache, GetThenHead) {
+  server::handlers::HttpResponseCache cache{MakeConfig()};
+  const auto get = ParseRequest("GET /path HTTP/1.1\r\n\r\n");
+  const auto head = ParseRequest("HEAD /path HTTP/1.1\r\n\r\n");
+
+  const auto get_entry = HandleCached(cache, *get, "body");
+  ASSERT_NE(get_entry, nullptr);
+  EXPECT_EQ(get_entry->body, "body");
+
+  // the cached GET body is not served to HEAD
+  const auto head_entry = HandleCached(cache, *head, "");
+  ASSERT_NE(head_entry, nullptr);
+  EXPECT_NE(head_entry, get_entry);
+  EXPECT_EQ(head_entry->body, "");
+
+  EXPECT_EQ(HandleCached(cache, *get, "other"), get_entry);
+}
+
+USERVER_NAMESPACE_END
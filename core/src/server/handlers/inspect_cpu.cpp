@@ -0,0 +1,73 @@
+#include <userver/server/handlers/inspect_cpu.hpp>
+
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <tracing/cpu_usage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::chrono::seconds kDefaultPeriod{60};
+constexpr std::size_t kDefaultLimit = 20;
+
+template <typename T>
+T GetOptionalArg(const http::HttpRequest& request, const std::string& name,
+                 T default_value) {
+  const auto& arg = request.GetArg(name);
+  if (arg.empty()) return default_value;
+  try {
+    return utils::FromString<T>(arg);
+  } catch (const std::exception&) {
+    throw ClientError(ExternalBody{"invalid '" + name + "'"});
+  }
+}
+
+}  // namespace
+
+InspectCpu::InspectCpu(const components::ComponentConfig& config,
+                       const components::ComponentContext& component_context)
+    : HttpHandlerJsonBase(config, component_context, /* is_monitor = */ true) {
+  engine::impl::SetCpuAccountingEnabled(true);
+}
+
+InspectCpu::~InspectCpu() { engine::impl::SetCpuAccountingEnabled(false); }
+
+formats::json::Value InspectCpu::HandleRequestJsonThrow(
+    const http::HttpRequest& request, const formats::json::Value&,
+    request::RequestContext&) const {
+  const std::chrono::seconds period{
+      GetOptionalArg(request, "period", kDefaultPeriod.count())};
+  if (period.count() <= 0 || period > tracing::impl::kCpuUsageWindow) {
+    throw ClientError(ExternalBody{"invalid 'period'"});
+  }
+  const auto limit = GetOptionalArg(request, "limit", kDefaultLimit);
+
+  formats::json::ValueBuilder result(formats::json::Type::kArray);
+  for (const auto& usage : tracing::impl::GetTopCpuUsage(limit, period)) {
+    formats::json::ValueBuilder usage_json(formats::json::Type::kObject);
+    usage_json["span"] = usage.span_name;
+    usage_json["cpu-time-ms"] = usage.cpu_time.count() / 1000;
+    usage_json["cpu-usage"] =
+        std::chrono::duration<double>(usage.cpu_time).count() /
+        static_cast<double>(period.count());
+    result.PushBack(std::move(usage_json));
+  }
+  return result.ExtractValue();
+}
+
+yaml_config::Schema InspectCpu::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("handler-inspect-cpu config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
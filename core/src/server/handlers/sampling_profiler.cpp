@@ -0,0 +1,97 @@
+#include <userver/server/handlers/sampling_profiler.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/scope_guard.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <tracing/sampling_profiler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultSamplingInterval{10};
+constexpr std::chrono::seconds kDefaultDuration{10};
+constexpr std::chrono::seconds kMaxDuration{60};
+
+std::chrono::seconds GetDuration(const http::HttpRequest& request) {
+  const auto& arg = request.GetArg("seconds");
+  if (arg.empty()) return kDefaultDuration;
+
+  std::chrono::seconds duration{};
+  try {
+    duration = std::chrono::seconds{utils::FromString<std::int64_t>(arg)};
+  } catch (const std::exception&) {
+    throw ClientError(ExternalBody{"invalid 'seconds'"});
+  }
+  if (duration.count() <= 0 || duration > kMaxDuration) {
+    throw ClientError(ExternalBody{"invalid 'seconds'"});
+  }
+  return duration;
+}
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      sampling_interval_(
+          config["sampling-interval"].As<std::chrono::milliseconds>(
+              kDefaultSamplingInterval)),
+      always_on_(config["always-on"].As<bool>(false)) {
+  if (sampling_interval_.count() <= 0) {
+    throw std::runtime_error("invalid 'sampling-interval'");
+  }
+  if (always_on_) tracing::impl::StartSamplingProfiler(sampling_interval_);
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  if (always_on_) tracing::impl::StopSamplingProfiler();
+}
+
+std::string SamplingProfiler::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext&) const {
+  const auto duration = GetDuration(request);
+  request.GetHttpResponse().SetContentType("text/plain");
+
+  if (always_on_) {
+    return tracing::impl::GetFoldedStacks(std::chrono::steady_clock::now() -
+                                          duration);
+  }
+
+  std::lock_guard lock(mutex_);
+  const auto since = std::chrono::steady_clock::now();
+  tracing::impl::StartSamplingProfiler(sampling_interval_);
+  {
+    utils::ScopeGuard stop([] { tracing::impl::StopSamplingProfiler(); });
+    engine::InterruptibleSleepFor(duration);
+  }
+  return tracing::impl::GetFoldedStacks(since);
+}
+
+yaml_config::Schema SamplingProfiler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-sampling-profiler config
+additionalProperties: false
+properties:
+    sampling-interval:
+        type: string
+        description: the CPU time between the samples of a thread
+        defaultDescription: 10ms
+    always-on:
+        type: boolean
+        description: sample continuously instead of only while a request is handled
+        defaultDescription: false
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
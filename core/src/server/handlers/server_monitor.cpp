@@ -4,6 +4,7 @@
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/prometheus.hpp>
@@ -12,6 +13,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 #include <userver/yaml_config/schema.hpp>
 
+#include <utils/statistics/prometheus_cache.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -48,6 +50,8 @@ StatsFormat ParseFormat(std::string_view format) {
       handlers::ExternalBody{"Unknown value of 'format' URL parameter"});
 }
 
+constexpr std::size_t kChunkSize = 64 * 1024;
+
 }  // namespace
 
 ServerMonitor::ServerMonitor(
@@ -57,10 +61,44 @@ ServerMonitor::ServerMonitor(
       statistics_storage_(
           component_context.FindComponent<components::StatisticsStorage>()
               .GetStorage()),
-      common_labels_{config["common-labels"].As<CommonLabels>({})} {}
+      common_labels_{config["common-labels"].As<CommonLabels>({})} {
+  if (config["prometheus-fragments-cache"].As<bool>(false)) {
+    using utils::statistics::impl::PrometheusFormatCache;
+    prometheus_cache_ = std::make_unique<PrometheusFormatCache>(
+        PrometheusFormatCache::Typed::kYes);
+    prometheus_untyped_cache_ = std::make_unique<PrometheusFormatCache>(
+        PrometheusFormatCache::Typed::kNo);
+  }
+}
+
+ServerMonitor::~ServerMonitor() = default;
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                               request::RequestContext&) const {
+  auto chunks = GetResponseChunks(request);
+  if (chunks.size() == 1) return std::move(chunks.front());
+
+  std::size_t size = 0;
+  for (const auto& chunk : chunks) size += chunk.size();
+
+  std::string result;
+  result.reserve(size);
+  for (const auto& chunk : chunks) result += chunk;
+  return result;
+}
+
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& stream) const {
+  auto chunks = GetResponseChunks(request);
+
+  stream.SetStatusCode(http::HttpStatus::kOk);
+  stream.SetEndOfHeaders();
+  for (auto& chunk : chunks) stream.PushBodyChunk(std::move(chunk));
+}
+
+std::vector<std::string> ServerMonitor::GetResponseChunks(
+    const http::HttpRequest& request) const {
   const auto& prefix = request.GetArg("prefix");
   const auto& path = request.GetArg("path");
   if (!path.empty() && !prefix.empty() && path != prefix) {
@@ -78,6 +116,9 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
   }
 
   const auto format = ParseFormat(request.GetArg("format"));
+  // filtered requests would evict the fragments of the full output
+  const bool use_cache =
+      prefix.empty() && path.empty() && labels_json.empty();
 
   using utils::statistics::Request;
   auto common_labels =
@@ -90,29 +131,37 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
 
   switch (format) {
     case StatsFormat::kGraphite:
-      return utils::statistics::ToGraphiteFormat(statistics_storage_,
-                                                 statistics_request);
+      return {utils::statistics::ToGraphiteFormat(statistics_storage_,
+                                                  statistics_request)};
 
     case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
+      if (prometheus_cache_ && use_cache) {
+        return prometheus_cache_->Render(statistics_storage_,
+                                         statistics_request, kChunkSize);
+      }
+      return {utils::statistics::ToPrometheusFormat(statistics_storage_,
+                                                    statistics_request)};
 
     case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
+      if (prometheus_untyped_cache_ && use_cache) {
+        return prometheus_untyped_cache_->Render(
+            statistics_storage_, statistics_request, kChunkSize);
+      }
+      return {utils::statistics::ToPrometheusFormatUntyped(
+          statistics_storage_, statistics_request)};
 
     case StatsFormat::kJson:
-      return utils::statistics::ToJsonFormat(statistics_storage_,
-                                             statistics_request);
+      return {utils::statistics::ToJsonFormat(statistics_storage_,
+                                              statistics_request)};
 
     case StatsFormat::kSolomon:
-      return utils::statistics::ToSolomonFormat(
-          statistics_storage_, common_labels_, statistics_request);
+      return {utils::statistics::ToSolomonFormat(
+          statistics_storage_, common_labels_, statistics_request)};
 
     case StatsFormat::kInternal:
       const auto json = statistics_storage_.GetAsJson();
       UASSERT(utils::statistics::AreAllMetricsNumbers(json));
-      return formats::json::ToString(json);
+      return {formats::json::ToString(json)};
   }
 
   UINVARIANT(false, "Unexpected 'format' value");
@@ -138,6 +187,12 @@ properties:
             added to each metric.
         additionalProperties: true
         properties: {}
+    prometheus-fragments-cache:
+        type: boolean
+        description: |
+            cache the Prometheus output per metrics source and format only
+            the sources with changed metrics
+        defaultDescription: false
   )");
 }
 
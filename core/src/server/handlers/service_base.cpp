@@ -95,10 +95,30 @@ properties:
         type: boolean
         description: allow decompression of the requests
         defaultDescription: false
+    compress_response:
+        type: boolean
+        description: gzip the responses if the client accepts gzip
+        defaultDescription: false
+    compress_response_level:
+        type: integer
+        description: gzip compression level from 1 (fastest) to 9 (smallest)
+        defaultDescription: 6
+    compress_response_min_size:
+        type: integer
+        description: responses smaller than this are sent uncompressed
+        defaultDescription: 1024
     throttling_enabled:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
         defaultDescription: true
+    priority_class:
+        type: string
+        description: "'critical' requests are never dropped by the request queue management of components::Server, 'batch' ones are dropped first"
+        defaultDescription: normal
+        enum:
+          - critical
+          - normal
+          - batch
     set-response-server-hostname:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
@@ -107,6 +127,10 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    request-body-stream:
+        type: boolean
+        description: run the handler once the headers are received and stream the body to it via server::http::HttpRequest::GetBodyStream(), the body is not limited by max_request_size and is neither decompressed nor parsed
+        defaultDescription: false
     monitor-handler:
         type: boolean
         description: overrides the in-code `is_monitor` flag that makes the handler run either on 'server.listener' or on 'server.listener-monitor'
@@ -0,0 +1,37 @@
+#include <server/http/conditional_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+std::string_view StripWeakPrefix(std::string_view etag) {
+  if (etag.substr(0, kWeakETagPrefix.size()) == kWeakETagPrefix) {
+    etag.remove_prefix(kWeakETagPrefix.size());
+  }
+  return etag;
+}
+
+}  // namespace
+
+bool IsNoneMatchFailed(std::string_view if_none_match, std::string_view etag) {
+  etag = StripWeakPrefix(etag);
+  while (!if_none_match.empty()) {
+    const auto comma = if_none_match.find(',');
+    auto candidate = if_none_match.substr(0, comma);
+    if_none_match.remove_prefix(
+        comma == std::string_view::npos ? if_none_match.size() : comma + 1);
+
+    const auto begin = candidate.find_first_not_of(' ');
+    if (begin == std::string_view::npos) continue;
+    candidate = candidate.substr(begin, candidate.find_last_not_of(' ') + 1 -
+                                            begin);
+    if (candidate == "*" || StripWeakPrefix(candidate) == etag) return true;
+  }
+  return false;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// The prefix of the weak entity tags, RFC 7232 section 2.3
+inline constexpr std::string_view kWeakETagPrefix = "W/";
+
+/// Returns true if the If-None-Match request header value matches the entity
+/// tag of the resource, i.e. the client has the current representation and
+/// a GET or HEAD request should be answered with 304 Not Modified. Uses the
+/// weak comparison of RFC 7232, section 3.2.
+bool IsNoneMatchFailed(std::string_view if_none_match, std::string_view etag);
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
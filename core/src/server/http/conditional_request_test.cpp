@@ -0,0 +1,26 @@
+#include <server/http/conditional_request.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::IsNoneMatchFailed;
+
+TEST(ConditionalRequest, NoneMatchFailed) {
+  EXPECT_TRUE(IsNoneMatchFailed(R"("abc")", R"("abc")"));
+  EXPECT_TRUE(IsNoneMatchFailed(R"("x", "abc")", R"("abc")"));
+  EXPECT_TRUE(IsNoneMatchFailed(R"( "x" , "abc" )", R"("abc")"));
+  EXPECT_TRUE(IsNoneMatchFailed(R"(W/"abc")", R"("abc")"));
+  EXPECT_TRUE(IsNoneMatchFailed(R"("abc")", R"(W/"abc")"));
+  EXPECT_TRUE(IsNoneMatchFailed("*", R"("abc")"));
+}
+
+TEST(ConditionalRequest, NoneMatch) {
+  EXPECT_FALSE(IsNoneMatchFailed("", R"("abc")"));
+  EXPECT_FALSE(IsNoneMatchFailed(" , ", R"("abc")"));
+  EXPECT_FALSE(IsNoneMatchFailed(R"("abcd")", R"("abc")"));
+  EXPECT_FALSE(IsNoneMatchFailed(R"("x", "y")", R"("abc")"));
+  EXPECT_FALSE(IsNoneMatchFailed("abc", R"("abc")"));
+}
+
+USERVER_NAMESPACE_END
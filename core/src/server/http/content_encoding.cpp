@@ -0,0 +1,96 @@
+#include <server/http/content_encoding.hpp>
+
+#include <optional>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+std::string_view Trim(std::string_view value) {
+  const auto begin = value.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(" \t");
+  return value.substr(begin, end - begin + 1);
+}
+
+// qvalue = ( "0" [ "." 0*3DIGIT ] ) / ( "1" [ "." 0*3("0") ] ),
+// any non-zero digit makes it positive
+bool IsPositiveQValue(std::string_view qvalue) {
+  return qvalue.find_first_of("123456789") != std::string_view::npos;
+}
+
+// Returns whether the element of the list is acceptable
+bool IsElementAccepted(std::string_view params) {
+  while (!params.empty()) {
+    const auto pos = params.find(';');
+    const auto param = Trim(params.substr(0, pos));
+    params = (pos == std::string_view::npos) ? std::string_view{}
+                                             : params.substr(pos + 1);
+
+    const auto eq = param.find('=');
+    if (eq == std::string_view::npos) continue;
+    if (utils::StrIcaseEqual{}(Trim(param.substr(0, eq)), "q")) {
+      return IsPositiveQValue(Trim(param.substr(eq + 1)));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool IsContentCodingAccepted(std::string_view accept_encoding,
+                             std::string_view coding) {
+  const utils::StrIcaseEqual equal;
+  std::optional<bool> wildcard_accepted;
+
+  while (!accept_encoding.empty()) {
+    const auto pos = accept_encoding.find(',');
+    const auto element = accept_encoding.substr(0, pos);
+    accept_encoding = (pos == std::string_view::npos)
+                          ? std::string_view{}
+                          : accept_encoding.substr(pos + 1);
+
+    const auto params_pos = element.find(';');
+    const auto name = Trim(element.substr(0, params_pos));
+    const auto params = (params_pos == std::string_view::npos)
+                            ? std::string_view{}
+                            : element.substr(params_pos + 1);
+
+    if (equal(name, coding)) return IsElementAccepted(params);
+    if (name == "*") wildcard_accepted = IsElementAccepted(params);
+  }
+
+  return wildcard_accepted.value_or(false);
+}
+
+bool IsCompressibleStatus(HttpStatus status) {
+  const auto code = static_cast<int>(status);
+  return code >= 200 && status != HttpStatus::kNoContent &&
+         status != HttpStatus::kNotModified;
+}
+
+void AddVaryAcceptEncoding(HttpResponse& response) {
+  using USERVER_NAMESPACE::http::headers::kAcceptEncoding;
+  using USERVER_NAMESPACE::http::headers::kVary;
+
+  if (!response.HasHeader(kVary)) {
+    response.SetHeader(kVary, kAcceptEncoding);
+    return;
+  }
+
+  const auto& vary = response.GetHeader(kVary);
+  if (utils::StrIcaseEqual{}(vary, "*") ||
+      vary.find(kAcceptEncoding) != std::string::npos) {
+    return;
+  }
+  response.SetHeader(kVary, vary + ", " + kAcceptEncoding);
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string_view>
+
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_status.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Returns true if the Accept-Encoding request header value allows the
+/// content coding, e.g. "gzip". Content codings with q=0 are refused, "*"
+/// matches the codings not listed explicitly, RFC 7231 section 5.3.4.
+bool IsContentCodingAccepted(std::string_view accept_encoding,
+                             std::string_view coding);
+
+/// Returns false for the statuses that have no response body
+bool IsCompressibleStatus(HttpStatus status);
+
+/// Adds Accept-Encoding to the Vary header of the response, for the caches to
+/// know that the response body depends on it
+void AddVaryAcceptEncoding(HttpResponse& response);
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,41 @@
+#include <server/http/content_encoding.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::IsContentCodingAccepted;
+
+TEST(ContentEncoding, Accepted) {
+  EXPECT_TRUE(IsContentCodingAccepted("gzip", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted("deflate, gzip, br", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted("br;q=1.0, GZip;q=0.5", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted(" gzip ; q=0.001 ", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted("*", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted("br, *;q=0.1", "gzip"));
+}
+
+TEST(ContentEncoding, Refused) {
+  EXPECT_FALSE(IsContentCodingAccepted("", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("identity", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("br, deflate", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("gzip;q=0", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("gzip; q=0.000", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("*;q=0", "gzip"));
+  EXPECT_FALSE(IsContentCodingAccepted("x-gzip2", "gzip"));
+}
+
+TEST(ContentEncoding, ExplicitOverridesWildcard) {
+  EXPECT_FALSE(IsContentCodingAccepted("*, gzip;q=0", "gzip"));
+  EXPECT_TRUE(IsContentCodingAccepted("*;q=0, gzip", "gzip"));
+}
+
+TEST(ContentEncoding, CompressibleStatus) {
+  using server::http::HttpStatus;
+  EXPECT_TRUE(server::http::IsCompressibleStatus(HttpStatus::kOk));
+  EXPECT_TRUE(server::http::IsCompressibleStatus(HttpStatus::kNotFound));
+  EXPECT_FALSE(server::http::IsCompressibleStatus(HttpStatus::kNoContent));
+  EXPECT_FALSE(server::http::IsCompressibleStatus(HttpStatus::kNotModified));
+}
+
+USERVER_NAMESPACE_END
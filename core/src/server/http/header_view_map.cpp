@@ -0,0 +1,79 @@
+#include <server/http/header_view_map.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+std::size_t SlotsCountFor(std::size_t headers_count) {
+  std::size_t slots_count = 1;
+  while (slots_count < headers_count * 2) slots_count *= 2;
+  return slots_count;
+}
+
+}  // namespace
+
+HeaderViewMap::HeaderViewMap() : slots_(kInlineSlots) {}
+
+void HeaderViewMap::Reserve(std::size_t count) {
+  headers_.reserve(count);
+  if (count * 2 > slots_.size()) Rehash(SlotsCountFor(count));
+}
+
+void HeaderViewMap::Append(HeaderView header) {
+  UINVARIANT(headers_.size() < kEmptySlot, "Too many headers");
+  if ((headers_.size() + 1) * 2 > slots_.size()) Rehash(slots_.size() * 2);
+
+  headers_.push_back(header);
+  Insert(HashHeaderName(header.name),
+         static_cast<std::uint32_t>(headers_.size() - 1));
+}
+
+HeaderViewMap::FindResult HeaderViewMap::Find(
+    const HeaderName& name) const noexcept {
+  const utils::StrIcaseEqual equal;
+  const auto mask = slots_.size() - 1;
+  for (auto pos = name.GetHash() & mask;; pos = (pos + 1) & mask) {
+    const auto& slot = slots_[pos];
+    if (slot.index == kEmptySlot) return {};
+    if (slot.hash == name.GetHash() &&
+        equal(headers_[slot.index].name, name.GetName())) {
+      return {&headers_[slot.index], slot.is_repeated};
+    }
+  }
+}
+
+void HeaderViewMap::Rehash(std::size_t slots_count) {
+  UASSERT((slots_count & (slots_count - 1)) == 0);
+  slots_.assign(slots_count, Slot{});
+  for (std::size_t i = 0; i < headers_.size(); ++i) {
+    Insert(HashHeaderName(headers_[i].name), static_cast<std::uint32_t>(i));
+  }
+}
+
+void HeaderViewMap::Insert(std::uint32_t hash, std::uint32_t index) {
+  const utils::StrIcaseEqual equal;
+  const auto mask = slots_.size() - 1;
+  for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+    auto& slot = slots_[pos];
+    if (slot.index == kEmptySlot) {
+      slot.hash = hash;
+      slot.index = index;
+      return;
+    }
+    if (slot.hash == hash &&
+        equal(headers_[slot.index].name, headers_[index].name)) {
+      // only the first header with the name is indexed
+      slot.is_repeated = true;
+      return;
+    }
+  }
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
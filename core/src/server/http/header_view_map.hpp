@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/http/common_headers.hpp>
+
+#include <server/http/request_head_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Case insensitive ASCII FNV-1a hash of a header name, usable at compile time
+constexpr std::uint32_t HashHeaderName(std::string_view name) noexcept {
+  std::uint32_t hash = 2166136261U;
+  for (const char c : name) {
+    auto byte = static_cast<unsigned char>(c);
+    if ('A' <= byte && byte <= 'Z') byte |= 32;
+    hash = (hash ^ byte) * 16777619U;
+  }
+  return hash;
+}
+
+/// Header name with a precomputed hash, for the lookups of well-known headers
+class HeaderName final {
+ public:
+  constexpr explicit HeaderName(std::string_view name) noexcept
+      : name_(name), hash_(HashHeaderName(name)) {}
+
+  constexpr std::string_view GetName() const noexcept { return name_; }
+  constexpr std::uint32_t GetHash() const noexcept { return hash_; }
+
+ private:
+  std::string_view name_;
+  std::uint32_t hash_;
+};
+
+/// Headers looked up by the framework for each request, hashed at compile time
+namespace header_names {
+
+namespace headers = USERVER_NAMESPACE::http::headers;
+
+inline constexpr HeaderName kContentType{headers::kContentType};
+inline constexpr HeaderName kContentEncoding{headers::kContentEncoding};
+inline constexpr HeaderName kCookie{"Cookie"};
+inline constexpr HeaderName kHost{headers::kHost};
+inline constexpr HeaderName kReferer{headers::kReferer};
+inline constexpr HeaderName kUserAgent{headers::kUserAgent};
+inline constexpr HeaderName kXForwardedFor{"X-Forwarded-For"};
+inline constexpr HeaderName kXRealIp{"X-Real-IP"};
+inline constexpr HeaderName kXYaRequestId{"X-YaRequestId"};
+
+}  // namespace header_names
+
+/// Compact case insensitive index of the request headers.
+///
+/// The headers are kept in their original order, the lookup goes through an
+/// open addressing table with linear probing over the header indices, whole
+/// names are compared only on a match of the stored hashes. Up to
+/// kInlineHeaders headers are indexed without heap allocations.
+///
+/// The hash is not seeded, so the map is meant for the bounded number of
+/// headers of RequestHead::kMaxHeaders.
+class HeaderViewMap final {
+ public:
+  static constexpr std::size_t kInlineHeaders = 16;
+
+  using Headers = boost::container::small_vector<HeaderView, kInlineHeaders>;
+
+  struct FindResult {
+    /// the first header with the name, nullptr if there is none
+    const HeaderView* header{nullptr};
+    /// there are more headers with the same name
+    bool is_repeated{false};
+  };
+
+  HeaderViewMap();
+
+  void Reserve(std::size_t count);
+
+  /// Adds the header to the end, repeated names are allowed
+  void Append(HeaderView header);
+
+  FindResult Find(const HeaderName& name) const noexcept;
+
+  FindResult Find(std::string_view name) const noexcept {
+    return Find(HeaderName{name});
+  }
+
+  std::size_t Size() const noexcept { return headers_.size(); }
+  bool IsEmpty() const noexcept { return headers_.empty(); }
+
+  Headers::const_iterator begin() const noexcept { return headers_.begin(); }
+  Headers::const_iterator end() const noexcept { return headers_.end(); }
+
+ private:
+  static constexpr std::uint32_t kEmptySlot =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct Slot {
+    std::uint32_t hash{0};
+    std::uint32_t index{kEmptySlot};
+    bool is_repeated{false};
+  };
+
+  // the table is kept at most half full
+  static constexpr std::size_t kInlineSlots = kInlineHeaders * 2;
+
+  void Rehash(std::size_t slots_count);
+  void Insert(std::uint32_t hash, std::uint32_t index);
+
+  Headers headers_;
+  boost::container::small_vector<Slot, kInlineSlots> slots_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#include <server/http/header_view_map.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::HeaderName;
+using server::http::impl::HeaderViewMap;
+
+}  // namespace
+
+TEST(HeaderViewMap, Empty) {
+  const HeaderViewMap map;
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.Size(), 0);
+  EXPECT_EQ(map.Find("Host").header, nullptr);
+}
+
+TEST(HeaderViewMap, CaseInsensitive) {
+  HeaderViewMap map;
+  map.Append({"Host", "localhost"});
+  map.Append({"content-type", "text/plain"});
+
+  ASSERT_NE(map.Find("host").header, nullptr);
+  EXPECT_EQ(map.Find("HOST").header->value, "localhost");
+  EXPECT_FALSE(map.Find("HOST").is_repeated);
+  EXPECT_EQ(map.Find(server::http::impl::header_names::kContentType)
+                .header->value,
+            "text/plain");
+  EXPECT_EQ(map.Find("Hos").header, nullptr);
+  EXPECT_EQ(map.Find("Hostt").header, nullptr);
+}
+
+TEST(HeaderViewMap, Repeated) {
+  HeaderViewMap map;
+  map.Append({"X-Header", "1"});
+  map.Append({"Host", "localhost"});
+  map.Append({"x-header", "2"});
+
+  const auto found = map.Find("X-HEADER");
+  ASSERT_NE(found.header, nullptr);
+  EXPECT_EQ(found.header->value, "1");
+  EXPECT_TRUE(found.is_repeated);
+  EXPECT_FALSE(map.Find("Host").is_repeated);
+  EXPECT_EQ(map.Size(), 3);
+}
+
+TEST(HeaderViewMap, Growth) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < HeaderViewMap::kInlineHeaders * 4; ++i) {
+    names.push_back("X-Header-" + std::to_string(i));
+  }
+
+  HeaderViewMap map;
+  for (const auto& name : names) map.Append({name, name});
+  // repeated names keep their flag on rehashes
+  map.Append({"x-header-0", "again"});
+  ASSERT_EQ(map.Size(), names.size() + 1);
+
+  for (const auto& name : names) {
+    const auto found = map.Find(name);
+    ASSERT_NE(found.header, nullptr) << name;
+    EXPECT_EQ(found.header->value, name);
+    EXPECT_EQ(found.is_repeated, name == "X-Header-0") << name;
+  }
+
+  std::size_t i = 0;
+  for (const auto& header : map) {
+    if (i < names.size()) {
+      EXPECT_EQ(header.name, names[i]);
+    }
+    ++i;
+  }
+  EXPECT_EQ(i, map.Size());
+}
+
+TEST(HeaderViewMap, CompileTimeHash) {
+  static_assert(HeaderName{"Content-Type"}.GetHash() ==
+                HeaderName{"content-type"}.GetHash());
+  static_assert(HeaderName{"Host"}.GetHash() != HeaderName{"Hosts"}.GetHash());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,488 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+
+#include "http_request_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kCookieHeader = "cookie";
+
+std::string_view AsStringView(const uint8_t* data, size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // nghttp2 copies the name/value pairs in nghttp2_submit_* functions
+  return {reinterpret_cast<uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+void AsciiToLower(std::string& str) noexcept {
+  for (auto& c : str) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+}
+
+HttpMethod ConvertHttpMethod(std::string_view method) {
+  try {
+    return HttpMethodFromString(method);
+  } catch (const std::exception&) {
+    return HttpMethod::kUnknown;
+  }
+}
+
+struct CallbacksDeleter {
+  void operator()(nghttp2_session_callbacks* callbacks) const noexcept {
+    nghttp2_session_callbacks_del(callbacks);
+  }
+};
+
+}  // namespace
+
+void Http2Session::SessionDeleter::operator()(
+    nghttp2_session* session) const noexcept {
+  nghttp2_session_del(session);
+}
+
+Http2Session::Http2Session(const net::Http2Config& config,
+                           const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           net::Http2Stats& http2_stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::Socket& socket)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      http2_stats_(http2_stats),
+      data_accounter_(data_accounter),
+      socket_(socket) {
+  nghttp2_session_callbacks* raw_callbacks = nullptr;
+  if (nghttp2_session_callbacks_new(&raw_callbacks) != 0) {
+    throw std::bad_alloc();
+  }
+  const std::unique_ptr<nghttp2_session_callbacks, CallbacksDeleter> callbacks{
+      raw_callbacks};
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks.get(),
+                                                          &OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks.get(), &OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks.get(),
+                                                            &OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks.get(),
+                                                       &OnFrameRecv);
+  nghttp2_session_callbacks_set_on_frame_send_callback(callbacks.get(),
+                                                       &OnFrameSend);
+  nghttp2_session_callbacks_set_on_stream_close_callback(callbacks.get(),
+                                                         &OnStreamClose);
+
+  nghttp2_session* session = nullptr;
+  if (nghttp2_session_server_new(&session, callbacks.get(), this) != 0) {
+    throw std::bad_alloc();
+  }
+  session_.reset(session);
+
+  const std::array<nghttp2_settings_entry, 2> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size},
+  }};
+  const auto res = nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE,
+                                           settings.data(), settings.size());
+  if (res != 0) {
+    throw std::runtime_error(std::string{"nghttp2_submit_settings failed: "} +
+                             nghttp2_strerror(res));
+  }
+}
+
+Http2Session::~Http2Session() {
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream.request_constructor) --stats_.parsing_request_count;
+  }
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  bool is_ok = true;
+  {
+    std::lock_guard lock(mutex_);
+    const auto res = nghttp2_session_mem_recv(
+        session_.get(), reinterpret_cast<const uint8_t*>(data), size);
+    if (res < 0) {
+      LOG_WARNING() << "HTTP/2 session error: " << nghttp2_strerror(res);
+      is_ok = false;
+    }
+    // SETTINGS and PING acks, WINDOW_UPDATEs, GOAWAY on error and the
+    // response data unblocked by the peer window updates
+    FlushLocked();
+    if (!nghttp2_session_want_read(session_.get())) is_ok = false;
+  }
+
+  DispatchRequests();
+  return is_ok;
+}
+
+void Http2Session::SendResponse(request::RequestBase& request) {
+  std::int32_t stream_id = 0;
+  {
+    std::lock_guard lock(mutex_);
+    const auto it = request_streams_.find(&request);
+    UASSERT(it != request_streams_.end());
+    if (it == request_streams_.end()) {
+      throw std::logic_error("request does not belong to the HTTP/2 session");
+    }
+    stream_id = it->second;
+    request_streams_.erase(it);
+  }
+
+  auto& response = dynamic_cast<HttpResponse&>(request.GetResponse());
+  response.SendResponse(*this, stream_id);
+}
+
+bool Http2Session::SubmitHeaders(std::int32_t stream_id, int status,
+                                 std::vector<Header>&& headers,
+                                 bool end_stream) {
+  const auto status_str = std::to_string(status);
+
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(headers.size() + 1);
+  nva.push_back(MakeNv(":status", status_str));
+  for (auto& header : headers) {
+    // HTTP/2 field names must be lowercase, RFC 7540 section 8.1.2
+    AsciiToLower(header.name);
+    nva.push_back(MakeNv(header.name, header.value));
+  }
+
+  nghttp2_data_provider data_provider{};
+  data_provider.read_callback = &ReadData;
+
+  std::lock_guard lock(mutex_);
+  if (!FindStream(stream_id)) return false;
+  const auto res = nghttp2_submit_response(
+      session_.get(), stream_id, nva.data(), nva.size(),
+      end_stream ? nullptr : &data_provider);
+  if (res != 0) {
+    LOG_WARNING() << "nghttp2_submit_response failed for stream " << stream_id
+                  << ": " << nghttp2_strerror(res);
+    return false;
+  }
+  return true;
+}
+
+bool Http2Session::SubmitData(std::int32_t stream_id, std::string&& data,
+                              bool end_stream) {
+  std::lock_guard lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (!stream) return false;
+
+  UASSERT(!stream->is_data_complete);
+  if (!data.empty()) stream->data.push_back(std::move(data));
+  stream->is_data_complete = end_stream;
+  if (stream->is_data_deferred) {
+    stream->is_data_deferred = false;
+    nghttp2_session_resume_data(session_.get(), stream_id);
+  }
+  return true;
+}
+
+size_t Http2Session::Flush() {
+  std::lock_guard lock(mutex_);
+  return FlushLocked();
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  LOG_TRACE() << "stream " << frame->hd.stream_id << " begin";
+  auto& stream = self->streams_[frame->hd.stream_id];
+  stream.request_constructor = std::make_unique<HttpRequestConstructor>(
+      self->request_constructor_config_, self->handler_info_index_,
+      self->data_accounter_);
+  ++self->stats_.parsing_request_count;
+  ++self->http2_stats_.streams_opened;
+  return 0;
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const uint8_t* name, size_t namelen,
+                           const uint8_t* value, size_t valuelen, uint8_t,
+                           void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  // trailers are ignored
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  auto* stream = self->FindStream(frame->hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  try {
+    self->OnHeaderImpl(*stream, AsStringView(name, namelen),
+                       AsStringView(value, valuelen));
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    // the request is answered with the error status set by the constructor
+    self->FinalizeRequest(frame->hd.stream_id, *stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunkRecv(nghttp2_session*, uint8_t,
+                                  std::int32_t stream_id, const uint8_t* data,
+                                  size_t len, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  auto* stream = self->FindStream(stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  LOG_TRACE() << "stream " << stream_id << " body: '"
+              << AsStringView(data, len) << '\'';
+  try {
+    self->CompleteUrl(*stream);
+    stream->request_constructor->AppendBody(
+        reinterpret_cast<const char*>(data), len);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    self->FinalizeRequest(stream_id, *stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+
+  switch (frame->hd.type) {
+    case NGHTTP2_HEADERS:
+    case NGHTTP2_DATA:
+      if (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) {
+        auto* stream = self->FindStream(frame->hd.stream_id);
+        if (stream && stream->request_constructor) {
+          self->FinalizeRequest(frame->hd.stream_id, *stream);
+        }
+      }
+      break;
+    case NGHTTP2_RST_STREAM:
+      ++self->http2_stats_.streams_reset;
+      break;
+    case NGHTTP2_WINDOW_UPDATE:
+      ++self->http2_stats_.window_updates_received;
+      break;
+    default:
+      break;
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameSend(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  if (frame->hd.type == NGHTTP2_WINDOW_UPDATE) {
+    ++self->http2_stats_.window_updates_sent;
+  }
+  return 0;
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                                uint32_t error_code, void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  const auto it = self->streams_.find(stream_id);
+  if (it == self->streams_.end()) return 0;
+
+  LOG_TRACE() << "stream " << stream_id << " closed, error_code="
+              << error_code;
+  if (it->second.request_constructor) --self->stats_.parsing_request_count;
+  self->streams_.erase(it);
+  return 0;
+}
+
+ssize_t Http2Session::ReadData(nghttp2_session*, std::int32_t stream_id,
+                               uint8_t* buf, size_t length,
+                               uint32_t* data_flags, nghttp2_data_source*,
+                               void* user_data) {
+  auto* self = static_cast<Http2Session*>(user_data);
+  UASSERT(self != nullptr);
+  return self->ReadDataImpl(stream_id, buf, length, data_flags);
+}
+
+void Http2Session::OnHeaderImpl(Stream& stream, std::string_view name,
+                                std::string_view value) {
+  auto& request_constructor = *stream.request_constructor;
+  LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+
+  // nghttp2 guarantees that the pseudo-headers precede the regular ones
+  if (!name.empty() && name.front() == ':') {
+    if (name == ":method") {
+      stream.method = ConvertHttpMethod(value);
+      request_constructor.SetMethod(stream.method);
+    } else if (name == ":path") {
+      request_constructor.AppendUrl(value.data(), value.size());
+    } else if (name == ":authority") {
+      stream.authority = value;
+    }
+    return;
+  }
+
+  CompleteUrl(stream);
+  if (name == kCookieHeader) {
+    // RFC 7540 section 8.1.2.5
+    if (!stream.cookie.empty()) stream.cookie += "; ";
+    stream.cookie += value;
+    return;
+  }
+  request_constructor.AppendHeaderField(name.data(), name.size());
+  request_constructor.AppendHeaderValue(value.data(), value.size());
+}
+
+void Http2Session::CompleteUrl(Stream& stream) {
+  if (stream.is_url_complete) return;
+
+  stream.is_url_complete = true;
+  auto& request_constructor = *stream.request_constructor;
+  request_constructor.SetMethod(stream.method);
+  request_constructor.SetHttpMajor(2);
+  request_constructor.SetHttpMinor(0);
+  request_constructor.ParseUrl();
+
+  if (!stream.authority.empty()) {
+    const std::string_view host = USERVER_NAMESPACE::http::headers::kHost;
+    request_constructor.AppendHeaderField(host.data(), host.size());
+    request_constructor.AppendHeaderValue(stream.authority.data(),
+                                          stream.authority.size());
+  }
+}
+
+void Http2Session::FinalizeRequest(std::int32_t stream_id, Stream& stream) {
+  UASSERT(stream.request_constructor);
+  auto request_constructor = std::move(stream.request_constructor);
+  --stats_.parsing_request_count;
+
+  try {
+    CompleteUrl(stream);
+    if (!stream.cookie.empty()) {
+      request_constructor->AppendHeaderField(kCookieHeader.data(),
+                                             kCookieHeader.size());
+      request_constructor->AppendHeaderValue(stream.cookie.data(),
+                                             stream.cookie.size());
+    }
+    request_constructor->AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't complete request: " << ex;
+  }
+  request_constructor->SetIsFinal(false);
+
+  auto request = request_constructor->Finalize();
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+  LOG_TRACE() << "stream " << stream_id << " request complete";
+  request_streams_.emplace(request.get(), stream_id);
+  finalized_requests_.push_back(std::move(request));
+}
+
+ssize_t Http2Session::ReadDataImpl(std::int32_t stream_id, uint8_t* buf,
+                                   size_t length, uint32_t* data_flags) {
+  auto* stream = FindStream(stream_id);
+  if (!stream) return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+
+  size_t copied = 0;
+  while (copied < length && !stream->data.empty()) {
+    const auto& part = stream->data.front();
+    const auto size =
+        std::min(length - copied, part.size() - stream->data_offset);
+    std::memcpy(buf + copied, part.data() + stream->data_offset, size);
+    copied += size;
+    stream->data_offset += size;
+    if (stream->data_offset == part.size()) {
+      stream->data.pop_front();
+      stream->data_offset = 0;
+    }
+  }
+
+  stream->is_window_stalled = false;
+  if (stream->data.empty() && stream->is_data_complete) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  } else if (copied == 0) {
+    // resumed by SubmitData()
+    stream->is_data_deferred = true;
+    return NGHTTP2_ERR_DEFERRED;
+  }
+  return static_cast<ssize_t>(copied);
+}
+
+Http2Session::Stream* Http2Session::FindStream(std::int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : &it->second;
+}
+
+size_t Http2Session::FlushLocked() {
+  size_t sent_bytes = 0;
+  for (;;) {
+    const uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_.get(), &data);
+    if (size < 0) {
+      throw std::runtime_error(
+          std::string{"nghttp2_session_mem_send failed: "} +
+          nghttp2_strerror(size));
+    }
+    if (size == 0) break;
+    sent_bytes += socket_.SendAll(data, size, {});
+  }
+
+  // Count the responses left waiting for the peer to open the window
+  const auto session_window =
+      nghttp2_session_get_remote_window_size(session_.get());
+  for (auto& [stream_id, stream] : streams_) {
+    if (stream.data.empty() || stream.is_window_stalled) continue;
+    const auto stream_window = nghttp2_session_get_stream_remote_window_size(
+        session_.get(), stream_id);
+    if (std::min(session_window, stream_window) <= 0) {
+      stream.is_window_stalled = true;
+      ++http2_stats_.flow_control_stalls;
+    }
+  }
+  return sent_bytes;
+}
+
+void Http2Session::DispatchRequests() {
+  std::vector<std::shared_ptr<request::RequestBase>> requests;
+  {
+    std::lock_guard lock(mutex_);
+    requests.swap(finalized_requests_);
+  }
+  for (auto& request : requests) on_new_request_cb_(std::move(request));
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
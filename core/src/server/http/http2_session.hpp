@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// HTTP/2 client connection preface, RFC 7540 section 3.5
+inline constexpr std::string_view kHttp2Preface =
+    "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+/// HTTP/2 server side of a connection: parses the frames into requests, one
+/// request per stream, and writes the responses of the streams as the peer
+/// flow-control windows allow.
+///
+/// Parse() is called by the connection reading task, the responses are sent
+/// from the response sending task, the nghttp2 session is guarded by a mutex.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  struct Header {
+    std::string name;
+    std::string value;
+  };
+
+  Http2Session(const net::Http2Config& config,
+               const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               net::Http2Stats& http2_stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::Socket& socket);
+
+  ~Http2Session() override;
+
+  /// Feeds the received bytes, starting with the client connection preface.
+  /// Returns false if the connection should be closed.
+  bool Parse(const char* data, size_t size) override;
+
+  /// Writes the response of a request returned by this session
+  void SendResponse(request::RequestBase& request);
+
+  /// @name Used by HttpResponse to send the response of a stream
+  /// Submit* functions return false if the stream was closed by the peer.
+  /// @{
+  bool SubmitHeaders(std::int32_t stream_id, int status,
+                     std::vector<Header>&& headers, bool end_stream);
+  bool SubmitData(std::int32_t stream_id, std::string&& data,
+                  bool end_stream);
+  /// Writes the pending frames to the socket, returns the bytes written
+  size_t Flush();
+  /// @}
+
+ private:
+  struct Stream {
+    // reset once the request is passed to on_new_request_cb_
+    std::unique_ptr<HttpRequestConstructor> request_constructor;
+    HttpMethod method{HttpMethod::kUnknown};
+    std::string authority;
+    std::string cookie;
+    bool is_url_complete{false};
+
+    // response body parts waiting for the peer flow-control window
+    std::deque<std::string> data;
+    size_t data_offset{0};
+    bool is_data_complete{false};
+    bool is_data_deferred{false};
+    bool is_window_stalled{false};
+  };
+
+  struct SessionDeleter {
+    void operator()(nghttp2_session* session) const noexcept;
+  };
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const uint8_t* name, size_t namelen,
+                      const uint8_t* value, size_t valuelen, uint8_t flags,
+                      void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, uint8_t flags,
+                             std::int32_t stream_id, const uint8_t* data,
+                             size_t len, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnFrameSend(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, std::int32_t stream_id,
+                           uint32_t error_code, void* user_data);
+  static ssize_t ReadData(nghttp2_session* session, std::int32_t stream_id,
+                          uint8_t* buf, size_t length, uint32_t* data_flags,
+                          nghttp2_data_source* source, void* user_data);
+
+  void OnHeaderImpl(Stream& stream, std::string_view name,
+                    std::string_view value);
+  void CompleteUrl(Stream& stream);
+  void FinalizeRequest(std::int32_t stream_id, Stream& stream);
+  ssize_t ReadDataImpl(std::int32_t stream_id, uint8_t* buf, size_t length,
+                       uint32_t* data_flags);
+
+  Stream* FindStream(std::int32_t stream_id);
+  size_t FlushLocked();
+  void DispatchRequests();
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  net::Http2Stats& http2_stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::Socket& socket_;
+
+  engine::Mutex mutex_;
+  std::unique_ptr<nghttp2_session, SessionDeleter> session_;
+  std::unordered_map<std::int32_t, Stream> streams_;
+  // requests finalized by the last Parse() to be passed to on_new_request_cb_
+  // outside of the lock
+  std::vector<std::shared_ptr<request::RequestBase>> finalized_requests_;
+  std::unordered_map<const request::RequestBase*, std::int32_t>
+      request_streams_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
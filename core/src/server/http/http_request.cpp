@@ -110,6 +110,11 @@ const std::string& HttpRequest::GetHeader(
   return impl_.GetHeader(header_name);
 }
 
+std::string_view HttpRequest::GetHeaderView(
+    std::string_view header_name) const {
+  return impl_.GetHeaderView(header_name);
+}
+
 bool HttpRequest::HasHeader(const std::string& header_name) const {
   return impl_.HasHeader(header_name);
 }
@@ -151,6 +156,10 @@ void HttpRequest::SetResponseStatus(HttpStatus status) const {
 
 bool HttpRequest::IsBodyCompressed() const { return impl_.IsBodyCompressed(); }
 
+RequestBodyStream& HttpRequest::GetBodyStream() const {
+  return impl_.GetBodyStream();
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
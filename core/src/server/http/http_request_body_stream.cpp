@@ -0,0 +1,30 @@
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+RequestBodyStream::RequestBodyStream(
+    Queue::Consumer&& consumer,
+    std::shared_ptr<const std::atomic<bool>> is_complete)
+    : consumer_(std::move(consumer)), is_complete_(std::move(is_complete)) {}
+
+RequestBodyStream::RequestBodyStream(RequestBodyStream&&) noexcept = default;
+
+RequestBodyStream& RequestBodyStream::operator=(RequestBodyStream&&) noexcept =
+    default;
+
+RequestBodyStream::~RequestBodyStream() = default;
+
+bool RequestBodyStream::ReadChunk(std::string& chunk,
+                                  engine::Deadline deadline) {
+  return consumer_.Pop(chunk, deadline);
+}
+
+bool RequestBodyStream::IsComplete() const noexcept {
+  return is_complete_->load();
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
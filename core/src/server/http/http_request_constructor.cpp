@@ -17,7 +17,8 @@ namespace server::http {
 
 namespace {
 
-const std::string kCookieHeader = "Cookie";
+// chunks of a streamed body the handler may lag behind the socket by
+constexpr std::size_t kBodyStreamQueueSize = 16;
 
 inline void Strip(const char*& begin, const char*& end) {
   while (begin < end && isspace(*begin)) ++begin;
@@ -43,6 +44,17 @@ void StripDuplicateStartingSlashes(std::string& s) {
 
 }  // namespace
 
+RequestBodyProducer::RequestBodyProducer(
+    RequestBodyStream::Queue::Producer&& producer,
+    std::shared_ptr<std::atomic<bool>> is_complete)
+    : producer_(std::move(producer)), is_complete_(std::move(is_complete)) {}
+
+bool RequestBodyProducer::Push(std::string&& chunk) {
+  return producer_.Push(std::move(chunk));
+}
+
+void RequestBodyProducer::Complete() noexcept { is_complete_->store(true); }
+
 HttpRequestConstructor::HttpRequestConstructor(
     Config config, const HandlerInfoIndex& handler_info_index,
     request::ResponseDataAccounter& data_accounter)
@@ -115,6 +127,7 @@ void HttpRequestConstructor::ParseUrl() {
     config_.parse_args_from_body =
         handler_config.request_config.parse_args_from_body;
     if (handler_config.decompress_request) config_.decompress_request = true;
+    is_body_streamed_ = handler_config.request_body_stream;
 
     request_->SetTaskProcessor(handler_info->task_processor);
     request_->SetHttpHandler(handler_info->handler);
@@ -159,6 +172,35 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::SetRequestHead(std::string_view raw_head,
+                                            const impl::HeaderView* headers,
+                                            size_t headers_count) {
+  UASSERT(!header_field_flag_);
+  UASSERT(request_->header_views_.IsEmpty());
+
+  size_t headers_size = 0;
+  for (size_t i = 0; i < headers_count; ++i) {
+    headers_size += headers[i].name.size() + headers[i].value.size();
+  }
+  AccountHeadersSize(headers_size);
+  AccountRequestSize(headers_size);
+
+  auto& owned_head = request_->raw_head_;
+  owned_head.assign(raw_head);
+  const auto rebase = [&](std::string_view view) {
+    UASSERT(view.data() >= raw_head.data() &&
+            view.data() + view.size() <= raw_head.data() + raw_head.size());
+    const auto offset = view.data() - raw_head.data();
+    return std::string_view{owned_head.data() + offset, view.size()};
+  };
+
+  request_->header_views_.Reserve(headers_count);
+  for (size_t i = 0; i < headers_count; ++i) {
+    request_->header_views_.Append(
+        {rebase(headers[i].name), rebase(headers[i].value)});
+  }
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
@@ -168,6 +210,23 @@ void HttpRequestConstructor::SetIsFinal(bool is_final) {
   request_->is_final_ = is_final;
 }
 
+void HttpRequestConstructor::SetIsUpgrade(bool is_upgrade) {
+  request_->is_upgrade_ = is_upgrade;
+}
+
+bool HttpRequestConstructor::IsBodyStreamed() const {
+  return is_body_streamed_ && status_ == Status::kOk;
+}
+
+RequestBodyProducer HttpRequestConstructor::StartBodyStream() {
+  UASSERT(IsBodyStreamed());
+  auto queue = RequestBodyStream::Queue::Create();
+  queue->SetSoftMaxSize(kBodyStreamQueueSize);
+  auto is_complete = std::make_shared<std::atomic<bool>>(false);
+  request_->body_stream_.emplace(queue->GetConsumer(), is_complete);
+  return {queue->GetProducer(), std::move(is_complete)};
+}
+
 std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr()
               << " orig_method=" << request_->GetOrigMethodStr();
@@ -192,7 +251,7 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   try {
     ParseArgs(parsed_url_);
-    if (config_.parse_args_from_body) {
+    if (config_.parse_args_from_body && !request_->body_stream_) {
       if (!config_.decompress_request || !request_->IsBodyCompressed())
         ParseArgs(request_->request_body_.data(),
                   request_->request_body_.size());
@@ -208,7 +267,7 @@ void HttpRequestConstructor::FinalizeImpl() {
                       [](const auto& arg) { return !arg.second.empty(); }));
 
   LOG_TRACE() << "request_args:" << request_->request_args_;
-  LOG_TRACE() << "headers:" << request_->headers_;
+  LOG_TRACE() << "headers:" << request_->GetHeadersMap();
 
   try {
     ParseCookies();
@@ -220,10 +279,12 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   LOG_TRACE() << "cookies:" << request_->cookies_;
 
-  const auto& content_type =
-      request_->GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
-  if (IsMultipartFormDataContentType(content_type)) {
-    if (!ParseMultipartFormData(content_type, request_->RequestBody(),
+  const auto content_type =
+      request_->GetHeaderView(impl::header_names::kContentType);
+  if (!request_->body_stream_ &&
+      IsMultipartFormDataContentType(content_type)) {
+    if (!ParseMultipartFormData(std::string{content_type},
+                                request_->RequestBody(),
                                 request_->form_data_args_)) {
       SetStatus(Status::kParseMultipartFormDataError);
     }
@@ -259,7 +320,7 @@ void HttpRequestConstructor::AddHeader() {
 }
 
 void HttpRequestConstructor::ParseCookies() {
-  const std::string& cookie = request_->GetHeader(kCookieHeader);
+  const auto cookie = request_->GetHeaderView(impl::header_names::kCookie);
 
   const char* data = cookie.data();
   size_t size = cookie.size();
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <string_view>
 
 #include <http_parser.h>
 
 #include <userver/http/parser/http_request_parse_args.hpp>
 #include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
 #include <userver/server/request/request_config.hpp>
 
+#include <server/http/request_head_parser.hpp>
 #include <server/request/request_constructor.hpp>
 
 #include "handler_info_index.hpp"
@@ -17,6 +21,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+// Producer side of a RequestBodyStream, owned by the request parser
+class RequestBodyProducer final {
+ public:
+  RequestBodyProducer(RequestBodyStream::Queue::Producer&& producer,
+                      std::shared_ptr<std::atomic<bool>> is_complete);
+
+  // Blocks while the handler lags behind, returns false if the handler does
+  // not read the body any more
+  bool Push(std::string&& chunk);
+
+  // Marks the body as fully received
+  void Complete() noexcept;
+
+ private:
+  RequestBodyStream::Queue::Producer producer_;
+  std::shared_ptr<std::atomic<bool>> is_complete_;
+};
+
 class HttpRequestConstructor final : public request::RequestConstructor {
  public:
   enum class Status {
@@ -50,9 +72,22 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Copies the whole request head into the request, `headers` must point into
+  // `raw_head`. Must not be mixed with AppendHeaderField() and
+  // AppendHeaderValue()
+  void SetRequestHead(std::string_view raw_head,
+                      const impl::HeaderView* headers, size_t headers_count);
   void AppendBody(const char* data, size_t size);
 
   void SetIsFinal(bool is_final);
+  void SetIsUpgrade(bool is_upgrade);
+
+  // Whether the request goes to a handler with `request-body-stream` enabled
+  bool IsBodyStreamed() const;
+
+  // The request is to be finalized before its body is received, the body is
+  // pushed by the parser into the returned producer
+  RequestBodyProducer StartBodyStream();
 
   std::shared_ptr<request::RequestBase> Finalize() override;
 
@@ -84,6 +119,7 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   size_t url_size_ = 0;
   size_t headers_size_ = 0;
   bool url_parsed_ = false;
+  bool is_body_streamed_ = false;
   Status status_ = Status::kOk;
 
   std::shared_ptr<HttpRequestImpl> request_;
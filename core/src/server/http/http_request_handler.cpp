@@ -14,6 +14,7 @@
 #include <userver/server/http/http_request.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include "http_request_impl.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -42,11 +43,33 @@ engine::TaskWithResult<void> StartFailsafeTask(
 
 }  // namespace
 
+void PriorityClassQueue::EnableCodel(std::chrono::milliseconds target,
+                                     std::chrono::milliseconds interval) {
+  codel_.emplace(target, interval);
+}
+
+bool PriorityClassQueue::AccountStart(
+    std::chrono::steady_clock::duration queue_time,
+    std::chrono::steady_clock::time_point now) {
+  queue_timings_.GetCurrentCounter().Account(
+      std::chrono::duration_cast<std::chrono::milliseconds>(queue_time)
+          .count());
+  return codel_ && codel_->ShouldDrop(queue_time, now);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const PriorityClassQueue& queue) {
+  writer["dropped"] = queue.GetDropped();
+  writer["is-overloaded"] = queue.IsOverloaded() ? 1 : 0;
+  writer["queue-time"] = queue.GetQueueTimings();
+}
+
 HttpRequestHandler::HttpRequestHandler(
     const components::ComponentContext& component_context,
     const std::optional<std::string>& logger_access_component,
     const std::optional<std::string>& logger_access_tskv_component,
-    bool is_monitor, std::string server_name)
+    bool is_monitor, std::string server_name,
+    const net::RequestQueueConfig& request_queue_config)
     : add_handler_disabled_(false),
       is_monitor_(is_monitor),
       server_name_(std::move(server_name)),
@@ -71,8 +94,37 @@ HttpRequestHandler::HttpRequestHandler(
   } else {
     LOG_INFO() << "Access_tskv log is disabled";
   }
+
+  if (request_queue_config.codel_enabled) {
+    is_codel_enabled_ = true;
+    GetPriorityClassQueue(handlers::PriorityClass::kNormal)
+        .EnableCodel(request_queue_config.normal_target,
+                     request_queue_config.codel_interval);
+    GetPriorityClassQueue(handlers::PriorityClass::kBatch)
+        .EnableCodel(request_queue_config.batch_target,
+                     request_queue_config.codel_interval);
+  }
+
+  if (!is_monitor_) {
+    auto& statistics_storage =
+        component_context.FindComponent<components::StatisticsStorage>()
+            .GetStorage();
+    statistics_holder_ = statistics_storage.RegisterWriter(
+        "server.request-queue", [this](utils::statistics::Writer& writer) {
+          for (const auto priority_class :
+               {handlers::PriorityClass::kCritical,
+                handlers::PriorityClass::kNormal,
+                handlers::PriorityClass::kBatch}) {
+            writer.ValueWithLabels(
+                GetPriorityClassQueue(priority_class),
+                {"priority_class", handlers::ToString(priority_class)});
+          }
+        });
+  }
 }
 
+HttpRequestHandler::~HttpRequestHandler() { statistics_holder_.Unregister(); }
+
 namespace {
 
 struct CcCustomStatus final {
@@ -176,9 +228,39 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     http_response.SetStreamBody();
   }
 
-  auto payload = [request = std::move(request), handler] {
+  const auto priority_class = handler->GetConfig().priority_class;
+  const bool is_droppable =
+      is_codel_enabled_ && !is_monitor_ && throttling_enabled &&
+      priority_class != handlers::PriorityClass::kCritical;
+  auto payload = [request = std::move(request), handler,
+                  &queue = GetPriorityClassQueue(priority_class),
+                  is_droppable] {
     request->SetTaskStartTime();
 
+    const auto queue_time =
+        request->TaskStartTime() - request->TaskCreateTime();
+    if (queue.AccountStart(queue_time, request->TaskStartTime()) &&
+        is_droppable) {
+      queue.AccountDropped();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      auto& http_response = static_cast<http::HttpRequestImpl&>(*request)
+                                .GetHttpResponse();
+      SetThrottleReason(http_response, "request queue time",
+                        USERVER_NAMESPACE::http::headers::ratelimit_reason::
+                            kRequestQueue);
+      http_response.SetStatus(HttpStatus::kTooManyRequests);
+      LOG_LIMITED_ERROR()
+          << "Request throttled (request queue CoDel, limit via "
+             "'server.listener.request_queue'), queue_time="
+          << std::chrono::duration_cast<std::chrono::milliseconds>(queue_time)
+                 .count()
+          << "ms, url=" << request->GetRequestPath();
+
+      request->SetResponseNotifyTime();
+      request->GetResponse().SetReady();
+      return;
+    }
+
     request::RequestContext context;
     handler->HandleRequest(*request, context);
 
@@ -187,7 +269,8 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     request->GetResponse().SetReady(now);
   };
 
-  if (!is_monitor_ && throttling_enabled) {
+  if (!is_monitor_ && throttling_enabled &&
+      priority_class != handlers::PriorityClass::kCritical) {
     return engine::AsyncNoSpan(*task_processor, std::move(payload));
   } else {
     return engine::CriticalAsyncNoSpan(*task_processor, std::move(payload));
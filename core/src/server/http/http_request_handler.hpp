@@ -1,15 +1,24 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <optional>
 
+#include <server/http/request_codel.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <server/net/listener_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/server/handlers/handler_base.hpp>
+#include <userver/server/handlers/handler_config.hpp>
 #include <userver/server/request/request_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/statistics/metrics_storage.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/token_bucket.hpp>
 
 #include "handler_info_index.hpp"
@@ -18,13 +27,52 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+/// Task processor queue of the requests of a handlers::PriorityClass
+class PriorityClassQueue final {
+ public:
+  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+
+  void EnableCodel(std::chrono::milliseconds target,
+                   std::chrono::milliseconds interval);
+
+  /// Accounts the queue time of a request that is about to start, returns
+  /// true if the request should be dropped
+  bool AccountStart(std::chrono::steady_clock::duration queue_time,
+                    std::chrono::steady_clock::time_point now);
+
+  void AccountDropped() noexcept { ++dropped_; }
+
+  std::uint64_t GetDropped() const noexcept { return dropped_.load(); }
+
+  Percentile GetQueueTimings() const {
+    return queue_timings_.GetStatsForPeriod();
+  }
+
+  bool IsOverloaded() const noexcept {
+    return codel_ && codel_->IsOverloaded();
+  }
+
+ private:
+  std::optional<RequestCodel> codel_;
+  utils::statistics::RecentPeriod<Percentile, Percentile,
+                                  utils::datetime::SteadyClock>
+      queue_timings_;
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const PriorityClassQueue& queue);
+
 class HttpRequestHandler final : public RequestHandlerBase {
  public:
   HttpRequestHandler(
       const components::ComponentContext& component_context,
       const std::optional<std::string>& logger_access_component,
       const std::optional<std::string>& logger_access_tskv_component,
-      bool is_monitor, std::string server_name);
+      bool is_monitor, std::string server_name,
+      const net::RequestQueueConfig& request_queue_config);
+
+  ~HttpRequestHandler() override;
 
   using NewRequestHook =
       std::function<void(std::shared_ptr<request::RequestBase>)>;
@@ -50,6 +98,11 @@ class HttpRequestHandler final : public RequestHandlerBase {
   void SetRpsRatelimitStatusCode(HttpStatus status_code);
 
  private:
+  PriorityClassQueue& GetPriorityClassQueue(
+      handlers::PriorityClass priority_class) const {
+    return priority_class_queues_[static_cast<std::size_t>(priority_class)];
+  }
+
   logging::LoggerPtr logger_access_;
   logging::LoggerPtr logger_access_tskv_;
 
@@ -68,6 +121,10 @@ class HttpRequestHandler final : public RequestHandlerBase {
   std::chrono::steady_clock::time_point cc_enabled_tp_;
   utils::statistics::MetricsStoragePtr metrics_;
   dynamic_config::Source config_source_;
+  mutable std::array<PriorityClassQueue, handlers::kPriorityClassCount>
+      priority_class_queues_;
+  bool is_codel_enabled_{false};
+  utils::statistics::Entry statistics_holder_;
 };
 
 }  // namespace server::http
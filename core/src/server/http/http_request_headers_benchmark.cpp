@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <server/http/header_view_map.hpp>
 #include <server/http/http_request_constructor.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -40,6 +41,45 @@ void http_request_headers_get(benchmark::State& state) {
   }
 }
 
+void http_request_header_view_map_insert(benchmark::State& state) {
+  for (auto _ : state) {
+    server::http::impl::HeaderViewMap map;
+
+    for (int i = 0; i < state.range(0); i++) {
+      map.Append({kHeadersArray[i], "1"});
+    }
+
+    benchmark::DoNotOptimize(map);
+  }
+}
+
+void http_request_header_view_map_get(benchmark::State& state) {
+  server::http::impl::HeaderViewMap map;
+  for (std::size_t i = 0; i < kHeadersCount; i++) {
+    map.Append({kHeadersArray[i], "1"});
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    if (++i == kHeadersCount) i = 0;
+    benchmark::DoNotOptimize(map.Find(kHeadersArray[i]));
+  }
+}
+
+// lookup of a well-known header with the hash computed at compile time
+void http_request_header_view_map_get_known(benchmark::State& state) {
+  server::http::impl::HeaderViewMap map;
+  for (std::size_t i = 0; i < kHeadersCount; i++) {
+    map.Append({kHeadersArray[i], "1"});
+  }
+  map.Append({"content-type", "application/json"});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        map.Find(server::http::impl::header_names::kContentType));
+  }
+}
+
 }  // namespace
 BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
@@ -47,4 +87,11 @@ BENCHMARK(http_request_headers_insert)
 
 BENCHMARK(http_request_headers_get);
 
+BENCHMARK(http_request_header_view_map_insert)
+    ->RangeMultiplier(2)
+    ->Range(1, kHeadersCount);
+
+BENCHMARK(http_request_header_view_map_get);
+BENCHMARK(http_request_header_view_map_get_known);
+
 USERVER_NAMESPACE_END
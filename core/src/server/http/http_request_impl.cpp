@@ -1,5 +1,7 @@
 #include "http_request_impl.hpp"
 
+#include <algorithm>
+
 #include <logging/spdlog.hpp>
 
 #include <logging/logger_with_info.hpp>
@@ -19,13 +21,13 @@ constexpr size_t kBucketCount = 32;
 
 constexpr size_t kZeroAllocationBucketCount = 0;
 
-std::string EscapeLogString(const std::string& str,
+std::string EscapeLogString(std::string_view str,
                             const std::vector<uint8_t>& need_escape_map) {
   size_t esc_cnt = 0;
   for (char ch : str) {
     if (need_escape_map[static_cast<uint8_t>(ch)]) esc_cnt++;
   }
-  if (!esc_cnt) return str;
+  if (!esc_cnt) return std::string{str};
   std::string res;
   res.reserve(str.size() + esc_cnt * 3);
   for (char ch : str) {
@@ -41,7 +43,7 @@ std::string EscapeLogString(const std::string& str,
   return res;
 }
 
-std::string EscapeForAccessLog(const std::string& str) {
+std::string EscapeForAccessLog(std::string_view str) {
   static auto prepare_need_escape = []() {
     std::vector<uint8_t> res(256, 0);
     for (int i = 0; i < 32; i++) res[i] = 1;
@@ -57,11 +59,12 @@ std::string EscapeForAccessLog(const std::string& str) {
   return EscapeLogString(str, kNeedEscape);
 }
 
-std::string EscapeForAccessTskvLog(const std::string& str) {
+std::string EscapeForAccessTskvLog(std::string_view str) {
   if (str.empty()) return "-";
 
   std::string encoded_str;
-  EncodeTskv(encoded_str, str, utils::encoding::EncodeTskvMode::kValue);
+  EncodeTskv(encoded_str, str.data(), str.size(),
+             utils::encoding::EncodeTskvMode::kValue);
   return encoded_str;
 }
 
@@ -185,20 +188,57 @@ size_t HttpRequestImpl::PathArgCount() const { return path_args_.size(); }
 
 const std::string& HttpRequestImpl::GetHeader(
     const std::string& header_name) const {
-  auto it = headers_.find(header_name);
-  if (it == headers_.end()) return kEmptyString;
+  const auto& headers = GetHeadersMap();
+  auto it = headers.find(header_name);
+  if (it == headers.end()) return kEmptyString;
   return it->second;
 }
 
+std::string_view HttpRequestImpl::GetHeaderView(
+    std::string_view header_name) const {
+  return GetHeaderView(impl::HeaderName{header_name});
+}
+
+std::string_view HttpRequestImpl::GetHeaderView(
+    const impl::HeaderName& header_name) const {
+  if (header_views_.IsEmpty()) {
+    return GetHeader(std::string{header_name.GetName()});
+  }
+
+  const auto found = header_views_.Find(header_name);
+  // repeated headers are joined in the map
+  if (found.is_repeated) return GetHeader(std::string{header_name.GetName()});
+  return found.header ? found.header->value : std::string_view{};
+}
+
 bool HttpRequestImpl::HasHeader(const std::string& header_name) const {
+  if (!header_views_.IsEmpty()) {
+    return header_views_.Find(header_name).header != nullptr;
+  }
   auto it = headers_.find(header_name);
   return (it != headers_.end());
 }
 
-size_t HttpRequestImpl::HeaderCount() const { return headers_.size(); }
+size_t HttpRequestImpl::HeaderCount() const { return GetHeadersMap().size(); }
 
 HttpRequest::HeadersMapKeys HttpRequestImpl::GetHeaderNames() const {
-  return HttpRequest::HeadersMapKeys{headers_};
+  return HttpRequest::HeadersMapKeys{GetHeadersMap()};
+}
+
+const HttpRequest::HeadersMap& HttpRequestImpl::GetHeadersMap() const {
+  if (header_views_.IsEmpty()) return headers_;
+
+  std::call_once(headers_map_once_, [this] {
+    for (const auto& header : header_views_) {
+      auto [it, inserted] =
+          headers_.try_emplace(std::string{header.name}, header.value);
+      if (!inserted) {
+        it->second += ',';
+        it->second += header.value;
+      }
+    }
+  });
+  return headers_;
 }
 
 const std::string& HttpRequestImpl::GetCookie(
@@ -226,8 +266,23 @@ void HttpRequestImpl::ParseArgsFromBody() {
   USERVER_NAMESPACE::http::parser::ParseArgs(request_body_, request_args_);
 }
 
+RequestBodyStream& HttpRequestImpl::GetBodyStream() {
+  if (!body_stream_) {
+    auto queue = RequestBodyStream::Queue::Create();
+    auto producer = queue->GetProducer();
+    if (!request_body_.empty()) {
+      [[maybe_unused]] const bool pushed =
+          producer.PushNoblock(std::string{request_body_});
+    }
+    body_stream_.emplace(queue->GetConsumer(),
+                         std::make_shared<const std::atomic<bool>>(true));
+  }
+  return *body_stream_;
+}
+
 bool HttpRequestImpl::IsBodyCompressed() const {
-  auto encoding = GetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding);
+  const auto encoding =
+      GetHeaderView(impl::header_names::kContentEncoding);
   return !encoding.empty() && encoding != "identity";
 }
 
@@ -301,15 +356,18 @@ void HttpRequestImpl::WriteAccessLog(
     const std::string& remote_address) const {
   if (!logger_access) return;
 
+  const auto host = GetHeaderView(impl::header_names::kHost);
+
   logger_access->ptr->info(
       R"([{}] {} {} "{} {} HTTP/{}.{}" {} "{}" "{}" "{}" {:0.6f} - {} {:0.6f})",
       utils::datetime::LocalTimezoneTimestring(tp, "%Y-%m-%d %H:%M:%E6S %Ez"),
-      EscapeForAccessLog(GetHost()), EscapeForAccessLog(remote_address),
+      EscapeForAccessLog(host), EscapeForAccessLog(remote_address),
       EscapeForAccessLog(GetOrigMethodStr()), EscapeForAccessLog(GetUrl()),
       GetHttpMajor(), GetHttpMinor(), static_cast<int>(response_.GetStatus()),
-      EscapeForAccessLog(GetHeader("Referer")),
-      EscapeForAccessLog(GetHeader("User-Agent")),
-      EscapeForAccessLog(GetHeader("Cookie")), GetRequestTime().count(),
+      EscapeForAccessLog(GetHeaderView(impl::header_names::kReferer)),
+      EscapeForAccessLog(GetHeaderView(impl::header_names::kUserAgent)),
+      EscapeForAccessLog(GetHeaderView(impl::header_names::kCookie)),
+      GetRequestTime().count(),
       GetResponse().BytesSent(), GetResponseTime().count());
 }
 
@@ -319,6 +377,8 @@ void HttpRequestImpl::WriteAccessTskvLog(
     const std::string& remote_address) const {
   if (!logger_access_tskv) return;
 
+  const auto host = GetHeaderView(impl::header_names::kHost);
+
   logger_access_tskv->ptr->info(
       "tskv"
       "\t{}"
@@ -344,14 +404,15 @@ void HttpRequestImpl::WriteAccessTskvLog(
       static_cast<int>(response_.GetStatus()), GetHttpMajor(), GetHttpMinor(),
       EscapeForAccessTskvLog(GetOrigMethodStr()),
       EscapeForAccessTskvLog(GetUrl()),
-      EscapeForAccessTskvLog(GetHeader("Referer")),
-      EscapeForAccessTskvLog(GetHeader("Cookie")),
-      EscapeForAccessTskvLog(GetHeader("User-Agent")),
-      EscapeForAccessTskvLog(GetHost()), EscapeForAccessTskvLog(remote_address),
-      EscapeForAccessTskvLog(GetHeader("X-Forwarded-For")),
-      EscapeForAccessTskvLog(GetHeader("X-Real-IP")),
-      EscapeForAccessTskvLog(GetHeader("X-YaRequestId")),
-      EscapeForAccessTskvLog(GetHost()), EscapeForAccessTskvLog(remote_address),
+      EscapeForAccessTskvLog(GetHeaderView(impl::header_names::kReferer)),
+      EscapeForAccessTskvLog(GetHeaderView(impl::header_names::kCookie)),
+      EscapeForAccessTskvLog(GetHeaderView(impl::header_names::kUserAgent)),
+      EscapeForAccessTskvLog(host), EscapeForAccessTskvLog(remote_address),
+      EscapeForAccessTskvLog(
+          GetHeaderView(impl::header_names::kXForwardedFor)),
+      EscapeForAccessTskvLog(GetHeaderView(impl::header_names::kXRealIp)),
+      EscapeForAccessTskvLog(GetHeaderView(impl::header_names::kXYaRequestId)),
+      EscapeForAccessTskvLog(host), EscapeForAccessTskvLog(remote_address),
       GetRequestTime().count(), GetResponseTime().count(),
       EscapeForAccessTskvLog(RequestBody()));
 }
@@ -2,7 +2,10 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -10,11 +13,14 @@
 
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include <server/http/header_view_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -65,6 +71,8 @@ class HttpRequestImpl final : public request::RequestBase {
   size_t PathArgCount() const;
 
   const std::string& GetHeader(const std::string& header_name) const;
+  std::string_view GetHeaderView(std::string_view header_name) const;
+  std::string_view GetHeaderView(const impl::HeaderName& header_name) const;
   bool HasHeader(const std::string& header_name) const;
   size_t HeaderCount() const;
   HttpRequest::HeadersMapKeys GetHeaderNames() const;
@@ -83,7 +91,12 @@ class HttpRequestImpl final : public request::RequestBase {
 
   bool IsBodyCompressed() const;
 
+  // Returns the stream set by HttpRequestConstructor::StartBodyStream() or a
+  // stream of the whole RequestBody()
+  RequestBodyStream& GetBodyStream();
+
   bool IsFinal() const override { return is_final_; }
+  bool IsUpgrade() const override { return is_upgrade_; }
 
   request::ResponseBase& GetResponse() const override { return response_; }
   HttpResponse& GetHttpResponse() const { return response_; }
@@ -119,6 +132,8 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  const HttpRequest::HeadersMap& GetHeadersMap() const;
+
   // method_ = (orig_method_ == kHead ? kGet : orig_method_)
   HttpMethod method_{HttpMethod::kUnknown};
   HttpMethod orig_method_{HttpMethod::kUnknown};
@@ -127,6 +142,7 @@ class HttpRequestImpl final : public request::RequestBase {
   std::string url_;
   std::string request_path_;
   std::string request_body_;
+  std::optional<RequestBodyStream> body_stream_;
   std::string path_suffix_;
   std::unordered_map<std::string, std::vector<std::string>, utils::StrCaseHash>
       request_args_;
@@ -135,9 +151,15 @@ class HttpRequestImpl final : public request::RequestBase {
   std::vector<std::string> path_args_;
   std::unordered_map<std::string, size_t, utils::StrCaseHash>
       path_args_by_name_index_;
-  HttpRequest::HeadersMap headers_;
+  mutable HttpRequest::HeadersMap headers_;
+  // Requests parsed in bulk own their head and keep the headers as views into
+  // it, headers_ are filled from header_views_ on the first access
+  std::string raw_head_;
+  impl::HeaderViewMap header_views_;
+  mutable std::once_flag headers_map_once_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
+  bool is_upgrade_{false};
 
   mutable HttpResponse response_;
   engine::TaskProcessor* task_processor_{nullptr};
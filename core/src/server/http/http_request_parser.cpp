@@ -1,9 +1,16 @@
 #include "http_request_parser.hpp"
 
+#include <limits>
+#include <optional>
+
+#include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+#include <server/http/request_head_parser.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -11,7 +18,7 @@ namespace server::http {
 
 namespace {
 
-HttpMethod ConvertHttpMethod(http_method method) {
+HttpMethod ConvertHttpMethod(http_method method) noexcept {
   switch (method) {
     case HTTP_DELETE:
       return HttpMethod::kDelete;
@@ -34,6 +41,61 @@ HttpMethod ConvertHttpMethod(http_method method) {
   }
 }
 
+// Unlike HttpMethodFromString does not throw, as unknown methods are handed
+// to http_parser to report the error
+HttpMethod ConvertHttpMethod(std::string_view method) noexcept {
+  if (method == "GET") return HttpMethod::kGet;
+  if (method == "POST") return HttpMethod::kPost;
+  if (method == "PUT") return HttpMethod::kPut;
+  if (method == "DELETE") return HttpMethod::kDelete;
+  if (method == "PATCH") return HttpMethod::kPatch;
+  if (method == "HEAD") return HttpMethod::kHead;
+  if (method == "OPTIONS") return HttpMethod::kOptions;
+  return HttpMethod::kUnknown;
+}
+
+std::optional<size_t> ParseContentLength(std::string_view value) noexcept {
+  if (value.empty()) return std::nullopt;
+  size_t result = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return std::nullopt;
+    if (result > (std::numeric_limits<size_t>::max() - 9) / 10) {
+      return std::nullopt;
+    }
+    result = result * 10 + (c - '0');
+  }
+  return result;
+}
+
+struct ConnectionOptions {
+  bool close{false};
+  bool keep_alive{false};
+  bool upgrade{false};
+};
+
+void ParseConnectionOptions(std::string_view value,
+                            ConnectionOptions& options) noexcept {
+  const utils::StrIcaseEqual equal;
+  const auto is_ows = [](char c) { return c == ' ' || c == '\t'; };
+  while (!value.empty()) {
+    const auto comma_pos = value.find(',');
+    auto option = value.substr(0, comma_pos);
+    value.remove_prefix(comma_pos == std::string_view::npos ? value.size()
+                                                            : comma_pos + 1);
+
+    while (!option.empty() && is_ows(option.front())) option.remove_prefix(1);
+    while (!option.empty() && is_ows(option.back())) option.remove_suffix(1);
+
+    if (equal(option, "close")) {
+      options.close = true;
+    } else if (equal(option, "keep-alive")) {
+      options.keep_alive = true;
+    } else if (equal(option, "upgrade")) {
+      options.upgrade = true;
+    }
+  }
+}
+
 }  // namespace
 
 const http_parser_settings HttpRequestParser::parser_settings = []() {
@@ -63,16 +125,42 @@ HttpRequestParser::HttpRequestParser(
 }
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
-  size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
-  if (parsed != size) {
-    LOG_WARNING() << "parsed=" << parsed << " size=" << size
+  std::string_view input{data, size};
+
+  // Complete requests are parsed in bulk, http_parser is used for the rest
+  while (!is_message_started_ && !input.empty()) {
+    if (is_final_) {
+      LOG_WARNING() << "data after the final request, size=" << input.size();
+      FinalizeRequest();
+      return false;
+    }
+
+    const auto result = TryParseRequest(input);
+    if (result == FastPathResult::kFallback) break;
+    if (result == FastPathResult::kError) {
+      FinalizeRequest();
+      return false;
+    }
+  }
+  if (input.empty()) return true;
+
+  size_t parsed = http_parser_execute(&parser_, &parser_settings, input.data(),
+                                      input.size());
+  if (parser_.upgrade && HTTP_PARSER_ERRNO(&parser_) == HPE_OK) {
+    // The rest belongs to the new protocol, the peer must wait for the
+    // response before sending it
+    if (parsed != input.size()) {
+      LOG_WARNING() << "data after the upgrade request, size="
+                    << input.size() - parsed;
+    }
+    return true;
+  }
+  if (parsed != input.size()) {
+    LOG_WARNING() << "parsed=" << parsed << " size=" << input.size()
                   << " error_description="
                   << http_errno_description(HTTP_PARSER_ERRNO(&parser_));
-    FinalizeRequest();
-    return false;
-  }
-  if (parser_.upgrade) {
-    LOG_WARNING() << "upgrade detected";
+    // the handler sees an incomplete body
+    body_producer_.reset();
     FinalizeRequest();
     return false;
   }
@@ -125,6 +213,7 @@ int HttpRequestParser::OnBody(http_parser* p, const char* data, size_t size) {
 
 int HttpRequestParser::OnMessageBeginImpl(http_parser*) {
   LOG_TRACE() << "message begin";
+  is_message_started_ = true;
   CreateRequestConstructor();
   return 0;
 }
@@ -182,11 +271,25 @@ int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
     return -1;
   }
   LOG_TRACE() << "headers complete";
+
+  if (request_constructor_->IsBodyStreamed()) {
+    is_final_ = !http_should_keep_alive(p) || p->upgrade;
+    request_constructor_->SetIsFinal(is_final_);
+    request_constructor_->SetIsUpgrade(p->upgrade);
+    body_producer_.emplace(request_constructor_->StartBodyStream());
+    if (!FinalizeRequest()) return -1;
+  }
   return 0;
 }
 
 int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
                                   size_t size) {
+  if (body_producer_) {
+    // the rest of the body is dropped if the handler has stopped reading it
+    body_producer_->Push(std::string(data, size));
+    return 0;
+  }
+
   UASSERT(request_constructor_);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
@@ -200,12 +303,25 @@ int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
 }
 
 int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
-  UASSERT(request_constructor_);
-  if (p->upgrade) {
-    LOG_WARNING() << "upgrade detected";
+  if (p->upgrade && p->method == HTTP_CONNECT) {
+    LOG_WARNING() << "CONNECT is not supported";
     return -1;  // error
   }
-  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  if (body_producer_) {
+    is_message_started_ = false;
+    body_producer_->Complete();
+    body_producer_.reset();
+    LOG_TRACE() << "streamed message complete";
+    return 0;
+  }
+
+  UASSERT(request_constructor_);
+  is_message_started_ = false;
+  // the connection is switched to the new protocol or closed after the
+  // response to an upgrade request
+  is_final_ = !http_should_keep_alive(p) || p->upgrade;
+  request_constructor_->SetIsFinal(is_final_);
+  request_constructor_->SetIsUpgrade(p->upgrade);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "message complete";
   if (!FinalizeRequest()) return -1;
@@ -221,11 +337,17 @@ void HttpRequestParser::CreateRequestConstructor() {
 
 bool HttpRequestParser::CheckUrlComplete(http_parser* p) {
   if (url_complete_) return true;
+  return CompleteUrl(ConvertHttpMethod(static_cast<http_method>(p->method)),
+                     p->http_major, p->http_minor);
+}
+
+bool HttpRequestParser::CompleteUrl(HttpMethod method,
+                                    unsigned short http_major,
+                                    unsigned short http_minor) {
   url_complete_ = true;
-  request_constructor_->SetMethod(
-      ConvertHttpMethod(static_cast<http_method>(p->method)));
-  request_constructor_->SetHttpMajor(p->http_major);
-  request_constructor_->SetHttpMinor(p->http_minor);
+  request_constructor_->SetMethod(method);
+  request_constructor_->SetHttpMajor(http_major);
+  request_constructor_->SetHttpMinor(http_minor);
   try {
     request_constructor_->ParseUrl();
   } catch (const std::exception& ex) {
@@ -235,6 +357,83 @@ bool HttpRequestParser::CheckUrlComplete(http_parser* p) {
   return true;
 }
 
+HttpRequestParser::FastPathResult HttpRequestParser::TryParseRequest(
+    std::string_view& data) {
+  UASSERT(!is_message_started_);
+
+  impl::RequestHead head;
+  if (impl::ParseRequestHead(data, head) != impl::HeadParseStatus::kComplete) {
+    return FastPathResult::kFallback;
+  }
+
+  // CONNECT is not converted as it has a special request-target syntax, it
+  // goes to http_parser along with the unknown methods
+  const auto method = ConvertHttpMethod(head.method);
+  if (method == HttpMethod::kUnknown) return FastPathResult::kFallback;
+
+  // Message framing, the uncommon cases are handled by http_parser
+  const utils::StrIcaseEqual equal;
+  std::optional<size_t> content_length;
+  ConnectionOptions connection;
+  for (size_t i = 0; i < head.headers_count; ++i) {
+    const auto& header = head.headers[i];
+    if (equal(header.name, USERVER_NAMESPACE::http::headers::kContentLength)) {
+      if (content_length) return FastPathResult::kFallback;
+      content_length = ParseContentLength(header.value);
+      if (!content_length) return FastPathResult::kFallback;
+    } else if (equal(header.name,
+                     USERVER_NAMESPACE::http::headers::kTransferEncoding) ||
+               equal(header.name, "Upgrade")) {
+      return FastPathResult::kFallback;
+    } else if (equal(header.name,
+                     USERVER_NAMESPACE::http::headers::kConnection)) {
+      ParseConnectionOptions(header.value, connection);
+    }
+  }
+  const auto body_size = content_length.value_or(0);
+  if (connection.upgrade || data.size() - head.size < body_size) {
+    return FastPathResult::kFallback;
+  }
+  // Same as http_should_keep_alive()
+  const bool keep_alive =
+      head.http_minor == 1 ? !connection.close : connection.keep_alive;
+
+  LOG_TRACE() << "complete request of size " << head.size + body_size;
+  CreateRequestConstructor();
+  try {
+    request_constructor_->SetMethod(method);
+    request_constructor_->AppendUrl(head.url.data(), head.url.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append url: " << ex;
+    return FastPathResult::kError;
+  }
+  if (!CompleteUrl(method, head.http_major, head.http_minor)) {
+    return FastPathResult::kError;
+  }
+  try {
+    request_constructor_->SetRequestHead(data.substr(0, head.size),
+                                         head.headers, head.headers_count);
+    if (request_constructor_->IsBodyStreamed()) {
+      auto producer = request_constructor_->StartBodyStream();
+      if (body_size != 0) {
+        producer.Push(std::string{data.substr(head.size, body_size)});
+      }
+      producer.Complete();
+    } else if (body_size != 0) {
+      request_constructor_->AppendBody(data.data() + head.size, body_size);
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append request: " << ex;
+    return FastPathResult::kError;
+  }
+
+  is_final_ = !keep_alive;
+  request_constructor_->SetIsFinal(is_final_);
+  data.remove_prefix(head.size + body_size);
+  if (!FinalizeRequest()) return FastPathResult::kError;
+  return FastPathResult::kParsed;
+}
+
 bool HttpRequestParser::FinalizeRequest() {
   bool res = FinalizeRequestImpl();
   --stats_.parsing_request_count;
@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include <http_parser.h>
 
@@ -33,6 +34,9 @@ class HttpRequestParser final : public request::RequestParser {
 
   bool Parse(const char* data, size_t size) override;
 
+  // no request is partially parsed
+  bool IsIdle() const noexcept { return !is_message_started_; }
+
  private:
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
@@ -50,9 +54,21 @@ class HttpRequestParser final : public request::RequestParser {
   int OnBodyImpl(http_parser* p, const char* data, size_t size);
   int OnMessageCompleteImpl(http_parser* p);
 
+  enum class FastPathResult {
+    kParsed,    ///< the whole request was parsed and finalized
+    kFallback,  ///< the data should be parsed by http_parser
+    kError,     ///< malformed request, the request should be finalized
+  };
+
+  // Parses a whole request from the beginning of `data` bypassing
+  // http_parser, removes the parsed request from `data`
+  FastPathResult TryParseRequest(std::string_view& data);
+
   void CreateRequestConstructor();
 
   bool CheckUrlComplete(http_parser* p);
+  bool CompleteUrl(HttpMethod method, unsigned short http_major,
+                   unsigned short http_minor);
 
   bool FinalizeRequest();
   bool FinalizeRequestImpl();
@@ -61,11 +77,17 @@ class HttpRequestParser final : public request::RequestParser {
   const HttpRequestConstructor::Config request_constructor_config_;
 
   bool url_complete_ = false;
+  // http_parser is in the middle of a request
+  bool is_message_started_ = false;
+  // the connection must be closed after the last parsed request
+  bool is_final_ = false;
 
   OnNewRequestCb on_new_request_cb_;
 
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
+  // the body of an already finalized request that is streamed to the handler
+  std::optional<RequestBodyProducer> body_producer_;
 
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
@@ -0,0 +1,153 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <server/http/http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct ParsedRequest {
+  std::string path;
+  std::string body;
+  std::string header;
+  bool is_final{false};
+};
+
+auto MakeCollector(std::vector<ParsedRequest>& requests) {
+  return [&requests](std::shared_ptr<server::request::RequestBase>&& request) {
+    auto& http_request_impl =
+        dynamic_cast<server::http::HttpRequestImpl&>(*request);
+    const server::http::HttpRequest http_request(http_request_impl);
+    requests.push_back({http_request.GetRequestPath(),
+                        http_request.RequestBody(),
+                        http_request.GetHeader("X-Header"),
+                        http_request_impl.IsFinal()});
+  };
+}
+
+}  // namespace
+
+UTEST(HttpRequestParser, Pipelined) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string data =
+      "GET /first HTTP/1.1\r\nX-Header: 1\r\n\r\n"
+      "POST /second HTTP/1.1\r\nContent-Length: 4\r\n\r\nbody"
+      "GET /third HTTP/1.1\r\nX-Header: 3\r\n\r\n";
+
+  // the third request is split between the parses
+  const auto split_pos = data.size() - 10;
+  EXPECT_TRUE(parser.Parse(data.data(), split_pos));
+  ASSERT_EQ(requests.size(), 2);
+  EXPECT_TRUE(parser.Parse(data.data() + split_pos, data.size() - split_pos));
+  ASSERT_EQ(requests.size(), 3);
+
+  EXPECT_EQ(requests[0].path, "/first");
+  EXPECT_EQ(requests[0].header, "1");
+  EXPECT_EQ(requests[1].path, "/second");
+  EXPECT_EQ(requests[1].body, "body");
+  EXPECT_EQ(requests[2].path, "/third");
+  EXPECT_EQ(requests[2].header, "3");
+  for (const auto& request : requests) EXPECT_FALSE(request.is_final);
+}
+
+UTEST(HttpRequestParser, SplitBody) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string head = "POST / HTTP/1.1\r\nContent-Length: 9\r\n\r\nbo";
+  const std::string tail = "dy body";
+  EXPECT_TRUE(parser.Parse(head.data(), head.size()));
+  EXPECT_TRUE(requests.empty());
+  EXPECT_TRUE(parser.Parse(tail.data(), tail.size()));
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_EQ(requests[0].body, "body body");
+}
+
+UTEST(HttpRequestParser, Chunked) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string data =
+      "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+      "4\r\nbody\r\n0\r\n\r\n";
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_EQ(requests[0].body, "body");
+}
+
+UTEST(HttpRequestParser, RepeatedHeaders) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string data =
+      "GET / HTTP/1.1\r\nX-Header: 1\r\nx-header: 2\r\n\r\n";
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_EQ(requests[0].header, "1,2");
+}
+
+UTEST(HttpRequestParser, HeaderViews) {
+  std::shared_ptr<server::request::RequestBase> request;
+  auto parser = server::CreateTestParser(
+      [&request](std::shared_ptr<server::request::RequestBase>&& parsed) {
+        request = std::move(parsed);
+      });
+
+  // the receive buffer is reused by the connection
+  std::string buffer =
+      "GET / HTTP/1.1\r\nX-Header: 1\r\nHost: localhost\r\n"
+      "x-header: 2\r\nX-Empty:\r\n\r\n";
+  EXPECT_TRUE(parser.Parse(buffer.data(), buffer.size()));
+  buffer.assign(buffer.size(), '\0');
+  ASSERT_TRUE(request);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+
+  EXPECT_EQ(http_request.GetHeaderView("host"), "localhost");
+  EXPECT_EQ(http_request.GetHeaderView("X-Header"), "1,2");
+  EXPECT_EQ(http_request.GetHeaderView("X-Empty"), "");
+  EXPECT_EQ(http_request.GetHeaderView("X-Missing"), "");
+  EXPECT_TRUE(http_request.HasHeader("X-Empty"));
+  EXPECT_FALSE(http_request.HasHeader("X-Missing"));
+
+  EXPECT_EQ(http_request.GetHeader("Host"), "localhost");
+  EXPECT_EQ(http_request.HeaderCount(), 3);
+}
+
+UTEST(HttpRequestParser, Final) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string data = "GET / HTTP/1.0\r\n\r\n";
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_TRUE(requests[0].is_final);
+
+  EXPECT_FALSE(parser.Parse(data.data(), data.size()));
+}
+
+UTEST(HttpRequestParser, KeepAliveHttp10) {
+  std::vector<ParsedRequest> requests;
+  auto parser = server::CreateTestParser(MakeCollector(requests));
+
+  const std::string data =
+      "GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n"
+      "GET / HTTP/1.1\r\nConnection: close\r\n\r\n";
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 2);
+  EXPECT_FALSE(requests[0].is_final);
+  EXPECT_TRUE(requests[1].is_final);
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/server/http/http_response.hpp>
 
 #include <array>
+#include <vector>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
@@ -15,7 +16,9 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
+#include <userver/utils/str_icase.hpp>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_cached_date.hpp>
 
 #include "http_request_impl.hpp"
@@ -35,6 +38,22 @@ constexpr std::string_view kKeepAlive = "keep-alive";
 
 const std::string kHostname = hostinfo::blocking::GetRealHostName();
 
+// "\r\n<size in hex>\r\n" line of a chunked body, formatted on stack
+class ChunkSizeLine final {
+ public:
+  explicit ChunkSizeLine(std::size_t chunk_size) noexcept
+      : size_(fmt::format_to_n(buffer_.data(), buffer_.size(),
+                               FMT_COMPILE("\r\n{:x}\r\n"), chunk_size)
+                  .size) {}
+
+  const char* Data() const noexcept { return buffer_.data(); }
+  std::size_t Size() const noexcept { return size_; }
+
+ private:
+  std::array<char, sizeof(std::size_t) * 2 + kCrlf.size() * 2> buffer_{};
+  std::size_t size_;
+};
+
 void CheckHeaderName(std::string_view name) {
   static constexpr auto init = []() {
     std::array<uint8_t, 256> res{};  // zero initialize
@@ -72,6 +91,15 @@ bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
          (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
 }
 
+// RFC 7540 section 8.1.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, http::headers::kConnection) ||
+         equal(name, http::headers::kTransferEncoding) ||
+         equal(name, "Keep-Alive") || equal(name, "Proxy-Connection") ||
+         equal(name, "Upgrade");
+}
+
 }  // namespace
 
 namespace server::http {
@@ -232,7 +260,7 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     header.append(kCrlf);
   }
 
-  if (IsBodyStreamed() && GetData().empty()) {
+  if (IsBodyStreamed() && GetDataView().empty()) {
     SetBodyStreamed(socket, header);
   } else {
     // e.g. a CustomHandlerException
@@ -244,7 +272,7 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
                                       std::string& header) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
-  const auto& data = GetData();
+  const auto data = GetDataView();
 
   if (!is_body_forbidden) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
@@ -270,7 +298,9 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
   }
 
   SetSentTime(std::chrono::steady_clock::now());
-  SetSent(sent_bytes);
+  // The body is sent straight from `data` as a separate iovec, be it a string
+  // or a shared memory-mapped file
+  SetSent(sent_bytes, header.size());
 }
 
 void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
@@ -278,21 +308,35 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
 
-  // send HTTP headers
-  size_t sent_bytes = socket.SendAll(header.data(), header.size(), {});
+  // The headers are serialized into `header`, the body parts are sent as is
+  size_t copied_bytes = header.size();
+
+  // Send HTTP headers, together with the first body part if it is ready
+  size_t sent_bytes = 0;
+  std::string body_part;
+  if (body_stream_->PopNoblock(body_part) && !body_part.empty()) {
+    const ChunkSizeLine size{body_part.size()};
+    copied_bytes += size.Size();
+    sent_bytes = socket.SendAll({{header.data(), header.size()},
+                                 {size.Data(), size.Size()},
+                                 {body_part.data(), body_part.size()}},
+                                engine::Deadline{});
+  } else {
+    sent_bytes = socket.SendAll(header.data(), header.size(), {});
+  }
   std::string().swap(header);  // free memory before time consuming operation
 
   // Transmit HTTP response body
-  std::string body_part;
   while (body_stream_->Pop(body_part)) {
     if (body_part.empty()) {
       LOG_DEBUG() << "Zero size body_part in http_response.cpp";
       continue;
     }
 
-    auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
+    const ChunkSizeLine size{body_part.size()};
+    copied_bytes += size.Size();
     sent_bytes += socket.SendAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
+        {{size.Data(), size.Size()}, {body_part.data(), body_part.size()}},
         engine::Deadline{});
   }
 
@@ -305,7 +349,107 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
   body_stream_.reset();
 
   SetSentTime(std::chrono::steady_clock::now());
-  SetSent(sent_bytes);
+  SetSent(sent_bytes, copied_bytes);
+}
+
+void HttpResponse::SendResponse(Http2Session& session,
+                                std::int32_t stream_id) {
+  using Header = Http2Session::Header;
+
+  std::vector<Header> headers;
+  headers.reserve(headers_.size() + cookies_.size() + 3);
+
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.cend();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    std::string date;
+    AppendCachedDate(date);
+    headers.push_back(
+        {USERVER_NAMESPACE::http::headers::kDate, std::move(date)});
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    headers.push_back({USERVER_NAMESPACE::http::headers::kContentType,
+                       kDefaultContentTypeString});
+  }
+  for (const auto& item : headers_) {
+    if (!IsConnectionSpecificHeader(item.first)) {
+      headers.push_back({item.first, item.second});
+    }
+  }
+  for (const auto& cookie : cookies_) {
+    std::string value;
+    cookie.second.AppendToString(value);
+    headers.push_back(
+        {USERVER_NAMESPACE::http::headers::kSetCookie, std::move(value)});
+  }
+
+  const auto status = static_cast<int>(status_);
+  bool is_stream_open = true;
+  // Frames of the other streams may be written by the same Flush(), the
+  // totals over the connection are exact
+  size_t sent_bytes = 0;
+
+  if (IsBodyStreamed() && GetDataView().empty()) {
+    is_stream_open =
+        session.SubmitHeaders(stream_id, status, std::move(headers), false);
+
+    std::string body_part;
+    if (is_stream_open && body_stream_->PopNoblock(body_part) &&
+        !body_part.empty()) {
+      is_stream_open =
+          session.SubmitData(stream_id, std::move(body_part), false);
+    }
+    sent_bytes += session.Flush();
+
+    while (is_stream_open && body_stream_->Pop(body_part)) {
+      if (body_part.empty()) continue;
+      is_stream_open =
+          session.SubmitData(stream_id, std::move(body_part), false);
+      sent_bytes += session.Flush();
+    }
+    if (is_stream_open) {
+      is_stream_open = session.SubmitData(stream_id, {}, true);
+      sent_bytes += session.Flush();
+    }
+
+    body_stream_producer_.reset();
+    body_stream_.reset();
+  } else {
+    const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+    const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
+    const auto data = GetDataView();
+
+    if (!is_body_forbidden) {
+      headers.push_back({USERVER_NAMESPACE::http::headers::kContentLength,
+                         fmt::format(FMT_COMPILE("{}"), data.size())});
+    }
+    if (is_body_forbidden && !data.empty()) {
+      LOG_LIMITED_WARNING()
+          << "Non-empty body provided for response with HTTP code " << status
+          << " which does not allow one, it will be dropped";
+    }
+
+    const bool has_body =
+        !is_head_request && !is_body_forbidden && !data.empty();
+    is_stream_open =
+        session.SubmitHeaders(stream_id, status, std::move(headers), !has_body);
+    if (is_stream_open && has_body) {
+      // The stream owns the data until the peer window allows to send it,
+      // so even the shared data is copied
+      is_stream_open = session.SubmitData(stream_id, std::string{data}, true);
+    }
+    sent_bytes = session.Flush();
+  }
+
+  if (!is_stream_open) {
+    LOG_DEBUG() << "HTTP/2 stream " << stream_id << " closed by peer";
+    SetSendFailed(std::chrono::steady_clock::now());
+    return;
+  }
+
+  SetSentTime(std::chrono::steady_clock::now());
+  // nghttp2 serializes all the frames into its own buffers
+  SetSent(sent_bytes, sent_bytes);
 }
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -1,5 +1,11 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <compression/gzip.hpp>
+#include <server/http/content_encoding.hpp>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
@@ -10,9 +16,26 @@ ResponseBodyStream::ResponseBodyStream(
     : queue_producer_(std::move(queue_producer)),
       http_response_(http_response) {}
 
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept =
+    default;
+
+ResponseBodyStream::~ResponseBodyStream() {
+  if (!compressor_) return;
+
+  try {
+    queue_producer_.Push(compressor_->Finish());
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Failed to finish the compressed response body: " << e;
+  }
+}
+
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (compressor_) {
+    chunk = compressor_->Compress(chunk);
+    if (chunk.empty()) return;
+  }
   queue_producer_.Push(std::move(chunk));
 }
 
@@ -21,7 +44,21 @@ void ResponseBodyStream::SetHeader(const std::string& name,
   http_response_.SetHeader(name, value);
 }
 
-void ResponseBodyStream::SetEndOfHeaders() { headers_ended_ = true; }
+void ResponseBodyStream::SetEndOfHeaders() {
+  if (headers_ended_) return;
+  headers_ended_ = true;
+
+  if (compression_level_ == 0 ||
+      !IsCompressibleStatus(http_response_.GetStatus()) ||
+      http_response_.HasHeader(
+          USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+  compressor_ =
+      std::make_unique<compression::gzip::Compressor>(compression_level_);
+  http_response_.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                           "gzip");
+}
 
 void ResponseBodyStream::SetStatusCode(int status_code) {
   http_response_.SetStatus(static_cast<server::http::HttpStatus>(status_code));
@@ -31,6 +68,12 @@ void ResponseBodyStream::SetStatusCode(HttpStatus status) {
   http_response_.SetStatus(status);
 }
 
+void ResponseBodyStream::EnableCompression(int level) {
+  UASSERT_MSG(!headers_ended_,
+              "Compression should be enabled before SetEndOfHeaders()");
+  compression_level_ = level;
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
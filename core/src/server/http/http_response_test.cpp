@@ -1,3 +1,5 @@
+#include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -45,6 +47,42 @@ UTEST(HttpResponse, Smoke) {
             fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, SharedData) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  const auto body = std::make_shared<const std::string>(100000, 'a');
+  response.SetSharedData(*body, body);
+  EXPECT_TRUE(response.GetData().empty());
+  EXPECT_EQ(response.GetDataView().data(), body->data());
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(body->size() + 4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  std::string_view reply{buffer.data(), reply_size};
+  const auto expected_content_length = fmt::format(
+      "\r\n{}: {}\r\n", http::headers::kContentLength, body->size());
+  EXPECT_TRUE(reply.find(expected_content_length) != std::string_view::npos);
+  EXPECT_EQ(reply.substr(reply.size() - body->size()), *body);
+  EXPECT_EQ(response.BytesSent() - response.BytesCopied(), body->size());
+
+  send_task.Get();
+  response.SetData("replaced");
+  EXPECT_FALSE(response.HasSharedData());
+  EXPECT_EQ(response.GetDataView(), "replaced");
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
@@ -3,6 +3,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <userver/logging/log.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/form_data_stream.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <array>
@@ -390,29 +392,10 @@ bool ParseMultipartFormDataBody(std::string_view body,
   return false;
 }
 
-}  // namespace
-
-bool IsMultipartFormDataContentType(std::string_view content_type) {
-  if (!IEquals(content_type.substr(0, kMultipartFormData.size()),
-               kMultipartFormData))
-    return false;
-  if (content_type.size() == kMultipartFormData.size()) return true;
-  switch (content_type[kMultipartFormData.size()]) {
-    case ';':
-    case ' ':
-    case '\t':
-      return true;
-  }
-  return false;
-}
-
-bool ParseMultipartFormData(const std::string& content_type,
-                            std::string_view body, FormDataArgs& form_data_args,
-                            bool strict_cr_lf) {
+bool ParseMultipartContentType(std::string_view content_type,
+                               std::string& boundary, std::string& charset) {
   static const std::string kBoundary = "boundary";
   static const std::string kCharset = "charset";
-  static const std::string kBoundaryNotFound =
-      "'boundary' parameter of multipart/form-data not found";
 
   if (!IsMultipartFormDataContentType(content_type)) {
     LOG_WARNING() << "Content type is not 'multipart/form-data'";
@@ -422,8 +405,6 @@ bool ParseMultipartFormData(const std::string& content_type,
   unparsed.remove_prefix(kMultipartFormData.size());
   SkipOptionalSpaces(unparsed);
 
-  std::string boundary;
-  std::string charset;
   while (!unparsed.empty()) {
     if (!SkipSymbol(unparsed, ';')) return false;
     SkipOptionalSpaces(unparsed);
@@ -452,7 +433,42 @@ bool ParseMultipartFormData(const std::string& content_type,
   }
 
   if (boundary.empty()) {
-    LOG_WARNING() << kBoundaryNotFound;
+    LOG_WARNING() << "'boundary' parameter of multipart/form-data not found";
+    return false;
+  }
+  return true;
+}
+
+// the headers of a single part, the whole body has its own limit
+constexpr std::size_t kMaxStreamedPartHeadersSize = 16 * 1024;
+
+[[noreturn]] void ThrowMalformedFormData(std::string_view reason) {
+  throw handlers::ClientError(handlers::ExternalBody{
+      "invalid body of multipart/form-data request: " + std::string{reason}});
+}
+
+}  // namespace
+
+bool IsMultipartFormDataContentType(std::string_view content_type) {
+  if (!IEquals(content_type.substr(0, kMultipartFormData.size()),
+               kMultipartFormData))
+    return false;
+  if (content_type.size() == kMultipartFormData.size()) return true;
+  switch (content_type[kMultipartFormData.size()]) {
+    case ';':
+    case ' ':
+    case '\t':
+      return true;
+  }
+  return false;
+}
+
+bool ParseMultipartFormData(const std::string& content_type,
+                            std::string_view body, FormDataArgs& form_data_args,
+                            bool strict_cr_lf) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartContentType(content_type, boundary, charset)) {
     return false;
   }
 
@@ -460,6 +476,141 @@ bool ParseMultipartFormData(const std::string& content_type,
                                     form_data_args, strict_cr_lf);
 }
 
+FormDataStream::FormDataStream(RequestBodyStream& body,
+                               std::string_view content_type)
+    : body_(body) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartContentType(content_type, boundary, charset)) {
+    ThrowMalformedFormData("bad Content-Type");
+  }
+  delimiter_ = "\r\n--" + boundary;
+  // the first delimiter may go without the preceding line break
+  buffer_ = "\r\n";
+}
+
+bool FormDataStream::NextPart(Part& part, engine::Deadline deadline) {
+  std::string skipped;
+  while (state_ == State::kData) {
+    [[maybe_unused]] const auto has_data = ReadPartData(skipped, deadline);
+  }
+  if (state_ == State::kEnd) return false;
+  if (state_ == State::kDelimiter && !ParseDelimiterEnd(deadline)) {
+    return false;
+  }
+  ParseHeaders(part, deadline);
+  state_ = State::kData;
+  return true;
+}
+
+bool FormDataStream::ReadPartData(std::string& data,
+                                  engine::Deadline deadline) {
+  if (state_ != State::kData) return false;
+
+  while (true) {
+    const auto pos = buffer_.find(delimiter_);
+    if (pos == 0) {
+      state_ = State::kDelimiter;
+      return false;
+    }
+    if (pos != std::string::npos) {
+      data.assign(buffer_, 0, pos);
+      buffer_.erase(0, pos);
+      return true;
+    }
+    // the tail of the buffer may be the beginning of the delimiter
+    if (buffer_.size() >= delimiter_.size()) {
+      const auto size = buffer_.size() - delimiter_.size() + 1;
+      data.assign(buffer_, 0, size);
+      buffer_.erase(0, size);
+      return true;
+    }
+    Fill(deadline);
+  }
+}
+
+void FormDataStream::Fill(engine::Deadline deadline) {
+  std::string chunk;
+  if (!body_.ReadChunk(chunk, deadline)) {
+    ThrowMalformedFormData("unexpected end of the body");
+  }
+  buffer_ += chunk;
+}
+
+bool FormDataStream::ParseDelimiterEnd(engine::Deadline deadline) {
+  UASSERT(state_ == State::kDelimiter);
+  while (true) {
+    const auto pos = buffer_.find(delimiter_);
+    if (pos != std::string::npos) {
+      buffer_.erase(0, pos + delimiter_.size());
+      break;
+    }
+    // skips the preamble
+    if (buffer_.size() >= delimiter_.size()) {
+      buffer_.erase(0, buffer_.size() - delimiter_.size() + 1);
+    }
+    Fill(deadline);
+  }
+
+  // https://datatracker.ietf.org/doc/html/rfc2046#section-5.1.1
+  while (true) {
+    if (boost::starts_with(buffer_, "--")) {
+      state_ = State::kEnd;
+      return false;
+    }
+    const auto pos = buffer_.find_first_not_of(kOwsChars);
+    if (pos != std::string::npos && buffer_.size() - pos >= 2) {
+      if (buffer_.compare(pos, 2, "\r\n") != 0) {
+        ThrowMalformedFormData("line break expected after the boundary");
+      }
+      buffer_.erase(0, pos + 2);
+      state_ = State::kHeaders;
+      return true;
+    }
+    if (buffer_.size() > kMaxStreamedPartHeadersSize) {
+      ThrowMalformedFormData("line break expected after the boundary");
+    }
+    Fill(deadline);
+  }
+}
+
+void FormDataStream::ParseHeaders(Part& part, engine::Deadline deadline) {
+  UASSERT(state_ == State::kHeaders);
+  std::size_t headers_size = 0;
+  while (true) {
+    if (boost::starts_with(buffer_, "\r\n")) {
+      headers_size = 2;
+      break;
+    }
+    const auto pos = buffer_.find("\r\n\r\n");
+    if (pos != std::string::npos) {
+      headers_size = pos + 4;
+      break;
+    }
+    if (buffer_.size() > kMaxStreamedPartHeadersSize) {
+      ThrowMalformedFormData("part headers are too large");
+    }
+    Fill(deadline);
+  }
+
+  std::string_view headers{buffer_.data(), headers_size};
+  FormDataArgInfo arg_info;
+  if (!ParseMultipartFormDataHeaders(headers, arg_info, "\r\n")) {
+    ThrowMalformedFormData("bad part headers");
+  }
+  if (arg_info.arg.content_disposition.empty()) {
+    ThrowMalformedFormData("missing Content-Disposition header");
+  }
+
+  part.name = std::move(arg_info.name);
+  part.filename = std::move(arg_info.arg.filename);
+  part.content_type.reset();
+  if (arg_info.arg.content_type) {
+    part.content_type.emplace(*arg_info.arg.content_type);
+  }
+  buffer_.erase(0, headers_size);
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
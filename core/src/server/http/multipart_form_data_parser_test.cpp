@@ -2,6 +2,9 @@
 
 #include <server/http/multipart_form_data_parser.hpp>
 
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/form_data_stream.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 TEST(MultipartFormDataParser, ContentType) {
@@ -532,4 +535,111 @@ TEST(MultipartFormDataParser, ParseErrors) {
   EXPECT_TRUE(form_data_args.empty());
 }
 
+namespace {
+
+constexpr std::string_view kStreamContentType =
+    "multipart/form-data; boundary=------------------------8099aaf9723cd601";
+
+// Splits the body into chunks of `chunk_size` bytes
+server::http::RequestBodyStream MakeBodyStream(std::string_view body,
+                                               std::size_t chunk_size,
+                                               bool is_complete = true) {
+  auto queue = server::http::RequestBodyStream::Queue::Create();
+  auto producer = queue->GetProducer();
+  for (std::size_t pos = 0; pos < body.size(); pos += chunk_size) {
+    auto chunk = std::string{body.substr(pos, chunk_size)};
+    EXPECT_TRUE(producer.PushNoblock(std::move(chunk)));
+  }
+  return {queue->GetConsumer(),
+          std::make_shared<const std::atomic<bool>>(is_complete)};
+}
+
+std::string ReadWholePart(server::http::FormDataStream& form_data) {
+  std::string value;
+  std::string data;
+  while (form_data.ReadPartData(data)) value += data;
+  return value;
+}
+
+}  // namespace
+
+UTEST(FormDataStream, Parts) {
+  constexpr std::string_view kBody =
+      "preamble\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"text\"\r\n"
+      "\r\n"
+      "default\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"file1\"; filename=\"a.html\"\r\n"
+      "Content-Type: text/html\r\n"
+      "\r\n"
+      "<!DOCTYPE html><title>Content of a.html.</title>\n\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"skipped\"\r\n"
+      "\r\n"
+      "not read by the handler\r\n"
+      "--------------------------8099aaf9723cd601--\r\n";
+
+  for (const std::size_t chunk_size : {1, 3, 7, 64, 4096}) {
+    auto body = MakeBodyStream(kBody, chunk_size);
+
+    /// [FormDataStream]
+    server::http::FormDataStream form_data{body, kStreamContentType};
+    server::http::FormDataStream::Part part;
+
+    ASSERT_TRUE(form_data.NextPart(part));
+    EXPECT_EQ(part.name, "text");
+    EXPECT_EQ(part.filename, std::nullopt);
+    EXPECT_EQ(part.content_type, std::nullopt);
+    EXPECT_EQ(ReadWholePart(form_data), "default");
+
+    ASSERT_TRUE(form_data.NextPart(part));
+    EXPECT_EQ(part.name, "file1");
+    EXPECT_EQ(part.filename, "a.html");
+    EXPECT_EQ(part.content_type, "text/html");
+    std::string value;
+    std::string data;
+    while (form_data.ReadPartData(data)) value += data;
+    EXPECT_EQ(value, "<!DOCTYPE html><title>Content of a.html.</title>\n");
+    /// [FormDataStream]
+
+    // the value of a part does not have to be read
+    ASSERT_TRUE(form_data.NextPart(part));
+    EXPECT_EQ(part.name, "skipped");
+
+    EXPECT_FALSE(form_data.NextPart(part)) << "chunk_size=" << chunk_size;
+    EXPECT_FALSE(form_data.NextPart(part));
+  }
+}
+
+UTEST(FormDataStream, Malformed) {
+  using server::handlers::ClientError;
+  {
+    auto body = MakeBodyStream("", 1);
+    UEXPECT_THROW(server::http::FormDataStream(body, "multipart/form-data"),
+                  ClientError);
+  }
+  {
+    auto body = MakeBodyStream(
+        "--------------------------8099aaf9723cd601\r\n"
+        "Content-Disposition: form-data; name=\"text\"\r\n"
+        "\r\n"
+        "truncated",
+        4, /*is_complete=*/false);
+    server::http::FormDataStream form_data{body, kStreamContentType};
+    server::http::FormDataStream::Part part;
+    ASSERT_TRUE(form_data.NextPart(part));
+    UEXPECT_THROW(ReadWholePart(form_data), ClientError);
+  }
+  {
+    auto body = MakeBodyStream(
+        "--------------------------8099aaf9723cd601 garbage\r\n", 8);
+    server::http::FormDataStream form_data{body, kStreamContentType};
+    server::http::FormDataStream::Part part;
+    UEXPECT_THROW([[maybe_unused]] auto res = form_data.NextPart(part),
+                  ClientError);
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include <server/http/path_trie.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::string_view kAnySuffixMark = "*";
+
+bool IsWildcard(std::string_view segment) {
+  return !segment.empty() && segment.front() == '{';
+}
+
+bool SegmentLess(std::string_view lhs, std::string_view rhs) {
+  // shorter segments first, then memcmp of the equal sized ones
+  if (lhs.size() != rhs.size()) return lhs.size() < rhs.size();
+  return lhs < rhs;
+}
+
+}  // namespace
+
+PathTrie::PathTrie() : nodes_(1) {}
+
+std::size_t PathTrie::AddPattern(std::string_view pattern) {
+  Segments segments;
+  Split(pattern, segments);
+
+  NodeIndex node = 0;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    const auto segment = segments[i];
+    if (segment == kAnySuffixMark && i + 1 == segments.size()) {
+      return GetOrAddRoute(nodes_[node].any_suffix_route);
+    }
+    node = IsWildcard(segment) ? GetOrAddWildcardChild(node)
+                               : GetOrAddFixedChild(node, segment);
+  }
+  return GetOrAddRoute(nodes_[node].route);
+}
+
+void PathTrie::Split(std::string_view path, Segments& segments) {
+  segments.clear();
+  while (true) {
+    const auto pos = path.find('/');
+    segments.push_back(path.substr(0, pos));
+    if (pos == std::string_view::npos) return;
+    path.remove_prefix(pos + 1);
+  }
+}
+
+PathTrie::NodeIndex PathTrie::FindFixedChild(const Node& node,
+                                             std::string_view segment) const {
+  const auto& children = node.fixed_children;
+  const auto it = std::lower_bound(
+      children.begin(), children.end(), segment,
+      [](const FixedChild& child, std::string_view value) {
+        return SegmentLess(child.segment, value);
+      });
+  if (it == children.end() || it->segment != segment) return kNoNode;
+  return it->node;
+}
+
+PathTrie::NodeIndex PathTrie::GetOrAddFixedChild(NodeIndex node,
+                                                 std::string_view segment) {
+  auto& children = nodes_[node].fixed_children;
+  const auto it = std::lower_bound(
+      children.begin(), children.end(), segment,
+      [](const FixedChild& child, std::string_view value) {
+        return SegmentLess(child.segment, value);
+      });
+  if (it != children.end() && it->segment == segment) return it->node;
+
+  const auto child = static_cast<NodeIndex>(nodes_.size());
+  if (child == kNoNode) throw std::length_error("too many path trie nodes");
+  children.insert(it, FixedChild{std::string{segment}, child});
+  nodes_.emplace_back();
+  return child;
+}
+
+PathTrie::NodeIndex PathTrie::GetOrAddWildcardChild(NodeIndex node) {
+  if (nodes_[node].wildcard_child != kNoNode) {
+    return nodes_[node].wildcard_child;
+  }
+
+  const auto child = static_cast<NodeIndex>(nodes_.size());
+  if (child == kNoNode) throw std::length_error("too many path trie nodes");
+  nodes_[node].wildcard_child = child;
+  nodes_.emplace_back();
+  return child;
+}
+
+std::size_t PathTrie::GetOrAddRoute(std::size_t& route) {
+  if (route == kNoRoute) route = routes_count_++;
+  return route;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
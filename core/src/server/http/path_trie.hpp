@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Routing trie over the '/'-separated path segments.
+///
+/// Patterns consist of fixed segments, wildcard segments ('{name}', match any
+/// single segment) and an optional trailing '*' segment that matches one or
+/// more remaining segments. The nodes and the sorted children are stored in
+/// flat arrays, the lookup does not allocate for paths of up to
+/// kInlineSegments segments.
+class PathTrie final {
+ public:
+  static constexpr std::size_t kInlineSegments = 16;
+  static constexpr std::size_t kNoRoute =
+      std::numeric_limits<std::size_t>::max();
+
+  using Segments =
+      boost::container::small_vector<std::string_view, kInlineSegments>;
+
+  struct Match {
+    std::size_t route{kNoRoute};
+    /// index of the first segment matched by the trailing '*', or the number
+    /// of segments if the route has no '*'
+    std::size_t any_suffix_segment{0};
+  };
+
+  PathTrie();
+
+  /// Adds the pattern, returns its route index. Route indexes are assigned
+  /// sequentially starting from 0, the same pattern gets the same index.
+  std::size_t AddPattern(std::string_view pattern);
+
+  std::size_t GetRoutesCount() const { return routes_count_; }
+
+  /// Splits the path by '/', "/a/b" gives {"", "a", "b"}
+  static void Split(std::string_view path, Segments& segments);
+
+  /// Calls `accept(const Match&)` for the routes matching the segments, the
+  /// more specific ones first: at each segment a fixed match is preferred to a
+  /// wildcard, then to a '*'. Stops and returns true as soon as `accept`
+  /// returns true.
+  template <typename Accept>
+  bool MatchSegments(const Segments& segments, Accept&& accept) const {
+    return MatchNode(0, segments, 0, accept);
+  }
+
+ private:
+  using NodeIndex = std::uint32_t;
+  static constexpr NodeIndex kNoNode = std::numeric_limits<NodeIndex>::max();
+
+  struct FixedChild {
+    std::string segment;
+    NodeIndex node;
+  };
+
+  struct Node {
+    // sorted by segment
+    std::vector<FixedChild> fixed_children;
+    NodeIndex wildcard_child{kNoNode};
+    std::size_t route{kNoRoute};
+    std::size_t any_suffix_route{kNoRoute};
+  };
+
+  NodeIndex FindFixedChild(const Node& node, std::string_view segment) const;
+  NodeIndex GetOrAddFixedChild(NodeIndex node, std::string_view segment);
+  NodeIndex GetOrAddWildcardChild(NodeIndex node);
+  std::size_t GetOrAddRoute(std::size_t& route);
+
+  template <typename Accept>
+  bool MatchNode(NodeIndex node_index, const Segments& segments,
+                 std::size_t depth, Accept& accept) const {
+    const auto& node = nodes_[node_index];
+    if (depth == segments.size()) {
+      return node.route != kNoRoute && accept(Match{node.route, depth});
+    }
+
+    const auto next = FindFixedChild(node, segments[depth]);
+    if (next != kNoNode && MatchNode(next, segments, depth + 1, accept)) {
+      return true;
+    }
+    if (node.wildcard_child != kNoNode &&
+        MatchNode(node.wildcard_child, segments, depth + 1, accept)) {
+      return true;
+    }
+    return node.any_suffix_route != kNoRoute &&
+           accept(Match{node.any_suffix_route, depth});
+  }
+
+  std::vector<Node> nodes_;
+  std::size_t routes_count_{0};
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
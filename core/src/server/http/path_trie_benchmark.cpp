@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <server/http/path_trie.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::PathTrie;
+
+const std::vector<std::string> kServices = {
+    "users",  "orders",   "payments", "drivers",  "vehicles",
+    "zones",  "tariffs",  "promo",    "support",  "reports",
+    "geo",    "billing",  "feedback", "partners", "documents",
+    "events", "settings", "routes",   "devices",  "subscriptions",
+};
+
+// 15 patterns per service, 300 in total
+std::vector<std::string> MakePatterns() {
+  std::vector<std::string> patterns;
+  for (const auto& service : kServices) {
+    for (const auto& version : {"v1", "v2"}) {
+      const auto base = "/" + service + "/" + version;
+      patterns.push_back(base + "/list");
+      patterns.push_back(base + "/search");
+      patterns.push_back(base + "/bulk-retrieve");
+      patterns.push_back(base + "/item/{id}");
+      patterns.push_back(base + "/item/{id}/history");
+      patterns.push_back(base + "/item/{id}/status/{status}");
+    }
+    patterns.push_back("/" + service + "/internal/cache/invalidate");
+    patterns.push_back("/" + service + "/internal/{command}");
+    patterns.push_back("/" + service + "/files/*");
+  }
+  return patterns;
+}
+
+std::vector<std::string> MakeRequests() {
+  std::vector<std::string> requests;
+  for (const auto& service : kServices) {
+    requests.push_back("/" + service + "/v1/list");
+    requests.push_back("/" + service + "/v2/item/5f0c3b1e9a7d4e21/history");
+    requests.push_back("/" + service + "/v1/item/42/status/active");
+    requests.push_back("/" + service + "/internal/reload");
+    requests.push_back("/" + service + "/files/static/js/app.min.js");
+    requests.push_back("/" + service + "/v3/unknown");
+  }
+  return requests;
+}
+
+PathTrie MakeTrie() {
+  PathTrie trie;
+  for (const auto& pattern : MakePatterns()) trie.AddPattern(pattern);
+  return trie;
+}
+
+}  // namespace
+
+void path_trie_match(benchmark::State& state) {
+  const auto trie = MakeTrie();
+  const auto requests = MakeRequests();
+
+  PathTrie::Segments segments;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    PathTrie::Split(requests[i++ % requests.size()], segments);
+    benchmark::DoNotOptimize(trie.MatchSegments(
+        segments, [](const PathTrie::Match& match) {
+          benchmark::DoNotOptimize(match.route);
+          return true;
+        }));
+  }
+}
+BENCHMARK(path_trie_match);
+
+void path_trie_build(benchmark::State& state) {
+  const auto patterns = MakePatterns();
+  for (auto _ : state) {
+    PathTrie trie;
+    for (const auto& pattern : patterns) trie.AddPattern(pattern);
+    benchmark::DoNotOptimize(trie.GetRoutesCount());
+  }
+}
+BENCHMARK(path_trie_build);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,84 @@
+#include <server/http/path_trie.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::impl::PathTrie;
+
+namespace {
+
+// Returns the first matched route or kNoRoute
+PathTrie::Match MatchFirst(const PathTrie& trie, std::string_view path) {
+  PathTrie::Segments segments;
+  PathTrie::Split(path, segments);
+
+  PathTrie::Match result;
+  trie.MatchSegments(segments, [&result](const PathTrie::Match& match) {
+    result = match;
+    return true;
+  });
+  return result;
+}
+
+}  // namespace
+
+TEST(PathTrie, Split) {
+  PathTrie::Segments segments;
+  PathTrie::Split("/a/bb//c/", segments);
+  const std::vector<std::string_view> expected{"", "a", "bb", "", "c", ""};
+  EXPECT_EQ(std::vector<std::string_view>(segments.begin(), segments.end()),
+            expected);
+
+  PathTrie::Split("", segments);
+  EXPECT_EQ(segments.size(), 1);
+}
+
+TEST(PathTrie, Routes) {
+  PathTrie trie;
+  const auto fixed = trie.AddPattern("/v1/users/me");
+  const auto wildcard = trie.AddPattern("/v1/users/{id}");
+  const auto nested = trie.AddPattern("/v1/users/{id}/orders/{order_id}");
+  const auto any_suffix = trie.AddPattern("/static/*");
+  EXPECT_EQ(trie.AddPattern("/v1/users/{user}"), wildcard);
+  EXPECT_EQ(trie.GetRoutesCount(), 4);
+
+  EXPECT_EQ(MatchFirst(trie, "/v1/users/me").route, fixed);
+  EXPECT_EQ(MatchFirst(trie, "/v1/users/42").route, wildcard);
+  EXPECT_EQ(MatchFirst(trie, "/v1/users/").route, wildcard);
+  EXPECT_EQ(MatchFirst(trie, "/v1/users/42/orders/7").route, nested);
+  EXPECT_EQ(MatchFirst(trie, "/v1/users").route, PathTrie::kNoRoute);
+  EXPECT_EQ(MatchFirst(trie, "/v1/users/42/orders").route, PathTrie::kNoRoute);
+
+  const auto match = MatchFirst(trie, "/static/css/main.css");
+  EXPECT_EQ(match.route, any_suffix);
+  EXPECT_EQ(match.any_suffix_segment, 2);
+  EXPECT_EQ(MatchFirst(trie, "/static").route, PathTrie::kNoRoute);
+}
+
+TEST(PathTrie, Backtracking) {
+  PathTrie trie;
+  const auto fixed = trie.AddPattern("/a/b/c");
+  const auto wildcard = trie.AddPattern("/a/{x}/d");
+  const auto any_suffix = trie.AddPattern("/a/*");
+
+  EXPECT_EQ(MatchFirst(trie, "/a/b/c").route, fixed);
+  // the fixed "b" branch has no "d", falls back to the wildcard
+  EXPECT_EQ(MatchFirst(trie, "/a/b/d").route, wildcard);
+  EXPECT_EQ(MatchFirst(trie, "/a/b/e").route, any_suffix);
+
+  // rejected routes are skipped, e.g. for the disallowed methods
+  PathTrie::Segments segments;
+  PathTrie::Split("/a/b/c", segments);
+  std::vector<std::size_t> tried;
+  EXPECT_FALSE(trie.MatchSegments(segments, [&](const PathTrie::Match& m) {
+    tried.push_back(m.route);
+    return false;
+  }));
+  EXPECT_EQ(tried, (std::vector<std::size_t>{fixed, any_suffix}));
+}
+
+USERVER_NAMESPACE_END
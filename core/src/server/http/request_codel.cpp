@@ -0,0 +1,58 @@
+#include <server/http/request_codel.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+std::int64_t ToNanoseconds(RequestCodel::Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+      .count();
+}
+
+}  // namespace
+
+RequestCodel::RequestCodel(std::chrono::microseconds target,
+                           std::chrono::microseconds interval)
+    : target_ns_(ToNanoseconds(target)), interval_ns_(ToNanoseconds(interval)) {
+  UINVARIANT(target.count() > 0 && interval.count() > 0,
+             "CoDel target and interval must be positive");
+}
+
+bool RequestCodel::ShouldDrop(Clock::duration queue_time,
+                              Clock::time_point now) noexcept {
+  const auto queue_time_ns = ToNanoseconds(queue_time);
+  const auto now_ns = ToNanoseconds(now.time_since_epoch());
+
+  if (now_ns >= interval_end_ns_.load(std::memory_order_relaxed) &&
+      !is_resetting_.exchange(true, std::memory_order_acquire)) {
+    // the interval is over, only a single thread starts the next one
+    if (now_ns >= interval_end_ns_.load(std::memory_order_relaxed)) {
+      const bool is_first_interval =
+          interval_end_ns_.load(std::memory_order_relaxed) == 0;
+      is_overloaded_.store(
+          !is_first_interval &&
+              min_queue_time_ns_.load(std::memory_order_relaxed) > target_ns_,
+          std::memory_order_relaxed);
+      min_queue_time_ns_.store(queue_time_ns, std::memory_order_relaxed);
+      interval_end_ns_.store(now_ns + interval_ns_, std::memory_order_relaxed);
+    }
+    is_resetting_.store(false, std::memory_order_release);
+  } else {
+    auto min_queue_time_ns = min_queue_time_ns_.load(std::memory_order_relaxed);
+    while (queue_time_ns < min_queue_time_ns &&
+           !min_queue_time_ns_.compare_exchange_weak(
+               min_queue_time_ns, queue_time_ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  return is_overloaded_.load(std::memory_order_relaxed) &&
+         queue_time_ns > 2 * target_ns_;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief CoDel-style controller of the time the requests spend in the task
+/// processor queue.
+///
+/// The queue is considered overloaded for the next interval if no request of
+/// the previous interval had a queue time below the target, i.e. the queue
+/// has not drained once during the interval. While overloaded, the requests
+/// that waited more than twice the target are dropped. Unlike the CoDel
+/// proper the drop rate does not grow gradually, as the stale requests are
+/// cheap to drop and the clients have likely given up on them.
+///
+/// Thread safe and wait-free.
+class RequestCodel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  RequestCodel(std::chrono::microseconds target,
+               std::chrono::microseconds interval);
+
+  /// Accounts the queue time of a request that is about to start, returns
+  /// true if the request should be dropped
+  bool ShouldDrop(Clock::duration queue_time,
+                  Clock::time_point now = Clock::now()) noexcept;
+
+  bool IsOverloaded() const noexcept {
+    return is_overloaded_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const std::int64_t target_ns_;
+  const std::int64_t interval_ns_;
+
+  std::atomic<std::int64_t> interval_end_ns_{0};
+  std::atomic<std::int64_t> min_queue_time_ns_{0};
+  std::atomic<bool> is_resetting_{false};
+  std::atomic<bool> is_overloaded_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
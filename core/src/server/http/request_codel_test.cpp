@@ -0,0 +1,44 @@
+#include <server/http/request_codel.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Clock = server::http::RequestCodel::Clock;
+
+constexpr std::chrono::milliseconds kTarget{5};
+constexpr std::chrono::milliseconds kInterval{100};
+
+}  // namespace
+
+TEST(RequestCodel, DropsOnlyWhenQueueDoesNotDrain) {
+  server::http::RequestCodel codel{kTarget, kInterval};
+  auto now = Clock::now();
+
+  // a single slow request is not an overload
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{50}, now));
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{1}, now));
+  now += kInterval;
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{50}, now));
+  EXPECT_FALSE(codel.IsOverloaded());
+
+  // all the requests of the interval waited for more than the target
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{20}, now));
+  now += kInterval;
+  EXPECT_TRUE(codel.ShouldDrop(std::chrono::milliseconds{50}, now));
+  EXPECT_TRUE(codel.IsOverloaded());
+
+  // requests that waited less than twice the target are still served
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{8}, now));
+  EXPECT_TRUE(codel.ShouldDrop(std::chrono::milliseconds{11}, now));
+
+  // the queue has drained
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{1}, now));
+  now += kInterval;
+  EXPECT_FALSE(codel.ShouldDrop(std::chrono::milliseconds{50}, now));
+  EXPECT_FALSE(codel.IsOverloaded());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,167 @@
+#include <server/http/request_head_parser.hpp>
+
+#include <array>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr int kBlockSize = 16;
+
+// A set of bytes, both as inclusive ranges for _mm_cmpestri and as a table
+// for the scalar tail
+struct CharClass {
+  alignas(kBlockSize) char ranges[kBlockSize]{};
+  int ranges_size{0};
+  bool table[256]{};
+};
+
+constexpr CharClass MakeCharClass(std::string_view ranges) {
+  CharClass result{};
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    result.ranges[i] = ranges[i];
+  }
+  result.ranges_size = static_cast<int>(ranges.size());
+  for (std::size_t i = 0; i + 1 < ranges.size(); i += 2) {
+    for (int c = static_cast<unsigned char>(ranges[i]);
+         c <= static_cast<unsigned char>(ranges[i + 1]); ++c) {
+      result.table[c] = true;
+    }
+  }
+  return result;
+}
+
+// CTLs, SP and DEL end the request-target
+constexpr auto kUrlDelimiters = MakeCharClass({"\0\040\177\177", 4});
+// CTLs except HTAB and DEL end the field-value
+constexpr auto kValueDelimiters = MakeCharClass({"\0\010\012\037\177\177", 6});
+
+constexpr auto kTokenChars = []() {
+  std::array<bool, 256> result{};
+  for (int c = '0'; c <= '9'; ++c) result[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) result[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) result[c] = true;
+  for (const unsigned char c : std::string_view{"!#$%&'*+-.^_`|~"}) {
+    result[c] = true;
+  }
+  return result;
+}();
+
+const char* FindDelimiter(const char* pos, const char* end,
+                          const CharClass& delimiters) noexcept {
+#ifdef __SSE4_2__
+  const __m128i ranges = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(delimiters.ranges));
+  while (end - pos >= kBlockSize) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    const int index =
+        _mm_cmpestri(ranges, delimiters.ranges_size, block, kBlockSize,
+                     _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                         _SIDD_LEAST_SIGNIFICANT);
+    if (index != kBlockSize) return pos + index;
+    pos += kBlockSize;
+  }
+#endif
+  while (pos != end && !delimiters.table[static_cast<unsigned char>(*pos)]) {
+    ++pos;
+  }
+  return pos;
+}
+
+const char* SkipToken(const char* pos, const char* end) noexcept {
+  while (pos != end && kTokenChars[static_cast<unsigned char>(*pos)]) ++pos;
+  return pos;
+}
+
+bool IsOws(char c) noexcept { return c == ' ' || c == '\t'; }
+
+}  // namespace
+
+HeadParseStatus ParseRequestHead(std::string_view data,
+                                 RequestHead& head) noexcept {
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+  const char* pos = begin;
+
+  // method SP request-target SP HTTP-version CRLF
+  const char* const method_end = SkipToken(pos, end);
+  if (method_end == end) return HeadParseStatus::kNeedMoreData;
+  if (method_end == pos || *method_end != ' ') {
+    return HeadParseStatus::kUnsupported;
+  }
+  head.method = std::string_view(pos, method_end - pos);
+  pos = method_end + 1;
+
+  const char* const url_end = FindDelimiter(pos, end, kUrlDelimiters);
+  if (url_end == end) return HeadParseStatus::kNeedMoreData;
+  if (url_end == pos || *url_end != ' ') return HeadParseStatus::kUnsupported;
+  head.url = std::string_view(pos, url_end - pos);
+  pos = url_end + 1;
+
+  constexpr std::string_view kVersionPrefix = "HTTP/1.";
+  constexpr std::size_t kVersionLineSize = kVersionPrefix.size() + 3;
+  if (static_cast<std::size_t>(end - pos) < kVersionLineSize) {
+    return HeadParseStatus::kNeedMoreData;
+  }
+  const char minor = pos[kVersionPrefix.size()];
+  if (std::string_view(pos, kVersionPrefix.size()) != kVersionPrefix ||
+      (minor != '0' && minor != '1') || pos[kVersionLineSize - 2] != '\r' ||
+      pos[kVersionLineSize - 1] != '\n') {
+    return HeadParseStatus::kUnsupported;
+  }
+  head.http_major = 1;
+  head.http_minor = minor - '0';
+  pos += kVersionLineSize;
+
+  // *( field-name ":" OWS field-value OWS CRLF ) CRLF
+  head.headers_count = 0;
+  while (true) {
+    if (pos == end) return HeadParseStatus::kNeedMoreData;
+    if (*pos == '\r') {
+      if (end - pos < 2) return HeadParseStatus::kNeedMoreData;
+      if (pos[1] != '\n') return HeadParseStatus::kUnsupported;
+      pos += 2;
+      break;
+    }
+
+    if (head.headers_count == RequestHead::kMaxHeaders) {
+      return HeadParseStatus::kUnsupported;
+    }
+
+    // Also rejects the obsolete line folding, as SP and HTAB are not tokens
+    const char* const name_end = SkipToken(pos, end);
+    if (name_end == end) return HeadParseStatus::kNeedMoreData;
+    if (name_end == pos || *name_end != ':') {
+      return HeadParseStatus::kUnsupported;
+    }
+    auto& header = head.headers[head.headers_count++];
+    header.name = std::string_view(pos, name_end - pos);
+    pos = name_end + 1;
+
+    while (pos != end && IsOws(*pos)) ++pos;
+    const char* const value_begin = pos;
+    const char* value_end = FindDelimiter(pos, end, kValueDelimiters);
+    if (end - value_end < 2) return HeadParseStatus::kNeedMoreData;
+    if (value_end[0] != '\r' || value_end[1] != '\n') {
+      return HeadParseStatus::kUnsupported;
+    }
+    pos = value_end + 2;
+
+    while (value_end != value_begin && IsOws(value_end[-1])) --value_end;
+    header.value = std::string_view(value_begin, value_end - value_begin);
+  }
+
+  head.size = pos - begin;
+  return HeadParseStatus::kComplete;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
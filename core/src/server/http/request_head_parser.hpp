@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+enum class HeadParseStatus {
+  kComplete,      ///< the whole request line and headers were parsed
+  kNeedMoreData,  ///< the data ends before the end of headers
+  kUnsupported,   ///< malformed request or a request the fast path does not
+                  ///< handle (e.g. obsolete line folding, too many headers)
+};
+
+struct HeaderView {
+  std::string_view name;
+  std::string_view value;
+};
+
+/// @brief Request line and headers, the views point into the parsed buffer.
+struct RequestHead {
+  static constexpr std::size_t kMaxHeaders = 64;
+
+  std::string_view method;
+  std::string_view url;
+  unsigned short http_major{0};
+  unsigned short http_minor{0};
+
+  HeaderView headers[kMaxHeaders];
+  std::size_t headers_count{0};
+
+  /// Size of the request line and headers including the final empty line
+  std::size_t size{0};
+};
+
+/// @brief Bulk parser of the HTTP/1.x request head, in the spirit of
+/// picohttpparser.
+///
+/// Delimiters of the URL and the header values are searched for with
+/// SSE4.2 string instructions when they are available, 16 bytes at once.
+/// Only the strict RFC 7230 syntax is accepted: CRLF line endings,
+/// HTTP/1.0 or HTTP/1.1, no obsolete line folding. Anything else results in
+/// kUnsupported and should be handed to the generic parser, which takes care
+/// of reporting the errors.
+HeadParseStatus ParseRequestHead(std::string_view data,
+                                 RequestHead& head) noexcept;
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include <http_parser.h>
+
+#include <server/http/request_head_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeRequest(std::int64_t headers_count) {
+  std::string request =
+      "GET /v1/some/handler/path?arg1=value1&arg2=value2 HTTP/1.1\r\n";
+  for (std::int64_t i = 0; i < headers_count; ++i) {
+    request += "X-Test-Header-" + std::to_string(i) +
+               ": some reasonably long header value " + std::to_string(i) +
+               "\r\n";
+  }
+  request += "\r\n";
+  return request;
+}
+
+int CountHeader(http_parser* p, const char*, size_t) {
+  ++*static_cast<std::size_t*>(p->data);
+  return 0;
+}
+
+void http_parser_request_head(benchmark::State& state) {
+  const auto request = MakeRequest(state.range(0));
+
+  http_parser_settings settings{};
+  settings.on_url = CountHeader;
+  settings.on_header_field = CountHeader;
+  settings.on_header_value = CountHeader;
+
+  std::size_t callbacks_count = 0;
+  for (auto _ : state) {
+    http_parser parser{};
+    http_parser_init(&parser, HTTP_REQUEST);
+    parser.data = &callbacks_count;
+    benchmark::DoNotOptimize(http_parser_execute(&parser, &settings,
+                                                 request.data(),
+                                                 request.size()));
+  }
+  benchmark::DoNotOptimize(callbacks_count);
+}
+
+void request_head_parser(benchmark::State& state) {
+  const auto request = MakeRequest(state.range(0));
+
+  for (auto _ : state) {
+    server::http::impl::RequestHead head;
+    benchmark::DoNotOptimize(
+        server::http::impl::ParseRequestHead(request, head));
+    benchmark::DoNotOptimize(head);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(http_parser_request_head)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(request_head_parser)->RangeMultiplier(2)->Range(1, 32);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include <server/http/request_head_parser.hpp>
+
+#include <string>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::HeadParseStatus;
+using server::http::impl::ParseRequestHead;
+using server::http::impl::RequestHead;
+
+constexpr std::string_view kRequest =
+    "POST /some/path?arg=value HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Content-Length: 4\r\n"
+    "X-Padded:   value with spaces \t \r\n"
+    "X-Empty:\r\n"
+    "\r\n"
+    "body";
+
+}  // namespace
+
+TEST(RequestHeadParser, Basic) {
+  RequestHead head;
+  ASSERT_EQ(ParseRequestHead(kRequest, head), HeadParseStatus::kComplete);
+
+  EXPECT_EQ(head.method, "POST");
+  EXPECT_EQ(head.url, "/some/path?arg=value");
+  EXPECT_EQ(head.http_major, 1);
+  EXPECT_EQ(head.http_minor, 1);
+  EXPECT_EQ(head.size, kRequest.size() - 4);
+
+  ASSERT_EQ(head.headers_count, 4);
+  EXPECT_EQ(head.headers[0].name, "Host");
+  EXPECT_EQ(head.headers[0].value, "localhost");
+  EXPECT_EQ(head.headers[1].name, "Content-Length");
+  EXPECT_EQ(head.headers[1].value, "4");
+  EXPECT_EQ(head.headers[2].name, "X-Padded");
+  EXPECT_EQ(head.headers[2].value, "value with spaces");
+  EXPECT_EQ(head.headers[3].name, "X-Empty");
+  EXPECT_EQ(head.headers[3].value, "");
+}
+
+TEST(RequestHeadParser, NoHeaders) {
+  RequestHead head;
+  ASSERT_EQ(ParseRequestHead("GET / HTTP/1.0\r\n\r\n", head),
+            HeadParseStatus::kComplete);
+  EXPECT_EQ(head.method, "GET");
+  EXPECT_EQ(head.url, "/");
+  EXPECT_EQ(head.http_minor, 0);
+  EXPECT_EQ(head.headers_count, 0);
+}
+
+TEST(RequestHeadParser, Incomplete) {
+  const auto head_size = kRequest.size() - 4;
+  for (std::size_t size = 0; size < head_size; ++size) {
+    RequestHead head;
+    EXPECT_EQ(ParseRequestHead(kRequest.substr(0, size), head),
+              HeadParseStatus::kNeedMoreData)
+        << "size=" << size;
+  }
+}
+
+TEST(RequestHeadParser, LongLines) {
+  const std::string url = "/" + std::string(1000, 'u');
+  const std::string value(1000, 'v');
+  const std::string request =
+      "GET " + url + " HTTP/1.1\r\nX-Long: " + value + "\r\n\r\n";
+
+  RequestHead head;
+  ASSERT_EQ(ParseRequestHead(request, head), HeadParseStatus::kComplete);
+  EXPECT_EQ(head.url, url);
+  ASSERT_EQ(head.headers_count, 1);
+  EXPECT_EQ(head.headers[0].value, value);
+
+  // delimiter in the middle of a 16 bytes block
+  std::string bad_request = request;
+  bad_request[request.find('v') + 517] = '\x01';
+  EXPECT_EQ(ParseRequestHead(bad_request, head),
+            HeadParseStatus::kUnsupported);
+}
+
+TEST(RequestHeadParser, Unsupported) {
+  const std::string_view kRequests[] = {
+      "GET / HTTP/1.1\n\n",
+      "GET / HTTP/2.0\r\n\r\n",
+      "GET  / HTTP/1.1\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Header : value\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Header: value\r\n  folded\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Header: va\x7flue\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Header: value\n\r\n",
+      "GET / HTTP/1.1\r\n\r\r\n",
+  };
+  for (const auto request : kRequests) {
+    RequestHead head;
+    EXPECT_EQ(ParseRequestHead(request, head), HeadParseStatus::kUnsupported)
+        << request;
+  }
+}
+
+TEST(RequestHeadParser, TooManyHeaders) {
+  std::string request = "GET / HTTP/1.1\r\n";
+  for (std::size_t i = 0; i <= RequestHead::kMaxHeaders; ++i) {
+    request += "X-Header: value\r\n";
+  }
+  request += "\r\n";
+
+  RequestHead head;
+  EXPECT_EQ(ParseRequestHead(request, head), HeadParseStatus::kUnsupported);
+}
+
+USERVER_NAMESPACE_END
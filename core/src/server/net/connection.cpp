@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <array>
 #include <stdexcept>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 
@@ -14,6 +16,7 @@
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
@@ -50,7 +53,8 @@ Connection::Connection(
       stats_(std::move(stats)),
       data_accounter_(data_accounter),
       remote_address_(peer_socket_.Getpeername().PrimaryAddressString()),
-      request_tasks_(Queue::Create()) {
+      idle_read_watcher_(engine::current_task::GetEventThread(), this),
+      idle_timeout_watcher_(engine::current_task::GetEventThread(), this) {
   LOG_DEBUG() << "Incoming connection from " << peer_socket_.Getpeername()
               << ", fd " << Fd();
 
@@ -63,8 +67,15 @@ void Connection::SetCloseCb(CloseCb close_cb) {
 }
 
 void Connection::Start() {
+  std::lock_guard lock(state_mutex_);
+  StartTasks();
+}
+
+void Connection::StartTasks() {
   LOG_TRACE() << "Starting socket listener for fd " << Fd();
 
+  request_tasks_ = Queue::Create();
+
   // TODO TAXICOMMON-1993 Remove slicing once the issues with payload lifetime
   // in cancelled TaskWithResult are resolved
   engine::Task socket_listener =
@@ -75,6 +86,7 @@ void Connection::Start() {
             ListenForRequests(std::move(producer));
           },
           request_tasks_->GetProducer());
+  socket_listener_token_ = engine::TaskCancellationToken{socket_listener};
 
   // `response_sender_task_` always starts because it is a Critical task
 
@@ -90,19 +102,57 @@ void Connection::Start() {
 
         socket_listener.SyncCancel();
         self->ProcessResponses(consumer);  // Consume remaining requests
-        self->Shutdown();
+        self->FinishTasks();
       },
       shared_from_this(), std::move(socket_listener));
+  if (is_stop_requested_) response_sender_task_.RequestCancel();
   response_sender_launched_event_.Send();
   response_sender_assigned_event_.Send();
 
   LOG_TRACE() << "Started socket listener for fd " << Fd();
 }
 
-void Connection::Stop() { response_sender_task_.RequestCancel(); }
+void Connection::Stop() {
+  std::shared_ptr<Connection> idle_self;
+  std::lock_guard lock(state_mutex_);
+  is_stop_requested_ = true;
+  if (response_sender_task_.IsValid()) {
+    response_sender_task_.RequestCancel();
+    return;
+  }
+
+  // a woken up connection notices is_stop_requested_ by itself
+  auto expected = IdleState::kIdle;
+  if (idle_state_.compare_exchange_strong(expected, IdleState::kWakingUp)) {
+    idle_read_watcher_.Stop();
+    idle_timeout_watcher_.Stop();
+    idle_self = std::move(idle_self_);
+    idle_state_ = IdleState::kActive;
+    --stats_->idle_connections;
+    Close();
+  }
+}
 
 int Connection::Fd() const { return peer_socket_.Fd(); }
 
+void Connection::FinishTasks() noexcept {
+  std::lock_guard lock(state_mutex_);
+  if (std::exchange(is_idle_release_requested_, false) &&
+      !is_stop_requested_ && is_response_chain_valid_ &&
+      !engine::current_task::ShouldCancel()) {
+    try {
+      ReleaseWhenIdle();
+      return;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to release idle connection on fd " << Fd()
+                  << ": " << ex;
+      idle_state_ = IdleState::kActive;
+      idle_self_.reset();
+    }
+  }
+  Shutdown();
+}
+
 void Connection::Shutdown() noexcept {
   UASSERT(response_sender_task_.IsValid());
 
@@ -110,20 +160,92 @@ void Connection::Shutdown() noexcept {
                  "requests) for fd "
               << Fd();
 
+  Close();
+
+  UASSERT(IsRequestTasksEmpty());
+
+  // `~Connection()` may be called from within the `response_sender_task_`.
+  // Without `Detach()` we get a deadlock.
+  std::move(response_sender_task_).Detach();
+}
+
+void Connection::Close() noexcept {
   peer_socket_.Close();  // should not throw
 
   --stats_->active_connections;
   ++stats_->connections_closed;
 
   if (close_cb_) close_cb_();  // should not throw
+}
 
+void Connection::ReleaseWhenIdle() {
   UASSERT(IsRequestTasksEmpty());
-
-  // `~Connection()` may be called from within the `response_sender_task_`.
-  // Without `Detach()` we get a deadlock.
+  LOG_TRACE() << "Releasing the tasks of idle connection on fd " << Fd();
+
+  const auto keepalive_left = std::chrono::duration<double>(
+      keepalive_deadline_.TimeLeftApprox());
+  idle_self_ = shared_from_this();
+  idle_state_ = IdleState::kIdle;
+  idle_timeout_watcher_.Init(&Connection::OnIdleTimeout,
+                             std::max(keepalive_left.count(), 0.0), 0.0);
+  idle_timeout_watcher_.Start();
+  idle_read_watcher_.Init(&Connection::OnIdleReadable, Fd(), EV_READ);
+  idle_read_watcher_.Start();
+  ++stats_->idle_connections;
+
+  // the task is finishing, the next one is started by WakeUp()
   std::move(response_sender_task_).Detach();
 }
 
+void Connection::OnIdleReadable(struct ev_loop*, ev_io* io, int) noexcept {
+  static_cast<Connection*>(io->data)->WakeUp(true);
+}
+
+void Connection::OnIdleTimeout(struct ev_loop*, ev_timer* timer,
+                               int) noexcept {
+  static_cast<Connection*>(timer->data)->WakeUp(false);
+}
+
+void Connection::WakeUp(bool is_readable) noexcept {
+  auto expected = IdleState::kIdle;
+  if (!idle_state_.compare_exchange_strong(expected, IdleState::kWakingUp)) {
+    return;
+  }
+  // called from the ev thread of the watchers, stops them in place
+  idle_read_watcher_.Stop();
+  idle_timeout_watcher_.Stop();
+
+  try {
+    engine::CriticalAsyncNoSpan(
+        task_processor_,
+        [self = std::move(idle_self_), is_readable] {
+          self->Resume(is_readable);
+        })
+        .Detach();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to wake up idle connection: " << ex;
+  }
+}
+
+void Connection::Resume(bool is_readable) noexcept {
+  std::lock_guard lock(state_mutex_);
+  idle_state_ = IdleState::kActive;
+  --stats_->idle_connections;
+
+  if (!is_readable) {
+    LOG_INFO() << "Closing idle connection on timeout";
+  } else if (!is_stop_requested_) {
+    try {
+      StartTasks();
+      return;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to resume idle connection on fd " << Fd() << ": "
+                  << ex;
+    }
+  }
+  Close();
+}
+
 bool Connection::IsRequestTasksEmpty() const noexcept {
   return request_tasks_->GetSizeApproximate() == 0;
 }
@@ -135,6 +257,7 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
     // do not request cancel unless we're sure it's in valid state
     // this task can only normally be cancelled from response sender
     if (response_sender_launched_event_.WaitForEvent()) {
+      std::lock_guard lock(state_mutex_);
       response_sender_task_.RequestCancel();
     }
   });
@@ -142,20 +265,37 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
-    http::HttpRequestParser request_parser(
+    const auto on_new_request = [this,
+                                 &producer](RequestBasePtr&& request_ptr) {
+      if (!NewRequest(std::move(request_ptr), producer)) {
+        is_accepting_requests_ = false;
+      }
+    };
+    http::HttpRequestParser http_request_parser(
         request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
-        [this, &producer](RequestBasePtr&& request_ptr) {
-          if (!NewRequest(std::move(request_ptr), producer)) {
-            is_accepting_requests_ = false;
-          }
-        },
-        stats_->parser_stats, data_accounter_);
+        on_new_request, stats_->parser_stats, data_accounter_);
+    request::RequestParser* request_parser = &http_request_parser;
+
+    // HTTP/2 with prior knowledge is recognized by the client connection
+    // preface, the preface may be split between the reads
+    bool is_protocol_detected = !config_.http2.enabled;
+    std::string connection_head;
 
     std::vector<char> buf(config_.in_buffer_size);
     std::size_t last_bytes_read = 0;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
+      // The connection without requests in progress releases its tasks and
+      // buffers if it stays idle for idle_release_timeout
+      auto wait_deadline = deadline;
+      if (config_.idle_release_timeout.count() > 0 && !http2_session_ &&
+          connection_head.empty() && http_request_parser.IsIdle()) {
+        wait_deadline = std::min(
+            deadline,
+            engine::Deadline::FromDuration(config_.idle_release_timeout));
+      }
+
       bool is_readable = true;
       // If we didn't fill the buffer in the previous loop iteration we almost
       // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
@@ -168,7 +308,14 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       //
       // So instead we just do 2. and 3., shaving off a whole recv syscall
       if (last_bytes_read != buf.size()) {
-        is_readable = peer_socket_.WaitReadable(deadline);
+        is_readable = peer_socket_.WaitReadable(wait_deadline);
+        if (!is_readable && wait_deadline < deadline &&
+            !engine::current_task::ShouldCancel()) {
+          keepalive_deadline_ = deadline;
+          is_idle_release_requested_ = true;
+          send_stopper.Release();
+          return;
+        }
       }
 
       last_bytes_read =
@@ -185,22 +332,54 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         //
         // It is faster (and probably more efficient) for us to cancel currently
         // processing and pending requests.
+        //
+        // The socket is not readable on the keepalive timeout and on the
+        // cancellation of the listener, the peer is still there then.
+        if (is_readable) is_peer_disconnected_ = true;
         return;
       }
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << peer_socket_.Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
+      std::string_view data{buf.data(), last_bytes_read};
+      if (!is_protocol_detected) {
+        connection_head.append(data);
+        data = connection_head;
+
+        const auto& preface = http::kHttp2Preface;
+        const auto common_size = std::min(data.size(), preface.size());
+        if (data.substr(0, common_size) != preface.substr(0, common_size)) {
+          is_protocol_detected = true;
+        } else if (data.size() >= preface.size()) {
+          LOG_TRACE() << "HTTP/2 connection preface on fd " << Fd();
+          is_protocol_detected = true;
+          http2_session_ = std::make_unique<http::Http2Session>(
+              config_.http2, request_handler_.GetHandlerInfoIndex(),
+              handler_defaults_config_, on_new_request, stats_->parser_stats,
+              stats_->http2_stats, data_accounter_, peer_socket_);
+          request_parser = http2_session_.get();
+        } else {
+          continue;
+        }
+      }
+
+      if (!request_parser->Parse(data.data(), data.size())) {
         LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
                     << " on fd " << Fd();
 
         // Stop accepting new requests, send previous answers.
         is_accepting_requests_ = false;
       }
+      connection_head.clear();
     }
 
     send_stopper.Release();
     LOG_TRACE() << "Gracefully stopping ListenForRequests()";
+
+    if (config_.cancel_on_disconnect && is_final_request_accepted_ &&
+        !is_upgrade_request_accepted_) {
+      WaitForPeerDisconnect(buf);
+    }
   } catch (const engine::io::IoTimeout&) {
     LOG_INFO() << "Closing idle connection on timeout";
     send_stopper.Release();
@@ -213,6 +392,7 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         ex.Code().value() == static_cast<int>(std::errc::connection_reset)
             ? logging::Level::kWarning
             : logging::Level::kError;
+    is_peer_disconnected_ = true;
     LOG(log_level) << "I/O error while receiving from peer "
                    << peer_socket_.Getpeername() << " on fd " << Fd() << ": "
                    << ex;
@@ -223,6 +403,28 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   }
 }
 
+void Connection::WaitForPeerDisconnect(std::vector<char>& buf) {
+  // Nothing is expected after the final request, the sender cancels this task
+  // once the final response is sent
+  try {
+    while (peer_socket_.WaitReadable({})) {
+      // the data after the final request is ignored
+      if (!peer_socket_.RecvSome(buf.data(), buf.size(), {})) break;
+    }
+    if (engine::current_task::ShouldCancel()) return;
+  } catch (const engine::io::IoSystemError& ex) {
+    LOG_DEBUG() << "I/O error while waiting for the final response: " << ex;
+  }
+
+  LOG_DEBUG() << "Peer " << peer_socket_.Getpeername() << " on fd " << Fd()
+              << " disconnected, cancelling the requests in progress";
+  is_peer_disconnected_ = true;
+  if (response_sender_launched_event_.WaitForEvent()) {
+    std::lock_guard lock(state_mutex_);
+    response_sender_task_.RequestCancel();
+  }
+}
+
 bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                             Queue::Producer& producer) {
   if (!is_accepting_requests_) {
@@ -235,6 +437,8 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
 
   if (request_ptr->IsFinal()) {
     is_accepting_requests_ = false;
+    is_final_request_accepted_ = true;
+    is_upgrade_request_accepted_ = request_ptr->IsUpgrade();
   }
 
   ++stats_->active_request_count;
@@ -248,13 +452,26 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
     while (consumer.Pop(item)) {
       HandleQueueItem(item);
 
-      // now we must complete processing
-      engine::TaskCancellationBlocker block_cancel;
+      bool is_upgraded = false;
+      {
+        // now we must complete processing
+        engine::TaskCancellationBlocker block_cancel;
+
+        /* In stream case we don't want a user task to exit
+         * until SendResponse() as the task produces body chunks.
+         */
+        const bool is_sent = SendResponse(*item.first);
+        is_upgraded = is_sent && item.first->IsUpgrade() &&
+                      item.first->GetResponse().IsUpgradeRequested();
+        if (config_.cancel_on_disconnect && item.first->IsFinal()) {
+          // stops WaitForPeerDisconnect()
+          socket_listener_token_.RequestCancel();
+        }
+      }
+
+      // the new protocol runs in this task and may be cancelled by Stop()
+      if (is_upgraded) SwitchProtocols(*item.first);
 
-      /* In stream case we don't want a user task to exit
-       * until SendResponse() as the task produces body chunks.
-       */
-      SendResponse(*item.first);
       item.first.reset();
       item.second = {};
     }
@@ -269,6 +486,7 @@ void Connection::HandleQueueItem(QueueItem& item) {
   if (engine::current_task::IsCancelRequested()) {
     // We could've packed all remaining requests into a vector and cancel them
     // in parallel. But pipelining is almost never used so why bother.
+    if (is_peer_disconnected_) request.MarkAsCancelledByPeer();
     auto request_task = std::move(item.second);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
@@ -281,8 +499,8 @@ void Connection::HandleQueueItem(QueueItem& item) {
     if (response.IsBodyStreamed()) {
       response.WaitForHeadersEnd();
     } else {
-      auto request_task = std::move(item.second);
-      request_task.Get();
+      // the task stays in the item if the wait is interrupted
+      item.second.Get();
     }
   } catch (const engine::TaskCancelledException&) {
     LOG_LIMITED_ERROR() << "Handler task was cancelled";
@@ -294,20 +512,31 @@ void Connection::HandleQueueItem(QueueItem& item) {
   } catch (const engine::WaitInterruptedException&) {
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
+    if (is_peer_disconnected_) request.MarkAsCancelledByPeer();
+    if (!request.GetResponse().IsBodyStreamed()) {
+      auto request_task = std::move(item.second);
+      request_task.SyncCancel();
+    }
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request.MarkAsInternalServerError();
   }
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+bool Connection::SendResponse(request::RequestBase& request) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
+  bool is_sent = false;
   if (is_response_chain_valid_ && peer_socket_) {
     try {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(peer_socket_);
+      if (http2_session_) {
+        http2_session_->SendResponse(request);
+      } else {
+        response.SendResponse(peer_socket_);
+      }
+      is_sent = true;
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -326,9 +555,26 @@ void Connection::SendResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
+  stats_->bytes_sent += response.BytesSent();
+  stats_->bytes_copied += response.BytesCopied();
 
   request.WriteAccessLogs(request_handler_.LoggerAccess(),
                           request_handler_.LoggerAccessTskv(), remote_address_);
+  return is_sent;
+}
+
+void Connection::SwitchProtocols(request::RequestBase& request) noexcept {
+  UASSERT(!http2_session_);
+  LOG_DEBUG() << "Switching protocols on fd " << Fd();
+  ++stats_->upgraded_connections;
+  try {
+    request.GetResponse().SwitchProtocols(peer_socket_);
+  } catch (const engine::io::IoCancelled&) {
+    LOG_TRACE() << "Upgraded connection on fd " << Fd() << " was cancelled";
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Upgraded connection on fd " << Fd()
+                  << " failed: " << ex;
+  }
 }
 
 }  // namespace server::net
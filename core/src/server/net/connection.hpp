@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <engine/ev/watcher.hpp>
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
@@ -11,7 +15,9 @@
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
@@ -60,17 +66,30 @@ class Connection final : public std::enable_shared_from_this<Connection> {
                               engine::TaskWithResult<void>>;
   using Queue = concurrent::SpscQueue<QueueItem>;
 
+  enum class IdleState { kActive, kIdle, kWakingUp };
+
+  void StartTasks();
+  void FinishTasks() noexcept;
   void Shutdown() noexcept;
+  void Close() noexcept;
+
+  void ReleaseWhenIdle();
+  void WakeUp(bool is_readable) noexcept;
+  void Resume(bool is_readable) noexcept;
+  static void OnIdleReadable(struct ev_loop*, ev_io* io, int) noexcept;
+  static void OnIdleTimeout(struct ev_loop*, ev_timer* timer, int) noexcept;
 
   bool IsRequestTasksEmpty() const noexcept;
 
   void ListenForRequests(Queue::Producer) noexcept;
+  void WaitForPeerDisconnect(std::vector<char>& buf);
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
   void HandleQueueItem(QueueItem& item);
-  void SendResponse(request::RequestBase& request);
+  bool SendResponse(request::RequestBase& request);
+  void SwitchProtocols(request::RequestBase& request) noexcept;
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
@@ -81,14 +100,40 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   request::ResponseDataAccounter& data_accounter_;
   const std::string remote_address_;
 
+  // set by ListenForRequests() on the HTTP/2 connection preface
+  std::unique_ptr<http::Http2Session> http2_session_;
+
   std::shared_ptr<Queue> request_tasks_;
   engine::SingleConsumerEvent response_sender_launched_event_;
   engine::SingleConsumerEvent response_sender_assigned_event_;
   engine::Task response_sender_task_;
+  engine::TaskCancellationToken socket_listener_token_;
 
   bool is_accepting_requests_{true};
+  bool is_final_request_accepted_{false};
+  // the socket belongs to the new protocol after the final upgrade request
+  bool is_upgrade_request_accepted_{false};
+  // set by ListenForRequests() before it cancels the in-flight requests
+  std::atomic<bool> is_peer_disconnected_{false};
   bool is_response_chain_valid_{true};
   CloseCb close_cb_;
+
+  // guards response_sender_task_ and is_stop_requested_ against Stop() while
+  // the tasks of an idle connection are released or restarted
+  engine::Mutex state_mutex_;
+  bool is_stop_requested_{false};
+
+  // set by ListenForRequests() once the connection is idle for
+  // idle_release_timeout
+  bool is_idle_release_requested_{false};
+  engine::Deadline keepalive_deadline_;
+
+  // while idle the connection has no tasks, keeps itself alive and is watched
+  // only by the ev watchers
+  std::atomic<IdleState> idle_state_{IdleState::kActive};
+  std::shared_ptr<Connection> idle_self_;
+  engine::ev::Watcher<ev_io> idle_read_watcher_;
+  engine::ev::Watcher<ev_timer> idle_timeout_watcher_;
 };
 
 }  // namespace server::net
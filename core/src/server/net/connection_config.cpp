@@ -1,11 +1,32 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>) {
+  Http2Config config;
+
+  config.enabled = value["enabled"].As<bool>(config.enabled);
+  config.max_concurrent_streams = value["max_concurrent_streams"].As<uint32_t>(
+      config.max_concurrent_streams);
+  config.initial_window_size = value["initial_window_size"].As<uint32_t>(
+      config.initial_window_size);
+
+  // RFC 7540 section 6.5.2
+  if (config.initial_window_size > (1U << 31) - 1) {
+    throw std::runtime_error("Invalid initial_window_size value in " +
+                             value.GetPath());
+  }
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -18,6 +39,12 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.idle_release_timeout =
+      value["idle_release_timeout"].As<std::chrono::milliseconds>(
+          config.idle_release_timeout);
+  config.cancel_on_disconnect =
+      value["cancel_on_disconnect"].As<bool>(config.cancel_on_disconnect);
+  config.http2 = value["http2"].As<Http2Config>(config.http2);
 
   return config;
 }
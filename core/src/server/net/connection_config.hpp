@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,12 +11,28 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct Http2Config {
+  // accept HTTP/2 with prior knowledge (h2c) along with HTTP/1.1
+  bool enabled = false;
+  std::uint32_t max_concurrent_streams = 100;
+  // per-stream flow-control window for the request bodies
+  std::uint32_t initial_window_size = 64 * 1024 - 1;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  // zero keeps the tasks and buffers of idle connections
+  std::chrono::milliseconds idle_release_timeout{0};
+  // watch for the peer disconnect while the final request is in progress
+  bool cancel_on_disconnect = false;
+  Http2Config http2;
 };
 
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
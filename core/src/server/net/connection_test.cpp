@@ -81,9 +81,11 @@ enum class ConnectionHeader {
 
 clients::http::ResponseFuture CreateRequest(
     clients::http::Client& http_client, engine::io::Socket& request_socket,
-    ConnectionHeader header = ConnectionHeader::kKeepAlive) {
+    ConnectionHeader header = ConnectionHeader::kKeepAlive,
+    clients::http::HttpVersion version = clients::http::HttpVersion::kDefault) {
   auto ret = http_client.CreateRequest()
                  ->get(HttpConnectionUriFromSocket(request_socket))
+                 ->http_version(version)
                  ->retry(1)
                  ->timeout(std::chrono::milliseconds(100));
   if (header == ConnectionHeader::kClose) {
@@ -282,6 +284,146 @@ UTEST(ServerNetConnection, KeepAlive) {
   EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+UTEST(ServerNetConnection, IdleRelease) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.idle_release_timeout = std::chrono::milliseconds{1};
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kKeepAlive);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  const auto wait_idle = [&stats] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (stats->idle_connections == 0 && !deadline.IsReached()) {
+      engine::SleepFor(std::chrono::milliseconds{1});
+    }
+    return stats->idle_connections == 1;
+  };
+
+  connection_ptr->Start();
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  ASSERT_TRUE(wait_idle());
+
+  // the idle connection is woken up by the next request
+  request = CreateRequest(*http_client_ptr, request_socket,
+                          ConnectionHeader::kKeepAlive);
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 2);
+  EXPECT_EQ(stats->connections_created, 1);
+  ASSERT_TRUE(wait_idle());
+
+  std::weak_ptr<net::Connection> weak = connection_ptr;
+  connection_ptr->Stop();
+  connection_ptr.reset();
+  EXPECT_FALSE(weak.lock());
+  EXPECT_EQ(stats->idle_connections, 0);
+  EXPECT_EQ(stats->connections_closed, 1);
+}
+
+UTEST(ServerNetConnection, CancelOnDisconnect) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.cancel_on_disconnect = true;
+  auto request_socket = net::CreateSocket(config);
+
+  // the client closes the connection once its request times out
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request =
+      CreateRequest(*http_client_ptr, request_socket, ConnectionHeader::kClose);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kHang};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  request.Wait();
+
+  // the handler of the final request is cancelled without waiting for it
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime / 2);
+  while (handler.asyncs_finished == 0 && !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(handler.asyncs_finished, 1);
+}
+
+UTEST(ServerNetConnection, Http2PriorKnowledge) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2.enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kKeepAlive,
+                               clients::http::HttpVersion::k2PriorKnowledge);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  EXPECT_EQ(request.Get()->status_code(), 404);
+
+  // the second request is a new stream of the same connection
+  request = CreateRequest(*http_client_ptr, request_socket,
+                          ConnectionHeader::kKeepAlive,
+                          clients::http::HttpVersion::k2PriorKnowledge);
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 2);
+  EXPECT_EQ(stats->http2_stats.streams_opened, 2);
+  EXPECT_EQ(stats->requests_processed_count, 2);
+}
+
+UTEST(ServerNetConnection, Http2EnabledServesHttp11) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2.enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kKeepAlive,
+                               clients::http::HttpVersion::k11);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(stats->http2_stats.streams_opened, 0);
+}
+
 UTEST(ServerNetConnection, CancelMultipleInFlight) {
   constexpr std::size_t kInFlightRequests = 10;
   constexpr std::size_t kMaxAttempts = 10;
@@ -6,9 +6,13 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
 
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -21,6 +25,8 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -82,6 +88,34 @@ engine::io::Socket CreateSocket(const ListenerConfig& config) {
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
 
+void AttachReuseportCpuProgram(engine::io::Socket& socket,
+                               std::size_t shard_count) {
+  UASSERT(shard_count > 0);
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // A = cpu; A %= shard_count; return A;
+  sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0,
+       static_cast<std::uint32_t>(shard_count)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  sock_fprog program{static_cast<unsigned short>(std::size(code)), code};
+  if (::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                   &program, sizeof(program)) == -1) {
+    const std::error_code ec(errno, std::system_category());
+    LOG_WARNING() << "Failed to attach the SO_REUSEPORT CPU program, "
+                     "connections are balanced by the kernel hash: "
+                  << ec.message();
+  }
+#else
+  static_cast<void>(socket);
+  static_cast<void>(shard_count);
+  LOG_WARNING() << "SO_ATTACH_REUSEPORT_CBPF is not supported, connections "
+                   "are balanced by the kernel hash";
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
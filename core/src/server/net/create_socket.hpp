@@ -9,6 +9,12 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config);
 
+/// Attaches a program to the SO_REUSEPORT group of the socket that passes
+/// the connections received on CPU `i` to the `i % shard_count` socket of the
+/// group, the kernel falls back to the hash balancing on failure
+void AttachReuseportCpuProgram(engine::io::Socket& socket,
+                               std::size_t shard_count);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
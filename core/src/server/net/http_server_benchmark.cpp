@@ -0,0 +1,279 @@
+#include <benchmark/benchmark.h>
+
+#include <netinet/in.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/handlers/http_handler_base_statistics.hpp>
+#include <server/http/handler_info_index.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/request_handler_base.hpp>
+#include <server/net/connection.hpp>
+#include <server/net/create_socket.hpp>
+#include <server/net/listener_config.hpp>
+#include <server/net/stats.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/gbench_latency.hpp>
+
+// End-to-end benchmark of the server: the requests of an in-process load
+// generator go over loopback through server::net::Connection, the request
+// parser and a handler, and the responses are written back to the sockets.
+
+USERVER_NAMESPACE_BEGIN
+
+namespace net = server::net;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+constexpr std::size_t kWorkerThreads = 4;
+constexpr std::size_t kStaticBodySize = 4096;
+
+constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+constexpr std::string_view kContentLength = "\r\nContent-Length: ";
+constexpr std::string_view kStatusOk = "HTTP/1.1 200";
+
+using namespace utils::gbench;
+
+enum class HandlerType { kPing, kJsonEcho, kStatic };
+
+const char* ToString(HandlerType type) {
+  switch (type) {
+    case HandlerType::kPing:
+      return "ping";
+    case HandlerType::kJsonEcho:
+      return "json-echo";
+    case HandlerType::kStatic:
+      return "static";
+  }
+
+  UINVARIANT(false, "Unexpected handler type");
+}
+
+std::string MakeRequest(HandlerType type) {
+  switch (type) {
+    case HandlerType::kPing:
+      return "GET /ping HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    case HandlerType::kJsonEcho: {
+      const std::string_view body =
+          R"({"id":42,"name":"benchmark","tags":["a","b","c"],)"
+          R"("nested":{"value":3.14,"enabled":true}})";
+      return fmt::format(
+          "POST /json HTTP/1.1\r\nHost: localhost\r\n"
+          "Content-Type: application/json\r\nContent-Length: {}\r\n\r\n{}",
+          body.size(), body);
+    }
+    case HandlerType::kStatic:
+      return "GET /static HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+
+  UINVARIANT(false, "Unexpected handler type");
+}
+
+// Picks the handler by the request path instead of routing, so that no
+// components are required. The requests are logged as not found, which is
+// below the log level of the benchmarks.
+class BenchmarkRequestHandler final : public server::http::RequestHandlerBase {
+ public:
+  engine::TaskWithResult<void> StartRequestTask(
+      std::shared_ptr<server::request::RequestBase> request) const override {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    static_cast<server::http::HttpRequestImpl&>(*request)
+        .SetHttpHandlerStatistics(statistics_);
+
+    return engine::AsyncNoSpan([this, request = std::move(request)] {
+      request->SetTaskStartTime();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      Handle(static_cast<server::http::HttpRequestImpl&>(*request));
+      const auto now = Clock::now();
+      request->SetResponseNotifyTime(now);
+      request->GetResponse().SetReady(now);
+    });
+  }
+
+  const server::http::HandlerInfoIndex& GetHandlerInfoIndex() const override {
+    return handler_info_index_;
+  }
+
+  const logging::LoggerPtr& LoggerAccess() const noexcept override {
+    return no_logger_;
+  }
+  const logging::LoggerPtr& LoggerAccessTskv() const noexcept override {
+    return no_logger_;
+  }
+
+ private:
+  void Handle(const server::http::HttpRequestImpl& request) const {
+    request.SetResponseStatus(server::http::HttpStatus::kOk);
+    auto& response = request.GetHttpResponse();
+
+    const auto& path = request.GetRequestPath();
+    if (path == "/json") {
+      response.SetContentType(
+          USERVER_NAMESPACE::http::content_type::kApplicationJson);
+      response.SetData(formats::json::ToString(
+          formats::json::FromString(request.RequestBody())));
+    } else if (path == "/static") {
+      response.SetSharedData(*static_body_, static_body_);
+    }
+  }
+
+  mutable server::handlers::HttpRequestStatistics statistics_;
+  const std::shared_ptr<const std::string> static_body_ =
+      std::make_shared<const std::string>(kStaticBodySize, 'a');
+  logging::LoggerPtr no_logger_;
+  server::http::HandlerInfoIndex handler_info_index_;
+};
+
+// A keep-alive connection that sends the requests in pipelined batches
+class LoadClient final {
+ public:
+  LoadClient(const engine::io::Sockaddr& addr, std::string_view request,
+             std::size_t pipeline_depth)
+      : socket_(addr.Domain(), engine::io::SocketType::kStream),
+        pipeline_depth_(pipeline_depth) {
+    batch_.reserve(request.size() * pipeline_depth);
+    for (std::size_t i = 0; i < pipeline_depth; ++i) batch_.append(request);
+    socket_.Connect(addr, engine::Deadline::FromDuration(kDeadlineMaxTime));
+  }
+
+  void RunBatch(LatencyPercentile& latency) {
+    const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+    const auto start = Clock::now();
+    UINVARIANT(socket_.SendAll(batch_.data(), batch_.size(), deadline) ==
+                   batch_.size(),
+               "Failed to send the requests");
+
+    for (std::size_t i = 0; i < pipeline_depth_; ++i) {
+      ReadResponse(deadline);
+      Account(latency, start);
+    }
+  }
+
+ private:
+  void ReadResponse(engine::Deadline deadline) {
+    while (true) {
+      const auto head_end = buffer_.find(kHeadersEnd);
+      if (head_end != std::string::npos) {
+        UINVARIANT(buffer_.compare(0, kStatusOk.size(), kStatusOk) == 0,
+                   "Unexpected response status");
+        const auto length_pos = buffer_.find(kContentLength);
+        UINVARIANT(length_pos < head_end, "No Content-Length in the response");
+
+        const auto body_size = std::strtoull(
+            buffer_.c_str() + length_pos + kContentLength.size(), nullptr, 10);
+        const auto response_size = head_end + kHeadersEnd.size() + body_size;
+        if (buffer_.size() >= response_size) {
+          buffer_.erase(0, response_size);
+          return;
+        }
+      }
+
+      const auto size =
+          socket_.RecvSome(chunk_.data(), chunk_.size(), deadline);
+      UINVARIANT(size != 0, "The server closed the connection");
+      buffer_.append(chunk_.data(), size);
+    }
+  }
+
+  engine::io::Socket socket_;
+  const std::size_t pipeline_depth_;
+  std::string batch_;
+  std::string buffer_;
+  std::array<char, 16 * 1024> chunk_{};
+};
+
+}  // namespace
+
+// state.range(0) is the handler type, each of the state.range(1) connections
+// sends batches of state.range(2) pipelined requests
+void http_server_load(benchmark::State& state) {
+  const auto handler_type = static_cast<HandlerType>(state.range(0));
+  const auto connections = static_cast<std::size_t>(state.range(1));
+  const auto pipeline_depth = static_cast<std::size_t>(state.range(2));
+  state.SetLabel(ToString(handler_type));
+
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+
+    net::ListenerConfig config;
+    config.handler_defaults = server::request::HttpRequestConfig{};
+    auto listener_socket = net::CreateSocket(config);
+    auto addr = listener_socket.Getsockname();
+    addr.As<struct sockaddr_in6>()->sin6_addr = in6addr_loopback;
+
+    const BenchmarkRequestHandler handler;
+    auto stats = std::make_shared<net::Stats>();
+    server::request::ResponseDataAccounter data_accounter;
+
+    std::vector<std::weak_ptr<net::Connection>> server_connections;
+    auto acceptor = engine::AsyncNoSpan([&] {
+      for (std::size_t i = 0; i < connections; ++i) {
+        auto connection = net::Connection::Create(
+            engine::current_task::GetTaskProcessor(), config.connection_config,
+            config.handler_defaults, listener_socket.Accept(deadline), handler,
+            stats, data_accounter);
+        connection->Start();
+        server_connections.push_back(connection);
+      }
+    });
+
+    const auto request = MakeRequest(handler_type);
+    std::vector<LoadClient> clients;
+    clients.reserve(connections);
+    for (std::size_t i = 0; i < connections; ++i) {
+      clients.emplace_back(addr, request, pipeline_depth);
+    }
+    acceptor.Get();
+
+    LatencyPercentile latency;
+    std::vector<engine::TaskWithResult<void>> batches;
+    batches.reserve(connections);
+    for (auto _ : state) {
+      for (auto& client : clients) {
+        batches.push_back(engine::AsyncNoSpan(
+            [&client, &latency] { client.RunBatch(latency); }));
+      }
+      for (auto& batch : batches) batch.Get();
+      batches.clear();
+    }
+
+    // the server connections finish on the peer disconnect
+    clients.clear();
+    for (const auto& connection : server_connections) {
+      while (!connection.expired()) engine::Yield();
+    }
+
+    ReportRate(state, "rps",
+               static_cast<double>(state.iterations() * connections *
+                                   pipeline_depth));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(http_server_load)
+    ->ArgsProduct({{static_cast<int>(HandlerType::kPing),
+                    static_cast<int>(HandlerType::kJsonEcho),
+                    static_cast<int>(HandlerType::kStatic)},
+                   {1, 16},
+                   {1, 16}})
+    ->ArgNames({"handler", "connections", "pipeline"})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -9,10 +9,12 @@ namespace server::net {
 
 Listener::Listener(std::shared_ptr<EndpointInfo> endpoint_info,
                    engine::TaskProcessor& task_processor,
-                   request::ResponseDataAccounter& data_accounter)
+                   request::ResponseDataAccounter& data_accounter,
+                   ListenerShard shard)
     : task_processor_(&task_processor),
       endpoint_info_(std::move(endpoint_info)),
-      data_accounter_(&data_accounter) {}
+      data_accounter_(&data_accounter),
+      shard_(shard) {}
 
 Listener::~Listener() {
   if (!impl_) return;
@@ -24,7 +26,7 @@ Listener::~Listener() {
 
 void Listener::Start() {
   impl_ = std::make_unique<ListenerImpl>(*task_processor_, endpoint_info_,
-                                         *data_accounter_);
+                                         *data_accounter_, shard_);
 }
 
 Stats Listener::GetStats() const {
@@ -9,6 +9,25 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+RequestQueueConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<RequestQueueConfig>) {
+  RequestQueueConfig config;
+  config.codel_enabled = value["codel_enabled"].As<bool>(config.codel_enabled);
+  config.codel_interval = value["codel_interval"].As<std::chrono::milliseconds>(
+      config.codel_interval);
+  config.normal_target = value["normal_target"].As<std::chrono::milliseconds>(
+      config.normal_target);
+  config.batch_target = value["batch_target"].As<std::chrono::milliseconds>(
+      config.batch_target);
+
+  if (config.codel_interval.count() <= 0 || config.normal_target.count() <= 0 ||
+      config.batch_target.count() <= 0) {
+    throw std::runtime_error("Invalid request queue CoDel durations in " +
+                             value.GetPath());
+  }
+  return config;
+}
+
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ListenerConfig>) {
   ListenerConfig config;
@@ -21,6 +40,12 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.max_connections =
       value["max_connections"].As<size_t>(config.max_connections);
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
+  config.ev_thread_per_shard =
+      value["ev_thread_per_shard"].As<bool>(config.ev_thread_per_shard);
+  config.reuseport_cpu_bpf =
+      value["reuseport_cpu_bpf"].As<bool>(config.reuseport_cpu_bpf);
+  config.request_queue = value["request_queue"].As<RequestQueueConfig>(
+      config.request_queue);
   config.task_processor = value["task_processor"].As<std::string>();
   config.backlog = value["backlog"].As<int>(config.backlog);
 
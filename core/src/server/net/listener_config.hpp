@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 
@@ -12,6 +13,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+/// CoDel-style dropping of the requests that wait too long in the task
+/// processor queue, see server::http::RequestCodel
+struct RequestQueueConfig {
+  bool codel_enabled = false;
+  std::chrono::milliseconds codel_interval{100};
+  std::chrono::milliseconds normal_target{10};
+  std::chrono::milliseconds batch_target{5};
+};
+
+RequestQueueConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<RequestQueueConfig>);
+
 struct ListenerConfig {
   ConnectionConfig connection_config;
   request::HttpRequestConfig handler_defaults;
@@ -20,6 +33,9 @@ struct ListenerConfig {
   int backlog = 1024;  // truncated to net.core.somaxconn
   size_t max_connections = 32768;
   std::optional<size_t> shards;
+  bool ev_thread_per_shard = false;
+  bool reuseport_cpu_bpf = false;
+  RequestQueueConfig request_queue;
   std::string task_processor;
 };
 
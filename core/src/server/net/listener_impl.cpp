@@ -8,6 +8,9 @@
 #include <string>
 #include <system_error>
 
+#include <engine/ev/thread_pool.hpp>
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 #include <server/net/create_socket.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/io/exception.hpp>
@@ -17,21 +20,60 @@
 #include <userver/fs/blocking/write.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+engine::ev::ThreadControl* GetShardEvThread(
+    engine::TaskProcessor& task_processor, const ListenerConfig& config,
+    ListenerShard shard) {
+  if (!config.ev_thread_per_shard) return nullptr;
+  auto& ev_thread_pool = task_processor.EventThreadPool();
+  return &ev_thread_pool.GetThread(shard.index % ev_thread_pool.GetSize());
+}
+
+engine::io::Socket CreateShardSocket(const ListenerConfig& config,
+                                     ListenerShard shard,
+                                     engine::ev::ThreadControl* ev_thread) {
+  auto& context = engine::current_task::GetCurrentTaskContext();
+  auto* const old_ev_thread = context.GetEventThreadAffinity();
+  context.SetEventThreadAffinity(ev_thread);
+  utils::FastScopeGuard restore_ev_thread([&]() noexcept {
+    context.SetEventThreadAffinity(old_ev_thread);
+  });
+
+  auto socket = CreateSocket(config);
+  // The program is shared by the SO_REUSEPORT group, the shards join the
+  // group in the order of their indices
+  if (config.reuseport_cpu_bpf && shard.index == 0 &&
+      config.unix_socket_path.empty()) {
+    AttachReuseportCpuProgram(socket, shard.count);
+  }
+  return socket;
+}
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
-                           request::ResponseDataAccounter& data_accounter)
+                           request::ResponseDataAccounter& data_accounter,
+                           ListenerShard shard)
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
+      ev_thread_(GetShardEvThread(task_processor_,
+                                  endpoint_info_->listener_config, shard)),
       stats_(std::make_shared<Stats>()),
       data_accounter_(data_accounter),
       socket_listener_task_(engine::CriticalAsyncNoSpan(
           task_processor_,
           [this](engine::io::Socket&& request_socket) {
+            // accepted sockets are served by the ev thread of the shard
+            engine::current_task::GetCurrentTaskContext()
+                .SetEventThreadAffinity(ev_thread_);
             while (!engine::current_task::ShouldCancel()) {
               try {
                 AcceptConnection(request_socket);
@@ -46,7 +88,8 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
               }
             }
           },
-          CreateSocket(endpoint_info_->listener_config))) {}
+          CreateShardSocket(endpoint_info_->listener_config, shard,
+                            ev_thread_))) {}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
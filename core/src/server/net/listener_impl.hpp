@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <unordered_map>
 
@@ -15,13 +16,24 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::ev {
+class ThreadControl;
+}  // namespace engine::ev
+
 namespace server::net {
 
+/// Position of a listener among the SO_REUSEPORT listeners of an endpoint
+struct ListenerShard {
+  std::size_t index{0};
+  std::size_t count{1};
+};
+
 class ListenerImpl final {
  public:
   ListenerImpl(engine::TaskProcessor& task_processor,
                std::shared_ptr<EndpointInfo> endpoint_info,
-               request::ResponseDataAccounter& data_accounter);
+               request::ResponseDataAccounter& data_accounter,
+               ListenerShard shard);
   ~ListenerImpl();
 
   Stats GetStats() const;
@@ -39,6 +51,8 @@ class ListenerImpl final {
 
   engine::TaskProcessor& task_processor_;
   std::shared_ptr<EndpointInfo> endpoint_info_;
+  // the ev thread of the listening and the accepted sockets, if pinned
+  engine::ev::ThreadControl* ev_thread_;
 
   std::shared_ptr<Stats> stats_;
   request::ResponseDataAccounter& data_accounter_;
@@ -22,14 +22,47 @@ inline ParserStats& operator+=(ParserStats& lhs, const ParserStats& rhs) {
   return lhs;
 }
 
+struct Http2Stats {
+  Http2Stats(const Http2Stats& other)
+      : streams_opened(other.streams_opened.load()),
+        streams_reset(other.streams_reset.load()),
+        window_updates_received(other.window_updates_received.load()),
+        window_updates_sent(other.window_updates_sent.load()),
+        flow_control_stalls(other.flow_control_stalls.load()) {}
+
+  Http2Stats() = default;
+
+  std::atomic<size_t> streams_opened{0};
+  // streams reset by the peer
+  std::atomic<size_t> streams_reset{0};
+  std::atomic<size_t> window_updates_received{0};
+  std::atomic<size_t> window_updates_sent{0};
+  // times a response waited for the peer flow-control window
+  std::atomic<size_t> flow_control_stalls{0};
+};
+
+inline Http2Stats& operator+=(Http2Stats& lhs, const Http2Stats& rhs) {
+  lhs.streams_opened += rhs.streams_opened;
+  lhs.streams_reset += rhs.streams_reset;
+  lhs.window_updates_received += rhs.window_updates_received;
+  lhs.window_updates_sent += rhs.window_updates_sent;
+  lhs.flow_control_stalls += rhs.flow_control_stalls;
+  return lhs;
+}
+
 struct Stats {
   Stats(const Stats& other)
       : active_connections(other.active_connections.load()),
         connections_created(other.connections_created.load()),
         connections_closed(other.connections_closed.load()),
+        idle_connections(other.idle_connections.load()),
+        upgraded_connections(other.upgraded_connections.load()),
         parser_stats(other.parser_stats),
         active_request_count(other.active_request_count.load()),
-        requests_processed_count(other.requests_processed_count.load()) {}
+        requests_processed_count(other.requests_processed_count.load()),
+        bytes_sent(other.bytes_sent.load()),
+        bytes_copied(other.bytes_copied.load()),
+        http2_stats(other.http2_stats) {}
 
   Stats() = default;
 
@@ -37,21 +70,34 @@ struct Stats {
   std::atomic<size_t> active_connections{0};
   std::atomic<size_t> connections_created{0};
   std::atomic<size_t> connections_closed{0};
+  // connections that released their tasks and buffers while idle
+  std::atomic<size_t> idle_connections{0};
+  // connections switched to another protocol, e.g. WebSocket
+  std::atomic<size_t> upgraded_connections{0};
 
   // per connection
   ParserStats parser_stats;
   std::atomic<size_t> active_request_count{0};
   std::atomic<size_t> requests_processed_count{0};
+  std::atomic<size_t> bytes_sent{0};
+  // part of bytes_sent that was copied into intermediate buffers
+  std::atomic<size_t> bytes_copied{0};
+  Http2Stats http2_stats;
 };
 
 inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
   lhs.active_connections += rhs.active_connections;
   lhs.connections_created += rhs.connections_created;
   lhs.connections_closed += rhs.connections_closed;
+  lhs.idle_connections += rhs.idle_connections;
+  lhs.upgraded_connections += rhs.upgraded_connections;
 
   lhs.parser_stats += rhs.parser_stats;
   lhs.active_request_count += rhs.active_request_count;
   lhs.requests_processed_count += rhs.requests_processed_count;
+  lhs.bytes_sent += rhs.bytes_sent;
+  lhs.bytes_copied += rhs.bytes_copied;
+  lhs.http2_stats += rhs.http2_stats;
   return lhs;
 }
 
@@ -34,6 +34,14 @@ void RequestBase::SetFinishSendResponseTime() {
   AccountResponseTime();
 }
 
+void RequestBase::MarkAsCancelledByPeer() noexcept {
+  is_cancelled_by_peer_ = true;
+}
+
+bool RequestBase::IsCancelledByPeer() const noexcept {
+  return is_cancelled_by_peer_;
+}
+
 }  // namespace server::request
 
 USERVER_NAMESPACE_END
@@ -53,9 +53,21 @@ ResponseBase::~ResponseBase() noexcept = default;
 void ResponseBase::SetData(std::string data) {
   create_time_ = std::chrono::steady_clock::now();
   data_ = std::move(data);
+  shared_data_ = {};
+  shared_data_owner_.reset();
   guard_.emplace(accounter_, create_time_, data_.size());
 }
 
+void ResponseBase::SetSharedData(std::string_view data,
+                                 std::shared_ptr<const void> owner) {
+  UASSERT(owner);
+  create_time_ = std::chrono::steady_clock::now();
+  data_.clear();
+  shared_data_ = data;
+  shared_data_owner_ = std::move(owner);
+  guard_.emplace(accounter_, create_time_, shared_data_.size());
+}
+
 void ResponseBase::SetReady() { SetReady(std::chrono::steady_clock::now()); }
 
 void ResponseBase::SetReady(std::chrono::steady_clock::time_point now) {
@@ -67,14 +79,25 @@ bool ResponseBase::IsLimitReached() const {
   return accounter_.GetCurrentLevel() >= accounter_.GetMaxLevel();
 }
 
+void ResponseBase::SetUpgradeCallback(UpgradeCallback callback) {
+  upgrade_callback_ = std::move(callback);
+}
+
+void ResponseBase::SwitchProtocols(engine::io::Socket& socket) {
+  UASSERT(upgrade_callback_);
+  auto callback = std::move(upgrade_callback_);
+  callback(socket);
+}
+
 void ResponseBase::SetSendFailed(
     std::chrono::steady_clock::time_point failure_time) {
   SetSentTime(failure_time);
   SetSent(0);
 }
 
-void ResponseBase::SetSent(size_t bytes_sent) {
+void ResponseBase::SetSent(size_t bytes_sent, size_t bytes_copied) {
   bytes_sent_ = bytes_sent;
+  bytes_copied_ = bytes_copied;
   is_sent_ = true;
 }
 
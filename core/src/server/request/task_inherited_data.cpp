@@ -0,0 +1,18 @@
+#include <userver/server/request/task_inherited_data.hpp>
+
+#include <userver/engine/task/task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::request {
+
+engine::Deadline GetTaskInheritedDeadline() noexcept {
+  // clients may be used outside of coroutines, e.g. on the ev threads
+  if (!engine::current_task::GetTaskProcessorOptional()) return {};
+  const auto* const data = kTaskInheritedData.GetOptional();
+  return data ? data->deadline : engine::Deadline{};
+}
+
+}  // namespace server::request
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,30 @@
+#include <userver/server/request/task_inherited_data.hpp>
+
+#include <string>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(TaskInheritedData, GetTaskInheritedDeadline) {
+  EXPECT_FALSE(server::request::GetTaskInheritedDeadline().IsReachable());
+
+  const std::string method = "GET";
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(), deadline});
+  EXPECT_EQ(server::request::GetTaskInheritedDeadline(), deadline);
+
+  engine::AsyncNoSpan([&deadline] {
+    EXPECT_EQ(server::request::GetTaskInheritedDeadline(), deadline);
+
+    // background tasks do not inherit the deadline
+    server::request::kTaskInheritedData.Erase();
+    EXPECT_FALSE(server::request::GetTaskInheritedDeadline().IsReachable());
+  }).Get();
+
+  EXPECT_EQ(server::request::GetTaskInheritedDeadline(), deadline);
+}
+
+USERVER_NAMESPACE_END
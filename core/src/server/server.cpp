@@ -141,17 +141,19 @@ void ServerImpl::InitPortInfo(
 
   info.request_handler_ = std::make_unique<http::HttpRequestHandler>(
       component_context, config.logger_access, config.logger_access_tskv,
-      is_monitor, config.server_name);
+      is_monitor, config.server_name, listener_config.request_queue);
 
   info.endpoint_info_ = std::make_shared<net::EndpointInfo>(
       listener_config, *info.request_handler_);
 
   const auto& event_thread_pool = task_processor.EventThreadPool();
-  size_t listener_shards = listener_config.shards ? *listener_config.shards
-                                                  : event_thread_pool.GetSize();
-  while (listener_shards--) {
+  const size_t listener_shards = listener_config.shards
+                                     ? *listener_config.shards
+                                     : event_thread_pool.GetSize();
+  for (size_t shard = 0; shard < listener_shards; ++shard) {
     info.listeners_.emplace_back(info.endpoint_info_, task_processor,
-                                 info.data_accounter_);
+                                 info.data_accounter_,
+                                 net::ListenerShard{shard, listener_shards});
   }
 }
 
@@ -199,6 +201,8 @@ formats::json::Value Server::GetMonitorData(
     json_conn_stats["active"] = server_stats.active_connections.load();
     json_conn_stats["opened"] = server_stats.connections_created.load();
     json_conn_stats["closed"] = server_stats.connections_closed.load();
+    json_conn_stats["idle"] = server_stats.idle_connections.load();
+    json_conn_stats["upgraded"] = server_stats.upgraded_connections.load();
 
     json_data["connections"] = std::move(json_conn_stats);
   }
@@ -215,6 +219,28 @@ formats::json::Value Server::GetMonitorData(
 
     json_data["requests"] = std::move(json_request_stats);
   }
+  {
+    formats::json::ValueBuilder json_response_stats(
+        formats::json::Type::kObject);
+    json_response_stats["bytes-sent"] = server_stats.bytes_sent.load();
+    json_response_stats["bytes-copied"] = server_stats.bytes_copied.load();
+
+    json_data["responses"] = std::move(json_response_stats);
+  }
+  {
+    const auto& http2_stats = server_stats.http2_stats;
+    formats::json::ValueBuilder json_http2_stats(formats::json::Type::kObject);
+    json_http2_stats["streams-opened"] = http2_stats.streams_opened.load();
+    json_http2_stats["streams-reset"] = http2_stats.streams_reset.load();
+    json_http2_stats["window-updates-received"] =
+        http2_stats.window_updates_received.load();
+    json_http2_stats["window-updates-sent"] =
+        http2_stats.window_updates_sent.load();
+    json_http2_stats["flow-control-stalls"] =
+        http2_stats.flow_control_stalls.load();
+
+    json_data["http2"] = std::move(json_http2_stats);
+  }
 
   return json_data.ExtractValue();
 }
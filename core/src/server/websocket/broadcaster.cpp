@@ -0,0 +1,79 @@
+#include <userver/server/websocket/broadcaster.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+Broadcaster::Subscription::Subscription(Broadcaster& broadcaster,
+                                        WebSocketConnection& connection)
+    : broadcaster_(&broadcaster), connection_(&connection) {}
+
+Broadcaster::Subscription::Subscription(Subscription&& other) noexcept
+    : broadcaster_(std::exchange(other.broadcaster_, nullptr)),
+      connection_(std::exchange(other.connection_, nullptr)) {}
+
+Broadcaster::Subscription& Broadcaster::Subscription::operator=(
+    Subscription&& other) noexcept {
+  if (this != &other) {
+    Unsubscribe();
+    broadcaster_ = std::exchange(other.broadcaster_, nullptr);
+    connection_ = std::exchange(other.connection_, nullptr);
+  }
+  return *this;
+}
+
+Broadcaster::Subscription::~Subscription() { Unsubscribe(); }
+
+void Broadcaster::Subscription::Unsubscribe() noexcept {
+  if (!broadcaster_) return;
+  broadcaster_->Unsubscribe(*connection_);
+  broadcaster_ = nullptr;
+  connection_ = nullptr;
+}
+
+Broadcaster::~Broadcaster() {
+  UASSERT_MSG(connections_.empty(),
+              "All the subscriptions must be destroyed before the broadcaster");
+}
+
+Broadcaster::Subscription Broadcaster::Subscribe(
+    WebSocketConnection& connection) {
+  std::lock_guard lock(mutex_);
+  const bool is_inserted = connections_.insert(&connection).second;
+  UINVARIANT(is_inserted, "The connection is already subscribed");
+  return Subscription{*this, connection};
+}
+
+void Broadcaster::Unsubscribe(WebSocketConnection& connection) noexcept {
+  std::lock_guard lock(mutex_);
+  connections_.erase(&connection);
+}
+
+Broadcaster::BroadcastResult Broadcaster::Broadcast(
+    const PreparedMessage& message) {
+  BroadcastResult result;
+  std::shared_lock lock(mutex_);
+  for (auto* connection : connections_) {
+    if (connection->TrySend(message)) {
+      ++result.sent;
+    } else {
+      ++result.dropped;
+    }
+  }
+  return result;
+}
+
+std::size_t Broadcaster::GetSubscribersCount() const {
+  std::shared_lock lock(mutex_);
+  return connections_.size();
+}
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,309 @@
+#include <server/websocket/protocol.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <userver/crypto/hash.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::uint8_t kFinBit = 0x80;
+constexpr std::uint8_t kRsv1Bit = 0x40;
+constexpr std::uint8_t kRsv23Bits = 0x30;
+constexpr std::uint8_t kOpcodeBits = 0x0F;
+constexpr std::uint8_t kMaskBit = 0x80;
+constexpr std::uint8_t kLengthBits = 0x7F;
+
+constexpr std::uint8_t kLength16 = 126;
+constexpr std::uint8_t kLength64 = 127;
+
+// RFC 6455 section 1.3
+constexpr std::string_view kAcceptKeyGuid =
+    "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+constexpr std::string_view kDeflateExtension = "permessage-deflate";
+constexpr std::string_view kDeflateTail{"\x00\x00\xff\xff", 4};
+
+// 15 bits of window, negative for the raw deflate without the zlib header
+constexpr int kRawWindowBits = -15;
+constexpr int kMemLevel = 8;
+// the messages are compressed once for all the connections, the speed matters
+// more than the ratio
+constexpr int kCompressionLevel = Z_BEST_SPEED;
+constexpr std::size_t kInflateChunkSize = 16 * 1024;
+constexpr std::size_t kSyncFlushMaxSize = 16;
+
+// smaller messages barely shrink and cost a deflate stream each
+constexpr std::size_t kMinCompressSize = 64;
+
+std::uint64_t ReadBigEndian(std::string_view data) noexcept {
+  std::uint64_t result = 0;
+  for (const char c : data) {
+    result = (result << 8) | static_cast<std::uint8_t>(c);
+  }
+  return result;
+}
+
+void AppendBigEndian(std::string& out, std::uint64_t value, int bytes) {
+  for (int i = bytes - 1; i >= 0; --i) {
+    out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+std::string_view Trim(std::string_view s) noexcept {
+  const auto is_space = [](char c) { return c == ' ' || c == '\t'; };
+  while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+  while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
+  return s;
+}
+
+// Splits off the part before `delimiter`, leaves the rest in `s`
+std::string_view CutToken(std::string_view& s, char delimiter) noexcept {
+  const auto pos = s.find(delimiter);
+  const auto token = s.substr(0, pos);
+  s = (pos == std::string_view::npos) ? std::string_view{} : s.substr(pos + 1);
+  return Trim(token);
+}
+
+std::optional<DeflateParams> ParseDeflateOffer(std::string_view offer) {
+  if (CutToken(offer, ';') != kDeflateExtension) return std::nullopt;
+
+  DeflateParams params;
+  while (!offer.empty()) {
+    auto value = CutToken(offer, ';');
+    const auto name = CutToken(value, '=');
+    value = Trim(value);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+      value = value.substr(1, value.size() - 2);
+    }
+
+    if (name == "server_no_context_takeover") {
+      // the server resets the context anyway
+    } else if (name == "client_no_context_takeover") {
+      params.client_no_context_takeover = true;
+    } else if (name == "server_max_window_bits") {
+      // the shared frames are compressed with the full window
+      if (value != "15") return std::nullopt;
+    } else if (name == "client_max_window_bits") {
+      // the server does not limit the client window
+    } else {
+      return std::nullopt;
+    }
+  }
+  return params;
+}
+
+}  // namespace
+
+std::size_t ParseFrameHeader(std::string_view data, FrameHeader& header) {
+  if (data.size() < 2) return 0;
+
+  const auto first = static_cast<std::uint8_t>(data[0]);
+  const auto second = static_cast<std::uint8_t>(data[1]);
+  header.is_final = first & kFinBit;
+  header.is_compressed = first & kRsv1Bit;
+  header.has_reserved_bits = first & kRsv23Bits;
+  header.opcode = static_cast<Opcode>(first & kOpcodeBits);
+  header.is_masked = second & kMaskBit;
+
+  const std::uint8_t length = second & kLengthBits;
+  std::size_t length_size = 0;
+  if (length == kLength16) {
+    length_size = 2;
+  } else if (length == kLength64) {
+    length_size = 8;
+  }
+
+  const std::size_t header_size =
+      2 + length_size + (header.is_masked ? header.mask.size() : 0);
+  if (data.size() < header_size) return 0;
+
+  header.payload_size =
+      length_size ? ReadBigEndian(data.substr(2, length_size)) : length;
+  if (header.is_masked) {
+    std::copy_n(data.data() + 2 + length_size, header.mask.size(),
+                header.mask.begin());
+  }
+  return header_size;
+}
+
+void AppendFrameHeader(std::string& out, Opcode opcode,
+                       std::size_t payload_size, bool is_compressed) {
+  out.push_back(static_cast<char>(kFinBit | (is_compressed ? kRsv1Bit : 0) |
+                                  static_cast<std::uint8_t>(opcode)));
+  if (payload_size < kLength16) {
+    out.push_back(static_cast<char>(payload_size));
+  } else if (payload_size <= 0xFFFF) {
+    out.push_back(static_cast<char>(kLength16));
+    AppendBigEndian(out, payload_size, 2);
+  } else {
+    out.push_back(static_cast<char>(kLength64));
+    AppendBigEndian(out, payload_size, 8);
+  }
+}
+
+std::string MakeFrame(Opcode opcode, std::string_view payload,
+                      bool is_compressed) {
+  // 10 bytes is the longest header without a mask
+  std::string frame;
+  frame.reserve(10 + payload.size());
+  AppendFrameHeader(frame, opcode, payload.size(), is_compressed);
+  frame.append(payload);
+  return frame;
+}
+
+std::string MakeCloseFrame(std::uint16_t status) {
+  std::string payload;
+  AppendBigEndian(payload, status, 2);
+  return MakeFrame(Opcode::kClose, payload);
+}
+
+void Unmask(char* data, std::size_t size, const std::array<char, 4>& mask,
+            std::size_t offset) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] ^= mask[(offset + i) % mask.size()];
+  }
+}
+
+bool IsValidCloseStatus(std::uint16_t status) noexcept {
+  // RFC 6455 section 7.4 and the IANA registry, 1004-1006 and 1015 are
+  // reserved for the local use
+  return (status >= 1000 && status <= 1003) ||
+         (status >= 1007 && status <= 1014) ||
+         (status >= 3000 && status <= 4999);
+}
+
+std::string MakeAcceptKey(std::string_view key) {
+  std::string data;
+  data.reserve(key.size() + kAcceptKeyGuid.size());
+  data.append(key).append(kAcceptKeyGuid);
+  return crypto::hash::Sha1(data, crypto::hash::OutputEncoding::kBase64);
+}
+
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions) {
+  while (!extensions.empty()) {
+    auto params = ParseDeflateOffer(CutToken(extensions, ','));
+    if (params) return params;
+  }
+  return std::nullopt;
+}
+
+std::string FormatDeflateResponse(const DeflateParams& params) {
+  std::string result{kDeflateExtension};
+  result.append("; server_no_context_takeover");
+  if (params.client_no_context_takeover) {
+    result.append("; client_no_context_takeover");
+  }
+  return result;
+}
+
+std::string Deflate(std::string_view data) {
+  z_stream stream{};
+  if (deflateInit2(&stream, kCompressionLevel, Z_DEFLATED, kRawWindowBits,
+                   kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("failed to initialize deflate compressor");
+  }
+
+  std::string result;
+  // the bound does not cover the sync flush marker
+  result.resize(deflateBound(&stream, data.size()) + kSyncFlushMaxSize);
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(result.data());
+  stream.avail_out = result.size();
+  const int ret = deflate(&stream, Z_SYNC_FLUSH);
+  const auto size = result.size() - stream.avail_out;
+  deflateEnd(&stream);
+
+  if (ret != Z_OK || stream.avail_in != 0) {
+    throw std::runtime_error("failed to compress data with deflate");
+  }
+  UASSERT(size >= kDeflateTail.size() &&
+          std::string_view(result.data() + size - kDeflateTail.size(),
+                           kDeflateTail.size()) == kDeflateTail);
+  result.resize(size - kDeflateTail.size());
+  return result;
+}
+
+Inflater::Inflater() {
+  if (inflateInit2(&stream_, kRawWindowBits) != Z_OK) {
+    throw std::runtime_error("failed to initialize deflate decompressor");
+  }
+}
+
+Inflater::~Inflater() { inflateEnd(&stream_); }
+
+void Inflater::Inflate(std::string_view compressed, std::size_t max_size,
+                       std::string& out) {
+  for (const auto data : {compressed, kDeflateTail}) {
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream_.avail_in = data.size();
+
+    do {
+      // one extra byte to detect the overflow
+      const auto chunk_size =
+          std::min(kInflateChunkSize, max_size + 1 - out.size());
+      const auto offset = out.size();
+      out.resize(offset + chunk_size);
+      stream_.next_out = reinterpret_cast<Bytef*>(out.data() + offset);
+      stream_.avail_out = chunk_size;
+
+      const int ret = inflate(&stream_, Z_SYNC_FLUSH);
+      out.resize(offset + chunk_size - stream_.avail_out);
+      if (out.size() > max_size) throw compression::TooBigError();
+
+      if (ret == Z_STREAM_END) {
+        // the peer has ended the stream with a final block
+        inflateReset(&stream_);
+        break;
+      }
+      if (ret == Z_BUF_ERROR) break;
+      if (ret != Z_OK) {
+        throw compression::DecompressionError(
+            "failed to decompress permessage-deflate data");
+      }
+    } while (stream_.avail_in > 0 || stream_.avail_out == 0);
+  }
+}
+
+PreparedFrames::PreparedFrames(Opcode opcode, std::string_view payload)
+    : opcode_(opcode),
+      payload_size_(payload.size()),
+      frame_(std::make_shared<const std::string>(MakeFrame(opcode, payload))) {
+  UASSERT(opcode == Opcode::kText || opcode == Opcode::kBinary);
+  if (payload_size_ < kMinCompressSize) compressed_frame_ = frame_;
+}
+
+std::shared_ptr<const std::string> PreparedFrames::GetFrame(
+    bool is_deflate_enabled) const {
+  if (!is_deflate_enabled) return frame_;
+
+  auto compressed = std::atomic_load(&compressed_frame_);
+  if (compressed) return compressed;
+
+  // concurrent senders may compress the message twice, one result is kept
+  auto made = MakeCompressedFrame();
+  if (!std::atomic_compare_exchange_strong(&compressed_frame_, &compressed,
+                                           made)) {
+    return compressed;
+  }
+  return made;
+}
+
+std::shared_ptr<const std::string> PreparedFrames::MakeCompressedFrame() const {
+  const auto payload = std::string_view{*frame_}.substr(frame_->size() -
+                                                         payload_size_);
+  const auto compressed = Deflate(payload);
+  if (compressed.size() >= payload.size()) return frame_;
+  return std::make_shared<const std::string>(
+      MakeFrame(opcode_, compressed, /*is_compressed*/ true));
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
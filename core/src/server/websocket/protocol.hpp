@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+/// Frame opcodes of RFC 6455 section 5.2
+enum class Opcode : std::uint8_t {
+  kContinuation = 0x0,
+  kText = 0x1,
+  kBinary = 0x2,
+  kClose = 0x8,
+  kPing = 0x9,
+  kPong = 0xA,
+};
+
+inline constexpr std::size_t kMaxControlPayloadSize = 125;
+
+constexpr bool IsControl(Opcode opcode) noexcept {
+  return static_cast<std::uint8_t>(opcode) & 0x8;
+}
+
+struct FrameHeader {
+  Opcode opcode{Opcode::kContinuation};
+  bool is_final{false};
+  /// RSV1, marks the first frame of a permessage-deflate compressed message
+  bool is_compressed{false};
+  /// RSV2 or RSV3, no negotiated extension defines them
+  bool has_reserved_bits{false};
+  bool is_masked{false};
+  std::uint64_t payload_size{0};
+  std::array<char, 4> mask{};
+};
+
+/// Parses a frame header from the beginning of `data`. Returns the header
+/// size or 0 if `data` holds only a part of the header.
+std::size_t ParseFrameHeader(std::string_view data, FrameHeader& header);
+
+/// Appends the header of an unmasked server frame
+void AppendFrameHeader(std::string& out, Opcode opcode,
+                       std::size_t payload_size, bool is_compressed = false);
+
+/// Makes a final unmasked frame
+std::string MakeFrame(Opcode opcode, std::string_view payload,
+                      bool is_compressed = false);
+
+/// Makes a close frame with the status code and no reason
+std::string MakeCloseFrame(std::uint16_t status);
+
+/// Applies the client mask to the bytes that go at `offset` of the payload
+void Unmask(char* data, std::size_t size, const std::array<char, 4>& mask,
+            std::size_t offset = 0) noexcept;
+
+/// Whether a peer may send the status code in a close frame
+bool IsValidCloseStatus(std::uint16_t status) noexcept;
+
+/// Computes the Sec-WebSocket-Accept value for a Sec-WebSocket-Key
+std::string MakeAcceptKey(std::string_view key);
+
+/// Negotiated permessage-deflate parameters of RFC 7692
+struct DeflateParams {
+  bool client_no_context_takeover{false};
+};
+
+/// Picks the first acceptable permessage-deflate offer from the
+/// Sec-WebSocket-Extensions header of the client.
+///
+/// The server always compresses each message on its own, as a shared frame
+/// can not depend on the previous messages of a connection, so the offers
+/// that limit the server window are declined.
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions);
+
+/// Formats the Sec-WebSocket-Extensions response for the accepted offer
+std::string FormatDeflateResponse(const DeflateParams& params);
+
+/// Compresses a whole message with a fresh raw deflate stream, the output
+/// lacks the trailing 0x00 0x00 0xff 0xff as RFC 7692 requires
+std::string Deflate(std::string_view data);
+
+/// Decompresses the messages of a connection, which may refer to the data of
+/// the previous messages
+class Inflater final {
+ public:
+  Inflater();
+  ~Inflater();
+
+  Inflater(Inflater&&) = delete;
+  Inflater& operator=(Inflater&&) = delete;
+
+  /// Decompresses a message payload into `out`.
+  /// @throws compression::TooBigError if the result exceeds `max_size`
+  /// @throws compression::DecompressionError on malformed data
+  void Inflate(std::string_view compressed, std::size_t max_size,
+               std::string& out);
+
+ private:
+  z_stream stream_{};
+};
+
+/// A message framed once. Sending it to a connection queues a reference to
+/// one of the frames, never a copy.
+class PreparedFrames final {
+ public:
+  PreparedFrames(Opcode opcode, std::string_view payload);
+
+  /// Returns the frame to send to a connection, compresses the payload on
+  /// the first request for the permessage-deflate variant
+  std::shared_ptr<const std::string> GetFrame(bool is_deflate_enabled) const;
+
+  std::size_t GetPayloadSize() const noexcept { return payload_size_; }
+
+ private:
+  std::shared_ptr<const std::string> MakeCompressedFrame() const;
+
+  const Opcode opcode_;
+  const std::size_t payload_size_;
+  const std::shared_ptr<const std::string> frame_;
+  // published with the atomic shared_ptr functions
+  mutable std::shared_ptr<const std::string> compressed_frame_;
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
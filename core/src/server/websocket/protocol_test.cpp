@@ -0,0 +1,152 @@
+#include <server/websocket/protocol.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+TEST(WebsocketProtocol, AcceptKey) {
+  // RFC 6455 section 1.3
+  EXPECT_EQ(MakeAcceptKey("dGhlIHNhbXBsZSBub25jZQ=="),
+            "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WebsocketProtocol, FrameHeader) {
+  for (const std::size_t size : {0, 5, 125, 126, 200, 65535, 65536, 70000}) {
+    const std::string payload(size, 'x');
+    const auto frame = MakeFrame(Opcode::kBinary, payload);
+
+    FrameHeader header;
+    const auto header_size = ParseFrameHeader(frame, header);
+    ASSERT_NE(header_size, 0) << size;
+    EXPECT_EQ(header_size + size, frame.size());
+    EXPECT_EQ(header.opcode, Opcode::kBinary);
+    EXPECT_TRUE(header.is_final);
+    EXPECT_FALSE(header.is_compressed);
+    EXPECT_FALSE(header.is_masked);
+    EXPECT_EQ(header.payload_size, size);
+
+    // a part of the header is not enough
+    EXPECT_EQ(ParseFrameHeader(std::string_view{frame}.substr(
+                                   0, header_size - 1),
+                               header),
+              0);
+  }
+}
+
+TEST(WebsocketProtocol, MaskedFrame) {
+  // RFC 6455 section 5.7, a masked "Hello"
+  const std::string frame{"\x81\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58", 11};
+
+  FrameHeader header;
+  const auto header_size = ParseFrameHeader(frame, header);
+  ASSERT_EQ(header_size, 6);
+  EXPECT_EQ(header.opcode, Opcode::kText);
+  EXPECT_TRUE(header.is_masked);
+  EXPECT_EQ(header.payload_size, 5);
+
+  auto payload = frame.substr(header_size);
+  Unmask(payload.data(), 2, header.mask);
+  Unmask(payload.data() + 2, 3, header.mask, 2);
+  EXPECT_EQ(payload, "Hello");
+}
+
+TEST(WebsocketProtocol, CloseFrame) {
+  EXPECT_EQ(MakeCloseFrame(1000), std::string("\x88\x02\x03\xe8", 4));
+  EXPECT_TRUE(IsValidCloseStatus(1000));
+  EXPECT_TRUE(IsValidCloseStatus(4000));
+  EXPECT_FALSE(IsValidCloseStatus(1005));
+  EXPECT_FALSE(IsValidCloseStatus(999));
+  EXPECT_FALSE(IsValidCloseStatus(5000));
+}
+
+TEST(WebsocketProtocol, NegotiateDeflate) {
+  EXPECT_FALSE(NegotiateDeflate(""));
+  EXPECT_FALSE(NegotiateDeflate("x-webkit-deflate-frame"));
+  EXPECT_FALSE(
+      NegotiateDeflate("permessage-deflate; server_max_window_bits=10"));
+  EXPECT_FALSE(NegotiateDeflate("permessage-deflate; unknown"));
+
+  auto params = NegotiateDeflate("permessage-deflate; client_max_window_bits");
+  ASSERT_TRUE(params);
+  EXPECT_FALSE(params->client_no_context_takeover);
+  EXPECT_EQ(FormatDeflateResponse(*params),
+            "permessage-deflate; server_no_context_takeover");
+
+  params = NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=10, "
+      "permessage-deflate;client_no_context_takeover;"
+      "server_max_window_bits=\"15\"");
+  ASSERT_TRUE(params);
+  EXPECT_TRUE(params->client_no_context_takeover);
+  EXPECT_EQ(FormatDeflateResponse(*params),
+            "permessage-deflate; server_no_context_takeover; "
+            "client_no_context_takeover");
+}
+
+TEST(WebsocketProtocol, Inflate) {
+  Inflater inflater;
+  std::string out;
+
+  // RFC 7692 section 7.2.3.1, "Hello" compressed
+  const std::string hello{"\xf2\x48\xcd\xc9\xc9\x07\x00", 7};
+  inflater.Inflate(hello, 100, out);
+  EXPECT_EQ(out, "Hello");
+
+  // the second message refers to the first one
+  out.clear();
+  inflater.Inflate(std::string{"\xf2\x00\x11\x00\x00", 5}, 100, out);
+  EXPECT_EQ(out, "Hello");
+
+  out.clear();
+  EXPECT_THROW(inflater.Inflate(Deflate(std::string(1000, 'a')), 999, out),
+               compression::TooBigError);
+
+  Inflater broken;
+  out.clear();
+  EXPECT_THROW(broken.Inflate("\xff\xff\xff", 100, out),
+               compression::DecompressionError);
+}
+
+TEST(WebsocketProtocol, DeflateRoundtrip) {
+  const std::string data(10000, 'a');
+  const auto compressed = Deflate(data);
+  EXPECT_LT(compressed.size(), data.size());
+
+  Inflater inflater;
+  std::string out;
+  inflater.Inflate(compressed, data.size(), out);
+  EXPECT_EQ(out, data);
+
+  // each message is compressed on its own
+  EXPECT_EQ(Deflate(data), compressed);
+}
+
+TEST(WebsocketProtocol, PreparedFrames) {
+  const PreparedFrames small{Opcode::kText, "Hello"};
+  EXPECT_EQ(small.GetFrame(false), small.GetFrame(true));
+  EXPECT_EQ(*small.GetFrame(false), "\x81\x05Hello");
+
+  const std::string data(1000, 'a');
+  const PreparedFrames big{Opcode::kBinary, data};
+  const auto frame = big.GetFrame(false);
+  const auto compressed = big.GetFrame(true);
+  EXPECT_EQ(*frame, MakeFrame(Opcode::kBinary, data));
+  EXPECT_EQ(compressed, big.GetFrame(true));
+
+  FrameHeader header;
+  const auto header_size = ParseFrameHeader(*compressed, header);
+  EXPECT_TRUE(header.is_compressed);
+  EXPECT_EQ(header.opcode, Opcode::kBinary);
+
+  Inflater inflater;
+  std::string out;
+  inflater.Inflate(std::string_view{*compressed}.substr(header_size),
+                   data.size(), out);
+  EXPECT_EQ(out, data);
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
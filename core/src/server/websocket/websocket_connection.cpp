@@ -0,0 +1,478 @@
+#include <userver/server/websocket/websocket_connection.hpp>
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text.hpp>
+
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 16 * 1024;
+
+// IOV_MAX is at least 1024, each frame is a single buffer
+constexpr std::size_t kMaxBatchFrames = 64;
+
+constexpr std::chrono::seconds kCloseFlushTimeout{1};
+
+bool IsKnownDataOpcode(impl::Opcode opcode) noexcept {
+  return opcode == impl::Opcode::kContinuation ||
+         opcode == impl::Opcode::kText || opcode == impl::Opcode::kBinary;
+}
+
+bool IsKnownControlOpcode(impl::Opcode opcode) noexcept {
+  return opcode == impl::Opcode::kClose || opcode == impl::Opcode::kPing ||
+         opcode == impl::Opcode::kPong;
+}
+
+}  // namespace
+
+PreparedMessage::PreparedMessage(
+    std::shared_ptr<const impl::PreparedFrames> frames)
+    : frames_(std::move(frames)) {}
+
+PreparedMessage PreparedMessage::Text(std::string_view data) {
+  return PreparedMessage{
+      std::make_shared<const impl::PreparedFrames>(impl::Opcode::kText, data)};
+}
+
+PreparedMessage PreparedMessage::Binary(std::string_view data) {
+  return PreparedMessage{std::make_shared<const impl::PreparedFrames>(
+      impl::Opcode::kBinary, data)};
+}
+
+std::size_t PreparedMessage::GetPayloadSize() const noexcept {
+  return frames_->GetPayloadSize();
+}
+
+class WebSocketConnection::Impl final {
+ public:
+  Impl(engine::io::Socket& socket, const impl::ConnectionConfig& config);
+  ~Impl();
+
+  void Recv(Message& message);
+
+  bool Send(const PreparedMessage& message, bool wait);
+
+  void Close(CloseStatus status);
+
+  bool IsClosing() const;
+
+  std::size_t GetSendQueueSize() const;
+
+  const engine::io::Sockaddr& RemoteAddr() const noexcept {
+    return remote_addr_;
+  }
+
+ private:
+  struct QueuedFrame {
+    std::shared_ptr<const std::string> data;
+    bool is_control{false};
+    bool is_close{false};
+  };
+
+  bool Enqueue(QueuedFrame frame, bool wait);
+  void SendControl(impl::Opcode opcode, std::string_view payload);
+
+  void WriterLoop();
+
+  // Reads at least `size` bytes into the buffer, returns false on EOF
+  bool Fill(std::size_t size);
+  std::string_view Buffered() const noexcept;
+  void Consume(std::size_t size) noexcept;
+
+  bool ReadHeader(impl::FrameHeader& header);
+  bool ReadPayload(const impl::FrameHeader& header, std::string& out);
+
+  void Fail(Message& message, CloseStatus status);
+
+  engine::io::Socket& socket_;
+  const impl::ConnectionConfig config_;
+  const engine::io::Sockaddr remote_addr_;
+
+  // reader state, accessed by the Recv() caller only
+  std::string read_buffer_;
+  std::size_t read_pos_{0};
+  std::string compressed_payload_;
+  std::unique_ptr<impl::Inflater> inflater_;
+  std::optional<CloseStatus> close_status_;
+  std::string close_reason_;
+
+  // writer state
+  mutable engine::Mutex mutex_;
+  engine::ConditionVariable queue_cv_;
+  engine::ConditionVariable space_cv_;
+  std::deque<QueuedFrame> queue_;
+  std::size_t queued_messages_{0};
+  bool is_close_queued_{false};
+  bool is_stopped_{false};
+  engine::TaskWithResult<void> writer_;
+};
+
+WebSocketConnection::Impl::Impl(engine::io::Socket& socket,
+                                const impl::ConnectionConfig& config)
+    : socket_(socket), config_(config), remote_addr_(socket.Getpeername()) {
+  if (config_.is_deflate_enabled) {
+    inflater_ = std::make_unique<impl::Inflater>();
+  }
+  // the writer must flush the close frame even under load
+  writer_ = engine::CriticalAsyncNoSpan([this] { WriterLoop(); });
+}
+
+WebSocketConnection::Impl::~Impl() {
+  {
+    std::lock_guard lock(mutex_);
+    is_stopped_ = true;
+  }
+  queue_cv_.NotifyAll();
+  space_cv_.NotifyAll();
+
+  // the close frame is sent even if the connection is being cancelled
+  engine::TaskCancellationBlocker block_cancel;
+  writer_.WaitFor(kCloseFlushTimeout);
+  if (!writer_.IsFinished()) {
+    LOG_DEBUG() << "WebSocket client " << remote_addr_
+                << " does not read, dropping the queued frames";
+    writer_.SyncCancel();
+  }
+}
+
+bool WebSocketConnection::Impl::Enqueue(QueuedFrame frame, bool wait) {
+  std::unique_lock lock(mutex_);
+  if (!frame.is_control) {
+    if (wait) {
+      [[maybe_unused]] const bool has_space = space_cv_.Wait(lock, [this] {
+        return is_close_queued_ ||
+               queued_messages_ < config_.max_send_queue_size;
+      });
+    }
+    if (queued_messages_ >= config_.max_send_queue_size) return false;
+  }
+  if (is_close_queued_) return false;
+
+  if (!frame.is_control) ++queued_messages_;
+  if (frame.is_close) is_close_queued_ = true;
+  queue_.push_back(std::move(frame));
+  lock.unlock();
+
+  queue_cv_.NotifyOne();
+  return true;
+}
+
+bool WebSocketConnection::Impl::Send(const PreparedMessage& message,
+                                     bool wait) {
+  return Enqueue(
+      {message.GetFrames().GetFrame(config_.is_deflate_enabled), false, false},
+      wait);
+}
+
+void WebSocketConnection::Impl::SendControl(impl::Opcode opcode,
+                                            std::string_view payload) {
+  UASSERT(payload.size() <= impl::kMaxControlPayloadSize);
+  [[maybe_unused]] const bool is_queued = Enqueue(
+      {std::make_shared<const std::string>(impl::MakeFrame(opcode, payload)),
+       true, opcode == impl::Opcode::kClose},
+      false);
+}
+
+void WebSocketConnection::Impl::Close(CloseStatus status) {
+  [[maybe_unused]] const bool is_queued =
+      Enqueue({std::make_shared<const std::string>(
+                   impl::MakeCloseFrame(static_cast<std::uint16_t>(status))),
+               true, true},
+              false);
+}
+
+bool WebSocketConnection::Impl::IsClosing() const {
+  std::lock_guard lock(mutex_);
+  return is_close_queued_;
+}
+
+std::size_t WebSocketConnection::Impl::GetSendQueueSize() const {
+  std::lock_guard lock(mutex_);
+  return queued_messages_;
+}
+
+void WebSocketConnection::Impl::WriterLoop() {
+  std::vector<QueuedFrame> batch;
+  std::vector<engine::io::IoData> buffers;
+  batch.reserve(kMaxBatchFrames);
+  buffers.reserve(kMaxBatchFrames);
+
+  try {
+    while (true) {
+      {
+        std::unique_lock lock(mutex_);
+        const bool is_ready = queue_cv_.Wait(
+            lock, [this] { return !queue_.empty() || is_stopped_; });
+        if (!is_ready) return;
+        if (queue_.empty()) return;
+
+        while (!queue_.empty() && batch.size() < kMaxBatchFrames) {
+          if (!queue_.front().is_control) --queued_messages_;
+          batch.push_back(std::move(queue_.front()));
+          queue_.pop_front();
+        }
+      }
+      space_cv_.NotifyAll();
+
+      for (const auto& frame : batch) {
+        buffers.push_back({frame.data->data(), frame.data->size()});
+      }
+      [[maybe_unused]] const auto sent =
+          socket_.SendAll(buffers.data(), buffers.size(), engine::Deadline{});
+
+      // nothing is queued after the close frame
+      if (batch.back().is_close) return;
+      batch.clear();
+      buffers.clear();
+    }
+  } catch (const std::exception& ex) {
+    LOG_DEBUG() << "Failed to send to WebSocket client " << remote_addr_
+                << ": " << ex;
+  }
+
+  {
+    std::lock_guard lock(mutex_);
+    is_close_queued_ = true;
+    queued_messages_ = 0;
+    queue_.clear();
+  }
+  space_cv_.NotifyAll();
+}
+
+std::string_view WebSocketConnection::Impl::Buffered() const noexcept {
+  return std::string_view{read_buffer_}.substr(read_pos_);
+}
+
+void WebSocketConnection::Impl::Consume(std::size_t size) noexcept {
+  UASSERT(size <= Buffered().size());
+  read_pos_ += size;
+}
+
+bool WebSocketConnection::Impl::Fill(std::size_t size) {
+  if (Buffered().size() >= size) return true;
+
+  read_buffer_.erase(0, read_pos_);
+  read_pos_ = 0;
+  while (read_buffer_.size() < size) {
+    const auto offset = read_buffer_.size();
+    read_buffer_.resize(offset + std::max(kReadChunkSize, size - offset));
+    const auto received = socket_.RecvSome(
+        read_buffer_.data() + offset, read_buffer_.size() - offset,
+        engine::Deadline{});
+    read_buffer_.resize(offset + received);
+    if (!received) return false;
+  }
+  return true;
+}
+
+bool WebSocketConnection::Impl::ReadHeader(impl::FrameHeader& header) {
+  // the headers are 2 to 14 bytes long
+  for (std::size_t size = 2;; ++size) {
+    if (!Fill(size)) return false;
+    const auto header_size = impl::ParseFrameHeader(Buffered(), header);
+    if (header_size) {
+      Consume(header_size);
+      return true;
+    }
+  }
+}
+
+bool WebSocketConnection::Impl::ReadPayload(const impl::FrameHeader& header,
+                                            std::string& out) {
+  auto left = static_cast<std::size_t>(header.payload_size);
+  std::size_t offset = 0;
+  while (left) {
+    if (Buffered().empty() && !Fill(1)) return false;
+    const auto chunk = Buffered().substr(0, left);
+    const auto out_offset = out.size();
+    out.append(chunk);
+    impl::Unmask(out.data() + out_offset, chunk.size(), header.mask, offset);
+    Consume(chunk.size());
+    offset += chunk.size();
+    left -= chunk.size();
+  }
+  return true;
+}
+
+void WebSocketConnection::Impl::Fail(Message& message, CloseStatus status) {
+  if (status != CloseStatus::kAbnormalClosure) Close(status);
+  close_status_ = status;
+  close_reason_.clear();
+  message.data.clear();
+  message.close_status = status;
+}
+
+void WebSocketConnection::Impl::Recv(Message& message) {
+  message.data.clear();
+  message.is_text = false;
+  message.close_status.reset();
+  if (close_status_) {
+    message.data = close_reason_;
+    message.close_status = close_status_;
+    return;
+  }
+
+  std::optional<impl::Opcode> message_opcode;
+  bool is_compressed = false;
+  std::string control_payload;
+
+  while (true) {
+    impl::FrameHeader header;
+    if (!ReadHeader(header)) {
+      return Fail(message, CloseStatus::kAbnormalClosure);
+    }
+
+    // RFC 6455 section 5.1, the client frames are always masked
+    if (!header.is_masked || header.has_reserved_bits) {
+      return Fail(message, CloseStatus::kProtocolError);
+    }
+
+    if (impl::IsControl(header.opcode)) {
+      if (!IsKnownControlOpcode(header.opcode) || !header.is_final ||
+          header.is_compressed ||
+          header.payload_size > impl::kMaxControlPayloadSize) {
+        return Fail(message, CloseStatus::kProtocolError);
+      }
+
+      control_payload.clear();
+      if (!ReadPayload(header, control_payload)) {
+        return Fail(message, CloseStatus::kAbnormalClosure);
+      }
+
+      if (header.opcode == impl::Opcode::kPing) {
+        SendControl(impl::Opcode::kPong, control_payload);
+        continue;
+      }
+      if (header.opcode == impl::Opcode::kPong) continue;
+
+      // close frame
+      auto status = CloseStatus::kNoStatusReceived;
+      if (!control_payload.empty()) {
+        if (control_payload.size() < 2) {
+          return Fail(message, CloseStatus::kProtocolError);
+        }
+        const auto code = static_cast<std::uint16_t>(
+            static_cast<std::uint8_t>(control_payload[0]) << 8 |
+            static_cast<std::uint8_t>(control_payload[1]));
+        if (!impl::IsValidCloseStatus(code)) {
+          return Fail(message, CloseStatus::kProtocolError);
+        }
+        status = static_cast<CloseStatus>(code);
+        close_reason_ = control_payload.substr(2);
+        if (!utils::text::IsUtf8(close_reason_)) {
+          return Fail(message, CloseStatus::kInvalidPayload);
+        }
+      }
+
+      // echo the status as RFC 6455 section 5.5.1 recommends
+      if (status == CloseStatus::kNoStatusReceived) {
+        SendControl(impl::Opcode::kClose, {});
+      } else {
+        SendControl(impl::Opcode::kClose, control_payload.substr(0, 2));
+      }
+      close_status_ = status;
+      message.data = close_reason_;
+      message.close_status = status;
+      return;
+    }
+
+    if (!IsKnownDataOpcode(header.opcode)) {
+      return Fail(message, CloseStatus::kProtocolError);
+    }
+    if (header.opcode == impl::Opcode::kContinuation) {
+      if (!message_opcode || header.is_compressed) {
+        return Fail(message, CloseStatus::kProtocolError);
+      }
+    } else {
+      if (message_opcode || (header.is_compressed && !inflater_)) {
+        return Fail(message, CloseStatus::kProtocolError);
+      }
+      message_opcode = header.opcode;
+      is_compressed = header.is_compressed;
+      compressed_payload_.clear();
+    }
+
+    auto& payload = is_compressed ? compressed_payload_ : message.data;
+    if (header.payload_size > config_.max_message_size - payload.size()) {
+      return Fail(message, CloseStatus::kMessageTooBig);
+    }
+    if (!ReadPayload(header, payload)) {
+      return Fail(message, CloseStatus::kAbnormalClosure);
+    }
+    if (!header.is_final) continue;
+
+    if (is_compressed) {
+      try {
+        inflater_->Inflate(compressed_payload_, config_.max_message_size,
+                           message.data);
+      } catch (const compression::TooBigError&) {
+        return Fail(message, CloseStatus::kMessageTooBig);
+      } catch (const compression::DecompressionError&) {
+        return Fail(message, CloseStatus::kInvalidPayload);
+      }
+    }
+
+    message.is_text = (message_opcode == impl::Opcode::kText);
+    if (message.is_text && !utils::text::IsUtf8(message.data)) {
+      return Fail(message, CloseStatus::kInvalidPayload);
+    }
+    return;
+  }
+}
+
+WebSocketConnection::WebSocketConnection(engine::io::Socket& socket,
+                                         const impl::ConnectionConfig& config)
+    : impl_(std::make_unique<Impl>(socket, config)) {}
+
+WebSocketConnection::~WebSocketConnection() = default;
+
+void WebSocketConnection::Recv(Message& message) { impl_->Recv(message); }
+
+void WebSocketConnection::Send(const PreparedMessage& message) {
+  [[maybe_unused]] const bool is_queued = impl_->Send(message, true);
+}
+
+bool WebSocketConnection::TrySend(const PreparedMessage& message) {
+  return impl_->Send(message, false);
+}
+
+void WebSocketConnection::SendText(std::string_view data) {
+  Send(PreparedMessage::Text(data));
+}
+
+void WebSocketConnection::SendBinary(std::string_view data) {
+  Send(PreparedMessage::Binary(data));
+}
+
+void WebSocketConnection::Close(CloseStatus status) { impl_->Close(status); }
+
+bool WebSocketConnection::IsClosing() const { return impl_->IsClosing(); }
+
+std::size_t WebSocketConnection::GetSendQueueSize() const {
+  return impl_->GetSendQueueSize();
+}
+
+const engine::io::Sockaddr& WebSocketConnection::RemoteAddr() const noexcept {
+  return impl_->RemoteAddr();
+}
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,266 @@
+#include <userver/server/websocket/websocket_connection.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/websocket/broadcaster.hpp>
+#include <userver/server/websocket/websocket_handler.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+using ws::impl::Opcode;
+
+/// [Sample websocket handler]
+class NotificationsHandler final : public ws::WebsocketHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-notifications";
+
+  using WebsocketHandlerBase::WebsocketHandlerBase;
+
+  void Handle(const server::http::HttpRequest&,
+              ws::WebSocketConnection& websocket) const override {
+    const auto subscription = broadcaster_.Subscribe(websocket);
+
+    ws::Message message;
+    while (true) {
+      websocket.Recv(message);
+      if (message.close_status) break;
+      // the clients publish to all the subscribers
+      [[maybe_unused]] const auto result =
+          broadcaster_.Broadcast(ws::PreparedMessage::Text(message.data));
+    }
+  }
+
+ private:
+  mutable ws::Broadcaster broadcaster_;
+};
+/// [Sample websocket handler]
+
+constexpr std::array<char, 4> kMask{'\x12', '\x34', '\x56', '\x78'};
+
+constexpr ws::impl::ConnectionConfig kConfig{
+    /*max_message_size*/ 1000, /*max_send_queue_size*/ 16,
+    /*is_deflate_enabled*/ false};
+
+std::string MakeClientFrame(Opcode opcode, std::string_view payload,
+                            bool is_final = true, bool is_compressed = false) {
+  std::string frame;
+  ws::impl::AppendFrameHeader(frame, opcode, payload.size(), is_compressed);
+  if (!is_final) frame[0] &= 0x7F;
+
+  // the client frames are masked
+  frame[1] |= 0x80;
+  frame.append(kMask.data(), kMask.size());
+
+  const auto offset = frame.size();
+  frame.append(payload);
+  ws::impl::Unmask(frame.data() + offset, payload.size(), kMask);
+  return frame;
+}
+
+void SendClientFrame(engine::io::Socket& client, std::string_view frame) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  ASSERT_EQ(client.SendAll(frame.data(), frame.size(), deadline),
+            frame.size());
+}
+
+struct ServerFrame {
+  ws::impl::FrameHeader header;
+  std::string payload;
+};
+
+ServerFrame RecvServerFrame(engine::io::Socket& client) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  std::string data(2, '\0');
+  EXPECT_EQ(client.RecvAll(data.data(), 2, deadline), 2);
+
+  const auto length = static_cast<std::uint8_t>(data[1]) & 0x7F;
+  const std::size_t length_size =
+      length == 126 ? 2 : (length == 127 ? 8 : 0);
+  data.resize(2 + length_size);
+  EXPECT_EQ(client.RecvAll(data.data() + 2, length_size, deadline),
+            length_size);
+
+  ServerFrame frame;
+  EXPECT_EQ(ws::impl::ParseFrameHeader(data, frame.header), data.size());
+  frame.payload.resize(frame.header.payload_size);
+  EXPECT_EQ(client.RecvAll(frame.payload.data(), frame.payload.size(),
+                           deadline),
+            frame.payload.size());
+  return frame;
+}
+
+}  // namespace
+
+UTEST(WebSocketConnection, Messages) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+  ws::WebSocketConnection websocket{server, kConfig};
+
+  // a fragmented message with a ping in the middle
+  SendClientFrame(client, MakeClientFrame(Opcode::kText, "Hel", false));
+  SendClientFrame(client, MakeClientFrame(Opcode::kPing, "ping"));
+  SendClientFrame(client, MakeClientFrame(Opcode::kContinuation, "lo"));
+  SendClientFrame(client, MakeClientFrame(Opcode::kBinary, "\x01\x02"));
+
+  ws::Message message;
+  websocket.Recv(message);
+  EXPECT_EQ(message.data, "Hello");
+  EXPECT_TRUE(message.is_text);
+  EXPECT_FALSE(message.close_status);
+
+  auto frame = RecvServerFrame(client);
+  EXPECT_EQ(frame.header.opcode, Opcode::kPong);
+  EXPECT_EQ(frame.payload, "ping");
+
+  websocket.Recv(message);
+  EXPECT_EQ(message.data, "\x01\x02");
+  EXPECT_FALSE(message.is_text);
+
+  websocket.SendText("reply");
+  frame = RecvServerFrame(client);
+  EXPECT_EQ(frame.header.opcode, Opcode::kText);
+  EXPECT_TRUE(frame.header.is_final);
+  EXPECT_EQ(frame.payload, "reply");
+
+  SendClientFrame(client, MakeClientFrame(Opcode::kClose, "\x03\xe8"
+                                                          "bye"));
+  websocket.Recv(message);
+  EXPECT_EQ(message.close_status, ws::CloseStatus::kNormal);
+  EXPECT_EQ(message.data, "bye");
+  EXPECT_TRUE(websocket.IsClosing());
+
+  frame = RecvServerFrame(client);
+  EXPECT_EQ(frame.header.opcode, Opcode::kClose);
+  EXPECT_EQ(frame.payload, "\x03\xe8");
+
+  // the messages after the close are dropped
+  EXPECT_FALSE(websocket.TrySend(ws::PreparedMessage::Text("late")));
+  websocket.Recv(message);
+  EXPECT_EQ(message.close_status, ws::CloseStatus::kNormal);
+}
+
+UTEST(WebSocketConnection, ProtocolErrors) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const std::pair<std::string, ws::CloseStatus> kCases[] = {
+      // unmasked
+      {ws::impl::MakeFrame(Opcode::kText, "text"),
+       ws::CloseStatus::kProtocolError},
+      {MakeClientFrame(Opcode::kContinuation, "text"),
+       ws::CloseStatus::kProtocolError},
+      {MakeClientFrame(Opcode::kPing, "ping", false),
+       ws::CloseStatus::kProtocolError},
+      {MakeClientFrame(static_cast<Opcode>(3), "text"),
+       ws::CloseStatus::kProtocolError},
+      // permessage-deflate is not negotiated
+      {MakeClientFrame(Opcode::kText, "text", true, true),
+       ws::CloseStatus::kProtocolError},
+      {MakeClientFrame(Opcode::kText, "\xff"),
+       ws::CloseStatus::kInvalidPayload},
+      {MakeClientFrame(Opcode::kBinary, std::string(1001, 'a')),
+       ws::CloseStatus::kMessageTooBig},
+  };
+
+  for (const auto& [client_frame, status] : kCases) {
+    auto [server, client] =
+        internal::net::TcpListener{}.MakeSocketPair(deadline);
+    ws::WebSocketConnection websocket{server, kConfig};
+    SendClientFrame(client, client_frame);
+
+    ws::Message message;
+    websocket.Recv(message);
+    EXPECT_EQ(message.close_status, status);
+
+    const auto frame = RecvServerFrame(client);
+    EXPECT_EQ(frame.header.opcode, Opcode::kClose);
+    EXPECT_EQ(frame.payload,
+              ws::impl::MakeCloseFrame(static_cast<std::uint16_t>(status))
+                  .substr(2));
+  }
+}
+
+UTEST(WebSocketConnection, Disconnect) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+  ws::WebSocketConnection websocket{server, kConfig};
+
+  SendClientFrame(client,
+                  MakeClientFrame(Opcode::kText, "text").substr(0, 4));
+  client.Close();
+
+  ws::Message message;
+  websocket.Recv(message);
+  EXPECT_EQ(message.close_status, ws::CloseStatus::kAbnormalClosure);
+}
+
+UTEST(WebSocketConnection, Deflate) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+  auto config = kConfig;
+  config.is_deflate_enabled = true;
+  ws::WebSocketConnection websocket{server, config};
+
+  const std::string data(900, 'a');
+  SendClientFrame(client, MakeClientFrame(Opcode::kText,
+                                          ws::impl::Deflate(data), true, true));
+
+  ws::Message message;
+  websocket.Recv(message);
+  EXPECT_EQ(message.data, data);
+  EXPECT_TRUE(message.is_text);
+
+  websocket.SendBinary(data);
+  const auto frame = RecvServerFrame(client);
+  EXPECT_EQ(frame.header.opcode, Opcode::kBinary);
+  EXPECT_TRUE(frame.header.is_compressed);
+
+  ws::impl::Inflater inflater;
+  std::string inflated;
+  inflater.Inflate(frame.payload, data.size(), inflated);
+  EXPECT_EQ(inflated, data);
+}
+
+UTEST(WebSocketConnection, Broadcast) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto [server1, client1] =
+      internal::net::TcpListener{}.MakeSocketPair(deadline);
+  auto [server2, client2] =
+      internal::net::TcpListener{}.MakeSocketPair(deadline);
+  ws::WebSocketConnection websocket1{server1, kConfig};
+  ws::WebSocketConnection websocket2{server2, kConfig};
+
+  ws::Broadcaster broadcaster;
+  auto subscription1 = broadcaster.Subscribe(websocket1);
+  {
+    const auto subscription2 = broadcaster.Subscribe(websocket2);
+    EXPECT_EQ(broadcaster.GetSubscribersCount(), 2);
+
+    const auto result =
+        broadcaster.Broadcast(ws::PreparedMessage::Text("news"));
+    EXPECT_EQ(result.sent, 2);
+    EXPECT_EQ(result.dropped, 0);
+  }
+  EXPECT_EQ(broadcaster.GetSubscribersCount(), 1);
+
+  EXPECT_EQ(RecvServerFrame(client1).payload, "news");
+  EXPECT_EQ(RecvServerFrame(client2).payload, "news");
+
+  websocket1.Close(ws::CloseStatus::kGoingAway);
+  const auto result = broadcaster.Broadcast(ws::PreparedMessage::Text("news"));
+  EXPECT_EQ(result.sent, 0);
+  EXPECT_EQ(result.dropped, 1);
+
+  subscription1.Unsubscribe();
+  EXPECT_EQ(broadcaster.GetSubscribersCount(), 0);
+}
+
+USERVER_NAMESPACE_END
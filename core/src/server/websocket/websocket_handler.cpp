@@ -0,0 +1,184 @@
+#include <userver/server/websocket/websocket_handler.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_config.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+namespace {
+
+constexpr std::size_t kDefaultMaxMessageSize = 1024 * 1024;
+constexpr std::size_t kDefaultMaxSendQueueSize = 1024;
+
+constexpr std::string_view kWebsocketVersion = "13";
+// base64 of a 16 bytes nonce
+constexpr std::size_t kKeySize = 24;
+
+// Whether the comma separated list in the header value has the token
+bool HasToken(std::string_view value, std::string_view token) {
+  const utils::StrIcaseEqual equal;
+  while (!value.empty()) {
+    const auto pos = value.find(',');
+    auto item = value.substr(0, pos);
+    value = (pos == std::string_view::npos) ? std::string_view{}
+                                            : value.substr(pos + 1);
+    while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) {
+      item.remove_prefix(1);
+    }
+    while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) {
+      item.remove_suffix(1);
+    }
+    if (equal(item, token)) return true;
+  }
+  return false;
+}
+
+void ThrowBadHandshake(std::string_view reason) {
+  throw handlers::ClientError(
+      handlers::InternalMessage{fmt::format("bad WebSocket handshake: {}",
+                                            reason)},
+      handlers::ExternalBody{std::string{reason}});
+}
+
+}  // namespace
+
+WebsocketHandlerBase::WebsocketHandlerBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      max_message_size_(config["max-message-size"].As<std::size_t>(
+          kDefaultMaxMessageSize)),
+      max_send_queue_size_(config["max-send-queue-size"].As<std::size_t>(
+          kDefaultMaxSendQueueSize)),
+      is_deflate_enabled_(config["permessage-deflate"].As<bool>(false)) {}
+
+WebsocketHandlerBase::~WebsocketHandlerBase() = default;
+
+bool WebsocketHandlerBase::HandleHandshake(const http::HttpRequest&,
+                                           http::HttpResponse&,
+                                           request::RequestContext&) const {
+  return true;
+}
+
+std::string WebsocketHandlerBase::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  // RFC 6455 section 4.2.1, HTTP/2 needs the extended CONNECT of RFC 8441
+  if (request.GetMethod() != http::HttpMethod::kGet) {
+    ThrowBadHandshake("GET method is required");
+  }
+  if (request.GetHttpMajor() != 1 || request.GetHttpMinor() < 1) {
+    ThrowBadHandshake("HTTP/1.1 is required");
+  }
+  if (!HasToken(request.GetHeader(headers::kUpgrade), "websocket") ||
+      !HasToken(request.GetHeader(headers::kConnection), "upgrade")) {
+    ThrowBadHandshake("'Upgrade: websocket' is required");
+  }
+  const auto& key = request.GetHeader(headers::kSecWebSocketKey);
+  if (key.size() != kKeySize) {
+    ThrowBadHandshake("invalid Sec-WebSocket-Key");
+  }
+
+  auto& response = request.GetHttpResponse();
+  if (request.GetHeader(headers::kSecWebSocketVersion) != kWebsocketVersion) {
+    response.SetStatus(http::HttpStatus::kUpgradeRequired);
+    response.SetHeader(std::string{headers::kSecWebSocketVersion},
+                       std::string{kWebsocketVersion});
+    return {};
+  }
+
+  if (!HandleHandshake(request, response, context)) return {};
+
+  impl::ConnectionConfig config{max_message_size_, max_send_queue_size_,
+                                false};
+  if (is_deflate_enabled_) {
+    const auto params = impl::NegotiateDeflate(
+        request.GetHeader(headers::kSecWebSocketExtensions));
+    if (params) {
+      config.is_deflate_enabled = true;
+      response.SetHeader(std::string{headers::kSecWebSocketExtensions},
+                         impl::FormatDeflateResponse(*params));
+    }
+  }
+
+  response.SetStatus(http::HttpStatus::kSwitchingProtocols);
+  response.SetHeader(std::string{headers::kConnection}, "Upgrade");
+  response.SetHeader(std::string{headers::kUpgrade}, "websocket");
+  response.SetHeader(std::string{headers::kSecWebSocketAccept},
+                     impl::MakeAcceptKey(key));
+
+  // the request outlives the connection task
+  response.SetUpgradeCallback(
+      [this, request, config](engine::io::Socket& socket) {
+        // a failure after the handshake may have replaced the response
+        if (request.GetHttpResponse().GetStatus() !=
+            http::HttpStatus::kSwitchingProtocols) {
+          return;
+        }
+        RunConnection(request, socket, config);
+      });
+  return {};
+}
+
+void WebsocketHandlerBase::RunConnection(
+    const http::HttpRequest& request, engine::io::Socket& socket,
+    const impl::ConnectionConfig& config) const {
+  tracing::Span span(fmt::format("websocket/{}", HandlerName()));
+  WebSocketConnection websocket{socket, config};
+  try {
+    Handle(request, websocket);
+    websocket.Close(CloseStatus::kNormal);
+  } catch (const std::exception& ex) {
+    if (engine::current_task::ShouldCancel()) {
+      LOG_DEBUG() << "WebSocket connection is cancelled: " << ex;
+      websocket.Close(CloseStatus::kGoingAway);
+    } else {
+      LOG_WARNING() << "WebSocket handler failed: " << ex;
+      websocket.Close(CloseStatus::kInternalError);
+    }
+  }
+}
+
+yaml_config::Schema WebsocketHandlerBase::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: Base class for the WebSocket handlers
+additionalProperties: false
+properties:
+    max-message-size:
+        type: integer
+        description: |
+            max size of a received message after the decompression, the
+            bigger messages close the connection with the 1009 status
+        defaultDescription: 1048576
+        minimum: 1
+    max-send-queue-size:
+        type: integer
+        description: |
+            max count of the messages queued to a connection, the control
+            frames do not count
+        defaultDescription: 1024
+        minimum: 1
+    permessage-deflate:
+        type: boolean
+        description: |
+            whether to accept the permessage-deflate offers of the clients
+        defaultDescription: false
+)");
+}
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#include <tracing/cpu_usage.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+constexpr std::chrono::seconds kEpochDuration{5};
+
+// span names may come from user input, keep the memory bounded
+constexpr std::size_t kMaxSpanNames = 1000;
+const std::string kOtherSpans = "<other>";
+
+struct Counter final {
+  std::atomic<std::int64_t> cpu_time_ns{0};
+
+  void Reset() noexcept { cpu_time_ns.store(0, std::memory_order_relaxed); }
+};
+
+struct Result final {
+  std::int64_t cpu_time_ns{0};
+
+  Result& operator+=(const Counter& counter) noexcept {
+    cpu_time_ns += counter.cpu_time_ns.load(std::memory_order_relaxed);
+    return *this;
+  }
+};
+
+class RecentCpuUsage final {
+ public:
+  RecentCpuUsage() : recent_(kEpochDuration, kCpuUsageWindow) {}
+
+  void Account(std::chrono::nanoseconds cpu_time) {
+    recent_.GetCurrentCounter().cpu_time_ns.fetch_add(
+        cpu_time.count(), std::memory_order_relaxed);
+  }
+
+  std::chrono::nanoseconds GetForPeriod(std::chrono::seconds period) const {
+    return std::chrono::nanoseconds{
+        recent_.GetStatsForPeriod(period, /*with_current_epoch=*/true)
+            .cpu_time_ns};
+  }
+
+ private:
+  mutable utils::statistics::RecentPeriod<Counter, Result> recent_;
+};
+
+rcu::RcuMap<std::string, RecentCpuUsage>& GetUsageMap() {
+  static rcu::RcuMap<std::string, RecentCpuUsage> usage;
+  return usage;
+}
+
+}  // namespace
+
+void AccountCpuUsage(const std::string& span_name,
+                     std::chrono::nanoseconds cpu_time) {
+  auto& usage = GetUsageMap();
+  auto recent = usage.Get(span_name);
+  if (!recent) {
+    const auto& name =
+        usage.SizeApprox() < kMaxSpanNames ? span_name : kOtherSpans;
+    recent = usage.TryEmplace(name).value;
+  }
+  recent->Account(cpu_time);
+}
+
+std::vector<SpanCpuUsage> GetTopCpuUsage(std::size_t limit,
+                                         std::chrono::seconds period) {
+  std::vector<SpanCpuUsage> result;
+  for (const auto& [span_name, recent] : GetUsageMap()) {
+    const auto cpu_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        recent->GetForPeriod(period));
+    if (cpu_time.count() > 0) result.push_back({span_name, cpu_time});
+  }
+
+  const auto hottest_first = [](const auto& lhs, const auto& rhs) {
+    return lhs.cpu_time > rhs.cpu_time;
+  };
+  if (result.size() > limit) {
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(),
+                      hottest_first);
+    result.resize(limit);
+  } else {
+    std::sort(result.begin(), result.end(), hottest_first);
+  }
+  return result;
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+struct SpanCpuUsage final {
+  std::string span_name;
+  std::chrono::microseconds cpu_time;
+};
+
+/// How long the CPU usage of the spans is kept for
+inline constexpr std::chrono::seconds kCpuUsageWindow{300};
+
+/// Accounts the CPU time a task spent within its root span
+void AccountCpuUsage(const std::string& span_name,
+                     std::chrono::nanoseconds cpu_time);
+
+/// Returns the root spans that took the most CPU time over the last `period`,
+/// the hottest first
+std::vector<SpanCpuUsage> GetTopCpuUsage(std::size_t limit,
+                                         std::chrono::seconds period);
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
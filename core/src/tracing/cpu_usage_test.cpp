@@ -0,0 +1,56 @@
+#include <tracing/cpu_usage.hpp>
+
+#include <algorithm>
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void BurnCpu(std::chrono::milliseconds duration) {
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+
+std::chrono::microseconds FindCpuTime(const std::string& span_name) {
+  const auto usage = tracing::impl::GetTopCpuUsage(
+      100, tracing::impl::kCpuUsageWindow);
+  const auto it =
+      std::find_if(usage.begin(), usage.end(), [&](const auto& entry) {
+        return entry.span_name == span_name;
+      });
+  return it == usage.end() ? std::chrono::microseconds{0} : it->cpu_time;
+}
+
+}  // namespace
+
+UTEST(SpanCpuUsage, RootSpansOfTasks) {
+  engine::impl::SetCpuAccountingEnabled(true);
+
+  engine::AsyncNoSpan([] {
+    tracing::Span span{"cpu-usage-hot"};
+    BurnCpu(std::chrono::milliseconds{20});
+    {
+      // the time of the nested spans goes to the root span
+      tracing::Span nested{"cpu-usage-nested"};
+      BurnCpu(std::chrono::milliseconds{5});
+    }
+    // waiting takes no CPU
+    engine::SleepFor(std::chrono::milliseconds{50});
+  }).Get();
+
+  engine::impl::SetCpuAccountingEnabled(false);
+
+  const auto hot = FindCpuTime("cpu-usage-hot");
+  EXPECT_GE(hot, std::chrono::milliseconds{25});
+  EXPECT_LT(hot, std::chrono::milliseconds{75});
+  EXPECT_EQ(FindCpuTime("cpu-usage-nested").count(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,221 @@
+#include <tracing/sampling_profiler.hpp>
+
+#include <sys/time.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/stacktrace/frame.hpp>
+#include <boost/stacktrace/safe_dump_to.hpp>
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
+#include <tracing/span_impl.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+constexpr std::size_t kMaxSamples = 32768;
+constexpr std::size_t kMaxFrames = 32;
+constexpr std::size_t kMaxSpanNameLength = 47;
+
+// the signal handler itself and the signal trampoline
+constexpr std::size_t kSkipFrames = 2;
+
+constexpr std::string_view kNoSpan = "<no span>";
+
+struct Sample final {
+  // odd while the sample is being written
+  std::atomic<std::uint64_t> sequence{0};
+  std::int64_t timestamp_ns{0};
+  std::size_t frames_count{0};
+  char span_name[kMaxSpanNameLength + 1]{};
+  const void* frames[kMaxFrames + 1]{};
+};
+
+struct SampleCopy final {
+  std::string span_name;
+  std::vector<const void*> frames;
+};
+
+std::mutex profiler_mutex;
+std::unique_ptr<Sample[]> samples;
+std::atomic<Sample*> samples_ptr{nullptr};
+std::atomic<std::uint64_t> write_index{0};
+std::atomic<bool> is_running{false};
+bool is_handler_installed = false;
+
+std::int64_t NowNs() noexcept {
+  // clock_gettime is async-signal-safe, steady_clock is not guaranteed to be
+  struct timespec ts {};
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+void WriteSample(Sample& sample) noexcept {
+  sample.timestamp_ns = NowNs();
+
+  const auto* name = Span::Impl::GetCurrentNameUnchecked();
+  const std::string_view span_name = name ? std::string_view{*name} : kNoSpan;
+  const auto length = std::min(span_name.size(), kMaxSpanNameLength);
+  std::memcpy(sample.span_name, span_name.data(), length);
+  sample.span_name[length] = '\0';
+
+  // the stored frames are terminated by a null one
+  sample.frames_count = boost::stacktrace::safe_dump_to(
+      kSkipFrames, sample.frames, sizeof(sample.frames));
+}
+
+void OnSigprof(int, siginfo_t*, void*) noexcept {
+  auto* buffer = samples_ptr.load(std::memory_order_acquire);
+  if (!buffer || !is_running.load(std::memory_order_relaxed)) return;
+
+  const auto saved_errno = errno;
+  auto& sample =
+      buffer[write_index.fetch_add(1, std::memory_order_relaxed) % kMaxSamples];
+  auto sequence = sample.sequence.load(std::memory_order_relaxed);
+  // a sample that is still being written by another thread is not overwritten
+  if (sequence % 2 == 0 && sample.sequence.compare_exchange_strong(
+                               sequence, sequence + 1,
+                               std::memory_order_acquire)) {
+    WriteSample(sample);
+    sample.sequence.store(sequence + 2, std::memory_order_release);
+  }
+  errno = saved_errno;
+}
+
+bool TryCopySample(const Sample& sample, std::int64_t since_ns,
+                   SampleCopy& copy) {
+  const auto sequence = sample.sequence.load(std::memory_order_acquire);
+  if (sequence == 0 || sequence % 2 != 0) return false;
+
+  const auto timestamp_ns = sample.timestamp_ns;
+  const auto frames_count = std::min(sample.frames_count, kMaxFrames);
+  copy.span_name.assign(sample.span_name,
+                        ::strnlen(sample.span_name, kMaxSpanNameLength));
+  copy.frames.assign(sample.frames, sample.frames + frames_count);
+  while (!copy.frames.empty() && !copy.frames.back()) copy.frames.pop_back();
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (sample.sequence.load(std::memory_order_relaxed) != sequence) return false;
+  return timestamp_ns >= since_ns;
+}
+
+void SetTimer(std::chrono::microseconds interval) {
+  struct itimerval timer {};
+  timer.it_interval.tv_sec = interval.count() / 1'000'000;
+  timer.it_interval.tv_usec = interval.count() % 1'000'000;
+  timer.it_value = timer.it_interval;
+  utils::CheckSyscall(::setitimer(ITIMER_PROF, &timer, nullptr),
+                      "setting the profiling timer");
+}
+
+class FrameNames final {
+ public:
+  const std::string& Get(const void* address) {
+    auto& name = names_[address];
+    if (name.empty()) {
+      name = boost::stacktrace::frame(address).name();
+      if (name.empty()) name = fmt::format("{}", address);
+    }
+    return name;
+  }
+
+ private:
+  std::unordered_map<const void*, std::string> names_;
+};
+
+}  // namespace
+
+bool StartSamplingProfiler(std::chrono::microseconds interval) {
+  UINVARIANT(interval.count() > 0, "Invalid sampling interval");
+  std::lock_guard lock(profiler_mutex);
+  if (is_running.load()) return false;
+
+  if (!samples) {
+    samples = std::make_unique<Sample[]>(kMaxSamples);
+    samples_ptr.store(samples.get(), std::memory_order_release);
+    // the unwinder initializes itself lazily and that is not
+    // async-signal-safe, so do it outside of the signal handler
+    const void* frames[kMaxFrames + 1]{};
+    boost::stacktrace::safe_dump_to(frames, sizeof(frames));
+  }
+
+  if (!is_handler_installed) {
+    // the handler stays installed after the profiler stops, as the default
+    // action of a SIGPROF that is already pending would kill the process
+    struct sigaction action {};
+    action.sa_sigaction = &OnSigprof;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    utils::CheckSyscall(::sigaction(SIGPROF, &action, nullptr),
+                        "setting SIGPROF handler");
+    is_handler_installed = true;
+  }
+
+  is_running = true;
+  SetTimer(interval);
+  return true;
+}
+
+void StopSamplingProfiler() {
+  std::lock_guard lock(profiler_mutex);
+  if (!is_running.load()) return;
+
+  SetTimer(std::chrono::microseconds{0});
+  is_running = false;
+}
+
+bool IsSamplingProfilerRunning() noexcept { return is_running.load(); }
+
+std::string GetFoldedStacks(std::chrono::steady_clock::time_point since) {
+  auto* buffer = samples_ptr.load(std::memory_order_acquire);
+  if (!buffer) return {};
+
+  // steady_clock is CLOCK_MONOTONIC on Linux
+  const auto since_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            since.time_since_epoch())
+                            .count();
+
+  std::map<std::vector<const void*>, std::map<std::string, std::size_t>>
+      counts;
+  SampleCopy copy;
+  for (std::size_t i = 0; i < kMaxSamples; ++i) {
+    if (!TryCopySample(buffer[i], since_ns, copy)) continue;
+    ++counts[copy.frames][copy.span_name];
+  }
+
+  FrameNames frame_names;
+  std::string result;
+  for (const auto& [frames, spans] : counts) {
+    std::string stack;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      stack += ';';
+      stack += frame_names.Get(*it);
+    }
+    for (const auto& [span_name, count] : spans) {
+      result += fmt::format("{}{} {}\n", span_name, stack, count);
+    }
+  }
+  return result;
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// Starts sampling the threads that consume CPU every `interval` of their CPU
+/// time, returns false if the profiler is already running
+bool StartSamplingProfiler(std::chrono::microseconds interval);
+
+void StopSamplingProfiler();
+
+bool IsSamplingProfilerRunning() noexcept;
+
+/// Returns the samples taken since `since` in the folded stacks format, i.e.
+/// `span;root_frame;...;leaf_frame count` per line, suitable for the flame
+/// graph tools. The samples are kept in a fixed size ring buffer, so only the
+/// latest ones are available.
+std::string GetFoldedStacks(std::chrono::steady_clock::time_point since);
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
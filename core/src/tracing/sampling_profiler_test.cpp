@@ -0,0 +1,43 @@
+#include <tracing/sampling_profiler.hpp>
+
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void BurnCpu(std::chrono::milliseconds duration) {
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+
+}  // namespace
+
+UTEST(SamplingProfiler, SamplesCurrentSpan) {
+  const auto since = std::chrono::steady_clock::now();
+  ASSERT_TRUE(
+      tracing::impl::StartSamplingProfiler(std::chrono::milliseconds{1}));
+  EXPECT_TRUE(tracing::impl::IsSamplingProfilerRunning());
+  EXPECT_FALSE(
+      tracing::impl::StartSamplingProfiler(std::chrono::milliseconds{1}));
+
+  {
+    tracing::Span span{"sampling-profiler-hot"};
+    BurnCpu(std::chrono::milliseconds{200});
+  }
+
+  tracing::impl::StopSamplingProfiler();
+  EXPECT_FALSE(tracing::impl::IsSamplingProfilerRunning());
+
+  const auto folded = tracing::impl::GetFoldedStacks(since);
+  EXPECT_NE(folded.find("sampling-profiler-hot;"), std::string::npos)
+      << folded;
+
+  // the samples are in the past
+  EXPECT_EQ(tracing::impl::GetFoldedStacks(std::chrono::steady_clock::now()),
+            "");
+}
+
+USERVER_NAMESPACE_END
@@ -1,15 +1,22 @@
 #include <tracing/span_impl.hpp>
 
+#include <new>
 #include <random>
 #include <type_traits>
+#include <variant>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <compiler/tls.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 #include <logging/put_data.hpp>
+#include <logging/tail_sampling.hpp>
+#include <tracing/cpu_usage.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
@@ -100,10 +107,9 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
                  ReferenceType reference_type, logging::Level log_level)
     : name_(std::move(name)),
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
+      is_sampled_(!parent || parent->is_sampled_),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
-      start_system_time_(std::chrono::system_clock::now()),
-      start_steady_time_(std::chrono::steady_clock::now()),
       trace_id_(parent ? parent->GetTraceId()
                        : utils::generators::GenerateUuid()),
       span_id_(GenerateSpanId()),
@@ -112,15 +118,23 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
+    tail_sampling_ = parent->tail_sampling_;
   }
+  StartTimersIfNeeded();
 }
 
 Span::Impl::~Impl() {
-  if (!ShouldLog()) {
-    return;
+  if (cpu_accounting_task_) FinishCpuAccounting();
+  if (owns_tail_sampling_ && tail_sampling_) FinishTailSampling();
+  ExportSpan();
+
+  if (ShouldLog()) {
+    PutIntoLogger(DO_LOG_TO_NO_SPAN(logging::DefaultLogger(), log_level_));
   }
 
-  PutIntoLogger(DO_LOG_TO_NO_SPAN(logging::DefaultLogger(), log_level_));
+  // The sampling profiler reads the name of the current span, so the span
+  // must leave the stack before its members are destroyed
+  DetachFromCoroStack();
 }
 
 void Span::Impl::PutIntoLogger(logging::LogHelper& lh) {
@@ -159,9 +173,48 @@ void Span::Impl::LogTo(logging::LogHelper& log_helper) && {
 
 void Span::Impl::DetachFromCoroStack() { unlink(); }
 
+void Span::Impl::SetSampled(bool is_sampled) {
+  is_sampled_ = is_sampled;
+  StartTimersIfNeeded();
+}
+
+void Span::Impl::StartTimersIfNeeded() {
+  // the tail sampling needs the duration of the span even if it is not logged
+  const bool needs_timers = IsRecording() || owns_tail_sampling_;
+  if (needs_timers &&
+      start_steady_time_ == std::chrono::steady_clock::time_point{}) {
+    start_system_time_ = std::chrono::system_clock::now();
+    start_steady_time_ = std::chrono::steady_clock::now();
+  }
+}
+
+const std::string* Span::Impl::GetCurrentNameUnchecked() noexcept {
+  auto* context = engine::current_task::GetCurrentTaskContextUnchecked();
+  if (!context || !context->HasLocalStorage()) return nullptr;
+
+  const auto* spans_ptr = task_local_spans.GetOptional();
+  return !spans_ptr || spans_ptr->empty() ? nullptr : &spans_ptr->back().name_;
+}
+
 void Span::Impl::AttachToCoroStack() {
   UASSERT(!is_linked());
-  task_local_spans->push_back(*this);
+  auto& spans = *task_local_spans;
+  if (spans.empty() && engine::impl::IsCpuAccountingEnabled()) {
+    cpu_accounting_task_ = &engine::current_task::GetCurrentTaskContext();
+    cpu_time_at_start_ = cpu_accounting_task_->GetExecutionTime();
+  }
+  spans.push_back(*this);
+}
+
+void Span::Impl::FinishCpuAccounting() noexcept {
+  // the span may have been moved to another task
+  if (!cpu_accounting_task_->IsCurrent()) return;
+  try {
+    impl::AccountCpuUsage(
+        name_, cpu_accounting_task_->GetExecutionTime() - cpu_time_at_start_);
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, e.what());
+  }
 }
 
 std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
@@ -195,20 +248,130 @@ bool Span::Impl::ShouldLog() const {
   /* We must honour default log level, but use span's level from ourselves,
    * not the previous span's.
    */
-  return logging::ShouldLogNospan(log_level_) &&
+  return is_sampled_ && logging::ShouldLogNospan(log_level_) &&
          local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+bool Span::Impl::HasErrorFlag() const {
+  const auto is_set = [](const logging::LogExtra& log_extra) {
+    return std::visit(
+        [](const auto& value) {
+          // AddTag() stores `true` as a number
+          if constexpr (std::is_arithmetic_v<std::decay_t<decltype(value)>>) {
+            return value != 0;
+          } else {
+            return false;
+          }
+        },
+        log_extra.GetValue(kErrorFlag));
+  };
+  return is_set(log_extra_inheritable_) ||
+         (log_extra_local_ && is_set(*log_extra_local_));
+}
+
+void Span::Impl::FinishTailSampling() noexcept {
+  try {
+    const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+    if (HasErrorFlag() || duration >= tail_sampling_->GetLatencyThreshold()) {
+      tail_sampling_->Flush();
+    }
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, e.what());
+  }
+}
+
 namespace {
+
+// Span::Impl keeps the tags in place and is too big for the fast paths of the
+// allocator. The memory of the destroyed Impls is kept in a bounded per-thread
+// free list and reused by the next spans.
+class ImplStoragePool final {
+ public:
+  ImplStoragePool() = default;
+  ImplStoragePool(const ImplStoragePool&) = delete;
+  ImplStoragePool& operator=(const ImplStoragePool&) = delete;
+
+  ~ImplStoragePool() { Clear(); }
+
+  void* Allocate() {
+    if (!head_) return ::operator new(sizeof(Span::Impl));
+
+    auto* block = head_;
+    head_ = block->next;
+    --size_;
+    return block;
+  }
+
+  void Deallocate(void* storage) noexcept {
+    if (size_ >= kMaxSize) {
+      ::operator delete(storage);
+      return;
+    }
+
+    head_ = new (storage) FreeBlock{head_};
+    ++size_;
+  }
+
+  void Clear() noexcept {
+    while (head_) {
+      auto* next = head_->next;
+      ::operator delete(head_);
+      head_ = next;
+    }
+    size_ = 0;
+  }
+
+ private:
+  // Impl takes about 4KB, the pool of a thread stays within ~130KB
+  static constexpr std::size_t kMaxSize = 32;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* head_{nullptr};
+  std::size_t size_{0};
+};
+
+static_assert(alignof(Span::Impl) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+thread_local ImplStoragePool impl_storage_pool;
+
+USERVER_PREVENT_TLS_CACHING
+void* AllocateImplStorage() { return impl_storage_pool.Allocate(); }
+
+USERVER_PREVENT_TLS_CACHING
+void DeallocateImplStorage(void* storage) noexcept {
+  impl_storage_pool.Deallocate(storage);
+}
+
+USERVER_PREVENT_TLS_CACHING
+void ClearImplStorage() noexcept { impl_storage_pool.Clear(); }
+
+// The thread_local destructor runs at the thread exit, the workers release
+// the pool earlier, on their shutdown
+[[maybe_unused]] const bool kImplStorageClearRegistered = [] {
+  engine::RegisterThreadStoppedHook(&ClearImplStorage);
+  return true;
+}();
+
 template <typename... Args>
 Span::Impl* AllocateImpl(Args&&... args) {
-  return new Span::Impl(std::forward<Args>(args)...);
+  void* storage = AllocateImplStorage();
+  try {
+    return new (storage) Span::Impl(std::forward<Args>(args)...);
+  } catch (...) {
+    DeallocateImplStorage(storage);
+    throw;
+  }
 }
+
 }  // namespace
 
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
-    std::default_delete<Impl>{}(impl);
+    impl->~Impl();
+    DeallocateImplStorage(impl);
   }
 }
 
@@ -314,6 +477,8 @@ tracing::ScopeTime Span::CreateScopeTime(std::string name) {
 
 void Span::AddNonInheritableTag(std::string key,
                                 logging::LogExtra::Value value) {
+  // the local tags are only used by the final log record and the export
+  if (!pimpl_->IsRecording()) return;
   if (!pimpl_->log_extra_local_) pimpl_->log_extra_local_.emplace();
   pimpl_->log_extra_local_->Extend(std::move(key), std::move(value));
 }
@@ -333,6 +498,18 @@ std::optional<logging::Level> Span::GetLocalLogLevel() const {
   return pimpl_->local_log_level_;
 }
 
+void Span::EnableTailSampling(logging::Level level,
+                              std::chrono::milliseconds latency_threshold) {
+  pimpl_->tail_sampling_ =
+      std::make_shared<logging::impl::TailSampling>(level, latency_threshold);
+  pimpl_->owns_tail_sampling_ = true;
+  pimpl_->StartTimersIfNeeded();
+}
+
+void Span::SetSampled(bool is_sampled) { pimpl_->SetSampled(is_sampled); }
+
+bool Span::IsSampled() const noexcept { return pimpl_->is_sampled_; }
+
 void Span::AddTag(std::string key, logging::LogExtra::Value value) {
   pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value));
 }
@@ -343,6 +520,11 @@ void Span::AddTags(const logging::LogExtra& log_extra, utils::InternalTag) {
 
 impl::TimeStorage& Span::GetTimeStorage() { return pimpl_->GetTimeStorage(); }
 
+logging::impl::TailSampling* Span::GetTailSampling(
+    utils::InternalTag) const noexcept {
+  return pimpl_->tail_sampling_.get();
+}
+
 std::string Span::GetTag(std::string_view tag) const {
   const auto& value = pimpl_->log_extra_inheritable_.GetValue(tag);
   const auto* s = std::get_if<std::string>(&value);
@@ -2,9 +2,11 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/intrusive/list.hpp>
 
@@ -15,6 +17,7 @@
 #include <userver/logging/log_helper.hpp>
 #include <userver/tracing/scope_time.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
 #include <userver/tracing/tracer.hpp>
 
 #include <tracing/time_storage.hpp>
@@ -27,6 +30,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::impl {
+class TaskContext;
+}  // namespace engine::impl
+
 namespace formats::json {
 class ValueBuilder;
 }
@@ -68,24 +75,46 @@ class Span::Impl
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
+  // Unsampled and no-log spans do not measure their time, keep no local tags
+  // and are never logged or exported
+  bool IsRecording() const noexcept { return is_sampled_ && !is_no_log_span_; }
+  void SetSampled(bool is_sampled);
+
   void DetachFromCoroStack();
   void AttachToCoroStack();
+
+  // Returns the name of the current span of the calling thread, if any. Reads
+  // plain memory only, so it may be called from a signal handler.
+  static const std::string* GetCurrentNameUnchecked() noexcept;
   void PutIntoLogger(logging::LogHelper& lh);
 
  private:
   void LogOpenTracing() const;
+  void ExportSpan() const noexcept;
+  static void CollectTags(std::vector<FinishedSpan::Tag>& output,
+                          const logging::LogExtra& input);
   void DoLogOpenTracing(logging::LogHelper& lh) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
 
   static std::string GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
+  bool HasErrorFlag() const;
+  void FinishTailSampling() noexcept;
+  void FinishCpuAccounting() noexcept;
+  void StartTimersIfNeeded();
 
   const std::string name_;
   const bool is_no_log_span_;
+  // inherited from the parent, see Span::SetSampled()
+  bool is_sampled_;
   logging::Level log_level_;
   std::optional<logging::Level> local_log_level_;
 
+  // shared with the children, the owning Span decides whether to write it
+  std::shared_ptr<logging::impl::TailSampling> tail_sampling_;
+  bool owns_tail_sampling_{false};
+
   std::shared_ptr<Tracer> tracer_;
   logging::LogExtra log_extra_inheritable_;
 
@@ -94,14 +123,19 @@ class Span::Impl
   std::optional<logging::LogExtra> log_extra_local_;
   impl::TimeStorage time_storage_;
 
-  const std::chrono::system_clock::time_point start_system_time_;
-  const std::chrono::steady_clock::time_point start_steady_time_;
+  // {} while the span is not recording
+  std::chrono::system_clock::time_point start_system_time_;
+  std::chrono::steady_clock::time_point start_steady_time_;
 
   std::string trace_id_;
   std::string span_id_;
   std::string parent_id_;
   const ReferenceType reference_type_;
 
+  // set for the root span of a task while the CPU accounting is enabled
+  engine::impl::TaskContext* cpu_accounting_task_{nullptr};
+  std::chrono::nanoseconds cpu_time_at_start_{0};
+
   friend class Span;
 };
 
@@ -8,6 +8,7 @@
 #include <userver/logging/log_extra.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -115,6 +116,40 @@ void Span::Impl::DoLogOpenTracing(logging::LogHelper& lh) const {
   PutData(lh, "tags", tags.GetStringView());
 }
 
+void Span::Impl::ExportSpan() const noexcept {
+  // moved-out spans have no ids
+  if (!IsRecording() || span_id_.empty()) return;
+
+  const auto exporter = Tracer::GetSpanExporter();
+  if (!exporter || !Tracer::IsSampled(trace_id_)) return;
+
+  try {
+    FinishedSpan span;
+    span.name = name_;
+    span.trace_id = trace_id_;
+    span.span_id = span_id_;
+    span.parent_id = parent_id_;
+    span.reference_type = reference_type_;
+    span.start_time = start_system_time_;
+    span.duration = std::chrono::steady_clock::now() - start_steady_time_;
+    span.has_error = HasErrorFlag();
+
+    CollectTags(span.tags, log_extra_inheritable_);
+    if (log_extra_local_) CollectTags(span.tags, *log_extra_local_);
+
+    exporter->Export(span);
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, e.what());
+  }
+}
+
+void Span::Impl::CollectTags(std::vector<FinishedSpan::Tag>& output,
+                             const logging::LogExtra& input) {
+  for (const auto& [key, value] : *input.extra_) {
+    output.emplace_back(key, value.GetValue());
+  }
+}
+
 void Span::Impl::AddOpentracingTags(formats::json::StringBuilder& output,
                                     const logging::LogExtra& input) {
   const auto& opentracing_tags = jaeger::GetOpentracingTags();
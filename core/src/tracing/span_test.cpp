@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
 
@@ -8,8 +10,11 @@
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/uuid4.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -297,6 +302,97 @@ UTEST_F(Span, LowerLocalLogLevel) {
   EXPECT_NE(std::string::npos, GetStreamString().find("logged_span"));
 }
 
+UTEST_F(Span, TailSamplingDropsFast) {
+  logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+  {
+    tracing::Span span("fast_span");
+    span.EnableTailSampling(logging::Level::kDebug, std::chrono::hours{1});
+    LOG_DEBUG() << "debug_fast";
+  }
+
+  logging::LogFlush();
+  EXPECT_NE(std::string::npos, GetStreamString().find("fast_span"));
+  EXPECT_EQ(std::string::npos, GetStreamString().find("debug_fast"));
+}
+
+UTEST_F(Span, TailSamplingWritesFailed) {
+  logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+  {
+    tracing::Span span("failed_span");
+    span.EnableTailSampling(logging::Level::kDebug, std::chrono::hours{1});
+    LOG_DEBUG() << "debug_failed";
+    LOG_TRACE() << "trace_failed";
+    {
+      tracing::Span child("child_span");
+      LOG_DEBUG() << "debug_child";
+    }
+    span.AddTag(tracing::kErrorFlag, true);
+
+    logging::LogFlush();
+    EXPECT_EQ(std::string::npos, GetStreamString().find("debug_failed"));
+  }
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_NE(std::string::npos, logs.find("debug_child"));
+  EXPECT_EQ(std::string::npos, logs.find("trace_failed"));
+  ASSERT_NE(std::string::npos, logs.find("debug_failed"));
+  EXPECT_LT(logs.find("debug_failed"), logs.find("stopwatch_name=failed_span"));
+}
+
+UTEST_F(Span, TailSamplingWritesSlow) {
+  logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+  {
+    tracing::Span span("slow_span");
+    span.EnableTailSampling(logging::Level::kDebug,
+                            std::chrono::milliseconds{0});
+    LOG_DEBUG() << "debug_slow";
+  }
+
+  logging::LogFlush();
+  EXPECT_NE(std::string::npos, GetStreamString().find("debug_slow"));
+}
+
+UTEST_F(Span, Unsampled) {
+  std::string trace_id;
+  {
+    tracing::Span root("unsampled_root");
+    root.SetSampled(false);
+    trace_id = root.GetTraceId();
+
+    tracing::Span child("unsampled_child");
+    EXPECT_FALSE(child.IsSampled());
+    EXPECT_EQ(child.GetTraceId(), trace_id);
+    EXPECT_FALSE(child.GetSpanId().empty());
+    child.AddNonInheritableTag("local_tag", "value");
+    LOG_INFO() << "inside_unsampled";
+  }
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_EQ(std::string::npos, logs.find("stopwatch_name="));
+  EXPECT_EQ(std::string::npos, logs.find("local_tag"));
+  // the logs of the unsampled spans still carry the trace id
+  EXPECT_NE(std::string::npos, logs.find("inside_unsampled"));
+  EXPECT_NE(std::string::npos, logs.find(trace_id));
+}
+
+UTEST_F(Span, SampledChildOfUnsampled) {
+  {
+    tracing::Span root("unsampled_root");
+    root.SetSampled(false);
+
+    tracing::Span child("sampled_child");
+    child.SetSampled(true);
+    EXPECT_TRUE(child.IsSampled());
+  }
+
+  logging::LogFlush();
+  EXPECT_NE(std::string::npos,
+            GetStreamString().find("stopwatch_name=sampled_child"));
+  EXPECT_EQ(std::string::npos, GetStreamString().find("unsampled_root"));
+}
+
 UTEST_F(Span, ConstructFromTracer) {
   auto tracer = tracing::MakeNoopTracer("test_service");
 
@@ -651,4 +747,128 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+namespace {
+
+class TestSpanExporter final : public tracing::SpanExporter {
+ public:
+  struct Span {
+    std::string name;
+    std::string trace_id;
+    std::string parent_id;
+    bool has_error;
+    std::vector<std::string> tag_keys;
+  };
+
+  void Export(const tracing::FinishedSpan& span) noexcept override {
+    Span result{std::string{span.name}, std::string{span.trace_id},
+                std::string{span.parent_id}, span.has_error, {}};
+    for (const auto& [key, value] : span.tags) {
+      result.tag_keys.emplace_back(key);
+    }
+    spans.push_back(std::move(result));
+  }
+
+  std::vector<Span> spans;
+};
+
+class SpanExport : public Span {
+ protected:
+  void SetUp() override {
+    Span::SetUp();
+    tracing::Tracer::SetSpanExporter(exporter_);
+  }
+
+  void TearDown() override {
+    tracing::Tracer::SetSpanExporter({});
+    tracing::Tracer::SetSamplingRatio(1);
+    Span::TearDown();
+  }
+
+  const std::vector<TestSpanExporter::Span>& GetExportedSpans() const {
+    return exporter_->spans;
+  }
+
+ private:
+  std::shared_ptr<TestSpanExporter> exporter_ =
+      std::make_shared<TestSpanExporter>();
+};
+
+}  // namespace
+
+UTEST_F(SpanExport, Basic) {
+  std::string trace_id;
+  std::string parent_span_id;
+  {
+    tracing::Span root("root");
+    trace_id = root.GetTraceId();
+    parent_span_id = root.GetSpanId();
+    root.AddTag("inherited", 1);
+
+    tracing::Span child("child");
+    child.AddNonInheritableTag("local", "value");
+    child.AddTag(tracing::kErrorFlag, true);
+  }
+
+  const auto& spans = GetExportedSpans();
+  ASSERT_EQ(spans.size(), 2);
+
+  EXPECT_EQ(spans[0].name, "child");
+  EXPECT_EQ(spans[0].trace_id, trace_id);
+  EXPECT_EQ(spans[0].parent_id, parent_span_id);
+  EXPECT_TRUE(spans[0].has_error);
+  EXPECT_NE(std::find(spans[0].tag_keys.begin(), spans[0].tag_keys.end(),
+                      "inherited"),
+            spans[0].tag_keys.end());
+  EXPECT_NE(
+      std::find(spans[0].tag_keys.begin(), spans[0].tag_keys.end(), "local"),
+      spans[0].tag_keys.end());
+
+  EXPECT_EQ(spans[1].name, "root");
+  EXPECT_FALSE(spans[1].has_error);
+}
+
+UTEST_F(SpanExport, HeadSampling) {
+  tracing::Tracer::SetSamplingRatio(0);
+  { tracing::Span span("not_sampled"); }
+  EXPECT_TRUE(GetExportedSpans().empty());
+
+  tracing::Tracer::SetSamplingRatio(0.5);
+  std::size_t sampled = 0;
+  constexpr std::size_t kTraces = 1000;
+  for (std::size_t i = 0; i < kTraces; ++i) {
+    tracing::Span root("root");
+    const bool is_sampled = tracing::Tracer::IsSampled(root.GetTraceId());
+    if (is_sampled) ++sampled;
+
+    const auto exported_before = GetExportedSpans().size();
+    { tracing::Span child("child"); }
+    // children follow the decision made for the trace
+    EXPECT_EQ(GetExportedSpans().size() - exported_before,
+              is_sampled ? 1 : 0);
+  }
+  EXPECT_GT(sampled, kTraces / 4);
+  EXPECT_LT(sampled, kTraces * 3 / 4);
+}
+
+UTEST_F(SpanExport, UnsampledSpans) {
+  {
+    tracing::Span root("root");
+    root.SetSampled(false);
+    tracing::Span child("child");
+  }
+  EXPECT_TRUE(GetExportedSpans().empty());
+}
+
+TEST(Tracer, SamplingRatioIsConsistent) {
+  constexpr std::size_t kTraces = 1000;
+  for (std::size_t i = 0; i < kTraces; ++i) {
+    const auto trace_id = utils::generators::GenerateUuid();
+    EXPECT_TRUE(tracing::Tracer::IsSampled(trace_id, 1));
+    EXPECT_FALSE(tracing::Tracer::IsSampled(trace_id, 0));
+    if (tracing::Tracer::IsSampled(trace_id, 0.1)) {
+      EXPECT_TRUE(tracing::Tracer::IsSampled(trace_id, 0.5));
+    }
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,10 +1,15 @@
 #include <userver/tracing/tracer.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <limits>
 
 #include <tracing/no_log_spans.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/tracing/noop.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/uuid4.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,6 +30,44 @@ auto& GlobalTracer() {
   return tracer;
 }
 
+auto& GlobalSpanExporter() {
+  static rcu::Variable<std::shared_ptr<SpanExporter>> exporter{};
+  return exporter;
+}
+
+// avoids rcu reads for each finished span while there is no exporter
+std::atomic<bool> has_span_exporter{false};
+
+// avoids rcu reads for each new span while there are no no-log spans
+std::atomic<bool> has_no_log_spans{false};
+
+// traces with the trace id hash below the threshold are sampled
+std::atomic<std::uint64_t> sampling_threshold{
+    std::numeric_limits<std::uint64_t>::max()};
+
+std::uint64_t RatioToThreshold(double ratio) noexcept {
+  constexpr auto kMax = std::numeric_limits<std::uint64_t>::max();
+  return ratio >= 1 ? kMax
+                    : static_cast<std::uint64_t>(
+                          std::max(ratio, 0.0) * static_cast<double>(kMax));
+}
+
+// FNV-1a, stable between processes and builds
+std::uint64_t HashTraceId(std::string_view trace_id) noexcept {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const char c : trace_id) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+bool IsBelowThreshold(std::string_view trace_id,
+                      std::uint64_t threshold) noexcept {
+  if (threshold == std::numeric_limits<std::uint64_t>::max()) return true;
+  return HashTraceId(trace_id) < threshold;
+}
+
 template <class T>
 bool ValueMatchPrefix(const T& value, const T& prefix) {
   return prefix.size() <= value.size() &&
@@ -51,12 +94,17 @@ bool ValueMatchesOneOfPrefixes(const T& value,
 
 Tracer::~Tracer() = default;
 
+SpanExporter::~SpanExporter() = default;
+
 void Tracer::SetNoLogSpans(NoLogSpans&& spans) {
   auto& global_spans = GlobalNoLogSpans();
+  const bool is_empty = spans.prefixes.empty() && spans.names.empty();
   global_spans.Assign(std::move(spans));
+  has_no_log_spans = !is_empty;
 }
 
 bool Tracer::IsNoLogSpan(const std::string& name) {
+  if (!has_no_log_spans) return false;
   const auto spans = GlobalNoLogSpans().Read();
 
   return ValueMatchesOneOfPrefixes(name, spans->prefixes) ||
@@ -71,6 +119,30 @@ std::shared_ptr<Tracer> Tracer::GetTracer() {
   return GlobalTracer().ReadCopy();
 }
 
+void Tracer::SetSpanExporter(std::shared_ptr<SpanExporter> exporter) {
+  has_span_exporter = (exporter != nullptr);
+  GlobalSpanExporter().Assign(std::move(exporter));
+}
+
+std::shared_ptr<SpanExporter> Tracer::GetSpanExporter() {
+  if (!has_span_exporter) return {};
+  return GlobalSpanExporter().ReadCopy();
+}
+
+void Tracer::SetSamplingRatio(double ratio) {
+  UINVARIANT(ratio >= 0 && ratio <= 1, "Sampling ratio must be in [0, 1]");
+  sampling_threshold = RatioToThreshold(ratio);
+}
+
+bool Tracer::IsSampled(std::string_view trace_id) noexcept {
+  return IsBelowThreshold(trace_id,
+                          sampling_threshold.load(std::memory_order_relaxed));
+}
+
+bool Tracer::IsSampled(std::string_view trace_id, double ratio) noexcept {
+  return IsBelowThreshold(trace_id, RatioToThreshold(ratio));
+}
+
 const std::string& Tracer::GetServiceName() const { return service_name_; }
 
 Span Tracer::CreateSpanWithoutParent(std::string name) {
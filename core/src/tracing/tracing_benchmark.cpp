@@ -3,6 +3,7 @@
 #include <userver/engine/run_standalone.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
+#include <userver/tracing/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,6 +55,69 @@ void tracing_opentracing_ctr(benchmark::State& state) {
 }
 BENCHMARK(tracing_opentracing_ctr);
 
+// Spans are not logged, shows the cost of the construction and destruction
+void tracing_child_span_ctr(benchmark::State& state) {
+  logging::LoggerPtr logger = logging::MakeNullLogger("logger");
+  engine::RunStandalone([&] {
+    auto old_logger = logging::SetDefaultLogger(logger);
+    logging::SetDefaultLoggerLevel(logging::Level::kWarning);
+
+    {
+      tracing::Span root_span("root");
+      for (auto _ : state) {
+        tracing::Span span("child");
+        benchmark::DoNotOptimize(span);
+      }
+    }
+
+    logging::SetDefaultLogger(old_logger);
+  });
+}
+BENCHMARK(tracing_child_span_ctr);
+
+// Spans are logged, compare with tracing_unsampled_child_span_ctr
+void tracing_logged_child_span_ctr(benchmark::State& state) {
+  logging::LoggerPtr logger = logging::MakeNullLogger("logger");
+  engine::RunStandalone([&] {
+    auto old_logger = logging::SetDefaultLogger(logger);
+    logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+
+    {
+      tracing::Span root_span("root");
+      for (auto _ : state) {
+        tracing::Span span("child");
+        span.AddNonInheritableTag("tag", "value");
+        benchmark::DoNotOptimize(span);
+      }
+    }
+
+    logging::SetDefaultLogger(old_logger);
+  });
+}
+BENCHMARK(tracing_logged_child_span_ctr);
+
+// The same spans in an unsampled request, see tracing::Span::SetSampled()
+void tracing_unsampled_child_span_ctr(benchmark::State& state) {
+  logging::LoggerPtr logger = logging::MakeNullLogger("logger");
+  engine::RunStandalone([&] {
+    auto old_logger = logging::SetDefaultLogger(logger);
+    logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+
+    {
+      tracing::Span root_span("root");
+      root_span.SetSampled(false);
+      for (auto _ : state) {
+        tracing::Span span("child");
+        span.AddNonInheritableTag("tag", "value");
+        benchmark::DoNotOptimize(span);
+      }
+    }
+
+    logging::SetDefaultLogger(old_logger);
+  });
+}
+BENCHMARK(tracing_unsampled_child_span_ctr);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -7,12 +7,21 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/task/task_context.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
 
 namespace {
+
 constexpr std::chrono::milliseconds kYieldInterval{3};
+
+bool IsTimeSliceExceeded() {
+  auto* current = engine::current_task::GetCurrentTaskContextUnchecked();
+  return current && current->IsTimeSliceExceeded();
+}
+
 }  // namespace
 
 ScopeTimePause::ScopeTimePause(tracing::ScopeTime* scope) : scope_(scope) {}
@@ -35,17 +44,19 @@ CpuRelax::CpuRelax(std::size_t every, tracing::ScopeTime* scope)
     : pause_(scope), every_iterations_(every) {}
 
 void CpuRelax::Relax() {
-  if (every_iterations_ == 0) return;
-  if (++iterations_ == every_iterations_) {
+  if (every_iterations_ != 0 && ++iterations_ == every_iterations_) {
     iterations_ = 0;
-    pause_.Pause();
     LOG_TRACE() << fmt::format("CPU relax: yielding after {} iterations",
                                every_iterations_);
-    if (engine::current_task::GetTaskProcessorOptional()) {
-      engine::Yield();
-    }
-    pause_.Unpause();
+  } else if (!IsTimeSliceExceeded()) {
+    return;
+  }
+
+  pause_.Pause();
+  if (engine::current_task::GetTaskProcessorOptional()) {
+    engine::Yield();
   }
+  pause_.Unpause();
 }
 
 StreamingCpuRelax::StreamingCpuRelax(std::uint64_t check_time_after_bytes,
@@ -77,6 +88,12 @@ void StreamingCpuRelax::Relax(std::uint64_t bytes_processed) {
       }
       pause_.Unpause();
     }
+  } else if (IsTimeSliceExceeded()) {
+    pause_.Pause();
+    LOG_TRACE() << "StreamingCpuRelax: yielding after the time slice";
+    last_yield_time_ = std::chrono::steady_clock::now();
+    engine::Yield();
+    pause_.Unpause();
   }
 }
 
@@ -0,0 +1,15 @@
+#pragma once
+
+// The engine yield point for the shared code, the universal library has a stub
+
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+inline void CooperativeYield() { engine::YieldIfTimeSliceExceeded(); }
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,12 @@
 #include <cerrno>
 #endif
 
+#include <cstdint>
+
+#include <sys/types.h>
+
+#include <fmt/format.h>
+
 #include <userver/utils/thread_name.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -36,6 +42,29 @@ std::error_code MallCtl(const char* name) {
   return MakeErrorCode(rc);
 }
 
+template <typename T>
+std::error_code MallCtlRead(const char* name, T& value) {
+  size_t size = sizeof(value);
+  int rc = mallctl(name, &value, &size, nullptr, 0);
+  return MakeErrorCode(rc);
+}
+
+std::error_code SetDecay(unsigned arena, const char* kind,
+                         std::optional<std::chrono::milliseconds> decay) {
+  if (!decay) return {};
+  const auto name = fmt::format("arena.{}.{}_decay_ms", arena, kind);
+  return MallCtl<ssize_t>(name.c_str(), decay->count());
+}
+
+std::error_code ReadArenaPages(unsigned arena, const char* kind,
+                               std::size_t page_size, std::size_t& bytes) {
+  const auto name = fmt::format("stats.arenas.{}.{}", arena, kind);
+  std::size_t pages = 0;
+  auto ec = MallCtlRead(name.c_str(), pages);
+  bytes = pages * page_size;
+  return ec;
+}
+
 void MallocStatPrintCb(void* data, const char* msg) {
   auto* s = static_cast<std::string*>(data);
   *s += msg;
@@ -68,6 +97,45 @@ std::error_code StopBgThreads() {
   return MallCtl<bool>("background_thread", false);
 }
 
+std::error_code CreateArena(const ArenaSettings& settings, unsigned& arena) {
+  if (auto ec = MallCtlRead("arenas.create", arena)) return ec;
+  if (auto ec = SetDecay(arena, "dirty", settings.dirty_decay)) return ec;
+  return SetDecay(arena, "muzzy", settings.muzzy_decay);
+}
+
+std::error_code BindCurrentThread(unsigned arena,
+                                  const ArenaSettings& settings) {
+  if (auto ec = MallCtl<unsigned>("thread.arena", arena)) return ec;
+  return MallCtl<bool>("thread.tcache.enabled", settings.tcache);
+}
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats) {
+  // the statistics are refreshed on each epoch increment
+  if (auto ec = MallCtl<std::uint64_t>("epoch", 1)) return ec;
+
+  std::size_t small_allocated = 0;
+  std::size_t large_allocated = 0;
+  const auto small_name =
+      fmt::format("stats.arenas.{}.small.allocated", arena);
+  const auto large_name =
+      fmt::format("stats.arenas.{}.large.allocated", arena);
+  if (auto ec = MallCtlRead(small_name.c_str(), small_allocated)) return ec;
+  if (auto ec = MallCtlRead(large_name.c_str(), large_allocated)) return ec;
+  stats.allocated_bytes = small_allocated + large_allocated;
+
+  std::size_t page_size = 0;
+  if (auto ec = MallCtlRead("arenas.page", page_size)) return ec;
+  if (auto ec = ReadArenaPages(arena, "pactive", page_size,
+                               stats.active_bytes)) {
+    return ec;
+  }
+  if (auto ec = ReadArenaPages(arena, "pdirty", page_size,
+                               stats.dirty_bytes)) {
+    return ec;
+  }
+  return ReadArenaPages(arena, "pmuzzy", page_size, stats.muzzy_bytes);
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
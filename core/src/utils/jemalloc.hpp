@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <optional>
 #include <string>
 #include <system_error>
 
@@ -22,6 +25,31 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+struct ArenaSettings {
+  /// Whether the threads of the arena cache the small allocations
+  bool tcache{true};
+  /// How long the unused dirty and muzzy pages are kept before being purged,
+  /// the jemalloc defaults are used if not set
+  std::optional<std::chrono::milliseconds> dirty_decay;
+  std::optional<std::chrono::milliseconds> muzzy_decay;
+};
+
+struct ArenaStats {
+  std::size_t allocated_bytes{0};
+  std::size_t active_bytes{0};
+  std::size_t dirty_bytes{0};
+  std::size_t muzzy_bytes{0};
+};
+
+/// Creates a new arena with the given decay settings
+std::error_code CreateArena(const ArenaSettings& settings, unsigned& arena);
+
+/// Makes the current thread allocate from the arena
+std::error_code BindCurrentThread(unsigned arena,
+                                  const ArenaSettings& settings);
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats);
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <userver/utils/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::parallel::impl {
+
+namespace {
+
+constexpr std::size_t kChunksPerTask = 4;
+
+std::size_t GetMaxTasks(const Settings& settings) {
+  if (settings.max_tasks != 0) return settings.max_tasks;
+  return std::max<std::size_t>(
+      engine::current_task::GetTaskProcessor().GetWorkerCount(), 1);
+}
+
+bool ShouldStop(const Settings& settings) {
+  return engine::current_task::ShouldCancel() ||
+         settings.deadline.IsReached();
+}
+
+}  // namespace
+
+std::size_t GetChunkSize(std::size_t size, const Settings& settings) {
+  if (settings.grain_size != 0) return settings.grain_size;
+  const auto chunk_count = GetMaxTasks(settings) * kChunksPerTask;
+  return std::max<std::size_t>((size + chunk_count - 1) / chunk_count, 1);
+}
+
+void RunJobs(std::size_t job_count, const Settings& settings,
+             const std::function<void(std::size_t job)>& job) {
+  if (job_count == 0) return;
+
+  std::atomic<std::size_t> next_job{0};
+  const auto run_jobs = [&] {
+    while (!ShouldStop(settings)) {
+      const auto current_job = next_job.fetch_add(1, std::memory_order_relaxed);
+      if (current_job >= job_count) return;
+      job(current_job);
+    }
+  };
+
+  const auto task_count = std::min(GetMaxTasks(settings), job_count);
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(task_count - 1);
+  auto& task_processor = engine::current_task::GetTaskProcessor();
+  for (std::size_t i = 1; i < task_count; ++i) {
+    tasks.push_back(utils::Async(task_processor, "parallel_jobs",
+                                 settings.deadline, run_jobs));
+  }
+
+  run_jobs();
+  engine::GetAll(tasks);
+
+  if (next_job.load() < job_count) {
+    // Some jobs were not started
+    throw engine::WaitInterruptedException(
+        engine::current_task::ShouldCancel()
+            ? engine::current_task::CancellationReason()
+            : engine::TaskCancellationReason::kDeadline);
+  }
+}
+
+}  // namespace utils::parallel::impl
+
+USERVER_NAMESPACE_END
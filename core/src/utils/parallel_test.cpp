@@ -0,0 +1,148 @@
+#include <userver/utils/parallel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<int> MakeRange(int size) {
+  std::vector<int> result(size);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+}  // namespace
+
+UTEST_MT(Parallel, Sample, 4) {
+  /// [Sample utils::parallel usage]
+  std::vector<int> values = MakeRange(10000);
+
+  utils::parallel::ForEach(values.begin(), values.end(),
+                           [](int& value) { value *= 2; });
+
+  std::vector<std::string> strings(values.size());
+  utils::parallel::Transform(values.begin(), values.end(), strings.begin(),
+                             [](int value) { return std::to_string(value); });
+
+  const auto sum = utils::parallel::Reduce(values.begin(), values.end(),
+                                           std::int64_t{0}, std::plus<>{});
+
+  utils::parallel::Sort(values.begin(), values.end(), std::greater<>{},
+                        {/*grain_size=*/1000});
+  /// [Sample utils::parallel usage]
+
+  EXPECT_EQ(strings[42], "84");
+  EXPECT_EQ(sum, std::int64_t{9999} * 10000);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), std::greater<>{}));
+}
+
+UTEST_MT(Parallel, ForEachVisitsAllOnce, 4) {
+  std::vector<std::atomic<int>> visits(1000);
+  for (const std::size_t grain_size : {1, 7, 1000, 5000}) {
+    for (auto& visit : visits) visit = 0;
+    utils::parallel::ForEach(visits.begin(), visits.end(),
+                             [](std::atomic<int>& visit) { ++visit; },
+                             {grain_size});
+    for (const auto& visit : visits) ASSERT_EQ(visit.load(), 1);
+  }
+}
+
+UTEST_MT(Parallel, Reduce, 4) {
+  const auto values = MakeRange(1001);
+  for (const std::size_t grain_size : {0, 1, 10, 2000}) {
+    EXPECT_EQ(utils::parallel::Reduce(values.begin(), values.end(), 5,
+                                      std::plus<>{}, {grain_size}),
+              5 + 1000 * 1001 / 2);
+  }
+
+  // order of the non-commutative operation is kept
+  const std::vector<std::string> letters{"a", "b", "c", "d", "e"};
+  EXPECT_EQ(utils::parallel::Reduce(letters.begin(), letters.end(),
+                                    std::string{">"}, std::plus<>{}, {2}),
+            ">abcde");
+
+  const std::vector<int> empty;
+  EXPECT_EQ(utils::parallel::Reduce(empty.begin(), empty.end(), 3,
+                                    std::plus<>{}),
+            3);
+}
+
+UTEST_MT(Parallel, Sort, 4) {
+  for (const std::size_t grain_size : {0, 1, 3, 100, 10000}) {
+    std::vector<int> values(1234);
+    for (auto& value : values) value = utils::RandRange(100);
+    utils::parallel::Sort(values.begin(), values.end(), {grain_size});
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  }
+}
+
+UTEST_MT(Parallel, Exception, 4) {
+  auto values = MakeRange(100);
+  UEXPECT_THROW(utils::parallel::ForEach(values.begin(), values.end(),
+                                         [](int value) {
+                                           if (value == 50) {
+                                             throw std::runtime_error("50");
+                                           }
+                                         },
+                                         {/*grain_size=*/1}),
+                std::runtime_error);
+}
+
+UTEST_MT(Parallel, Deadline, 2) {
+  auto values = MakeRange(100);
+  std::atomic<int> calls{0};
+  utils::parallel::Settings settings;
+  settings.grain_size = 1;
+  settings.deadline = engine::Deadline::FromDuration(20ms);
+
+  UEXPECT_THROW(utils::parallel::ForEach(values.begin(), values.end(),
+                                         [&calls](int) {
+                                           ++calls;
+                                           engine::SleepFor(5ms);
+                                         },
+                                         settings),
+                engine::WaitInterruptedException);
+  EXPECT_LT(calls.load(), 100);
+}
+
+UTEST_MT(Parallel, Cancellation, 2) {
+  auto values = MakeRange(100);
+  std::atomic<int> calls{0};
+
+  auto task = engine::AsyncNoSpan([&] {
+    try {
+      utils::parallel::ForEach(
+          values.begin(), values.end(),
+          [&calls](int) {
+            if (++calls == 10) {
+              engine::current_task::GetCancellationToken().RequestCancel();
+            }
+          },
+          {/*grain_size=*/1, /*max_tasks=*/1});
+    } catch (const engine::WaitInterruptedException&) {
+      return true;
+    }
+    return false;
+  });
+
+  EXPECT_TRUE(task.Get());
+  EXPECT_EQ(calls.load(), 10);
+}
+
+USERVER_NAMESPACE_END
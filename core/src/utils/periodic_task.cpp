@@ -9,6 +9,7 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/utils/periodic_task_scheduler.hpp>
 #include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -59,6 +60,19 @@ void PeriodicTask::Start(std::string name, Settings settings,
 void PeriodicTask::DoStart() {
   LOG_INFO() << "Starting PeriodicTask with name=" << name_;
   auto settings_ptr = settings_.Read();
+  if (settings_ptr->scheduler) {
+    const auto now = std::chrono::steady_clock::now();
+    period_start_ = now;
+    scheduler_ = settings_ptr->scheduler;
+    scheduler_->Register(
+        *this,
+        settings_ptr->flags & Flags::kNow
+            ? now
+            : now + MutatePeriod(settings_ptr->period),
+        settings_ptr->period);
+    return;
+  }
+
   auto& task_processor = settings_ptr->task_processor
                              ? *settings_ptr->task_processor
                              : engine::current_task::GetTaskProcessor();
@@ -74,8 +88,13 @@ void PeriodicTask::Stop() noexcept {
   try {
     if (IsRunning()) {
       LOG_INFO() << "Stopping PeriodicTask with name=" << name_;
-      task_.SyncCancel();
-      task_ = engine::TaskWithResult<void>();
+      if (scheduler_) {
+        scheduler_->Unregister(*this);
+        scheduler_ = nullptr;
+      } else {
+        task_.SyncCancel();
+        task_ = engine::TaskWithResult<void>();
+      }
       LOG_INFO() << "Stopped PeriodicTask with name=" << name_;
     }
   } catch (std::exception& e) {
@@ -91,6 +110,7 @@ void PeriodicTask::SetSettings(Settings settings) {
   {
     auto writer = settings_.StartWrite();
     settings.flags = writer->flags;
+    settings.scheduler = writer->scheduler;
     has_changed = settings.period != writer->period;
     *writer = std::move(settings);
     writer.Commit();
@@ -99,7 +119,13 @@ void PeriodicTask::SetSettings(Settings settings) {
   if (has_changed) {
     LOG_DEBUG() << "periodic task settings have changed, signalling name="
                 << name_;
-    changed_event_.Send();
+    if (scheduler_) {
+      const auto period = GetCurrentSettings().period;
+      scheduler_->Reschedule(*this, period_start_.load() + MutatePeriod(period),
+                             period);
+    } else {
+      changed_event_.Send();
+    }
   }
 }
 
@@ -111,16 +137,34 @@ bool PeriodicTask::SynchronizeDebug(bool preserve_span) {
   return StepDebug(preserve_span);
 }
 
-bool PeriodicTask::IsRunning() const { return task_.IsValid(); }
+void PeriodicTask::ForceStepAsync() {
+  should_force_step_ = true;
+  if (scheduler_) {
+    scheduler_->Reschedule(*this, std::chrono::steady_clock::now(),
+                           GetCurrentSettings().period);
+  } else {
+    changed_event_.Send();
+  }
+}
+
+bool PeriodicTask::IsRunning() const {
+  return task_.IsValid() || scheduler_ != nullptr;
+}
 
 void PeriodicTask::Run() {
   {
     auto settings = settings_.Read();
-    if (!(settings->flags & Flags::kNow))
-      engine::InterruptibleSleepFor(MutatePeriod(settings->period));
+    if (!(settings->flags & Flags::kNow)) {
+      const auto deadline = engine::Deadline::FromDuration(
+          MutatePeriod(settings->period));
+      while (changed_event_.WaitForEventUntil(deadline) &&
+             !should_force_step_) {
+      }
+    }
   }
 
   while (!engine::current_task::ShouldCancel()) {
+    should_force_step_ = false;
     const auto before = std::chrono::steady_clock::now();
     bool no_exception = Step();
     auto settings = settings_.Read();
@@ -137,6 +181,7 @@ void PeriodicTask::Run() {
     }
 
     while (changed_event_.WaitForEventUntil(start + MutatePeriod(period))) {
+      if (should_force_step_) break;
       // The config variable value has been changed, reload
       auto settings = settings_.Read();
       period = settings->period;
@@ -144,6 +189,28 @@ void PeriodicTask::Run() {
   }
 }
 
+PeriodicTask::NextStep PeriodicTask::ScheduledStep() {
+  should_force_step_ = false;
+  const auto before = std::chrono::steady_clock::now();
+  const bool no_exception = Step();
+
+  auto settings = settings_.Read();
+  const auto period = settings->period;
+  const auto start = settings->flags & Flags::kStrong
+                         ? before
+                         : std::chrono::steady_clock::now();
+  period_start_ = start;
+
+  const auto wait_period =
+      no_exception ? period : settings->exception_period.value_or(period);
+  return {start + MutatePeriod(wait_period), period};
+}
+
+bool PeriodicTask::IsCritical() const {
+  const auto settings = settings_.Read();
+  return static_cast<bool>(settings->flags & Flags::kCritical);
+}
+
 bool PeriodicTask::DoStep() {
   auto settings_ptr = settings_.Read();
   const auto span_log_level = settings_ptr->span_level;
@@ -0,0 +1,174 @@
+#include <userver/utils/periodic_task_scheduler.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+engine::TaskProcessor& GetTaskProcessor(
+    const PeriodicTaskScheduler::Settings& settings) {
+  return settings.task_processor ? *settings.task_processor
+                                 : engine::current_task::GetTaskProcessor();
+}
+
+}  // namespace
+
+PeriodicTaskScheduler::PeriodicTaskScheduler()
+    : PeriodicTaskScheduler(Settings{}) {}
+
+PeriodicTaskScheduler::PeriodicTaskScheduler(Settings settings)
+    : settings_(settings), task_processor_(GetTaskProcessor(settings_)) {
+  // the steps of the critical periodic tasks must not wait for a cancelled
+  // scheduler
+  loop_task_ = engine::CriticalAsyncNoSpan(task_processor_,
+                                           &PeriodicTaskScheduler::Run, this);
+}
+
+PeriodicTaskScheduler::~PeriodicTaskScheduler() {
+  UASSERT_MSG(GetTasksCount() == 0,
+              "All the periodic tasks must be stopped before the scheduler "
+              "is destroyed");
+  loop_task_.SyncCancel();
+  steps_.CancelAndWait();
+}
+
+std::size_t PeriodicTaskScheduler::GetTasksCount() const {
+  std::lock_guard lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t PeriodicTaskScheduler::GetRunningStepsCount() const {
+  std::lock_guard lock(mutex_);
+  return running_steps_;
+}
+
+void PeriodicTaskScheduler::Register(PeriodicTask& task,
+                                     Clock::time_point first_step,
+                                     std::chrono::milliseconds period) {
+  std::lock_guard lock(mutex_);
+  auto [it, inserted] = entries_.try_emplace(&task);
+  UASSERT_MSG(inserted, "The periodic task is already registered");
+  Enqueue(task, it->second, first_step, period);
+}
+
+void PeriodicTaskScheduler::Reschedule(PeriodicTask& task,
+                                       Clock::time_point next_step,
+                                       std::chrono::milliseconds period) {
+  std::lock_guard lock(mutex_);
+  const auto it = entries_.find(&task);
+  if (it == entries_.end() || !it->second.queued) return;
+
+  auto& entry = it->second;
+  queue_.erase(*entry.queued);
+  Enqueue(task, entry, next_step, period);
+}
+
+void PeriodicTaskScheduler::Unregister(PeriodicTask& task) noexcept {
+  // Stop() of a cancelled task still has to wait for the step
+  engine::TaskCancellationBlocker cancel_blocker;
+
+  std::unique_lock lock(mutex_);
+  const auto it = entries_.find(&task);
+  if (it == entries_.end()) return;
+
+  auto& entry = it->second;
+  entry.is_removed = true;
+  if (entry.queued) {
+    queue_.erase(*entry.queued);
+    entry.queued.reset();
+  }
+  if (entry.running.IsValid()) {
+    entry.running.RequestCancel();
+    [[maybe_unused]] const bool finished = step_finished_cv_.Wait(
+        lock, [&entry] { return !entry.running.IsValid(); });
+    UASSERT(finished);
+  }
+  entries_.erase(it);
+}
+
+void PeriodicTaskScheduler::Enqueue(PeriodicTask& task, Entry& entry,
+                                    Clock::time_point next_step,
+                                    std::chrono::milliseconds period) {
+  UASSERT(!entry.queued);
+  entry.slack = std::min<Clock::duration>(settings_.slack, period / 4);
+  const auto queued = queue_.emplace(next_step, &task);
+  entry.queued = queued;
+  if (queued == queue_.begin()) queue_changed_event_.Send();
+}
+
+void PeriodicTaskScheduler::Run() {
+  std::vector<PeriodicTask*> due;
+
+  while (!engine::current_task::ShouldCancel()) {
+    auto deadline = engine::Deadline{};
+    {
+      std::lock_guard lock(mutex_);
+      const auto now = Clock::now();
+      const auto batch_end = queue_.upper_bound(now + settings_.slack);
+      for (auto it = queue_.begin(); it != batch_end;) {
+        auto& entry = entries_.at(it->second);
+        if (it->first - entry.slack > now) {
+          ++it;
+          continue;
+        }
+        due.push_back(it->second);
+        entry.queued.reset();
+        it = queue_.erase(it);
+      }
+
+      for (auto* task : due) {
+        auto step = task->IsCritical()
+                        ? engine::CriticalAsyncNoSpan(
+                              task_processor_, &PeriodicTaskScheduler::RunStep,
+                              this, std::ref(*task))
+                        : engine::AsyncNoSpan(task_processor_,
+                                              &PeriodicTaskScheduler::RunStep,
+                                              this, std::ref(*task));
+        entries_.at(task).running = engine::TaskCancellationToken{step};
+        ++running_steps_;
+        steps_.Detach(std::move(step));
+      }
+      due.clear();
+
+      if (!queue_.empty()) {
+        deadline = engine::Deadline::FromTimePoint(queue_.begin()->first);
+      }
+    }
+
+    [[maybe_unused]] const bool changed =
+        queue_changed_event_.WaitForEventUntil(deadline);
+  }
+}
+
+void PeriodicTaskScheduler::RunStep(PeriodicTask& task) {
+  const auto next_step = task.ScheduledStep();
+
+  std::lock_guard lock(mutex_);
+  auto& entry = entries_.at(&task);
+  entry.running = {};
+  --running_steps_;
+  if (entry.is_removed) {
+    step_finished_cv_.NotifyAll();
+    return;
+  }
+  // ForceStepAsync() during the step could not reschedule a running task
+  Enqueue(task, entry,
+          task.should_force_step_ ? Clock::now() : next_step.time,
+          next_step.period);
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
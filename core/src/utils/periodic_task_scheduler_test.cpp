@@ -0,0 +1,168 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/periodic_task_scheduler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Flags = utils::PeriodicTask::Flags;
+
+template <typename Pred>
+bool PollUntil(Pred pred) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!pred()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  return true;
+}
+
+}  // namespace
+
+UTEST_MT(PeriodicTaskScheduler, ManyTasks, 4) {
+  constexpr std::size_t kTasksCount = 100;
+
+  /// [Sample periodic task scheduler]
+  utils::PeriodicTaskScheduler scheduler{{std::chrono::milliseconds{5}}};
+
+  std::atomic<std::size_t> steps{0};
+  std::vector<std::unique_ptr<utils::PeriodicTask>> tasks;
+  for (std::size_t i = 0; i < kTasksCount; ++i) {
+    utils::PeriodicTask::Settings settings{std::chrono::milliseconds{10},
+                                           Flags::kNow};
+    // the tasks sleep in the scheduler, not in their own coroutines
+    settings.scheduler = &scheduler;
+    tasks.push_back(std::make_unique<utils::PeriodicTask>(
+        "tenant-refresher", settings, [&steps] { ++steps; }));
+  }
+  /// [Sample periodic task scheduler]
+
+  EXPECT_EQ(scheduler.GetTasksCount(), kTasksCount);
+  EXPECT_TRUE(PollUntil([&] { return steps >= kTasksCount * 3; }));
+
+  for (auto& task : tasks) {
+    EXPECT_TRUE(task->IsRunning());
+    task->Stop();
+    EXPECT_FALSE(task->IsRunning());
+  }
+  EXPECT_EQ(scheduler.GetTasksCount(), 0);
+  EXPECT_EQ(scheduler.GetRunningStepsCount(), 0);
+
+  const auto steps_after_stop = steps.load();
+  engine::SleepFor(std::chrono::milliseconds{50});
+  EXPECT_EQ(steps, steps_after_stop);
+}
+
+UTEST(PeriodicTaskScheduler, NoCoroutineBetweenSteps) {
+  utils::PeriodicTaskScheduler scheduler;
+
+  utils::PeriodicTask::Settings settings{std::chrono::hours{1}};
+  settings.scheduler = &scheduler;
+  std::atomic<int> steps{0};
+  utils::PeriodicTask task{"task", settings, [&steps] { ++steps; }};
+
+  EXPECT_TRUE(task.IsRunning());
+  EXPECT_EQ(scheduler.GetTasksCount(), 1);
+  EXPECT_EQ(scheduler.GetRunningStepsCount(), 0);
+
+  engine::SleepFor(std::chrono::milliseconds{20});
+  EXPECT_EQ(steps, 0);
+
+  task.ForceStepAsync();
+  EXPECT_TRUE(PollUntil([&] { return steps == 1; }));
+  EXPECT_TRUE(PollUntil([&] { return scheduler.GetRunningStepsCount() == 0; }));
+}
+
+UTEST(PeriodicTaskScheduler, Coalescing) {
+  utils::PeriodicTaskScheduler scheduler{{std::chrono::seconds{1}}};
+  const auto start = std::chrono::steady_clock::now();
+
+  std::atomic<bool> first_step{false};
+  std::atomic<bool> second_step{false};
+  std::atomic<std::chrono::steady_clock::time_point> second_step_time{};
+
+  utils::PeriodicTask::Settings first_settings{std::chrono::milliseconds{800}};
+  first_settings.scheduler = &scheduler;
+  utils::PeriodicTask::Settings second_settings{std::chrono::seconds{1}};
+  second_settings.scheduler = &scheduler;
+
+  utils::PeriodicTask first{"first", first_settings,
+                            [&first_step] { first_step = true; }};
+  utils::PeriodicTask second{"second", second_settings, [&] {
+                               second_step_time =
+                                   std::chrono::steady_clock::now();
+                               second_step = true;
+                             }};
+
+  EXPECT_TRUE(PollUntil([&] { return first_step && second_step; }));
+  // the second step is due in 1s, its slack is a quarter of the period, so it
+  // wakes up together with the first one
+  EXPECT_LT(second_step_time.load() - start, std::chrono::milliseconds{950});
+}
+
+UTEST(PeriodicTaskScheduler, SlackIsLimitedByPeriod) {
+  utils::PeriodicTaskScheduler scheduler{{std::chrono::milliseconds{200}}};
+
+  engine::SingleConsumerEvent first_step;
+  std::atomic<bool> second_step{false};
+
+  utils::PeriodicTask::Settings first_settings{std::chrono::milliseconds{50}};
+  first_settings.scheduler = &scheduler;
+  utils::PeriodicTask::Settings second_settings{std::chrono::seconds{1}};
+  second_settings.scheduler = &scheduler;
+
+  utils::PeriodicTask second{"second", second_settings,
+                             [&second_step] { second_step = true; }};
+  utils::PeriodicTask first{"first", first_settings,
+                            [&first_step] { first_step.Send(); }};
+
+  ASSERT_TRUE(first_step.WaitForEventFor(utest::kMaxTestWaitTime));
+  // the second step is not within the slack of the first one
+  EXPECT_FALSE(second_step);
+}
+
+UTEST(PeriodicTaskScheduler, StopCancelsStep) {
+  utils::PeriodicTaskScheduler scheduler;
+
+  engine::SingleConsumerEvent started;
+  utils::PeriodicTask::Settings settings{std::chrono::milliseconds{10},
+                                         Flags::kNow};
+  settings.scheduler = &scheduler;
+  utils::PeriodicTask task{"task", settings, [&started] {
+                             started.Send();
+                             engine::InterruptibleSleepFor(
+                                 utest::kMaxTestWaitTime);
+                           }};
+
+  ASSERT_TRUE(started.WaitForEventFor(utest::kMaxTestWaitTime));
+  EXPECT_EQ(scheduler.GetRunningStepsCount(), 1);
+
+  task.Stop();
+  EXPECT_FALSE(task.IsRunning());
+  EXPECT_EQ(scheduler.GetRunningStepsCount(), 0);
+}
+
+UTEST(PeriodicTaskScheduler, SetSettings) {
+  utils::PeriodicTaskScheduler scheduler;
+
+  utils::PeriodicTask::Settings settings{std::chrono::hours{1}};
+  settings.scheduler = &scheduler;
+  std::atomic<int> steps{0};
+  utils::PeriodicTask task{"task", settings, [&steps] { ++steps; }};
+
+  // the scheduler is kept, as the flags are
+  task.SetSettings(std::chrono::milliseconds{10});
+  EXPECT_EQ(task.GetCurrentSettings().scheduler, &scheduler);
+  EXPECT_TRUE(PollUntil([&] { return steps >= 2; }));
+}
+
+USERVER_NAMESPACE_END
@@ -247,6 +247,25 @@ UTEST(PeriodicTask, SetSettingsInstant) {
   task.Stop();
 }
 
+UTEST(PeriodicTask, ForceStepAsync) {
+  SimpleTaskData simple;
+
+  utils::PeriodicTask task("task", utest::kMaxTestWaitTime,
+                           simple.GetTaskFunction());
+  task.ForceStepAsync();
+  EXPECT_TRUE(simple.WaitFor(utest::kMaxTestWaitTime,
+                             [&simple]() { return simple.GetCount() == 1; }));
+
+  task.ForceStepAsync();
+  EXPECT_TRUE(simple.WaitFor(utest::kMaxTestWaitTime,
+                             [&simple]() { return simple.GetCount() == 2; }));
+
+  // the period is counted from the forced step
+  EXPECT_FALSE(simple.WaitFor(std::chrono::milliseconds(10),
+                              [&simple]() { return simple.GetCount() > 2; }));
+  task.Stop();
+}
+
 UTEST(PeriodicTask, StopStop) {
   SimpleTaskData simple;
 
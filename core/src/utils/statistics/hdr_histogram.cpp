@@ -0,0 +1,51 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+std::uint64_t HdrHistogramView::GetUpperBoundAt(
+    std::size_t index) const noexcept {
+  UASSERT(index < bucket_count_);
+  return impl::hdr::GetBucketUpperBound(index, precision_bits_);
+}
+
+std::uint64_t HdrHistogramView::GetValueAt(std::size_t index) const noexcept {
+  UASSERT(index < bucket_count_);
+  return buckets_[index].load(std::memory_order_relaxed);
+}
+
+std::uint64_t HdrHistogramView::GetTotalCount() const noexcept {
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < bucket_count_; ++i) {
+    total += buckets_[i].load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+std::uint64_t HdrHistogramView::GetSum() const noexcept {
+  return sum_->load(std::memory_order_relaxed);
+}
+
+std::uint64_t HdrHistogramView::GetPercentile(double percent) const noexcept {
+  const auto total = GetTotalCount();
+  if (total == 0) return 0;
+
+  // the same semantics as in utils::statistics::Percentile
+  const auto want_sum = static_cast<double>(total) * percent;
+  std::uint64_t sum = 0;
+  std::size_t max_index = 0;
+  for (std::size_t i = 0; i < bucket_count_; ++i) {
+    const auto value = buckets_[i].load(std::memory_order_relaxed);
+    sum += value;
+    if (static_cast<double>(sum) * 100 > want_sum) return GetUpperBoundAt(i);
+    if (value) max_index = i;
+  }
+  return GetUpperBoundAt(max_index);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
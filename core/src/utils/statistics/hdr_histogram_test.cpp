@@ -0,0 +1,119 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Histogram = utils::statistics::HdrHistogram<>;
+
+}  // namespace
+
+TEST(HdrHistogram, Layout) {
+  namespace hdr = utils::statistics::impl::hdr;
+  constexpr std::size_t kPrecision = 5;
+  constexpr std::size_t kMaxBits = 36;
+
+  for (std::uint64_t value = 0; value < (1 << 20); ++value) {
+    const auto index = hdr::GetBucketIndex(value, kPrecision, kMaxBits);
+    ASSERT_LE(value, hdr::GetBucketUpperBound(index, kPrecision));
+    if (index > 0) {
+      ASSERT_GT(value, hdr::GetBucketUpperBound(index - 1, kPrecision));
+    }
+  }
+
+  const auto last = hdr::GetBucketCount(kPrecision, kMaxBits) - 1;
+  EXPECT_EQ(hdr::GetBucketIndex((std::uint64_t{1} << kMaxBits) - 1,
+                                kPrecision, kMaxBits),
+            last);
+  EXPECT_EQ(hdr::GetBucketIndex(std::numeric_limits<std::uint64_t>::max(),
+                                kPrecision, kMaxBits),
+            last);
+  EXPECT_EQ(hdr::GetBucketUpperBound(last, kPrecision),
+            (std::uint64_t{1} << kMaxBits) - 1);
+}
+
+TEST(HdrHistogram, Zero) {
+  Histogram h;
+
+  EXPECT_EQ(h.GetPercentile(0), 0);
+  EXPECT_EQ(h.GetPercentile(50), 0);
+  EXPECT_EQ(h.GetPercentile(100), 0);
+  EXPECT_EQ(h.Count(), 0);
+}
+
+TEST(HdrHistogram, ExactSmallValues) {
+  Histogram h;
+  for (int i = 0; i < 32; i++) h.Account(i);
+
+  EXPECT_EQ(h.GetPercentile(0), 0);
+  EXPECT_EQ(h.GetPercentile(50), 16);
+  EXPECT_EQ(h.GetPercentile(100), 31);
+  EXPECT_EQ(h.Count(), 32);
+  EXPECT_EQ(h.GetView().GetSum(), 31 * 32 / 2);
+}
+
+TEST(HdrHistogram, RelativeError) {
+  for (std::uint64_t value = 1; value < (std::uint64_t{1} << 35);
+       value = value * 3 + 1) {
+    Histogram h;
+    h.Account(value);
+
+    const auto result = h.GetPercentile(50);
+    EXPECT_GE(result, value);
+    EXPECT_LE(static_cast<double>(result - value) / value, 1.0 / 32)
+        << "value=" << value;
+  }
+}
+
+TEST(HdrHistogram, Overflow) {
+  Histogram h;
+  h.Account(std::numeric_limits<std::uint32_t>::max() * 100ULL);
+
+  EXPECT_EQ(h.Count(), 1);
+  EXPECT_EQ(h.GetView().GetValueAt(Histogram::kBucketCount - 1), 1);
+}
+
+TEST(HdrHistogram, Add) {
+  Histogram first;
+  Histogram second;
+  for (int i = 0; i < 50; i++) first.Account(i * 1000);
+  for (int i = 50; i < 100; i++) second.Account(i * 1000);
+
+  Histogram total = first;
+  total.Add(second);
+  EXPECT_EQ(total.Count(), 100);
+  EXPECT_EQ(total.GetView().GetSum(),
+            first.GetView().GetSum() + second.GetView().GetSum());
+  EXPECT_NEAR(total.GetPercentile(50), 50000, 50000 / 32);
+
+  total.Reset();
+  EXPECT_EQ(total.Count(), 0);
+  EXPECT_EQ(total.GetView().GetSum(), 0);
+}
+
+TEST(HdrHistogram, Concurrent) {
+  constexpr std::size_t kThreads = 4;
+  constexpr std::size_t kIterations = 10000;
+
+  Histogram h;
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&h] {
+      for (std::size_t j = 0; j < kIterations; ++j) h.Account(j);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(h.Count(), kThreads * kIterations);
+  EXPECT_EQ(h.GetView().GetSum(),
+            kThreads * (kIterations - 1) * kIterations / 2);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,30 @@
+#include <utils/statistics/labels_cache.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+std::uint64_t RenderedLabelsCache::Hash(LabelsSpan labels) noexcept {
+  std::uint64_t hash = labels.size();
+  for (const auto& label : labels) {
+    hash = utils::HashBytes(label.Name(), hash);
+    hash = utils::HashBytes(label.Value(), hash);
+  }
+  return hash;
+}
+
+bool RenderedLabelsCache::IsSame(const Entry& entry,
+                                 LabelsSpan labels) noexcept {
+  return std::equal(entry.labels.begin(), entry.labels.end(), labels.begin(),
+                    labels.end(), [](const Label& x, const LabelView& y) {
+                      return x.Name() == y.Name() && x.Value() == y.Value();
+                    });
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
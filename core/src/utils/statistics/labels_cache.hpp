@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/utils/statistics/labels.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+/// @brief Interned label sets with the text rendered for each of them by a
+/// metrics format.
+///
+/// Metrics written by the same writer mostly share the label set, so the
+/// formatters render the labels once per distinct set instead of once per
+/// metric. The last used set is checked first, as the metrics with the same
+/// labels usually go in a row.
+class RenderedLabelsCache final {
+ public:
+  /// The cache is cleared when it holds that many label sets
+  static constexpr std::size_t kMaxSize = 100'000;
+
+  RenderedLabelsCache() = default;
+  RenderedLabelsCache(const RenderedLabelsCache&) = delete;
+  RenderedLabelsCache& operator=(const RenderedLabelsCache&) = delete;
+
+  /// Returns the text for `labels`, calls `render(labels, text)` to fill the
+  /// text of a new label set. The result is valid until the next call.
+  template <typename RenderFunc>
+  std::string_view Get(LabelsSpan labels, RenderFunc&& render) {
+    if (last_ && IsSame(*last_, labels)) return last_->text;
+
+    const auto hash = Hash(labels);
+    const auto [begin, end] = entries_.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      if (IsSame(it->second, labels)) {
+        last_ = &it->second;
+        return last_->text;
+      }
+    }
+
+    std::string text;
+    render(labels, text);
+    if (entries_.size() >= kMaxSize) entries_.clear();
+    std::vector<Label> owned_labels(labels.begin(), labels.end());
+    last_ = &entries_.emplace(hash, Entry{std::move(owned_labels),
+                                          std::move(text)})
+                 ->second;
+    return last_->text;
+  }
+
+  std::size_t GetSize() const noexcept { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::vector<Label> labels;
+    std::string text;
+  };
+
+  static std::uint64_t Hash(LabelsSpan labels) noexcept;
+
+  static bool IsSame(const Entry& entry, LabelsSpan labels) noexcept;
+
+  std::unordered_multimap<std::uint64_t, Entry> entries_;
+  const Entry* last_{nullptr};
+};
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,75 @@
+#include <utils/statistics/labels_cache.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+std::size_t render_count = 0;
+
+void Render(LabelsSpan labels, std::string& out) {
+  ++render_count;
+  for (const auto& label : labels) {
+    out.append(label.Name()).append("=").append(label.Value()).append(";");
+  }
+}
+
+}  // namespace
+
+TEST(RenderedLabelsCache, Basic) {
+  render_count = 0;
+  RenderedLabelsCache cache;
+
+  const std::vector<LabelView> first{{"a", "1"}, {"b", "2"}};
+  const std::vector<LabelView> second{{"a", "1"}};
+
+  EXPECT_EQ(cache.Get(LabelsSpan{first}, &Render), "a=1;b=2;");
+  EXPECT_EQ(cache.Get(LabelsSpan{first}, &Render), "a=1;b=2;");
+  EXPECT_EQ(render_count, 1);
+
+  EXPECT_EQ(cache.Get(LabelsSpan{second}, &Render), "a=1;");
+  EXPECT_EQ(cache.Get(LabelsSpan{first}, &Render), "a=1;b=2;");
+  EXPECT_EQ(cache.Get(LabelsSpan{}, &Render), "");
+  EXPECT_EQ(cache.Get(LabelsSpan{}, &Render), "");
+  EXPECT_EQ(render_count, 3);
+  EXPECT_EQ(cache.GetSize(), 3);
+}
+
+TEST(RenderedLabelsCache, ComparesContents) {
+  render_count = 0;
+  RenderedLabelsCache cache;
+
+  // the views of the writers point to different memory on each scrape
+  std::string value = "1";
+  const std::vector<LabelView> labels{{"a", value}};
+  EXPECT_EQ(cache.Get(LabelsSpan{labels}, &Render), "a=1;");
+
+  value = "2";
+  const std::vector<LabelView> changed{{"a", value}};
+  EXPECT_EQ(cache.Get(LabelsSpan{changed}, &Render), "a=2;");
+
+  const std::string copy = "a";
+  const std::vector<LabelView> same{{copy, "2"}};
+  EXPECT_EQ(cache.Get(LabelsSpan{same}, &Render), "a=2;");
+  EXPECT_EQ(render_count, 2);
+}
+
+TEST(RenderedLabelsCache, Overflow) {
+  RenderedLabelsCache cache;
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i <= RenderedLabelsCache::kMaxSize; ++i) {
+    const auto value = std::to_string(i);
+    const std::vector<LabelView> labels{{"i", value}};
+    EXPECT_EQ(cache.Get(LabelsSpan{labels}, &Render), "i=" + value + ";");
+  }
+  EXPECT_EQ(cache.GetSize(), 1);
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
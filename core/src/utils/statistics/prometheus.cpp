@@ -3,14 +3,20 @@
 #include <algorithm>
 #include <iterator>
 #include <unordered_map>
+#include <unordered_set>
+
+#include <boost/functional/hash.hpp>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <userver/utils/algo.hpp>
 #include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
+#include <utils/statistics/prometheus_cache.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
@@ -24,57 +30,238 @@ enum class Typed { kYes, kNo };
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
  public:
-  explicit FormatBuilder() = default;
+  explicit FormatBuilder(RenderedLabelsCache& labels_cache)
+      : labels_cache_(labels_cache) {}
 
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
-    DumpMetricName(std::string{path});
+    buf_.append(GetMetricName(path, "gauge"));
     DumpLabels(labels);
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
   }
 
+  // Only the non-empty buckets are written to keep the output small. The last
+  // bucket also holds the values that do not fit the histogram, so it is
+  // written only as a part of "+Inf".
+  void HandleHistogram(std::string_view path,
+                       utils::statistics::LabelsSpan labels,
+                       const HdrHistogramView& histogram) override {
+    const auto& name = GetMetricName(path, "histogram");
+    const auto last = histogram.GetBucketCount() - 1;
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < last; ++i) {
+      const auto value = histogram.GetValueAt(i);
+      if (value == 0) continue;
+      total += value;
+
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"), name);
+      DumpLabels(labels, fmt::to_string(histogram.GetUpperBoundAt(i)));
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+    }
+
+    total += histogram.GetValueAt(last);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"), name);
+    DumpLabels(labels, "+Inf");
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_sum"), name);
+    DumpLabels(labels);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"),
+                   histogram.GetSum());
+
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_count"), name);
+    DumpLabels(labels);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+  }
+
   std::string Release() { return fmt::to_string(buf_); }
 
+  void ReleaseFragment(PrometheusFormatCache::Fragment& fragment) {
+    fragment.text = fmt::to_string(buf_);
+    fragment.type_lines = std::move(type_lines_);
+  }
+
  private:
-  void DumpMetricName(const std::string& name) {
-    if (auto* converted = utils::FindOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
-      return;
+  // Writes the type of the metric on the first use of the name
+  const std::string& GetMetricName(std::string_view name,
+                                   std::string_view type) {
+    // reused to look up without an allocation
+    name_.assign(name);
+    if (auto* converted = utils::FindOrNullptr(metrics_, name_)) {
+      return *converted;
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
-    metrics_.emplace(name, prometheus_name);
+    auto& prometheus_name =
+        metrics_.emplace(name_, impl::ToPrometheusName(name)).first->second;
     if constexpr (IsTyped == Typed::kYes) {
-      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} gauge\n"),
-                     prometheus_name);
+      const auto begin = buf_.size();
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} {}\n"),
+                     prometheus_name, type);
+      type_lines_.push_back({begin, buf_.size(), prometheus_name});
     }
-    buf_.append(prometheus_name);
+    return prometheus_name;
   }
 
-  void DumpLabels(utils::statistics::LabelsSpan labels) {
-    buf_.push_back('{');
+  static void RenderLabels(utils::statistics::LabelsSpan labels,
+                           std::string& out) {
     bool sep = false;
     for (const auto& label : labels) {
       if (sep) {
-        buf_.push_back(',');
+        out.push_back(',');
       }
-      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""),
+      fmt::format_to(std::back_inserter(out), FMT_COMPILE("{}=\""),
                      impl::ToPrometheusLabel(label.Name()));
       const auto& value = label.Value();
-      std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_),
+      std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(out),
                         '"', '\'');
-      buf_.push_back('"');
+      out.push_back('"');
       sep = true;
     }
+  }
+
+  void DumpLabels(utils::statistics::LabelsSpan labels,
+                  std::string_view le = {}) {
+    buf_.push_back('{');
+    const auto rendered = labels_cache_.Get(labels, &RenderLabels);
+    buf_.append(rendered);
+    if (!le.empty()) {
+      if (!rendered.empty()) {
+        buf_.push_back(',');
+      }
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("le=\"{}\""), le);
+    }
     buf_.push_back('}');
   }
 
+  RenderedLabelsCache& labels_cache_;
   fmt::memory_buffer buf_;
+  std::string name_;
   std::unordered_map<std::string, std::string> metrics_;
+  std::vector<PrometheusFormatCache::Fragment::TypeLine> type_lines_;
+};
+
+// Collects the values of the metrics and hashes their names and labels, which
+// is much cheaper than formatting them
+class FingerprintBuilder final : public utils::statistics::BaseFormatBuilder {
+ public:
+  void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
+                    const MetricValue& value) override {
+    HashMetric(path, labels);
+    value.Visit([this](auto raw) { values_.emplace_back(raw); });
+  }
+
+  void HandleHistogram(std::string_view path,
+                       utils::statistics::LabelsSpan labels,
+                       const HdrHistogramView& histogram) override {
+    HashMetric(path, labels);
+    for (std::size_t i = 0; i < histogram.GetBucketCount(); ++i) {
+      const auto value = histogram.GetValueAt(i);
+      if (value == 0) continue;
+      boost::hash_combine(hash_, i);
+      values_.emplace_back(static_cast<std::int64_t>(value));
+    }
+    values_.emplace_back(static_cast<std::int64_t>(histogram.GetSum()));
+  }
+
+  std::uint64_t GetHash() const noexcept { return hash_; }
+
+  std::vector<MetricValue::RawType>& GetValues() noexcept { return values_; }
+
+ private:
+  void HashMetric(std::string_view path, utils::statistics::LabelsSpan labels) {
+    boost::hash_combine(hash_, std::hash<std::string_view>{}(path));
+    for (const auto& label : labels) {
+      boost::hash_combine(hash_, std::hash<std::string_view>{}(label.Name()));
+      boost::hash_combine(hash_, std::hash<std::string_view>{}(label.Value()));
+    }
+  }
+
+  std::size_t hash_{0};
+  std::vector<MetricValue::RawType> values_;
 };
 
 }  // namespace
 
+PrometheusFormatCache::PrometheusFormatCache(Typed typed) : typed_(typed) {}
+
+PrometheusFormatCache::~PrometheusFormatCache() = default;
+
+std::vector<std::string> PrometheusFormatCache::Render(
+    const Storage& storage, const Request& request, std::size_t chunk_size) {
+  std::vector<std::string> chunks;
+  std::string chunk;
+  const auto append = [&](std::string_view data) {
+    chunk.append(data);
+    if (chunk.size() >= chunk_size) {
+      chunks.push_back(std::move(chunk));
+      chunk = {};
+    }
+  };
+
+  std::lock_guard lock(mutex_);
+  last_stats_ = {};
+  for (auto& [id, fragment] : fragments_) fragment.visited = false;
+
+  // Views to the names in the fragments, which are not modified until the end
+  // of the rendering
+  std::unordered_set<std::string_view> declared_types;
+
+  storage.VisitMetricsBySource(request, [&](const void* source_id,
+                                            const SourceWriteFunc& write) {
+    FingerprintBuilder fingerprint;
+    write(fingerprint);
+
+    auto [it, inserted] = fragments_.try_emplace(source_id);
+    auto& fragment = it->second;
+    fragment.visited = true;
+    if (inserted || fragment.structure_hash != fingerprint.GetHash() ||
+        fragment.values != fingerprint.GetValues()) {
+      fragment.structure_hash = fingerprint.GetHash();
+      fragment.values = std::move(fingerprint.GetValues());
+      if (typed_ == Typed::kYes) {
+        FormatBuilder<impl::Typed::kYes> builder{labels_cache_};
+        write(builder);
+        builder.ReleaseFragment(fragment);
+      } else {
+        FormatBuilder<impl::Typed::kNo> builder{labels_cache_};
+        write(builder);
+        builder.ReleaseFragment(fragment);
+      }
+      ++last_stats_.rendered_sources;
+    } else {
+      ++last_stats_.cached_sources;
+    }
+
+    const std::string_view text = fragment.text;
+    std::size_t pos = 0;
+    for (const auto& type_line : fragment.type_lines) {
+      if (!declared_types.insert(type_line.name).second) {
+        append(text.substr(pos, type_line.begin - pos));
+        pos = type_line.end;
+      }
+    }
+    append(text.substr(pos));
+  });
+
+  // drop the sources that were unregistered
+  for (auto it = fragments_.begin(); it != fragments_.end();) {
+    if (it->second.visited) {
+      ++it;
+    } else {
+      it = fragments_.erase(it);
+    }
+  }
+
+  if (!chunk.empty()) chunks.push_back(std::move(chunk));
+  return chunks;
+}
+
+PrometheusFormatCache::Stats PrometheusFormatCache::GetLastStats() const {
+  std::lock_guard lock(mutex_);
+  return last_stats_;
+}
+
 std::string ToPrometheusName(std::string_view data) {
   std::string name;
   if (!data.empty()) {
@@ -109,7 +296,8 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kYes> builder{};
+  impl::RenderedLabelsCache labels_cache;
+  impl::FormatBuilder<impl::Typed::kYes> builder{labels_cache};
   statistics.VisitMetrics(builder, request);
   return builder.Release();
 }
@@ -117,7 +305,8 @@ std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
 std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kNo> builder{};
+  impl::RenderedLabelsCache labels_cache;
+  impl::FormatBuilder<impl::Typed::kNo> builder{labels_cache};
   statistics.VisitMetrics(builder, request);
   return builder.Release();
 }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+#include <utils/statistics/labels_cache.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+/// @brief Prometheus output that is cached per metrics source.
+///
+/// Each scrape still runs the writers of all the sources, but only to collect
+/// the values of the metrics. The text of a source is formatted again only if
+/// its metrics or their values have changed since the previous scrape,
+/// otherwise the cached text is reused.
+class PrometheusFormatCache final {
+ public:
+  enum class Typed { kYes, kNo };
+
+  explicit PrometheusFormatCache(Typed typed);
+  ~PrometheusFormatCache();
+
+  /// Returns the same text as ToPrometheusFormat or ToPrometheusFormatUntyped,
+  /// split into chunks of about `chunk_size` bytes.
+  std::vector<std::string> Render(const Storage& storage,
+                                  const Request& request,
+                                  std::size_t chunk_size);
+
+  struct Stats {
+    std::size_t rendered_sources{0};
+    std::size_t cached_sources{0};
+  };
+
+  /// Statistics of the last Render() call
+  Stats GetLastStats() const;
+
+  /// Formatted text of a single metrics source
+  struct Fragment {
+    /// `# TYPE` line, written only for the first use of the name in the
+    /// whole output
+    struct TypeLine {
+      std::size_t begin;
+      std::size_t end;
+      std::string name;
+    };
+
+    std::uint64_t structure_hash{0};
+    std::vector<MetricValue::RawType> values;
+    std::string text;
+    std::vector<TypeLine> type_lines;
+    bool visited{false};
+  };
+
+ private:
+  const Typed typed_;
+  mutable engine::Mutex mutex_;
+  std::unordered_map<const void*, Fragment> fragments_;
+  // label sets rendered in the previous scrapes
+  RenderedLabelsCache labels_cache_;
+  Stats last_stats_;
+};
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
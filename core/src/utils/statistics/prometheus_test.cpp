@@ -5,11 +5,14 @@
 #include <boost/algorithm/string/split.hpp>
 
 #include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 #include <userver/utils/statistics/prometheus.hpp>
 
+#include <utils/statistics/prometheus_cache.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics::impl {
@@ -422,6 +425,71 @@ UTEST(MetricsPrometheus, SimpleParentSkipped) {
   }
 }
 
+UTEST(MetricsPrometheus, HdrHistogram) {
+  utils::statistics::HdrHistogram<> histogram;
+  for (const auto value : {1, 2, 2, 100}) histogram.Account(value);
+
+  utils::statistics::Storage statistics_storage;
+  auto holder = statistics_storage.RegisterWriter(
+      "hist", [&](utils::statistics::Writer& writer) {
+        writer.ValueWithLabels(histogram, {"method", "get"});
+      });
+
+  const auto* expected =
+      "# TYPE hist histogram\n"
+      "hist_bucket{method=\"get\",le=\"1\"} 1\n"
+      "hist_bucket{method=\"get\",le=\"2\"} 3\n"
+      "hist_bucket{method=\"get\",le=\"101\"} 4\n"
+      "hist_bucket{method=\"get\",le=\"+Inf\"} 4\n"
+      "hist_sum{method=\"get\"} 105\n"
+      "hist_count{method=\"get\"} 4\n";
+  EXPECT_EQ(ToPrometheusFormat(statistics_storage), expected);
+}
+
+UTEST(MetricsPrometheus, FormatCache) {
+  std::atomic<int> changing{1};
+  utils::statistics::Storage statistics_storage;
+  auto constant_holder = statistics_storage.RegisterWriter(
+      "metric", [&](utils::statistics::Writer& writer) {
+        writer.ValueWithLabels(42, {"source", "constant"});
+      });
+  auto changing_holder = statistics_storage.RegisterWriter(
+      "metric", [&](utils::statistics::Writer& writer) {
+        writer.ValueWithLabels(changing.load(), {"source", "changing"});
+      });
+
+  const auto render = [&](PrometheusFormatCache& cache) {
+    std::string result;
+    for (const auto& chunk : cache.Render(statistics_storage, {}, 16)) {
+      result += chunk;
+    }
+    return result;
+  };
+
+  PrometheusFormatCache cache{PrometheusFormatCache::Typed::kYes};
+  EXPECT_EQ(render(cache), ToPrometheusFormat(statistics_storage));
+  EXPECT_EQ(cache.GetLastStats().rendered_sources, 3);
+
+  EXPECT_EQ(render(cache), ToPrometheusFormat(statistics_storage));
+  EXPECT_EQ(cache.GetLastStats().rendered_sources, 0);
+  EXPECT_EQ(cache.GetLastStats().cached_sources, 3);
+
+  changing = 2;
+  const auto* expected =
+      "# TYPE metric gauge\n"
+      "metric{source=\"constant\"} 42\n"
+      "metric{source=\"changing\"} 2\n";
+  EXPECT_EQ(render(cache), expected);
+  EXPECT_EQ(cache.GetLastStats().rendered_sources, 1);
+
+  PrometheusFormatCache untyped_cache{PrometheusFormatCache::Typed::kNo};
+  EXPECT_EQ(render(untyped_cache),
+            ToPrometheusFormatUntyped(statistics_storage));
+
+  constant_holder.Unregister();
+  EXPECT_EQ(render(cache), ToPrometheusFormat(statistics_storage));
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
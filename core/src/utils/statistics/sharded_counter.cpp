@@ -0,0 +1,29 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <compiler/tls.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+std::size_t AcquireShardIndex() noexcept {
+  static std::atomic<std::size_t> next_index{0};
+  return next_index.fetch_add(1, std::memory_order_relaxed) %
+         kCounterShardCount;
+}
+
+thread_local const std::size_t kThreadShardIndex = AcquireShardIndex();
+
+}  // namespace
+
+// A coroutine may migrate to another thread between the calls, so the index
+// must not be cached across the context switches.
+USERVER_PREVENT_TLS_CACHING std::size_t GetCounterShardIndex() noexcept {
+  return kThreadShardIndex;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+utils::statistics::RelaxedCounter<std::uint64_t> relaxed_counter;
+utils::statistics::ShardedCounter<std::uint64_t> sharded_counter;
+
+}  // namespace
+
+void sharded_counter_relaxed_increment(benchmark::State& state) {
+  for (auto _ : state) ++relaxed_counter;
+  benchmark::DoNotOptimize(relaxed_counter.Load());
+}
+BENCHMARK(sharded_counter_relaxed_increment)
+    ->RangeMultiplier(2)
+    ->ThreadRange(1, 32);
+
+void sharded_counter_increment(benchmark::State& state) {
+  for (auto _ : state) ++sharded_counter;
+  benchmark::DoNotOptimize(sharded_counter.Load());
+}
+BENCHMARK(sharded_counter_increment)->RangeMultiplier(2)->ThreadRange(1, 32);
+
+void sharded_counter_load(benchmark::State& state) {
+  for (auto _ : state) benchmark::DoNotOptimize(sharded_counter.Load());
+}
+BENCHMARK(sharded_counter_load);
+
+USERVER_NAMESPACE_END
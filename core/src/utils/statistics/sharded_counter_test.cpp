@@ -0,0 +1,53 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ShardedCounter, Basic) {
+  utils::statistics::ShardedCounter<std::uint64_t> counter;
+  EXPECT_EQ(counter.Load(), 0);
+
+  ++counter;
+  counter += 10;
+  counter--;
+  EXPECT_EQ(counter.Load(), 10);
+}
+
+TEST(ShardedCounter, CrossThreadDecrement) {
+  utils::statistics::ShardedCounter<std::size_t> counter;
+
+  std::thread([&counter] { counter += 5; }).join();
+  std::thread([&counter] { counter -= 3; }).join();
+  --counter;
+  EXPECT_EQ(counter.Load(), 1);
+}
+
+TEST(ShardedCounter, Concurrent) {
+  constexpr std::size_t kThreads = 8;
+  constexpr std::size_t kIterations = 10000;
+
+  utils::statistics::ShardedCounter<std::int64_t> counter;
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&counter, i] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        if (i % 2) {
+          ++counter;
+        } else {
+          counter -= 2;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(counter.Load(),
+            -static_cast<std::int64_t>(kThreads / 2 * kIterations));
+}
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,19 @@
 #include <userver/utils/statistics/solomon.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
 
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
+#include <formats/json/impl/string_writer.hpp>
+#include <utils/statistics/labels_cache.hpp>
 #include <utils/statistics/solomon_limits.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,6 +41,56 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
     value.Visit([this](auto x) { WriteToStream(x, builder_); });
   }
 
+  // Only the non-empty buckets are written, adjacent buckets are merged to fit
+  // into the Solomon limit. The last bucket also holds the values that do not
+  // fit the histogram, so it goes to "inf".
+  void HandleHistogram(std::string_view path,
+                       utils::statistics::LabelsSpan labels,
+                       const HdrHistogramView& histogram) override {
+    const auto last = histogram.GetBucketCount() - 1;
+
+    std::size_t non_empty = 0;
+    for (std::size_t i = 0; i < last; ++i) {
+      if (histogram.GetValueAt(i) != 0) ++non_empty;
+    }
+    const auto merge_count = std::max<std::size_t>(
+        1, (non_empty + impl::solomon::kMaxHistogramBuckets - 1) /
+               impl::solomon::kMaxHistogramBuckets);
+
+    std::vector<std::uint64_t> bounds;
+    std::vector<std::uint64_t> buckets;
+    std::size_t merged = 0;
+    for (std::size_t i = 0; i < last; ++i) {
+      const auto value = histogram.GetValueAt(i);
+      if (value == 0) continue;
+
+      if (merged == 0) {
+        bounds.push_back(histogram.GetUpperBoundAt(i));
+        buckets.push_back(value);
+      } else {
+        bounds.back() = histogram.GetUpperBoundAt(i);
+        buckets.back() += value;
+      }
+      merged = (merged + 1) % merge_count;
+    }
+
+    formats::json::StringBuilder::ObjectGuard guard{builder_};
+    builder_.Key("labels");
+    DumpLabels(path, labels);
+    builder_.Key("type");
+    builder_.WriteString("HIST");
+    builder_.Key("hist");
+    {
+      formats::json::StringBuilder::ObjectGuard hist_guard{builder_};
+      builder_.Key("bounds");
+      WriteArray(bounds);
+      builder_.Key("buckets");
+      WriteArray(buckets);
+      builder_.Key("inf");
+      builder_.WriteUInt64(histogram.GetValueAt(last));
+    }
+  }
+
   void AddCommonLabels(
       const std::unordered_map<std::string, std::string>& common_labels) {
     if (common_labels.empty()) {
@@ -43,16 +101,37 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
   }
 
  private:
-  void DumpLabels(std::string_view path, utils::statistics::LabelsSpan labels) {
-    formats::json::StringBuilder::ObjectGuard guard{builder_};
-    builder_.Key("sensor");
+  void WriteArray(const std::vector<std::uint64_t>& values) {
+    formats::json::StringBuilder::ArrayGuard guard{builder_};
+    for (const auto value : values) builder_.WriteUInt64(value);
+  }
 
+  // Written as a raw JSON value, the labels part is rendered once per label
+  // set
+  void DumpLabels(std::string_view path, utils::statistics::LabelsSpan labels) {
     if (path.size() > impl::solomon::kMaxLabelValueLen) {
       LOG_LIMITED_WARNING()
           << "Path '" << path << "' is too long for Solomon; will be truncated";
     }
-    builder_.WriteString(path.substr(0, impl::solomon::kMaxLabelValueLen));
 
+    buffer_.Clear();
+    AppendRaw(buffer_, R"({"sensor":)");
+    formats::json::impl::WriteEscapedString(
+        buffer_, path.substr(0, impl::solomon::kMaxLabelValueLen));
+    AppendRaw(buffer_, labels_cache_.Get(labels, &RenderLabels));
+    buffer_.Put('}');
+    builder_.WriteRawString({buffer_.GetString(), buffer_.GetSize()});
+  }
+
+  static void AppendRaw(rapidjson::StringBuffer& buffer,
+                        std::string_view data) {
+    std::memcpy(buffer.Push(data.size()), data.data(), data.size());
+  }
+
+  // Renders `,"name":"value"` for each of the labels
+  static void RenderLabels(utils::statistics::LabelsSpan labels,
+                           std::string& out) {
+    rapidjson::StringBuffer buffer;
     std::size_t written_labels = 0;
     for (const auto& label : labels) {
       const auto name = label.Name();
@@ -79,7 +158,10 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
                               << impl::solomon::kMaxLabelNameLen
                               << " chars allowed in Solomon; will be truncated";
       }
-      builder_.Key(name.substr(0, impl::solomon::kMaxLabelNameLen));
+      buffer.Put(',');
+      formats::json::impl::WriteEscapedString(
+          buffer, name.substr(0, impl::solomon::kMaxLabelNameLen));
+      buffer.Put(':');
 
       const auto value = label.Value();
       if (value.size() > impl::solomon::kMaxLabelValueLen) {
@@ -88,13 +170,17 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
             << "' is longer than " << impl::solomon::kMaxLabelValueLen
             << " chars allowed in Solomon; will be truncated";
       }
-      builder_.WriteString(value.substr(0, impl::solomon::kMaxLabelValueLen));
+      formats::json::impl::WriteEscapedString(
+          buffer, value.substr(0, impl::solomon::kMaxLabelValueLen));
 
       ++written_labels;
     }
+    out.assign(buffer.GetString(), buffer.GetSize());
   }
 
   formats::json::StringBuilder& builder_;
+  impl::RenderedLabelsCache labels_cache_;
+  rapidjson::StringBuffer buffer_;
 };
 
 }  // namespace
@@ -3,6 +3,7 @@
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utest/utest.hpp>
 
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/statistics/solomon.hpp>
 #include <userver/utils/statistics/storage.hpp>
@@ -380,6 +381,40 @@ UTEST(MetricsSolomon, SimpleParentSkipped) {
   }
 }
 
+UTEST(MetricsSolomon, HdrHistogram) {
+  utils::statistics::HdrHistogram<> histogram;
+  for (const auto value : {1, 2, 2, 100}) histogram.Account(value);
+  histogram.Account(std::uint64_t{1} << 40);
+
+  utils::statistics::Storage statistics_storage;
+  auto holder = statistics_storage.RegisterWriter(
+      "hist", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  const auto* const expected = R"([
+    {"labels": {"sensor": "hist"}, "type": "HIST",
+     "hist": {"bounds": [1, 2, 101], "buckets": [1, 2, 1], "inf": 1}}
+  ])";
+  TestToMetricsSolomon(statistics_storage, expected);
+}
+
+UTEST(MetricsSolomon, HdrHistogramBucketsLimit) {
+  utils::statistics::HdrHistogram<> histogram;
+  for (std::uint64_t value = 0; value < 1000; ++value) histogram.Account(value);
+
+  utils::statistics::Storage statistics_storage;
+  auto holder = statistics_storage.RegisterWriter(
+      "hist", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  const auto result = formats::json::FromString(ToSolomonFormat(
+      statistics_storage, {}))["metrics"][0]["hist"];
+  EXPECT_LE(result["bounds"].GetSize(), 100);
+  EXPECT_EQ(result["bounds"][result["bounds"].GetSize() - 1].As<int>(), 1007);
+
+  std::uint64_t total = 0;
+  for (const auto& bucket : result["buckets"]) total += bucket.As<int>();
+  EXPECT_EQ(total, 1000);
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,141 @@
+#include <utils/statistics/statsd.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/utils/statistics/fmt.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+// ':', '|', '@', '#' and ',' delimit the parts of a statsd line
+bool IsStatsdPrintable(char c) noexcept {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '.' ||
+         c == '-' || c == '_' || c == '/';
+}
+
+void AppendStatsdSafe(std::string& out, std::string_view value) {
+  std::replace_copy_if(
+      value.cbegin(), value.cend(), std::back_inserter(out),
+      [](char c) { return !IsStatsdPrintable(c); }, '_');
+}
+
+bool IsFinite(const MetricValue& value) noexcept {
+  return value.Visit([](auto x) {
+    if constexpr (std::is_floating_point_v<decltype(x)>) {
+      return std::isfinite(x);
+    } else {
+      return true;
+    }
+  });
+}
+
+bool IsNegative(const MetricValue& value) noexcept {
+  return value.Visit([](auto x) { return x < 0; });
+}
+
+}  // namespace
+
+class StatsdDeltaEncoder::Builder final : public BaseFormatBuilder {
+ public:
+  Builder(StatsdDeltaEncoder& encoder, bool full)
+      : encoder_(encoder), full_(full) {}
+
+  void HandleMetric(std::string_view path, LabelsSpan labels,
+                    const MetricValue& value) override {
+    if (!IsFinite(value)) return;
+
+    key_.clear();
+    AppendStatsdSafe(key_, path);
+    const auto name_size = key_.size();
+    bool first_label = true;
+    for (const auto& label : labels) {
+      key_.append(first_label ? "|#" : ",");
+      first_label = false;
+      AppendStatsdSafe(key_, label.Name());
+      key_.push_back(':');
+      AppendStatsdSafe(key_, label.Value());
+    }
+
+    auto it = encoder_.sent_.find(key_);
+    if (it == encoder_.sent_.end()) {
+      it = encoder_.sent_.emplace(key_, SentValue{value, 0}).first;
+    } else if (it->second.value == value && !full_) {
+      it->second.generation = encoder_.generation_;
+      return;
+    }
+    it->second.value = value;
+    it->second.generation = encoder_.generation_;
+
+    const std::string_view name{key_.data(), name_size};
+    const std::string_view tags{key_.data() + name_size,
+                                key_.size() - name_size};
+    line_.clear();
+    // a signed gauge value is a change of the gauge in statsd, so the
+    // negative values are sent as a reset to zero and a decrement
+    if (IsNegative(value)) {
+      fmt::format_to(std::back_inserter(line_), FMT_COMPILE("{}:0|g{}\n"),
+                     name, tags);
+    }
+    fmt::format_to(std::back_inserter(line_), FMT_COMPILE("{}:{}|g{}"), name,
+                   value, tags);
+    AppendLine();
+  }
+
+  std::vector<std::string> Release() { return std::move(packets_); }
+
+ private:
+  void AppendLine() {
+    if (packets_.empty() || packets_.back().size() + 1 + line_.size() >
+                                encoder_.max_packet_size_) {
+      packets_.emplace_back().reserve(encoder_.max_packet_size_);
+    } else {
+      packets_.back().push_back('\n');
+    }
+    packets_.back().append(line_);
+  }
+
+  StatsdDeltaEncoder& encoder_;
+  const bool full_;
+  std::string key_;
+  std::string line_;
+  std::vector<std::string> packets_;
+};
+
+StatsdDeltaEncoder::StatsdDeltaEncoder(std::size_t max_packet_size)
+    : max_packet_size_(max_packet_size) {}
+
+std::vector<std::string> StatsdDeltaEncoder::Encode(const Storage& storage,
+                                                    const Request& request,
+                                                    bool full) {
+  ++generation_;
+  Builder builder{*this, full};
+  storage.VisitMetrics(builder, request);
+
+  // forget the metrics that are gone, so that they are sent anew if they ever
+  // come back
+  for (auto it = sent_.begin(); it != sent_.end();) {
+    if (it->second.generation != generation_) {
+      it = sent_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return builder.Release();
+}
+
+void StatsdDeltaEncoder::Reset() noexcept { sent_.clear(); }
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
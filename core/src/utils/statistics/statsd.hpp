@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/utils/statistics/metric_value.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+/// Formats the metrics as statsd gauges with DogStatsD tags and remembers the
+/// sent values, so that the unchanged metrics are skipped on the next call.
+class StatsdDeltaEncoder final {
+ public:
+  explicit StatsdDeltaEncoder(std::size_t max_packet_size);
+
+  /// Returns the datagrams with the metrics that changed since the previous
+  /// call, or with all the metrics if `full` is true. Metrics lines are
+  /// separated by '\n', each datagram is at most `max_packet_size` bytes
+  /// unless a single line does not fit.
+  std::vector<std::string> Encode(const Storage& storage,
+                                  const Request& request, bool full);
+
+  /// Forgets the sent values, e.g. after a failed send
+  void Reset() noexcept;
+
+  std::size_t GetTrackedMetricsCount() const noexcept { return sent_.size(); }
+
+ private:
+  class Builder;
+
+  struct SentValue {
+    MetricValue value;
+    std::uint64_t generation{0};
+  };
+
+  const std::size_t max_packet_size_;
+  std::uint64_t generation_{0};
+  std::unordered_map<std::string, SentValue> sent_;
+};
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
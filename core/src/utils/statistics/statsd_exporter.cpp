@@ -0,0 +1,141 @@
+#include <userver/utils/statistics/statsd_exporter.hpp>
+
+#include <vector>
+
+#include <userver/clients/dns/component.hpp>
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <utils/statistics/statsd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+constexpr std::size_t kDefaultMaxPacketSize = 1432;
+
+utils::PeriodicTask::Settings MakePushSettings(
+    const ComponentConfig& config, const ComponentContext& context) {
+  // the default distribution spreads the pushes of the service instances
+  utils::PeriodicTask::Settings settings{
+      config["push-interval"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{10})};
+  const auto task_processor = config["task-processor"];
+  if (!task_processor.IsMissing()) {
+    settings.task_processor =
+        &context.GetTaskProcessor(task_processor.As<std::string>());
+  }
+  return settings;
+}
+
+}  // namespace
+
+StatsdExporter::StatsdExporter(const ComponentConfig& config,
+                               const ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      storage_(context.FindComponent<components::StatisticsStorage>()
+                   .GetStorage()),
+      resolver_(context.FindComponent<clients::dns::Component>().GetResolver()),
+      host_(config["host"].As<std::string>()),
+      port_(config["port"].As<int>(8125)),
+      full_push_interval_(config["full-push-interval"]
+                              .As<std::chrono::milliseconds>(
+                                  std::chrono::minutes{5})),
+      send_timeout_(config["send-timeout"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{1})),
+      request_(utils::statistics::Request::MakeWithPrefix(
+          config["prefix"].As<std::string>(""))),
+      push_settings_(MakePushSettings(config, context)),
+      encoder_(std::make_unique<utils::statistics::impl::StatsdDeltaEncoder>(
+          config["max-packet-size"].As<std::size_t>(kDefaultMaxPacketSize))) {}
+
+StatsdExporter::~StatsdExporter() { push_task_.Stop(); }
+
+void StatsdExporter::OnAllComponentsLoaded() {
+  push_task_.Start("statsd-exporter", push_settings_, [this] { Push(); });
+}
+
+void StatsdExporter::OnAllComponentsAreStopping() { push_task_.Stop(); }
+
+void StatsdExporter::Push() {
+  const auto deadline = engine::Deadline::FromDuration(send_timeout_);
+  auto addr = resolver_.Resolve(host_, deadline).front();
+  addr.SetPort(port_);
+  if (!socket_ || socket_.Getsockname().Domain() != addr.Domain()) {
+    socket_ = engine::io::Socket{addr.Domain(), engine::io::SocketType::kUdp};
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const bool full = full_push_interval_.count() > 0 &&
+                    now - last_full_push_ >= full_push_interval_;
+  const auto packets = encoder_->Encode(storage_, request_, full);
+
+  std::vector<engine::io::Socket::SendDatagram> datagrams;
+  datagrams.reserve(packets.size());
+  for (const auto& packet : packets) {
+    datagrams.push_back({&addr, packet.data(), packet.size()});
+  }
+
+  try {
+    [[maybe_unused]] const auto sent =
+        socket_.SendAllBatchTo(datagrams.data(), datagrams.size(), deadline);
+  } catch (const std::exception&) {
+    // the agent may have missed any of the values
+    encoder_->Reset();
+    throw;
+  }
+  if (full) last_full_push_ = now;
+
+  LOG_DEBUG() << "Pushed " << packets.size() << " statsd packets, "
+              << encoder_->GetTrackedMetricsCount() << " metrics tracked";
+}
+
+yaml_config::Schema StatsdExporter::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: Component that periodically pushes the changed metrics to statsd
+additionalProperties: false
+properties:
+    host:
+        type: string
+        description: statsd agent host name or IP address
+    port:
+        type: integer
+        description: statsd agent UDP port
+        defaultDescription: 8125
+    push-interval:
+        type: string
+        description: how often to push the changed metrics
+        defaultDescription: 10s
+    full-push-interval:
+        type: string
+        description: |
+            how often to push all the metrics, 0 to push only the changed ones
+        defaultDescription: 5m
+    max-packet-size:
+        type: integer
+        description: max datagram size in bytes
+        defaultDescription: 1432
+        minimum: 64
+    send-timeout:
+        type: string
+        description: timeout for resolving and sending a single push
+        defaultDescription: 1s
+    prefix:
+        type: string
+        description: push only the metrics whose path starts with the prefix
+        defaultDescription: ''
+    task-processor:
+        type: string
+        description: task processor to run the pushes on
+        defaultDescription: the main task processor
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,110 @@
+#include <utils/statistics/statsd.hpp>
+
+#include <limits>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+using Packets = std::vector<std::string>;
+
+}  // namespace
+
+UTEST(MetricsStatsd, Format) {
+  Storage storage;
+  auto holder = storage.RegisterWriter("a", [](Writer& writer) {
+    writer["int"] = 42;
+    writer["double"] = 1.5;
+    writer["negative"] = -3;
+    writer["nan"] = std::numeric_limits<double>::quiet_NaN();
+    writer["labeled"].ValueWithLabels(7, {{"l1", "v1"}, {"l:2", "v|2,3"}});
+  });
+
+  StatsdDeltaEncoder encoder{1000};
+  EXPECT_EQ(encoder.Encode(storage, {}, false),
+            (Packets{"a.int:42|g\n"
+                     "a.double:1.5|g\n"
+                     "a.negative:0|g\n"
+                     "a.negative:-3|g\n"
+                     "a.labeled:7|g|#l1:v1,l_2:v_2_3"}));
+  EXPECT_EQ(encoder.GetTrackedMetricsCount(), 4);
+}
+
+UTEST(MetricsStatsd, Delta) {
+  Storage storage;
+  int changing = 1;
+  auto holder = storage.RegisterWriter("m", [&](Writer& writer) {
+    writer["const"] = 10;
+    writer["changing"] = changing;
+  });
+
+  StatsdDeltaEncoder encoder{1000};
+  EXPECT_EQ(encoder.Encode(storage, {}, false),
+            (Packets{"m.const:10|g\nm.changing:1|g"}));
+  EXPECT_EQ(encoder.Encode(storage, {}, false), (Packets{}));
+
+  changing = 2;
+  EXPECT_EQ(encoder.Encode(storage, {}, false), (Packets{"m.changing:2|g"}));
+  EXPECT_EQ(encoder.Encode(storage, {}, true),
+            (Packets{"m.const:10|g\nm.changing:2|g"}));
+
+  encoder.Reset();
+  EXPECT_EQ(encoder.Encode(storage, {}, false),
+            (Packets{"m.const:10|g\nm.changing:2|g"}));
+}
+
+UTEST(MetricsStatsd, Vanished) {
+  Storage storage;
+  bool with_extra = true;
+  auto holder = storage.RegisterWriter("m", [&](Writer& writer) {
+    writer["x"] = 1;
+    if (with_extra) writer["extra"] = 2;
+  });
+
+  StatsdDeltaEncoder encoder{1000};
+  EXPECT_EQ(encoder.Encode(storage, {}, false).size(), 1);
+  EXPECT_EQ(encoder.GetTrackedMetricsCount(), 2);
+
+  with_extra = false;
+  EXPECT_EQ(encoder.Encode(storage, {}, false), (Packets{}));
+  EXPECT_EQ(encoder.GetTrackedMetricsCount(), 1);
+
+  with_extra = true;
+  EXPECT_EQ(encoder.Encode(storage, {}, false), (Packets{"m.extra:2|g"}));
+}
+
+UTEST(MetricsStatsd, Batching) {
+  Storage storage;
+  auto holder = storage.RegisterWriter("m", [](Writer& writer) {
+    writer["a"] = 1;
+    writer["b"] = 2;
+    writer["c"] = 3;
+    writer["very-long-metric-name"] = 4;
+  });
+
+  // "m.a:1|g" is 7 bytes long
+  StatsdDeltaEncoder encoder{15};
+  EXPECT_EQ(encoder.Encode(storage, {}, false),
+            (Packets{"m.a:1|g\nm.b:2|g", "m.c:3|g",
+                     "m.very-long-metric-name:4|g"}));
+}
+
+UTEST(MetricsStatsd, Request) {
+  Storage storage;
+  auto holder1 =
+      storage.RegisterWriter("first", [](Writer& writer) { writer = 1; });
+  auto holder2 =
+      storage.RegisterWriter("second", [](Writer& writer) { writer = 2; });
+
+  StatsdDeltaEncoder encoder{1000};
+  EXPECT_EQ(encoder.Encode(storage, Request::MakeWithPrefix("sec"), false),
+            (Packets{"second:2|g"}));
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
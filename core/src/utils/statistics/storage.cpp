@@ -7,6 +7,8 @@
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
+#include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/text.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
@@ -61,6 +63,24 @@ Request::Request(std::string prefix_in, PrefixMatch path_match_type_in,
 
 BaseFormatBuilder::~BaseFormatBuilder() = default;
 
+void BaseFormatBuilder::HandleHistogram(std::string_view path,
+                                        LabelsSpan labels,
+                                        const HdrHistogramView& histogram) {
+  constexpr double kPercents[] = {0, 50, 90, 95, 98, 99, 99.6, 99.9, 100};
+
+  boost::container::small_vector<LabelView, 8> percentile_labels(
+      labels.begin(), labels.end());
+  percentile_labels.emplace_back();
+
+  for (const double percent : kPercents) {
+    const auto name = GetPercentileFieldName(percent);
+    percentile_labels.back() = LabelView{"percentile", name};
+    HandleMetric(path, LabelsSpan{percentile_labels},
+                 MetricValue{static_cast<std::int64_t>(
+                     histogram.GetPercentile(percent))});
+  }
+}
+
 Storage::Storage() : may_register_extenders_(true) {}
 
 formats::json::Value Storage::GetAsJson() const {
@@ -85,45 +105,35 @@ formats::json::Value Storage::GetAsJson() const {
 void Storage::VisitMetrics(BaseFormatBuilder& out,
                            const Request& request) const {
   {
-    impl::WriterState state{out, request, {}, {}};
-    for (const auto& [name, value] : request.add_labels) {
-      state.add_labels.emplace_back(name, value);
+    std::shared_lock lock(mutex_);
+    for (const auto& entry : metrics_sources_) {
+      if (entry.writer) WriteSource(entry, out, request);
     }
+  }
 
-    boost::container::small_vector<LabelView, 16> labels_vector;
+  statistics::VisitMetrics(out, GetAsJson(), request);
+}
 
+void Storage::VisitMetricsBySource(const Request& request,
+                                   const impl::SourceVisitor& visitor) const {
+  {
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
       if (!entry.writer) {
         continue;
       }
 
-      labels_vector.clear();
-      labels_vector.reserve(entry.writer_labels.size());
-      for (const auto& l : entry.writer_labels) {
-        labels_vector.emplace_back(l);
-      }
-
-      try {
-        auto writer =
-            (entry.prefix_path.empty()
-                 ? Writer{state, LabelsSpan{labels_vector}}
-                 : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
-        if (writer) {
-          LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-          entry.writer(writer);
-        }
-      } catch (const std::exception& e) {
-        UASSERT_MSG(false,
-                    fmt::format("Failed to write metrics for prefix '{}': {}",
-                                entry.prefix_path, e.what()));
-        LOG_ERROR() << "Failed to write metrics for prefix '"
-                    << entry.prefix_path << "': " << e;
-      }
+      visitor(&entry, [this, &entry, &request](BaseFormatBuilder& out) {
+        WriteSource(entry, out, request);
+      });
     }
   }
 
-  statistics::VisitMetrics(out, GetAsJson(), request);
+  // Legacy extenders are written as a single source
+  const auto json = GetAsJson();
+  visitor(&metrics_sources_, [&json, &request](BaseFormatBuilder& out) {
+    statistics::VisitMetrics(out, json, request);
+  });
 }
 
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
@@ -151,6 +161,38 @@ Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
   return Entry(Entry::Impl{this, res});
 }
 
+void Storage::WriteSource(const impl::MetricsSource& source,
+                          BaseFormatBuilder& out,
+                          const Request& request) const {
+  impl::WriterState state{out, request, {}, {}};
+  for (const auto& [name, value] : request.add_labels) {
+    state.add_labels.emplace_back(name, value);
+  }
+
+  boost::container::small_vector<LabelView, 16> labels_vector;
+  labels_vector.reserve(source.writer_labels.size());
+  for (const auto& l : source.writer_labels) {
+    labels_vector.emplace_back(l);
+  }
+
+  try {
+    auto writer =
+        (source.prefix_path.empty()
+             ? Writer{state, LabelsSpan{labels_vector}}
+             : Writer{state, LabelsSpan{labels_vector}}[source.prefix_path]);
+    if (writer) {
+      LOG_DEBUG() << "Getting statistics for prefix=" << source.prefix_path;
+      source.writer(writer);
+    }
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false,
+                fmt::format("Failed to write metrics for prefix '{}': {}",
+                            source.prefix_path, e.what()));
+    LOG_ERROR() << "Failed to write metrics for prefix '"
+                << source.prefix_path << "': " << e;
+  }
+}
+
 void Storage::UnregisterExtender(impl::StorageIterator iterator) noexcept {
   std::lock_guard lock(mutex_);
   metrics_sources_.erase(iterator);
@@ -4,6 +4,7 @@
 #include <boost/numeric/conversion/cast.hpp>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/text.hpp>
 
 #include <utils/statistics/writer_state.hpp>
@@ -68,8 +69,8 @@ bool CanSubPathSucceedStartsWith(std::string_view current_path,
                                  current_path.substr(initial_path_size));
 }
 
-void CheckAndWrite(impl::WriterState& state,
-                   std::variant<std::int64_t, double> value) {
+template <class Value>
+void CheckAndWrite(impl::WriterState& state, const Value& value) {
   UINVARIANT(!state.path.empty(),
              "Detected an attempt to write a metric by empty path");
 
@@ -87,7 +88,11 @@ void CheckAndWrite(impl::WriterState& state,
     return;
   }
 
-  state.builder.HandleMetric(state.path, labels, MetricValue{value});
+  if constexpr (std::is_same_v<Value, HdrHistogramView>) {
+    state.builder.HandleHistogram(state.path, labels, value);
+  } else {
+    state.builder.HandleMetric(state.path, labels, MetricValue{value});
+  }
 }
 
 }  // namespace
@@ -156,6 +161,13 @@ void Writer::Write(double value) {
   }
 }
 
+void Writer::Write(const HdrHistogramView& value) {
+  if (state_) {
+    ValidateUsage();
+    CheckAndWrite(*state_, value);
+  }
+}
+
 void Writer::ResetState() noexcept {
   UASSERT(state_);
 
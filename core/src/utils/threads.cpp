@@ -12,15 +12,21 @@
 #include <sys/time.h>
 #include <unistd.h>
 #else
+#include <pthread.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
 #endif
 
 #include <algorithm>
+#include <stdexcept>
+#include <system_error>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -59,6 +65,10 @@ LowPriorityParams QueryLowPriorityParams() {
   return result;
 }
 
+constexpr std::string_view kSysfsNodePath = "/sys/devices/system/node/";
+
+thread_local std::size_t current_thread_numa_node = 0;
+
 }  // namespace
 
 bool IsMainThread() {
@@ -98,6 +108,94 @@ void SetCurrentThreadLowPriorityScheduling() {
       "setting thread scheduling parameters");
 }
 
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> result;
+
+  for (const auto& range : text::Split(cpu_list, ",")) {
+    const auto trimmed = text::Trim(range);
+    if (trimmed.empty()) continue;
+
+    const auto dash_pos = trimmed.find('-');
+    const auto first = FromString<std::size_t>(trimmed.substr(0, dash_pos));
+    const auto last =
+        (dash_pos == std::string::npos)
+            ? first
+            : FromString<std::size_t>(trimmed.substr(dash_pos + 1));
+    if (last < first) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU range '{}' in CPU list '{}'", trimmed,
+                      cpu_list));
+    }
+
+    for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::size_t GetNumaNodesCount() {
+#ifdef __linux__
+  const auto path = fmt::format("{}possible", kSysfsNodePath);
+  if (!fs::blocking::FileExists(path)) return 1;
+
+  const auto nodes = ParseCpuList(fs::blocking::ReadFileContents(path));
+  return nodes.empty() ? 1 : nodes.back() + 1;
+#else
+  return 1;
+#endif
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node) {
+#ifdef __linux__
+  const auto path = fmt::format("{}node{}/cpulist", kSysfsNodePath, numa_node);
+  if (!fs::blocking::FileExists(path)) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} was not found at '{}'", numa_node, path));
+  }
+  return ParseCpuList(fs::blocking::ReadFileContents(path));
+#else
+  throw std::runtime_error(fmt::format(
+      "NUMA node {} CPUs are not available on this platform", numa_node));
+#endif
+}
+
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(
+          fmt::format("CPU {} is out of supported range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  // pthread_* functions return the error code instead of setting errno
+  const auto error =
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (error != 0) {
+    throw std::system_error(error, std::generic_category(),
+                            "setting thread CPU affinity");
+  }
+#else
+  if (!cpus.empty()) {
+    throw std::runtime_error(
+        "Setting thread CPU affinity is not supported on this platform");
+  }
+#endif
+}
+
+void SetCurrentThreadNumaNode(std::size_t numa_node) noexcept {
+  current_thread_numa_node = numa_node;
+}
+
+std::size_t GetCurrentThreadNumaNode() noexcept {
+  return current_thread_numa_node;
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
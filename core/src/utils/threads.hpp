@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -10,6 +14,26 @@ void SetCurrentThreadIdleScheduling();
 
 void SetCurrentThreadLowPriorityScheduling();
 
+/// Parses a Linux CPU list, e.g. "0-3,8,10-11"
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the number of possible NUMA nodes, 1 if it could not be detected.
+/// Does blocking reads of sysfs.
+std::size_t GetNumaNodesCount();
+
+/// Returns CPUs of the NUMA node. Does blocking reads of sysfs.
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node);
+
+/// Restricts the current thread to run on the specified CPUs only
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
+
+/// Remembers the NUMA node the current thread is bound to, used to keep the
+/// thread-local data (e.g. coroutine stacks) on the same node.
+void SetCurrentThreadNumaNode(std::size_t numa_node) noexcept;
+
+/// Returns the NUMA node set by SetCurrentThreadNumaNode, 0 by default
+std::size_t GetCurrentThreadNumaNode() noexcept;
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
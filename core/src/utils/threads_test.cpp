@@ -0,0 +1,30 @@
+#include <utils/threads.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ParseCpuList, Basic) {
+  using Cpus = std::vector<std::size_t>;
+
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+  EXPECT_EQ(utils::ParseCpuList("3"), Cpus{3});
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("0-1,8,10-11\n"), (Cpus{0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("4,0-1,1"), (Cpus{0, 1, 4}));
+}
+
+TEST(ParseCpuList, Invalid) {
+  EXPECT_ANY_THROW(utils::ParseCpuList("3-1"));
+  EXPECT_ANY_THROW(utils::ParseCpuList("a-b"));
+  EXPECT_ANY_THROW(utils::ParseCpuList("-1"));
+}
+
+TEST(NumaNodes, CurrentThread) {
+  EXPECT_GE(utils::GetNumaNodesCount(), 1);
+  EXPECT_EQ(utils::GetCurrentThreadNumaNode(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -46,11 +46,13 @@ void Iterator<iter_traits>::UpdateValue() const {
   UASSERT(container_ != nullptr);
   if (current_) return;
 
+  // the member is taken from the iterator, looking it up by the name in the
+  // container is linear in the size of the container
   if (it_.GetIteratorType() == formats::common::Type::kArray) {
-    current_ = (*container_)[it_.GetIndex()];
+    current_ = container_->MakeChild(*it_, it_.GetIndex());
   } else {
     UASSERT(it_.GetIteratorType() == formats::common::Type::kObject);
-    current_ = (*container_)[it_.GetName()];
+    current_ = container_->MakeChild(*it_, it_.GetName());
   }
 }
 
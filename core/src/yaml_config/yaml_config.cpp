@@ -1,5 +1,7 @@
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <optional>
+
 #include <fmt/format.h>
 
 #include <userver/formats/yaml/serialize.hpp>
@@ -18,14 +20,13 @@ const formats::yaml::Value& YamlConfig::Yaml() const { return yaml_; }
 
 namespace {
 
-bool IsSubstitution(const formats::yaml::Value& value) {
-  if (!value.IsString()) return false;
-  const auto& str = value.As<std::string>();
-  return !str.empty() && str.front() == '$';
-}
-
-std::string GetSubstitutionVarName(const formats::yaml::Value& value) {
-  return value.As<std::string>().substr(1);
+std::optional<std::string> GetSubstitutionVarName(
+    const formats::yaml::Value& value) {
+  if (!value.IsString()) return std::nullopt;
+  auto str = value.As<std::string>();
+  if (str.empty() || str.front() != '$') return std::nullopt;
+  str.erase(0, 1);
+  return str;
 }
 
 std::string GetFallbackName(std::string_view str) {
@@ -41,12 +42,17 @@ YamlConfig MakeMissingConfig(const YamlConfig& config, Field field) {
 }  // namespace
 
 YamlConfig YamlConfig::operator[](std::string_view key) const {
-  auto value = yaml_[key];
+  return MakeChild(yaml_[key], key);
+}
 
-  if (IsSubstitution(value)) {
-    const auto var_name = GetSubstitutionVarName(value);
+YamlConfig YamlConfig::operator[](size_t index) const {
+  return MakeChild(yaml_[index], index);
+}
 
-    auto var_data = config_vars_[var_name];
+YamlConfig YamlConfig::MakeChild(formats::yaml::Value value,
+                                 std::string_view key) const {
+  if (const auto var_name = GetSubstitutionVarName(value)) {
+    auto var_data = config_vars_[*var_name];
     if (!var_data.IsMissing()) {
       // Strip substitutions off to disallow nested substitutions
       return YamlConfig{std::move(var_data), {}};
@@ -55,7 +61,7 @@ YamlConfig YamlConfig::operator[](std::string_view key) const {
     const auto fallback_name = GetFallbackName(key);
 
     if (yaml_.HasMember(fallback_name)) {
-      LOG_INFO() << "using default value for config variable '" << var_name
+      LOG_INFO() << "using default value for config variable '" << *var_name
                  << '\'';
       return YamlConfig{yaml_[fallback_name], config_vars_};
     }
@@ -67,13 +73,10 @@ YamlConfig YamlConfig::operator[](std::string_view key) const {
   return YamlConfig{std::move(value), config_vars_};
 }
 
-YamlConfig YamlConfig::operator[](size_t index) const {
-  auto value = yaml_[index];
-
-  if (IsSubstitution(value)) {
-    const auto var_name = GetSubstitutionVarName(value);
-
-    auto var_data = config_vars_[var_name];
+YamlConfig YamlConfig::MakeChild(formats::yaml::Value value,
+                                 size_t index) const {
+  if (const auto var_name = GetSubstitutionVarName(value)) {
+    auto var_data = config_vars_[*var_name];
     if (!var_data.IsMissing()) {
       // Strip substitutions off to disallow nested substitutions
       return YamlConfig{std::move(var_data), {}};
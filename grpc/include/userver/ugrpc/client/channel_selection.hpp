@@ -0,0 +1,29 @@
+#pragma once
+
+/// @file userver/ugrpc/client/channel_selection.hpp
+/// @brief @copybrief ugrpc::client::ChannelSelection
+
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+/// @brief How a request picks one of the channels of an endpoint, when the
+/// ClientFactory creates several channels (HTTP/2 connections) per endpoint
+enum class ChannelSelection {
+  /// A random channel, the default
+  kRandom,
+  /// The channels in turn, separately for each client
+  kRoundRobin,
+  /// The channel with the least number of in-flight requests over all the
+  /// clients of the ClientFactory
+  kLeastLoaded,
+};
+
+ChannelSelection Parse(const yaml_config::YamlConfig& value,
+                       formats::parse::To<ChannelSelection>);
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 /// @file userver/ugrpc/client/channels.hpp
 /// @brief Utilities for managing gRPC connections
 
+#include <cstddef>
+
 #include <grpcpp/channel.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/security/credentials.h>
@@ -47,17 +49,21 @@ std::shared_ptr<grpc::Channel> MakeChannel(
 
 /// @brief Wait until the channel state of `client` is `READY`. If the current
 /// state is already `READY`, returns `true` immediately. In case of multiple
-/// underlying channels, waits for all of them.
+/// endpoints or underlying channels, waits for all of them.
 /// @returns `true` if the state changed before `deadline` expired
 /// @note The wait operation does not support task cancellations
 template <typename Client>
 [[nodiscard]] bool TryWaitForConnected(
     Client& client, engine::Deadline deadline,
     engine::TaskProcessor& blocking_task_processor) {
-  return impl::TryWaitForConnected(
-      impl::GetClientData(client).GetChannelToken(),
-      impl::GetClientData(client).GetQueue(), deadline,
-      blocking_task_processor);
+  auto& data = impl::GetClientData(client);
+  for (std::size_t i = 0; i < data.GetEndpointCount(); ++i) {
+    if (!impl::TryWaitForConnected(data.GetChannelToken(i), data.GetQueue(),
+                                   deadline, blocking_task_processor)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 }  // namespace ugrpc::client
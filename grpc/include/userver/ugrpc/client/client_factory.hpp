@@ -4,17 +4,25 @@
 /// @brief @copybrief ugrpc::client::ClientFactory
 
 #include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/support/channel_arguments.h>
 
+#include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
+#include <userver/ugrpc/client/channel_selection.hpp>
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/client/impl/client_data.hpp>
+#include <userver/ugrpc/client/outlier_detection.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -38,6 +46,15 @@ struct ClientFactoryConfig {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Overrides of `channel_count` for specific endpoints
+  std::unordered_map<std::string, std::size_t> channel_count_by_endpoint{};
+
+  /// How a request picks one of the channels of an endpoint
+  ChannelSelection channel_selection{ChannelSelection::kRandom};
+
+  /// Ejection of failing endpoints of clients with several endpoints
+  OutlierDetectionConfig outlier_detection{};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
@@ -56,22 +73,45 @@ class ClientFactory final {
   template <typename Client>
   Client MakeClient(const std::string& endpoint);
 
+  /// @brief Creates a client, which balances the requests across `endpoints`
+  ///
+  /// Each request goes to an endpoint with the least number of active
+  /// requests. Endpoints with a high error rate are temporarily ejected, see
+  /// OutlierDetectionConfig.
+  template <typename Client>
+  Client MakeClient(const std::vector<std::string>& endpoints);
+
  private:
-  impl::ChannelCache::Token GetChannel(const std::string& endpoint);
+  std::vector<impl::Endpoint> GetEndpoints(
+      const std::vector<std::string>& endpoints);
 
   engine::TaskProcessor& channel_task_processor_;
   grpc::CompletionQueue& queue_;
+  const OutlierDetectionConfig outlier_detection_;
+  const ChannelSelection channel_selection_;
   impl::ChannelCache channel_cache_;
   ugrpc::impl::StatisticsStorage client_statistics_storage_;
 };
 
 template <typename Client>
 Client ClientFactory::MakeClient(const std::string& endpoint) {
+  return MakeClient<Client>(std::vector<std::string>{endpoint});
+}
+
+template <typename Client>
+Client ClientFactory::MakeClient(const std::vector<std::string>& endpoints) {
   auto& statistics =
       client_statistics_storage_.GetServiceStatistics(Client::GetMetadata());
-  return Client(GetChannel(endpoint), queue_, statistics);
+  return Client(GetEndpoints(endpoints), queue_, statistics);
 }
 
+/// @brief Resolves the host of a `host:port` endpoint to the list of
+/// `address:port` endpoints, suitable for a balancing client
+/// @throws clients::dns::NotResolvedException if the host is not resolved
+std::vector<std::string> ResolveEndpoints(clients::dns::Resolver& resolver,
+                                          const std::string& endpoint,
+                                          engine::Deadline deadline);
+
 }  // namespace ugrpc::client
 
 USERVER_NAMESPACE_END
@@ -34,6 +34,20 @@ namespace ugrpc::client {
 /// We allow setting default service_config: pass desired JSON literal
 /// to `default-service-config` parameter
 ///
+/// ## Balancing
+/// A client created for several endpoints, e.g. resolved by
+/// ugrpc::client::ResolveEndpoints, sends each request to the endpoint with
+/// the least number of active requests. Endpoints with high error rate are
+/// ejected for a while, see `outlier-detection`.
+///
+/// ## Channels
+/// Requests over a single channel are multiplexed over one HTTP/2
+/// connection, which limits them by `MAX_CONCURRENT_STREAMS` of the peer.
+/// `channel-count` creates several channels, each with its own connection,
+/// per endpoint. `least-loaded` selection picks the channel with the least
+/// number of in-flight requests over all the clients of the factory; the
+/// in-flight requests are reported per channel in the endpoint metrics.
+///
 /// ## Static options:
 /// The default component name for static config is `"grpc-client-factory"`.
 ///
@@ -45,6 +59,12 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// channel-count-by-endpoint | a map of endpoint to its channel-count override | {}
+/// channel-selection | how a request picks a channel: `random`, `round-robin` or `least-loaded` | random
+/// outlier-detection.error-rate | share of failed requests, which ejects an endpoint of a balancing client | 0.5
+/// outlier-detection.min-requests | min number of requests within interval to judge on the error rate | 10
+/// outlier-detection.interval | period of error rate accounting | 10s
+/// outlier-detection.ejection-time | for how long an ejected endpoint receives no requests | 30s
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
 class ClientFactoryComponent final : public components::LoggableComponentBase {
@@ -11,10 +11,13 @@
 #include <grpcpp/impl/codegen/async_unary_call.h>
 #include <grpcpp/impl/codegen/status.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/tracing/in_place_span.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/client/impl/endpoint_health.hpp>
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
+#include <userver/ugrpc/impl/message_logging.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -69,7 +72,8 @@ class RpcData final {
  public:
   RpcData(std::unique_ptr<grpc::ClientContext>&& context,
           std::string_view call_name,
-          ugrpc::impl::MethodStatistics& statistics);
+          ugrpc::impl::MethodStatistics& statistics,
+          EndpointUsage&& endpoint_usage);
 
   RpcData(RpcData&&) noexcept = delete;
   RpcData& operator=(RpcData&&) noexcept = delete;
@@ -87,6 +91,8 @@ class RpcData final {
 
   ugrpc::impl::RpcStatisticsScope& GetStatsScope() noexcept;
 
+  EndpointUsage& GetEndpointUsage() noexcept;
+
   State GetState() const noexcept;
 
   void SetState(State new_state) noexcept;
@@ -113,6 +119,7 @@ class RpcData final {
 
   std::optional<tracing::InPlaceSpan> span_;
   ugrpc::impl::RpcStatisticsScope stats_scope_;
+  EndpointUsage endpoint_usage_;
 
   std::optional<AsyncMethodInvocation> finish_;
   grpc::Status status_;
@@ -148,7 +155,10 @@ template <typename GrpcStream, typename Response>
   PrepareRead(data);
   AsyncMethodInvocation read;
   stream.Read(&response, read.GetTag());
-  return read.Wait();
+  if (!read.Wait()) return false;
+  LOG_DEBUG() << "gRPC response: "
+              << ugrpc::impl::MessageForLogging{response};
+  return true;
 }
 
 void PrepareWrite(RpcData& data);
@@ -157,6 +167,7 @@ template <typename GrpcStream, typename Request>
 void Write(GrpcStream& stream, const Request& request,
            grpc::WriteOptions options, RpcData& data) {
   PrepareWrite(data);
+  LOG_DEBUG() << "gRPC request: " << ugrpc::impl::MessageForLogging{request};
   AsyncMethodInvocation write;
   stream.Write(request, options, write.GetTag());
   CheckOk(data, write.Wait(), "Write");
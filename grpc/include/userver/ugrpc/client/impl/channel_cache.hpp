@@ -21,7 +21,9 @@ class ChannelCache final {
  public:
   ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
                const grpc::ChannelArguments& channel_args,
-               std::size_t channel_count);
+               std::size_t channel_count,
+               std::unordered_map<std::string, std::size_t>&&
+                   channel_count_by_endpoint = {});
 
   ~ChannelCache();
 
@@ -31,6 +33,8 @@ class ChannelCache final {
   // alive.
   Token Get(const std::string& endpoint);
 
+  std::size_t GetChannelCount(const std::string& endpoint) const;
+
  private:
   struct CountedChannel final {
     CountedChannel(const std::string& endpoint,
@@ -47,6 +51,7 @@ class ChannelCache final {
   const std::shared_ptr<grpc::ChannelCredentials> credentials_;
   const grpc::ChannelArguments channel_args_;
   const std::size_t channel_count_;
+  const std::unordered_map<std::string, std::size_t> channel_count_by_endpoint_;
   concurrent::Variable<Map> channels_;
 };
 
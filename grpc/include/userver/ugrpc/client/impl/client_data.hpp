@@ -3,12 +3,15 @@
 #include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <grpcpp/channel.h>
 #include <grpcpp/completion_queue.h>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/client/impl/endpoint_health.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/rand.hpp>
 
@@ -16,6 +19,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+/// A channel to one of the endpoints of a client
+struct Endpoint final {
+  ChannelCache::Token channel_token;
+  std::shared_ptr<EndpointHealth> health;
+};
+
 /// A helper class for generated gRPC clients
 class ClientData final {
  public:
@@ -25,19 +34,23 @@ class ClientData final {
   ClientData() = delete;
 
   template <typename Service>
-  ClientData(impl::ChannelCache::Token channel_token,
-             grpc::CompletionQueue& queue,
+  ClientData(std::vector<Endpoint>&& endpoints, grpc::CompletionQueue& queue,
              ugrpc::impl::ServiceStatistics& statistics,
              std::in_place_type_t<Service>)
-      : channel_token_(std::move(channel_token)),
-        queue_(&queue),
-        statistics_(&statistics) {
-    const std::size_t channel_count = channel_token_.GetChannelCount();
-    stubs_ = utils::GenerateFixedArray(channel_count, [&](std::size_t index) {
-      return StubPtr(
-          Service::NewStub(channel_token_.GetChannel(index)).release(),
-          &StubDeleter<Service>);
-    });
+      : queue_(&queue), statistics_(&statistics) {
+    UINVARIANT(!endpoints.empty(), "No endpoints for the client");
+    endpoints_ = utils::GenerateFixedArray(
+        endpoints.size(), [&](std::size_t endpoint_index) {
+          auto& endpoint = endpoints[endpoint_index];
+          const auto& token = endpoint.channel_token;
+          auto stubs = utils::GenerateFixedArray(
+              token.GetChannelCount(), [&](std::size_t index) {
+                return StubPtr(
+                    Service::NewStub(token.GetChannel(index)).release(),
+                    &StubDeleter<Service>);
+              });
+          return EndpointData{std::move(endpoint), std::move(stubs)};
+        });
   }
 
   ClientData(ClientData&&) noexcept = default;
@@ -46,10 +59,28 @@ class ClientData final {
   ClientData(const ClientData&) = delete;
   ClientData& operator=(const ClientData&) = delete;
 
+  /// Picks the least loaded of the healthy endpoints
+  std::size_t NextEndpoint() const;
+
+  /// Picks one of the channels of the endpoint according to its
+  /// ChannelSelection
+  std::size_t NextChannel(std::size_t endpoint_index) const {
+    const auto& data = endpoints_[endpoint_index];
+    return data.endpoint.health->NextChannel(data.stubs.size());
+  }
+
   template <typename Service>
-  Stub<Service>& NextStub() const {
-    return *static_cast<Stub<Service>*>(
-        stubs_[utils::RandRange(stubs_.size())].get());
+  Stub<Service>& NextStub(std::size_t endpoint_index,
+                          std::size_t channel_index) const {
+    const auto& stubs = endpoints_[endpoint_index].stubs;
+    UASSERT(channel_index < stubs.size());
+    return *static_cast<Stub<Service>*>(stubs[channel_index].get());
+  }
+
+  EndpointUsage MakeEndpointUsage(std::size_t endpoint_index,
+                                  std::size_t channel_index) const {
+    return EndpointUsage{endpoints_[endpoint_index].endpoint.health,
+                         channel_index};
   }
 
   grpc::CompletionQueue& GetQueue() const { return *queue_; }
@@ -58,7 +89,11 @@ class ClientData final {
     return statistics_->GetMethodStatistics(method_id);
   }
 
-  ChannelCache::Token& GetChannelToken() { return channel_token_; }
+  std::size_t GetEndpointCount() const noexcept { return endpoints_.size(); }
+
+  ChannelCache::Token& GetChannelToken(std::size_t endpoint_index = 0) {
+    return endpoints_[endpoint_index].endpoint.channel_token;
+  }
 
  private:
   using StubDeleterType = void (*)(void*);
@@ -69,8 +104,12 @@ class ClientData final {
     delete static_cast<Stub<Service>*>(ptr);
   }
 
-  impl::ChannelCache::Token channel_token_;
-  utils::FixedArray<StubPtr> stubs_;
+  struct EndpointData final {
+    Endpoint endpoint;
+    utils::FixedArray<StubPtr> stubs;
+  };
+
+  utils::FixedArray<EndpointData> endpoints_;
   grpc::CompletionQueue* queue_;
   ugrpc::impl::ServiceStatistics* statistics_;
 };
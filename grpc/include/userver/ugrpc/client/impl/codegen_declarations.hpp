@@ -5,6 +5,8 @@
 //
 // Do not include this header in your code, use non-impl includes instead!
 
+#include <vector>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
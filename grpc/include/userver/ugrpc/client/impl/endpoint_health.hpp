@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <grpcpp/support/status.h>
+
+#include <userver/ugrpc/client/channel_selection.hpp>
+#include <userver/ugrpc/client/outlier_detection.hpp>
+#include <userver/ugrpc/impl/statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+/// Load and recent failures of an endpoint, as seen by a single client.
+/// Shared with the RPCs, which may outlive the client.
+class EndpointHealth final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  EndpointHealth(const OutlierDetectionConfig& config,
+                 ugrpc::impl::EndpointStatistics& statistics,
+                 ChannelSelection channel_selection =
+                     ChannelSelection::kRandom);
+
+  std::size_t GetOutstandingCount() const noexcept;
+
+  bool IsEjected(Clock::time_point now) const noexcept;
+
+  /// Picks one of the `channel_count` channels of the endpoint
+  std::size_t NextChannel(std::size_t channel_count) noexcept;
+
+  void OnStarted(std::size_t channel_index) noexcept;
+
+  void OnFinished(std::size_t channel_index, bool is_failure) noexcept;
+
+ private:
+  static std::int64_t ToRep(Clock::time_point time) noexcept;
+
+  void MaybeEject(Clock::time_point now) noexcept;
+
+  const OutlierDetectionConfig config_;
+  ugrpc::impl::EndpointStatistics& statistics_;
+  const ChannelSelection channel_selection_;
+  std::atomic<std::size_t> next_channel_{0};
+  std::atomic<std::size_t> outstanding_{0};
+  std::atomic<std::int64_t> window_start_;
+  std::atomic<std::uint64_t> window_requests_{0};
+  std::atomic<std::uint64_t> window_failures_{0};
+  std::atomic<std::int64_t> ejected_until_{0};
+};
+
+/// Accounts a single RPC in the health of the endpoint it was sent to
+class EndpointUsage final {
+ public:
+  EndpointUsage() noexcept = default;
+  EndpointUsage(std::shared_ptr<EndpointHealth> health,
+                std::size_t channel_index) noexcept;
+
+  EndpointUsage(EndpointUsage&&) noexcept = default;
+  EndpointUsage& operator=(EndpointUsage&&) = delete;
+  ~EndpointUsage();
+
+  void OnFinished(const grpc::Status& status) noexcept;
+
+  void OnNetworkError() noexcept;
+
+ private:
+  void Release(bool is_failure) noexcept;
+
+  std::shared_ptr<EndpointHealth> health_;
+  std::size_t channel_index_{0};
+};
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,74 @@
+#pragma once
+
+/// @file userver/ugrpc/client/otlp_span_exporter_component.hpp
+/// @brief @copybrief ugrpc::client::OtlpSpanExporterComponent
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+namespace impl {
+class OtlpSpanExporter;
+}  // namespace impl
+
+/// @ingroup userver_components
+///
+/// @brief Sends the finished spans to an OpenTelemetry collector over
+/// OTLP/gRPC.
+///
+/// Spans are converted to the OTLP format by the tasks that finish them and
+/// are put into a bounded lock-free queue. A background task sends the queue
+/// in batches when `max-batch-size` spans are queued or when `export-interval`
+/// expires, whichever happens first. When the queue is full, new spans are
+/// dropped and accounted in the statistics.
+///
+/// Head sampling is done with tracing::Tracer::SetSamplingRatio, so all the
+/// spans of a trace are either exported or not.
+///
+/// The component works independently of the span logging and of the
+/// opentracing logger.
+///
+/// ## Static options:
+/// The default component name for static config is `"otlp-span-exporter"`.
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | the collector endpoint, e.g. `localhost:4317` | -
+/// client-factory | name of the ugrpc::client::ClientFactoryComponent to use | grpc-client-factory
+/// task-processor | the task processor for the background export task | main-task-processor
+/// sampling-ratio | share of the traces in [0, 1] to export | 1.0
+/// max-queue-size | max number of spans waiting for the export | 65536
+/// max-batch-size | max number of spans in a single export request | 512
+/// export-interval | max time a span waits for the export | 1s
+/// export-timeout | deadline of a single export request | 1s
+class OtlpSpanExporterComponent final
+    : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "otlp-span-exporter";
+
+  OtlpSpanExporterComponent(const components::ComponentConfig& config,
+                            const components::ComponentContext& context);
+
+  ~OtlpSpanExporterComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  formats::json::Value ExtendStatistics() const;
+
+  std::shared_ptr<impl::OtlpSpanExporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace ugrpc::client
+
+template <>
+inline constexpr bool
+    components::kHasValidate<ugrpc::client::OtlpSpanExporterComponent> = true;
+
+USERVER_NAMESPACE_END
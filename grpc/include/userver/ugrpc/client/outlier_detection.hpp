@@ -0,0 +1,40 @@
+#pragma once
+
+/// @file userver/ugrpc/client/outlier_detection.hpp
+/// @brief @copybrief ugrpc::client::OutlierDetectionConfig
+
+#include <chrono>
+#include <cstddef>
+
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+/// @brief Settings of ejection of failing endpoints, when a client balances
+/// requests across several endpoints
+///
+/// Transport errors and `UNAVAILABLE`, `DEADLINE_EXCEEDED`, `INTERNAL`,
+/// `UNKNOWN` status codes are considered failures. If all the endpoints are
+/// ejected, requests are spread across all of them.
+struct OutlierDetectionConfig final {
+  /// Share of failed requests, which ejects the endpoint. Disabled if `0`.
+  double error_rate{0.5};
+
+  /// Minimal number of requests within `interval` to judge on the error rate
+  std::size_t min_requests{10};
+
+  /// Period of error rate accounting
+  std::chrono::milliseconds interval{std::chrono::seconds{10}};
+
+  /// For how long an ejected endpoint receives no requests
+  std::chrono::milliseconds ejection_time{std::chrono::seconds{30}};
+};
+
+OutlierDetectionConfig Parse(const yaml_config::YamlConfig& value,
+                             formats::parse::To<OutlierDetectionConfig>);
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
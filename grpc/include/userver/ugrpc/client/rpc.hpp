@@ -9,12 +9,14 @@
 
 #include <grpcpp/impl/codegen/proto_utils.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 
 #include <userver/ugrpc/client/exceptions.hpp>
 #include <userver/ugrpc/client/impl/async_methods.hpp>
 #include <userver/ugrpc/impl/deadline_timepoint.hpp>
+#include <userver/ugrpc/impl/message_logging.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -74,6 +76,9 @@ class USERVER_NODISCARD UnaryCall final {
   ///
   /// `Finish` and `FinishAsync` should not be called together for the same RPC.
   ///
+  /// `response` may be created on a `google::protobuf::Arena`, then all of its
+  /// submessages are parsed into the arena as well.
+  ///
   /// @returns the future for the single response
   UnaryFuture FinishAsync(Response& response);
 
@@ -86,7 +91,8 @@ class USERVER_NODISCARD UnaryCall final {
       Stub& stub, grpc::CompletionQueue& queue,
       impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
       std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-      ugrpc::impl::MethodStatistics& statistics, const Request& req);
+      ugrpc::impl::MethodStatistics& statistics,
+      impl::EndpointUsage&& endpoint_usage, const Request& req);
 
   UnaryCall(UnaryCall&&) noexcept = default;
   UnaryCall& operator=(UnaryCall&&) noexcept = default;
@@ -141,7 +147,8 @@ class USERVER_NODISCARD InputStream final {
               impl::RawReaderPreparer<Stub, Request, Response> prepare_func,
               std::string_view call_name,
               std::unique_ptr<grpc::ClientContext> context,
-              ugrpc::impl::MethodStatistics& statistics, const Request& req);
+              ugrpc::impl::MethodStatistics& statistics,
+              impl::EndpointUsage&& endpoint_usage, const Request& req);
 
   InputStream(InputStream&&) noexcept = default;
   InputStream& operator=(InputStream&&) noexcept = default;
@@ -174,6 +181,16 @@ class USERVER_NODISCARD OutputStream final {
   /// @throws ugrpc::client::RpcError on an RPC error
   void Write(const Request& request);
 
+  /// @brief Write the next outgoing message, allowing gRPC to hold it back
+  ///
+  /// The message may be coalesced with the following ones and is only
+  /// guaranteed to be sent out on the next `Write`, `WritesDone` or `Finish`.
+  /// Use for streams of many small messages.
+  ///
+  /// @param request the next message to write
+  /// @throws ugrpc::client::RpcError on an RPC error
+  void WriteBuffered(const Request& request);
+
   /// @brief Complete the RPC successfully
   ///
   /// Should be called once all the data is written. The server will then
@@ -196,7 +213,8 @@ class USERVER_NODISCARD OutputStream final {
                impl::RawWriterPreparer<Stub, Request, Response> prepare_func,
                std::string_view call_name,
                std::unique_ptr<grpc::ClientContext> context,
-               ugrpc::impl::MethodStatistics& statistics);
+               ugrpc::impl::MethodStatistics& statistics,
+               impl::EndpointUsage&& endpoint_usage);
 
   OutputStream(OutputStream&&) noexcept = default;
   OutputStream& operator=(OutputStream&&) noexcept = default;
@@ -240,6 +258,16 @@ class USERVER_NODISCARD BidirectionalStream final {
   /// @throws ugrpc::client::RpcError on an RPC error
   void Write(const Request& request);
 
+  /// @brief Write the next outgoing message, allowing gRPC to hold it back
+  ///
+  /// The message may be coalesced with the following ones and is only
+  /// guaranteed to be sent out on the next `Write`, `WritesDone` or `Finish`.
+  /// Use for streams of many small messages.
+  ///
+  /// @param request the next message to write
+  /// @throws ugrpc::client::RpcError on an RPC error
+  void WriteBuffered(const Request& request);
+
   /// @brief Announce end-of-output to the server
   ///
   /// Should be called to notify the server and receive the final response(s).
@@ -268,7 +296,8 @@ class USERVER_NODISCARD BidirectionalStream final {
       Stub& stub, grpc::CompletionQueue& queue,
       impl::RawReaderWriterPreparer<Stub, Request, Response> prepare_func,
       std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-      ugrpc::impl::MethodStatistics& statistics);
+      ugrpc::impl::MethodStatistics& statistics,
+      impl::EndpointUsage&& endpoint_usage);
 
   BidirectionalStream(BidirectionalStream&&) noexcept = default;
   BidirectionalStream& operator=(BidirectionalStream&&) noexcept = default;
@@ -287,10 +316,13 @@ UnaryCall<Response>::UnaryCall(
     Stub& stub, grpc::CompletionQueue& queue,
     impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-    ugrpc::impl::MethodStatistics& statistics, const Request& req)
+    ugrpc::impl::MethodStatistics& statistics,
+    impl::EndpointUsage&& endpoint_usage, const Request& req)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
+                                            statistics,
+                                            std::move(endpoint_usage))),
       reader_((stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
+  LOG_DEBUG() << "gRPC request: " << ugrpc::impl::MessageForLogging{req};
   reader_->StartCall();
   data_->SetState(impl::State::kWritesDone);
 }
@@ -324,10 +356,13 @@ InputStream<Response>::InputStream(
     Stub& stub, grpc::CompletionQueue& queue,
     impl::RawReaderPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-    ugrpc::impl::MethodStatistics& statistics, const Request& req)
+    ugrpc::impl::MethodStatistics& statistics,
+    impl::EndpointUsage&& endpoint_usage, const Request& req)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
+                                            statistics,
+                                            std::move(endpoint_usage))),
       stream_((stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
+  LOG_DEBUG() << "gRPC request: " << ugrpc::impl::MessageForLogging{req};
   impl::StartCall(*stream_, *data_);
   data_->SetState(impl::State::kWritesDone);
 }
@@ -358,9 +393,11 @@ OutputStream<Request, Response>::OutputStream(
     Stub& stub, grpc::CompletionQueue& queue,
     impl::RawWriterPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-    ugrpc::impl::MethodStatistics& statistics)
+    ugrpc::impl::MethodStatistics& statistics,
+    impl::EndpointUsage&& endpoint_usage)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
+                                            statistics,
+                                            std::move(endpoint_usage))),
       final_response_(std::make_unique<Response>()),
       // 'final_response_' will be filled upon successful 'Finish' async call
       stream_((stub.*prepare_func)(&data_->GetContext(), final_response_.get(),
@@ -382,6 +419,14 @@ void OutputStream<Request, Response>::Write(const Request& request) {
   impl::Write(*stream_, request, write_options, *data_);
 }
 
+template <typename Request, typename Response>
+void OutputStream<Request, Response>::WriteBuffered(const Request& request) {
+  grpc::WriteOptions write_options{};
+  write_options.set_buffer_hint();
+
+  impl::Write(*stream_, request, write_options, *data_);
+}
+
 template <typename Request, typename Response>
 Response OutputStream<Request, Response>::Finish() {
   // gRPC does not implicitly call `WritesDone` in `Finish`,
@@ -399,9 +444,11 @@ BidirectionalStream<Request, Response>::BidirectionalStream(
     Stub& stub, grpc::CompletionQueue& queue,
     impl::RawReaderWriterPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
-    ugrpc::impl::MethodStatistics& statistics)
+    ugrpc::impl::MethodStatistics& statistics,
+    impl::EndpointUsage&& endpoint_usage)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
+                                            statistics,
+                                            std::move(endpoint_usage))),
       stream_((stub.*prepare_func)(&data_->GetContext(), &queue)) {
   impl::StartCall(*stream_, *data_);
 }
@@ -429,6 +476,15 @@ void BidirectionalStream<Request, Response>::Write(const Request& request) {
   impl::Write(*stream_, request, write_options, *data_);
 }
 
+template <typename Request, typename Response>
+void BidirectionalStream<Request, Response>::WriteBuffered(
+    const Request& request) {
+  grpc::WriteOptions write_options{};
+  write_options.set_buffer_hint();
+
+  impl::Write(*stream_, request, write_options, *data_);
+}
+
 template <typename Request, typename Response>
 void BidirectionalStream<Request, Response>::WritesDone() {
   impl::WritesDone(*stream_, *data_);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <google/protobuf/message.h>
+
+#include <userver/logging/log_helper_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+/// The default limit of a logged message, in bytes
+inline constexpr std::size_t kMessageLogLimit = 512;
+
+/// @brief Formats the message in the single-line text format, stops once the
+/// output reaches `limit` bytes
+///
+/// Unlike a full TextFormat serialization, the cost is bounded by `limit`
+/// rather than by the size of the message: the formatting stops at the first
+/// field or element of a repeated field that does not fit, and long strings are
+/// truncated.
+std::string ToLimitedString(const google::protobuf::Message& message,
+                            std::size_t limit);
+
+/// @brief A message for a log line, formatted by ToLimitedString only if the
+/// log line is actually written
+///
+/// @code
+/// LOG_DEBUG() << "gRPC request: " << MessageForLogging{request};
+/// @endcode
+struct MessageForLogging final {
+  const google::protobuf::Message& message;
+  std::size_t limit{kMessageLogLimit};
+};
+
+logging::LogHelper& operator<<(logging::LogHelper& lh,
+                               const MessageForLogging& value);
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+
+#include <google/protobuf/arena.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+/// @brief A protobuf arena, which starts with a memory block recycled through
+/// a small thread-local pool
+///
+/// Messages created on the arena, along with all their submessages, don't hit
+/// the allocator until the initial block is exhausted.
+class PooledArena final {
+ public:
+  PooledArena();
+
+  PooledArena(PooledArena&&) = delete;
+  PooledArena& operator=(PooledArena&&) = delete;
+
+  google::protobuf::Arena& Get() noexcept { return arena_; }
+
+ private:
+  class Block final {
+   public:
+    Block();
+    ~Block();
+
+    Block(Block&&) = delete;
+    Block& operator=(Block&&) = delete;
+
+    char* Data() const noexcept { return data_.get(); }
+
+   private:
+    std::unique_ptr<char[]> data_;
+  };
+
+  // 'block_' must outlive 'arena_', which keeps its bookkeeping in the block
+  Block block_;
+  google::protobuf::Arena arena_;
+};
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
@@ -1,20 +1,37 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/engine/single_use_event.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
+/// Polling thread utilization of a completion queue
+struct QueueStatistics final {
+  std::atomic<std::uint64_t> events{0};
+  // time spent processing the events, as opposed to waiting for them
+  std::atomic<std::uint64_t> busy_time_us{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const QueueStatistics& stats);
+
 class QueueRunner final {
  public:
   explicit QueueRunner(grpc::CompletionQueue& queue);
   ~QueueRunner();
 
+  const QueueStatistics& GetStatistics() const noexcept { return stats_; }
+
  private:
   grpc::CompletionQueue& queue_;
+  QueueStatistics stats_;
   engine::SingleUseEvent completion_;
 };
 
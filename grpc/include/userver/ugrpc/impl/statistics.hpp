@@ -38,6 +38,16 @@ class MethodStatistics final {
   // UNKNOWN status code is automatically returned in this case.
   void AccountInternalError() noexcept;
 
+  // The RPCs are limited by server::MethodConcurrencyLimit
+  void SetConcurrencyLimit(std::size_t limit) noexcept;
+
+  void AccountConcurrencyAcquired() noexcept;
+
+  void AccountConcurrencyReleased() noexcept;
+
+  // The RPC is rejected with RESOURCE_EXHAUSTED due to the concurrency limit
+  void AccountConcurrencyRejected() noexcept;
+
   friend void DumpMetric(utils::statistics::Writer& writer,
                          const MethodStatistics& stats);
 
@@ -56,6 +66,10 @@ class MethodStatistics final {
   utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
   Counter network_errors_{0};
   Counter internal_errors_{0};
+  std::atomic<bool> has_concurrency_limit_{false};
+  std::atomic<std::size_t> concurrency_limit_{0};
+  Counter concurrency_in_flight_{0};
+  Counter concurrency_rejected_{0};
 };
 
 class ServiceStatistics final {
@@ -77,6 +91,37 @@ class ServiceStatistics final {
   utils::FixedArray<MethodStatistics> method_statistics_;
 };
 
+/// Client-side statistics of a single endpoint, aggregated over all the
+/// clients of a ClientFactory
+class EndpointStatistics final {
+ public:
+  explicit EndpointStatistics(std::size_t channel_count);
+
+  void AccountStarted(std::size_t channel_index) noexcept;
+
+  void AccountFinished(std::size_t channel_index, bool is_failure) noexcept;
+
+  std::size_t GetChannelCount() const noexcept;
+
+  // Requests in flight on the channel, over all the clients of the factory
+  std::uint64_t GetChannelInFlight(std::size_t channel_index) const noexcept;
+
+  // The endpoint has been excluded from balancing due to its error rate
+  void AccountEjection() noexcept;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const EndpointStatistics& stats);
+
+ private:
+  using Counter = std::atomic<std::uint64_t>;
+
+  Counter started_{0};
+  Counter finished_{0};
+  Counter failures_{0};
+  Counter ejections_{0};
+  utils::FixedArray<Counter> channel_in_flight_;
+};
+
 }  // namespace ugrpc::impl
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 
@@ -27,6 +29,9 @@ class StatisticsStorage final {
   ugrpc::impl::ServiceStatistics& GetServiceStatistics(
       const ugrpc::impl::StaticServiceMetadata& metadata);
 
+  ugrpc::impl::EndpointStatistics& GetEndpointStatistics(
+      const std::string& endpoint, std::size_t channel_count);
+
  private:
   // Pointer to service name from its metadata is used as a unique service ID
   using ServiceId = const char*;
@@ -35,6 +40,8 @@ class StatisticsStorage final {
 
   std::unordered_map<ServiceId, ugrpc::impl::ServiceStatistics>
       service_statistics_;
+  std::unordered_map<std::string, ugrpc::impl::EndpointStatistics>
+      endpoint_statistics_;
   engine::SharedMutex mutex_;
 
   utils::statistics::Entry statistics_holder_;
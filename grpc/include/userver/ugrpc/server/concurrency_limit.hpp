@@ -0,0 +1,44 @@
+#pragma once
+
+/// @file userver/ugrpc/server/concurrency_limit.hpp
+/// @brief @copybrief ugrpc::server::MethodConcurrencyLimit
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+/// @brief Limits the number of RPCs of a method that are handled at the same
+/// time
+///
+/// The RPCs over the limit wait for a free slot in a bounded queue. The rest
+/// are rejected right away with `RESOURCE_EXHAUSTED`, so that the clients may
+/// retry them on other hosts instead of piling up in the task processor.
+struct MethodConcurrencyLimit final {
+  /// The maximum number of RPCs handled at the same time
+  std::size_t max_in_flight{0};
+
+  /// The maximum number of RPCs waiting for a free slot
+  std::size_t max_queue_size{0};
+
+  /// How long an RPC waits in the queue before it is rejected
+  std::chrono::milliseconds queue_timeout{100};
+};
+
+/// Concurrency limits of the methods of a service by method name, e.g.
+/// `SayHello`
+using MethodConcurrencyLimits =
+    std::unordered_map<std::string, MethodConcurrencyLimit>;
+
+MethodConcurrencyLimit Parse(const yaml_config::YamlConfig& value,
+                             formats::parse::To<MethodConcurrencyLimit>);
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
@@ -8,7 +8,9 @@
 #include <grpcpp/impl/codegen/async_unary_call.h>
 #include <grpcpp/impl/codegen/status.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
+#include <userver/ugrpc/impl/message_logging.hpp>
 #include <userver/ugrpc/server/exceptions.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -38,10 +40,13 @@ void ReportErrorWhileCancelling(std::string_view call_name) noexcept;
 
 extern const grpc::Status kUnimplementedStatus;
 extern const grpc::Status kUnknownErrorStatus;
+extern const grpc::Status kConcurrencyLimitStatus;
 
 template <typename GrpcStream, typename Response>
 void Finish(GrpcStream& stream, const Response& response,
             const grpc::Status& status, std::string_view call_name) {
+  LOG_DEBUG() << "gRPC response: "
+              << ugrpc::impl::MessageForLogging{response};
   AsyncMethodInvocation finish;
   stream.Finish(response, status, finish.GetTag());
   if (!finish.Wait()) {
@@ -96,12 +101,16 @@ template <typename GrpcStream, typename Request>
 bool Read(GrpcStream& stream, Request& request) {
   AsyncMethodInvocation read;
   stream.Read(&request, read.GetTag());
-  return read.Wait();
+  if (!read.Wait()) return false;
+  LOG_DEBUG() << "gRPC request: " << ugrpc::impl::MessageForLogging{request};
+  return true;
 }
 
 template <typename GrpcStream, typename Response>
 void Write(GrpcStream& stream, const Response& response,
            grpc::WriteOptions options, std::string_view call_name) {
+  LOG_DEBUG() << "gRPC response: "
+              << ugrpc::impl::MessageForLogging{response};
   AsyncMethodInvocation write;
   stream.Write(response, options, write.GetTag());
   if (!write.Wait()) {
@@ -113,6 +122,8 @@ template <typename GrpcStream, typename Response>
 void WriteAndFinish(GrpcStream& stream, const Response& response,
                     grpc::WriteOptions options, const grpc::Status& status,
                     std::string_view call_name) {
+  LOG_DEBUG() << "gRPC response: "
+              << ugrpc::impl::MessageForLogging{response};
   AsyncMethodInvocation write_and_finish;
   stream.WriteAndFinish(response, options, status, write_and_finish.GetTag());
   if (!write_and_finish.Wait()) {
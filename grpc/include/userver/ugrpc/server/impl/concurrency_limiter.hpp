@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/congestion_control/sensor.hpp>
+#include <userver/engine/semaphore.hpp>
+
+#include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/ugrpc/server/concurrency_limit.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+/// Holds a slot of ConcurrencyLimiter, empty if the RPC is rejected
+class ConcurrencyPermit final {
+ public:
+  ConcurrencyPermit() noexcept = default;
+  ConcurrencyPermit(engine::SemaphoreLock&& lock,
+                    ugrpc::impl::MethodStatistics& statistics) noexcept;
+
+  ConcurrencyPermit(ConcurrencyPermit&&) noexcept;
+  ConcurrencyPermit& operator=(ConcurrencyPermit&&) noexcept;
+  ~ConcurrencyPermit();
+
+  explicit operator bool() const noexcept { return lock_.OwnsLock(); }
+
+ private:
+  engine::SemaphoreLock lock_;
+  ugrpc::impl::MethodStatistics* statistics_{nullptr};
+};
+
+/// @brief Limits the RPCs of a single method, see MethodConcurrencyLimit
+///
+/// As a congestion_control::Sensor, reports the RPCs in flight as the load,
+/// the rejected RPCs as the overload events and the admitted ones as the
+/// no-overload events since the previous fetch.
+class ConcurrencyLimiter final : public congestion_control::Sensor {
+ public:
+  ConcurrencyLimiter(const MethodConcurrencyLimit& limit,
+                     ugrpc::impl::MethodStatistics& statistics);
+
+  /// Takes a free slot, waiting in the queue if there is room in it
+  ConcurrencyPermit Acquire();
+
+  Data FetchCurrent() override;
+
+ private:
+  const MethodConcurrencyLimit limit_;
+  ugrpc::impl::MethodStatistics& statistics_;
+  engine::Semaphore semaphore_;
+  std::atomic<std::size_t> queued_{0};
+  std::atomic<std::uint64_t> admitted_{0};
+  std::atomic<std::uint64_t> rejected_{0};
+
+  // only touched by FetchCurrent
+  std::uint64_t last_admitted_{0};
+  std::uint64_t last_rejected_{0};
+};
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@
 
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
+#include <userver/ugrpc/server/concurrency_limit.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,9 +21,13 @@ namespace ugrpc::server::impl {
 
 /// Config for a `ServiceWorker`, provided by `ugrpc::server::Server`
 struct ServiceSettings final {
-  grpc::ServerCompletionQueue& queue;
+  /// Each method listens to requests on all the queues
+  std::vector<grpc::ServerCompletionQueue*> queues;
   engine::TaskProcessor& task_processor;
   ugrpc::impl::StatisticsStorage& statistics_storage;
+  /// Whether to allocate incoming messages on protobuf arenas
+  bool use_arena{false};
+  MethodConcurrencyLimits concurrency_limits{};
 };
 
 /// @brief Listens to requests for a gRPC service, forwarding them to a
@@ -2,11 +2,15 @@
 
 #include <exception>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/impl/service_type.h>
 #include <grpcpp/server_context.h>
@@ -14,6 +18,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/tracing/in_place_span.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
@@ -21,12 +26,15 @@
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/lazy_prvalue.hpp>
 
+#include <userver/ugrpc/impl/message_logging.hpp>
+#include <userver/ugrpc/impl/pooled_arena.hpp>
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 #include <userver/ugrpc/server/impl/async_method_invocation.hpp>
 #include <userver/ugrpc/server/impl/async_service.hpp>
 #include <userver/ugrpc/server/impl/call_traits.hpp>
+#include <userver/ugrpc/server/impl/concurrency_limiter.hpp>
 #include <userver/ugrpc/server/impl/service_worker.hpp>
 #include <userver/ugrpc/server/rpc.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
@@ -46,6 +54,12 @@ void ReportNetworkError(const RpcInterruptedError& ex,
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                grpc::ServerContext& context, std::string_view call_name);
 
+// Has nullptr for the methods without a limit
+std::vector<std::unique_ptr<ConcurrencyLimiter>> MakeConcurrencyLimiters(
+    const ServiceSettings& settings,
+    const ugrpc::impl::StaticServiceMetadata& metadata,
+    ugrpc::impl::ServiceStatistics& statistics);
+
 /// Per-gRPC-service data
 template <typename GrpcppService>
 struct ServiceData final {
@@ -53,8 +67,9 @@ struct ServiceData final {
               const ugrpc::impl::StaticServiceMetadata& metadata)
       : settings(settings),
         metadata(metadata),
-        statistics(settings.statistics_storage.GetServiceStatistics(metadata)) {
-  }
+        statistics(settings.statistics_storage.GetServiceStatistics(metadata)),
+        concurrency_limiters(
+            MakeConcurrencyLimiters(settings, metadata, statistics)) {}
 
   ~ServiceData() = default;
 
@@ -63,6 +78,7 @@ struct ServiceData final {
   AsyncService<GrpcppService> async_service{metadata.method_full_names.size()};
   utils::impl::WaitTokenStorage wait_tokens;
   ugrpc::impl::ServiceStatistics& statistics;
+  const std::vector<std::unique_ptr<ConcurrencyLimiter>> concurrency_limiters;
 };
 
 /// Per-gRPC-method data
@@ -72,11 +88,14 @@ struct MethodData final {
   const std::size_t method_id{};
   typename CallTraits::ServiceBase& service;
   const typename CallTraits::ServiceMethod service_method;
+  grpc::ServerCompletionQueue& queue;
 
   std::string_view call_name{
       service_data.metadata.method_full_names[method_id]};
   ugrpc::impl::MethodStatistics& statistics{
       service_data.statistics.GetMethodStatistics(method_id)};
+  ConcurrencyLimiter* concurrency_limiter{
+      service_data.concurrency_limiters[method_id].get()};
 };
 
 template <typename GrpcppService, typename CallTraits>
@@ -101,7 +120,7 @@ class CallData final {
     context_.AsyncNotifyWhenDone(notify_when_done.GetTag());
 
     // the request for an incoming RPC must be performed synchronously
-    auto& queue = method_data_.service_data.settings.queue;
+    auto& queue = method_data_.queue;
     method_data_.service_data.async_service.template Prepare<CallTraits>(
         method_data_.method_id, context_, initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
@@ -139,6 +158,16 @@ class CallData final {
   using RawCall = typename CallTraits::RawCall;
   using Call = typename CallTraits::Call;
 
+  InitialRequest& MakeInitialRequest() {
+    if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+      if (method_data_.service_data.settings.use_arena) {
+        auto& arena = arena_.emplace().Get();
+        return *google::protobuf::Arena::CreateMessage<InitialRequest>(&arena);
+      }
+    }
+    return initial_request_storage_;
+  }
+
   void HandleRpc() {
     const auto call_name = method_data_.call_name;
     auto& service = method_data_.service;
@@ -152,9 +181,20 @@ class CallData final {
                    span_->Get());
 
     try {
+      ConcurrencyPermit permit;
+      if (auto* limiter = method_data_.concurrency_limiter) {
+        permit = limiter->Acquire();
+        if (!permit) {
+          responder.FinishWithError(kConcurrencyLimitStatus);
+          return;
+        }
+      }
+
       if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
         (service.*service_method)(responder);
       } else {
+        LOG_DEBUG() << "gRPC request: "
+                    << ugrpc::impl::MessageForLogging{initial_request_};
         (service.*service_method)(responder, std::move(initial_request_));
       }
     } catch (const RpcInterruptedError& ex) {
@@ -172,7 +212,10 @@ class CallData final {
   MethodData<GrpcppService, CallTraits> method_data_;
 
   grpc::ServerContext context_{};
-  InitialRequest initial_request_{};
+  // 'arena_' must outlive the request allocated on it
+  std::optional<ugrpc::impl::PooledArena> arena_{};
+  InitialRequest initial_request_storage_{};
+  InitialRequest& initial_request_{MakeInitialRequest()};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_{};
   std::optional<tracing::InPlaceSpan> span_{};
@@ -187,10 +230,13 @@ class ServiceWorkerImpl final : public ServiceWorker {
                     Service& service, ServiceMethods... service_methods)
       : service_data_(settings, metadata),
         start_{[this, &service, service_methods...] {
-          std::size_t method_id = 0;
-          (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
-               {service_data_, method_id++, service, service_methods}),
-           ...);
+          for (auto* queue : service_data_.settings.queues) {
+            std::size_t method_id = 0;
+            (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
+                 {service_data_, method_id++, service, service_methods,
+                  *queue}),
+             ...);
+          }
         }} {}
 
   ~ServiceWorkerImpl() override {
@@ -0,0 +1,92 @@
+#pragma once
+
+/// @file userver/ugrpc/server/json_transcoding_handler.hpp
+/// @brief @copybrief ugrpc::server::JsonTranscodingHandler
+
+#include <memory>
+#include <string>
+
+#include <google/protobuf/descriptor.h>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+namespace impl {
+class JsonTranscoder;
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief HTTP handler that exposes unary gRPC methods of the
+/// ugrpc::server::Server to HTTP/JSON clients
+///
+/// The request body is a JSON representation of the request message, the
+/// response body is a JSON representation of the response message, as per
+/// https://protobuf.dev/programming-guides/proto3/#json
+///
+/// The method is found by its descriptor in the generated descriptor pool,
+/// so no code is generated for the handler. The body is converted between
+/// JSON text and the protobuf wire format in a streaming manner: neither a
+/// formats::json::Value nor a protobuf message is built. The request is sent
+/// to the service over an in-process channel of the server, so it is accounted
+/// in the gRPC statistics and concurrency limits as a usual gRPC request.
+///
+/// A non-OK status of the call results in an HTTP error status and a
+/// `{"code": <grpc code>, "message": "..."}` JSON body.
+///
+/// ## Static options:
+/// The default component name for static config is `"grpc-json-transcoding-handler"`.
+/// Besides the @ref userver_http_handlers "common handler options":
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// grpc-server | the name of the ugrpc::server::ServerComponent | grpc-server
+/// grpc-method | the full name of the method, e.g. `package.Service/Method`; if missing, the `{service}` and `{method}` path arguments are used | -
+/// ignore-unknown-fields | ignore the unknown fields of the request JSON instead of answering 400 | false
+/// preserve-proto-field-names | use the field names of .proto files instead of lowerCamelCase in the response | false
+/// always-print-primitive-fields | print the fields with default values in the response | false
+///
+/// ## Static config example:
+/// @code
+/// say-hello-handler:
+///     path: /v1/hello
+///     method: POST
+///     task_processor: main-task-processor
+///     grpc-method: samples.api.GreeterService/SayHello
+/// @endcode
+
+// clang-format on
+class JsonTranscodingHandler final
+    : public USERVER_NAMESPACE::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "grpc-json-transcoding-handler";
+
+  JsonTranscodingHandler(const components::ComponentConfig& config,
+                         const components::ComponentContext& context);
+
+  ~JsonTranscodingHandler() override;
+
+  std::string HandleRequestThrow(
+      const USERVER_NAMESPACE::server::http::HttpRequest& request,
+      USERVER_NAMESPACE::server::request::RequestContext& context)
+      const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const std::unique_ptr<impl::JsonTranscoder> transcoder_;
+  const google::protobuf::MethodDescriptor* const method_;
+};
+
+}  // namespace ugrpc::server
+
+template <>
+inline constexpr bool
+    components::kHasValidate<ugrpc::server::JsonTranscodingHandler> = true;
+
+USERVER_NAMESPACE_END
@@ -138,6 +138,16 @@ class OutputStream final {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Write the next outgoing message, allowing gRPC to hold it back
+  ///
+  /// The message may be coalesced with the following ones and is only
+  /// guaranteed to be sent out on the next `Write` or `Finish`. Use for
+  /// streams of many small messages.
+  ///
+  /// @param response the next message to write
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void WriteBuffered(const Response& response);
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -211,6 +221,16 @@ class BidirectionalStream {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Write the next outgoing message, allowing gRPC to hold it back
+  ///
+  /// The message may be coalesced with the following ones and is only
+  /// guaranteed to be sent out on the next `Write` or `Finish`. Use for
+  /// streams of many small messages.
+  ///
+  /// @param response the next message to write
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void WriteBuffered(const Response& response);
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -395,6 +415,19 @@ void OutputStream<Response>::Write(const Response& response) {
   impl::Write(stream_, response, write_options, call_name_);
 }
 
+template <typename Response>
+void OutputStream<Response>::WriteBuffered(const Response& response) {
+  UINVARIANT(state_ != State::kFinished,
+             "'WriteBuffered' called on a finished stream");
+
+  impl::SendInitialMetadataIfNew(stream_, call_name_, state_);
+
+  grpc::WriteOptions write_options{};
+  write_options.set_buffer_hint();
+
+  impl::Write(stream_, response, write_options, call_name_);
+}
+
 template <typename Response>
 void OutputStream<Response>::Finish() {
   UINVARIANT(state_ != State::kFinished,
@@ -473,6 +506,18 @@ void BidirectionalStream<Request, Response>::Write(const Response& response) {
   impl::Write(stream_, response, write_options, call_name_);
 }
 
+template <typename Request, typename Response>
+void BidirectionalStream<Request, Response>::WriteBuffered(
+    const Response& response) {
+  UINVARIANT(state_ == State::kOpen,
+             "'WriteBuffered' called on a finished stream");
+
+  grpc::WriteOptions write_options{};
+  write_options.set_buffer_hint();
+
+  impl::Write(stream_, response, write_options, call_name_);
+}
+
 template <typename Request, typename Response>
 void BidirectionalStream<Request, Response>::Finish() {
   UINVARIANT(state_ != State::kFinished,
@@ -3,10 +3,12 @@
 /// @file userver/ugrpc/server/server.hpp
 /// @brief @copybrief ugrpc::server::Server
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <unordered_map>
 
+#include <grpcpp/channel.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_builder.h>
 
@@ -16,6 +18,7 @@
 #include <userver/yaml_config/fwd.hpp>
 
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/ugrpc/server/concurrency_limit.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -39,6 +42,15 @@ struct ServerConfig final {
 
   /// Serve a web page with runtime info about gRPC connections
   bool enable_channelz{false};
+
+  /// The number of completion queues, each one is polled by a separate thread.
+  /// RPCs are spread over the queues, which allows to handle more requests
+  /// than a single polling thread is able to.
+  std::size_t completion_queue_count{1};
+
+  /// Allocate incoming messages, along with their submessages, on protobuf
+  /// arenas. Reduces the number of allocations for deeply nested messages.
+  bool use_arena{false};
 };
 
 ServerConfig Parse(const yaml_config::YamlConfig& value,
@@ -63,7 +75,10 @@ class Server final {
   /// @brief Register a service implementation in the server. The user or the
   /// component is responsible for keeping `service` alive at least until `Stop`
   /// is called.
-  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor);
+  /// @param concurrency_limits per-method limits of the RPCs handled at the
+  /// same time, see MethodConcurrencyLimit
+  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor,
+                  MethodConcurrencyLimits concurrency_limits = {});
 
   /// @brief Get names of all registered services
   std::vector<std::string_view> GetServiceNames() const;
@@ -78,6 +93,12 @@ class Server final {
   /// usually no more than one instance per program.
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  /// @returns the channel that sends the requests to the services of this
+  /// server directly, bypassing the network
+  /// @note Only available after 'Start' has returned. The channel is created
+  /// by 'Start' and is shared by all the callers.
+  std::shared_ptr<grpc::Channel> GetInProcessChannel();
+
   /// @brief Start accepting requests
   /// @note Must be called at most once after all the services are registered
   void Start();
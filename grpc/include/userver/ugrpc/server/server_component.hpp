@@ -26,6 +26,8 @@ namespace ugrpc::server {
 /// channel-args | a map of channel arguments, see gRPC Core docs | {}
 /// native-log-level | min log level for the native gRPC library | 'error'
 /// enable-channelz | initialize service with runtime info about gRPC connections | false
+/// completion-queue-count | the number of completion queues, each one is polled by a separate thread | 1
+/// use-arena | allocate incoming messages on protobuf arenas | false
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
 
@@ -8,6 +8,7 @@
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
+#include <userver/ugrpc/server/concurrency_limit.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +17,8 @@ namespace ugrpc::server {
 
 class Server;
 
+// clang-format off
+
 /// @ingroup userver_components userver_base_classes
 ///
 /// @brief Base class for all the gRPC service components.
@@ -24,6 +27,13 @@ class Server;
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// task-processor | the task processor to use for responses | -
+/// concurrency-limits | per-method limits of the RPCs handled at the same time, see ugrpc::server::MethodConcurrencyLimit | {}
+/// concurrency-limits.<method>.max-in-flight | the maximum number of RPCs of the method handled at the same time | -
+/// concurrency-limits.<method>.max-queue-size | the maximum number of RPCs waiting for a free slot, the rest are rejected with RESOURCE_EXHAUSTED | 0
+/// concurrency-limits.<method>.queue-timeout | how long an RPC waits in the queue before it is rejected | 100ms
+
+// clang-format on
+
 class ServiceComponentBase : public components::LoggableComponentBase {
  public:
   ServiceComponentBase(const components::ComponentConfig& config,
@@ -39,6 +49,7 @@ class ServiceComponentBase : public components::LoggableComponentBase {
  private:
   Server& server_;
   engine::TaskProcessor& service_task_processor_;
+  const MethodConcurrencyLimits concurrency_limits_;
   std::atomic<bool> registered_{false};
 };
 
@@ -0,0 +1,90 @@
+#include <userver/utest/utest.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+#include <userver/ugrpc/client/client_factory.hpp>
+#include <userver/ugrpc/server/server.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class UnitTestServiceArena final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    EXPECT_NE(request.GetArena(), nullptr);
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    EXPECT_NE(request.GetArena(), nullptr);
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name("Hello again " + request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.use_arena = true;
+  return config;
+}
+
+}  // namespace
+
+UTEST(GrpcArena, IncomingMessages) {
+  utils::statistics::Storage statistics_storage;
+
+  UnitTestServiceArena service;
+  ugrpc::server::Server server(MakeServerConfig(), statistics_storage);
+  server.AddService(service, engine::current_task::GetTaskProcessor());
+  server.Start();
+
+  {
+    ugrpc::client::ClientFactory client_factory(
+        {}, engine::current_task::GetTaskProcessor(),
+        server.GetCompletionQueue(), statistics_storage);
+    auto client =
+        client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+            fmt::format("[::1]:{}", server.GetPort()));
+
+    // the arena blocks are recycled between the calls
+    for (int i = 0; i < 10; ++i) {
+      sample::ugrpc::GreetingRequest request;
+      request.set_name("userver");
+      EXPECT_EQ(client.SayHello(request).Finish().name(), "Hello userver");
+    }
+
+    sample::ugrpc::StreamGreetingRequest request;
+    request.set_name("userver");
+    request.set_number(3);
+    auto stream = client.ReadMany(request);
+
+    sample::ugrpc::StreamGreetingResponse response;
+    int count = 0;
+    while (stream.Read(response)) {
+      EXPECT_EQ(response.number(), count);
+      ++count;
+    }
+    EXPECT_EQ(count, 3);
+  }
+
+  server.Stop();
+}
+
+USERVER_NAMESPACE_END
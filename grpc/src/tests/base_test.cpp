@@ -310,4 +310,66 @@ UTEST_F(GrpcWriteAndFinish, BidirectionalStream) {
   EXPECT_FALSE(is.Read(in));
 }
 
+namespace {
+
+class WriteBufferedService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name("Hello " + request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.WriteBuffered(response);
+    }
+    call.Finish();
+  }
+
+  void WriteMany(WriteManyCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    int count = 0;
+    while (call.Read(request)) {
+      ++count;
+    }
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_number(count);
+    call.Finish(response);
+  }
+};
+
+}  // namespace
+
+using GrpcWriteBuffered = GrpcServiceFixtureSimple<WriteBufferedService>;
+
+UTEST_F(GrpcWriteBuffered, InputStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  out.set_number(kNumber);
+  auto is = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(is.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  EXPECT_FALSE(is.Read(in));
+}
+
+UTEST_F(GrpcWriteBuffered, OutputStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto os = client.WriteMany();
+
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  for (int i = 0; i < kNumber; ++i) {
+    out.set_number(i);
+    UEXPECT_NO_THROW(os.WriteBuffered(out));
+  }
+
+  sample::ugrpc::StreamGreetingResponse in;
+  UEXPECT_NO_THROW(in = os.Finish());
+  EXPECT_EQ(in.number(), kNumber);
+}
+
 USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 
 #include <userver/ugrpc/client/client_factory.hpp>
 #include <userver/ugrpc/client/exceptions.hpp>
@@ -143,6 +144,57 @@ UTEST(GrpcServer, DeadlineAffectsWaitForReady) {
   EXPECT_FALSE(long_deadline.IsReached());
 }
 
+UTEST(GrpcServer, TaskDeadlineLimitsContextDeadline) {
+  utils::statistics::Storage statistics_storage;
+  ugrpc::client::QueueHolder client_queue;
+  const std::string endpoint = "[::1]:1234";
+
+  ugrpc::client::ClientFactory client_factory(
+      ugrpc::client::ClientFactoryConfig{},
+      engine::current_task::GetTaskProcessor(), client_queue.GetQueue(),
+      statistics_storage);
+
+  auto client =
+      client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(endpoint);
+
+  const std::string method = "GET";
+  const auto task_deadline = engine::Deadline::FromDuration(100ms);
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(), task_deadline});
+
+  // the context deadline is shrunk to the time left of the handled request
+  auto context = std::make_unique<grpc::ClientContext>();
+  context->set_deadline(engine::Deadline::FromDuration(100ms + 1s));
+  context->set_wait_for_ready(true);
+  auto call = client.SayHello({}, std::move(context));
+  EXPECT_LE(call.GetContext().deadline(),
+            std::chrono::system_clock::now() + 100ms);
+  UEXPECT_THROW(call.Finish(), ugrpc::client::DeadlineExceededError);
+  EXPECT_TRUE(task_deadline.IsReached());
+
+  // a shorter context deadline is kept as is
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(),
+       engine::Deadline::FromDuration(1s)});
+  const auto short_deadline = std::chrono::system_clock::now() + 50ms;
+  context = std::make_unique<grpc::ClientContext>();
+  context->set_deadline(short_deadline);
+  auto short_call = client.SayHello({}, std::move(context));
+  EXPECT_EQ(short_call.GetContext().deadline(), short_deadline);
+  UEXPECT_THROW(short_call.Finish(), ugrpc::client::BaseError);
+
+  // an expired deadline fails the call right away
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(),
+       engine::Deadline::Passed()});
+  const auto long_deadline = engine::Deadline::FromDuration(1s);
+  context = std::make_unique<grpc::ClientContext>();
+  context->set_wait_for_ready(true);
+  auto expired_call = client.SayHello({}, std::move(context));
+  UEXPECT_THROW(expired_call.Finish(), ugrpc::client::DeadlineExceededError);
+  EXPECT_FALSE(long_deadline.IsReached());
+}
+
 namespace {
 
 class UnitTestServiceCancelHello final
@@ -1,5 +1,8 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <string>
+#include <vector>
+
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/value.hpp>
@@ -41,4 +44,66 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, ChannelsCountByEndpoint) {
+  formats::yaml::ValueBuilder builder(formats::common::Type::kObject);
+  builder["channel-count"] = 2;
+  builder["channel-count-by-endpoint"]["[::]:50052"] = 5;
+  builder["channel-selection"] = "least-loaded";
+
+  const auto yaml_data = builder.ExtractValue();
+  yaml_config::YamlConfig yaml_config(yaml_data, formats::yaml::Value());
+
+  auto config = yaml_config.As<ugrpc::client::ClientFactoryConfig>();
+  EXPECT_EQ(config.channel_selection,
+            ugrpc::client::ChannelSelection::kLeastLoaded);
+  ugrpc::client::QueueHolder client_queue;
+  utils::statistics::Storage statistics_storage;
+
+  ugrpc::client::ClientFactory client_factory(
+      std::move(config), engine::current_task::GetTaskProcessor(),
+      client_queue.GetQueue(), statistics_storage);
+
+  const std::vector<std::string> endpoints{"[::]:50051", "[::]:50052"};
+  auto client =
+      client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+          endpoints);
+
+  auto& data = ugrpc::client::impl::GetClientData(client);
+  EXPECT_EQ(2, data.GetChannelToken(0).GetChannelCount());
+  EXPECT_EQ(5, data.GetChannelToken(1).GetChannelCount());
+
+  // the channel with an active request is avoided
+  const auto busy_channel = data.NextChannel(1);
+  const auto usage = data.MakeEndpointUsage(1, busy_channel);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(busy_channel, data.NextChannel(1));
+  }
+}
+
+UTEST(GrpcClient, SeveralEndpoints) {
+  ugrpc::client::QueueHolder client_queue;
+  utils::statistics::Storage statistics_storage;
+
+  ugrpc::client::ClientFactory client_factory(
+      {}, engine::current_task::GetTaskProcessor(), client_queue.GetQueue(),
+      statistics_storage);
+
+  const std::vector<std::string> endpoints{"[::]:50051", "[::]:50052",
+                                           "[::]:50053"};
+  auto client =
+      client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+          endpoints);
+
+  auto& data = ugrpc::client::impl::GetClientData(client);
+  ASSERT_EQ(endpoints.size(), data.GetEndpointCount());
+
+  // the endpoint with an active request is avoided
+  const auto busy_endpoint = data.NextEndpoint();
+  const auto usage =
+      data.MakeEndpointUsage(busy_endpoint, data.NextChannel(busy_endpoint));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(busy_endpoint, data.NextEndpoint());
+  }
+}
+
 USERVER_NAMESPACE_END
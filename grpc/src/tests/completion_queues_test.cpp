@@ -0,0 +1,86 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include <userver/ugrpc/client/client_factory.hpp>
+#include <userver/ugrpc/server/server.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class UnitTestServiceSimple final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+};
+
+constexpr std::size_t kQueueCount = 3;
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.completion_queue_count = kQueueCount;
+  return config;
+}
+
+}  // namespace
+
+UTEST_MT(GrpcCompletionQueues, RequestsAreSpread, 4) {
+  constexpr int kRequestCount = 100;
+  utils::statistics::Storage statistics_storage;
+
+  UnitTestServiceSimple service;
+  ugrpc::server::Server server(MakeServerConfig(), statistics_storage);
+  server.AddService(service, engine::current_task::GetTaskProcessor());
+  server.Start();
+
+  {
+    ugrpc::client::ClientFactory client_factory(
+        {}, engine::current_task::GetTaskProcessor(),
+        server.GetCompletionQueue(), statistics_storage);
+    auto client =
+        client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+            fmt::format("[::1]:{}", server.GetPort()));
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < kRequestCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&client, i] {
+        sample::ugrpc::GreetingRequest request;
+        request.set_name(std::to_string(i));
+        EXPECT_EQ(client.SayHello(request).Finish().name(),
+                  "Hello " + std::to_string(i));
+      }));
+    }
+    engine::GetAll(tasks);
+  }
+
+  const utils::statistics::Snapshot stats{statistics_storage,
+                                          "grpc.server-queues"};
+  for (std::size_t i = 0; i < kQueueCount; ++i) {
+    EXPECT_GT(
+        stats.SingleMetric("events", {{"grpc_queue", std::to_string(i)}})
+            .AsInt(),
+        0);
+  }
+
+  server.Stop();
+}
+
+USERVER_NAMESPACE_END
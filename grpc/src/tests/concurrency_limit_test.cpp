@@ -0,0 +1,136 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/server/concurrency_limit.hpp>
+
+#include <tests/service_fixture_test.hpp>
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class UnitTestServiceBlocking final
+    : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    if (request.name() == "wait") {
+      started_event_.Send();
+      EXPECT_TRUE(release_event_.WaitForEventFor(utest::kMaxTestWaitTime));
+    }
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  auto& GetStartedEvent() { return started_event_; }
+  auto& GetReleaseEvent() { return release_event_; }
+
+ private:
+  engine::SingleConsumerEvent started_event_;
+  engine::SingleConsumerEvent release_event_;
+};
+
+class GrpcConcurrencyLimit : public GrpcServiceFixture {
+ protected:
+  ~GrpcConcurrencyLimit() override { StopServer(); }
+
+  void Start(const ugrpc::server::MethodConcurrencyLimit& limit) {
+    GetServer().AddService(service_, engine::current_task::GetTaskProcessor(),
+                           {{"SayHello", limit}});
+    StartServer();
+  }
+
+  UnitTestServiceBlocking& GetService() { return service_; }
+
+  utils::statistics::Snapshot GetConcurrencyStatistics() {
+    return GetStatistics(
+        "grpc.server.by-destination.concurrency",
+        {{"grpc_destination", "sample.ugrpc.UnitTestService/SayHello"}});
+  }
+
+ private:
+  UnitTestServiceBlocking service_;
+};
+
+sample::ugrpc::GreetingRequest MakeRequest(std::string name) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name(std::move(name));
+  return request;
+}
+
+}  // namespace
+
+UTEST_F(GrpcConcurrencyLimit, RejectsOverLimit) {
+  Start({/*max_in_flight=*/1, /*max_queue_size=*/0});
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  auto blocked = engine::AsyncNoSpan(
+      [&] { return client.SayHello(MakeRequest("wait")).Finish().name(); });
+  ASSERT_TRUE(
+      GetService().GetStartedEvent().WaitForEventFor(utest::kMaxTestWaitTime));
+
+  UEXPECT_THROW(client.SayHello(MakeRequest("rejected")).Finish(),
+                ugrpc::client::ResourceExhaustedError);
+
+  GetService().GetReleaseEvent().Send();
+  EXPECT_EQ(blocked.Get(), "Hello wait");
+  EXPECT_EQ(client.SayHello(MakeRequest("after")).Finish().name(),
+            "Hello after");
+
+  GetServer().StopDebug();
+  const auto stats = GetConcurrencyStatistics();
+  EXPECT_EQ(stats.SingleMetric("limit").AsInt(), 1);
+  EXPECT_EQ(stats.SingleMetric("in-flight").AsInt(), 0);
+  EXPECT_EQ(stats.SingleMetric("rejected").AsInt(), 1);
+}
+
+UTEST_F(GrpcConcurrencyLimit, QueuesUpToLimit) {
+  Start({/*max_in_flight=*/1, /*max_queue_size=*/1,
+         /*queue_timeout=*/utest::kMaxTestWaitTime});
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  auto blocked = engine::AsyncNoSpan(
+      [&] { return client.SayHello(MakeRequest("wait")).Finish().name(); });
+  ASSERT_TRUE(
+      GetService().GetStartedEvent().WaitForEventFor(utest::kMaxTestWaitTime));
+
+  auto queued = engine::AsyncNoSpan(
+      [&] { return client.SayHello(MakeRequest("queued")).Finish().name(); });
+  engine::SleepFor(50ms);
+  EXPECT_FALSE(queued.IsFinished());
+
+  GetService().GetReleaseEvent().Send();
+  EXPECT_EQ(blocked.Get(), "Hello wait");
+  EXPECT_EQ(queued.Get(), "Hello queued");
+
+  GetServer().StopDebug();
+  EXPECT_EQ(GetConcurrencyStatistics().SingleMetric("rejected").AsInt(), 0);
+}
+
+UTEST_F(GrpcConcurrencyLimit, QueueTimeout) {
+  Start({/*max_in_flight=*/1, /*max_queue_size=*/1, /*queue_timeout=*/10ms});
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  auto blocked = engine::AsyncNoSpan(
+      [&] { return client.SayHello(MakeRequest("wait")).Finish().name(); });
+  ASSERT_TRUE(
+      GetService().GetStartedEvent().WaitForEventFor(utest::kMaxTestWaitTime));
+
+  UEXPECT_THROW(client.SayHello(MakeRequest("timed out")).Finish(),
+                ugrpc::client::ResourceExhaustedError);
+
+  GetService().GetReleaseEvent().Send();
+  EXPECT_EQ(blocked.Get(), "Hello wait");
+}
+
+USERVER_NAMESPACE_END
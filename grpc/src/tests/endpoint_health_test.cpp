@@ -0,0 +1,120 @@
+#include <userver/ugrpc/client/impl/endpoint_health.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ugrpc::client::impl::EndpointHealth;
+
+ugrpc::client::OutlierDetectionConfig MakeConfig() {
+  ugrpc::client::OutlierDetectionConfig config;
+  config.error_rate = 0.5;
+  config.min_requests = 4;
+  return config;
+}
+
+void Account(EndpointHealth& health, bool is_failure) {
+  health.OnStarted(0);
+  health.OnFinished(0, is_failure);
+}
+
+}  // namespace
+
+TEST(GrpcEndpointHealth, Outstanding) {
+  ugrpc::impl::EndpointStatistics statistics{1};
+  EndpointHealth health{MakeConfig(), statistics};
+
+  health.OnStarted(0);
+  health.OnStarted(0);
+  EXPECT_EQ(health.GetOutstandingCount(), 2);
+  health.OnFinished(0, false);
+  EXPECT_EQ(health.GetOutstandingCount(), 1);
+  health.OnFinished(0, false);
+  EXPECT_EQ(health.GetOutstandingCount(), 0);
+}
+
+TEST(GrpcEndpointHealth, Ejection) {
+  ugrpc::impl::EndpointStatistics statistics{1};
+  EndpointHealth health{MakeConfig(), statistics};
+
+  Account(health, false);
+  Account(health, true);
+  Account(health, false);
+  EXPECT_FALSE(health.IsEjected(EndpointHealth::Clock::now()));
+
+  // 2 failures out of 4 requests
+  Account(health, true);
+  const auto now = EndpointHealth::Clock::now();
+  EXPECT_TRUE(health.IsEjected(now));
+  EXPECT_FALSE(health.IsEjected(now + MakeConfig().ejection_time));
+}
+
+TEST(GrpcEndpointHealth, TooFewRequests) {
+  ugrpc::impl::EndpointStatistics statistics{1};
+  EndpointHealth health{MakeConfig(), statistics};
+
+  for (int i = 0; i < 3; ++i) Account(health, true);
+  EXPECT_FALSE(health.IsEjected(EndpointHealth::Clock::now()));
+}
+
+TEST(GrpcEndpointHealth, Disabled) {
+  auto config = MakeConfig();
+  config.error_rate = 0;
+  ugrpc::impl::EndpointStatistics statistics{1};
+  EndpointHealth health{config, statistics};
+
+  for (int i = 0; i < 10; ++i) Account(health, true);
+  EXPECT_FALSE(health.IsEjected(EndpointHealth::Clock::now()));
+}
+
+TEST(GrpcEndpointHealth, UsageStatusCodes) {
+  ugrpc::impl::EndpointStatistics statistics{1};
+  auto health = std::make_shared<EndpointHealth>(MakeConfig(), statistics);
+
+  for (int i = 0; i < 4; ++i) {
+    ugrpc::client::impl::EndpointUsage usage{health, 0};
+    EXPECT_EQ(health->GetOutstandingCount(), 1);
+    // not a failure of the endpoint
+    usage.OnFinished(grpc::Status{grpc::StatusCode::NOT_FOUND, ""});
+    EXPECT_EQ(health->GetOutstandingCount(), 0);
+  }
+  EXPECT_FALSE(health->IsEjected(EndpointHealth::Clock::now()));
+
+  for (int i = 0; i < 4; ++i) {
+    ugrpc::client::impl::EndpointUsage usage{health, 0};
+    usage.OnFinished(grpc::Status{grpc::StatusCode::UNAVAILABLE, ""});
+  }
+  EXPECT_TRUE(health->IsEjected(EndpointHealth::Clock::now()));
+}
+
+TEST(GrpcEndpointHealth, RoundRobinChannels) {
+  ugrpc::impl::EndpointStatistics statistics{3};
+  EndpointHealth health{MakeConfig(), statistics,
+                        ugrpc::client::ChannelSelection::kRoundRobin};
+
+  const auto first = health.NextChannel(3);
+  EXPECT_EQ(health.NextChannel(3), (first + 1) % 3);
+  EXPECT_EQ(health.NextChannel(3), (first + 2) % 3);
+  EXPECT_EQ(health.NextChannel(3), first);
+}
+
+TEST(GrpcEndpointHealth, LeastLoadedChannels) {
+  ugrpc::impl::EndpointStatistics statistics{3};
+  EndpointHealth health{MakeConfig(), statistics,
+                        ugrpc::client::ChannelSelection::kLeastLoaded};
+
+  health.OnStarted(0);
+  health.OnStarted(2);
+  EXPECT_EQ(statistics.GetChannelInFlight(0), 1);
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(health.NextChannel(3), 1);
+
+  health.OnStarted(1);
+  health.OnStarted(1);
+  health.OnFinished(2, false);
+  EXPECT_EQ(statistics.GetChannelInFlight(2), 0);
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(health.NextChannel(3), 2);
+}
+
+USERVER_NAMESPACE_END
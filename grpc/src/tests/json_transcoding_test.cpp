@@ -0,0 +1,151 @@
+#include <userver/utest/utest.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <userver/formats/json.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_error.hpp>
+
+#include <ugrpc/server/impl/json_transcoder.hpp>
+
+#include <tests/service_fixture_test.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace handlers = server::handlers;
+namespace http = server::http;
+
+constexpr std::string_view kService = "sample.ugrpc.UnitTestService";
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    if (request.name() == "missing") {
+      call.FinishWithError({grpc::StatusCode::NOT_FOUND, "no such greeting"});
+      return;
+    }
+    if (request.name() == "busy") {
+      call.FinishWithError({grpc::StatusCode::RESOURCE_EXHAUSTED, "busy"});
+      return;
+    }
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+};
+
+class GrpcJsonTranscoding : public GrpcServiceFixtureSimple<UnitTestService> {
+ protected:
+  GrpcJsonTranscoding() : transcoder_(GetServer(), {}, {}) {}
+
+  const ugrpc::server::impl::JsonTranscoder& GetTranscoder() const {
+    return transcoder_;
+  }
+
+  const google::protobuf::MethodDescriptor& GetSayHello() const {
+    return transcoder_.FindMethod(std::string{kService}, "SayHello");
+  }
+
+  ugrpc::server::impl::TranscodedResponse Call(
+      const google::protobuf::MethodDescriptor& method,
+      const std::string& json_request) const {
+    return transcoder_.Call(
+        method, json_request,
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+  }
+
+ private:
+  ugrpc::server::impl::JsonTranscoder transcoder_;
+};
+
+template <typename Exception>
+http::HttpStatus GetThrownStatus(const std::function<void()>& func) {
+  try {
+    func();
+  } catch (const Exception& ex) {
+    return http::GetHttpStatus(ex.GetCode());
+  }
+  ADD_FAILURE() << "Nothing has been thrown";
+  return http::HttpStatus::kOk;
+}
+
+}  // namespace
+
+UTEST_F(GrpcJsonTranscoding, UnaryRoundTrip) {
+  const auto response = Call(GetSayHello(), R"({"name": "userver"})");
+  EXPECT_EQ(response.status, http::HttpStatus::kOk);
+  EXPECT_EQ(formats::json::FromString(response.body),
+            formats::json::FromString(R"({"name": "Hello userver"})"));
+}
+
+UTEST_F(GrpcJsonTranscoding, EmptyBody) {
+  const auto response = Call(GetSayHello(), "");
+  EXPECT_EQ(response.status, http::HttpStatus::kOk);
+  EXPECT_EQ(formats::json::FromString(response.body)["name"].As<std::string>(),
+            "Hello ");
+}
+
+UTEST_F(GrpcJsonTranscoding, UnknownMethod) {
+  EXPECT_EQ(GetThrownStatus<handlers::ResourceNotFound>([this] {
+              GetTranscoder().FindMethod("sample.ugrpc.NoSuchService",
+                                         "SayHello");
+            }),
+            http::HttpStatus::kNotFound);
+  EXPECT_EQ(GetThrownStatus<handlers::ResourceNotFound>([this] {
+              GetTranscoder().FindMethod(std::string{kService}, "SayGoodbye");
+            }),
+            http::HttpStatus::kNotFound);
+}
+
+UTEST_F(GrpcJsonTranscoding, InvalidJson) {
+  const auto& method = GetSayHello();
+  EXPECT_EQ(GetThrownStatus<handlers::ClientError>(
+                [&] { Call(method, R"({"name": )"); }),
+            http::HttpStatus::kBadRequest);
+  EXPECT_EQ(GetThrownStatus<handlers::ClientError>(
+                [&] { Call(method, R"({"unknown": true})"); }),
+            http::HttpStatus::kBadRequest);
+}
+
+UTEST_F(GrpcJsonTranscoding, ErrorStatus) {
+  const auto& method = GetSayHello();
+
+  const auto not_found = Call(method, R"({"name": "missing"})");
+  EXPECT_EQ(not_found.status, http::HttpStatus::kNotFound);
+  const auto body = formats::json::FromString(not_found.body);
+  EXPECT_EQ(body["code"].As<int>(),
+            static_cast<int>(grpc::StatusCode::NOT_FOUND));
+  EXPECT_EQ(body["message"].As<std::string>(), "no such greeting");
+
+  EXPECT_EQ(Call(method, R"({"name": "busy"})").status,
+            http::HttpStatus::kTooManyRequests);
+}
+
+UTEST_F(GrpcJsonTranscoding, StreamingRejected) {
+  for (const auto* name : {"ReadMany", "WriteMany", "Chat"}) {
+    EXPECT_EQ(GetThrownStatus<handlers::ResourceNotFound>([&] {
+                GetTranscoder().FindMethod(std::string{kService}, name);
+              }),
+              http::HttpStatus::kNotFound)
+        << name;
+  }
+
+  UEXPECT_THROW(ugrpc::server::impl::ParseUnaryMethod(
+                    "sample.ugrpc.UnitTestService/ReadMany"),
+                std::runtime_error);
+  UEXPECT_THROW(ugrpc::server::impl::ParseUnaryMethod(
+                    "sample.ugrpc.UnitTestService.SayHello"),
+                std::runtime_error);
+  EXPECT_EQ(ugrpc::server::impl::ParseUnaryMethod(
+                "sample.ugrpc.UnitTestService/SayHello"),
+            &GetSayHello());
+  EXPECT_EQ(ugrpc::server::impl::ParseUnaryMethod(std::nullopt), nullptr);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,48 @@
+#include <userver/ugrpc/impl/message_logging.hpp>
+
+#include <google/protobuf/struct.pb.h>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+google::protobuf::ListValue MakeList(int size) {
+  google::protobuf::ListValue list;
+  for (int i = 0; i < size; ++i) list.add_values()->set_number_value(i);
+  return list;
+}
+
+}  // namespace
+
+TEST(GrpcMessageLogging, SingleLine) {
+  google::protobuf::Struct message;
+  (*message.mutable_fields())["key"].set_string_value("value");
+
+  EXPECT_EQ(ugrpc::impl::ToLimitedString(message, 100),
+            R"(fields { key: "key" value { string_value: "value" } })");
+  EXPECT_EQ(ugrpc::impl::ToLimitedString(MakeList(2), 100),
+            "values { number_value: 0 } values { number_value: 1 }");
+  EXPECT_EQ(ugrpc::impl::ToLimitedString(google::protobuf::ListValue{}, 100),
+            "");
+}
+
+TEST(GrpcMessageLogging, Limit) {
+  constexpr std::size_t kLimit = 64;
+  const auto result = ugrpc::impl::ToLimitedString(MakeList(100'000), kLimit);
+  EXPECT_EQ(result.size(), kLimit + 3);
+  EXPECT_EQ(result.substr(0, 26), "values { number_value: 0 }");
+  EXPECT_EQ(result.substr(kLimit), "...");
+}
+
+TEST(GrpcMessageLogging, LongString) {
+  google::protobuf::Value message;
+  message.set_string_value(std::string(1000, 'a'));
+
+  const auto result = ugrpc::impl::ToLimitedString(message, 32);
+  EXPECT_EQ(result.size(), 32 + 3);
+  EXPECT_EQ(result.substr(0, 15), R"(string_value: ")");
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/tracing/tracer.hpp>
+
+#include <opentelemetry/proto/collector/trace/v1/trace_service_service.usrv.pb.hpp>
+#include <tests/service_fixture_test.hpp>
+#include <ugrpc/client/otlp_span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace otlp_collector = opentelemetry::proto::collector::trace::v1;
+
+class FakeCollector final : public otlp_collector::TraceServiceBase {
+ public:
+  void Export(ExportCall& call,
+              otlp_collector::ExportTraceServiceRequest&& request) override {
+    for (const auto& resource_spans : request.resource_spans()) {
+      for (const auto& scope_spans : resource_spans.scope_spans()) {
+        for (const auto& span : scope_spans.spans()) {
+          spans.push_back(span);
+        }
+      }
+    }
+    ++requests;
+    call.Finish({});
+  }
+
+  std::vector<opentelemetry::proto::trace::v1::Span> spans;
+  std::size_t requests{0};
+};
+
+using OtlpSpanExporterTest = GrpcServiceFixtureSimple<FakeCollector>;
+
+ugrpc::client::impl::OtlpSpanExporterConfig MakeConfig(
+    std::size_t max_queue_size, std::size_t max_batch_size) {
+  ugrpc::client::impl::OtlpSpanExporterConfig config;
+  config.max_queue_size = max_queue_size;
+  config.max_batch_size = max_batch_size;
+  return config;
+}
+
+}  // namespace
+
+UTEST_F(OtlpSpanExporterTest, ExportsInBatches) {
+  ugrpc::client::impl::OtlpSpanExporter exporter(
+      MakeClient<ugrpc::client::impl::OtlpSpanExporter::Client>(), "service",
+      MakeConfig(100, 2));
+
+  tracing::Tracer::SetSpanExporter(
+      std::shared_ptr<tracing::SpanExporter>(&exporter, [](auto*) {}));
+  {
+    tracing::Span root("root");
+    root.AddTag("number", 42);
+
+    tracing::Span child("child");
+    child.AddTag(tracing::kErrorFlag, true);
+  }
+  { tracing::Span other("other"); }
+  tracing::Tracer::SetSpanExporter({});
+
+  exporter.ExportQueued();
+
+  const auto& spans = GetService().spans;
+  ASSERT_EQ(spans.size(), 3);
+  // batches of 2 spans
+  EXPECT_EQ(GetService().requests, 2);
+
+  EXPECT_EQ(spans[0].name(), "child");
+  EXPECT_EQ(spans[0].trace_id().size(), 16);
+  EXPECT_EQ(spans[0].span_id().size(), 8);
+  EXPECT_EQ(spans[0].parent_span_id(), spans[1].span_id());
+  EXPECT_EQ(spans[0].status().code(),
+            opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR);
+
+  EXPECT_EQ(spans[1].name(), "root");
+  EXPECT_EQ(spans[1].trace_id(), spans[0].trace_id());
+  EXPECT_TRUE(spans[1].parent_span_id().empty());
+  EXPECT_NE(spans[1].status().code(),
+            opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR);
+  const auto& attributes = spans[1].attributes();
+  const auto number = std::find_if(
+      attributes.begin(), attributes.end(),
+      [](const auto& attribute) { return attribute.key() == "number"; });
+  ASSERT_NE(number, attributes.end());
+  EXPECT_EQ(number->value().int_value(), 42);
+
+  EXPECT_EQ(spans[2].name(), "other");
+  EXPECT_NE(spans[2].trace_id(), spans[0].trace_id());
+
+  const auto stats = exporter.GetStatistics();
+  EXPECT_EQ(stats.exported, 3);
+  EXPECT_EQ(stats.dropped, 0);
+  EXPECT_EQ(stats.queue_size, 0);
+}
+
+UTEST_F(OtlpSpanExporterTest, DropsOverLimit) {
+  ugrpc::client::impl::OtlpSpanExporter exporter(
+      MakeClient<ugrpc::client::impl::OtlpSpanExporter::Client>(), "service",
+      MakeConfig(2, 10));
+
+  tracing::Tracer::SetSpanExporter(
+      std::shared_ptr<tracing::SpanExporter>(&exporter, [](auto*) {}));
+  for (int i = 0; i < 5; ++i) {
+    tracing::Span span("span");
+  }
+  tracing::Tracer::SetSpanExporter({});
+
+  EXPECT_EQ(exporter.GetStatistics().queue_size, 2);
+  EXPECT_EQ(exporter.GetStatistics().dropped, 3);
+
+  exporter.ExportQueued();
+  EXPECT_EQ(GetService().spans.size(), 2);
+  EXPECT_EQ(exporter.GetStatistics().exported, 2);
+}
+
+UTEST_F(OtlpSpanExporterTest, BackgroundExport) {
+  auto exporter = std::make_shared<ugrpc::client::impl::OtlpSpanExporter>(
+      MakeClient<ugrpc::client::impl::OtlpSpanExporter::Client>(), "service",
+      MakeConfig(100, 1));
+  exporter->Start(engine::current_task::GetTaskProcessor());
+
+  tracing::Tracer::SetSpanExporter(exporter);
+  { tracing::Span span("span"); }
+  tracing::Tracer::SetSpanExporter({});
+
+  // a full batch wakes up the export task
+  while (exporter->GetStatistics().exported == 0) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  exporter->Stop();
+
+  ASSERT_EQ(GetService().spans.size(), 1);
+  EXPECT_EQ(GetService().spans[0].name(), "span");
+}
+
+USERVER_NAMESPACE_END
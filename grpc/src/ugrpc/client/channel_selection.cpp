@@ -0,0 +1,29 @@
+#include <userver/ugrpc/client/channel_selection.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+ChannelSelection Parse(const yaml_config::YamlConfig& value,
+                       formats::parse::To<ChannelSelection>) {
+  const auto string = value.As<std::string>();
+
+  if (string == "random") return ChannelSelection::kRandom;
+  if (string == "round-robin") return ChannelSelection::kRoundRobin;
+  if (string == "least-loaded") return ChannelSelection::kLeastLoaded;
+
+  throw std::runtime_error(
+      fmt::format("Failed to parse ChannelSelection from '{}' at path '{}'",
+                  string, value.GetPath()));
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,17 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <memory>
 #include <optional>
 #include <stdexcept>
+#include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/clients/dns/resolver.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/utils/from_string.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -80,6 +86,14 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.channel_count_by_endpoint =
+      value["channel-count-by-endpoint"]
+          .As<std::unordered_map<std::string, std::size_t>>({});
+  config.channel_selection = value["channel-selection"].As<ChannelSelection>(
+      config.channel_selection);
+  config.outlier_detection =
+      value["outlier-detection"].As<OutlierDetectionConfig>(
+          config.outlier_detection);
 
   return config;
 }
@@ -90,20 +104,57 @@ ClientFactory::ClientFactory(ClientFactoryConfig&& config,
                              utils::statistics::Storage& statistics_storage)
     : channel_task_processor_(channel_task_processor),
       queue_(queue),
+      outlier_detection_(config.outlier_detection),
+      channel_selection_(config.channel_selection),
       channel_cache_(std::move(config.credentials), config.channel_args,
-                     config.channel_count),
+                     config.channel_count,
+                     std::move(config.channel_count_by_endpoint)),
       client_statistics_storage_(statistics_storage, "client") {
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
 }
 
-impl::ChannelCache::Token ClientFactory::GetChannel(
-    const std::string& endpoint) {
-  // Spawn a blocking task creating a gRPC channel
-  // This is third party code, no use of span inside it
-  return engine::AsyncNoSpan(channel_task_processor_,
-                             [&] { return channel_cache_.Get(endpoint); })
-      .Get();
+std::vector<impl::Endpoint> ClientFactory::GetEndpoints(
+    const std::vector<std::string>& endpoints) {
+  std::vector<impl::Endpoint> result;
+  result.reserve(endpoints.size());
+  for (const auto& endpoint : endpoints) {
+    // Spawn a blocking task creating a gRPC channel
+    // This is third party code, no use of span inside it
+    auto channel_token =
+        engine::AsyncNoSpan(channel_task_processor_, [&] {
+          return channel_cache_.Get(endpoint);
+        }).Get();
+    auto health = std::make_shared<impl::EndpointHealth>(
+        outlier_detection_,
+        client_statistics_storage_.GetEndpointStatistics(
+            endpoint, channel_token.GetChannelCount()),
+        channel_selection_);
+    result.push_back({std::move(channel_token), std::move(health)});
+  }
+  return result;
+}
+
+std::vector<std::string> ResolveEndpoints(clients::dns::Resolver& resolver,
+                                          const std::string& endpoint,
+                                          engine::Deadline deadline) {
+  const auto delimiter = endpoint.rfind(':');
+  if (delimiter == std::string::npos) {
+    throw std::invalid_argument(
+        fmt::format("Endpoint '{}' must be of the form host:port", endpoint));
+  }
+  auto host = endpoint.substr(0, delimiter);
+  if (host.size() > 1 && host.front() == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+  const auto port = utils::FromString<int>(endpoint.substr(delimiter + 1));
+
+  std::vector<std::string> result;
+  for (auto address : resolver.Resolve(host, deadline)) {
+    address.SetPort(port);
+    result.push_back(fmt::to_string(address));
+  }
+  return result;
 }
 
 }  // namespace ugrpc::client
@@ -81,6 +81,43 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    channel-count-by-endpoint:
+        type: object
+        description: overrides of channel-count for specific endpoints
+        defaultDescription: '{}'
+        additionalProperties:
+            type: integer
+            description: number of channels created for the endpoint
+        properties: {}
+    channel-selection:
+        type: string
+        description: how a request picks one of the channels of an endpoint
+        defaultDescription: random
+        enum:
+          - random
+          - round-robin
+          - least-loaded
+    outlier-detection:
+        type: object
+        description: ejection of failing endpoints of balancing clients
+        additionalProperties: false
+        properties:
+            error-rate:
+                type: number
+                description: share of failed requests, which ejects an endpoint; 0 disables the ejection
+                defaultDescription: 0.5
+            min-requests:
+                type: integer
+                description: min number of requests within interval to judge on the error rate
+                defaultDescription: 10
+            interval:
+                type: string
+                description: period of error rate accounting
+                defaultDescription: 10s
+            ejection-time:
+                type: string
+                description: for how long an ejected endpoint receives no requests
+                defaultDescription: 30s
 )");
 }
 
@@ -1,7 +1,10 @@
 #include <userver/ugrpc/client/impl/async_methods.hpp>
 
+#include <chrono>
+
 #include <fmt/format.h>
 
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/tracing/tags.hpp>
 #include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
@@ -33,6 +36,20 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                       ugrpc::impl::ToGrpcString(span.GetLink()));
 }
 
+// There is no use waiting for the response after the deadline of the request
+// being handled. An expired deadline fails the RPC locally with
+// DEADLINE_EXCEEDED without sending it.
+void LimitByTaskDeadline(grpc::ClientContext& context) {
+  const auto deadline = server::request::GetTaskInheritedDeadline();
+  if (!deadline.IsReachable()) return;
+
+  const auto task_deadline = std::chrono::system_clock::now() +
+                             std::chrono::duration_cast<
+                                 std::chrono::system_clock::duration>(
+                                 deadline.TimeLeft());
+  if (task_deadline < context.deadline()) context.set_deadline(task_deadline);
+}
+
 void SetStatusDetailsForSpan(RpcData& data, grpc::Status& status,
                              const std::optional<std::string>& message) {
   data.GetSpan().AddTag(tracing::kErrorFlag, true);
@@ -56,11 +73,14 @@ void SetErrorForSpan(RpcData& data, std::string&& message) {
 
 RpcData::RpcData(std::unique_ptr<grpc::ClientContext>&& context,
                  std::string_view call_name,
-                 ugrpc::impl::MethodStatistics& statistics)
+                 ugrpc::impl::MethodStatistics& statistics,
+                 EndpointUsage&& endpoint_usage)
     : context_(std::move(context)),
       call_name_(call_name),
-      stats_scope_(statistics) {
+      stats_scope_(statistics),
+      endpoint_usage_(std::move(endpoint_usage)) {
   UASSERT(context_);
+  LimitByTaskDeadline(*context_);
   SetupSpan(span_, *context_, call_name_);
 }
 
@@ -104,6 +124,8 @@ ugrpc::impl::RpcStatisticsScope& RpcData::GetStatsScope() noexcept {
   return stats_scope_;
 }
 
+EndpointUsage& RpcData::GetEndpointUsage() noexcept { return endpoint_usage_; }
+
 State RpcData::GetState() const noexcept {
   UASSERT(context_);
   return state_;
@@ -140,6 +162,7 @@ void CheckOk(RpcData& data, bool ok, std::string_view stage) {
   if (!ok) {
     data.SetState(State::kFinished);
     data.GetStatsScope().OnNetworkError();
+    data.GetEndpointUsage().OnNetworkError();
     SetErrorForSpan(data, fmt::format("Network error at '{}'", stage));
     throw RpcInterruptedError(data.GetCallName(), stage);
   }
@@ -157,6 +180,7 @@ void ProcessFinishResult(RpcData& data, bool ok, grpc::Status& status,
               "ok=false in async Finish method invocation is prohibited "
               "by gRPC docs, see grpc::CompletionQueue::Next");
   data.GetStatsScope().OnExplicitFinish(status.error_code());
+  data.GetEndpointUsage().OnFinished(status);
 
   if (!status.ok()) {
     // extract error
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <utility>
 
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
@@ -60,31 +62,47 @@ ChannelCache::CountedChannel::CountedChannel(
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
     const grpc::ChannelArguments& channel_args, std::size_t count) {
   const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
+  auto args = channel_args;
+  if (count > 1) {
+    // channels with equal args share the subchannels, and thus the HTTP/2
+    // connection, via the global subchannel pool
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  }
   channels = utils::GenerateFixedArray(count, [&](std::size_t) {
-    return grpc::CreateCustomChannel(endpoint_string, credentials,
-                                     channel_args);
+    return grpc::CreateCustomChannel(endpoint_string, credentials, args);
   });
   UASSERT(count > 0);
 }
 
 ChannelCache::ChannelCache(
     std::shared_ptr<grpc::ChannelCredentials>&& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    const grpc::ChannelArguments& channel_args, std::size_t channel_count,
+    std::unordered_map<std::string, std::size_t>&& channel_count_by_endpoint)
     : credentials_(std::move(credentials)),
       channel_args_(channel_args),
-      channel_count_(channel_count) {
+      channel_count_(channel_count),
+      channel_count_by_endpoint_(std::move(channel_count_by_endpoint)) {
   UINVARIANT(channel_count > 0, "Channels count must be greater than zero");
+  for (const auto& [endpoint, count] : channel_count_by_endpoint_) {
+    UINVARIANT(count > 0, "Channels count must be greater than zero");
+  }
 }
 
 ChannelCache::~ChannelCache() = default;
 
 ChannelCache::Token ChannelCache::Get(const std::string& endpoint) {
   auto channels = channels_.Lock();
-  const auto [it, _] = channels->try_emplace(endpoint, endpoint, credentials_,
-                                             channel_args_, channel_count_);
+  const auto [it, _] =
+      channels->try_emplace(endpoint, endpoint, credentials_, channel_args_,
+                            GetChannelCount(endpoint));
   return {*this, it->first, it->second};
 }
 
+std::size_t ChannelCache::GetChannelCount(const std::string& endpoint) const {
+  return utils::FindOrDefault(channel_count_by_endpoint_, endpoint,
+                              channel_count_);
+}
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
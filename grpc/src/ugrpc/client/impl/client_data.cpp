@@ -0,0 +1,34 @@
+#include <userver/ugrpc/client/impl/client_data.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+std::size_t ClientData::NextEndpoint() const {
+  const auto size = endpoints_.size();
+  if (size == 1) return 0;
+
+  // a random starting point spreads the load among equally loaded endpoints
+  const auto start = utils::RandRange(size);
+  const auto now = EndpointHealth::Clock::now();
+  auto best = size;
+  std::size_t best_outstanding = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto index = (start + i) % size;
+    const auto& health = *endpoints_[index].endpoint.health;
+    if (health.IsEjected(now)) continue;
+
+    const auto outstanding = health.GetOutstandingCount();
+    if (best == size || outstanding < best_outstanding) {
+      best = index;
+      best_outstanding = outstanding;
+    }
+  }
+
+  // all the endpoints are ejected, so none of them is better than the others
+  return best == size ? start : best;
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,155 @@
+#include <userver/ugrpc/client/impl/endpoint_health.hpp>
+
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+namespace {
+
+bool IsFailure(grpc::StatusCode code) noexcept {
+  switch (code) {
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::INTERNAL:
+    case grpc::StatusCode::UNKNOWN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+EndpointHealth::EndpointHealth(const OutlierDetectionConfig& config,
+                               ugrpc::impl::EndpointStatistics& statistics,
+                               ChannelSelection channel_selection)
+    : config_(config),
+      statistics_(statistics),
+      channel_selection_(channel_selection),
+      window_start_(ToRep(Clock::now())) {}
+
+std::size_t EndpointHealth::GetOutstandingCount() const noexcept {
+  return outstanding_.load(std::memory_order_relaxed);
+}
+
+bool EndpointHealth::IsEjected(Clock::time_point now) const noexcept {
+  return ToRep(now) < ejected_until_.load(std::memory_order_relaxed);
+}
+
+std::size_t EndpointHealth::NextChannel(std::size_t channel_count) noexcept {
+  UASSERT(channel_count > 0);
+  UASSERT(channel_count <= statistics_.GetChannelCount());
+  if (channel_count == 1) return 0;
+
+  switch (channel_selection_) {
+    case ChannelSelection::kRandom:
+      return utils::RandRange(channel_count);
+    case ChannelSelection::kRoundRobin:
+      return next_channel_.fetch_add(1, std::memory_order_relaxed) %
+             channel_count;
+    case ChannelSelection::kLeastLoaded:
+      break;
+  }
+
+  // a random starting point spreads the load among equally loaded channels
+  const auto start = utils::RandRange(channel_count);
+  auto best = start;
+  auto best_in_flight = statistics_.GetChannelInFlight(start);
+  for (std::size_t i = 1; i < channel_count && best_in_flight != 0; ++i) {
+    const auto index = (start + i) % channel_count;
+    const auto in_flight = statistics_.GetChannelInFlight(index);
+    if (in_flight < best_in_flight) {
+      best = index;
+      best_in_flight = in_flight;
+    }
+  }
+  return best;
+}
+
+void EndpointHealth::OnStarted(std::size_t channel_index) noexcept {
+  ++outstanding_;
+  statistics_.AccountStarted(channel_index);
+}
+
+void EndpointHealth::OnFinished(std::size_t channel_index,
+                                bool is_failure) noexcept {
+  UASSERT(outstanding_ > 0);
+  --outstanding_;
+  statistics_.AccountFinished(channel_index, is_failure);
+  if (config_.error_rate <= 0) return;
+
+  const auto now = Clock::now();
+  auto window_start = window_start_.load();
+  if (ToRep(now) - window_start >
+          std::chrono::duration_cast<Clock::duration>(config_.interval)
+              .count() &&
+      window_start_.compare_exchange_strong(window_start, ToRep(now))) {
+    // counters are reset racily, which is fine for an estimate
+    window_requests_ = 0;
+    window_failures_ = 0;
+  }
+
+  ++window_requests_;
+  if (is_failure) {
+    ++window_failures_;
+    MaybeEject(now);
+  }
+}
+
+std::int64_t EndpointHealth::ToRep(Clock::time_point time) noexcept {
+  return time.time_since_epoch().count();
+}
+
+void EndpointHealth::MaybeEject(Clock::time_point now) noexcept {
+  const auto requests = window_requests_.load();
+  const auto failures = window_failures_.load();
+  if (requests < config_.min_requests ||
+      failures < config_.error_rate * requests) {
+    return;
+  }
+
+  auto ejected_until = ejected_until_.load();
+  if (ToRep(now) < ejected_until) return;
+  if (!ejected_until_.compare_exchange_strong(
+          ejected_until, ToRep(now + config_.ejection_time))) {
+    return;
+  }
+
+  statistics_.AccountEjection();
+  // the endpoint starts from scratch after the ejection
+  window_start_ = ToRep(now + config_.ejection_time);
+  window_requests_ = 0;
+  window_failures_ = 0;
+}
+
+EndpointUsage::EndpointUsage(std::shared_ptr<EndpointHealth> health,
+                             std::size_t channel_index) noexcept
+    : health_(std::move(health)), channel_index_(channel_index) {
+  if (health_) health_->OnStarted(channel_index_);
+}
+
+EndpointUsage::~EndpointUsage() {
+  // abandoned and cancelled RPCs say nothing about the endpoint
+  Release(false);
+}
+
+void EndpointUsage::OnFinished(const grpc::Status& status) noexcept {
+  Release(IsFailure(status.error_code()));
+}
+
+void EndpointUsage::OnNetworkError() noexcept { Release(true); }
+
+void EndpointUsage::Release(bool is_failure) noexcept {
+  if (!health_) return;
+  health_->OnFinished(channel_index_, is_failure);
+  health_.reset();
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,228 @@
+#include <ugrpc/client/otlp_span_exporter.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/encoding/hex.hpp>
+
+#include <userver/ugrpc/client/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+namespace {
+
+namespace otlp_trace = opentelemetry::proto::trace::v1;
+
+constexpr std::size_t kTraceIdSize = 16;
+constexpr std::size_t kSpanIdSize = 8;
+
+// spans of the export requests must not be exported, or each export would
+// produce more spans to export
+constexpr std::string_view kExportSpanPrefix =
+    "grpc/opentelemetry.proto.collector.trace.v1.TraceService/";
+
+std::uint64_t Fnv1a(std::string_view data, std::uint64_t seed) noexcept {
+  std::uint64_t hash = 14695981039346656037ULL ^ seed;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// OTLP requires binary ids of a fixed size. userver ids are hex strings of
+// the right size, foreign ids from the request headers are hashed.
+std::string ToOtlpId(std::string_view id, std::size_t size) {
+  if (id.size() == utils::encoding::LengthInHexForm(size) &&
+      utils::encoding::IsHexData(id)) {
+    return utils::encoding::FromHex(id);
+  }
+
+  std::string result(size, '\0');
+  for (std::size_t offset = 0; offset < size; offset += sizeof(std::uint64_t)) {
+    const auto hash = Fnv1a(id, offset);
+    std::memcpy(result.data() + offset, &hash,
+                std::min(sizeof(hash), size - offset));
+  }
+  return result;
+}
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void SetAttributeValue(opentelemetry::proto::common::v1::AnyValue& output,
+                       const logging::LogExtra::Value& value) {
+  std::visit(
+      [&output](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          output.set_string_value(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          output.set_double_value(v);
+        } else {
+          output.set_int_value(static_cast<std::int64_t>(v));
+        }
+      },
+      value);
+}
+
+otlp_trace::Span ToOtlpSpan(const tracing::FinishedSpan& span) {
+  otlp_trace::Span result;
+  result.set_trace_id(ToOtlpId(span.trace_id, kTraceIdSize));
+  result.set_span_id(ToOtlpId(span.span_id, kSpanIdSize));
+  if (!span.parent_id.empty()) {
+    result.set_parent_span_id(ToOtlpId(span.parent_id, kSpanIdSize));
+  }
+  result.set_name(std::string{span.name});
+  result.set_kind(otlp_trace::Span::SPAN_KIND_INTERNAL);
+  result.set_start_time_unix_nano(ToUnixNano(span.start_time));
+  result.set_end_time_unix_nano(ToUnixNano(
+      span.start_time +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          span.duration)));
+
+  for (const auto& [key, value] : span.tags) {
+    auto& attribute = *result.add_attributes();
+    attribute.set_key(std::string{key});
+    SetAttributeValue(*attribute.mutable_value(), value.get());
+  }
+
+  if (span.has_error) {
+    result.mutable_status()->set_code(otlp_trace::Status::STATUS_CODE_ERROR);
+  }
+  return result;
+}
+
+}  // namespace
+
+OtlpSpanExporter::OtlpSpanExporter(Client&& client, std::string service_name,
+                                   const OtlpSpanExporterConfig& config)
+    : client_(std::move(client)),
+      service_name_(std::move(service_name)),
+      config_(config),
+      batch_(config_.max_batch_size) {
+  UINVARIANT(config_.max_batch_size > 0, "max-batch-size must be positive");
+}
+
+OtlpSpanExporter::~OtlpSpanExporter() { Stop(); }
+
+void OtlpSpanExporter::Start(engine::TaskProcessor& task_processor) {
+  UASSERT(!task_.IsValid());
+  task_ = engine::CriticalAsyncNoSpan(task_processor, [this] { Run(); });
+}
+
+void OtlpSpanExporter::Stop() noexcept {
+  if (!task_.IsValid()) return;
+  task_.SyncCancel();
+  task_ = {};
+
+  try {
+    ExportQueued();
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Failed to export the remaining spans: " << e;
+  }
+}
+
+void OtlpSpanExporter::Export(const tracing::FinishedSpan& span) noexcept {
+  if (span.name.substr(0, kExportSpanPrefix.size()) == kExportSpanPrefix) {
+    return;
+  }
+
+  const auto size = queue_size_.fetch_add(1, std::memory_order_relaxed);
+  if (size >= config_.max_queue_size) {
+    queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  try {
+    queue_.enqueue(ToOtlpSpan(span));
+    if (size + 1 == config_.max_batch_size) batch_ready_.Send();
+  } catch (const std::exception& e) {
+    queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    UASSERT_MSG(false, e.what());
+  }
+}
+
+void OtlpSpanExporter::ExportQueued() {
+  while (ExportBatch() == config_.max_batch_size &&
+         !engine::current_task::ShouldCancel()) {
+  }
+}
+
+OtlpSpanExporterStatistics OtlpSpanExporter::GetStatistics() const noexcept {
+  OtlpSpanExporterStatistics result;
+  result.exported = exported_.load(std::memory_order_relaxed);
+  result.dropped = dropped_.load(std::memory_order_relaxed);
+  result.export_errors = export_errors_.load(std::memory_order_relaxed);
+  result.queue_size = queue_size_.load(std::memory_order_relaxed);
+  return result;
+}
+
+void OtlpSpanExporter::Run() {
+  while (!engine::current_task::ShouldCancel()) {
+    [[maybe_unused]] const bool batch_ready =
+        batch_ready_.WaitForEventFor(config_.export_interval);
+    if (engine::current_task::ShouldCancel()) break;
+
+    try {
+      ExportQueued();
+    } catch (const std::exception& e) {
+      LOG_WARNING() << "Failed to export spans: " << e;
+    }
+  }
+}
+
+std::size_t OtlpSpanExporter::ExportBatch() {
+  const auto count =
+      queue_.try_dequeue_bulk(batch_.begin(), config_.max_batch_size);
+  if (count == 0) return 0;
+  queue_size_.fetch_sub(count, std::memory_order_relaxed);
+
+  opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest
+      request;
+  auto& resource_spans = *request.add_resource_spans();
+
+  auto& service_name = *resource_spans.mutable_resource()->add_attributes();
+  service_name.set_key("service.name");
+  service_name.mutable_value()->set_string_value(service_name_);
+
+  auto& scope_spans = *resource_spans.add_scope_spans();
+  scope_spans.mutable_scope()->set_name("userver");
+  scope_spans.mutable_spans()->Reserve(static_cast<int>(count));
+  for (std::size_t i = 0; i < count; ++i) {
+    scope_spans.add_spans()->Swap(&batch_[i]);
+  }
+
+  auto context = std::make_unique<grpc::ClientContext>();
+  context->set_deadline(std::chrono::system_clock::now() +
+                        config_.export_timeout);
+
+  try {
+    client_.Export(request, std::move(context)).Finish();
+    exported_.fetch_add(count, std::memory_order_relaxed);
+  } catch (const ugrpc::client::RpcError& e) {
+    export_errors_.fetch_add(1, std::memory_order_relaxed);
+    dropped_.fetch_add(count, std::memory_order_relaxed);
+    LOG_LIMITED_WARNING() << "Failed to export " << count
+                          << " spans to the collector: " << e;
+  }
+
+  return count;
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
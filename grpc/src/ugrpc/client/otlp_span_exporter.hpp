@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/tracing/span_exporter.hpp>
+
+#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+struct OtlpSpanExporterConfig final {
+  /// Spans over this limit are dropped until the queue is exported
+  std::size_t max_queue_size{65536};
+
+  /// Queue size that triggers an export before the export interval expires,
+  /// also the maximum number of spans in a single request
+  std::size_t max_batch_size{512};
+
+  std::chrono::milliseconds export_interval{1000};
+  std::chrono::milliseconds export_timeout{1000};
+};
+
+struct OtlpSpanExporterStatistics final {
+  std::uint64_t exported{0};
+  std::uint64_t dropped{0};
+  std::uint64_t export_errors{0};
+  std::size_t queue_size{0};
+};
+
+/// Converts the finished spans into OTLP spans and sends them in batches to
+/// the opentelemetry collector from a background task.
+class OtlpSpanExporter final : public tracing::SpanExporter {
+ public:
+  using Client = opentelemetry::proto::collector::trace::v1::TraceServiceClient;
+
+  OtlpSpanExporter(Client&& client, std::string service_name,
+                   const OtlpSpanExporterConfig& config);
+
+  ~OtlpSpanExporter() override;
+
+  /// Starts the background export task
+  void Start(engine::TaskProcessor& task_processor);
+
+  /// Stops the background task and exports the rest of the queue
+  void Stop() noexcept;
+
+  void Export(const tracing::FinishedSpan& span) noexcept override;
+
+  /// Exports all the queued spans from the current task
+  void ExportQueued();
+
+  OtlpSpanExporterStatistics GetStatistics() const noexcept;
+
+ private:
+  using OtlpSpan = opentelemetry::proto::trace::v1::Span;
+
+  void Run();
+  std::size_t ExportBatch();
+
+  Client client_;
+  const std::string service_name_;
+  const OtlpSpanExporterConfig config_;
+
+  moodycamel::ConcurrentQueue<OtlpSpan> queue_;
+  // the queue itself is unbounded, the size is limited by this counter
+  std::atomic<std::size_t> queue_size_{0};
+  engine::SingleConsumerEvent batch_ready_;
+
+  // used only by the exporting task
+  std::vector<OtlpSpan> batch_;
+
+  std::atomic<std::uint64_t> exported_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> export_errors_{0};
+
+  engine::TaskWithResult<void> task_;
+};
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
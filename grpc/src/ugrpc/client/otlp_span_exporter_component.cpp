@@ -0,0 +1,121 @@
+#include <userver/ugrpc/client/otlp_span_exporter_component.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/components/tracer.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <userver/ugrpc/client/client_factory_component.hpp>
+
+#include <ugrpc/client/otlp_span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+OtlpSpanExporterComponent::OtlpSpanExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  // the service name is set by the tracer component
+  context.FindComponent<components::Tracer>();
+
+  const auto client_factory_name = config["client-factory"].As<std::string>(
+      std::string{ClientFactoryComponent::kName});
+  auto& client_factory =
+      context.FindComponent<ClientFactoryComponent>(client_factory_name)
+          .GetFactory();
+  auto& task_processor = context.GetTaskProcessor(
+      config["task-processor"].As<std::string>("main-task-processor"));
+
+  impl::OtlpSpanExporterConfig exporter_config;
+  exporter_config.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(exporter_config.max_queue_size);
+  exporter_config.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(exporter_config.max_batch_size);
+  exporter_config.export_interval =
+      config["export-interval"].As<std::chrono::milliseconds>(
+          exporter_config.export_interval);
+  exporter_config.export_timeout =
+      config["export-timeout"].As<std::chrono::milliseconds>(
+          exporter_config.export_timeout);
+
+  exporter_ = std::make_shared<impl::OtlpSpanExporter>(
+      client_factory.MakeClient<impl::OtlpSpanExporter::Client>(
+          config["endpoint"].As<std::string>()),
+      tracing::Tracer::GetTracer()->GetServiceName(), exporter_config);
+  exporter_->Start(task_processor);
+
+  tracing::Tracer::SetSamplingRatio(config["sampling-ratio"].As<double>(1.0));
+  tracing::Tracer::SetSpanExporter(exporter_);
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterExtender(
+      std::string{kName},
+      [this](const auto& /*request*/) { return ExtendStatistics(); });
+}
+
+OtlpSpanExporterComponent::~OtlpSpanExporterComponent() {
+  statistics_holder_.Unregister();
+  tracing::Tracer::SetSpanExporter({});
+  exporter_->Stop();
+}
+
+formats::json::Value OtlpSpanExporterComponent::ExtendStatistics() const {
+  const auto stats = exporter_->GetStatistics();
+
+  formats::json::ValueBuilder json_stats;
+  json_stats["exported"] = stats.exported;
+  json_stats["dropped"] = stats.dropped;
+  json_stats["export-errors"] = stats.export_errors;
+  json_stats["queue-size"] = stats.queue_size;
+  return json_stats.ExtractValue();
+}
+
+yaml_config::Schema OtlpSpanExporterComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Sends the finished spans to an OpenTelemetry collector
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: the collector endpoint, e.g. localhost:4317
+    client-factory:
+        type: string
+        description: name of the grpc-client-factory component to use
+        defaultDescription: grpc-client-factory
+    task-processor:
+        type: string
+        description: the task processor for the background export task
+        defaultDescription: main-task-processor
+    sampling-ratio:
+        type: number
+        description: share of the traces in [0, 1] to export
+        defaultDescription: 1.0
+    max-queue-size:
+        type: integer
+        description: max number of spans waiting for the export
+        defaultDescription: 65536
+    max-batch-size:
+        type: integer
+        description: max number of spans in a single export request
+        defaultDescription: 512
+    export-interval:
+        type: string
+        description: max time a span waits for the export
+        defaultDescription: 1s
+    export-timeout:
+        type: string
+        description: deadline of a single export request
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,24 @@
+#include <userver/ugrpc/client/outlier_detection.hpp>
+
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+OutlierDetectionConfig Parse(const yaml_config::YamlConfig& value,
+                             formats::parse::To<OutlierDetectionConfig>) {
+  OutlierDetectionConfig config;
+  config.error_rate = value["error-rate"].As<double>(config.error_rate);
+  config.min_requests =
+      value["min-requests"].As<std::size_t>(config.min_requests);
+  config.interval =
+      value["interval"].As<std::chrono::milliseconds>(config.interval);
+  config.ejection_time = value["ejection-time"].As<std::chrono::milliseconds>(
+      config.ejection_time);
+  return config;
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,107 @@
+#include <userver/ugrpc/impl/message_logging.hpp>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/text_format.h>
+
+#include <userver/logging/log_helper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+namespace {
+
+constexpr std::string_view kTruncatedMarker = "...";
+
+class LimitedPrinter final {
+ public:
+  explicit LimitedPrinter(std::size_t limit) : limit_(limit) {
+    printer_.SetSingleLineMode(true);
+    printer_.SetTruncateStringFieldLongerThan(limit);
+  }
+
+  void PrintMessage(const google::protobuf::Message& message) {
+    const auto* reflection = message.GetReflection();
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    reflection->ListFields(message, &fields);
+
+    for (const auto* field : fields) {
+      if (!field->is_repeated()) {
+        PrintField(message, *field, -1);
+        continue;
+      }
+      const auto size = reflection->FieldSize(message, field);
+      for (int i = 0; i < size; ++i) {
+        PrintField(message, *field, i);
+        if (IsExhausted()) return;
+      }
+      if (IsExhausted()) return;
+    }
+  }
+
+  std::string Extract() && {
+    if (IsExhausted()) {
+      output_.resize(limit_);
+      output_.append(kTruncatedMarker);
+    } else if (!output_.empty() && output_.back() == ' ') {
+      output_.pop_back();
+    }
+    return std::move(output_);
+  }
+
+ private:
+  bool IsExhausted() const noexcept { return output_.size() > limit_; }
+
+  void PrintField(const google::protobuf::Message& message,
+                  const google::protobuf::FieldDescriptor& field, int index) {
+    if (IsExhausted()) return;
+
+    if (field.is_extension()) {
+      output_.append("[").append(field.full_name()).append("]");
+    } else {
+      output_.append(field.name());
+    }
+
+    if (field.cpp_type() ==
+        google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+      const auto* reflection = message.GetReflection();
+      const auto& nested =
+          index < 0 ? reflection->GetMessage(message, &field)
+                    : reflection->GetRepeatedMessage(message, &field, index);
+      output_.append(" { ");
+      PrintMessage(nested);
+      output_.append("} ");
+      return;
+    }
+
+    printer_.PrintFieldValueToString(message, &field, index, &value_);
+    output_.append(": ").append(value_).append(" ");
+  }
+
+  const std::size_t limit_;
+  google::protobuf::TextFormat::Printer printer_;
+  std::string output_;
+  std::string value_;
+};
+
+}  // namespace
+
+std::string ToLimitedString(const google::protobuf::Message& message,
+                            std::size_t limit) {
+  LimitedPrinter printer{limit};
+  printer.PrintMessage(message);
+  return std::move(printer).Extract();
+}
+
+logging::LogHelper& operator<<(logging::LogHelper& lh,
+                               const MessageForLogging& value) {
+  return lh << ToLimitedString(value.message, value.limit);
+}
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
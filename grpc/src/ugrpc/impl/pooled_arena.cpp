@@ -0,0 +1,55 @@
+#include <userver/ugrpc/impl/pooled_arena.hpp>
+
+#include <cstddef>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 8 * 1024;
+constexpr std::size_t kMaxPooledBlocks = 64;
+
+std::vector<std::unique_ptr<char[]>>& GetLocalPool() {
+  thread_local std::vector<std::unique_ptr<char[]>> pool = [] {
+    std::vector<std::unique_ptr<char[]>> result;
+    // no allocations on return of a block
+    result.reserve(kMaxPooledBlocks);
+    return result;
+  }();
+  return pool;
+}
+
+google::protobuf::ArenaOptions MakeArenaOptions(char* block) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block;
+  options.initial_block_size = kBlockSize;
+  return options;
+}
+
+}  // namespace
+
+PooledArena::Block::Block() {
+  auto& pool = GetLocalPool();
+  if (pool.empty()) {
+    // no need to zero the memory
+    data_.reset(new char[kBlockSize]);
+  } else {
+    data_ = std::move(pool.back());
+    pool.pop_back();
+  }
+}
+
+PooledArena::Block::~Block() {
+  // the block may be returned to a pool of another thread, which is fine
+  auto& pool = GetLocalPool();
+  if (pool.size() < kMaxPooledBlocks) pool.push_back(std::move(data_));
+}
+
+PooledArena::PooledArena() : arena_(MakeArenaOptions(block_.Data())) {}
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
@@ -1,8 +1,10 @@
 #include <userver/ugrpc/impl/queue_runner.hpp>
 
+#include <chrono>
 #include <thread>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/thread_name.hpp>
 
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
@@ -13,7 +15,7 @@ namespace ugrpc::impl {
 
 namespace {
 
-void ProcessQueue(grpc::CompletionQueue& queue,
+void ProcessQueue(grpc::CompletionQueue& queue, QueueStatistics& stats,
                   engine::SingleUseEvent& completion) noexcept {
   utils::SetCurrentThreadName("grpc-queue");
 
@@ -21,9 +23,15 @@ void ProcessQueue(grpc::CompletionQueue& queue,
   bool ok = false;
 
   while (queue.Next(&tag, &ok)) {
+    const auto start = std::chrono::steady_clock::now();
     auto* call = static_cast<EventBase*>(tag);
     UASSERT(call != nullptr);
     call->Notify(ok);
+
+    ++stats.events;
+    stats.busy_time_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
   }
 
   completion.Send();
@@ -31,8 +39,14 @@ void ProcessQueue(grpc::CompletionQueue& queue,
 
 }  // namespace
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const QueueStatistics& stats) {
+  writer["events"] = stats.events.load();
+  writer["busy-time-us"] = stats.busy_time_us.load();
+}
+
 QueueRunner::QueueRunner(grpc::CompletionQueue& queue) : queue_(queue) {
-  std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+  std::thread([this] { ProcessQueue(queue_, stats_, completion_); }).detach();
 }
 
 QueueRunner::~QueueRunner() {
@@ -1,6 +1,9 @@
 #include <userver/ugrpc/impl/statistics.hpp>
 
+#include <string>
+
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/underlying_value.hpp>
@@ -37,6 +40,23 @@ void MethodStatistics::AccountNetworkError() noexcept { ++network_errors_; }
 
 void MethodStatistics::AccountInternalError() noexcept { ++internal_errors_; }
 
+void MethodStatistics::SetConcurrencyLimit(std::size_t limit) noexcept {
+  concurrency_limit_ = limit;
+  has_concurrency_limit_ = true;
+}
+
+void MethodStatistics::AccountConcurrencyAcquired() noexcept {
+  ++concurrency_in_flight_;
+}
+
+void MethodStatistics::AccountConcurrencyReleased() noexcept {
+  --concurrency_in_flight_;
+}
+
+void MethodStatistics::AccountConcurrencyRejected() noexcept {
+  ++concurrency_rejected_;
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const MethodStatistics& stats) {
   writer["timings"] = stats.timings_.GetStatsForPeriod();
@@ -71,6 +91,13 @@ void DumpMetric(utils::statistics::Writer& writer,
 
   writer["network-error"] = network_errors_value;
   writer["abandoned-error"] = abandoned_errors_value;
+
+  if (stats.has_concurrency_limit_.load()) {
+    auto concurrency = writer["concurrency"];
+    concurrency["limit"] = stats.concurrency_limit_.load();
+    concurrency["in-flight"] = stats.concurrency_in_flight_.load();
+    concurrency["rejected"] = stats.concurrency_rejected_.load();
+  }
 }
 
 ServiceStatistics::~ServiceStatistics() = default;
@@ -107,6 +134,53 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 }
 
+EndpointStatistics::EndpointStatistics(std::size_t channel_count)
+    : channel_in_flight_(channel_count, 0) {
+  UASSERT(channel_count > 0);
+}
+
+void EndpointStatistics::AccountStarted(std::size_t channel_index) noexcept {
+  UASSERT(channel_index < channel_in_flight_.size());
+  ++started_;
+  ++channel_in_flight_[channel_index];
+}
+
+void EndpointStatistics::AccountFinished(std::size_t channel_index,
+                                         bool is_failure) noexcept {
+  UASSERT(channel_index < channel_in_flight_.size());
+  --channel_in_flight_[channel_index];
+  ++finished_;
+  if (is_failure) ++failures_;
+}
+
+std::size_t EndpointStatistics::GetChannelCount() const noexcept {
+  return channel_in_flight_.size();
+}
+
+std::uint64_t EndpointStatistics::GetChannelInFlight(
+    std::size_t channel_index) const noexcept {
+  UASSERT(channel_index < channel_in_flight_.size());
+  return channel_in_flight_[channel_index].load(std::memory_order_relaxed);
+}
+
+void EndpointStatistics::AccountEjection() noexcept { ++ejections_; }
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const EndpointStatistics& stats) {
+  const auto finished = stats.finished_.load();
+  writer["active"] = stats.started_.load() - finished;
+  writer["rps"] = finished;
+  writer["eps"] = stats.failures_.load();
+  writer["ejections"] = stats.ejections_.load();
+  if (stats.channel_in_flight_.size() > 1) {
+    auto in_flight = writer["channels"]["in-flight"];
+    for (std::size_t i = 0; i < stats.channel_in_flight_.size(); ++i) {
+      in_flight.ValueWithLabels(stats.channel_in_flight_[i].load(),
+                                {"grpc_channel", std::to_string(i)});
+    }
+  }
+}
+
 }  // namespace ugrpc::impl
 
 USERVER_NAMESPACE_END
@@ -42,6 +42,20 @@ ugrpc::impl::ServiceStatistics& StatisticsStorage::GetServiceStatistics(
   return iter->second;
 }
 
+ugrpc::impl::EndpointStatistics& StatisticsStorage::GetEndpointStatistics(
+    const std::string& endpoint, std::size_t channel_count) {
+  {
+    std::shared_lock lock(mutex_);
+    if (auto* stats = utils::FindOrNullptr(endpoint_statistics_, endpoint)) {
+      return *stats;
+    }
+  }
+
+  std::lock_guard lock(mutex_);
+  return endpoint_statistics_.try_emplace(endpoint, channel_count)
+      .first->second;
+}
+
 void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
   std::shared_lock lock(mutex_);
   {
@@ -50,6 +64,12 @@ void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
       by_destination = service_stats;
     }
   }
+  if (!endpoint_statistics_.empty()) {
+    auto by_endpoint = writer["by-endpoint"];
+    for (const auto& [endpoint, endpoint_stats] : endpoint_statistics_) {
+      by_endpoint.ValueWithLabels(endpoint_stats, {"grpc_endpoint", endpoint});
+    }
+  }
 }
 
 }  // namespace ugrpc::impl
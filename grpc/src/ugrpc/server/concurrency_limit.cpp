@@ -0,0 +1,22 @@
+#include <userver/ugrpc/server/concurrency_limit.hpp>
+
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+MethodConcurrencyLimit Parse(const yaml_config::YamlConfig& value,
+                             formats::parse::To<MethodConcurrencyLimit>) {
+  MethodConcurrencyLimit limit;
+  limit.max_in_flight = value["max-in-flight"].As<std::size_t>();
+  limit.max_queue_size =
+      value["max-queue-size"].As<std::size_t>(limit.max_queue_size);
+  limit.queue_timeout = value["queue-timeout"].As<std::chrono::milliseconds>(
+      limit.queue_timeout);
+  return limit;
+}
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
@@ -18,6 +18,10 @@ const grpc::Status kUnknownErrorStatus{
     grpc::StatusCode::UNKNOWN,
     "The service method has exited unexpectedly, without providing a status"};
 
+const grpc::Status kConcurrencyLimitStatus{
+    grpc::StatusCode::RESOURCE_EXHAUSTED,
+    "Too many concurrent requests to the method, try again later"};
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
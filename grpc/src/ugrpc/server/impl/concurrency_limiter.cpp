@@ -0,0 +1,76 @@
+#include <userver/ugrpc/server/impl/concurrency_limiter.hpp>
+
+#include <mutex>
+#include <utility>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+ConcurrencyPermit::ConcurrencyPermit(
+    engine::SemaphoreLock&& lock,
+    ugrpc::impl::MethodStatistics& statistics) noexcept
+    : lock_(std::move(lock)), statistics_(&statistics) {}
+
+ConcurrencyPermit::ConcurrencyPermit(ConcurrencyPermit&& other) noexcept
+    : lock_(std::move(other.lock_)),
+      statistics_(std::exchange(other.statistics_, nullptr)) {}
+
+ConcurrencyPermit& ConcurrencyPermit::operator=(
+    ConcurrencyPermit&& other) noexcept {
+  if (this == &other) return *this;
+  [[maybe_unused]] const ConcurrencyPermit old{std::move(*this)};
+  lock_ = std::move(other.lock_);
+  statistics_ = std::exchange(other.statistics_, nullptr);
+  return *this;
+}
+
+ConcurrencyPermit::~ConcurrencyPermit() {
+  if (statistics_) statistics_->AccountConcurrencyReleased();
+}
+
+ConcurrencyLimiter::ConcurrencyLimiter(
+    const MethodConcurrencyLimit& limit,
+    ugrpc::impl::MethodStatistics& statistics)
+    : limit_(limit), statistics_(statistics), semaphore_(limit.max_in_flight) {
+  statistics_.SetConcurrencyLimit(limit_.max_in_flight);
+}
+
+ConcurrencyPermit ConcurrencyLimiter::Acquire() {
+  engine::SemaphoreLock lock(semaphore_, std::try_to_lock);
+  if (!lock && limit_.max_queue_size != 0) {
+    if (queued_.fetch_add(1) < limit_.max_queue_size) {
+      [[maybe_unused]] const bool is_locked = lock.TryLockUntil(
+          engine::Deadline::FromDuration(limit_.queue_timeout));
+    }
+    queued_.fetch_sub(1);
+  }
+
+  if (!lock) {
+    ++rejected_;
+    statistics_.AccountConcurrencyRejected();
+    return {};
+  }
+  ++admitted_;
+  statistics_.AccountConcurrencyAcquired();
+  return ConcurrencyPermit{std::move(lock), statistics_};
+}
+
+ConcurrencyLimiter::Data ConcurrencyLimiter::FetchCurrent() {
+  const auto admitted = admitted_.load();
+  const auto rejected = rejected_.load();
+  const auto remaining = semaphore_.RemainingApprox();
+
+  return Data{
+      limit_.max_in_flight > remaining ? limit_.max_in_flight - remaining : 0,
+      rejected - std::exchange(last_rejected_, rejected),
+      admitted - std::exchange(last_admitted_, admitted),
+      std::chrono::steady_clock::now(),
+  };
+}
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
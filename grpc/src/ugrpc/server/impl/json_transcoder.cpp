@@ -0,0 +1,208 @@
+#include <ugrpc/server/impl/json_transcoder.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/type_resolver_util.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/proto_buffer_reader.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+
+#include <userver/ugrpc/impl/async_method_invocation.hpp>
+#include <userver/ugrpc/impl/deadline_timepoint.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+namespace {
+
+namespace handlers = USERVER_NAMESPACE::server::handlers;
+namespace http = USERVER_NAMESPACE::server::http;
+
+constexpr std::string_view kTypeUrlPrefix = "type.googleapis.com";
+
+std::string MakeTypeUrl(const google::protobuf::Descriptor& type) {
+  return fmt::format("{}/{}", kTypeUrlPrefix, type.full_name());
+}
+
+bool IsStreaming(const google::protobuf::MethodDescriptor& method) noexcept {
+  return method.client_streaming() || method.server_streaming();
+}
+
+const google::protobuf::MethodDescriptor* FindMethodDescriptor(
+    const std::string& service_name, const std::string& method_name) {
+  const auto* service =
+      google::protobuf::DescriptorPool::generated_pool()->FindServiceByName(
+          service_name);
+  return service ? service->FindMethodByName(method_name) : nullptr;
+}
+
+http::HttpStatus ToHttpStatus(grpc::StatusCode code) noexcept {
+  switch (code) {
+    case grpc::StatusCode::INVALID_ARGUMENT:
+    case grpc::StatusCode::FAILED_PRECONDITION:
+    case grpc::StatusCode::OUT_OF_RANGE:
+      return http::HttpStatus::kBadRequest;
+    case grpc::StatusCode::UNAUTHENTICATED:
+      return http::HttpStatus::kUnauthorized;
+    case grpc::StatusCode::PERMISSION_DENIED:
+      return http::HttpStatus::kForbidden;
+    case grpc::StatusCode::NOT_FOUND:
+      return http::HttpStatus::kNotFound;
+    case grpc::StatusCode::ALREADY_EXISTS:
+    case grpc::StatusCode::ABORTED:
+      return http::HttpStatus::kConflict;
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+      return http::HttpStatus::kTooManyRequests;
+    case grpc::StatusCode::CANCELLED:
+      return http::HttpStatus::kClientClosedRequest;
+    case grpc::StatusCode::UNIMPLEMENTED:
+      return http::HttpStatus::kNotImplemented;
+    case grpc::StatusCode::UNAVAILABLE:
+      return http::HttpStatus::kServiceUnavailable;
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+      return http::HttpStatus::kGatewayTimeout;
+    default:
+      return http::HttpStatus::kInternalServerError;
+  }
+}
+
+std::string MakeErrorBody(const grpc::Status& status) {
+  formats::json::StringBuilder sb;
+  {
+    const formats::json::StringBuilder::ObjectGuard guard{sb};
+    sb.Key("code");
+    WriteToStream(static_cast<int>(status.error_code()), sb);
+    sb.Key("message");
+    WriteToStream(status.error_message(), sb);
+  }
+  return sb.GetString();
+}
+
+void DeleteString(void* string) noexcept {
+  delete static_cast<std::string*>(string);
+}
+
+// Hands the serialized message over to grpc without copying
+grpc::ByteBuffer MakeByteBuffer(std::string&& data) {
+  auto* owned = new std::string(std::move(data));
+  grpc::Slice slice(owned->data(), owned->size(), &DeleteString, owned);
+  return grpc::ByteBuffer(&slice, 1);
+}
+
+}  // namespace
+
+const google::protobuf::MethodDescriptor* ParseUnaryMethod(
+    const std::optional<std::string>& full_name) {
+  if (!full_name) return nullptr;
+
+  const auto delimiter = full_name->find('/');
+  if (delimiter == std::string::npos) {
+    throw std::runtime_error(fmt::format(
+        "grpc-method '{}' must be of the form package.Service/Method",
+        *full_name));
+  }
+  const auto* method = FindMethodDescriptor(full_name->substr(0, delimiter),
+                                            full_name->substr(delimiter + 1));
+  if (!method) {
+    throw std::runtime_error(fmt::format(
+        "gRPC method '{}' is not found among the linked services",
+        *full_name));
+  }
+  if (IsStreaming(*method)) {
+    throw std::runtime_error(fmt::format(
+        "gRPC method '{}' is a streaming one, only unary methods may be "
+        "transcoded",
+        *full_name));
+  }
+  return method;
+}
+
+JsonTranscoder::JsonTranscoder(
+    Server& server,
+    const google::protobuf::util::JsonParseOptions& parse_options,
+    const google::protobuf::util::JsonPrintOptions& print_options)
+    : server_(server),
+      type_resolver_(google::protobuf::util::NewTypeResolverForDescriptorPool(
+          std::string{kTypeUrlPrefix},
+          google::protobuf::DescriptorPool::generated_pool())),
+      parse_options_(parse_options),
+      print_options_(print_options) {}
+
+JsonTranscoder::~JsonTranscoder() = default;
+
+const google::protobuf::MethodDescriptor& JsonTranscoder::FindMethod(
+    const std::string& service_name, const std::string& method_name) const {
+  const auto* method = FindMethodDescriptor(service_name, method_name);
+  if (!method || IsStreaming(*method)) {
+    throw handlers::ResourceNotFound(handlers::ExternalBody{fmt::format(
+        "Unknown unary gRPC method '{}/{}'", service_name, method_name)});
+  }
+  return *method;
+}
+
+TranscodedResponse JsonTranscoder::Call(
+    const google::protobuf::MethodDescriptor& method,
+    const std::string& json_request, engine::Deadline deadline) const {
+  // an empty body stands for a message with all the fields missing
+  std::string binary_request;
+  if (!json_request.empty()) {
+    const auto status = google::protobuf::util::JsonToBinaryString(
+        type_resolver_.get(), MakeTypeUrl(*method.input_type()), json_request,
+        &binary_request, parse_options_);
+    if (!status.ok()) {
+      throw handlers::ClientError(handlers::ExternalBody{
+          fmt::format("Invalid request: {}", status.ToString())});
+    }
+  }
+
+  grpc::ClientContext client_context;
+  if (deadline.IsReachable()) client_context.set_deadline(deadline);
+
+  grpc::GenericStub stub{server_.GetInProcessChannel()};
+  const auto call = stub.PrepareUnaryCall(
+      &client_context,
+      fmt::format("/{}/{}", method.service()->full_name(), method.name()),
+      MakeByteBuffer(std::move(binary_request)),
+      &server_.GetCompletionQueue());
+  call->StartCall();
+
+  grpc::ByteBuffer binary_response;
+  grpc::Status status;
+  ugrpc::impl::AsyncMethodInvocation finish;
+  call->Finish(&binary_response, &status, finish.GetTag());
+  if (!finish.Wait()) {
+    throw handlers::InternalServerError(
+        handlers::InternalMessage{"gRPC call has been interrupted"});
+  }
+
+  if (!status.ok()) {
+    return {ToHttpStatus(status.error_code()), MakeErrorBody(status)};
+  }
+
+  TranscodedResponse response;
+  {
+    grpc::ProtoBufferReader binary_input(&binary_response);
+    google::protobuf::io::StringOutputStream json_output(&response.body);
+    const auto convert_status = google::protobuf::util::BinaryToJsonStream(
+        type_resolver_.get(), MakeTypeUrl(*method.output_type()),
+        &binary_input, &json_output, print_options_);
+    if (!convert_status.ok()) {
+      throw handlers::InternalServerError(handlers::InternalMessage{
+          fmt::format("Failed to convert the response of '{}' to JSON: {}",
+                      method.full_name(), convert_status.ToString())});
+    }
+  }
+  return response;
+}
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
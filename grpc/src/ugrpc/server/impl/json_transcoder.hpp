@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/type_resolver.h>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/server/http/http_status.hpp>
+
+#include <userver/ugrpc/server/server.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+/// @returns the unary method for the `grpc-method` option of the form
+/// package.Service/Method, nullptr if there is no option
+/// @throws std::runtime_error if the method is malformed, unknown or streaming
+const google::protobuf::MethodDescriptor* ParseUnaryMethod(
+    const std::optional<std::string>& full_name);
+
+struct TranscodedResponse final {
+  USERVER_NAMESPACE::server::http::HttpStatus status{
+      USERVER_NAMESPACE::server::http::HttpStatus::kOk};
+  std::string body;
+};
+
+/// Calls the unary methods of the server with JSON requests, see
+/// ugrpc::server::JsonTranscodingHandler
+class JsonTranscoder final {
+ public:
+  JsonTranscoder(Server& server,
+                 const google::protobuf::util::JsonParseOptions& parse_options,
+                 const google::protobuf::util::JsonPrintOptions& print_options);
+  ~JsonTranscoder();
+
+  /// @throws server::handlers::ResourceNotFound if there is no such unary
+  /// method among the linked services
+  const google::protobuf::MethodDescriptor& FindMethod(
+      const std::string& service_name, const std::string& method_name) const;
+
+  /// A non-OK status of the call is returned as an HTTP error status with a
+  /// `{"code", "message"}` JSON body
+  /// @throws server::handlers::ClientError if the request is not a valid JSON
+  /// of the input message
+  TranscodedResponse Call(const google::protobuf::MethodDescriptor& method,
+                          const std::string& json_request,
+                          engine::Deadline deadline) const;
+
+ private:
+  Server& server_;
+  const std::unique_ptr<google::protobuf::util::TypeResolver> type_resolver_;
+  const google::protobuf::util::JsonParseOptions parse_options_;
+  const google::protobuf::util::JsonPrintOptions print_options_;
+};
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -2,7 +2,6 @@
 
 #include <utility>
 
-#include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +25,10 @@ QueueHolder::~QueueHolder() = default;
 
 grpc::ServerCompletionQueue& QueueHolder::GetQueue() { return *impl_->queue; }
 
+const ugrpc::impl::QueueStatistics& QueueHolder::GetStatistics() const {
+  return impl_->queue_runner.GetStatistics();
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 
 #include <grpcpp/completion_queue.h>
 
+#include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -24,9 +25,11 @@ class QueueHolder final {
 
   grpc::ServerCompletionQueue& GetQueue();
 
+  const ugrpc::impl::QueueStatistics& GetStatistics() const;
+
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 32, 8> impl_;
+  utils::FastPimpl<Impl, 48, 8> impl_;
 };
 
 }  // namespace ugrpc::server::impl
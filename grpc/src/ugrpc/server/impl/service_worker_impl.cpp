@@ -1,5 +1,9 @@
 #include <userver/ugrpc/server/impl/service_worker_impl.hpp>
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tags.hpp>
 #include <userver/utils/algo.hpp>
@@ -58,6 +62,34 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                              ugrpc::impl::ToGrpcString(span.GetLink()));
 }
 
+std::vector<std::unique_ptr<ConcurrencyLimiter>> MakeConcurrencyLimiters(
+    const ServiceSettings& settings,
+    const ugrpc::impl::StaticServiceMetadata& metadata,
+    ugrpc::impl::ServiceStatistics& statistics) {
+  std::vector<std::unique_ptr<ConcurrencyLimiter>> limiters(
+      metadata.method_full_names.size());
+  std::size_t limits_found = 0;
+
+  for (std::size_t method_id = 0; method_id < limiters.size(); ++method_id) {
+    const auto method_name = metadata.method_full_names[method_id].substr(
+        metadata.service_full_name.size() + 1);
+    const auto* limit = utils::FindOrNullptr(settings.concurrency_limits,
+                                             std::string{method_name});
+    if (!limit) continue;
+
+    ++limits_found;
+    limiters[method_id] = std::make_unique<ConcurrencyLimiter>(
+        *limit, statistics.GetMethodStatistics(method_id));
+  }
+
+  if (limits_found != settings.concurrency_limits.size()) {
+    throw std::runtime_error(fmt::format(
+        "Concurrency limits of service '{}' refer to unknown methods",
+        metadata.service_full_name));
+  }
+  return limiters;
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,109 @@
+#include <userver/ugrpc/server/json_transcoding_handler.hpp>
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <userver/components/component.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <ugrpc/server/impl/json_transcoder.hpp>
+#include <userver/ugrpc/server/server_component.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+namespace {
+
+google::protobuf::util::JsonParseOptions MakeParseOptions(
+    const components::ComponentConfig& config) {
+  google::protobuf::util::JsonParseOptions options;
+  options.ignore_unknown_fields =
+      config["ignore-unknown-fields"].As<bool>(false);
+  return options;
+}
+
+google::protobuf::util::JsonPrintOptions MakePrintOptions(
+    const components::ComponentConfig& config) {
+  google::protobuf::util::JsonPrintOptions options;
+  options.preserve_proto_field_names =
+      config["preserve-proto-field-names"].As<bool>(false);
+  options.always_print_primitive_fields =
+      config["always-print-primitive-fields"].As<bool>(false);
+  return options;
+}
+
+}  // namespace
+
+JsonTranscodingHandler::JsonTranscodingHandler(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      transcoder_(std::make_unique<impl::JsonTranscoder>(
+          context
+              .FindComponent<ServerComponent>(
+                  config["grpc-server"].As<std::string>(
+                      ServerComponent::kName))
+              .GetServer(),
+          MakeParseOptions(config), MakePrintOptions(config))),
+      method_(impl::ParseUnaryMethod(
+          config["grpc-method"].As<std::optional<std::string>>())) {}
+
+JsonTranscodingHandler::~JsonTranscodingHandler() = default;
+
+std::string JsonTranscodingHandler::HandleRequestThrow(
+    const USERVER_NAMESPACE::server::http::HttpRequest& request,
+    USERVER_NAMESPACE::server::request::RequestContext&) const {
+  const auto& method =
+      method_ ? *method_
+              : transcoder_->FindMethod(request.GetPathArg("service"),
+                                        request.GetPathArg("method"));
+
+  auto transcoded = transcoder_->Call(
+      method, request.RequestBody(),
+      USERVER_NAMESPACE::server::request::GetTaskInheritedDeadline());
+
+  auto& response = request.GetHttpResponse();
+  response.SetContentType(
+      USERVER_NAMESPACE::http::content_type::kApplicationJson);
+  response.SetStatus(transcoded.status);
+  return std::move(transcoded.body);
+}
+
+yaml_config::Schema JsonTranscodingHandler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: HTTP/JSON transcoding handler of unary gRPC methods
+additionalProperties: false
+properties:
+    grpc-server:
+        type: string
+        description: the name of the ugrpc::server::ServerComponent
+        defaultDescription: grpc-server
+    grpc-method:
+        type: string
+        description: |
+            the full name of the method, e.g. package.Service/Method; if
+            missing, the {service} and {method} path arguments are used
+        defaultDescription: taken from the path arguments
+    ignore-unknown-fields:
+        type: boolean
+        description: ignore the unknown fields of the request JSON
+        defaultDescription: false
+    preserve-proto-field-names:
+        type: boolean
+        description: use the field names of .proto files in the response
+        defaultDescription: false
+    always-print-primitive-fields:
+        type: boolean
+        description: print the fields with default values in the response
+        defaultDescription: false
+)");
+}
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include <fmt/format.h>
@@ -16,7 +17,8 @@
 #include <userver/logging/level_serialization.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/impl/logging.hpp>
@@ -77,6 +79,9 @@ ServerConfig Parse(const yaml_config::YamlConfig& value,
   config.native_log_level =
       value["native-log-level"].As<logging::Level>(logging::Level::kError);
   config.enable_channelz = value["enable-channelz"].As<bool>(false);
+  config.completion_queue_count =
+      value["completion-queue-count"].As<std::size_t>(1);
+  config.use_arena = value["use-arena"].As<bool>(false);
   return config;
 }
 
@@ -86,7 +91,8 @@ class Server::Impl final {
                 utils::statistics::Storage& statistics_storage);
   ~Impl();
 
-  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor);
+  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor,
+                  MethodConcurrencyLimits&& concurrency_limits);
 
   std::vector<std::string_view> GetServiceNames() const;
 
@@ -94,6 +100,8 @@ class Server::Impl final {
 
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  std::shared_ptr<grpc::Channel> GetInProcessChannel();
+
   void Start();
 
   int GetPort() const noexcept;
@@ -113,20 +121,27 @@ class Server::Impl final {
 
   void DoStart();
 
+  void WriteQueuesStatistics(utils::statistics::Writer& writer) const;
+
   State state_{State::kConfiguration};
   std::optional<grpc::ServerBuilder> server_builder_;
   std::optional<int> port_;
+  bool use_arena_{false};
   std::vector<std::unique_ptr<impl::ServiceWorker>> service_workers_;
-  std::optional<impl::QueueHolder> queue_;
+  // The first queue is also used for clients
+  std::vector<std::unique_ptr<impl::QueueHolder>> queues_;
   std::unique_ptr<grpc::Server> server_;
+  std::shared_ptr<grpc::Channel> in_process_channel_;
   mutable engine::Mutex configuration_mutex_;
 
   ugrpc::impl::StatisticsStorage statistics_storage_;
+  utils::statistics::Entry queues_statistics_holder_;
 };
 
 Server::Impl::Impl(ServerConfig&& config,
                    utils::statistics::Storage& statistics_storage)
-    : statistics_storage_(statistics_storage, "server") {
+    : use_arena_(config.use_arena),
+      statistics_storage_(statistics_storage, "server") {
   LOG_INFO() << "Configuring the gRPC server";
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
@@ -139,7 +154,16 @@ Server::Impl::Impl(ServerConfig&& config,
   }
   server_builder_.emplace();
   ApplyChannelArgs(*server_builder_, config);
-  queue_.emplace(server_builder_->AddCompletionQueue());
+  UINVARIANT(config.completion_queue_count > 0,
+             "completion-queue-count must be positive");
+  for (std::size_t i = 0; i < config.completion_queue_count; ++i) {
+    queues_.push_back(std::make_unique<impl::QueueHolder>(
+        server_builder_->AddCompletionQueue()));
+  }
+  queues_statistics_holder_ = statistics_storage.RegisterWriter(
+      "grpc.server-queues", [this](utils::statistics::Writer& writer) {
+        WriteQueuesStatistics(writer);
+      });
   if (config.port) AddListeningPort(*config.port);
 }
 
@@ -150,6 +174,7 @@ Server::Impl::~Impl() {
                    "ensure that it is destroyed before services.";
     Stop();
   }
+  queues_statistics_holder_.Unregister();
 }
 
 void Server::Impl::AddListeningPort(int port) {
@@ -167,12 +192,18 @@ void Server::Impl::AddListeningPort(int port) {
 }
 
 void Server::Impl::AddService(ServiceBase& service,
-                              engine::TaskProcessor& task_processor) {
+                              engine::TaskProcessor& task_processor,
+                              MethodConcurrencyLimits&& concurrency_limits) {
   std::lock_guard lock(configuration_mutex_);
   UASSERT(state_ == State::kConfiguration);
 
+  std::vector<grpc::ServerCompletionQueue*> queues;
+  queues.reserve(queues_.size());
+  for (auto& queue : queues_) queues.push_back(&queue->GetQueue());
+
   service_workers_.push_back(service.MakeWorker(impl::ServiceSettings{
-      queue_->GetQueue(), task_processor, statistics_storage_}));
+      std::move(queues), task_processor, statistics_storage_, use_arena_,
+      std::move(concurrency_limits)}));
 }
 
 std::vector<std::string_view> Server::Impl::GetServiceNames() const {
@@ -196,7 +227,14 @@ void Server::Impl::WithServerBuilder(SetupHook&& setup) {
 
 grpc::CompletionQueue& Server::Impl::GetCompletionQueue() noexcept {
   UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
-  return queue_->GetQueue();
+  return queues_.front()->GetQueue();
+}
+
+std::shared_ptr<grpc::Channel> Server::Impl::GetInProcessChannel() {
+  // 'in_process_channel_' is only modified by 'Start' and 'Stop', which may
+  // not run concurrently with the requests, so no locking is needed here
+  UINVARIANT(in_process_channel_, "The gRPC server is not running");
+  return in_process_channel_;
 }
 
 void Server::Impl::Start() {
@@ -231,7 +269,10 @@ void Server::Impl::Stop() noexcept {
     server_->Shutdown();
   }
   service_workers_.clear();
-  queue_.reset();
+  // waits for the statistics writer that reads the queues
+  queues_statistics_holder_.Unregister();
+  queues_.clear();
+  in_process_channel_.reset();
   server_.reset();
 
   state_ = State::kStopped;
@@ -242,6 +283,14 @@ void Server::Impl::StopDebug() noexcept {
   server_->Shutdown();
 }
 
+void Server::Impl::WriteQueuesStatistics(
+    utils::statistics::Writer& writer) const {
+  for (std::size_t i = 0; i < queues_.size(); ++i) {
+    writer.ValueWithLabels(queues_[i]->GetStatistics(),
+                           {"grpc_queue", std::to_string(i)});
+  }
+}
+
 void Server::Impl::DoStart() {
   LOG_INFO() << "Starting the gRPC server";
 
@@ -255,6 +304,7 @@ void Server::Impl::DoStart() {
   server_ = server_builder_->BuildAndStart();
   UINVARIANT(server_, "See grpcpp logs for details");
   server_builder_.reset();
+  in_process_channel_ = server_->InProcessChannel(grpc::ChannelArguments{});
 
   for (auto& worker : service_workers_) {
     worker->Start();
@@ -274,8 +324,9 @@ Server::Server(ServerConfig&& config,
 Server::~Server() = default;
 
 void Server::AddService(ServiceBase& service,
-                        engine::TaskProcessor& task_processor) {
-  impl_->AddService(service, task_processor);
+                        engine::TaskProcessor& task_processor,
+                        MethodConcurrencyLimits concurrency_limits) {
+  impl_->AddService(service, task_processor, std::move(concurrency_limits));
 }
 
 std::vector<std::string_view> Server::GetServiceNames() const {
@@ -290,6 +341,10 @@ grpc::CompletionQueue& Server::GetCompletionQueue() noexcept {
   return impl_->GetCompletionQueue();
 }
 
+std::shared_ptr<grpc::Channel> Server::GetInProcessChannel() {
+  return impl_->GetInProcessChannel();
+}
+
 void Server::Start() { return impl_->Start(); }
 
 int Server::GetPort() const noexcept { return impl_->GetPort(); }
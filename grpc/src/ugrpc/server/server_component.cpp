@@ -54,6 +54,15 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    completion-queue-count:
+        type: integer
+        description: the number of completion queues, each one is polled by a separate thread
+        defaultDescription: 1
+        minimum: 1
+    use-arena:
+        type: boolean
+        description: allocate incoming messages on protobuf arenas
+        defaultDescription: false
 )");
 }
 
@@ -4,6 +4,7 @@
 #include <userver/components/component_context.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 #include <userver/ugrpc/server/server_component.hpp>
 
@@ -17,11 +18,13 @@ ServiceComponentBase::ServiceComponentBase(
     : LoggableComponentBase(config, context),
       server_(context.FindComponent<ServerComponent>().GetServer()),
       service_task_processor_(context.GetTaskProcessor(
-          config["task-processor"].As<std::string>())) {}
+          config["task-processor"].As<std::string>())),
+      concurrency_limits_(
+          config["concurrency-limits"].As<MethodConcurrencyLimits>({})) {}
 
 void ServiceComponentBase::RegisterService(ServiceBase& service) {
   UASSERT_MSG(!registered_.exchange(true), "Register must only be called once");
-  server_.AddService(service, service_task_processor_);
+  server_.AddService(service, service_task_processor_, concurrency_limits_);
 }
 
 yaml_config::Schema ServiceComponentBase::GetStaticConfigSchema() {
@@ -33,6 +36,33 @@ properties:
     task-processor:
         type: string
         description: the task processor to use for responses
+    concurrency-limits:
+        type: object
+        description: per-method limits of the RPCs handled at the same time
+        defaultDescription: '{}'
+        additionalProperties:
+            type: object
+            description: the limit of a method, by method name
+            additionalProperties: false
+            properties:
+                max-in-flight:
+                    type: integer
+                    description: |
+                        the maximum number of RPCs of the method handled at
+                        the same time
+                max-queue-size:
+                    type: integer
+                    description: |
+                        the maximum number of RPCs waiting for a free slot,
+                        the rest are rejected with RESOURCE_EXHAUSTED
+                    defaultDescription: 0
+                queue-timeout:
+                    type: string
+                    description: |
+                        how long an RPC waits in the queue before it is
+                        rejected
+                    defaultDescription: 100ms
+        properties: {}
 )");
 }
 
@@ -4,6 +4,11 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,9 +16,17 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/dump/fwd.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/collection.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
@@ -29,12 +42,72 @@ inline const std::string kFetchAndParseStage = "fetch_and_parse";
 
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
+inline constexpr std::chrono::seconds kChangeStreamRetryInterval{1};
 
 namespace impl {
 
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
-}
+/// What a change event requires from a MongoCache
+enum class ChangeEventAction {
+  /// the full document of the event is added to the changes
+  kIncrementalUpdate,
+  /// the cache keys of the changed documents are unknown
+  kFullUpdate,
+  /// the stream is closed and has to be reopened without a resume token
+  kReopen,
+};
+
+/// The changes of a change stream not applied to a MongoCache yet and the
+/// position of the stream after them
+class ChangeStreamChanges final {
+ public:
+  struct Batch final {
+    std::vector<formats::bson::Document> documents;
+    /// resumes the stream right after the documents, std::nullopt if the
+    /// documents do not cover all the changes before it
+    std::optional<formats::bson::Document> resume_token;
+  };
+
+  /// Adds the full document of an insert, update or replace event
+  ChangeEventAction Add(const formats::bson::Document& event,
+                        std::optional<formats::bson::Document> resume_token);
+
+  std::optional<formats::bson::Document> GetResumeToken() const;
+  void SetResumeToken(std::optional<formats::bson::Document> resume_token);
+
+  /// Starts the changes of a stream opened without a resume token, the
+  /// changes made before it are unknown until a full update
+  void Restart(std::optional<formats::bson::Document> resume_token);
+
+  /// Takes the documents for an incremental update
+  Batch Extract();
+
+  /// Drops the documents, a full update started after the call includes them
+  /// @returns the resume token of the position the update covers
+  std::optional<formats::bson::Document> Discard();
+
+ private:
+  mutable engine::Mutex mutex_;
+  std::vector<formats::bson::Document> documents_;
+  std::optional<formats::bson::Document> resume_token_;
+  bool is_full_update_required_{false};
+};
+
+/// Reads the events of the stream into the changes and requests the cache
+/// updates they require until the stream is invalidated or the task is
+/// cancelled
+/// @throws the errors of the stream
+void ReadChangeStream(
+    storages::mongo::ChangeStream& stream, ChangeStreamChanges& changes,
+    const std::function<void(cache::UpdateType)>& invalidate_async);
+
+void WriteResumeToken(dump::Writer& writer,
+                      const std::optional<formats::bson::Document>& token);
+
+std::optional<formats::bson::Document> ReadResumeToken(dump::Reader& reader);
+
+}  // namespace impl
 
 // clang-format off
 
@@ -50,6 +123,20 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 /// ---- | ----------- | -------------
 /// update-correction | adjusts incremental updates window to overlap with previous update | 0
 ///
+/// ## Change streams:
+/// With `kUseChangeStream` in traits the cache watches the collection with
+/// a change stream (requires a replica set) and an incremental update
+/// applies the inserted, updated and replaced documents received since the
+/// previous update instead of querying the collection, so the update field
+/// is not required. An update is started right after the changes arrive.
+/// Deletions and the other events that cannot be mapped to the cache keys
+/// result in a full update. The stream is reopened after errors from the
+/// last received resume token, a full update is made if the stream cannot be
+/// resumed (e.g. the oplog has moved on). Cache dumps store the resume token
+/// of the dumped data, the stream is resumed from it after the dump is loaded
+/// (so enabling `kUseChangeStream` requires a new dump `format-version`).
+/// The stream holds a connection of the pool.
+///
 /// ## Traits example:
 /// All fields below (except for function overrides) are mandatory.
 ///
@@ -108,6 +195,10 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   // Whether update part of the cache even if failed to parse some documents
 ///   static constexpr bool kAreInvalidDocumentsSkipped = false;
 ///
+///   // Whether incremental updates apply the changes of a change stream
+///   // (optional, false by default)
+///   static constexpr bool kUseChangeStream = true;
+///
 ///   // Component to get the collections
 ///   using MongoCollectionsComponent = components::MongoCollections;
 /// };
@@ -131,6 +222,8 @@ class MongoCache
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
+  using DataType = typename MongoCacheTraits::DataType;
+
   void Update(cache::UpdateType type,
               const std::chrono::system_clock::time_point& last_update,
               const std::chrono::system_clock::time_point& now,
@@ -148,10 +241,34 @@ class MongoCache
   std::unique_ptr<typename MongoCacheTraits::DataType> GetData(
       cache::UpdateType type);
 
+  void ApplyChanges(cache::UpdateStatisticsScope& stats_scope);
+
+  void WriteContents(dump::Writer& writer,
+                     const DataType& contents) const override;
+  std::unique_ptr<const DataType> ReadContents(
+      dump::Reader& reader) const override;
+
+  void SetAppliedResumeToken(
+      const DataType* data,
+      std::optional<formats::bson::Document> resume_token) const;
+
+  storages::mongo::ChangeStream OpenChangeStream(
+      const std::optional<formats::bson::Document>& resume_token) const;
+  void ReadChangeStream(std::optional<storages::mongo::ChangeStream> stream);
+
   const std::shared_ptr<CollectionsType> mongo_collections_;
   const storages::mongo::Collection* const mongo_collection_;
   const std::chrono::system_clock::duration correction_;
   std::size_t cpu_relax_iterations_{0};
+
+  // mutable to be restored in ReadContents
+  mutable impl::ChangeStreamChanges changes_;
+  // the data of the last Set and the stream position it covers, for dumps
+  mutable engine::Mutex applied_mutex_;
+  mutable const DataType* applied_data_{nullptr};
+  mutable std::optional<formats::bson::Document> applied_resume_token_;
+  mutable bool is_dump_loaded_{false};
+  engine::TaskWithResult<void> change_stream_task_;
 };
 
 template <class MongoCacheTraits>
@@ -176,6 +293,7 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
   if (CachingComponentBase<
           typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
+      !mongo_cache::impl::kUseChangeStream<MongoCacheTraits> &&
       !mongo_cache::impl::kHasUpdateFieldName<MongoCacheTraits> &&
       !mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
     throw std::logic_error(
@@ -190,11 +308,42 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
         components::GetCurrentComponentName(config) + "' cache");
   }
 
+  [[maybe_unused]] std::optional<storages::mongo::ChangeStream> stream;
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    // opened before the first update to not miss the changes made during it
+    try {
+      stream = OpenChangeStream(std::nullopt);
+      changes_.Restart(stream->GetResumeToken());
+    } catch (const std::exception& e) {
+      LOG_WARNING() << "Failed to open the change stream for cache " << kName
+                    << ": " << e;
+    }
+  }
+
   this->StartPeriodicUpdates();
+
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    if (is_dump_loaded_) {
+      if (changes_.GetResumeToken()) {
+        // the changes made since the dump are read again
+        stream.reset();
+      } else {
+        // the position of the dumped data in the stream is unknown
+        this->InvalidateAsync(cache::UpdateType::kFull);
+      }
+    }
+    change_stream_task_ = engine::CriticalAsyncNoSpan(
+        this->GetCacheTaskProcessor(),
+        [this](std::optional<storages::mongo::ChangeStream> stream) {
+          ReadChangeStream(std::move(stream));
+        },
+        std::move(stream));
+  }
 }
 
 template <class MongoCacheTraits>
 MongoCache<MongoCacheTraits>::~MongoCache() {
+  if (change_stream_task_.IsValid()) change_stream_task_.SyncCancel();
   this->StopPeriodicUpdates();
 }
 
@@ -206,6 +355,16 @@ void MongoCache<MongoCacheTraits>::Update(
     cache::UpdateStatisticsScope& stats_scope) {
   namespace sm = storages::mongo;
 
+  [[maybe_unused]] std::optional<formats::bson::Document> resume_token;
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    if (type == cache::UpdateType::kIncremental) {
+      ApplyChanges(stats_scope);
+      return;
+    }
+    // the scan below includes the changes received before it
+    resume_token = changes_.Discard();
+  }
+
   const auto* collection = mongo_collection_;
   auto find_op = GetFindOperation(type, last_update, now, correction_);
   auto cursor = collection->Execute(find_op);
@@ -267,7 +426,11 @@ void MongoCache<MongoCacheTraits>::Update(
   scope.Reset();
 
   const auto size = new_cache->size();
+  [[maybe_unused]] const DataType* const data = new_cache.get();
   this->Set(std::move(new_cache));
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    SetAppliedResumeToken(data, std::move(resume_token));
+  }
   stats_scope.Finish(size);
 }
 
@@ -333,6 +496,134 @@ MongoCache<MongoCacheTraits>::GetData(cache::UpdateType type) {
   }
 }
 
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::ApplyChanges(
+    cache::UpdateStatisticsScope& stats_scope) {
+  auto changes = changes_.Extract();
+  if (changes.documents.empty()) {
+    LOG_INFO() << "No changes in cache " << MongoCacheTraits::kName;
+    stats_scope.FinishNoChanges();
+    return;
+  }
+
+  auto scope = tracing::Span::CurrentSpan().CreateScopeTime("copy_data");
+  auto new_cache = GetData(cache::UpdateType::kIncremental);
+  scope.Reset(kFetchAndParseStage);
+
+  for (const auto& doc : changes.documents) {
+    stats_scope.IncreaseDocumentsReadCount(1);
+
+    try {
+      auto object = DeserializeObject(doc);
+      auto key = (object.*MongoCacheTraits::kKeyField);
+      (*new_cache)[key] = std::move(object);
+    } catch (const std::exception& e) {
+      LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
+                          << MongoCacheTraits::kName << ", _id="
+                          << doc["_id"].template ConvertTo<std::string>()
+                          << ", what(): " << e;
+      stats_scope.IncreaseDocumentsParseFailures(1);
+
+      if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+    }
+  }
+
+  scope.Reset();
+
+  const auto size = new_cache->size();
+  const DataType* const data = new_cache.get();
+  this->Set(std::move(new_cache));
+  SetAppliedResumeToken(data, std::move(changes.resume_token));
+  stats_scope.Finish(size);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::WriteContents(
+    dump::Writer& writer, const DataType& contents) const {
+  CachingComponentBase<DataType>::WriteContents(writer, contents);
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    std::optional<formats::bson::Document> resume_token;
+    {
+      std::lock_guard lock(applied_mutex_);
+      // the token of newer data is not written with the older one
+      if (applied_data_ == &contents) resume_token = applied_resume_token_;
+    }
+    impl::WriteResumeToken(writer, resume_token);
+  }
+}
+
+template <class MongoCacheTraits>
+std::unique_ptr<const typename MongoCacheTraits::DataType>
+MongoCache<MongoCacheTraits>::ReadContents(dump::Reader& reader) const {
+  auto contents = CachingComponentBase<DataType>::ReadContents(reader);
+  if constexpr (mongo_cache::impl::kUseChangeStream<MongoCacheTraits>) {
+    auto resume_token = impl::ReadResumeToken(reader);
+    // the stream is not read until the dump is loaded
+    changes_.Discard();
+    changes_.SetResumeToken(resume_token);
+    SetAppliedResumeToken(contents.get(), std::move(resume_token));
+    is_dump_loaded_ = true;
+  }
+  return contents;
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::SetAppliedResumeToken(
+    const DataType* data,
+    std::optional<formats::bson::Document> resume_token) const {
+  std::lock_guard lock(applied_mutex_);
+  applied_data_ = data;
+  applied_resume_token_ = std::move(resume_token);
+}
+
+template <class MongoCacheTraits>
+storages::mongo::ChangeStream MongoCache<MongoCacheTraits>::OpenChangeStream(
+    const std::optional<formats::bson::Document>& resume_token) const {
+  namespace sm = storages::mongo;
+
+  sm::operations::Watch watch_op(formats::bson::MakeArray());
+  watch_op.SetOption(sm::options::FullDocumentLookup{});
+  if (resume_token) watch_op.SetOption(sm::options::ResumeAfter{*resume_token});
+  return mongo_collection_->Execute(watch_op);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::ReadChangeStream(
+    std::optional<storages::mongo::ChangeStream> stream) {
+  const auto invalidate_async = [this](cache::UpdateType type) {
+    this->InvalidateAsync(type);
+  };
+
+  while (!engine::current_task::ShouldCancel()) {
+    bool is_resuming = false;
+    try {
+      if (!stream) {
+        const auto resume_token = changes_.GetResumeToken();
+        is_resuming = resume_token.has_value();
+        stream = OpenChangeStream(resume_token);
+        is_resuming = false;
+        if (!resume_token) {
+          // the changes made while there was no stream are unknown
+          changes_.Restart(stream->GetResumeToken());
+          this->InvalidateAsync(cache::UpdateType::kFull);
+        }
+      }
+
+      impl::ReadChangeStream(*stream, changes_, invalidate_async);
+      // the stream is invalidated
+      stream.reset();
+      continue;
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Failed to read the change stream for cache " << kName
+                    << ": " << e;
+      stream.reset();
+      if (is_resuming) changes_.SetResumeToken(std::nullopt);
+    }
+    engine::InterruptibleSleepFor(kChangeStreamRetryInterval);
+  }
+}
+
 namespace impl {
 
 std::string GetMongoCacheSchema();
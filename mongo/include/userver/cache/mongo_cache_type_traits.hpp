@@ -99,6 +99,23 @@ template <typename T>
 inline constexpr bool kHasInvalidDocumentsSkipped =
     meta::kIsDetected<HasInvalidDocumentsSkipped, T>;
 
+template <typename T>
+using HasUseChangeStream = decltype(T::kUseChangeStream);
+template <typename T>
+inline constexpr bool kHasUseChangeStream =
+    meta::kIsDetected<HasUseChangeStream, T>;
+
+template <typename T>
+constexpr bool IsChangeStreamUsed() {
+  if constexpr (kHasUseChangeStream<T>) {
+    return T::kUseChangeStream;
+  } else {
+    return false;
+  }
+}
+template <typename T>
+inline constexpr bool kUseChangeStream = IsChangeStreamUsed<T>();
+
 template <typename>
 struct ClassByMemberPointer {};
 template <typename T, typename C>
@@ -127,6 +144,13 @@ struct CheckTraits {
                          bool>,
           "Mongo cache traits must specify kUseDefaultFindOperation as bool");
     }
+    if constexpr (kHasUseChangeStream<MongoCacheTraits>) {
+      static_assert(
+          std::is_same_v<
+              std::decay_t<decltype(MongoCacheTraits::kUseChangeStream)>,
+              bool>,
+          "Mongo cache traits must specify kUseChangeStream as bool");
+    }
   }
 
   static_assert(kHasCollectionsField<MongoCacheTraits>,
@@ -53,6 +53,9 @@ class BsonBuilder {
 
   BsonBuilder& Append(std::string_view key, const bson_t*);
 
+  /// Removes all the fields, keeping the allocated buffer
+  void Reset();
+
   const bson_t* Get() const;
   bson_t* Get();
 
@@ -0,0 +1,93 @@
+#pragma once
+
+/// @file userver/formats/bson/document_sequence.hpp
+/// @brief @copybrief formats::bson::DocumentSequence
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/formats/bson/bson_builder.hpp>
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+/// @brief Documents written one after another into a single buffer
+///
+/// Unlike a vector of documents built with MakeDoc(), the fields are written
+/// through a single reused builder and each document is appended to
+/// the common buffer, so that in a steady state building a document does not
+/// allocate. Nested documents and arrays are copied from the provided values.
+///
+/// Meant for the bulk writes, see storages::mongo::operations::InsertMany and
+/// storages::mongo::operations::Bulk::InsertMany.
+///
+/// ## Example usage:
+///
+/// @snippet formats/bson/document_sequence_test.cpp  Sample formats::bson::DocumentSequence usage
+class DocumentSequence final {
+ public:
+  /// Preallocates the buffer for about `reserve_bytes` of documents
+  explicit DocumentSequence(std::size_t reserve_bytes = 0);
+
+  /// Appends a document of the provided key-value pairs, the values are the
+  /// same as for MakeDoc()
+  template <typename... Args>
+  void Append(Args&&... args);
+
+  /// Number of the documents in the sequence
+  std::size_t Size() const { return offsets_.size(); }
+
+  bool IsEmpty() const { return offsets_.empty(); }
+
+  /// Total size of the documents in bytes
+  std::size_t ByteSize() const { return buffer_.size(); }
+
+  /// Returns a copy of the document at the position
+  Document GetDocument(std::size_t index) const;
+
+  /// Removes all the documents, keeping the allocated buffer
+  void Clear();
+
+  /// @cond
+  // Serialized documents written back to back, internal use only
+  std::string_view GetData() const { return buffer_; }
+
+  // Offsets of the documents in GetData(), internal use only
+  const std::vector<std::uint32_t>& GetOffsets() const { return offsets_; }
+  /// @endcond
+
+ private:
+  void AppendFields() {}
+
+  template <typename FieldValue, typename... Tail>
+  void AppendFields(std::string_view key, FieldValue&& value, Tail&&... tail) {
+    builder_.Append(key, std::forward<FieldValue>(value));
+    AppendFields(std::forward<Tail>(tail)...);
+  }
+
+  void Commit();
+
+  impl::BsonBuilder builder_;
+  std::string buffer_;
+  std::vector<std::uint32_t> offsets_;
+};
+
+template <typename... Args>
+void DocumentSequence::Append(Args&&... args) {
+  static_assert(sizeof...(Args) % 2 == 0,
+                "Arguments must be key-value pairs");
+
+  builder_.Reset();
+  AppendFields(std::forward<Args>(args)...);
+  Commit();
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
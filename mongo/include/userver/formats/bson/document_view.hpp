@@ -0,0 +1,105 @@
+#pragma once
+
+/// @file userver/formats/bson/document_view.hpp
+/// @brief @copybrief formats::bson::DocumentView
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+/// @brief Read-only view of a BSON document that reads the fields directly
+/// from the document buffer
+///
+/// Unlike formats::bson::Value, the view does not build a tree of values on
+/// field access, and strings and subdocuments are returned without copying.
+/// Each lookup is a linear scan over the document fields, so the view is best
+/// suited for reading a few fields of large documents, e.g. of the documents
+/// returned by a big storages::mongo::Cursor scan.
+///
+/// If a field is duplicated, the first one is used.
+///
+/// The view shares the ownership of the underlying buffer with the document.
+class DocumentView final {
+ public:
+  explicit DocumentView(const Document& document);
+
+  /// Returns whether the document has a field with the specified name
+  bool HasMember(std::string_view name) const;
+
+  /// @brief Returns the value of the field
+  ///
+  /// Supported types are `bool`, `int64_t` (from any integer field),
+  /// `double` (from any number field), `std::string_view`, formats::bson::Oid,
+  /// `std::chrono::system_clock::time_point` and DocumentView for
+  /// subdocuments. Returned string views and subdocument views are valid while
+  /// this view or the document exist.
+  /// @throws MemberMissingException if there is no such field
+  /// @throws TypeMismatchException if the field has an unsupported type
+  template <typename T>
+  T Get(std::string_view name) const;
+
+  /// @brief Returns the value of the field or `std::nullopt` if the field is
+  /// missing or is null
+  /// @throws TypeMismatchException if the field has an unsupported type
+  template <typename T>
+  std::optional<T> GetOptional(std::string_view name) const;
+
+  /// Converts the view into a document, the buffer is copied for subdocuments
+  Document ToDocument() const;
+
+ private:
+  DocumentView(impl::BsonHolder owner, const uint8_t* data,
+               std::uint32_t length, std::string path);
+
+  bool IsNullOrMissing(std::string_view name) const;
+
+  impl::BsonHolder owner_;
+  const uint8_t* data_;
+  std::uint32_t length_;
+  std::string path_;
+};
+
+template <typename T>
+std::optional<T> DocumentView::GetOptional(std::string_view name) const {
+  if (IsNullOrMissing(name)) return std::nullopt;
+  return Get<T>(name);
+}
+
+/// @cond
+template <>
+bool DocumentView::Get<bool>(std::string_view name) const;
+
+template <>
+int64_t DocumentView::Get<int64_t>(std::string_view name) const;
+
+template <>
+double DocumentView::Get<double>(std::string_view name) const;
+
+template <>
+std::string_view DocumentView::Get<std::string_view>(
+    std::string_view name) const;
+
+template <>
+Oid DocumentView::Get<Oid>(std::string_view name) const;
+
+template <>
+std::chrono::system_clock::time_point
+DocumentView::Get<std::chrono::system_clock::time_point>(
+    std::string_view name) const;
+
+template <>
+DocumentView DocumentView::Get<DocumentView>(std::string_view name) const;
+/// @endcond
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
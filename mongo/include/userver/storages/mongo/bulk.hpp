@@ -3,6 +3,7 @@
 /// @file userver/storages/mongo/bulk.hpp
 /// @brief Bulk collection operation model
 
+#include <userver/formats/bson/document_sequence.hpp>
 #include <userver/storages/mongo/bulk_ops.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -38,6 +39,9 @@ class Bulk {
   template <typename... Options>
   void InsertOne(formats::bson::Document document, Options&&... options);
 
+  /// Inserts all the documents of the sequence
+  void InsertMany(const formats::bson::DocumentSequence& documents);
+
   /// @brief Replaces a single matching document
   /// @see options::Upsert
   template <typename... Options>
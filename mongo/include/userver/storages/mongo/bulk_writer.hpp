@@ -0,0 +1,221 @@
+#pragma once
+
+/// @file userver/storages/mongo/bulk_writer.hpp
+/// @brief @copybrief storages::mongo::BulkWriter
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value_builder.hpp>
+#include <userver/storages/mongo/bulk.hpp>
+#include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/options.hpp>
+#include <userver/storages/mongo/write_result.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+/// @brief Accumulates write operations into bulks and executes them in
+/// background, with several bulks in flight at once.
+///
+/// A bulk is sent out as soon as it has Settings::max_operations operations or
+/// Settings::max_bytes of documents, and at least once in about
+/// Settings::max_delay. If Settings::max_in_flight bulks are already being
+/// executed, adding an operation waits for the oldest one to complete.
+///
+/// Flush() waits for all the bulks and returns their combined WriteResult,
+/// where the operations are indexed in the order they were added since the
+/// previous Flush(). If a bulk execution fails, the first error is rethrown
+/// from Flush() instead, the other bulks are still executed.
+///
+/// Bulks in flight are not ordered against each other, so either use
+/// Bulk::Mode::kUnordered or set Settings::max_in_flight to 1 if the order of
+/// the operations matters.
+///
+/// The class is thread-safe.
+class BulkWriter final {
+ public:
+  struct Settings final {
+    /// Max number of operations in a single bulk
+    std::size_t max_operations{1000};
+    /// Max total size of the documents in a single bulk
+    std::size_t max_bytes{8 * 1024 * 1024};
+    /// Max time for an operation to wait for the bulk execution
+    std::chrono::milliseconds max_delay{std::chrono::seconds{1}};
+    /// Max number of bulks executed at once
+    std::size_t max_in_flight{4};
+    /// Mode of the bulks
+    operations::Bulk::Mode mode{operations::Bulk::Mode::kUnordered};
+    /// Write concern of the bulks, the collection default if not set
+    std::optional<options::WriteConcern> write_concern{};
+    /// Report server errors in the WriteResult instead of throwing
+    bool suppress_server_exceptions{false};
+  };
+
+  BulkWriter(Collection collection, Settings settings);
+
+  /// Executes the remaining operations, errors are logged
+  ~BulkWriter();
+
+  BulkWriter(const BulkWriter&) = delete;
+  BulkWriter& operator=(const BulkWriter&) = delete;
+
+  /// Inserts a single document
+  template <typename... Options>
+  void InsertOne(formats::bson::Document document, Options&&... options);
+
+  /// @brief Replaces a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  void ReplaceOne(formats::bson::Document selector,
+                  formats::bson::Document replacement, Options&&... options);
+
+  /// @brief Updates a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  void UpdateOne(formats::bson::Document selector,
+                 formats::bson::Document update, Options&&... options);
+
+  /// @brief Updates all matching documents
+  /// @see options::Upsert
+  template <typename... Options>
+  void UpdateMany(formats::bson::Document selector,
+                  formats::bson::Document update, Options&&... options);
+
+  /// Deletes a single matching document
+  template <typename... Options>
+  void DeleteOne(formats::bson::Document selector, Options&&... options);
+
+  /// Deletes all matching documents
+  template <typename... Options>
+  void DeleteMany(formats::bson::Document selector, Options&&... options);
+
+  /// @brief Executes the current bulk, waits for all the bulks in flight and
+  /// returns the combined result of the operations added since the previous
+  /// call
+  /// @throws the first error of the bulk executions, if any
+  WriteResult Flush();
+
+ private:
+  struct InFlightBulk {
+    std::size_t first_index;
+    engine::TaskWithResult<WriteResult> task;
+  };
+
+  template <typename Append>
+  void AddOperation(std::size_t bytes, Append&& append);
+
+  static std::size_t GetSize(const formats::bson::Document& document);
+
+  operations::Bulk MakeBulk() const;
+  void OnOperationAdded(std::unique_lock<engine::Mutex>& lock,
+                        std::size_t bytes);
+  void StartBulk(std::unique_lock<engine::Mutex>& lock);
+  void WaitForOldest(std::unique_lock<engine::Mutex>& lock);
+  void Merge(std::size_t first_index, const WriteResult& result);
+  void ResetTotals();
+
+  Collection collection_;
+  const Settings settings_;
+
+  engine::Mutex mutex_;
+  operations::Bulk bulk_;
+  std::size_t bulk_operations_{0};
+  std::size_t bulk_bytes_{0};
+  std::size_t total_operations_{0};
+  std::deque<InFlightBulk> in_flight_;
+
+  std::size_t inserted_{0};
+  std::size_t matched_{0};
+  std::size_t modified_{0};
+  std::size_t upserted_{0};
+  std::size_t deleted_{0};
+  formats::bson::ValueBuilder upserted_ids_;
+  formats::bson::ValueBuilder write_errors_;
+  formats::bson::ValueBuilder write_concern_errors_;
+  std::exception_ptr error_;
+
+  // must be the last member, as its callback uses the others
+  USERVER_NAMESPACE::utils::PeriodicTask flush_timer_;
+};
+
+template <typename Append>
+void BulkWriter::AddOperation(std::size_t bytes, Append&& append) {
+  std::unique_lock lock(mutex_);
+  append(bulk_);
+  OnOperationAdded(lock, bytes);
+}
+
+template <typename... Options>
+void BulkWriter::InsertOne(formats::bson::Document document,
+                           Options&&... options) {
+  const auto bytes = GetSize(document);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.InsertOne(std::move(document), std::forward<Options>(options)...);
+  });
+}
+
+template <typename... Options>
+void BulkWriter::ReplaceOne(formats::bson::Document selector,
+                            formats::bson::Document replacement,
+                            Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(replacement);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.ReplaceOne(std::move(selector), std::move(replacement),
+                    std::forward<Options>(options)...);
+  });
+}
+
+template <typename... Options>
+void BulkWriter::UpdateOne(formats::bson::Document selector,
+                           formats::bson::Document update,
+                           Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(update);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.UpdateOne(std::move(selector), std::move(update),
+                   std::forward<Options>(options)...);
+  });
+}
+
+template <typename... Options>
+void BulkWriter::UpdateMany(formats::bson::Document selector,
+                            formats::bson::Document update,
+                            Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(update);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.UpdateMany(std::move(selector), std::move(update),
+                    std::forward<Options>(options)...);
+  });
+}
+
+template <typename... Options>
+void BulkWriter::DeleteOne(formats::bson::Document selector,
+                           Options&&... options) {
+  const auto bytes = GetSize(selector);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.DeleteOne(std::move(selector), std::forward<Options>(options)...);
+  });
+}
+
+template <typename... Options>
+void BulkWriter::DeleteMany(formats::bson::Document selector,
+                            Options&&... options) {
+  const auto bytes = GetSize(selector);
+  AddOperation(bytes, [&](operations::Bulk& bulk) {
+    bulk.DeleteMany(std::move(selector), std::forward<Options>(options)...);
+  });
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,47 @@
+#pragma once
+
+/// @file userver/storages/mongo/change_stream.hpp
+/// @brief @copybrief storages::mongo::ChangeStream
+
+#include <memory>
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace impl {
+class ChangeStreamImpl;
+}  // namespace impl
+
+/// @brief MongoDB change stream of a collection, see
+/// storages::mongo::Collection::Watch.
+///
+/// Holds a connection of the pool for its lifetime.
+class ChangeStream {
+ public:
+  explicit ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&&);
+  ~ChangeStream();
+
+  ChangeStream(ChangeStream&&) noexcept;
+  ChangeStream& operator=(ChangeStream&&) noexcept;
+
+  /// @brief Waits for the next change event.
+  /// @returns the event or std::nullopt if there were no events within
+  /// the max await time of the stream
+  /// @throws MongoException and its descendants on error, the stream should
+  /// be reopened with options::ResumeAfter
+  std::optional<formats::bson::Document> Next();
+
+  /// @returns the token to resume the stream after the last returned event,
+  /// if any
+  std::optional<formats::bson::Document> GetResumeToken() const;
+
+ private:
+  std::unique_ptr<impl::ChangeStreamImpl> impl_;
+};
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
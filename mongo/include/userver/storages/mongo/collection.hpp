@@ -11,6 +11,7 @@
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/value.hpp>
 #include <userver/storages/mongo/bulk.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/cursor.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/write_result.hpp>
@@ -124,6 +125,13 @@ class Collection {
   template <typename... Options>
   Cursor Aggregate(formats::bson::Value pipeline, Options&&... options);
 
+  /// @brief Opens a change stream of the collection, requires a replica set
+  /// @param pipeline an array of aggregation stages applied to the events,
+  /// may be empty
+  template <typename... Options>
+  ChangeStream Watch(formats::bson::Value pipeline,
+                     Options&&... options) const;
+
   /// @name Prepared operation executors
   /// @{
   size_t Execute(const operations::Count&) const;
@@ -139,6 +147,7 @@ class Collection {
   WriteResult Execute(operations::Bulk&&);
   Cursor Execute(const operations::Aggregate&);
   void Execute(const operations::Drop&);
+  ChangeStream Execute(const operations::Watch&) const;
   /// @}
  private:
   std::shared_ptr<impl::CollectionImpl> impl_;
@@ -300,6 +309,14 @@ Cursor Collection::Aggregate(formats::bson::Value pipeline,
   return Execute(aggregate);
 }
 
+template <typename... Options>
+ChangeStream Collection::Watch(formats::bson::Value pipeline,
+                               Options&&... options) const {
+  operations::Watch watch(std::move(pipeline));
+  (watch.SetOption(std::forward<Options>(options)), ...);
+  return Execute(watch);
+}
+
 }  // namespace storages::mongo
 
 USERVER_NAMESPACE_END
@@ -60,6 +60,8 @@ namespace components {
 /// local_threshold | latency window for instance selection | mongodb default
 /// max_replication_lag | replication lag limit for usable secondaries, min. 90s | -
 /// maintenance_period | pool maintenance period (idle connections pruning etc.) | 15s
+/// lifo_acquire | reuse the most recently released connection first to keep the working set of connections small and hot | false
+/// max_idle_time | with lifo_acquire, close the connections idle for longer; 0 keeps up to idle_limit | 0
 /// stats_verbosity | changes the granularity of reported metrics | 'terse'
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'getaddrinfo'
 ///
@@ -130,6 +132,8 @@ inline constexpr bool kHasValidate<Mongo> = true;
 /// initial_size | number of connections created initially (per database) | 16
 /// max_size | limit for total connections number (per database) | 128
 /// idle_limit | limit for idle connections number (per database) | 64
+/// lifo_acquire | reuse the most recently released connection first to keep the working set of connections small and hot | false
+/// max_idle_time | with lifo_acquire, close the connections idle for longer; 0 keeps up to idle_limit | 0
 /// connecting_limit | limit for establishing connections number (per database) | 8
 /// local_threshold | latency window for instance selection | mongodb default
 /// max_replication_lag | replication lag limit for usable secondaries, min. 90s | -
@@ -4,6 +4,7 @@
 /// @brief Collection operation models
 
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/document_sequence.hpp>
 #include <userver/formats/bson/value.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -17,6 +18,8 @@ class CDriverCollectionImpl;
 /// Collection operations
 namespace storages::mongo::operations {
 
+struct WatchArguments;
+
 /// Counts documents matching the filter
 class Count {
  public:
@@ -136,6 +139,8 @@ class InsertMany {
  public:
   InsertMany();
   explicit InsertMany(std::vector<formats::bson::Document> documents);
+  /// Inserts the documents without copying them one by one
+  explicit InsertMany(formats::bson::DocumentSequence documents);
   ~InsertMany();
 
   InsertMany(const InsertMany&);
@@ -154,7 +159,7 @@ class InsertMany {
   friend class storages::mongo::impl::cdriver::CDriverCollectionImpl;
 
   class Impl;
-  static constexpr size_t kSize = 80;
+  static constexpr size_t kSize = 144;
   static constexpr size_t kAlignment = 8;
   // MAC_COMPAT: std::string size differs
   utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
@@ -355,6 +360,32 @@ class Drop {
   utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
 };
 
+/// Opens a change stream of the collection
+class Watch {
+ public:
+  /// @param pipeline an array of aggregation stages applied to the change
+  /// events, may be empty
+  explicit Watch(formats::bson::Value pipeline);
+  ~Watch();
+
+  Watch(const Watch&);
+  Watch(Watch&&) noexcept;
+  Watch& operator=(const Watch&);
+  Watch& operator=(Watch&&) noexcept;
+
+  void SetOption(const options::ResumeAfter&);
+  void SetOption(options::FullDocumentLookup);
+  void SetOption(const options::MaxAwaitTime&);
+
+ private:
+  friend struct WatchArguments;
+
+  class Impl;
+  static constexpr size_t kSize = 40;
+  static constexpr size_t kAlignment = 8;
+  utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
+};
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
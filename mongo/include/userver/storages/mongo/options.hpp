@@ -283,6 +283,36 @@ class MaxServerTime {
   std::chrono::milliseconds value_;
 };
 
+/// @brief Resumes a change stream right after the event of the token
+/// @see storages::mongo::ChangeStream::GetResumeToken
+class ResumeAfter {
+ public:
+  explicit ResumeAfter(formats::bson::Document token);
+
+  const formats::bson::Document& Value() const;
+
+ private:
+  formats::bson::Document token_;
+};
+
+/// @brief Makes the update events of a change stream contain the current
+/// version of the whole document in `fullDocument`
+class FullDocumentLookup {};
+
+/// @brief Specifies how long the server waits for new events of a change
+/// stream before returning no events, 1 second by default
+/// @warning Must be less than the socket timeout of the pool.
+class MaxAwaitTime {
+ public:
+  explicit MaxAwaitTime(const std::chrono::milliseconds& value)
+      : value_(value) {}
+
+  const std::chrono::milliseconds& Value() const { return value_; }
+
+ private:
+  std::chrono::milliseconds value_;
+};
+
 }  // namespace storages::mongo::options
 
 USERVER_NAMESPACE_END
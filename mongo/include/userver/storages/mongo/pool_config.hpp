@@ -67,6 +67,11 @@ class PoolConfig {
   std::optional<std::chrono::milliseconds> local_threshold;
   /// Pool maintenance period
   std::chrono::milliseconds maintenance_period;
+  /// Reuse the most recently released connection first
+  bool lifo_acquire;
+  /// With lifo_acquire, idle time after which a connection is closed
+  /// (0 - keep up to idle_limit)
+  std::chrono::milliseconds max_idle_time;
 
   /// Application name (sent to server)
   std::string app_name;
@@ -1,6 +1,10 @@
 #include <userver/cache/base_mongo_cache.hpp>
 
 #include <userver/components/component_config.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/formats/bson/binary.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +16,102 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(
   return config["update-correction"].As<std::chrono::milliseconds>(0);
 }
 
+ChangeEventAction ChangeStreamChanges::Add(
+    const formats::bson::Document& event,
+    std::optional<formats::bson::Document> resume_token) {
+  const auto operation_type = event["operationType"].As<std::string>("");
+  const auto full_document = event["fullDocument"];
+
+  std::lock_guard lock(mutex_);
+  resume_token_ = std::move(resume_token);
+  if ((operation_type == "insert" || operation_type == "update" ||
+       operation_type == "replace") &&
+      full_document.IsDocument()) {
+    documents_.emplace_back(full_document);
+    return ChangeEventAction::kIncrementalUpdate;
+  }
+  if (operation_type == "invalidate") {
+    // the stream is closed and cannot be resumed
+    resume_token_.reset();
+    is_full_update_required_ = true;
+    return ChangeEventAction::kReopen;
+  }
+  // deleted documents cannot be mapped to the cache keys
+  is_full_update_required_ = true;
+  return ChangeEventAction::kFullUpdate;
+}
+
+std::optional<formats::bson::Document> ChangeStreamChanges::GetResumeToken()
+    const {
+  std::lock_guard lock(mutex_);
+  return resume_token_;
+}
+
+void ChangeStreamChanges::SetResumeToken(
+    std::optional<formats::bson::Document> resume_token) {
+  std::lock_guard lock(mutex_);
+  resume_token_ = std::move(resume_token);
+}
+
+void ChangeStreamChanges::Restart(
+    std::optional<formats::bson::Document> resume_token) {
+  std::lock_guard lock(mutex_);
+  resume_token_ = std::move(resume_token);
+  is_full_update_required_ = true;
+}
+
+ChangeStreamChanges::Batch ChangeStreamChanges::Extract() {
+  Batch batch;
+  std::lock_guard lock(mutex_);
+  batch.documents.swap(documents_);
+  if (!is_full_update_required_) batch.resume_token = resume_token_;
+  return batch;
+}
+
+std::optional<formats::bson::Document> ChangeStreamChanges::Discard() {
+  std::lock_guard lock(mutex_);
+  documents_.clear();
+  is_full_update_required_ = false;
+  return resume_token_;
+}
+
+void ReadChangeStream(
+    storages::mongo::ChangeStream& stream, ChangeStreamChanges& changes,
+    const std::function<void(cache::UpdateType)>& invalidate_async) {
+  while (!engine::current_task::ShouldCancel()) {
+    const auto event = stream.Next();
+    auto resume_token = stream.GetResumeToken();
+    if (!event) {
+      if (resume_token) changes.SetResumeToken(std::move(resume_token));
+      continue;
+    }
+
+    switch (changes.Add(*event, std::move(resume_token))) {
+      case ChangeEventAction::kIncrementalUpdate:
+        invalidate_async(cache::UpdateType::kIncremental);
+        break;
+      case ChangeEventAction::kFullUpdate:
+        invalidate_async(cache::UpdateType::kFull);
+        break;
+      case ChangeEventAction::kReopen:
+        return;
+    }
+  }
+}
+
+void WriteResumeToken(dump::Writer& writer,
+                      const std::optional<formats::bson::Document>& token) {
+  std::optional<std::string> binary;
+  if (token) binary = formats::bson::ToBinaryString(*token).ToString();
+  writer.Write(binary);
+}
+
+std::optional<formats::bson::Document> ReadResumeToken(dump::Reader& reader) {
+  const auto binary = reader.Read<std::optional<std::string>>();
+  if (!binary) return std::nullopt;
+  return formats::bson::FromBinaryString(*binary);
+}
+
 std::string GetMongoCacheSchema() {
   return R"(
 type: object
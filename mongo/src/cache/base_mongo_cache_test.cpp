@@ -0,0 +1,208 @@
+#include <userver/cache/base_mongo_cache.hpp>
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/operations_mock.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <storages/mongo/change_stream_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace bson = formats::bson;
+
+using components::impl::ChangeEventAction;
+using components::impl::ChangeStreamChanges;
+
+struct FakeEvent {
+  std::optional<bson::Document> event;
+  bson::Document resume_token;
+};
+
+class FakeChangeStreamImpl final
+    : public storages::mongo::impl::ChangeStreamImpl {
+ public:
+  explicit FakeChangeStreamImpl(std::vector<FakeEvent> events)
+      : events_(std::move(events)) {}
+
+  std::optional<bson::Document> Next() override {
+    if (next_ == events_.size()) throw std::runtime_error("connection lost");
+    resume_token_ = events_[next_].resume_token;
+    return events_[next_++].event;
+  }
+
+  std::optional<bson::Document> GetResumeToken() const override {
+    return resume_token_;
+  }
+
+ private:
+  std::vector<FakeEvent> events_;
+  std::size_t next_{0};
+  std::optional<bson::Document> resume_token_;
+};
+
+storages::mongo::ChangeStream MakeStream(std::vector<FakeEvent> events) {
+  return storages::mongo::ChangeStream(
+      std::make_unique<FakeChangeStreamImpl>(std::move(events)));
+}
+
+bson::Document MakeToken(int position) {
+  return bson::MakeDoc("_data", std::to_string(position));
+}
+
+bson::Document MakeEvent(const std::string& operation_type,
+                         std::optional<int> key = {}) {
+  if (!key) return bson::MakeDoc("operationType", operation_type);
+  return bson::MakeDoc("operationType", operation_type, "fullDocument",
+                       bson::MakeDoc("_id", *key));
+}
+
+std::vector<int> GetKeys(const ChangeStreamChanges::Batch& batch) {
+  std::vector<int> keys;
+  for (const auto& doc : batch.documents) keys.push_back(doc["_id"].As<int>());
+  return keys;
+}
+
+}  // namespace
+
+UTEST(MongoCacheChangeStream, EventActions) {
+  ChangeStreamChanges changes;
+
+  EXPECT_EQ(changes.Add(MakeEvent("insert", 1), MakeToken(1)),
+            ChangeEventAction::kIncrementalUpdate);
+  EXPECT_EQ(changes.Add(MakeEvent("update", 2), MakeToken(2)),
+            ChangeEventAction::kIncrementalUpdate);
+  EXPECT_EQ(changes.Add(MakeEvent("replace", 3), MakeToken(3)),
+            ChangeEventAction::kIncrementalUpdate);
+  // the document was deleted before the lookup
+  EXPECT_EQ(changes.Add(MakeEvent("update"), MakeToken(4)),
+            ChangeEventAction::kFullUpdate);
+  EXPECT_EQ(changes.Add(MakeEvent("delete"), MakeToken(5)),
+            ChangeEventAction::kFullUpdate);
+  EXPECT_EQ(changes.Add(MakeEvent("drop"), MakeToken(6)),
+            ChangeEventAction::kFullUpdate);
+  EXPECT_EQ(changes.Add(bson::MakeDoc("_id", MakeToken(7)), MakeToken(7)),
+            ChangeEventAction::kFullUpdate);
+  EXPECT_EQ(changes.GetResumeToken(), MakeToken(7));
+
+  EXPECT_EQ(changes.Add(MakeEvent("invalidate"), MakeToken(8)),
+            ChangeEventAction::kReopen);
+  EXPECT_EQ(changes.GetResumeToken(), std::nullopt);
+
+  const auto batch = changes.Extract();
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{1, 2, 3}));
+}
+
+UTEST(MongoCacheChangeStream, IncrementalBatches) {
+  ChangeStreamChanges changes;
+  changes.SetResumeToken(MakeToken(0));
+
+  auto batch = changes.Extract();
+  EXPECT_TRUE(batch.documents.empty());
+  EXPECT_EQ(batch.resume_token, MakeToken(0));
+
+  changes.Add(MakeEvent("insert", 1), MakeToken(1));
+  changes.Add(MakeEvent("update", 1), MakeToken(2));
+  batch = changes.Extract();
+  // the updates of a key are applied in order
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{1, 1}));
+  EXPECT_EQ(batch.resume_token, MakeToken(2));
+
+  changes.Add(MakeEvent("replace", 3), MakeToken(3));
+  batch = changes.Extract();
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{3}));
+  EXPECT_EQ(batch.resume_token, MakeToken(3));
+
+  EXPECT_TRUE(changes.Extract().documents.empty());
+}
+
+UTEST(MongoCacheChangeStream, PositionUnknownUntilFullUpdate) {
+  ChangeStreamChanges changes;
+  changes.Add(MakeEvent("insert", 1), MakeToken(1));
+  changes.Add(MakeEvent("delete"), MakeToken(2));
+  changes.Add(MakeEvent("insert", 3), MakeToken(3));
+
+  // the documents do not cover the deletion
+  auto batch = changes.Extract();
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{1, 3}));
+  EXPECT_EQ(batch.resume_token, std::nullopt);
+
+  changes.Add(MakeEvent("insert", 4), MakeToken(4));
+  EXPECT_EQ(changes.Discard(), MakeToken(4));
+  batch = changes.Extract();
+  EXPECT_TRUE(batch.documents.empty());
+  EXPECT_EQ(batch.resume_token, MakeToken(4));
+
+  changes.Restart(MakeToken(5));
+  changes.Add(MakeEvent("insert", 6), MakeToken(6));
+  batch = changes.Extract();
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{6}));
+  EXPECT_EQ(batch.resume_token, std::nullopt);
+  EXPECT_EQ(changes.Discard(), MakeToken(6));
+}
+
+UTEST(MongoCacheChangeStream, ReadUntilInvalidated) {
+  auto stream = MakeStream({
+      {MakeEvent("insert", 1), MakeToken(1)},
+      {std::nullopt, MakeToken(2)},
+      {MakeEvent("update", 2), MakeToken(3)},
+      {MakeEvent("delete"), MakeToken(4)},
+      {MakeEvent("replace", 3), MakeToken(5)},
+      {MakeEvent("invalidate"), MakeToken(6)},
+  });
+  ChangeStreamChanges changes;
+  std::vector<cache::UpdateType> updates;
+  components::impl::ReadChangeStream(
+      stream, changes,
+      [&updates](cache::UpdateType type) { updates.push_back(type); });
+
+  EXPECT_EQ(updates, (std::vector<cache::UpdateType>{
+                         cache::UpdateType::kIncremental,
+                         cache::UpdateType::kIncremental,
+                         cache::UpdateType::kFull,
+                         cache::UpdateType::kIncremental,
+                     }));
+  EXPECT_EQ(changes.GetResumeToken(), std::nullopt);
+  EXPECT_EQ(GetKeys(changes.Extract()), (std::vector<int>{1, 2, 3}));
+}
+
+UTEST(MongoCacheChangeStream, ReadError) {
+  auto stream = MakeStream({
+      {MakeEvent("insert", 1), MakeToken(1)},
+      {std::nullopt, MakeToken(2)},
+  });
+  ChangeStreamChanges changes;
+  std::size_t updates = 0;
+  const auto count_updates = [&updates](cache::UpdateType) { ++updates; };
+  UEXPECT_THROW(
+      components::impl::ReadChangeStream(stream, changes, count_updates),
+      std::runtime_error);
+
+  EXPECT_EQ(updates, 1);
+  // the stream is resumed after the last read position
+  EXPECT_EQ(changes.GetResumeToken(), MakeToken(2));
+  const auto batch = changes.Extract();
+  EXPECT_EQ(GetKeys(batch), (std::vector<int>{1}));
+  EXPECT_EQ(batch.resume_token, MakeToken(2));
+}
+
+TEST(MongoCacheChangeStream, DumpResumeToken) {
+  for (const auto& token :
+       {std::optional<bson::Document>{}, std::optional{MakeToken(42)}}) {
+    dump::MockWriter writer;
+    components::impl::WriteResumeToken(writer, token);
+    dump::MockReader reader(std::move(writer).Extract());
+    EXPECT_EQ(components::impl::ReadResumeToken(reader), token);
+    reader.Finish();
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -210,6 +210,8 @@ void BsonBuilder::AppendInto(bson_t* dest, std::string_view key,
   }
 }
 
+void BsonBuilder::Reset() { bson_reinit(bson_->Get()); }
+
 const bson_t* BsonBuilder::Get() const { return bson_->Get(); }
 bson_t* BsonBuilder::Get() { return bson_->Get(); }
 
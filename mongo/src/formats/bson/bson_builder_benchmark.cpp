@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/formats/bson.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace fb = formats::bson;
+
+// Fields of a typical users collection document, about 1KB
+struct User {
+  explicit User(std::int64_t id_)
+      : id(id_),
+        name("user-" + std::to_string(id)),
+        email(name + "@example.com"),
+        created(std::chrono::seconds{id}) {}
+
+  std::int64_t id;
+  std::string name;
+  std::string email;
+  std::chrono::system_clock::time_point created;
+  std::string payload = std::string(768, 'a');
+};
+
+std::vector<User> MakeUsers(std::int64_t count) {
+  std::vector<User> users;
+  users.reserve(count);
+  for (std::int64_t i = 0; i < count; ++i) users.emplace_back(i);
+  return users;
+}
+
+void ReportDocuments(benchmark::State& state) {
+  state.counters["documents"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(0)),
+      benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+// state.range(0) documents built one by one, as for InsertMany or Bulk
+void bson_build_documents(benchmark::State& state) {
+  const auto users = MakeUsers(state.range(0));
+
+  for (auto _ : state) {
+    std::vector<fb::Document> docs;
+    docs.reserve(users.size());
+    for (const auto& user : users) {
+      docs.push_back(fb::MakeDoc("_id", user.id, "name", user.name, "email",
+                                 user.email, "created", user.created,
+                                 "score", user.id * 0.5, "active",
+                                 user.id % 2 == 0, "payload", user.payload));
+    }
+    benchmark::DoNotOptimize(docs);
+  }
+  ReportDocuments(state);
+}
+BENCHMARK(bson_build_documents)->Range(1, 10'000);
+
+// The same documents written into a single buffer
+void bson_build_document_sequence(benchmark::State& state) {
+  const auto users = MakeUsers(state.range(0));
+
+  for (auto _ : state) {
+    fb::DocumentSequence sequence{users.size() * 1024};
+    for (const auto& user : users) {
+      sequence.Append("_id", user.id, "name", user.name, "email", user.email,
+                      "created", user.created, "score", user.id * 0.5,
+                      "active", user.id % 2 == 0, "payload", user.payload);
+    }
+    benchmark::DoNotOptimize(sequence);
+  }
+  ReportDocuments(state);
+}
+BENCHMARK(bson_build_document_sequence)->Range(1, 10'000);
+
+// The same documents written into a reused buffer
+void bson_build_document_sequence_reused(benchmark::State& state) {
+  const auto users = MakeUsers(state.range(0));
+
+  fb::DocumentSequence sequence;
+  for (auto _ : state) {
+    sequence.Clear();
+    for (const auto& user : users) {
+      sequence.Append("_id", user.id, "name", user.name, "email", user.email,
+                      "created", user.created, "score", user.id * 0.5,
+                      "active", user.id % 2 == 0, "payload", user.payload);
+    }
+    benchmark::DoNotOptimize(sequence);
+  }
+  ReportDocuments(state);
+}
+BENCHMARK(bson_build_document_sequence_reused)->Range(1, 10'000);
+
+USERVER_NAMESPACE_END
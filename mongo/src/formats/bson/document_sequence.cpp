@@ -0,0 +1,49 @@
+#include <userver/formats/bson/document_sequence.hpp>
+
+#include <limits>
+
+#include <bson/bson.h>
+
+#include <formats/bson/wrappers.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+DocumentSequence::DocumentSequence(std::size_t reserve_bytes) {
+  buffer_.reserve(reserve_bytes);
+}
+
+Document DocumentSequence::GetDocument(std::size_t index) const {
+  UINVARIANT(index < offsets_.size(), "Document index is out of range");
+
+  const auto offset = offsets_[index];
+  const auto end =
+      index + 1 < offsets_.size() ? offsets_[index + 1] : buffer_.size();
+  return Document(
+      impl::MutableBson(
+          reinterpret_cast<const uint8_t*>(buffer_.data() + offset),
+          end - offset)
+          .Extract());
+}
+
+void DocumentSequence::Clear() {
+  buffer_.clear();
+  offsets_.clear();
+}
+
+void DocumentSequence::Commit() {
+  const auto* native = builder_.Get();
+  UINVARIANT(buffer_.size() + native->len <=
+                 std::numeric_limits<std::uint32_t>::max(),
+             "Document sequence is too large");
+
+  offsets_.push_back(static_cast<std::uint32_t>(buffer_.size()));
+  buffer_.append(reinterpret_cast<const char*>(bson_get_data(native)),
+                 native->len);
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
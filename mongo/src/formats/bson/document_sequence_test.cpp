@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <userver/formats/bson.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+TEST(BsonDocumentSequence, Empty) {
+  const fb::DocumentSequence sequence;
+  EXPECT_TRUE(sequence.IsEmpty());
+  EXPECT_EQ(sequence.Size(), 0);
+  EXPECT_EQ(sequence.ByteSize(), 0);
+}
+
+TEST(BsonDocumentSequence, Sample) {
+  /// [Sample formats::bson::DocumentSequence usage]
+  // #include <userver/formats/bson.hpp>
+
+  formats::bson::DocumentSequence sequence{64 * 1024};
+  for (int i = 0; i < 100; ++i) {
+    sequence.Append("_id", i, "name", "user-" + std::to_string(i), "tags",
+                    formats::bson::MakeArray("a", "b"));
+  }
+  EXPECT_EQ(sequence.Size(), 100);
+
+  const auto doc = sequence.GetDocument(42);
+  EXPECT_EQ(doc["_id"].As<int>(), 42);
+  EXPECT_EQ(doc["name"].As<std::string>(), "user-42");
+  EXPECT_EQ(doc["tags"][1].As<std::string>(), "b");
+  /// [Sample formats::bson::DocumentSequence usage]
+}
+
+TEST(BsonDocumentSequence, SameAsMakeDoc) {
+  fb::DocumentSequence sequence;
+  sequence.Append();
+  sequence.Append("int", 1, "double", 2.5, "null", nullptr, "doc",
+                  fb::MakeDoc("key", "value"));
+  sequence.Append("bool", true);
+
+  ASSERT_EQ(sequence.Size(), 3);
+  EXPECT_EQ(sequence.GetDocument(0), fb::MakeDoc());
+  EXPECT_EQ(sequence.GetDocument(1),
+            fb::MakeDoc("int", 1, "double", 2.5, "null", nullptr, "doc",
+                        fb::MakeDoc("key", "value")));
+  EXPECT_EQ(sequence.GetDocument(2), fb::MakeDoc("bool", true));
+  EXPECT_EQ(sequence.ByteSize(),
+            fb::ToBinaryString(sequence.GetDocument(0)).GetView().size() +
+                fb::ToBinaryString(sequence.GetDocument(1)).GetView().size() +
+                fb::ToBinaryString(sequence.GetDocument(2)).GetView().size());
+}
+
+TEST(BsonDocumentSequence, InvalidValue) {
+  fb::DocumentSequence sequence;
+  sequence.Append("key", "value");
+  UEXPECT_THROW(sequence.Append("key", std::string_view{"\xff"}),
+                fb::BsonException);
+
+  // the failed document is not a part of the sequence
+  sequence.Append("key", "other");
+  ASSERT_EQ(sequence.Size(), 2);
+  EXPECT_EQ(sequence.GetDocument(1), fb::MakeDoc("key", "other"));
+}
+
+TEST(BsonDocumentSequence, Clear) {
+  fb::DocumentSequence sequence;
+  sequence.Append("key", 1);
+  sequence.Clear();
+  EXPECT_TRUE(sequence.IsEmpty());
+  EXPECT_EQ(sequence.ByteSize(), 0);
+
+  sequence.Append("key", 2);
+  ASSERT_EQ(sequence.Size(), 1);
+  EXPECT_EQ(sequence.GetDocument(0), fb::MakeDoc("key", 2));
+}
+
+USERVER_NAMESPACE_END
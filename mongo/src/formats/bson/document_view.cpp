@@ -0,0 +1,149 @@
+#include <userver/formats/bson/document_view.hpp>
+
+#include <userver/formats/bson/exception.hpp>
+#include <userver/formats/common/path.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+namespace {
+
+bool FindField(const uint8_t* data, std::uint32_t length,
+               std::string_view name, bson_iter_t& it) {
+  if (!bson_iter_init_from_data(&it, data, length)) {
+    throw ParseException("Malformed BSON");
+  }
+  while (bson_iter_next(&it)) {
+    if (name == std::string_view{bson_iter_key(&it), bson_iter_key_len(&it)}) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bson_iter_t FindExisting(const uint8_t* data, std::uint32_t length,
+                         std::string_view name, const std::string& path) {
+  bson_iter_t it;
+  if (!FindField(data, length, name, it)) {
+    throw MemberMissingException(common::MakeChildPath(path, name));
+  }
+  return it;
+}
+
+}  // namespace
+
+DocumentView::DocumentView(const Document& document)
+    : owner_(document.GetBson()),
+      data_(bson_get_data(owner_.get())),
+      length_(owner_->len) {}
+
+DocumentView::DocumentView(impl::BsonHolder owner, const uint8_t* data,
+                           std::uint32_t length, std::string path)
+    : owner_(std::move(owner)),
+      data_(data),
+      length_(length),
+      path_(std::move(path)) {}
+
+bool DocumentView::HasMember(std::string_view name) const {
+  bson_iter_t it;
+  return FindField(data_, length_, name, it);
+}
+
+bool DocumentView::IsNullOrMissing(std::string_view name) const {
+  bson_iter_t it;
+  return !FindField(data_, length_, name, it) ||
+         bson_iter_type(&it) == BSON_TYPE_NULL;
+}
+
+Document DocumentView::ToDocument() const {
+  if (data_ == bson_get_data(owner_.get())) return Document(owner_);
+
+  bson_t bson;
+  if (!bson_init_static(&bson, data_, length_)) {
+    throw ParseException("Malformed BSON");
+  }
+  return Document(impl::MutableBson::CopyNative(&bson).Extract());
+}
+
+template <>
+bool DocumentView::Get<bool>(std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_BOOL(&it)) return bson_iter_bool(&it);
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_BOOL,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+int64_t DocumentView::Get<int64_t>(std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_INT32(&it)) return bson_iter_int32(&it);
+  if (BSON_ITER_HOLDS_INT64(&it)) return bson_iter_int64(&it);
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_INT64,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+double DocumentView::Get<double>(std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_DOUBLE(&it)) return bson_iter_double(&it);
+  if (BSON_ITER_HOLDS_INT32(&it)) return bson_iter_int32(&it);
+  if (BSON_ITER_HOLDS_INT64(&it)) {
+    return static_cast<double>(bson_iter_int64(&it));
+  }
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_DOUBLE,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+std::string_view DocumentView::Get<std::string_view>(
+    std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_UTF8(&it)) {
+    std::uint32_t size = 0;
+    const char* str = bson_iter_utf8(&it, &size);
+    return {str, size};
+  }
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_UTF8,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+Oid DocumentView::Get<Oid>(std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_OID(&it)) return *bson_iter_oid(&it);
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_OID,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+std::chrono::system_clock::time_point
+DocumentView::Get<std::chrono::system_clock::time_point>(
+    std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_DATE_TIME(&it)) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(bson_iter_date_time(&it)));
+  }
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_DATE_TIME,
+                              common::MakeChildPath(path_, name));
+}
+
+template <>
+DocumentView DocumentView::Get<DocumentView>(std::string_view name) const {
+  auto it = FindExisting(data_, length_, name, path_);
+  if (BSON_ITER_HOLDS_DOCUMENT(&it)) {
+    std::uint32_t length = 0;
+    const uint8_t* data = nullptr;
+    bson_iter_document(&it, &length, &data);
+    return {owner_, data, length, common::MakeChildPath(path_, name)};
+  }
+  throw TypeMismatchException(bson_iter_type(&it), BSON_TYPE_DOCUMENT,
+                              common::MakeChildPath(path_, name));
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
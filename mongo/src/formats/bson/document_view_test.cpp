@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/document_view.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+namespace {
+
+const auto kTimePoint =
+    std::chrono::system_clock::from_time_t(0) + std::chrono::milliseconds{1};
+
+}  // namespace
+
+TEST(DocumentView, Get) {
+  const fb::Oid oid;
+  const auto doc = fb::MakeDoc(
+      "bool", true, "int32", 1, "int64", int64_t{2}, "double", 3.5, "string",
+      "test", "oid", oid, "date", kTimePoint, "null", nullptr);
+
+  const fb::DocumentView view{doc};
+  EXPECT_TRUE(view.HasMember("bool"));
+  EXPECT_FALSE(view.HasMember("missing"));
+
+  EXPECT_TRUE(view.Get<bool>("bool"));
+  EXPECT_EQ(1, view.Get<int64_t>("int32"));
+  EXPECT_EQ(2, view.Get<int64_t>("int64"));
+  EXPECT_DOUBLE_EQ(3.5, view.Get<double>("double"));
+  EXPECT_DOUBLE_EQ(2.0, view.Get<double>("int64"));
+  EXPECT_EQ("test", view.Get<std::string_view>("string"));
+  EXPECT_EQ(oid, view.Get<fb::Oid>("oid"));
+  EXPECT_EQ(kTimePoint,
+            view.Get<std::chrono::system_clock::time_point>("date"));
+
+  EXPECT_EQ(std::nullopt, view.GetOptional<int64_t>("null"));
+  EXPECT_EQ(std::nullopt, view.GetOptional<int64_t>("missing"));
+  EXPECT_EQ(1, view.GetOptional<int64_t>("int32"));
+
+  EXPECT_THROW(view.Get<bool>("missing"), fb::MemberMissingException);
+  EXPECT_THROW(view.Get<int64_t>("string"), fb::TypeMismatchException);
+  EXPECT_THROW(view.Get<fb::DocumentView>("int32"),
+               fb::TypeMismatchException);
+}
+
+TEST(DocumentView, Nested) {
+  const auto doc = fb::MakeDoc("outer", fb::MakeDoc("inner", "value"));
+
+  const auto nested = fb::DocumentView{doc}.Get<fb::DocumentView>("outer");
+  EXPECT_EQ("value", nested.Get<std::string_view>("inner"));
+  EXPECT_EQ(fb::MakeDoc("inner", "value"), nested.ToDocument());
+
+  try {
+    nested.Get<bool>("missing");
+    FAIL() << "exception is not thrown";
+  } catch (const fb::MemberMissingException& ex) {
+    EXPECT_NE(std::string_view{ex.what()}.find("outer.missing"),
+              std::string_view::npos);
+  }
+}
+
+TEST(DocumentView, OutlivesDocument) {
+  std::optional<fb::DocumentView> view;
+  {
+    const auto doc = fb::MakeDoc("string", "test");
+    view.emplace(doc);
+  }
+  EXPECT_EQ("test", view->Get<std::string_view>("string"));
+}
+
+USERVER_NAMESPACE_END
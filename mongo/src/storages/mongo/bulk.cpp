@@ -57,6 +57,20 @@ void Bulk::Append(const bulk_ops::InsertOne& insert_subop) {
   }
 }
 
+void Bulk::InsertMany(const formats::bson::DocumentSequence& documents) {
+  auto* bulk = EnsureBulk(impl_->bulk, impl_->mode);
+  for (std::size_t i = 0; i < documents.Size(); ++i) {
+    bson_t native;
+    impl::InitStaticBson(native, documents, i);
+
+    MongoError error;
+    if (!mongoc_bulk_operation_insert_with_opts(bulk, &native, nullptr,
+                                                error.GetNative())) {
+      error.Throw("Error appending insert to bulk");
+    }
+  }
+}
+
 void Bulk::Append(const bulk_ops::ReplaceOne& replace_subop) {
   MongoError error;
   const bson_t* native_selector_bson_ptr =
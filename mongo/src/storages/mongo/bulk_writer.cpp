@@ -0,0 +1,162 @@
+#include <userver/storages/mongo/bulk_writer.hpp>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+BulkWriter::BulkWriter(Collection collection, Settings settings)
+    : collection_(std::move(collection)),
+      settings_(std::move(settings)),
+      bulk_(MakeBulk()) {
+  UINVARIANT(settings_.max_operations > 0, "max_operations must be positive");
+  UINVARIANT(settings_.max_in_flight > 0, "max_in_flight must be positive");
+  ResetTotals();
+
+  flush_timer_.Start("mongo-bulk-writer",
+                     USERVER_NAMESPACE::utils::PeriodicTask::Settings{
+                         settings_.max_delay},
+                     [this] {
+                       std::unique_lock lock(mutex_);
+                       if (bulk_operations_ > 0) StartBulk(lock);
+                     });
+}
+
+BulkWriter::~BulkWriter() {
+  flush_timer_.Stop();
+  try {
+    Flush();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to execute a mongo bulk: " << ex;
+  }
+}
+
+WriteResult BulkWriter::Flush() {
+  std::unique_lock lock(mutex_);
+  if (bulk_operations_ > 0) StartBulk(lock);
+  while (!in_flight_.empty()) WaitForOldest(lock);
+
+  // the same fields as in the bulk execution reply
+  formats::bson::ValueBuilder builder(formats::common::Type::kObject);
+  builder["nInserted"] = inserted_;
+  builder["nMatched"] = matched_;
+  builder["nModified"] = modified_;
+  builder["nUpserted"] = upserted_;
+  builder["nRemoved"] = deleted_;
+  builder["upserted"] = std::move(upserted_ids_);
+  builder["writeErrors"] = std::move(write_errors_);
+  builder["writeConcernErrors"] = std::move(write_concern_errors_);
+  WriteResult result(builder.ExtractValue());
+
+  auto error = std::exchange(error_, {});
+  ResetTotals();
+  if (error) std::rethrow_exception(error);
+  return result;
+}
+
+std::size_t BulkWriter::GetSize(const formats::bson::Document& document) {
+  return document.GetBson()->len;
+}
+
+operations::Bulk BulkWriter::MakeBulk() const {
+  operations::Bulk bulk(settings_.mode);
+  if (settings_.write_concern) bulk.SetOption(*settings_.write_concern);
+  if (settings_.suppress_server_exceptions) {
+    bulk.SetOption(options::SuppressServerExceptions{});
+  }
+  return bulk;
+}
+
+void BulkWriter::OnOperationAdded(std::unique_lock<engine::Mutex>& lock,
+                                  std::size_t bytes) {
+  UASSERT(lock.owns_lock());
+  ++bulk_operations_;
+  ++total_operations_;
+  bulk_bytes_ += bytes;
+  if (bulk_operations_ >= settings_.max_operations ||
+      bulk_bytes_ >= settings_.max_bytes) {
+    StartBulk(lock);
+  }
+}
+
+void BulkWriter::StartBulk(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  UASSERT(bulk_operations_ > 0);
+  if (in_flight_.size() >= settings_.max_in_flight) WaitForOldest(lock);
+
+  const auto first_index = total_operations_ - bulk_operations_;
+  auto bulk = std::exchange(bulk_, MakeBulk());
+  bulk_operations_ = 0;
+  bulk_bytes_ = 0;
+
+  // critical, as the operations are already accepted
+  in_flight_.push_back(
+      {first_index,
+       USERVER_NAMESPACE::utils::CriticalAsync(
+           "mongo-bulk-writer-execute",
+           [this, bulk = std::move(bulk)]() mutable {
+             return collection_.Execute(std::move(bulk));
+           })});
+}
+
+void BulkWriter::WaitForOldest(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  UASSERT(!in_flight_.empty());
+  auto bulk = std::move(in_flight_.front());
+  in_flight_.pop_front();
+
+  try {
+    Merge(bulk.first_index, bulk.task.Get());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Mongo bulk execution failed: " << ex;
+    if (!error_) error_ = std::current_exception();
+  }
+}
+
+void BulkWriter::Merge(std::size_t first_index, const WriteResult& result) {
+  inserted_ += result.InsertedCount();
+  matched_ += result.MatchedCount();
+  modified_ += result.ModifiedCount();
+  upserted_ += result.UpsertedCount();
+  deleted_ += result.DeletedCount();
+
+  for (const auto& [index, id] : result.UpsertedIds()) {
+    formats::bson::ValueBuilder item(formats::common::Type::kObject);
+    item["index"] = first_index + index;
+    item["_id"] = id;
+    upserted_ids_.PushBack(std::move(item));
+  }
+  for (const auto& [index, error] : result.ServerErrors()) {
+    formats::bson::ValueBuilder item(formats::common::Type::kObject);
+    item["index"] = first_index + index;
+    item["code"] = error.Code();
+    item["errmsg"] = error.Message();
+    write_errors_.PushBack(std::move(item));
+  }
+  for (const auto& error : result.WriteConcernErrors()) {
+    formats::bson::ValueBuilder item(formats::common::Type::kObject);
+    item["code"] = error.Code();
+    item["errmsg"] = error.Message();
+    write_concern_errors_.PushBack(std::move(item));
+  }
+}
+
+void BulkWriter::ResetTotals() {
+  total_operations_ = 0;
+  inserted_ = 0;
+  matched_ = 0;
+  modified_ = 0;
+  upserted_ = 0;
+  deleted_ = 0;
+  upserted_ids_ = formats::bson::ValueBuilder(formats::common::Type::kArray);
+  write_errors_ = formats::bson::ValueBuilder(formats::common::Type::kArray);
+  write_concern_errors_ =
+      formats::bson::ValueBuilder(formats::common::Type::kArray);
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,108 @@
+#include <userver/utest/utest.hpp>
+
+#include <storages/mongo/util_mongotest.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/storages/mongo.hpp>
+#include <userver/storages/mongo/bulk_writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+namespace {
+class BulkWriter : public MongoPoolFixture {};
+}  // namespace
+
+UTEST_F(BulkWriter, FlushesBySize) {
+  auto coll = GetDefaultPool().GetCollection("bulk_writer_size");
+
+  mongo::BulkWriter::Settings settings;
+  settings.max_operations = 10;
+  settings.max_delay = std::chrono::hours{1};
+  settings.max_in_flight = 2;
+  mongo::BulkWriter writer{coll, settings};
+
+  for (int i = 0; i < 95; ++i) writer.InsertOne(bson::MakeDoc("_id", i));
+  // all the full bulks are executed in background
+  for (int i = 0; i < 100 && coll.Count({}) < 90; ++i) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_EQ(90, coll.Count({}));
+
+  const auto result = writer.Flush();
+  EXPECT_EQ(95, result.InsertedCount());
+  EXPECT_TRUE(result.ServerErrors().empty());
+  EXPECT_EQ(95, coll.Count({}));
+}
+
+UTEST_F(BulkWriter, FlushesByTime) {
+  auto coll = GetDefaultPool().GetCollection("bulk_writer_time");
+
+  mongo::BulkWriter::Settings settings;
+  settings.max_delay = std::chrono::milliseconds{10};
+  mongo::BulkWriter writer{coll, settings};
+
+  writer.InsertOne(bson::MakeDoc("_id", 1));
+  for (int i = 0; i < 100 && coll.Count({}) == 0; ++i) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_EQ(1, coll.Count({}));
+}
+
+UTEST_F(BulkWriter, AggregatesResults) {
+  auto coll = GetDefaultPool().GetCollection("bulk_writer_result");
+  coll.InsertOne(bson::MakeDoc("_id", 1, "x", 0));
+
+  mongo::BulkWriter::Settings settings;
+  settings.max_operations = 2;
+  settings.max_in_flight = 1;
+  settings.suppress_server_exceptions = true;
+  mongo::BulkWriter writer{coll, settings};
+
+  writer.InsertOne(bson::MakeDoc("_id", 2));
+  writer.InsertOne(bson::MakeDoc("_id", 1));
+  writer.UpdateOne(bson::MakeDoc("_id", 1),
+                   bson::MakeDoc("$set", bson::MakeDoc("x", 1)));
+  writer.UpdateOne(bson::MakeDoc("_id", 3),
+                   bson::MakeDoc("$set", bson::MakeDoc("x", 1)),
+                   mongo::options::Upsert{});
+  writer.DeleteOne(bson::MakeDoc("_id", 2));
+
+  const auto result = writer.Flush();
+  EXPECT_EQ(1, result.InsertedCount());
+  EXPECT_EQ(1, result.MatchedCount());
+  EXPECT_EQ(1, result.ModifiedCount());
+  EXPECT_EQ(1, result.UpsertedCount());
+  EXPECT_EQ(1, result.DeletedCount());
+
+  auto upserted_ids = result.UpsertedIds();
+  ASSERT_EQ(1, upserted_ids.size());
+  EXPECT_EQ(3, upserted_ids[3].As<int>());
+
+  auto errors = result.ServerErrors();
+  ASSERT_EQ(1, errors.size());
+  EXPECT_EQ(11000, errors[1].Code());
+
+  // the totals are reset on flush
+  EXPECT_EQ(0, writer.Flush().InsertedCount());
+}
+
+UTEST_F(BulkWriter, RethrowsErrors) {
+  auto coll = GetDefaultPool().GetCollection("bulk_writer_errors");
+
+  mongo::BulkWriter::Settings settings;
+  settings.max_operations = 1;
+  mongo::BulkWriter writer{coll, settings};
+
+  writer.InsertOne(bson::MakeDoc("_id", 1));
+  writer.InsertOne(bson::MakeDoc("_id", 1));
+  writer.InsertOne(bson::MakeDoc("_id", 2));
+  UEXPECT_THROW(writer.Flush(), mongo::DuplicateKeyException);
+  EXPECT_EQ(2, coll.Count({}));
+
+  EXPECT_EQ(0, writer.Flush().InsertedCount());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#include <storages/mongo/cdriver/adaptive_idle_limit.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+AdaptiveIdleLimit::AdaptiveIdleLimit(size_t idle_limit, size_t max_size,
+                                     size_t step)
+    : idle_limit_(idle_limit),
+      max_size_(max_size),
+      step_(step),
+      limit_(idle_limit) {}
+
+void AdaptiveIdleLimit::Update(std::chrono::microseconds max_connect_wait,
+                               size_t pool_size) {
+  if (max_connect_wait > kConnectWaitThreshold) {
+    // keep at least the connections the pool has now
+    limit_ = std::min(max_size_, std::max(limit_ + step_, pool_size));
+  } else if (limit_ > idle_limit_) {
+    --limit_;
+  }
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
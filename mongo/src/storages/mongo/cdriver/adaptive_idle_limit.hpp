@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+/// The number of idle connections the pool keeps. It grows while the requests
+/// have to wait for new connections and slowly falls back to the configured
+/// limit otherwise.
+class AdaptiveIdleLimit final {
+ public:
+  /// Waits for new connections longer than this raise the limit
+  static constexpr std::chrono::microseconds kConnectWaitThreshold{
+      std::chrono::milliseconds{10}};
+
+  /// @param idle_limit the configured limit, the lowest one
+  /// @param max_size the pool size, the highest limit
+  /// @param step how much the limit grows after a long wait
+  AdaptiveIdleLimit(size_t idle_limit, size_t max_size, size_t step);
+
+  /// Updates the limit on maintenance
+  /// @param max_connect_wait the longest wait for a new connection since the
+  /// previous update
+  /// @param pool_size the current number of connections
+  void Update(std::chrono::microseconds max_connect_wait, size_t pool_size);
+
+  size_t Get() const { return limit_; }
+
+ private:
+  const size_t idle_limit_;
+  const size_t max_size_;
+  const size_t step_;
+  size_t limit_;
+};
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
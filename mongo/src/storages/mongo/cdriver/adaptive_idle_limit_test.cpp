@@ -0,0 +1,68 @@
+#include <storages/mongo/cdriver/adaptive_idle_limit.hpp>
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::mongo::impl::cdriver::AdaptiveIdleLimit;
+
+constexpr auto kLongWait =
+    AdaptiveIdleLimit::kConnectWaitThreshold + std::chrono::microseconds{1};
+constexpr std::chrono::microseconds kShortWait{100};
+
+}  // namespace
+
+TEST(MongoAdaptiveIdleLimit, IdleByDefault) {
+  AdaptiveIdleLimit limit(4, 16, 2);
+  EXPECT_EQ(limit.Get(), 4);
+
+  limit.Update(kShortWait, 10);
+  EXPECT_EQ(limit.Get(), 4);
+
+  limit.Update(AdaptiveIdleLimit::kConnectWaitThreshold, 10);
+  EXPECT_EQ(limit.Get(), 4);
+}
+
+TEST(MongoAdaptiveIdleLimit, GrowsUnderLoad) {
+  AdaptiveIdleLimit limit(4, 16, 2);
+
+  // the connections the pool has are kept
+  limit.Update(kLongWait, 10);
+  EXPECT_EQ(limit.Get(), 10);
+
+  // then the limit grows by a step per long wait
+  limit.Update(kLongWait, 10);
+  EXPECT_EQ(limit.Get(), 12);
+  limit.Update(kLongWait, 12);
+  EXPECT_EQ(limit.Get(), 14);
+
+  // up to the pool size
+  for (int i = 0; i < 10; ++i) limit.Update(kLongWait, 16);
+  EXPECT_EQ(limit.Get(), 16);
+}
+
+TEST(MongoAdaptiveIdleLimit, ShrinksWithoutLoad) {
+  AdaptiveIdleLimit limit(4, 16, 2);
+  limit.Update(kLongWait, 8);
+  ASSERT_EQ(limit.Get(), 8);
+
+  // slowly, one connection per update
+  for (int expected = 7; expected >= 4; --expected) {
+    limit.Update(kShortWait, 8);
+    EXPECT_EQ(limit.Get(), expected);
+  }
+
+  // down to the configured limit
+  limit.Update(kShortWait, 4);
+  EXPECT_EQ(limit.Get(), 4);
+
+  // and grows back under load
+  limit.Update(kLongWait, 4);
+  EXPECT_EQ(limit.Get(), 6);
+}
+
+USERVER_NAMESPACE_END
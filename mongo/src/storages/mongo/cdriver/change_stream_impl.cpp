@@ -0,0 +1,46 @@
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
+
+#include <bson/bson.h>
+#include <mongoc/mongoc.h>
+
+#include <userver/storages/mongo/mongo_error.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+CDriverChangeStreamImpl::CDriverChangeStreamImpl(
+    cdriver::CDriverPoolImpl::BoundClientPtr client,
+    cdriver::ChangeStreamPtr change_stream)
+    : client_(std::move(client)), change_stream_(std::move(change_stream)) {
+  UASSERT(client_ && change_stream_);
+}
+
+std::optional<formats::bson::Document> CDriverChangeStreamImpl::Next() {
+  const bson_t* event_bson = nullptr;
+  if (mongoc_change_stream_next(change_stream_.get(), &event_bson)) {
+    return formats::bson::impl::MutableBson::CopyNative(event_bson).Extract();
+  }
+
+  MongoError error;
+  if (mongoc_change_stream_error_document(change_stream_.get(),
+                                          error.GetNative(), nullptr)) {
+    error.Throw("Error reading the change stream");
+  }
+  return std::nullopt;
+}
+
+std::optional<formats::bson::Document> CDriverChangeStreamImpl::GetResumeToken()
+    const {
+  const bson_t* token_bson =
+      mongoc_change_stream_get_resume_token(change_stream_.get());
+  if (!token_bson) return std::nullopt;
+  return formats::bson::impl::MutableBson::CopyNative(token_bson).Extract();
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+#include <storages/mongo/cdriver/pool_impl.hpp>
+#include <storages/mongo/cdriver/wrappers.hpp>
+#include <storages/mongo/change_stream_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+class CDriverChangeStreamImpl final : public ChangeStreamImpl {
+ public:
+  CDriverChangeStreamImpl(cdriver::CDriverPoolImpl::BoundClientPtr,
+                          cdriver::ChangeStreamPtr);
+
+  std::optional<formats::bson::Document> Next() override;
+  std::optional<formats::bson::Document> GetResumeToken() const override;
+
+ private:
+  cdriver::CDriverPoolImpl::BoundClientPtr client_;
+  cdriver::ChangeStreamPtr change_stream_;
+};
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
@@ -12,11 +12,13 @@
 #include <userver/utils/text.hpp>
 
 #include <formats/bson/wrappers.hpp>
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 #include <storages/mongo/cdriver/pool_impl.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <storages/mongo/operations_common.hpp>
 #include <storages/mongo/operations_impl.hpp>
+#include <storages/mongo/watch_arguments.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -220,13 +222,20 @@ WriteResult CDriverCollectionImpl::Execute(
 WriteResult CDriverCollectionImpl::Execute(
     const operations::InsertMany& insert_op) {
   auto span = MakeSpan("mongo_insert_many");
-  if (insert_op.impl_->documents.empty()) return {};
+  const auto& sequence = insert_op.impl_->sequence;
+  if (insert_op.impl_->documents.empty() && sequence.IsEmpty()) return {};
 
   std::vector<const bson_t*> bsons;
-  bsons.reserve(insert_op.impl_->documents.size());
+  bsons.reserve(insert_op.impl_->documents.size() + sequence.Size());
   for (const auto& doc : insert_op.impl_->documents) {
     bsons.push_back(doc.GetBson().get());
   }
+  // the views point into the buffer of the sequence
+  std::vector<bson_t> sequence_bsons(sequence.Size());
+  for (std::size_t i = 0; i < sequence_bsons.size(); ++i) {
+    impl::InitStaticBson(sequence_bsons[i], sequence, i);
+    bsons.push_back(&sequence_bsons[i]);
+  }
 
   auto [client, collection] = GetCDriverCollection();
   auto stats_ptr = statistics_->write[insert_op.impl_->write_concern_desc];
@@ -516,6 +525,32 @@ void CDriverCollectionImpl::Execute(const operations::Drop& drop_op) {
   }
 }
 
+ChangeStream CDriverCollectionImpl::Execute(
+    const operations::Watch& watch_op) const {
+  auto span = MakeSpan("mongo_watch");
+  auto [client, collection] = GetCDriverCollection();
+  auto stats_ptr = statistics_->read[operations::kDefaultReadPrefDesc];
+
+  const operations::WatchArguments arguments(watch_op);
+
+  stats::OperationStopwatch watch_sw(stats_ptr,
+                                     stats::ReadOperationStatistics::kWatch);
+
+  cdriver::ChangeStreamPtr change_stream(mongoc_collection_watch(
+      collection.get(), arguments.pipeline.GetBson().get(),
+      arguments.options.GetBson().get()));
+
+  MongoError error;
+  if (mongoc_change_stream_error_document(change_stream.get(),
+                                          error.GetNative(), nullptr)) {
+    watch_sw.AccountError(error.GetKind());
+    error.Throw("Error starting change stream");
+  }
+  watch_sw.AccountSuccess();
+  return ChangeStream(std::make_unique<impl::cdriver::CDriverChangeStreamImpl>(
+      std::move(client), std::move(change_stream)));
+}
+
 cdriver::CDriverPoolImpl::BoundClientPtr
 CDriverCollectionImpl::GetCDriverClient() const {
   // uasserted in ctor
@@ -1,12 +1,14 @@
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 
 #include <stdexcept>
+#include <utility>
 
 #include <bson/bson.h>
 #include <mongoc/mongoc.h>
 
 #include <userver/storages/mongo/mongo_error.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 
 #include <formats/bson/wrappers.hpp>
 
@@ -25,34 +27,72 @@ int mongoc_cursor_get_batch_num(const T*...) noexcept {
 
 namespace storages::mongo::impl::cdriver {
 
+namespace {
+
+// limits the memory usage when batch boundaries are not reported by mongoc
+constexpr std::size_t kMaxChunkSize = 1000;
+
+}  // namespace
+
 CDriverCursorImpl::CDriverCursorImpl(
     cdriver::CDriverPoolImpl::BoundClientPtr client, cdriver::CursorPtr cursor,
     std::shared_ptr<stats::ReadOperationStatistics> stats_ptr)
     : client_(std::move(client)),
       cursor_(std::move(cursor)),
       stats_ptr_(std::move(stats_ptr)) {
-  Next();  // prime the cursor
+  FetchChunk();  // prime the cursor
 }
 
-bool CDriverCursorImpl::IsValid() const { return cursor_ || current_; }
+bool CDriverCursorImpl::IsValid() const {
+  // the cursor is only touched when there is no prefetch running
+  return current_idx_ < documents_.size() || pending_error_ || cursor_;
+}
 
 bool CDriverCursorImpl::HasMore() const {
+  if (prefetch_task_.IsValid()) return true;
   return cursor_ && mongoc_cursor_more(cursor_.get());
 }
 
 const formats::bson::Document& CDriverCursorImpl::Current() const {
   if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
-  return *current_;
+  UASSERT(current_idx_ < documents_.size());
+  return documents_[current_idx_];
 }
 
 void CDriverCursorImpl::Next() {
   if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
 
-  current_ = std::nullopt;
-  if (!HasMore()) {
-    UASSERT(!cursor_ && !client_);
+  if (current_idx_ < documents_.size() && ++current_idx_ < documents_.size()) {
     return;
   }
+  if (pending_error_) {
+    std::rethrow_exception(std::exchange(pending_error_, {}));
+  }
+  FetchChunk();
+}
+
+void CDriverCursorImpl::FetchChunk() {
+  auto chunk = prefetch_task_.IsValid() ? prefetch_task_.Get() : ReadChunk();
+  documents_ = std::move(chunk.documents);
+  current_idx_ = 0;
+  pending_error_ = std::move(chunk.error);
+  if (documents_.empty() && pending_error_) {
+    std::rethrow_exception(std::exchange(pending_error_, {}));
+  }
+
+  if (cursor_ && !pending_error_) {
+    prefetch_task_ =
+        utils::Async("mongo_cursor_prefetch", [this] { return ReadChunk(); });
+  }
+}
+
+CDriverCursorImpl::Chunk CDriverCursorImpl::ReadChunk() {
+  Chunk chunk;
+  if (!cursor_ || !mongoc_cursor_more(cursor_.get())) {
+    cursor_.reset();
+    client_.reset();
+    return chunk;
+  }
 
   UASSERT(client_ && cursor_);
   const auto batch_num_before = mongoc_cursor_get_batch_num(cursor_.get());
@@ -63,11 +103,16 @@ void CDriverCursorImpl::Next() {
 
   const bson_t* current_bson = nullptr;
   MongoError error;
-  while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) && HasMore()) {
+  while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) &&
+         mongoc_cursor_more(cursor_.get())) {
     if (mongoc_cursor_next(cursor_.get(), &current_bson)) {
-      current_ = formats::bson::Document(
+      chunk.documents.emplace_back(
           formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
-      break;
+      // stop at the first document of a new batch to not wait for the next
+      if (batch_num_before != mongoc_cursor_get_batch_num(cursor_.get()) ||
+          chunk.documents.size() >= kMaxChunkSize) {
+        break;
+      }
     }
   }
   if (batch_num_before == mongoc_cursor_get_batch_num(cursor_.get())) {
@@ -77,13 +122,18 @@ void CDriverCursorImpl::Next() {
   } else {
     cursor_next_sw.AccountError(error.GetKind());
   }
-  if (!HasMore()) {
+  if (error || !mongoc_cursor_more(cursor_.get())) {
     cursor_.reset();
     client_.reset();
   }
   if (error) {
-    error.Throw("Error iterating over query results");
+    try {
+      error.Throw("Error iterating over query results");
+    } catch (const std::exception&) {
+      chunk.error = std::current_exception();
+    }
   }
+  return chunk;
 }
 
 }  // namespace storages::mongo::impl::cdriver
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <exception>
 #include <memory>
-#include <optional>
+#include <vector>
 
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson/document.hpp>
 
 #include <storages/mongo/cdriver/pool_impl.hpp>
@@ -15,6 +18,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::mongo::impl::cdriver {
 
+/// Reads the results in chunks, fetching the next chunk in background while
+/// the current one is being iterated over, so that the getMore round trips
+/// overlap with the processing of the documents.
+///
+/// A chunk is the rest of the current server batch plus the first document
+/// of the next one (or at most kMaxChunkSize documents), thus at most two
+/// chunks are held in memory at a time.
 class CDriverCursorImpl final : public CursorImpl {
  public:
   CDriverCursorImpl(cdriver::CDriverPoolImpl::BoundClientPtr,
@@ -28,10 +38,23 @@ class CDriverCursorImpl final : public CursorImpl {
   void Next() override;
 
  private:
-  std::optional<formats::bson::Document> current_;
+  struct Chunk {
+    std::vector<formats::bson::Document> documents;
+    std::exception_ptr error;
+  };
+
+  Chunk ReadChunk();
+  void FetchChunk();
+
+  std::vector<formats::bson::Document> documents_;
+  std::size_t current_idx_{0};
+  std::exception_ptr pending_error_;
   cdriver::CDriverPoolImpl::BoundClientPtr client_;
   cdriver::CursorPtr cursor_;
   std::shared_ptr<stats::ReadOperationStatistics> stats_ptr_;
+
+  // must be the last member, as it uses the cursor
+  engine::TaskWithResult<Chunk> prefetch_task_;
 };
 
 }  // namespace storages::mongo::impl::cdriver
@@ -1,13 +1,17 @@
 #include <storages/mongo/cdriver/pool_impl.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <bson/bson.h>
 
 #include <userver/clients/dns/resolver.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 #include <storages/mongo/cdriver/async_stream.hpp>
@@ -126,14 +130,18 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
       app_name_(config.app_name),
       init_data_{dns_resolver, {}},
       max_size_(config.max_size),
-      idle_limit_(config.idle_limit),
       queue_timeout_(config.queue_timeout),
+      lifo_acquire_(config.lifo_acquire),
+      max_idle_time_(config.max_idle_time),
       size_(0),
+      adaptive_idle_limit_(config.idle_limit, config.max_size,
+                           config.connecting_limit),
       in_use_semaphore_(config.max_size),
       connecting_semaphore_(config.connecting_limit),
       // FP?: pointer magic in boost.lockfree
       // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-      queue_(config.max_size) {
+      queue_(config.max_size),
+      stack_(config.max_size) {
   static const GlobalInitializer kInitMongoc;
   GlobalInitializer::LogInitWarningsOnce();
   CheckAsyncStreamCompatible();
@@ -148,16 +156,7 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
 
   init_data_.ssl_opt = MakeSslOpt(uri_.get());
 
-  try {
-    LOG_INFO() << "Creating " << config.initial_size << " mongo connections";
-    for (size_t i = 0; i < config.initial_size; ++i) {
-      engine::SemaphoreLock lock(in_use_semaphore_);
-      Push(Create());
-      lock.Release();
-    }
-  } catch (const std::exception& ex) {
-    LOG_ERROR() << "Mongo pool was not fully prepopulated: " << ex;
-  }
+  Warmup(config.initial_size);
 
   maintenance_task_.Start(kMaintenanceTaskName,
                           {config.maintenance_period,
@@ -172,6 +171,8 @@ CDriverPoolImpl::~CDriverPoolImpl() {
   const ClientDeleter deleter;
   mongoc_client_t* client = nullptr;
   while (queue_.pop(client)) deleter(client);
+  IdleClient idle{};
+  while (stack_.pop(idle)) deleter(idle.client);
 }
 
 size_t CDriverPoolImpl::InUseApprox() const {
@@ -192,6 +193,7 @@ CDriverPoolImpl::BoundClientPtr CDriverPoolImpl::Acquire() {
 }
 
 mongoc_client_t* CDriverPoolImpl::Pop() {
+  const auto start = std::chrono::steady_clock::now();
   stats::ConnectionThrottleStopwatch queue_sw(GetStatistics().pool);
   const auto queue_deadline = engine::Deadline::FromDuration(queue_timeout_);
 
@@ -219,6 +221,14 @@ mongoc_client_t* CDriverPoolImpl::Pop() {
       }
       client = Create();
     }
+
+    const auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    auto max_wait_us = max_connect_wait_us_.load();
+    while (max_wait_us < wait_us &&
+           !max_connect_wait_us_.compare_exchange_weak(max_wait_us, wait_us)) {
+    }
   }
 
   UASSERT(client);
@@ -228,7 +238,11 @@ mongoc_client_t* CDriverPoolImpl::Pop() {
 
 void CDriverPoolImpl::Push(mongoc_client_t* client) noexcept {
   UASSERT(client);
-  if (!queue_.bounded_push(client)) Drop(client);
+  const bool pushed =
+      lifo_acquire_
+          ? stack_.bounded_push({client, std::chrono::steady_clock::now()})
+          : queue_.bounded_push(client);
+  if (!pushed) Drop(client);
   in_use_semaphore_.unlock_shared();
 }
 
@@ -241,6 +255,11 @@ void CDriverPoolImpl::Drop(mongoc_client_t* client) noexcept {
 }
 
 mongoc_client_t* CDriverPoolImpl::TryGetIdle() {
+  if (lifo_acquire_) {
+    IdleClient idle{};
+    if (stack_.pop(idle)) return idle.client;
+    return nullptr;
+  }
   mongoc_client_t* client = nullptr;
   if (queue_.pop(client)) return client;
   return nullptr;
@@ -282,16 +301,89 @@ mongoc_client_t* CDriverPoolImpl::Create() {
   return client.release();
 }
 
+void CDriverPoolImpl::Warmup(size_t count) {
+  LOG_INFO() << "Creating " << count << " mongo connections";
+
+  // connections are established concurrently, as a handshake may take a
+  // noticeable time
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    tasks.push_back(utils::Async("mongo_pool_warmup", [this] {
+      engine::SemaphoreLock connecting_lock(connecting_semaphore_);
+      engine::SemaphoreLock lock(in_use_semaphore_);
+      Push(Create());
+      lock.Release();
+    }));
+  }
+
+  size_t failed = 0;
+  for (auto& task : tasks) {
+    try {
+      task.Get();
+    } catch (const std::exception& ex) {
+      if (!failed++) {
+        LOG_ERROR() << "Mongo pool was not fully prepopulated: " << ex;
+      }
+    }
+  }
+  if (failed) {
+    LOG_ERROR() << "Failed to create " << failed << " of " << count
+                << " mongo connections in pool '" << Id() << '\'';
+  }
+}
+
 void CDriverPoolImpl::DoMaintenance() {
   LOG_DEBUG() << "Starting mongo pool '" << Id() << "' maintenance";
-  for (auto idle_drop_left = kIdleConnectionDropRate;
-       idle_drop_left && size_.load() > idle_limit_; --idle_drop_left) {
-    LOG_TRACE() << "Trying to drop idle connection";
-    Drop(TryGetIdle());
+
+  // keep the connections while the requests have to wait for new ones,
+  // slowly fall back to idle_limit otherwise
+  const std::chrono::microseconds max_connect_wait{
+      max_connect_wait_us_.exchange(0)};
+  adaptive_idle_limit_.Update(max_connect_wait, size_.load());
+  LOG_DEBUG() << "Mongo pool '" << Id() << "' idle limit is "
+              << adaptive_idle_limit_.Get()
+              << " after the longest connection wait of "
+              << max_connect_wait.count() << "us";
+
+  if (lifo_acquire_) {
+    DropColdTail();
+  } else {
+    for (auto idle_drop_left = kIdleConnectionDropRate;
+         idle_drop_left && size_.load() > adaptive_idle_limit_.Get();
+         --idle_drop_left) {
+      LOG_TRACE() << "Trying to drop idle connection";
+      Drop(TryGetIdle());
+    }
   }
   LOG_DEBUG() << "Finished mongo pool '" << Id() << "' maintenance";
 }
 
+void CDriverPoolImpl::DropColdTail() {
+  // The stack holds the idle connections from the most to the least recently
+  // used one, so all of them are taken to get to the cold tail. The rest are
+  // pushed back starting from the coldest one to keep the order.
+  std::vector<IdleClient> idle;
+  idle.reserve(max_size_);
+  IdleClient client{};
+  while (stack_.pop(client)) idle.push_back(client);
+
+  const auto now = std::chrono::steady_clock::now();
+  auto idle_drop_left = kIdleConnectionDropRate;
+  for (auto it = idle.rbegin(); it != idle.rend(); ++it) {
+    const bool expired = max_idle_time_.count() > 0 &&
+                         now - it->released_at >= max_idle_time_;
+    if (expired ||
+        (idle_drop_left && size_.load() > adaptive_idle_limit_.Get())) {
+      if (!expired) --idle_drop_left;
+      LOG_TRACE() << "Dropping cold idle connection";
+      Drop(it->client);
+    } else if (!stack_.bounded_push(*it)) {
+      Drop(it->client);
+    }
+  }
+}
+
 }  // namespace storages::mongo::impl::cdriver
 
 USERVER_NAMESPACE_END
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 
 #include <mongoc/mongoc.h>
 #include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
 
+#include <storages/mongo/cdriver/adaptive_idle_limit.hpp>
 #include <storages/mongo/cdriver/async_stream.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <storages/mongo/dynamic_config.hpp>
@@ -51,6 +55,11 @@ class CDriverPoolImpl final : public PoolImpl {
   BoundClientPtr Acquire();
 
  private:
+  struct IdleClient {
+    mongoc_client_t* client;
+    std::chrono::steady_clock::time_point released_at;
+  };
+
   mongoc_client_t* Pop();
   void Push(mongoc_client_t*) noexcept;
   void Drop(mongoc_client_t*) noexcept;
@@ -58,7 +67,9 @@ class CDriverPoolImpl final : public PoolImpl {
   mongoc_client_t* TryGetIdle();
   mongoc_client_t* Create();
 
+  void Warmup(size_t count);
   void DoMaintenance();
+  void DropColdTail();
 
   const std::string app_name_;
   std::string default_database_;
@@ -66,12 +77,19 @@ class CDriverPoolImpl final : public PoolImpl {
   AsyncStreamInitiatorData init_data_;
 
   const size_t max_size_;
-  const size_t idle_limit_;
   const std::chrono::milliseconds queue_timeout_;
+  const bool lifo_acquire_;
+  const std::chrono::milliseconds max_idle_time_;
   std::atomic<size_t> size_;
+  // longest wait for a new connection since the last maintenance
+  std::atomic<std::int64_t> max_connect_wait_us_{0};
+  // only used by the maintenance
+  AdaptiveIdleLimit adaptive_idle_limit_;
   engine::Semaphore in_use_semaphore_;
   engine::Semaphore connecting_semaphore_;
   boost::lockfree::queue<mongoc_client_t*> queue_;
+  // used instead of the queue with lifo_acquire
+  boost::lockfree::stack<IdleClient> stack_;
   utils::PeriodicTask maintenance_task_;
 };
 
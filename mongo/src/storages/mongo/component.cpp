@@ -128,6 +128,14 @@ properties:
         type: string
         description: pool maintenance period (idle connections pruning etc.)
         defaultDescription: 15s
+    lifo_acquire:
+        type: boolean
+        description: reuse the most recently released connection first to keep the working set of connections small
+        defaultDescription: false
+    max_idle_time:
+        type: string
+        description: with lifo_acquire, close the connections idle for longer (0 - keep up to idle_limit)
+        defaultDescription: 0
     stats_verbosity:
         type: string
         description: changes the granularity of reported metrics
@@ -209,6 +217,14 @@ properties:
         type: integer
         description: limit for idle connections number (per database)
         defaultDescription: 64
+    lifo_acquire:
+        type: boolean
+        description: reuse the most recently released connection first to keep the working set of connections small
+        defaultDescription: false
+    max_idle_time:
+        type: string
+        description: with lifo_acquire, close the connections idle for longer (0 - keep up to idle_limit)
+        defaultDescription: 0
     connecting_limit:
         type: integer
         description: limit for establishing connections number (per database)
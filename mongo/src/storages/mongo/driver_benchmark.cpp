@@ -0,0 +1,233 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <storages/mongo/cdriver/pool_impl.hpp>
+#include <storages/mongo/dynamic_config.hpp>
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/storages/mongo.hpp>
+#include <utils/gbench_latency.hpp>
+
+// Benchmarks of the driver against a real database, they are skipped unless
+// the kMongoUri environment variable is set
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+constexpr const char* kMongoUri = "MONGO_URI_BENCH";
+constexpr std::size_t kPoolSize = 4;
+const std::string kCollectionName = "driver_benchmark";
+
+using namespace utils::gbench;
+
+mongo::PoolConfig MakePoolConfig() {
+  mongo::PoolConfig config;
+  config.initial_size = kPoolSize;
+  config.max_size = kPoolSize;
+  return config;
+}
+
+// Runs the payload with a pool of the kMongoUri database, which is dropped
+// afterwards
+void RunWithPool(benchmark::State& state,
+                 std::function<void(mongo::Pool&)> payload) {
+  engine::RunStandalone(kPoolSize, [&] {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const auto* uri = std::getenv(kMongoUri);
+    if (!uri) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+
+    clients::dns::Resolver resolver{engine::current_task::GetTaskProcessor(),
+                                    {}};
+    dynamic_config::StorageMock config_storage{{mongo::kDefaultMaxTime, {}}};
+    mongo::Pool pool{"bench", uri, MakePoolConfig(), &resolver,
+                     config_storage.GetSource()};
+
+    payload(pool);
+    pool.DropDatabase();
+  });
+}
+
+// A document of a typical users collection, about 1KB
+bson::Document MakeUser(std::int64_t id) {
+  return bson::MakeDoc(
+      "_id", id, "name", "user-" + std::to_string(id), "email",
+      "user-" + std::to_string(id) + "@example.com", "created",
+      std::chrono::system_clock::time_point{std::chrono::seconds{id}}, "score",
+      id * 0.5, "active", id % 2 == 0, "tags",
+      bson::MakeArray("alpha", "beta", "gamma", "delta", "epsilon"), "address",
+      bson::MakeDoc("city", "Moscow", "street", "Tverskaya", "zip", "125009"),
+      "payload", std::string(768, 'a'));
+}
+
+struct User {
+  std::int64_t id;
+  std::string name;
+  std::string email;
+  std::chrono::system_clock::time_point created;
+  double score;
+  bool active;
+  std::vector<std::string> tags;
+  std::string city;
+  std::string payload;
+};
+
+User ParseUser(const bson::Document& doc) {
+  return {doc["_id"].As<std::int64_t>(),
+          doc["name"].As<std::string>(),
+          doc["email"].As<std::string>(),
+          doc["created"].As<std::chrono::system_clock::time_point>(),
+          doc["score"].As<double>(),
+          doc["active"].As<bool>(),
+          doc["tags"].As<std::vector<std::string>>(),
+          doc["address"]["city"].As<std::string>(),
+          doc["payload"].As<std::string>()};
+}
+
+void InsertUsers(mongo::Collection& collection, std::int64_t count) {
+  std::vector<bson::Document> users;
+  users.reserve(count);
+  for (std::int64_t i = 0; i < count; ++i) users.push_back(MakeUser(i));
+  collection.InsertMany(std::move(users));
+}
+
+}  // namespace
+
+// Lookups of a single document by _id
+void mongo_find_one_latency(benchmark::State& state) {
+  RunWithPool(state, [&state](mongo::Pool& pool) {
+    auto collection = pool.GetCollection(kCollectionName);
+    InsertUsers(collection, 1);
+
+    LatencyPercentile latency;
+    const auto filter = bson::MakeDoc("_id", 0);
+    for (auto _ : state) {
+      const auto start = std::chrono::steady_clock::now();
+      auto user = collection.FindOne(filter);
+      benchmark::DoNotOptimize(user);
+      Account(latency, start);
+    }
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(mongo_find_one_latency)->UseRealTime();
+
+// state.range(0) documents inserted one by one or in a single bulk if
+// state.range(1) is set
+void mongo_insert_throughput(benchmark::State& state) {
+  const auto count = state.range(0);
+  const bool is_bulk = state.range(1);
+
+  RunWithPool(state, [&](mongo::Pool& pool) {
+    auto collection = pool.GetCollection(kCollectionName);
+    std::int64_t next_id = 0;
+    for (auto _ : state) {
+      if (is_bulk) {
+        auto bulk = collection.MakeUnorderedBulk();
+        for (std::int64_t i = 0; i < count; ++i) {
+          bulk.InsertOne(MakeUser(next_id++));
+        }
+        collection.Execute(std::move(bulk));
+      } else {
+        for (std::int64_t i = 0; i < count; ++i) {
+          collection.InsertOne(MakeUser(next_id++));
+        }
+      }
+    }
+    ReportRate(state, "documents",
+               static_cast<double>(state.iterations() * count));
+  });
+}
+BENCHMARK(mongo_insert_throughput)
+    ->ArgsProduct({{1, 16, 256}, {0, 1}})
+    ->ArgNames({"documents", "bulk"})
+    ->UseRealTime();
+
+// Fetching and decoding of state.range(0) documents
+void mongo_find_decode(benchmark::State& state) {
+  const auto count = state.range(0);
+
+  RunWithPool(state, [&](mongo::Pool& pool) {
+    auto collection = pool.GetCollection(kCollectionName);
+    InsertUsers(collection, count);
+
+    for (auto _ : state) {
+      std::vector<User> users;
+      users.reserve(count);
+      for (const auto& doc : collection.Find(bson::Document{})) {
+        users.push_back(ParseUser(doc));
+      }
+      benchmark::DoNotOptimize(users);
+    }
+    ReportRate(state, "documents",
+               static_cast<double>(state.iterations() * count));
+  });
+}
+BENCHMARK(mongo_find_decode)->Range(1, 10'000)->UseRealTime();
+
+// Connection acquisition from a pool of 4 by state.range(0) concurrent tasks
+void mongo_pool_acquire(benchmark::State& state) {
+  constexpr std::size_t kAcquiresPerTask = 16;
+
+  engine::RunStandalone(kPoolSize, [&] {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const auto* uri = std::getenv(kMongoUri);
+    if (!uri) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+
+    clients::dns::Resolver resolver{engine::current_task::GetTaskProcessor(),
+                                    {}};
+    dynamic_config::StorageMock config_storage{{mongo::kDefaultMaxTime, {}}};
+    mongo::impl::cdriver::CDriverPoolImpl pool{
+        "bench", uri, MakePoolConfig(), &resolver, config_storage.GetSource()};
+
+    LatencyPercentile latency;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0));
+    for (auto _ : state) {
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&pool, &latency] {
+          for (std::size_t j = 0; j < kAcquiresPerTask; ++j) {
+            const auto start = std::chrono::steady_clock::now();
+            auto client = pool.Acquire();
+            Account(latency, start);
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+
+    ReportRate(state, "acquisitions",
+               static_cast<double>(state.iterations() * state.range(0) *
+                                   kAcquiresPerTask));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(mongo_pool_acquire)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->ArgNames({"tasks"})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
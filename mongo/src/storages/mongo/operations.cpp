@@ -391,6 +391,9 @@ InsertMany::InsertMany() = default;
 InsertMany::InsertMany(std::vector<formats::bson::Document> documents_)
     : impl_(std::move(documents_)) {}
 
+InsertMany::InsertMany(formats::bson::DocumentSequence documents_)
+    : impl_(std::move(documents_)) {}
+
 InsertMany::~InsertMany() = default;
 
 InsertMany::InsertMany(const InsertMany&) = default;
@@ -732,6 +735,36 @@ void Drop::SetOption(const options::WriteConcern& write_concern) {
   impl_->write_concern_desc = MakeWriteConcernDescription(write_concern);
 }
 
+Watch::Watch(formats::bson::Value pipeline) : impl_(std::move(pipeline)) {
+  if (!impl_->pipeline.IsArray()) {
+    throw InvalidQueryArgumentException(
+        "Change stream pipeline is not an array");
+  }
+}
+
+Watch::~Watch() = default;
+
+Watch::Watch(const Watch&) = default;
+Watch::Watch(Watch&&) noexcept = default;
+Watch& Watch::operator=(const Watch&) = default;
+Watch& Watch::operator=(Watch&&) noexcept = default;
+
+void Watch::SetOption(const options::ResumeAfter& resume_after) {
+  static const std::string kOptionName = "resumeAfter";
+  impl::EnsureBuilder(impl_->options)
+      .Append(kOptionName, resume_after.Value().GetBson().get());
+}
+
+void Watch::SetOption(options::FullDocumentLookup) {
+  static const std::string kOptionName = "fullDocument";
+  impl::EnsureBuilder(impl_->options).Append(kOptionName, "updateLookup");
+}
+
+void Watch::SetOption(const options::MaxAwaitTime& max_await_time) {
+  AppendMaxAwaitTime(impl::EnsureBuilder(impl_->options),
+                     impl_->has_max_await_time_option, max_await_time);
+}
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
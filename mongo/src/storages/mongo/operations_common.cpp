@@ -6,6 +6,7 @@
 #include <mongoc/mongoc.h>
 
 #include <userver/storages/mongo/exception.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <formats/bson/wrappers.hpp>
 
@@ -79,6 +80,22 @@ void AppendUpsert(formats::bson::impl::BsonBuilder& builder) {
   builder.Append(kOptionName, true);
 }
 
+void InitStaticBson(bson_t& native,
+                    const formats::bson::DocumentSequence& documents,
+                    std::size_t index) {
+  const auto data = documents.GetData();
+  const auto& offsets = documents.GetOffsets();
+  UASSERT(index < offsets.size());
+
+  const auto offset = offsets[index];
+  const auto end =
+      index + 1 < offsets.size() ? offsets[index + 1] : data.size();
+  [[maybe_unused]] const bool is_valid = bson_init_static(
+      &native, reinterpret_cast<const uint8_t*>(data.data() + offset),
+      end - offset);
+  UASSERT(is_valid);
+}
+
 }  // namespace storages::mongo::impl
 
 USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <bson/bson.h>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <userver/formats/bson/bson_builder.hpp>
+#include <userver/formats/bson/document_sequence.hpp>
 #include <userver/storages/mongo/options.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +22,12 @@ cdriver::WriteConcernPtr MakeCDriverWriteConcern(const options::WriteConcern&);
 
 void AppendUpsert(formats::bson::impl::BsonBuilder&);
 
+/// Makes a view of a document of the sequence, which is valid until
+/// the sequence is modified
+void InitStaticBson(bson_t& native,
+                    const formats::bson::DocumentSequence& documents,
+                    std::size_t index);
+
 }  // namespace storages::mongo::impl
 
 USERVER_NAMESPACE_END
@@ -27,6 +27,16 @@ void AppendMaxServerTime(formats::bson::impl::BsonBuilder& builder,
   builder.Append(kOptionName, max_server_time.Value().count());
 }
 
+void AppendMaxAwaitTime(formats::bson::impl::BsonBuilder& builder,
+                        bool& has_max_await_time_option,
+                        const options::MaxAwaitTime& max_await_time) {
+  UASSERT(!has_max_await_time_option);
+  has_max_await_time_option = true;
+
+  static const std::string kOptionName = "maxAwaitTimeMS";
+  builder.Append(kOptionName, max_await_time.Value().count());
+}
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
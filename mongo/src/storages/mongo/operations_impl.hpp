@@ -68,7 +68,11 @@ class InsertMany::Impl {
   explicit Impl(std::vector<formats::bson::Document>&& documents_)
       : documents(std::move(documents_)) {}
 
+  explicit Impl(formats::bson::DocumentSequence&& sequence_)
+      : sequence(std::move(sequence_)) {}
+
   std::vector<formats::bson::Document> documents;
+  formats::bson::DocumentSequence sequence;
   std::string write_concern_desc{kDefaultWriteConcernDesc};
   std::optional<formats::bson::impl::BsonBuilder> options;
   bool should_throw{true};
@@ -169,6 +173,16 @@ class Drop::Impl {
   std::string write_concern_desc{kDefaultWriteConcernDesc};
 };
 
+class Watch::Impl {
+ public:
+  explicit Impl(formats::bson::Value pipeline_)
+      : pipeline(std::move(pipeline_)) {}
+
+  formats::bson::Value pipeline;
+  std::optional<formats::bson::impl::BsonBuilder> options;
+  bool has_max_await_time_option{false};
+};
+
 void AppendComment(formats::bson::impl::BsonBuilder& builder,
                    bool& has_comment_option, const options::Comment& comment);
 
@@ -176,6 +190,10 @@ void AppendMaxServerTime(formats::bson::impl::BsonBuilder& builder,
                          bool& has_max_server_time_option,
                          const options::MaxServerTime& max_server_time);
 
+void AppendMaxAwaitTime(formats::bson::impl::BsonBuilder& builder,
+                        bool& has_max_await_time_option,
+                        const options::MaxAwaitTime& max_await_time);
+
 }  // namespace storages::mongo::operations
 
 USERVER_NAMESPACE_END
@@ -162,6 +162,11 @@ Comment::Comment(std::string value) : value_(std::move(value)) {
 
 const std::string& Comment::Value() const { return value_; }
 
+ResumeAfter::ResumeAfter(formats::bson::Document token)
+    : token_(std::move(token)) {}
+
+const formats::bson::Document& ResumeAfter::Value() const { return token_; }
+
 }  // namespace storages::mongo::options
 
 USERVER_NAMESPACE_END
@@ -71,6 +71,9 @@ PoolConfig::PoolConfig(const components::ComponentConfig& component_config)
       maintenance_period(
           component_config["maintenance_period"].As<std::chrono::milliseconds>(
               kDefaultMaintenancePeriod)),
+      lifo_acquire(component_config["lifo_acquire"].As<bool>(false)),
+      max_idle_time(
+          component_config["max_idle_time"].As<std::chrono::milliseconds>(0)),
       app_name(component_config["appname"].As<std::string>(kDefaultAppName)),
       max_replication_lag(component_config["max_replication_lag"]
                               .As<std::optional<std::chrono::seconds>>()),
@@ -98,6 +101,8 @@ PoolConfig::PoolConfig()
       idle_limit(kTestIdleLimit),
       connecting_limit(kTestConnectingLimit),
       maintenance_period(kTestMaintenancePeriod),
+      lifo_acquire(false),
+      max_idle_time(0),
       app_name(kDefaultAppName),
       driver_impl(DriverImpl::kMongoCDriver) {
   if (!IsValidAppName(app_name)) {
@@ -113,6 +118,7 @@ void PoolConfig::Validate(const std::string& pool_id) const {
     CheckDuration(*local_threshold, "local threshold", pool_id);
   }
   CheckDuration(maintenance_period, "pool maintenance period", pool_id);
+  CheckDuration(max_idle_time, "max idle time", pool_id);
 
   if (!max_size) {
     throw InvalidConfigException("invalid max pool size in ")
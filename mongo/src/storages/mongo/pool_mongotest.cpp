@@ -74,6 +74,49 @@ UTEST(NonexistentPool, ConnectionFailure) {
                 mongo::ClusterUnavailableException);
 }
 
+UTEST(NonexistentPool, WarmupFailure) {
+  auto dns_resolver = MakeDnsResolver();
+  auto dynamic_config = MakeDynamicConfig();
+
+  mongo::PoolConfig config{};
+  config.initial_size = 4;
+  config.idle_limit = 4;
+  config.max_size = 8;
+  config.connecting_limit = 2;
+
+  // failed connections are not counted
+  mongo::Pool bad_pool("bad", "mongodb://%2Fnonexistent.sock/bad", config,
+                       &dns_resolver, dynamic_config.GetSource());
+  const auto stats = bad_pool.GetStatistics()["pool"];
+  EXPECT_EQ(stats["current-size"].As<size_t>(), 0);
+  EXPECT_EQ(stats["conn-created"].As<size_t>(), 0);
+}
+
+UTEST_F(Pool, Warmup) {
+  mongo::PoolConfig config{};
+  config.initial_size = 4;
+  config.idle_limit = 4;
+  config.max_size = 8;
+  // fewer than initial_size to make the warmup wait for the connecting slots
+  config.connecting_limit = 2;
+  auto pool = MakePool({}, config);
+
+  // all the initial connections are ready before the first request
+  auto stats = pool.GetStatistics()["pool"];
+  EXPECT_EQ(stats["current-size"].As<size_t>(), 4);
+  EXPECT_EQ(stats["conn-created"].As<size_t>(), 4);
+  EXPECT_EQ(stats["current-in-use"].As<size_t>(), 0);
+  EXPECT_EQ(stats["conn-requests"].As<size_t>(), 0);
+
+  // the requests use the idle connections
+  UEXPECT_NO_THROW(pool.HasCollection("test"));
+  stats = pool.GetStatistics()["pool"];
+  EXPECT_EQ(stats["current-size"].As<size_t>(), 4);
+  EXPECT_EQ(stats["conn-created"].As<size_t>(), 4);
+  EXPECT_GE(stats["conn-requests"].As<size_t>(), 1);
+  EXPECT_TRUE(stats["conn-request-timings-us"].IsObject());
+}
+
 UTEST_F(Pool, Limits) {
   mongo::PoolConfig limited_config{};
   limited_config.initial_size = 1;
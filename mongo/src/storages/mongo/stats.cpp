@@ -101,6 +101,8 @@ std::string ToString(ReadOperationStatistics::OpType type) {
       return "find";
     case Type::kGetMore:
       return "getmore";
+    case Type::kWatch:
+      return "watch";
   }
 
   UINVARIANT(false, "Unexpected type");
@@ -223,8 +225,12 @@ ConnectionWaitStopwatch::ConnectionWaitStopwatch(
 ConnectionWaitStopwatch::~ConnectionWaitStopwatch() {
   try {
     ++stats_ptr_->requested;
+    const auto duration = scope_time_.Reset();
     stats_ptr_->request_timings_agg.GetCurrentCounter().Account(
-        GetMilliseconds(scope_time_.Reset()));
+        GetMilliseconds(duration));
+    stats_ptr_->request_timings_us_agg.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
   } catch (const std::exception&) {
     // ignore
   }
@@ -10,6 +10,7 @@
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/storages/mongo/mongo_error.hpp>
 #include <userver/tracing/scope_time.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/relaxed_counter.hpp>
@@ -23,6 +24,7 @@ using TimingsPercentile =
     utils::statistics::Percentile</*buckets =*/1000, uint32_t,
                                   /*extra_buckets=*/780,
                                   /*extra_bucket_size=*/50>;
+using MicrosecondsHistogram = utils::statistics::HdrHistogram<>;
 
 template <typename T>
 using Aggregator = utils::statistics::RecentPeriod<T, T>;
@@ -66,6 +68,7 @@ struct ReadOperationStatistics {
     kCountApprox,
     kFind,
     kGetMore,
+    kWatch,
   };
 
   rcu::RcuMap<OpType, Aggregator<OperationStatisticsItem>> items;
@@ -122,6 +125,8 @@ struct PoolConnectStatistics {
 
   Aggregator<TimingsPercentile> request_timings_agg;
   Aggregator<TimingsPercentile> queue_wait_timings_agg;
+  // connection acquire latency, with precise sub-millisecond values
+  Aggregator<MicrosecondsHistogram> request_timings_us_agg;
 };
 
 std::string ToString(PoolConnectStatistics::OpType type);
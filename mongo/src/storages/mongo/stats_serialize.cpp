@@ -141,6 +141,8 @@ void Dump(const PoolConnectStatistics& conn_stats,
       conn_stats.request_timings_agg.GetStatsForPeriod());
   builder["queue-wait-timings"] = utils::statistics::PercentileToJson(
       conn_stats.queue_wait_timings_agg.GetStatsForPeriod());
+  builder["conn-request-timings-us"] = utils::statistics::PercentileToJson(
+      conn_stats.request_timings_us_agg.GetStatsForPeriod());
 }
 
 }  // namespace
@@ -0,0 +1,64 @@
+#include <storages/mongo/stats_serialize.hpp>
+
+#include <chrono>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace stats = storages::mongo::stats;
+
+formats::json::Value ToJson(const stats::PoolStatistics& pool_stats) {
+  formats::json::ValueBuilder builder(formats::json::Type::kObject);
+  stats::PoolStatisticsToJson(pool_stats, builder, stats::Verbosity::kTerse);
+  return builder.ExtractValue();
+}
+
+}  // namespace
+
+UTEST(MongoStats, ConnectionWaitMicroseconds) {
+  tracing::Span span{"test"};
+  stats::PoolStatistics pool_stats;
+
+  {
+    stats::ConnectionWaitStopwatch conn_wait_sw(pool_stats.pool);
+    engine::SleepFor(std::chrono::milliseconds{2});
+  }
+
+  EXPECT_EQ(pool_stats.pool->requested.Load(), 1);
+  // a sub-millisecond precision is kept
+  const auto wait_us =
+      pool_stats.pool->request_timings_us_agg
+          .GetStatsForPeriod(std::chrono::seconds{60},
+                             /*with_current_epoch=*/true)
+          .GetPercentile(100);
+  EXPECT_GE(wait_us, 2000);
+  EXPECT_LT(wait_us, std::chrono::microseconds{utest::kMaxTestWaitTime}.count());
+}
+
+UTEST(MongoStats, ConnectionWaitExported) {
+  stats::PoolStatistics pool_stats;
+  auto& timings_us = pool_stats.pool->request_timings_us_agg;
+  // the current epoch is not exported until it is finished
+  for (int i = 0; i < 99; ++i) timings_us.GetPreviousCounter(1).Account(250);
+  timings_us.GetPreviousCounter(1).Account(40'000);
+
+  const auto json = ToJson(pool_stats);
+  const auto exported = json["pool"]["conn-request-timings-us"];
+  ASSERT_TRUE(exported.IsObject());
+
+  // the histogram values are precise up to ~3%
+  EXPECT_NEAR(exported["p50"].As<double>(), 250, 8);
+  EXPECT_NEAR(exported["p100"].As<double>(), 40'000, 1'250);
+
+  // the millisecond percentiles are still exported
+  EXPECT_TRUE(json["pool"]["conn-request-timings"].IsObject());
+  EXPECT_TRUE(json["pool"]["queue-wait-timings"].IsObject());
+}
+
+USERVER_NAMESPACE_END
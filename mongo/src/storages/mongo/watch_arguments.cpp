@@ -0,0 +1,31 @@
+#include <storages/mongo/watch_arguments.hpp>
+
+#include <chrono>
+
+#include <storages/mongo/operations_common.hpp>
+#include <storages/mongo/operations_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::operations {
+namespace {
+
+constexpr std::chrono::seconds kDefaultMaxAwaitTime{1};
+
+}  // namespace
+
+WatchArguments::WatchArguments(const Watch& watch_op)
+    : pipeline(watch_op.impl_->pipeline.GetInternalArrayDocument()) {
+  auto options_builder = watch_op.impl_->options;
+  if (!watch_op.impl_->has_max_await_time_option) {
+    bool has_max_await_time_option = false;
+    AppendMaxAwaitTime(impl::EnsureBuilder(options_builder),
+                       has_max_await_time_option,
+                       mongo::options::MaxAwaitTime{kDefaultMaxAwaitTime});
+  }
+  options = formats::bson::Document(options_builder->Extract());
+}
+
+}  // namespace storages::mongo::operations
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/storages/mongo/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::operations {
+
+/// The `mongoc_collection_watch` arguments of the operation
+struct WatchArguments final {
+  /// Applies the default max await time, which must be less than the socket
+  /// timeout of the pool
+  explicit WatchArguments(const Watch& watch_op);
+
+  formats::bson::Document pipeline;
+  formats::bson::Document options;
+};
+
+}  // namespace storages::mongo::operations
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,95 @@
+#include <storages/mongo/watch_arguments.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/bson/inline.hpp>
+#include <userver/storages/mongo/exception.hpp>
+#include <userver/storages/mongo/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+}  // namespace
+
+TEST(WatchArguments, Defaults) {
+  const mongo::operations::Watch watch_op(bson::MakeArray());
+  const mongo::operations::WatchArguments arguments(watch_op);
+
+  EXPECT_TRUE(arguments.pipeline.IsEmpty());
+  EXPECT_EQ(arguments.options["maxAwaitTimeMS"].As<std::int64_t>(), 1000);
+  EXPECT_FALSE(arguments.options.HasMember("resumeAfter"));
+  EXPECT_FALSE(arguments.options.HasMember("fullDocument"));
+}
+
+TEST(WatchArguments, Pipeline) {
+  const mongo::operations::Watch watch_op(bson::MakeArray(
+      bson::MakeDoc("$match", bson::MakeDoc("operationType", "insert"))));
+  const mongo::operations::WatchArguments arguments(watch_op);
+
+  ASSERT_EQ(arguments.pipeline.GetSize(), 1);
+  EXPECT_EQ(
+      arguments.pipeline["0"]["$match"]["operationType"].As<std::string>(),
+      "insert");
+}
+
+TEST(WatchArguments, NotArrayPipeline) {
+  EXPECT_THROW(mongo::operations::Watch(bson::MakeDoc("$match", 1)),
+               mongo::InvalidQueryArgumentException);
+}
+
+TEST(WatchArguments, ResumeAfter) {
+  const auto token = bson::MakeDoc("_data", "8263");
+  mongo::operations::Watch watch_op(bson::MakeArray());
+  watch_op.SetOption(mongo::options::ResumeAfter{token});
+  const mongo::operations::WatchArguments arguments(watch_op);
+
+  EXPECT_EQ(arguments.options["resumeAfter"]["_data"].As<std::string>(),
+            "8263");
+  EXPECT_EQ(arguments.options["maxAwaitTimeMS"].As<std::int64_t>(), 1000);
+}
+
+TEST(WatchArguments, FullDocumentLookup) {
+  mongo::operations::Watch watch_op(bson::MakeArray());
+  watch_op.SetOption(mongo::options::FullDocumentLookup{});
+  const mongo::operations::WatchArguments arguments(watch_op);
+
+  EXPECT_EQ(arguments.options["fullDocument"].As<std::string>(),
+            "updateLookup");
+}
+
+TEST(WatchArguments, MaxAwaitTime) {
+  mongo::operations::Watch watch_op(bson::MakeArray());
+  watch_op.SetOption(
+      mongo::options::MaxAwaitTime{std::chrono::milliseconds{250}});
+  const mongo::operations::WatchArguments arguments(watch_op);
+
+  EXPECT_EQ(arguments.options["maxAwaitTimeMS"].As<std::int64_t>(), 250);
+  EXPECT_EQ(arguments.options.GetSize(), 1);
+}
+
+TEST(WatchArguments, CopiesOptions) {
+  mongo::operations::Watch watch_op(bson::MakeArray());
+  watch_op.SetOption(mongo::options::FullDocumentLookup{});
+  {
+    const mongo::operations::WatchArguments arguments(watch_op);
+    EXPECT_TRUE(arguments.options.HasMember("maxAwaitTimeMS"));
+  }
+
+  // the operation keeps its own options
+  watch_op.SetOption(
+      mongo::options::MaxAwaitTime{std::chrono::milliseconds{100}});
+  const mongo::operations::WatchArguments arguments(watch_op);
+  EXPECT_EQ(arguments.options["maxAwaitTimeMS"].As<std::int64_t>(), 100);
+  EXPECT_EQ(arguments.options["fullDocument"].As<std::string>(),
+            "updateLookup");
+}
+
+USERVER_NAMESPACE_END
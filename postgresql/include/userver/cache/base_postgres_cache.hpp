@@ -22,6 +22,10 @@
 #include <userver/storages/postgres/io/chrono.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
@@ -62,6 +66,7 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL, 0 to fetch all rows in one request | 1000
+/// listen-channel | channel to `LISTEN` to, see @ref pg_cc_notifications | - (no listening)
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -93,6 +98,35 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// @section pg_cc_notifications Updates on notifications
+///
+/// With `listen-channel` the cache is updated right after a `NOTIFY` of the
+/// channel instead of waiting for the rest of the `update-interval`, so the
+/// interval may be increased to reduce the idle load on the database. The
+/// data source should notify the channel after the changes are committed,
+/// e.g. by a trigger:
+///
+/// @code{.sql}
+/// CREATE FUNCTION notify_users_changed() RETURNS trigger AS $$
+/// BEGIN
+///   NOTIFY users_changed;
+///   RETURN NULL;
+/// END;
+/// $$ LANGUAGE plpgsql;
+///
+/// CREATE TRIGGER users_changed AFTER INSERT OR UPDATE OR DELETE ON users
+///   FOR EACH STATEMENT EXECUTE FUNCTION notify_users_changed();
+/// @endcode
+///
+/// A connection of the master pool of each shard is held for listening, see
+/// storages::postgres::Cluster::Listen. The notifications that arrive during
+/// an update are coalesced into a single update after it. The updates stay
+/// incremental (unless the policy has no `kUpdatedField` or the
+/// `full-update-interval` has passed), so `update-correction` must still
+/// cover the transactions that were in progress during the previous update.
+/// The periodic updates are kept, they catch up on the notifications lost
+/// while the listening connection is being re-established.
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -364,6 +398,7 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::chrono::seconds kListenRetryInterval{1};
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -421,14 +456,18 @@ class PostgreCache final
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
+  void ListenForNotifications(storages::postgres::Cluster& cluster);
+
   std::vector<storages::postgres::ClusterPtr> clusters_;
 
   const std::chrono::system_clock::duration correction_;
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::string listen_channel_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
+  std::vector<engine::TaskWithResult<void>> listen_tasks_;
 };
 
 template <typename PostgreCachePolicy>
@@ -446,7 +485,8 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      listen_channel_{config["listen-channel"].As<std::string>("")} {
   if (this->GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
       !kIncrementalUpdates) {
@@ -479,10 +519,19 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
              << GetDeltaQuery().Statement() << "`";
 
   this->StartPeriodicUpdates();
+
+  if (!listen_channel_.empty()) {
+    for (const auto& cluster : clusters_) {
+      listen_tasks_.push_back(engine::CriticalAsyncNoSpan(
+          this->GetCacheTaskProcessor(),
+          [this, cluster] { ListenForNotifications(*cluster); }));
+    }
+  }
 }
 
 template <typename PostgreCachePolicy>
 PostgreCache<PostgreCachePolicy>::~PostgreCache() {
+  for (auto& task : listen_tasks_) task.SyncCancel();
   this->StopPeriodicUpdates();
 }
 
@@ -530,6 +579,27 @@ std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
   }
 }
 
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::ListenForNotifications(
+    storages::postgres::Cluster& cluster) {
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      auto scope = cluster.Listen(listen_channel_);
+      // catches up on the changes made while there was no listener
+      this->InvalidateAsync(cache::UpdateType::kIncremental);
+      while (true) {
+        scope.WaitNotify(engine::Deadline{});
+        this->InvalidateAsync(cache::UpdateType::kIncremental);
+      }
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Failed to listen to channel '" << listen_channel_
+                    << "' for cache " << kName << ": " << e;
+    }
+    engine::InterruptibleSleepFor(pg_cache::detail::kListenRetryInterval);
+  }
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::UpdatedFieldType
 PostgreCache<PostgreCachePolicy>::GetLastUpdated(
@@ -4,6 +4,7 @@
 /// @brief @copybrief storages::postgres::Cluster
 
 #include <memory>
+#include <string_view>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -14,8 +15,11 @@
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/database.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -181,6 +185,9 @@ class Cluster {
 
   /// @brief Execute a statement with stored arguments and specified host
   /// selection rules.
+  ///
+  /// The result may be served from the query result cache, see
+  /// Cluster::SetQueryResultCacheSettings.
   ResultSet Execute(ClusterHostTypeFlags flags, const Query& query,
                     const ParameterStore& store);
 
@@ -191,6 +198,61 @@ class Cluster {
                     const Query& query, const ParameterStore& store);
   /// @}
 
+  /// @name Multiple independent statements in a single round trip
+  /// @{
+
+  /// @brief Execute all the statements of the batch over a single connection
+  /// at host of specified type, see storages::postgres::QueryBatch.
+  /// @note You must specify at least one role from ClusterHostType here
+  QueryBatchResult ExecuteBatch(ClusterHostTypeFlags flags,
+                                const QueryBatch& batch);
+
+  /// @brief Execute all the statements of the batch with specified host
+  /// selection rules and command control settings for the whole batch.
+  /// @note You must specify at least one role from ClusterHostType here
+  QueryBatchResult ExecuteBatch(ClusterHostTypeFlags flags,
+                                OptionalCommandControl statement_cmd_ctl,
+                                const QueryBatch& batch);
+  /// @}
+
+  /// @name Asynchronous notifications
+  /// @{
+
+  /// @brief Listen to the notifications of the channel on the master host,
+  /// see storages::postgres::NotifyScope.
+  ///
+  /// A connection of the master pool is held until the scope is destroyed.
+  /// `cmd_ctl` limits the time to acquire the connection and to execute
+  /// `LISTEN` and `UNLISTEN`.
+  /// @throws ClusterUnavailable if the master is not available
+  NotifyScope Listen(std::string_view channel,
+                     OptionalCommandControl cmd_ctl = {});
+  /// @}
+
+  /// @name Query result cache
+  /// @{
+
+  /// @brief Enables caching of the results of the named queries.
+  ///
+  /// Cluster::Execute of a query listed in `settings` serves the result of
+  /// a previous execution of the same statement with the same arguments
+  /// until its TTL expires, without a database round trip. Only the queries
+  /// with the arguments of built-in types are cached. The flags and the
+  /// command control are not a part of the cache key, so only enable it
+  /// for the read queries over slowly changing data where a stale result
+  /// is acceptable.
+  ///
+  /// The results of the queries whose settings did not change are kept.
+  void SetQueryResultCacheSettings(
+      const QueryResultCacheSettingsMap& settings);
+
+  /// Drops the cached results of the query, e.g. after the data changes
+  void InvalidateQueryResults(const std::string& query_name);
+
+  /// Drops the cached results of all the queries
+  void InvalidateQueryResults();
+  /// @}
+
   /// Replaces globally updated command control with a static user-provided one
   void SetDefaultCommandControl(CommandControl);
 
@@ -220,6 +282,8 @@ class Cluster {
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  bool IsQueryResultCached(const Query& query) const;
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
@@ -237,6 +301,13 @@ template <typename... Args>
 ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
                            OptionalCommandControl statement_cmd_ctl,
                            const Query& query, const Args&... args) {
+  if constexpr ((io::traits::kIsMappedToSystemType<Args> && ...)) {
+    if (IsQueryResultCached(query)) {
+      ParameterStore store;
+      (store.PushBack(args), ...);
+      return Execute(flags, statement_cmd_ctl, query, store);
+    }
+  }
   if (!statement_cmd_ctl && query.GetName()) {
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
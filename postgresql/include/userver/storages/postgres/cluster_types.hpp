@@ -44,6 +44,10 @@ enum class ClusterHostType {
 
   /// Chooses a host with the lowest RTT
   kNearest = 0x10,
+
+  /// Chooses a host with the lowest expected latency, estimated from its RTT,
+  /// the number of queries in flight and the replication lag
+  kLeastLoaded = 0x20,
   /// @}
 };
 
@@ -54,7 +58,8 @@ constexpr ClusterHostTypeFlags kClusterHostRolesMask{
     ClusterHostType::kSlave};
 
 constexpr ClusterHostTypeFlags kClusterHostStrategyMask{
-    ClusterHostType::kRoundRobin, ClusterHostType::kNearest};
+    ClusterHostType::kRoundRobin, ClusterHostType::kNearest,
+    ClusterHostType::kLeastLoaded};
 
 std::string ToString(ClusterHostType);
 std::string ToString(ClusterHostTypeFlags);
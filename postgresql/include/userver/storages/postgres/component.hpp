@@ -124,11 +124,17 @@ namespace components {
 /// ignore_unused_query_params| disable check for not-NULL query params that are not used in query| false
 /// monitoring-dbalias      | name of the database for monitorings                      | calculated from dbalias or dbconnection options
 /// max_prepared_cache_size | prepared statements cache size limit                      | 5000
+/// warmup-prepared-statements | number of the most used statements prepared by new connections in advance | 0
 /// max_statement_metrics   | limit of exported metrics for named statements            | 0
 /// min_pool_size           | number of connections created initially                   | 4
 /// max_pool_size           | maximum number of created connections                     | 15
 /// max_queue_size          | maximum number of clients waiting for a connection        | 200
 /// connecting_limit        | limit for concurrent establishing connections number per pool (0 - unlimited) | 0
+/// adaptive_size           | adjust the number of connections between min_pool_size and max_pool_size to the load | false
+/// adaptive_max_acquire_wait_ms | connection acquire wait time (95th percentile) that makes an adaptive pool grow | 10
+/// throttling_accepts_multiplier | reject the transactions locally once they outnumber the transactions served by the host during the last 2 minutes by this factor, see congestion_control::ClientThrottler; 0 disables the throttling | 0
+/// lifo_acquire            | reuse the most recently released connection first to keep the working set of connections small and hot | false
+/// max_idle_time_ms        | with lifo_acquire, close the connections idle for longer while the pool is above min_pool_size; 0 keeps them | 0
 
 // clang-format on
 
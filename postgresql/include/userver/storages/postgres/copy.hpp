@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Streaming of the rows with binary COPY
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/io/traits.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+/// @brief Writer of the rows of `COPY ... FROM STDIN (FORMAT binary)`.
+///
+/// Is created by storages::postgres::Transaction::CopyIn. The rows are
+/// serialized with the same formatters as the query parameters and are sent to
+/// the database in chunks, the coroutine is suspended while the database is
+/// not ready to take the next chunk. The types of the values must match the
+/// types of the columns exactly, e.g. std::int32_t for `integer` and
+/// std::int64_t for `bigint`, as the binary format has no type information.
+///
+/// The copy is completed by Finish(), the destruction of an unfinished stream
+/// aborts the copy and so the transaction.
+///
+/// @code
+/// auto copy = trx.CopyIn("users", {"id", "name"});
+/// for (const auto& user : users) copy.WriteRow(user.id, user.name);
+/// auto rows = copy.Finish();
+/// @endcode
+///
+/// The stream must not outlive the transaction and no other statements can be
+/// executed in the transaction until the copy is completed.
+class CopyInStream final {
+ public:
+  CopyInStream(detail::Connection* conn, const std::string& table,
+               const std::vector<std::string>& columns,
+               OptionalCommandControl cmd_ctl = {});
+
+  CopyInStream(CopyInStream&&) noexcept;
+  CopyInStream& operator=(CopyInStream&&) noexcept;
+
+  CopyInStream(const CopyInStream&) = delete;
+  CopyInStream& operator=(const CopyInStream&) = delete;
+
+  ~CopyInStream();
+
+  /// @brief Serializes a row to the stream, the row is sent to the database
+  /// when enough data is accumulated.
+  /// @throws LogicError if the stream is finished
+  template <typename... Columns>
+  CopyInStream& WriteRow(const Columns&... columns) {
+    CheckActive();
+    if (column_count_ && column_count_ != sizeof...(Columns)) {
+      throw FieldTupleMismatch(column_count_, sizeof...(Columns));
+    }
+    const auto row_begin = buffer_.size();
+    try {
+      io::WriteBuffer(*types_, buffer_,
+                      static_cast<Smallint>(sizeof...(Columns)));
+      (io::WriteRawBinary(*types_, buffer_, columns), ...);
+    } catch (const std::exception&) {
+      buffer_.resize(row_begin);
+      throw;
+    }
+    if (buffer_.size() >= kChunkSize) SendBuffer();
+    return *this;
+  }
+
+  /// @brief Sends the rest of the rows and completes the copy, the stream is
+  /// not usable after that.
+  /// @returns the number of copied rows
+  std::size_t Finish();
+
+ private:
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  void Swap(CopyInStream& other) noexcept;
+  void CheckActive() const;
+  void SendBuffer();
+
+  detail::Connection* conn_{nullptr};
+  const UserTypes* types_{nullptr};
+  std::size_t column_count_{0};
+  std::vector<char> buffer_;
+};
+
+/// @brief Reader of the rows of `COPY (...) TO STDOUT (FORMAT binary)`.
+///
+/// Is created by storages::postgres::Transaction::CopyOut. The rows are parsed
+/// with the same parsers as the fields of a result set, the coroutine is
+/// suspended until the database sends the next row. The types of the values
+/// must match the types of the columns exactly, as the binary format has no
+/// type information.
+///
+/// @code
+/// auto copy = trx.CopyOut("SELECT id, name FROM users");
+/// std::int64_t id{};
+/// std::string name;
+/// while (copy.ReadRow(id, name)) {
+///   ...
+/// }
+/// @endcode
+///
+/// The destruction of the stream before the end of the data cancels the copy
+/// and so the transaction. The stream must not outlive the transaction and no
+/// other statements can be executed in the transaction until the copy is
+/// completed.
+class CopyOutStream final {
+ public:
+  CopyOutStream(detail::Connection* conn, const Query& query,
+                OptionalCommandControl cmd_ctl = {});
+
+  CopyOutStream(CopyOutStream&&) noexcept;
+  CopyOutStream& operator=(CopyOutStream&&) noexcept;
+
+  CopyOutStream(const CopyOutStream&) = delete;
+  CopyOutStream& operator=(const CopyOutStream&) = delete;
+
+  ~CopyOutStream();
+
+  /// @brief Reads the next row into the values.
+  /// @returns false at the end of the data
+  template <typename... Columns>
+  bool ReadRow(Columns&... columns) {
+    if (!FetchRow()) return false;
+    if (field_count_ != sizeof...(Columns)) {
+      throw FieldTupleMismatch(field_count_, sizeof...(Columns));
+    }
+    io::FieldBuffer buffer{
+        false, io::BufferCategory::kPlainBuffer, row_.size() - row_offset_,
+        reinterpret_cast<const std::uint8_t*>(row_.data()) + row_offset_};
+    (buffer.ReadRaw(columns, *categories_,
+                    io::traits::kTypeBufferCategory<Columns>),
+     ...);
+    if (buffer.length != 0) {
+      throw InvalidBinaryBuffer("COPY row has extra data");
+    }
+    return true;
+  }
+
+ private:
+  void Swap(CopyOutStream& other) noexcept;
+  bool FetchRow();
+  bool FetchData();
+
+  detail::Connection* conn_{nullptr};
+  const io::TypeBufferCategory* categories_{nullptr};
+  std::string row_;
+  std::size_t row_offset_{0};
+  std::size_t field_count_{0};
+  bool header_read_{false};
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
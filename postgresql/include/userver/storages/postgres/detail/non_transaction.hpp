@@ -6,6 +6,7 @@
 #include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
@@ -64,6 +65,12 @@ class NonTransaction {
   /// Suspends coroutine for execution.
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const std::string& statement, const ParameterStore& store);
+
+  /// Execute all the statements of the batch in a single round trip.
+  ///
+  /// Suspends coroutine for execution.
+  QueryBatchResult ExecuteBatch(OptionalCommandControl statement_cmd_ctl,
+                                const QueryBatch& batch);
   /// @}
  private:
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
@@ -0,0 +1,42 @@
+#pragma once
+
+/// @file userver/storages/postgres/dist_lock_group_strategy.hpp
+/// @brief @copybrief storages::postgres::DistLockGroupStrategy
+
+#include <userver/dist_lock/dist_lock_group.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/storages/postgres/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief Postgres distributed locking strategy for dist_lock::DistLockGroup
+///
+/// Acquires and prolongs all the locks of a batch with a single statement
+/// over the same table as storages::postgres::DistLockStrategy.
+class DistLockGroupStrategy final
+    : public dist_lock::DistLockGroupStrategyBase {
+ public:
+  DistLockGroupStrategy(ClusterPtr cluster, const std::string& table,
+                        CommandControl cc);
+
+  std::vector<bool> AcquireBatch(
+      const std::vector<LockRequest>& requests) override;
+
+  void Release(const std::string& lock_name,
+               const std::string& locker_id) override;
+
+  void UpdateCommandControl(CommandControl cc);
+
+ private:
+  ClusterPtr cluster_;
+  rcu::Variable<CommandControl> cc_;
+  const std::string acquire_batch_query_;
+  const std::string release_query_;
+  const std::string owner_prefix_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file userver/storages/postgres/notify.hpp
+/// @brief @copybrief storages::postgres::NotifyScope
+
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief Asynchronous notification sent by `NOTIFY channel, 'payload'` or
+/// `pg_notify('channel', 'payload')`
+struct Notification final {
+  std::string channel;
+  /// Empty if the notification has no payload
+  std::string payload;
+};
+
+/// @brief Subscription to the notifications of a PostgreSQL channel, see
+/// `LISTEN`.
+///
+/// Is created by storages::postgres::Cluster::Listen. Holds a connection of
+/// the pool to the master host that executes `LISTEN channel` on creation and
+/// `UNLISTEN channel` on destruction, the connection is not available for
+/// other queries while the scope is alive.
+///
+/// @code
+/// auto scope = cluster->Listen("data_changed");
+/// while (!engine::current_task::ShouldCancel()) {
+///   const auto notification = scope.WaitNotify(engine::Deadline{});
+///   ...
+/// }
+/// @endcode
+///
+/// The notifications sent while no scope exists, e.g. while the connection is
+/// being re-established after an error, are lost.
+class NotifyScope final {
+ public:
+  NotifyScope(detail::ConnectionPtr conn, std::string_view channel,
+              OptionalCommandControl cmd_ctl);
+
+  NotifyScope(NotifyScope&&) noexcept;
+  NotifyScope& operator=(NotifyScope&&) noexcept;
+
+  NotifyScope(const NotifyScope&) = delete;
+  NotifyScope& operator=(const NotifyScope&) = delete;
+
+  ~NotifyScope();
+
+  /// @brief Waits for the next notification of the channel, suspends the
+  /// coroutine until it arrives.
+  ///
+  /// The notifications are queued in order, so no notifications are lost
+  /// between the calls.
+  /// @throws ConnectionTimeoutError if the deadline is reached
+  /// @throws ConnectionInterrupted if the task is cancelled
+  /// @throws ConnectionError and its descendants if the connection is lost,
+  /// the scope should be recreated
+  Notification WaitNotify(engine::Deadline deadline);
+
+ private:
+  detail::ConnectionPtr conn_;
+  std::string channel_;
+  OptionalCommandControl cmd_ctl_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -142,6 +142,28 @@ using CommandControlByHandlerMap =
 using CommandControlByQueryMap =
     std::unordered_map<std::string, CommandControl>;
 
+/// Default size limit for the cached results of a query
+static constexpr std::size_t kDefaultQueryResultCacheMaxBytes = 1024 * 1024;
+
+/// @brief Settings of the result cache of a named query, see
+/// storages::postgres::Cluster::SetQueryResultCacheSettings
+struct QueryResultCacheSettings {
+  /// How long a result is served from the cache, 0 disables the caching
+  std::chrono::milliseconds ttl{0};
+
+  /// Limit of the total size of the cached results of the query, the least
+  /// recently used results are evicted first
+  std::size_t max_bytes{kDefaultQueryResultCacheMaxBytes};
+
+  bool operator==(const QueryResultCacheSettings& rhs) const {
+    return ttl == rhs.ttl && max_bytes == rhs.max_bytes;
+  }
+};
+
+/// Result cache settings by query name
+using QueryResultCacheSettingsMap =
+    std::unordered_map<std::string, QueryResultCacheSettings>;
+
 OptionalCommandControl GetHandlerOptionalCommandControl(
     const CommandControlByHandlerMap& map, const std::string& path,
     const std::string& method);
@@ -165,6 +187,9 @@ static constexpr size_t kDefaultPoolMaxQueueSize = 200;
 /// Default limit for concurrent establishing connections number
 static constexpr size_t kDefaultConnectingLimit = 0;
 
+/// Default acquire wait time that makes an adaptive pool grow
+static constexpr TimeoutDuration kDefaultAdaptiveMaxAcquireWait{10};
+
 /// @brief PostgreSQL connection pool options
 ///
 /// Dynamic option @ref POSTGRES_CONNECTION_POOL_SETTINGS
@@ -181,10 +206,37 @@ struct PoolSettings {
   /// Limits number of concurrent establishing connections (0 - unlimited)
   size_t connecting_limit{kDefaultConnectingLimit};
 
+  /// Adjust the number of connections between min_size and max_size to the
+  /// measured load instead of keeping the idle connections
+  bool adaptive_size{false};
+
+  /// Acquire wait time (95th percentile) that makes an adaptive pool grow
+  TimeoutDuration adaptive_max_acquire_wait{kDefaultAdaptiveMaxAcquireWait};
+
+  /// Reject the transactions locally once they outnumber the transactions
+  /// served by the host during the last 2 minutes by this factor
+  /// (0 - disabled), see congestion_control::ClientThrottler
+  double throttling_accepts_multiplier{0};
+
+  /// Reuse the most recently released connection first instead of rotating
+  /// through all of them, so that the working set of connections stays small
+  /// and the rest form a cold tail that is closed after max_idle_time
+  bool lifo_acquire{false};
+
+  /// With lifo_acquire, close the connections that stay idle longer while the
+  /// pool is above min_size (0 - keep them)
+  TimeoutDuration max_idle_time{0};
+
   bool operator==(const PoolSettings& rhs) const {
     return min_size == rhs.min_size && max_size == rhs.max_size &&
            max_queue_size == rhs.max_queue_size &&
-           connecting_limit == rhs.connecting_limit;
+           connecting_limit == rhs.connecting_limit &&
+           adaptive_size == rhs.adaptive_size &&
+           adaptive_max_acquire_wait == rhs.adaptive_max_acquire_wait &&
+           throttling_accepts_multiplier ==
+               rhs.throttling_accepts_multiplier &&
+           lifo_acquire == rhs.lifo_acquire &&
+           max_idle_time == rhs.max_idle_time;
   }
 };
 
@@ -232,6 +284,10 @@ struct ConnectionSettings {
   /// This many connection errors in 15 seconds block new connections opening
   size_t recent_errors_threshold = 2;
 
+  /// This many most used prepared statements of the pool are prepared by new
+  /// connections in advance
+  size_t warmup_prepared_statements = 0;
+
   /// Helps keep track of the changes in settings
   SettingsVersion version{0U};
 
@@ -241,7 +297,8 @@ struct ConnectionSettings {
            ignore_unused_query_params == rhs.ignore_unused_query_params &&
            max_prepared_cache_size == rhs.max_prepared_cache_size &&
            pipeline_mode == rhs.pipeline_mode &&
-           recent_errors_threshold == rhs.recent_errors_threshold;
+           recent_errors_threshold == rhs.recent_errors_threshold &&
+           warmup_prepared_statements == rhs.warmup_prepared_statements;
   }
 
   bool operator!=(const ConnectionSettings& rhs) const {
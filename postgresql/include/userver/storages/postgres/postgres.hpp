@@ -33,6 +33,8 @@
 /// - Binary protocol usage for communication;
 /// - Portals for effective background cache updates;
 /// - Queries pipelining;
+/// - Asynchronous notifications (`LISTEN`/`NOTIFY`);
+/// - Opt-in caching of the results of the named read queries;
 /// - Mapping PostgreSQL user types to C++ types.
 ///
 /// @section toc More information
@@ -24,6 +24,7 @@ namespace detail {
 class Connection;
 class ConnectionImpl;
 class ConnectionPtr;
+class QueryResultCache;
 using ConnectionCallback = std::function<void(Connection*)>;
 
 class ResultWrapper;
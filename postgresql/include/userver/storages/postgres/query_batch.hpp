@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file userver/storages/postgres/query_batch.hpp
+/// @brief @copybrief storages::postgres::QueryBatch
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @ingroup userver_containers
+///
+/// @brief A list of statements that are sent to the database at once.
+///
+/// The statements are executed over a single connection in libpq pipeline
+/// mode, so the whole batch takes a single network round trip instead of a
+/// round trip per statement. The statements are independent, an error in one
+/// of them does not prevent the others from execution, unless the batch is
+/// executed in a transaction that gets aborted by the error.
+///
+/// If libpq does not support pipelining, the statements are executed one by
+/// one.
+///
+/// @code
+/// storages::postgres::QueryBatch batch;
+/// batch.Append("SELECT name FROM users WHERE id = $1", user_id)
+///     .Append("SELECT count(*) FROM orders WHERE user_id = $1", user_id);
+///
+/// auto results = cluster->ExecuteBatch(ClusterHostType::kSlave, batch);
+/// auto name = results.Get(0).AsSingleRow<std::string>();
+/// auto orders = results.Get(1).AsSingleRow<std::int64_t>();
+/// @endcode
+///
+/// @warning Do NOT create a query string manually by embedding arguments!
+/// It leads to vulnerabilities and bad performance.
+class QueryBatch final {
+ public:
+  /// @brief Adds a statement to the end of the batch.
+  ///
+  /// The arguments are copied, so they must not reference the data that is
+  /// destroyed before the batch execution (e.g. std::string_view).
+  template <typename... Args>
+  QueryBatch& Append(const Query& query, const Args&... args) {
+    statements_.push_back(
+        {query, [args = std::make_tuple(args...)](
+                    const UserTypes& types,
+                    detail::DynamicQueryParameters& params) {
+           std::apply(
+               [&](const auto&... unpacked) { params.Write(types, unpacked...); },
+               args);
+         }});
+    return *this;
+  }
+
+  /// Number of the statements in the batch
+  std::size_t Size() const noexcept { return statements_.size(); }
+
+  bool IsEmpty() const noexcept { return statements_.empty(); }
+
+  /// @cond
+  struct Statement {
+    Query query;
+    std::function<void(const UserTypes&, detail::DynamicQueryParameters&)>
+        write_params;
+  };
+
+  const std::vector<Statement>& GetStatements() const noexcept {
+    return statements_;
+  }
+  /// @endcond
+
+ private:
+  std::vector<Statement> statements_;
+};
+
+/// @brief Results of the statements of storages::postgres::QueryBatch, in the
+/// order of the statements.
+class QueryBatchResult final {
+ public:
+  std::size_t Size() const noexcept { return results_.size(); }
+
+  /// Returns true if the statement has failed
+  bool HasError(std::size_t index) const;
+
+  /// Returns the error of the statement or nullptr on success
+  std::exception_ptr GetError(std::size_t index) const;
+
+  /// @brief Returns the result of the statement
+  /// @throws the error of the statement if it has failed
+  const ResultSet& Get(std::size_t index) const;
+
+  /// @cond
+  void AddResult(ResultSet result);
+  void AddError(std::exception_ptr error);
+  /// @endcond
+
+ private:
+  struct Item {
+    ResultSet result{nullptr};
+    std::exception_ptr error;
+  };
+
+  const Item& At(std::size_t index) const;
+
+  std::vector<Item> results_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
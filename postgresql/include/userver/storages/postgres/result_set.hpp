@@ -8,6 +8,7 @@
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -19,6 +20,7 @@
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/meta.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -644,6 +646,7 @@ class ResultSet {
   //@}
  private:
   friend class detail::ConnectionImpl;
+  friend class detail::QueryResultCache;
   void FillBufferCategories(const UserTypes& types);
   void SetBufferCategoriesFrom(const ResultSet&);
 
@@ -651,11 +654,32 @@ class ResultSet {
   friend class TypedResultSet;
   friend class ConnectionImpl;
 
+  //@{
+  /** @name Columnar extraction */
+  void GetColumnBuffers(size_type column,
+                        std::vector<io::FieldBuffer>& buffers) const;
+  const io::TypeBufferCategory& GetTypeBufferCategories() const;
+
+  template <typename Container, std::size_t... Indexes>
+  void ReadColumns(Container& c, std::index_sequence<Indexes...>) const;
+  template <typename Getter>
+  void ReadColumn(size_type column, std::vector<io::FieldBuffer>& buffers,
+                  const Getter& get_value) const;
+  //@}
+
   std::shared_ptr<detail::ResultWrapper> pimpl_;
 };
 
 namespace detail {
 
+/// Containers that are filled column by column by ResultSet::AsContainer, the
+/// field types and formats are checked once per column rather than per value
+template <typename Container>
+inline constexpr bool kIsColumnarContainer =
+    meta::kIsVector<Container> &&
+    !std::is_same_v<typename Container::value_type, bool> &&
+    std::is_default_constructible_v<typename Container::value_type>;
+
 //@{
 /** @name Sequental field extraction */
 template <typename IndexTuple, typename... T>
@@ -846,6 +870,26 @@ auto ResultSet::AsSetOf(FieldTag) const {
 template <typename Container>
 Container ResultSet::AsContainer() const {
   using ValueType = typename Container::value_type;
+  if constexpr (detail::kIsColumnarContainer<Container>) {
+    // composite types can be parsed without an explicit mapping
+    static_assert(io::traits::kIsMappedToPg<ValueType> ||
+                      io::traits::kIsCompositeType<ValueType>,
+                  "This type is not mapped to a PostgreSQL type");
+    if (FieldCount() > 1) {
+      throw NonSingleColumResultSet{FieldCount(),
+                                    compiler::GetTypeName<ValueType>(),
+                                    "AsSetOf"};
+    }
+    Container c(Size());
+    if (c.empty()) return c;
+    if (FieldCount() < 1) {
+      throw InvalidTupleSizeRequested{FieldCount(), 1};
+    }
+    std::vector<io::FieldBuffer> buffers;
+    ReadColumn(0, buffers,
+               [&c](size_type row) -> ValueType& { return c[row]; });
+    return c;
+  }
   Container c;
   if constexpr (io::traits::kCanReserve<Container>) {
     c.reserve(Size());
@@ -858,6 +902,23 @@ Container ResultSet::AsContainer() const {
 template <typename Container>
 Container ResultSet::AsContainer(RowTag) const {
   using ValueType = typename Container::value_type;
+  if constexpr (detail::kIsColumnarContainer<Container>) {
+    static_assert(io::traits::kIsRowType<ValueType>,
+                  "This type cannot be used as a row type");
+    constexpr auto tuple_size = io::RowType<ValueType>::size;
+    Container c(Size());
+    if (c.empty()) return c;
+    if (tuple_size > FieldCount()) {
+      throw InvalidTupleSizeRequested(FieldCount(), tuple_size);
+    } else if (tuple_size < FieldCount()) {
+      LOG_LIMITED_WARNING()
+          << "Row size is greater that the number of data members in "
+             "C++ user datatype "
+          << compiler::GetTypeName<ValueType>();
+    }
+    ReadColumns(c, std::make_index_sequence<tuple_size>{});
+    return c;
+  }
   Container c;
   if constexpr (io::traits::kCanReserve<Container>) {
     c.reserve(Size());
@@ -867,6 +928,47 @@ Container ResultSet::AsContainer(RowTag) const {
   return c;
 }
 
+template <typename Container, std::size_t... Indexes>
+void ResultSet::ReadColumns(Container& c,
+                            std::index_sequence<Indexes...>) const {
+  using RowType = io::RowType<typename Container::value_type>;
+  std::vector<io::FieldBuffer> buffers;
+  (ReadColumn(Indexes, buffers,
+              [&c](size_type row) -> decltype(auto) {
+                return std::get<Indexes>(RowType::GetTuple(c[row]));
+              }),
+   ...);
+}
+
+template <typename Getter>
+void ResultSet::ReadColumn(size_type column,
+                           std::vector<io::FieldBuffer>& buffers,
+                           const Getter& get_value) const {
+  using ValueType = std::decay_t<decltype(get_value(0))>;
+  GetColumnBuffers(column, buffers);
+  const auto& categories = GetTypeBufferCategories();
+  for (size_type row = 0; row < buffers.size(); ++row) {
+    const auto& buffer = buffers[row];
+    auto& value = get_value(row);
+    if (buffer.is_null) {
+      if constexpr (io::traits::kIsNullable<ValueType>) {
+        io::traits::GetSetNull<ValueType>::SetNull(value);
+        continue;
+      } else {
+        // throws FieldValueIsNull
+        (*this)[row][column].To(value);
+      }
+    }
+    try {
+      io::ReadBuffer(buffer, value, categories);
+    } catch (const ResultSetError&) {
+      // the row-wise extraction throws the error with the field context
+      (*this)[row][column].To(value);
+      throw;
+    }
+  }
+}
+
 template <typename T>
 auto ResultSet::AsSingleRow() const {
   return AsSingleRow<T>(kFieldTag);
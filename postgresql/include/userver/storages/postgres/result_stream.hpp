@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file userver/storages/postgres/result_stream.hpp
+/// @brief @copybrief storages::postgres::ResultStream
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+template <typename T, typename ExtractionTag>
+class TypedResultStream;
+
+/// @brief Rows of a statement that are received while the statement is still
+/// running.
+///
+/// Unlike ResultSet, which holds all the rows in memory, the rows are received
+/// in libpq single-row mode (or in chunked rows mode, if libpq supports it) as
+/// they are fetched, so the memory consumption is bounded by the size of a
+/// chunk regardless of the size of the result. Unlike Portal, there is a
+/// single network round trip for the whole result.
+///
+/// Is created by storages::postgres::Transaction::MakeResultStream.
+///
+/// @code
+/// auto stream = trx.MakeResultStream("SELECT id, name FROM users");
+/// for (const auto& [id, name] :
+///      stream.AsSetOf<std::tuple<std::int64_t, std::string>>(kRowTag)) {
+///   ...
+/// }
+/// @endcode
+///
+/// The destruction of the stream before the end of the rows cancels the
+/// statement and so the transaction. The stream must not outlive the
+/// transaction and no other statements can be executed in the transaction
+/// until all the rows are received.
+class ResultStream final {
+ public:
+  /// Number of rows in a chunk if libpq supports chunked rows mode
+  static constexpr std::size_t kDefaultChunkRows = 1024;
+
+  ResultStream(detail::Connection* conn, const Query& query,
+               const detail::QueryParameters& params,
+               OptionalCommandControl cmd_ctl = {},
+               std::size_t chunk_rows = kDefaultChunkRows);
+
+  ResultStream(ResultStream&&) noexcept;
+  ResultStream& operator=(ResultStream&&) noexcept;
+
+  ResultStream(const ResultStream&) = delete;
+  ResultStream& operator=(const ResultStream&) = delete;
+
+  ~ResultStream();
+
+  /// @brief Receives the next chunk of rows, suspends the coroutine until the
+  /// rows arrive.
+  /// @returns std::nullopt after the end of the rows
+  std::optional<ResultSet> Fetch();
+
+  /// Returns true if all the rows are received
+  bool Done() const { return conn_ == nullptr; }
+
+  /// @brief Get a wrapper for iterating over the typed rows as they arrive.
+  ///
+  /// The rows are parsed the same way as ResultSet::AsSetOf does.
+  template <typename T>
+  auto AsSetOf() {
+    return AsSetOf<T>(kFieldTag);
+  }
+  template <typename T>
+  auto AsSetOf(RowTag) {
+    static_assert(io::traits::kIsRowType<std::decay_t<T>>,
+                  "This type cannot be used as a row type");
+    return TypedResultStream<T, RowTag>{*this};
+  }
+  template <typename T>
+  auto AsSetOf(FieldTag) {
+    // composite types can be parsed without an explicit mapping
+    static_assert(io::traits::kIsMappedToPg<std::decay_t<T>> ||
+                      io::traits::kIsCompositeType<std::decay_t<T>>,
+                  "This type is not mapped to a PostgreSQL type");
+    return TypedResultStream<T, FieldTag>{*this};
+  }
+
+ private:
+  void Swap(ResultStream& other) noexcept;
+
+  detail::Connection* conn_{nullptr};
+};
+
+/// @brief Single-pass range of the typed rows of ResultStream.
+///
+/// The iterators satisfy requirements of an InputIterator, a row is parsed
+/// when the iterator is advanced to it.
+template <typename T, typename ExtractionTag>
+class TypedResultStream final {
+ public:
+  class Iterator final {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    /// The end iterator
+    Iterator() = default;
+
+    explicit Iterator(ResultStream& stream) : stream_{&stream} { Advance(); }
+
+    reference operator*() const { return *value_; }
+    pointer operator->() const { return &*value_; }
+
+    Iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+    bool operator==(const Iterator& rhs) const {
+      return stream_ == rhs.stream_;
+    }
+    bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    void Advance() {
+      while (row_ >= chunk_.Size()) {
+        auto chunk = stream_->Fetch();
+        if (!chunk) {
+          stream_ = nullptr;
+          value_.reset();
+          return;
+        }
+        chunk_ = std::move(*chunk);
+        row_ = 0;
+      }
+      value_ = chunk_[row_++].template As<T>(ExtractionTag{});
+    }
+
+    ResultStream* stream_{nullptr};
+    ResultSet chunk_{nullptr};
+    ResultSet::size_type row_{0};
+    std::optional<T> value_;
+  };
+
+  explicit TypedResultStream(ResultStream& stream) : stream_{stream} {}
+
+  /// Starts receiving the rows, can be called once
+  Iterator begin() { return Iterator{stream_}; }
+  Iterator end() { return {}; }
+
+ private:
+  ResultStream& stream_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -113,6 +113,8 @@ struct InstanceStatisticsTemplate {
   Counter pool_exhaust_errors = 0;
   /// Error caused by queue size overflow
   Counter queue_size_errors = 0;
+  /// Error caused by the client-side throttling
+  Counter throttled_errors = 0;
   /// Connect time percentile
   PercentileAccumulator connection_percentile;
   /// Acquire connection percentile
@@ -186,6 +188,7 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
 
     pool_exhaust_errors = stats.pool_exhaust_errors;
     queue_size_errors = stats.queue_size_errors;
+    throttled_errors = stats.throttled_errors;
     connection_percentile = stats.connection_percentile.GetStatsForPeriod();
     acquire_percentile = stats.acquire_percentile.GetStatsForPeriod();
 
@@ -5,7 +5,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -14,7 +16,9 @@
 #include <userver/storages/postgres/portal.hpp>
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -209,6 +213,23 @@ class Transaction {
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Execute all the statements of the batch in a single network round trip.
+  ///
+  /// Suspends coroutine for execution.
+  ///
+  /// @note An error in a statement aborts the transaction, so the following
+  /// statements of the batch fail too.
+  QueryBatchResult ExecuteBatch(const QueryBatch& batch) {
+    return ExecuteBatch(OptionalCommandControl{}, batch);
+  }
+
+  /// Execute all the statements of the batch in a single network round trip
+  /// with per-batch command control.
+  ///
+  /// Suspends coroutine for execution.
+  QueryBatchResult ExecuteBatch(OptionalCommandControl statement_cmd_ctl,
+                                const QueryBatch& batch);
+
   /// Execute statement that uses an array of arguments splitting that array in
   /// chunks and executing the statement with a chunk of arguments.
   ///
@@ -257,6 +278,71 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// @brief Execute statement with arbitrary parameters and receive its rows
+  /// as they arrive, see storages::postgres::ResultStream.
+  ///
+  /// Suspends coroutine until the statement is sent to the database.
+  template <typename... Args>
+  ResultStream MakeResultStream(const Query& query, const Args&... args) {
+    return MakeResultStream(OptionalCommandControl{}, query, args...);
+  }
+
+  /// @brief Execute statement with arbitrary parameters and per-statement
+  /// command control and receive its rows as they arrive.
+  template <typename... Args>
+  ResultStream MakeResultStream(OptionalCommandControl statement_cmd_ctl,
+                                const Query& query, const Args&... args) {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(GetConnectionUserTypes(), args...);
+    return MakeResultStream(query, detail::QueryParameters{params},
+                            std::move(statement_cmd_ctl));
+  }
+
+  /// @brief Execute statement with stored parameters and receive its rows as
+  /// they arrive.
+  ResultStream MakeResultStream(const Query& query,
+                                const ParameterStore& store) {
+    return MakeResultStream(OptionalCommandControl{}, query, store);
+  }
+
+  /// @brief Execute statement with stored parameters and per-statement
+  /// command control and receive its rows as they arrive.
+  ResultStream MakeResultStream(OptionalCommandControl statement_cmd_ctl,
+                                const Query& query,
+                                const ParameterStore& store);
+
+  /// @brief Start `COPY table (columns) FROM STDIN (FORMAT binary)`.
+  ///
+  /// The table and the column names are inserted into the statement as is,
+  /// they must be quoted if required and must never come from the user input.
+  /// Empty column list means all the columns of the table.
+  ///
+  /// Suspends coroutine until the database is ready to receive the rows.
+  CopyInStream CopyIn(const std::string& table,
+                      const std::vector<std::string>& columns = {}) {
+    return CopyIn(OptionalCommandControl{}, table, columns);
+  }
+
+  /// @brief Start `COPY table (columns) FROM STDIN (FORMAT binary)` with
+  /// per-statement command control.
+  CopyInStream CopyIn(OptionalCommandControl statement_cmd_ctl,
+                      const std::string& table,
+                      const std::vector<std::string>& columns = {});
+
+  /// @brief Start `COPY (query) TO STDOUT (FORMAT binary)`.
+  ///
+  /// The query cannot have parameters.
+  ///
+  /// Suspends coroutine until the database starts sending the rows.
+  CopyOutStream CopyOut(const Query& query) {
+    return CopyOut(OptionalCommandControl{}, query);
+  }
+
+  /// @brief Start `COPY (query) TO STDOUT (FORMAT binary)` with per-statement
+  /// command control.
+  CopyOutStream CopyOut(OptionalCommandControl statement_cmd_ctl,
+                        const Query& query);
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -285,6 +371,10 @@ class Transaction {
                     const detail::QueryParameters& params,
                     OptionalCommandControl statement_cmd_ctl);
 
+  ResultStream MakeResultStream(const Query& query,
+                                const detail::QueryParameters& params,
+                                OptionalCommandControl statement_cmd_ctl);
+
   const UserTypes& GetConnectionUserTypes() const;
 
   detail::ConnectionPtr conn_;
@@ -28,6 +28,10 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    listen-channel:
+        type: string
+        description: channel to LISTEN to on the master host of each shard, the cache is updated right after a NOTIFY of the channel; empty to disable
+        defaultDescription: ""
     pgcomponent:
         type: string
         description: PostgreSQL component name
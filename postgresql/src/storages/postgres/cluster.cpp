@@ -87,6 +87,11 @@ detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
   return pimpl_->Start(flags, cmd_ctl);
 }
 
+NotifyScope Cluster::Listen(std::string_view channel,
+                            OptionalCommandControl cmd_ctl) {
+  return pimpl_->Listen(channel, cmd_ctl);
+}
+
 OptionalCommandControl Cluster::GetQueryCmdCtl(
     const std::string& query_name) const {
   return pimpl_->GetQueryCmdCtl(query_name);
@@ -108,9 +113,55 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
   if (!statement_cmd_ctl && query.GetName()) {
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
+  auto& result_cache = pimpl_->GetQueryResultCache();
+  std::optional<std::string> cache_key;
+  if (IsQueryResultCached(query)) {
+    cache_key = detail::QueryResultCache::MakeKey(query.Statement(),
+                                                  store.GetInternalData());
+    auto cached = result_cache.Get(query.GetName()->GetUnderlying(),
+                                   *cache_key);
+    if (cached) return std::move(*cached);
+  }
+
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  auto ntrx = Start(flags, statement_cmd_ctl);
+  auto result = ntrx.Execute(statement_cmd_ctl, query.Statement(), store);
+  if (cache_key) {
+    result_cache.Put(query.GetName()->GetUnderlying(), std::move(*cache_key),
+                     result);
+  }
+  return result;
+}
+
+void Cluster::SetQueryResultCacheSettings(
+    const QueryResultCacheSettingsMap& settings) {
+  pimpl_->GetQueryResultCache().SetSettings(settings);
+}
+
+void Cluster::InvalidateQueryResults(const std::string& query_name) {
+  pimpl_->GetQueryResultCache().Invalidate(query_name);
+}
+
+void Cluster::InvalidateQueryResults() {
+  pimpl_->GetQueryResultCache().InvalidateAll();
+}
+
+bool Cluster::IsQueryResultCached(const Query& query) const {
+  return query.GetName() && pimpl_->GetQueryResultCache().IsEnabled(
+                                query.GetName()->GetUnderlying());
+}
+
+QueryBatchResult Cluster::ExecuteBatch(ClusterHostTypeFlags flags,
+                                       const QueryBatch& batch) {
+  return ExecuteBatch(flags, OptionalCommandControl{}, batch);
+}
+
+QueryBatchResult Cluster::ExecuteBatch(ClusterHostTypeFlags flags,
+                                       OptionalCommandControl statement_cmd_ctl,
+                                       const QueryBatch& batch) {
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
   auto ntrx = Start(flags, statement_cmd_ctl);
-  return ntrx.Execute(statement_cmd_ctl, query.Statement(), store);
+  return ntrx.ExecuteBatch(statement_cmd_ctl, batch);
 }
 
 }  // namespace storages::postgres
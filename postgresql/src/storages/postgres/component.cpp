@@ -242,6 +242,10 @@ properties:
         type: integer
         description: prepared statements cache size limit
         defaultDescription: 5000
+    warmup-prepared-statements:
+        type: integer
+        description: number of the most used statements prepared by new connections in advance
+        defaultDescription: 0
     max_statement_metrics:
         type: integer
         description: limit of exported metrics for named statements
@@ -283,6 +287,26 @@ properties:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
         defaultDescription: 0
+    adaptive_size:
+        type: boolean
+        description: adjust the number of connections between min_pool_size and max_pool_size to the load
+        defaultDescription: false
+    adaptive_max_acquire_wait_ms:
+        type: integer
+        description: connection acquire wait time (95th percentile) that makes an adaptive pool grow
+        defaultDescription: 10
+    throttling_accepts_multiplier:
+        type: number
+        description: reject the transactions locally once they outnumber the transactions served by the host during the last 2 minutes by this factor (0 - disabled)
+        defaultDescription: 0
+    lifo_acquire:
+        type: boolean
+        description: reuse the most recently released connection first to keep the working set of connections small
+        defaultDescription: false
+    max_idle_time_ms:
+        type: integer
+        description: with lifo_acquire, close the connections idle for longer while the pool is above min_pool_size (0 - keep them)
+        defaultDescription: 0
 )");
 }
 
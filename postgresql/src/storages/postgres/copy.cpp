@@ -0,0 +1,203 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+constexpr std::array<char, 11> kBinarySignature{'P',  'G',  'C',  'O',
+                                                'P',  'Y',  '\n', '\377',
+                                                '\r', '\n', '\0'};
+constexpr Smallint kTrailer = -1;
+
+std::string MakeColumnList(const std::vector<std::string>& columns) {
+  if (columns.empty()) return {};
+  return fmt::format(" ({})", fmt::join(columns, ", "));
+}
+
+template <typename T>
+T ReadInteger(const std::string& data, std::size_t offset) {
+  T value{};
+  io::ReadBuffer(
+      io::FieldBuffer{false, io::BufferCategory::kPlainBuffer, sizeof(T),
+                      reinterpret_cast<const std::uint8_t*>(data.data()) +
+                          offset},
+      value);
+  return value;
+}
+
+}  // namespace
+
+CopyInStream::CopyInStream(detail::Connection* conn, const std::string& table,
+                           const std::vector<std::string>& columns,
+                           OptionalCommandControl cmd_ctl)
+    : conn_{conn},
+      types_{&conn->GetUserTypes()},
+      column_count_{columns.size()} {
+  conn_->CopyInStart(fmt::format("COPY {}{} FROM STDIN (FORMAT binary)", table,
+                                 MakeColumnList(columns)),
+                     std::move(cmd_ctl));
+  buffer_.reserve(kChunkSize);
+  buffer_.insert(buffer_.end(), kBinarySignature.begin(),
+                 kBinarySignature.end());
+  // flags and header extension length
+  io::WriteBuffer(*types_, buffer_, Integer{0});
+  io::WriteBuffer(*types_, buffer_, Integer{0});
+}
+
+CopyInStream::CopyInStream(CopyInStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      types_{other.types_},
+      column_count_{other.column_count_},
+      buffer_{std::move(other.buffer_)} {}
+
+CopyInStream& CopyInStream::operator=(CopyInStream&& other) noexcept {
+  CopyInStream{std::move(other)}.Swap(*this);
+  return *this;
+}
+
+CopyInStream::~CopyInStream() {
+  if (!conn_) return;
+  try {
+    conn_->CopyInAbort("COPY stream is destroyed without finishing");
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to abort COPY: " << e;
+  }
+}
+
+std::size_t CopyInStream::Finish() {
+  CheckActive();
+  io::WriteBuffer(*types_, buffer_, kTrailer);
+  SendBuffer();
+  return std::exchange(conn_, nullptr)->CopyInEnd();
+}
+
+void CopyInStream::Swap(CopyInStream& other) noexcept {
+  using std::swap;
+  swap(conn_, other.conn_);
+  swap(types_, other.types_);
+  swap(column_count_, other.column_count_);
+  swap(buffer_, other.buffer_);
+}
+
+void CopyInStream::CheckActive() const {
+  if (!conn_) throw LogicError{"COPY stream is finished"};
+}
+
+void CopyInStream::SendBuffer() {
+  conn_->CopyInData(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+CopyOutStream::CopyOutStream(detail::Connection* conn, const Query& query,
+                             OptionalCommandControl cmd_ctl)
+    : conn_{conn},
+      categories_{&conn->GetUserTypes().GetTypeBufferCategories()} {
+  conn_->CopyOutStart(
+      fmt::format("COPY ({}) TO STDOUT (FORMAT binary)", query.Statement()),
+      std::move(cmd_ctl));
+}
+
+CopyOutStream::CopyOutStream(CopyOutStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      categories_{other.categories_},
+      row_{std::move(other.row_)},
+      row_offset_{other.row_offset_},
+      field_count_{other.field_count_},
+      header_read_{other.header_read_} {}
+
+CopyOutStream& CopyOutStream::operator=(CopyOutStream&& other) noexcept {
+  CopyOutStream{std::move(other)}.Swap(*this);
+  return *this;
+}
+
+CopyOutStream::~CopyOutStream() {
+  if (!conn_) return;
+  try {
+    conn_->CopyOutAbort();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to abort COPY: " << e;
+  }
+}
+
+void CopyOutStream::Swap(CopyOutStream& other) noexcept {
+  using std::swap;
+  swap(conn_, other.conn_);
+  swap(categories_, other.categories_);
+  swap(row_, other.row_);
+  swap(row_offset_, other.row_offset_);
+  swap(field_count_, other.field_count_);
+  swap(header_read_, other.header_read_);
+}
+
+bool CopyOutStream::FetchRow() {
+  row_.clear();
+  row_offset_ = 0;
+  if (!FetchData()) return false;
+
+  if (!header_read_) {
+    constexpr auto kHeaderSize =
+        kBinarySignature.size() + 2 * sizeof(Integer);
+    if (row_.size() < kHeaderSize ||
+        std::memcmp(row_.data(), kBinarySignature.data(),
+                    kBinarySignature.size()) != 0) {
+      throw InvalidBinaryBuffer("COPY data has no binary header");
+    }
+    const auto extension_size =
+        ReadInteger<Integer>(row_, kHeaderSize - sizeof(Integer));
+    if (extension_size < 0 ||
+        row_.size() < kHeaderSize + static_cast<std::size_t>(extension_size)) {
+      throw InvalidBinaryBuffer("COPY header has invalid extension size");
+    }
+    row_offset_ = kHeaderSize + extension_size;
+    header_read_ = true;
+    if (row_offset_ == row_.size()) {
+      // the header was sent separately from the first row
+      row_.clear();
+      row_offset_ = 0;
+      if (!FetchData()) {
+        throw InvalidBinaryBuffer("COPY data has no trailer");
+      }
+    }
+  }
+
+  if (row_.size() - row_offset_ < sizeof(Smallint)) {
+    throw InvalidBinaryBuffer("COPY row has no field count");
+  }
+  const auto field_count = ReadInteger<Smallint>(row_, row_offset_);
+  row_offset_ += sizeof(Smallint);
+  if (field_count == kTrailer) {
+    row_.clear();
+    if (FetchData()) {
+      throw InvalidBinaryBuffer("COPY data continues after the trailer");
+    }
+    return false;
+  }
+  if (field_count < 0) {
+    throw InvalidBinaryBuffer("COPY row has negative field count");
+  }
+  field_count_ = field_count;
+  return true;
+}
+
+bool CopyOutStream::FetchData() {
+  if (!conn_) return false;
+  if (conn_->CopyOutData(row_)) return true;
+  conn_ = nullptr;
+  return false;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <storages/postgres/detail/cluster_impl.hpp>
 
+#include <limits>
+#include <optional>
+
 #include <fmt/format.h>
 
 #include <userver/engine/async.hpp>
@@ -28,15 +31,18 @@ ClusterHostType Fallback(ClusterHostType ht) {
     case ClusterHostType::kNone:
     case ClusterHostType::kRoundRobin:
     case ClusterHostType::kNearest:
+    case ClusterHostType::kLeastLoaded:
       throw ClusterError("Invalid ClusterHostType value for fallback " +
                          ToString(ht));
   }
   UINVARIANT(false, "Unexpected cluster host type");
 }
 
+template <typename CostEstimator>
 size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
                       ClusterHostTypeFlags flags,
-                      std::atomic<uint32_t>& rr_host_idx) {
+                      std::atomic<uint32_t>& rr_host_idx,
+                      const CostEstimator& estimate_cost) {
   UASSERT(!indices.empty());
   if (indices.empty()) {
     throw ClusterError("Cannot select host from an empty list");
@@ -51,6 +57,21 @@ size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
       idx_pos =
           rr_host_idx.fetch_add(1, std::memory_order_relaxed) % indices.size();
     }
+  } else if (strategy_flags == ClusterHostType::kLeastLoaded) {
+    if (indices.size() != 1) {
+      // start from a round-robin position to spread the ties
+      const auto start =
+          rr_host_idx.fetch_add(1, std::memory_order_relaxed) % indices.size();
+      auto min_cost = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < indices.size(); ++i) {
+        const auto pos = (start + i) % indices.size();
+        const auto cost = estimate_cost(indices[pos]);
+        if (cost < min_cost) {
+          min_cost = cost;
+          idx_pos = pos;
+        }
+      }
+    }
   } else if (strategy_flags != ClusterHostType::kNearest) {
     throw LogicError(
         fmt::format("Invalid strategy requested: {}, ensure only one is used",
@@ -195,6 +216,18 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
   size_t dsn_index = -1;
   const auto role_flags = flags & kClusterHostRolesMask;
 
+  std::optional<rcu::ReadablePtr<topology::TopologyBase::DsnMetrics>>
+      dsn_metrics;
+  if (flags & ClusterHostType::kLeastLoaded) {
+    dsn_metrics.emplace(topology_->GetDsnMetrics());
+  }
+  const auto estimate_cost = [&](size_t index) {
+    UASSERT(dsn_metrics && index < (*dsn_metrics)->size());
+    return topology::EstimateHostCost(
+        (**dsn_metrics)[index], host_pools_[index]->GetInFlight(),
+        topology_->GetTopologySettings().max_replication_lag);
+  };
+
   UASSERT_MSG(role_flags, "No roles specified");
   UASSERT_MSG(!(role_flags & ClusterHostType::kSyncSlave) ||
                   role_flags == ClusterHostType::kSyncSlave,
@@ -207,7 +240,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
     if (alive_dsn_indices->empty()) {
       throw ClusterUnavailable("None of cluster hosts are available");
     }
-    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_,
+                               estimate_cost);
   } else {
     auto host_role = static_cast<ClusterHostType>(role_flags.GetValue());
     auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
@@ -229,7 +263,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
                       ToString(host_role), ToString(role_flags)));
     }
     LOG_TRACE() << "Starting transaction on " << host_role;
-    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_,
+                               estimate_cost);
   }
 
   UASSERT(dsn_index < host_pools_.size());
@@ -264,6 +299,13 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
+NotifyScope ClusterImpl::Listen(std::string_view channel,
+                                OptionalCommandControl cmd_ctl) {
+  LOG_TRACE() << "Requested listening to channel '" << channel << "'";
+  // the notifications are not replicated
+  return FindPool(ClusterHostType::kMaster)->Listen(channel, cmd_ctl);
+}
+
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
                                            DefaultCommandControlSource source) {
   default_cmd_ctls_.UpdateDefaultCmdCtl(cmd_ctl, source);
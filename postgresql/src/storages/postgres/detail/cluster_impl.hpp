@@ -11,10 +11,12 @@
 
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/query_result_cache.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <storages/postgres/detail/topology/base.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
@@ -40,6 +42,8 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  NotifyScope Listen(std::string_view channel, OptionalCommandControl);
+
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
 
@@ -59,6 +63,8 @@ class ClusterImpl {
 
   OptionalCommandControl GetTaskDataHandlersCommandControl() const;
 
+  QueryResultCache& GetQueryResultCache() { return result_cache_; }
+
  private:
   using ConnectionPoolPtr = std::shared_ptr<ConnectionPool>;
 
@@ -69,6 +75,7 @@ class ClusterImpl {
   engine::TaskProcessor& bg_task_processor_;
   std::vector<ConnectionPoolPtr> host_pools_;
   std::atomic<uint32_t> rr_host_idx_;
+  QueryResultCache result_cache_;
 };
 
 }  // namespace storages::postgres::detail
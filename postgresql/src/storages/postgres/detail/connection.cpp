@@ -21,14 +21,15 @@ std::unique_ptr<Connection> Connection::Connect(
     engine::TaskProcessor& bg_task_processor, uint32_t id,
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
-    const error_injection::Settings& ei_settings, SizeGuard&& size_guard) {
+    const error_injection::Settings& ei_settings, SizeGuard&& size_guard,
+    StatementsRegistry* statements_registry) {
   std::unique_ptr<Connection> conn(new Connection());
 
   const auto deadline = engine::Deadline::FromDuration(std::max(
       kMinConnectTimeout, default_cmd_ctls.GetDefaultCmdCtl().execute));
   conn->pimpl_ = std::make_unique<ConnectionImpl>(
       bg_task_processor, id, settings, default_cmd_ctls, testsuite_pg_ctl,
-      ei_settings, std::move(size_guard));
+      ei_settings, std::move(size_guard), statements_registry);
   if (resolver) {
     try {
       conn->pimpl_->AsyncConnect(ResolveDsnHostaddrs(dsn, *resolver, deadline),
@@ -113,6 +114,11 @@ ResultSet Connection::Execute(CommandControl statement_cmd_ctl,
                  OptionalCommandControl{statement_cmd_ctl});
 }
 
+QueryBatchResult Connection::ExecuteBatch(
+    const QueryBatch& batch, OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->ExecuteBatch(batch, std::move(statement_cmd_ctl));
+}
+
 Connection::StatementId Connection::PortalBind(
     const std::string& statement, const std::string& portal_name,
     const detail::QueryParameters& params,
@@ -129,6 +135,60 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+void Connection::ResultStreamStart(const Query& query,
+                                   const detail::QueryParameters& params,
+                                   std::size_t chunk_rows,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->ResultStreamStart(query, params, chunk_rows,
+                            std::move(statement_cmd_ctl));
+}
+
+std::optional<ResultSet> Connection::ResultStreamFetch() {
+  return pimpl_->ResultStreamFetch();
+}
+
+void Connection::ResultStreamAbort() { pimpl_->ResultStreamAbort(); }
+
+void Connection::CopyInStart(const std::string& statement,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyInStart(statement, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyInData(const char* data, std::size_t size) {
+  pimpl_->CopyInData(data, size);
+}
+
+std::size_t Connection::CopyInEnd() { return pimpl_->CopyInEnd(); }
+
+void Connection::CopyInAbort(const std::string& message) {
+  pimpl_->CopyInAbort(message);
+}
+
+void Connection::CopyOutStart(const std::string& statement,
+                              OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyOutStart(statement, std::move(statement_cmd_ctl));
+}
+
+bool Connection::CopyOutData(std::string& data) {
+  return pimpl_->CopyOutData(data);
+}
+
+void Connection::CopyOutAbort() { pimpl_->CopyOutAbort(); }
+
+void Connection::Listen(std::string_view channel,
+                        OptionalCommandControl cmd_ctl) {
+  pimpl_->Listen(channel, std::move(cmd_ctl));
+}
+
+void Connection::Unlisten(std::string_view channel,
+                          OptionalCommandControl cmd_ctl) {
+  pimpl_->Unlisten(channel, std::move(cmd_ctl));
+}
+
+Notification Connection::WaitNotify(engine::Deadline deadline) {
+  return pimpl_->WaitNotify(deadline);
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
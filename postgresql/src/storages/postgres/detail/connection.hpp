@@ -2,9 +2,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
 #include <userver/testsuite/postgres_control.hpp>
@@ -15,8 +18,10 @@
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/dsn.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -35,6 +40,7 @@ enum class ConnectionState {
 namespace detail {
 
 class ConnectionImpl;
+class StatementsRegistry;
 
 /// @brief PostreSQL connection class
 /// Handles connecting to Postgres, sending commands, processing command results
@@ -127,6 +133,7 @@ class Connection {
   /// @param testsuite_pg_ctl operation parameters customizer for testsuite
   /// @param ei_settings error injection settings
   /// @param size_guard structure to track the size of owning connection pool
+  /// @param statements_registry statements shared by the connections of the pool, optional
   /// @throws ConnectionFailed, ConnectionTimeoutError
   // clang-format on
   static std::unique_ptr<Connection> Connect(
@@ -136,7 +143,8 @@ class Connection {
       const DefaultCommandControls& default_cmd_ctls,
       const testsuite::PostgresControl& testsuite_pg_ctl,
       const error_injection::Settings& ei_settings,
-      SizeGuard&& size_guard = SizeGuard{});
+      SizeGuard&& size_guard = SizeGuard{},
+      StatementsRegistry* statements_registry = nullptr);
 
   /// Close the connection
   /// TODO When called from another thread/coroutine will wait for current
@@ -218,6 +226,10 @@ class Connection {
   ResultSet Execute(CommandControl statement_cmd_ctl, const Query& query,
                     const ParameterStore& store);
 
+  /// Execute all the statements of the batch in a single round trip
+  QueryBatchResult ExecuteBatch(const QueryBatch& batch,
+                                OptionalCommandControl statement_cmd_ctl = {});
+
   StatementId PortalBind(const std::string& statement,
                          const std::string& portal_name,
                          const detail::QueryParameters& params,
@@ -225,6 +237,39 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Start a query which rows are received by chunks of up to `chunk_rows`
+  /// rows, the chunks have a single row if libpq has no chunked rows mode
+  void ResultStreamStart(const Query& query,
+                         const detail::QueryParameters& params,
+                         std::size_t chunk_rows, OptionalCommandControl);
+  /// Receive the next chunk of rows, std::nullopt at the end of rows
+  std::optional<ResultSet> ResultStreamFetch();
+  /// Cancel the query and discard the rest of the rows
+  void ResultStreamAbort();
+
+  /// Start `COPY ... FROM STDIN (FORMAT binary)`
+  void CopyInStart(const std::string& statement, OptionalCommandControl);
+  /// Send data of the copy, suspends until the data is sent
+  void CopyInData(const char* data, std::size_t size);
+  /// Finish the copy and return the number of copied rows
+  std::size_t CopyInEnd();
+  /// Make the copy fail with the message
+  void CopyInAbort(const std::string& message);
+
+  /// Start `COPY ... TO STDOUT (FORMAT binary)`
+  void CopyOutStart(const std::string& statement, OptionalCommandControl);
+  /// Append the next row of data to `data`, return false at the end of data
+  bool CopyOutData(std::string& data);
+  /// Stop the copy, discarding the rest of data
+  void CopyOutAbort();
+
+  /// Execute `LISTEN channel`
+  void Listen(std::string_view channel, OptionalCommandControl);
+  /// Execute `UNLISTEN channel` and discard the received notifications
+  void Unlisten(std::string_view channel, OptionalCommandControl);
+  /// Wait for the next notification of the listened channels
+  Notification WaitNotify(engine::Deadline deadline);
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/connection_impl.hpp>
 
+#include <algorithm>
+
 #include <boost/functional/hash.hpp>
 
 #include <userver/error_injection/hook.hpp>
@@ -9,6 +11,7 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include <storages/postgres/detail/task_deadline.hpp>
 #include <storages/postgres/detail/tracing_tags.hpp>
 #include <storages/postgres/io/pg_type_parsers.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
@@ -32,6 +35,21 @@ std::size_t QueryHash(const std::string& statement,
   return res;
 }
 
+// Parameter types of a statement that is prepared in advance, without values
+class ParamTypesHolder {
+ public:
+  explicit ParamTypesHolder(const std::vector<Oid>& types) : types_{types} {}
+
+  std::size_t Size() const { return types_.size(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 class CountExecute {
  public:
   CountExecute(Connection::Statistics& stats) : stats_(stats) {
@@ -59,6 +77,40 @@ class CountExecute {
   SteadyClock::time_point exec_begin_time;
 };
 
+class CountBatchExecute {
+ public:
+  CountBatchExecute(Connection::Statistics& stats, std::size_t size)
+      : stats_(stats), size_(size), exec_begin_time_(SteadyClock::now()) {
+    stats_.execute_total += size_;
+  }
+
+  ~CountBatchExecute() {
+    auto now = SteadyClock::now();
+    if (!completed_) {
+      stats_.error_execute_total += size_;
+    }
+    stats_.sum_query_duration += now - exec_begin_time_;
+    stats_.last_execute_finish = now;
+  }
+
+  void AccountResults(const QueryBatchResult& results) {
+    for (std::size_t i = 0; i < results.Size(); ++i) {
+      if (results.HasError(i)) {
+        ++stats_.error_execute_total;
+      } else if (results.Get(i).FieldCount()) {
+        ++stats_.reply_total;
+      }
+    }
+    completed_ = true;
+  }
+
+ private:
+  Connection::Statistics& stats_;
+  const std::size_t size_;
+  bool completed_{false};
+  SteadyClock::time_point exec_begin_time_;
+};
+
 class CountPortalBind {
  public:
   CountPortalBind(Connection::Statistics& stats) : stats_(stats) {
@@ -165,10 +217,12 @@ ConnectionImpl::ConnectionImpl(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    Connection::SizeGuard&& size_guard)
+    Connection::SizeGuard&& size_guard,
+    StatementsRegistry* statements_registry)
     : uuid_{USERVER_NAMESPACE::utils::generators::GenerateUuid()},
       conn_wrapper_{bg_task_processor, id, std::move(size_guard)},
       prepared_{settings.max_prepared_cache_size},
+      statements_registry_{statements_registry},
       settings_{settings},
       default_cmd_ctls_(default_cmd_ctls),
       testsuite_pg_ctl_{testsuite_pg_ctl},
@@ -207,6 +261,7 @@ void ConnectionImpl::AsyncConnect(const Dsn& dsn, engine::Deadline deadline) {
   if (settings_.user_types == ConnectionSettings::kUserTypesEnabled) {
     LoadUserTypes(deadline);
   }
+  WarmupPreparedStatements(deadline);
 }
 
 void ConnectionImpl::Close() { conn_wrapper_.Close().Wait(); }
@@ -339,11 +394,128 @@ ResultSet ConnectionImpl::ExecuteCommand(
   TimeoutDuration execute_timeout = !!statement_cmd_ctl
                                         ? statement_cmd_ctl->execute
                                         : CurrentExecuteTimeout();
-  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(execute_timeout);
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(execute_timeout));
   SetStatementTimeout(std::move(statement_cmd_ctl));
   return ExecuteCommand(query, params, deadline);
 }
 
+QueryBatchResult ConnectionImpl::ExecuteBatch(
+    const QueryBatch& batch, OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration execute_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(execute_timeout));
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  const auto& statements = batch.GetStatements();
+  std::vector<DynamicQueryParameters> params(statements.size());
+  for (std::size_t i = 0; i < statements.size(); ++i) {
+    statements[i].write_params(db_types_, params[i]);
+  }
+
+  QueryBatchResult result;
+  if (statements.empty()) return result;
+
+#if LIBPQ_HAS_PIPELINING
+  // statements of the batch must stay prepared until they are executed
+  const bool can_pipeline =
+      settings_.prepared_statements ==
+          ConnectionSettings::kNoPreparedStatements ||
+      statements.size() <= settings_.max_prepared_cache_size;
+#else
+  const bool can_pipeline = false;
+#endif
+  if (!can_pipeline) {
+    for (std::size_t i = 0; i < statements.size(); ++i) {
+      try {
+        result.AddResult(ExecuteCommand(
+            statements[i].query, QueryParameters{params[i]}, deadline));
+      } catch (const ConnectionError&) {
+        throw;
+      } catch (const ConnectionInterrupted&) {
+        throw;
+      } catch (const Error&) {
+        result.AddError(std::current_exception());
+      }
+    }
+    return result;
+  }
+
+  DiscardOldPreparedStatements(deadline);
+  CheckDeadlineReached(deadline);
+  tracing::Span span{scopes::kBatch};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag("db.batch_size", statements.size());
+  auto scope = span.CreateScopeTime();
+  CountBatchExecute count_execute(stats_, statements.size());
+
+  // Prepared statements are prepared beforehand, which takes round trips only
+  // for the new statements
+  std::vector<PreparedStatementInfo> prepared;
+  if (settings_.prepared_statements !=
+      ConnectionSettings::kNoPreparedStatements) {
+    prepared.reserve(statements.size());
+    for (std::size_t i = 0; i < statements.size(); ++i) {
+      const auto& statement = statements[i].query.Statement();
+      const QueryParameters query_params{params[i]};
+      if (settings_.ignore_unused_query_params ==
+          ConnectionSettings::kCheckUnused) {
+        CheckQueryParameters(statement, query_params);
+      }
+      prepared.push_back(
+          PrepareStatement(statement, query_params, deadline, span, scope));
+    }
+  }
+
+  const bool enter_pipeline = !IsPipelineActive();
+  if (enter_pipeline) conn_wrapper_.EnterPipelineMode();
+
+  scope.Reset(scopes::kExec);
+  conn_wrapper_.SendPipelineSync();
+  for (std::size_t i = 0; i < statements.size(); ++i) {
+    const QueryParameters query_params{params[i]};
+    if (prepared.empty()) {
+      conn_wrapper_.SendQuery(statements[i].query.Statement(), query_params,
+                              scope);
+    } else {
+      conn_wrapper_.SendPreparedQuery(prepared[i].statement_name, query_params,
+                                      scope);
+    }
+    conn_wrapper_.SendPipelineSync();
+  }
+
+  std::vector<PGConnectionWrapper::ResultOrError> results;
+  try {
+    results = conn_wrapper_.WaitPipelineResults(statements.size(), deadline,
+                                                scope);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+  if (enter_pipeline) conn_wrapper_.ExitPipelineMode();
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    if (auto* error = std::get_if<std::exception_ptr>(&results[i])) {
+      span.AddTag(tracing::kErrorFlag, true);
+      result.AddError(*error);
+      continue;
+    }
+
+    auto& res = std::get<ResultSet>(results[i]);
+    if (!prepared.empty() && !prepared[i].description.IsEmpty()) {
+      res.SetBufferCategoriesFrom(prepared[i].description);
+    } else if (!res.IsEmpty()) {
+      FillBufferCategories(res);
+    }
+    result.AddResult(std::move(res));
+  }
+  count_execute.AccountResults(result);
+  return result;
+}
+
 void ConnectionImpl::Begin(const TransactionOptions& options,
                            SteadyClock::time_point trx_start_time,
                            OptionalCommandControl trx_cmd_ctl) {
@@ -421,7 +593,8 @@ Connection::StatementId ConnectionImpl::PortalBind(
   TimeoutDuration network_timeout = !!statement_cmd_ctl
                                         ? statement_cmd_ctl->execute
                                         : CurrentExecuteTimeout();
-  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout));
   SetStatementTimeout(std::move(statement_cmd_ctl));
 
   tracing::Span span{scopes::kQuery};
@@ -450,7 +623,8 @@ ResultSet ConnectionImpl::PortalExecute(
                                         ? statement_cmd_ctl->execute
                                         : CurrentExecuteTimeout();
 
-  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout));
   SetStatementTimeout(std::move(statement_cmd_ctl));
 
   auto* prepared_info = prepared_.Get(statement_id);
@@ -462,7 +636,7 @@ ResultSet ConnectionImpl::PortalExecute(
   conn_wrapper_.FillSpanTags(span);
   span.AddTag(tracing::kDatabaseStatement, prepared_info->statement);
   if (deadline.IsReached()) {
-    ++stats_.execute_timeout;
+    if (!IsTaskDeadlineReached()) ++stats_.execute_timeout;
     // TODO Portal name function, logging 'unnamed portal' for an empty name
     LOG_LIMITED_WARNING()
         << "Deadline was reached before starting to execute portal `"
@@ -477,13 +651,315 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
-void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
-  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
+void ConnectionImpl::CopyInStart(const std::string& statement,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(statement, PGRES_COPY_IN, std::move(statement_cmd_ctl));
+}
+
+void ConnectionImpl::CopyInData(const char* data, std::size_t size) {
+  UASSERT(stream_);
+  conn_wrapper_.PutCopyData(data, size, MakeStreamDeadline());
+}
+
+std::size_t ConnectionImpl::CopyInEnd() {
+  UASSERT(stream_);
+  auto deadline = MakeStreamDeadline();
+  tracing::Span span{scopes::kCopy};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, stream_->statement);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    conn_wrapper_.PutCopyEnd(nullptr, deadline);
+    auto res = conn_wrapper_.WaitResult(deadline, scope);
+    FinishStream(true);
+    return res.RowsAffected();
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    FinishStream(false);
+    throw;
+  }
+}
+
+void ConnectionImpl::CopyInAbort(const std::string& message) {
+  // the copy is already finished by an error
+  if (!stream_) return;
+  auto deadline = MakeStreamDeadline();
+  tracing::Span span{scopes::kCopy};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, stream_->statement);
+  span.AddTag(tracing::kErrorFlag, true);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    conn_wrapper_.PutCopyEnd(message.c_str(), deadline);
+    conn_wrapper_.WaitResult(deadline, scope);
+  } catch (const QueryCancelled&) {
+    // the server reports the message of the failed copy
+  } catch (const std::exception&) {
+    FinishStream(false);
+    throw;
+  }
+  FinishStream(false);
+}
+
+void ConnectionImpl::CopyOutStart(const std::string& statement,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(statement, PGRES_COPY_OUT, std::move(statement_cmd_ctl));
+}
+
+bool ConnectionImpl::CopyOutData(std::string& data) {
+  UASSERT(stream_);
+  auto deadline = MakeStreamDeadline();
+  if (conn_wrapper_.GetCopyData(data, deadline)) return true;
+
+  tracing::Span span{scopes::kCopy};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, stream_->statement);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    conn_wrapper_.WaitResult(deadline, scope);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    FinishStream(false);
+    throw;
+  }
+  FinishStream(true);
+  return false;
+}
+
+void ConnectionImpl::CopyOutAbort() {
+  // the copy is already finished by an error
+  if (!stream_) return;
+  auto deadline = MakeStreamDeadline();
+  tracing::Span span{scopes::kCopy};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, stream_->statement);
+  span.AddTag(tracing::kErrorFlag, true);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  // The server does not stop sending the data until it gets a cancel request
+  auto cancel = conn_wrapper_.Cancel();
+  try {
+    std::string data;
+    while (conn_wrapper_.GetCopyData(data, deadline)) data.clear();
+    conn_wrapper_.WaitResult(deadline, scope);
+  } catch (const QueryCancelled&) {
+    // the expected result of the cancelled copy
+  } catch (const std::exception&) {
+    cancel.WaitUntil(deadline);
+    FinishStream(false);
+    throw;
+  }
+  cancel.WaitUntil(deadline);
+  FinishStream(false);
+}
+
+void ConnectionImpl::ResultStreamStart(
+    const Query& query, const QueryParameters& params, std::size_t chunk_rows,
+    OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration network_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout));
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  const auto& statement = query.Statement();
+  auto span = MakeQuerySpan(query);
+  CheckDeadlineReached(deadline);
+  auto scope = span.CreateScopeTime();
+
+  // the rows of a query in pipeline are not received until the sync point
+  const bool pipeline_exited = LeavePipelineMode(deadline, scope);
+  StartStream(statement, network_timeout, pipeline_exited);
+  try {
+    if (settings_.prepared_statements ==
+        ConnectionSettings::kNoPreparedStatements) {
+      conn_wrapper_.SendQuery(statement, params, scope);
+    } else {
+      if (settings_.ignore_unused_query_params ==
+          ConnectionSettings::kCheckUnused) {
+        CheckQueryParameters(statement, params);
+      }
+      DiscardOldPreparedStatements(deadline);
+      const auto& prepared_info =
+          PrepareStatement(statement, params, deadline, span, scope);
+      scope.Reset(scopes::kExec);
+      conn_wrapper_.SendPreparedQuery(prepared_info.statement_name, params,
+                                      scope);
+    }
+    conn_wrapper_.SetRowsStreamingMode(chunk_rows);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    FinishStream(false);
+    throw;
+  }
+}
+
+std::optional<ResultSet> ConnectionImpl::ResultStreamFetch() {
+  UASSERT(stream_);
+  std::optional<ResultSet> rows;
+  try {
+    rows = conn_wrapper_.WaitRowsChunk(MakeStreamDeadline());
+  } catch (const std::exception&) {
+    FinishStream(false);
+    throw;
+  }
+  if (!rows) {
+    FinishStream(true);
+    return rows;
+  }
+
+  // all the chunks have the same fields
+  if (stream_->description) {
+    rows->SetBufferCategoriesFrom(*stream_->description);
+  } else {
+    FillBufferCategories(*rows);
+    stream_->description = *rows;
+  }
+  return rows;
+}
+
+void ConnectionImpl::ResultStreamAbort() {
+  // the stream is already finished by an error
+  if (!stream_) return;
+  auto deadline = MakeStreamDeadline();
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, stream_->statement);
+  span.AddTag(tracing::kErrorFlag, true);
+  auto cancel = conn_wrapper_.Cancel();
+  try {
+    while (conn_wrapper_.WaitRowsChunk(deadline)) {
+    }
+  } catch (const QueryCancelled&) {
+    // the expected result of the cancelled query
+  } catch (const std::exception&) {
+    cancel.WaitUntil(deadline);
+    FinishStream(false);
+    throw;
+  }
+  cancel.WaitUntil(deadline);
+  FinishStream(false);
+}
+
+void ConnectionImpl::Listen(std::string_view channel,
+                            OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration execute_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(execute_timeout));
+  // LISTEN cannot be prepared
+  ExecuteCommandNoPrepare(
+      "LISTEN " + conn_wrapper_.EscapeIdentifier(channel), deadline);
+}
+
+void ConnectionImpl::Unlisten(std::string_view channel,
+                              OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration execute_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(execute_timeout));
+  ExecuteCommandNoPrepare(
+      "UNLISTEN " + conn_wrapper_.EscapeIdentifier(channel), deadline);
+  // the connection returns to the pool, the next listener must not get them
+  conn_wrapper_.DiscardNotifications();
+}
+
+Notification ConnectionImpl::WaitNotify(engine::Deadline deadline) {
+  CheckBusy();
+  return conn_wrapper_.WaitNotify(deadline);
+}
 
+void ConnectionImpl::StartCopy(const std::string& statement,
+                               ExecStatusType copy_status,
+                               OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration network_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = LimitByTaskDeadline(
+      testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout));
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  tracing::Span span{scopes::kCopy};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(tracing::kDatabaseStatement, statement);
+  CheckDeadlineReached(deadline);
+  auto scope = span.CreateScopeTime();
+
+  // COPY is not allowed in pipeline mode
+  const bool pipeline_exited = LeavePipelineMode(deadline, scope);
+  StartStream(statement, network_timeout, pipeline_exited);
+  try {
+    scope.Reset(scopes::kExec);
+    conn_wrapper_.SendQuery(statement, scope);
+    if (conn_wrapper_.WaitCopyStart(deadline, scope) != copy_status) {
+      // the data of the copy in a wrong direction cannot be handled
+      conn_wrapper_.MarkAsBroken();
+      throw LogicError{"Unexpected direction of COPY statement"};
+    }
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    FinishStream(false);
+    throw;
+  }
+}
+
+bool ConnectionImpl::LeavePipelineMode(engine::Deadline deadline,
+                                       tracing::ScopeTime& scope) {
+  if (!IsPipelineActive()) return false;
+  // the pipeline mode is restored when the stream is finished
+  conn_wrapper_.WaitResult(deadline, scope);
+  conn_wrapper_.ExitPipelineMode();
+  return true;
+}
+
+void ConnectionImpl::StartStream(std::string statement,
+                                 TimeoutDuration network_timeout,
+                                 bool pipeline_exited) {
+  ++stats_.execute_total;
+  stream_.emplace(StreamState{std::move(statement), network_timeout,
+                              SteadyClock::now(), pipeline_exited, {}});
+}
+
+engine::Deadline ConnectionImpl::MakeStreamDeadline() const {
+  UASSERT(stream_);
+  return testsuite_pg_ctl_.MakeExecuteDeadline(stream_->network_timeout);
+}
+
+void ConnectionImpl::FinishStream(bool success) {
+  if (!stream_) return;
+  const auto now = SteadyClock::now();
+  if (!success) ++stats_.error_execute_total;
+  stats_.sum_query_duration += now - stream_->start_time;
+  stats_.last_execute_finish = now;
+  const bool restore_pipeline = stream_->pipeline_exited;
+  stream_.reset();
+
+  const auto state = GetConnectionState();
+  if (restore_pipeline && state != ConnectionState::kOffline &&
+      state != ConnectionState::kTranActive) {
+    conn_wrapper_.EnterPipelineMode();
+  }
+}
+
+void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto state = GetConnectionState();
   if (state == ConnectionState::kOffline) {
     return;
   }
+  // A statement interrupted by the deadline of the handled request is still
+  // within its own timeout, so it is likely to finish without cancelling
+  if (std::exchange(is_task_deadline_timeout_, false) &&
+      state == ConnectionState::kTranActive && Cleanup(timeout / 2)) {
+    return;
+  }
+
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
   if (GetConnectionState() == ConnectionState::kTranActive) {
     auto cancel = conn_wrapper_.Cancel();
     // May throw on timeout
@@ -561,7 +1037,7 @@ void ConnectionImpl::CheckBusy() const {
 
 void ConnectionImpl::CheckDeadlineReached(const engine::Deadline& deadline) {
   if (deadline.IsReached()) {
-    ++stats_.execute_timeout;
+    if (!IsTaskDeadlineReached()) ++stats_.execute_timeout;
     LOG_LIMITED_WARNING()
         << "Deadline was reached before starting to execute statement";
     throw ConnectionTimeoutError{"Deadline reached before executing"};
@@ -676,16 +1152,35 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
       throw;
     }
 
-    conn_wrapper_.SendDescribePrepared(statement_name, scope);
+    std::optional<ResultSet> shared_description;
+    if (statements_registry_) {
+      shared_description = statements_registry_->GetDescription(query_id);
+    }
     statement_info = prepared_.Get(query_id);
-    auto res = conn_wrapper_.WaitResult(deadline, scope);
-    if (!res.pimpl_) {
-      throw CommandError("WaitResult() returned nullptr");
+    if (shared_description) {
+      // the statement is already described by another connection of the pool
+      statement_info->description = std::move(*shared_description);
+    } else {
+      conn_wrapper_.SendDescribePrepared(statement_name, scope);
+      auto res = conn_wrapper_.WaitResult(deadline, scope);
+      if (!res.pimpl_) {
+        throw CommandError("WaitResult() returned nullptr");
+      }
+      FillBufferCategories(res);
+      statement_info->description = res;
+      // Ensure we've got binary format established
+      res.GetRowDescription().CheckBinaryFormat(db_types_);
+    }
+    if (statements_registry_) {
+      std::vector<Oid> param_types;
+      if (!params.Empty()) {
+        param_types.assign(params.ParamTypesBuffer(),
+                           params.ParamTypesBuffer() + params.Size());
+      }
+      statements_registry_->Register({query_id, statement,
+                                      std::move(param_types),
+                                      statement_info->description});
     }
-    FillBufferCategories(res);
-    statement_info->description = res;
-    // Ensure we've got binary format established
-    res.GetRowDescription().CheckBinaryFormat(db_types_);
     ++stats_.parse_total;
     return *statement_info;
   }
@@ -696,11 +1191,53 @@ void ConnectionImpl::DiscardOldPreparedStatements(engine::Deadline deadline) {
   if (is_discard_prepared_pending_ && !IsInTransaction()) {
     LOG_DEBUG() << "Discarding prepared statements";
     prepared_.Clear();
+    // the shared descriptions may be outdated as well
+    if (statements_registry_) statements_registry_->Clear();
     ExecuteCommandNoPrepare("DEALLOCATE ALL", deadline);
     is_discard_prepared_pending_ = false;
   }
 }
 
+void ConnectionImpl::WarmupPreparedStatements(engine::Deadline deadline) {
+  if (!statements_registry_ || !settings_.warmup_prepared_statements ||
+      settings_.prepared_statements ==
+          ConnectionSettings::kNoPreparedStatements) {
+    return;
+  }
+  const auto statements = statements_registry_->GetHotStatements(std::min(
+      settings_.warmup_prepared_statements, settings_.max_prepared_cache_size));
+  if (statements.empty()) return;
+
+  tracing::Span span{scopes::kPrepare};
+  auto scope = span.CreateScopeTime();
+  std::size_t prepared = 0;
+  for (const auto& info : statements) {
+    // the connection is usable without the statements prepared in advance
+    if (deadline.IsReached()) break;
+    ParamTypesHolder param_types{info.param_types};
+    const QueryParameters params{param_types};
+    auto statement_name =
+        "q" + std::to_string(info.id.GetUnderlying()) + "_" + uuid_;
+    conn_wrapper_.SendPrepare(statement_name, info.statement, params, scope);
+    try {
+      conn_wrapper_.WaitResult(deadline, scope);
+    } catch (const ConnectionError&) {
+      throw;
+    } catch (const Error& e) {
+      // e.g. the statement uses a table that is dropped since
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << info.statement << "` in advance: " << e;
+      continue;
+    }
+    prepared_.Put(info.id, {info.id, info.statement, std::move(statement_name),
+                            info.description});
+    ++prepared;
+  }
+  stats_.parse_total += prepared;
+  LOG_DEBUG() << "Prepared " << prepared << " of " << statements.size()
+              << " statements in advance";
+}
+
 void ConnectionImpl::DiscardPreparedStatement(const PreparedStatementInfo& info,
                                               engine::Deadline deadline) {
   LOG_DEBUG() << "Discarding prepared statement " << info.statement_name;
@@ -847,6 +1384,7 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
                                      Counter& counter, tracing::Span& span,
                                      tracing::ScopeTime& scope,
                                      const ResultSet* description_ptr) {
+  is_task_deadline_timeout_ = false;
   try {
     auto res = conn_wrapper_.WaitResult(deadline, scope);
     if (description_ptr && !description_ptr->IsEmpty()) {
@@ -865,11 +1403,21 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
     span.AddTag(tracing::kErrorFlag, true);
     throw;
   } catch (const ConnectionTimeoutError& e) {
-    ++stats_.execute_timeout;
-    LOG_LIMITED_WARNING() << "Statement `" << statement
-                          << "` network timeout error: " << e << ". "
-                          << "Network timeout was " << network_timeout.count()
-                          << "ms";
+    if (IsTaskDeadlineReached()) {
+      // The statement is still in flight, give it a chance to finish on
+      // cleanup instead of cancelling it
+      is_task_deadline_timeout_ = true;
+      LOG_LIMITED_INFO() << "Statement `" << statement
+                         << "` was interrupted by the deadline of the "
+                            "handled request: "
+                         << e;
+    } else {
+      ++stats_.execute_timeout;
+      LOG_LIMITED_WARNING()
+          << "Statement `" << statement << "` network timeout error: " << e
+          << ". "
+          << "Network timeout was " << network_timeout.count() << "ms";
+    }
     span.AddTag(tracing::kErrorFlag, true);
     throw;
   } catch (const QueryCancelled& e) {
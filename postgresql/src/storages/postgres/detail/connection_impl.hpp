@@ -16,10 +16,12 @@
 #include <storages/postgres/default_command_controls.hpp>
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_connection_wrapper.hpp>
+#include <storages/postgres/detail/statements_registry.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,7 +35,8 @@ class ConnectionImpl {
                  const DefaultCommandControls& default_cmd_ctls,
                  const testsuite::PostgresControl& testsuite_pg_ctl,
                  const error_injection::Settings& ei_settings,
-                 Connection::SizeGuard&& size_guard);
+                 Connection::SizeGuard&& size_guard,
+                 StatementsRegistry* statements_registry);
 
   void AsyncConnect(const Dsn& dsn, engine::Deadline deadline);
   void Close();
@@ -63,6 +66,9 @@ class ConnectionImpl {
                            const detail::QueryParameters& params,
                            OptionalCommandControl statement_cmd_ctl);
 
+  QueryBatchResult ExecuteBatch(const QueryBatch& batch,
+                                OptionalCommandControl statement_cmd_ctl);
+
   void Begin(const TransactionOptions& options,
              SteadyClock::time_point trx_start_time,
              OptionalCommandControl trx_cmd_ctl = {});
@@ -81,6 +87,29 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  void CopyInStart(const std::string& statement,
+                   OptionalCommandControl statement_cmd_ctl);
+  void CopyInData(const char* data, std::size_t size);
+  std::size_t CopyInEnd();
+  void CopyInAbort(const std::string& message);
+
+  void CopyOutStart(const std::string& statement,
+                    OptionalCommandControl statement_cmd_ctl);
+  bool CopyOutData(std::string& data);
+  void CopyOutAbort();
+
+  void Listen(std::string_view channel,
+              OptionalCommandControl statement_cmd_ctl);
+  void Unlisten(std::string_view channel,
+                OptionalCommandControl statement_cmd_ctl);
+  Notification WaitNotify(engine::Deadline deadline);
+
+  void ResultStreamStart(const Query& query, const QueryParameters& params,
+                         std::size_t chunk_rows,
+                         OptionalCommandControl statement_cmd_ctl);
+  std::optional<ResultSet> ResultStreamFetch();
+  void ResultStreamAbort();
+
   void CancelAndCleanup(TimeoutDuration timeout);
   bool Cleanup(TimeoutDuration timeout);
 
@@ -107,6 +136,15 @@ class ConnectionImpl {
   using PreparedStatements =
       cache::LruMap<Connection::StatementId, PreparedStatementInfo>;
 
+  /// A statement whose data is transferred by several calls
+  struct StreamState {
+    std::string statement;
+    TimeoutDuration network_timeout{};
+    SteadyClock::time_point start_time;
+    bool pipeline_exited{false};
+    std::optional<ResultSet> description;
+  };
+
   struct ResetTransactionCommandControl;
 
   void CheckBusy() const;
@@ -130,6 +168,8 @@ class ConnectionImpl {
       engine::Deadline deadline, tracing::Span& span,
       tracing::ScopeTime& scope);
   void DiscardOldPreparedStatements(engine::Deadline deadline);
+  /// Prepares the hot statements of the pool in advance
+  void WarmupPreparedStatements(engine::Deadline deadline);
   void DiscardPreparedStatement(const PreparedStatementInfo& info,
                                 engine::Deadline deadline);
 
@@ -164,16 +204,28 @@ class ConnectionImpl {
                        tracing::Span& span, tracing::ScopeTime& scope,
                        const ResultSet* description_ptr);
 
+  void StartCopy(const std::string& statement, ExecStatusType copy_status,
+                 OptionalCommandControl statement_cmd_ctl);
+  /// Completes the commands sent in pipeline mode and exits it, returns true
+  /// if the pipeline mode was active
+  bool LeavePipelineMode(engine::Deadline deadline, tracing::ScopeTime& scope);
+  void StartStream(std::string statement, TimeoutDuration network_timeout,
+                   bool pipeline_exited);
+  engine::Deadline MakeStreamDeadline() const;
+  void FinishStream(bool success);
+
   void Cancel();
 
   const std::string uuid_;
   Connection::Statistics stats_;
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  StatementsRegistry* statements_registry_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
   bool is_discard_prepared_pending_ = false;
+  bool is_task_deadline_timeout_ = false;
   ConnectionSettings settings_;
 
   CommandControl default_cmd_ctl_{{}, {}};
@@ -181,6 +233,7 @@ class ConnectionImpl {
   testsuite::PostgresControl testsuite_pg_ctl_;
   OptionalCommandControl transaction_cmd_ctl_;
   TimeoutDuration current_statement_timeout_{};
+  std::optional<StreamState> stream_;
   const error_injection::Settings ei_settings_;
 };
 
@@ -25,6 +25,11 @@ ResultSet NonTransaction::Execute(OptionalCommandControl statement_cmd_ctl,
                    statement_cmd_ctl);
 }
 
+QueryBatchResult NonTransaction::ExecuteBatch(
+    OptionalCommandControl statement_cmd_ctl, const QueryBatch& batch) {
+  return conn_->ExecuteBatch(batch, statement_cmd_ctl);
+}
+
 ResultSet NonTransaction::DoExecute(const Query& query,
                                     const detail::QueryParameters& params,
                                     OptionalCommandControl statement_cmd_ctl) {
@@ -401,6 +401,28 @@ bool PGConnectionWrapper::IsPipelineActive() const {
 #endif
 }
 
+void PGConnectionWrapper::ExitPipelineMode() {
+#if LIBPQ_HAS_PIPELINING
+  if (!PQexitPipelineMode(conn_)) {
+    PGCW_LOG_LIMITED_ERROR() << "libpq failed to exit pipeline connection mode";
+    throw ConnectionError{"Failed to exit pipeline connection mode"};
+  }
+  PGCW_LOG_DEBUG() << "Exited pipeline mode";
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
+void PGConnectionWrapper::SendPipelineSync() {
+#if LIBPQ_HAS_PIPELINING
+  HandleSocketPostClose();
+  CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
+  UpdateLastUse();
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
 void PGConnectionWrapper::RefreshSocket(const Dsn& dsn) {
   const auto fd = PQsocket(conn_);
   if (fd < 0) {
@@ -434,6 +456,10 @@ void PGConnectionWrapper::Flush(Deadline deadline) {
     is_syncing_pipeline_ = true;
   }
 #endif
+  FlushOutput(deadline);
+}
+
+void PGConnectionWrapper::FlushOutput(Deadline deadline) {
   while (const int flush_res = PQflush(conn_)) {
     if (flush_res < 0) {
       HandleSocketPostClose();
@@ -512,6 +538,53 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+std::vector<PGConnectionWrapper::ResultOrError>
+PGConnectionWrapper::WaitPipelineResults(std::size_t count, Deadline deadline,
+                                         tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  FlushOutput(deadline);
+
+  std::vector<ResultOrError> results;
+  results.reserve(count);
+  // results of the commands sent before the batch, e.g. BEGIN
+  MakeResult(WaitPipelineSync(deadline));
+
+  while (results.size() < count) {
+    auto handle = WaitPipelineSync(deadline);
+    try {
+      results.emplace_back(MakeResult(std::move(handle)));
+    } catch (const std::exception&) {
+      // the connection is closed on fatal errors
+      if (!conn_) throw;
+      results.emplace_back(std::current_exception());
+    }
+  }
+  return results;
+}
+
+PGConnectionWrapper::ResultHandle PGConnectionWrapper::WaitPipelineSync(
+    Deadline deadline) {
+  auto handle = MakeResultHandle(nullptr);
+#if LIBPQ_HAS_PIPELINING
+  while (true) {
+    ConsumeInput(deadline);
+    auto next_handle = MakeResultHandle(PQXgetResult(conn_));
+    if (!next_handle) {
+      // end of the results of a command
+      if (PQstatus(conn_) == CONNECTION_BAD) {
+        CloseWithError(ConnectionError{"Connection lost in a pipeline"});
+      }
+      continue;
+    }
+    if (PQresultStatus(next_handle.get()) == PGRES_PIPELINE_SYNC) break;
+    handle = std::move(next_handle);
+  }
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+  return handle;
+}
+
 void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   Flush(deadline);
   auto handle = MakeResultHandle(nullptr);
@@ -519,6 +592,11 @@ void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   do {
     while (auto* pg_res = PQXgetResult(conn_)) {
       handle = MakeResultHandle(pg_res);
+      const auto status = PQresultStatus(handle.get());
+      if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT) {
+        // libpq returns the same status until the copy is ended
+        DiscardCopy(status, deadline);
+      }
       ConsumeInput(deadline);
 #if LIBPQ_HAS_PIPELINING
       if (is_syncing_pipeline_ &&
@@ -530,6 +608,190 @@ void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   } while (is_syncing_pipeline_);
 }
 
+void PGConnectionWrapper::SetRowsStreamingMode(
+    [[maybe_unused]] std::size_t chunk_rows) {
+#if LIBPQ_HAS_CHUNK_MODE
+  if (chunk_rows > 1) {
+    CheckError<CommandError>(
+        "PQsetChunkedRowsMode",
+        PQsetChunkedRowsMode(conn_, static_cast<int>(chunk_rows)));
+    return;
+  }
+#endif
+  CheckError<CommandError>("PQsetSingleRowMode", PQsetSingleRowMode(conn_));
+}
+
+std::optional<ResultSet> PGConnectionWrapper::WaitRowsChunk(
+    Deadline deadline) {
+  FlushOutput(deadline);
+  ConsumeInput(deadline);
+  auto handle = MakeResultHandle(PQXgetResult(conn_));
+  if (!handle) return std::nullopt;
+  switch (PQresultStatus(handle.get())) {
+    case PGRES_SINGLE_TUPLE:
+#if LIBPQ_HAS_CHUNK_MODE
+    case PGRES_TUPLES_CHUNK:
+#endif
+      UpdateLastUse();
+      return MakeResult(std::move(handle));
+    default:
+      break;
+  }
+  // the final result of the query, possibly an error
+  while (true) {
+    ConsumeInput(deadline);
+    auto next_handle = MakeResultHandle(PQXgetResult(conn_));
+    if (!next_handle) break;
+    handle = std::move(next_handle);
+  }
+  MakeResult(std::move(handle));
+  return std::nullopt;
+}
+
+ExecStatusType PGConnectionWrapper::WaitCopyStart(Deadline deadline,
+                                                  tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  FlushOutput(deadline);
+  ConsumeInput(deadline);
+  auto handle = MakeResultHandle(PQXgetResult(conn_));
+  if (handle) {
+    const auto status = PQresultStatus(handle.get());
+    if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT) {
+      UpdateLastUse();
+      return status;
+    }
+  }
+  while (handle) {
+    ConsumeInput(deadline);
+    auto next_handle = MakeResultHandle(PQXgetResult(conn_));
+    if (!next_handle) break;
+    handle = std::move(next_handle);
+  }
+  // throws the error of the statement, if any
+  MakeResult(std::move(handle));
+  throw LogicError{"The statement does not start a COPY"};
+}
+
+void PGConnectionWrapper::PutCopyData(const char* data, std::size_t size,
+                                      Deadline deadline) {
+  while (true) {
+    const int res = PQputCopyData(conn_, data, static_cast<int>(size));
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQputCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    // libpq buffer is full, wait for the server to take the data
+    FlushOutput(deadline);
+  }
+  FlushOutput(deadline);
+  UpdateLastUse();
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  while (true) {
+    const int res = PQputCopyEnd(conn_, error_message);
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQputCopyEnd execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    FlushOutput(deadline);
+  }
+  FlushOutput(deadline);
+  UpdateLastUse();
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& data, Deadline deadline) {
+  while (true) {
+    char* buffer = nullptr;
+    const int res = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (res > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> guard{buffer,
+                                                              &PQfreemem};
+      data.append(buffer, res);
+      UpdateLastUse();
+      return true;
+    }
+    if (res == -1) return false;
+    if (res < -1) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQgetCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    // no complete row is received yet
+    HandleSocketPostClose();
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while receiving copy data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while receiving copy data from PostgreSQL connection";
+      throw ConnectionTimeoutError("Timed out while receiving copy data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  }
+}
+
+Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
+  // the notifications may have arrived along with the previous results
+  CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  while (true) {
+    if (auto* notify = PQnotifies(conn_)) {
+      const std::unique_ptr<PGnotify, decltype(&PQfreemem)> guard{notify,
+                                                                  &PQfreemem};
+      UpdateLastUse();
+      return {notify->relname, notify->extra ? notify->extra : ""};
+    }
+    HandleSocketPostClose();
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted(
+            "Task cancelled while waiting for a notification");
+      }
+      if (!socket_.IsValid()) {
+        throw ConnectionError("Connection closed while waiting for a "
+                              "notification");
+      }
+      // the lack of notifications is not an error, don't log it
+      throw ConnectionTimeoutError(
+          "Timed out while waiting for a notification");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  }
+}
+
+void PGConnectionWrapper::DiscardNotifications() {
+  while (auto* notify = PQnotifies(conn_)) {
+    PQfreemem(notify);
+  }
+}
+
+std::string PGConnectionWrapper::EscapeIdentifier(std::string_view identifier) {
+  const std::unique_ptr<char, decltype(&PQfreemem)> escaped{
+      PQescapeIdentifier(conn_, identifier.data(), identifier.size()),
+      &PQfreemem};
+  if (!escaped) {
+    throw LogicError{std::string{"PQescapeIdentifier error: "} +
+                     PQerrorMessage(conn_)};
+  }
+  return escaped.get();
+}
+
+void PGConnectionWrapper::DiscardCopy(ExecStatusType status,
+                                      Deadline deadline) {
+  PGCW_LOG_LIMITED_WARNING() << "Discarding an unfinished COPY";
+  if (status == PGRES_COPY_IN) {
+    PutCopyEnd("COPY is discarded by the client", deadline);
+  } else {
+    std::string data;
+    while (GetCopyData(data, deadline)) data.clear();
+  }
+}
+
 void PGConnectionWrapper::FillSpanTags(tracing::Span& span) const {
   span.AddTags(log_extra_, USERVER_NAMESPACE::utils::InternalTag{});
 }
@@ -553,9 +815,13 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
       PGCW_LOG_TRACE() << "Successful completion of a command returning data";
       break;
     case PGRES_SINGLE_TUPLE:
-      PGCW_LOG_LIMITED_ERROR()
-          << "libpq was switched to SINGLE_ROW mode, this is not supported.";
-      CloseWithError(NotImplemented{"Single row mode is not supported"});
+      PGCW_LOG_TRACE() << "Successful retrieval of a row in single-row mode";
+      break;
+#if LIBPQ_HAS_CHUNK_MODE
+    case PGRES_TUPLES_CHUNK:
+      PGCW_LOG_TRACE() << "Successful retrieval of rows in chunked mode";
+      break;
+#endif
     case PGRES_COPY_IN:
     case PGRES_COPY_OUT:
     case PGRES_COPY_BOTH:
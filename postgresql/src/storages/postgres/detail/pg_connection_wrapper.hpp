@@ -1,7 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <variant>
+#include <vector>
 
 #include <libpq-fe.h>
 
@@ -15,6 +20,7 @@
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/result_wrapper.hpp>
 #include <userver/storages/postgres/dsn.hpp>
+#include <userver/storages/postgres/notify.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -66,6 +72,17 @@ class PGConnectionWrapper {
   /// Check if pipeline mode is currenty enabled
   bool IsPipelineActive() const;
 
+  /// @brief Causes a connection to exit pipeline mode.
+  ///
+  /// All the results of the sent commands must be received.
+  void ExitPipelineMode();
+
+  /// @brief Wrapper for PQpipelineSync in pipeline mode.
+  ///
+  /// An error in a command does not affect the commands sent after the next
+  /// synchronization point.
+  void SendPipelineSync();
+
   /// @brief Close the connection on a background task processor.
   [[nodiscard]] engine::Task Close();
 
@@ -103,6 +120,67 @@ class PGConnectionWrapper {
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&);
 
+  using ResultOrError = std::variant<ResultSet, std::exception_ptr>;
+
+  /// @brief Wait for the results of `count` commands sent in pipeline mode.
+  ///
+  /// Expects a synchronization point before the first command and after each
+  /// command. The results of the commands sent before the first
+  /// synchronization point are discarded, except for the error of the last
+  /// one, which is thrown. The errors of the `count` commands are returned,
+  /// the connection errors are thrown.
+  std::vector<ResultOrError> WaitPipelineResults(std::size_t count,
+                                                 Deadline deadline,
+                                                 tracing::ScopeTime&);
+
+  /// @brief Switch the last sent query to the single-row mode (wrapper for
+  /// PQsetSingleRowMode) or to the mode of chunks of up to `chunk_rows` rows
+  /// if libpq supports it (wrapper for PQsetChunkedRowsMode).
+  void SetRowsStreamingMode(std::size_t chunk_rows);
+
+  /// @brief Wait for the next rows of the query in the single-row or chunked
+  /// mode.
+  ///
+  /// Returns std::nullopt after the end of the rows, throws the error of the
+  /// query.
+  std::optional<ResultSet> WaitRowsChunk(Deadline deadline);
+
+  /// @brief Wait for the start of `COPY ... FROM STDIN` or
+  /// `COPY ... TO STDOUT`.
+  ///
+  /// Returns PGRES_COPY_IN or PGRES_COPY_OUT, throws the error of the
+  /// statement or LogicError if the statement is not a COPY.
+  ExecStatusType WaitCopyStart(Deadline deadline, tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData, suspends the coroutine until the data
+  /// is sent.
+  void PutCopyData(const char* data, std::size_t size, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, the copy fails if `error_message` is
+  /// not null.
+  ///
+  /// The result of the COPY statement is obtained by WaitResult.
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData, appends a row of data to `data`.
+  ///
+  /// Returns false at the end of the data, the result of the COPY statement
+  /// is obtained by WaitResult.
+  bool GetCopyData(std::string& data, Deadline deadline);
+
+  /// @brief Wait for the next notification of the listened channels, suspends
+  /// the coroutine until it arrives.
+  ///
+  /// @throws ConnectionTimeoutError if the deadline is reached, the
+  /// connection stays usable
+  Notification WaitNotify(Deadline deadline);
+
+  /// Drops the notifications that are already received
+  void DiscardNotifications();
+
+  /// Wrapper for PQescapeIdentifier
+  std::string EscapeIdentifier(std::string_view identifier);
+
   /// Consume input from connection
   void ConsumeInput(Deadline deadline);
   /// Consume all input discarding all result sets
@@ -141,6 +219,14 @@ class PGConnectionWrapper {
 
   void Flush(Deadline deadline);
 
+  void FlushOutput(Deadline deadline);
+
+  /// Ends the COPY that was left unfinished
+  void DiscardCopy(ExecStatusType status, Deadline deadline);
+
+  /// Returns the last result before the next synchronization point
+  ResultHandle WaitPipelineSync(Deadline deadline);
+
   ResultSet MakeResult(ResultHandle&& handle);
 
   template <typename ExceptionType>
@@ -1,11 +1,15 @@
 #include <storages/postgres/detail/pool.hpp>
 
+#include <algorithm>
+
 #include <storages/postgres/detail/statement_timings_storage.hpp>
+#include <storages/postgres/detail/task_deadline.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 
@@ -27,6 +31,9 @@ constexpr std::chrono::seconds kMaintainInterval{30};
 constexpr std::chrono::seconds kMaxIdleDuration{15};
 constexpr const char* kMaintainTaskName = "pg_maintain";
 
+constexpr std::chrono::seconds kAdaptiveInterval{5};
+constexpr const char* kAdaptiveTaskName = "pg_adaptive_size";
+
 constexpr std::chrono::seconds kConnectingTimeout{2};
 
 // Max idle connections that can be dropped in one run of maintenance task
@@ -35,6 +42,14 @@ constexpr auto kIdleDropLimit = 1;
 // Practically unlimited number on concurrect establishing connections
 constexpr auto kUnlimitedConnecting = std::numeric_limits<std::size_t>::max();
 
+void UpdatePeak(std::atomic<std::size_t>& peak, std::size_t value) {
+  auto current = peak.load(std::memory_order_relaxed);
+  while (current < value &&
+         !peak.compare_exchange_weak(current, value,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
 class Stopwatch {
  public:
   using Accumulator =
@@ -73,6 +88,8 @@ ConnectionPool::ConnectionPool(
       conn_settings_{conn_settings},
       bg_task_processor_{bg_task_processor},
       queue_{settings.max_size},
+      stack_{settings.max_size},
+      lifo_{settings.lifo_acquire},
       size_{std::make_shared<std::atomic<size_t>>(0)},
       connecting_semaphore_{settings.connecting_limit
                                 ? settings.connecting_limit
@@ -83,7 +100,9 @@ ConnectionPool::ConnectionPool(
       ei_settings_(std::move(ei_settings)),
       cancel_limit_{std::max(std::size_t{1}, settings.max_size / kCancelRatio),
                     {1, kCancelPeriod}},
-      sts_{statement_metrics_settings} {}
+      throttler_{{settings.throttling_accepts_multiplier}},
+      sts_{statement_metrics_settings},
+      statements_registry_{conn_settings.max_prepared_cache_size} {}
 
 ConnectionPool::~ConnectionPool() {
   StopMaintainTask();
@@ -167,10 +186,16 @@ void ConnectionPool::Init(InitMode mode) {
 }
 
 ConnectionPtr ConnectionPool::Acquire(engine::Deadline deadline) {
+  if (!throttler_.Allow()) {
+    ++stats_.throttled_errors;
+    throw PoolError("Host is throttled, too many requests failed recently",
+                    db_name_);
+  }
+
   // Obtain smart pointer first to prolong lifetime of this object
   auto shared_this = shared_from_this();
   ConnectionPtr connection{Pop(deadline), std::move(shared_this)};
-  ++stats_.connection.used;
+  UpdatePeak(peak_used_, ++stats_.connection.used);
   connection->UpdateDefaultCommandControl();
   return connection;
 }
@@ -178,6 +203,9 @@ ConnectionPtr ConnectionPool::Acquire(engine::Deadline deadline) {
 void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
   auto now = SteadyClock::now();
 
+  // the connection is healthy and none of the queries timed out
+  if (conn_stats.execute_timeout == 0) throttler_.AccountAccepted();
+
   stats_.connection.prepared_statements.GetCurrentCounter().Account(
       conn_stats.prepared_statements_current);
 
@@ -299,11 +327,18 @@ const InstanceStatistics& ConnectionPool::GetStatistics() const {
   return stats_;
 }
 
+std::size_t ConnectionPool::GetInFlight() const {
+  return stats_.connection.used.Load() +
+         wait_count_.load(std::memory_order_relaxed);
+}
+
 Transaction ConnectionPool::Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl) {
   const auto trx_start_time = detail::SteadyClock::now();
-  const auto deadline =
-      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(trx_cmd_ctl));
+  // the wait for a connection is limited by the handled request deadline
+  const auto deadline = std::min(
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(trx_cmd_ctl)),
+      server::request::GetTaskInheritedDeadline());
   auto conn = Acquire(deadline);
   UASSERT(conn);
   return Transaction{std::move(conn), options, trx_cmd_ctl, trx_start_time};
@@ -311,13 +346,24 @@ Transaction ConnectionPool::Begin(const TransactionOptions& options,
 
 NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   const auto start_time = detail::SteadyClock::now();
-  const auto deadline =
-      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  const auto deadline = std::min(
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl)),
+      server::request::GetTaskInheritedDeadline());
   auto conn = Acquire(deadline);
   UASSERT(conn);
   return NonTransaction{std::move(conn), start_time};
 }
 
+NotifyScope ConnectionPool::Listen(std::string_view channel,
+                                   OptionalCommandControl cmd_ctl) {
+  const auto deadline = std::min(
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl)),
+      server::request::GetTaskInheritedDeadline());
+  auto conn = Acquire(deadline);
+  UASSERT(conn);
+  return NotifyScope{std::move(conn), channel, cmd_ctl};
+}
+
 TimeoutDuration ConnectionPool::GetExecuteTimeout(
     OptionalCommandControl cmd_ctl) const {
   if (cmd_ctl) return cmd_ctl->execute;
@@ -336,6 +382,8 @@ void ConnectionPool::SetSettings(const PoolSettings& settings) {
     connecting_semaphore_.SetCapacity(settings.connecting_limit
                                           ? settings.connecting_limit
                                           : kUnlimitedConnecting);
+  throttler_.SetSettings({settings.throttling_accepts_multiplier});
+  lifo_ = settings.lifo_acquire;
   settings_.Assign(settings);
 }
 
@@ -346,6 +394,9 @@ void ConnectionPool::SetConnectionSettings(const ConnectionSettings& settings) {
     *writer = settings;
     writer->version = old_version + 1;
     writer.Commit();
+    // the descriptions depend on the settings
+    statements_registry_.SetMaxSize(settings.max_prepared_cache_size);
+    statements_registry_.Clear();
   }
 }
 
@@ -375,7 +426,8 @@ engine::TaskWithResult<bool> ConnectionPool::Connect(
           shared_this->dsn_, shared_this->resolver_,
           shared_this->bg_task_processor_, conn_id, *conn_settings,
           shared_this->default_cmd_ctls_, shared_this->testsuite_pg_ctl_,
-          shared_this->ei_settings_, std::move(sg));
+          shared_this->ei_settings_, std::move(sg),
+          &shared_this->statements_registry_);
     } catch (const ConnectionTimeoutError&) {
       // No problem if it's connection error
       ++shared_this->stats_.connection.error_timeout;
@@ -426,9 +478,10 @@ void ConnectionPool::TryCreateConnectionAsync() {
 void ConnectionPool::CheckMinPoolSizeUnderflow() {
   auto settings = settings_.Read();
   auto count = size_->load(std::memory_order_relaxed);
-  if (count < settings->min_size) {
+  const auto min_size = GetMinSize(*settings);
+  if (count < min_size) {
     LOG_DEBUG() << "Current pool size is less than min_size (" << count << " < "
-                << settings->min_size << "). Create new connection.";
+                << min_size << "). Create new connection.";
     TryCreateConnectionAsync();
   }
 }
@@ -437,7 +490,7 @@ void ConnectionPool::Push(Connection* connection) {
   auto conn_settings = conn_settings_.Read();
   if (connection->GetSettings().version < conn_settings->version) {
     DropOutdatedConnection(connection);
-  } else if (queue_.push(connection)) {
+  } else if (PushIdle(connection)) {
     conn_available_.NotifyOne();
   } else {
     // TODO Reflect this as a statistics error
@@ -459,7 +512,7 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
   Stopwatch st{stats_.acquire_percentile};
   Connection* connection = nullptr;
   auto conn_settings = conn_settings_.Read();
-  while (queue_.pop(connection)) {
+  while (PopIdle(connection)) {
     if (connection->GetSettings().version < conn_settings->version) {
       DropOutdatedConnection(connection);
       continue;
@@ -469,6 +522,7 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
 
   auto settings = settings_.Read();
   SizeGuard wg(wait_count_);
+  UpdatePeak(peak_waiting_, wg.GetValue());
   if (wg.GetValue() > settings->max_queue_size) {
     ++stats_.queue_size_errors;
     throw PoolError("Wait queue size exceeded");
@@ -484,7 +538,7 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
     std::unique_lock<engine::Mutex> lock{wait_mutex_};
     // Wait for a connection
     if (conn_available_.WaitUntil(lock, deadline,
-                                  [&] { return queue_.pop(connection); })) {
+                                  [&] { return PopIdle(connection); })) {
       return connection;
     }
   }
@@ -493,13 +547,23 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
     throw PoolError("Task was cancelled while waiting for connection");
   }
 
-  ++stats_.pool_exhaust_errors;
+  // the pool is not to blame for the deadline of the handled request
+  if (!IsTaskDeadlineReached()) ++stats_.pool_exhaust_errors;
   throw PoolError("No available connections found", db_name_);
 }
 
+bool ConnectionPool::PushIdle(Connection* connection) {
+  return lifo_ ? stack_.push(connection) : queue_.push(connection);
+}
+
+bool ConnectionPool::PopIdle(Connection*& connection) {
+  if (lifo_) return stack_.pop(connection) || queue_.pop(connection);
+  return queue_.pop(connection) || stack_.pop(connection);
+}
+
 void ConnectionPool::Clear() {
   Connection* connection = nullptr;
-  while (queue_.pop(connection)) {
+  while (PopIdle(connection)) {
     delete connection;
   }
 }
@@ -520,10 +584,29 @@ void ConnectionPool::DropOutdatedConnection(Connection* connection) {
   DeleteConnection(connection);
 }
 
+void ConnectionPool::DropIdleConnections(std::size_t count) {
+  Connection* connection = nullptr;
+  while (count > 0 && PopIdle(connection)) {
+    --count;
+    LOG_DEBUG() << "Drop excess idle connection to `" << DsnCutPassword(dsn_)
+                << '`';
+    CloseIdleConnection(connection);
+  }
+}
+
+void ConnectionPool::CloseIdleConnection(Connection* connection) {
+  try {
+    connection->Close();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Exception while closing connection: " << e;
+  }
+  DeleteConnection(connection);
+}
+
 Connection* ConnectionPool::AcquireImmediate() {
   Connection* conn = nullptr;
   auto conn_settings = conn_settings_.Read();
-  while (queue_.pop(conn)) {
+  while (PopIdle(conn)) {
     if (conn->GetSettings().version < conn_settings->version) {
       DropOutdatedConnection(conn);
       continue;
@@ -545,10 +628,16 @@ void ConnectionPool::MaintainConnections() {
   }
 
   LOG_DEBUG() << "Ping connection pool " << DsnCutPassword(dsn_);
+  auto settings = settings_.Read();
+  if (settings->lifo_acquire) {
+    MaintainIdleTail(*settings);
+    CheckMinPoolSizeUnderflow();
+    return;
+  }
+
   auto stale_connection = true;
   auto count = size_->load(std::memory_order_relaxed);
   auto drop_left = kIdleDropLimit;
-  auto settings = settings_.Read();
   while (count > 0 && stale_connection) {
     try {
       auto deleter = [this](Connection* c) { DeleteConnection(c); };
@@ -560,7 +649,7 @@ void ConnectionPool::MaintainConnections() {
         break;
       }
       stale_connection = conn->GetIdleDuration() >= kMaxIdleDuration;
-      if (count > settings->min_size && drop_left > 0) {
+      if (count > GetMinSize(*settings) && drop_left > 0) {
         --drop_left;
         --stats_.connection.used;
         LOG_DEBUG() << "Drop idle connection to `" << DsnCutPassword(dsn_)
@@ -587,14 +676,130 @@ void ConnectionPool::MaintainConnections() {
   CheckMinPoolSizeUnderflow();
 }
 
+void ConnectionPool::MaintainIdleTail(const PoolSettings& settings) {
+  // The stack holds the idle connections from the most to the least recently
+  // used one, so all of them are taken to get to the cold tail. The hot ones
+  // are returned right away.
+  std::vector<Connection*> idle;
+  Connection* connection = nullptr;
+  while (PopIdle(connection)) idle.push_back(connection);
+
+  auto size = size_->load(std::memory_order_relaxed);
+  const auto min_size = GetMinSize(settings);
+  const auto reap_idle = settings.max_idle_time.count() > 0;
+  auto drop_left = kIdleDropLimit;
+  std::vector<Connection*> expired;
+  std::vector<Connection*> stale;
+  std::vector<Connection*> kept;
+  for (auto it = idle.rbegin(); it != idle.rend(); ++it) {
+    const auto idle_duration = (*it)->GetIdleDuration();
+    const auto above_min = size > min_size;
+    if (above_min && (reap_idle ? idle_duration >= settings.max_idle_time
+                                : idle_duration >= kMaxIdleDuration &&
+                                      drop_left-- > 0)) {
+      expired.push_back(*it);
+      --size;
+    } else if (idle_duration >= kMaxIdleDuration &&
+               !(reap_idle && above_min)) {
+      // the cold connections above min_size are not pinged, otherwise they
+      // would never become idle for max_idle_time
+      stale.push_back(*it);
+    } else {
+      kept.push_back(*it);
+    }
+  }
+  // the most recently used connection goes on top again
+  for (auto* conn : kept) Push(conn);
+
+  for (auto* conn : expired) {
+    LOG_DEBUG() << "Drop idle connection to `" << DsnCutPassword(dsn_) << '`';
+    CloseIdleConnection(conn);
+  }
+
+  for (auto* conn : stale) {
+    ++stats_.connection.used;
+    const auto releaser = [this](Connection* c) { Release(c); };
+    std::unique_ptr<Connection, decltype(releaser)> capture(conn, releaser);
+    try {
+      capture->Ping();
+    } catch (const RuntimeError& e) {
+      LOG_LIMITED_WARNING() << "Exception while pinging connection to `"
+                            << DsnCutPassword(dsn_) << "`: " << e;
+    }
+  }
+}
+
 void ConnectionPool::StartMaintainTask() {
   using Flags = USERVER_NAMESPACE::utils::PeriodicTask::Flags;
 
   ping_task_.Start(kMaintainTaskName, {kMaintainInterval, Flags::kStrong},
                    [this] { MaintainConnections(); });
+  adaptive_task_.Start(kAdaptiveTaskName, {kAdaptiveInterval, Flags::kStrong},
+                       [this] { AdjustPoolSize(); });
 }
 
-void ConnectionPool::StopMaintainTask() { ping_task_.Stop(); }
+void ConnectionPool::StopMaintainTask() {
+  adaptive_task_.Stop();
+  ping_task_.Stop();
+}
+
+std::size_t ConnectionPool::GetMinSize(const PoolSettings& settings) const {
+  if (!settings.adaptive_size) return settings.min_size;
+  return std::max(settings.min_size,
+                  target_size_.load(std::memory_order_relaxed));
+}
+
+void ConnectionPool::AdjustPoolSize() {
+  const auto peak_used = peak_used_.exchange(
+      stats_.connection.used.Load(), std::memory_order_relaxed);
+  const auto peak_waiting = peak_waiting_.exchange(
+      wait_count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  auto settings = settings_.Read();
+  if (!settings->adaptive_size) {
+    target_size_ = 0;
+    size_controller_.Reset();
+    return;
+  }
+
+  PoolSizeController::Sample sample;
+  sample.size = size_->load(std::memory_order_relaxed);
+  sample.peak_used = peak_used;
+  sample.peak_waiting = peak_waiting;
+  sample.acquire_wait_ms =
+      stats_.acquire_percentile.GetStatsForPeriod(kAdaptiveInterval, true)
+          .GetPercentile(95);
+  sample.query_time_ms =
+      stats_.transaction.busy_percentile
+          .GetStatsForPeriod(kAdaptiveInterval, true)
+          .GetPercentile(95);
+
+  const auto target = size_controller_.Update(sample, *settings);
+  target_size_ = target;
+  if (target == sample.size) return;
+  LOG_DEBUG() << "Adaptive pool size of `" << DsnCutPassword(dsn_)
+              << "`: " << sample.size << " -> " << target
+              << " (peak used " << peak_used << ", peak waiting "
+              << peak_waiting << ", acquire p95 " << sample.acquire_wait_ms
+              << "ms, query p95 " << sample.query_time_ms << "ms)";
+
+  if (target < sample.size) {
+    DropIdleConnections(sample.size - target);
+    return;
+  }
+
+  auto conn_settings = conn_settings_.Read();
+  if (recent_conn_errors_.GetStatsForPeriod(kRecentErrorPeriod, true) >=
+      conn_settings->recent_errors_threshold) {
+    LOG_DEBUG() << "Too many connection errors in recent period";
+    return;
+  }
+  for (auto count = sample.size; count < target; ++count) {
+    SharedSizeGuard sg{size_};
+    if (sg.GetValue() > target) break;
+    Connect(std::move(sg)).Detach();
+  }
+}
 
 }  // namespace storages::postgres::detail
 
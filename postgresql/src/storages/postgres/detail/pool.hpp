@@ -5,8 +5,10 @@
 #include <vector>
 
 #include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/congestion_control/client_throttler.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -21,13 +23,16 @@
 #include <storages/postgres/default_command_controls.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <storages/postgres/detail/pool_size_controller.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
+#include <storages/postgres/detail/statements_registry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -62,11 +67,16 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void Release(Connection* connection);
 
   const InstanceStatistics& GetStatistics() const;
+  /// Number of connections in use and clients waiting for a connection
+  std::size_t GetInFlight() const;
   [[nodiscard]] Transaction Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl = {});
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
+  [[nodiscard]] NotifyScope Listen(std::string_view channel,
+                                   OptionalCommandControl cmd_ctl = {});
+
   CommandControl GetDefaultCommandControl() const;
 
   void SetSettings(const PoolSettings& settings);
@@ -96,18 +106,26 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void Push(Connection* connection);
   Connection* Pop(engine::Deadline);
 
+  bool PushIdle(Connection* connection);
+  bool PopIdle(Connection*& connection);
+
   void Clear();
 
   void DeleteConnection(Connection* connection);
   void DeleteBrokenConnection(Connection* connection);
   void DropOutdatedConnection(Connection* connection);
+  void DropIdleConnections(std::size_t count);
+  void CloseIdleConnection(Connection* connection);
 
   void AccountConnectionStats(Connection::Statistics stats);
 
   Connection* AcquireImmediate();
   void MaintainConnections();
+  void MaintainIdleTail(const PoolSettings& settings);
   void StartMaintainTask();
   void StopMaintainTask();
+  void AdjustPoolSize();
+  std::size_t GetMinSize(const PoolSettings& settings) const;
 
   using RecentCounter = USERVER_NAMESPACE::utils::statistics::RecentPeriod<
       USERVER_NAMESPACE::utils::statistics::RelaxedCounter<size_t>, size_t>;
@@ -120,18 +138,30 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   rcu::Variable<ConnectionSettings> conn_settings_;
   engine::TaskProcessor& bg_task_processor_;
   USERVER_NAMESPACE::utils::PeriodicTask ping_task_;
+  USERVER_NAMESPACE::utils::PeriodicTask adaptive_task_;
   engine::Mutex wait_mutex_;
   engine::ConditionVariable conn_available_;
+  // Idle connections, the stack is used with lifo_acquire. Both are popped
+  // from to pick up the connections left after the settings change.
   boost::lockfree::queue<Connection*> queue_;
+  boost::lockfree::stack<Connection*> stack_;
+  std::atomic<bool> lifo_;
   SharedCounter size_;
   engine::Semaphore connecting_semaphore_;
   std::atomic<size_t> wait_count_;
+  std::atomic<size_t> peak_used_{0};
+  std::atomic<size_t> peak_waiting_{0};
+  // 0 unless the adaptive sizing is on
+  std::atomic<size_t> target_size_{0};
+  PoolSizeController size_controller_;
   DefaultCommandControls default_cmd_ctls_;
   testsuite::PostgresControl testsuite_pg_ctl_;
   const error_injection::Settings ei_settings_;
   RecentCounter recent_conn_errors_;
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
+  congestion_control::ClientThrottler throttler_;
   detail::StatementTimingsStorage sts_;
+  StatementsRegistry statements_registry_;
 };
 
 }  // namespace storages::postgres::detail
@@ -0,0 +1,82 @@
+#include <storages/postgres/detail/pool_size_controller.hpp>
+
+#include <algorithm>
+
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// Queries this many times slower than before the pressure mean that the
+// server is saturated
+constexpr std::size_t kSaturationRatio = 2;
+// Query time changes below this threshold are considered noise
+constexpr std::size_t kMinQueryTimeMs = 5;
+
+// Periods without waiting before shrinking, avoids flapping
+constexpr std::size_t kCalmPeriodsToShrink = 3;
+
+// The pool changes by this part of its size at once
+constexpr std::size_t kStepDivisor = 4;
+
+std::size_t Step(std::size_t size) {
+  return std::max<std::size_t>(1, size / kStepDivisor);
+}
+
+}  // namespace
+
+std::size_t PoolSizeController::Update(const Sample& sample,
+                                       const PoolSettings& settings) {
+  const auto lower = std::min(settings.min_size, settings.max_size);
+  const auto upper = settings.max_size;
+  if (!target_) target_ = std::clamp(sample.size, lower, upper);
+
+  const bool pressure =
+      sample.peak_waiting > 0 ||
+      sample.acquire_wait_ms >
+          static_cast<std::size_t>(settings.adaptive_max_acquire_wait.count());
+
+  if (pressure) {
+    calm_periods_ = 0;
+    if (!baseline_query_time_ms_) {
+      baseline_query_time_ms_ =
+          std::max(sample.query_time_ms, kMinQueryTimeMs);
+    }
+    if (sample.query_time_ms > baseline_query_time_ms_ * kSaturationRatio) {
+      LOG_LIMITED_WARNING() << "Queries became slower while the pool grew ("
+                            << baseline_query_time_ms_ << "ms -> "
+                            << sample.query_time_ms
+                            << "ms), the server seems saturated, keeping "
+                            << target_ << " connections";
+    } else {
+      const auto current = std::max(target_, sample.size);
+      target_ = std::min(upper, current + Step(current));
+    }
+  } else {
+    baseline_query_time_ms_ = 0;
+    const auto needed = sample.peak_used + Step(sample.peak_used);
+    if (needed < target_) {
+      if (++calm_periods_ >= kCalmPeriodsToShrink) {
+        target_ = std::max(needed, target_ - Step(target_));
+      }
+    } else {
+      calm_periods_ = 0;
+    }
+  }
+
+  target_ = std::clamp(target_, lower, upper);
+  return target_;
+}
+
+void PoolSizeController::Reset() {
+  target_ = 0;
+  baseline_query_time_ms_ = 0;
+  calm_periods_ = 0;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/storages/postgres/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Computes the number of connections of an adaptive pool.
+///
+/// The pool grows while the clients wait for connections, unless the queries
+/// become slower as the pool grows: that means the server is saturated and
+/// more connections would only add to its load. The pool shrinks to the peak
+/// number of used connections with some headroom when there is no waiting for
+/// several periods in a row.
+class PoolSizeController final {
+ public:
+  /// Pool load measured over a period
+  struct Sample {
+    /// Current number of connections
+    std::size_t size{0};
+    /// Maximum number of simultaneously used connections
+    std::size_t peak_used{0};
+    /// Maximum number of clients waiting for a connection
+    std::size_t peak_waiting{0};
+    /// 95th percentile of connection acquire time, ms
+    std::size_t acquire_wait_ms{0};
+    /// 95th percentile of query execution time per transaction, ms
+    std::size_t query_time_ms{0};
+  };
+
+  /// Returns the desired number of connections in [min_size, max_size]
+  std::size_t Update(const Sample& sample, const PoolSettings& settings);
+
+  std::size_t GetTarget() const { return target_; }
+
+  /// Forgets the history, e.g. when the adaptive sizing is turned off
+  void Reset();
+
+ private:
+  std::size_t target_{0};
+  /// Query time when the clients started waiting, 0 if they don't wait
+  std::size_t baseline_query_time_ms_{0};
+  std::size_t calm_periods_{0};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
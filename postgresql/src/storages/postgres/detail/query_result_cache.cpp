@@ -0,0 +1,142 @@
+#include <storages/postgres/detail/query_result_cache.hpp>
+
+#include <cstring>
+
+#include <userver/utils/datetime.hpp>
+
+#include <storages/postgres/detail/result_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+template <typename T>
+void AppendBytes(std::string& key, const T& value) {
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+QueryResultCache::QueryResultCache() = default;
+
+QueryResultCache::~QueryResultCache() = default;
+
+void QueryResultCache::SetSettings(
+    const QueryResultCacheSettingsMap& settings) {
+  auto caches = caches_.StartWrite();
+  QueryCaches updated;
+  for (const auto& [query_name, query_settings] : settings) {
+    if (query_settings.ttl.count() <= 0 || !query_settings.max_bytes) continue;
+
+    // the results are kept if the settings of the query did not change
+    const auto it = caches->find(query_name);
+    if (it != caches->end() && it->second->settings == query_settings) {
+      updated.emplace(query_name, it->second);
+    } else {
+      updated.emplace(query_name,
+                      std::make_shared<QueryCache>(query_settings));
+    }
+  }
+  *caches = std::move(updated);
+  caches.Commit();
+}
+
+bool QueryResultCache::IsEnabled(const std::string& query_name) const {
+  const auto caches = caches_.Read();
+  return caches->count(query_name) != 0;
+}
+
+std::string QueryResultCache::MakeKey(const std::string& statement,
+                                      const DynamicQueryParameters& params) {
+  std::string key = statement;
+  key.push_back('\0');
+  const auto size = params.Size();
+  for (std::size_t i = 0; i < size; ++i) {
+    AppendBytes(key, params.ParamTypesBuffer()[i]);
+    const auto length = params.ParamLengthsBuffer()[i];
+    AppendBytes(key, length);
+    if (length > 0) key.append(params.ParamBuffers()[i], length);
+  }
+  return key;
+}
+
+std::optional<ResultSet> QueryResultCache::Get(const std::string& query_name,
+                                               const std::string& key) const {
+  const auto cache = Find(query_name);
+  if (!cache) return std::nullopt;
+
+  auto entries = cache->entries.Lock();
+  const auto it = entries->index.find(key);
+  if (it == entries->index.end()) return std::nullopt;
+
+  const auto entry_it = it->second;
+  if (entry_it->expires_at <= USERVER_NAMESPACE::utils::datetime::SteadyNow()) {
+    entries->Erase(entry_it);
+    return std::nullopt;
+  }
+  entries->lru.splice(entries->lru.begin(), entries->lru, entry_it);
+  return entry_it->result;
+}
+
+void QueryResultCache::Put(const std::string& query_name, std::string key,
+                           const ResultSet& result) {
+  const auto cache = Find(query_name);
+  if (!cache) return;
+
+  const auto bytes = key.size() + result.pimpl_->GetMemorySize();
+  if (bytes > cache->settings.max_bytes) return;
+
+  const auto expires_at =
+      USERVER_NAMESPACE::utils::datetime::SteadyNow() + cache->settings.ttl;
+  auto entries = cache->entries.Lock();
+  if (const auto it = entries->index.find(key); it != entries->index.end()) {
+    entries->Erase(it->second);
+  }
+  while (entries->bytes + bytes > cache->settings.max_bytes) {
+    entries->Erase(std::prev(entries->lru.end()));
+  }
+
+  entries->lru.push_front(Entry{std::move(key), result, expires_at, bytes});
+  entries->index.emplace(entries->lru.front().key, entries->lru.begin());
+  entries->bytes += bytes;
+}
+
+void QueryResultCache::Invalidate(const std::string& query_name) {
+  const auto cache = Find(query_name);
+  if (!cache) return;
+  auto entries = cache->entries.Lock();
+  entries->Clear();
+}
+
+void QueryResultCache::InvalidateAll() {
+  const auto caches = caches_.Read();
+  for (const auto& [_, cache] : *caches) {
+    auto entries = cache->entries.Lock();
+    entries->Clear();
+  }
+}
+
+void QueryResultCache::Entries::Erase(std::list<Entry>::iterator it) {
+  bytes -= it->bytes;
+  index.erase(it->key);
+  lru.erase(it);
+}
+
+void QueryResultCache::Entries::Clear() {
+  index.clear();
+  lru.clear();
+  bytes = 0;
+}
+
+QueryResultCache::QueryCachePtr QueryResultCache::Find(
+    const std::string& query_name) const {
+  const auto caches = caches_.Read();
+  const auto it = caches->find(query_name);
+  return it == caches->end() ? nullptr : it->second;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
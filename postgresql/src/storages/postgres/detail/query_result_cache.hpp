@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Results of the named queries executed by Cluster::Execute, keyed by the
+/// statement and the serialized parameters. Each query has its own LRU with
+/// the TTL and the byte limit from QueryResultCacheSettings.
+class QueryResultCache final {
+ public:
+  QueryResultCache();
+  ~QueryResultCache();
+
+  void SetSettings(const QueryResultCacheSettingsMap& settings);
+
+  bool IsEnabled(const std::string& query_name) const;
+
+  static std::string MakeKey(const std::string& statement,
+                             const DynamicQueryParameters& params);
+
+  std::optional<ResultSet> Get(const std::string& query_name,
+                               const std::string& key) const;
+
+  void Put(const std::string& query_name, std::string key,
+           const ResultSet& result);
+
+  /// Drops the results of the query
+  void Invalidate(const std::string& query_name);
+
+  /// Drops the results of all the queries
+  void InvalidateAll();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::string key;
+    ResultSet result;
+    Clock::time_point expires_at;
+    std::size_t bytes;
+  };
+
+  struct Entries {
+    std::list<Entry> lru;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    std::size_t bytes{0};
+
+    void Erase(std::list<Entry>::iterator it);
+    void Clear();
+  };
+
+  struct QueryCache {
+    explicit QueryCache(const QueryResultCacheSettings& settings)
+        : settings{settings} {}
+
+    const QueryResultCacheSettings settings;
+    concurrent::Variable<Entries> entries;
+  };
+
+  using QueryCachePtr = std::shared_ptr<QueryCache>;
+  using QueryCaches = std::unordered_map<std::string, QueryCachePtr>;
+
+  QueryCachePtr Find(const std::string& query_name) const;
+
+  rcu::Variable<QueryCaches> caches_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
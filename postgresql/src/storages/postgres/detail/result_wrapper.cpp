@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/result_wrapper.hpp>
 
+#include <pg_config.h>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 #include <boost/stacktrace/stacktrace.hpp>
@@ -104,6 +106,19 @@ void ResultWrapper::FillBufferCategories(const UserTypes& types) {
 
     AddTypeBufferCategories(data_type, types, buffer_categories_, context);
   }
+  CacheFieldBufferCategories();
+}
+
+void ResultWrapper::CacheFieldBufferCategories() {
+  const auto n_fields = FieldCount();
+  field_categories_.clear();
+  field_categories_.reserve(n_fields);
+  for (std::size_t f_no = 0; f_no < n_fields; ++f_no) {
+    const auto f = buffer_categories_.find(GetFieldTypeOid(f_no));
+    field_categories_.push_back(f != buffer_categories_.end()
+                                    ? f->second
+                                    : io::BufferCategory::kNoParser);
+  }
 }
 
 ExecStatusType ResultWrapper::GetStatus() const {
@@ -173,6 +188,7 @@ Oid ResultWrapper::GetFieldTypeOid(std::size_t col) const {
 
 io::BufferCategory ResultWrapper::GetFieldBufferCategory(
     std::size_t col) const {
+  if (col < field_categories_.size()) return field_categories_[col];
   auto data_type = GetFieldTypeOid(col);
   if (auto f = buffer_categories_.find(data_type);
       f != buffer_categories_.end()) {
@@ -186,6 +202,22 @@ std::size_t ResultWrapper::GetFieldLength(std::size_t row,
   return PQgetlength(handle_.get(), row, col);
 }
 
+std::size_t ResultWrapper::GetMemorySize() const {
+#if PG_VERSION_NUM >= 120000
+  return PQresultMemorySize(handle_.get());
+#else
+  const auto rows = RowCount();
+  const auto fields = FieldCount();
+  std::size_t size = 0;
+  for (std::size_t row = 0; row < rows; ++row) {
+    for (std::size_t col = 0; col < fields; ++col) {
+      size += GetFieldLength(row, col);
+    }
+  }
+  return size;
+#endif
+}
+
 io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                                               std::size_t col) const {
   if (PQfformat(handle_.get(), col) != io::kPgBinaryDataFormat) {
@@ -199,6 +231,26 @@ io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                              PQgetvalue(handle_.get(), row, col))};
 }
 
+void ResultWrapper::GetColumnBuffers(
+    std::size_t col, std::vector<io::FieldBuffer>& buffers) const {
+  const auto n_rows = RowCount();
+  buffers.clear();
+  if (!n_rows) return;
+  // checks the format
+  buffers.push_back(GetFieldBuffer(0, col));
+  buffers.reserve(n_rows);
+  const auto category = buffers.front().category;
+  auto* handle = handle_.get();
+  for (std::size_t row = 1; row < n_rows; ++row) {
+    buffers.push_back(
+        io::FieldBuffer{static_cast<bool>(PQgetisnull(handle, row, col)),
+                        category,
+                        static_cast<std::size_t>(PQgetlength(handle, row, col)),
+                        reinterpret_cast<const std::uint8_t*>(
+                            PQgetvalue(handle, row, col))});
+  }
+}
+
 std::string ResultWrapper::GetErrorMessage() const {
   auto* msg = PQresultErrorMessage(handle_.get());
   return {msg ? msg : "no error message"};
@@ -3,6 +3,7 @@
 #include <libpq-fe.h>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 #include <userver/storages/postgres/postgres_fwd.hpp>
 
@@ -35,6 +36,7 @@ class ResultWrapper {
   }
   void SetTypeBufferCategories(const io::TypeBufferCategory& cats) {
     buffer_categories_ = cats;
+    CacheFieldBufferCategories();
   }
   std::string CommandStatus() const;
   std::size_t RowsAffected() const;
@@ -48,6 +50,12 @@ class ResultWrapper {
   bool IsFieldNull(std::size_t row, std::size_t col) const;
   std::size_t GetFieldLength(std::size_t row, std::size_t col) const;
   io::FieldBuffer GetFieldBuffer(std::size_t row, std::size_t col) const;
+  /// Buffers of the field in all the rows, the field format and buffer
+  /// category are checked once
+  void GetColumnBuffers(std::size_t col,
+                        std::vector<io::FieldBuffer>& buffers) const;
+  /// Memory held by the result
+  std::size_t GetMemorySize() const;
   //@}
 
   //@{
@@ -74,6 +82,12 @@ class ResultWrapper {
 
   ResultHandle handle_;
   io::TypeBufferCategory buffer_categories_;
+
+ private:
+  void CacheFieldBufferCategories();
+
+  // buffer categories of the fields, to avoid the lookup for every value
+  std::vector<io::BufferCategory> field_categories_;
 };
 
 inline ResultWrapper::ResultHandle MakeResultHandle(PGresult* pg_res) {
@@ -1,57 +1,70 @@
 #include "statement_timings_storage.hpp"
 
-#include <userver/engine/sleep.hpp>
-#include <userver/utils/async.hpp>
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail {
 
 namespace {
-constexpr size_t kDefaultEventsQueueSize = 1000;
-}
+constexpr std::chrono::milliseconds kMergeInterval{100};
+// Bounds the memory of a shard if the merges fall behind, the timings
+// accounted above the limit are dropped
+constexpr std::size_t kMaxShardSamples = 10000;
+}  // namespace
 
 StatementTimingsStorage::StatementTimingsStorage(
     const StatementMetricsSettings& settings)
     : settings_{settings},
       enabled_{settings.max_statements != 0},
-      data_{
-          CreateStorageData(settings.max_statements, kDefaultEventsQueueSize)} {
-  data_.consumer_task =
-      utils::Async("pg_timings_events_consumer", [this]() { ProcessEvents(); });
-}
+      timings_{std::make_unique<Storage>(
+          settings.max_statements ? settings.max_statements : 1)},
+      merge_task_{"pg_timings_merge",
+                  USERVER_NAMESPACE::utils::PeriodicTask::Settings{
+                      kMergeInterval},
+                  [this] { MergeShards(); }} {}
 
-StatementTimingsStorage::~StatementTimingsStorage() {
-  if (data_.consumer_task.IsValid()) {
-    data_.consumer_task.SyncCancel();
-  }
-}
+StatementTimingsStorage::~StatementTimingsStorage() { merge_task_.Stop(); }
 
 void StatementTimingsStorage::Account(const std::string& statement_name,
                                       std::size_t duration_ms) const {
   if (!IsEnabled()) return;
 
-  const auto producer = data_.events_queue->GetProducer();
+  // The shard is only shared with the threads that have the same index and
+  // with the merge, so the lock is virtually uncontended
+  auto& shard = shards_[utils::statistics::impl::GetCounterShardIndex()];
+  std::lock_guard lock{shard.mutex};
+  if (shard.samples_count >= kMaxShardSamples) return;
 
-  producer.PushNoblock(
-      std::make_unique<StatementEvent>(statement_name, duration_ms));
+  auto it = shard.samples.find(statement_name);
+  if (it == shard.samples.end()) {
+    it = shard.samples.emplace(statement_name, Samples::mapped_type{}).first;
+  }
+  it->second.push_back(static_cast<std::uint32_t>(
+      std::min<std::size_t>(duration_ms, UINT32_MAX)));
+  ++shard.samples_count;
 }
 
 std::unordered_map<std::string, StatementTimingsStorage::Percentile>
-StatementTimingsStorage::GetTimingsPercentiles() const {
+StatementTimingsStorage::GetTimingsPercentiles(bool with_current_epoch) const {
   if (!IsEnabled()) return {};
 
-  auto locked_ptr = data_.timings->SharedLock();
+  auto locked_ptr = timings_->SharedLock();
   const auto& timings = *locked_ptr;
 
   std::unordered_map<std::string, StatementTimingsStorage::Percentile> result;
   result.reserve(timings.GetSize());
 
   timings.VisitAll(
-      [&result](const std::string& key,
-                const std::unique_ptr<StatementTimingsStorage::RecentPeriod>&
-                    recent_period) {
-        result.emplace(key, recent_period->GetStatsForPeriod());
+      [&result, with_current_epoch](
+          const std::string& key,
+          const std::unique_ptr<StatementTimingsStorage::RecentPeriod>&
+              recent_period) {
+        result.emplace(key, recent_period->GetStatsForPeriod(
+                                RecentPeriod::Duration::min(),
+                                with_current_epoch));
       });
 
   return result;
@@ -66,7 +79,7 @@ void StatementTimingsStorage::SetSettings(
   if (enabled) {
     // we don't have any operations that hold this lock for long,
     // so it should be ok
-    auto locked_ptr = data_.timings->UniqueLock();
+    auto locked_ptr = timings_->UniqueLock();
     auto& timings = *locked_ptr;
 
     timings.SetMaxSize(settings.max_statements);
@@ -76,57 +89,59 @@ void StatementTimingsStorage::SetSettings(
   settings_.Assign(settings);
 }
 
-void StatementTimingsStorage::WaitForExhaustion() const {
-  while (data_.events_queue->GetSizeApproximate()) {
-    engine::SleepFor(std::chrono::milliseconds{2});
-  }
-}
-
-bool StatementTimingsStorage::IsEnabled() const { return enabled_; }
-
-void StatementTimingsStorage::ProcessEvents() {
-  const auto consumer = data_.events_queue->GetConsumer();
+void StatementTimingsStorage::WaitForExhaustion() const { MergeShards(); }
 
-  EventPtr event_ptr;
-  while (!engine::current_task::IsCancelRequested()) {
-    if (!consumer.Pop(event_ptr)) {
-      break;
+std::vector<std::string> StatementTimingsStorage::GetBufferedStatements()
+    const {
+  std::vector<std::string> result;
+  std::lock_guard merge_lock{merge_mutex_};
+  for (auto& shard : shards_) {
+    std::lock_guard lock{shard.mutex};
+    for (const auto* samples : {&shard.samples, &shard.merged_samples}) {
+      for (const auto& [name, durations] : *samples) result.push_back(name);
     }
-    UASSERT(event_ptr);
-
-    AccountEvent(std::move(event_ptr));
   }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
 }
 
-void StatementTimingsStorage::AccountEvent(EventPtr event_ptr) const {
-  const auto& name = event_ptr->statement_name;
-  const auto duration = event_ptr->duration_ms;
+bool StatementTimingsStorage::IsEnabled() const { return enabled_; }
 
-  auto locked_ptr = data_.timings->UniqueLock();
-  auto& data = *locked_ptr;
+void StatementTimingsStorage::MergeShards() const {
+  std::lock_guard merge_lock{merge_mutex_};
+  for (auto& shard : shards_) {
+    // The shard gets back the vectors cleared on the previous merge
+    auto& samples = shard.merged_samples;
+    {
+      std::lock_guard lock{shard.mutex};
+      if (!shard.samples_count) continue;
+      samples.swap(shard.samples);
+      shard.samples_count = 0;
+    }
 
-  auto* timing_ptr = data.Get(name);
-  if (!timing_ptr) {
-    data.Put(name, std::make_unique<RecentPeriod>());
-    timing_ptr = data.Get(name);
+    auto locked_ptr = timings_->UniqueLock();
+    auto& timings = *locked_ptr;
+    for (auto it = samples.begin(); it != samples.end();) {
+      auto& [name, durations] = *it;
+      // statements not accounted since the previous merge are forgotten
+      if (durations.empty()) {
+        it = samples.erase(it);
+        continue;
+      }
+
+      auto* timing_ptr = timings.Get(name);
+      if (!timing_ptr) {
+        timings.Put(name, std::make_unique<RecentPeriod>());
+        timing_ptr = timings.Get(name);
+      }
+      UASSERT(timing_ptr);
+      auto& percentile = (*timing_ptr)->GetCurrentCounter();
+      for (const auto duration : durations) percentile.Account(duration);
+      durations.clear();
+      ++it;
+    }
   }
-  UASSERT(timing_ptr);
-  (*timing_ptr)->GetCurrentCounter().Account(duration);
-}
-
-StatementTimingsStorage::StorageData StatementTimingsStorage::CreateStorageData(
-    size_t max_map_size, size_t max_queue_size) {
-  // We create storage and queue unconditionally, because
-  // it gets complicated to process config updates otherwise
-  if (!max_map_size) max_map_size = 1;
-
-  auto queue_ptr = Queue::Create(max_queue_size);
-
-  return StatementTimingsStorage::StorageData{
-      std::make_unique<Storage>(max_map_size),
-      queue_ptr,
-      {},
-      queue_ptr->GetProducer()};
 }
 
 }  // namespace storages::postgres::detail
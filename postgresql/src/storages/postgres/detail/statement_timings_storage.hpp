@@ -1,22 +1,33 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <userver/cache/lru_map.hpp>
-#include <userver/concurrent/mpsc_queue.hpp>
 #include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/shared_mutex.hpp>
-#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/statistics.hpp>
+#include <userver/utils/periodic_task.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
-
-#include <unordered_map>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail {
 
+/// Accumulates the statement timings in per-thread shards that are
+/// periodically merged into the per statement name percentiles, so that
+/// Account() does not contend with other threads. The merges keep the
+/// per statement buffers of the shards, so Account() does not allocate for
+/// the statements that are executed steadily.
 class StatementTimingsStorage final {
  public:
   using Percentile = postgres::Percentile;
@@ -27,24 +38,32 @@ class StatementTimingsStorage final {
   void Account(const std::string& statement_name,
                std::size_t duration_ms) const;
 
-  std::unordered_map<std::string, Percentile> GetTimingsPercentiles() const;
+  // The current epoch of the percentiles is included for testing purposes
+  std::unordered_map<std::string, Percentile> GetTimingsPercentiles(
+      bool with_current_epoch = false) const;
 
   void SetSettings(const StatementMetricsSettings& settings);
 
-  // For testing purposes, don't use directly
+  // For testing purposes, don't use directly. Merges the accounted timings
+  // into the percentiles.
   void WaitForExhaustion() const;
 
- private:
-  struct StatementEvent final {
-    StatementEvent(const std::string& statement_name_, size_t duration_)
-        : statement_name{statement_name_}, duration_ms{duration_} {}
+  // For testing purposes, don't use directly. The sorted names of the
+  // statements the shards keep the buffers for.
+  std::vector<std::string> GetBufferedStatements() const;
 
-    std::string statement_name;
-    std::size_t duration_ms;
+ private:
+  using Samples = std::unordered_map<std::string, std::vector<std::uint32_t>>;
+
+  struct alignas(64) Shard final {
+    std::mutex mutex;
+    Samples samples;
+    std::size_t samples_count{0};
+    // Swapped with samples on merges, only used under merge_mutex_. The
+    // vectors are cleared in place, so that they keep their capacity.
+    Samples merged_samples;
   };
-  using EventPtr = std::unique_ptr<StatementEvent>;
 
-  using Queue = USERVER_NAMESPACE::concurrent::MpscQueue<EventPtr>;
   using RecentPeriod =
       USERVER_NAMESPACE::utils::statistics::RecentPeriod<Percentile,
                                                          Percentile>;
@@ -54,25 +73,23 @@ class StatementTimingsStorage final {
   using Storage =
       USERVER_NAMESPACE::concurrent::Variable<StorageType, engine::SharedMutex>;
 
-  struct StorageData final {
-    std::unique_ptr<Storage> timings;
-    std::shared_ptr<Queue> events_queue;
-
-    engine::TaskWithResult<void> consumer_task;
-    Queue::Producer ensure_lifetime_producer;
-  };
-
   bool IsEnabled() const;
 
-  void ProcessEvents();
-  void AccountEvent(EventPtr event_ptr) const;
-  static StorageData CreateStorageData(size_t max_map_size,
-                                       size_t max_queue_size);
+  void MergeShards() const;
 
   rcu::Variable<StatementMetricsSettings> settings_;
   std::atomic_bool enabled_;
 
-  StorageData data_;
+  // We create storage unconditionally, because
+  // it gets complicated to process config updates otherwise
+  std::unique_ptr<Storage> timings_;
+  mutable std::array<
+      Shard, USERVER_NAMESPACE::utils::statistics::impl::kCounterShardCount>
+      shards_;
+  // The merges lock the timings, which may suspend the coroutine
+  mutable engine::Mutex merge_mutex_;
+
+  USERVER_NAMESPACE::utils::PeriodicTask merge_task_;
 };
 
 }  // namespace storages::postgres::detail
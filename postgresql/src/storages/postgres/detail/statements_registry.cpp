@@ -0,0 +1,67 @@
+#include <storages/postgres/detail/statements_registry.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+StatementsRegistry::StatementsRegistry(std::size_t max_size)
+    : statements_{max_size} {}
+
+void StatementsRegistry::Register(Statement statement) {
+  auto statements = statements_.Lock();
+  auto* entry = statements->Get(statement.id);
+  if (!entry) {
+    const auto id = statement.id;
+    entry = statements->Emplace(id, Entry{std::move(statement)});
+  }
+  ++entry->prepare_count;
+}
+
+std::optional<ResultSet> StatementsRegistry::GetDescription(
+    Connection::StatementId id) {
+  auto statements = statements_.Lock();
+  const auto* entry = statements->Get(id);
+  if (!entry) return std::nullopt;
+  return entry->statement.description;
+}
+
+std::vector<StatementsRegistry::Statement> StatementsRegistry::GetHotStatements(
+    std::size_t limit) const {
+  std::vector<const Entry*> entries;
+  std::vector<Statement> result;
+  if (!limit) return result;
+
+  auto statements = statements_.Lock();
+  entries.reserve(statements->GetSize());
+  statements->VisitAll(
+      [&entries](const Connection::StatementId&, const Entry& entry) {
+        entries.push_back(&entry);
+      });
+  limit = std::min(limit, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + limit, entries.end(),
+                    [](const Entry* lhs, const Entry* rhs) {
+                      return lhs->prepare_count > rhs->prepare_count;
+                    });
+
+  result.reserve(limit);
+  for (std::size_t i = 0; i < limit; ++i) {
+    result.push_back(entries[i]->statement);
+  }
+  return result;
+}
+
+void StatementsRegistry::Clear() {
+  auto statements = statements_.Lock();
+  statements->Clear();
+}
+
+void StatementsRegistry::SetMaxSize(std::size_t max_size) {
+  auto statements = statements_.Lock();
+  statements->SetMaxSize(max_size);
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
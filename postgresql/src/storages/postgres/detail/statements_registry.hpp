@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/pg_types.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Statements prepared by the connections of a pool.
+///
+/// New connections prepare the most used statements eagerly, and the result
+/// descriptions are shared between the connections, so a statement is
+/// described just once per pool.
+class StatementsRegistry final {
+ public:
+  struct Statement {
+    Connection::StatementId id{};
+    std::string statement;
+    std::vector<Oid> param_types;
+    /// Description with buffer categories filled
+    ResultSet description{nullptr};
+  };
+
+  explicit StatementsRegistry(std::size_t max_size);
+
+  /// Accounts the statement prepared by a connection
+  void Register(Statement statement);
+
+  /// Returns the shared description of a statement
+  std::optional<ResultSet> GetDescription(Connection::StatementId id);
+
+  /// Returns up to `limit` statements prepared by the most connections
+  std::vector<Statement> GetHotStatements(std::size_t limit) const;
+
+  /// Forgets the statements, e.g. when their descriptions become invalid
+  void Clear();
+
+  void SetMaxSize(std::size_t max_size);
+
+ private:
+  struct Entry {
+    Statement statement;
+    std::size_t prepare_count{0};
+  };
+
+  using Storage = cache::LruMap<Connection::StatementId, Entry>;
+
+  mutable concurrent::Variable<Storage, engine::Mutex> statements_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,27 @@
+#include <storages/postgres/detail/task_deadline.hpp>
+
+#include <algorithm>
+
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+engine::Deadline LimitByTaskDeadline(engine::Deadline deadline) {
+  const auto task_deadline = server::request::GetTaskInheritedDeadline();
+  if (task_deadline.IsReached()) {
+    throw ConnectionTimeoutError{
+        "Deadline of the handled request reached before executing"};
+  }
+  return std::min(deadline, task_deadline);
+}
+
+bool IsTaskDeadlineReached() {
+  return server::request::GetTaskInheritedDeadline().IsReached();
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
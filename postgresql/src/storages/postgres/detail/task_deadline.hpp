@@ -0,0 +1,21 @@
+#pragma once
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// There is no use executing a statement after the deadline of the request
+/// being handled, so the deadline is shrunk to the task-inherited one.
+/// @throws ConnectionTimeoutError if the task-inherited deadline is reached
+engine::Deadline LimitByTaskDeadline(engine::Deadline deadline);
+
+/// Whether the timeout was caused by the deadline of the request being
+/// handled. Such timeouts are not accounted against the database host, as the
+/// database is not to blame.
+bool IsTaskDeadlineReached();
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
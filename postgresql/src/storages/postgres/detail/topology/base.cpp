@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/topology/base.hpp>
 
+#include <algorithm>
+
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -11,8 +13,27 @@ namespace {
 // Special connection ID to ease detection in logs
 constexpr uint32_t kConnectionId = 4'100'200'300;
 
+// Hosts closer than this are considered equally near, so that the load
+// and not a jitter of a fast network decides
+constexpr std::chrono::microseconds kMinRoundtripTime{500};
+
 }  // namespace
 
+double EstimateHostCost(const HostMetrics& metrics, std::size_t in_flight,
+                        std::chrono::milliseconds max_replication_lag) {
+  // Every query in flight is expected to delay the new one by a roundtrip
+  const auto rtt = std::max(metrics.roundtrip_time, kMinRoundtripTime);
+  double cost = static_cast<double>(rtt.count()) * (1 + in_flight);
+  // The more a replica lags the less we want to read from it, the cost doubles
+  // at the lag limit (lagging further disables the replica)
+  if (max_replication_lag.count() > 0 && metrics.replication_lag.count() > 0) {
+    cost *= 1 + std::min(1.0, static_cast<double>(
+                                  metrics.replication_lag.count()) /
+                                  max_replication_lag.count());
+  }
+  return cost;
+}
+
 TopologyBase::TopologyBase(engine::TaskProcessor& bg_task_processor,
                            DsnList dsns, clients::dns::Resolver* resolver,
                            const TopologySettings& topology_settings,
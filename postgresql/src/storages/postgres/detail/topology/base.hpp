@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -9,6 +10,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/options.hpp>
@@ -19,12 +21,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail::topology {
 
+/// Last measured properties of a host
+struct HostMetrics {
+  std::chrono::microseconds roundtrip_time{0};
+  std::chrono::milliseconds replication_lag{0};
+};
+
+/// Returns an estimation of how slow a query would be on a host, the host with
+/// the lowest cost is the best to use
+double EstimateHostCost(const HostMetrics& metrics, std::size_t in_flight,
+                        std::chrono::milliseconds max_replication_lag);
+
 class TopologyBase {
  public:
   using DsnIndex = size_t;
   using DsnIndices = std::vector<DsnIndex>;
   using DsnIndicesByType =
       std::unordered_map<ClusterHostType, DsnIndices, ClusterHostTypeHash>;
+  using DsnMetrics = std::vector<HostMetrics>;
 
   TopologyBase(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                clients::dns::Resolver* resolver,
@@ -46,6 +60,9 @@ class TopologyBase {
   /// Currently accessible hosts
   virtual rcu::ReadablePtr<DsnIndices> GetAliveDsnIndices() const = 0;
 
+  /// Last measured metrics for each DSN in DsnList
+  virtual rcu::ReadablePtr<DsnMetrics> GetDsnMetrics() const = 0;
+
   // Returns statistics for each DSN in DsnList
   virtual const std::vector<decltype(InstanceStatistics::topology)>&
   GetDsnStatistics() const = 0;
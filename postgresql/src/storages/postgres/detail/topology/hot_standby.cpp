@@ -141,6 +141,7 @@ HotStandby::HotStandby(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                    topology_settings, conn_settings, default_cmd_ctls,
                    testsuite_pg_ctl, std::move(ei_settings)),
       host_states_{GetDsnList().begin(), GetDsnList().end()},
+      dsn_metrics_(DsnMetrics(GetDsnList().size())),
       dsn_stats_(GetDsnList().size()) {
   crypto::impl::Openssl::Init();
   RunDiscovery();
@@ -164,6 +165,10 @@ rcu::ReadablePtr<TopologyBase::DsnIndices> HotStandby::GetAliveDsnIndices()
   return alive_dsn_indices_.Read();
 }
 
+rcu::ReadablePtr<TopologyBase::DsnMetrics> HotStandby::GetDsnMetrics() const {
+  return dsn_metrics_.Read();
+}
+
 const std::vector<decltype(InstanceStatistics::topology)>&
 HotStandby::GetDsnStatistics() const {
   return dsn_stats_;
@@ -178,6 +183,7 @@ void HotStandby::RunDiscovery() {
   for (auto& task : tasks) task.Get();
 
   // Report states and find the master
+  DsnMetrics dsn_metrics(host_states_.size());
   HostState* master = nullptr;
   std::chrono::system_clock::time_point max_slave_xact_timestamp;
   for (DsnIndex i = 0; i < host_states_.size(); ++i) {
@@ -186,6 +192,7 @@ void HotStandby::RunDiscovery() {
                 << state.roundtrip_time.count() << "us, LSN " << state.wal_lsn
                 << ", last xact time " << state.current_xact_timestamp;
     if (state.roundtrip_time != kUnknownRtt) {
+      dsn_metrics[i].roundtrip_time = state.roundtrip_time;
       dsn_stats_[i].roundtrip_time.GetCurrentCounter().Account(
           std::chrono::duration_cast<std::chrono::milliseconds>(
               state.roundtrip_time)
@@ -227,6 +234,7 @@ void HotStandby::RunDiscovery() {
     dsn_stats_[i].replication_lag.GetCurrentCounter().Account(
         std::chrono::duration_cast<std::chrono::milliseconds>(slave_lag)
             .count());
+    dsn_metrics[i].replication_lag = slave_lag;
 
     if (slave_lag > GetTopologySettings().max_replication_lag) {
       // Demote lagged slave
@@ -280,6 +288,7 @@ void HotStandby::RunDiscovery() {
       dsn_indices_by_type[ClusterHostType::kSlave].push_back(idx);
     }
   }
+  dsn_metrics_.Assign(std::move(dsn_metrics));
   dsn_indices_by_type_.Assign(std::move(dsn_indices_by_type));
   alive_dsn_indices_.Assign(std::move(alive_dsn_indices));
 }
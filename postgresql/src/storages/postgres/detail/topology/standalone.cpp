@@ -18,6 +18,7 @@ Standalone::Standalone(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                    testsuite_pg_ctl, std::move(ei_settings)),
       dsn_indices_by_type_(DsnIndicesByType{{ClusterHostType::kMaster, {0}}}),
       alive_dsn_indices_(DsnIndices{0}),
+      dsn_metrics_(DsnMetrics(1)),
       dsn_stats_(GetDsnList().size()) {
   UASSERT(GetDsnList().size() == 1);
 }
@@ -32,6 +33,10 @@ rcu::ReadablePtr<TopologyBase::DsnIndices> Standalone::GetAliveDsnIndices()
   return alive_dsn_indices_.Read();
 }
 
+rcu::ReadablePtr<TopologyBase::DsnMetrics> Standalone::GetDsnMetrics() const {
+  return dsn_metrics_.Read();
+}
+
 const std::vector<decltype(InstanceStatistics::topology)>&
 Standalone::GetDsnStatistics() const {
   return dsn_stats_;
@@ -14,6 +14,10 @@ const std::string kConnect = "pg_connect";
 const std::string kGetConnectData = "pg_get_conn_data";
 /// Execute query, top driver level
 const std::string kQuery = "pg_query";
+/// Execute a batch of queries, top driver level
+const std::string kBatch = "pg_batch";
+/// Copy data from or to the database, top driver level
+const std::string kCopy = "pg_copy";
 /// Prepare query, driver level
 const std::string kPrepare = "pg_prepare";
 /// Bind portal, driver level
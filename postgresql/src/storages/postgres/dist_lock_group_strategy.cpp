@@ -0,0 +1,102 @@
+#include <userver/storages/postgres/dist_lock_group_strategy.hpp>
+
+#include <unordered_set>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/hostinfo/blocking/get_hostname.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// keys - $1
+// owners - $2
+// timeouts in seconds - $3
+std::string MakeAcquireBatchQuery(const std::string& table) {
+  static constexpr auto kAcquireBatchQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time)
+    SELECT r.key, r.owner, current_timestamp + make_interval(secs => r.ttl)
+    FROM unnest($1::text[], $2::text[], $3::double precision[])
+    AS r(key, owner, ttl)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = excluded.owner, expiration_time = excluded.expiration_time
+    WHERE (t.owner = excluded.owner) OR
+    (t.expiration_time <= current_timestamp) RETURNING t.key;
+)";
+  return fmt::format(FMT_COMPILE(kAcquireBatchQueryFmt), table);
+}
+
+// key - $1
+// owner - $2
+std::string MakeReleaseQuery(const std::string& table) {
+  static constexpr auto kReleaseQueryFmt = R"(
+    DELETE FROM {}
+    WHERE key = $1
+    AND owner = $2
+    RETURNING 1;
+)";
+  return fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
+}
+
+std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
+  return fmt::format(FMT_COMPILE("{}:{}"), prefix, locker);
+}
+
+}  // namespace
+
+DistLockGroupStrategy::DistLockGroupStrategy(ClusterPtr cluster,
+                                             const std::string& table,
+                                             CommandControl cc)
+    : cluster_(std::move(cluster)),
+      cc_(cc),
+      acquire_batch_query_(MakeAcquireBatchQuery(table)),
+      release_query_(MakeReleaseQuery(table)),
+      owner_prefix_(hostinfo::blocking::GetRealHostName()) {}
+
+void DistLockGroupStrategy::UpdateCommandControl(CommandControl cc) {
+  auto cc_ptr = cc_.StartWrite();
+  *cc_ptr = cc;
+  cc_ptr.Commit();
+}
+
+std::vector<bool> DistLockGroupStrategy::AcquireBatch(
+    const std::vector<LockRequest>& requests) {
+  std::vector<std::string> keys;
+  std::vector<std::string> owners;
+  std::vector<double> timeouts_seconds;
+  keys.reserve(requests.size());
+  owners.reserve(requests.size());
+  timeouts_seconds.reserve(requests.size());
+  for (const auto& request : requests) {
+    keys.push_back(request.lock_name);
+    owners.push_back(MakeOwnerId(owner_prefix_, request.locker_id));
+    timeouts_seconds.push_back(request.lock_ttl.count() / 1000.0);
+  }
+
+  auto cc_ptr = cc_.Read();
+  const auto result =
+      cluster_->Execute(ClusterHostType::kMaster, *cc_ptr,
+                        acquire_batch_query_, keys, owners, timeouts_seconds);
+  const auto acquired = result.AsContainer<std::unordered_set<std::string>>();
+
+  std::vector<bool> results;
+  results.reserve(requests.size());
+  for (const auto& key : keys) results.push_back(acquired.count(key) != 0);
+  return results;
+}
+
+void DistLockGroupStrategy::Release(const std::string& lock_name,
+                                    const std::string& locker_id) {
+  auto cc_ptr = cc_.Read();
+  cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_,
+                    lock_name, MakeOwnerId(owner_prefix_, locker_id));
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
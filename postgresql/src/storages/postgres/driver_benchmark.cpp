@@ -0,0 +1,188 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/default_command_controls.hpp>
+#include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/pool.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
+#include <utils/gbench_latency.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+using namespace utils::gbench;
+
+pg::ConnectionSettings MakeSettings(pg::PipelineMode pipeline_mode) {
+  pg::ConnectionSettings settings{
+      pg::ConnectionSettings::kCachePreparedStatements};
+  settings.pipeline_mode = pipeline_mode;
+  return settings;
+}
+
+BENCHMARK_F(PgConnection, SelectOneLatency)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    LatencyPercentile latency;
+    for (auto _ : state) {
+      const auto start = std::chrono::steady_clock::now();
+      auto res = GetConnection().Execute("select 1");
+      benchmark::DoNotOptimize(res);
+      Account(latency, start);
+    }
+    ReportLatency(state, latency);
+  });
+}
+
+// state.range(0) statements one by one, with the pipeline mode if
+// state.range(1) is set
+BENCHMARK_DEFINE_F(PgConnection, SequentialStatements)
+(benchmark::State& state) {
+  const auto pipeline_mode = state.range(1) ? pg::PipelineMode::kEnabled
+                                            : pg::PipelineMode::kDisabled;
+  RunStandalone(state, 1, MakeSettings(pipeline_mode), [this, &state] {
+    for (auto _ : state) {
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        auto res = GetConnection().Execute("select $1", i);
+        benchmark::DoNotOptimize(res);
+      }
+    }
+    ReportRate(state, "statements",
+               static_cast<double>(state.iterations() * state.range(0)));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, SequentialStatements)
+    ->ArgsProduct({{1, 8, 64}, {0, 1}})
+    ->ArgNames({"statements", "pipeline"});
+
+// state.range(0) statements in a single round trip
+BENCHMARK_DEFINE_F(PgConnection, BatchStatements)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    pg::QueryBatch batch;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      batch.Append("select $1", i);
+    }
+
+    for (auto _ : state) {
+      auto results = GetConnection().ExecuteBatch(batch);
+      benchmark::DoNotOptimize(results);
+    }
+    ReportRate(state, "statements",
+               static_cast<double>(state.iterations() * state.range(0)));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BatchStatements)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->ArgNames({"statements"});
+
+// A row of a typical users table, about 300 bytes
+const std::string kUsersQuery =
+    "select i::bigint, 'user-' || i, 'user-' || i || '@example.com', "
+    "now() - i * interval '1 minute', i * 0.5::float8, i % 2 = 0, "
+    "repeat(md5(i::text), 6) from generate_series(1, $1) i";
+
+struct UserRow {
+  std::int64_t id;
+  std::string name;
+  std::string email;
+  pg::TimePointTz created;
+  double score;
+  bool active;
+  std::string payload;
+};
+
+// Decoding of state.range(0) rows that are fetched once
+BENCHMARK_DEFINE_F(PgConnection, UsersDecoding)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = GetConnection().Execute(kUsersQuery, state.range(0));
+    for (auto _ : state) {
+      auto rows = res.AsContainer<std::vector<UserRow>>(pg::kRowTag);
+      benchmark::DoNotOptimize(rows);
+    }
+    ReportRate(state, "rows",
+               static_cast<double>(state.iterations() * state.range(0)));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, UsersDecoding)->Range(1, 10'000);
+
+// Fetching and decoding of state.range(0) rows
+BENCHMARK_DEFINE_F(PgConnection, UsersFetch)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    for (auto _ : state) {
+      auto rows = GetConnection()
+                      .Execute(kUsersQuery, state.range(0))
+                      .AsContainer<std::vector<UserRow>>(pg::kRowTag);
+      benchmark::DoNotOptimize(rows);
+    }
+    ReportRate(state, "rows",
+               static_cast<double>(state.iterations() * state.range(0)));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, UsersFetch)->Range(1, 10'000);
+
+constexpr std::size_t kPoolSize = 4;
+constexpr std::size_t kAcquiresPerTask = 16;
+
+// Connection acquisition from a pool of 4 by state.range(0) concurrent tasks
+void PgPoolAcquire(benchmark::State& state) {
+  engine::RunStandalone(kPoolSize, [&] {
+    const auto dsn = GetDsnFromEnv();
+    if (dsn.empty()) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+
+    auto pool = pg::detail::ConnectionPool::Create(
+        dsn, nullptr, engine::current_task::GetTaskProcessor(), "",
+        pg::InitMode::kSync, {kPoolSize, kPoolSize, 1000},
+        {pg::ConnectionSettings::kCachePreparedStatements}, {},
+        pg::DefaultCommandControls(kBenchCmdCtl, {}, {}), {}, {});
+
+    LatencyPercentile latency;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0));
+    for (auto _ : state) {
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&pool, &latency] {
+          for (std::size_t j = 0; j < kAcquiresPerTask; ++j) {
+            const auto start = std::chrono::steady_clock::now();
+            auto connection = pool->Acquire(
+                engine::Deadline::FromDuration(kBenchCmdCtl.execute));
+            Account(latency, start);
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+
+    ReportRate(state, "acquisitions",
+               static_cast<double>(state.iterations() * state.range(0) *
+                                   kAcquiresPerTask));
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(PgPoolAcquire)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->ArgNames({"tasks"})
+    ->UseRealTime();
+
+}  // namespace
+
+USERVER_NAMESPACE_END
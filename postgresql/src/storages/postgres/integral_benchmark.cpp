@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include <storages/postgres/detail/connection.hpp>
 
@@ -53,6 +56,36 @@ BENCHMARK_F(PgConnection, Int64Roundtrip)(benchmark::State& state) {
   });
 }
 
+const std::string kWideResultQuery =
+    "select i::smallint, i, i::bigint, i * 2::bigint, i::float8 "
+    "from generate_series(1, 10000) i";
+using WideRow =
+    std::tuple<std::int16_t, std::int32_t, std::int64_t, std::int64_t, double>;
+
+BENCHMARK_F(PgConnection, WideResultRowwise)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto res = GetConnection().Execute(kWideResultQuery);
+    for (auto _ : state) {
+      std::vector<WideRow> rows;
+      rows.reserve(res.Size());
+      for (const auto& row : res.AsSetOf<WideRow>(pg::kRowTag)) {
+        rows.push_back(row);
+      }
+      benchmark::DoNotOptimize(rows);
+    }
+  });
+}
+
+BENCHMARK_F(PgConnection, WideResultColumnar)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto res = GetConnection().Execute(kWideResultQuery);
+    for (auto _ : state) {
+      auto rows = res.AsContainer<std::vector<WideRow>>(pg::kRowTag);
+      benchmark::DoNotOptimize(rows);
+    }
+  });
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
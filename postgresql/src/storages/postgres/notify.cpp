@@ -0,0 +1,49 @@
+#include <userver/storages/postgres/notify.hpp>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+NotifyScope::NotifyScope(detail::ConnectionPtr conn, std::string_view channel,
+                         OptionalCommandControl cmd_ctl)
+    : conn_{std::move(conn)}, channel_{channel}, cmd_ctl_{cmd_ctl} {
+  conn_->Listen(channel_, cmd_ctl_);
+}
+
+NotifyScope::NotifyScope(NotifyScope&&) noexcept = default;
+
+NotifyScope& NotifyScope::operator=(NotifyScope&& other) noexcept {
+  if (this == &other) return *this;
+  // unlistens the current channel
+  [[maybe_unused]] const NotifyScope old{std::move(*this)};
+  conn_ = std::move(other.conn_);
+  channel_ = std::move(other.channel_);
+  cmd_ctl_ = other.cmd_ctl_;
+  return *this;
+}
+
+NotifyScope::~NotifyScope() {
+  if (!conn_) return;
+  try {
+    conn_->Unlisten(channel_, cmd_ctl_);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to stop listening to channel '"
+                          << channel_ << "': " << e;
+    // the connection may still receive the notifications
+    conn_->MarkAsBroken();
+  }
+}
+
+Notification NotifyScope::WaitNotify(engine::Deadline deadline) {
+  UASSERT(conn_);
+  return conn_->WaitNotify(deadline);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
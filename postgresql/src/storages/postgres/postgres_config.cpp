@@ -63,6 +63,9 @@ ConnectionSettings ParseConnectionSettings(const ConfigType& config) {
   settings.recent_errors_threshold =
       config["recent-errors-threshold"].template As<size_t>(
           settings.recent_errors_threshold);
+  settings.warmup_prepared_statements =
+      config["warmup-prepared-statements"].template As<size_t>(
+          settings.warmup_prepared_statements);
   return settings;
 }
 
@@ -91,6 +94,19 @@ PoolSettings ParsePoolSettings(const ConfigType& config) {
       config["max_queue_size"].template As<size_t>(result.max_queue_size);
   result.connecting_limit =
       config["connecting_limit"].template As<size_t>(result.connecting_limit);
+  result.adaptive_size =
+      config["adaptive_size"].template As<bool>(result.adaptive_size);
+  result.adaptive_max_acquire_wait = TimeoutDuration{
+      config["adaptive_max_acquire_wait_ms"].template As<size_t>(
+          result.adaptive_max_acquire_wait.count())};
+  result.throttling_accepts_multiplier =
+      config["throttling_accepts_multiplier"].template As<double>(
+          result.throttling_accepts_multiplier);
+  result.lifo_acquire =
+      config["lifo_acquire"].template As<bool>(result.lifo_acquire);
+  result.max_idle_time = TimeoutDuration{
+      config["max_idle_time_ms"].template As<size_t>(
+          result.max_idle_time.count())};
 
   if (result.max_size == 0)
     throw InvalidConfig{"max_pool_size must be greater than 0"};
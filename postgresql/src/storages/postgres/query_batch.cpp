@@ -0,0 +1,45 @@
+#include <userver/storages/postgres/query_batch.hpp>
+
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+bool QueryBatchResult::HasError(std::size_t index) const {
+  return !!At(index).error;
+}
+
+std::exception_ptr QueryBatchResult::GetError(std::size_t index) const {
+  return At(index).error;
+}
+
+const ResultSet& QueryBatchResult::Get(std::size_t index) const {
+  const auto& item = At(index);
+  if (item.error) std::rethrow_exception(item.error);
+  return item.result;
+}
+
+void QueryBatchResult::AddResult(ResultSet result) {
+  results_.push_back({std::move(result), {}});
+}
+
+void QueryBatchResult::AddError(std::exception_ptr error) {
+  UASSERT(error);
+  results_.push_back({ResultSet{nullptr}, std::move(error)});
+}
+
+const QueryBatchResult::Item& QueryBatchResult::At(std::size_t index) const {
+  if (index >= results_.size()) {
+    throw LogicError{"Batch result index " + std::to_string(index) +
+                     " is out of bounds, the batch size is " +
+                     std::to_string(results_.size())};
+  }
+  return results_[index];
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
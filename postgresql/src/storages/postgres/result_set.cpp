@@ -241,6 +241,20 @@ void ResultSet::SetBufferCategoriesFrom(const ResultSet& dsc) {
   pimpl_->SetTypeBufferCategories(dsc.pimpl_->GetTypeBufferCategories());
 }
 
+void ResultSet::GetColumnBuffers(size_type column,
+                                 std::vector<io::FieldBuffer>& buffers) const {
+  if (!pimpl_) {
+    buffers.clear();
+    return;
+  }
+  pimpl_->GetColumnBuffers(column, buffers);
+}
+
+const io::TypeBufferCategory& ResultSet::GetTypeBufferCategories() const {
+  UASSERT(pimpl_);
+  return pimpl_->GetTypeBufferCategories();
+}
+
 Row::size_type Row::IndexOfName(const std::string& name) const {
   return res_->IndexOfName(name);
 }
@@ -0,0 +1,57 @@
+#include <userver/storages/postgres/result_stream.hpp>
+
+#include <utility>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+ResultStream::ResultStream(detail::Connection* conn, const Query& query,
+                           const detail::QueryParameters& params,
+                           OptionalCommandControl cmd_ctl,
+                           std::size_t chunk_rows)
+    : conn_{conn} {
+  conn_->ResultStreamStart(query, params, chunk_rows, std::move(cmd_ctl));
+}
+
+ResultStream::ResultStream(ResultStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)} {}
+
+ResultStream& ResultStream::operator=(ResultStream&& other) noexcept {
+  ResultStream{std::move(other)}.Swap(*this);
+  return *this;
+}
+
+ResultStream::~ResultStream() {
+  if (!conn_) return;
+  try {
+    conn_->ResultStreamAbort();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to cancel result stream: " << e;
+  }
+}
+
+std::optional<ResultSet> ResultStream::Fetch() {
+  if (!conn_) return std::nullopt;
+  std::optional<ResultSet> rows;
+  try {
+    rows = conn_->ResultStreamFetch();
+  } catch (const std::exception&) {
+    // the connection finishes the stream on errors
+    conn_ = nullptr;
+    throw;
+  }
+  if (!rows) conn_ = nullptr;
+  return rows;
+}
+
+void ResultStream::Swap(ResultStream& other) noexcept {
+  std::swap(conn_, other.conn_);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
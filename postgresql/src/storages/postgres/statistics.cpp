@@ -51,6 +51,8 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                            {kPostgresqlError, "pool"});
     errors.ValueWithLabels(stats.queue_size_errors,
                            {kPostgresqlError, "queue"});
+    errors.ValueWithLabels(stats.throttled_errors,
+                           {kPostgresqlError, "throttled"});
     errors.ValueWithLabels(stats.connection.error_timeout,
                            {kPostgresqlError, "connection-timeout"});
   }
@@ -257,6 +257,15 @@ UTEST_F(PostgreCluster, HostSelectionSingleQuery) {
                                           pg::ClusterHostType::kNearest},
                                          "select 1"));
   EXPECT_EQ(1, res.Size());
+  UEXPECT_NO_THROW(res = cluster.Execute({pg::ClusterHostType::kSlave,
+                                          pg::ClusterHostType::kLeastLoaded},
+                                         "select 1"));
+  EXPECT_EQ(1, res.Size());
+  UEXPECT_NO_THROW(res = cluster.Execute({pg::ClusterHostType::kSlave,
+                                          pg::ClusterHostType::kMaster,
+                                          pg::ClusterHostType::kLeastLoaded},
+                                         "select 1"));
+  EXPECT_EQ(1, res.Size());
 
   UEXPECT_THROW(cluster.Execute({pg::ClusterHostType::kSlave,
                                  pg::ClusterHostType::kRoundRobin,
@@ -332,4 +341,35 @@ UTEST_F(PostgreCluster, NonTransactionExecuteWithParameterStore) {
   }
 }
 
+UTEST_F(PostgreCluster, QueryResultCache) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor(), 1);
+  cluster.SetQueryResultCacheSettings(
+      {{"cached_query", {std::chrono::seconds{10}}}});
+
+  const std::string statement = "select format('%s %s', clock_timestamp(), $1)";
+  const pg::Query cached{statement, pg::Query::Name{"cached_query"}};
+  const pg::Query uncached{statement, pg::Query::Name{"uncached_query"}};
+  const auto execute = [&cluster](const pg::Query& query, int arg) {
+    return cluster.Execute(pg::ClusterHostType::kMaster, query, arg)
+        .AsSingleRow<std::string>();
+  };
+
+  const auto first = execute(cached, 1);
+  EXPECT_EQ(first, execute(cached, 1));
+  EXPECT_EQ(first, cluster
+                       .Execute(pg::ClusterHostType::kMaster, cached,
+                                pg::ParameterStore{}.PushBack(1))
+                       .AsSingleRow<std::string>());
+  EXPECT_NE(first, execute(cached, 2));
+  EXPECT_NE(execute(uncached, 1), execute(uncached, 1));
+
+  cluster.InvalidateQueryResults("cached_query");
+  const auto refreshed = execute(cached, 1);
+  EXPECT_NE(first, refreshed);
+  EXPECT_EQ(refreshed, execute(cached, 1));
+
+  cluster.SetQueryResultCacheSettings({});
+  EXPECT_NE(execute(cached, 1), execute(cached, 1));
+}
+
 USERVER_NAMESPACE_END
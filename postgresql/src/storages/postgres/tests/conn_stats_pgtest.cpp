@@ -4,6 +4,7 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 
@@ -226,6 +227,39 @@ UTEST_P(PostgreStats, PortalDuplicateName) {
             old_stats.prepared_statements_current);
 }
 
+UTEST_P(PostgreStats, TaskDeadlineTimeout) {
+  [[maybe_unused]] const auto old_stats = GetConn()->GetStatsAndReset();
+
+  const std::string method = "GET";
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(),
+       engine::Deadline::FromDuration(std::chrono::milliseconds{50})});
+
+  // the execute timeout is shrunk by the deadline of the handled request
+  UEXPECT_THROW(GetConn()->Execute("select pg_sleep(0.2)"),
+                pg::ConnectionTimeoutError);
+  EXPECT_EQ(pg::ConnectionState::kTranActive, GetConn()->GetState());
+  // the statement is left to finish instead of being cancelled
+  UEXPECT_NO_THROW(GetConn()->CancelAndCleanup(utest::kMaxTestWaitTime));
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+
+  // no statements are sent after the deadline
+  UEXPECT_THROW(GetConn()->Execute("select 1"), pg::ConnectionTimeoutError);
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+
+  // the database is not to blame, so the timeouts are not accounted
+  const auto stats = GetConn()->GetStatsAndReset();
+  EXPECT_EQ(0, stats.execute_timeout);
+
+  server::request::kTaskInheritedData.Erase();
+  DefaultCommandControlScope scope(pg::CommandControl{
+      std::chrono::milliseconds{10}, std::chrono::milliseconds{0}});
+  UEXPECT_THROW(GetConn()->Execute("select pg_sleep(1)"),
+                pg::ConnectionTimeoutError);
+  UEXPECT_NO_THROW(GetConn()->CancelAndCleanup(utest::kMaxTestWaitTime));
+  EXPECT_EQ(1, GetConn()->GetStatsAndReset().execute_timeout);
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/null.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const std::string kCreateTable = R"~(
+    create temporary table copy_test(
+      id integer primary key,
+      name text,
+      vals bigint[])
+    )~";
+
+UTEST_P(PostgreConnection, CopyInOut) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+
+  constexpr int kRows = 10000;
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test",
+                          {"id", "name", "vals"}};
+    for (int i = 0; i < kRows; ++i) {
+      std::optional<std::string> name;
+      if (i % 2) name = "name " + std::to_string(i);
+      copy.WriteRow(i, name, std::vector<std::int64_t>{i, i * 2});
+    }
+    EXPECT_EQ(pg::ConnectionState::kTranActive, GetConn()->GetState());
+    EXPECT_EQ(kRows, copy.Finish());
+    UEXPECT_THROW(copy.WriteRow(0, std::string{}, std::vector<std::int64_t>{}),
+                  pg::LogicError);
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranIdle, GetConn()->GetState());
+  EXPECT_EQ(kRows, GetConn()
+                       ->Execute("select count(*) from copy_test")
+                       .AsSingleRow<std::int64_t>());
+
+  {
+    pg::CopyOutStream copy{GetConn().get(),
+                           "select id, name, vals from copy_test order by id"};
+    int id = -1;
+    std::optional<std::string> name;
+    std::vector<std::int64_t> values;
+    int expected = 0;
+    while (copy.ReadRow(id, name, values)) {
+      ASSERT_EQ(expected, id);
+      if (id % 2) {
+        EXPECT_EQ("name " + std::to_string(id), name);
+      } else {
+        EXPECT_FALSE(name);
+      }
+      EXPECT_EQ((std::vector<std::int64_t>{id, id * 2}), values);
+      ++expected;
+    }
+    EXPECT_EQ(kRows, expected);
+    EXPECT_FALSE(copy.ReadRow(id, name, values));
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranIdle, GetConn()->GetState());
+
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+}
+
+UTEST_P(PostgreConnection, CopyInErrors) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+
+  UEXPECT_THROW(pg::CopyInStream(GetConn().get(), "no_such_table", {}),
+                pg::AccessRuleViolation);
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test", {"id", "name"}};
+    UEXPECT_THROW(copy.WriteRow(1), pg::FieldTupleMismatch);
+    copy.WriteRow(1, std::string{"first"});
+    copy.WriteRow(1, std::string{"duplicate"});
+    UEXPECT_THROW(copy.Finish(), pg::UniqueViolation);
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+}
+
+UTEST_P(PostgreConnection, CopyAbort) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test", {"id"}};
+    copy.WriteRow(1);
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  {
+    pg::CopyOutStream copy{GetConn().get(),
+                           "select generate_series(1, 1000000)"};
+    int value = 0;
+    EXPECT_TRUE(copy.ReadRow(value));
+    EXPECT_EQ(1, value);
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
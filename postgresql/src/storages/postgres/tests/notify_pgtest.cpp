@@ -0,0 +1,87 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/notify.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::chrono::milliseconds kShortTimeout{50};
+
+UTEST_P(PostgreConnection, ListenNotify) {
+  CheckConnection(GetConn());
+  auto listener = MakeConnection(GetDsnFromEnv(), GetTaskProcessor());
+  UASSERT_NO_THROW(listener->Listen("notify_test", {}));
+
+  UEXPECT_THROW(listener->WaitNotify(engine::Deadline::FromDuration(
+                    kShortTimeout)),
+                pg::ConnectionTimeoutError);
+  EXPECT_EQ(pg::ConnectionState::kIdle, listener->GetState());
+
+  UASSERT_NO_THROW(GetConn()->Execute("notify notify_test"));
+  UASSERT_NO_THROW(GetConn()->Execute("select pg_notify($1, $2)",
+                                      std::string{"notify_test"},
+                                      std::string{"payload"}));
+  // the notifications of the other channels are not received
+  UASSERT_NO_THROW(GetConn()->Execute("notify other_channel"));
+
+  auto notification = listener->WaitNotify(MakeDeadline());
+  EXPECT_EQ("notify_test", notification.channel);
+  EXPECT_EQ("", notification.payload);
+  notification = listener->WaitNotify(MakeDeadline());
+  EXPECT_EQ("notify_test", notification.channel);
+  EXPECT_EQ("payload", notification.payload);
+
+  // the connection is usable for queries in between
+  EXPECT_EQ(1, listener->Execute("select 1").AsSingleRow<int>());
+
+  UASSERT_NO_THROW(GetConn()->Execute("notify notify_test, 'pending'"));
+  UASSERT_NO_THROW(GetConn()->Execute("select pg_sleep(0.1)"));
+  UASSERT_NO_THROW(listener->Execute("select 1"));
+  UASSERT_NO_THROW(listener->Unlisten("notify_test", {}));
+  // the pending notification is discarded
+  UEXPECT_THROW(listener->WaitNotify(engine::Deadline::FromDuration(
+                    kShortTimeout)),
+                pg::ConnectionTimeoutError);
+  CheckConnection(listener);
+}
+
+UTEST_P(PostgreConnection, NotifyScope) {
+  CheckConnection(GetConn());
+  {
+    pg::NotifyScope scope{MakeConnection(GetDsnFromEnv(), GetTaskProcessor()),
+                          "Mixed Case Channel", {}};
+
+    auto task = engine::AsyncNoSpan([&scope] {
+      return scope.WaitNotify(engine::Deadline{}).payload;
+    });
+    UASSERT_NO_THROW(
+        GetConn()->Execute(R"~(notify "Mixed Case Channel", 'first')~"));
+    EXPECT_EQ("first", task.Get());
+
+    pg::NotifyScope moved{std::move(scope)};
+    UASSERT_NO_THROW(
+        GetConn()->Execute(R"~(notify "Mixed Case Channel", 'second')~"));
+    EXPECT_EQ("second", moved.WaitNotify(MakeDeadline()).payload);
+  }
+  {
+    pg::NotifyScope scope{MakeConnection(GetDsnFromEnv(), GetTaskProcessor()),
+                          "notify_test", {}};
+    auto task = engine::AsyncNoSpan(
+        [&scope] { return scope.WaitNotify(engine::Deadline{}); });
+    // lets the task start waiting
+    engine::SleepFor(kShortTimeout);
+    task.RequestCancel();
+    UEXPECT_THROW(task.Get(), pg::ConnectionInterrupted);
+  }
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -256,6 +256,31 @@ UTEST_F(PostgrePool, QueryCancel) {
   }
 }
 
+UTEST_F(PostgrePool, LifoAcquire) {
+  pg::PoolSettings settings{2, 2, 10};
+  settings.lifo_acquire = true;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kSync, settings, kCachePreparedStatements,
+      {}, GetTestCmdCtls(), {}, {});
+
+  pg::detail::ConnectionPtr first{nullptr};
+  pg::detail::ConnectionPtr second{nullptr};
+  UASSERT_NO_THROW(first = pool->Acquire(MakeDeadline()));
+  UASSERT_NO_THROW(second = pool->Acquire(MakeDeadline()));
+  const auto* second_ptr = &*second;
+  first = pg::detail::ConnectionPtr{nullptr};
+  second = pg::detail::ConnectionPtr{nullptr};
+
+  // the most recently released connection is reused every time
+  for (int i = 0; i < 3; ++i) {
+    pg::detail::ConnectionPtr conn{nullptr};
+    UASSERT_NO_THROW(conn = pool->Acquire(MakeDeadline()));
+    EXPECT_EQ(second_ptr, &*conn);
+    CheckConnection(std::move(conn));
+  }
+}
+
 UTEST_F(PostgrePool, DefaultCmdCtl) {
   using Source = pg::detail::DefaultCommandControlSource;
   const pg::CommandControl custom_cmd_ctl{std::chrono::seconds{2},
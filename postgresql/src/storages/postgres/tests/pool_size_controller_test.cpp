@@ -0,0 +1,91 @@
+#include <userver/utest/utest.hpp>
+
+#include <storages/postgres/detail/pool_size_controller.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using Sample = pg::detail::PoolSizeController::Sample;
+
+pg::PoolSettings MakeSettings() {
+  pg::PoolSettings settings;
+  settings.min_size = 4;
+  settings.max_size = 40;
+  settings.adaptive_size = true;
+  settings.adaptive_max_acquire_wait = std::chrono::milliseconds{10};
+  return settings;
+}
+
+}  // namespace
+
+TEST(PostgrePoolSizeController, GrowsOnWaiting) {
+  const auto settings = MakeSettings();
+  pg::detail::PoolSizeController controller;
+
+  EXPECT_EQ(5, controller.Update({4, 4, 3, 50, 10}, settings));
+  EXPECT_EQ(6, controller.Update({5, 5, 2, 30, 10}, settings));
+  // slow acquire without waiters at the moment is a pressure too
+  EXPECT_EQ(7, controller.Update({6, 6, 0, 30, 10}, settings));
+}
+
+TEST(PostgrePoolSizeController, RespectsBounds) {
+  const auto settings = MakeSettings();
+  pg::detail::PoolSizeController controller;
+
+  std::size_t size = settings.min_size;
+  for (int i = 0; i < 100; ++i) {
+    size = controller.Update({size, size, 10, 100, 10}, settings);
+    EXPECT_LE(size, settings.max_size);
+  }
+  EXPECT_EQ(settings.max_size, size);
+
+  for (int i = 0; i < 100; ++i) {
+    size = controller.Update({size, 0, 0, 0, 1}, settings);
+    EXPECT_GE(size, settings.min_size);
+  }
+  EXPECT_EQ(settings.min_size, size);
+}
+
+TEST(PostgrePoolSizeController, StopsOnServerSaturation) {
+  const auto settings = MakeSettings();
+  pg::detail::PoolSizeController controller;
+
+  EXPECT_EQ(5, controller.Update({4, 4, 3, 50, 10}, settings));
+  EXPECT_EQ(6, controller.Update({5, 5, 3, 50, 15}, settings));
+  // queries became much slower than before the pool started to grow
+  EXPECT_EQ(6, controller.Update({6, 6, 3, 50, 40}, settings));
+  EXPECT_EQ(6, controller.Update({6, 6, 3, 50, 40}, settings));
+}
+
+TEST(PostgrePoolSizeController, ShrinksGradually) {
+  const auto settings = MakeSettings();
+  pg::detail::PoolSizeController controller;
+
+  EXPECT_EQ(20, controller.Update({20, 10, 0, 0, 10}, settings));
+  EXPECT_EQ(20, controller.Update({20, 10, 0, 0, 10}, settings));
+  EXPECT_EQ(15, controller.Update({20, 10, 0, 0, 10}, settings));
+  EXPECT_EQ(12, controller.Update({15, 10, 0, 0, 10}, settings));
+  // peak usage with headroom is kept
+  EXPECT_EQ(12, controller.Update({12, 10, 0, 0, 10}, settings));
+
+  // a burst resets the calm periods counter
+  EXPECT_EQ(12, controller.Update({12, 12, 0, 0, 10}, settings));
+  EXPECT_EQ(12, controller.Update({12, 1, 0, 0, 10}, settings));
+  EXPECT_EQ(12, controller.Update({12, 1, 0, 0, 10}, settings));
+  EXPECT_EQ(9, controller.Update({12, 1, 0, 0, 10}, settings));
+}
+
+TEST(PostgrePoolSizeController, Reset) {
+  const auto settings = MakeSettings();
+  pg::detail::PoolSizeController controller;
+
+  EXPECT_EQ(5, controller.Update({4, 4, 3, 50, 10}, settings));
+  controller.Reset();
+  EXPECT_EQ(0, controller.GetTarget());
+  EXPECT_EQ(settings.max_size,
+            controller.Update({100, 100, 0, 0, 10}, settings));
+}
+
+USERVER_NAMESPACE_END
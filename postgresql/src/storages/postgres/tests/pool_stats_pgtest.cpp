@@ -276,6 +276,34 @@ UTEST_F(PostgrePoolStats, MaxPreparedCacheSize) {
             conn_settings.max_prepared_cache_size);
 }
 
+UTEST_F(PostgrePoolStats, WarmupPreparedStatements) {
+  pg::ConnectionSettings conn_settings;
+  conn_settings.warmup_prepared_statements = 10;
+
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kAsync, {1, 10, 10}, conn_settings, {},
+      GetTestCmdCtls(), {}, {});
+
+  auto conn = pg::detail::ConnectionPtr{nullptr};
+  UASSERT_NO_THROW(conn = pool->Acquire(MakeDeadline()))
+      << "Obtained connection from pool";
+  UEXPECT_NO_THROW(conn->Execute("select 1"));
+  UEXPECT_NO_THROW(conn->Execute("select $1::integer", 1));
+
+  // the first connection is busy, so a new one is created
+  auto new_conn = pg::detail::ConnectionPtr{nullptr};
+  UASSERT_NO_THROW(new_conn = pool->Acquire(MakeDeadline()))
+      << "Obtained connection from pool";
+  auto warmup_stats = new_conn->GetStatsAndReset();
+  EXPECT_GE(warmup_stats.prepared_statements_current, 2);
+
+  UEXPECT_NO_THROW(new_conn->Execute("select 1"));
+  UEXPECT_NO_THROW(new_conn->Execute("select $1::integer", 2));
+  auto stats = new_conn->GetStatsAndReset();
+  EXPECT_EQ(stats.parse_total, 0);
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
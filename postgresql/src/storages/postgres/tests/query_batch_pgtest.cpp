@@ -0,0 +1,101 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+UTEST_P(PostgreConnection, QueryBatchEmpty) {
+  CheckConnection(GetConn());
+
+  pg::QueryBatchResult res;
+  UEXPECT_NO_THROW(res = GetConn()->ExecuteBatch(pg::QueryBatch{}));
+  EXPECT_EQ(0, res.Size());
+  UEXPECT_THROW(res.Get(0), pg::LogicError);
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+}
+
+UTEST_P(PostgreConnection, QueryBatchResults) {
+  CheckConnection(GetConn());
+
+  pg::QueryBatch batch;
+  batch.Append("select $1", 1)
+      .Append("select $1::text", std::string{"two"})
+      .Append("select generate_series(1, $1)", 3);
+  EXPECT_EQ(3, batch.Size());
+
+  pg::QueryBatchResult res;
+  UASSERT_NO_THROW(res = GetConn()->ExecuteBatch(batch));
+  ASSERT_EQ(3, res.Size());
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+
+  for (std::size_t i = 0; i < res.Size(); ++i) {
+    EXPECT_FALSE(res.HasError(i)) << "Statement " << i;
+  }
+  EXPECT_EQ(1, res.Get(0).AsSingleRow<int>());
+  EXPECT_EQ("two", res.Get(1).AsSingleRow<std::string>());
+  EXPECT_EQ((std::vector<int>{1, 2, 3}),
+            res.Get(2).AsContainer<std::vector<int>>());
+
+  // the connection is usable after the batch
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+UTEST_P(PostgreConnection, QueryBatchErrors) {
+  CheckConnection(GetConn());
+
+  pg::QueryBatch batch;
+  batch.Append("select 1")
+      .Append("elect")
+      .Append("select 1 / $1", 0)
+      .Append("select 4");
+
+  pg::QueryBatchResult res;
+  UASSERT_NO_THROW(res = GetConn()->ExecuteBatch(batch));
+  ASSERT_EQ(4, res.Size());
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+
+  EXPECT_FALSE(res.HasError(0));
+  EXPECT_EQ(1, res.Get(0).AsSingleRow<int>());
+  EXPECT_TRUE(res.HasError(1));
+  UEXPECT_THROW(res.Get(1), pg::SyntaxError);
+  EXPECT_TRUE(res.HasError(2));
+  UEXPECT_THROW(res.Get(2), pg::DataException);
+  EXPECT_FALSE(res.HasError(3));
+  EXPECT_EQ(4, res.Get(3).AsSingleRow<int>());
+
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+UTEST_P(PostgreConnection, QueryBatchInTransaction) {
+  CheckConnection(GetConn());
+
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  UASSERT_NO_THROW(
+      GetConn()->Execute("create temporary table batch_test(id integer)"));
+
+  pg::QueryBatch batch;
+  batch.Append("insert into batch_test values ($1)", 1)
+      .Append("insert into batch_test values ($1)", 2)
+      .Append("select count(*)::integer from batch_test");
+
+  pg::QueryBatchResult res;
+  UASSERT_NO_THROW(res = GetConn()->ExecuteBatch(batch));
+  ASSERT_EQ(3, res.Size());
+  EXPECT_EQ(1, res.Get(0).RowsAffected());
+  EXPECT_EQ(1, res.Get(1).RowsAffected());
+  EXPECT_EQ(2, res.Get(2).AsSingleRow<int>());
+  EXPECT_EQ(pg::ConnectionState::kTranIdle, GetConn()->GetState());
+
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,118 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr int kRows = 10000;
+
+UTEST_P(PostgreConnection, ResultStreamRows) {
+  CheckConnection(GetConn());
+  {
+    pg::ResultStream stream{GetConn().get(),
+                            "select i, 'row ' || i from generate_series(1, "
+                            "10000) i",
+                            {}};
+    EXPECT_FALSE(stream.Done());
+    int expected = 1;
+    for (const auto& [i, name] :
+         stream.AsSetOf<std::tuple<int, std::string>>(pg::kRowTag)) {
+      ASSERT_EQ(expected, i);
+      EXPECT_EQ("row " + std::to_string(i), name);
+      ++expected;
+    }
+    EXPECT_EQ(kRows + 1, expected);
+    EXPECT_TRUE(stream.Done());
+    EXPECT_FALSE(stream.Fetch());
+  }
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  CheckConnection(GetConn());
+}
+
+UTEST_P(PostgreConnection, ResultStreamChunks) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  {
+    pg::ResultStream stream{GetConn().get(), "select 1 where false", {}};
+    EXPECT_FALSE(stream.Fetch());
+    EXPECT_TRUE(stream.Done());
+  }
+  {
+    pg::ResultStream stream{
+        GetConn().get(), "select i from generate_series(1, 100) i", {}};
+    std::size_t rows = 0;
+    while (auto chunk = stream.Fetch()) {
+      EXPECT_LE(chunk->Size(), pg::ResultStream::kDefaultChunkRows);
+      EXPECT_EQ(1, chunk->FieldCount());
+      for (const auto& row : *chunk) {
+        EXPECT_EQ(++rows, row[0].As<int>());
+      }
+    }
+    EXPECT_EQ(100, rows);
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranIdle, GetConn()->GetState());
+  EXPECT_EQ(1, GetConn()->Execute("select 1").AsSingleRow<int>());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+}
+
+UTEST_P(PostgreConnection, ResultStreamError) {
+  CheckConnection(GetConn());
+  pg::ResultStream stream{
+      GetConn().get(),
+      "select 1 / (5000 - i) from generate_series(1, 10000) i",
+      {}};
+  std::size_t rows = 0;
+  UEXPECT_THROW(
+      for (auto value
+           : stream.AsSetOf<int>()) {
+        static_cast<void>(value);
+        ++rows;
+      },
+      pg::DataException);
+  EXPECT_EQ(4999, rows);
+  EXPECT_TRUE(stream.Done());
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  CheckConnection(GetConn());
+
+  UEXPECT_THROW(pg::ResultStream(GetConn().get(), "elect 1", {}),
+                pg::SyntaxError);
+  CheckConnection(GetConn());
+}
+
+UTEST_P(PostgreConnection, ResultStreamAbort) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Begin({}, {}));
+  {
+    pg::ResultStream stream{
+        GetConn().get(), "select i from generate_series(1, 1000000) i", {}};
+    auto chunk = stream.Fetch();
+    ASSERT_TRUE(chunk);
+    EXPECT_EQ(1, chunk->Front().As<int>());
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  CheckConnection(GetConn());
+}
+
+UTEST_P(PostgreConnection, ResultStreamParams) {
+  CheckConnection(GetConn());
+  pg::detail::StaticQueryParameters<1> params;
+  params.Write(GetConn()->GetUserTypes(), kRows);
+  pg::ResultStream stream{GetConn().get(),
+                          "select i from generate_series(1, $1) i",
+                          pg::detail::QueryParameters{params}};
+  int sum = 0;
+  for (auto i : stream.AsSetOf<int>()) sum += i;
+  EXPECT_EQ(kRows * (kRows + 1) / 2, sum);
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,140 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/statement_timings_storage.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+
+constexpr bool kWithCurrentEpoch = true;
+
+}  // namespace
+
+UTEST(PostgreStatementTimings, Disabled) {
+  pg::detail::StatementTimingsStorage storage{{0}};
+  storage.Account("statement", 10);
+  storage.WaitForExhaustion();
+  EXPECT_TRUE(storage.GetTimingsPercentiles(kWithCurrentEpoch).empty());
+}
+
+UTEST(PostgreStatementTimings, PerStatementPercentiles) {
+  pg::detail::StatementTimingsStorage storage{{10}};
+  for (std::size_t i = 1; i <= 100; ++i) storage.Account("slow", 100 + i);
+  for (std::size_t i = 1; i <= 10; ++i) storage.Account("fast", i);
+  storage.WaitForExhaustion();
+
+  const auto timings = storage.GetTimingsPercentiles(kWithCurrentEpoch);
+  ASSERT_EQ(timings.size(), 2);
+
+  const auto& slow = timings.at("slow");
+  EXPECT_EQ(slow.Count(), 100);
+  EXPECT_EQ(slow.GetPercentile(50), 151);
+  EXPECT_EQ(slow.GetPercentile(100), 200);
+
+  const auto& fast = timings.at("fast");
+  EXPECT_EQ(fast.Count(), 10);
+  EXPECT_EQ(fast.GetPercentile(100), 10);
+}
+
+UTEST(PostgreStatementTimings, RepeatedMerges) {
+  pg::detail::StatementTimingsStorage storage{{10}};
+  for (int merge = 0; merge < 3; ++merge) {
+    for (std::size_t i = 0; i < 5; ++i) storage.Account("statement", 42);
+    storage.WaitForExhaustion();
+  }
+  // nothing new to merge
+  storage.WaitForExhaustion();
+
+  const auto timings = storage.GetTimingsPercentiles(kWithCurrentEpoch);
+  ASSERT_EQ(timings.size(), 1);
+  EXPECT_EQ(timings.at("statement").Count(), 15);
+  EXPECT_EQ(timings.at("statement").GetPercentile(50), 42);
+}
+
+UTEST_MT(PostgreStatementTimings, MergesAllShards, 4) {
+  constexpr std::size_t kTasks = 16;
+  constexpr std::size_t kAccountsPerTask = 100;
+
+  pg::detail::StatementTimingsStorage storage{{10}};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&storage] {
+      for (std::size_t j = 0; j < kAccountsPerTask; ++j) {
+        storage.Account("statement", 7);
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+  storage.WaitForExhaustion();
+
+  const auto timings = storage.GetTimingsPercentiles(kWithCurrentEpoch);
+  ASSERT_EQ(timings.size(), 1);
+  EXPECT_EQ(timings.at("statement").Count(), kTasks * kAccountsPerTask);
+}
+
+UTEST(PostgreStatementTimings, KeepsStatementBuffers) {
+  using Names = std::vector<std::string>;
+  pg::detail::StatementTimingsStorage storage{{10}};
+  EXPECT_EQ(storage.GetBufferedStatements(), Names{});
+
+  storage.Account("first", 1);
+  storage.Account("second", 2);
+  storage.WaitForExhaustion();
+  EXPECT_EQ(storage.GetBufferedStatements(), (Names{"first", "second"}));
+
+  // the buffers of the statements not accounted since the previous merge of
+  // the shard are dropped on the next one
+  storage.Account("first", 3);
+  storage.WaitForExhaustion();
+  storage.Account("first", 5);
+  storage.WaitForExhaustion();
+  EXPECT_EQ(storage.GetBufferedStatements(), Names{"first"});
+
+  const auto timings = storage.GetTimingsPercentiles(kWithCurrentEpoch);
+  ASSERT_EQ(timings.size(), 2);
+  EXPECT_EQ(timings.at("first").Count(), 3);
+  EXPECT_EQ(timings.at("first").GetPercentile(100), 5);
+  EXPECT_EQ(timings.at("second").Count(), 1);
+  EXPECT_EQ(timings.at("second").GetPercentile(100), 2);
+}
+
+UTEST_MT(PostgreStatementTimings, MergesShardBuffers, 4) {
+  constexpr std::size_t kTasks = 16;
+  constexpr std::size_t kRounds = 3;
+
+  pg::detail::StatementTimingsStorage storage{{10}};
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasks);
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&storage, i] {
+        storage.Account("shared", 10);
+        storage.Account("task_" + std::to_string(i % 2), 20 + i % 2);
+      }));
+    }
+    for (auto& task : tasks) task.Get();
+    storage.WaitForExhaustion();
+  }
+
+  EXPECT_EQ(storage.GetBufferedStatements(),
+            (std::vector<std::string>{"shared", "task_0", "task_1"}));
+
+  const auto timings = storage.GetTimingsPercentiles(kWithCurrentEpoch);
+  ASSERT_EQ(timings.size(), 3);
+  EXPECT_EQ(timings.at("shared").Count(), kTasks * kRounds);
+  EXPECT_EQ(timings.at("shared").GetPercentile(50), 10);
+  EXPECT_EQ(timings.at("task_0").Count(), kTasks * kRounds / 2);
+  EXPECT_EQ(timings.at("task_0").GetPercentile(100), 20);
+  EXPECT_EQ(timings.at("task_1").Count(), kTasks * kRounds / 2);
+  EXPECT_EQ(timings.at("task_1").GetPercentile(100), 21);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+
+#include <storages/postgres/detail/task_deadline.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+
+void SetTaskDeadline(const std::string& method, engine::Deadline deadline) {
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(), deadline});
+}
+
+}  // namespace
+
+UTEST(PostgreTaskDeadline, NoTaskDeadline) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  EXPECT_EQ(pg::detail::LimitByTaskDeadline(deadline), deadline);
+  EXPECT_FALSE(pg::detail::IsTaskDeadlineReached());
+}
+
+UTEST(PostgreTaskDeadline, Shrunk) {
+  const std::string method = "GET";
+  const auto task_deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{1});
+  SetTaskDeadline(method, task_deadline);
+
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  EXPECT_EQ(pg::detail::LimitByTaskDeadline(deadline), task_deadline);
+  EXPECT_FALSE(pg::detail::IsTaskDeadlineReached());
+
+  // a shorter statement deadline is kept as is
+  const auto short_deadline =
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10});
+  EXPECT_EQ(pg::detail::LimitByTaskDeadline(short_deadline), short_deadline);
+}
+
+UTEST(PostgreTaskDeadline, Reached) {
+  const std::string method = "GET";
+  SetTaskDeadline(method, engine::Deadline::Passed());
+
+  EXPECT_TRUE(pg::detail::IsTaskDeadlineReached());
+  UEXPECT_THROW(pg::detail::LimitByTaskDeadline(
+                    engine::Deadline::FromDuration(utest::kMaxTestWaitTime)),
+                pg::ConnectionTimeoutError);
+
+  // background tasks are not limited by the handled request
+  server::request::kTaskInheritedData.Erase();
+  EXPECT_FALSE(pg::detail::IsTaskDeadlineReached());
+}
+
+USERVER_NAMESPACE_END
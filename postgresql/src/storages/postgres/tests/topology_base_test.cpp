@@ -0,0 +1,56 @@
+#include <userver/utest/utest.hpp>
+
+#include <storages/postgres/detail/topology/base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace topology = storages::postgres::detail::topology;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+constexpr milliseconds kMaxLag{1000};
+
+}  // namespace
+
+TEST(PostgreTopology, HostCostInFlight) {
+  const topology::HostMetrics metrics{microseconds{1000}, milliseconds{0}};
+  EXPECT_LT(topology::EstimateHostCost(metrics, 0, kMaxLag),
+            topology::EstimateHostCost(metrics, 1, kMaxLag));
+  EXPECT_LT(topology::EstimateHostCost(metrics, 1, kMaxLag),
+            topology::EstimateHostCost(metrics, 10, kMaxLag));
+}
+
+TEST(PostgreTopology, HostCostRtt) {
+  const topology::HostMetrics near{microseconds{1000}, milliseconds{0}};
+  const topology::HostMetrics far{microseconds{20000}, milliseconds{0}};
+  EXPECT_LT(topology::EstimateHostCost(near, 0, kMaxLag),
+            topology::EstimateHostCost(far, 0, kMaxLag));
+  // a busy near host loses to an idle far one
+  EXPECT_GT(topology::EstimateHostCost(near, 30, kMaxLag),
+            topology::EstimateHostCost(far, 0, kMaxLag));
+
+  // tiny RTT differences are ignored
+  const topology::HostMetrics nearest{microseconds{10}, milliseconds{0}};
+  const topology::HostMetrics next{microseconds{100}, milliseconds{0}};
+  EXPECT_EQ(topology::EstimateHostCost(nearest, 1, kMaxLag),
+            topology::EstimateHostCost(next, 1, kMaxLag));
+}
+
+TEST(PostgreTopology, HostCostReplicationLag) {
+  const topology::HostMetrics fresh{microseconds{1000}, milliseconds{0}};
+  const topology::HostMetrics lagging{microseconds{1000}, milliseconds{500}};
+  const topology::HostMetrics stale{microseconds{1000}, milliseconds{5000}};
+  EXPECT_LT(topology::EstimateHostCost(fresh, 1, kMaxLag),
+            topology::EstimateHostCost(lagging, 1, kMaxLag));
+  EXPECT_LT(topology::EstimateHostCost(lagging, 1, kMaxLag),
+            topology::EstimateHostCost(stale, 1, kMaxLag));
+  EXPECT_DOUBLE_EQ(2 * topology::EstimateHostCost(fresh, 1, kMaxLag),
+                   topology::EstimateHostCost(stale, 1, kMaxLag));
+  // lag is not accounted without the limit
+  EXPECT_DOUBLE_EQ(topology::EstimateHostCost(fresh, 1, milliseconds{0}),
+                   topology::EstimateHostCost(stale, 1, milliseconds{0}));
+}
+
+USERVER_NAMESPACE_END
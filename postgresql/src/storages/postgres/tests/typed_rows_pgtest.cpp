@@ -175,6 +175,45 @@ UTEST_P(PostgreConnection, OptionalFields) {
   UEXPECT_NO_THROW(res.AsSingleRow<MyStruct>(pg::kRowTag));
 }
 
+UTEST_P(PostgreConnection, ColumnarContainer) {
+  using Row = std::tuple<int, std::optional<std::int64_t>, double>;
+
+  CheckConnection(GetConn());
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute(
+          "select i, case when i % 3 = 0 then null else i * 2 end::bigint, "
+          "i / 2.0::float8 from generate_series(1, 1000) i"));
+  ASSERT_EQ(1000, res.Size());
+
+  std::vector<Row> expected;
+  for (const auto& row : res.AsSetOf<Row>(pg::kRowTag)) {
+    expected.push_back(row);
+  }
+  EXPECT_EQ(expected, res.AsContainer<std::vector<Row>>(pg::kRowTag));
+
+  auto ints = res.AsContainer<std::vector<Row>>(pg::kRowTag);
+  EXPECT_EQ(1, std::get<0>(ints.front()));
+  EXPECT_EQ(2, std::get<1>(ints.front()));
+  EXPECT_FALSE(std::get<1>(ints[2]));
+
+  UEXPECT_THROW((res.AsContainer<std::vector<std::tuple<int, std::int64_t>>>(
+                    pg::kRowTag)),
+                pg::FieldValueIsNull);
+  UEXPECT_THROW(
+      (res.AsContainer<std::vector<std::tuple<std::string>>>(pg::kRowTag)),
+      pg::InvalidParserCategory);
+  UEXPECT_THROW(res.AsContainer<std::vector<int>>(),
+                pg::NonSingleColumResultSet);
+
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute("select i from generate_series(1, 100) i"));
+  auto values = res.AsContainer<std::vector<int>>();
+  ASSERT_EQ(100, values.size());
+  EXPECT_EQ(1, values.front());
+  EXPECT_EQ(100, values.back());
+}
+
 UTEST_P(PostgreConnection, EmptyTypedResult) {
   using MyTuple = static_test::MyTupleType;
   using MyStruct = static_test::MyAggregateStruct;
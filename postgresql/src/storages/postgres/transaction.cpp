@@ -45,6 +45,41 @@ ResultSet Transaction::Execute(OptionalCommandControl statement_cmd_ctl,
                    statement_cmd_ctl);
 }
 
+QueryBatchResult Transaction::ExecuteBatch(
+    OptionalCommandControl statement_cmd_ctl, const QueryBatch& batch) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "ExecuteBatch called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return conn_->ExecuteBatch(batch, std::move(statement_cmd_ctl));
+}
+
+CopyInStream Transaction::CopyIn(OptionalCommandControl statement_cmd_ctl,
+                                 const std::string& table,
+                                 const std::vector<std::string>& columns) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyIn called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyInStream{conn_.get(), table, columns,
+                      std::move(statement_cmd_ctl)};
+}
+
+CopyOutStream Transaction::CopyOut(OptionalCommandControl statement_cmd_ctl,
+                                   const Query& query) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyOut called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return CopyOutStream{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
 Portal Transaction::MakePortal(OptionalCommandControl statement_cmd_ctl,
                                const Query& query,
                                const ParameterStore& store) {
@@ -53,6 +88,14 @@ Portal Transaction::MakePortal(OptionalCommandControl statement_cmd_ctl,
                     statement_cmd_ctl);
 }
 
+ResultStream Transaction::MakeResultStream(
+    OptionalCommandControl statement_cmd_ctl, const Query& query,
+    const ParameterStore& store) {
+  return MakeResultStream(query,
+                          detail::QueryParameters{store.GetInternalData()},
+                          std::move(statement_cmd_ctl));
+}
+
 ResultSet Transaction::DoExecute(const Query& query,
                                  const detail::QueryParameters& params,
                                  OptionalCommandControl statement_cmd_ctl) {
@@ -92,6 +135,21 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+ResultStream Transaction::MakeResultStream(
+    const Query& query, const detail::QueryParameters& params,
+    OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "MakeResultStream called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return ResultStream{conn_.get(), query, params,
+                      std::move(statement_cmd_ctl)};
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
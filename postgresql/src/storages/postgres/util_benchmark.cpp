@@ -11,8 +11,6 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::bench {
 
-namespace {
-
 Dsn GetDsnFromEnv() {
   auto* conn_list_env = std::getenv(kPostgresDsn);
   if (!conn_list_env) {
@@ -25,8 +23,6 @@ Dsn GetDsnFromEnv() {
   return by_host[0];
 }
 
-}  // namespace
-
 void PgConnection::RunStandalone(benchmark::State& state,
                                  std::function<void()> payload) {
   RunStandalone(state, 1, std::move(payload));
@@ -35,13 +31,21 @@ void PgConnection::RunStandalone(benchmark::State& state,
 void PgConnection::RunStandalone(benchmark::State& state,
                                  std::size_t thread_count,
                                  std::function<void()> payload) {
+  RunStandalone(state, thread_count,
+                {ConnectionSettings::kCachePreparedStatements},
+                std::move(payload));
+}
+
+void PgConnection::RunStandalone(benchmark::State& state,
+                                 std::size_t thread_count,
+                                 ConnectionSettings settings,
+                                 std::function<void()> payload) {
   engine::RunStandalone(thread_count, [&] {
     auto dsn = GetDsnFromEnv();
     if (!dsn.empty()) {
       conn_ = detail::Connection::Connect(
           dsn, nullptr, engine::current_task::GetTaskProcessor(), kConnectionId,
-          {ConnectionSettings::kCachePreparedStatements},
-          DefaultCommandControls(kBenchCmdCtl, {}, {}), {}, {});
+          settings, DefaultCommandControls(kBenchCmdCtl, {}, {}), {}, {});
     }
 
     if (!IsConnectionValid()) {
@@ -4,6 +4,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/options.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +17,10 @@ inline constexpr uint32_t kConnectionId = 0;
 inline constexpr CommandControl kBenchCmdCtl{std::chrono::milliseconds{100},
                                              std::chrono::milliseconds{50}};
 
+/// Returns the DSN of the first host from the kPostgresDsn environment
+/// variable, empty if it is not set
+Dsn GetDsnFromEnv();
+
 class PgConnection : public benchmark::Fixture {
  protected:
   bool IsConnectionValid() const;
@@ -29,6 +34,10 @@ class PgConnection : public benchmark::Fixture {
   void RunStandalone(benchmark::State& state, std::size_t thread_count,
                      std::function<void()> payload);
 
+  void RunStandalone(benchmark::State& state, std::size_t thread_count,
+                     ConnectionSettings settings,
+                     std::function<void()> payload);
+
  private:
   std::unique_ptr<detail::Connection> conn_;
 };
@@ -4,6 +4,7 @@
 /// @brief A bunch of interface classes
 
 #include <string>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/utils/flags.hpp>
@@ -134,6 +135,31 @@ class IReliableChannelInterface {
                                const std::string& message,
                                engine::Deadline deadline) = 0;
 
+  /// @brief Publish a batch of messages to an exchange and
+  /// await confirmation of all of them from the broker
+  ///
+  /// The messages are written to the socket in a few big bursts and their
+  /// confirmations are awaited all at once, which is much faster than
+  /// publishing the messages one by one.
+  /// If any of the messages is not confirmed an exception is thrown,
+  /// some of the messages might be delivered in that case.
+  ///
+  /// @param exchange the exchange to publish to
+  /// @param routing_key the routing key
+  /// @param messages the messages to send
+  /// @param deadline execution deadline
+  virtual void PublishReliableBatch(const Exchange& exchange,
+                                    const std::string& routing_key,
+                                    const std::vector<std::string>& messages,
+                                    MessageType type,
+                                    engine::Deadline deadline) = 0;
+
+  /// @brief overload of PublishReliableBatch
+  virtual void PublishReliableBatch(const Exchange& exchange,
+                                    const std::string& routing_key,
+                                    const std::vector<std::string>& messages,
+                                    engine::Deadline deadline) = 0;
+
  protected:
   ~IReliableChannelInterface();
 };
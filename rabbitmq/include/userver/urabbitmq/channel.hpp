@@ -74,6 +74,20 @@ class ReliableChannel final : IReliableChannelInterface {
                     deadline);
   }
 
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type,
+                            engine::Deadline deadline) override;
+
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            engine::Deadline deadline) override {
+    PublishReliableBatch(exchange, routing_key, messages,
+                         MessageType::kTransient, deadline);
+  }
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
@@ -98,6 +98,20 @@ class Client : public std::enable_shared_from_this<Client>,
                     deadline);
   }
 
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type,
+                            engine::Deadline deadline) override;
+
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            engine::Deadline deadline) override {
+    PublishReliableBatch(exchange, routing_key, messages,
+                         MessageType::kTransient, deadline);
+  }
+
   /// @brief Get a reliable publisher interface for the broker
   /// (publisher-confirms)
   ///
@@ -57,6 +57,14 @@ struct PoolSettings final {
   /// (tcp error/protocol error/write timeout) leads to a errors burst:
   /// all outstanding request will fails at once
   size_t max_in_flight_requests = 5;
+
+  /// How many publishers may use a connection at once.
+  /// The operations of a connection are sent one by one, but the publishers
+  /// don't wait for each other's responses, so this allows to serve more
+  /// publishers with fewer connections.
+  /// Note: the publishers sharing a connection share its
+  /// max_in_flight_requests limit as well as its errors
+  size_t channels_per_connection = 1;
 };
 
 class TestsHelper;
@@ -4,6 +4,8 @@
 /// @brief Base class for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/utils/periodic_task.hpp>
 
@@ -68,7 +70,17 @@ class ConsumerBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  virtual void Process(std::string message);
+
+  /// @brief Override this method in derived class instead of `Process` to
+  /// handle the messages in batches of up to
+  /// ConsumerSettings::max_batch_size messages.
+  ///
+  /// If this method returns successfully all the messages would be acked,
+  /// if it throws all of them would be requeued.
+  ///
+  /// The default implementation calls `Process` for each of the messages.
+  virtual void ProcessBatch(std::vector<std::string> messages);
 
  private:
   std::shared_ptr<Client> client_;
@@ -4,6 +4,8 @@
 /// @brief Base component for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/components/loggable_component_base.hpp>
 
@@ -38,6 +40,8 @@ namespace urabbitmq {
 /// rabbit_name      | Name of the RabbitMQ component to use for consumption
 /// queue            | Name of the queue to consume from
 /// prefetch_count   | prefetch_count for the consumer, limits the amount of in-flight messages
+/// max_batch_size   | max number of messages passed to a single `ProcessBatch` call, 1 by default
+/// max_batch_delay  | max time to wait for a batch to fill up, 10ms by default
 ///
 // clang-format on
 class ConsumerComponentBase : public components::LoggableComponentBase {
@@ -64,7 +68,16 @@ class ConsumerComponentBase : public components::LoggableComponentBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  virtual void Process(std::string message);
+
+  /// @brief Override this method in derived class instead of `Process` to
+  /// handle the messages in batches of up to `max_batch_size` messages.
+  ///
+  /// If this method returns successfully all the messages would be acked,
+  /// if it throws all of them would be requeued.
+  ///
+  /// The default implementation calls `Process` for each of the messages.
+  virtual void ProcessBatch(std::vector<std::string> messages);
 
  private:
   // This is actually just a subclass of `ConsumerBase`
@@ -3,6 +3,7 @@
 /// @file userver/urabbitmq/consumer_settings.hpp
 /// @brief Consumer settings.
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/urabbitmq/typedefs.hpp>
@@ -24,6 +25,14 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Max number of messages passed to a single `ProcessBatch` call.
+  /// Should not exceed `prefetch_count`, otherwise the batches are always
+  /// sent out by `max_batch_delay`
+  std::uint16_t max_batch_size{1};
+
+  /// Max time to wait for a batch to fill up
+  std::chrono::milliseconds max_batch_delay{10};
 };
 
 }  // namespace urabbitmq
@@ -0,0 +1,213 @@
+#include "utils_rmqtest.hpp"
+
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+
+#include <urabbitmq/connection.hpp>
+#include <urabbitmq/connection_pool.hpp>
+#include <urabbitmq/connection_ptr.hpp>
+#include <urabbitmq/statistics/connection_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kSmallTimeout{100};
+
+clients::dns::Resolver CreateResolver() {
+  return clients::dns::Resolver{engine::current_task::GetTaskProcessor(), {}};
+}
+
+class PoolWrapper final {
+ public:
+  PoolWrapper(size_t min_pool_size, size_t max_pool_size,
+              size_t channels_per_connection)
+      : resolver_{CreateResolver()} {
+    urabbitmq::EndpointInfo endpoint{};
+    endpoint.port = GetRabbitMqPort();
+
+    urabbitmq::PoolSettings pool_settings{};
+    pool_settings.min_pool_size = min_pool_size;
+    pool_settings.max_pool_size = max_pool_size;
+    pool_settings.channels_per_connection = channels_per_connection;
+
+    pool_ = urabbitmq::ConnectionPool::Create(
+        resolver_, endpoint, {}, pool_settings,
+        /*use_secure_connection=*/false, stats_);
+  }
+
+  urabbitmq::ConnectionPool* operator->() const { return pool_.get(); }
+
+  urabbitmq::statistics::ConnectionStatistics::Frozen GetStatistics() const {
+    return stats_.Get();
+  }
+
+ private:
+  clients::dns::Resolver resolver_;
+  urabbitmq::statistics::ConnectionStatistics stats_;
+  std::shared_ptr<urabbitmq::ConnectionPool> pool_;
+};
+
+engine::Deadline GetDeadline() {
+  return engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+}
+
+urabbitmq::impl::AmqpConnectionHandler& GetHandler(
+    const urabbitmq::ConnectionPtr& connection) {
+  return urabbitmq::TestsHelper::GetHandler(*connection.operator->());
+}
+
+}  // namespace
+
+UTEST(ConnectionPool, SharesConnections) {
+  PoolWrapper pool{1, 2, 3};
+
+  std::vector<urabbitmq::ConnectionPtr> holders;
+  std::unordered_set<urabbitmq::Connection*> connections;
+  for (size_t i = 0; i < 6; ++i) {
+    holders.push_back(pool->Acquire(GetDeadline()));
+    connections.insert(holders.back().operator->());
+  }
+
+  EXPECT_EQ(connections.size(), 2);
+  EXPECT_EQ(pool.GetStatistics().connections_created, 2);
+}
+
+UTEST_MT(ConnectionPool, ConcurrentAcquireRespectsMaxPoolSize, 4) {
+  constexpr size_t kMaxPoolSize = 2;
+  constexpr size_t kChannelsPerConnection = 2;
+  PoolWrapper pool{1, kMaxPoolSize, kChannelsPerConnection};
+
+  concurrent::Variable<std::unordered_set<urabbitmq::Connection*>> connections;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (size_t i = 0; i < 16; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (size_t j = 0; j < 10; ++j) {
+        auto connection = pool->Acquire(GetDeadline());
+        connections.Lock()->insert(connection.operator->());
+        engine::Yield();
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(connections.Lock()->size(), kMaxPoolSize);
+  EXPECT_EQ(pool.GetStatistics().connections_created, kMaxPoolSize);
+}
+
+UTEST(ConnectionPool, WaitsForReleasedSlot) {
+  PoolWrapper pool{1, 1, 2};
+
+  std::optional<urabbitmq::ConnectionPtr> first{pool->Acquire(GetDeadline())};
+  const auto second = pool->Acquire(GetDeadline());
+  auto* const connection = second.operator->();
+  EXPECT_EQ(first.value().operator->(), connection);
+
+  UEXPECT_THROW(
+      pool->Acquire(engine::Deadline::FromDuration(kSmallTimeout)),
+      std::runtime_error);
+
+  auto waiter = engine::AsyncNoSpan([&] {
+    const auto third = pool->Acquire(GetDeadline());
+    EXPECT_EQ(third.operator->(), connection);
+  });
+  waiter.WaitFor(kSmallTimeout);
+  EXPECT_FALSE(waiter.IsFinished());
+
+  first.reset();
+  UEXPECT_NO_THROW(waiter.Get());
+  EXPECT_EQ(pool.GetStatistics().connections_created, 1);
+}
+
+UTEST(ConnectionPool, ExclusiveConnectionIsAdopted) {
+  PoolWrapper pool{1, 2, 2};
+
+  auto exclusive = pool->AcquireExclusive(GetDeadline());
+  const auto shared = pool->Acquire(GetDeadline());
+  EXPECT_NE(exclusive.operator->(), shared.operator->());
+  EXPECT_EQ(pool.GetStatistics().connections_created, 2);
+
+  // the adopted connection leaves a place for a new pooled one
+  exclusive.Adopt();
+  const auto second_shared = pool->Acquire(GetDeadline());
+  EXPECT_EQ(second_shared.operator->(), shared.operator->());
+  const auto third_shared = pool->Acquire(GetDeadline());
+  EXPECT_NE(third_shared.operator->(), shared.operator->());
+  EXPECT_NE(third_shared.operator->(), exclusive.operator->());
+  EXPECT_EQ(pool.GetStatistics().connections_created, 3);
+}
+
+UTEST(ConnectionPool, BlockedConnectionPausesPublishing) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  PoolWrapper pool{1, 1, 2};
+
+  const auto first = pool->Acquire(GetDeadline());
+  const auto second = pool->Acquire(GetDeadline());
+  ASSERT_EQ(first.operator->(), second.operator->());
+
+  auto& handler = GetHandler(first);
+  handler.onBlocked(nullptr, "test");
+  EXPECT_EQ(pool.GetStatistics().connections_blocked, 1);
+
+  const auto publish = [&client](const urabbitmq::ConnectionPtr& connection,
+                                 engine::Deadline deadline) {
+    connection->GetChannel().Publish(
+        client.GetExchange(), client.GetRoutingKey(), "blocked",
+        urabbitmq::MessageType::kTransient, deadline);
+  };
+  UEXPECT_THROW(
+      publish(first, engine::Deadline::FromDuration(kSmallTimeout)),
+      std::runtime_error);
+
+  // both holders of the connection wait
+  auto first_publisher =
+      engine::AsyncNoSpan([&] { publish(first, GetDeadline()); });
+  auto second_publisher =
+      engine::AsyncNoSpan([&] { publish(second, GetDeadline()); });
+  first_publisher.WaitFor(kSmallTimeout);
+  second_publisher.WaitFor(kSmallTimeout);
+  EXPECT_FALSE(first_publisher.IsFinished());
+  EXPECT_FALSE(second_publisher.IsFinished());
+
+  handler.onUnblocked(nullptr);
+  UEXPECT_NO_THROW(first_publisher.Get());
+  UEXPECT_NO_THROW(second_publisher.Get());
+}
+
+UTEST(ConnectionPool, BrokenConnectionReleasesSlots) {
+  PoolWrapper pool{1, 1, 2};
+
+  std::optional<urabbitmq::ConnectionPtr> first{pool->Acquire(GetDeadline())};
+  std::optional<urabbitmq::ConnectionPtr> second{pool->Acquire(GetDeadline())};
+  auto* const broken = first.value().operator->();
+
+  auto waiter = engine::AsyncNoSpan([&] {
+    const auto third = pool->Acquire(GetDeadline());
+    EXPECT_TRUE(third.IsUsable());
+  });
+  waiter.WaitFor(kSmallTimeout);
+  EXPECT_FALSE(waiter.IsFinished());
+
+  GetHandler(first.value()).Invalidate();
+  EXPECT_TRUE(broken->IsBroken());
+
+  // the broken connection is destroyed with the last of its slots
+  first.reset();
+  waiter.WaitFor(kSmallTimeout);
+  EXPECT_FALSE(waiter.IsFinished());
+  EXPECT_EQ(pool.GetStatistics().connections_closed, 0);
+
+  second.reset();
+  UEXPECT_NO_THROW(waiter.Get());
+  EXPECT_EQ(pool.GetStatistics().connections_closed, 1);
+  EXPECT_EQ(pool.GetStatistics().connections_created, 2);
+}
+
+USERVER_NAMESPACE_END
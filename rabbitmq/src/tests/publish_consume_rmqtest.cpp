@@ -1,7 +1,10 @@
 #include "utils_rmqtest.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <vector>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/uuid4.hpp>
 
@@ -49,6 +52,39 @@ class Consumer final : public urabbitmq::ConsumerBase {
   engine::SingleConsumerEvent event_;
 };
 
+class BatchConsumer final : public urabbitmq::ConsumerBase {
+ public:
+  using urabbitmq::ConsumerBase::ConsumerBase;
+  ~BatchConsumer() override { Stop(); }
+
+  void ProcessBatch(std::vector<std::string> messages) override {
+    {
+      auto locked = batch_sizes_.Lock();
+      locked->push_back(messages.size());
+    }
+
+    consumed_ += messages.size();
+    if (consumed_ >= expected_consumed_) {
+      event_.Send();
+    }
+  }
+
+  void ExpectConsume(size_t count) { expected_consumed_ = count; }
+
+  std::vector<size_t> Wait() {
+    [[maybe_unused]] auto res = event_.WaitForEventFor(utest::kMaxTestWaitTime);
+
+    auto locked = batch_sizes_.Lock();
+    return *locked;
+  }
+
+ private:
+  concurrent::Variable<std::vector<size_t>> batch_sizes_;
+  std::atomic<size_t> expected_consumed_{0};
+  std::atomic<size_t> consumed_{0};
+  engine::SingleConsumerEvent event_;
+};
+
 class ThrowingConsumer final : public urabbitmq::ConsumerBase {
  public:
   using urabbitmq::ConsumerBase::ConsumerBase;
@@ -133,6 +169,72 @@ UTEST(Consumer, ExhaustesQueue) {
   consumer.Wait();
 }
 
+UTEST(Consumer, ConsumesReliableBatch) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 100};
+
+  // more than fits into a single write burst
+  const size_t messages_count = 2500;
+  std::vector<std::string> messages;
+  messages.reserve(messages_count);
+  for (size_t i = 0; i < messages_count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  client->PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                               messages, urabbitmq::MessageType::kTransient,
+                               client.GetDeadline());
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+  auto consumed = consumer.Wait();
+
+  ASSERT_EQ(consumed.size(), messages_count);
+  std::sort(consumed.begin(), consumed.end());
+  std::sort(messages.begin(), messages.end());
+  EXPECT_EQ(consumed, messages);
+}
+
+UTEST(Consumer, ReliableEmptyBatch) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  auto channel = client->GetReliableChannel(client.GetDeadline());
+  channel.PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(), {},
+                               client.GetDeadline());
+}
+
+UTEST(Consumer, ConsumesInBatches) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  urabbitmq::ConsumerSettings settings{client.GetQueue(), 100};
+  settings.max_batch_size = 10;
+
+  const size_t messages_count = 1005;
+  std::vector<std::string> messages;
+  messages.reserve(messages_count);
+  for (size_t i = 0; i < messages_count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  client->PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                               messages, client.GetDeadline());
+
+  BatchConsumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+  const auto batch_sizes = consumer.Wait();
+
+  size_t total = 0;
+  for (const auto size : batch_sizes) {
+    EXPECT_LE(size, settings.max_batch_size);
+    total += size;
+  }
+  EXPECT_EQ(total, messages_count);
+  // the last incomplete batch is sent out by the timer
+  EXPECT_LT(batch_sizes.size(), messages_count);
+}
+
 UTEST(Consumer, ThrowsReturnsToQueue) {
   ClientWrapper client{};
   client.SetupRmqEntities();
@@ -217,4 +319,39 @@ UTEST(Consumer, ForDifferentQueuesWork) {
       .RemoveQueue(second_queue, client.GetDeadline());
 }
 
+UTEST_MT(Consumer, ConsumesFromSharedConnections, 4) {
+  auto settings = urabbitmq::TestsHelper::CreateSettings();
+  settings.pool_settings.min_pool_size = 1;
+  settings.pool_settings.max_pool_size = 2;
+  settings.pool_settings.channels_per_connection = 4;
+  ClientWrapper client{settings};
+  client.SetupRmqEntities();
+
+  // the publishers share the connections and the consumer adopts its own one
+  Consumer consumer{client.Get(), {client.GetQueue(), 10}};
+  const size_t publishers_count = 8;
+  const size_t messages_per_publisher = 100;
+  consumer.ExpectConsume(publishers_count * messages_per_publisher);
+  consumer.Start();
+
+  std::vector<engine::TaskWithResult<void>> publishers;
+  publishers.reserve(publishers_count);
+  for (size_t i = 0; i < publishers_count; ++i) {
+    publishers.push_back(engine::AsyncNoSpan([&client, i] {
+      for (size_t j = 0; j < messages_per_publisher; ++j) {
+        client->PublishReliable(
+            client.GetExchange(), client.GetRoutingKey(),
+            std::to_string(i * messages_per_publisher + j),
+            urabbitmq::MessageType::kTransient, client.GetDeadline());
+      }
+    }));
+  }
+  for (auto& publisher : publishers) publisher.Get();
+
+  auto consumed = consumer.Wait();
+  ASSERT_EQ(consumed.size(), publishers_count * messages_per_publisher);
+  std::sort(consumed.begin(), consumed.end());
+  EXPECT_EQ(std::unique(consumed.begin(), consumed.end()), consumed.end());
+}
+
 USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include <urabbitmq/connection.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -16,9 +18,9 @@ clients::dns::Resolver CreateResolver() {
 }
 
 std::shared_ptr<urabbitmq::Client> CreateClient(
-    userver::clients::dns::Resolver& resolver) {
-  return urabbitmq::Client::Create(resolver,
-                                   urabbitmq::TestsHelper::CreateSettings());
+    userver::clients::dns::Resolver& resolver,
+    const urabbitmq::ClientSettings& settings) {
+  return urabbitmq::Client::Create(resolver, settings);
 }
 
 }  // namespace
@@ -31,8 +33,11 @@ uint16_t GetRabbitMqPort() {
 }
 
 ClientWrapper::ClientWrapper()
+    : ClientWrapper{urabbitmq::TestsHelper::CreateSettings()} {}
+
+ClientWrapper::ClientWrapper(const urabbitmq::ClientSettings& settings)
     : resolver_{CreateResolver()},
-      client_{CreateClient(resolver_)},
+      client_{CreateClient(resolver_, settings)},
       exchange_{utils::generators::GenerateUuid()},
       queue_{utils::generators::GenerateUuid()},
       routing_key_{utils::generators::GenerateUuid()},
@@ -101,6 +106,10 @@ ClientSettings TestsHelper::CreateSettings() {
   return settings;
 }
 
+impl::AmqpConnectionHandler& TestsHelper::GetHandler(Connection& connection) {
+  return connection.handler_;
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
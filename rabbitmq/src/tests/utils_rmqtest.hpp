@@ -12,6 +12,7 @@ uint16_t GetRabbitMqPort();
 class ClientWrapper final {
  public:
   ClientWrapper();
+  explicit ClientWrapper(const urabbitmq::ClientSettings& settings);
   ~ClientWrapper();
 
   urabbitmq::Client& operator*() const;
@@ -44,9 +45,17 @@ class ClientWrapper final {
 
 namespace urabbitmq {
 
+class Connection;
+
+namespace impl {
+class AmqpConnectionHandler;
+}
+
 class TestsHelper final {
  public:
   static ClientSettings CreateSettings();
+
+  static impl::AmqpConnectionHandler& GetHandler(Connection& connection);
 };
 
 }  // namespace urabbitmq
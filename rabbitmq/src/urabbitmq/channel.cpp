@@ -37,6 +37,15 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+void ReliableChannel::PublishReliableBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  ConnectionHelper::PublishReliableBatch(*impl_, exchange, routing_key,
+                                         messages, type, deadline)
+      .Wait(deadline);
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
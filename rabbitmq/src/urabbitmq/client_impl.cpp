@@ -43,11 +43,22 @@ formats::json::Value ClientImpl::GetStatistics() const {
 }
 
 ConnectionPtr ClientImpl::GetConnection(engine::Deadline deadline) {
+  return DoGetConnection(deadline, false);
+}
+
+ConnectionPtr ClientImpl::GetExclusiveConnection(engine::Deadline deadline) {
+  return DoGetConnection(deadline, true);
+}
+
+ConnectionPtr ClientImpl::DoGetConnection(engine::Deadline deadline,
+                                          bool exclusive) {
   const auto start_idx = pool_idx_.load(std::memory_order_relaxed);
   for (size_t i = 0; i < pools_.size(); ++i) {
     const auto idx = (start_idx + i) % pools_.size();
     try {
-      auto conn_ptr = pools_[idx].pool->Acquire(deadline);
+      auto& pool = *pools_[idx].pool;
+      auto conn_ptr = exclusive ? pool.AcquireExclusive(deadline)
+                                : pool.Acquire(deadline);
       pool_idx_.fetch_add(i + 1, std::memory_order_relaxed);
       return conn_ptr;
     } catch (const std::exception&) {
@@ -24,10 +24,14 @@ class ClientImpl final {
   ClientImpl(clients::dns::Resolver& resolver, const ClientSettings& settings);
 
   ConnectionPtr GetConnection(engine::Deadline deadline);
+  // The connection is not shared with the publishers, for the consumers
+  ConnectionPtr GetExclusiveConnection(engine::Deadline deadline);
 
   formats::json::Value GetStatistics() const;
 
  private:
+  ConnectionPtr DoGetConnection(engine::Deadline deadline, bool exclusive);
+
   const ClientSettings settings_;
 
   struct PoolHolder final {
@@ -63,10 +63,14 @@ PoolSettings Parse(const yaml_config::YamlConfig& config,
       config["max_pool_size"].As<size_t>(result.max_pool_size);
   result.max_in_flight_requests = config["max_in_flight_requests"].As<size_t>(
       result.max_in_flight_requests);
+  result.channels_per_connection = config["channels_per_connection"].As<size_t>(
+      result.channels_per_connection);
 
   UINVARIANT(result.min_pool_size <= result.max_pool_size,
              "max_pool_size is less than min_pool_size");
   UINVARIANT(result.max_pool_size > 0, "max_pool_size is set to zero");
+  UINVARIANT(result.channels_per_connection > 0,
+             "channels_per_connection is set to zero");
 
   return result;
 }
@@ -71,6 +71,10 @@ properties:
         description: |
           per-connection limit for requests awaiting response from the broker
         defaultDescription: 5
+    channels_per_connection:
+        type: integer
+        description: how many publishers may use a connection at once
+        defaultDescription: 1
     use_secure_connection:
         type: boolean
         description: whether to use TLS for connections
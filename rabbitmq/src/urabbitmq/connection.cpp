@@ -31,6 +31,10 @@ void Connection::EnsureUsable() const {
   }
 }
 
+void Connection::SetPoolSlots(size_t slots) { pool_slots_ = slots; }
+
+bool Connection::DropPoolSlot() { return --pool_slots_ == 0; }
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
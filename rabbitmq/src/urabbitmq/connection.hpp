@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <boost/lockfree/queue.hpp>
@@ -22,6 +23,8 @@ namespace statistics {
 class ConnectionStatistics;
 }
 
+class TestsHelper;
+
 class Connection final {
  public:
   Connection(clients::dns::Resolver& resolver, const EndpointInfo& endpoint,
@@ -37,12 +40,21 @@ class Connection final {
 
   void EnsureUsable() const;
 
+  // A pooled connection is shared by the holders of its slots and has to be
+  // destroyed once all of them are dropped
+  void SetPoolSlots(size_t slots);
+  [[nodiscard]] bool DropPoolSlot();
+
  private:
+  friend class TestsHelper;
+
   impl::AmqpConnectionHandler handler_;
   impl::AmqpConnection connection_;
 
   impl::AmqpChannel channel_;
   impl::AmqpReliableChannel reliable_channel_;
+
+  std::atomic<size_t> pool_slots_{1};
 };
 
 }  // namespace urabbitmq
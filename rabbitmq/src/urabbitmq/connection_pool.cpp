@@ -1,5 +1,7 @@
 #include "connection_pool.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include <userver/engine/async.hpp>
@@ -21,6 +23,21 @@ constexpr std::chrono::milliseconds kPoolMonitorInterval{1000};
 
 constexpr size_t kMaxSimultaneouslyConnectingClients{5};
 
+template <typename Func>
+Connection* AccountAcquire(statistics::ConnectionStatistics& stats,
+                           Func&& pop) {
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    auto* connection = pop();
+    stats.AccountAcquire(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start));
+    return connection;
+  } catch (const std::exception&) {
+    stats.AccountAcquireFailed();
+    throw;
+  }
+}
+
 }  // namespace
 
 std::shared_ptr<ConnectionPool> ConnectionPool::Create(
@@ -46,18 +63,26 @@ ConnectionPool::ConnectionPool(clients::dns::Resolver& resolver,
       pool_settings_{pool_settings},
       use_secure_connection_{use_secure_connection},
       stats_{stats},
-      given_away_semaphore_{pool_settings_.max_pool_size},
+      given_away_semaphore_{pool_settings_.max_pool_size *
+                            pool_settings_.channels_per_connection},
       connecting_semaphore_{kMaxSimultaneouslyConnectingClients},
       // FP?: pointer magic in boost.lockfree
       // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-      queue_{pool_settings_.max_pool_size} {
+      queue_{pool_settings_.max_pool_size *
+             pool_settings_.channels_per_connection} {
+  std::vector<Connection*> connections(pool_settings_.min_pool_size, nullptr);
   try {
     std::vector<engine::TaskWithResult<void>> init_tasks;
     init_tasks.reserve(pool_settings_.min_pool_size);
 
     for (size_t i = 0; i < pool_settings_.min_pool_size; ++i) {
-      init_tasks.emplace_back(engine::AsyncNoSpan([this] {
-        PushConnection(engine::Deadline::FromDuration(kConnectionSetupTimeout));
+      if (!TryReserveConnection(/*exclusive=*/false)) break;
+      init_tasks.emplace_back(engine::AsyncNoSpan([this, &connections, i] {
+        connections[i] =
+            CreateConnection(
+                engine::Deadline::FromDuration(kConnectionSetupTimeout),
+                pool_settings_.channels_per_connection)
+                .release();
       }));
     }
 
@@ -70,12 +95,19 @@ ConnectionPool::ConnectionPool(clients::dns::Resolver& resolver,
 
     LOG_ERROR() << "Critical failure encountered in connection pool setup: "
                 << ex.what();
-    CleanupQueue();
+    for (auto* connection : connections) {
+      if (connection) Drop(connection);
+    }
     throw;
   } catch (const std::exception& ex) {
     LOG_WARNING() << "Failed to properly setup connection pool: " << ex.what();
   }
 
+  connections.erase(
+      std::remove(connections.begin(), connections.end(), nullptr),
+      connections.end());
+  PushSlots(connections, pool_settings_.channels_per_connection);
+
   monitor_.Start("connection_pool_monitor", {{kPoolMonitorInterval}},
                  [this] { RunMonitor(); });
 }
@@ -87,15 +119,25 @@ ConnectionPool::~ConnectionPool() {
 }
 
 ConnectionPtr ConnectionPool::Acquire(engine::Deadline deadline) {
-  return {shared_from_this(), Pop(deadline)};
+  return {shared_from_this(),
+          AccountAcquire(stats_, [this, deadline] { return Pop(deadline); })};
 }
 
-void ConnectionPool::Release(std::unique_ptr<Connection> connection) {
+ConnectionPtr ConnectionPool::AcquireExclusive(engine::Deadline deadline) {
+  return {shared_from_this(), AccountAcquire(stats_, [this, deadline] {
+            return pool_settings_.channels_per_connection == 1
+                       ? Pop(deadline)
+                       : PopExclusive(deadline);
+          })};
+}
+
+void ConnectionPool::Release(Connection* connection) {
   UASSERT(connection);
 
-  auto* ptr = connection.release();
-  if (ptr->IsBroken() || !queue_.bounded_push(ptr)) {
-    Drop(ptr);
+  if (connection->IsBroken() || !queue_.bounded_push(connection)) {
+    DropSlot(connection);
+  } else {
+    NotifyPoolChanged();
   }
 
   given_away_semaphore_.unlock_shared();
@@ -103,27 +145,44 @@ void ConnectionPool::Release(std::unique_ptr<Connection> connection) {
 
 void ConnectionPool::NotifyConnectionAdopted() {
   given_away_semaphore_.unlock_shared();
-  size_.fetch_sub(1);
+  UnreserveConnection();
 }
 
-std::unique_ptr<Connection> ConnectionPool::Pop(engine::Deadline deadline) {
+Connection* ConnectionPool::Pop(engine::Deadline deadline) {
   engine::SemaphoreLock given_away_lock{given_away_semaphore_, deadline};
   if (!given_away_lock.OwnsLock()) {
     throw std::runtime_error{"Connection pool acquisition wait limit exceeded"};
   }
 
-  auto connection_ptr = TryPop();
-  if (!connection_ptr) {
-    engine::SemaphoreLock connecting_lock{connecting_semaphore_, deadline};
+  auto* connection_ptr = TryPop();
+  while (!connection_ptr) {
+    {
+      engine::SemaphoreLock connecting_lock{connecting_semaphore_, deadline};
 
-    connection_ptr = TryPop();
-    if (!connection_ptr) {
+      connection_ptr = TryPop();
+      if (connection_ptr) break;
       if (!connecting_lock.OwnsLock()) {
         throw std::runtime_error{
             "Connection pool acquisition wait limit exceeded"};
       }
-      connection_ptr = CreateConnection(deadline);
+      if (TryReserveConnection(/*exclusive=*/false)) {
+        connection_ptr = CreateConnection(
+                             deadline, pool_settings_.channels_per_connection)
+                             .release();
+        // the other slots of the new connection are available to others
+        PushSlots({connection_ptr},
+                  pool_settings_.channels_per_connection - 1);
+        if (pool_settings_.channels_per_connection > 1) NotifyPoolChanged();
+        break;
+      }
     }
+
+    // the pool is full, wait for a slot to be returned or a connection to go
+    if (!WaitForPoolChange(deadline)) {
+      throw std::runtime_error{
+          "Connection pool acquisition wait limit exceeded"};
+    }
+    connection_ptr = TryPop();
   }
 
   UASSERT(connection_ptr);
@@ -136,39 +195,117 @@ std::unique_ptr<Connection> ConnectionPool::Pop(engine::Deadline deadline) {
   return connection_ptr;
 }
 
-std::unique_ptr<Connection> ConnectionPool::TryPop() {
+Connection* ConnectionPool::PopExclusive(engine::Deadline deadline) {
+  // The slots of the pooled connections may be held by the publishers,
+  // so a dedicated connection is created instead
+  engine::SemaphoreLock given_away_lock{given_away_semaphore_, deadline};
+  if (!given_away_lock.OwnsLock()) {
+    throw std::runtime_error{"Connection pool acquisition wait limit exceeded"};
+  }
+
+  engine::SemaphoreLock connecting_lock{connecting_semaphore_, deadline};
+  if (!connecting_lock.OwnsLock()) {
+    throw std::runtime_error{"Connection pool acquisition wait limit exceeded"};
+  }
+  // The connection is adopted right away and leaves the pool, so it doesn't
+  // wait for a place there. Otherwise the consumers would wait forever for
+  // the idle pooled connections to go.
+  [[maybe_unused]] const auto reserved =
+      TryReserveConnection(/*exclusive=*/true);
+  UASSERT(reserved);
+  auto* connection_ptr = CreateConnection(deadline, 1).release();
+
+  given_away_lock.Release();
+  return connection_ptr;
+}
+
+Connection* ConnectionPool::TryPop() {
   Connection* conn{nullptr};
-  if (!queue_.pop(conn)) {
-    return nullptr;
+  while (queue_.pop(conn)) {
+    // the remaining slots of a broken connection are dropped as they come up
+    if (!conn->IsBroken()) return conn;
+    DropSlot(conn);
   }
 
-  return std::unique_ptr<Connection>(conn);
+  return nullptr;
 }
 
 void ConnectionPool::PushConnection(engine::Deadline deadline) {
-  auto* ptr = CreateConnection(deadline).release();
-  if (!queue_.bounded_push(ptr)) {
-    Drop(ptr);
+  if (!TryReserveConnection(/*exclusive=*/false)) return;
+  const auto slots = pool_settings_.channels_per_connection;
+  PushSlots({CreateConnection(deadline, slots).release()}, slots);
+  NotifyPoolChanged();
+}
+
+void ConnectionPool::PushSlots(const std::vector<Connection*>& connections,
+                               size_t slots) {
+  // Slot by slot rather than connection by connection, so that the holders
+  // get spread across the connections
+  for (size_t slot = 0; slot < slots; ++slot) {
+    for (auto* connection : connections) {
+      if (!queue_.bounded_push(connection)) {
+        DropSlot(connection);
+      }
+    }
   }
 }
 
 std::unique_ptr<Connection> ConnectionPool::CreateConnection(
-    engine::Deadline deadline) {
-  auto conn =
-      std::make_unique<Connection>(resolver_, endpoint_info_, auth_settings_,
-                                   pool_settings_.max_in_flight_requests,
-                                   use_secure_connection_, stats_, deadline);
+    engine::Deadline deadline, size_t slots) {
+  std::unique_ptr<Connection> conn;
+  try {
+    conn = std::make_unique<Connection>(
+        resolver_, endpoint_info_, auth_settings_,
+        pool_settings_.max_in_flight_requests, use_secure_connection_, stats_,
+        deadline);
+  } catch (const std::exception&) {
+    UnreserveConnection();
+    throw;
+  }
+  conn->SetPoolSlots(slots);
 
   stats_.AccountConnectionCreated();
-  size_.fetch_add(1);
   return conn;
 }
 
+bool ConnectionPool::TryReserveConnection(bool exclusive) {
+  const std::lock_guard lock{size_mutex_};
+  if (!exclusive && size_ >= pool_settings_.max_pool_size) return false;
+  size_.fetch_add(1);
+  return true;
+}
+
+void ConnectionPool::UnreserveConnection() noexcept {
+  const std::lock_guard lock{size_mutex_};
+  size_.fetch_sub(1);
+  pool_changed_cv_.NotifyAll();
+}
+
+bool ConnectionPool::WaitForPoolChange(engine::Deadline deadline) {
+  std::unique_lock lock{size_mutex_};
+  return pool_changed_cv_.WaitUntil(lock, deadline, [this] {
+    return size_ < pool_settings_.max_pool_size || !queue_.empty();
+  });
+}
+
+void ConnectionPool::NotifyPoolChanged() noexcept {
+  // under the lock, so that the notification is not lost by a waiter that
+  // has just checked the queue
+  const std::lock_guard lock{size_mutex_};
+  pool_changed_cv_.NotifyAll();
+}
+
+void ConnectionPool::DropSlot(Connection* connection) noexcept {
+  if (connection->DropPoolSlot()) {
+    Drop(connection);
+  }
+}
+
 void ConnectionPool::Drop(Connection* connection) noexcept {
   std::default_delete<Connection>{}(connection);
 
   stats_.AccountConnectionClosed();
-  size_.fetch_sub(1);
+  UnreserveConnection();
 }
 
 void ConnectionPool::RunMonitor() {
@@ -188,7 +325,7 @@ void ConnectionPool::CleanupQueue() {
       break;
     }
 
-    Drop(conn);
+    DropSlot(conn);
   }
 }
 
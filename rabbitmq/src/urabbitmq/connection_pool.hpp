@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <boost/lockfree/queue.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/utils/periodic_task.hpp>
 
@@ -21,6 +24,8 @@ namespace statistics {
 class ConnectionStatistics;
 }
 
+// Every pooled connection has PoolSettings::channels_per_connection slots in
+// the queue, each of them is handed out to a single holder.
 class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
  public:
   static std::shared_ptr<ConnectionPool> Create(
@@ -30,7 +35,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   ~ConnectionPool();
 
   ConnectionPtr Acquire(engine::Deadline deadline);
-  void Release(std::unique_ptr<Connection> connection);
+  // The connection is not shared with other holders, so it may be adopted
+  ConnectionPtr AcquireExclusive(engine::Deadline deadline);
+  void Release(Connection* connection);
 
   void NotifyConnectionAdopted();
 
@@ -42,11 +49,21 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
                  statistics::ConnectionStatistics& stats);
 
  private:
-  std::unique_ptr<Connection> Pop(engine::Deadline deadline);
-  std::unique_ptr<Connection> TryPop();
+  Connection* Pop(engine::Deadline deadline);
+  Connection* PopExclusive(engine::Deadline deadline);
+  Connection* TryPop();
 
   void PushConnection(engine::Deadline deadline);
-  std::unique_ptr<Connection> CreateConnection(engine::Deadline deadline);
+  void PushSlots(const std::vector<Connection*>& connections, size_t slots);
+  // Must be preceded by a successful TryReserveConnection
+  std::unique_ptr<Connection> CreateConnection(engine::Deadline deadline,
+                                               size_t slots);
+  // Exclusive connections are not limited by max_pool_size
+  bool TryReserveConnection(bool exclusive);
+  void UnreserveConnection() noexcept;
+  bool WaitForPoolChange(engine::Deadline deadline);
+  void NotifyPoolChanged() noexcept;
+  void DropSlot(Connection* connection) noexcept;
   void Drop(Connection* connection) noexcept;
 
   void RunMonitor();
@@ -63,6 +80,11 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   engine::Semaphore given_away_semaphore_;
   engine::Semaphore connecting_semaphore_;
   boost::lockfree::queue<Connection*> queue_;
+  // Connections are counted in size_ from the reservation on, so that
+  // concurrent creations do not exceed max_pool_size. Changes of size_ and
+  // the returns of slots are signalled under the mutex.
+  engine::Mutex size_mutex_;
+  engine::ConditionVariable pool_changed_cv_;
   std::atomic<size_t> size_{0};
 
   utils::PeriodicTask monitor_;
@@ -1,5 +1,7 @@
 #include "connection_ptr.hpp"
 
+#include <utility>
+
 #include <userver/utils/assert.hpp>
 
 #include <urabbitmq/connection.hpp>
@@ -10,23 +12,27 @@ USERVER_NAMESPACE_BEGIN
 namespace urabbitmq {
 
 ConnectionPtr::ConnectionPtr(std::shared_ptr<ConnectionPool>&& pool,
-                             std::unique_ptr<Connection>&& conn)
-    : pool_{std::move(pool)}, conn_{std::move(conn)} {}
+                             Connection* conn)
+    : pool_{std::move(pool)}, conn_{conn} {}
 
 ConnectionPtr::~ConnectionPtr() { Release(); }
 
-ConnectionPtr::ConnectionPtr(ConnectionPtr&& other) noexcept = default;
+ConnectionPtr::ConnectionPtr(ConnectionPtr&& other) noexcept
+    : pool_{std::move(other.pool_)},
+      conn_{std::exchange(other.conn_, nullptr)},
+      adopted_{std::move(other.adopted_)} {}
 
 Connection* ConnectionPtr::operator->() const {
   UASSERT(conn_);
   conn_->EnsureUsable();
-  return conn_.get();
+  return conn_;
 }
 
 void ConnectionPtr::Adopt() {
   UASSERT(pool_);
   pool_->NotifyConnectionAdopted();
   pool_.reset();
+  adopted_.reset(conn_);
 }
 
 bool ConnectionPtr::IsUsable() const {
@@ -36,7 +42,7 @@ bool ConnectionPtr::IsUsable() const {
 
 void ConnectionPtr::Release() {
   if (pool_ && conn_) {
-    pool_->Release(std::move(conn_));
+    pool_->Release(std::exchange(conn_, nullptr));
   }
 }
 
@@ -11,8 +11,7 @@ class Connection;
 
 class ConnectionPtr {
  public:
-  ConnectionPtr(std::shared_ptr<ConnectionPool>&& pool,
-                std::unique_ptr<Connection>&& conn);
+  ConnectionPtr(std::shared_ptr<ConnectionPool>&& pool, Connection* conn);
   ~ConnectionPtr();
 
   ConnectionPtr(const ConnectionPtr& other) = delete;
@@ -27,7 +26,9 @@ class ConnectionPtr {
   void Release();
 
   std::shared_ptr<ConnectionPool> pool_;
-  std::unique_ptr<Connection> conn_;
+  // one of the pool slots of the connection, see ConnectionPool
+  Connection* conn_;
+  std::unique_ptr<Connection> adopted_;
 };
 
 }  // namespace urabbitmq
@@ -2,6 +2,7 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/urabbitmq/client.hpp>
 
 #include <urabbitmq/client_impl.hpp>
@@ -21,7 +22,7 @@ std::unique_ptr<ConsumerBaseImpl> CreateAndStartConsumerImpl(
     ClientImpl& client_impl, const ConsumerSettings& settings,
     OnMessage&& on_message) {
   auto impl = std::make_unique<ConsumerBaseImpl>(
-      client_impl.GetConnection(
+      client_impl.GetExclusiveConnection(
           engine::Deadline::FromDuration(kConnectionAcquisitionTimeout)),
       settings);
   impl->Start(std::forward<OnMessage>(on_message));
@@ -51,7 +52,9 @@ void ConsumerBase::Start() {
   try {
     impl_ = CreateAndStartConsumerImpl(
         *client_->impl_, settings_,
-        [this](std::string message) { Process(std::move(message)); });
+        [this](std::vector<std::string> messages) {
+          ProcessBatch(std::move(messages));
+        });
   } catch (const std::exception& ex) {
     LOG_WARNING() << "Failed to start a consumer: '" << ex.what()
                   << "'; will try to start again";
@@ -72,7 +75,9 @@ void ConsumerBase::Start() {
             impl_.reset();
             impl_ = CreateAndStartConsumerImpl(
                 *client_->impl_, settings_,
-                [this](std::string message) { Process(std::move(message)); });
+                [this](std::vector<std::string> messages) {
+                  ProcessBatch(std::move(messages));
+                });
             LOG_INFO() << "Restarted successfully";
           } catch (const std::exception& ex) {
             LOG_WARNING() << "Failed to restart a consumer: '" << ex.what()
@@ -87,6 +92,16 @@ void ConsumerBase::Stop() {
   impl_.reset();
 }
 
+void ConsumerBase::Process(std::string) {
+  UINVARIANT(false, "Either Process or ProcessBatch must be overridden");
+}
+
+void ConsumerBase::ProcessBatch(std::vector<std::string> messages) {
+  for (auto& message : messages) {
+    Process(std::move(message));
+  }
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
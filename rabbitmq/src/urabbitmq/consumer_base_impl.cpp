@@ -1,10 +1,12 @@
 #include "consumer_base_impl.hpp"
 
 #include <string>
+#include <utility>
 
 #include <fmt/format.h>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
@@ -29,6 +31,8 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
     : dispatcher_{engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
       prefetch_count_{settings.prefetch_count},
+      max_batch_size_{settings.max_batch_size},
+      max_batch_delay_{settings.max_batch_delay},
       connection_ptr_{std::move(connection)},
       channel_{connection_ptr_->GetChannel()} {
   // We take ownership of the connection, because if it remains pooled
@@ -94,41 +98,121 @@ bool ConsumerBaseImpl::IsBroken() const {
 
 void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
                                  uint64_t delivery_tag) {
+  Delivery delivery{std::string{message.body(), message.bodySize()},
+                    message.headers().get("u-trace-id"), delivery_tag};
+
+  std::vector<Delivery> batch;
+  if (max_batch_size_ <= 1) {
+    batch.push_back(std::move(delivery));
+    Dispatch(std::move(batch));
+    return;
+  }
+
+  {
+    std::lock_guard lock{batch_mutex_};
+    batch_.push_back(std::move(delivery));
+    if (batch_.size() >= max_batch_size_) {
+      batch = std::exchange(batch_, {});
+      ++batch_id_;
+    } else if (batch_.size() == 1) {
+      bts_->Detach(engine::AsyncNoSpan(
+          dispatcher_,
+          [this, batch_id = batch_id_] { FlushBatchAfterDelay(batch_id); }));
+    }
+  }
+
+  if (!batch.empty()) Dispatch(std::move(batch));
+}
+
+void ConsumerBaseImpl::FlushBatchAfterDelay(uint64_t batch_id) {
+  engine::InterruptibleSleepFor(max_batch_delay_);
+  if (engine::current_task::ShouldCancel()) return;
+
+  std::vector<Delivery> batch;
+  {
+    std::lock_guard lock{batch_mutex_};
+    // the batch might have been sent out already, because it filled up
+    if (batch_id != batch_id_ || batch_.empty()) return;
+
+    batch = std::exchange(batch_, {});
+    ++batch_id_;
+  }
+
+  Dispatch(std::move(batch));
+}
+
+void ConsumerBaseImpl::Dispatch(std::vector<Delivery>&& batch) {
+  UASSERT(!batch.empty());
   std::string span_name{fmt::format("consume_{}_{}", queue_name_,
                                     consumer_tag_.value_or("ctag:unknown"))};
-  std::string trace_id = message.headers().get("u-trace-id");
-  std::string message_data{message.body(), message.bodySize()};
 
   bts_->Detach(engine::AsyncNoSpan(
-      dispatcher_, [this, message = std::move(message_data),
-                    span_name = std::move(span_name),
-                    trace_id = std::move(trace_id), delivery_tag]() mutable {
-        auto span = tracing::Span::MakeSpan(std::move(span_name), trace_id, {});
+      dispatcher_, [this, batch = std::move(batch),
+                    span_name = std::move(span_name)]() mutable {
+        auto span = tracing::Span::MakeSpan(std::move(span_name),
+                                            batch.front().trace_id, {});
+
+        std::vector<std::string> messages;
+        messages.reserve(batch.size());
+        for (auto& delivery : batch) {
+          messages.push_back(std::move(delivery.message));
+        }
 
         bool success = false;
         try {
-          dispatch_callback_(std::move(message));
+          dispatch_callback_(std::move(messages));
           success = true;
         } catch (const std::exception& ex) {
           LOG_ERROR() << "Failed to process the consumed message, " << ex.what()
                       << "; would requeue";
         }
 
-        try {
-          if (success) {
-            channel_.Ack(delivery_tag, {});
-            channel_.AccountMessageConsumed();
-          } else {
-            channel_.Reject(delivery_tag, true, {});
-          }
-        } catch (const std::exception& ex) {
-          LOG_WARNING()
-              << "Failed to " << (success ? "ack" : "requeue")
-              << " the message, it will be requeued by RabbitMQ at some point";
-        }
+        Finish(batch, success);
       }));
 }
 
+void ConsumerBaseImpl::Finish(const std::vector<Delivery>& batch,
+                              bool success) {
+  if (!success) {
+    for (const auto& delivery : batch) {
+      try {
+        channel_.Reject(delivery.delivery_tag, true, {});
+      } catch (const std::exception&) {
+        LOG_WARNING() << "Failed to requeue the message, it will be requeued "
+                         "by RabbitMQ at some point";
+      }
+    }
+  }
+
+  std::lock_guard lock{ack_mutex_};
+  for (const auto& delivery : batch) {
+    completed_.emplace(delivery.delivery_tag, success);
+  }
+
+  // Delivery tags are assigned by the broker sequentially within a channel,
+  // so we advance over the contiguous range of completed deliveries and ack
+  // the last successful of them, which acks all the previous ones as well.
+  // The rejected ones are not outstanding anymore and are not affected.
+  uint64_t ack_tag = 0;
+  for (auto it = completed_.begin();
+       it != completed_.end() && it->first == last_completed_tag_ + 1;
+       it = completed_.erase(it)) {
+    last_completed_tag_ = it->first;
+    if (it->second) {
+      ack_tag = it->first;
+      channel_.AccountMessageConsumed();
+    }
+  }
+
+  if (ack_tag == 0) return;
+  try {
+    channel_.Ack(ack_tag, true, {});
+  } catch (const std::exception&) {
+    LOG_WARNING() << "Failed to ack the messages, they will be requeued by "
+                     "RabbitMQ at some point";
+  }
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
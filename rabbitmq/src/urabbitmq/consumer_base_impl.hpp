@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <map>
+#include <vector>
 
 #include <userver/concurrent/background_task_storage_fwd.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
@@ -25,19 +28,31 @@ class ConsumerBaseImpl final {
                    const ConsumerSettings& settings);
   ~ConsumerBaseImpl();
 
-  using DispatchCallback = std::function<void(std::string message)>;
+  using DispatchCallback =
+      std::function<void(std::vector<std::string> messages)>;
 
   void Start(DispatchCallback cb);
 
   bool IsBroken() const;
 
  private:
+  struct Delivery final {
+    std::string message;
+    std::string trace_id;
+    uint64_t delivery_tag;
+  };
+
   void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void FlushBatchAfterDelay(uint64_t batch_id);
+  void Dispatch(std::vector<Delivery>&& batch);
+  void Finish(const std::vector<Delivery>& batch, bool success);
   void Stop();
 
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
   uint16_t prefetch_count_;
+  const uint16_t max_batch_size_;
+  const std::chrono::milliseconds max_batch_delay_;
 
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
@@ -46,6 +61,18 @@ class ConsumerBaseImpl final {
 
   DispatchCallback dispatch_callback_;
 
+  // Deliveries waiting for the batch to fill up
+  engine::Mutex batch_mutex_;
+  std::vector<Delivery> batch_;
+  uint64_t batch_id_{0};
+
+  // Messages complete out of order, but are acked in order with a single
+  // cumulative ack for each contiguous range of completed deliveries
+  engine::Mutex ack_mutex_;
+  // delivery tag -> whether the processing succeeded
+  std::map<uint64_t, bool> completed_;
+  uint64_t last_completed_tag_{0};
+
   std::atomic<bool> stopped_{false};
 
   // Underlying channel errored, just restart the consumer
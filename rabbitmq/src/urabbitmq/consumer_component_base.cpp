@@ -19,6 +19,13 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
 
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
 
+  settings.max_batch_size =
+      config["max_batch_size"].As<uint16_t>(settings.max_batch_size);
+  settings.max_batch_delay =
+      config["max_batch_delay"].As<std::chrono::milliseconds>(
+          settings.max_batch_delay);
+  UINVARIANT(settings.max_batch_size > 0, "max_batch_size is set to zero");
+
   return settings;
 }
 
@@ -40,6 +47,11 @@ class ConsumerComponentBase::Impl final : public ConsumerBase {
     parent_->Process(std::move(message));
   }
 
+  void ProcessBatch(std::vector<std::string> messages) override {
+    UASSERT(parent_ != nullptr);
+    parent_->ProcessBatch(std::move(messages));
+  }
+
  private:
   ConsumerComponentBase* parent_{nullptr};
 };
@@ -61,6 +73,16 @@ void ConsumerComponentBase::OnAllComponentsLoaded() { impl_->Start(this); }
 
 void ConsumerComponentBase::OnAllComponentsAreStopping() { impl_->Stop(); }
 
+void ConsumerComponentBase::Process(std::string) {
+  UINVARIANT(false, "Either Process or ProcessBatch must be overridden");
+}
+
+void ConsumerComponentBase::ProcessBatch(std::vector<std::string> messages) {
+  for (auto& message : messages) {
+    Process(std::move(message));
+  }
+}
+
 yaml_config::Schema ConsumerComponentBase::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
 type: object
@@ -76,6 +98,14 @@ properties:
     prefetch_count:
         type: integer
         description: prefetch_count for the consumer
+    max_batch_size:
+        type: integer
+        description: max number of messages passed to a single ProcessBatch call
+        defaultDescription: 1
+    max_batch_delay:
+        type: string
+        description: max time to wait for a batch to fill up
+        defaultDescription: 10ms
 )");
 }
 
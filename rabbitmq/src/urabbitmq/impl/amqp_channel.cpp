@@ -1,5 +1,8 @@
 #include "amqp_channel.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <optional>
 
 #include <userver/engine/task/task.hpp>
@@ -15,6 +18,8 @@ namespace urabbitmq::impl {
 
 namespace {
 
+constexpr std::size_t kMaxMessagesPerBurst = 1000;
+
 AMQP::ExchangeType Convert(urabbitmq::Exchange::Type type) {
   using From = urabbitmq::Exchange::Type;
   using To = AMQP::ExchangeType;
@@ -152,6 +157,7 @@ void AmqpChannel::Publish(const Exchange& exchange,
   envelope.setPersistent(type == MessageType::kPersistent);
   envelope.setHeaders(CreateHeaders());
 
+  conn_.WaitUnblocked(deadline);
   {
     auto channel = conn_.GetChannel(deadline);
 
@@ -164,10 +170,11 @@ void AmqpChannel::Publish(const Exchange& exchange,
   // We don't account publish here, because there's no way to ensure success
 }
 
-void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
+void AmqpChannel::Ack(uint64_t delivery_tag, bool multiple,
+                      engine::Deadline deadline) {
   // No way to acknowledge success, no way to handle synchronous errors
   auto channel = conn_.GetChannel(deadline);
-  channel->ack(delivery_tag);
+  channel->ack(delivery_tag, multiple ? AMQP::multiple : 0);
 }
 
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
@@ -228,6 +235,7 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
 
   auto awaiter = conn_.GetAwaiter(deadline);
 
+  conn_.WaitUnblocked(deadline);
   {
     auto reliable = conn_.GetReliableChannel(deadline);
 
@@ -244,6 +252,54 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
   return awaiter;
 }
 
+ResponseAwaiter AmqpReliableChannel::PublishBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  const auto headers = CreateHeaders();
+
+  auto awaiter = conn_.GetAwaiter(deadline);
+  if (messages.empty()) {
+    awaiter.GetWrapper()->Ok();
+    return awaiter;
+  }
+
+  // Confirmations are matched to the messages by delivery tags in
+  // AMQP::Reliable, so we only have to count them
+  auto unconfirmed =
+      std::make_shared<std::atomic<std::size_t>>(messages.size());
+
+  for (std::size_t begin = 0; begin < messages.size();
+       begin += kMaxMessagesPerBurst) {
+    const auto end = std::min(begin + kMaxMessagesPerBurst, messages.size());
+
+    // The broker may block the connection in the middle of a batch
+    conn_.WaitUnblocked(deadline);
+
+    // The lock is released between the bursts, so that the confirmations of
+    // the already sent messages get processed meanwhile
+    auto reliable = conn_.GetReliableChannel(deadline);
+    AmqpConnection::WriteBufferingScope buffering{conn_};
+
+    for (std::size_t i = begin; i < end; ++i) {
+      AMQP::Envelope envelope{messages[i].data(), messages[i].size()};
+      envelope.setPersistent(type == MessageType::kPersistent);
+      envelope.setHeaders(headers);
+
+      reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
+          .onAck([this, unconfirmed, deferred = awaiter.GetWrapper()] {
+            AccountMessagePublished();
+            if (--*unconfirmed == 0) deferred->Ok();
+          })
+          .onError([deferred = awaiter.GetWrapper()](const char* error) {
+            deferred->Fail(error);
+          });
+    }
+  }
+
+  return awaiter;
+}
+
 void AmqpReliableChannel::AccountMessagePublished() {
   conn_.GetStatistics().AccountMessagePublished();
 }
@@ -2,6 +2,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/utils/assert.hpp>
@@ -54,7 +56,8 @@ class AmqpChannel final {
                const std::string& message, MessageType type,
                engine::Deadline deadline);
 
-  void Ack(uint64_t delivery_tag, engine::Deadline deadline);
+  // With `multiple` all the unacked messages up to `delivery_tag` are acked
+  void Ack(uint64_t delivery_tag, bool multiple, engine::Deadline deadline);
 
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
@@ -87,6 +90,11 @@ class AmqpReliableChannel final {
                           const std::string& message, MessageType type,
                           engine::Deadline deadline);
 
+  ResponseAwaiter PublishBatch(const Exchange& exchange,
+                               const std::string& routing_key,
+                               const std::vector<std::string>& messages,
+                               MessageType type, engine::Deadline deadline);
+
  private:
   void AccountMessagePublished();
 
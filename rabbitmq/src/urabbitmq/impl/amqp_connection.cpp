@@ -20,8 +20,7 @@ AMQP::Connection CreateConnection(AmqpConnectionHandler& handler,
 
 }  // namespace
 
-ConnectionLock::ConnectionLock(engine::SingleWaitingTaskMutex& mutex,
-                               engine::Deadline deadline)
+ConnectionLock::ConnectionLock(engine::Mutex& mutex, engine::Deadline deadline)
     : mutex_{mutex}, owns_{mutex_.try_lock_until(deadline)} {
   if (!owns_) {
     throw std::runtime_error{
@@ -95,6 +94,19 @@ ResponseAwaiter AmqpConnection::GetAwaiter(engine::Deadline deadline) {
   return ResponseAwaiter{std::move(lock)};
 }
 
+void AmqpConnection::WaitUnblocked(engine::Deadline deadline) {
+  handler_.WaitUnblocked(deadline);
+}
+
+AmqpConnection::WriteBufferingScope::WriteBufferingScope(AmqpConnection& conn)
+    : conn_{conn} {
+  conn_.handler_.StartWriteBuffering();
+}
+
+AmqpConnection::WriteBufferingScope::~WriteBufferingScope() {
+  conn_.handler_.FlushWriteBuffer(&conn_.GetNative());
+}
+
 ConnectionLock AmqpConnection::Lock(engine::Deadline deadline) {
   return {mutex_, deadline};
 }
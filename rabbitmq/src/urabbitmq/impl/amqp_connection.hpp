@@ -1,8 +1,8 @@
 #pragma once
 
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
-#include <userver/engine/single_waiting_task_mutex.hpp>
 
 #include <amqpcpp.h>
 
@@ -19,15 +19,14 @@ namespace urabbitmq::impl {
 
 class ConnectionLock final {
  public:
-  ConnectionLock(engine::SingleWaitingTaskMutex& mutex,
-                 engine::Deadline deadline);
+  ConnectionLock(engine::Mutex& mutex, engine::Deadline deadline);
   ~ConnectionLock();
 
   ConnectionLock(const ConnectionLock& other) = delete;
   ConnectionLock(ConnectionLock&& other) noexcept;
 
  private:
-  engine::SingleWaitingTaskMutex& mutex_;
+  engine::Mutex& mutex_;
   bool owns_;
 };
 
@@ -68,6 +67,24 @@ class AmqpConnection final {
 
   ResponseAwaiter GetAwaiter(engine::Deadline deadline);
 
+  // Waits for the broker to lift its flow control, must be called without
+  // the lock of the connection held
+  void WaitUnblocked(engine::Deadline deadline);
+
+  /// Collects all the writes done while it is alive and sends them to the
+  /// socket at once. Must only be used under a lock of the connection.
+  class WriteBufferingScope final {
+   public:
+    explicit WriteBufferingScope(AmqpConnection& conn);
+    ~WriteBufferingScope();
+
+    WriteBufferingScope(const WriteBufferingScope&) = delete;
+    WriteBufferingScope& operator=(const WriteBufferingScope&) = delete;
+
+   private:
+    AmqpConnection& conn_;
+  };
+
  private:
   friend class AmqpConnectionLocker;
   [[nodiscard]] ConnectionLock Lock(engine::Deadline deadline);
@@ -97,7 +114,8 @@ class AmqpConnection final {
   AMQP::Channel reliable_channel_;
   std::unique_ptr<ReliableChannel> reliable_;
 
-  engine::SingleWaitingTaskMutex mutex_{};
+  // the connection may be shared by several publishers along with the reader
+  engine::Mutex mutex_{};
   engine::Semaphore waiters_sema_;
 };
 
@@ -3,6 +3,8 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 
+#include <mutex>
+
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/socket.hpp>
@@ -19,6 +21,8 @@ namespace urabbitmq::impl {
 
 namespace {
 
+constexpr std::size_t kMaxRetainedWriteBufferSize = 1024 * 1024;
+
 engine::io::Socket CreateSocket(engine::io::Sockaddr& addr,
                                 engine::Deadline deadline) {
   engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kTcp};
@@ -92,6 +96,16 @@ void AmqpConnectionHandler::onData(AMQP::Connection* connection,
     return;
   }
 
+  if (buffer_writes_) {
+    write_buffer_.append(buffer, size);
+    return;
+  }
+
+  DoWrite(connection, buffer, size);
+}
+
+void AmqpConnectionHandler::DoWrite(AMQP::Connection* connection,
+                                    const char* buffer, size_t size) {
   try {
     const auto sent = socket_->WriteAll(buffer, size, operation_deadline_);
     if (sent != size) {
@@ -134,6 +148,23 @@ void AmqpConnectionHandler::onReady(AMQP::Connection*) {
   connection_ready_event_.Send();
 }
 
+void AmqpConnectionHandler::onBlocked(AMQP::Connection*, const char* reason) {
+  LOG_WARNING() << "The broker has blocked the connection: " << reason;
+  stats_.AccountConnectionBlocked();
+
+  std::lock_guard lock{blocked_mutex_};
+  blocked_ = true;
+}
+
+void AmqpConnectionHandler::onUnblocked(AMQP::Connection*) {
+  LOG_INFO() << "The broker has unblocked the connection";
+  {
+    std::lock_guard lock{blocked_mutex_};
+    blocked_ = false;
+  }
+  unblocked_cv_.NotifyAll();
+}
+
 void AmqpConnectionHandler::OnConnectionCreated(AmqpConnection* connection,
                                                 engine::Deadline deadline) {
   reader_.Start(connection);
@@ -152,10 +183,28 @@ void AmqpConnectionHandler::OnConnectionCreated(AmqpConnection* connection,
 
 void AmqpConnectionHandler::OnConnectionDestruction() { reader_.Stop(); }
 
-void AmqpConnectionHandler::Invalidate() { broken_ = true; }
+void AmqpConnectionHandler::Invalidate() {
+  {
+    std::lock_guard lock{blocked_mutex_};
+    broken_ = true;
+  }
+  // the waiters fail on the broken connection rather than on the deadline
+  unblocked_cv_.NotifyAll();
+}
 
 bool AmqpConnectionHandler::IsBroken() const { return broken_.load(); }
 
+void AmqpConnectionHandler::WaitUnblocked(engine::Deadline deadline) {
+  if (!blocked_) return;
+
+  std::unique_lock lock{blocked_mutex_};
+  if (!unblocked_cv_.WaitUntil(lock, deadline,
+                               [this] { return !blocked_ || broken_; })) {
+    throw std::runtime_error{
+        "The connection is blocked by the broker, publishing is paused"};
+  }
+}
+
 void AmqpConnectionHandler::AccountRead(size_t size) {
   stats_.AccountRead(size);
 }
@@ -168,6 +217,24 @@ void AmqpConnectionHandler::SetOperationDeadline(engine::Deadline deadline) {
   operation_deadline_ = deadline;
 }
 
+void AmqpConnectionHandler::StartWriteBuffering() {
+  UASSERT(!buffer_writes_);
+  buffer_writes_ = true;
+}
+
+void AmqpConnectionHandler::FlushWriteBuffer(AMQP::Connection* connection) {
+  buffer_writes_ = false;
+  if (!write_buffer_.empty() && !IsBroken()) {
+    DoWrite(connection, write_buffer_.data(), write_buffer_.size());
+  }
+
+  if (write_buffer_.capacity() > kMaxRetainedWriteBufferSize) {
+    std::string{}.swap(write_buffer_);
+  } else {
+    write_buffer_.clear();
+  }
+}
+
 statistics::ConnectionStatistics& AmqpConnectionHandler::GetStatistics() {
   return stats_;
 }
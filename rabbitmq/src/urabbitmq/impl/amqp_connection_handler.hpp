@@ -6,6 +6,8 @@
 #include <string>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 
 #include <urabbitmq/impl/io/socket_reader.hpp>
@@ -60,6 +62,11 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
 
   void onReady(AMQP::Connection* connection) override;
 
+  // The broker stops reading from the connection while it is blocked
+  void onBlocked(AMQP::Connection* connection, const char* reason) override;
+
+  void onUnblocked(AMQP::Connection* connection) override;
+
   void OnConnectionCreated(AmqpConnection* connection,
                            engine::Deadline deadline);
   void OnConnectionDestruction();
@@ -67,8 +74,16 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
   void Invalidate();
   bool IsBroken() const;
 
+  // Returns immediately if the broker doesn't block the connection,
+  // throws if it doesn't unblock it before the deadline
+  void WaitUnblocked(engine::Deadline deadline);
+
   void SetOperationDeadline(engine::Deadline deadline);
 
+  // While buffering, the data is kept in memory until FlushWriteBuffer
+  void StartWriteBuffering();
+  void FlushWriteBuffer(AMQP::Connection* connection);
+
   void AccountRead(size_t size);
   void AccountWrite(size_t size);
 
@@ -77,6 +92,9 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
   const AMQP::Address& GetAddress() const;
 
  private:
+  void DoWrite(AMQP::Connection* connection, const char* buffer,
+               size_t size);
+
   AMQP::Address address_;
   std::unique_ptr<engine::io::RwBase> socket_;
   io::SocketReader reader_;
@@ -84,12 +102,19 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
   engine::SingleConsumerEvent connection_ready_event_;
   std::atomic<bool> broken_{false};
 
+  std::atomic<bool> blocked_{false};
+  engine::Mutex blocked_mutex_;
+  engine::ConditionVariable unblocked_cv_;
+
   statistics::ConnectionStatistics& stats_;
 
   engine::Deadline operation_deadline_ = engine::Deadline::Passed();
 
   std::atomic<bool> is_ready_{false};
   std::optional<std::string> error_;
+
+  bool buffer_writes_{false};
+  std::string write_buffer_;
 };
 
 }  // namespace impl
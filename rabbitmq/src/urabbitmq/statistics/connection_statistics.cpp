@@ -12,6 +12,17 @@ void ConnectionStatistics::AccountConnectionCreated() {
 
 void ConnectionStatistics::AccountConnectionClosed() { ++connections_closed_; }
 
+void ConnectionStatistics::AccountConnectionBlocked() {
+  ++connections_blocked_;
+}
+
+void ConnectionStatistics::AccountAcquire(std::chrono::microseconds wait_time) {
+  ++acquisitions_;
+  acquisition_wait_us_ += static_cast<size_t>(wait_time.count());
+}
+
+void ConnectionStatistics::AccountAcquireFailed() { ++acquisition_failures_; }
+
 void ConnectionStatistics::AccountWrite(size_t bytes_written) {
   bytes_sent_ += bytes_written;
 }
@@ -28,6 +39,10 @@ ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   Frozen result{};
   result.connections_created = connections_created_.Load();
   result.connections_closed = connections_closed_.Load();
+  result.connections_blocked = connections_blocked_.Load();
+  result.acquisitions = acquisitions_.Load();
+  result.acquisition_failures = acquisition_failures_.Load();
+  result.acquisition_wait_us = acquisition_wait_us_.Load();
   result.bytes_sent = bytes_sent_.Load();
   result.bytes_read = bytes_read_.Load();
   result.messages_published = messages_published_.Load();
@@ -40,6 +55,10 @@ ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
     const Frozen& other) {
   connections_created += other.connections_created;
   connections_closed += other.connections_closed;
+  connections_blocked += other.connections_blocked;
+  acquisitions += other.acquisitions;
+  acquisition_failures += other.acquisition_failures;
+  acquisition_wait_us += other.acquisition_wait_us;
   bytes_sent += other.bytes_sent;
   bytes_read += other.bytes_read;
   messages_published += other.messages_published;
@@ -53,6 +72,10 @@ formats::json::Value Serialize(const ConnectionStatistics::Frozen& value,
   formats::json::ValueBuilder builder{formats::json::Type::kObject};
   builder["connections_created"] = value.connections_created;
   builder["connections_closed"] = value.connections_closed;
+  builder["connections_blocked"] = value.connections_blocked;
+  builder["acquisitions"] = value.acquisitions;
+  builder["acquisition_failures"] = value.acquisition_failures;
+  builder["acquisition_wait_us"] = value.acquisition_wait_us;
   builder["bytes_sent"] = value.bytes_sent;
   builder["bytes_read"] = value.bytes_read;
   builder["messages_published"] = value.messages_published;
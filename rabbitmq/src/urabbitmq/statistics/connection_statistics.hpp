@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/formats/json/serialize.hpp>
@@ -13,6 +14,10 @@ class ConnectionStatistics final {
  public:
   void AccountConnectionCreated();
   void AccountConnectionClosed();
+  void AccountConnectionBlocked();
+
+  void AccountAcquire(std::chrono::microseconds wait_time);
+  void AccountAcquireFailed();
 
   void AccountWrite(size_t bytes_written);
   void AccountRead(size_t bytes_read);
@@ -25,6 +30,11 @@ class ConnectionStatistics final {
 
     size_t connections_created{0};
     size_t connections_closed{0};
+    size_t connections_blocked{0};
+
+    size_t acquisitions{0};
+    size_t acquisition_failures{0};
+    size_t acquisition_wait_us{0};
 
     size_t bytes_sent{0};
     size_t bytes_read{0};
@@ -37,6 +47,11 @@ class ConnectionStatistics final {
  private:
   utils::statistics::RelaxedCounter<size_t> connections_created_{0};
   utils::statistics::RelaxedCounter<size_t> connections_closed_{0};
+  utils::statistics::RelaxedCounter<size_t> connections_blocked_{0};
+
+  utils::statistics::RelaxedCounter<size_t> acquisitions_{0};
+  utils::statistics::RelaxedCounter<size_t> acquisition_failures_{0};
+  utils::statistics::RelaxedCounter<size_t> acquisition_wait_us_{0};
 
   utils::statistics::RelaxedCounter<size_t> bytes_sent_{0};
   utils::statistics::RelaxedCounter<size_t> bytes_read_{0};
@@ -15,6 +15,7 @@
 #include <userver/storages/redis/request.hpp>
 #include <userver/storages/redis/request_eval.hpp>
 #include <userver/storages/redis/request_evalsha.hpp>
+#include <userver/storages/redis/script.hpp>
 #include <userver/storages/redis/transaction.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -90,6 +91,25 @@ class Client {
       std::string script, size_t shard,
       const CommandControl& command_control) = 0;
 
+  /// @brief Loads the script into every master and replica of each shard,
+  /// both now and on each (re)connection, e.g. after a failover.
+  ///
+  /// The registered script is run by EvalSha(const Script&, ...) without the
+  /// NOSCRIPT handling and without loading it by hand. The new connections
+  /// are not used until the registered scripts are loaded into them, the
+  /// connected ones get the script queued before the call returns.
+  virtual void RegisterScript(const Script& script) = 0;
+
+  /// @brief Runs the script registered by RegisterScript by its SHA1
+  template <typename ScriptResult, typename ReplyType = ScriptResult>
+  RequestEval<ScriptResult, ReplyType> EvalSha(
+      const Script& script, std::vector<std::string> keys,
+      std::vector<std::string> args, const CommandControl& command_control) {
+    return RequestEval<ScriptResult, ReplyType>{
+        EvalShaCommon(script.GetSha1(), std::move(keys), std::move(args),
+                      command_control)};
+  }
+
   template <typename ScriptInfo, typename ReplyType = std::decay_t<ScriptInfo>>
   RequestEval<std::decay_t<ScriptInfo>, ReplyType> Eval(
       const ScriptInfo& script_info, std::vector<std::string> keys,
@@ -265,6 +285,17 @@ class Client {
   virtual RequestScan Scan(size_t shard, ScanOptions options,
                            const CommandControl& command_control) = 0;
 
+  /// @brief SCAN of all the shards, e.g. for the maintenance jobs over the
+  /// whole keyspace.
+  ///
+  /// The cursors of up to `max_parallel_shards` shards are iterated
+  /// concurrently and their keys are merged in the order the replies arrive.
+  /// Use RequestScan::GetBatch to process the keys of a whole reply at once.
+  /// A client of GetClientForShard scans only its shard.
+  virtual RequestScan ScanAllShards(ScanOptions options,
+                                    size_t max_parallel_shards,
+                                    const CommandControl& command_control) = 0;
+
   virtual RequestScard Scard(std::string key,
                              const CommandControl& command_control) = 0;
 
@@ -0,0 +1,111 @@
+#pragma once
+
+/// @file userver/storages/redis/client_side_cache.hpp
+/// @brief @copybrief storages::redis::ClientSideCache
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_options.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+class SubscribeClient;
+
+/// @class ClientSideCache
+/// @brief In-process cache for GET and HGET results, invalidated by keyspace
+/// notifications of redis.
+///
+/// Repeated reads of hot keys are served from memory without a network
+/// roundtrip. A key is dropped from the cache as soon as redis notifies about
+/// any change of it, so the servers must have keyspace notifications enabled,
+/// e.g. `notify-keyspace-events Kgxe$h`.
+///
+/// As notifications may be lost (e.g. on reconnects), every cached value also
+/// expires after Settings::ttl, which bounds the staleness of the data.
+class ClientSideCache final {
+ public:
+  struct Settings {
+    /// Max number of cached keys
+    std::size_t max_size{10000};
+    /// Max time to keep a value
+    std::chrono::milliseconds ttl{std::chrono::seconds{10}};
+  };
+
+  struct Statistics {
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t invalidations{0};
+  };
+
+  ClientSideCache(ClientPtr client, SubscribeClient& subscribe_client,
+                  Settings settings);
+  ~ClientSideCache();
+
+  ClientSideCache(const ClientSideCache&) = delete;
+  ClientSideCache& operator=(const ClientSideCache&) = delete;
+
+  /// Returns the value of a key, requests redis on cache miss
+  std::optional<std::string> Get(std::string key,
+                                 const CommandControl& command_control = {});
+
+  /// Returns the value of a hash field, requests redis on cache miss
+  std::optional<std::string> Hget(std::string key, std::string field,
+                                  const CommandControl& command_control = {});
+
+  /// Drops all the values of a key
+  void Invalidate(const std::string& key);
+
+  /// Drops all the values
+  void Clear();
+
+  Statistics GetStatistics() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::optional<std::string> value;
+    Clock::time_point expires_at;
+    // nonzero while the value is being fetched
+    std::uint64_t fill_token{0};
+  };
+
+  struct KeyEntry {
+    std::optional<Entry> value;
+    std::unordered_map<std::string, Entry> fields;
+  };
+
+  using Storage = cache::LruMap<std::string, KeyEntry>;
+
+  template <typename Fetch>
+  std::optional<std::string> GetOrFetch(const std::string& key,
+                                        const std::string* field,
+                                        Fetch&& fetch);
+
+  void OnKeyspaceNotification(const std::string& channel);
+
+  ClientPtr client_;
+  const Settings settings_;
+  concurrent::Variable<Storage, engine::Mutex> storage_;
+  std::atomic<std::uint64_t> last_fill_token_{0};
+  std::atomic<std::size_t> hits_{0};
+  std::atomic<std::size_t> misses_{0};
+  std::atomic<std::size_t> invalidations_{0};
+  SubscriptionToken subscription_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -61,6 +61,8 @@ namespace components {
 /// groups.[].db | name to refer to the cluster in components::Redis::GetClient() | -
 /// groups.[].sharding_strategy | one of RedisCluster, KeyShardCrc32, KeyShardTaximeterCrc32 or KeyShardGpsStorageDriver | "KeyShardTaximeterCrc32"
 /// groups.[].allow_reads_from_master | allows read requests from master instance | false
+/// groups.[].throttling_accepts_multiplier | reject the requests to a shard locally once they outnumber the requests served by it during the last 2 minutes by this factor, see congestion_control::ClientThrottler; 0 disables the throttling | 0
+/// groups.[].connections_per_instance | connections to open to each redis instance for more throughput; the commands are sent over the least loaded connection, the commands with the same key are sent over the same connection to keep their order | 1
 /// subscribe_groups | array of redis clusters to work with in subscribe mode | -
 /// subscribe_groups.[].config_name | key name in secdist with options for this cluster | -
 /// subscribe_groups.[].db | name to refer to the cluster in components::Redis::GetSubscribeClient() | -
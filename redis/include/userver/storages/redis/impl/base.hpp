@@ -178,6 +178,10 @@ struct CommandControl {
     kLocalDcConductor,
     /* Send requests to 'best_dc_count' Redis instances with the min ping */
     kNearestServerPing,
+    /* Send requests to the instance with the min expected reply time, that
+       is estimated by the moving average of the reply times and the number of
+       commands in flight */
+    kLeastLatency,
   };
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -243,11 +247,15 @@ struct CommandsBufferingSettings {
   bool buffering_enabled{false};
   size_t commands_buffering_threshold{0};
   std::chrono::microseconds watch_command_timer_interval{0};
+  /// Send consecutive plain GETs and SETs as a single MGET or MSET. A merged
+  /// GET of a key holding a non-string value replies nil instead of WRONGTYPE.
+  bool merge_get_set_commands{false};
 
   constexpr bool operator==(const CommandsBufferingSettings& o) const {
     return buffering_enabled == o.buffering_enabled &&
            commands_buffering_threshold == o.commands_buffering_threshold &&
-           watch_command_timer_interval == o.watch_command_timer_interval;
+           watch_command_timer_interval == o.watch_command_timer_interval &&
+           merge_get_set_commands == o.merge_get_set_commands;
   }
 };
 
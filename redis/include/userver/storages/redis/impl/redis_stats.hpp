@@ -3,9 +3,11 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/types.hpp>
@@ -98,6 +100,9 @@ struct InstanceStatistics {
   long long last_ping_ms;
 
   std::array<long long, REDIS_ERR_MAX + 1> error_count{{}};
+
+  // Per connection statistics of an instance with several connections
+  std::vector<InstanceStatistics> connections;
 };
 
 struct ShardStatistics {
@@ -106,6 +111,9 @@ struct ShardStatistics {
   std::map<std::string, InstanceStatistics> instances;
   bool is_ready = false;
   std::chrono::steady_clock::time_point last_ready_time;
+  /// Number of the requests rejected by the client-side throttling, only set
+  /// for the master statistics as the throttling is per shard
+  std::uint64_t throttled = 0;
 };
 
 struct SentinelStatisticsInternal {
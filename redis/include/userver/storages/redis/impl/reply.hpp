@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/logging/log_extra.hpp>
@@ -15,6 +17,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
+/// Bulk strings of a reply received from a server are not copied out of the
+/// hiredis reply, ReplyData keeps the reply alive instead and copies a string
+/// on the first non-const GetString() call only. Use GetStringView() to read
+/// a string without copying it.
+///
+/// Like the standard containers, ReplyData is not safe to be accessed from
+/// several threads at once, even via const member functions.
 class ReplyData final {
  public:
   using Array = std::vector<ReplyData>;
@@ -36,8 +45,12 @@ class ReplyData final {
       KeyValue(const Array& array, size_t index)
           : array_(array), index_(index) {}
 
-      std::string Key() const { return array_[index_ * 2].GetString(); }
-      std::string Value() const { return array_[index_ * 2 + 1].GetString(); }
+      std::string Key() const {
+        return std::string{array_[index_ * 2].GetStringView()};
+      }
+      std::string Value() const {
+        return std::string{array_[index_ * 2 + 1].GetStringView()};
+      }
 
      private:
       const Array& array_;
@@ -80,6 +93,9 @@ class ReplyData final {
 
       std::string& Key() { return key_data_.GetString(); }
       std::string& Value() { return value_data_.GetString(); }
+      std::string_view ValueView() const {
+        return value_data_.GetStringView();
+      }
 
      private:
       ReplyData& key_data_;
@@ -120,6 +136,8 @@ class ReplyData final {
   MovableKeyValues GetMovableKeyValues();
 
   ReplyData(const redisReply* reply);
+  /// References the strings of the reply instead of copying them
+  explicit ReplyData(std::shared_ptr<const redisReply> reply);
   ReplyData(Array&& array);
   ReplyData(std::string s);
   ReplyData(int value);
@@ -152,14 +170,21 @@ class ReplyData final {
 
   const std::string& GetString() const {
     UASSERT(IsString());
+    MaterializeString();
     return string_;
   }
 
   std::string& GetString() {
     UASSERT(IsString());
+    MaterializeString();
     return string_;
   }
 
+  std::string_view GetStringView() const {
+    UASSERT(IsString());
+    return owner_ ? view_ : std::string_view{string_};
+  }
+
   const Array& GetArray() const {
     UASSERT(IsArray());
     return array_;
@@ -225,6 +250,15 @@ class ReplyData final {
 
  private:
   ReplyData() = default;
+  ReplyData(const redisReply* reply,
+            const std::shared_ptr<const redisReply>& owner);
+
+  void MaterializeString() const {
+    if (!owner_) return;
+    string_.assign(view_.data(), view_.size());
+    view_ = {};
+    owner_.reset();
+  }
 
   [[noreturn]] void ThrowUnexpectedReplyType(
       ReplyData::Type expected, const std::string& request_description) const;
@@ -233,7 +267,10 @@ class ReplyData final {
 
   int64_t integer_{};
   Array array_;
-  std::string string_;
+  mutable std::string string_;
+  // set while string_ is not copied out of the hiredis reply yet
+  mutable std::shared_ptr<const redisReply> owner_;
+  mutable std::string_view view_;
 };
 
 class Reply final {
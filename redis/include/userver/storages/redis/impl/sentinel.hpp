@@ -5,6 +5,7 @@
 
 #include <boost/signals2.hpp>
 
+#include <userver/congestion_control/client_throttler.hpp>
 #include <userver/utils/swappingsmart.hpp>
 
 #include <userver/storages/redis/impl/base.hpp>
@@ -51,7 +52,8 @@ class Sentinel {
            std::unique_ptr<KeyShard>&& key_shard = nullptr,
            CommandControl command_control = kDefaultCommandControl,
            const testsuite::RedisControl& testsuite_redis_control = {},
-           ConnectionMode mode = ConnectionMode::kCommands);
+           ConnectionMode mode = ConnectionMode::kCommands,
+           size_t connections_per_instance = 1);
   virtual ~Sentinel();
 
   void Start();
@@ -77,14 +79,16 @@ class Sentinel {
       const secdist::RedisSettings& settings, std::string shard_group_name,
       const std::string& client_name, KeyShardFactory key_shard_factory,
       const CommandControl& command_control = kDefaultCommandControl,
-      const testsuite::RedisControl& testsuite_redis_control = {});
+      const testsuite::RedisControl& testsuite_redis_control = {},
+      size_t connections_per_instance = 1);
   static std::shared_ptr<redis::Sentinel> CreateSentinel(
       const std::shared_ptr<ThreadPools>& thread_pools,
       const secdist::RedisSettings& settings, std::string shard_group_name,
       const std::string& client_name, ReadyChangeCallback ready_callback,
       KeyShardFactory key_shard_factory,
       const CommandControl& command_control = kDefaultCommandControl,
-      const testsuite::RedisControl& testsuite_redis_control = {});
+      const testsuite::RedisControl& testsuite_redis_control = {},
+      size_t connections_per_instance = 1);
 
   void Restart();
 
@@ -103,6 +107,10 @@ class Sentinel {
 
   size_t ShardByKey(const std::string& key) const;
   size_t ShardsCount() const;
+  bool IsInClusterMode() const;
+  // Redis Cluster hash slot of the key, see
+  // https://redis.io/docs/reference/cluster-spec/#key-distribution-model
+  static size_t HashSlot(const std::string& key);
   void CheckShardIdx(size_t shard_idx) const;
   static void CheckShardIdx(size_t shard_idx, size_t shard_count);
 
@@ -115,6 +123,16 @@ class Sentinel {
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  /// Client-side throttling of each shard, the throttled requests fail with
+  /// the REDIS_ERR_NOT_READY status
+  void SetClientThrottlerSettings(
+      const congestion_control::ClientThrottlerSettings& settings);
+
+  /// `SCRIPT LOAD`s the Lua script into every master and replica of each
+  /// shard, both now and on each (re)connection, e.g. after a failover.
+  /// The new connections are not ready until the scripts are loaded.
+  void RegisterScript(std::string script);
+
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(size_t shard)> signal_instances_changed;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -20,6 +20,7 @@ namespace storages::redis {
 
 template <ScanTag scan_tag>
 class RequestScanData;
+class RequestScanAllShardsData;
 
 template <typename Result, typename ReplyType = Result>
 class USERVER_NODISCARD Request final {
@@ -46,6 +47,8 @@ class USERVER_NODISCARD Request final {
   template <ScanTag scan_tag>
   friend class RequestScanData;
 
+  friend class RequestScanAllShardsData;
+
  private:
   ReplyPtr GetRaw() { return impl_->GetRaw(); }
 
@@ -75,6 +78,11 @@ class ScanRequest final {
     impl_->SetRequestDescription(std::move(request_description));
   }
 
+  /// @brief Returns the next keys in the order the SCAN replies arrive,
+  /// usually a whole reply at once. Returns an empty vector after the last
+  /// keys.
+  std::vector<ReplyElem> GetBatch() { return impl_->GetBatch(); }
+
   class Iterator {
    public:
     using iterator_category = std::input_iterator_tag;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <userver/storages/redis/reply_fwd.hpp>
 #include <userver/storages/redis/reply_types.hpp>
@@ -46,6 +47,13 @@ class RequestScanDataBase {
 
   virtual bool Eof() = 0;
 
+  // Returns the rest of the keys of the current SCAN reply, empty on eof
+  virtual std::vector<ReplyElem> GetBatch() {
+    std::vector<ReplyElem> batch;
+    if (!Eof()) batch.push_back(Get());
+    return batch;
+  }
+
  protected:
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   std::string request_description_;
@@ -0,0 +1,33 @@
+#pragma once
+
+/// @file userver/storages/redis/script.hpp
+/// @brief @copybrief storages::redis::Script
+
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// @brief Lua script for storages::redis::Client::RegisterScript and
+/// storages::redis::Client::EvalSha.
+///
+/// The SHA1 of the body is calculated once on construction, so the script is
+/// usually constructed once, e.g. as a member of a component.
+class Script final {
+ public:
+  explicit Script(std::string body);
+
+  const std::string& GetBody() const { return body_; }
+
+  /// Hex encoded SHA1 of the body, the same as `SCRIPT LOAD` returns
+  const std::string& GetSha1() const { return sha1_; }
+
+ private:
+  std::string body_;
+  std::string sha1_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
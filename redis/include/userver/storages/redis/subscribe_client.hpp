@@ -55,6 +55,22 @@ class SubscribeClient {
                                SubscriptionToken::OnPmessageCb on_pmessage_cb) {
     return Psubscribe(std::move(pattern), std::move(on_pmessage_cb), {});
   }
+
+  /// @brief Like Subscribe(), but passes all the messages received by the time
+  /// the callback is invoked, up to `batch_settings.max_size`, to one
+  /// callback invocation. Saves the per-message scheduling on the high-rate
+  /// channels.
+  virtual SubscriptionToken SubscribeBatched(
+      std::string channel, SubscriptionToken::OnMessagesCb on_messages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control) = 0;
+
+  /// @brief Like Psubscribe(), but passes the messages in batches, see
+  /// SubscribeBatched()
+  virtual SubscriptionToken PsubscribeBatched(
+      std::string pattern, SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control) = 0;
 };
 
 }  // namespace storages::redis
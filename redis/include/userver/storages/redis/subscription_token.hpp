@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -28,6 +31,22 @@ class SubscriptionTokenImplBase {
   virtual void Unsubscribe() = 0;
 };
 
+/// Settings of the batched delivery of the messages, see
+/// SubscribeClient::SubscribeBatched
+struct SubscriptionBatchSettings {
+  /// Maximum number of messages passed to one callback invocation
+  std::size_t max_size{1000};
+  /// How long to wait for more messages after the first message of a batch,
+  /// zero to pass only the messages that are already received
+  std::chrono::milliseconds max_latency{0};
+};
+
+/// Message received by a pattern subscription
+struct PatternMessage {
+  std::string channel;
+  std::string message;
+};
+
 class SubscriptionToken {
  public:
   using OnMessageCb = std::function<void(const std::string& channel,
@@ -35,6 +54,11 @@ class SubscriptionToken {
   using OnPmessageCb =
       std::function<void(const std::string& pattern, const std::string& channel,
                          const std::string& message)>;
+  using OnMessagesCb = std::function<void(
+      const std::string& channel, const std::vector<std::string>& messages)>;
+  using OnPmessagesCb =
+      std::function<void(const std::string& pattern,
+                         const std::vector<PatternMessage>& messages)>;
 
   SubscriptionToken();
   SubscriptionToken(SubscriptionToken&&) noexcept;
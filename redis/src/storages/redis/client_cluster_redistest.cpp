@@ -1,6 +1,8 @@
 #include <userver/utest/utest.hpp>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/sleep.hpp>
@@ -137,8 +139,12 @@ UTEST(ClientCluster, DISABLED_MgetCrossSlot) {
   }
 
   {
+    // keys of different slots are requested separately
     auto req = client->Mget({MakeKey(idx[0]), MakeKey(idx[1])}, kDefaultCc);
-    UASSERT_THROW(req.Get(), redis::ParseReplyException);
+    auto reply = req.Get();
+    ASSERT_EQ(reply.size(), 2);
+    EXPECT_EQ(reply[0], std::to_string(add + idx[0]));
+    EXPECT_EQ(reply[1], std::to_string(add + idx[1]));
   }
 
   for (unsigned long i : idx) {
@@ -147,6 +153,34 @@ UTEST(ClientCluster, DISABLED_MgetCrossSlot) {
   }
 }
 
+UTEST(ClientCluster, DISABLED_MultiKeyCrossShard) {
+  auto client = GetClient();
+
+  const size_t kNumKeys = 10;
+
+  std::vector<std::string> keys;
+  std::vector<std::pair<std::string, std::string>> key_values;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    keys.push_back(MakeKey(i));
+    key_values.emplace_back(MakeKey(i), std::to_string(i));
+  }
+
+  UASSERT_NO_THROW(client->Mset(key_values, kDefaultCc).Get());
+
+  auto mget_keys = keys;
+  mget_keys.push_back("missing_key");
+  const auto values = client->Mget(mget_keys, kDefaultCc).Get();
+  ASSERT_EQ(values.size(), kNumKeys + 1);
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    EXPECT_EQ(values[i], std::to_string(i));
+  }
+  EXPECT_EQ(values.back(), std::nullopt);
+
+  EXPECT_EQ(client->Exists(mget_keys, kDefaultCc).Get(), kNumKeys);
+  EXPECT_EQ(client->Del(mget_keys, kDefaultCc).Get(), kNumKeys);
+  EXPECT_EQ(client->Exists(keys, kDefaultCc).Get(), 0);
+}
+
 UTEST(ClientCluster, DISABLED_Transaction) {
   auto client = GetClient();
   auto transaction = client->Multi();
@@ -259,6 +293,38 @@ UTEST(ClientCluster, DISABLED_Subscribe) {
   EXPECT_EQ(msg_counter, 3);
 }
 
+UTEST(ClientCluster, DISABLED_SubscribeBatched) {
+  auto client = GetClient();
+  auto subscribe_client = GetSubscribeClient();
+
+  const std::string kChannel = "channel_batched";
+  constexpr size_t kMessagesCount = 10;
+  size_t msg_counter = 0;
+  size_t batch_counter = 0;
+  const auto waiting_time = std::chrono::milliseconds(50);
+
+  storages::redis::SubscriptionBatchSettings batch_settings;
+  batch_settings.max_size = 100;
+  batch_settings.max_latency = std::chrono::milliseconds(20);
+  auto token = subscribe_client->SubscribeBatched(
+      kChannel,
+      [&](const std::string& channel,
+          const std::vector<std::string>& messages) {
+        EXPECT_EQ(channel, kChannel);
+        msg_counter += messages.size();
+        ++batch_counter;
+      },
+      batch_settings, {});
+  engine::SleepFor(waiting_time);
+
+  for (size_t i = 0; i < kMessagesCount; ++i)
+    client->Publish(kChannel, std::to_string(i), kDefaultCc);
+  engine::SleepFor(waiting_time);
+
+  EXPECT_EQ(msg_counter, kMessagesCount);
+  EXPECT_LT(batch_counter, kMessagesCount);
+}
+
 // for manual testing of CLUSTER FAILOVER
 UTEST(ClientCluster, DISABLED_LongWork) {
   const auto kTestTime = std::chrono::seconds(30);
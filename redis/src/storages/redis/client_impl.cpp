@@ -1,5 +1,9 @@
 #include "client_impl.hpp"
 
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+
 #include <userver/storages/redis/impl/sentinel.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -31,6 +35,43 @@ void DoCheckShard(size_t shard, std::optional<size_t> force_shard_idx) {
         ')');
 }
 
+const std::string& GetKey(const std::string& key) { return key; }
+
+const std::string& GetKey(const std::pair<std::string, std::string>& kv) {
+  return kv.first;
+}
+
+// Redis Cluster rejects multi-key commands with keys from different hash
+// slots. Returns the indices of `args` grouped by the hash slots of their keys
+// or a single group if the args may be sent in one command.
+template <typename T>
+std::vector<std::vector<size_t>> GroupBySlot(
+    const USERVER_NAMESPACE::redis::Sentinel& sentinel,
+    const std::vector<T>& args) {
+  if (!sentinel.IsInClusterMode() || args.size() < 2) return {{}};
+
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<size_t, size_t> slot_to_group;
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto slot =
+        USERVER_NAMESPACE::redis::Sentinel::HashSlot(GetKey(args[i]));
+    const auto [it, inserted] = slot_to_group.emplace(slot, groups.size());
+    if (inserted) groups.emplace_back();
+    groups[it->second].push_back(i);
+  }
+  if (groups.size() == 1) return {{}};
+  return groups;
+}
+
+template <typename T>
+std::vector<T> TakeGroup(std::vector<T>& args,
+                         const std::vector<size_t>& group) {
+  std::vector<T> result;
+  result.reserve(group.size());
+  for (const auto idx : group) result.push_back(std::move(args[idx]));
+  return result;
+}
+
 }  // namespace
 
 ClientImpl::ClientImpl(
@@ -111,6 +152,11 @@ RequestDel ClientImpl::Del(std::vector<std::string> keys,
                            const CommandControl& command_control) {
   if (keys.empty())
     return CreateDummyRequest<RequestDel>(std::make_shared<Reply>("del", 0));
+  auto slot_groups = GroupBySlot(*redis_client_, keys);
+  if (slot_groups.size() > 1) {
+    return CreateAggregateRequest<RequestDel>(MakeRequestsBySlot(
+        "del", std::move(keys), slot_groups, true, command_control));
+  }
   auto shard = ShardByKey(keys.at(0), command_control);
   return CreateRequest<RequestDel>(
       MakeRequest(CmdArgs{"del", std::move(keys)}, shard, true,
@@ -148,6 +194,10 @@ RequestScriptLoad ClientImpl::ScriptLoad(
                   GetCommandControl(command_control)));
 }
 
+void ClientImpl::RegisterScript(const Script& script) {
+  redis_client_->RegisterScript(script.GetBody());
+}
+
 RequestExists ClientImpl::Exists(std::string key,
                                  const CommandControl& command_control) {
   auto shard = ShardByKey(key, command_control);
@@ -161,6 +211,11 @@ RequestExists ClientImpl::Exists(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestExists>(
         std::make_shared<Reply>("exists", 0));
+  auto slot_groups = GroupBySlot(*redis_client_, keys);
+  if (slot_groups.size() > 1) {
+    return CreateAggregateRequest<RequestExists>(MakeRequestsBySlot(
+        "exists", std::move(keys), slot_groups, false, command_control));
+  }
   auto shard = ShardByKey(keys.at(0), command_control);
   return CreateRequest<RequestExists>(
       MakeRequest(CmdArgs{"exists", std::move(keys)}, shard, false,
@@ -447,6 +502,19 @@ RequestMget ClientImpl::Mget(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestMget>(
         std::make_shared<Reply>("mget", ReplyData::Array{}));
+  auto slot_groups = GroupBySlot(*redis_client_, keys);
+  if (slot_groups.size() > 1) {
+    std::vector<size_t> positions;
+    positions.reserve(keys.size());
+    for (const auto& group : slot_groups) {
+      positions.insert(positions.end(), group.begin(), group.end());
+    }
+    return CreateAggregateRequest<RequestMget>(
+        MakeRequestsBySlot("mget", std::move(keys), slot_groups, false,
+                           command_control),
+        std::move(positions));
+  }
+
   const auto shard = ShardByKey(keys.at(0), command_control);
   const auto max_chunk_size =
       command_control.chunk_size ? command_control.chunk_size : keys.size();
@@ -469,6 +537,12 @@ RequestMset ClientImpl::Mset(
     return CreateDummyRequest<RequestMset>(
         std::make_shared<USERVER_NAMESPACE::redis::Reply>(
             "mset", USERVER_NAMESPACE::redis::ReplyData::CreateStatus("OK")));
+  auto slot_groups = GroupBySlot(*redis_client_, key_values);
+  if (slot_groups.size() > 1) {
+    return CreateAggregateRequest<RequestMset>(
+        MakeRequestsBySlot("mset", std::move(key_values), slot_groups, true,
+                           command_control));
+  }
   auto shard = ShardByKey(key_values.at(0).first, command_control);
   return CreateRequest<RequestMset>(
       MakeRequest(CmdArgs{"mset", std::move(key_values)}, shard, true,
@@ -596,6 +670,25 @@ ScanRequest<ScanTag::kScan> ClientImpl::Scan(
           shared_from_this(), shard, std::move(options), command_control));
 }
 
+ScanRequest<ScanTag::kScan> ClientImpl::ScanAllShards(
+    ScanOptions options, size_t max_parallel_shards,
+    const CommandControl& command_control) {
+  std::vector<size_t> shards;
+  const auto forced_shard = command_control.force_shard_idx
+                                ? command_control.force_shard_idx
+                                : force_shard_idx_;
+  if (forced_shard) {
+    CheckShard(*forced_shard, command_control);
+    shards.push_back(*forced_shard);
+  } else {
+    shards.resize(ShardsCount());
+    std::iota(shards.begin(), shards.end(), 0);
+  }
+  return ScanRequest<ScanTag::kScan>(std::make_unique<RequestScanAllShardsData>(
+      shared_from_this(), std::move(shards), std::move(options),
+      max_parallel_shards, command_control));
+}
+
 template <ScanTag scan_tag>
 ScanRequest<scan_tag> ClientImpl::ScanTmpl(
     std::string key, ScanOptionsTmpl<scan_tag> options,
@@ -1018,6 +1111,29 @@ size_t ClientImpl::GetPublishShard(PubShard policy) {
   return 0;
 }
 
+template <typename T>
+std::vector<USERVER_NAMESPACE::redis::Request> ClientImpl::MakeRequestsBySlot(
+    const std::string& command, std::vector<T>&& args,
+    const std::vector<std::vector<size_t>>& slot_groups, bool master,
+    const CommandControl& command_control) {
+  const auto cc = GetCommandControl(command_control);
+  std::vector<USERVER_NAMESPACE::redis::Request> requests;
+  for (const auto& group : slot_groups) {
+    auto group_args = TakeGroup(args, group);
+    const auto shard = ShardByKey(GetKey(group_args.front()), command_control);
+    const auto max_chunk_size = command_control.chunk_size
+                                    ? command_control.chunk_size
+                                    : group_args.size();
+    auto chunks = MakeRequestChunks(
+        max_chunk_size, std::move(group_args), [&](auto chunk) {
+          return MakeRequest(CmdArgs{command, std::move(chunk)}, shard, master,
+                             cc);
+        });
+    std::move(chunks.begin(), chunks.end(), std::back_inserter(requests));
+  }
+  return requests;
+}
+
 size_t ClientImpl::ShardByKey(const std::string& key,
                               const CommandControl& cc) const {
   if (force_shard_idx_) {
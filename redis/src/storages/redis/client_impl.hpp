@@ -79,6 +79,8 @@ class ClientImpl final : public Client,
   RequestScriptLoad ScriptLoad(std::string script, size_t shard,
                                const CommandControl& command_control) override;
 
+  void RegisterScript(const Script& script) override;
+
   RequestExists Exists(std::string key,
                        const CommandControl& command_control) override;
 
@@ -237,6 +239,10 @@ class ClientImpl final : public Client,
       size_t shard, ScanOptions options,
       const CommandControl& command_control) override;
 
+  ScanRequest<ScanTag::kScan> ScanAllShards(
+      ScanOptions options, size_t max_parallel_shards,
+      const CommandControl& command_control) override;
+
   template <ScanTag scan_tag>
   ScanRequest<scan_tag> ScanTmpl(std::string key,
                                  ScanOptionsTmpl<scan_tag> options,
@@ -429,6 +435,14 @@ class ClientImpl final : public Client,
     return requests;
   }
 
+  // Makes a request per hash slot of the keys, splits them into
+  // CommandControl::chunk_size chunks if needed
+  template <typename T>
+  std::vector<USERVER_NAMESPACE::redis::Request> MakeRequestsBySlot(
+      const std::string& command, std::vector<T>&& args,
+      const std::vector<std::vector<size_t>>& slot_groups, bool master,
+      const CommandControl& command_control);
+
   CommandControl GetCommandControl(const CommandControl& cc) const;
 
   size_t GetPublishShard(PubShard policy);
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include <userver/engine/task/cancel.hpp>
 
@@ -118,4 +119,50 @@ UTEST(RedisClient, Mget) {
   EXPECT_EQ(*result[1], "bar");
 }
 
+UTEST(RedisClient, ScanAllShards) {
+  auto client = GetClient();
+  constexpr std::size_t kKeysCount = 100;
+  for (std::size_t i = 0; i < kKeysCount; ++i)
+    client->Set("scan_key" + std::to_string(i), "value", {}).Get();
+
+  const storages::redis::ScanOptions options{
+      storages::redis::ScanOptions::Match{"scan_key*"},
+      storages::redis::ScanOptions::Count{10}};
+  auto keys = client->ScanAllShards(options, 4, {})
+                  .GetAll<std::unordered_set<std::string>>();
+  EXPECT_EQ(keys.size(), kKeysCount);
+
+  auto request = client->ScanAllShards(options, 4, {});
+  std::size_t batches = 0;
+  keys.clear();
+  for (auto batch = request.GetBatch(); !batch.empty();
+       batch = request.GetBatch()) {
+    ++batches;
+    keys.insert(batch.begin(), batch.end());
+  }
+  EXPECT_EQ(keys.size(), kKeysCount);
+  EXPECT_GT(batches, 1);
+  EXPECT_TRUE(request.GetBatch().empty());
+}
+
+UTEST(RedisClient, RegisteredScript) {
+  auto client = GetClient();
+  const storages::redis::Script script{
+      "return redis.call('incrby', KEYS[1], ARGV[1])"};
+  client->RegisterScript(script);
+
+  // already connected instances get the script before the next commands
+  EXPECT_EQ(
+      client->EvalSha<int64_t>(script, {"script_counter"}, {"2"}, {}).Get(),
+      2);
+  EXPECT_EQ(
+      client->EvalSha<int64_t>(script, {"script_counter"}, {"3"}, {}).Get(),
+      5);
+  EXPECT_EQ(client->ScriptLoad(script.GetBody(), 0, {}).Get(),
+            script.GetSha1());
+
+  // registering the same script again is a no-op
+  UEXPECT_NO_THROW(client->RegisterScript(script));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,123 @@
+#include <userver/storages/redis/client_side_cache.hpp>
+
+#include <string_view>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+// Notifications are published to `__keyspace@<db>__:<key>` channels
+const std::string kKeyspacePattern = "__keyspace@*__:*";
+constexpr std::string_view kKeyspaceDelimiter = "__:";
+
+}  // namespace
+
+ClientSideCache::ClientSideCache(ClientPtr client,
+                                 SubscribeClient& subscribe_client,
+                                 Settings settings)
+    : client_(std::move(client)),
+      settings_(settings),
+      storage_(settings.max_size) {
+  subscription_ = subscribe_client.Psubscribe(
+      kKeyspacePattern,
+      [this](const std::string&, const std::string& channel,
+             const std::string&) { OnKeyspaceNotification(channel); });
+}
+
+ClientSideCache::~ClientSideCache() { subscription_.Unsubscribe(); }
+
+std::optional<std::string> ClientSideCache::Get(
+    std::string key, const CommandControl& command_control) {
+  return GetOrFetch(key, nullptr, [&] {
+    return client_->Get(key, command_control).Get();
+  });
+}
+
+std::optional<std::string> ClientSideCache::Hget(
+    std::string key, std::string field, const CommandControl& command_control) {
+  return GetOrFetch(key, &field, [&] {
+    return client_->Hget(key, field, command_control).Get();
+  });
+}
+
+template <typename Fetch>
+std::optional<std::string> ClientSideCache::GetOrFetch(const std::string& key,
+                                                       const std::string* field,
+                                                       Fetch&& fetch) {
+  const auto get_entry = [&key, field](Storage& storage) -> Entry* {
+    auto* key_entry = storage.Get(key);
+    if (!key_entry) return nullptr;
+    if (!field) return key_entry->value ? &*key_entry->value : nullptr;
+    const auto it = key_entry->fields.find(*field);
+    return it == key_entry->fields.end() ? nullptr : &it->second;
+  };
+
+  const auto fill_token = ++last_fill_token_;
+  {
+    auto storage = storage_.Lock();
+    auto* entry = get_entry(*storage);
+    if (entry && !entry->fill_token && Clock::now() < entry->expires_at) {
+      ++hits_;
+      return entry->value;
+    }
+
+    // Mark the entry as being fetched, so that an invalidation arriving
+    // before the reply prevents caching of an outdated value
+    auto* key_entry = storage->Get(key);
+    if (!key_entry) key_entry = storage->Emplace(key);
+    auto& new_entry = field ? key_entry->fields[*field]
+                            : key_entry->value.emplace();
+    new_entry.fill_token = fill_token;
+  }
+  ++misses_;
+
+  auto value = fetch();
+
+  auto storage = storage_.Lock();
+  auto* entry = get_entry(*storage);
+  if (entry && entry->fill_token == fill_token) {
+    entry->value = value;
+    entry->expires_at = Clock::now() + settings_.ttl;
+    entry->fill_token = 0;
+  }
+  return value;
+}
+
+void ClientSideCache::Invalidate(const std::string& key) {
+  ++invalidations_;
+  auto storage = storage_.Lock();
+  storage->Erase(key);
+}
+
+void ClientSideCache::Clear() {
+  auto storage = storage_.Lock();
+  storage->Clear();
+}
+
+ClientSideCache::Statistics ClientSideCache::GetStatistics() const {
+  Statistics stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.invalidations = invalidations_.load();
+  return stats;
+}
+
+void ClientSideCache::OnKeyspaceNotification(const std::string& channel) {
+  const auto pos = channel.find(kKeyspaceDelimiter);
+  if (pos == std::string::npos) {
+    LOG_LIMITED_WARNING() << "Unexpected keyspace notification channel "
+                          << channel;
+    return;
+  }
+  Invalidate(channel.substr(pos + kKeyspaceDelimiter.size()));
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
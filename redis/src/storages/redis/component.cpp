@@ -94,6 +94,18 @@ formats::json::ValueBuilder InstanceStatisticsToJson(
                   .count()
             : 0;
     result["session-time-ms"] = session_time_ms;
+
+    if (!stats.connections.empty()) {
+      formats::json::ValueBuilder connections(formats::json::Type::kObject);
+      for (size_t i = 0; i < stats.connections.size(); ++i) {
+        connections[std::to_string(i)] = InstanceStatisticsToJson(
+            stats.connections[i], metrics_settings, true);
+      }
+      utils::statistics::SolomonChildrenAreLabelValues(connections,
+                                                       "redis_connection");
+      utils::statistics::SolomonSkip(connections);
+      result["connections"] = connections;
+    }
   }
 
   return result;
@@ -126,6 +138,7 @@ formats::json::ValueBuilder ShardStatisticsToJson(
           std::chrono::steady_clock::now() - shard_stats.last_ready_time)
           .count();
   result["not_ready_ms"] = shard_stats.is_ready ? 0 : not_ready;
+  result["throttled"] = shard_stats.throttled;
   return result;
 }
 
@@ -244,6 +257,8 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  double throttling_accepts_multiplier{0};
+  size_t connections_per_instance{1};
 };
 
 RedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -254,6 +269,12 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  config.throttling_accepts_multiplier =
+      value["throttling_accepts_multiplier"].As<double>(
+          config.throttling_accepts_multiplier);
+  config.connections_per_instance =
+      value["connections_per_instance"].As<size_t>(
+          config.connections_per_instance);
   return config;
 }
 
@@ -364,8 +385,10 @@ void Redis::Connect(const ComponentConfig& config,
     auto sentinel = redis::Sentinel::CreateSentinel(
         thread_pools_, settings, redis_group.config_name, redis_group.db,
         redis::KeyShardFactory{redis_group.sharding_strategy}, command_control,
-        testsuite_redis_control);
+        testsuite_redis_control, redis_group.connections_per_instance);
     if (sentinel) {
+      sentinel->SetClientThrottlerSettings(
+          {redis_group.throttling_accepts_multiplier});
       sentinels_.emplace(redis_group.db, sentinel);
       const auto& client =
           std::make_shared<storages::redis::ClientImpl>(sentinel);
@@ -525,6 +548,14 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                throttling_accepts_multiplier:
+                    type: number
+                    description: reject the requests to a shard locally once they outnumber the requests served by it during the last 2 minutes by this factor, 0 disables the throttling
+                    defaultDescription: 0
+                connections_per_instance:
+                    type: integer
+                    description: connections to open to each redis instance, the commands with the same key are sent over the same connection
+                    defaultDescription: 1
     subscribe_groups:
         type: array
         description: array of redis clusters to work with in subscribe mode
@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <storages/redis/client_impl.hpp>
+#include <storages/redis/redis_secdist.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/storages/redis/impl/sentinel.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+#include <utils/gbench_latency.hpp>
+
+// Benchmarks of the driver against a real database, they are skipped unless
+// the kSentinelPort environment variable is set
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr const char* kSentinelPort = "REDIS_SENTINEL_PORT_BENCH";
+constexpr std::size_t kWorkerThreads = 4;
+constexpr std::size_t kValueSize = 256;
+
+constexpr std::string_view kRedisSettingsJsonFormat = R"({{
+  "redis_settings": {{
+    "bench": {{
+        "password": "",
+        "sentinels": [{{"host": "localhost", "port": {}}}],
+        "shards": [{{"name": "test_master0"}}]
+    }}
+  }}
+}})";
+
+using namespace utils::gbench;
+
+std::shared_ptr<redis::Sentinel> MakeSentinel(
+    const std::shared_ptr<redis::ThreadPools>& thread_pools,
+    const secdist::RedisSettings& settings) {
+  auto sentinel = redis::Sentinel::CreateSentinel(
+      thread_pools, settings, "none", "bench", redis::KeyShardFactory{""});
+  sentinel->WaitConnectedDebug();
+  return sentinel;
+}
+
+// Runs the payload with a client of the kSentinelPort database, which is
+// flushed before and afterwards
+void RunWithClient(
+    benchmark::State& state,
+    std::function<void(storages::redis::Client&, const secdist::RedisSettings&)>
+        payload) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const auto* sentinel_port = std::getenv(kSentinelPort);
+    if (!sentinel_port) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+
+    const storages::secdist::RedisMapSettings settings_map{
+        formats::json::FromString(
+            fmt::format(kRedisSettingsJsonFormat, sentinel_port))};
+    const auto& settings = settings_map.GetSettings("bench");
+
+    auto thread_pools = std::make_shared<redis::ThreadPools>(
+        redis::kDefaultSentinelThreadPoolSize,
+        redis::kDefaultRedisThreadPoolSize);
+    auto sentinel = MakeSentinel(thread_pools, settings);
+    sentinel->MakeRequest({"FLUSHDB"}, "none").Get();
+
+    auto client = std::make_shared<storages::redis::ClientImpl>(sentinel);
+    payload(*client, settings);
+
+    sentinel->MakeRequest({"FLUSHDB"}, "none").Get();
+  });
+}
+
+}  // namespace
+
+// Round trips of a single GET
+void redis_get_latency(benchmark::State& state) {
+  RunWithClient(state, [&state](storages::redis::Client& client,
+                                const secdist::RedisSettings&) {
+    client.Set("key", std::string(kValueSize, 'a'), {}).Get();
+
+    LatencyPercentile latency;
+    for (auto _ : state) {
+      const auto start = std::chrono::steady_clock::now();
+      auto value = client.Get("key", {}).Get();
+      benchmark::DoNotOptimize(value);
+      Account(latency, start);
+    }
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(redis_get_latency)->UseRealTime();
+
+// state.range(0) GETs awaited one by one or, if state.range(1) is set, sent
+// at once and pipelined by the connection
+void redis_get_throughput(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const bool is_pipelined = state.range(1);
+
+  RunWithClient(state, [&](storages::redis::Client& client,
+                           const secdist::RedisSettings&) {
+    client.Set("key", std::string(kValueSize, 'a'), {}).Get();
+
+    std::vector<storages::redis::RequestGet> requests;
+    requests.reserve(count);
+    for (auto _ : state) {
+      if (is_pipelined) {
+        for (std::size_t i = 0; i < count; ++i) {
+          requests.push_back(client.Get("key", {}));
+        }
+        for (auto& request : requests) {
+          benchmark::DoNotOptimize(request.Get());
+        }
+        requests.clear();
+      } else {
+        for (std::size_t i = 0; i < count; ++i) {
+          benchmark::DoNotOptimize(client.Get("key", {}).Get());
+        }
+      }
+    }
+    ReportRate(state, "requests",
+               static_cast<double>(state.iterations() * count));
+  });
+}
+BENCHMARK(redis_get_throughput)
+    ->ArgsProduct({{1, 16, 256}, {0, 1}})
+    ->ArgNames({"requests", "pipelined"})
+    ->UseRealTime();
+
+// Fetching and parsing of an MGET of state.range(0) values
+void redis_mget_decode(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+
+  RunWithClient(state, [&](storages::redis::Client& client,
+                           const secdist::RedisSettings&) {
+    std::vector<std::pair<std::string, std::string>> key_values;
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < count; ++i) {
+      keys.push_back(fmt::format("{{mget}}key-{}", i));
+      key_values.emplace_back(keys.back(), std::string(kValueSize, 'a'));
+    }
+    client.Mset(std::move(key_values), {}).Get();
+
+    for (auto _ : state) {
+      auto values = client.Mget(keys, {}).Get();
+      benchmark::DoNotOptimize(values);
+    }
+    ReportRate(state, "values",
+               static_cast<double>(state.iterations() * count));
+  });
+}
+BENCHMARK(redis_mget_decode)->Range(1, 10'000)->UseRealTime();
+
+// Fetching and parsing of an HGETALL of a hash of state.range(0) fields
+void redis_hgetall_decode(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+
+  RunWithClient(state, [&](storages::redis::Client& client,
+                           const secdist::RedisSettings&) {
+    std::vector<std::pair<std::string, std::string>> field_values;
+    for (std::size_t i = 0; i < count; ++i) {
+      field_values.emplace_back(fmt::format("field-{}", i),
+                                std::string(kValueSize, 'a'));
+    }
+    client.Hmset("hash", std::move(field_values), {}).Get();
+
+    for (auto _ : state) {
+      auto values = client.Hgetall("hash", {}).Get();
+      benchmark::DoNotOptimize(values);
+    }
+    ReportRate(state, "fields",
+               static_cast<double>(state.iterations() * count));
+  });
+}
+BENCHMARK(redis_hgetall_decode)->Range(1, 10'000)->UseRealTime();
+
+// Connection establishment, from the sentinel discovery to a connected master
+void redis_connect(benchmark::State& state) {
+  RunWithClient(state, [&state](storages::redis::Client&,
+                                const secdist::RedisSettings& settings) {
+    auto thread_pools = std::make_shared<redis::ThreadPools>(
+        redis::kDefaultSentinelThreadPoolSize,
+        redis::kDefaultRedisThreadPoolSize);
+
+    LatencyPercentile latency;
+    for (auto _ : state) {
+      const auto start = std::chrono::steady_clock::now();
+      auto sentinel = MakeSentinel(thread_pools, settings);
+      Account(latency, start);
+
+      state.PauseTiming();
+      sentinel.reset();
+      state.ResumeTiming();
+    }
+    ReportLatency(state, latency);
+  });
+}
+BENCHMARK(redis_connect)->UseRealTime();
+
+USERVER_NAMESPACE_END
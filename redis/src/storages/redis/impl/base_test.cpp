@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Strategy = redis::CommandControl::Strategy;
+
+TEST(CommandControl, StrategyFromString) {
+  EXPECT_EQ(redis::StrategyFromString("default"), Strategy::kDefault);
+  EXPECT_EQ(redis::StrategyFromString("every_dc"), Strategy::kEveryDc);
+  EXPECT_EQ(redis::StrategyFromString("local_dc_conductor"),
+            Strategy::kLocalDcConductor);
+  EXPECT_EQ(redis::StrategyFromString("nearest_server_ping"),
+            Strategy::kNearestServerPing);
+  EXPECT_EQ(redis::StrategyFromString("least_latency"),
+            Strategy::kLeastLatency);
+}
+
+TEST(CommandControl, StrategyFromStringUnknown) {
+  UEXPECT_THROW(redis::StrategyFromString("Least_Latency"), std::runtime_error);
+  UEXPECT_THROW(redis::StrategyFromString("least-latency"), std::runtime_error);
+  UEXPECT_THROW(redis::StrategyFromString(""), std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
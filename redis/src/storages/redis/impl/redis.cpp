@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <chrono>
 #include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -23,6 +26,7 @@
 
 #include <storages/redis/impl/command.hpp>
 #include <storages/redis/impl/ev_wrapper.hpp>
+#include <storages/redis/impl/script_registry.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
 #include <userver/storages/redis/impl/redis_stats.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
@@ -34,6 +38,8 @@ namespace {
 
 const auto kPingLatencyExp = 0.7;
 const auto kInitialPingLatencyMs = 1000;
+// replies are much more frequent than pings, smooth them stronger
+const auto kReplyLatencyExp = 0.9;
 const size_t kMissedPingStreakThresholdDefault = 3;
 
 // channel is used for periodic subscribe/unsubscribe to calculate actual RTT
@@ -78,6 +84,35 @@ inline bool IsExecCommand(const CmdArgs::CmdArgsArray& args) {
   return AreStringsEqualIgnoreCase(args[0], exec_command);
 }
 
+// Commands that can be merged into a single multi-key command
+enum class MergeableCommand { kNone, kGet, kSet };
+
+MergeableCommand GetMergeableCommand(const CommandPtr& command) {
+  if (command->asking || command->args.args.size() != 1) {
+    return MergeableCommand::kNone;
+  }
+  const auto& args = command->args.args.front();
+  // SET with options (EX, NX, GET...) has no MSET counterpart
+  if (args.size() == 2 && command->GetName() == "get") {
+    return MergeableCommand::kGet;
+  }
+  if (args.size() == 3 && command->GetName() == "set") {
+    return MergeableCommand::kSet;
+  }
+  return MergeableCommand::kNone;
+}
+
+constexpr size_t kKeyBucketsCount = 4096;
+
+// The first argument of the first command that has arguments, e.g. the key of
+// GET or the first key of a transaction
+const std::string* GetCommandKey(const CmdArgs& args) {
+  for (const auto& command_args : args.args) {
+    if (command_args.size() > 1) return &command_args[1];
+  }
+  return nullptr;
+}
+
 bool IsFinalState(Redis::State state) {
   return state == Redis::State::kDisconnected ||
          state == Redis::State::kDisconnectError;
@@ -91,6 +126,37 @@ bool IsUnsubscribeReply(const ReplyPtr& reply) {
          !strcasecmp(reply_array[0].GetString().c_str(), "PUNSUBSCRIBE");
 }
 
+// hiredis frees a reply right after the reply callback returns. The callback
+// adopts the reply instead, so that ReplyData may reference the reply strings
+// without copying them.
+thread_local const void* adopted_reply = nullptr;
+
+void FreeReplyObjectIfNotAdopted(void* reply) {
+  if (reply == adopted_reply) {
+    adopted_reply = nullptr;
+    return;
+  }
+  freeReplyObject(reply);
+}
+
+redisReplyObjectFunctions* GetAdoptingReplyFunctions(
+    const redisReplyObjectFunctions& defaults) {
+  static redisReplyObjectFunctions functions = [&defaults] {
+    auto result = defaults;
+    result.freeObject = &FreeReplyObjectIfNotAdopted;
+    return result;
+  }();
+  return &functions;
+}
+
+std::shared_ptr<const redisReply> AdoptReply(redisReply* reply) {
+  UASSERT(!adopted_reply);
+  adopted_reply = reply;
+  return {reply, [](const redisReply* reply) {
+            freeReplyObject(const_cast<redisReply*>(reply));
+          }};
+}
+
 #ifdef USERVER_FEATURE_REDIS_TLS
 struct SSLContextDeleter final {
   void operator()(redisSSLContext* ptr) const noexcept {
@@ -108,7 +174,8 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
 
   RedisImpl(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
             const engine::ev::ThreadControl& thread_control, Redis& redis_obj,
-            bool send_readonly, ConnectionSecurity connection_security);
+            bool send_readonly, ConnectionSecurity connection_security,
+            ServerId server_id);
   ~RedisImpl();
 
   void Connect(const std::string& host, int port, const Password& password);
@@ -127,8 +194,15 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   std::chrono::milliseconds GetPingLatency() const {
     return std::chrono::milliseconds(ping_latency_ms_);
   }
+  std::chrono::microseconds GetReplyLatency() const {
+    return std::chrono::microseconds(
+        static_cast<int64_t>(reply_latency_us_.load()));
+  }
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
+  void SetScriptRegistry(std::shared_ptr<ScriptRegistry> script_registry) {
+    script_registry_ = std::move(script_registry);
+  }
 
   void ResetRedisObj() { redis_obj_ = nullptr; }
 
@@ -156,6 +230,8 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   void OnDisconnectImpl(int status);
   bool InitSecureConnection();
   void InvokeCommand(const CommandPtr& command, ReplyPtr&& reply);
+  void AccountReply(const CommandPtr& command, const ReplyPtr& reply);
+  void DeliverReply(const CommandPtr& command, ReplyPtr&& reply);
   void InvokeCommandError(const CommandPtr& command, const std::string& name,
                           int status);
 
@@ -173,9 +249,15 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
 
   void SetState(State state);
   void ProcessCommand(const CommandPtr& command);
+  void ProcessCommands(std::deque<CommandPtr>& commands, bool merge_get_set);
+  CommandPtr MergeCommands(MergeableCommand type,
+                           std::vector<CommandPtr> commands);
 
   void Authenticate();
   void SendReadOnly();
+  void LoadScripts();
+  CommandPtr PrepareScriptLoad(const std::string& script,
+                               std::function<void()> on_loaded);
   void FreeCommands();
 
   static void LogSocketErrorReply(const CommandPtr& command,
@@ -233,9 +315,12 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   ev_timer watch_command_timer_{};
   ev_async watch_command_{};
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
+  std::shared_ptr<ScriptRegistry> script_registry_;
   std::chrono::milliseconds ping_interval_{2000};
   std::chrono::milliseconds ping_timeout_{4000};
   std::atomic<double> ping_latency_ms_{kInitialPingLatencyMs};
+  // written from the event loop only
+  std::atomic<double> reply_latency_us_{0};
   logging::LogExtra log_extra_;
   const bool send_readonly_;
   const ConnectionSecurity connection_security_;
@@ -273,64 +358,182 @@ const std::string& Redis::StateToString(State state) {
 }
 
 Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
-             bool send_readonly, ConnectionSecurity connection_security)
-    : thread_control_(thread_pool->NextThread()) {
-  thread_control_.RunInEvLoopBlocking([&]() {
-    impl_ = std::make_shared<RedisImpl>(thread_pool, thread_control_, *this,
-                                        send_readonly, connection_security);
-  });
+             bool send_readonly, ConnectionSecurity connection_security,
+             size_t connections_count) {
+  connections_count = std::clamp<size_t>(
+      connections_count, 1, std::numeric_limits<std::uint16_t>::max() - 1);
+  const auto server_id = ServerId::Generate();
+  connections_.reserve(connections_count);
+  for (size_t i = 0; i < connections_count; ++i) {
+    auto& connection =
+        connections_.emplace_back(Connection{thread_pool->NextThread(), {}});
+    connection.thread_control.RunInEvLoopBlocking([&]() {
+      connection.impl = std::make_shared<RedisImpl>(
+          thread_pool, connection.thread_control, *this, send_readonly,
+          connection_security, server_id);
+    });
+  }
+  if (connections_count > 1) {
+    key_buckets_ =
+        std::make_unique<std::atomic<std::uint16_t>[]>(kKeyBucketsCount);
+  }
 }
 
 Redis::~Redis() {
-  thread_control_.RunInEvLoopBlocking([this]() {
-    impl_->Disconnect();
-    impl_->ResetRedisObj();
-    impl_.reset();
-  });
+  // no state changes are signaled while the other connections are destroyed
+  for (auto& connection : connections_) {
+    connection.thread_control.RunInEvLoopBlocking(
+        [&connection]() { connection.impl->ResetRedisObj(); });
+  }
+  for (auto& connection : connections_) {
+    connection.thread_control.RunInEvLoopBlocking([&connection]() {
+      connection.impl->Disconnect();
+      connection.impl.reset();
+    });
+  }
 }
 
 void Redis::Connect(const std::string& host, int port,
                     const Password& password) {
-  impl_->Connect(host, port, password);
+  for (auto& connection : connections_)
+    connection.impl->Connect(host, port, password);
 }
 
 bool Redis::AsyncCommand(const CommandPtr& command) {
-  return impl_->AsyncCommand(command);
+  return SelectConnection(command).AsyncCommand(command);
 }
 
-Redis::State Redis::GetState() const { return impl_->GetState(); }
+Redis::State Redis::GetState() const {
+  if (connections_.size() == 1) return connections_.front().impl->GetState();
 
-const Statistics& Redis::GetStatistics() const {
-  return impl_->GetStatistics();
+  bool all_connected = true;
+  for (const auto& connection : connections_) {
+    const auto state = connection.impl->GetState();
+    if (state == State::kInitError || state == State::kDisconnecting ||
+        IsFinalState(state)) {
+      return state;
+    }
+    if (state != State::kConnected) all_connected = false;
+  }
+  return all_connected ? State::kConnected : State::kInit;
 }
 
-ServerId Redis::GetServerId() const { return impl_->GetServerId(); }
+InstanceStatistics Redis::GetStatistics() const {
+  InstanceStatistics stats(connections_.front().impl->GetStatistics());
+  if (connections_.size() == 1) return stats;
+
+  auto first_connection_stats = stats;
+  stats.connections.reserve(connections_.size());
+  stats.connections.push_back(std::move(first_connection_stats));
+  for (size_t i = 1; i < connections_.size(); ++i) {
+    InstanceStatistics connection_stats(
+        connections_[i].impl->GetStatistics());
+    stats.Add(connection_stats);
+    stats.connections.push_back(std::move(connection_stats));
+  }
+  stats.state = GetState();
+  return stats;
+}
 
-size_t Redis::GetRunningCommands() const { return impl_->GetRunningCommands(); }
+ServerId Redis::GetServerId() const {
+  return connections_.front().impl->GetServerId();
+}
+
+size_t Redis::GetRunningCommands() const {
+  size_t running_commands = 0;
+  for (const auto& connection : connections_)
+    running_commands += connection.impl->GetRunningCommands();
+  return running_commands;
+}
 
 std::chrono::milliseconds Redis::GetPingLatency() const {
-  return impl_->GetPingLatency();
+  std::chrono::milliseconds latency{0};
+  for (const auto& connection : connections_)
+    latency += connection.impl->GetPingLatency();
+  return latency / connections_.size();
 }
 
-bool Redis::IsDestroying() const { return impl_->IsDestroying(); }
+std::chrono::microseconds Redis::GetReplyLatency() const {
+  std::chrono::microseconds latency{0};
+  for (const auto& connection : connections_)
+    latency += connection.impl->GetReplyLatency();
+  return latency / connections_.size();
+}
+
+bool Redis::IsDestroying() const {
+  return connections_.front().impl->IsDestroying();
+}
 
-std::string Redis::GetServerHost() const { return impl_->GetHost(); }
+std::string Redis::GetServerHost() const {
+  return connections_.front().impl->GetHost();
+}
 
 void Redis::SetCommandsBufferingSettings(
     CommandsBufferingSettings commands_buffering_settings) {
-  impl_->SetCommandsBufferingSettings(commands_buffering_settings);
+  for (auto& connection : connections_)
+    connection.impl->SetCommandsBufferingSettings(commands_buffering_settings);
+}
+
+void Redis::SetScriptRegistry(std::shared_ptr<ScriptRegistry> script_registry) {
+  for (auto& connection : connections_)
+    connection.impl->SetScriptRegistry(script_registry);
+}
+
+Redis::RedisImpl& Redis::SelectConnection(const CommandPtr& command) {
+  if (connections_.size() == 1) return *connections_.front().impl;
+
+  const auto least_pending = [this] {
+    size_t best = 0;
+    size_t best_running = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < connections_.size(); ++i) {
+      const auto& impl = *connections_[i].impl;
+      if (impl.GetState() != State::kConnected) continue;
+      const auto running = impl.GetRunningCommands();
+      if (running < best_running) {
+        best = i;
+        best_running = running;
+      }
+    }
+    return best;
+  };
+
+  const auto* key = GetCommandKey(command->args);
+  if (!key) return *connections_[least_pending()].impl;
+
+  // The commands with the same key go to the same connection to keep their
+  // order, the bucket is assigned to the least loaded connection on first use
+  auto& bucket =
+      key_buckets_[std::hash<std::string>{}(*key) % kKeyBucketsCount];
+  auto index = bucket.load(std::memory_order_relaxed);
+  if (index == 0) {
+    const auto assigned = static_cast<std::uint16_t>(least_pending() + 1);
+    if (bucket.compare_exchange_strong(index, assigned,
+                                       std::memory_order_relaxed)) {
+      index = assigned;
+    }
+  }
+  return *connections_[index - 1].impl;
+}
+
+void Redis::OnConnectionStateChange() {
+  std::lock_guard lock(state_mutex_);
+  const auto state = GetState();
+  if (state == last_signaled_state_) return;
+  last_signaled_state_ = state;
+  signal_state_change(state);
 }
 
 Redis::RedisImpl::RedisImpl(
     const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
     const engine::ev::ThreadControl& thread_control, Redis& redis_obj,
-    bool send_readonly, ConnectionSecurity connection_security)
+    bool send_readonly, ConnectionSecurity connection_security,
+    ServerId server_id)
     : redis_obj_(&redis_obj),
       ev_thread_control_(thread_control),
       thread_pool_(thread_pool),
       send_readonly_(send_readonly),
       connection_security_(connection_security),
-      server_id_(ServerId::Generate()) {
+      server_id_(server_id) {
   SetCommandsBufferingSettings(CommandsBufferingSettings{});
   LOG_DEBUG() << "RedisImpl() server_id=" << GetServerId().GetId();
 }
@@ -400,6 +603,8 @@ void Redis::RedisImpl::Connect(const std::string& host, int port,
     context_ = nullptr;
     SetState(State::kInitError);
   } else {
+    context_->c.reader->fn =
+        GetAdoptingReplyFunctions(*context_->c.reader->fn);
     ev_thread_control_.RunInEvLoopBlocking([this]() {
       bool err = false;
       auto CheckError = [&err](int status, const std::string& name) {
@@ -453,8 +658,24 @@ void Redis::RedisImpl::DoDisconnect() {
 void Redis::RedisImpl::InvokeCommand(const CommandPtr& command,
                                      ReplyPtr&& reply) {
   UASSERT(reply);
-  if (command->control.account_in_statistics)
-    statistics_.AccountReplyReceived(reply, command);
+  if (command->control.account_in_statistics) AccountReply(command, reply);
+  DeliverReply(command, std::move(reply));
+}
+
+void Redis::RedisImpl::AccountReply(const CommandPtr& command,
+                                    const ReplyPtr& reply) {
+  statistics_.AccountReplyReceived(reply, command);
+  // local errors are fast and must not attract the load
+  if (reply->status == REDIS_OK || reply->status == REDIS_ERR_TIMEOUT) {
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - command->GetStartHandlingTime());
+    reply_latency_us_ = reply_latency_us_.load() * kReplyLatencyExp +
+                        latency.count() * (1 - kReplyLatencyExp);
+  }
+}
+
+void Redis::RedisImpl::DeliverReply(const CommandPtr& command,
+                                    ReplyPtr&& reply) {
   reply->server = server_;
   if (reply->status == REDIS_ERR_TIMEOUT) {
     auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -716,7 +937,7 @@ void Redis::RedisImpl::SetState(State state) {
              state == State::kDisconnected)
     Disconnect();
 
-  if (redis_obj_) redis_obj_->signal_state_change(state);
+  if (redis_obj_) redis_obj_->OnConnectionStateChange();
 }
 
 void Redis::RedisImpl::FreeCommands() {
@@ -795,9 +1016,8 @@ void Redis::RedisImpl::CommandLoopImpl() {
     std::swap(commands_, commands);
   }
   LOG_TRACE() << "commands size=" << commands.size();
-  for (auto& command : commands) {
-    ProcessCommand(command);
-  }
+  ProcessCommands(commands,
+                  commands_buffering_settings_.Get()->merge_get_set_commands);
 }
 
 void Redis::RedisImpl::OnConnect(const redisAsyncContext* c,
@@ -900,7 +1120,7 @@ void Redis::RedisImpl::Authenticate() {
     if (send_readonly_)
       SendReadOnly();
     else
-      SetState(State::kConnected);
+      LoadScripts();
   } else {
     ProcessCommand(PrepareCommand(
         CmdArgs{"AUTH", password_.GetUnderlying()},
@@ -909,7 +1129,7 @@ void Redis::RedisImpl::Authenticate() {
             if (send_readonly_)
               SendReadOnly();
             else
-              SetState(State::kConnected);
+              LoadScripts();
           } else {
             if (*reply) {
               if (reply->IsUnknownCommandError()) {
@@ -941,7 +1161,7 @@ void Redis::RedisImpl::SendReadOnly() {
   ProcessCommand(PrepareCommand(
       CmdArgs{"READONLY"}, [this](const CommandPtr&, ReplyPtr reply) {
         if (*reply && reply->data.IsStatus()) {
-          SetState(State::kConnected);
+          LoadScripts();
         } else {
           if (*reply) {
             LOG_LIMITED_ERROR()
@@ -957,6 +1177,58 @@ void Redis::RedisImpl::SendReadOnly() {
       }));
 }
 
+void Redis::RedisImpl::LoadScripts() {
+  if (!script_registry_) {
+    SetState(State::kConnected);
+    return;
+  }
+
+  const std::weak_ptr<RedisImpl> weak_self = shared_from_this();
+  // the scripts registered later are loaded by the regular command queue
+  auto scripts = script_registry_->Subscribe(
+      weak_self, [weak_self](const std::string& script) {
+        if (auto self = weak_self.lock())
+          self->AsyncCommand(self->PrepareScriptLoad(script, {}));
+      });
+  if (scripts.empty()) {
+    SetState(State::kConnected);
+    return;
+  }
+
+  LOG_DEBUG() << "Load " << scripts.size() << " scripts to "
+              << GetServerId().GetDescription();
+  auto pending = std::make_shared<size_t>(scripts.size());
+  for (const auto& script : scripts) {
+    ProcessCommand(PrepareScriptLoad(script, [this, pending] {
+      if (--*pending == 0) SetState(State::kConnected);
+    }));
+  }
+}
+
+CommandPtr Redis::RedisImpl::PrepareScriptLoad(
+    const std::string& script, std::function<void()> on_loaded) {
+  return PrepareCommand(
+      CmdArgs{"SCRIPT", "LOAD", script},
+      [this, on_loaded = std::move(on_loaded)](const CommandPtr&,
+                                               ReplyPtr reply) {
+        if (!*reply) {
+          LOG_LIMITED_WARNING() << "SCRIPT LOAD failed with status="
+                                << reply->StatusString() << log_extra_;
+          // reconnects instead of staying in kInit
+          if (on_loaded) Disconnect();
+          return;
+        }
+        if (!reply->data.IsString()) {
+          // EVALSHA of the script gets NOSCRIPT, the instance is still usable
+          LOG_LIMITED_ERROR()
+              << log_extra_ << "SCRIPT LOAD failed: response type="
+              << reply->data.GetTypeString()
+              << " msg=" << reply->data.ToDebugString();
+        }
+        if (on_loaded) on_loaded();
+      });
+}
+
 void Redis::RedisImpl::OnRedisReply(redisAsyncContext* c, void* r,
                                     void* privdata) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(c->data);
@@ -977,9 +1249,11 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply,
 
     ev_thread_control_.Stop(data->second->timer);
     pcommand = data->second.get();
-    auto reply =
-        std::make_shared<Reply>(pcommand->cmd, redis_reply,
-                                redis_reply ? REDIS_OK : REDIS_ERR_NOT_READY);
+    auto reply = redis_reply
+                     ? std::make_shared<Reply>(
+                           pcommand->cmd, ReplyData(AdoptReply(redis_reply)))
+                     : std::make_shared<Reply>(pcommand->cmd, nullptr,
+                                               REDIS_ERR_NOT_READY);
 
     // After 'subscribe x' + 'unsubscribe x' + 'subscribe x' requests
     // 'unsubscribe' reply can be received as a reply to the second subscribe
@@ -1105,6 +1379,101 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
   }
 }
 
+void Redis::RedisImpl::ProcessCommands(std::deque<CommandPtr>& commands,
+                                       bool merge_get_set) {
+  if (!merge_get_set || subscriber_) {
+    for (auto& command : commands) {
+      ProcessCommand(command);
+    }
+    return;
+  }
+
+  // Only the adjacent commands are merged so that the order of the commands
+  // for the same key is preserved
+  for (auto it = commands.begin(); it != commands.end();) {
+    const auto type = GetMergeableCommand(*it);
+    auto run_end = std::next(it);
+    if (type != MergeableCommand::kNone) {
+      while (run_end != commands.end() &&
+             GetMergeableCommand(*run_end) == type) {
+        ++run_end;
+      }
+    }
+    if (std::distance(it, run_end) < 2) {
+      ProcessCommand(*it);
+    } else {
+      ProcessCommand(MergeCommands(type, {it, run_end}));
+    }
+    it = run_end;
+  }
+}
+
+CommandPtr Redis::RedisImpl::MergeCommands(MergeableCommand type,
+                                           std::vector<CommandPtr> commands) {
+  UASSERT(type != MergeableCommand::kNone && commands.size() > 1);
+  const bool is_get = type == MergeableCommand::kGet;
+
+  CmdArgs::CmdArgsArray args;
+  args.reserve(1 + commands.size() * (is_get ? 1 : 2));
+  args.emplace_back(is_get ? "MGET" : "MSET");
+  auto control = commands.front()->control;
+  for (const auto& command : commands) {
+    const auto& command_args = command->args.args.front();
+    args.insert(args.end(), std::next(command_args.begin()),
+                command_args.end());
+    control.timeout_single =
+        std::min(control.timeout_single, command->control.timeout_single);
+    control.account_in_statistics |= command->control.account_in_statistics;
+    command->ResetStartHandlingTime();
+  }
+  // The merged command is accounted in the statistics and in the reply
+  // latency estimate once, instead of the commands it replaces.
+  //
+  // Note that MGET replies nil for a key holding a non-string value, while
+  // GET replies a WRONGTYPE error for it.
+
+  LOG_TRACE() << "Merging " << commands.size() << " commands into " << args[0];
+  CmdArgs merged_args;
+  merged_args.args.push_back(std::move(args));
+  return PrepareCommand(
+      std::move(merged_args),
+      [this, is_get, commands = std::move(commands)](const CommandPtr&,
+                                                     ReplyPtr reply) {
+        const std::string name = is_get ? "get" : "set";
+        if (reply->IsOk() && reply->data.IsError()) {
+          // e.g. CROSSSLOT in cluster mode, let the commands fail separately
+          LOG_LIMITED_WARNING()
+              << "Merged " << reply->cmd << " failed with "
+              << reply->data.GetError() << ", resending separately"
+              << log_extra_;
+          for (const auto& command : commands) ProcessCommand(command);
+          return;
+        }
+        const bool valid_get_reply = is_get && reply->IsOk() &&
+                                     reply->data.IsArray() &&
+                                     reply->data.GetSize() == commands.size();
+        const bool valid_set_reply =
+            !is_get && reply->IsOk() && reply->data.IsStatus();
+        for (size_t i = 0; i < commands.size(); ++i) {
+          ReplyPtr command_reply;
+          if (valid_get_reply) {
+            command_reply = std::make_shared<Reply>(
+                name, std::move(reply->data.GetArray()[i]));
+          } else if (valid_set_reply) {
+            command_reply =
+                std::make_shared<Reply>(name, ReplyData(reply->data));
+          } else {
+            command_reply = std::make_shared<Reply>(
+                name, nullptr,
+                reply->IsOk() ? REDIS_ERR_PROTOCOL : reply->status);
+          }
+          command_reply->time = reply->time;
+          DeliverReply(commands[i], std::move(command_reply));
+        }
+      },
+      control);
+}
+
 void Redis::RedisImpl::SetCommandsBufferingSettings(
     CommandsBufferingSettings commands_buffering_settings) {
   commands_buffering_settings_.Set(
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <boost/signals2/signal.hpp>
@@ -12,6 +14,7 @@
 
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/redis_state.hpp>
+#include <userver/storages/redis/impl/redis_stats.hpp>
 #include <userver/storages/redis/impl/request.hpp>
 #include <userver/storages/redis/impl/types.hpp>
 
@@ -19,15 +22,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
-class Statistics;
+class ScriptRegistry;
 
 class Redis {
  public:
   using State = RedisState;
   static const std::string& StateToString(State state);
 
+  // Opens `connections_count` connections to the server, each on its own ev
+  // thread, the commands are spread over them
   Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
-        bool send_readonly, ConnectionSecurity connection_security);
+        bool send_readonly, ConnectionSecurity connection_security,
+        size_t connections_count = 1);
   ~Redis();
 
   Redis(Redis&& o) = delete;
@@ -37,16 +43,26 @@ class Redis {
   bool AsyncCommand(const CommandPtr& command);
   size_t GetRunningCommands() const;
   std::chrono::milliseconds GetPingLatency() const;
+  // Exponentially weighted moving average of the command reply times
+  std::chrono::microseconds GetReplyLatency() const;
   bool IsDestroying() const;
   std::string GetServerHost() const;
 
+  // kConnected once all the connections are connected
   State GetState() const;
-  const Statistics& GetStatistics() const;
+  // Sum of the connections' statistics, with the per-connection ones in
+  // InstanceStatistics::connections if there are several connections
+  InstanceStatistics GetStatistics() const;
+  // The same for all the connections
   ServerId GetServerId() const;
 
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  // Scripts of the registry are loaded on connect before the instance becomes
+  // kConnected, must be called before Connect()
+  void SetScriptRegistry(std::shared_ptr<ScriptRegistry> script_registry);
+
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(State)> signal_state_change;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -54,8 +70,20 @@ class Redis {
 
  private:
   class RedisImpl;
-  engine::ev::ThreadControl thread_control_;
-  std::shared_ptr<RedisImpl> impl_;
+
+  struct Connection {
+    engine::ev::ThreadControl thread_control;
+    std::shared_ptr<RedisImpl> impl;
+  };
+
+  RedisImpl& SelectConnection(const CommandPtr& command);
+  void OnConnectionStateChange();
+
+  std::vector<Connection> connections_;
+  // connection index + 1 of each bucket of the keys, 0 if not assigned yet
+  std::unique_ptr<std::atomic<std::uint16_t>[]> key_buckets_;
+  std::mutex state_mutex_;
+  State last_signaled_state_{State::kInit};
 };
 
 template <typename Rep, typename Period>
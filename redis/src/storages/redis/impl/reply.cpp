@@ -14,19 +14,30 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
-ReplyData::ReplyData(const redisReply* reply) {
+ReplyData::ReplyData(const redisReply* reply) : ReplyData(reply, nullptr) {}
+
+ReplyData::ReplyData(std::shared_ptr<const redisReply> reply)
+    : ReplyData(reply.get(), reply) {}
+
+ReplyData::ReplyData(const redisReply* reply,
+                     const std::shared_ptr<const redisReply>& owner) {
   if (!reply) return;
 
   switch (reply->type) {
     case REDIS_REPLY_STRING:
       type_ = Type::kString;
-      string_ = std::string(reply->str, reply->len);
+      if (owner) {
+        view_ = std::string_view(reply->str, reply->len);
+        owner_ = owner;
+      } else {
+        string_ = std::string(reply->str, reply->len);
+      }
       break;
     case REDIS_REPLY_ARRAY:
       type_ = Type::kArray;
       array_.reserve(reply->elements);
       for (size_t i = 0; i < reply->elements; i++)
-        array_.emplace_back(reply->element[i]);
+        array_.push_back(ReplyData(reply->element[i], owner));
       break;
     case REDIS_REPLY_INTEGER:
       type_ = Type::kInteger;
@@ -84,6 +95,7 @@ std::string ReplyData::ToDebugString() const {
     case ReplyData::Type::kNil:
       return "(nil)";
     case ReplyData::Type::kString:
+      return std::string{GetStringView()};
     case ReplyData::Type::kStatus:
     case ReplyData::Type::kError:
       return string_;
@@ -173,6 +185,7 @@ size_t ReplyData::GetSize() const {
       return 1;
 
     case Type::kString:
+      return GetStringView().size();
     case Type::kStatus:
     case Type::kError:
       return string_.size();
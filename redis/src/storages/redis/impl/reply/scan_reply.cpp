@@ -46,7 +46,7 @@ ScanReply ScanReply::parse(ReplyPtr reply) {
           ReplyData::TypeToString(ReplyData::Type::kString) +
           ", but one of elements has " + key_data.GetTypeString() + " type");
     }
-    keys.emplace_back(key_data.GetString());
+    keys.emplace_back(key_data.GetStringView());
   }
 
   ScanReply result;
@@ -1,6 +1,9 @@
 #include <userver/storages/redis/impl/reply.hpp>
 
+#include <string>
+
 #include <gtest/gtest.h>
+#include <hiredis/hiredis.h>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,4 +25,55 @@ TEST(Reply, IsUnusableInstanceErrorERR) {
   EXPECT_FALSE(data.IsUnusableInstanceError());
 }
 
+TEST(Reply, RetainedReplyStrings) {
+  std::string key = "key";
+  std::string value = "value";
+
+  redisReply elements[2]{};
+  elements[0].type = REDIS_REPLY_STRING;
+  elements[0].str = key.data();
+  elements[0].len = key.size();
+  elements[1].type = REDIS_REPLY_STRING;
+  elements[1].str = value.data();
+  elements[1].len = value.size();
+  redisReply* element_ptrs[2]{&elements[0], &elements[1]};
+
+  redisReply array{};
+  array.type = REDIS_REPLY_ARRAY;
+  array.element = element_ptrs;
+  array.elements = 2;
+
+  bool freed = false;
+  {
+    redis::ReplyData data{std::shared_ptr<const redisReply>(
+        &array, [&freed](const redisReply*) { freed = true; })};
+    ASSERT_TRUE(data.IsArray());
+    EXPECT_EQ(data.GetSize(), key.size() + value.size());
+    EXPECT_EQ(data[0].GetStringView(), "key");
+    EXPECT_EQ(data[0].GetStringView().data(), key.data());
+
+    // elements keep the reply alive
+    auto element = std::move(data[1]);
+    data = redis::ReplyData::CreateNil();
+    EXPECT_FALSE(freed);
+
+    EXPECT_EQ(element.GetString(), "value");
+    EXPECT_TRUE(freed);
+    EXPECT_EQ(element.GetStringView(), "value");
+  }
+}
+
+TEST(Reply, CopiedReplyStrings) {
+  std::string value = "value";
+  redisReply reply{};
+  reply.type = REDIS_REPLY_STRING;
+  reply.str = value.data();
+  reply.len = value.size();
+
+  redis::ReplyData data{&reply};
+  value = "other";
+  EXPECT_EQ(data.GetStringView(), "value");
+  EXPECT_EQ(data.GetString(), "value");
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <userver/storages/redis/impl/request.hpp>
 
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/tracing/in_place_span.hpp>
 
 #include <storages/redis/impl/command.hpp>
@@ -57,7 +58,7 @@ Request::Request(Sentinel& sentinel, CmdArgs&& args, const std::string& key,
                  size_t replies_to_skip) {
   CommandPtr command_ptr = PrepareRequest(std::forward<CmdArgs>(args),
                                           command_control, replies_to_skip);
-  sentinel.AsyncCommand(std::move(command_ptr), key, master);
+  if (command_ptr) sentinel.AsyncCommand(std::move(command_ptr), key, master);
 }
 
 Request::Request(Sentinel& sentinel, CmdArgs&& args, size_t shard, bool master,
@@ -65,7 +66,7 @@ Request::Request(Sentinel& sentinel, CmdArgs&& args, size_t shard, bool master,
                  size_t replies_to_skip) {
   CommandPtr command_ptr = PrepareRequest(std::forward<CmdArgs>(args),
                                           command_control, replies_to_skip);
-  sentinel.AsyncCommand(std::move(command_ptr), master, shard);
+  if (command_ptr) sentinel.AsyncCommand(std::move(command_ptr), master, shard);
 }
 
 CommandPtr Request::PrepareRequest(CmdArgs&& args,
@@ -73,6 +74,16 @@ CommandPtr Request::PrepareRequest(CmdArgs&& args,
                                    size_t replies_to_skip) {
   deadline_ = engine::Deadline::FromDuration(command_control.timeout_all);
 
+  // The handled request has already timed out, the command is not sent and
+  // times out right away
+  if (server::request::GetTaskInheritedDeadline().IsReached()) {
+    engine::Promise<ReplyPtr> promise;
+    future_ = promise.get_future();
+    promise.set_value(
+        std::make_shared<Reply>(std::string(), nullptr, REDIS_ERR_TIMEOUT));
+    return nullptr;
+  }
+
   // Sadly, we don't have std::move_only_function, so we need a shared_ptr.
   auto state_ptr = std::make_shared<ReplyState>(MakeSpanName(args));
   state_ptr->SetRepliesToSkip(replies_to_skip);
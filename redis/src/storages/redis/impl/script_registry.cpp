@@ -0,0 +1,40 @@
+#include <storages/redis/impl/script_registry.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+bool ScriptRegistry::Add(std::string script) {
+  std::vector<Subscriber> subscribers;
+  {
+    std::lock_guard lock(mutex_);
+    if (std::find(scripts_.begin(), scripts_.end(), script) != scripts_.end())
+      return false;
+    scripts_.push_back(script);
+
+    subscribers_.erase(
+        std::remove_if(subscribers_.begin(), subscribers_.end(),
+                       [](const auto& s) { return s.owner.expired(); }),
+        subscribers_.end());
+    subscribers = subscribers_;
+  }
+
+  // the listeners are not called under the lock to allow them to block
+  for (const auto& subscriber : subscribers) {
+    if (const auto owner = subscriber.owner.lock()) subscriber.listener(script);
+  }
+  return true;
+}
+
+std::vector<std::string> ScriptRegistry::Subscribe(
+    std::weak_ptr<const void> owner, Listener listener) {
+  std::lock_guard lock(mutex_);
+  subscribers_.push_back({std::move(owner), std::move(listener)});
+  return scripts_;
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+// Lua scripts that are loaded by `SCRIPT LOAD` into every instance of the
+// shards of a Sentinel, so that EVALSHA does not get the NOSCRIPT errors.
+// Is shared by the shards, each Redis instance subscribes on connect.
+class ScriptRegistry final {
+ public:
+  using Listener = std::function<void(const std::string& script)>;
+
+  // Returns true if the script was not registered before
+  bool Add(std::string script);
+
+  // Returns the registered scripts, the scripts registered after the call are
+  // passed to the listener while the owner is alive. Each script is either
+  // returned or passed to the listener, never both.
+  std::vector<std::string> Subscribe(std::weak_ptr<const void> owner,
+                                     Listener listener);
+
+ private:
+  struct Subscriber {
+    std::weak_ptr<const void> owner;
+    Listener listener;
+  };
+
+  std::mutex mutex_;
+  std::vector<std::string> scripts_;
+  std::vector<Subscriber> subscribers_;
+};
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/storages/redis/impl/sentinel.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 
@@ -7,6 +9,7 @@
 
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -31,6 +34,20 @@ void ThrowIfCancelled() {
   }
 }
 
+// There is no use waiting for the reply after the deadline of the request
+// being handled
+void LimitByTaskDeadline(CommandControl& cc) {
+  const auto deadline = server::request::GetTaskInheritedDeadline();
+  if (!deadline.IsReachable()) return;
+  // an expired deadline is handled by the Request, which does not send it
+  const auto time_left = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline.TimeLeft()),
+      std::chrono::milliseconds{1});
+  cc.timeout_single = std::min(cc.timeout_single, time_left);
+  cc.timeout_all = std::min(cc.timeout_all, time_left);
+}
+
 }  // namespace
 
 Sentinel::Sentinel(
@@ -40,7 +57,8 @@ Sentinel::Sentinel(
     const std::string& client_name, const Password& password,
     ConnectionSecurity connection_security, ReadyChangeCallback ready_callback,
     std::unique_ptr<KeyShard>&& key_shard, CommandControl command_control,
-    const testsuite::RedisControl& testsuite_redis_control, ConnectionMode mode)
+    const testsuite::RedisControl& testsuite_redis_control, ConnectionMode mode,
+    size_t connections_per_instance)
     : thread_pools_(thread_pools),
       secdist_default_command_control_(command_control),
       testsuite_redis_control_(testsuite_redis_control) {
@@ -58,7 +76,7 @@ Sentinel::Sentinel(
         *sentinel_thread_control_, thread_pools_->GetRedisThreadPool(), *this,
         shards, conns, std::move(shard_group_name), client_name, password,
         connection_security, std::move(ready_callback), std::move(key_shard),
-        mode);
+        mode, connections_per_instance);
   });
 }
 
@@ -86,7 +104,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
     const secdist::RedisSettings& settings, std::string shard_group_name,
     const std::string& client_name, KeyShardFactory key_shard_factory,
     const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    size_t connections_per_instance) {
   auto ready_callback = [](size_t shard, const std::string& shard_name,
                            bool ready) {
     LOG_INFO() << "redis: ready_callback:"
@@ -96,7 +115,7 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
   return CreateSentinel(thread_pools, settings, std::move(shard_group_name),
                         client_name, std::move(ready_callback),
                         std::move(key_shard_factory), command_control,
-                        testsuite_redis_control);
+                        testsuite_redis_control, connections_per_instance);
 }
 
 std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
@@ -105,7 +124,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
     const std::string& client_name,
     Sentinel::ReadyChangeCallback ready_callback,
     KeyShardFactory key_shard_factory, const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    size_t connections_per_instance) {
   const auto& password = settings.password;
 
   const std::vector<std::string>& shards = settings.shards;
@@ -139,7 +159,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
     client = std::make_shared<redis::Sentinel>(
         thread_pools, shards, conns, std::move(shard_group_name), client_name,
         password, settings.secure_connection, std::move(ready_callback),
-        std::move(key_shard), command_control, testsuite_redis_control);
+        std::move(key_shard), command_control, testsuite_redis_control,
+        ConnectionMode::kCommands, connections_per_instance);
     client->Start();
   }
 
@@ -241,6 +262,12 @@ size_t Sentinel::ShardByKey(const std::string& key) const {
 
 size_t Sentinel::ShardsCount() const { return impl_->ShardsCount(); }
 
+bool Sentinel::IsInClusterMode() const { return impl_->IsInClusterMode(); }
+
+size_t Sentinel::HashSlot(const std::string& key) {
+  return SentinelImpl::HashSlot(key);
+}
+
 void Sentinel::CheckShardIdx(size_t shard_idx) const {
   CheckShardIdx(shard_idx, ShardsCount());
 }
@@ -265,6 +292,15 @@ void Sentinel::SetCommandsBufferingSettings(
   return impl_->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void Sentinel::RegisterScript(std::string script) {
+  impl_->RegisterScript(std::move(script));
+}
+
+void Sentinel::SetClientThrottlerSettings(
+    const congestion_control::ClientThrottlerSettings& settings) {
+  impl_->SetClientThrottlerSettings(settings);
+}
+
 std::vector<Request> Sentinel::MakeRequests(
     CmdArgs&& args, bool master, const CommandControl& command_control,
     size_t replies_to_skip) {
@@ -323,10 +359,12 @@ void Sentinel::OnPsubscribeReply(const PmessageCallback pmessage_callback,
 }
 
 CommandControl Sentinel::GetCommandControl(const CommandControl& cc) const {
-  return secdist_default_command_control_
-      .MergeWith(*config_default_command_control_.Get())
-      .MergeWith(cc)
-      .MergeWith(testsuite_redis_control_);
+  auto result = secdist_default_command_control_
+                    .MergeWith(*config_default_command_control_.Get())
+                    .MergeWith(cc)
+                    .MergeWith(testsuite_redis_control_);
+  LimitByTaskDeadline(result);
+  return result;
 }
 
 void Sentinel::SetConfigDefaultCommandControl(
@@ -59,7 +59,8 @@ SentinelImpl::SentinelImpl(
     const std::vector<ConnectionInfo>& conns, std::string shard_group_name,
     const std::string& client_name, const Password& password,
     ConnectionSecurity connection_security, ReadyChangeCallback ready_callback,
-    std::unique_ptr<KeyShard>&& key_shard, ConnectionMode mode)
+    std::unique_ptr<KeyShard>&& key_shard, ConnectionMode mode,
+    size_t connections_per_instance)
     : sentinel_obj_(sentinel),
       ev_thread_(sentinel_thread_control),
       shard_group_name_(std::move(shard_group_name)),
@@ -73,7 +74,8 @@ SentinelImpl::SentinelImpl(
       cluster_mode_failed_(false),
       key_shard_(std::move(key_shard)),
       connection_mode_(mode),
-      slot_info_(IsInClusterMode() ? std::make_unique<SlotInfo>() : nullptr) {
+      slot_info_(IsInClusterMode() ? std::make_unique<SlotInfo>() : nullptr),
+      connections_per_instance_(connections_per_instance) {
   for (size_t i = 0; i < init_shards_->size(); ++i) {
     shards_[(*init_shards_)[i]] = i;
     connected_statuses_.push_back(std::make_unique<ConnectedStatus>());
@@ -182,6 +184,9 @@ void SentinelImpl::InitShards(
     shard_options.shard_name = shard;
     shard_options.shard_group_name = shard_group_name_;
     shard_options.cluster_mode = IsInClusterMode();
+    shard_options.throttling = throttler_settings_;
+    shard_options.script_registry = script_registry_;
+    shard_options.connections_per_instance = connections_per_instance_;
     shard_options.ready_change_callback = [i, shard,
                                            ready_callback](bool ready) {
       if (ready_callback) ready_callback(i, shard, ready);
@@ -241,6 +246,10 @@ void SentinelImpl::AsyncCommand(const SentinelCommand& scommand,
         if (counter != command->counter) return;
         UASSERT(reply);
 
+        if (reply->status == REDIS_OK && !reply->IsUnusableInstanceError()) {
+          master_shards_[shard]->GetThrottler().AccountAccepted();
+        }
+
         std::chrono::steady_clock::time_point now =
             std::chrono::steady_clock::now();
 
@@ -307,6 +316,12 @@ void SentinelImpl::AsyncCommand(const SentinelCommand& scommand,
 
   UASSERT(shard < master_shards_.size());
   auto master_shard = master_shards_[shard];
+  if (!master_shard->GetThrottler().Allow()) {
+    // retries are throttled as well, the callback gets the throttled reply
+    scommand.command->args = std::move(command_check_errors->args);
+    AsyncCommandThrottled(scommand.command);
+    return;
+  }
   if (!master_shard->AsyncCommand(command_check_errors)) {
     scommand.command->args = std::move(command_check_errors->args);
     AsyncCommandFailed(scommand);
@@ -389,6 +404,18 @@ void SentinelImpl::GenerateKeysForShards(size_t max_len) {
       max_len));
 }
 
+void SentinelImpl::AsyncCommandThrottled(CommandPtr command) {
+  LOG_LIMITED_WARNING() << "Shard is throttled, not sending "
+                        << CommandSpecialPrinter{command};
+  // Run command callbacks from redis thread only, see AsyncCommandFailed()
+  ev_thread_.RunInEvLoopAsync([command = std::move(command)] {
+    for (const auto& args : command->args.args) {
+      InvokeCommand(command, std::make_shared<Reply>(args[0], nullptr,
+                                                     REDIS_ERR_NOT_READY));
+    }
+  });
+}
+
 void SentinelImpl::AsyncCommandFailed(const SentinelCommand& scommand) {
   // Run command callbacks from redis thread only.
   // It prevents recursive mutex locking in subscription_storage.
@@ -490,6 +517,19 @@ void SentinelImpl::SetCommandsBufferingSettings(
     shard->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void SentinelImpl::RegisterScript(std::string script) {
+  if (script_registry_->Add(std::move(script)))
+    LOG_INFO() << "Registered a Lua script for " << shard_group_name_;
+}
+
+void SentinelImpl::SetClientThrottlerSettings(
+    const congestion_control::ClientThrottlerSettings& settings) {
+  throttler_settings_ = settings;
+  for (auto& shard : master_shards_) {
+    shard->GetThrottler().SetSettings(settings);
+  }
+}
+
 void SentinelImpl::RequestUpdateClusterSlots(size_t shard) {
   current_slots_shard_ = shard;
   ev_thread_.Send(watch_cluster_slots_);
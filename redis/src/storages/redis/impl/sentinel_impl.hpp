@@ -26,6 +26,7 @@
 #include "keys_for_shards.hpp"
 #include "keyshard_impl.hpp"
 #include "redis.hpp"
+#include "script_registry.hpp"
 #include "sentinel_query.hpp"
 #include "shard.hpp"
 
@@ -46,7 +47,8 @@ class SentinelImpl {
                const Password& password, ConnectionSecurity connection_security,
                ReadyChangeCallback ready_callback,
                std::unique_ptr<KeyShard>&& key_shard,
-               ConnectionMode mode = ConnectionMode::kCommands);
+               ConnectionMode mode = ConnectionMode::kCommands,
+               size_t connections_per_instance = 1);
   ~SentinelImpl();
 
   std::unordered_map<ServerId, size_t, ServerIdHasher>
@@ -88,9 +90,13 @@ class SentinelImpl {
 
   std::vector<std::shared_ptr<const Shard>> GetMasterShards() const;
   bool IsInClusterMode() const;
+  static size_t HashSlot(const std::string& key);
 
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
+  void SetClientThrottlerSettings(
+      const congestion_control::ClientThrottlerSettings& settings);
+  void RegisterScript(std::string script);
 
  private:
   static constexpr const std::chrono::milliseconds cluster_slots_timeout_ =
@@ -156,6 +162,7 @@ class SentinelImpl {
 
   void GenerateKeysForShards(size_t max_len = 4);
   void AsyncCommandFailed(const SentinelCommand& scommand);
+  void AsyncCommandThrottled(CommandPtr command);
 
   static void OnCheckTimer(struct ev_loop*, ev_timer* w, int revents) noexcept;
   static void ChangedState(struct ev_loop*, ev_async* w, int revents) noexcept;
@@ -184,8 +191,6 @@ class SentinelImpl {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
@@ -225,6 +230,10 @@ class SentinelImpl {
   SentinelStatisticsInternal statistics_internal_;
   utils::SwappingSmart<KeysForShards> keys_for_shards_;
   std::optional<CommandsBufferingSettings> commands_buffering_settings_;
+  congestion_control::ClientThrottlerSettings throttler_settings_;
+  const std::shared_ptr<ScriptRegistry> script_registry_ =
+      std::make_shared<ScriptRegistry>();
+  const size_t connections_per_instance_;
 };
 
 }  // namespace redis
@@ -76,7 +76,8 @@ bool ParseSentinelResponse(
 
       auto& properties = res.emplace_back();
       for (size_t k = 0; k < array.size() - 1; k += 2) {
-        properties[array[k].GetString()] = array[k + 1].GetString();
+        properties[std::string{array[k].GetStringView()}] =
+            array[k + 1].GetStringView();
       }
     }
   }
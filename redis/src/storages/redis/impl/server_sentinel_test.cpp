@@ -1,7 +1,10 @@
 #include <userver/utest/utest.hpp>
 
+#include <string>
 #include <thread>
 
+#include <userver/server/request/task_inherited_data.hpp>
+
 #include "server_common_sentinel_test.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +29,11 @@ void PeriodicCheck(int check_count, std::chrono::milliseconds wait_period,
   }
 }
 
+void SetTaskDeadline(const std::string& method, engine::Deadline deadline) {
+  server::request::kTaskInheritedData.Set(
+      {nullptr, method, std::chrono::steady_clock::now(), deadline});
+}
+
 }  // namespace
 
 UTEST(Redis, SentinelSingleMaster) {
@@ -234,6 +242,45 @@ UTEST(Redis, SentinelCcRetryToMasterOnNilReply) {
   }
 }
 
+UTEST(Redis, SentinelLeastLatency) {
+  const size_t master_count = 1;
+  const size_t slave_count = 2;
+  const size_t sentinel_count = 1;
+  const int magic_value_slave = 42;
+  const auto slow_reply = std::chrono::milliseconds(100);
+
+  SentinelTest sentinel_test(sentinel_count, master_count, slave_count, 0,
+                             magic_value_slave);
+  auto& sentinel = sentinel_test.SentinelClient();
+
+  EXPECT_TRUE(sentinel_test.Master().WaitForFirstPingReply(kSmallPeriod));
+  for (size_t i = 0; i < slave_count; ++i) {
+    EXPECT_TRUE(sentinel_test.Slave(i).WaitForFirstPingReply(kSmallPeriod));
+  }
+
+  // a slow replica, the other one replies with magic_value_slave + 1
+  auto slow_handler =
+      sentinel_test.Slave(0).RegisterTimeoutHandler("GET", slow_reply);
+
+  redis::CommandControl cc;
+  cc.strategy = redis::CommandControl::Strategy::kLeastLatency;
+  cc.timeout_single = std::chrono::seconds(1);
+  cc.timeout_all = std::chrono::seconds(2);
+
+  // no commands are in flight, so only the reply time average of the slow
+  // replica keeps the commands away from it after the first reply
+  for (int i = 0; i < 10; ++i) MakeGetRequest(sentinel, "value", cc).Get();
+  EXPECT_LE(slow_handler->GetReplyCount(), 1UL);
+
+  const auto slow_replies = slow_handler->GetReplyCount();
+  for (int i = 0; i < 20; ++i) {
+    auto res = MakeGetRequest(sentinel, "value", cc).Get();
+    ASSERT_TRUE(res->data.IsInt());
+    EXPECT_EQ(res->data.GetInt(), magic_value_slave + 1);
+  }
+  EXPECT_EQ(slow_handler->GetReplyCount(), slow_replies);
+}
+
 UTEST(Redis, SentinelForceShardIdx) {
   const size_t shard_count = 3;
   const size_t sentinel_count = 1;
@@ -259,4 +306,66 @@ UTEST(Redis, SentinelForceShardIdx) {
   }
 }
 
+UTEST(Redis, SentinelTaskDeadline) {
+  SentinelTest sentinel_test(1, 1, 0);
+  auto& sentinel = sentinel_test.SentinelClient();
+
+  redis::CommandControl cc;
+  cc.timeout_single = std::chrono::seconds{10};
+  cc.timeout_all = std::chrono::seconds{30};
+
+  auto result = sentinel.GetCommandControl(cc);
+  EXPECT_EQ(result.timeout_single, cc.timeout_single);
+  EXPECT_EQ(result.timeout_all, cc.timeout_all);
+
+  const std::string method = "GET";
+  const auto time_left = std::chrono::milliseconds{500};
+  SetTaskDeadline(method, engine::Deadline::FromDuration(time_left));
+
+  // the timeouts are shrunk to the time left of the handled request
+  result = sentinel.GetCommandControl(cc);
+  EXPECT_LE(result.timeout_single, time_left);
+  EXPECT_GT(result.timeout_single, std::chrono::milliseconds{0});
+  EXPECT_LE(result.timeout_all, time_left);
+  EXPECT_GT(result.timeout_all, std::chrono::milliseconds{0});
+
+  // the shorter timeouts are kept as is
+  cc.timeout_single = std::chrono::milliseconds{10};
+  result = sentinel.GetCommandControl(cc);
+  EXPECT_EQ(result.timeout_single, cc.timeout_single);
+  EXPECT_LE(result.timeout_all, time_left);
+
+  // an expired deadline leaves a minimal timeout, the Request does not send
+  // the command anyway
+  SetTaskDeadline(method, engine::Deadline::Passed());
+  result = sentinel.GetCommandControl(cc);
+  EXPECT_EQ(result.timeout_single, std::chrono::milliseconds{1});
+  EXPECT_EQ(result.timeout_all, std::chrono::milliseconds{1});
+}
+
+UTEST(Redis, SentinelTaskDeadlineReached) {
+  SentinelTest sentinel_test(1, 1, 0);
+  auto& sentinel = sentinel_test.SentinelClient();
+  auto handler = sentinel_test.Master().RegisterHandlerWithConstReply(
+      "GET", {"deadline"}, 42);
+
+  EXPECT_TRUE(sentinel_test.Master().WaitForFirstPingReply(kSmallPeriod));
+
+  const std::string method = "GET";
+  SetTaskDeadline(method, engine::Deadline::Passed());
+
+  // the reply times out right away, the command is not sent
+  const auto res = MakeGetRequest(sentinel, "deadline").Get();
+  EXPECT_EQ(res->status, redis::REDIS_ERR_TIMEOUT);
+  EXPECT_FALSE(res->data);
+  EXPECT_EQ(handler->GetReplyCount(), 0);
+
+  // background tasks are not limited by the handled request
+  server::request::kTaskInheritedData.Erase();
+  const auto reply = MakeGetRequest(sentinel, "deadline").Get();
+  ASSERT_TRUE(reply->data.IsInt());
+  EXPECT_EQ(reply->data.GetInt(), 42);
+  EXPECT_EQ(handler->GetReplyCount(), 1);
+}
+
 USERVER_NAMESPACE_END
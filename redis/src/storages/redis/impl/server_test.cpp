@@ -1,5 +1,6 @@
 #include "mock_server_test.hpp"
 
+#include <atomic>
 #include <thread>
 
 #include <storages/redis/impl/command.hpp>
@@ -142,6 +143,32 @@ TEST(Redis, PingFail) {
   PeriodicWait([&] { return !IsConnected(*redis); });
 }
 
+TEST(Redis, MultipleConnections) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  auto get_handler = server.RegisterNilReplyHandler("GET");
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 2);
+  auto redis = std::make_shared<redis::Redis>(
+      pool->GetRedisThreadPool(), false, redis::ConnectionSecurity::kNone, 3);
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(ping_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+  EXPECT_EQ(redis->GetStatistics().connections.size(), 3u);
+
+  std::atomic<int> replies{0};
+  for (int i = 0; i < 10; ++i) {
+    redis->AsyncCommand(redis::PrepareCommand(
+        {"GET", "key" + std::to_string(i % 3)},
+        [&replies](const redis::CommandPtr&, redis::ReplyPtr reply) {
+          if (reply->data.IsNil()) ++replies;
+        }));
+  }
+  PeriodicWait([&] { return replies == 10; });
+  EXPECT_TRUE(IsConnected(*redis));
+}
+
 class RedisDisconnectingReplies : public ::testing::TestWithParam<const char*> {
 };
 
@@ -173,4 +200,57 @@ TEST_P(RedisDisconnectingReplies, X) {
   PeriodicWait([&] { return !IsConnected(*redis); });
 }
 
+TEST(Redis, MergeGetCommands) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  auto get_handler = server.RegisterNilReplyHandler("GET");
+  auto mget_handler = server.RegisterHandlerWithConstReply(
+      "MGET", redis::ReplyData::Array{redis::ReplyData{"one"},
+                                      redis::ReplyData::CreateNil(),
+                                      redis::ReplyData{"three"}});
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis = std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false,
+                                              redis::ConnectionSecurity::kNone);
+  redis::CommandsBufferingSettings buffering_settings;
+  buffering_settings.buffering_enabled = true;
+  buffering_settings.watch_command_timer_interval =
+      std::chrono::milliseconds{100};
+  buffering_settings.merge_get_set_commands = true;
+  redis->SetCommandsBufferingSettings(buffering_settings);
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(ping_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  const auto replies_accounted =
+      redis->GetStatistics().error_count[REDIS_OK];
+
+  std::mutex mutex;
+  std::vector<std::string> replies(3);
+  std::atomic<size_t> reply_count{0};
+  for (size_t i = 0; i < replies.size(); ++i) {
+    redis->AsyncCommand(redis::PrepareCommand(
+        {"GET", std::to_string(i)},
+        [&, i](const redis::CommandPtr&, redis::ReplyPtr reply) {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_EQ("get", reply->cmd);
+            replies[i] = reply->data.IsString() ? reply->data.GetString()
+                                                : reply->data.GetTypeString();
+          }
+          ++reply_count;
+        }));
+  }
+
+  EXPECT_TRUE(mget_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return reply_count == replies.size(); });
+  EXPECT_EQ(0, get_handler->GetReplyCount());
+  // the merged command is accounted once instead of the commands it replaces
+  EXPECT_EQ(replies_accounted + 1,
+            redis->GetStatistics().error_count[REDIS_OK]);
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ((std::vector<std::string>{"one", "kNil", "three"}), replies);
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <storages/redis/impl/shard.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
@@ -13,6 +16,21 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace redis {
+namespace {
+
+// Replies faster than this are considered equal, so that idle instances
+// without latency samples yet are not preferred too much
+constexpr std::chrono::microseconds kMinReplyLatency{100};
+
+// Expected time to get a reply from the instance: commands in flight are
+// served before a new one
+double EstimateReplyTime(const Redis& instance) {
+  const auto latency = std::max(instance.GetReplyLatency(), kMinReplyLatency);
+  return static_cast<double>(latency.count()) *
+         (1 + instance.GetRunningCommands());
+}
+
+}  // namespace
 
 ConnectionInfoInt::ConnectionInfoInt(ConnectionInfo conn_info)
     : conn_info_(std::move(conn_info)),
@@ -67,6 +85,9 @@ Shard::Shard(Options options)
     : shard_name_(std::move(options.shard_name)),
       shard_group_name_(std::move(options.shard_group_name)),
       ready_change_callback_(std::move(options.ready_change_callback)),
+      throttler_(options.throttling),
+      script_registry_(std::move(options.script_registry)),
+      connections_per_instance_(options.connections_per_instance),
       cluster_mode_(options.cluster_mode) {
   for (const auto& conn : options.connection_infos) {
     connection_infos_.emplace_back(conn);
@@ -118,7 +139,8 @@ std::vector<unsigned char> Shard::GetAvailableServers(
 
   switch (command_control.strategy) {
     case CommandControl::Strategy::kEveryDc:
-    case CommandControl::Strategy::kDefault: {
+    case CommandControl::Strategy::kDefault:
+    case CommandControl::Strategy::kLeastLatency: {
       std::vector<unsigned char> result(instances_.size(), 0);
       for (size_t i = 0; i < instances_.size(); i++) {
         result[i] =
@@ -174,7 +196,7 @@ std::vector<unsigned char> Shard::GetNearestServersPing(
 std::shared_ptr<Redis> Shard::GetInstance(
     const std::vector<unsigned char>& available_servers,
     bool may_fallback_to_any, size_t skip_idx, bool read_only,
-    size_t* pinstance_idx) {
+    size_t* pinstance_idx, bool by_latency) {
   std::shared_ptr<Redis> instance;
 
   auto end = instances_.size();
@@ -191,7 +213,10 @@ std::shared_ptr<Redis> Shard::GetInstance(
     if (cur_inst && !cur_inst->IsDestroying() &&
         (cur_inst->GetState() == Redis::State::kConnected) &&
         (!instance || instance->IsDestroying() ||
-         cur_inst->GetRunningCommands() < instance->GetRunningCommands())) {
+         (by_latency ? EstimateReplyTime(*cur_inst) <
+                           EstimateReplyTime(*instance)
+                     : cur_inst->GetRunningCommands() <
+                           instance->GetRunningCommands()))) {
       if (pinstance_idx) *pinstance_idx = instance_idx;
       instance = cur_inst;
     }
@@ -238,8 +263,10 @@ bool Shard::AsyncCommand(CommandPtr command) {
     bool may_fallback_to_any =
         attempt != 0 && command->control.force_server_id.IsAny();
 
-    instance = GetInstance(available_servers, may_fallback_to_any, skip_idx,
-                           command->read_only, &idx);
+    instance = GetInstance(
+        available_servers, may_fallback_to_any, skip_idx, command->read_only,
+        &idx,
+        command->control.strategy == CommandControl::Strategy::kLeastLatency);
     command->instance_idx = idx;
 
     if (instance) {
@@ -291,10 +318,12 @@ bool Shard::ProcessCreation(
                 redis_thread_pool,
                 // https://github.com/boostorg/signals2/issues/59
                 // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
-                cluster_mode_ && id.IsReadOnly(), id.GetConnectionSecurity())};
+                cluster_mode_ && id.IsReadOnly(), id.GetConnectionSecurity(),
+                connections_per_instance_)};
     if (auto commands_buffering_settings = commands_buffering_settings_.Get())
       entry.instance->SetCommandsBufferingSettings(
           *commands_buffering_settings);
+    if (script_registry_) entry.instance->SetScriptRegistry(script_registry_);
     auto server_id = entry.instance->GetServerId();
     entry.instance->signal_state_change.connect(
         [this, server_id](Redis::State state) {
@@ -396,6 +425,7 @@ ShardStatistics Shard::GetStatistics(bool master) const {
     }
   }
   stats.last_ready_time = last_ready_time_;
+  if (master) stats.throttled = throttler_.GetStatistics().rejected;
 
   return stats;
 }
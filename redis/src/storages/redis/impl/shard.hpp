@@ -7,9 +7,11 @@
 #include <utility>
 #include <vector>
 
+#include <userver/congestion_control/client_throttler.hpp>
 #include <userver/utils/swappingsmart.hpp>
 
 #include <storages/redis/impl/redis.hpp>
+#include <storages/redis/impl/script_registry.hpp>
 #include <userver/storages/redis/impl/redis_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -65,6 +67,11 @@ class Shard {
     bool cluster_mode{false};
     std::function<void(bool ready)> ready_change_callback;
     std::vector<ConnectionInfo> connection_infos;
+    congestion_control::ClientThrottlerSettings throttling;
+    // scripts to load into the instances, none if null
+    std::shared_ptr<ScriptRegistry> script_registry;
+    // connections to open to each instance
+    size_t connections_per_instance{1};
   };
 
   explicit Shard(Options options);
@@ -79,7 +86,7 @@ class Shard {
   std::shared_ptr<Redis> GetInstance(
       const std::vector<unsigned char>& available_servers,
       bool may_fallback_to_any, size_t skip_idx, bool read_only,
-      size_t* pinstance_idx);
+      size_t* pinstance_idx, bool by_latency = false);
   void Clean();
   bool ProcessCreation(
       const std::shared_ptr<engine::ev::ThreadPool>& redis_thread_pool);
@@ -97,6 +104,8 @@ class Shard {
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  congestion_control::ClientThrottler& GetThrottler() { return throttler_; }
+
  private:
   std::vector<unsigned char> GetAvailableServers(
       const CommandControl& command_control, bool with_masters,
@@ -129,6 +138,9 @@ class Shard {
   boost::signals2::signal<void(ServerId, bool)> signal_instance_ready_;
 
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
+  congestion_control::ClientThrottler throttler_;
+  const std::shared_ptr<ScriptRegistry> script_registry_;
+  const size_t connections_per_instance_;
 
   bool prev_connected_ = false;
   const bool cluster_mode_ = false;
@@ -1,5 +1,12 @@
 #include <userver/storages/redis/parse_reply.hpp>
 
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
 #include <userver/storages/redis/reply.hpp>
 #include <userver/utils/from_string.hpp>
 
@@ -26,6 +33,22 @@ std::string ExtractStringElem(ReplyData& array_data, size_t elem_idx,
   return std::move(elem.GetString());
 }
 
+// Same as std::stod, but short strings are not copied to the heap. The reply
+// strings are not null-terminated, so std::strtod can not be used on them
+// directly.
+double ParseDouble(std::string_view str) {
+  std::array<char, 64> buffer{};
+  if (str.size() >= buffer.size()) return std::stod(std::string{str});
+  std::memcpy(buffer.data(), str.data(), str.size());
+
+  char* end = nullptr;
+  errno = 0;
+  const double result = std::strtod(buffer.data(), &end);
+  if (end == buffer.data()) throw std::invalid_argument("no number found");
+  if (errno == ERANGE) throw std::out_of_range("number is out of range");
+  return result;
+}
+
 ReplyData::MovableKeyValues GetKeyValues(
     ReplyData& array_data, const std::string& request_description) {
   try {
@@ -148,10 +171,10 @@ std::vector<MemberScore> ParseReplyDataArray(
 
   for (auto elem : key_values) {
     auto& member_elem = elem.Key();
-    const auto& score_elem = elem.Value();
+    const auto score_elem = elem.ValueView();
     double score = NAN;
     try {
-      score = std::stod(score_elem);
+      score = ParseDouble(score_elem);
     } catch (const std::exception& ex) {
       throw USERVER_NAMESPACE::redis::ParseReplyException(
           std::string("Can't parse response to '")
@@ -237,7 +260,7 @@ double Parse(ReplyData&& reply_data, const std::string& request_description,
              To<double>) {
   reply_data.ExpectString(request_description);
   try {
-    return std::stod(reply_data.GetString());
+    return ParseDouble(reply_data.GetStringView());
   } catch (const std::exception& ex) {
     throw USERVER_NAMESPACE::redis::ParseReplyException(
         "Can't parse value from reply to '" + request_description +
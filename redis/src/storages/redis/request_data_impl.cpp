@@ -1,5 +1,7 @@
 #include "request_data_impl.hpp"
 
+#include <algorithm>
+
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,6 +32,85 @@ USERVER_NAMESPACE::redis::Request& RequestDataImplBase::GetRequest() {
   return request_;
 }
 
+RequestScanAllShardsData::RequestScanAllShardsData(
+    std::shared_ptr<ClientImpl> client, std::vector<size_t> shards,
+    ScanOptions options, size_t max_parallel_shards,
+    const CommandControl& command_control)
+    : client_(std::move(client)),
+      shards_(std::move(shards)),
+      options_(std::move(options)),
+      max_parallel_shards_(std::max<size_t>(max_parallel_shards, 1)),
+      command_control_(command_control) {
+  StartShards();
+}
+
+RequestScanAllShardsData::ReplyElem RequestScanAllShardsData::Get() {
+  if (Eof())
+    throw RequestScan::GetAfterEofException("Trying to Get() after eof");
+  return std::move(keys_[keys_index_++]);
+}
+
+RequestScanAllShardsData::ReplyElem& RequestScanAllShardsData::Current() {
+  if (Eof())
+    throw RequestScan::GetAfterEofException(
+        "Trying to call Current() after eof");
+  return keys_[keys_index_];
+}
+
+bool RequestScanAllShardsData::Eof() {
+  CheckReply();
+  return keys_index_ == keys_.size();
+}
+
+std::vector<RequestScanAllShardsData::ReplyElem>
+RequestScanAllShardsData::GetBatch() {
+  if (Eof()) return {};
+  std::vector<ReplyElem> batch;
+  if (keys_index_ == 0) {
+    batch = std::move(keys_);
+    keys_.clear();
+  } else {
+    batch.assign(std::make_move_iterator(keys_.begin() + keys_index_),
+                 std::make_move_iterator(keys_.end()));
+    keys_.clear();
+  }
+  keys_index_ = 0;
+  return batch;
+}
+
+void RequestScanAllShardsData::StartShards() {
+  while (in_flight_.size() < max_parallel_shards_ &&
+         next_shard_index_ < shards_.size()) {
+    const auto shard = shards_[next_shard_index_++];
+    in_flight_.push_back({shard, command_control_,
+                          client_->MakeScanRequestNoKey(shard, {}, options_,
+                                                        command_control_)});
+  }
+}
+
+void RequestScanAllShardsData::CheckReply() {
+  while (keys_index_ == keys_.size() && !in_flight_.empty()) {
+    auto scan = std::move(in_flight_.front());
+    in_flight_.pop_front();
+
+    auto scan_reply_raw = scan.request.GetRaw();
+    // the cursor is only valid for the same server
+    scan.command_control.force_server_id = scan_reply_raw->server_id;
+    auto scan_reply = ParseReply<ScanReply>(std::move(scan_reply_raw),
+                                            request_description_);
+    keys_ = std::move(scan_reply.GetKeys());
+    keys_index_ = 0;
+
+    if (scan_reply.GetCursor().GetValue()) {
+      scan.request = client_->MakeScanRequestNoKey(
+          scan.shard, scan_reply.GetCursor(), options_, scan.command_control);
+      in_flight_.push_back(std::move(scan));
+    } else {
+      StartShards();
+    }
+  }
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
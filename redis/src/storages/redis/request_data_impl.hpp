@@ -1,9 +1,14 @@
 #pragma once
 
+#include <deque>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/exception.hpp>
 #include <userver/storages/redis/impl/request.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -78,8 +83,11 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   using RequestDataPtr = std::unique_ptr<RequestDataBase<ReplyType>>;
 
  public:
-  explicit AggregateRequestDataImpl(std::vector<RequestDataPtr>&& requests)
-      : requests_(std::move(requests)) {}
+  // `positions` are the indices of the concatenated reply elements in the
+  // resulting reply, the elements are not reordered if empty
+  explicit AggregateRequestDataImpl(std::vector<RequestDataPtr>&& requests,
+                                    std::vector<size_t> positions = {})
+      : requests_(std::move(requests)), positions_(std::move(positions)) {}
 
   void Wait() override {
     for (auto& request : requests_) {
@@ -88,12 +96,35 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   }
 
   ReplyType Get(const std::string& request_description) override {
-    std::vector<typename ReplyType::value_type> result;
-    for (auto& request : requests_) {
-      auto data = request->Get(request_description);
-      std::move(data.begin(), data.end(), std::back_inserter(result));
+    if constexpr (std::is_void_v<ReplyType>) {
+      for (auto& request : requests_) request->Get(request_description);
+    } else if constexpr (std::is_arithmetic_v<ReplyType>) {
+      ReplyType result{};
+      for (auto& request : requests_) {
+        result += request->Get(request_description);
+      }
+      return result;
+    } else {
+      std::vector<typename ReplyType::value_type> result;
+      for (auto& request : requests_) {
+        auto data = request->Get(request_description);
+        std::move(data.begin(), data.end(), std::back_inserter(result));
+      }
+      if (positions_.empty()) return result;
+
+      if (positions_.size() != result.size()) {
+        throw USERVER_NAMESPACE::redis::ParseReplyException(
+            "Unexpected number of elements in replies to '" +
+            request_description + "' request: expected " +
+            std::to_string(positions_.size()) + ", got " +
+            std::to_string(result.size()));
+      }
+      std::vector<typename ReplyType::value_type> ordered(result.size());
+      for (size_t i = 0; i < result.size(); ++i) {
+        ordered[positions_[i]] = std::move(result[i]);
+      }
+      return ordered;
     }
-    return result;
   }
 
   ReplyPtr GetRaw() override {
@@ -103,6 +134,7 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
 
  private:
   std::vector<RequestDataPtr> requests_;
+  std::vector<size_t> positions_;
 };
 
 template <typename Result, typename ReplyType>
@@ -150,6 +182,8 @@ class RequestScanData final : public RequestScanDataBase<scan_tag> {
 
   bool Eof() override;
 
+  std::vector<ReplyElem> GetBatch() override;
+
  private:
   RequestScanData(std::shared_ptr<ClientImpl> client, std::string key,
                   size_t shard, ScanOptionsTmpl<scan_tag> options,
@@ -211,6 +245,23 @@ bool RequestScanData<scan_tag>::Eof() {
   return eof_;
 }
 
+template <ScanTag scan_tag>
+std::vector<typename RequestScanData<scan_tag>::ReplyElem>
+RequestScanData<scan_tag>::GetBatch() {
+  if (Eof()) return {};
+  auto& keys = reply_->GetKeys();
+  std::vector<ReplyElem> batch;
+  if (reply_keys_index_ == 0) {
+    batch = std::move(keys);
+    keys.clear();
+  } else {
+    batch.assign(std::make_move_iterator(keys.begin() + reply_keys_index_),
+                 std::make_move_iterator(keys.end()));
+  }
+  reply_keys_index_ = keys.size();
+  return batch;
+}
+
 template <ScanTag scan_tag>
 void RequestScanData<scan_tag>::CheckReply() {
   while (!eof_ && (!reply_ || reply_keys_index_ == reply_->GetKeys().size())) {
@@ -238,6 +289,48 @@ void RequestScanData<scan_tag>::CheckReply() {
   }
 }
 
+// SCAN of all the shards, the cursors of up to `max_parallel_shards` shards
+// are iterated concurrently: the next SCAN of a shard is sent as soon as its
+// reply is taken, while the other shards' replies are being received.
+class RequestScanAllShardsData final
+    : public RequestScanDataBase<ScanTag::kScan> {
+ public:
+  RequestScanAllShardsData(std::shared_ptr<ClientImpl> client,
+                           std::vector<size_t> shards, ScanOptions options,
+                           size_t max_parallel_shards,
+                           const CommandControl& command_control);
+
+  ReplyElem Get() override;
+
+  ReplyElem& Current() override;
+
+  bool Eof() override;
+
+  std::vector<ReplyElem> GetBatch() override;
+
+ private:
+  struct ShardScan {
+    size_t shard;
+    CommandControl command_control;
+    Request<ScanReply> request;
+  };
+
+  void StartShards();
+  void CheckReply();
+
+  std::shared_ptr<ClientImpl> client_;
+  std::vector<size_t> shards_;
+  ScanOptions options_;
+  size_t max_parallel_shards_;
+  CommandControl command_control_;
+
+  size_t next_shard_index_{0};
+  // in the order the requests were sent
+  std::deque<ShardScan> in_flight_;
+  std::vector<ReplyElem> keys_;
+  size_t keys_index_{0};
+};
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
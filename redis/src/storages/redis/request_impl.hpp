@@ -22,7 +22,7 @@ Request<Result, ReplyType> CreateRequest(
 template <typename Result, typename ReplyType = Result>
 Request<Result, ReplyType> CreateAggregateRequest(
     std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
-    Request<Result, ReplyType>* /* for ADL */) {
+    std::vector<size_t> positions, Request<Result, ReplyType>* /* for ADL */) {
   std::vector<std::unique_ptr<RequestDataBase<ReplyType>>> req_data;
   req_data.reserve(requests.size());
   for (auto& request : requests) {
@@ -31,7 +31,7 @@ Request<Result, ReplyType> CreateAggregateRequest(
   }
   return Request<Result, ReplyType>(
       std::make_unique<AggregateRequestDataImpl<Result, ReplyType>>(
-          std::move(req_data)));
+          std::move(req_data), std::move(positions)));
 }
 
 template <typename Result, typename ReplyType = Result>
@@ -52,9 +52,11 @@ Request CreateRequest(USERVER_NAMESPACE::redis::Request&& request) {
 
 template <typename Request>
 Request CreateAggregateRequest(
-    std::vector<USERVER_NAMESPACE::redis::Request>&& requests) {
+    std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
+    std::vector<size_t> positions = {}) {
   Request* tmp = nullptr;
-  return impl::CreateAggregateRequest(std::move(requests), tmp);
+  return impl::CreateAggregateRequest(std::move(requests),
+                                      std::move(positions), tmp);
 }
 
 template <typename Request>
@@ -0,0 +1,16 @@
+#include <userver/storages/redis/script.hpp>
+
+#include <utility>
+
+#include <userver/crypto/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+Script::Script(std::string body)
+    : body_(std::move(body)), sha1_(crypto::hash::Sha1(body_)) {}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
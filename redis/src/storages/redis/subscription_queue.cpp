@@ -1,5 +1,7 @@
 #include "subscription_queue.hpp"
 
+#include <algorithm>
+
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,6 +35,27 @@ bool SubscriptionQueue<Item>::PopMessage(std::unique_ptr<Item>& msg_ptr) {
   return consumer_.Pop(msg_ptr);
 }
 
+template <typename Item>
+bool SubscriptionQueue<Item>::PopMessages(
+    std::vector<std::unique_ptr<Item>>& batch,
+    const SubscriptionBatchSettings& settings) {
+  batch.clear();
+  std::unique_ptr<Item> msg;
+  if (!consumer_.Pop(msg)) return false;
+  batch.push_back(std::move(msg));
+
+  const auto max_size = std::max<std::size_t>(settings.max_size, 1);
+  const auto deadline = engine::Deadline::FromDuration(settings.max_latency);
+  while (batch.size() < max_size) {
+    if (!consumer_.PopNoblock(msg) &&
+        (settings.max_latency.count() == 0 || !consumer_.Pop(msg, deadline))) {
+      break;
+    }
+    batch.push_back(std::move(msg));
+  }
+  return true;
+}
+
 template <typename Item>
 void SubscriptionQueue<Item>::Unsubscribe() {
   token_->Unsubscribe();
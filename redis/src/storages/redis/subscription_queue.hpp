@@ -2,9 +2,11 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <storages/redis/impl/subscribe_sentinel.hpp>
 #include <userver/engine/mpsc_queue.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -43,6 +45,10 @@ class SubscriptionQueue {
 
   bool PopMessage(std::unique_ptr<Item>& msg_ptr);
 
+  // Waits for a message, then takes the next ones up to the settings' limits
+  bool PopMessages(std::vector<std::unique_ptr<Item>>& batch,
+                   const SubscriptionBatchSettings& settings);
+
   void Unsubscribe();
 
  private:
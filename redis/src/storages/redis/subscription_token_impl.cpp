@@ -1,6 +1,7 @@
 #include "subscription_token_impl.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/tracing/span.hpp>
@@ -15,6 +16,8 @@ const std::string kSubscribeToChannelPrefix = "redis-channel-subscriber-";
 const std::string kSubscribeToPatternPrefix = "redis-pattern-subscriber-";
 const std::string kProcessRedisSubscriptionMessage =
     "process redis subscription message";
+const std::string kProcessRedisSubscriptionMessages =
+    "process redis subscription messages";
 
 }  // namespace
 
@@ -29,6 +32,19 @@ SubscriptionTokenImpl::SubscriptionTokenImpl(
       subscriber_task_(utils::Async(kSubscribeToChannelPrefix + channel_,
                                     [this] { ProcessMessages(); })) {}
 
+SubscriptionTokenImpl::SubscriptionTokenImpl(
+    USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+    std::string channel, OnMessagesCb on_messages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control)
+    : channel_(std::move(channel)),
+      queue_(std::make_unique<SubscriptionQueue<ChannelSubscriptionQueueItem>>(
+          subscribe_sentinel, channel_, command_control)),
+      on_messages_cb_(std::move(on_messages_cb)),
+      batch_settings_(batch_settings),
+      subscriber_task_(utils::Async(kSubscribeToChannelPrefix + channel_,
+                                    [this] { ProcessBatches(); })) {}
+
 SubscriptionTokenImpl::~SubscriptionTokenImpl() { Unsubscribe(); }
 
 void SubscriptionTokenImpl::SetMaxQueueLength(size_t length) {
@@ -48,6 +64,17 @@ void SubscriptionTokenImpl::ProcessMessages() {
   }
 }
 
+void SubscriptionTokenImpl::ProcessBatches() {
+  std::vector<std::unique_ptr<ChannelSubscriptionQueueItem>> batch;
+  std::vector<std::string> messages;
+  while (queue_->PopMessages(batch, batch_settings_)) {
+    messages.clear();
+    for (auto& msg : batch) messages.push_back(std::move(msg->message));
+    tracing::Span span(kProcessRedisSubscriptionMessages);
+    if (on_messages_cb_) on_messages_cb_(channel_, messages);
+  }
+}
+
 PsubscriptionTokenImpl::PsubscriptionTokenImpl(
     USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
     std::string pattern, OnPmessageCb on_pmessage_cb,
@@ -59,6 +86,19 @@ PsubscriptionTokenImpl::PsubscriptionTokenImpl(
       subscriber_task_(utils::Async(kSubscribeToPatternPrefix + pattern_,
                                     [this] { ProcessMessages(); })) {}
 
+PsubscriptionTokenImpl::PsubscriptionTokenImpl(
+    USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+    std::string pattern, OnPmessagesCb on_pmessages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control)
+    : pattern_(std::move(pattern)),
+      queue_(std::make_unique<SubscriptionQueue<PatternSubscriptionQueueItem>>(
+          subscribe_sentinel, pattern_, command_control)),
+      on_pmessages_cb_(std::move(on_pmessages_cb)),
+      batch_settings_(batch_settings),
+      subscriber_task_(utils::Async(kSubscribeToPatternPrefix + pattern_,
+                                    [this] { ProcessBatches(); })) {}
+
 PsubscriptionTokenImpl::~PsubscriptionTokenImpl() { Unsubscribe(); }
 
 void PsubscriptionTokenImpl::SetMaxQueueLength(size_t length) {
@@ -78,6 +118,19 @@ void PsubscriptionTokenImpl::ProcessMessages() {
   }
 }
 
+void PsubscriptionTokenImpl::ProcessBatches() {
+  std::vector<std::unique_ptr<PatternSubscriptionQueueItem>> batch;
+  std::vector<PatternMessage> messages;
+  while (queue_->PopMessages(batch, batch_settings_)) {
+    messages.clear();
+    for (auto& msg : batch) {
+      messages.push_back({std::move(msg->channel), std::move(msg->message)});
+    }
+    tracing::Span span(kProcessRedisSubscriptionMessages);
+    if (on_pmessages_cb_) on_pmessages_cb_(pattern_, messages);
+  }
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
@@ -14,12 +14,19 @@ namespace storages::redis {
 class SubscriptionTokenImpl : public SubscriptionTokenImplBase {
  public:
   using OnMessageCb = SubscriptionToken::OnMessageCb;
+  using OnMessagesCb = SubscriptionToken::OnMessagesCb;
 
   SubscriptionTokenImpl(
       USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
       std::string channel, OnMessageCb on_message_cb,
       const USERVER_NAMESPACE::redis::CommandControl& command_control);
 
+  SubscriptionTokenImpl(
+      USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+      std::string channel, OnMessagesCb on_messages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
+
   ~SubscriptionTokenImpl() override;
 
   void SetMaxQueueLength(size_t length) override;
@@ -28,22 +35,32 @@ class SubscriptionTokenImpl : public SubscriptionTokenImplBase {
 
  private:
   void ProcessMessages();
+  void ProcessBatches();
 
   std::string channel_;
   std::unique_ptr<SubscriptionQueue<ChannelSubscriptionQueueItem>> queue_;
   OnMessageCb on_message_cb_;
+  OnMessagesCb on_messages_cb_;
+  SubscriptionBatchSettings batch_settings_;
   engine::TaskWithResult<void> subscriber_task_;
 };
 
 class PsubscriptionTokenImpl : public SubscriptionTokenImplBase {
  public:
   using OnPmessageCb = SubscriptionToken::OnPmessageCb;
+  using OnPmessagesCb = SubscriptionToken::OnPmessagesCb;
 
   PsubscriptionTokenImpl(
       USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
       std::string pattern, OnPmessageCb on_pmessage_cb,
       const USERVER_NAMESPACE::redis::CommandControl& command_control);
 
+  PsubscriptionTokenImpl(
+      USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+      std::string pattern, OnPmessagesCb on_pmessages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
+
   ~PsubscriptionTokenImpl() override;
 
   void SetMaxQueueLength(size_t length) override;
@@ -52,10 +69,13 @@ class PsubscriptionTokenImpl : public SubscriptionTokenImplBase {
 
  private:
   void ProcessMessages();
+  void ProcessBatches();
 
   std::string pattern_;
   std::unique_ptr<SubscriptionQueue<PatternSubscriptionQueueItem>> queue_;
   OnPmessageCb on_pmessage_cb_;
+  OnPmessagesCb on_pmessages_cb_;
+  SubscriptionBatchSettings batch_settings_;
   engine::TaskWithResult<void> subscriber_task_;
 };
 
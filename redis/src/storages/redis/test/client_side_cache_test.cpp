@@ -0,0 +1,126 @@
+#include <userver/storages/redis/client_side_cache.hpp>
+
+#include <userver/storages/redis/mock_client_google.hpp>
+#include <userver/storages/redis/mock_subscribe_client.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::test {
+
+namespace {
+
+using testing::_;
+
+class ClientSideCacheTest : public ::testing::Test {
+ protected:
+  ClientSideCacheTest() {
+    EXPECT_CALL(subscribe_client_, Psubscribe("__keyspace@*__:*", _, _))
+        .WillOnce([this](std::string, SubscriptionToken::OnPmessageCb cb,
+                         const USERVER_NAMESPACE::redis::CommandControl&) {
+          on_notification_ = std::move(cb);
+          return SubscriptionToken{};
+        });
+  }
+
+  void Notify(const std::string& key) {
+    ASSERT_TRUE(on_notification_);
+    on_notification_("__keyspace@*__:*", "__keyspace@0__:" + key, "set");
+  }
+
+  std::shared_ptr<GMockClient> client_ = std::make_shared<GMockClient>();
+  MockSubscribeClient subscribe_client_;
+  SubscriptionToken::OnPmessageCb on_notification_;
+};
+
+}  // namespace
+
+UTEST_F(ClientSideCacheTest, Get) {
+  ClientSideCache cache{client_, subscribe_client_, {}};
+
+  EXPECT_CALL(*client_, Get("key", _))
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::string{"value"});
+      })
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::string{"new"});
+      });
+  EXPECT_CALL(*client_, Get("missing", _))
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::nullopt);
+      });
+
+  EXPECT_EQ("value", cache.Get("key"));
+  EXPECT_EQ("value", cache.Get("key"));
+  EXPECT_EQ(std::nullopt, cache.Get("missing"));
+  EXPECT_EQ(std::nullopt, cache.Get("missing"));
+
+  Notify("key");
+  EXPECT_EQ("new", cache.Get("key"));
+  EXPECT_EQ("new", cache.Get("key"));
+
+  const auto stats = cache.GetStatistics();
+  EXPECT_EQ(3, stats.hits);
+  EXPECT_EQ(3, stats.misses);
+  EXPECT_EQ(1, stats.invalidations);
+}
+
+UTEST_F(ClientSideCacheTest, Hget) {
+  ClientSideCache cache{client_, subscribe_client_, {}};
+
+  EXPECT_CALL(*client_, Hget("hash", "a", _))
+      .Times(2)
+      .WillRepeatedly([](std::string, std::string, const CommandControl&) {
+        return CreateMockRequest<RequestHget>(std::string{"value-a"});
+      });
+  EXPECT_CALL(*client_, Hget("hash", "b", _))
+      .Times(2)
+      .WillRepeatedly([](std::string, std::string, const CommandControl&) {
+        return CreateMockRequest<RequestHget>(std::string{"value-b"});
+      });
+
+  EXPECT_EQ("value-a", cache.Hget("hash", "a"));
+  EXPECT_EQ("value-b", cache.Hget("hash", "b"));
+  EXPECT_EQ("value-a", cache.Hget("hash", "a"));
+
+  // all the fields are dropped
+  Notify("hash");
+  EXPECT_EQ("value-a", cache.Hget("hash", "a"));
+  EXPECT_EQ("value-b", cache.Hget("hash", "b"));
+}
+
+UTEST_F(ClientSideCacheTest, Ttl) {
+  ClientSideCache cache{
+      client_, subscribe_client_, {100, std::chrono::milliseconds{0}}};
+
+  EXPECT_CALL(*client_, Get("key", _))
+      .Times(2)
+      .WillRepeatedly([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::string{"value"});
+      });
+
+  EXPECT_EQ("value", cache.Get("key"));
+  EXPECT_EQ("value", cache.Get("key"));
+}
+
+UTEST_F(ClientSideCacheTest, InvalidationDuringFetch) {
+  ClientSideCache cache{client_, subscribe_client_, {}};
+
+  EXPECT_CALL(*client_, Get("key", _))
+      .WillOnce([this](std::string, const CommandControl&) {
+        // the key changes while the old value is on the way
+        Notify("key");
+        return CreateMockRequest<RequestGet>(std::string{"old"});
+      })
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::string{"new"});
+      });
+
+  EXPECT_EQ("old", cache.Get("key"));
+  EXPECT_EQ("new", cache.Get("key"));
+  EXPECT_EQ("new", cache.Get("key"));
+}
+
+}  // namespace storages::redis::test
+
+USERVER_NAMESPACE_END
@@ -82,6 +82,8 @@ class MockClientBase : public Client,
   RequestScriptLoad ScriptLoad(std::string script, size_t shard,
                                const CommandControl& command_control) override;
 
+  void RegisterScript(const Script& script) override;
+
   RequestExists Exists(std::string key,
                        const CommandControl& command_control) override;
 
@@ -236,6 +238,10 @@ class MockClientBase : public Client,
       size_t shard, ScanOptions options,
       const CommandControl& command_control) override;
 
+  ScanRequest<ScanTag::kScan> ScanAllShards(
+      ScanOptionsTmpl<ScanTag::kScan> options, size_t max_parallel_shards,
+      const CommandControl& command_control) override;
+
   RequestScard Scard(std::string key,
                      const CommandControl& command_control) override;
 
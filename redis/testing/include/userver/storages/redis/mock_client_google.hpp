@@ -28,6 +28,8 @@ class GMockClient : public MockClientBase {
               (USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected),
               (override));
 
+  MOCK_METHOD(void, RegisterScript, (const Script& script), (override));
+
   MOCK_METHOD(RequestAppend, Append,
               (std::string key, std::string value,
                const CommandControl& command_control),
@@ -255,6 +257,11 @@ class GMockClient : public MockClientBase {
                const CommandControl& command_control),
               (override));
 
+  MOCK_METHOD(RequestScan, ScanAllShards,
+              (ScanOptions options, size_t max_parallel_shards,
+               const CommandControl& command_control),
+              (override));
+
   MOCK_METHOD(RequestScard, Scard,
               (std::string key, const CommandControl& command_control),
               (override));
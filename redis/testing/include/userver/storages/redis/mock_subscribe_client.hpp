@@ -25,6 +25,18 @@ class MockSubscribeClient : public SubscribeClient {
                SubscriptionToken::OnPmessageCb on_pmessage_cb,
                const USERVER_NAMESPACE::redis::CommandControl& command_control),
               (override));
+  MOCK_METHOD(SubscriptionToken, SubscribeBatched,
+              (std::string channel,
+               SubscriptionToken::OnMessagesCb on_messages_cb,
+               const SubscriptionBatchSettings& batch_settings,
+               const USERVER_NAMESPACE::redis::CommandControl& command_control),
+              (override));
+  MOCK_METHOD(SubscriptionToken, PsubscribeBatched,
+              (std::string pattern,
+               SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+               const SubscriptionBatchSettings& batch_settings,
+               const USERVER_NAMESPACE::redis::CommandControl& command_control),
+              (override));
 };
 
 /// Mocked SubscriptionTokenImplBase. Although one can used it by itself,
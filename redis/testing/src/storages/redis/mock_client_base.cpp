@@ -94,6 +94,8 @@ RequestScriptLoad MockClientBase::ScriptLoad(
   return RequestScriptLoad{nullptr};
 }
 
+void MockClientBase::RegisterScript(const Script& /*script*/) {}
+
 RequestExists MockClientBase::Exists(
     std::string /*key*/, const CommandControl& /*command_control*/) {
   UASSERT_MSG(false, "redis method not mocked");
@@ -417,6 +419,14 @@ ScanRequest<ScanTag::kScan> MockClientBase::Scan(
   return ScanRequest<ScanTag::kScan>{nullptr};
 }
 
+ScanRequest<ScanTag::kScan> MockClientBase::ScanAllShards(
+    ScanOptionsTmpl<ScanTag::kScan> /*options*/,
+    size_t /*max_parallel_shards*/,
+    const CommandControl& /*command_control*/) {
+  UASSERT_MSG(false, "redis method not mocked");
+  return ScanRequest<ScanTag::kScan>{nullptr};
+}
+
 RequestScard MockClientBase::Scard(std::string /*key*/,
                                    const CommandControl& /*command_control*/) {
   UASSERT_MSG(false, "redis method not mocked");
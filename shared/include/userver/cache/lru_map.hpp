@@ -55,6 +55,11 @@ class LruMap final {
     return default_value;
   }
 
+  /// Returns pointer to the least recently used key;
+  /// returns nullptr if LRU is empty.
+  /// @warning Returned pointer may be freed on the next map access!
+  const T* GetLeastUsedKey() { return impl_.GetLeastUsedKey(); }
+
   /// Returns pointer to the least recently used value;
   /// returns nullptr if LRU is empty.
   /// @warning Returned pointer may be freed on the next map access!
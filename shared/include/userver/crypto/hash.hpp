@@ -3,6 +3,8 @@
 /// @file userver/crypto/hash.hpp
 /// @brief @copybrief crypto::hash
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 USERVER_NAMESPACE_BEGIN
@@ -88,6 +90,48 @@ std::string HmacSha384(std::string_view key, std::string_view message,
 std::string HmacSha512(std::string_view key, std::string_view message,
                        OutputEncoding encoding = OutputEncoding::kHex);
 
+/// @brief Calculates a hash of the data that comes in parts, e.g. of a body
+/// that is streamed from network, in constant memory
+///
+/// The results are the same as of the functions above for the concatenated
+/// parts.
+class Hasher final {
+ public:
+  enum class Algorithm {
+    kSha1,
+    kSha224,
+    kSha256,
+    kSha384,
+    kSha512,
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+    kBlake2b128,
+#endif
+    /// Broken, must not be used except for compatibility
+    kWeakMd5,
+  };
+
+  /// @throws CryptoException internal library exception
+  explicit Hasher(Algorithm algorithm);
+
+  Hasher(Hasher&&) noexcept;
+  Hasher& operator=(Hasher&&) noexcept;
+  ~Hasher();
+
+  /// @brief Appends the data to the hashed message
+  /// @throws CryptoException internal library exception
+  void Update(std::string_view data);
+
+  /// @brief Returns the hash of the data passed to Update() since the
+  /// construction or the previous Finalize() call and starts a new message
+  /// @param encoding result could be returned as binary string or encoded
+  /// @throws CryptoException internal library exception
+  std::string Finalize(OutputEncoding encoding = OutputEncoding::kHex);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Broken cryptographic hashes, must not be used except for compatibility
 namespace weak {
 
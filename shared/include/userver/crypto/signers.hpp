@@ -77,6 +77,9 @@ class DsaSigner final : public Signer {
 
  private:
   PrivateKey pkey_;
+  // initialized once with the key and the algorithm, copied for each message
+  std::shared_ptr<const EVP_MD_CTX> sign_ctx_;
+  std::shared_ptr<EVP_PKEY_CTX> sign_digest_ctx_;
 };
 
 /// @name Outputs RSASSA signature using SHA-2 and PKCS1 padding.
@@ -84,6 +84,9 @@ class DsaVerifier final : public Verifier {
 
  private:
   PublicKey pkey_;
+  // initialized once with the key and the algorithm, copied for each message
+  std::shared_ptr<const EVP_MD_CTX> verify_ctx_;
+  std::shared_ptr<EVP_PKEY_CTX> verify_digest_ctx_;
 };
 
 /// @name Verifies RSASSA signature using SHA-2 and PKCS1 padding.
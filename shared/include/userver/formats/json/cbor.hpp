@@ -0,0 +1,35 @@
+#pragma once
+
+/// @file userver/formats/json/cbor.hpp
+/// @brief CBOR (RFC 8949) encoding of formats::json::Value
+
+#include <string>
+#include <string_view>
+
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @brief Serializes the JSON value to CBOR.
+///
+/// Integers are written in the shortest form, doubles as single precision
+/// floats if that is lossless and as double precision floats otherwise.
+/// Arrays, objects and strings have definite lengths.
+std::string ToCborString(const formats::json::Value& doc);
+
+/// @brief Parses the CBOR data item into a JSON value.
+///
+/// Accepts definite and indefinite length arrays, maps and text strings,
+/// half, single and double precision floats. Tags are ignored, `undefined` is
+/// parsed as null.
+///
+/// @throw ParseException if the data is malformed, has trailing bytes, has
+/// non-string map keys, duplicate keys, byte strings, non-finite floats or
+/// integers out of the `std::int64_t`/`std::uint64_t` range
+formats::json::Value FromCborString(std::string_view cbor);
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
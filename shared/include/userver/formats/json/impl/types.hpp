@@ -25,6 +25,8 @@ using formats::common::Type;
 class Value;
 
 namespace impl {
+struct InternedKeys;
+
 // rapidjson integration
 using UTF8 = ::rapidjson::UTF8<char>;
 using Value = ::rapidjson::GenericValue<UTF8, ::rapidjson::CrtAllocator>;
@@ -61,6 +63,14 @@ class VersionedValuePtr final {
   size_t Version() const;
   void BumpVersion();
 
+  void SetInternedKeys(std::shared_ptr<const InternedKeys> keys);
+
+  /// @brief Makes the interned keys that the `source` tree references usable
+  /// in this tree.
+  /// @returns false if the keys must be copied instead, i.e. this tree already
+  /// references the keys of another document
+  bool ShareInternedKeys(const VersionedValuePtr& source);
+
  private:
   struct Data;
 
@@ -0,0 +1,145 @@
+#pragma once
+
+/// @file userver/formats/json/lazy_value.hpp
+/// @brief @copybrief formats::json::LazyValue
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @ingroup userver_containers
+///
+/// @brief Read-only JSON value of an on-demand parsed document.
+///
+/// formats::json::LazyFromString() only indexes the structural characters of
+/// the document. The values are parsed when they are accessed, lookups skip
+/// the nested objects and arrays without looking into them. Suits the big
+/// documents of which only a few fields are read.
+///
+/// @snippet formats/json/lazy_value_test.cpp  Sample LazyValue
+///
+/// The document is validated on demand: the brackets and the strings are
+/// checked by LazyFromString(), the rest is checked when accessed and
+/// formats::json::ParseException is thrown from the accessors.
+///
+/// The types other than `bool`, `std::int64_t`, `std::uint64_t`, `double`,
+/// `std::string` and formats::json::Value are parsed from the subtree
+/// returned by Materialize(), paths in their exceptions are relative to it.
+class LazyValue final {
+ public:
+  /// Constructs a missing value
+  LazyValue() noexcept;
+
+  /// @brief Access member by key.
+  /// @throw TypeMismatchException if not an object, missing or null.
+  LazyValue operator[](std::string_view key) const;
+
+  /// @brief Access array member by index.
+  /// @throw TypeMismatchException if not an array.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  LazyValue operator[](std::size_t index) const;
+
+  /// @brief Returns the number of the members of an object or array.
+  /// @throw TypeMismatchException if not an array, object or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not an object or null.
+  bool HasMember(std::string_view key) const;
+
+  bool IsMissing() const noexcept;
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  bool IsNumber() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Extracts the specified type with strict type checks.
+  /// @throw MemberMissingException if the value is missing.
+  template <typename T>
+  T As() const;
+
+  /// @brief Extracts the specified type, returns the `default_value` if the
+  /// value is missing or null.
+  template <typename T, typename Default>
+  T As(Default&& default_value) const {
+    if (IsMissing() || IsNull()) {
+      return T(std::forward<Default>(default_value));
+    }
+    return As<T>();
+  }
+
+  /// @brief Parses the value with its subtree. The result is a root value.
+  /// @throw MemberMissingException if the value is missing.
+  Value Materialize() const;
+
+  /// @brief Returns the text of the value in the document.
+  /// @throw MemberMissingException if the value is missing.
+  std::string_view GetRawJson() const;
+
+  /// @brief Returns full path to this value.
+  std::string GetPath() const;
+
+  /// @cond
+  struct Document;
+  /// @endcond
+
+ private:
+  friend LazyValue LazyFromString(std::string_view doc);
+
+  LazyValue(std::shared_ptr<const Document> document,
+            std::uint32_t token) noexcept;
+  LazyValue(std::shared_ptr<const Document> document,
+            std::string&& detached_path) noexcept;
+
+  void CheckNotMissing() const;
+  [[noreturn]] void ThrowTypeMismatch(int expected) const;
+  char GetFirstChar() const noexcept;
+
+  std::shared_ptr<const Document> document_;
+  std::uint32_t token_;
+  /// Full path of node (only for missing nodes)
+  std::string detached_path_;
+};
+
+template <>
+bool LazyValue::As<bool>() const;
+
+template <>
+std::int64_t LazyValue::As<std::int64_t>() const;
+
+template <>
+std::uint64_t LazyValue::As<std::uint64_t>() const;
+
+template <>
+double LazyValue::As<double>() const;
+
+template <>
+std::string LazyValue::As<std::string>() const;
+
+template <>
+Value LazyValue::As<Value>() const;
+
+template <typename T>
+T LazyValue::As() const {
+  return Materialize().As<T>();
+}
+
+/// @brief Copies and indexes the JSON document for the on-demand access
+/// @throw ParseException if the brackets are not balanced, a string is not
+/// terminated or the document has not exactly one root value
+LazyValue LazyFromString(std::string_view doc);
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
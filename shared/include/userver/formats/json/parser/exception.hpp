@@ -25,6 +25,11 @@ class InternalParseError : public BaseError {
   using BaseError::BaseError;
 };
 
+/// Invalid or unsupported JSON Schema, see formats::json::parser::Schema
+class SchemaError : public BaseError {
+  using BaseError::BaseError;
+};
+
 }  // namespace formats::json::parser
 
 USERVER_NAMESPACE_END
@@ -11,6 +11,9 @@ class ParserHandler final {
  public:
   ParserHandler(BaseParser& parser);
 
+  /// The validator, if any, sees each token before the parser
+  ParserHandler(BaseParser& parser, impl::SchemaValidator* validator);
+
   ParserHandler(ParserState& parser_state);
 
   bool Null();
@@ -31,6 +34,7 @@ class ParserHandler final {
 
  private:
   BaseParser& parser_;
+  impl::SchemaValidator* validator_{nullptr};
 };
 
 }  // namespace formats::json::parser
@@ -10,6 +10,11 @@ namespace formats::json::parser {
 
 class BaseParser;
 class ParserHandler;
+class Schema;
+
+namespace impl {
+class SchemaValidator;
+}  // namespace impl
 
 class ParserState final {
  public:
@@ -24,6 +29,9 @@ class ParserState final {
 
   void ProcessInput(std::string_view sw);
 
+  /// Parses the input and validates it against the schema on the fly
+  void ProcessInput(std::string_view sw, const Schema& schema);
+
   void PopMe(BaseParser& parser);
 
   [[noreturn]] void ThrowError(const std::string& err_msg);
@@ -31,6 +39,8 @@ class ParserState final {
  private:
   std::string GetCurrentPath() const;
 
+  void DoProcessInput(std::string_view sw, impl::SchemaValidator* validator);
+
   BaseParser& GetTopParser() const;
 
   struct Impl;
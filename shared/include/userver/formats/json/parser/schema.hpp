@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file userver/formats/json/parser/schema.hpp
+/// @brief @copybrief formats::json::parser::Schema
+
+#include <memory>
+#include <string_view>
+
+#include <userver/formats/json/parser/typed_parser.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+namespace impl {
+struct SchemaProgram;
+}  // namespace impl
+
+/// @brief JSON Schema compiled into a validation program.
+///
+/// Is created once, e.g. in the constructor of a handler, and validates the
+/// documents while the SAX parsers parse them, see
+/// formats::json::parser::ParseToType(). The validation needs no extra pass
+/// over a formats::json::Value.
+///
+/// Supported keywords:
+/// - `type` (a type name or an array of them), `enum` of scalars;
+/// - `minimum`, `maximum`, `exclusiveMinimum`, `exclusiveMaximum` (both the
+///   numeric and the boolean forms);
+/// - `minLength`, `maxLength` in code points;
+/// - `items` with a single schema, `minItems`, `maxItems`;
+/// - `properties`, `required`, `additionalProperties`, `minProperties`,
+///   `maxProperties`;
+/// - boolean schemas `true` and `false`.
+///
+/// The annotations, e.g. `title`, `description`, `default` or `format`, are
+/// ignored. The rest of the keywords (`pattern`, `$ref`, `oneOf`, ...) are
+/// rejected, so that a schema never validates less than it says.
+///
+/// @snippet formats/json/parser/schema_test.cpp Sample Schema usage
+class Schema final {
+ public:
+  /// @throws SchemaError if the schema is invalid or unsupported
+  /// @throws formats::json::Exception if a keyword has a wrong type
+  explicit Schema(const formats::json::Value& schema);
+
+  Schema(Schema&&) noexcept;
+  Schema& operator=(Schema&&) noexcept;
+  ~Schema();
+
+  /// @cond
+  const impl::SchemaProgram& GetProgram() const;
+  /// @endcond
+
+ private:
+  std::unique_ptr<const impl::SchemaProgram> program_;
+};
+
+/// @brief Parses the input with the Parser, validating it against the schema
+/// on the fly.
+/// @throws ParseError if the input is not a valid JSON, is not accepted by the
+/// Parser or does not match the schema
+template <typename T, typename Parser>
+T ParseToType(std::string_view input, const Schema& schema) {
+  T result{};
+  Parser parser;
+  parser.Reset();
+  SubscriberSink<T> sink(result);
+  parser.Subscribe(sink);
+
+  ParserState state;
+  state.PushParser(parser);
+  state.ProcessInput(input, schema);
+
+  return result;
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,432 @@
+#pragma once
+
+/// @file userver/formats/json/parser/struct_parser.hpp
+/// @brief @copybrief formats::json::parser::StructParser
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/json/parser/array_parser.hpp>
+#include <userver/formats/json/parser/bool_parser.hpp>
+#include <userver/formats/json/parser/int_parser.hpp>
+#include <userver/formats/json/parser/map_parser.hpp>
+#include <userver/formats/json/parser/number_parser.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/string_parser.hpp>
+#include <userver/formats/json/parser/typed_parser.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+/// @brief Names of the JSON object fields of an aggregate, in the order of
+/// its members.
+///
+/// To enable formats::json::parser::StructParser for an aggregate, specialize
+/// in the global namespace:
+///
+/// @code
+/// template <>
+/// struct formats::json::parser::StructFieldNames<MyStruct> {
+///   static constexpr std::string_view kNames[] = {"id", "name", "tags"};
+/// };
+/// @endcode
+template <typename T>
+struct StructFieldNames {};
+
+template <typename T, typename ItemParser>
+class OptionalParser;
+
+template <typename Item, typename ItemParser, typename Array>
+class OwningArrayParser;
+
+template <typename Map, typename ValueParser>
+class OwningMapParser;
+
+template <typename T>
+class StructParser;
+
+namespace impl {
+
+template <typename T>
+using StructFieldNamesArray = decltype(StructFieldNames<T>::kNames);
+
+template <typename T>
+inline constexpr bool kHasStructFieldNames =
+    meta::kIsDetected<StructFieldNamesArray, T>;
+
+template <typename T, typename = void>
+struct ParserFor {
+  static_assert(!sizeof(T),
+                "No SAX parser for the type, describe it with "
+                "formats::json::parser::StructFieldNames or use one of "
+                "bool, std::int32_t, std::int64_t, double, float, std::string, "
+                "formats::json::Value, std::optional, std::vector, std::map "
+                "and std::unordered_map with std::string keys");
+};
+
+template <>
+struct ParserFor<bool> {
+  using Type = BoolParser;
+};
+
+template <>
+struct ParserFor<std::int32_t> {
+  using Type = Int32Parser;
+};
+
+template <>
+struct ParserFor<std::int64_t> {
+  using Type = Int64Parser;
+};
+
+template <>
+struct ParserFor<double> {
+  using Type = DoubleParser;
+};
+
+template <>
+struct ParserFor<float> {
+  using Type = FloatParser;
+};
+
+template <>
+struct ParserFor<std::string> {
+  using Type = StringParser;
+};
+
+template <>
+struct ParserFor<Value> {
+  using Type = JsonValueParser;
+};
+
+template <typename T>
+struct ParserFor<std::optional<T>> {
+  using Type = OptionalParser<T, typename ParserFor<T>::Type>;
+};
+
+template <typename T>
+struct ParserFor<std::vector<T>> {
+  using Type = OwningArrayParser<T, typename ParserFor<T>::Type,
+                                 std::vector<T>>;
+};
+
+template <typename T>
+struct ParserFor<std::map<std::string, T>> {
+  using Type = OwningMapParser<std::map<std::string, T>,
+                               typename ParserFor<T>::Type>;
+};
+
+template <typename T>
+struct ParserFor<std::unordered_map<std::string, T>> {
+  using Type = OwningMapParser<std::unordered_map<std::string, T>,
+                               typename ParserFor<T>::Type>;
+};
+
+template <typename T>
+struct ParserFor<T, std::enable_if_t<kHasStructFieldNames<T>>> {
+  using Type = StructParser<T>;
+};
+
+/// Consumes any JSON value without storing it
+class SkipParser final : public TypedParser<std::nullptr_t> {
+ public:
+  void Reset() override { depth_ = 0; }
+
+ protected:
+  void Null() override { MaybeFinish(); }
+  void Bool(bool) override { MaybeFinish(); }
+  void Int64(int64_t) override { MaybeFinish(); }
+  void Uint64(uint64_t) override { MaybeFinish(); }
+  void Double(double) override { MaybeFinish(); }
+  void String(std::string_view) override { MaybeFinish(); }
+  void StartObject() override { ++depth_; }
+  void Key(std::string_view) override {}
+  void EndObject() override { EndContainer(); }
+  void StartArray() override { ++depth_; }
+  void EndArray() override { EndContainer(); }
+
+  std::string Expected() const override { return "value"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  void MaybeFinish() {
+    if (depth_ == 0) this->SetResult(nullptr);
+  }
+
+  void EndContainer() {
+    --depth_;
+    MaybeFinish();
+  }
+
+  std::size_t depth_{0};
+};
+
+/// Parser of the member of an aggregate with the sink that stores the result
+/// into the member
+template <std::size_t Index, typename Field>
+struct FieldParser {
+  explicit FieldParser(Field& field) : sink(field) { parser.Subscribe(sink); }
+
+  typename ParserFor<Field>::Type parser;
+  SubscriberSink<Field> sink;
+};
+
+template <typename T, typename Indices>
+struct FieldParsers;
+
+template <typename T, std::size_t... Indices>
+struct FieldParsers<T, std::index_sequence<Indices...>>
+    : FieldParser<Indices, boost::pfr::tuple_element_t<Indices, T>>... {
+  explicit FieldParsers(T& value)
+      : FieldParser<Indices, boost::pfr::tuple_element_t<Indices, T>>(
+            boost::pfr::get<Indices>(value))... {}
+};
+
+}  // namespace impl
+
+/// @brief SAX parser for `std::optional<T>`, null gives `std::nullopt`
+template <typename T, typename ItemParser>
+class OptionalParser final : public TypedParser<std::optional<T>>,
+                             public Subscriber<T> {
+ public:
+  OptionalParser() { item_parser_.Subscribe(*this); }
+
+ protected:
+  void Null() override { this->SetResult(std::nullopt); }
+  void Bool(bool b) override { PushParser().Bool(b); }
+  void Int64(int64_t i) override { PushParser().Int64(i); }
+  void Uint64(uint64_t i) override { PushParser().Uint64(i); }
+  void Double(double d) override { PushParser().Double(d); }
+  void String(std::string_view sw) override { PushParser().String(sw); }
+  void StartObject() override { PushParser().StartObject(); }
+  void StartArray() override { PushParser().StartArray(); }
+
+  std::string Expected() const override { return "value or null"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  BaseParser& PushParser() {
+    item_parser_.Reset();
+    this->parser_state_->PushParser(item_parser_.GetParser());
+    return item_parser_.GetParser();
+  }
+
+  void OnSend(T&& value) override {
+    this->SetResult(std::optional<T>{std::move(value)});
+  }
+
+  ItemParser item_parser_;
+};
+
+/// @brief Proxy parser for arrays that owns its item parser
+template <typename Item, typename ItemParser,
+          typename Array = std::vector<Item>>
+class OwningArrayParser final {
+ public:
+  using ResultType = Array;
+
+  OwningArrayParser() : array_parser_(item_parser_) {}
+
+  void Reset() { array_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Array>& subscriber) {
+    array_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return array_parser_.GetParser(); }
+
+ private:
+  ItemParser item_parser_;
+  ArrayParser<Item, ItemParser, Array> array_parser_;
+};
+
+/// @brief Proxy parser for objects with arbitrary keys that owns its value
+/// parser
+template <typename Map, typename ValueParser>
+class OwningMapParser final {
+ public:
+  using ResultType = Map;
+
+  OwningMapParser() : map_parser_(value_parser_) {}
+
+  void Reset() { map_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Map>& subscriber) {
+    map_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return map_parser_.GetParser(); }
+
+ private:
+  ValueParser value_parser_;
+  MapParser<Map, ValueParser> map_parser_;
+};
+
+/// @ingroup userver_formats_parse
+///
+/// @brief SAX parser for an aggregate described with
+/// formats::json::parser::StructFieldNames.
+///
+/// The parser for each member is chosen at compile time from its type, the
+/// values are parsed straight into the members without building a
+/// formats::json::Value. Members of `std::optional` type may be missing or
+/// null, the rest are required. Unknown fields are skipped.
+///
+/// @snippet formats/json/parser/struct_parser_test.cpp  Sample StructParser
+template <typename T>
+class StructParser final : public TypedParser<T> {
+  static constexpr std::size_t kSize = boost::pfr::tuple_size_v<T>;
+  static constexpr std::size_t kNoField = kSize;
+
+  static_assert(std::is_aggregate_v<T>,
+                "StructParser supports only the aggregates");
+  static_assert(
+      std::size(StructFieldNames<T>::kNames) == kSize,
+      "StructFieldNames<T>::kNames must name all the members of the struct");
+
+  template <std::size_t Index>
+  using FieldType = boost::pfr::tuple_element_t<Index, T>;
+
+  using Indices = std::make_index_sequence<kSize>;
+
+ public:
+  StructParser() : fields_(result_) {}
+
+  // field parsers reference the members of result_
+  StructParser(const StructParser&) = delete;
+  StructParser& operator=(const StructParser&) = delete;
+
+  void Reset() override {
+    state_ = State::kStart;
+    field_ = kNoField;
+    missing_ = kNoField;
+    seen_.reset();
+    result_ = T{};
+  }
+
+ protected:
+  void StartObject() override {
+    if (state_ != State::kStart) this->Throw("object");
+    state_ = State::kInside;
+  }
+
+  void Key(std::string_view key) override {
+    if (state_ != State::kInside) this->Throw("object");
+
+    field_ = FindField(key);
+    if (field_ == kNoField) {
+      skip_parser_.Reset();
+      this->parser_state_->PushParser(skip_parser_);
+      return;
+    }
+
+    seen_.set(field_);
+    VisitField(field_, [this](auto& parser) {
+      parser.Reset();
+      this->parser_state_->PushParser(parser.GetParser());
+    });
+  }
+
+  void EndObject() override {
+    if (state_ != State::kInside) this->Throw("}");
+
+    field_ = kNoField;
+    missing_ = FindMissingField(Indices{});
+    if (missing_ != kNoField) this->Throw("'}'");
+
+    this->SetResult(std::move(result_));
+  }
+
+  std::string Expected() const override {
+    if (state_ == State::kStart) return "object";
+    if (missing_ != kNoField) {
+      return "field '" + std::string{StructFieldNames<T>::kNames[missing_]} +
+             "'";
+    }
+    return "field name";
+  }
+
+  std::string GetPathItem() const override {
+    if (field_ == kNoField) return {};
+    return std::string{StructFieldNames<T>::kNames[field_]};
+  }
+
+ private:
+  template <std::size_t Index>
+  auto& GetFieldParser() {
+    return static_cast<impl::FieldParser<Index, FieldType<Index>>&>(fields_)
+        .parser;
+  }
+
+  static std::size_t FindField(std::string_view key) {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (StructFieldNames<T>::kNames[i] == key) return i;
+    }
+    return kNoField;
+  }
+
+  template <typename Visitor>
+  void VisitField(std::size_t index, Visitor visitor) {
+    VisitField(index, visitor, Indices{});
+  }
+
+  template <typename Visitor, std::size_t... Indices>
+  void VisitField(std::size_t index, Visitor& visitor,
+                  std::index_sequence<Indices...>) {
+    ((index == Indices ? (visitor(GetFieldParser<Indices>()), true)
+                       : false) ||
+     ...);
+  }
+
+  template <std::size_t... Indices>
+  std::size_t FindMissingField(std::index_sequence<Indices...>) const {
+    std::size_t missing = kNoField;
+    ((!meta::kIsOptional<FieldType<Indices>> && !seen_.test(Indices)
+          ? (missing = Indices, true)
+          : false) ||
+     ...);
+    return missing;
+  }
+
+  enum class State {
+    kStart,
+    kInside,
+  };
+
+  State state_{State::kStart};
+  std::size_t field_{kNoField};
+  std::size_t missing_{kNoField};
+  std::bitset<kSize> seen_;
+  T result_{};
+  impl::FieldParsers<T, Indices> fields_;
+  impl::SkipParser skip_parser_;
+};
+
+/// @brief Parses the JSON document straight into an aggregate described with
+/// formats::json::parser::StructFieldNames
+/// @throw formats::json::parser::ParseError on malformed input
+template <typename T>
+T ParseStruct(std::string_view input) {
+  return ParseToType<T, StructParser<T>>(input);
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
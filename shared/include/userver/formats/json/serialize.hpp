@@ -23,6 +23,15 @@ namespace formats::json {
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// @brief Parse JSON from string, storing each distinct object key of the
+/// document once.
+///
+/// Saves memory and allocations on large documents with repetitive keys,
+/// e.g. arrays of objects of the same structure that are kept in caches. The
+/// keys are shared, not copied, when the subtrees of the document are copied
+/// into a formats::json::ValueBuilder or are Value::Clone()d.
+formats::json::Value FromStringInternKeys(std::string_view doc);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
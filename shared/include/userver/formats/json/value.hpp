@@ -270,10 +270,13 @@ class Value final {
   friend class impl::StringBuffer;
 
   friend formats::json::Value FromString(std::string_view);
+  friend formats::json::Value FromStringInternKeys(std::string_view);
   friend formats::json::Value FromStream(std::istream&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
   friend std::string ToStableString(const formats::json::Value&);
+  friend formats::json::Value FromCborString(std::string_view);
+  friend std::string ToCborString(const formats::json::Value&);
   friend logging::LogHelper& operator<<(logging::LogHelper&, const Value&);
 };
 
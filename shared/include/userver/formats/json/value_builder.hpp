@@ -185,8 +185,9 @@ class ValueBuilder final {
 
   explicit ValueBuilder(impl::MutableValueWrapper) noexcept;
 
-  static void Copy(impl::Value& to, const ValueBuilder& from);
-  static void Move(impl::Value& to, ValueBuilder&& from);
+  // `to` must belong to the tree of *this
+  void Copy(impl::Value& to, const ValueBuilder& from);
+  void Move(impl::Value& to, ValueBuilder&& from);
 
   impl::Value& AddMember(const std::string& key, CheckMemberExists);
 
@@ -115,6 +115,15 @@ inline constexpr char kSetCookie[] = "Set-Cookie";
 /// @name Extra headers
 /// @{
 inline constexpr char kConnection[] = "Connection";
+inline constexpr char kUpgrade[] = "Upgrade";
+/// @}
+
+/// @name WebSocket handshake
+/// @{
+inline constexpr char kSecWebSocketKey[] = "Sec-WebSocket-Key";
+inline constexpr char kSecWebSocketAccept[] = "Sec-WebSocket-Accept";
+inline constexpr char kSecWebSocketVersion[] = "Sec-WebSocket-Version";
+inline constexpr char kSecWebSocketExtensions[] = "Sec-WebSocket-Extensions";
 /// @}
 
 /// @name Tracing headers
@@ -153,6 +162,8 @@ inline constexpr char kMaxResponseSizeInFlight[] =
 inline constexpr char kMaxPendingResponses[] = "too-many-pending-responses";
 inline constexpr char kGlobal[] = "global-ratelimit";
 inline constexpr char kInFlight[] = "max-requests-in-flight";
+inline constexpr char kAdaptiveConcurrency[] = "adaptive-concurrency-limit";
+inline constexpr char kRequestQueue[] = "request-queue-time";
 }  // namespace ratelimit_reason
 /// @}
 
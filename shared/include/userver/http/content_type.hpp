@@ -86,6 +86,7 @@ std::ostream& operator<<(std::ostream&, const ContentType&);
 namespace content_type {
 
 extern const ContentType kApplicationJson;
+extern const ContentType kApplicationCbor;
 
 }  // namespace content_type
 }  // namespace http
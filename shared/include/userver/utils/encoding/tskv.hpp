@@ -3,8 +3,11 @@
 /// @file userver/utils/encoding/tskv.hpp
 /// @brief Encoders, decoders and helpers for TSKV representations
 
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -148,39 +151,21 @@ void EncodeTskv(T& to, const char* str, size_t size, EncodeTskvMode mode,
 }
 /// @}
 
+/// @brief Returns the position of the first char in `str` that EncodeTskv
+/// changes in `mode`, or `str.size()` if EncodeTskv would keep `str` as is.
+///
+/// Scans 16 or 32 bytes at a time if SSE2 or AVX2 is available, use it to
+/// copy the runs of chars that need no escaping in bulk.
+std::size_t FindTskvEscapedChar(std::string_view str,
+                                EncodeTskvMode mode) noexcept;
+
 inline bool ShouldValueBeEscaped(std::string_view key) {
-  for (char ch : key) {
-    switch (ch) {
-      case '\t':
-      case '\r':
-      case '\n':
-      case '\0':
-      case '\\':
-        return true;
-      default:
-        break;
-    }
-  }
-  return false;
+  return FindTskvEscapedChar(key, EncodeTskvMode::kValue) != key.size();
 }
 
 inline bool ShouldKeyBeEscaped(std::string_view key) {
-  for (char ch : key) {
-    switch (ch) {
-      case '\t':
-      case '\r':
-      case '\n':
-      case '\0':
-      case '\\':
-      case '.':
-      case '=':
-        return true;
-      default:
-        if ('A' <= ch && ch <= 'Z') return true;
-        break;
-    }
-  }
-  return false;
+  return FindTskvEscapedChar(key, EncodeTskvMode::kKeyReplacePeriod) !=
+         key.size();
 }
 
 }  // namespace utils::encoding
@@ -0,0 +1,44 @@
+#pragma once
+
+/// @file userver/utils/hash.hpp
+/// @brief Fast non-cryptographic hash functions
+
+#include <cstdint>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @brief 64-bit non-cryptographic hash of the bytes of `s`, wyhash-class.
+///
+/// Processes 48 bytes per iteration; is much faster than a byte-by-byte
+/// hash_combine loop for long strings and has a good distribution in all the
+/// bits. Use a random `seed` and keep it secret if arbitrary keys are allowed,
+/// see utils::StrCaseHash. The result is not stable across userver versions,
+/// do not persist it.
+std::uint64_t HashBytes(std::string_view s, std::uint64_t seed = 0) noexcept;
+
+/// @brief Same as utils::HashBytes, but ASCII letters of `s` are treated as
+/// lowercase. Letters are folded 8 bytes at a time.
+std::uint64_t HashBytesIcase(std::string_view s,
+                             std::uint64_t seed = 0) noexcept;
+
+/// @brief Mixes all the bits of `value` into all the bits of the result.
+///
+/// Useful to derive an independent value from an already computed hash, e.g.
+/// to pick a shard with `HashMix(hash) % shards_count` while the hash itself
+/// is used by a hash table inside the shard.
+constexpr std::uint64_t HashMix(std::uint64_t value) noexcept {
+  // the finalizer of splitmix64
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
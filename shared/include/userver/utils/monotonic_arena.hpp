@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file userver/utils/monotonic_arena.hpp
+/// @brief @copybrief utils::MonotonicArena
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_containers
+///
+/// @brief Monotonic memory arena: allocations are bump-pointer fast,
+/// deallocations are no-op and all the memory is freed at once on Release()
+/// or destruction.
+///
+/// Suits the short-lived objects with a bounded lifetime, e.g. the objects
+/// created during a single request handling. Use it with the containers via
+/// utils::ArenaAllocator:
+/// @snippet src/utils/monotonic_arena_test.cpp  Sample MonotonicArena
+///
+/// Not thread-safe.
+class MonotonicArena final {
+ public:
+  /// Size of the first block, the next blocks grow geometrically
+  static constexpr std::size_t kDefaultInitialBlockSize = 4096;
+
+  explicit MonotonicArena(
+      std::size_t initial_block_size = kDefaultInitialBlockSize) noexcept;
+
+  MonotonicArena(MonotonicArena&&) = delete;
+  MonotonicArena& operator=(MonotonicArena&&) = delete;
+  ~MonotonicArena();
+
+  /// @brief Returns memory of at least `size` bytes aligned by `alignment`,
+  /// which must be a power of 2.
+  /// @throws std::bad_alloc if the memory can not be allocated.
+  void* Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /// Frees all the memory allocated from the arena
+  void Release() noexcept;
+
+  /// Total size of the blocks requested from the global allocator
+  std::size_t GetAllocatedBytes() const noexcept { return allocated_bytes_; }
+
+ private:
+  struct Block;
+
+  void* AllocateInNewBlock(std::size_t size, std::size_t alignment);
+
+  Block* blocks_{nullptr};
+  char* current_{nullptr};
+  char* end_{nullptr};
+  std::size_t next_block_size_;
+  std::size_t allocated_bytes_{0};
+};
+
+/// @ingroup userver_containers
+///
+/// @brief Standard allocator over the utils::MonotonicArena. The arena must
+/// outlive all the containers that use it.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(&other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  MonotonicArena& GetArena() const noexcept { return *arena_; }
+
+ private:
+  MonotonicArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return &lhs.GetArena() == &rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -14,6 +14,8 @@ namespace utils {
 /// @ingroup userver_containers
 ///
 /// @brief Small alias for boost::regex / std::regex without huge includes
+///
+/// @see utils::RegexSet to match many patterns at once
 class regex final {
  public:
   regex();
@@ -0,0 +1,67 @@
+#pragma once
+
+/// @file userver/utils/regex_set.hpp
+/// @brief @copybrief utils::RegexSet
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_containers
+///
+/// @brief Set of regular expressions that are matched against a string at
+/// once
+///
+/// If userver is built with `USERVER_FEATURE_RE2`, the set is compiled with
+/// RE2 into a single automaton: all the patterns are matched in one pass over
+/// the string in linear time, no matter how many patterns there are.
+/// Otherwise the patterns are matched by boost::regex one by one.
+///
+/// The patterns should use the common subset of the RE2 and Perl syntax:
+/// no backreferences and no lookarounds. `^` and `$` match only at the
+/// beginning and the end of the string, `.` does not match `\n`.
+///
+/// @snippet utils/regex_set_test.cpp Sample utils::RegexSet usage
+class RegexSet final {
+ public:
+  enum class Mode {
+    /// A pattern must match the whole string, like utils::regex_match
+    kMatch,
+    /// A pattern may match anywhere in the string, like utils::regex_search
+    kSearch,
+  };
+
+  /// @throws std::invalid_argument if some pattern is invalid
+  explicit RegexSet(const std::vector<std::string>& patterns,
+                    Mode mode = Mode::kSearch);
+
+  RegexSet(RegexSet&&) noexcept;
+  RegexSet& operator=(RegexSet&&) noexcept;
+  ~RegexSet();
+
+  /// @returns indices of all the matching patterns in ascending order
+  std::vector<std::size_t> Match(std::string_view str) const;
+
+  /// @returns the least index of the matching patterns, if any
+  std::optional<std::size_t> MatchFirst(std::string_view str) const;
+
+  /// @returns whether any of the patterns matches
+  bool MatchAny(std::string_view str) const;
+
+  /// @returns the count of the patterns
+  std::size_t GetSize() const noexcept;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,9 @@
 /// @file userver/utils/trivial_map.hpp
 /// @brief Bidirectional map|sets over string literals or other trivial types.
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -225,6 +227,171 @@ class CaseCounter final {
   std::size_t count_{0};
 };
 
+template <std::size_t Count>
+class CaseCounterType final {
+ public:
+  static constexpr std::size_t kCount = Count;
+
+  template <typename First, typename Second>
+  constexpr CaseCounterType<Count + 1> Case(First, Second) noexcept {
+    return {};
+  }
+
+  template <typename First>
+  constexpr CaseCounterType<Count + 1> Case(First) noexcept {
+    return {};
+  }
+};
+
+class CaseCounterTypeSelector final {
+ public:
+  constexpr CaseCounterType<0> operator()() const noexcept { return {}; }
+};
+
+/// Number of Case statements of a BuilderFunc, known at the type level
+template <typename BuilderFunc>
+inline constexpr std::size_t kCasesCount =
+    std::invoke_result_t<const BuilderFunc&, CaseCounterTypeSelector>::kCount;
+
+// Maps with string keys and more Case statements than this are looked up via
+// StringHashTable, for the smaller ones the compiler generated comparisons
+// are faster
+inline constexpr std::size_t kStringHashTableMinCases = 32;
+
+template <typename First, typename Second, std::size_t CasesCount>
+inline constexpr bool kUseStringHashTable =
+    std::is_same_v<First, std::string_view> &&
+    CasesCount > kStringHashTableMinCases &&
+    (std::is_void_v<Second> || std::is_default_constructible_v<Second>);
+
+constexpr std::uint64_t LoadByte(const char* data, std::size_t i) noexcept {
+  return std::uint64_t{static_cast<unsigned char>(data[i])} << (i * 8);
+}
+
+constexpr std::uint64_t LoadWord(const char* data) noexcept {
+  // compilers merge this into a single 8 bytes load
+  return LoadByte(data, 0) | LoadByte(data, 1) | LoadByte(data, 2) |
+         LoadByte(data, 3) | LoadByte(data, 4) | LoadByte(data, 5) |
+         LoadByte(data, 6) | LoadByte(data, 7);
+}
+
+constexpr std::uint64_t HashString(std::string_view value) noexcept {
+  // processes 8 bytes at a time, the final mix makes the low bits depend on
+  // all the input
+  constexpr std::uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+  const auto* data = value.data();
+  const auto size = value.size();
+  std::uint64_t hash = size * kMultiplier;
+
+  if (size < 8) {
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < size; ++i) word |= impl::LoadByte(data, i);
+    hash = (hash ^ word) * kMultiplier;
+  } else {
+    for (std::size_t i = 0; i + 8 < size; i += 8) {
+      hash = (hash ^ impl::LoadWord(data + i)) * kMultiplier;
+    }
+    // the last 8 bytes, possibly overlapping with the previous ones
+    hash = (hash ^ impl::LoadWord(data + size - 8)) * kMultiplier;
+  }
+  hash ^= hash >> 32;
+  hash *= kMultiplier;
+  return hash ^ (hash >> 32);
+}
+
+constexpr std::size_t StringHashTableCapacity(std::size_t cases) noexcept {
+  // load factor of at most 0.5 keeps the probe sequences short
+  std::size_t capacity = 1;
+  while (capacity < cases * 2) capacity *= 2;
+  return capacity;
+}
+
+template <typename Second, std::size_t CasesCount>
+class StringHashTableBuilder final {
+ public:
+  using Value = std::conditional_t<std::is_void_v<Second>, bool, Second>;
+
+  constexpr StringHashTableBuilder& Case(std::string_view first,
+                                         Value second) noexcept {
+    keys_[size_] = first;
+    values_[size_] = second;
+    ++size_;
+    return *this;
+  }
+
+  constexpr StringHashTableBuilder& Case(std::string_view first) noexcept {
+    keys_[size_] = first;
+    ++size_;
+    return *this;
+  }
+
+  std::array<std::string_view, CasesCount> keys_{};
+  std::array<Value, CasesCount> values_{};
+  std::size_t size_{0};
+};
+
+/// Open addressing hash table over the Case statements built at compile time.
+/// Slots store the full hash of the key, so that a lookup usually does a single
+/// string comparison.
+template <typename Second, std::size_t CasesCount>
+class StringHashTable final {
+  using Builder = StringHashTableBuilder<Second, CasesCount>;
+  using Value = typename Builder::Value;
+
+ public:
+  template <typename BuilderFunc>
+  constexpr explicit StringHashTable(const BuilderFunc& func) noexcept {
+    const auto cases = func([]() { return Builder{}; });
+    for (std::size_t i = 0; i < cases.size_; ++i) {
+      const auto hash = impl::HashString(cases.keys_[i]);
+      auto index = static_cast<std::size_t>(hash) & kMask;
+      for (;;) {
+        auto& slot = slots_[index];
+        if (!slot.used) {
+          slot.used = true;
+          slot.hash = hash;
+          slot.key = cases.keys_[i];
+          slot.value = cases.values_[i];
+          break;
+        }
+        // the first Case statement wins, as with the comparison chains
+        if (slot.hash == hash && slot.key == cases.keys_[i]) break;
+        index = (index + 1) & kMask;
+      }
+    }
+  }
+
+  constexpr std::optional<Value> TryFind(std::string_view key) const noexcept {
+    const auto hash = impl::HashString(key);
+    auto index = static_cast<std::size_t>(hash) & kMask;
+    for (;;) {
+      const auto& slot = slots_[index];
+      if (!slot.used) return std::nullopt;
+      if (slot.hash == hash && slot.key == key) return slot.value;
+      index = (index + 1) & kMask;
+    }
+  }
+
+ private:
+  static constexpr std::size_t kCapacity = StringHashTableCapacity(CasesCount);
+  static constexpr std::size_t kMask = kCapacity - 1;
+
+  struct Slot final {
+    std::uint64_t hash{0};
+    std::string_view key{};
+    Value value{};
+    bool used{false};
+  };
+
+  std::array<Slot, kCapacity> slots_{};
+};
+
+class NoStringHashTable final {
+ public:
+  template <typename BuilderFunc>
+  constexpr explicit NoStringHashTable(const BuilderFunc&) noexcept {}
+};
+
 class CaseDescriber final {
  public:
   template <typename First, typename Second>
@@ -294,6 +461,12 @@ class CaseFirstDescriber final {
 /// The same story with integral or enum mappings - compiler optimizes them
 /// into a switch and it usually takes O(1) to find the match.
 ///
+/// Maps with string first parameters and more than 32 Case statements are
+/// looked up by TryFindByFirst() via a hash table built at compile time, with
+/// a single hash computation and usually a single string comparison per
+/// lookup. Prefer namespace scope or `static constexpr` variables for such
+/// maps, otherwise the table may be copied to the stack on each use.
+///
 /// @snippet shared/src/utils/trivial_map_test.cpp  sample bidir bimap
 ///
 /// For a single value Case statements see @ref utils::TrivialSet.
@@ -306,7 +479,8 @@ class TrivialBiMap final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialBiMap(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialBiMap(BuilderFunc&& func) noexcept
+      : func_(std::move(func)), hash_table_(func_) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -319,9 +493,14 @@ class TrivialBiMap final {
   }
 
   constexpr std::optional<Second> TryFindByFirst(First value) const noexcept {
-    return func_(
-               [value]() { return impl::SwitchByFirst<First, Second>{value}; })
-        .Extract();
+    if constexpr (kUseHashTable) {
+      return hash_table_.TryFind(value);
+    } else {
+      return func_([value]() {
+               return impl::SwitchByFirst<First, Second>{value};
+             })
+          .Extract();
+    }
   }
 
   constexpr std::optional<First> TryFindBySecond(Second value) const noexcept {
@@ -385,7 +564,15 @@ class TrivialBiMap final {
   }
 
  private:
+  static constexpr bool kUseHashTable =
+      impl::kUseStringHashTable<First, Second, impl::kCasesCount<BuilderFunc>>;
+
   const BuilderFunc func_;
+  const std::conditional_t<
+      kUseHashTable,
+      impl::StringHashTable<Second, impl::kCasesCount<BuilderFunc>>,
+      impl::NoStringHashTable>
+      hash_table_;
 };
 
 /// @ingroup userver_containers
@@ -403,7 +590,8 @@ class TrivialSet final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialSet(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialSet(BuilderFunc&& func) noexcept
+      : func_(std::move(func)), hash_table_(func_) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -413,9 +601,14 @@ class TrivialSet final {
   }
 
   constexpr bool Contains(First value) const noexcept {
-    return func_(
-               [value]() { return impl::SwitchByFirst<First, Second>{value}; })
-        .Extract();
+    if constexpr (kUseHashTable) {
+      return hash_table_.TryFind(value).has_value();
+    } else {
+      return func_([value]() {
+               return impl::SwitchByFirst<First, Second>{value};
+             })
+          .Extract();
+    }
   }
 
   constexpr bool ContainsICase(std::string_view value) const noexcept {
@@ -440,7 +633,15 @@ class TrivialSet final {
   }
 
  private:
+  static constexpr bool kUseHashTable =
+      impl::kUseStringHashTable<First, Second, impl::kCasesCount<BuilderFunc>>;
+
   const BuilderFunc func_;
+  const std::conditional_t<
+      kUseHashTable,
+      impl::StringHashTable<Second, impl::kCasesCount<BuilderFunc>>,
+      impl::NoStringHashTable>
+      hash_table_;
 };
 
 }  // namespace utils
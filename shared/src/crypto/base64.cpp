@@ -1,7 +1,14 @@
 #include <userver/crypto/base64.hpp>
 
+#include <cstddef>
+#include <string>
+
 #include <cryptopp/base64.h>
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 #include <userver/crypto/exception.hpp>
 
 #ifdef CRYPTOPP_NO_GLOBAL_BYTE
@@ -14,21 +21,89 @@ namespace crypto::base64 {
 
 namespace {
 
-template <typename Base64Encoder>
-std::string Base64Encode(std::string_view data, Pad pad) {
-  std::string response;
-  try {
-    Base64Encoder encoder(new CryptoPP::StringSink(response));
-    CryptoPP::AlgorithmParameters params =
-        CryptoPP::MakeParameters(CryptoPP::Name::Pad(), Pad::kWith == pad)(
-            CryptoPP::Name::InsertLineBreaks(), false);
-    encoder.IsolatedInitialize(params);
-    encoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
-                          data.size());
-  } catch (const CryptoPP::Exception& exc) {
-    throw crypto::CryptoException(exc.what());
+constexpr std::string_view kAlphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static_assert(kAlphabet.size() == 64);
+
+#ifndef USERVER_NO_CRYPTOPP_BASE64_URL
+constexpr std::string_view kUrlAlphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+static_assert(kUrlAlphabet.size() == 64);
+#endif
+
+#ifdef __SSSE3__
+// Offsets of the chars from the 6 bit values for the EncodeBlock ranges
+__m128i MakeOffsets(std::string_view alphabet) {
+  return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, static_cast<char>(alphabet[62] - 62),
+                       static_cast<char>(alphabet[63] - 63), 'A', 0, 0);
+}
+
+// Encodes 12 bytes into 16 chars, reads 16 bytes of the input. See
+// http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html for the details
+__m128i EncodeBlock(const unsigned char* src, __m128i offsets) {
+  auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+  // gather the 6 bit values of each 3 bytes into 4 bytes
+  in = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const auto t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const auto t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const auto indices = _mm_or_si128(t1, t3);
+
+  // map the ranges 0..25, 26..51, 52..61, 62 and 63 into the indices of
+  // `offsets`: 13, 0, 1..10, 11 and 12 respectively
+  auto ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  ranges = _mm_or_si128(ranges, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+#endif
+
+std::string Base64Encode(std::string_view data, Pad pad,
+                         std::string_view alphabet) {
+  const auto tail_size = data.size() % 3;
+  std::size_t result_size = data.size() / 3 * 4;
+  if (tail_size != 0) result_size += (pad == Pad::kWith ? 4 : tail_size + 1);
+
+  std::string result(result_size, '\0');
+  const auto* src = reinterpret_cast<const unsigned char*>(data.data());
+  const auto* const src_end = src + data.size();
+  auto* dst = result.data();
+
+#ifdef __SSSE3__
+  const auto offsets = MakeOffsets(alphabet);
+  while (src_end - src >= 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     EncodeBlock(src, offsets));
+    src += 12;
+    dst += 16;
   }
-  return response;
+#endif
+
+  while (src_end - src >= 3) {
+    const auto triple = (src[0] << 16) | (src[1] << 8) | src[2];
+    *(dst++) = alphabet[(triple >> 18) & 0x3f];
+    *(dst++) = alphabet[(triple >> 12) & 0x3f];
+    *(dst++) = alphabet[(triple >> 6) & 0x3f];
+    *(dst++) = alphabet[triple & 0x3f];
+    src += 3;
+  }
+
+  if (tail_size != 0) {
+    const auto triple = (src[0] << 16) | (tail_size == 2 ? src[1] << 8 : 0);
+    *(dst++) = alphabet[(triple >> 18) & 0x3f];
+    *(dst++) = alphabet[(triple >> 12) & 0x3f];
+    if (tail_size == 2) *(dst++) = alphabet[(triple >> 6) & 0x3f];
+    if (pad == Pad::kWith) {
+      for (auto i = tail_size; i < 3; ++i) *(dst++) = '=';
+    }
+  }
+
+  return result;
 }
 
 template <typename Base64Decoder>
@@ -47,7 +122,7 @@ std::string Base64Decode(std::string_view data) {
 }  // namespace
 
 std::string Base64Encode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64Encoder>(data, pad);
+  return Base64Encode(data, pad, kAlphabet);
 }
 
 std::string Base64Decode(std::string_view data) {
@@ -56,7 +131,7 @@ std::string Base64Decode(std::string_view data) {
 
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 std::string Base64UrlEncode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64URLEncoder>(data, pad);
+  return Base64Encode(data, pad, kUrlAlphabet);
 }
 
 std::string Base64UrlDecode(std::string_view data) {
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <cryptopp/base64.h>
+
+#include <userver/crypto/base64.hpp>
+
+#ifdef CRYPTOPP_NO_GLOBAL_BYTE
+using CryptoPP::byte;
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string GenerateSource(std::size_t size) {
+  std::string source;
+  source.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    source.push_back(static_cast<char>(i * 37));
+  }
+
+  return source;
+}
+
+// The previous implementation, for comparison
+std::string CryptoPPBase64Encode(std::string_view data) {
+  std::string response;
+  CryptoPP::Base64Encoder encoder(new CryptoPP::StringSink(response));
+  CryptoPP::AlgorithmParameters params = CryptoPP::MakeParameters(
+      CryptoPP::Name::Pad(), true)(CryptoPP::Name::InsertLineBreaks(), false);
+  encoder.IsolatedInitialize(params);
+  encoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
+                        data.size());
+  return response;
+}
+
+}  // namespace
+
+void base64_encode(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Encode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(base64_encode)->RangeMultiplier(8)->Range(8, 256 << 10);
+
+void base64_encode_cryptopp(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CryptoPPBase64Encode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(base64_encode_cryptopp)->RangeMultiplier(8)->Range(8, 256 << 10);
+
+void base64_decode(benchmark::State& state) {
+  const auto source =
+      crypto::base64::Base64Encode(GenerateSource(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Decode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(base64_decode)->RangeMultiplier(8)->Range(8, 256 << 10);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
+
 #include <userver/crypto/base64.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,6 +20,23 @@ TEST(Crypto, Base64) {
   EXPECT_EQ("U/8=", crypto::base64::Base64Encode("S\xff"));
 }
 
+TEST(Crypto, Base64Long) {
+  constexpr std::string_view kText =
+      "The quick brown fox jumps over the lazy dog";
+  EXPECT_EQ("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw==",
+            crypto::base64::Base64Encode(kText));
+
+  std::string data;
+  for (int i = 0; i < 100; ++i) {
+    const auto encoded = crypto::base64::Base64Encode(data);
+    EXPECT_EQ(encoded.size(), (data.size() + 2) / 3 * 4);
+    EXPECT_EQ(data, crypto::base64::Base64Decode(encoded));
+    EXPECT_EQ(data, crypto::base64::Base64Decode(crypto::base64::Base64Encode(
+                        data, crypto::base64::Pad::kWithout)));
+    data.push_back(static_cast<char>(i * 37));
+  }
+}
+
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 TEST(Crypto, Base64Url) {
   EXPECT_EQ("U_8=", crypto::base64::Base64UrlEncode("S\xff"));
@@ -24,6 +44,13 @@ TEST(Crypto, Base64Url) {
                        "S\xff", crypto::base64::Pad::kWithout));
   EXPECT_EQ("S\xFF", crypto::base64::Base64UrlDecode("U_8"));
   EXPECT_EQ("S\xFF", crypto::base64::Base64UrlDecode("U_8="));
+
+  std::string data;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(data, crypto::base64::Base64UrlDecode(
+                        crypto::base64::Base64UrlEncode(data)));
+    data.push_back(static_cast<char>(i * 37));
+  }
 }
 #endif
 
@@ -1,6 +1,7 @@
 #include <userver/crypto/hash.hpp>
 
 #include <array>
+#include <memory>
 
 #include <cryptopp/base64.h>
 #ifndef USERVER_NO_CRYPTOPP_BLAKE2
@@ -12,6 +13,7 @@
 #include <cryptopp/sha.h>
 
 #include <userver/crypto/exception.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <cryptopp/md5.h>
 
@@ -145,6 +147,77 @@ std::string HmacSha1(std::string_view key, std::string_view message,
   return CalculateHmac<CryptoPP::SHA1>(key, message, encoding);
 }
 
+namespace {
+
+std::unique_ptr<CryptoPP::HashTransformation> MakeHash(
+    Hasher::Algorithm algorithm) {
+  switch (algorithm) {
+    case Hasher::Algorithm::kSha1:
+      return std::make_unique<CryptoPP::SHA1>();
+    case Hasher::Algorithm::kSha224:
+      return std::make_unique<CryptoPP::SHA224>();
+    case Hasher::Algorithm::kSha256:
+      return std::make_unique<CryptoPP::SHA256>();
+    case Hasher::Algorithm::kSha384:
+      return std::make_unique<CryptoPP::SHA384>();
+    case Hasher::Algorithm::kSha512:
+      return std::make_unique<CryptoPP::SHA512>();
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+    case Hasher::Algorithm::kBlake2b128:
+      return std::make_unique<AlgoBlake2b128>();
+#endif
+    case Hasher::Algorithm::kWeakMd5:
+      return std::make_unique<CryptoPP::Weak::MD5>();
+  }
+  UINVARIANT(false, "Unexpected Hasher::Algorithm");
+}
+
+}  // namespace
+
+struct Hasher::Impl {
+  std::unique_ptr<CryptoPP::HashTransformation> hash;
+};
+
+Hasher::Hasher(Algorithm algorithm) {
+  try {
+    impl_ = std::make_unique<Impl>(Impl{MakeHash(algorithm)});
+  } catch (const CryptoPP::Exception& exc) {
+    throw CryptoException(exc.what());
+  }
+}
+
+Hasher::Hasher(Hasher&&) noexcept = default;
+
+Hasher& Hasher::operator=(Hasher&&) noexcept = default;
+
+Hasher::~Hasher() = default;
+
+void Hasher::Update(std::string_view data) {
+  UASSERT_MSG(impl_, "Hasher is used after move");
+  try {
+    impl_->hash->Update(reinterpret_cast<const byte*>(data.data()),
+                        data.size());
+  } catch (const CryptoPP::Exception& exc) {
+    throw CryptoException(exc.what());
+  }
+}
+
+std::string Hasher::Finalize(OutputEncoding encoding) {
+  UASSERT_MSG(impl_, "Hasher is used after move");
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): performance
+  std::array<byte, CryptoPP::SHA512::DIGESTSIZE> digest;
+  const auto digest_size = impl_->hash->DigestSize();
+  UASSERT(digest_size <= digest.size());
+  try {
+    // restarts the hash
+    impl_->hash->Final(digest.data());
+  } catch (const CryptoPP::Exception& exc) {
+    throw CryptoException(exc.what());
+  }
+
+  return EncodeArray(digest.data(), digest_size, encoding);
+}
+
 namespace weak {
 
 std::string Md5(std::string_view data, OutputEncoding encoding) {
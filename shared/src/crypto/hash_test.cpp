@@ -104,4 +104,46 @@ TEST(Crypto, Blake2b128) {
 }
 #endif
 
+TEST(Crypto, Hasher) {
+  using Algorithm = crypto::hash::Hasher::Algorithm;
+
+  crypto::hash::Hasher sha256{Algorithm::kSha256};
+  EXPECT_EQ(crypto::hash::Sha256({}), sha256.Finalize());
+
+  sha256.Update("te");
+  sha256.Update({});
+  sha256.Update("st\n");
+  EXPECT_EQ(crypto::hash::Sha256("test\n"), sha256.Finalize());
+  // a new message is started after Finalize()
+  sha256.Update("test");
+  EXPECT_EQ(crypto::hash::Sha256("test", crypto::hash::OutputEncoding::kBase64),
+            sha256.Finalize(crypto::hash::OutputEncoding::kBase64));
+
+  const std::string long_data(100'000, 'x');
+  crypto::hash::Hasher sha512{Algorithm::kSha512};
+  for (std::size_t i = 0; i < long_data.size(); i += 1000) {
+    sha512.Update(std::string_view{long_data}.substr(i, 1000));
+  }
+  EXPECT_EQ(crypto::hash::Sha512(long_data), sha512.Finalize());
+
+  const auto hash = [](Algorithm algorithm, std::string_view data) {
+    crypto::hash::Hasher hasher{algorithm};
+    hasher.Update(data);
+    return hasher.Finalize(crypto::hash::OutputEncoding::kBinary);
+  };
+  constexpr auto kBinary = crypto::hash::OutputEncoding::kBinary;
+  EXPECT_EQ(crypto::hash::Sha1("test", kBinary),
+            hash(Algorithm::kSha1, "test"));
+  EXPECT_EQ(crypto::hash::Sha224("test", kBinary),
+            hash(Algorithm::kSha224, "test"));
+  EXPECT_EQ(crypto::hash::Sha384("test", kBinary),
+            hash(Algorithm::kSha384, "test"));
+  EXPECT_EQ(crypto::hash::weak::Md5("test", kBinary),
+            hash(Algorithm::kWeakMd5, "test"));
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+  EXPECT_EQ(crypto::hash::Blake2b128("test", kBinary),
+            hash(Algorithm::kBlake2b128, "test"));
+#endif
+}
+
 USERVER_NAMESPACE_END
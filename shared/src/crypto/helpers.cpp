@@ -94,6 +94,40 @@ EvpMdCtx::~EvpMdCtx() {
 EvpMdCtx::EvpMdCtx(EvpMdCtx&& other) noexcept
     : ctx_(std::exchange(other.ctx_, nullptr)) {}
 
+std::shared_ptr<EVP_MD_CTX> MakeSharedEvpMdCtx() {
+  auto ctx = std::make_shared<EvpMdCtx>();
+  return {ctx, ctx->Get()};
+}
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local bool thread_local_md_ctx_in_use = false;
+
+}  // namespace
+
+ThreadLocalEvpMdCtxCopy::ThreadLocalEvpMdCtxCopy(const EVP_MD_CTX* from) {
+  thread_local EvpMdCtx thread_local_ctx;
+  UASSERT_MSG(!thread_local_md_ctx_in_use,
+              "Nested use of the thread-local EVP_MD_CTX");
+
+  ctx_ = thread_local_ctx.Get();
+  if (1 != EVP_MD_CTX_copy_ex(ctx_, from)) {
+    throw CryptoException(FormatSslError("Failed to copy EVP_MD_CTX"));
+  }
+  thread_local_md_ctx_in_use = true;
+}
+
+ThreadLocalEvpMdCtxCopy::~ThreadLocalEvpMdCtxCopy() {
+  // releases the EVP_PKEY_CTX and the key held by the copy
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+  EVP_MD_CTX_reset(ctx_);
+#else
+  EVP_MD_CTX_cleanup(ctx_);
+#endif
+  thread_local_md_ctx_in_use = false;
+}
+
 decltype(&crypto::hash::HmacSha256) GetHmacFuncByEnum(DigestSize bits) {
   switch (bits) {
     case DigestSize::k160:
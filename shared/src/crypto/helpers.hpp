@@ -30,6 +30,29 @@ class EvpMdCtx {
   EVP_MD_CTX* ctx_;
 };
 
+std::shared_ptr<EVP_MD_CTX> MakeSharedEvpMdCtx();
+
+using EvpPkeyCtxPtr =
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)>;
+
+// A thread-local EVP_MD_CTX holding a copy of an initialized context, is reset
+// on destruction. Saves the allocations and the algorithm lookups of
+// EVP_Digest{Sign,Verify}Init for each message. Must not outlive a coroutine
+// suspension.
+class ThreadLocalEvpMdCtxCopy final {
+ public:
+  explicit ThreadLocalEvpMdCtxCopy(const EVP_MD_CTX* from);
+  ~ThreadLocalEvpMdCtxCopy();
+
+  ThreadLocalEvpMdCtxCopy(const ThreadLocalEvpMdCtxCopy&) = delete;
+  ThreadLocalEvpMdCtxCopy& operator=(const ThreadLocalEvpMdCtxCopy&) = delete;
+
+  EVP_MD_CTX* Get() { return ctx_; }
+
+ private:
+  EVP_MD_CTX* ctx_;
+};
+
 constexpr size_t GetDigestLength(DigestSize digest_size) {
   size_t bits = 0;
   switch (digest_size) {
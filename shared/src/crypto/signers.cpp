@@ -124,21 +124,41 @@ DsaSigner<type, bits>::DsaSigner(const std::string& key,
       throw SignError("Non-RSA key supplied for " + Name() + " signer");
     }
   }
-}
 
-template <DsaType type, DigestSize bits>
-std::string DsaSigner<type, bits>::Sign(
-    std::initializer_list<std::string_view> data) const {
-  EvpMdCtx ctx;
+  auto sign_ctx = MakeSharedEvpMdCtx();
   EVP_PKEY_CTX* pkey_ctx = nullptr;  // non-owning
-  if (1 != EVP_DigestSignInit(ctx.Get(), &pkey_ctx, GetShaMdByEnum(bits),
+  if (1 != EVP_DigestSignInit(sign_ctx.get(), &pkey_ctx, GetShaMdByEnum(bits),
                               nullptr, pkey_.GetNative())) {
     throw SignError(FormatSslError("Failed to sign: EVP_DigestSignInit"));
   }
 
   if constexpr (type == DsaType::kRsaPss) {
     SetupJwaRsaPssPadding(pkey_ctx, bits);
+  } else {
+    EvpPkeyCtxPtr digest_ctx(EVP_PKEY_CTX_new(pkey_.GetNative(), nullptr),
+                             EVP_PKEY_CTX_free);
+    if (!digest_ctx) {
+      throw SignError(
+          FormatSslError("Failed to sign digest: EVP_PKEY_CTX_new"));
+    }
+    if (1 != EVP_PKEY_sign_init(digest_ctx.get())) {
+      throw SignError(
+          FormatSslError("Failed to sign digest: EVP_PKEY_sign_init"));
+    }
+    if (EVP_PKEY_CTX_set_signature_md(digest_ctx.get(),
+                                      GetShaMdByEnum(bits)) <= 0) {
+      throw SignError(FormatSslError(
+          "Failed to sign digest: EVP_PKEY_CTX_set_signature_md"));
+    }
+    sign_digest_ctx_ = std::move(digest_ctx);
   }
+  sign_ctx_ = std::move(sign_ctx);
+}
+
+template <DsaType type, DigestSize bits>
+std::string DsaSigner<type, bits>::Sign(
+    std::initializer_list<std::string_view> data) const {
+  ThreadLocalEvpMdCtxCopy ctx(sign_ctx_.get());
 
   for (const auto& part : data) {
     if (1 != EVP_DigestSignUpdate(ctx.Get(), part.data(), part.size())) {
@@ -177,19 +197,10 @@ std::string DsaSigner<type, bits>::SignDigest(std::string_view digest) const {
     throw SignError("Invalid digest size for " + Name() + " signer");
   }
 
-  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> pkey_ctx(
-      EVP_PKEY_CTX_new(pkey_.GetNative(), nullptr), EVP_PKEY_CTX_free);
+  EvpPkeyCtxPtr pkey_ctx(EVP_PKEY_CTX_dup(sign_digest_ctx_.get()),
+                         EVP_PKEY_CTX_free);
   if (!pkey_ctx) {
-    throw SignError(FormatSslError("Failed to sign digest: EVP_PKEY_CTX_new"));
-  }
-  if (1 != EVP_PKEY_sign_init(pkey_ctx.get())) {
-    throw SignError(
-        FormatSslError("Failed to sign digest: EVP_PKEY_sign_init"));
-  }
-  if (EVP_PKEY_CTX_set_signature_md(pkey_ctx.get(), GetShaMdByEnum(bits)) <=
-      0) {
-    throw SignError(
-        FormatSslError("Failed to sign digest: EVP_PKEY_CTX_set_signature_md"));
+    throw SignError(FormatSslError("Failed to sign digest: EVP_PKEY_CTX_dup"));
   }
 
   size_t siglen = 0;
@@ -118,6 +118,37 @@ DsaVerifier<type, bits>::DsaVerifier(PublicKey pubkey)
                               " verifier");
     }
   }
+
+  auto verify_ctx = MakeSharedEvpMdCtx();
+  EVP_PKEY_CTX* pkey_ctx = nullptr;  // non-owning
+  if (1 != EVP_DigestVerifyInit(verify_ctx.get(), &pkey_ctx,
+                                GetShaMdByEnum(bits), nullptr,
+                                pkey_.GetNative())) {
+    throw VerificationError(
+        FormatSslError("Failed to verify: EVP_DigestVerifyInit"));
+  }
+
+  if constexpr (type == DsaType::kRsaPss) {
+    SetupJwaRsaPssPadding(pkey_ctx, bits);
+  } else {
+    EvpPkeyCtxPtr digest_ctx(EVP_PKEY_CTX_new(pkey_.GetNative(), nullptr),
+                             EVP_PKEY_CTX_free);
+    if (!digest_ctx) {
+      throw VerificationError(
+          FormatSslError("Failed to verify digest: EVP_PKEY_CTX_new"));
+    }
+    if (1 != EVP_PKEY_verify_init(digest_ctx.get())) {
+      throw VerificationError(
+          FormatSslError("Failed to verify digest: EVP_PKEY_verify_init"));
+    }
+    if (EVP_PKEY_CTX_set_signature_md(digest_ctx.get(),
+                                      GetShaMdByEnum(bits)) <= 0) {
+      throw VerificationError(FormatSslError(
+          "Failed to sign digest: EVP_PKEY_CTX_set_signature_md"));
+    }
+    verify_digest_ctx_ = std::move(digest_ctx);
+  }
+  verify_ctx_ = std::move(verify_ctx);
 }
 
 template <DsaType type, DigestSize bits>
@@ -128,17 +159,7 @@ template <DsaType type, DigestSize bits>
 void DsaVerifier<type, bits>::Verify(
     std::initializer_list<std::string_view> data,
     std::string_view raw_signature) const {
-  EvpMdCtx ctx;
-  EVP_PKEY_CTX* pkey_ctx = nullptr;
-  if (1 != EVP_DigestVerifyInit(ctx.Get(), &pkey_ctx, GetShaMdByEnum(bits),
-                                nullptr, pkey_.GetNative())) {
-    throw VerificationError(
-        FormatSslError("Failed to verify: EVP_DigestVerifyInit"));
-  }
-
-  if constexpr (type == DsaType::kRsaPss) {
-    SetupJwaRsaPssPadding(pkey_ctx, bits);
-  }
+  ThreadLocalEvpMdCtxCopy ctx(verify_ctx_.get());
 
   for (const auto& part : data) {
     if (1 != EVP_DigestVerifyUpdate(ctx.Get(), part.data(), part.size())) {
@@ -176,20 +197,11 @@ void DsaVerifier<type, bits>::VerifyDigest(
     throw VerificationError("Invalid digest size for " + Name() + " verifier");
   }
 
-  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> pkey_ctx(
-      EVP_PKEY_CTX_new(pkey_.GetNative(), nullptr), EVP_PKEY_CTX_free);
+  EvpPkeyCtxPtr pkey_ctx(EVP_PKEY_CTX_dup(verify_digest_ctx_.get()),
+                         EVP_PKEY_CTX_free);
   if (!pkey_ctx) {
     throw VerificationError(
-        FormatSslError("Failed to verify digest: EVP_PKEY_CTX_new"));
-  }
-  if (1 != EVP_PKEY_verify_init(pkey_ctx.get())) {
-    throw VerificationError(
-        FormatSslError("Failed to verify digest: EVP_PKEY_verify_init"));
-  }
-  if (EVP_PKEY_CTX_set_signature_md(pkey_ctx.get(), GetShaMdByEnum(bits)) <=
-      0) {
-    throw VerificationError(
-        FormatSslError("Failed to sign digest: EVP_PKEY_CTX_set_signature_md"));
+        FormatSslError("Failed to verify digest: EVP_PKEY_CTX_dup"));
   }
 
   int verification_result = -1;
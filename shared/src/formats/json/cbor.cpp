@@ -0,0 +1,439 @@
+#include <userver/formats/json/cbor.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <boost/container/small_vector.hpp>
+#include <fmt/format.h>
+#include <rapidjson/document.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/types_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+::rapidjson::CrtAllocator g_allocator;
+
+// RFC 8949, 3.1. Major Types
+enum class MajorType : std::uint8_t {
+  kUnsigned = 0,
+  kNegative = 1,
+  kBytes = 2,
+  kText = 3,
+  kArray = 4,
+  kMap = 5,
+  kTag = 6,
+  kSimple = 7,
+};
+
+// additional information values
+constexpr std::uint8_t kOneByteArg = 24;
+constexpr std::uint8_t kTwoBytesArg = 25;
+constexpr std::uint8_t kFourBytesArg = 26;
+constexpr std::uint8_t kEightBytesArg = 27;
+constexpr std::uint8_t kIndefinite = 31;
+
+// simple values and floats of the major type 7
+constexpr std::uint8_t kFalse = 20;
+constexpr std::uint8_t kTrue = 21;
+constexpr std::uint8_t kNull = 22;
+constexpr std::uint8_t kUndefined = 23;
+constexpr std::uint8_t kHalfFloat = kTwoBytesArg;
+constexpr std::uint8_t kSingleFloat = kFourBytesArg;
+constexpr std::uint8_t kDoubleFloat = kEightBytesArg;
+
+constexpr std::uint8_t kBreak = 0xFF;
+
+constexpr std::uint8_t MakeInitialByte(MajorType major, std::uint8_t info) {
+  return static_cast<std::uint8_t>(static_cast<std::uint8_t>(major) << 5 |
+                                   info);
+}
+
+void WriteBigEndian(std::string& out, std::uint64_t value,
+                    std::size_t bytes) {
+  for (std::size_t i = bytes; i-- > 0;) {
+    out.push_back(static_cast<char>(value >> (i * 8)));
+  }
+}
+
+void WriteHead(std::string& out, MajorType major, std::uint64_t arg) {
+  if (arg < kOneByteArg) {
+    out.push_back(static_cast<char>(
+        MakeInitialByte(major, static_cast<std::uint8_t>(arg))));
+  } else if (arg <= std::numeric_limits<std::uint8_t>::max()) {
+    out.push_back(static_cast<char>(MakeInitialByte(major, kOneByteArg)));
+    WriteBigEndian(out, arg, 1);
+  } else if (arg <= std::numeric_limits<std::uint16_t>::max()) {
+    out.push_back(static_cast<char>(MakeInitialByte(major, kTwoBytesArg)));
+    WriteBigEndian(out, arg, 2);
+  } else if (arg <= std::numeric_limits<std::uint32_t>::max()) {
+    out.push_back(static_cast<char>(MakeInitialByte(major, kFourBytesArg)));
+    WriteBigEndian(out, arg, 4);
+  } else {
+    out.push_back(static_cast<char>(MakeInitialByte(major, kEightBytesArg)));
+    WriteBigEndian(out, arg, 8);
+  }
+}
+
+void WriteDouble(std::string& out, double value) {
+  const auto single = static_cast<float>(value);
+  if (static_cast<double>(single) == value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &single, sizeof(bits));
+    out.push_back(
+        static_cast<char>(MakeInitialByte(MajorType::kSimple, kSingleFloat)));
+    WriteBigEndian(out, bits, sizeof(bits));
+  } else {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    out.push_back(
+        static_cast<char>(MakeInitialByte(MajorType::kSimple, kDoubleFloat)));
+    WriteBigEndian(out, bits, sizeof(bits));
+  }
+}
+
+void WriteString(std::string& out, const impl::Value& value) {
+  WriteHead(out, MajorType::kText, value.GetStringLength());
+  out.append(value.GetString(), value.GetStringLength());
+}
+
+void WriteValue(std::string& out, const impl::Value& value) {
+  switch (value.GetType()) {
+    case rapidjson::kNullType:
+      out.push_back(
+          static_cast<char>(MakeInitialByte(MajorType::kSimple, kNull)));
+      break;
+    case rapidjson::kFalseType:
+      out.push_back(
+          static_cast<char>(MakeInitialByte(MajorType::kSimple, kFalse)));
+      break;
+    case rapidjson::kTrueType:
+      out.push_back(
+          static_cast<char>(MakeInitialByte(MajorType::kSimple, kTrue)));
+      break;
+    case rapidjson::kStringType:
+      WriteString(out, value);
+      break;
+    case rapidjson::kNumberType:
+      if (value.IsUint64()) {
+        WriteHead(out, MajorType::kUnsigned, value.GetUint64());
+      } else if (value.IsInt64()) {
+        // -1 - value
+        WriteHead(out, MajorType::kNegative,
+                  ~static_cast<std::uint64_t>(value.GetInt64()));
+      } else {
+        WriteDouble(out, value.GetDouble());
+      }
+      break;
+    case rapidjson::kArrayType:
+      WriteHead(out, MajorType::kArray, value.Size());
+      for (const auto& elem : value.GetArray()) WriteValue(out, elem);
+      break;
+    case rapidjson::kObjectType:
+      WriteHead(out, MajorType::kMap, value.MemberCount());
+      for (const auto& member : value.GetObject()) {
+        WriteString(out, member.name);
+        WriteValue(out, member.value);
+      }
+      break;
+  }
+}
+
+double DecodeHalfFloat(std::uint16_t half) {
+  const int exponent = (half >> 10) & 0x1F;
+  const int mantissa = half & 0x3FF;
+  double value = 0;
+  if (exponent == 0) {
+    value = std::ldexp(mantissa, -24);
+  } else if (exponent != 0x1F) {
+    value = std::ldexp(mantissa + 1024, exponent - 25);
+  } else {
+    value = mantissa == 0 ? std::numeric_limits<double>::infinity()
+                          : std::numeric_limits<double>::quiet_NaN();
+  }
+  return (half & 0x8000) ? -value : value;
+}
+
+/// Generator of the SAX events for rapidjson::GenericDocument::Populate()
+class CborReader final {
+ public:
+  explicit CborReader(std::string_view data) : data_(data) {}
+
+  bool operator()(impl::Document& handler);
+
+ private:
+  struct Frame {
+    bool is_map;
+    bool indefinite;
+    bool expects_key;
+    // items left of a definite length container, pairs for the maps
+    std::uint64_t remaining;
+    rapidjson::SizeType count;
+  };
+
+  [[noreturn]] void Throw(std::string_view what) const;
+
+  std::uint8_t ReadByte();
+  std::uint64_t ReadBigEndian(std::size_t bytes);
+  std::uint64_t ReadArgument(std::uint8_t info);
+  std::string_view ReadBytes(std::uint64_t size);
+  rapidjson::SizeType ReadLength(std::uint8_t info);
+  void ReadText(std::uint8_t info, std::string& buffer);
+  void ReadFloat(impl::Document& handler, std::uint8_t info);
+
+  bool IsFinished(const Frame& frame);
+  void OnItem();
+
+  std::string_view data_;
+  std::size_t pos_{0};
+  boost::container::small_vector<Frame, 16> stack_;
+};
+
+void CborReader::Throw(std::string_view what) const {
+  throw ParseException(
+      fmt::format("CBOR parse error at offset {}: {}", pos_, what));
+}
+
+std::uint8_t CborReader::ReadByte() {
+  if (pos_ >= data_.size()) Throw("unexpected end of data");
+  return static_cast<std::uint8_t>(data_[pos_++]);
+}
+
+std::uint64_t CborReader::ReadBigEndian(std::size_t bytes) {
+  if (data_.size() - pos_ < bytes) Throw("unexpected end of data");
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < bytes; ++i) {
+    value = value << 8 | static_cast<std::uint8_t>(data_[pos_++]);
+  }
+  return value;
+}
+
+std::uint64_t CborReader::ReadArgument(std::uint8_t info) {
+  if (info < kOneByteArg) return info;
+  switch (info) {
+    case kOneByteArg:
+      return ReadBigEndian(1);
+    case kTwoBytesArg:
+      return ReadBigEndian(2);
+    case kFourBytesArg:
+      return ReadBigEndian(4);
+    case kEightBytesArg:
+      return ReadBigEndian(8);
+    default:
+      Throw("malformed argument");
+  }
+}
+
+std::string_view CborReader::ReadBytes(std::uint64_t size) {
+  if (data_.size() - pos_ < size) Throw("unexpected end of data");
+  const auto result = data_.substr(pos_, size);
+  pos_ += size;
+  return result;
+}
+
+rapidjson::SizeType CborReader::ReadLength(std::uint8_t info) {
+  const auto length = ReadArgument(info);
+  // every item takes at least a byte
+  if (length > data_.size() - pos_ ||
+      length > std::numeric_limits<rapidjson::SizeType>::max()) {
+    Throw("length exceeds the data size");
+  }
+  return static_cast<rapidjson::SizeType>(length);
+}
+
+void CborReader::ReadText(std::uint8_t info, std::string& buffer) {
+  buffer.clear();
+  if (info != kIndefinite) {
+    buffer.append(ReadBytes(ReadLength(info)));
+    return;
+  }
+
+  while (true) {
+    const auto initial = ReadByte();
+    if (initial == kBreak) return;
+    if (initial >> 5 != static_cast<std::uint8_t>(MajorType::kText) ||
+        (initial & 0x1F) == kIndefinite) {
+      Throw("indefinite length text string chunk is not a text string");
+    }
+    buffer.append(ReadBytes(ReadLength(initial & 0x1F)));
+  }
+}
+
+void CborReader::ReadFloat(impl::Document& handler, std::uint8_t info) {
+  double value = 0;
+  if (info == kHalfFloat) {
+    value = DecodeHalfFloat(static_cast<std::uint16_t>(ReadBigEndian(2)));
+  } else if (info == kSingleFloat) {
+    const auto bits = static_cast<std::uint32_t>(ReadBigEndian(4));
+    float single = 0;
+    std::memcpy(&single, &bits, sizeof(single));
+    value = single;
+  } else {
+    const auto bits = ReadBigEndian(8);
+    std::memcpy(&value, &bits, sizeof(value));
+  }
+  if (!std::isfinite(value)) Throw("non-finite floats are not allowed in JSON");
+  handler.Double(value);
+}
+
+bool CborReader::IsFinished(const Frame& frame) {
+  if (!frame.indefinite) return frame.remaining == 0;
+  if (pos_ < data_.size() && static_cast<std::uint8_t>(data_[pos_]) == kBreak) {
+    if (frame.is_map && !frame.expects_key) Throw("map key without a value");
+    ++pos_;
+    return true;
+  }
+  return false;
+}
+
+void CborReader::OnItem() {
+  if (stack_.empty()) return;
+  auto& frame = stack_.back();
+  if (frame.is_map) {
+    if (frame.expects_key) {
+      frame.expects_key = false;
+      return;
+    }
+    frame.expects_key = true;
+  }
+  if (frame.count == std::numeric_limits<rapidjson::SizeType>::max()) {
+    Throw("too many items in a container");
+  }
+  ++frame.count;
+  if (!frame.indefinite) --frame.remaining;
+}
+
+bool CborReader::operator()(impl::Document& handler) {
+  std::string text;
+  while (true) {
+    if (!stack_.empty()) {
+      auto& frame = stack_.back();
+      if (IsFinished(frame)) {
+        if (frame.is_map) {
+          handler.EndObject(frame.count);
+        } else {
+          handler.EndArray(frame.count);
+        }
+        stack_.pop_back();
+        OnItem();
+        if (stack_.empty()) break;
+        continue;
+      }
+    }
+
+    const auto initial = ReadByte();
+    const auto major = static_cast<MajorType>(initial >> 5);
+    const auto info = static_cast<std::uint8_t>(initial & 0x1F);
+
+    if (!stack_.empty() && stack_.back().is_map && stack_.back().expects_key) {
+      if (major != MajorType::kText) Throw("map keys must be text strings");
+      ReadText(info, text);
+      handler.Key(text.data(), text.size(), true);
+      OnItem();
+      continue;
+    }
+
+    switch (major) {
+      case MajorType::kUnsigned:
+        handler.Uint64(ReadArgument(info));
+        break;
+      case MajorType::kNegative: {
+        const auto arg = ReadArgument(info);
+        if (arg > static_cast<std::uint64_t>(
+                      std::numeric_limits<std::int64_t>::max())) {
+          Throw("negative integer is out of the int64 range");
+        }
+        // -1 - arg
+        handler.Int64(static_cast<std::int64_t>(~arg));
+        break;
+      }
+      case MajorType::kBytes:
+        Throw("byte strings are not representable in JSON");
+      case MajorType::kText:
+        ReadText(info, text);
+        handler.String(text.data(), text.size(), true);
+        break;
+      case MajorType::kArray:
+      case MajorType::kMap: {
+        const bool is_map = major == MajorType::kMap;
+        const bool indefinite = info == kIndefinite;
+        const auto length = indefinite ? 0 : ReadLength(info);
+        if (is_map) {
+          if (length > (data_.size() - pos_) / 2) {
+            Throw("length exceeds the data size");
+          }
+          handler.StartObject();
+        } else {
+          handler.StartArray();
+        }
+        stack_.push_back(Frame{is_map, indefinite, true, length, 0});
+        continue;
+      }
+      case MajorType::kTag:
+        // the tagged item follows, the semantics of the tag are not kept
+        ReadArgument(info);
+        continue;
+      case MajorType::kSimple:
+        switch (info) {
+          case kFalse:
+            handler.Bool(false);
+            break;
+          case kTrue:
+            handler.Bool(true);
+            break;
+          case kNull:
+          case kUndefined:
+            handler.Null();
+            break;
+          case kHalfFloat:
+          case kSingleFloat:
+          case kDoubleFloat:
+            ReadFloat(handler, info);
+            break;
+          default:
+            Throw(info == kIndefinite ? "unexpected break"
+                                      : "unsupported simple value");
+        }
+        break;
+    }
+    OnItem();
+    if (stack_.empty()) break;
+  }
+
+  if (pos_ != data_.size()) Throw("trailing data after the data item");
+  return true;
+}
+
+}  // namespace
+
+std::string ToCborString(const formats::json::Value& doc) {
+  std::string result;
+  WriteValue(result, doc.GetNative());
+  return result;
+}
+
+formats::json::Value FromCborString(std::string_view cbor) {
+  if (cbor.empty()) {
+    throw ParseException("CBOR data is empty");
+  }
+
+  impl::Document json{&g_allocator};
+  CborReader reader{cbor};
+  json.Populate(reader);
+  impl::CheckKeyUniqueness(&json);
+
+  return Value{impl::VersionedValuePtr::Create(std::move(json))};
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
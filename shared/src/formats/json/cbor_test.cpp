@@ -0,0 +1,146 @@
+#include <userver/formats/json/cbor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using formats::json::FromCborString;
+using formats::json::FromString;
+using formats::json::ToCborString;
+
+std::string Bytes(std::initializer_list<unsigned char> bytes) {
+  return {bytes.begin(), bytes.end()};
+}
+
+}  // namespace
+
+TEST(FormatsJsonCbor, ToCbor) {
+  // RFC 8949, Appendix A
+  EXPECT_EQ(ToCborString(FromString("0")), Bytes({0x00}));
+  EXPECT_EQ(ToCborString(FromString("23")), Bytes({0x17}));
+  EXPECT_EQ(ToCborString(FromString("24")), Bytes({0x18, 0x18}));
+  EXPECT_EQ(ToCborString(FromString("1000")), Bytes({0x19, 0x03, 0xe8}));
+  EXPECT_EQ(ToCborString(FromString("1000000")),
+            Bytes({0x1a, 0x00, 0x0f, 0x42, 0x40}));
+  EXPECT_EQ(ToCborString(FromString("18446744073709551615")),
+            Bytes({0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+  EXPECT_EQ(ToCborString(FromString("-1")), Bytes({0x20}));
+  EXPECT_EQ(ToCborString(FromString("-1000")), Bytes({0x39, 0x03, 0xe7}));
+  EXPECT_EQ(ToCborString(FromString("1.5")),
+            Bytes({0xfa, 0x3f, 0xc0, 0x00, 0x00}));
+  EXPECT_EQ(ToCborString(FromString("1.1")),
+            Bytes({0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a}));
+  EXPECT_EQ(ToCborString(FromString("false")), Bytes({0xf4}));
+  EXPECT_EQ(ToCborString(FromString("true")), Bytes({0xf5}));
+  EXPECT_EQ(ToCborString(FromString("null")), Bytes({0xf6}));
+  EXPECT_EQ(ToCborString(FromString(R"("IETF")")),
+            Bytes({0x64, 0x49, 0x45, 0x54, 0x46}));
+  EXPECT_EQ(ToCborString(FromString("[1,[2,3]]")),
+            Bytes({0x82, 0x01, 0x82, 0x02, 0x03}));
+  EXPECT_EQ(ToCborString(FromString(R"({"a":1,"b":[2,3]})")),
+            Bytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03}));
+}
+
+TEST(FormatsJsonCbor, FromCbor) {
+  EXPECT_EQ(FromCborString(Bytes({0x19, 0x03, 0xe8})).As<int>(), 1000);
+  EXPECT_EQ(FromCborString(Bytes({0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                  0xff, 0xff}))
+                .As<std::int64_t>(),
+            std::numeric_limits<std::int64_t>::min());
+  // half precision floats
+  EXPECT_EQ(FromCborString(Bytes({0xf9, 0x3e, 0x00})).As<double>(), 1.5);
+  EXPECT_EQ(FromCborString(Bytes({0xf9, 0x7b, 0xff})).As<double>(), 65504.0);
+  EXPECT_EQ(FromCborString(Bytes({0xf9, 0x00, 0x01})).As<double>(),
+            5.960464477539063e-8);
+  EXPECT_EQ(FromCborString(Bytes({0xf9, 0xc4, 0x00})).As<double>(), -4.0);
+  // undefined
+  EXPECT_TRUE(FromCborString(Bytes({0xf7})).IsNull());
+  // tag 1 (epoch-based date/time) is skipped
+  EXPECT_EQ(FromCborString(Bytes({0xc1, 0x1a, 0x51, 0x4b, 0x67, 0xb0}))
+                .As<std::int64_t>(),
+            1363896240);
+
+  // indefinite lengths
+  EXPECT_EQ(FromCborString(Bytes({0x9f, 0x01, 0x82, 0x02, 0x03, 0x9f, 0x04,
+                                  0x05, 0xff, 0xff})),
+            FromString("[1,[2,3],[4,5]]"));
+  EXPECT_EQ(FromCborString(Bytes({0xbf, 0x61, 0x61, 0x01, 0x61, 0x62, 0x9f,
+                                  0x02, 0x03, 0xff, 0xff})),
+            FromString(R"({"a":1,"b":[2,3]})"));
+  EXPECT_EQ(
+      FromCborString(Bytes({0x7f, 0x65, 0x73, 0x74, 0x72, 0x65, 0x61, 0x64,
+                            0x6d, 0x69, 0x6e, 0x67, 0xff})),
+      FromString(R"("streaming")"));
+  EXPECT_EQ(FromCborString(Bytes({0x9f, 0xff})), FromString("[]"));
+  EXPECT_EQ(FromCborString(Bytes({0xa0})), FromString("{}"));
+}
+
+TEST(FormatsJsonCbor, RoundTrip) {
+  const auto json = FromString(R"({
+    "int": -42,
+    "uint": 18446744073709551615,
+    "min": -9223372036854775808,
+    "double": 0.1,
+    "float": 0.25,
+    "string": "строка\u0000with zero",
+    "empty": {"array": [], "object": {}, "string": ""},
+    "nested": [[[[null, true, false]]]]
+  })");
+  const auto cbor = ToCborString(json);
+  EXPECT_EQ(FromCborString(cbor), json);
+
+  formats::json::ValueBuilder builder(formats::common::Type::kArray);
+  for (int i = 0; i < 70000; ++i) builder.PushBack(i);
+  const auto big = builder.ExtractValue();
+  EXPECT_EQ(FromCborString(ToCborString(big)), big);
+}
+
+TEST(FormatsJsonCbor, Errors) {
+  using formats::json::ParseException;
+
+  EXPECT_THROW(FromCborString({}), ParseException);
+  // truncated
+  EXPECT_THROW(FromCborString(Bytes({0x19, 0x03})), ParseException);
+  EXPECT_THROW(FromCborString(Bytes({0x82, 0x01})), ParseException);
+  EXPECT_THROW(FromCborString(Bytes({0x9f, 0x01})), ParseException);
+  EXPECT_THROW(FromCborString(Bytes({0x64, 0x49})), ParseException);
+  // length is bigger than the data
+  EXPECT_THROW(FromCborString(Bytes({0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                     0xff, 0xff, 0x01})),
+               ParseException);
+  // trailing data
+  EXPECT_THROW(FromCborString(Bytes({0x01, 0x02})), ParseException);
+  // byte string
+  EXPECT_THROW(FromCborString(Bytes({0x41, 0x00})), ParseException);
+  // non-string key
+  EXPECT_THROW(FromCborString(Bytes({0xa1, 0x01, 0x02})), ParseException);
+  // duplicate keys
+  EXPECT_THROW(
+      FromCborString(Bytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x61, 0x02})),
+      ParseException);
+  // key without value
+  EXPECT_THROW(FromCborString(Bytes({0xbf, 0x61, 0x61, 0xff})), ParseException);
+  // break outside of an indefinite length item
+  EXPECT_THROW(FromCborString(Bytes({0xff})), ParseException);
+  EXPECT_THROW(FromCborString(Bytes({0x81, 0xff})), ParseException);
+  // NaN and infinity
+  EXPECT_THROW(FromCborString(Bytes({0xf9, 0x7e, 0x00})), ParseException);
+  EXPECT_THROW(FromCborString(Bytes({0xfa, 0x7f, 0x80, 0x00, 0x00})),
+               ParseException);
+  // -2^64
+  EXPECT_THROW(FromCborString(Bytes({0x3b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                     0xff, 0xff})),
+               ParseException);
+  // reserved additional information
+  EXPECT_THROW(FromCborString(Bytes({0x1c})), ParseException);
+  // simple value
+  EXPECT_THROW(FromCborString(Bytes({0xf0})), ParseException);
+}
+
+USERVER_NAMESPACE_END
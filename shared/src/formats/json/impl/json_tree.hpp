@@ -70,6 +70,8 @@ class TreeIterFrame {
 std::string MakePath(const Value* root, const Value* node, int node_depth);
 /// Transform nodes onto stack into string
 std::string ExtractPath(const std::vector<TreeIterFrame>& stack);
+/// @throws ParseException if an object in the tree has duplicate keys
+void CheckKeyUniqueness(const Value* root);
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,118 @@
+#include <formats/json/impl/string_writer.hpp>
+
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+// "\u00XX" for the control characters
+constexpr std::size_t kMaxEscapedCharSize = 6;
+
+constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+
+bool NeedsEscape(char c) noexcept {
+  return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+char* WriteEscapedChar(char c, char* out) noexcept {
+  *out++ = '\\';
+  switch (c) {
+    case '"':
+    case '\\':
+      *out++ = c;
+      break;
+    case '\b':
+      *out++ = 'b';
+      break;
+    case '\f':
+      *out++ = 'f';
+      break;
+    case '\n':
+      *out++ = 'n';
+      break;
+    case '\r':
+      *out++ = 'r';
+      break;
+    case '\t':
+      *out++ = 't';
+      break;
+    default: {
+      const auto code = static_cast<unsigned char>(c);
+      *out++ = 'u';
+      *out++ = '0';
+      *out++ = '0';
+      *out++ = kHexDigits[code >> 4];
+      *out++ = kHexDigits[code & 0xF];
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+void WriteEscapedString(rapidjson::StringBuffer& buffer, std::string_view str) {
+  // the room for the string as is, the escapes extend it and the rest is
+  // returned after the write
+  char* out = buffer.Push(str.size() + 2);
+  char* room_end = out + str.size() + 2;
+  const char* in = str.data();
+  const char* const end = in + str.size();
+
+  const auto write_escaped = [&buffer, &out, &room_end](char c) {
+    // the extension follows the room, which may be moved by the buffer
+    constexpr auto kExtraSize = kMaxEscapedCharSize - 1;
+    const auto room_left = room_end - out;
+    room_end = buffer.Push(kExtraSize) + kExtraSize;
+    out = WriteEscapedChar(c, room_end - kExtraSize - room_left);
+  };
+
+  *out++ = '"';
+#ifdef __SSE2__
+  const auto quote = _mm_set1_epi8('"');
+  const auto backslash = _mm_set1_epi8('\\');
+  const auto control_max = _mm_set1_epi8(0x1F);
+  while (end - in >= static_cast<std::ptrdiff_t>(sizeof(__m128i))) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    // the whole block is stored, the output has room for it in any case
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chunk);
+
+    // unsigned chunk <= 0x1F
+    const auto control =
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, control_max), control_max);
+    const auto special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                      _mm_cmpeq_epi8(chunk, backslash));
+    const auto mask = _mm_movemask_epi8(_mm_or_si128(control, special));
+    if (mask == 0) {
+      in += sizeof(__m128i);
+      out += sizeof(__m128i);
+      continue;
+    }
+
+    const auto pos = __builtin_ctz(mask);
+    out += pos;
+    write_escaped(in[pos]);
+    in += pos + 1;
+  }
+#endif
+  for (; in != end; ++in) {
+    if (NeedsEscape(*in)) {
+      write_escaped(*in);
+    } else {
+      *out++ = *in;
+    }
+  }
+  *out++ = '"';
+
+  buffer.Pop(room_end - out);
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string_view>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <utils/impl/cooperative_yield.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Writes `str` as a quoted JSON string, the characters that need no escaping
+/// are found with SIMD and copied in blocks
+void WriteEscapedString(rapidjson::StringBuffer& buffer, std::string_view str);
+
+/// rapidjson::Writer that escapes the strings and keys with
+/// WriteEscapedString() instead of the per-character loop
+class StringWriter : public rapidjson::Writer<rapidjson::StringBuffer> {
+ public:
+  using rapidjson::Writer<rapidjson::StringBuffer>::Writer;
+
+  bool String(const Ch* str, rapidjson::SizeType length, bool copy = false) {
+    static_cast<void>(copy);
+    Prefix(rapidjson::kStringType);
+    WriteEscapedString(*os_, std::string_view{str, length});
+    return EndValue(true);
+  }
+
+  bool Key(const Ch* str, rapidjson::SizeType length, bool copy = false) {
+    return String(str, length, copy);
+  }
+};
+
+/// StringWriter with the yield points of engine::YieldIfTimeSliceExceeded()
+/// at the objects and the arrays, so that the serialization of a huge document
+/// does not stall the other tasks of the worker
+class YieldingStringWriter final : public StringWriter {
+ public:
+  using StringWriter::StringWriter;
+
+  bool StartObject() {
+    utils::impl::CooperativeYield();
+    return StringWriter::StartObject();
+  }
+
+  bool StartArray() {
+    utils::impl::CooperativeYield();
+    return StringWriter::StartArray();
+  }
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <formats/json/impl/string_writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Writer>
+std::string Write(const std::string& key, const std::string& value) {
+  rapidjson::StringBuffer buffer;
+  Writer writer{buffer};
+  writer.StartObject();
+  writer.Key(key.data(), key.size());
+  writer.String(value.data(), value.size());
+  writer.EndObject();
+  return std::string{buffer.GetString(), buffer.GetLength()};
+}
+
+void ExpectSameAsRapidjson(const std::string& str) {
+  EXPECT_EQ(Write<formats::json::impl::StringWriter>(str, str),
+            Write<rapidjson::Writer<rapidjson::StringBuffer>>(str, str))
+      << "size: " << str.size();
+}
+
+}  // namespace
+
+TEST(StringWriter, Plain) {
+  ExpectSameAsRapidjson("");
+  ExpectSameAsRapidjson("a");
+  ExpectSameAsRapidjson("\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82");
+  for (std::size_t size = 1; size < 70; ++size) {
+    ExpectSameAsRapidjson(std::string(size, 'x'));
+  }
+}
+
+TEST(StringWriter, AllCharacters) {
+  std::string all;
+  for (int c = 0; c < 256; ++c) all.push_back(static_cast<char>(c));
+  ExpectSameAsRapidjson(all);
+
+  for (int c = 0; c < 256; ++c) {
+    // every position in and around the SIMD block
+    for (std::size_t pos = 0; pos < 40; ++pos) {
+      std::string str(40, 'a');
+      str[pos] = static_cast<char>(c);
+      ExpectSameAsRapidjson(str);
+    }
+  }
+}
+
+TEST(StringWriter, ManyEscapes) {
+  ExpectSameAsRapidjson(std::string(100, '"'));
+  ExpectSameAsRapidjson(std::string(100, '\0'));
+  ExpectSameAsRapidjson("line \"one\"\n\tline two\\");
+}
+
+TEST(StringWriter, BufferGrowsOnEscapes) {
+  // the room is reserved for the unescaped size, the escapes move the buffer
+  std::string str;
+  for (std::size_t i = 0; i < 10000; ++i) {
+    str.push_back(i % 3 ? static_cast<char>(i % 32) : 'a');
+  }
+  ExpectSameAsRapidjson(str);
+  ExpectSameAsRapidjson(std::string(10000, '\x01'));
+}
+
+USERVER_NAMESPACE_END
@@ -15,6 +15,13 @@ VersionedValuePtr::Data::Data(Document&& doc)
       "Both Document and Value must use CrtAllocator for the fast move");
 }
 
+std::string_view InternedKeys::Intern(std::string_view key) {
+  const auto it = index_.find(key);
+  if (it != index_.end()) return *it;
+  const auto& stored = storage_.emplace_back(key);
+  return *index_.insert(stored).first;
+}
+
 VersionedValuePtr::VersionedValuePtr() noexcept = default;
 
 VersionedValuePtr::VersionedValuePtr(std::shared_ptr<Data>&& data) noexcept
@@ -52,6 +59,21 @@ size_t VersionedValuePtr::Version() const {
 
 void VersionedValuePtr::BumpVersion() { ++data_->version; }
 
+void VersionedValuePtr::SetInternedKeys(
+    std::shared_ptr<const InternedKeys> keys) {
+  UASSERT(data_);
+  data_->interned_keys = std::move(keys);
+}
+
+bool VersionedValuePtr::ShareInternedKeys(const VersionedValuePtr& source) {
+  if (!source.data_ || !source.data_->interned_keys) return true;
+  if (!data_) return false;
+  if (!data_->interned_keys) {
+    data_->interned_keys = source.data_->interned_keys;
+  }
+  return data_->interned_keys == source.data_->interned_keys;
+}
+
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
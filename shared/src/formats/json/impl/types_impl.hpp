@@ -1,6 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 
 #include <rapidjson/document.h>
 
@@ -10,6 +15,20 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::impl {
 
+/// The distinct object keys of a document parsed with
+/// formats::json::FromStringInternKeys(). The members of the tree reference
+/// them as rapidjson constant strings, so the keys must outlive every tree
+/// that contains them, see VersionedValuePtr::ShareInternedKeys().
+struct InternedKeys final {
+  /// @returns a NUL-terminated copy of the key that lives as long as *this
+  std::string_view Intern(std::string_view key);
+
+ private:
+  std::unordered_set<std::string_view> index_;
+  // std::deque does not move the elements on push_back
+  std::deque<std::string> storage_;
+};
+
 struct VersionedValuePtr::Data {
   template <typename... Args>
   explicit Data(Args&&... args) : native(std::forward<Args>(args)...) {}
@@ -18,6 +37,9 @@ struct VersionedValuePtr::Data {
   // https://github.com/Tencent/rapidjson/issues/387
   explicit Data(Document&&);
 
+  // owns the constant string keys of native, if there are any
+  std::shared_ptr<const InternedKeys> interned_keys;
+
   // native rapidjson value
   Value native;
 
@@ -104,8 +104,10 @@ void InlineObjectBuilder::Append(std::string_view key,
 
 void InlineObjectBuilder::Append(std::string_view key,
                                  const formats::json::Value& value) {
+  const bool share_keys = json_.ShareInternedKeys(value.root_);
   json_->AddMember(WrapStringView(key),
-                   impl::Value(value.GetNative(), g_allocator), g_allocator);
+                   impl::Value(value.GetNative(), g_allocator, !share_keys),
+                   g_allocator);
 }
 
 InlineArrayBuilder::InlineArrayBuilder()
@@ -168,7 +170,9 @@ void InlineArrayBuilder::Append(std::chrono::system_clock::time_point value) {
 }
 
 void InlineArrayBuilder::Append(const formats::json::Value& value) {
-  json_->PushBack(impl::Value(value.GetNative(), g_allocator), g_allocator);
+  const bool share_keys = json_.ShareInternedKeys(value.root_);
+  json_->PushBack(impl::Value(value.GetNative(), g_allocator, !share_keys),
+                  g_allocator);
 }
 
 }  // namespace formats::json::impl
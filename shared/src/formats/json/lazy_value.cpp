@@ -0,0 +1,513 @@
+#include <userver/formats/json/lazy_value.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/json/impl/exttypes.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+constexpr std::uint32_t kMissingToken =
+    std::numeric_limits<std::uint32_t>::max();
+
+constexpr std::size_t kMaxDocumentSize =
+    std::numeric_limits<std::uint32_t>::max() - 1;
+
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool IsScalarEnd(char c) {
+  return IsWhitespace(c) || c == ',' || c == ':' || c == '}' || c == ']' ||
+         c == '{' || c == '[' || c == '"';
+}
+
+// Returns the position of the closing quote of the string that starts at
+// `pos` (right after the opening quote) or npos
+std::size_t FindStringEnd(std::string_view json, std::size_t pos) {
+  const auto size = json.size();
+  const char* data = json.data();
+  while (pos < size) {
+#ifdef __SSE2__
+    const auto quotes = _mm_set1_epi8('"');
+    const auto backslashes = _mm_set1_epi8('\\');
+    while (pos + 16 <= size) {
+      const auto chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+      const auto mask = _mm_movemask_epi8(
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                       _mm_cmpeq_epi8(chunk, backslashes)));
+      if (mask != 0) {
+        pos += __builtin_ctz(static_cast<unsigned>(mask));
+        break;
+      }
+      pos += 16;
+    }
+#endif
+    while (pos < size && data[pos] != '"' && data[pos] != '\\') ++pos;
+    if (pos >= size) break;
+    if (data[pos] == '"') return pos;
+    // skip the escaped character
+    pos += 2;
+  }
+  return std::string_view::npos;
+}
+
+[[noreturn]] void ThrowParseError(std::size_t pos, std::string_view what) {
+  throw ParseException("JSON parse error at offset " + std::to_string(pos) +
+                       ": " + std::string{what});
+}
+
+}  // namespace
+
+struct LazyValue::Document {
+  struct Token {
+    // the first character
+    std::uint32_t pos;
+    // past the last character of the value starting with this token
+    std::uint32_t end;
+    // the token after the value starting with this token
+    std::uint32_t next;
+  };
+
+  std::string json;
+  std::vector<Token> tokens;
+
+  void Index();
+
+  char GetChar(std::uint32_t token) const { return json[tokens[token].pos]; }
+
+  std::string_view GetRaw(std::uint32_t token) const {
+    const auto& t = tokens[token];
+    return std::string_view{json}.substr(t.pos, t.end - t.pos);
+  }
+
+  void CheckChar(std::uint32_t token, char expected) const {
+    if (token >= tokens.size() || GetChar(token) != expected) {
+      ThrowParseError(token < tokens.size() ? tokens[token].pos : json.size(),
+                      std::string{"expected '"} + expected + '\'');
+    }
+  }
+
+  std::string GetKey(std::uint32_t token) const;
+  bool IsKeyEqual(std::uint32_t token, std::string_view key) const;
+
+  // Calls `func(key_token, value_token)` for the members of the object, stops
+  // if `func` returns true
+  template <typename Func>
+  void ForEachMember(std::uint32_t object, Func&& func) const;
+
+  // Calls `func(index, value_token)` for the elements of the array, stops if
+  // `func` returns true
+  template <typename Func>
+  void ForEachElement(std::uint32_t array, Func&& func) const;
+
+  std::string GetPath(std::uint32_t target) const;
+};
+
+void LazyValue::Document::Index() {
+  if (json.size() > kMaxDocumentSize) {
+    throw ParseException("JSON document is too big for the lazy parsing");
+  }
+  tokens.reserve(json.size() / 8);
+
+  std::vector<std::uint32_t> open_containers;
+  const auto size = json.size();
+  std::size_t pos = 0;
+  while (pos < size) {
+    const char c = json[pos];
+    if (IsWhitespace(c)) {
+      ++pos;
+      continue;
+    }
+
+    const auto index = static_cast<std::uint32_t>(tokens.size());
+    const auto start = static_cast<std::uint32_t>(pos);
+    switch (c) {
+      case '{':
+      case '[':
+        open_containers.push_back(index);
+        tokens.push_back({start, 0, 0});
+        ++pos;
+        break;
+      case '}':
+      case ']': {
+        if (open_containers.empty()) ThrowParseError(pos, "unexpected bracket");
+        const auto open = open_containers.back();
+        open_containers.pop_back();
+        if ((GetChar(open) == '{') != (c == '}')) {
+          ThrowParseError(pos, "mismatched bracket");
+        }
+        ++pos;
+        tokens.push_back({start, static_cast<std::uint32_t>(pos), index + 1});
+        tokens[open].end = static_cast<std::uint32_t>(pos);
+        tokens[open].next = index + 1;
+        break;
+      }
+      case ':':
+      case ',':
+        ++pos;
+        tokens.push_back({start, static_cast<std::uint32_t>(pos), index + 1});
+        break;
+      case '"': {
+        const auto quote = FindStringEnd(json, pos + 1);
+        if (quote == std::string_view::npos) {
+          ThrowParseError(pos, "unterminated string");
+        }
+        pos = quote + 1;
+        tokens.push_back({start, static_cast<std::uint32_t>(pos), index + 1});
+        break;
+      }
+      default:
+        while (pos < size && !IsScalarEnd(json[pos])) ++pos;
+        tokens.push_back({start, static_cast<std::uint32_t>(pos), index + 1});
+        break;
+    }
+  }
+
+  if (!open_containers.empty()) {
+    ThrowParseError(tokens[open_containers.back()].pos, "unclosed bracket");
+  }
+  if (tokens.empty()) throw ParseException("JSON document is empty");
+  if (tokens.front().next != tokens.size()) {
+    ThrowParseError(tokens[tokens.front().next].pos,
+                    "the document root must be a single value");
+  }
+}
+
+std::string LazyValue::Document::GetKey(std::uint32_t token) const {
+  CheckChar(token, '"');
+  const auto raw = GetRaw(token);
+  if (raw.find('\\') == std::string_view::npos) {
+    return std::string{raw.substr(1, raw.size() - 2)};
+  }
+  return FromString(raw).As<std::string>();
+}
+
+bool LazyValue::Document::IsKeyEqual(std::uint32_t token,
+                                     std::string_view key) const {
+  CheckChar(token, '"');
+  const auto raw = GetRaw(token);
+  if (raw.size() == key.size() + 2 &&
+      std::memcmp(raw.data() + 1, key.data(), key.size()) == 0) {
+    return true;
+  }
+  // escaped keys are compared after unescaping
+  return raw.find('\\') != std::string_view::npos && GetKey(token) == key;
+}
+
+template <typename Func>
+void LazyValue::Document::ForEachMember(std::uint32_t object,
+                                        Func&& func) const {
+  UASSERT(GetChar(object) == '{');
+  auto token = object + 1;
+  if (GetChar(token) == '}') return;
+
+  while (true) {
+    const auto key = token;
+    CheckChar(key, '"');
+    CheckChar(key + 1, ':');
+    const auto value = key + 2;
+    if (value >= tokens.size() || GetChar(value) == '}' ||
+        GetChar(value) == ',' || GetChar(value) == ':') {
+      ThrowParseError(tokens[key].end, "expected a value");
+    }
+    if (func(key, value)) return;
+
+    token = tokens[value].next;
+    if (GetChar(token) == '}') return;
+    CheckChar(token, ',');
+    ++token;
+  }
+}
+
+template <typename Func>
+void LazyValue::Document::ForEachElement(std::uint32_t array,
+                                         Func&& func) const {
+  UASSERT(GetChar(array) == '[');
+  auto token = array + 1;
+  if (GetChar(token) == ']') return;
+
+  for (std::size_t index = 0;; ++index) {
+    if (GetChar(token) == ']' || GetChar(token) == ',' ||
+        GetChar(token) == ':') {
+      ThrowParseError(tokens[token].pos, "expected a value");
+    }
+    if (func(index, token)) return;
+
+    token = tokens[token].next;
+    if (GetChar(token) == ']') return;
+    CheckChar(token, ',');
+    ++token;
+  }
+}
+
+std::string LazyValue::Document::GetPath(std::uint32_t target) const {
+  std::string path;
+  std::uint32_t current = 0;
+  while (current != target) {
+    UASSERT(current < target && target < tokens[current].next);
+    const auto parent = current;
+    if (GetChar(parent) == '{') {
+      ForEachMember(parent, [&](std::uint32_t key, std::uint32_t value) {
+        if (target < tokens[value].next) {
+          formats::common::AppendPath(path, GetKey(key));
+          current = value;
+          return true;
+        }
+        return false;
+      });
+    } else {
+      ForEachElement(parent, [&](std::size_t index, std::uint32_t value) {
+        if (target < tokens[value].next) {
+          formats::common::AppendPath(path, index);
+          current = value;
+          return true;
+        }
+        return false;
+      });
+    }
+    UASSERT(current != parent);
+    if (current == parent) break;
+  }
+  return path.empty() ? std::string{formats::common::kPathRoot} : path;
+}
+
+LazyValue::LazyValue() noexcept : token_(kMissingToken) {}
+
+LazyValue::LazyValue(std::shared_ptr<const Document> document,
+                     std::uint32_t token) noexcept
+    : document_(std::move(document)), token_(token) {}
+
+LazyValue::LazyValue(std::shared_ptr<const Document> document,
+                     std::string&& detached_path) noexcept
+    : document_(std::move(document)),
+      token_(kMissingToken),
+      detached_path_(std::move(detached_path)) {}
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+  if (!IsMissing()) {
+    if (IsObject()) {
+      std::uint32_t found = kMissingToken;
+      document_->ForEachMember(
+          token_, [&](std::uint32_t key_token, std::uint32_t value) {
+            if (!document_->IsKeyEqual(key_token, key)) return false;
+            found = value;
+            return true;
+          });
+      if (found != kMissingToken) return {document_, found};
+    } else if (!IsNull()) {
+      ThrowTypeMismatch(impl::objectValue);
+    }
+  }
+  return {document_, formats::common::MakeChildPath(GetPath(), key)};
+}
+
+LazyValue LazyValue::operator[](std::size_t index) const {
+  CheckNotMissing();
+  if (!IsArray()) ThrowTypeMismatch(impl::arrayValue);
+
+  std::uint32_t found = kMissingToken;
+  document_->ForEachElement(token_,
+                            [&](std::size_t i, std::uint32_t value) {
+                              if (i != index) return false;
+                              found = value;
+                              return true;
+                            });
+  if (found == kMissingToken) {
+    throw OutOfBoundsException(index, GetSize(), GetPath());
+  }
+  return {document_, found};
+}
+
+std::size_t LazyValue::GetSize() const {
+  CheckNotMissing();
+  std::size_t size = 0;
+  if (IsObject()) {
+    document_->ForEachMember(token_, [&size](std::uint32_t, std::uint32_t) {
+      ++size;
+      return false;
+    });
+  } else if (IsArray()) {
+    document_->ForEachElement(token_, [&size](std::size_t, std::uint32_t) {
+      ++size;
+      return false;
+    });
+  } else if (!IsNull()) {
+    ThrowTypeMismatch(impl::arrayValue);
+  }
+  return size;
+}
+
+bool LazyValue::HasMember(std::string_view key) const {
+  CheckNotMissing();
+  if (IsNull()) return false;
+  if (!IsObject()) ThrowTypeMismatch(impl::objectValue);
+  return !(*this)[key].IsMissing();
+}
+
+bool LazyValue::IsMissing() const noexcept { return token_ == kMissingToken; }
+
+bool LazyValue::IsNull() const noexcept { return GetFirstChar() == 'n'; }
+
+bool LazyValue::IsBool() const noexcept {
+  const auto c = GetFirstChar();
+  return c == 't' || c == 'f';
+}
+
+bool LazyValue::IsNumber() const noexcept {
+  const auto c = GetFirstChar();
+  return c == '-' || (c >= '0' && c <= '9');
+}
+
+bool LazyValue::IsString() const noexcept { return GetFirstChar() == '"'; }
+
+bool LazyValue::IsArray() const noexcept { return GetFirstChar() == '['; }
+
+bool LazyValue::IsObject() const noexcept { return GetFirstChar() == '{'; }
+
+template <>
+bool LazyValue::As<bool>() const {
+  CheckNotMissing();
+  const auto raw = GetRawJson();
+  if (raw == "true") return true;
+  if (raw == "false") return false;
+  if (IsBool()) ThrowParseError(document_->tokens[token_].pos, "bad literal");
+  ThrowTypeMismatch(impl::booleanValue);
+}
+
+template <>
+std::int64_t LazyValue::As<std::int64_t>() const {
+  CheckNotMissing();
+  if (!IsNumber()) ThrowTypeMismatch(impl::intValue);
+
+  const auto raw = GetRawJson();
+  std::int64_t result{};
+  const auto [end, ec] =
+      std::from_chars(raw.data(), raw.data() + raw.size(), result);
+  if (ec == std::errc{} && end == raw.data() + raw.size()) return result;
+
+  try {
+    return Materialize().As<std::int64_t>();
+  } catch (const TypeMismatchException&) {
+    ThrowTypeMismatch(impl::intValue);
+  }
+}
+
+template <>
+std::uint64_t LazyValue::As<std::uint64_t>() const {
+  CheckNotMissing();
+  if (!IsNumber()) ThrowTypeMismatch(impl::uintValue);
+
+  const auto raw = GetRawJson();
+  std::uint64_t result{};
+  const auto [end, ec] =
+      std::from_chars(raw.data(), raw.data() + raw.size(), result);
+  if (ec == std::errc{} && end == raw.data() + raw.size()) return result;
+
+  try {
+    return Materialize().As<std::uint64_t>();
+  } catch (const TypeMismatchException&) {
+    ThrowTypeMismatch(impl::uintValue);
+  }
+}
+
+template <>
+double LazyValue::As<double>() const {
+  CheckNotMissing();
+  if (!IsNumber()) ThrowTypeMismatch(impl::realValue);
+  return Materialize().As<double>();
+}
+
+template <>
+std::string LazyValue::As<std::string>() const {
+  CheckNotMissing();
+  if (!IsString()) ThrowTypeMismatch(impl::stringValue);
+
+  const auto raw = GetRawJson();
+  if (raw.find('\\') == std::string_view::npos) {
+    return std::string{raw.substr(1, raw.size() - 2)};
+  }
+  return Materialize().As<std::string>();
+}
+
+template <>
+Value LazyValue::As<Value>() const {
+  return Materialize();
+}
+
+Value LazyValue::Materialize() const { return FromString(GetRawJson()); }
+
+std::string_view LazyValue::GetRawJson() const {
+  CheckNotMissing();
+  return document_->GetRaw(token_);
+}
+
+std::string LazyValue::GetPath() const {
+  if (IsMissing()) {
+    return detached_path_.empty() ? std::string{formats::common::kPathRoot}
+                                  : detached_path_;
+  }
+  return document_->GetPath(token_);
+}
+
+void LazyValue::CheckNotMissing() const {
+  if (IsMissing()) throw MemberMissingException(GetPath());
+}
+
+void LazyValue::ThrowTypeMismatch(int expected) const {
+  impl::Type actual = impl::errorValue;
+  switch (GetFirstChar()) {
+    case '{':
+      actual = impl::objectValue;
+      break;
+    case '[':
+      actual = impl::arrayValue;
+      break;
+    case '"':
+      actual = impl::stringValue;
+      break;
+    case 'n':
+      actual = impl::nullValue;
+      break;
+    case 't':
+    case 'f':
+      actual = impl::booleanValue;
+      break;
+    default:
+      if (IsNumber()) actual = impl::realValue;
+      break;
+  }
+  throw TypeMismatchException(actual, expected, GetPath());
+}
+
+char LazyValue::GetFirstChar() const noexcept {
+  if (IsMissing()) return '\0';
+  return document_->GetChar(token_);
+}
+
+LazyValue LazyFromString(std::string_view doc) {
+  auto document = std::make_shared<LazyValue::Document>();
+  document->json = std::string{doc};
+  document->Index();
+  return LazyValue{std::move(document), std::uint32_t{0}};
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
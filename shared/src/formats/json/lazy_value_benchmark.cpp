@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A request body of which a handler reads only a few fields
+std::string MakeDocument(std::size_t items_count) {
+  std::string json = R"({"id": "5f0c3b1e9a7d4e21", "user": {"name": "Alice",)"
+                     R"( "locale": "en"}, "items": [)";
+  for (std::size_t i = 0; i < items_count; ++i) {
+    if (i != 0) json += ',';
+    json += R"({"sku": "item-)" + std::to_string(i) +
+            R"(", "quantity": 3, "price": 199.99, "tags": ["a", "b", "c"],)"
+            R"( "description": "some reasonably long item description"})";
+  }
+  json += R"(], "total": 12345})";
+  return json;
+}
+
+}  // namespace
+
+void json_read_few_fields_dom(benchmark::State& state) {
+  const auto doc = MakeDocument(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::FromString(doc);
+    benchmark::DoNotOptimize(json["id"].As<std::string>());
+    benchmark::DoNotOptimize(json["user"]["name"].As<std::string>());
+    benchmark::DoNotOptimize(json["total"].As<std::int64_t>());
+  }
+}
+BENCHMARK(json_read_few_fields_dom)->RangeMultiplier(8)->Range(1, 512);
+
+void json_read_few_fields_lazy(benchmark::State& state) {
+  const auto doc = MakeDocument(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::LazyFromString(doc);
+    benchmark::DoNotOptimize(json["id"].As<std::string>());
+    benchmark::DoNotOptimize(json["user"]["name"].As<std::string>());
+    benchmark::DoNotOptimize(json["total"].As<std::int64_t>());
+  }
+}
+BENCHMARK(json_read_few_fields_lazy)->RangeMultiplier(8)->Range(1, 512);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kDoc = R"({
+  "id": 42,
+  "name": "Alice",
+  "escaped": "line\n\"quoted\"",
+  "balance": -12.5,
+  "big": 18446744073709551615,
+  "active": true,
+  "nothing": null,
+  "tags": ["a", "b", {"c": [1, 2]}],
+  "nested": {"deep": {"value": "found", "pad": [[], {}, "}]"]}},
+  "ke\"y": 1
+})";
+
+}  // namespace
+
+TEST(LazyValue, Sample) {
+  /// [Sample LazyValue]
+  const auto json = formats::json::LazyFromString(kDoc);
+
+  // only the accessed values are parsed
+  EXPECT_EQ(json["id"].As<int>(), 42);
+  EXPECT_EQ(json["nested"]["deep"]["value"].As<std::string>(), "found");
+  EXPECT_EQ(json["missing"].As<std::string>("default"), "default");
+  /// [Sample LazyValue]
+}
+
+TEST(LazyValue, Scalars) {
+  const auto json = formats::json::LazyFromString(kDoc);
+  EXPECT_EQ(json["id"].As<std::int64_t>(), 42);
+  EXPECT_EQ(json["id"].As<std::uint64_t>(), 42);
+  EXPECT_EQ(json["id"].As<double>(), 42.0);
+  EXPECT_EQ(json["name"].As<std::string>(), "Alice");
+  EXPECT_EQ(json["escaped"].As<std::string>(), "line\n\"quoted\"");
+  EXPECT_EQ(json["balance"].As<double>(), -12.5);
+  EXPECT_EQ(json["big"].As<std::uint64_t>(), 18446744073709551615ULL);
+  EXPECT_TRUE(json["active"].As<bool>());
+  EXPECT_TRUE(json["nothing"].IsNull());
+  EXPECT_EQ(json["nothing"].As<int>(7), 7);
+  EXPECT_EQ(json["ke\"y"].As<int>(), 1);
+}
+
+TEST(LazyValue, Containers) {
+  const auto json = formats::json::LazyFromString(kDoc);
+  EXPECT_TRUE(json.IsObject());
+  EXPECT_EQ(json.GetSize(), 10);
+  EXPECT_TRUE(json.HasMember("tags"));
+  EXPECT_FALSE(json.HasMember("tag"));
+
+  const auto tags = json["tags"];
+  ASSERT_TRUE(tags.IsArray());
+  EXPECT_EQ(tags.GetSize(), 3);
+  EXPECT_EQ(tags[1].As<std::string>(), "b");
+  EXPECT_EQ(tags[2]["c"][1].As<int>(), 2);
+  EXPECT_EQ(tags[2].GetRawJson(), R"({"c": [1, 2]})");
+
+  EXPECT_EQ(json["nested"]["deep"]["pad"].GetSize(), 3);
+  EXPECT_EQ(json["nested"]["deep"]["pad"][2].As<std::string>(), "}]");
+}
+
+TEST(LazyValue, Materialize) {
+  const auto json = formats::json::LazyFromString(kDoc);
+  const auto tags = json["tags"].As<formats::json::Value>();
+  EXPECT_EQ(tags, formats::json::FromString(R"(["a", "b", {"c": [1, 2]}])"));
+  EXPECT_EQ(json["tags"].As<std::vector<formats::json::Value>>().size(), 3);
+}
+
+TEST(LazyValue, Errors) {
+  const auto json = formats::json::LazyFromString(kDoc);
+  EXPECT_THROW(json["missing"].As<int>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(json["name"].As<int>(), formats::json::TypeMismatchException);
+  EXPECT_THROW(json["id"]["key"], formats::json::TypeMismatchException);
+  EXPECT_THROW(json["tags"][3], formats::json::OutOfBoundsException);
+  EXPECT_THROW(json["balance"].As<std::int64_t>(),
+               formats::json::TypeMismatchException);
+
+  EXPECT_EQ(json["tags"][2]["c"].GetPath(), "tags[2].c");
+  EXPECT_EQ(json["nested"]["none"]["x"].GetPath(), "nested.none.x");
+  EXPECT_EQ(json.GetPath(), "/");
+}
+
+TEST(LazyValue, ParseErrors) {
+  using formats::json::LazyFromString;
+  using formats::json::ParseException;
+  EXPECT_THROW(LazyFromString(""), ParseException);
+  EXPECT_THROW(LazyFromString("{"), ParseException);
+  EXPECT_THROW(LazyFromString("[}"), ParseException);
+  EXPECT_THROW(LazyFromString(R"({"a": "b)"), ParseException);
+  EXPECT_THROW(LazyFromString("1 2"), ParseException);
+
+  // the rest is checked on access
+  const auto json = LazyFromString(R"({"a": 1 "b": 2, "c": tru})");
+  EXPECT_THROW(json["b"], ParseException);
+  EXPECT_EQ(json["a"].As<int>(), 1);
+
+  const auto bad_literal = LazyFromString(R"({"c": tru})");
+  EXPECT_THROW(bad_literal["c"].As<bool>(), ParseException);
+}
+
+TEST(LazyValue, RootScalar) {
+  EXPECT_EQ(formats::json::LazyFromString(" \"str\" ").As<std::string>(),
+            "str");
+  EXPECT_EQ(formats::json::LazyFromString("-5").As<int>(), -5);
+}
+
+USERVER_NAMESPACE_END
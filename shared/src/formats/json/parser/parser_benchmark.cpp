@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <userver/formats/json/parser/parser.hpp>
+#include <userver/formats/json/parser/struct_parser.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 
@@ -97,4 +98,76 @@ void JsonParseValueSax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseValueSax)->RangeMultiplier(2)->Range(1, 16);
 
+namespace {
+
+struct Item {
+  std::int64_t id;
+  std::string name;
+  double price;
+  std::optional<std::string> comment;
+  std::vector<std::int64_t> tags;
+};
+
+struct Catalog {
+  std::vector<Item> items;
+};
+
+Item Parse(const formats::json::Value& value, formats::parse::To<Item>) {
+  return Item{
+      value["id"].As<std::int64_t>(),
+      value["name"].As<std::string>(),
+      value["price"].As<double>(),
+      value["comment"].As<std::optional<std::string>>(),
+      value["tags"].As<std::vector<std::int64_t>>(),
+  };
+}
+
+Catalog Parse(const formats::json::Value& value, formats::parse::To<Catalog>) {
+  return Catalog{value["items"].As<std::vector<Item>>()};
+}
+
+std::string BuildCatalog(size_t len) {
+  std::string r = R"({"items": [)";
+  for (size_t i = 0; i < len; i++) {
+    if (i > 0) r += ',';
+    r += fmt::format(
+        R"({{"id": {}, "name": "item number {}", "price": {}.99, )"
+        R"("tags": [1, 2, 3], "unknown": {{"a": [true, null]}}}})",
+        i, i, i);
+  }
+  r += "]}";
+  return r;
+}
+
+}  // namespace
+
+template <>
+struct formats::json::parser::StructFieldNames<Item> {
+  static constexpr std::string_view kNames[] = {"id", "name", "price",
+                                                "comment", "tags"};
+};
+
+template <>
+struct formats::json::parser::StructFieldNames<Catalog> {
+  static constexpr std::string_view kNames[] = {"items"};
+};
+
+void JsonParseStructDom(benchmark::State& state) {
+  const auto input = BuildCatalog(state.range(0));
+  for (auto _ : state) {
+    const auto res = formats::json::FromString(input).As<Catalog>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseStructDom)->RangeMultiplier(8)->Range(1, 4096);
+
+void JsonParseStructSax(benchmark::State& state) {
+  const auto input = BuildCatalog(state.range(0));
+  for (auto _ : state) {
+    const auto res = formats::json::parser::ParseStruct<Catalog>(input);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseStructSax)->RangeMultiplier(8)->Range(1, 4096);
+
 USERVER_NAMESPACE_END
@@ -1,59 +1,76 @@
 #include <userver/formats/json/parser/parser_handler.hpp>
 
+#include <formats/json/parser/schema_validator.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::parser {
 
 ParserHandler::ParserHandler(BaseParser& parser) : parser_(parser) {}
 
+ParserHandler::ParserHandler(BaseParser& parser,
+                             impl::SchemaValidator* validator)
+    : parser_(parser), validator_(validator) {}
+
 ParserHandler::ParserHandler(ParserState& parser_state)
     : ParserHandler(parser_state.GetTopParser()) {}
 
 bool ParserHandler::Null() {
+  if (validator_) validator_->Null();
   parser_.Null();
   return true;
 }
 bool ParserHandler::Bool(bool b) {
+  if (validator_) validator_->Bool(b);
   parser_.Bool(b);
   return true;
 }
 bool ParserHandler::Int(int64_t i) { return Int64(i); }
 bool ParserHandler::Uint(uint64_t u) { return Uint64(u); }
 bool ParserHandler::Int64(int64_t i) {
+  if (validator_) validator_->Int64(i);
   parser_.Int64(i);
   return true;
 }
 bool ParserHandler::Uint64(uint64_t u) {
+  if (validator_) validator_->Uint64(u);
   parser_.Uint64(u);
   return true;
 }
 bool ParserHandler::Double(double d) {
+  if (validator_) validator_->Double(d);
   parser_.Double(d);
   return true;
 }
 bool ParserHandler::StartObject() {
+  if (validator_) validator_->StartObject();
   parser_.StartObject();
   return true;
 }
 bool ParserHandler::EndObject(size_t members) {
+  if (validator_) validator_->EndObject();
   parser_.EndObject(members);
   return true;
 }
 bool ParserHandler::StartArray() {
+  if (validator_) validator_->StartArray();
   parser_.StartArray();
   return true;
 }
 bool ParserHandler::EndArray(size_t members) {
+  if (validator_) validator_->EndArray();
   parser_.EndArray(members);
   return true;
 }
 
 bool ParserHandler::Key(const char* c, size_t size, bool) {
+  if (validator_) validator_->Key(std::string_view{c, size});
   parser_.Key(std::string_view{c, size});
   return true;
 }
 
 bool ParserHandler::String(const char* c, size_t size, bool) {
+  if (validator_) validator_->String(std::string_view{c, size});
   parser_.String(std::string_view{c, size});
   return true;
 }
@@ -12,9 +12,12 @@
 #include <userver/formats/common/path.hpp>
 #include <userver/formats/json/parser/base_parser.hpp>
 #include <userver/formats/json/parser/parser_handler.hpp>
+#include <userver/formats/json/parser/schema.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <formats/json/parser/schema_validator.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::parser {
@@ -74,6 +77,16 @@ void ParserState::PushParser(BaseParser& parser) {
 }
 
 void ParserState::ProcessInput(std::string_view sw) {
+  DoProcessInput(sw, nullptr);
+}
+
+void ParserState::ProcessInput(std::string_view sw, const Schema& schema) {
+  impl::SchemaValidator validator{schema};
+  DoProcessInput(sw, &validator);
+}
+
+void ParserState::DoProcessInput(std::string_view sw,
+                                 impl::SchemaValidator* validator) {
   rapidjson::Reader reader;
   rapidjson::MemoryStream is(sw.data(), sw.size());
   reader.IterativeParseInit();
@@ -88,7 +101,7 @@ void ParserState::ProcessInput(std::string_view sw) {
       }
 
       UASSERT(stack.back().parser);
-      ParserHandler handler(*stack.back().parser);
+      ParserHandler handler(*stack.back().parser, validator);
 
       pos = is.Tell();
       reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(is, handler);
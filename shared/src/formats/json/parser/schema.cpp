@@ -0,0 +1,480 @@
+#include <userver/formats/json/parser/schema.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/parser/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/trivial_map.hpp>
+
+#include <formats/json/parser/schema_validator.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+namespace impl {
+
+namespace {
+
+constexpr utils::TrivialBiMap kTypes = [](auto selector) {
+  return selector()
+      .Case("null", kNullType)
+      .Case("boolean", kBooleanType)
+      .Case("integer", kIntegerType)
+      .Case("string", kStringType)
+      .Case("array", kArrayType)
+      .Case("object", kObjectType);
+};
+
+constexpr utils::TrivialSet kAnnotations = [](auto selector) {
+  return selector()
+      .Case("$schema")
+      .Case("$id")
+      .Case("id")
+      .Case("$comment")
+      .Case("title")
+      .Case("description")
+      .Case("default")
+      .Case("examples")
+      .Case("format")
+      .Case("readOnly")
+      .Case("writeOnly")
+      .Case("deprecated")
+      .Case("definitions")
+      .Case("$defs");
+};
+
+std::string TypesToString(std::uint8_t types) {
+  if (types == 0) return "nothing";
+
+  std::string result;
+  const auto append = [&result](std::string_view name) {
+    if (!result.empty()) result += " or ";
+    result += name;
+  };
+
+  if ((types & kIntegerType) && (types & kFractionalType)) {
+    append("number");
+    types &= ~(kIntegerType | kFractionalType);
+  }
+  for (const auto flag : {kNullType, kBooleanType, kIntegerType, kStringType,
+                          kArrayType, kObjectType}) {
+    if (types & flag) append(*kTypes.TryFindBySecond(flag));
+  }
+  return result;
+}
+
+std::uint8_t ParseType(const formats::json::Value& type) {
+  const auto name = type.As<std::string>();
+  if (name == "number") return kIntegerType | kFractionalType;
+  const auto flag = kTypes.TryFindByFirst(name);
+  if (!flag) {
+    throw SchemaError(
+        fmt::format("Unknown type '{}' at '{}'", name, type.GetPath()));
+  }
+  return *flag;
+}
+
+[[noreturn]] void ThrowUnsupported(std::string_view what,
+                                   const formats::json::Value& value) {
+  throw SchemaError(fmt::format("{} at '{}' is not supported by the compiled "
+                                "JSON Schema validator",
+                                what, value.GetPath()));
+}
+
+std::size_t CountCodePoints(std::string_view s) {
+  return std::count_if(s.begin(), s.end(), [](char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+  });
+}
+
+class Compiler final {
+ public:
+  explicit Compiler(SchemaProgram& program) : program_(program) {
+    program_.nodes.resize(2);
+    program_.nodes[kNeverNode].types = 0;
+  }
+
+  std::size_t Compile(const formats::json::Value& schema);
+
+ private:
+  void CompileEnum(const formats::json::Value& values, SchemaNode& node);
+  void CompileRequired(const formats::json::Value& names, SchemaNode& node);
+
+  SchemaProgram& program_;
+};
+
+std::size_t Compiler::Compile(const formats::json::Value& schema) {
+  if (schema.IsBool()) {
+    return schema.As<bool>() ? kAnyNode : kNeverNode;
+  }
+  if (!schema.IsObject()) {
+    throw SchemaError(fmt::format("Schema at '{}' must be an object or a bool",
+                                  schema.GetPath()));
+  }
+
+  // the children are compiled first, the node is stored at the end
+  const auto index = program_.nodes.size();
+  program_.nodes.emplace_back();
+  SchemaNode node;
+  bool draft4_exclusive_minimum = false;
+  bool draft4_exclusive_maximum = false;
+  std::optional<formats::json::Value> required;
+
+  for (auto it = schema.begin(); it != schema.end(); ++it) {
+    const auto keyword = it.GetName();
+    const auto& value = *it;
+
+    if (keyword == "type") {
+      if (value.IsArray()) {
+        node.types = 0;
+        for (const auto& type : value) node.types |= ParseType(type);
+      } else {
+        node.types = ParseType(value);
+      }
+    } else if (keyword == "enum") {
+      CompileEnum(value, node);
+    } else if (keyword == "minimum") {
+      node.minimum = value.As<double>();
+    } else if (keyword == "maximum") {
+      node.maximum = value.As<double>();
+    } else if (keyword == "exclusiveMinimum") {
+      if (value.IsBool()) {
+        draft4_exclusive_minimum = value.As<bool>();
+      } else {
+        node.exclusive_minimum = value.As<double>();
+      }
+    } else if (keyword == "exclusiveMaximum") {
+      if (value.IsBool()) {
+        draft4_exclusive_maximum = value.As<bool>();
+      } else {
+        node.exclusive_maximum = value.As<double>();
+      }
+    } else if (keyword == "minLength") {
+      node.min_length = value.As<std::size_t>();
+    } else if (keyword == "maxLength") {
+      node.max_length = value.As<std::size_t>();
+    } else if (keyword == "items") {
+      if (value.IsArray()) ThrowUnsupported("Array form of 'items'", value);
+      node.items = Compile(value);
+    } else if (keyword == "minItems") {
+      node.min_items = value.As<std::size_t>();
+    } else if (keyword == "maxItems") {
+      node.max_items = value.As<std::size_t>();
+    } else if (keyword == "properties") {
+      for (auto property = value.begin(); property != value.end();
+           ++property) {
+        node.properties.push_back({property.GetName(), Compile(*property)});
+      }
+    } else if (keyword == "required") {
+      // needs the properties and additionalProperties
+      required = value;
+    } else if (keyword == "additionalProperties") {
+      node.additional_properties = Compile(value);
+    } else if (keyword == "minProperties") {
+      node.min_properties = value.As<std::size_t>();
+    } else if (keyword == "maxProperties") {
+      node.max_properties = value.As<std::size_t>();
+    } else if (!kAnnotations.Contains(keyword)) {
+      ThrowUnsupported(fmt::format("Keyword '{}'", keyword), value);
+    }
+  }
+
+  if (draft4_exclusive_minimum && node.minimum) {
+    node.exclusive_minimum = std::exchange(node.minimum, std::nullopt);
+  }
+  if (draft4_exclusive_maximum && node.maximum) {
+    node.exclusive_maximum = std::exchange(node.maximum, std::nullopt);
+  }
+
+  std::sort(
+      node.properties.begin(), node.properties.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.name < rhs.name; });
+  if (required) CompileRequired(*required, node);
+
+  program_.nodes[index] = std::move(node);
+  return index;
+}
+
+void Compiler::CompileEnum(const formats::json::Value& values,
+                           SchemaNode& node) {
+  node.has_enum = true;
+  for (const auto& value : values) {
+    if (value.IsNull()) {
+      node.enum_null = true;
+    } else if (value.IsBool()) {
+      (value.As<bool>() ? node.enum_true : node.enum_false) = true;
+    } else if (value.IsString()) {
+      node.enum_strings.push_back(value.As<std::string>());
+    } else if (value.IsDouble() || value.IsInt64() || value.IsUInt64()) {
+      node.enum_numbers.push_back(value.As<double>());
+    } else {
+      ThrowUnsupported("Non-scalar 'enum' value", value);
+    }
+  }
+  std::sort(node.enum_strings.begin(), node.enum_strings.end());
+}
+
+void Compiler::CompileRequired(const formats::json::Value& names,
+                               SchemaNode& node) {
+  for (const auto& name_value : names) {
+    const auto name = name_value.As<std::string>();
+    auto it = std::lower_bound(
+        node.properties.begin(), node.properties.end(), name,
+        [](const auto& property, const auto& key) {
+          return property.name < key;
+        });
+    if (it == node.properties.end() || it->name != name) {
+      // validated by additionalProperties
+      it = node.properties.insert(it, {name, node.additional_properties});
+    }
+    if (it->required_index == kUnlimited) {
+      it->required_index = node.required_count++;
+    }
+  }
+}
+
+}  // namespace
+
+SchemaValidator::SchemaValidator(const Schema& schema)
+    : program_(schema.GetProgram()) {}
+
+void SchemaValidator::Null() {
+  const auto& node = StartValue();
+  if (!(node.types & kNullType)) {
+    Fail(fmt::format("expected {}, got null", TypesToString(node.types)));
+  }
+  if (node.has_enum && !node.enum_null) Fail("the value is not in the enum");
+}
+
+void SchemaValidator::Bool(bool b) {
+  const auto& node = StartValue();
+  if (!(node.types & kBooleanType)) {
+    Fail(fmt::format("expected {}, got boolean", TypesToString(node.types)));
+  }
+  if (node.has_enum && !(b ? node.enum_true : node.enum_false)) {
+    Fail("the value is not in the enum");
+  }
+}
+
+void SchemaValidator::Int64(std::int64_t i) {
+  CheckNumber(StartValue(), static_cast<double>(i), kIntegerType);
+}
+
+void SchemaValidator::Uint64(std::uint64_t u) {
+  CheckNumber(StartValue(), static_cast<double>(u), kIntegerType);
+}
+
+void SchemaValidator::Double(double d) {
+  // 1.0 is an integer in JSON Schema
+  CheckNumber(StartValue(), d,
+              std::trunc(d) == d ? kIntegerType : kFractionalType);
+}
+
+void SchemaValidator::String(std::string_view s) {
+  const auto& node = StartValue();
+  if (!(node.types & kStringType)) {
+    Fail(fmt::format("expected {}, got string", TypesToString(node.types)));
+  }
+
+  if (node.min_length != 0 || node.max_length != kUnlimited) {
+    const auto length = CountCodePoints(s);
+    if (length < node.min_length) {
+      Fail(fmt::format("the string is shorter than {}", node.min_length));
+    }
+    if (length > node.max_length) {
+      Fail(fmt::format("the string is longer than {}", node.max_length));
+    }
+  }
+
+  if (node.has_enum && !std::binary_search(node.enum_strings.begin(),
+                                           node.enum_strings.end(), s)) {
+    Fail("the value is not in the enum");
+  }
+}
+
+void SchemaValidator::StartObject() {
+  const auto& node = StartValue();
+  if (!(node.types & kObjectType)) {
+    Fail(fmt::format("expected {}, got object", TypesToString(node.types)));
+  }
+  if (node.has_enum) Fail("the value is not in the enum");
+
+  auto& frame = stack_.emplace_back();
+  frame.node = &node;
+  frame.is_object = true;
+  frame.required_seen.resize((node.required_count + 63) / 64);
+}
+
+void SchemaValidator::Key(std::string_view key) {
+  UASSERT(!stack_.empty() && stack_.back().is_object);
+  auto& frame = stack_.back();
+  const auto& node = *frame.node;
+  frame.key.assign(key.data(), key.size());
+
+  if (++frame.size > node.max_properties) {
+    FailContainer(fmt::format("the object has more than {} properties",
+                     node.max_properties));
+  }
+
+  auto member_index = node.additional_properties;
+  const auto it = std::lower_bound(
+      node.properties.begin(), node.properties.end(), key,
+      [](const auto& property, std::string_view key) {
+        return property.name < key;
+      });
+  if (it != node.properties.end() && it->name == key) {
+    member_index = it->node;
+    if (it->required_index != kUnlimited) {
+      frame.required_seen[it->required_index / 64] |=
+          std::uint64_t{1} << (it->required_index % 64);
+    }
+  }
+
+  if (member_index == kNeverNode) Fail("the property is not allowed");
+  frame.member = &program_.nodes[member_index];
+}
+
+void SchemaValidator::EndObject() {
+  UASSERT(!stack_.empty() && stack_.back().is_object);
+  const auto& frame = stack_.back();
+  const auto& node = *frame.node;
+
+  if (frame.size < node.min_properties) {
+    FailContainer(fmt::format("the object has less than {} properties",
+                     node.min_properties));
+  }
+
+  for (const auto& property : node.properties) {
+    const auto bit = property.required_index;
+    if (bit != kUnlimited &&
+        !(frame.required_seen[bit / 64] & (std::uint64_t{1} << (bit % 64)))) {
+      FailContainer(fmt::format("the required property '{}' is missing",
+                                property.name));
+    }
+  }
+
+  stack_.pop_back();
+}
+
+void SchemaValidator::StartArray() {
+  const auto& node = StartValue();
+  if (!(node.types & kArrayType)) {
+    Fail(fmt::format("expected {}, got array", TypesToString(node.types)));
+  }
+  if (node.has_enum) Fail("the value is not in the enum");
+
+  auto& frame = stack_.emplace_back();
+  frame.node = &node;
+}
+
+void SchemaValidator::EndArray() {
+  UASSERT(!stack_.empty() && !stack_.back().is_object);
+  const auto& frame = stack_.back();
+  if (frame.size < frame.node->min_items) {
+    FailContainer(fmt::format("the array has less than {} items",
+                              frame.node->min_items));
+  }
+  stack_.pop_back();
+}
+
+const SchemaNode& SchemaValidator::StartValue() {
+  if (stack_.empty()) return program_.nodes[program_.root];
+
+  auto& frame = stack_.back();
+  if (frame.is_object) {
+    UASSERT(frame.member);
+    return *std::exchange(frame.member, nullptr);
+  }
+
+  const auto& node = *frame.node;
+  if (++frame.size > node.max_items) {
+    FailContainer(
+        fmt::format("the array has more than {} items", node.max_items));
+  }
+  return program_.nodes[node.items];
+}
+
+void SchemaValidator::CheckNumber(const SchemaNode& node, double value,
+                                  std::uint8_t type) {
+  if (!(node.types & type)) {
+    Fail(fmt::format("expected {}, got {}", TypesToString(node.types),
+                     type == kIntegerType ? "integer" : "number"));
+  }
+
+  if (node.minimum && value < *node.minimum) {
+    Fail(fmt::format("the value is less than {}", *node.minimum));
+  }
+  if (node.exclusive_minimum && value <= *node.exclusive_minimum) {
+    Fail(fmt::format("the value is not greater than {}",
+                     *node.exclusive_minimum));
+  }
+  if (node.maximum && value > *node.maximum) {
+    Fail(fmt::format("the value is greater than {}", *node.maximum));
+  }
+  if (node.exclusive_maximum && value >= *node.exclusive_maximum) {
+    Fail(fmt::format("the value is not less than {}",
+                     *node.exclusive_maximum));
+  }
+
+  if (node.has_enum &&
+      std::find(node.enum_numbers.begin(), node.enum_numbers.end(), value) ==
+          node.enum_numbers.end()) {
+    Fail("the value is not in the enum");
+  }
+}
+
+void SchemaValidator::Fail(std::string_view what) const {
+  Fail(what, stack_.size());
+}
+
+void SchemaValidator::FailContainer(std::string_view what) const {
+  UASSERT(!stack_.empty());
+  Fail(what, stack_.size() - 1);
+}
+
+void SchemaValidator::Fail(std::string_view what, std::size_t depth) const {
+  std::string path;
+  for (std::size_t i = 0; i < depth; ++i) {
+    const auto& frame = stack_[i];
+    if (frame.is_object) {
+      formats::common::AppendPath(path, frame.key);
+    } else {
+      formats::common::AppendPath(path, frame.size - 1);
+    }
+  }
+  if (path.empty()) path = formats::common::kPathRoot;
+
+  throw InternalParseError(
+      fmt::format("value at '{}' does not match the schema: {}", path, what));
+}
+
+}  // namespace impl
+
+Schema::Schema(const formats::json::Value& schema) {
+  auto program = std::make_unique<impl::SchemaProgram>();
+  impl::Compiler compiler{*program};
+  program->root = compiler.Compile(schema);
+  program_ = std::move(program);
+}
+
+Schema::Schema(Schema&&) noexcept = default;
+
+Schema& Schema::operator=(Schema&&) noexcept = default;
+
+Schema::~Schema() = default;
+
+const impl::SchemaProgram& Schema::GetProgram() const {
+  UASSERT(program_);
+  return *program_;
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/parser/parser.hpp>
+#include <userver/formats/json/parser/schema.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fjp = formats::json::parser;
+
+namespace {
+
+fjp::Schema MakeSchema(std::string_view schema) {
+  return fjp::Schema{formats::json::FromString(schema)};
+}
+
+formats::json::Value Parse(std::string_view input, const fjp::Schema& schema) {
+  return fjp::ParseToType<formats::json::Value, fjp::JsonValueParser>(input,
+                                                                      schema);
+}
+
+std::string GetError(std::string_view input, const fjp::Schema& schema) {
+  try {
+    Parse(input, schema);
+  } catch (const fjp::ParseError& e) {
+    return e.what();
+  }
+  ADD_FAILURE() << "no error for " << input;
+  return {};
+}
+
+}  // namespace
+
+TEST(JsonSchema, Sample) {
+  /// [Sample Schema usage]
+  // Compiled once, e.g. in the constructor of a handler
+  const fjp::Schema schema{formats::json::FromString(R"({
+    "type": "object",
+    "properties": {
+      "name": {"type": "string", "minLength": 1},
+      "tags": {"type": "array", "items": {"type": "string"}, "maxItems": 2}
+    },
+    "required": ["name"],
+    "additionalProperties": false
+  })")};
+
+  // Validated during the parsing, no second pass over the DOM
+  const auto value =
+      fjp::ParseToType<formats::json::Value, fjp::JsonValueParser>(
+          R"({"name": "x", "tags": ["a"]})", schema);
+  EXPECT_EQ(value["name"].As<std::string>(), "x");
+
+  EXPECT_THROW((fjp::ParseToType<formats::json::Value, fjp::JsonValueParser>(
+                    R"({"tags": []})", schema)),
+                fjp::ParseError);
+  /// [Sample Schema usage]
+}
+
+TEST(JsonSchema, Types) {
+  const auto schema = MakeSchema(R"({"type": ["integer", "null"]})");
+  EXPECT_EQ(Parse("1", schema).As<int>(), 1);
+  EXPECT_EQ(Parse("-1", schema).As<int>(), -1);
+  EXPECT_EQ(Parse("2.0", schema).As<double>(), 2.0);
+  EXPECT_TRUE(Parse("null", schema).IsNull());
+
+  EXPECT_NE(GetError("1.5", schema).find(
+                "value at '/' does not match the schema: expected null or "
+                "integer, got number"),
+            std::string::npos)
+      << GetError("1.5", schema);
+  EXPECT_NE(GetError(R"("1")", schema).find("got string"), std::string::npos);
+  EXPECT_NE(GetError("[]", schema).find("got array"), std::string::npos);
+  EXPECT_NE(GetError("{}", schema).find("got object"), std::string::npos);
+  EXPECT_NE(GetError("true", schema).find("got boolean"), std::string::npos);
+
+  EXPECT_EQ(Parse("[1, {}]", MakeSchema("{}")).GetSize(), 2);
+  EXPECT_EQ(Parse("[1, {}]", MakeSchema("true")).GetSize(), 2);
+  EXPECT_NE(GetError("1", MakeSchema("false")).find("expected nothing"),
+            std::string::npos);
+}
+
+TEST(JsonSchema, Numbers) {
+  const auto schema = MakeSchema(R"({
+    "type": "number", "minimum": 1, "exclusiveMaximum": 10
+  })");
+  EXPECT_EQ(Parse("1", schema).As<int>(), 1);
+  EXPECT_EQ(Parse("9.5", schema).As<double>(), 9.5);
+  EXPECT_NE(GetError("0.5", schema).find("less than 1"), std::string::npos);
+  EXPECT_NE(GetError("10", schema).find("not less than 10"),
+            std::string::npos);
+
+  const auto draft4 = MakeSchema(R"({
+    "minimum": 0, "exclusiveMinimum": true, "maximum": 1
+  })");
+  EXPECT_EQ(Parse("1", draft4).As<int>(), 1);
+  EXPECT_NE(GetError("0", draft4).find("not greater than 0"),
+            std::string::npos);
+}
+
+TEST(JsonSchema, StringsAndEnums) {
+  const auto schema = MakeSchema(R"({
+    "type": "string", "minLength": 2, "maxLength": 3
+  })");
+  EXPECT_EQ(Parse(R"("ab")", schema).As<std::string>(), "ab");
+  // code points, not bytes
+  EXPECT_EQ(Parse(R"("абв")", schema).As<std::string>(), "абв");
+  EXPECT_NE(GetError(R"("a")", schema).find("shorter than 2"),
+            std::string::npos);
+  EXPECT_NE(GetError(R"("abcd")", schema).find("longer than 3"),
+            std::string::npos);
+
+  const auto enum_schema = MakeSchema(R"({"enum": ["a", 1, true, null]})");
+  for (const auto* input : {R"("a")", "1", "1.0", "true", "null"}) {
+    EXPECT_NO_THROW(Parse(input, enum_schema)) << input;
+  }
+  for (const auto* input : {R"("b")", "2", "false", "[]", "{}"}) {
+    EXPECT_NE(GetError(input, enum_schema).find("not in the enum"),
+              std::string::npos)
+        << input;
+  }
+}
+
+TEST(JsonSchema, Objects) {
+  const auto schema = MakeSchema(R"({
+    "type": "object",
+    "properties": {
+      "id": {"type": "integer"},
+      "child": {
+        "properties": {"flag": {"type": "boolean"}},
+        "required": ["flag", "extra"],
+        "additionalProperties": {"type": "string"}
+      }
+    },
+    "required": ["id"],
+    "maxProperties": 2
+  })");
+
+  EXPECT_EQ(
+      Parse(R"({"id": 1, "child": {"flag": true, "extra": "x", "more": "y"}})",
+            schema)["child"]["more"]
+          .As<std::string>(),
+      "y");
+  EXPECT_NE(GetError(R"({"child": {}})", schema)
+                .find("value at 'child' does not match the schema: the "
+                      "required property 'extra' is missing"),
+            std::string::npos)
+      << GetError(R"({"child": {}})", schema);
+  EXPECT_NE(GetError(R"({"child": {"flag": 1}})", schema)
+                .find("value at 'child.flag' does not match the schema: "
+                      "expected boolean, got integer"),
+            std::string::npos);
+  EXPECT_NE(GetError(R"({"id": 1, "child": {"flag": true, "extra": 1}})",
+                     schema)
+                .find("value at 'child.extra'"),
+            std::string::npos);
+  EXPECT_NE(GetError(R"({"child": {"flag": true, "extra": ""}})", schema)
+                .find("value at '/' does not match the schema: the required "
+                      "property 'id' is missing"),
+            std::string::npos);
+  EXPECT_NE(GetError(R"({"id": 1, "a": 1, "b": 2})", schema)
+                .find("more than 2 properties"),
+            std::string::npos);
+
+  const auto closed = MakeSchema(R"({"additionalProperties": false})");
+  EXPECT_NE(GetError(R"({"a": 1})", closed)
+                .find("value at 'a' does not match the schema: the property "
+                      "is not allowed"),
+            std::string::npos);
+}
+
+TEST(JsonSchema, Arrays) {
+  const auto schema = MakeSchema(R"({
+    "type": "array",
+    "items": {"type": "array", "items": {"type": "integer"}, "minItems": 1},
+    "maxItems": 2
+  })");
+  EXPECT_EQ(Parse("[[1], [2, 3]]", schema)[1][1].As<int>(), 3);
+  EXPECT_NE(GetError(R"([[1], [2, "3"]])", schema)
+                .find("value at '[1][1]' does not match the schema"),
+            std::string::npos)
+      << GetError(R"([[1], [2, "3"]])", schema);
+  EXPECT_NE(GetError("[[1], []]", schema)
+                .find("value at '[1]' does not match the schema: the array "
+                      "has less than 1 items"),
+            std::string::npos);
+  EXPECT_NE(GetError("[[1], [2], [3]]", schema)
+                .find("value at '/' does not match the schema: the array has "
+                      "more than 2 items"),
+            std::string::npos);
+}
+
+TEST(JsonSchema, TypedParser) {
+  const auto schema = MakeSchema(R"({"type": "integer", "minimum": 0})");
+  EXPECT_EQ((fjp::ParseToType<int, fjp::IntParser>("5", schema)), 5);
+  EXPECT_THROW((fjp::ParseToType<int, fjp::IntParser>("-5", schema)),
+                fjp::ParseError);
+  // the input is invalid JSON
+  EXPECT_THROW((fjp::ParseToType<int, fjp::IntParser>("5 5", schema)),
+                fjp::ParseError);
+}
+
+TEST(JsonSchema, Unsupported) {
+  EXPECT_THROW(MakeSchema(R"({"pattern": "a+"})"), fjp::SchemaError);
+  EXPECT_THROW(MakeSchema(R"({"items": [{}]})"), fjp::SchemaError);
+  EXPECT_THROW(MakeSchema(R"({"properties": {"a": {"$ref": "#"}}})"),
+                fjp::SchemaError);
+  EXPECT_THROW(MakeSchema(R"({"type": "decimal"})"), fjp::SchemaError);
+  EXPECT_THROW(MakeSchema(R"({"enum": [[1]]})"), fjp::SchemaError);
+  EXPECT_THROW(MakeSchema("1"), fjp::SchemaError);
+  EXPECT_NO_THROW(MakeSchema(R"({
+    "$schema": "http://json-schema.org/draft-07/schema#",
+    "title": "t", "description": "d", "format": "date-time", "default": 1
+  })"));
+}
+
+USERVER_NAMESPACE_END
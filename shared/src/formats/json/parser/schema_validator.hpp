@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/formats/json/parser/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser::impl {
+
+enum TypeFlag : std::uint8_t {
+  kNullType = 1 << 0,
+  kBooleanType = 1 << 1,
+  kIntegerType = 1 << 2,
+  // the numbers that are not integers
+  kFractionalType = 1 << 3,
+  kStringType = 1 << 4,
+  kArrayType = 1 << 5,
+  kObjectType = 1 << 6,
+};
+
+inline constexpr std::uint8_t kAnyType = (1 << 7) - 1;
+inline constexpr std::size_t kUnlimited =
+    std::numeric_limits<std::size_t>::max();
+
+// accepts any value
+inline constexpr std::size_t kAnyNode = 0;
+// accepts nothing
+inline constexpr std::size_t kNeverNode = 1;
+
+struct SchemaNode final {
+  struct Property final {
+    std::string name;
+    std::size_t node;
+    // index of the bit in SchemaValidator::Frame::required_seen or kUnlimited
+    std::size_t required_index{kUnlimited};
+  };
+
+  std::uint8_t types{kAnyType};
+
+  std::optional<double> minimum;
+  std::optional<double> exclusive_minimum;
+  std::optional<double> maximum;
+  std::optional<double> exclusive_maximum;
+
+  std::size_t min_length{0};
+  std::size_t max_length{kUnlimited};
+
+  bool has_enum{false};
+  bool enum_null{false};
+  bool enum_true{false};
+  bool enum_false{false};
+  std::vector<std::string> enum_strings;  // sorted
+  std::vector<double> enum_numbers;
+
+  std::size_t items{kAnyNode};
+  std::size_t min_items{0};
+  std::size_t max_items{kUnlimited};
+
+  std::vector<Property> properties;  // sorted by name
+  std::size_t required_count{0};
+  std::size_t additional_properties{kAnyNode};
+  std::size_t min_properties{0};
+  std::size_t max_properties{kUnlimited};
+};
+
+struct SchemaProgram final {
+  // starts with the kAnyNode and the kNeverNode
+  std::vector<SchemaNode> nodes;
+  std::size_t root{kAnyNode};
+};
+
+/// Validates the tokens of a single document against the program of a
+/// Schema, throws InternalParseError on mismatch
+class SchemaValidator final {
+ public:
+  explicit SchemaValidator(const Schema& schema);
+
+  void Null();
+  void Bool(bool b);
+  void Int64(std::int64_t i);
+  void Uint64(std::uint64_t u);
+  void Double(double d);
+  void String(std::string_view s);
+  void StartObject();
+  void Key(std::string_view key);
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+ private:
+  struct Frame final {
+    const SchemaNode* node{nullptr};
+    bool is_object{false};
+    // members or elements started so far
+    std::size_t size{0};
+    // node of the value of the current member
+    const SchemaNode* member{nullptr};
+    std::string key;
+    boost::container::small_vector<std::uint64_t, 1> required_seen;
+  };
+
+  const SchemaNode& StartValue();
+  void CheckNumber(const SchemaNode& node, double value, std::uint8_t type);
+  // for the current value
+  [[noreturn]] void Fail(std::string_view what) const;
+  // for the current object or array as a whole
+  [[noreturn]] void FailContainer(std::string_view what) const;
+  [[noreturn]] void Fail(std::string_view what, std::size_t depth) const;
+
+  const SchemaProgram& program_;
+  boost::container::small_vector<Frame, 16> stack_;
+};
+
+}  // namespace formats::json::parser::impl
+
+USERVER_NAMESPACE_END
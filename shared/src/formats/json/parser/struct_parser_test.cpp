@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/parser/struct_parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+/// [Sample StructParser]
+struct Point {
+  double x;
+  double y;
+};
+
+struct Shape {
+  std::int64_t id;
+  std::string name;
+  std::vector<Point> points;
+  std::optional<std::string> comment;
+  std::unordered_map<std::string, int> counters;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::parser::StructFieldNames<Point> {
+  static constexpr std::string_view kNames[] = {"x", "y"};
+};
+
+template <>
+struct formats::json::parser::StructFieldNames<Shape> {
+  static constexpr std::string_view kNames[] = {"id", "name", "points",
+                                                "comment", "counters"};
+};
+
+TEST(JsonStructParser, Sample) {
+  const auto shape = formats::json::parser::ParseStruct<Shape>(R"({
+    "id": 42,
+    "name": "triangle",
+    "points": [{"x": 0, "y": 0}, {"x": 1.5, "y": 0}, {"x": 0, "y": 2}],
+    "counters": {"views": 3}
+  })");
+
+  EXPECT_EQ(shape.id, 42);
+  EXPECT_EQ(shape.name, "triangle");
+  ASSERT_EQ(shape.points.size(), 3);
+  EXPECT_DOUBLE_EQ(shape.points[1].x, 1.5);
+  EXPECT_DOUBLE_EQ(shape.points[2].y, 2);
+  EXPECT_EQ(shape.comment, std::nullopt);
+  EXPECT_EQ(shape.counters.at("views"), 3);
+}
+/// [Sample StructParser]
+
+namespace {
+
+struct WithValue {
+  std::optional<int> number;
+  formats::json::Value raw;
+  std::vector<std::optional<bool>> flags;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::parser::StructFieldNames<WithValue> {
+  static constexpr std::string_view kNames[] = {"number", "raw", "flags"};
+};
+
+TEST(JsonStructParser, OptionalAndValue) {
+  const auto parsed = formats::json::parser::ParseStruct<WithValue>(
+      R"({"number": null, "raw": {"a": [1, 2]}, "flags": [true, null]})");
+  EXPECT_EQ(parsed.number, std::nullopt);
+  EXPECT_EQ(parsed.raw, formats::json::FromString(R"({"a": [1, 2]})"));
+  EXPECT_EQ(parsed.flags, (std::vector<std::optional<bool>>{true, {}}));
+
+  EXPECT_EQ(formats::json::parser::ParseStruct<WithValue>(
+                R"({"number": 5, "raw": null, "flags": []})")
+                .number,
+            5);
+}
+
+TEST(JsonStructParser, UnknownFieldsSkipped) {
+  const auto point = formats::json::parser::ParseStruct<Point>(
+      R"({"z": {"a": [1, {"b": null}], "c": "d"}, "x": 1, "w": [], "y": 2})");
+  EXPECT_DOUBLE_EQ(point.x, 1);
+  EXPECT_DOUBLE_EQ(point.y, 2);
+}
+
+TEST(JsonStructParser, Errors) {
+  using formats::json::parser::ParseError;
+  using formats::json::parser::ParseStruct;
+
+  try {
+    ParseStruct<Shape>(R"({"id": 1, "name": "a", "points": [{"x": 1}]})");
+    FAIL() << "missing field was not detected";
+  } catch (const ParseError& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "Parse error at pos 41, path 'points.[0]': field 'y' was "
+              "expected, but '}' found");
+  }
+
+  try {
+    ParseStruct<Shape>(R"({"id": "1"})");
+    FAIL() << "type mismatch was not detected";
+  } catch (const ParseError& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "Parse error at pos 10, path 'id': integer was expected, but "
+              "string found, the latest token was : \"1\"");
+  }
+
+  EXPECT_THROW(ParseStruct<Point>("[]"), ParseError);
+  EXPECT_THROW(ParseStruct<Point>(R"({"x": 1, "y": 2)"), ParseError);
+}
+
+USERVER_NAMESPACE_END
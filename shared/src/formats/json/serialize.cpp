@@ -7,9 +7,12 @@
 
 #include <fmt/format.h>
 #include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/writer.h>
 
 #include <userver/formats/json/exception.hpp>
@@ -18,6 +21,7 @@
 #include <userver/utils/assert.hpp>
 
 #include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/string_writer.hpp>
 #include <formats/json/impl/types_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -28,53 +32,64 @@ namespace {
 
 ::rapidjson::CrtAllocator g_allocator;
 
-std::string_view AsStringView(const impl::Value& jval) {
-  return {jval.GetString(), jval.GetStringLength()};
-}
-
-void CheckKeyUniqueness(const impl::Value* root) {
-  std::vector<impl::TreeIterFrame> stack;
-  const impl::Value* value = root;
-
-  stack.reserve(impl::kInitialStackDepth);
-  stack.emplace_back();  // fake "top" frame to avoid extra checks for an empty
-                         // stack inside walker loop
-
-  for (;;) {
-    stack.back().Advance();
-    if (value->IsObject()) {
-      // O(n²) just because our json objects are (hopefully) small
-      const int count = value->MemberCount();
-      const auto begin = value->MemberBegin();
-      for (int i = 1; i < count; i++) {
-        const std::string_view i_key = AsStringView(begin[i].name);
-        for (int j = 0; j < i; j++) {
-          const std::string_view j_key = AsStringView(begin[j].name);
-          if (i_key == j_key)
-            // TODO: add object path to message in TAXICOMMON-1658
-            throw ParseException("Duplicate key: " + std::string(i_key) +
-                                 " at " + impl::ExtractPath(stack));
-        }
-      }
-    }
+constexpr unsigned kParseFlags = rapidjson::kParseDefaultFlags |
+                                 rapidjson::kParseIterativeFlag |
+                                 rapidjson::kParseFullPrecisionFlag;
+
+// Builds the document like impl::Document::Parse(), but the keys reference
+// their interned copies instead of being copied into each member
+class InterningHandler final {
+ public:
+  InterningHandler(impl::Document& document, impl::InternedKeys& keys)
+      : document_(document), keys_(keys) {}
+
+  bool Null() { return document_.Null(); }
+  bool Bool(bool b) { return document_.Bool(b); }
+  bool Int(int i) { return document_.Int(i); }
+  bool Uint(unsigned i) { return document_.Uint(i); }
+  bool Int64(std::int64_t i) { return document_.Int64(i); }
+  bool Uint64(std::uint64_t i) { return document_.Uint64(i); }
+  bool Double(double d) { return document_.Double(d); }
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+    return document_.RawNumber(str, length, copy);
+  }
+  bool String(const char* str, rapidjson::SizeType length, bool copy) {
+    return document_.String(str, length, copy);
+  }
+  bool StartObject() { return document_.StartObject(); }
+  bool Key(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+    const auto key = keys_.Intern({str, length});
+    return document_.Key(key.data(), length, false);
+  }
+  bool EndObject(rapidjson::SizeType count) {
+    return document_.EndObject(count);
+  }
+  bool StartArray() { return document_.StartArray(); }
+  bool EndArray(rapidjson::SizeType count) {
+    return document_.EndArray(count);
+  }
 
-    if ((value->IsObject() && value->MemberCount() > 0) ||
-        (value->IsArray() && value->Size() > 0)) {
-      // descend
-      stack.emplace_back(value);
-    } else {
-      while (!stack.back().HasMoreElements()) {
-        stack.pop_back();
-        if (stack.empty()) return;
-      }
-    }
+ private:
+  impl::Document& document_;
+  impl::InternedKeys& keys_;
+};
 
-    value = stack.back().CurrentValue();
-  }
+[[noreturn]] void ThrowParseError(std::string_view doc,
+                                  rapidjson::ParseResult result) {
+  const auto offset = result.Offset();
+  const auto line = 1 + std::count(doc.begin(), doc.begin() + offset, '\n');
+  // Some versions of libstdc++ have runtime isues in
+  // string_view::find_last_of("\n", 0, offset) implementation.
+  const auto from_pos = doc.substr(0, offset).find_last_of('\n');
+  const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+
+  throw ParseException(
+      fmt::format("JSON parse error at line {} column {}: {}", line, column,
+                  rapidjson::GetParseError_En(result.Code())));
 }
 
 impl::VersionedValuePtr EnsureValid(impl::Document&& json) {
-  CheckKeyUniqueness(&json);
+  impl::CheckKeyUniqueness(&json);
 
   return impl::VersionedValuePtr::Create(std::move(json));
 }
@@ -125,23 +140,36 @@ Value FromString(std::string_view doc) {
 
   impl::Document json{&g_allocator};
   rapidjson::ParseResult ok =
-      json.Parse<rapidjson::kParseDefaultFlags |
-                 rapidjson::kParseIterativeFlag |
-                 rapidjson::kParseFullPrecisionFlag>(doc.data(), doc.size());
-  if (!ok) {
-    const auto offset = ok.Offset();
-    const auto line = 1 + std::count(doc.begin(), doc.begin() + offset, '\n');
-    // Some versions of libstdc++ have runtime isues in
-    // string_view::find_last_of("\n", 0, offset) implementation.
-    const auto from_pos = doc.substr(0, offset).find_last_of('\n');
-    const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+      json.Parse<kParseFlags>(doc.data(), doc.size());
+  if (!ok) ThrowParseError(doc, ok);
 
-    throw ParseException(
-        fmt::format("JSON parse error at line {} column {}: {}", line, column,
-                    rapidjson::GetParseError_En(ok.Code())));
+  return Value{EnsureValid(std::move(json))};
+}
+
+Value FromStringInternKeys(std::string_view doc) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
   }
 
-  return Value{EnsureValid(std::move(json))};
+  auto keys = std::make_shared<impl::InternedKeys>();
+  rapidjson::ParseResult ok;
+  auto generator = [&doc, &keys, &ok](impl::Document& document) {
+    rapidjson::MemoryStream memory{doc.data(), doc.size()};
+    rapidjson::EncodedInputStream<impl::UTF8, rapidjson::MemoryStream> in{
+        memory};
+    InterningHandler handler{document, *keys};
+    rapidjson::Reader reader;
+    ok = reader.Parse<kParseFlags>(in, handler);
+    return !ok.IsError();
+  };
+
+  impl::Document json{&g_allocator};
+  json.Populate(generator);
+  if (!ok) ThrowParseError(doc, ok);
+
+  auto root = EnsureValid(std::move(json));
+  root.SetInternedKeys(std::move(keys));
+  return Value{std::move(root)};
 }
 
 Value FromStream(std::istream& is) {
@@ -152,9 +180,7 @@ Value FromStream(std::istream& is) {
   rapidjson::IStreamWrapper in(is);
   impl::Document json{&g_allocator};
   rapidjson::ParseResult ok =
-      json.ParseStream<rapidjson::kParseDefaultFlags |
-                       rapidjson::kParseIterativeFlag |
-                       rapidjson::kParseFullPrecisionFlag>(in);
+      json.ParseStream<kParseFlags>(in);
   if (!ok) {
     throw ParseException(fmt::format("JSON parse error at offset {}: {}",
                                      ok.Offset(),
@@ -175,21 +201,21 @@ void Serialize(const Value& doc, std::ostream& os) {
 
 std::string ToString(const Value& doc) {
   rapidjson::StringBuffer buffer;
-  rapidjson::Writer writer(buffer);
+  impl::YieldingStringWriter writer(buffer);
   doc.GetNative().Accept(writer);
   return std::string{buffer.GetString(), buffer.GetLength()};
 }
 
 std::string ToStableString(const Value& doc) {
   rapidjson::StringBuffer buffer;
-  rapidjson::Writer writer(buffer);
+  impl::YieldingStringWriter writer(buffer);
   AcceptStable(doc.GetNative(), writer);
   return std::string{buffer.GetString(), buffer.GetLength()};
 }
 
 logging::LogHelper& operator<<(logging::LogHelper& lh, const Value& doc) {
   rapidjson::StringBuffer buffer;
-  rapidjson::Writer writer(buffer);
+  impl::StringWriter writer(buffer);
   doc.GetNative().Accept(writer);
   return lh << std::string_view{buffer.GetString(), buffer.GetLength()};
 }
@@ -215,7 +241,7 @@ struct StringBuffer::Impl final {
 };
 
 StringBuffer::StringBuffer(const formats::json::Value& value) {
-  rapidjson::Writer writer(pimpl_->buffer);
+  YieldingStringWriter writer(pimpl_->buffer);
   value.GetNative().Accept(writer);
 }
 
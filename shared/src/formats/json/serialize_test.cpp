@@ -152,4 +152,68 @@ TEST(JsonToSortedString, NonASCII) {
             formats::json::ToStableString(unescaped));
 }
 
+namespace {
+
+constexpr std::string_view kRepetitiveDoc = R"([
+  {"a_rather_long_key_name": 1, "another_long_key_name": {"nested": "x"}},
+  {"a_rather_long_key_name": 2, "another_long_key_name": {"nested": "y"}},
+  {"a_rather_long_key_name": 3, "short": [1, 2, 3]}
+])";
+
+}  // namespace
+
+TEST(FormatsJsonInternKeys, SameAsFromString) {
+  const auto interned = formats::json::FromStringInternKeys(kRepetitiveDoc);
+  const auto regular = formats::json::FromString(kRepetitiveDoc);
+  EXPECT_EQ(interned, regular);
+  EXPECT_EQ(formats::json::ToString(interned),
+            formats::json::ToString(regular));
+  EXPECT_EQ(interned[1]["another_long_key_name"]["nested"].As<std::string>(),
+            "y");
+  EXPECT_TRUE(interned[2].HasMember("short"));
+  EXPECT_FALSE(interned[2].HasMember("another_long_key_name"));
+}
+
+TEST(FormatsJsonInternKeys, Errors) {
+  EXPECT_THROW(formats::json::FromStringInternKeys(""),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringInternKeys(R"({"a": 1, "a": 2})"),
+               formats::json::ParseException);
+  try {
+    formats::json::FromStringInternKeys("{\n\"a\": }");
+    FAIL() << "Exception was not thrown";
+  } catch (const formats::json::ParseException& e) {
+    EXPECT_NE(std::string_view{e.what()}.find("line 2 column 6"),
+              std::string_view::npos)
+        << e.what();
+  }
+}
+
+TEST(FormatsJsonInternKeys, CopiesOutliveDocument) {
+  formats::json::ValueBuilder builder;
+  formats::json::Value clone;
+  {
+    const auto doc = formats::json::FromStringInternKeys(kRepetitiveDoc);
+    builder["first"] = doc[0];
+    builder["moved"] = formats::json::ValueBuilder{doc[1]};
+    clone = doc[2].Clone();
+  }
+  {
+    // keys of another document are copied
+    const auto other = formats::json::FromStringInternKeys(
+        R"({"a_rather_long_key_name_of_other": true})");
+    builder["other"] = other;
+  }
+
+  const auto value = builder.ExtractValue();
+  EXPECT_EQ(value["first"]["a_rather_long_key_name"].As<int>(), 1);
+  EXPECT_EQ(
+      value["moved"]["another_long_key_name"]["nested"].As<std::string>(),
+      "y");
+  EXPECT_TRUE(value["other"]["a_rather_long_key_name_of_other"].As<bool>());
+  EXPECT_EQ(clone["a_rather_long_key_name"].As<int>(), 3);
+  EXPECT_EQ(formats::json::ToString(clone),
+            R"({"a_rather_long_key_name":3,"short":[1,2,3]})");
+}
+
 USERVER_NAMESPACE_END
@@ -9,10 +9,10 @@
 #include <userver/utils/fast_pimpl.hpp>
 
 #include <formats/common/validations.hpp>
+#include <formats/json/impl/string_writer.hpp>
 
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,7 +20,7 @@ namespace formats::json {
 
 struct StringBuilder::Impl {
   rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer{buffer};
+  impl::YieldingStringWriter writer{buffer};
 
   Impl() = default;
 };
@@ -1,5 +1,9 @@
+#include <cstdint>
+#include <string_view>
+
 #include <benchmark/benchmark.h>
 
+#include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -73,4 +77,76 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+// ~150 bytes per element, up to 5 MB for the largest ranges
+constexpr std::string_view kPlainText =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod";
+constexpr std::string_view kEscapedText = "line \"one\"\n\tline two\\";
+
+void WriteElement(std::size_t i, StringBuilder& sw) {
+  StringBuilder::ObjectGuard guard(sw);
+  sw.Key("id");
+  sw.WriteUInt64(i);
+  sw.Key("text");
+  sw.WriteString(kPlainText);
+  sw.Key("escaped");
+  sw.WriteString(kEscapedText);
+  sw.Key("score");
+  sw.WriteDouble(static_cast<double>(i) / 7);
+}
+
+Value BuildLargeArray(std::size_t size) {
+  StringBuilder sw;
+  {
+    StringBuilder::ArrayGuard guard(sw);
+    for (std::size_t i = 0; i < size; ++i) WriteElement(i, sw);
+  }
+  return FromString(sw.GetStringView());
+}
+
+void JsonSerializeLargeArray(benchmark::State& state) {
+  const auto json = BuildLargeArray(state.range(0));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    const auto res = ToString(json);
+    bytes += res.size();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerializeLargeArray)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 15);
+
+void JsonStringBuilderLargeArray(benchmark::State& state) {
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    StringBuilder sw;
+    {
+      StringBuilder::ArrayGuard guard(sw);
+      for (std::int64_t i = 0; i < state.range(0); ++i) WriteElement(i, sw);
+    }
+    bytes += sw.GetStringView().size();
+    benchmark::DoNotOptimize(sw.GetStringView());
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonStringBuilderLargeArray)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 15);
+
+void JsonStringBuilderWriteValue(benchmark::State& state) {
+  const auto json = BuildLargeArray(state.range(0));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    StringBuilder sw;
+    sw.WriteValue(json);
+    bytes += sw.GetStringView().size();
+    benchmark::DoNotOptimize(sw.GetStringView());
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonStringBuilderWriteValue)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 15);
+
 USERVER_NAMESPACE_END
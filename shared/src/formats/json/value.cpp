@@ -344,7 +344,11 @@ std::string Value::GetPath() const {
 }
 
 Value Value::Clone() const {
-  return Value{impl::VersionedValuePtr::Create(GetNative(), g_allocator)};
+  auto clone = impl::VersionedValuePtr::Create(GetNative(), g_allocator);
+  // the interned keys are referenced, not copied
+  [[maybe_unused]] const bool shared = clone.ShareInternedKeys(root_);
+  UASSERT(shared);
+  return Value{std::move(clone)};
 }
 
 // Value states
@@ -107,17 +107,21 @@ ValueBuilder& ValueBuilder::operator=(ValueBuilder&& other) {
 ValueBuilder::ValueBuilder(const formats::json::Value& other) {
   // As we have new native object created,
   // we fill it with the copy from other's native object.
-  value_->GetNative().CopyFrom(other.GetNative(), g_allocator);
+  auto& native = value_->GetNative();
+  const bool share_keys = value_->root_.ShareInternedKeys(other.root_);
+  native.CopyFrom(other.GetNative(), g_allocator, !share_keys);
 }
 
 ValueBuilder::ValueBuilder(formats::json::Value&& other) {
   // As we have new native object created,
   // we fill it with the other's native object.
-  if (other.IsUniqueReference())
-    value_->GetNative() = std::move(other.GetNative());
+  auto& native = value_->GetNative();
+  const bool share_keys = value_->root_.ShareInternedKeys(other.root_);
+  if (other.IsUniqueReference() && share_keys)
+    native = std::move(other.GetNative());
   else
     // rapidjson uses move semantics in assignment
-    value_->GetNative().CopyFrom(other.GetNative(), g_allocator);
+    native.CopyFrom(other.GetNative(), g_allocator, !share_keys);
 }
 
 ValueBuilder::ValueBuilder(EmplaceEnabler,
@@ -228,7 +232,8 @@ void ValueBuilder::PushBack(ValueBuilder&& bld) {
     }
   };
 
-  if (bld.value_->IsRoot()) {
+  if (bld.value_->IsRoot() &&
+      value_->root_.ShareInternedKeys(bld.value_->root_)) {
     // PushBack is moving value via RawAssign
     checked_push_back(bld.value_->GetNative());
   } else {
@@ -246,11 +251,13 @@ formats::json::Value ValueBuilder::ExtractValue() {
 }
 
 void ValueBuilder::Copy(impl::Value& to, const ValueBuilder& from) {
-  to.CopyFrom(from.value_->GetNative(), g_allocator);
+  const bool share_keys = value_->root_.ShareInternedKeys(from.value_->root_);
+  to.CopyFrom(from.value_->GetNative(), g_allocator, !share_keys);
 }
 
 void ValueBuilder::Move(impl::Value& to, ValueBuilder&& from) {
-  if (from.value_->IsRoot()) {
+  if (from.value_->IsRoot() &&
+      value_->root_.ShareInternedKeys(from.value_->root_)) {
     to = std::move(from.value_->GetNative());
   } else {
     Copy(to, from);
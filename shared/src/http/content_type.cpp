@@ -259,6 +259,7 @@ std::ostream& operator<<(std::ostream& os, const ContentType& content_type) {
 namespace content_type {
 
 extern const ContentType kApplicationJson = "application/json; charset=utf-8";
+extern const ContentType kApplicationCbor = "application/cbor";
 
 }  // namespace content_type
 }  // namespace http
@@ -1,6 +1,10 @@
 #include <userver/http/url.hpp>
 
-#include <array>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 USERVER_NAMESPACE_BEGIN
 
@@ -10,10 +14,37 @@ namespace {
 
 const std::string_view kSchemaSeparator = "://";
 
-void UrlEncodeTo(std::string_view input_string, std::string& result) {
+#ifdef __SSE2__
+// Returns true if none of the 16 chars at `data` need to be percent-encoded
+bool IsUnreservedBlock(const char* data) {
+  const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const auto in_range = [](__m128i chars, char first, char last) {
+    // non-ASCII chars are negative and fall out of any range
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)),
+                         _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
+  };
+  const auto equal = [block](char c) {
+    return _mm_cmpeq_epi8(block, _mm_set1_epi8(c));
+  };
+
+  auto unreserved = _mm_or_si128(
+      in_range(block, '0', '9'),
+      in_range(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a', 'z'));
+  unreserved = _mm_or_si128(
+      unreserved, _mm_or_si128(_mm_or_si128(equal('-'), equal('_')),
+                               _mm_or_si128(equal('.'), equal('!'))));
+  unreserved = _mm_or_si128(
+      unreserved, _mm_or_si128(_mm_or_si128(equal('~'), equal('*')),
+                               _mm_or_si128(equal('('), equal(')'))));
+  unreserved = _mm_or_si128(unreserved, equal('\''));
+  return _mm_movemask_epi8(unreserved) == 0xffff;
+}
+#endif
+
+char* UrlEncodeChars(std::string_view input_string, char* dst) {
   for (char symbol : input_string) {
     if (isalnum(symbol)) {
-      result.append(1, symbol);
+      *(dst++) = symbol;
       continue;
     }
     switch (symbol) {
@@ -26,18 +57,41 @@ void UrlEncodeTo(std::string_view input_string, std::string& result) {
       case '(':
       case ')':
       case '\'':
-        result.append(1, symbol);
+        *(dst++) = symbol;
         break;
       default:
-        std::array<char, 3> bytes = {'%', 0, 0};
-        bytes[1] = (symbol & 0xF0) / 16;
-        bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
-        bytes[2] = symbol & 0x0F;
-        bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
-        result.append(bytes.data(), bytes.size());
+        const char high = (symbol & 0xF0) / 16;
+        const char low = symbol & 0x0F;
+        *(dst++) = '%';
+        *(dst++) = high + ((high > 9) ? 'A' - 10 : '0');
+        *(dst++) = low + ((low > 9) ? 'A' - 10 : '0');
         break;
     }
   }
+  return dst;
+}
+
+void UrlEncodeTo(std::string_view input_string, std::string& result) {
+  const auto old_size = result.size();
+  result.resize(old_size + 3 * input_string.size());
+  auto* dst = result.data() + old_size;
+
+#ifdef __SSE2__
+  // most of the input is usually unreserved and is copied as is
+  constexpr std::size_t kBlockSize = 16;
+  while (input_string.size() >= kBlockSize) {
+    const auto block = input_string.substr(0, kBlockSize);
+    if (IsUnreservedBlock(block.data())) {
+      dst = std::copy(block.begin(), block.end(), dst);
+    } else {
+      dst = UrlEncodeChars(block, dst);
+    }
+    input_string.remove_prefix(kBlockSize);
+  }
+#endif
+
+  dst = UrlEncodeChars(input_string, dst);
+  result.resize(dst - result.data());
 }
 
 }  // namespace
@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <string>
+
 #include <userver/http/url.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +29,21 @@ BENCHMARK(make_url_small);
 void make_url_big(benchmark::State& state) { make_url(state, 5000); }
 BENCHMARK(make_url_big);
 
+void url_encode(benchmark::State& state) {
+  // mostly unreserved chars with an occasional reserved one, as in the
+  // typical query arguments
+  std::string source;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    source.push_back(i % 50 == 49 ? ' ' : static_cast<char>('a' + i % 26));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(http::UrlEncode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(url_encode)->RangeMultiplier(8)->Range(8, 64 << 10);
+
 void make_query(benchmark::State& state) {
   http::Args query_args;
   const auto agrs_count = state.range(0);
@@ -1,3 +1,4 @@
+#include <string>
 #include <string_view>
 
 #include <gtest/gtest.h>
@@ -21,6 +22,28 @@ TEST(UrlEncode, Special) {
   EXPECT_EQ("Text%20with%20spaces%2C%3F%26%3D", UrlEncode(str));
 }
 
+TEST(UrlEncode, AllChars) {
+  std::string str;
+  std::string expected;
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (int c = 0; c < 256; ++c) {
+      str.push_back(static_cast<char>(c));
+      expected += UrlEncode(std::string(1, static_cast<char>(c)));
+    }
+    // long unreserved runs
+    str += "abcdefghijklmnopqrstuvwxyz0123456789-_.!~*()'";
+    expected += "abcdefghijklmnopqrstuvwxyz0123456789-_.!~*()'";
+  }
+
+  for (std::size_t offset = 0; offset < 16; ++offset) {
+    const auto input = std::string_view{str}.substr(offset);
+    std::string expected_suffix;
+    for (const char c : input) expected_suffix += UrlEncode({&c, 1});
+    EXPECT_EQ(expected_suffix, UrlEncode(input));
+  }
+  EXPECT_EQ(expected, UrlEncode(str));
+}
+
 TEST(UrlDecode, Empty) { EXPECT_EQ("", UrlDecode("")); }
 
 TEST(UrlDecode, Latin) {
@@ -11,6 +11,7 @@
 
 #include <userver/utils/assert.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <utils/datetime/rfc3339.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -44,6 +45,25 @@ const cctz::time_zone& GetLocalTimezone() {
   return kLocalTz;
 }
 
+// Parses the fixed formats without looking up the UTC time zone
+std::optional<std::chrono::system_clock::time_point> OptionalUtcStringtime(
+    const std::string& timestring, impl::UtcFormat format) {
+  using Duration = std::chrono::system_clock::duration;
+  constexpr auto kMaxSeconds =
+      std::chrono::duration_cast<std::chrono::seconds>(Duration::max()).count();
+
+  const auto parsed = impl::ParseUtc(timestring, format);
+  // let cctz deal with the overflows
+  if (!parsed || parsed->seconds >= kMaxSeconds ||
+      parsed->seconds <= -kMaxSeconds) {
+    return {};
+  }
+  return std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<Duration>(
+          std::chrono::seconds{parsed->seconds} +
+          std::chrono::nanoseconds{parsed->nanoseconds})};
+}
+
 std::optional<std::chrono::system_clock::time_point> OptionalStringtime(
     const std::string& timestring, const cctz::time_zone& timezone,
     const std::string& format) {
@@ -104,6 +124,12 @@ bool IsTimeBetween(int hour, int min, int hour_from, int min_from, int hour_to,
 
 std::string Timestring(std::chrono::system_clock::time_point tp,
                        const std::string& timezone, const std::string& format) {
+  if (timezone == kDefaultTimezone) {
+    if (const auto utc_format = impl::FindUtcFormat(format)) {
+      auto result = impl::FormatUtc(tp, *utc_format);
+      if (result) return std::move(*result);
+    }
+  }
   return cctz::format(format, tp, GetTimezone(timezone));
 }
 
@@ -127,6 +153,13 @@ std::string LocalTimezoneTimestring(time_t timestamp,
 std::chrono::system_clock::time_point Stringtime(const std::string& timestring,
                                                  const std::string& timezone,
                                                  const std::string& format) {
+  if (timezone == kDefaultTimezone) {
+    if (const auto utc_format = impl::FindUtcFormat(format)) {
+      const auto optional_tp = OptionalUtcStringtime(timestring, *utc_format);
+      if (optional_tp) return *optional_tp;
+    }
+  }
+
   const auto optional_tp =
       OptionalStringtime(timestring, GetTimezone(timezone), format);
   if (!optional_tp) {
@@ -147,6 +180,15 @@ std::chrono::system_clock::time_point LocalTimezoneStringtime(
 
 std::chrono::system_clock::time_point GuessStringtime(
     const std::string& timestamp, const std::string& timezone) {
+  if (timezone == kDefaultTimezone) {
+    // the guessed formats differ only in the UTC offset, ParseUtc() accepts
+    // both "Z" and the offsets of the format
+    for (const auto format : {impl::UtcFormat::kRfc3339,
+                              impl::UtcFormat::kDefault}) {
+      const auto optional_tp = OptionalUtcStringtime(timestamp, format);
+      if (optional_tp) return *optional_tp;
+    }
+  }
   return DoGuessStringtime(timestamp, GetTimezone(timezone));
 }
 
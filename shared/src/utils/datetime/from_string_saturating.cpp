@@ -3,6 +3,7 @@
 #include <cctz/time_zone.h>
 
 #include <userver/utils/datetime.hpp>
+#include <utils/datetime/rfc3339.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,11 +34,20 @@ std::chrono::system_clock::time_point FromStringSaturating(
 
   constexpr cctz::time_point<Days> kTaxiInfinity{DaysBetweenYears(1970, 10000)};
 
-  // reimplement cctz::parse() because we cannot distinguish overflow otherwise
+  // reimplement cctz::parse() because we cannot distinguish overflow otherwise,
+  // the fixed formats are parsed without cctz
   cctz::time_point<cctz::seconds> tp_seconds;
   cctz::detail::femtoseconds femtoseconds;
-  if (!cctz::detail::parse(format, timestring, cctz::utc_time_zone(),
-                           &tp_seconds, &femtoseconds)) {
+
+  const auto utc_format = impl::FindUtcFormat(format);
+  const auto parsed =
+      utc_format ? impl::ParseUtc(timestring, *utc_format) : std::nullopt;
+  if (parsed) {
+    tp_seconds =
+        cctz::time_point<cctz::seconds>{cctz::seconds{parsed->seconds}};
+    femtoseconds = std::chrono::nanoseconds{parsed->nanoseconds};
+  } else if (!cctz::detail::parse(format, timestring, cctz::utc_time_zone(),
+                                  &tp_seconds, &femtoseconds)) {
     throw DateParseError(timestring);
   }
 
@@ -0,0 +1,254 @@
+#include <utils/datetime/rfc3339.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include <userver/utils/datetime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime::impl {
+
+namespace {
+
+constexpr std::int64_t kSecondsInDay = 24 * 60 * 60;
+constexpr std::int64_t kNanosecondsInSecond = 1'000'000'000;
+
+// "YYYY-MM-DDTHH:MM:SS"
+constexpr std::size_t kDateTimeSize = 19;
+
+struct CivilDay final {
+  std::int64_t year;
+  unsigned month;
+  unsigned day;
+};
+
+// https://howardhinnant.github.io/date_algorithms.html#civil_from_days
+constexpr CivilDay CivilFromDays(std::int64_t days) noexcept {
+  days += 719468;
+  const auto era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto doe = static_cast<unsigned>(days - era * 146097);  // [0, 146096]
+  const auto yoe =
+      (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+  const auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);    // [0, 365]
+  const auto mp = (5 * doy + 2) / 153;                         // [0, 11]
+  const auto day = doy - (153 * mp + 2) / 5 + 1;               // [1, 31]
+  const auto month = mp < 10 ? mp + 3 : mp - 9;                // [1, 12]
+  return {static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2), month,
+          day};
+}
+
+// https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+constexpr std::int64_t DaysFromCivil(std::int64_t year, unsigned month,
+                                     unsigned day) noexcept {
+  year -= month <= 2;
+  const auto era = (year >= 0 ? year : year - 399) / 400;
+  const auto yoe = static_cast<unsigned>(year - era * 400);  // [0, 399]
+  const auto doy =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;  // [0, 146096]
+  return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+static_assert(DaysFromCivil(1970, 1, 1) == 0);
+static_assert(CivilFromDays(DaysFromCivil(2000, 2, 29)).day == 29);
+
+constexpr unsigned DaysInMonth(std::int64_t year, unsigned month) noexcept {
+  constexpr std::array<unsigned, 12> kDays{31, 28, 31, 30, 31, 30,
+                                           31, 31, 30, 31, 30, 31};
+  if (month == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
+    return 29;
+  }
+  return kDays[month - 1];
+}
+
+char* WriteDigits(char* out, unsigned value, std::size_t digits) noexcept {
+  for (std::size_t i = digits; i > 0; --i) {
+    out[i - 1] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return out + digits;
+}
+
+// Formatted date and time of the last formatted second
+struct SecondCache final {
+  std::int64_t seconds{std::numeric_limits<std::int64_t>::min()};
+  std::array<char, kDateTimeSize> date_time{};
+};
+
+thread_local SecondCache second_cache;
+
+bool FormatDateTime(std::int64_t seconds,
+                    std::array<char, kDateTimeSize>& out) {
+  auto days = seconds / kSecondsInDay;
+  auto day_seconds = seconds % kSecondsInDay;
+  if (day_seconds < 0) {
+    day_seconds += kSecondsInDay;
+    --days;
+  }
+
+  const auto civil = CivilFromDays(days);
+  if (civil.year < 1000 || civil.year > 9999) return false;
+
+  const auto day_seconds_unsigned = static_cast<unsigned>(day_seconds);
+  auto* ptr = WriteDigits(out.data(), civil.year, 4);
+  *(ptr++) = '-';
+  ptr = WriteDigits(ptr, civil.month, 2);
+  *(ptr++) = '-';
+  ptr = WriteDigits(ptr, civil.day, 2);
+  *(ptr++) = 'T';
+  ptr = WriteDigits(ptr, day_seconds_unsigned / 3600, 2);
+  *(ptr++) = ':';
+  ptr = WriteDigits(ptr, day_seconds_unsigned / 60 % 60, 2);
+  *(ptr++) = ':';
+  WriteDigits(ptr, day_seconds_unsigned % 60, 2);
+  return true;
+}
+
+// Parses exactly `digits` decimal digits
+bool ParseDigits(std::string_view str, std::size_t pos, std::size_t digits,
+                 unsigned& result) noexcept {
+  if (str.size() < pos + digits) return false;
+  result = 0;
+  for (std::size_t i = pos; i < pos + digits; ++i) {
+    const auto digit = static_cast<unsigned>(str[i] - '0');
+    if (digit > 9) return false;
+    result = result * 10 + digit;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<UtcFormat> FindUtcFormat(const std::string& format) noexcept {
+  if (format == kRfc3339Format) return UtcFormat::kRfc3339;
+  if (format == kDefaultFormat) return UtcFormat::kDefault;
+  if (format == kTaximeterFormat) return UtcFormat::kTaximeter;
+  if (format == kIsoFormat) return UtcFormat::kIso;
+  return std::nullopt;
+}
+
+std::optional<std::string> FormatUtc(std::chrono::system_clock::time_point tp,
+                                     UtcFormat format) {
+  const auto nanoseconds_since_epoch =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          tp.time_since_epoch())
+          .count();
+  auto seconds = nanoseconds_since_epoch / kNanosecondsInSecond;
+  auto nanoseconds = nanoseconds_since_epoch % kNanosecondsInSecond;
+  if (nanoseconds < 0) {
+    nanoseconds += kNanosecondsInSecond;
+    --seconds;
+  }
+
+  auto& cache = second_cache;
+  if (cache.seconds != seconds) {
+    if (!FormatDateTime(seconds, cache.date_time)) return std::nullopt;
+    cache.seconds = seconds;
+  }
+
+  // "YYYY-MM-DDTHH:MM:SS.nnnnnnnnn+00:00"
+  std::array<char, kDateTimeSize + 16> buffer{};
+  std::copy(cache.date_time.begin(), cache.date_time.end(), buffer.begin());
+  auto* ptr = buffer.data() + kDateTimeSize;
+
+  switch (format) {
+    case UtcFormat::kRfc3339:
+    case UtcFormat::kDefault:
+      if (nanoseconds != 0) {
+        // %E*S drops the trailing zeros of the fraction
+        auto digits = 9;
+        auto fraction = static_cast<unsigned>(nanoseconds);
+        while (fraction % 10 == 0) {
+          fraction /= 10;
+          --digits;
+        }
+        *(ptr++) = '.';
+        ptr = WriteDigits(ptr, fraction, digits);
+      }
+      for (const char c : std::string_view{
+               format == UtcFormat::kRfc3339 ? "+00:00" : "+0000"}) {
+        *(ptr++) = c;
+      }
+      break;
+    case UtcFormat::kTaximeter:
+      *(ptr++) = '.';
+      ptr = WriteDigits(ptr, static_cast<unsigned>(nanoseconds / 1000), 6);
+      *(ptr++) = 'Z';
+      break;
+    case UtcFormat::kIso:
+      *(ptr++) = 'Z';
+      break;
+  }
+
+  return std::string(buffer.data(), ptr);
+}
+
+std::optional<ParsedTime> ParseUtc(std::string_view timestring,
+                                   UtcFormat format) noexcept {
+  if (format != UtcFormat::kRfc3339 && format != UtcFormat::kDefault) {
+    return std::nullopt;
+  }
+
+  unsigned year = 0;
+  unsigned month = 0;
+  unsigned day = 0;
+  unsigned hour = 0;
+  unsigned minute = 0;
+  unsigned second = 0;
+  if (timestring.size() < kDateTimeSize + 1 ||
+      !ParseDigits(timestring, 0, 4, year) || timestring[4] != '-' ||
+      !ParseDigits(timestring, 5, 2, month) || timestring[7] != '-' ||
+      !ParseDigits(timestring, 8, 2, day) || timestring[10] != 'T' ||
+      !ParseDigits(timestring, 11, 2, hour) || timestring[13] != ':' ||
+      !ParseDigits(timestring, 14, 2, minute) || timestring[16] != ':' ||
+      !ParseDigits(timestring, 17, 2, second)) {
+    return std::nullopt;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month) ||
+      hour > 23 || minute > 59 || second > 59) {
+    return std::nullopt;
+  }
+
+  std::size_t pos = kDateTimeSize;
+  std::int64_t nanoseconds = 0;
+  if (timestring[pos] == '.') {
+    const auto fraction_begin = ++pos;
+    std::int64_t scale = kNanosecondsInSecond;
+    while (pos < timestring.size() && '0' <= timestring[pos] &&
+           timestring[pos] <= '9') {
+      if (pos - fraction_begin == 9) return std::nullopt;
+      scale /= 10;
+      nanoseconds += (timestring[pos] - '0') * scale;
+      ++pos;
+    }
+    if (pos == fraction_begin) return std::nullopt;
+  }
+
+  std::int64_t offset_minutes = 0;
+  const auto offset = timestring.substr(pos);
+  if (offset != "Z") {
+    const bool with_colon = (format == UtcFormat::kRfc3339);
+    unsigned offset_hours = 0;
+    unsigned offset_mins = 0;
+    if (offset.size() != (with_colon ? 6 : 5) ||
+        (offset[0] != '+' && offset[0] != '-') ||
+        !ParseDigits(offset, 1, 2, offset_hours) ||
+        (with_colon && offset[3] != ':') ||
+        !ParseDigits(offset, with_colon ? 4 : 3, 2, offset_mins) ||
+        offset_hours > 23 || offset_mins > 59) {
+      return std::nullopt;
+    }
+    offset_minutes = offset_hours * 60 + offset_mins;
+    if (offset[0] == '-') offset_minutes = -offset_minutes;
+  }
+
+  const auto seconds = DaysFromCivil(year, month, day) * kSecondsInDay +
+                       hour * 3600 + minute * 60 + second - offset_minutes * 60;
+  return ParsedTime{seconds, nanoseconds};
+}
+
+}  // namespace utils::datetime::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime::impl {
+
+/// The fixed formats that are formatted and parsed without cctz in UTC
+enum class UtcFormat {
+  kRfc3339,    ///< kRfc3339Format, "%Y-%m-%dT%H:%M:%E*S%Ez"
+  kDefault,    ///< kDefaultFormat, "%Y-%m-%dT%H:%M:%E*S%z"
+  kTaximeter,  ///< kTaximeterFormat, "%Y-%m-%dT%H:%M:%E6SZ"
+  kIso,        ///< kIsoFormat, "%Y-%m-%dT%H:%M:%SZ"
+};
+
+/// Returns the fixed format that matches the cctz `format`, if any
+std::optional<UtcFormat> FindUtcFormat(const std::string& format) noexcept;
+
+/// @brief Formats `tp` in UTC exactly as cctz::format() does for the
+/// corresponding format string.
+///
+/// The formatted date and time of the last second are cached per thread, so
+/// that timestamps of the same second, e.g. in logs, only format the
+/// fraction.
+///
+/// Returns std::nullopt for the years that are not of 4 digits, cctz does not
+/// pad them.
+std::optional<std::string> FormatUtc(std::chrono::system_clock::time_point tp,
+                                     UtcFormat format);
+
+/// Seconds and nanoseconds since the epoch
+struct ParsedTime final {
+  std::int64_t seconds{0};
+  std::int64_t nanoseconds{0};
+};
+
+/// @brief Parses the canonical "YYYY-MM-DDTHH:MM:SS[.fraction]" followed by
+/// "Z" or an UTC offset of kRfc3339 ("+hh:mm") or kDefault ("+hhmm").
+///
+/// Returns std::nullopt for anything else, including the valid inputs that
+/// cctz accepts leniently (leap seconds, whitespaces, short fields, more
+/// than 9 digits of fraction). Callers should fall back to cctz::parse() then.
+std::optional<ParsedTime> ParseUtc(std::string_view timestring,
+                                   UtcFormat format) noexcept;
+
+}  // namespace utils::datetime::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#include <utils/datetime/rfc3339.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <cctz/time_zone.h>
+
+#include <userver/utils/datetime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const std::string kTimestring = "2018-11-07T13:28:44.194045+03:00";
+
+}  // namespace
+
+void datetime_cctz_format(benchmark::State& state) {
+  const auto utc = cctz::utc_time_zone();
+  auto tp = std::chrono::system_clock::now();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        cctz::format(utils::datetime::kRfc3339Format, tp, utc));
+    tp += std::chrono::milliseconds{1};
+  }
+}
+BENCHMARK(datetime_cctz_format);
+
+void datetime_utc_format(benchmark::State& state) {
+  auto tp = std::chrono::system_clock::now();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::Timestring(
+        tp, "UTC", utils::datetime::kRfc3339Format));
+    tp += std::chrono::milliseconds{1};
+  }
+}
+BENCHMARK(datetime_utc_format);
+
+void datetime_cctz_parse(benchmark::State& state) {
+  const auto utc = cctz::utc_time_zone();
+  std::chrono::system_clock::time_point tp;
+  for (auto _ : state) {
+    cctz::parse(utils::datetime::kRfc3339Format, kTimestring, utc, &tp);
+    benchmark::DoNotOptimize(tp);
+  }
+}
+BENCHMARK(datetime_cctz_parse);
+
+void datetime_utc_parse(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::Stringtime(
+        kTimestring, "UTC", utils::datetime::kRfc3339Format));
+  }
+}
+BENCHMARK(datetime_utc_parse);
+
+USERVER_NAMESPACE_END
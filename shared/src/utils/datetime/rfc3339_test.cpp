@@ -0,0 +1,105 @@
+#include <utils/datetime/rfc3339.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cctz/time_zone.h>
+
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/from_string_saturating.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+const std::vector<TimePoint> kTimePoints{
+    TimePoint{},
+    TimePoint{std::chrono::seconds{1541597324}},
+    TimePoint{std::chrono::seconds{1541597324} +
+              std::chrono::microseconds{194045}},
+    TimePoint{std::chrono::seconds{1541597324} +
+              std::chrono::milliseconds{100}},
+    TimePoint{std::chrono::seconds{951782400}},  // 2000-02-29
+    TimePoint{std::chrono::seconds{-1} + std::chrono::microseconds{1}},
+    TimePoint{std::chrono::seconds{-2208988800}},  // 1900-01-01
+};
+
+}  // namespace
+
+TEST(DatetimeUtc, FormatAsCctz) {
+  for (const auto& format :
+       {utils::datetime::kRfc3339Format, utils::datetime::kDefaultFormat,
+        utils::datetime::kTaximeterFormat, utils::datetime::kIsoFormat}) {
+    const auto utc_format = utils::datetime::impl::FindUtcFormat(format);
+    ASSERT_TRUE(utc_format);
+
+    for (const auto tp : kTimePoints) {
+      const auto expected = cctz::format(format, tp, cctz::utc_time_zone());
+      // the second call uses the cached date and time
+      EXPECT_EQ(utils::datetime::impl::FormatUtc(tp, *utc_format), expected);
+      EXPECT_EQ(utils::datetime::impl::FormatUtc(tp, *utc_format), expected);
+      EXPECT_EQ(utils::datetime::Timestring(tp, "UTC", format), expected);
+    }
+  }
+
+  EXPECT_FALSE(utils::datetime::impl::FindUtcFormat("%Y-%m-%d"));
+  EXPECT_EQ(utils::datetime::Timestring(kTimePoints[2], "UTC",
+                                        utils::datetime::kRfc3339Format),
+            "2018-11-07T13:28:44.194045+00:00");
+}
+
+TEST(DatetimeUtc, ParseAsCctz) {
+  for (const std::string timestring : {
+           "2018-11-07T13:28:44+03:00",
+           "2018-11-07T13:28:44.194045+03:00",
+           "2018-11-07T13:28:44.1-00:30",
+           "2018-11-07T13:28:44.123456789Z",
+           "2000-02-29T23:59:59Z",
+           "1969-12-31T23:59:59.5+00:00",
+       }) {
+    TimePoint expected;
+    ASSERT_TRUE(cctz::parse(utils::datetime::kRfc3339Format, timestring,
+                            cctz::utc_time_zone(), &expected));
+    EXPECT_TRUE(utils::datetime::impl::ParseUtc(
+        timestring, utils::datetime::impl::UtcFormat::kRfc3339));
+    EXPECT_EQ(utils::datetime::Stringtime(timestring, "UTC",
+                                          utils::datetime::kRfc3339Format),
+              expected);
+    EXPECT_EQ(utils::datetime::GuessStringtime(timestring, "UTC"), expected);
+    EXPECT_EQ(utils::datetime::FromRfc3339StringSaturating(timestring),
+              expected);
+  }
+
+  EXPECT_EQ(utils::datetime::Stringtime("2018-11-07T13:28:44.1+0300"),
+            utils::datetime::Stringtime("2018-11-07T10:28:44.1Z"));
+}
+
+TEST(DatetimeUtc, ParseFallsBackToCctz) {
+  for (const std::string_view timestring : {
+           "2018-11-07T13:28:44+0300",         // no colon in kRfc3339
+           "2018-11-07T13:28:44+03",           // no offset minutes
+           "2018-11-07T13:28:60Z",             // leap second
+           "2018-11-07T13:28:44.Z",            // empty fraction
+           "2018-11-07T13:28:44.1234567891Z",  // femtoseconds
+           "2018-02-30T13:28:44Z",             // invalid day
+           "18-11-07T13:28:44Z",               // short year
+           " 2018-11-07T13:28:44Z",            // leading whitespace
+       }) {
+    EXPECT_FALSE(utils::datetime::impl::ParseUtc(
+        timestring, utils::datetime::impl::UtcFormat::kRfc3339))
+        << timestring;
+  }
+
+  EXPECT_EQ(utils::datetime::Stringtime("2018-11-07T13:28:44+03", "UTC",
+                                        utils::datetime::kRfc3339Format),
+            utils::datetime::Stringtime("2018-11-07T10:28:44Z"));
+  EXPECT_THROW(utils::datetime::Stringtime("2018-02-30T13:28:44Z"),
+               utils::datetime::DateParseError);
+}
+
+USERVER_NAMESPACE_END
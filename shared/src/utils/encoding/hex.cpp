@@ -3,7 +3,9 @@
 #include <stdexcept>
 #include <string_view>
 
-#ifdef __SSSE3__
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSSE3__)
 #include <tmmintrin.h>
 #endif
 
@@ -111,6 +113,10 @@ const auto kDigitsMask = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
                                        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
 #endif
 
+#ifdef __AVX2__
+const auto kDigitsMask256 = _mm256_broadcastsi128_si256(kDigitsMask);
+#endif
+
 }  // namespace detail
 
 std::string_view GetHexPart(std::string_view encoded) noexcept {
@@ -138,6 +144,31 @@ void ToHex(std::string_view input, std::string& out) noexcept {
   const auto* last = input.data() + input.size();
   auto* dst = out.data();
 
+#ifdef __AVX2__
+  while (last - first >= 16) {
+    const auto sixteen_bytes_of_data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+    // the same as below, but 16 bytes at a time: 4 high bits and 4 low bits
+    // of each byte are interleaved into 32 bytes and gathered from kXdigits
+    // by a single shuffle
+    const auto high_bits = _mm_and_si128(
+        _mm_srli_epi64(sixteen_bytes_of_data, 4), detail::kLow4BitsMask);
+    const auto low_bits =
+        _mm_and_si128(sixteen_bytes_of_data, detail::kLow4BitsMask);
+    const auto interleaving_hi_lo =
+        _mm256_set_m128i(_mm_unpackhi_epi8(high_bits, low_bits),
+                         _mm_unpacklo_epi8(high_bits, low_bits));
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst),
+        _mm256_shuffle_epi8(detail::kDigitsMask256, interleaving_hi_lo));
+
+    first += 16;
+    dst += 32;
+  }
+#endif
+
 #ifdef __SSSE3__
   while (last - first >= 8) {
     // we only take 8 bytes because each byte transforms into 2 bytes
@@ -42,4 +42,20 @@ void to_hex_benchmark_no_alloc(benchmark::State& state) {
 }
 BENCHMARK(to_hex_benchmark_no_alloc)->RangeMultiplier(2)->Range(8, 512);
 
+void to_hex_benchmark_large(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+
+  std::string out;
+  out.reserve(state.range(0) * 2);
+  benchmark::DoNotOptimize(out);
+
+  for (auto _ : state) {
+    utils::encoding::ToHex(source, out);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(to_hex_benchmark_large)
+    ->RangeMultiplier(8)
+    ->Range(4 << 10, 256 << 10);
+
 USERVER_NAMESPACE_END
@@ -39,6 +39,20 @@ TEST(Hex, ToHexLong) {
   EXPECT_EQ(reference, result);
 }
 
+TEST(Hex, ToHexAllSizes) {
+  constexpr std::string_view kXdigits = "0123456789abcdef";
+  std::string data;
+  std::string reference;
+  for (int i = 0; i < 100; ++i) {
+    const auto byte = static_cast<char>(i * 37);
+    EXPECT_EQ(reference, ToHex(data));
+    data.push_back(byte);
+    reference += kXdigits[(byte >> 4) & 0xf];
+    reference += kXdigits[byte & 0xf];
+  }
+  EXPECT_EQ(reference, ToHex(data));
+}
+
 TEST(Hex, FromHex) {
   // Test simple case - everything is correct
   {
@@ -0,0 +1,106 @@
+#include <userver/utils/encoding/tskv.hpp>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::encoding {
+
+namespace {
+
+bool IsEscaped(char ch, EncodeTskvMode mode) noexcept {
+  switch (ch) {
+    case '\t':
+    case '\r':
+    case '\n':
+    case '\0':
+    case '\\':
+      return true;
+    case '.':
+      return mode == EncodeTskvMode::kKeyReplacePeriod;
+    case '=':
+      return mode != EncodeTskvMode::kValue;
+    default:
+      return mode != EncodeTskvMode::kValue && 'A' <= ch && ch <= 'Z';
+  }
+}
+
+#ifdef __AVX2__
+// Returns a bitmask of the chars in the 32 bytes block that are escaped
+unsigned EscapedMask(const char* data, EncodeTskvMode mode) noexcept {
+  const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const auto equal = [block](char c) {
+    return _mm256_cmpeq_epi8(block, _mm256_set1_epi8(c));
+  };
+
+  auto escaped =
+      _mm256_or_si256(_mm256_or_si256(equal('\t'), equal('\r')),
+                      _mm256_or_si256(equal('\n'), equal('\0')));
+  escaped = _mm256_or_si256(escaped, equal('\\'));
+  if (mode != EncodeTskvMode::kValue) {
+    // non-ASCII chars are negative and are not uppercase letters
+    const auto uppercase = _mm256_and_si256(
+        _mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+    escaped = _mm256_or_si256(escaped, _mm256_or_si256(uppercase, equal('=')));
+    if (mode == EncodeTskvMode::kKeyReplacePeriod) {
+      escaped = _mm256_or_si256(escaped, equal('.'));
+    }
+  }
+  return static_cast<unsigned>(_mm256_movemask_epi8(escaped));
+}
+
+constexpr std::size_t kBlockSize = 32;
+#elif defined(__SSE2__)
+// Returns a bitmask of the chars in the 16 bytes block that are escaped
+unsigned EscapedMask(const char* data, EncodeTskvMode mode) noexcept {
+  const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const auto equal = [block](char c) {
+    return _mm_cmpeq_epi8(block, _mm_set1_epi8(c));
+  };
+
+  auto escaped = _mm_or_si128(_mm_or_si128(equal('\t'), equal('\r')),
+                              _mm_or_si128(equal('\n'), equal('\0')));
+  escaped = _mm_or_si128(escaped, equal('\\'));
+  if (mode != EncodeTskvMode::kValue) {
+    // non-ASCII chars are negative and are not uppercase letters
+    const auto uppercase =
+        _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                      _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+    escaped = _mm_or_si128(escaped, _mm_or_si128(uppercase, equal('=')));
+    if (mode == EncodeTskvMode::kKeyReplacePeriod) {
+      escaped = _mm_or_si128(escaped, equal('.'));
+    }
+  }
+  return static_cast<unsigned>(_mm_movemask_epi8(escaped));
+}
+
+constexpr std::size_t kBlockSize = 16;
+#endif
+
+}  // namespace
+
+std::size_t FindTskvEscapedChar(std::string_view str,
+                                EncodeTskvMode mode) noexcept {
+  std::size_t pos = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+  for (; pos + kBlockSize <= str.size(); pos += kBlockSize) {
+    const auto mask = EscapedMask(str.data() + pos, mode);
+    if (mask != 0) return pos + __builtin_ctz(mask);
+  }
+#endif
+
+  for (; pos < str.size(); ++pos) {
+    if (IsEscaped(str[pos], mode)) break;
+  }
+  return pos;
+}
+
+}  // namespace utils::encoding
+
+USERVER_NAMESPACE_END
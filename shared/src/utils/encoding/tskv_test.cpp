@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -35,4 +36,34 @@ TEST(tskv, TAXICOMMON1362) {
       << "Result: " << result;
 }
 
+TEST(tskv, FindEscapedChar) {
+  for (auto mode : {utils::encoding::EncodeTskvMode::kValue,
+                    utils::encoding::EncodeTskvMode::kKey,
+                    utils::encoding::EncodeTskvMode::kKeyReplacePeriod}) {
+    for (int c = 0; c < 256; ++c) {
+      const auto ch = static_cast<char>(c);
+      std::string encoded;
+      utils::encoding::EncodeTskv(encoded, ch, mode);
+      const bool is_escaped = (encoded != std::string(1, ch));
+
+      // the char at every position of the SIMD blocks and of the tail
+      for (std::size_t size : {1, 15, 16, 17, 31, 32, 33, 70}) {
+        for (std::size_t pos = 0; pos < size; ++pos) {
+          std::string str(size, 'x');
+          str[pos] = ch;
+          EXPECT_EQ(utils::encoding::FindTskvEscapedChar(str, mode),
+                    is_escaped ? pos : size)
+              << "char " << c << " at " << pos << " of " << size;
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(utils::encoding::FindTskvEscapedChar(
+                "", utils::encoding::EncodeTskvMode::kValue),
+            0);
+  EXPECT_TRUE(utils::encoding::ShouldKeyBeEscaped("some.key"));
+  EXPECT_FALSE(utils::encoding::ShouldValueBeEscaped("some.value="));
+}
+
 USERVER_NAMESPACE_END
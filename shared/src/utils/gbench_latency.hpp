@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/statistics/percentile.hpp>
+
+// Latency and rate counters for google benchmark
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::gbench {
+
+// precise up to 1ms, then in 100us steps up to 101ms
+using LatencyPercentile =
+    utils::statistics::Percentile<1000, std::uint32_t, 1000, 100>;
+
+inline void Account(LatencyPercentile& latency,
+                    std::chrono::steady_clock::duration duration) {
+  latency.Account(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+inline void Account(LatencyPercentile& latency,
+                    std::chrono::steady_clock::time_point start) {
+  Account(latency, std::chrono::steady_clock::now() - start);
+}
+
+// Reports the latency percentiles in microseconds
+inline void ReportLatency(benchmark::State& state,
+                          const LatencyPercentile& latency) {
+  state.counters["p50-us"] = latency.GetPercentile(50);
+  state.counters["p99-us"] = latency.GetPercentile(99);
+  state.counters["p99.9-us"] = latency.GetPercentile(99.9);
+}
+
+inline void ReportRate(benchmark::State& state, const char* name,
+                       double count) {
+  state.counters[name] = benchmark::Counter(count, benchmark::Counter::kIsRate);
+}
+
+}  // namespace utils::gbench
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,133 @@
+#include <userver/utils/hash.hpp>
+
+#include <cstring>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+// The algorithm follows wyhash: a 64x64->128 bit multiplication folded with
+// XOR is the only mixing primitive.
+constexpr std::uint64_t kSecret[4] = {
+    0xa0761d6478bd642fULL,
+    0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL,
+    0x589965cc75374cc3ULL,
+};
+
+constexpr std::uint64_t RepeatByte(std::uint8_t byte) noexcept {
+  return 0x0101010101010101ULL * byte;
+}
+
+void MultiplyFold(std::uint64_t& a, std::uint64_t& b) noexcept {
+  const auto r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+}
+
+std::uint64_t Mix(std::uint64_t a, std::uint64_t b) noexcept {
+  MultiplyFold(a, b);
+  return a ^ b;
+}
+
+// Lowercases the ASCII letters in each of the 8 bytes at once, the bytes with
+// the high bit set are left intact.
+std::uint64_t ToLowerAscii8(std::uint64_t x) noexcept {
+  const std::uint64_t heptets = x & RepeatByte(0x7f);
+  // the high bit of a byte is set iff the heptet is greater than 'Z'
+  const std::uint64_t gt_z = heptets + RepeatByte(0x7f - 'Z');
+  // the high bit of a byte is set iff the heptet is not less than 'A'
+  const std::uint64_t ge_a = heptets + RepeatByte(0x80 - 'A');
+  const std::uint64_t is_upper = (ge_a ^ gt_z) & ~x & RepeatByte(0x80);
+  return x | (is_upper >> 2);
+}
+
+template <bool Icase>
+struct Reader final {
+  static std::uint64_t Read8(const unsigned char* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if constexpr (Icase) v = ToLowerAscii8(v);
+    return v;
+  }
+
+  static std::uint64_t Read4(const unsigned char* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if constexpr (Icase) return ToLowerAscii8(v);
+    return v;
+  }
+
+  // 1 to 3 bytes
+  static std::uint64_t ReadSmall(const unsigned char* p,
+                                 std::size_t size) noexcept {
+    const std::uint64_t v = (std::uint64_t{p[0]} << 16) |
+                            (std::uint64_t{p[size >> 1]} << 8) | p[size - 1];
+    if constexpr (Icase) return ToLowerAscii8(v);
+    return v;
+  }
+};
+
+template <bool Icase>
+std::uint64_t DoHash(std::string_view s, std::uint64_t seed) noexcept {
+  using R = Reader<Icase>;
+  const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+  const std::size_t size = s.size();
+
+  seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+
+  if (size <= 16) {
+    if (size >= 4) {
+      const std::size_t shift = (size >> 3) << 2;
+      a = (R::Read4(p) << 32) | R::Read4(p + shift);
+      b = (R::Read4(p + size - 4) << 32) | R::Read4(p + size - 4 - shift);
+    } else if (size > 0) {
+      a = R::ReadSmall(p, size);
+    }
+  } else {
+    std::size_t left = size;
+    if (left > 48) {
+      // three independent lanes keep the multipliers busy
+      std::uint64_t seed1 = seed;
+      std::uint64_t seed2 = seed;
+      do {
+        seed = Mix(R::Read8(p) ^ kSecret[1], R::Read8(p + 8) ^ seed);
+        seed1 = Mix(R::Read8(p + 16) ^ kSecret[2], R::Read8(p + 24) ^ seed1);
+        seed2 = Mix(R::Read8(p + 32) ^ kSecret[3], R::Read8(p + 40) ^ seed2);
+        p += 48;
+        left -= 48;
+      } while (left > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (left > 16) {
+      seed = Mix(R::Read8(p) ^ kSecret[1], R::Read8(p + 8) ^ seed);
+      p += 16;
+      left -= 16;
+    }
+    a = R::Read8(p + left - 16);
+    b = R::Read8(p + left - 8);
+  }
+
+  a ^= kSecret[1];
+  b ^= seed;
+  MultiplyFold(a, b);
+  return Mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+}
+
+}  // namespace
+
+std::uint64_t HashBytes(std::string_view s, std::uint64_t seed) noexcept {
+  return DoHash<false>(s, seed);
+}
+
+std::uint64_t HashBytesIcase(std::string_view s, std::uint64_t seed) noexcept {
+  return DoHash<true>(s, seed);
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
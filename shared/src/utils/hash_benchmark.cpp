@@ -0,0 +1,72 @@
+#include <userver/utils/hash.hpp>
+
+#include <functional>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <boost/functional/hash.hpp>
+
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeKey(std::size_t size) {
+  std::string key;
+  for (std::size_t i = 0; i < size; ++i) {
+    key.push_back("Content-Type"[i % 12]);
+  }
+  return key;
+}
+
+// the implementation of utils::StrIcaseHash before utils::HashBytesIcase
+std::size_t BoostHashIcase(std::string_view s, std::size_t seed) {
+  for (const char c : s) {
+    const char mask = (c >= 'A' && c <= 'Z') ? 32 : 0;
+    boost::hash_combine(seed, static_cast<char>(c | mask));
+  }
+  return seed;
+}
+
+}  // namespace
+
+void HashStd(benchmark::State& state) {
+  const auto key = MakeKey(state.range(0));
+  const std::hash<std::string_view> hash;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(hash(key));
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(HashStd)->RangeMultiplier(4)->Range(4, 4096);
+
+void HashBytes(benchmark::State& state) {
+  const auto key = MakeKey(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(utils::HashBytes(key, 42));
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(HashBytes)->RangeMultiplier(4)->Range(4, 4096);
+
+void HashBoostIcase(benchmark::State& state) {
+  const auto key = MakeKey(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(BoostHashIcase(key, 42));
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(HashBoostIcase)->RangeMultiplier(4)->Range(4, 4096);
+
+void HashStrIcase(benchmark::State& state) {
+  const auto key = MakeKey(state.range(0));
+  const utils::StrIcaseHash hash{42};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(hash(key));
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(HashStrIcase)->RangeMultiplier(4)->Range(4, 4096);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#include <userver/utils/hash.hpp>
+
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Hash, AllSizes) {
+  // every size hits a different read pattern, up to the 48-byte loop and past
+  std::string data;
+  std::unordered_set<std::uint64_t> hashes;
+  for (std::size_t size = 0; size <= 200; ++size) {
+    EXPECT_TRUE(hashes.insert(utils::HashBytes(data)).second) << size;
+    data.push_back(static_cast<char>('a' + size % 26));
+  }
+}
+
+TEST(Hash, EveryByteMatters) {
+  const std::string data(113, 'x');
+  const auto base = utils::HashBytes(data);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    auto changed = data;
+    changed[i] = 'y';
+    EXPECT_NE(utils::HashBytes(changed), base) << i;
+  }
+}
+
+TEST(Hash, Seed) {
+  constexpr std::string_view kData = "some key";
+  EXPECT_EQ(utils::HashBytes(kData, 42), utils::HashBytes(kData, 42));
+  EXPECT_NE(utils::HashBytes(kData, 42), utils::HashBytes(kData, 43));
+  EXPECT_NE(utils::HashBytes({}, 42), utils::HashBytes({}, 43));
+}
+
+TEST(Hash, Icase) {
+  std::string lower;
+  std::string upper;
+  for (std::size_t size = 0; size <= 100; ++size) {
+    EXPECT_EQ(utils::HashBytesIcase(lower, 1), utils::HashBytesIcase(upper, 1))
+        << size;
+    EXPECT_EQ(utils::HashBytesIcase(lower, 1), utils::HashBytes(lower, 1))
+        << size;
+
+    const char c = "azAZ09@[`{\x80\xc1\xff"[size % 13];
+    lower.push_back(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    upper.push_back(c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c);
+  }
+
+  // the neighbours of the letters are not folded
+  EXPECT_NE(utils::HashBytesIcase("@[`{"), utils::HashBytesIcase("`{@["));
+  EXPECT_NE(utils::HashBytesIcase("\xc1\xc1\xc1\xc1"),
+            utils::HashBytesIcase("\xe1\xe1\xe1\xe1"));
+}
+
+TEST(Hash, Mix) {
+  std::unordered_set<std::uint64_t> low_bits;
+  for (std::uint64_t i = 0; i < 64; ++i) {
+    low_bits.insert(utils::HashMix(i << 8) % 64);
+  }
+  // the values differing only in the high bits get different remainders
+  EXPECT_GT(low_bits.size(), 32);
+}
+
+USERVER_NAMESPACE_END
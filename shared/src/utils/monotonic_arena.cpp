@@ -0,0 +1,88 @@
+#include <userver/utils/monotonic_arena.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+constexpr std::size_t kMaxBlockSize = 1024 * 1024;
+
+bool IsPowerOf2(std::size_t value) noexcept {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+char* AlignUp(char* ptr, std::size_t alignment) noexcept {
+  const auto value = reinterpret_cast<std::uintptr_t>(ptr);
+  return ptr + ((alignment - value % alignment) % alignment);
+}
+
+}  // namespace
+
+struct MonotonicArena::Block {
+  Block* next;
+};
+
+MonotonicArena::MonotonicArena(std::size_t initial_block_size) noexcept
+    : next_block_size_(std::max(initial_block_size, sizeof(Block))) {}
+
+MonotonicArena::~MonotonicArena() { Release(); }
+
+void* MonotonicArena::Allocate(std::size_t size, std::size_t alignment) {
+  UASSERT(IsPowerOf2(alignment));
+
+  char* const result = AlignUp(current_, alignment);
+  if (current_ && result <= end_ &&
+      size <= static_cast<std::size_t>(end_ - result)) {
+    current_ = result + size;
+    return result;
+  }
+  return AllocateInNewBlock(size, alignment);
+}
+
+void MonotonicArena::Release() noexcept {
+  while (blocks_) {
+    auto* const next = blocks_->next;
+    std::free(blocks_);
+    blocks_ = next;
+  }
+  current_ = nullptr;
+  end_ = nullptr;
+}
+
+void* MonotonicArena::AllocateInNewBlock(std::size_t size,
+                                         std::size_t alignment) {
+  // malloc aligns by alignof(std::max_align_t), more is requested via padding
+  const auto header_size =
+      std::max(sizeof(Block), alignof(std::max_align_t));
+  const auto padding =
+      alignment > alignof(std::max_align_t) ? alignment : std::size_t{0};
+  if (size > std::numeric_limits<std::size_t>::max() - header_size - padding) {
+    throw std::bad_alloc();
+  }
+  const auto block_size =
+      std::max(next_block_size_, header_size + padding + size);
+
+  auto* const block = static_cast<Block*>(std::malloc(block_size));
+  if (!block) throw std::bad_alloc();
+  block->next = blocks_;
+  blocks_ = block;
+  allocated_bytes_ += block_size;
+  next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+
+  char* const data = reinterpret_cast<char*>(block) + header_size;
+  char* const result = AlignUp(data, alignment);
+  current_ = result + size;
+  end_ = reinterpret_cast<char*>(block) + block_size;
+  return result;
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,79 @@
+#include <userver/utils/monotonic_arena.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool IsAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(MonotonicArena, Sample) {
+  /// [Sample MonotonicArena]
+  utils::MonotonicArena arena;
+
+  using Allocator = utils::ArenaAllocator<int>;
+  std::vector<int, Allocator> values{Allocator{arena}};
+  for (int i = 0; i < 100; ++i) values.push_back(i);
+  EXPECT_EQ(values.back(), 99);
+
+  // all the memory is freed at once with the arena
+  /// [Sample MonotonicArena]
+}
+
+TEST(MonotonicArena, Alignment) {
+  utils::MonotonicArena arena{64};
+  for (const std::size_t alignment : {1, 2, 8, 16, 64, 256}) {
+    arena.Allocate(1, 1);
+    const auto* ptr = arena.Allocate(3, alignment);
+    EXPECT_TRUE(IsAligned(ptr, alignment)) << alignment;
+  }
+}
+
+TEST(MonotonicArena, Blocks) {
+  utils::MonotonicArena arena{128};
+  EXPECT_EQ(arena.GetAllocatedBytes(), 0);
+
+  auto* first = static_cast<char*>(arena.Allocate(16));
+  auto* second = static_cast<char*>(arena.Allocate(16));
+  EXPECT_EQ(second, first + 16);
+  const auto first_block = arena.GetAllocatedBytes();
+  EXPECT_EQ(first_block, 128);
+
+  // does not fit into the first block
+  arena.Allocate(1000);
+  EXPECT_GE(arena.GetAllocatedBytes(), first_block + 1000);
+
+  arena.Release();
+  EXPECT_NE(arena.Allocate(16), nullptr);
+}
+
+TEST(MonotonicArena, Containers) {
+  utils::MonotonicArena arena;
+
+  using String =
+      std::basic_string<char, std::char_traits<char>,
+                        utils::ArenaAllocator<char>>;
+  using Map = std::unordered_map<
+      int, String, std::hash<int>, std::equal_to<>,
+      utils::ArenaAllocator<std::pair<const int, String>>>;
+
+  Map map{Map::allocator_type{arena}};
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, String(100, 'a' + i % 26, String::allocator_type{arena}));
+  }
+  EXPECT_EQ(map.size(), 100);
+  EXPECT_EQ(map.at(27), String(100, 'b', String::allocator_type{arena}));
+  EXPECT_GE(arena.GetAllocatedBytes(), 100 * 100);
+}
+
+USERVER_NAMESPACE_END
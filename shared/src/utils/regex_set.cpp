@@ -0,0 +1,151 @@
+#include <userver/utils/regex_set.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef USERVER_FEATURE_RE2
+#include <re2/re2.h>
+#include <re2/set.h>
+#else
+#include <boost/regex.hpp>
+#endif
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+#ifdef USERVER_FEATURE_RE2
+
+namespace {
+
+RE2::Options MakeOptions() {
+  RE2::Options options;
+  options.set_log_errors(false);
+  return options;
+}
+
+}  // namespace
+
+struct RegexSet::Impl {
+  Impl(const std::vector<std::string>& patterns, Mode mode)
+      : set(MakeOptions(),
+            mode == Mode::kMatch ? RE2::ANCHOR_BOTH : RE2::UNANCHORED),
+        size(patterns.size()) {
+    std::string error;
+    for (const auto& pattern : patterns) {
+      if (set.Add({pattern.data(), pattern.size()}, &error) < 0) {
+        throw std::invalid_argument(
+            fmt::format("Invalid regex '{}': {}", pattern, error));
+      }
+    }
+    if (!set.Compile()) {
+      throw std::invalid_argument("Regex set is too large to compile");
+    }
+  }
+
+  std::vector<int> DoMatch(std::string_view str) const {
+    std::vector<int> matched;
+    if (size != 0) set.Match({str.data(), str.size()}, &matched);
+    return matched;
+  }
+
+  std::vector<std::size_t> Match(std::string_view str) const {
+    const auto matched = DoMatch(str);
+    std::vector<std::size_t> result(matched.begin(), matched.end());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  std::optional<std::size_t> MatchFirst(std::string_view str) const {
+    const auto matched = DoMatch(str);
+    if (matched.empty()) return std::nullopt;
+    return *std::min_element(matched.begin(), matched.end());
+  }
+
+  bool MatchAny(std::string_view str) const {
+    return size != 0 && set.Match({str.data(), str.size()}, nullptr);
+  }
+
+  RE2::Set set;
+  std::size_t size;
+};
+
+#else
+
+struct RegexSet::Impl {
+  Impl(const std::vector<std::string>& patterns, Mode mode)
+      : mode(mode), size(patterns.size()) {
+    regexes.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+      try {
+        // the same anchors and dot semantics as in RE2
+        regexes.emplace_back(pattern, boost::regex::perl |
+                                          boost::regex::no_mod_m |
+                                          boost::regex::no_mod_s);
+      } catch (const boost::regex_error& e) {
+        throw std::invalid_argument(
+            fmt::format("Invalid regex '{}': {}", pattern, e.what()));
+      }
+    }
+  }
+
+  bool IsMatching(std::string_view str, const boost::regex& regex) const {
+    return mode == Mode::kMatch
+               ? boost::regex_match(str.begin(), str.end(), regex)
+               : boost::regex_search(str.begin(), str.end(), regex);
+  }
+
+  std::vector<std::size_t> Match(std::string_view str) const {
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < regexes.size(); ++i) {
+      if (IsMatching(str, regexes[i])) result.push_back(i);
+    }
+    return result;
+  }
+
+  std::optional<std::size_t> MatchFirst(std::string_view str) const {
+    for (std::size_t i = 0; i < regexes.size(); ++i) {
+      if (IsMatching(str, regexes[i])) return i;
+    }
+    return std::nullopt;
+  }
+
+  bool MatchAny(std::string_view str) const {
+    return MatchFirst(str).has_value();
+  }
+
+  std::vector<boost::regex> regexes;
+  Mode mode;
+  std::size_t size;
+};
+
+#endif
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns, Mode mode)
+    : impl_(std::make_unique<Impl>(patterns, mode)) {}
+
+RegexSet::RegexSet(RegexSet&&) noexcept = default;
+
+RegexSet& RegexSet::operator=(RegexSet&&) noexcept = default;
+
+RegexSet::~RegexSet() = default;
+
+std::vector<std::size_t> RegexSet::Match(std::string_view str) const {
+  return impl_->Match(str);
+}
+
+std::optional<std::size_t> RegexSet::MatchFirst(std::string_view str) const {
+  return impl_->MatchFirst(str);
+}
+
+bool RegexSet::MatchAny(std::string_view str) const {
+  return impl_->MatchAny(str);
+}
+
+std::size_t RegexSet::GetSize() const noexcept { return impl_->size; }
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#include <userver/utils/regex_set.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/utils/regex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> MakePatterns(std::size_t count) {
+  std::vector<std::string> patterns;
+  for (std::size_t i = 0; i < count; ++i) {
+    patterns.push_back(fmt::format(R"(/v1/handler{}/[a-z]+/\d+)", i));
+  }
+  return patterns;
+}
+
+// matches only the last pattern, the worst case for the one-by-one matching
+std::string MakePath(std::size_t count) {
+  return fmt::format("/v1/handler{}/orders/1234567", count - 1);
+}
+
+}  // namespace
+
+void RegexMatchEach(benchmark::State& state) {
+  const auto count = state.range(0);
+  std::vector<utils::regex> regexes;
+  for (const auto& pattern : MakePatterns(count)) {
+    regexes.emplace_back(pattern);
+  }
+  const auto path = MakePath(count);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& regex : regexes) {
+      if (utils::regex_match(path, regex)) break;
+    }
+  }
+}
+BENCHMARK(RegexMatchEach)->RangeMultiplier(4)->Range(1, 64);
+
+void RegexSetMatchFirst(benchmark::State& state) {
+  const auto count = state.range(0);
+  const utils::RegexSet set{MakePatterns(count),
+                            utils::RegexSet::Mode::kMatch};
+  const auto path = MakePath(count);
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(set.MatchFirst(path));
+  }
+}
+BENCHMARK(RegexSetMatchFirst)->RangeMultiplier(4)->Range(1, 64);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,79 @@
+#include <userver/utils/regex_set.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using Indices = std::vector<std::size_t>;
+
+TEST(RegexSet, Sample) {
+  /// [Sample utils::RegexSet usage]
+  // Compile once, e.g. in the constructor of a component
+  const utils::RegexSet routes{
+      {R"(/v1/users/\d+)", R"(/v1/users/[^/]+/orders)", R"(/v[12]/.*)"},
+      utils::RegexSet::Mode::kMatch,
+  };
+
+  EXPECT_EQ(routes.Match("/v1/users/42"), (Indices{0, 2}));
+  EXPECT_EQ(routes.MatchFirst("/v1/users/me/orders"), 1);
+  EXPECT_FALSE(routes.MatchAny("/v3/users"));
+  /// [Sample utils::RegexSet usage]
+}
+
+TEST(RegexSet, Search) {
+  const utils::RegexSet set{{"abc", "^b", "c$", "x+y"}};
+  EXPECT_EQ(set.GetSize(), 4);
+
+  EXPECT_EQ(set.Match("zabcz"), (Indices{0}));
+  EXPECT_EQ(set.Match("babc"), (Indices{0, 1, 2}));
+  EXPECT_EQ(set.Match(""), (Indices{}));
+  EXPECT_EQ(set.MatchFirst("__xxxy"), 3);
+  EXPECT_EQ(set.MatchFirst("bc"), 1);
+  EXPECT_EQ(set.MatchFirst("___"), std::nullopt);
+  EXPECT_TRUE(set.MatchAny("___c"));
+  EXPECT_FALSE(set.MatchAny("___"));
+}
+
+TEST(RegexSet, Match) {
+  const utils::RegexSet set{{"a+", "a*b", ""}, utils::RegexSet::Mode::kMatch};
+  EXPECT_EQ(set.Match("aaa"), (Indices{0}));
+  EXPECT_EQ(set.Match("aab"), (Indices{1}));
+  EXPECT_EQ(set.Match("b"), (Indices{1}));
+  EXPECT_EQ(set.Match(""), (Indices{2}));
+  EXPECT_EQ(set.Match("aaba"), (Indices{}));
+}
+
+TEST(RegexSet, Lines) {
+  // the anchors are for the whole string, the dot does not match '\n'
+  const utils::RegexSet set{{"^b", "a$", "a.b"}};
+  EXPECT_EQ(set.Match("a\nb"), (Indices{}));
+  EXPECT_EQ(set.Match("b\na"), (Indices{0, 1}));
+  EXPECT_EQ(set.Match("a_b"), (Indices{2}));
+}
+
+TEST(RegexSet, Empty) {
+  const utils::RegexSet set{{}};
+  EXPECT_EQ(set.GetSize(), 0);
+  EXPECT_EQ(set.Match("abc"), (Indices{}));
+  EXPECT_EQ(set.MatchFirst("abc"), std::nullopt);
+  EXPECT_FALSE(set.MatchAny(""));
+}
+
+TEST(RegexSet, Invalid) {
+  EXPECT_THROW((utils::RegexSet{{"a", "(b"}}), std::invalid_argument);
+  EXPECT_THROW((utils::RegexSet{{"[z-a]"}}), std::invalid_argument);
+}
+
+TEST(RegexSet, Move) {
+  utils::RegexSet set{{"a"}};
+  utils::RegexSet other{std::move(set)};
+  EXPECT_TRUE(other.MatchAny("a"));
+
+  set = utils::RegexSet{{"b"}};
+  EXPECT_TRUE(set.MatchAny("b"));
+  EXPECT_FALSE(set.MatchAny("a"));
+}
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,14 @@
 #include <userver/utils/str_icase.hpp>
 
 #include <algorithm>  // for std::min
+#include <cstdint>
+#include <cstring>
 
-#include <boost/functional/hash.hpp>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+#include <userver/utils/hash.hpp>
 #include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +21,35 @@ static_assert((static_cast<std::size_t>('Z') | kUppercaseToLowerMask) == 'z');
 static_assert((static_cast<std::size_t>('a') | kUppercaseToLowerMask) == 'a');
 static_assert((static_cast<std::size_t>('z') | kUppercaseToLowerMask) == 'z');
 
+namespace {
+
+constexpr std::uint64_t RepeatByte(std::uint8_t byte) noexcept {
+  return 0x0101010101010101ULL * byte;
+}
+
+// Lowercases the ASCII letters in each of the 8 bytes at once, the bytes with
+// the high bit set are left intact.
+std::uint64_t ToLowerAscii8(std::uint64_t x) noexcept {
+  const std::uint64_t heptets = x & RepeatByte(0x7f);
+  const std::uint64_t gt_z = heptets + RepeatByte(0x7f - 'Z');
+  const std::uint64_t ge_a = heptets + RepeatByte(0x80 - 'A');
+  const std::uint64_t is_upper = (ge_a ^ gt_z) & ~x & RepeatByte(0x80);
+  return x | (is_upper >> 2);
+}
+
+#ifdef __SSE2__
+// Bytes with the high bit set are negative and are never taken for letters
+__m128i ToLowerAscii16(__m128i x) noexcept {
+  const auto is_upper =
+      _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+  return _mm_or_si128(
+      x, _mm_and_si128(is_upper, _mm_set1_epi8(kUppercaseToLowerMask)));
+}
+#endif
+
+}  // namespace
+
 StrIcaseHash::StrIcaseHash()
     : seed_(std::uniform_int_distribution<std::size_t>{}(DefaultRandom())) {}
 
@@ -25,12 +59,7 @@ std::size_t StrIcaseHash::operator()(std::string_view s) const& noexcept {
   // NOTE: a random seed, mixed "well enough" into string hash, should make it
   // resistant to HashDOS attacks. That is, it should make deliberate generation
   // of collisions infeasible.
-  std::size_t res = seed_;
-  for (const char c : s) {
-    const char mask = (c >= 'A' && c <= 'Z') ? kUppercaseToLowerMask : 0;
-    boost::hash_combine(res, static_cast<char>(c | mask));
-  }
-  return res;
+  return HashBytesIcase(s, seed_);
 }
 
 StrCaseHash::StrCaseHash()
@@ -42,11 +71,7 @@ std::size_t StrCaseHash::operator()(std::string_view s) const& noexcept {
   // NOTE: a random seed, mixed "well enough" into string hash, should make it
   // resistant to HashDOS attacks. That is, it should make deliberate generation
   // of collisions infeasible.
-  std::size_t res = seed_;
-  for (const char c : s) {
-    boost::hash_combine(res, static_cast<char>(c));
-  }
-  return res;
+  return HashBytes(s, seed_);
 }
 
 int StrIcaseCompareThreeWay::operator()(std::string_view lhs,
@@ -71,7 +96,28 @@ int StrIcaseCompareThreeWay::operator()(std::string_view lhs,
 bool StrIcaseEqual::operator()(std::string_view lhs, std::string_view rhs) const
     noexcept {
   if (lhs.size() != rhs.size()) return false;
-  return StrIcaseCompareThreeWay{}(lhs, rhs) == 0;
+
+  const auto size = lhs.size();
+  std::size_t pos = 0;
+#ifdef __SSE2__
+  for (; pos + 16 <= size; pos += 16) {
+    const auto a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs.data() + pos));
+    const auto b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs.data() + pos));
+    const auto equal =
+        _mm_cmpeq_epi8(ToLowerAscii16(a), ToLowerAscii16(b));
+    if (_mm_movemask_epi8(equal) != 0xffff) return false;
+  }
+#endif
+  for (; pos + 8 <= size; pos += 8) {
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    std::memcpy(&a, lhs.data() + pos, sizeof(a));
+    std::memcpy(&b, rhs.data() + pos, sizeof(b));
+    if (a != b && ToLowerAscii8(a) != ToLowerAscii8(b)) return false;
+  }
+  return StrIcaseCompareThreeWay{}(lhs.substr(pos), rhs.substr(pos)) == 0;
 }
 
 bool StrIcaseLess::operator()(std::string_view lhs, std::string_view rhs) const
@@ -84,6 +84,29 @@ TEST(StrIcases, CompareEqual) {
                                       std::string_view("warnin")));
 }
 
+TEST(StrIcases, CompareEqualAllBytes) {
+  const auto to_lower = [](unsigned char c) {
+    return ('A' <= c && c <= 'Z') ? c | 32 : c;
+  };
+
+  // covers the 16-byte, the 8-byte and the tail comparisons
+  constexpr std::size_t kSize = 40;
+  std::string lhs(kSize, 'x');
+  std::string rhs(kSize, 'X');
+  for (std::size_t pos = 0; pos < kSize; ++pos) {
+    for (int a = 0; a < 256; ++a) {
+      for (int b = 0; b < 256; ++b) {
+        lhs[pos] = static_cast<char>(a);
+        rhs[pos] = static_cast<char>(b);
+        ASSERT_EQ(utils::StrIcaseEqual{}(lhs, rhs), to_lower(a) == to_lower(b))
+            << "pos=" << pos << " a=" << a << " b=" << b;
+      }
+    }
+    lhs[pos] = 'x';
+    rhs[pos] = 'X';
+  }
+}
+
 TEST(StrIcases, CompareLess) {
   EXPECT_FALSE(utils::StrIcaseLess{}(kUppercaseChars, kLowercaseChars));
   EXPECT_FALSE(utils::StrIcaseLess{}(kLowercaseChars, kUppercaseChars));
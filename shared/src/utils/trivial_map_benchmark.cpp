@@ -3,6 +3,7 @@
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -293,4 +294,298 @@ void MappingHugeUnorderedLast(benchmark::State& state) {
 }
 BENCHMARK(MappingHugeUnorderedLast);
 
+constexpr utils::TrivialBiMap kLargeTrivialBiMap = [](auto selector) {
+  return selector()
+      .Case("header-accept-0", 0)
+      .Case("header-content-0", 1)
+      .Case("header-x-request-0", 2)
+      .Case("header-cache-0", 3)
+      .Case("header-accept-1", 4)
+      .Case("header-content-1", 5)
+      .Case("header-x-request-1", 6)
+      .Case("header-cache-1", 7)
+      .Case("header-accept-2", 8)
+      .Case("header-content-2", 9)
+      .Case("header-x-request-2", 10)
+      .Case("header-cache-2", 11)
+      .Case("header-accept-3", 12)
+      .Case("header-content-3", 13)
+      .Case("header-x-request-3", 14)
+      .Case("header-cache-3", 15)
+      .Case("header-accept-4", 16)
+      .Case("header-content-4", 17)
+      .Case("header-x-request-4", 18)
+      .Case("header-cache-4", 19)
+      .Case("header-accept-5", 20)
+      .Case("header-content-5", 21)
+      .Case("header-x-request-5", 22)
+      .Case("header-cache-5", 23)
+      .Case("header-accept-6", 24)
+      .Case("header-content-6", 25)
+      .Case("header-x-request-6", 26)
+      .Case("header-cache-6", 27)
+      .Case("header-accept-7", 28)
+      .Case("header-content-7", 29)
+      .Case("header-x-request-7", 30)
+      .Case("header-cache-7", 31)
+      .Case("header-accept-8", 32)
+      .Case("header-content-8", 33)
+      .Case("header-x-request-8", 34)
+      .Case("header-cache-8", 35)
+      .Case("header-accept-9", 36)
+      .Case("header-content-9", 37)
+      .Case("header-x-request-9", 38)
+      .Case("header-cache-9", 39)
+      .Case("header-accept-10", 40)
+      .Case("header-content-10", 41)
+      .Case("header-x-request-10", 42)
+      .Case("header-cache-10", 43)
+      .Case("header-accept-11", 44)
+      .Case("header-content-11", 45)
+      .Case("header-x-request-11", 46)
+      .Case("header-cache-11", 47)
+      .Case("header-accept-12", 48)
+      .Case("header-content-12", 49)
+      .Case("header-x-request-12", 50)
+      .Case("header-cache-12", 51)
+      .Case("header-accept-13", 52)
+      .Case("header-content-13", 53)
+      .Case("header-x-request-13", 54)
+      .Case("header-cache-13", 55)
+      .Case("header-accept-14", 56)
+      .Case("header-content-14", 57)
+      .Case("header-x-request-14", 58)
+      .Case("header-cache-14", 59)
+      .Case("header-accept-15", 60)
+      .Case("header-content-15", 61)
+      .Case("header-x-request-15", 62)
+      .Case("header-cache-15", 63)
+      .Case("header-accept-16", 64)
+      .Case("header-content-16", 65)
+      .Case("header-x-request-16", 66)
+      .Case("header-cache-16", 67)
+      .Case("header-accept-17", 68)
+      .Case("header-content-17", 69)
+      .Case("header-x-request-17", 70)
+      .Case("header-cache-17", 71)
+      .Case("header-accept-18", 72)
+      .Case("header-content-18", 73)
+      .Case("header-x-request-18", 74)
+      .Case("header-cache-18", 75)
+      .Case("header-accept-19", 76)
+      .Case("header-content-19", 77)
+      .Case("header-x-request-19", 78)
+      .Case("header-cache-19", 79)
+      .Case("header-accept-20", 80)
+      .Case("header-content-20", 81)
+      .Case("header-x-request-20", 82)
+      .Case("header-cache-20", 83)
+      .Case("header-accept-21", 84)
+      .Case("header-content-21", 85)
+      .Case("header-x-request-21", 86)
+      .Case("header-cache-21", 87)
+      .Case("header-accept-22", 88)
+      .Case("header-content-22", 89)
+      .Case("header-x-request-22", 90)
+      .Case("header-cache-22", 91)
+      .Case("header-accept-23", 92)
+      .Case("header-content-23", 93)
+      .Case("header-x-request-23", 94)
+      .Case("header-cache-23", 95)
+      .Case("header-accept-24", 96)
+      .Case("header-content-24", 97)
+      .Case("header-x-request-24", 98)
+      .Case("header-cache-24", 99)
+      .Case("header-accept-25", 100)
+      .Case("header-content-25", 101)
+      .Case("header-x-request-25", 102)
+      .Case("header-cache-25", 103)
+      .Case("header-accept-26", 104)
+      .Case("header-content-26", 105)
+      .Case("header-x-request-26", 106)
+      .Case("header-cache-26", 107)
+      .Case("header-accept-27", 108)
+      .Case("header-content-27", 109)
+      .Case("header-x-request-27", 110)
+      .Case("header-cache-27", 111)
+      .Case("header-accept-28", 112)
+      .Case("header-content-28", 113)
+      .Case("header-x-request-28", 114)
+      .Case("header-cache-28", 115)
+      .Case("header-accept-29", 116)
+      .Case("header-content-29", 117)
+      .Case("header-x-request-29", 118)
+      .Case("header-cache-29", 119)
+      .Case("header-accept-30", 120)
+      .Case("header-content-30", 121)
+      .Case("header-x-request-30", 122)
+      .Case("header-cache-30", 123)
+      .Case("header-accept-31", 124)
+      .Case("header-content-31", 125)
+      .Case("header-x-request-31", 126)
+      .Case("header-cache-31", 127);
+};
+
+const auto kLargeUnorderedMapping = std::unordered_map<std::string_view, int>{
+    {"header-accept-0", 0},
+    {"header-content-0", 1},
+    {"header-x-request-0", 2},
+    {"header-cache-0", 3},
+    {"header-accept-1", 4},
+    {"header-content-1", 5},
+    {"header-x-request-1", 6},
+    {"header-cache-1", 7},
+    {"header-accept-2", 8},
+    {"header-content-2", 9},
+    {"header-x-request-2", 10},
+    {"header-cache-2", 11},
+    {"header-accept-3", 12},
+    {"header-content-3", 13},
+    {"header-x-request-3", 14},
+    {"header-cache-3", 15},
+    {"header-accept-4", 16},
+    {"header-content-4", 17},
+    {"header-x-request-4", 18},
+    {"header-cache-4", 19},
+    {"header-accept-5", 20},
+    {"header-content-5", 21},
+    {"header-x-request-5", 22},
+    {"header-cache-5", 23},
+    {"header-accept-6", 24},
+    {"header-content-6", 25},
+    {"header-x-request-6", 26},
+    {"header-cache-6", 27},
+    {"header-accept-7", 28},
+    {"header-content-7", 29},
+    {"header-x-request-7", 30},
+    {"header-cache-7", 31},
+    {"header-accept-8", 32},
+    {"header-content-8", 33},
+    {"header-x-request-8", 34},
+    {"header-cache-8", 35},
+    {"header-accept-9", 36},
+    {"header-content-9", 37},
+    {"header-x-request-9", 38},
+    {"header-cache-9", 39},
+    {"header-accept-10", 40},
+    {"header-content-10", 41},
+    {"header-x-request-10", 42},
+    {"header-cache-10", 43},
+    {"header-accept-11", 44},
+    {"header-content-11", 45},
+    {"header-x-request-11", 46},
+    {"header-cache-11", 47},
+    {"header-accept-12", 48},
+    {"header-content-12", 49},
+    {"header-x-request-12", 50},
+    {"header-cache-12", 51},
+    {"header-accept-13", 52},
+    {"header-content-13", 53},
+    {"header-x-request-13", 54},
+    {"header-cache-13", 55},
+    {"header-accept-14", 56},
+    {"header-content-14", 57},
+    {"header-x-request-14", 58},
+    {"header-cache-14", 59},
+    {"header-accept-15", 60},
+    {"header-content-15", 61},
+    {"header-x-request-15", 62},
+    {"header-cache-15", 63},
+    {"header-accept-16", 64},
+    {"header-content-16", 65},
+    {"header-x-request-16", 66},
+    {"header-cache-16", 67},
+    {"header-accept-17", 68},
+    {"header-content-17", 69},
+    {"header-x-request-17", 70},
+    {"header-cache-17", 71},
+    {"header-accept-18", 72},
+    {"header-content-18", 73},
+    {"header-x-request-18", 74},
+    {"header-cache-18", 75},
+    {"header-accept-19", 76},
+    {"header-content-19", 77},
+    {"header-x-request-19", 78},
+    {"header-cache-19", 79},
+    {"header-accept-20", 80},
+    {"header-content-20", 81},
+    {"header-x-request-20", 82},
+    {"header-cache-20", 83},
+    {"header-accept-21", 84},
+    {"header-content-21", 85},
+    {"header-x-request-21", 86},
+    {"header-cache-21", 87},
+    {"header-accept-22", 88},
+    {"header-content-22", 89},
+    {"header-x-request-22", 90},
+    {"header-cache-22", 91},
+    {"header-accept-23", 92},
+    {"header-content-23", 93},
+    {"header-x-request-23", 94},
+    {"header-cache-23", 95},
+    {"header-accept-24", 96},
+    {"header-content-24", 97},
+    {"header-x-request-24", 98},
+    {"header-cache-24", 99},
+    {"header-accept-25", 100},
+    {"header-content-25", 101},
+    {"header-x-request-25", 102},
+    {"header-cache-25", 103},
+    {"header-accept-26", 104},
+    {"header-content-26", 105},
+    {"header-x-request-26", 106},
+    {"header-cache-26", 107},
+    {"header-accept-27", 108},
+    {"header-content-27", 109},
+    {"header-x-request-27", 110},
+    {"header-cache-27", 111},
+    {"header-accept-28", 112},
+    {"header-content-28", 113},
+    {"header-x-request-28", 114},
+    {"header-cache-28", 115},
+    {"header-accept-29", 116},
+    {"header-content-29", 117},
+    {"header-x-request-29", 118},
+    {"header-cache-29", 119},
+    {"header-accept-30", 120},
+    {"header-content-30", 121},
+    {"header-x-request-30", 122},
+    {"header-cache-30", 123},
+    {"header-accept-31", 124},
+    {"header-content-31", 125},
+    {"header-x-request-31", 126},
+    {"header-cache-31", 127},
+};
+
+std::vector<std::string_view> LargeMappingKeys() {
+  std::vector<std::string_view> keys;
+  for (int i = 0; i < 128; i += 13) {
+    keys.push_back(MyLaunder(kLargeTrivialBiMap.TryFindBySecond(i).value()));
+  }
+  keys.push_back(MyLaunder("header-accept-unknown"));
+  return keys;
+}
+
+void MappingLargeTrivialBiMap(benchmark::State& state) {
+  const auto keys = LargeMappingKeys();
+
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(kLargeTrivialBiMap.TryFind(key));
+    }
+  }
+}
+BENCHMARK(MappingLargeTrivialBiMap);
+
+void MappingLargeUnordered(benchmark::State& state) {
+  const auto keys = LargeMappingKeys();
+
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(kLargeUnorderedMapping.find(key));
+    }
+  }
+}
+BENCHMARK(MappingLargeUnordered);
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/utils/trivial_map.hpp>
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -293,4 +295,126 @@ TEST(TrivialBiMap, StringICase) {
       "\xf0\xe1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff"));
 }
 
+constexpr utils::TrivialBiMap kLargeMap = [](auto selector) {
+  return selector()
+      .Case("key0", 0)
+      .Case("key1", 1)
+      .Case("key2", 2)
+      .Case("key3", 3)
+      .Case("key4", 4)
+      .Case("key5", 5)
+      .Case("key6", 6)
+      .Case("key7", 7)
+      .Case("key8", 8)
+      .Case("key9", 9)
+      .Case("key10", 10)
+      .Case("key11", 11)
+      .Case("key12", 12)
+      .Case("key13", 13)
+      .Case("key14", 14)
+      .Case("key15", 15)
+      .Case("key16", 16)
+      .Case("key17", 17)
+      .Case("key18", 18)
+      .Case("key19", 19)
+      .Case("key20", 20)
+      .Case("key21", 21)
+      .Case("key22", 22)
+      .Case("key23", 23)
+      .Case("key24", 24)
+      .Case("key25", 25)
+      .Case("key26", 26)
+      .Case("key27", 27)
+      .Case("key28", 28)
+      .Case("key29", 29)
+      .Case("key30", 30)
+      .Case("key31", 31)
+      .Case("key32", 32)
+      .Case("key33", 33)
+      .Case("key34", 34)
+      .Case("key35", 35)
+      .Case("key36", 36)
+      .Case("key37", 37)
+      .Case("key38", 38)
+      .Case("key39", 39)
+      .Case("key0", 42);
+};
+
+TEST(TrivialBiMap, LargeStringMap) {
+  static_assert(kLargeMap.TryFindByFirst("key7") == 7);
+  static_assert(!kLargeMap.TryFindByFirst("key40"));
+  EXPECT_EQ(kLargeMap.size(), 41);
+
+  for (int i = 0; i < 40; ++i) {
+    const auto key = "key" + std::to_string(i);
+    EXPECT_EQ(kLargeMap.TryFind(key), i);
+    EXPECT_EQ(kLargeMap.TryFind(i), key);
+  }
+
+  // the first Case statement wins
+  EXPECT_EQ(kLargeMap.TryFind("key0"), 0);
+  EXPECT_EQ(kLargeMap.TryFind(42), "key0");
+
+  EXPECT_FALSE(kLargeMap.TryFind("key40"));
+  EXPECT_FALSE(kLargeMap.TryFind("key"));
+  EXPECT_FALSE(kLargeMap.TryFind(""));
+  EXPECT_EQ(kLargeMap.TryFindICase("KEY3"), 3);
+}
+
+constexpr utils::TrivialSet kLargeSet = [](auto selector) {
+  return selector()
+      .Case("value0")
+      .Case("value1")
+      .Case("value2")
+      .Case("value3")
+      .Case("value4")
+      .Case("value5")
+      .Case("value6")
+      .Case("value7")
+      .Case("value8")
+      .Case("value9")
+      .Case("value10")
+      .Case("value11")
+      .Case("value12")
+      .Case("value13")
+      .Case("value14")
+      .Case("value15")
+      .Case("value16")
+      .Case("value17")
+      .Case("value18")
+      .Case("value19")
+      .Case("value20")
+      .Case("value21")
+      .Case("value22")
+      .Case("value23")
+      .Case("value24")
+      .Case("value25")
+      .Case("value26")
+      .Case("value27")
+      .Case("value28")
+      .Case("value29")
+      .Case("value30")
+      .Case("value31")
+      .Case("value32")
+      .Case("value33")
+      .Case("value34")
+      .Case("value35")
+      .Case("value36")
+      .Case("value37")
+      .Case("value38")
+      .Case("value39");
+};
+
+TEST(TrivialBiMap, LargeStringSet) {
+  static_assert(kLargeSet.Contains("value39"));
+  static_assert(!kLargeSet.Contains("value40"));
+
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_TRUE(kLargeSet.Contains("value" + std::to_string(i)));
+  }
+  EXPECT_FALSE(kLargeSet.Contains("value"));
+  EXPECT_FALSE(kLargeSet.Contains("Value1"));
+  EXPECT_TRUE(kLargeSet.ContainsICase("Value1"));
+}
+
 USERVER_NAMESPACE_END
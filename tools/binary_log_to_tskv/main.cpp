@@ -0,0 +1,30 @@
+#include <fstream>
+#include <iostream>
+
+#include <userver/logging/binary_log.hpp>
+
+// Converts the logs written in the `binary` format to TSKV.
+// Usage: binary_log_to_tskv [FILE]...
+// Reads the standard input if no files are given.
+int main(int argc, char* argv[]) {
+  namespace logging = USERVER_NAMESPACE::logging;
+
+  try {
+    if (argc < 2) {
+      logging::ConvertBinaryLogToTskv(std::cin, std::cout);
+      return 0;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+      std::ifstream file(argv[i], std::ios::binary);
+      if (!file) {
+        std::cerr << "Failed to open '" << argv[i] << "'\n";
+        return 1;
+      }
+      logging::ConvertBinaryLogToTskv(file, std::cout);
+    }
+  } catch (const logging::BinaryLogError& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}
@@ -69,7 +69,7 @@ Config ParseConfig(int argc, char* argv[]) {
       po::value(&config.timeout_ms)->default_value(config.timeout_ms),
       "request timeout in ms")("multiplexing", "enable HTTP/2 multiplexing")(
       "http-version,V", po::value<std::string>(),
-      "http version, possible values: 1.0, 1.1, 2.0-prior")(
+      "http version, possible values: 1.0, 1.1, 2, 2tls, 2-prior, 3")(
       "max-host-connections",
       po::value(&config.max_host_connections)
           ->default_value(config.max_host_connections),
@@ -100,6 +100,8 @@ Config ParseConfig(int argc, char* argv[]) {
       config.http_version = http::HttpVersion::k2Tls;
     else if (value == "2-prior")
       config.http_version = http::HttpVersion::k2PriorKnowledge;
+    else if (value == "3")
+      config.http_version = http::HttpVersion::k3;
     else {
       std::cerr << "--http-version value is unknown" << std::endl;
       exit(1);
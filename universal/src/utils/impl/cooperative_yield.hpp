@@ -0,0 +1,13 @@
+#pragma once
+
+// Stub for the engine yield point, there are no coroutines to yield
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+inline void CooperativeYield() {}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END